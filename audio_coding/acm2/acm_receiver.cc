@@ -38,7 +38,9 @@ AcmReceiver::AcmReceiver(const AudioCodingModule::Config& config)
                            config.clock,
                            config.decoder_factory)),
       clock_(config.clock),
-      resampled_last_output_frame_(true) {
+      resampled_last_output_frame_(true),
+      post_decode_vad_(config.neteq_config.enable_post_decode_vad),
+      post_decode_vad_paused_(false) {
   RTC_DCHECK(clock_);
   memset(last_audio_buffer_.get(), 0,
          sizeof(int16_t) * AudioFrame::kMaxDataSizeSamples);
@@ -131,7 +133,64 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   RTC_DCHECK(muted);
   // Accessing members, take the lock.
   rtc::CritScope lock(&crit_sect_);
+  return GetAudioLocked(desired_freq_hz, audio_frame, muted);
+}
+
+int AcmReceiver::GetAudio(int desired_freq_hz,
+                          rtc::ArrayView<AudioFrame> audio_frames) {
+  // Accessing members, take the lock once for all the frames.
+  rtc::CritScope lock(&crit_sect_);
+  for (AudioFrame& audio_frame : audio_frames) {
+    bool muted;
+    if (GetAudioLocked(desired_freq_hz, &audio_frame, &muted) != 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int AcmReceiver::GetUnmixedAudio(AudioFrame* audio_frame,
+                                 bool* muted,
+                                 uint32_t* energy) {
+  RTC_DCHECK(muted);
+  RTC_DCHECK(energy);
+  rtc::CritScope lock(&crit_sect_);
+  if (post_decode_vad_ && !post_decode_vad_paused_) {
+    neteq_->DisableVad();
+    post_decode_vad_paused_ = true;
+  }
+  if (neteq_->GetAudio(audio_frame, muted) != NetEq::kOK) {
+    RTC_LOG(LERROR) << "AcmReceiver::GetUnmixedAudio - NetEq Failed.";
+    return -1;
+  }
 
+  const size_t num_samples =
+      audio_frame->samples_per_channel_ * audio_frame->num_channels_;
+  // Not resampled, so the next GetAudio() has to prime the resampler with
+  // this frame if it resamples.
+  resampled_last_output_frame_ = false;
+  memcpy(last_audio_buffer_.get(), audio_frame->data(),
+         sizeof(int16_t) * num_samples);
+
+  *energy = 0;
+  if (!*muted) {
+    const int16_t* data = audio_frame->data();
+    for (size_t i = 0; i < num_samples; ++i) {
+      *energy += data[i] * data[i];
+    }
+  }
+
+  call_stats_.DecodedByNetEq(audio_frame->speech_type_, *muted);
+  return 0;
+}
+
+int AcmReceiver::GetAudioLocked(int desired_freq_hz,
+                                AudioFrame* audio_frame,
+                                bool* muted) {
+  if (post_decode_vad_paused_) {
+    neteq_->EnableVad();
+    post_decode_vad_paused_ = false;
+  }
   if (neteq_->GetAudio(audio_frame, muted) != NetEq::kOK) {
     RTC_LOG(LERROR) << "AcmReceiver::GetAudio - NetEq Failed.";
     return -1;
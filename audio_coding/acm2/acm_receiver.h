@@ -81,6 +81,39 @@ class AcmReceiver {
   //
   int GetAudio(int desired_freq_hz, AudioFrame* audio_frame, bool* muted);
 
+  //
+  // Like GetAudio() above, but gets |audio_frames.size()| consecutive 10 ms
+  // frames while taking the lock only once. This is intended for pipelines
+  // that pull audio faster than real-time, e.g., offline decoding or
+  // recording. Whether a frame is muted is given by AudioFrame::muted().
+  //
+  // Return value             : 0 if OK.
+  //                           -1 if NetEq returned an error, in which case
+  //                            the frames after the failing one are not
+  //                            populated.
+  //
+  int GetAudio(int desired_freq_hz, rtc::ArrayView<AudioFrame> audio_frames);
+
+  //
+  // Cheaper variant of GetAudio() for streams that are currently left out of
+  // the mix. NetEq still decodes the 10 ms so that the stream stays in sync
+  // and can be mixed again without a glitch, but post-decode VAD is paused
+  // and the audio is returned at the sampling rate of the decoder, without
+  // resampling. The next call to GetAudio() resumes the VAD.
+  //
+  // Output:
+  //   -audio_frame           : as for GetAudio(); |vad_activity_| is
+  //                            kVadUnknown.
+  //   -muted                 : as for GetAudio().
+  //   -energy                : sum of the squared samples of the frame, summed
+  //                            over all channels, or 0 if muted. The same
+  //                            measure the audio mixer uses to rank sources.
+  //
+  // Return value             : 0 if OK.
+  //                           -1 if NetEq returned an error.
+  //
+  int GetUnmixedAudio(AudioFrame* audio_frame, bool* muted, uint32_t* energy);
+
   // Replace the current set of decoders with the specified set.
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs);
 
@@ -212,6 +245,9 @@ class AcmReceiver {
 
   uint32_t NowInTimestamp(int decoder_sampling_rate) const;
 
+  int GetAudioLocked(int desired_freq_hz, AudioFrame* audio_frame, bool* muted)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
   rtc::CriticalSection crit_sect_;
   absl::optional<DecoderInfo> last_decoder_ RTC_GUARDED_BY(crit_sect_);
   ACMResampler resampler_ RTC_GUARDED_BY(crit_sect_);
@@ -220,6 +256,10 @@ class AcmReceiver {
   const std::unique_ptr<NetEq> neteq_;  // NetEq is thread-safe; no lock needed.
   Clock* const clock_;
   bool resampled_last_output_frame_ RTC_GUARDED_BY(crit_sect_);
+  // Whether NetEq was configured with post-decode VAD, and whether it is
+  // paused by GetUnmixedAudio().
+  const bool post_decode_vad_;
+  bool post_decode_vad_paused_ RTC_GUARDED_BY(crit_sect_);
 };
 
 }  // namespace acm2
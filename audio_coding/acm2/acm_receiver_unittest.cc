@@ -12,6 +12,7 @@
 
 #include <algorithm>  // std::min
 #include <memory>
+#include <vector>
 
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
@@ -166,6 +167,32 @@ TEST_F(AcmReceiverTestOldApi, MAYBE_SampleRate) {
   }
 }
 
+#if defined(WEBRTC_ANDROID)
+#define MAYBE_GetMultipleFrames DISABLED_GetMultipleFrames
+#else
+#define MAYBE_GetMultipleFrames GetMultipleFrames
+#endif
+TEST_F(AcmReceiverTestOldApi, MAYBE_GetMultipleFrames) {
+  const SdpAudioFormat codec("L16", 16000, 1);
+  receiver_->SetCodecs({{0, codec}});
+
+  constexpr int kOutSampleRateHz = 32000;  // Different than codec sample rate.
+  const int num_10ms_frames = InsertOnePacketOfSilence(SetEncoder(0, codec));
+  ASSERT_GT(num_10ms_frames, 0);
+  std::vector<AudioFrame> frames(num_10ms_frames);
+  EXPECT_EQ(0, receiver_->GetAudio(kOutSampleRateHz, frames));
+  for (const AudioFrame& frame : frames) {
+    EXPECT_EQ(kOutSampleRateHz, frame.sample_rate_hz_);
+    EXPECT_EQ(static_cast<size_t>(kOutSampleRateHz / 100),
+              frame.samples_per_channel_);
+  }
+  EXPECT_EQ(16000, receiver_->last_output_sample_rate_hz());
+
+  AudioDecodingCallStats stats;
+  receiver_->GetDecodingCallStatistics(&stats);
+  EXPECT_EQ(num_10ms_frames, stats.calls_to_neteq);
+}
+
 class AcmReceiverTestFaxModeOldApi : public AcmReceiverTestOldApi {
  protected:
   AcmReceiverTestFaxModeOldApi() {
@@ -272,6 +299,55 @@ TEST_F(AcmReceiverTestOldApi, MAYBE_PostdecodingVad) {
   EXPECT_EQ(AudioFrame::kVadPassive, frame.vad_activity_);
 }
 
+#if defined(WEBRTC_ANDROID)
+#define MAYBE_UnmixedAudioSkipsVadAndResampling \
+  DISABLED_UnmixedAudioSkipsVadAndResampling
+#else
+#define MAYBE_UnmixedAudioSkipsVadAndResampling \
+  UnmixedAudioSkipsVadAndResampling
+#endif
+TEST_F(AcmReceiverTestOldApi, MAYBE_UnmixedAudioSkipsVadAndResampling) {
+  EXPECT_TRUE(config_.neteq_config.enable_post_decode_vad);
+  constexpr int payload_type = 34;
+  const SdpAudioFormat codec = {"L16", 16000, 1};
+  const AudioCodecInfo info = SetEncoder(payload_type, codec);
+  receiver_->SetCodecs({{payload_type, codec}});
+  constexpr int kOutSampleRateHz = 32000;  // Different than codec sample rate.
+  constexpr int kNumPackets = 5;
+  AudioFrame frame;
+  int num_calls = 0;
+  for (int n = 0; n < kNumPackets; ++n) {
+    const int num_10ms_frames = InsertOnePacketOfSilence(info);
+    for (int k = 0; k < num_10ms_frames; ++k) {
+      bool muted;
+      uint32_t energy = 1;
+      ASSERT_EQ(0, receiver_->GetUnmixedAudio(&frame, &muted, &energy));
+      EXPECT_EQ(info.sample_rate_hz, frame.sample_rate_hz_);
+      EXPECT_EQ(static_cast<size_t>(info.sample_rate_hz / 100),
+                frame.samples_per_channel_);
+      EXPECT_EQ(AudioFrame::kVadUnknown, frame.vad_activity_);
+      EXPECT_EQ(0u, energy);
+      ++num_calls;
+    }
+  }
+
+  // Mixing the stream again resumes the VAD and the resampling.
+  for (int n = 0; n < kNumPackets; ++n) {
+    const int num_10ms_frames = InsertOnePacketOfSilence(info);
+    for (int k = 0; k < num_10ms_frames; ++k) {
+      bool muted;
+      ASSERT_EQ(0, receiver_->GetAudio(kOutSampleRateHz, &frame, &muted));
+      EXPECT_EQ(kOutSampleRateHz, frame.sample_rate_hz_);
+      ++num_calls;
+    }
+  }
+  EXPECT_EQ(AudioFrame::kVadPassive, frame.vad_activity_);
+
+  AudioDecodingCallStats stats;
+  receiver_->GetDecodingCallStatistics(&stats);
+  EXPECT_EQ(num_calls, stats.calls_to_neteq);
+}
+
 class AcmReceiverTestPostDecodeVadPassiveOldApi : public AcmReceiverTestOldApi {
  protected:
   AcmReceiverTestPostDecodeVadPassiveOldApi() {
@@ -145,13 +145,15 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   // in_frame: input audio-frame
   // ptr_out: pointer to output audio_frame. If no preprocessing is required
   //          |ptr_out| will be pointing to |in_frame|, otherwise pointing to
-  //          |preprocess_frame_|.
+  //          |preprocess_frame_|. The timestamp of |*ptr_out| is not used.
+  // timestamp: the timestamp of the output audio in the codec's sample rate.
   //
   // Return value:
   //   -1: if encountering an error.
   //    0: otherwise.
   int PreprocessToAddData(const AudioFrame& in_frame,
-                          const AudioFrame** ptr_out)
+                          const AudioFrame** ptr_out,
+                          uint32_t* timestamp)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
 
   // Change required states after starting to receive the codec corresponding
@@ -462,7 +464,8 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
   // performed before resampling (a down mix prior to resampling will take
   // place if both primary and secondary encoders are mono and input is in
   // stereo).
-  if (PreprocessToAddData(audio_frame, &ptr_frame) < 0) {
+  if (PreprocessToAddData(audio_frame, &ptr_frame,
+                          &input_data->input_timestamp) < 0) {
     return -1;
   }
 
@@ -472,7 +475,6 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
       ptr_frame->num_channels_ == current_num_channels;
 
   // TODO(yujo): Skip encode of muted frames.
-  input_data->input_timestamp = ptr_frame->timestamp_;
   input_data->length_per_channel = ptr_frame->samples_per_channel_;
   input_data->audio_channel = current_num_channels;
 
@@ -498,10 +500,13 @@ int AudioCodingModuleImpl::Add10MsDataInternal(const AudioFrame& audio_frame,
 // encoder is mono and input is stereo. In case of dual-streaming, both
 // encoders has to be mono for down-mix to take place.
 // |*ptr_out| will point to the pre-processed audio-frame. If no pre-processing
-// is required, |*ptr_out| points to |in_frame|.
+// is required, |*ptr_out| points to |in_frame|, also when the codec timestamp
+// differs from the input timestamp, so that the input is never copied only to
+// rewrite its timestamp.
 // TODO(yujo): Make this more efficient for muted frames.
 int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
-                                               const AudioFrame** ptr_out) {
+                                               const AudioFrame** ptr_out,
+                                               uint32_t* timestamp) {
   const bool resample =
       in_frame.sample_rate_hz_ != encoder_stack_->SampleRateHz();
 
@@ -527,19 +532,10 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
     expected_in_ts_ = in_frame.timestamp_;
   }
 
+  *timestamp = expected_codec_ts_;
   if (!down_mix && !resample) {
     // No pre-processing is required.
-    if (expected_in_ts_ == expected_codec_ts_) {
-      // If we've never resampled, we can use the input frame as-is
-      *ptr_out = &in_frame;
-    } else {
-      // Otherwise we'll need to alter the timestamp. Since in_frame is const,
-      // we'll have to make a copy of it.
-      preprocess_frame_.CopyFrom(in_frame);
-      preprocess_frame_.timestamp_ = expected_codec_ts_;
-      *ptr_out = &preprocess_frame_;
-    }
-
+    *ptr_out = &in_frame;
     expected_in_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
     expected_codec_ts_ += static_cast<uint32_t>(in_frame.samples_per_channel_);
     return 0;
@@ -560,7 +556,6 @@ int AudioCodingModuleImpl::PreprocessToAddData(const AudioFrame& in_frame,
     src_ptr_audio = audio;
   }
 
-  preprocess_frame_.timestamp_ = expected_codec_ts_;
   preprocess_frame_.samples_per_channel_ = in_frame.samples_per_channel_;
   preprocess_frame_.sample_rate_hz_ = in_frame.sample_rate_hz_;
   // If it is required, we have to do a resampling.
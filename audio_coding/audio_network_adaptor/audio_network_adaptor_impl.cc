@@ -113,10 +113,21 @@ void AudioNetworkAdaptorImpl::SetOverhead(size_t overhead_bytes_per_packet) {
 }
 
 AudioEncoderRuntimeConfig AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
+  std::vector<Controller*> sorted_controllers =
+      controller_manager_->GetSortedControllers(last_metrics_);
+  if (sorted_controllers != prev_sorted_controllers_) {
+    prev_config_is_stable_ = false;
+    prev_sorted_controllers_ = std::move(sorted_controllers);
+  }
+
   AudioEncoderRuntimeConfig config;
-  for (auto& controller :
-       controller_manager_->GetSortedControllers(last_metrics_))
-    controller->MakeDecision(&config);
+  if (prev_config_is_stable_) {
+    config = *prev_config_;
+  } else {
+    for (auto& controller : prev_sorted_controllers_)
+      controller->MakeDecision(&config);
+    prev_config_is_stable_ = prev_config_ && config == *prev_config_;
+  }
 
   // Update ANA stats.
   auto increment_opt = [](absl::optional<uint32_t>& a) {
@@ -176,6 +187,7 @@ void AudioNetworkAdaptorImpl::DumpNetworkMetrics() {
 
 void AudioNetworkAdaptorImpl::UpdateNetworkMetrics(
     const Controller::NetworkMetrics& network_metrics) {
+  prev_config_is_stable_ = false;
   for (auto& controller : controller_manager_->GetControllers())
     controller->UpdateNetworkMetrics(network_metrics);
 }
@@ -14,6 +14,7 @@
 #include <stdio.h>
 
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/audio_codecs/audio_encoder.h"
@@ -82,6 +83,16 @@ class AudioNetworkAdaptorImpl final : public AudioNetworkAdaptor {
 
   absl::optional<AudioEncoderRuntimeConfig> prev_config_;
 
+  // The controllers in the order they were last run.
+  std::vector<Controller*> prev_sorted_controllers_;
+
+  // True when running the controllers again would reproduce |prev_config_|:
+  // the last run gave the same config as the run before it, and neither the
+  // network metrics nor the controller order have changed since. The
+  // controllers keep no state besides what they put in the config, so they
+  // have then reached a fixed point.
+  bool prev_config_is_stable_ = false;
+
   ANAStats stats_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioNetworkAdaptorImpl);
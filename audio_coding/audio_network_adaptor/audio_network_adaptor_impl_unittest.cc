@@ -186,6 +186,37 @@ TEST(AudioNetworkAdaptorImplTest,
   states.audio_network_adaptor->GetEncoderRuntimeConfig();
 }
 
+TEST(AudioNetworkAdaptorImplTest,
+     MakeDecisionIsSkippedWhenNothingHasChanged) {
+  auto states = CreateAudioNetworkAdaptor();
+  // The second decision equals the first, so a third would too.
+  for (auto& mock_controller : states.mock_controllers)
+    EXPECT_CALL(*mock_controller, MakeDecision(_)).Times(2);
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+
+  // New network metrics trigger a new decision.
+  for (auto& mock_controller : states.mock_controllers)
+    EXPECT_CALL(*mock_controller, MakeDecision(_)).Times(1);
+  states.audio_network_adaptor->SetRtt(100);
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+}
+
+TEST(AudioNetworkAdaptorImplTest, CachedConfigIsReturned) {
+  auto states = CreateAudioNetworkAdaptor();
+  AudioEncoderRuntimeConfig config;
+  config.bitrate_bps = 32000;
+  config.frame_length_ms = 60;
+  EXPECT_CALL(*states.mock_controllers[0], MakeDecision(_))
+      .Times(2)
+      .WillRepeatedly(SetArgPointee<0>(config));
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+  states.audio_network_adaptor->GetEncoderRuntimeConfig();
+  EXPECT_THAT(states.audio_network_adaptor->GetEncoderRuntimeConfig(),
+              EncoderRuntimeConfigIs(config));
+}
+
 TEST(AudioNetworkAdaptorImplTest,
      DumpEncoderRuntimeConfigIsCalledOnGetEncoderRuntimeConfig) {
   test::ScopedFieldTrials override_field_trials(
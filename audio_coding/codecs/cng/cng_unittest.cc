@@ -7,6 +7,8 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 
@@ -202,6 +204,42 @@ TEST_F(CngTest, CngGenerate) {
   EXPECT_FALSE(cng_decoder.Generate(rtc::ArrayView<int16_t>(out_data, 641), 0));
 }
 
+// Test that a reset decoder generates the same noise as a new one, also when
+// the noise parameters of the previous SID were still in use.
+TEST_F(CngTest, CngGenerateAfterReset) {
+  rtc::Buffer sid_data;
+  rtc::Buffer other_sid_data;
+  int16_t out_data[160];
+  int16_t reference_data[160];
+
+  ComfortNoiseEncoder cng_encoder(16000, kSidNormalIntervalUpdate,
+                                  kCNGNumParamsNormal);
+  EXPECT_EQ(kCNGNumParamsNormal + 1,
+            cng_encoder.Encode(rtc::ArrayView<const int16_t>(speech_data_, 160),
+                               kForceSid, &sid_data));
+  EXPECT_EQ(kCNGNumParamsNormal + 1,
+            cng_encoder.Encode(
+                rtc::ArrayView<const int16_t>(&speech_data_[160], 160),
+                kForceSid, &other_sid_data));
+
+  ComfortNoiseDecoder cng_decoder;
+  cng_decoder.UpdateSid(other_sid_data);
+  for (int i = 0; i < 50; i++) {
+    EXPECT_TRUE(cng_decoder.Generate(out_data, i == 0));
+  }
+  cng_decoder.Reset();
+
+  ComfortNoiseDecoder reference_decoder;
+  cng_decoder.UpdateSid(sid_data);
+  reference_decoder.UpdateSid(sid_data);
+  for (int i = 0; i < 50; i++) {
+    EXPECT_TRUE(cng_decoder.Generate(out_data, i == 0));
+    EXPECT_TRUE(reference_decoder.Generate(reference_data, i == 0));
+    ASSERT_TRUE(std::equal(std::begin(out_data), std::end(out_data),
+                           std::begin(reference_data)));
+  }
+}
+
 // Test automatic SID.
 TEST_F(CngTest, CngAutoSid) {
   rtc::Buffer sid_data;
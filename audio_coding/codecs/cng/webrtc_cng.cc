@@ -11,6 +11,7 @@
 #include "modules/audio_coding/codecs/cng/webrtc_cng.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "rtc_base/checks.h"
@@ -69,6 +70,7 @@ void ComfortNoiseDecoder::Reset() {
   dec_order_ = 5;
   dec_target_scale_factor_ = 0;
   dec_used_scale_factor_ = 0;
+  dec_params_valid_ = false;
 }
 
 void ComfortNoiseDecoder::UpdateSid(rtc::ArrayView<const uint8_t> sid) {
@@ -112,7 +114,6 @@ bool ComfortNoiseDecoder::Generate(rtc::ArrayView<int16_t> out_data,
                                    bool new_period) {
   int16_t excitation[kCngMaxOutsizeOrder];
   int16_t low[kCngMaxOutsizeOrder];
-  int16_t lpPoly[WEBRTC_CNG_MAX_LPC_ORDER + 1];
   int16_t ReflBetaStd = 26214;      /* 0.8 in q15. */
   int16_t ReflBetaCompStd = 6553;   /* 0.2 in q15. */
   int16_t ReflBetaNewP = 19661;     /* 0.6 in q15. */
@@ -152,36 +153,49 @@ bool ComfortNoiseDecoder::Generate(rtc::ArrayView<int16_t> out_data,
         (int16_t)WEBRTC_SPL_MUL_16_16_RSFT(dec_target_reflCoefs_[i], BetaC, 15);
   }
 
-  /* Compute the polynomial coefficients. */
-  WebRtcCng_K2a16(dec_used_reflCoefs_, WEBRTC_CNG_MAX_LPC_ORDER, lpPoly);
-
-  targetEnergy = dec_used_energy_;
-
-  /* Calculate scaling factor based on filter energy. */
-  En = 8192; /* 1.0 in Q13. */
-  for (size_t i = 0; i < (WEBRTC_CNG_MAX_LPC_ORDER); i++) {
-    /* Floating point value for reference.
-       E *= 1.0 - (dec_used_reflCoefs_[i] / 32768.0) *
-       (dec_used_reflCoefs_[i] / 32768.0);
-     */
-
-    /* Same in fixed point. */
-    /* K(i).^2 in Q15. */
-    temp16 = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT(dec_used_reflCoefs_[i],
-                                                dec_used_reflCoefs_[i], 15);
-    /* 1 - K(i).^2 in Q15. */
-    temp16 = 0x7fff - temp16;
-    En = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT(En, temp16, 15);
+  if (!dec_params_valid_ ||
+      !std::equal(std::begin(dec_used_reflCoefs_),
+                  std::end(dec_used_reflCoefs_),
+                  std::begin(dec_params_reflCoefs_))) {
+    std::copy(std::begin(dec_used_reflCoefs_), std::end(dec_used_reflCoefs_),
+              std::begin(dec_params_reflCoefs_));
+
+    /* Compute the polynomial coefficients. */
+    WebRtcCng_K2a16(dec_used_reflCoefs_, WEBRTC_CNG_MAX_LPC_ORDER,
+                    dec_params_lpPoly_);
+
+    /* Calculate scaling factor based on filter energy. */
+    En = 8192; /* 1.0 in Q13. */
+    for (size_t i = 0; i < (WEBRTC_CNG_MAX_LPC_ORDER); i++) {
+      /* Floating point value for reference.
+         E *= 1.0 - (dec_used_reflCoefs_[i] / 32768.0) *
+         (dec_used_reflCoefs_[i] / 32768.0);
+       */
+
+      /* Same in fixed point. */
+      /* K(i).^2 in Q15. */
+      temp16 = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT(dec_used_reflCoefs_[i],
+                                                  dec_used_reflCoefs_[i], 15);
+      /* 1 - K(i).^2 in Q15. */
+      temp16 = 0x7fff - temp16;
+      En = (int16_t)WEBRTC_SPL_MUL_16_16_RSFT(En, temp16, 15);
+    }
+
+    En = (int16_t)WebRtcSpl_Sqrt(En) << 6;
+    dec_params_filter_gain_ = (En * 3) >> 1; /* 1.5 estimates sqrt(2). */
   }
 
   /* float scaling= sqrt(E * dec_target_energy_ / (1 << 24)); */
 
   /* Calculate sqrt(En * target_energy / excitation energy) */
-  targetEnergy = WebRtcSpl_Sqrt(dec_used_energy_);
-
-  En = (int16_t)WebRtcSpl_Sqrt(En) << 6;
-  En = (En * 3) >> 1; /* 1.5 estimates sqrt(2). */
-  dec_used_scale_factor_ = (int16_t)((En * targetEnergy) >> 12);
+  if (!dec_params_valid_ || dec_used_energy_ != dec_params_energy_) {
+    dec_params_energy_ = dec_used_energy_;
+    dec_params_sqrt_energy_ = WebRtcSpl_Sqrt(dec_used_energy_);
+  }
+  dec_params_valid_ = true;
+  targetEnergy = dec_params_sqrt_energy_;
+  dec_used_scale_factor_ =
+      (int16_t)((dec_params_filter_gain_ * targetEnergy) >> 12);
 
   /* Generate excitation. */
   /* Excitation energy per sample is 2.^24 - Q13 N(0,1). */
@@ -193,14 +207,15 @@ bool ComfortNoiseDecoder::Generate(rtc::ArrayView<int16_t> out_data,
   WebRtcSpl_ScaleVector(excitation, excitation, dec_used_scale_factor_,
                         num_samples, 13);
 
-  /* |lpPoly| - Coefficients in Q12.
+  /* |dec_params_lpPoly_| - Coefficients in Q12.
    * |excitation| - Speech samples.
    * |nst->dec_filtstate| - State preservation.
    * |out_data| - Filtered speech samples. */
-  WebRtcSpl_FilterAR(lpPoly, WEBRTC_CNG_MAX_LPC_ORDER + 1, excitation,
-                     num_samples, dec_filtstate_, WEBRTC_CNG_MAX_LPC_ORDER,
-                     dec_filtstateLow_, WEBRTC_CNG_MAX_LPC_ORDER,
-                     out_data.data(), low, num_samples);
+  WebRtcSpl_FilterAR(dec_params_lpPoly_, WEBRTC_CNG_MAX_LPC_ORDER + 1,
+                     excitation, num_samples, dec_filtstate_,
+                     WEBRTC_CNG_MAX_LPC_ORDER, dec_filtstateLow_,
+                     WEBRTC_CNG_MAX_LPC_ORDER, out_data.data(), low,
+                     num_samples);
 
   return true;
 }
@@ -239,7 +254,6 @@ size_t ComfortNoiseEncoder::Encode(rtc::ArrayView<const int16_t> speech,
   int16_t arCoefs[WEBRTC_CNG_MAX_LPC_ORDER + 1];
   int32_t corrVector[WEBRTC_CNG_MAX_LPC_ORDER + 1];
   int16_t refCs[WEBRTC_CNG_MAX_LPC_ORDER + 1];
-  int16_t hanningW[kCngMaxOutsizeOrder];
   int16_t ReflBeta = 19661;     /* 0.6 in q15. */
   int16_t ReflBetaComp = 13107; /* 0.4 in q15. */
   int32_t outEnergy;
@@ -280,13 +294,16 @@ size_t ComfortNoiseEncoder::Encode(rtc::ArrayView<const int16_t> speech,
   outEnergy = WebRtcSpl_DivW32W16(outEnergy, (int16_t)factor);
 
   if (outEnergy > 1) {
-    /* Create Hanning Window. */
-    WebRtcSpl_GetHanningWindow(hanningW, num_samples / 2);
-    for (i = 0; i < (num_samples / 2); i++)
-      hanningW[num_samples - i - 1] = hanningW[i];
+    /* Create Hanning Window, unless the block size is unchanged. */
+    if (enc_hanningW_.size() != num_samples) {
+      enc_hanningW_.resize(num_samples);
+      WebRtcSpl_GetHanningWindow(enc_hanningW_.data(), num_samples / 2);
+      for (i = 0; i < (num_samples / 2); i++)
+        enc_hanningW_[num_samples - i - 1] = enc_hanningW_[i];
+    }
 
-    WebRtcSpl_ElementwiseVectorMult(speechBuf, hanningW, speechBuf, num_samples,
-                                    14);
+    WebRtcSpl_ElementwiseVectorMult(speechBuf, enc_hanningW_.data(), speechBuf,
+                                    num_samples, 14);
 
     WebRtcSpl_AutoCorrelation(speechBuf, num_samples, enc_nrOfCoefs_,
                               corrVector, &acorrScale);
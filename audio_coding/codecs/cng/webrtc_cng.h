@@ -14,6 +14,7 @@
 #include <stdint.h>
 
 #include <cstddef>
+#include <vector>
 
 #include "api/array_view.h"
 #include "rtc_base/buffer.h"
@@ -56,6 +57,16 @@ class ComfortNoiseDecoder {
   uint16_t dec_order_;
   int16_t dec_target_scale_factor_; /* Q29 */
   int16_t dec_used_scale_factor_;   /* Q29 */
+
+  // Filter parameters derived from |dec_used_reflCoefs_| and
+  // |dec_used_energy_| by the last Generate() call. The used values converge
+  // to those of the last SID, after which the parameters are reused as is.
+  bool dec_params_valid_;
+  int16_t dec_params_reflCoefs_[WEBRTC_CNG_MAX_LPC_ORDER + 1];
+  int16_t dec_params_lpPoly_[WEBRTC_CNG_MAX_LPC_ORDER + 1]; /* Q12 */
+  int16_t dec_params_filter_gain_;
+  int32_t dec_params_energy_;
+  int32_t dec_params_sqrt_energy_;
 };
 
 class ComfortNoiseEncoder {
@@ -92,6 +103,8 @@ class ComfortNoiseEncoder {
   int16_t enc_reflCoefs_[WEBRTC_CNG_MAX_LPC_ORDER + 1];
   int32_t enc_corrVector_[WEBRTC_CNG_MAX_LPC_ORDER + 1];
   uint32_t enc_seed_;
+  // Hanning window for the size of the last encoded block.
+  std::vector<int16_t> enc_hanningW_;
 };
 
 }  // namespace webrtc
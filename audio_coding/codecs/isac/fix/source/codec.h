@@ -20,6 +20,7 @@
 #define MODULES_AUDIO_CODING_CODECS_ISAC_FIX_SOURCE_CODEC_H_
 
 #include "modules/audio_coding/codecs/isac/fix/source/structs.h"
+#include "rtc_base/system/arch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -173,6 +174,14 @@ void WebRtcIsacfix_FilterMaLoopNeon(int16_t input0,
                                     int32_t* ptr2);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int WebRtcIsacfix_AutocorrSse2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t N,
+                               int16_t order,
+                               int16_t* __restrict scale);
+#endif
+
 #if defined(MIPS32_LE)
 int WebRtcIsacfix_AutocorrMIPS(int32_t* __restrict r,
                                const int16_t* __restrict x,
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Contains a function for WebRtcIsacfix_AllpassFilter2FixDec16Sse2()
+// in iSAC codec, optimized for x86 SSE2. Bit exact with function
+// WebRtcIsacfix_AllpassFilter2FixDec16C() in filterbanks.c.
+//
+// The four 32-bit lanes hold the two allpass sections of both channels:
+// {channel 1 section 0, channel 1 section 1, channel 2 section 0,
+// channel 2 section 1}. Section 1 runs one sample behind section 0, so that
+// all four lanes can be updated in the same step.
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/filterbank_internal.h"
+#include "rtc_base/checks.h"
+
+// Same as WebRtcSpl_AddSatW32() on each lane.
+static __m128i AddSatW32(__m128i a, __m128i b) {
+  const __m128i sum = _mm_add_epi32(a, b);
+  const __m128i overflow = _mm_srai_epi32(
+      _mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31);
+  const __m128i saturated =
+      _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7FFFFFFF));
+  return _mm_or_si128(_mm_and_si128(overflow, saturated),
+                      _mm_andnot_si128(overflow, sum));
+}
+
+// Runs one step of all four allpass sections. |factor| holds the Q15 factors
+// in the low 16 bits of each lane, and |data| the Q0 inputs sign-extended to
+// 32 bits. Returns the Q0 outputs, sign-extended to 32 bits.
+static __m128i AllpassStep(__m128i factor, __m128i data, __m128i* state) {
+  // Only the low halves of the lanes contribute, since the high halves of
+  // |factor| are zero.
+  const __m128i a = _mm_slli_epi32(_mm_madd_epi16(factor, data), 1);  // Q16
+  const __m128i b = AddSatW32(a, *state);                               // Q16
+  const __m128i out = _mm_srai_epi32(b, 16);                            // Q0
+  const __m128i c = _mm_sub_epi32(
+      _mm_setzero_si128(), _mm_slli_epi32(_mm_madd_epi16(factor, out), 1));
+  *state = AddSatW32(c, _mm_slli_epi32(data, 16));  // Q16
+  return out;
+}
+
+void WebRtcIsacfix_AllpassFilter2FixDec16Sse2(
+    int16_t* data_ch1,  // Input and output in channel 1, in Q0
+    int16_t* data_ch2,  // Input and output in channel 2, in Q0
+    const int16_t* factor_ch1,  // Scaling factor for channel 1, in Q15
+    const int16_t* factor_ch2,  // Scaling factor for channel 2, in Q15
+    const int length,  // Length of the data buffers
+    int32_t* filter_state_ch1,  // Filter state for channel 1, in Q16
+    int32_t* filter_state_ch2) {  // Filter state for channel 2, in Q16
+  RTC_DCHECK_EQ(0, length % 2);
+  // Selects the section 1 lanes.
+  const __m128i kSection1Mask = _mm_set_epi32(-1, 0, -1, 0);
+  const __m128i factor = _mm_set_epi32(
+      (uint16_t)factor_ch2[1], (uint16_t)factor_ch2[0],
+      (uint16_t)factor_ch1[1], (uint16_t)factor_ch1[0]);
+  __m128i state = _mm_set_epi32(filter_state_ch2[1], filter_state_ch2[0],
+                                filter_state_ch1[1], filter_state_ch1[0]);
+  __m128i data;
+  __m128i out;
+  __m128i new_state;
+  int n = 0;
+
+  // Section 0 alone filters the first sample.
+  data = _mm_set_epi32(0, data_ch2[0], 0, data_ch1[0]);
+  new_state = state;
+  out = AllpassStep(factor, data, &new_state);
+  state = _mm_or_si128(_mm_and_si128(kSection1Mask, state),
+                       _mm_andnot_si128(kSection1Mask, new_state));
+
+  for (n = 1; n < length; n++) {
+    // Section 1 takes the previous output of section 0.
+    data = _mm_or_si128(_mm_slli_epi64(out, 32),
+                        _mm_set_epi32(0, data_ch2[n], 0, data_ch1[n]));
+    out = AllpassStep(factor, data, &state);
+    data_ch1[n - 1] = (int16_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 4));
+    data_ch2[n - 1] = (int16_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 12));
+  }
+
+  // Section 1 alone filters the last sample.
+  data = _mm_slli_epi64(out, 32);
+  new_state = state;
+  out = AllpassStep(factor, data, &new_state);
+  state = _mm_or_si128(_mm_and_si128(kSection1Mask, new_state),
+                       _mm_andnot_si128(kSection1Mask, state));
+  data_ch1[length - 1] = (int16_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 4));
+  data_ch2[length - 1] = (int16_t)_mm_cvtsi128_si32(_mm_srli_si128(out, 12));
+
+  filter_state_ch1[0] = _mm_cvtsi128_si32(state);
+  filter_state_ch1[1] = _mm_cvtsi128_si32(_mm_srli_si128(state, 4));
+  filter_state_ch2[0] = _mm_cvtsi128_si32(_mm_srli_si128(state, 8));
+  filter_state_ch2[1] = _mm_cvtsi128_si32(_mm_srli_si128(state, 12));
+}
@@ -67,6 +67,11 @@ TEST_F(FilterBanksTest, AllpassFilter2FixDec16Test) {
 #if defined(WEBRTC_HAS_NEON)
   CalculateResidualEnergyTester(WebRtcIsacfix_AllpassFilter2FixDec16Neon);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    CalculateResidualEnergyTester(WebRtcIsacfix_AllpassFilter2FixDec16Sse2);
+  }
+#endif
 }
 
 TEST_F(FilterBanksTest, HighpassFilterFixDec32Test) {
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/isac/fix/source/codec.h"
+#include "rtc_base/checks.h"
+
+// Returns the sum of x[j] * y[j] for 0 <= j < length, accumulated in 64 bits.
+static int64_t DotProductSse2(const int16_t* x,
+                              const int16_t* y,
+                              int length) {
+  const __m128i kMin = _mm_set1_epi32((int32_t)0x80000000);
+  __m128i acc_low = _mm_setzero_si128();
+  __m128i acc_high = _mm_setzero_si128();
+  int64_t acc[2];
+  int64_t prod = 0;
+  int j = 0;
+
+  for (; j + 8 <= length; j += 8) {
+    const __m128i x_v = _mm_loadu_si128((const __m128i*)(x + j));
+    const __m128i y_v = _mm_loadu_si128((const __m128i*)(y + j));
+    // Each lane is the sum of two products. It only overflows to INT32_MIN
+    // when both products are (-32768)^2; the sign is corrected for that case
+    // before the lanes are widened to 64 bits.
+    const __m128i sum_v = _mm_madd_epi16(x_v, y_v);
+    const __m128i sign_v = _mm_andnot_si128(_mm_cmpeq_epi32(sum_v, kMin),
+                                            _mm_srai_epi32(sum_v, 31));
+    acc_low = _mm_add_epi64(acc_low, _mm_unpacklo_epi32(sum_v, sign_v));
+    acc_high = _mm_add_epi64(acc_high, _mm_unpackhi_epi32(sum_v, sign_v));
+  }
+  _mm_storeu_si128((__m128i*)acc, _mm_add_epi64(acc_low, acc_high));
+  prod = acc[0] + acc[1];
+
+  for (; j < length; j++) {
+    prod += x[j] * y[j];
+  }
+  return prod;
+}
+
+// Autocorrelation function in fixed point. Bit exact with
+// WebRtcIsacfix_AutocorrC().
+int WebRtcIsacfix_AutocorrSse2(int32_t* __restrict r,
+                               const int16_t* __restrict x,
+                               int16_t N,
+                               int16_t order,
+                               int16_t* __restrict scale) {
+  int i = 0;
+  int16_t scaling = 0;
+  uint32_t temp = 0;
+  int64_t prod = 0;
+
+  RTC_DCHECK_EQ(0, N % 4);
+  RTC_DCHECK_GE(N, 8);
+
+  // Calculate r[0].
+  prod = DotProductSse2(x, x, N);
+
+  // Calculate scaling (the value of shifting).
+  temp = (uint32_t)(prod >> 31);
+  scaling = temp ? 32 - WebRtcSpl_NormU32(temp) : 0;
+  r[0] = (int32_t)(prod >> scaling);
+
+  // Perform the actual correlation calculation.
+  for (i = 1; i < order + 1; i++) {
+    prod = DotProductSse2(x, x + i, N - i);
+    r[i] = (int32_t)(prod >> scaling);
+  }
+
+  *scale = scaling;
+
+  return order + 1;
+}
@@ -65,4 +65,9 @@ TEST_F(FiltersTest, AutocorrFixTest) {
 #if defined(WEBRTC_HAS_NEON)
   FiltersTester(WebRtcIsacfix_AutocorrNeon);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    FiltersTester(WebRtcIsacfix_AutocorrSse2);
+  }
+#endif
 }
@@ -170,6 +170,20 @@ static void WebRtcIsacfix_InitNeon(void) {
 }
 #endif
 
+/****************************************************************************
+ * WebRtcIsacfix_InitSse2(...)
+ *
+ * This function initializes function pointers for x86 platforms with SSE2.
+ */
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+static void WebRtcIsacfix_InitSse2(void) {
+  WebRtcIsacfix_AutocorrFix = WebRtcIsacfix_AutocorrSse2;
+  WebRtcIsacfix_AllpassFilter2FixDec16 =
+      WebRtcIsacfix_AllpassFilter2FixDec16Sse2;
+}
+#endif
+
 /****************************************************************************
  * WebRtcIsacfix_InitMIPS(...)
  *
@@ -213,6 +227,12 @@ static void InitFunctionPointers(void) {
   WebRtcIsacfix_InitNeon();
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcIsacfix_InitSse2();
+  }
+#endif
+
 #if defined(MIPS32_LE)
   WebRtcIsacfix_InitMIPS();
 #endif
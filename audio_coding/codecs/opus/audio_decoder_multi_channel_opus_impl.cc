@@ -18,16 +18,45 @@
 
 #include "absl/memory/memory.h"
 #include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
+#include "rtc_base/arraysize.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/string_to_number.h"
 
 namespace webrtc {
 
+namespace {
+
+// Maximum number of samples per channel in one Opus packet: 120 ms at 48 kHz.
+constexpr size_t kMaxSamplesPerChannel = 5760;
+
+// Position of each channel for a given channel count, in Vorbis order. 'L'
+// and 'R' channels go to the left and right output, 'C' channels go to both
+// at half the weight, and the LFE channel ('E') is dropped.
+const char* const kChannelPositions[] = {
+    "C", "LR", "LCR", "LRLR", "LCRLR", "LCRLRE", "LCRLRCE", "LCRLRLRE",
+};
+
+}  // namespace
+
 std::unique_ptr<AudioDecoderMultiChannelOpusImpl>
 AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(
     AudioDecoderMultiChannelOpusConfig config) {
+  const size_t num_channels = config.num_channels;
+  return MakeAudioDecoder(std::move(config), num_channels);
+}
+
+std::unique_ptr<AudioDecoderMultiChannelOpusImpl>
+AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(
+    AudioDecoderMultiChannelOpusConfig config,
+    size_t num_output_channels) {
   if (!config.IsOk()) {
     return nullptr;
   }
+  if (num_output_channels != config.num_channels &&
+      (num_output_channels < 1 || num_output_channels > 2 ||
+       config.num_channels > arraysize(kChannelPositions))) {
+    return nullptr;
+  }
   // Fill the pointer with a working decoder through the C interface. This
   // allocates memory.
   OpusDecInst* dec_state = nullptr;
@@ -41,14 +70,21 @@ AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(
   // Pass the ownership to DecoderImpl. Not using 'make_unique' because the
   // c-tor is private.
   return std::unique_ptr<AudioDecoderMultiChannelOpusImpl>(
-      new AudioDecoderMultiChannelOpusImpl(dec_state, config));
+      new AudioDecoderMultiChannelOpusImpl(dec_state, config,
+                                           num_output_channels));
 }
 
 AudioDecoderMultiChannelOpusImpl::AudioDecoderMultiChannelOpusImpl(
     OpusDecInst* dec_state,
-    AudioDecoderMultiChannelOpusConfig config)
-    : dec_state_(dec_state), config_(config) {
+    AudioDecoderMultiChannelOpusConfig config,
+    size_t num_output_channels)
+    : dec_state_(dec_state),
+      config_(config),
+      num_output_channels_(num_output_channels) {
   RTC_DCHECK(dec_state);
+  if (num_output_channels_ != config_.num_channels) {
+    decode_buffer_.resize(kMaxSamplesPerChannel * config_.num_channels);
+  }
   WebRtcOpus_DecoderInit(dec_state_);
 }
 
@@ -108,11 +144,17 @@ int AudioDecoderMultiChannelOpusImpl::DecodeInternal(const uint8_t* encoded,
                                                      SpeechType* speech_type) {
   RTC_DCHECK_EQ(sample_rate_hz, 48000);
   int16_t temp_type = 1;  // Default is speech.
-  int ret =
-      WebRtcOpus_Decode(dec_state_, encoded, encoded_len, decoded, &temp_type);
-  if (ret > 0)
+  const bool downmix = !decode_buffer_.empty();
+  int ret = WebRtcOpus_Decode(dec_state_, encoded, encoded_len,
+                              downmix ? decode_buffer_.data() : decoded,
+                              &temp_type);
+  if (ret > 0) {
+    if (downmix) {
+      Downmix(ret, decoded);
+    }
     ret *= static_cast<int>(
-        config_.num_channels);  // Return total number of samples.
+        num_output_channels_);  // Return total number of samples.
+  }
   *speech_type = ConvertSpeechType(temp_type);
   return ret;
 }
@@ -131,15 +173,65 @@ int AudioDecoderMultiChannelOpusImpl::DecodeRedundantInternal(
 
   RTC_DCHECK_EQ(sample_rate_hz, 48000);
   int16_t temp_type = 1;  // Default is speech.
-  int ret = WebRtcOpus_DecodeFec(dec_state_, encoded, encoded_len, decoded,
+  const bool downmix = !decode_buffer_.empty();
+  int ret = WebRtcOpus_DecodeFec(dec_state_, encoded, encoded_len,
+                                 downmix ? decode_buffer_.data() : decoded,
                                  &temp_type);
-  if (ret > 0)
+  if (ret > 0) {
+    if (downmix) {
+      Downmix(ret, decoded);
+    }
     ret *= static_cast<int>(
-        config_.num_channels);  // Return total number of samples.
+        num_output_channels_);  // Return total number of samples.
+  }
   *speech_type = ConvertSpeechType(temp_type);
   return ret;
 }
 
+void AudioDecoderMultiChannelOpusImpl::Downmix(size_t samples_per_channel,
+                                               int16_t* output) const {
+  RTC_DCHECK_LE(samples_per_channel, kMaxSamplesPerChannel);
+  const size_t num_channels = config_.num_channels;
+  const char* const positions = kChannelPositions[num_channels - 1];
+  // Weights in Q1 for each output channel, normalized so that a signal
+  // present in all input channels keeps its level.
+  int weights[2][8] = {};
+  int weight_sums[2] = {};
+  for (size_t c = 0; c < num_channels; ++c) {
+    for (size_t k = 0; k < num_output_channels_; ++k) {
+      int weight = 0;
+      switch (positions[c]) {
+        case 'L':
+          weight = (num_output_channels_ == 1 || k == 0) ? 2 : 0;
+          break;
+        case 'R':
+          weight = (num_output_channels_ == 1 || k == 1) ? 2 : 0;
+          break;
+        case 'C':
+          weight = num_output_channels_ == 1 ? 2 : 1;
+          break;
+        default:  // LFE.
+          break;
+      }
+      weights[k][c] = weight;
+      weight_sums[k] += weight;
+    }
+  }
+
+  const int16_t* input = decode_buffer_.data();
+  for (size_t i = 0; i < samples_per_channel; ++i) {
+    for (size_t k = 0; k < num_output_channels_; ++k) {
+      int32_t sum = 0;
+      for (size_t c = 0; c < num_channels; ++c) {
+        sum += weights[k][c] * input[c];
+      }
+      output[k] = rtc::saturated_cast<int16_t>(sum / weight_sums[k]);
+    }
+    input += num_channels;
+    output += num_output_channels_;
+  }
+}
+
 void AudioDecoderMultiChannelOpusImpl::Reset() {
   WebRtcOpus_DecoderInit(dec_state_);
 }
@@ -172,7 +264,7 @@ int AudioDecoderMultiChannelOpusImpl::SampleRateHz() const {
 }
 
 size_t AudioDecoderMultiChannelOpusImpl::Channels() const {
-  return config_.num_channels;
+  return num_output_channels_;
 }
 
 }  // namespace webrtc
@@ -30,6 +30,16 @@ class AudioDecoderMultiChannelOpusImpl final : public AudioDecoder {
   static std::unique_ptr<AudioDecoderMultiChannelOpusImpl> MakeAudioDecoder(
       AudioDecoderMultiChannelOpusConfig config);
 
+  // Creates a decoder that downmixes the decoded audio to
+  // |num_output_channels|, which must be 1 or 2, or the number of channels in
+  // |config|. This is intended for mixers that consume fewer channels than
+  // the stream has: the downmix happens before NetEq, so that the signal
+  // processing in NetEq only runs on the output channels. The channels are
+  // assumed to be in Vorbis order, as for the surround formats.
+  static std::unique_ptr<AudioDecoderMultiChannelOpusImpl> MakeAudioDecoder(
+      AudioDecoderMultiChannelOpusConfig config,
+      size_t num_output_channels);
+
   ~AudioDecoderMultiChannelOpusImpl() override;
 
   std::vector<ParseResult> ParsePayload(rtc::Buffer&& payload,
@@ -59,10 +69,19 @@ class AudioDecoderMultiChannelOpusImpl final : public AudioDecoder {
 
  private:
   AudioDecoderMultiChannelOpusImpl(OpusDecInst* dec_state,
-                                   AudioDecoderMultiChannelOpusConfig config);
+                                   AudioDecoderMultiChannelOpusConfig config,
+                                   size_t num_output_channels);
+
+  // Downmixes |samples_per_channel| samples from |decode_buffer_| into
+  // |output|.
+  void Downmix(size_t samples_per_channel, int16_t* output) const;
 
   OpusDecInst* dec_state_;
   const AudioDecoderMultiChannelOpusConfig config_;
+  const size_t num_output_channels_;
+  // Holds all decoded channels before the downmix. Only used when
+  // downmixing.
+  std::vector<int16_t> decode_buffer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioDecoderMultiChannelOpusImpl);
 };
 
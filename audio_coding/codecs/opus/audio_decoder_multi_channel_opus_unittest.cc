@@ -10,7 +10,12 @@
 
 #include "api/audio_codecs/opus/audio_decoder_multi_channel_opus.h"
 
+#include <math.h>
+
+#include "api/audio_codecs/opus/audio_encoder_multi_channel_opus.h"
 #include "modules/audio_coding/codecs/opus/audio_coder_opus_common.h"
+#include "modules/audio_coding/codecs/opus/audio_decoder_multi_channel_opus_impl.h"
+#include "rtc_base/buffer.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -157,4 +162,87 @@ TEST(AudioDecoderMultiOpusTest, AdvertisedCodecsCanBeCreated) {
     EXPECT_TRUE(opus_decoder);
   }
 }
+
+TEST(AudioDecoderMultiOpusTest, DownmixesToOutputChannels) {
+  const SdpAudioFormat sdp_format("multiopus", 48000, 6,
+                                  {{"channel_mapping", "0,4,1,2,3,5"},
+                                   {"coupled_streams", "2"},
+                                   {"num_streams", "4"}});
+  const absl::optional<AudioEncoderMultiChannelOpus::Config> encoder_config =
+      AudioEncoderMultiChannelOpus::SdpToConfig(sdp_format);
+  ASSERT_TRUE(encoder_config.has_value());
+  const std::unique_ptr<AudioEncoder> encoder =
+      AudioEncoderMultiChannelOpus::MakeAudioEncoder(*encoder_config, 120);
+  ASSERT_TRUE(encoder);
+  const absl::optional<AudioDecoderMultiChannelOpus::Config> decoder_config =
+      AudioDecoderMultiChannelOpus::SdpToConfig(sdp_format);
+  ASSERT_TRUE(decoder_config.has_value());
+
+  const auto full_decoder =
+      AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(*decoder_config);
+  const auto mono_decoder =
+      AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(*decoder_config, 1);
+  const auto stereo_decoder =
+      AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(*decoder_config, 2);
+  ASSERT_TRUE(full_decoder);
+  ASSERT_TRUE(mono_decoder);
+  ASSERT_TRUE(stereo_decoder);
+  EXPECT_EQ(6u, full_decoder->Channels());
+  EXPECT_EQ(1u, mono_decoder->Channels());
+  EXPECT_EQ(2u, stereo_decoder->Channels());
+  EXPECT_FALSE(
+      AudioDecoderMultiChannelOpusImpl::MakeAudioDecoder(*decoder_config, 3));
+
+  constexpr size_t kSamplesPer10Ms = 480;
+  constexpr size_t kMaxSamples = 5760 * 6;
+  std::vector<int16_t> input(kSamplesPer10Ms * 6);
+  std::vector<int16_t> full(kMaxSamples);
+  std::vector<int16_t> mono(kMaxSamples);
+  std::vector<int16_t> stereo(kMaxSamples);
+  uint32_t rtp_timestamp = 0;
+  size_t n = 0;
+  for (int block = 0; block < 100; ++block) {
+    for (size_t i = 0; i < kSamplesPer10Ms; ++i, ++n) {
+      for (size_t c = 0; c < 6; ++c) {
+        input[i * 6 + c] = static_cast<int16_t>(
+            4000 * sin(2 * M_PI * (300.0 + 100 * c) * n / 48000));
+      }
+    }
+    rtc::Buffer encoded;
+    encoder->Encode(rtp_timestamp, input, &encoded);
+    rtp_timestamp += kSamplesPer10Ms;
+    if (encoded.empty()) {
+      continue;
+    }
+    AudioDecoder::SpeechType speech_type;
+    const int full_samples =
+        full_decoder->Decode(encoded.data(), encoded.size(), 48000,
+                             full.size() * sizeof(int16_t), full.data(),
+                             &speech_type);
+    const int mono_samples =
+        mono_decoder->Decode(encoded.data(), encoded.size(), 48000,
+                             mono.size() * sizeof(int16_t), mono.data(),
+                             &speech_type);
+    const int stereo_samples =
+        stereo_decoder->Decode(encoded.data(), encoded.size(), 48000,
+                               stereo.size() * sizeof(int16_t), stereo.data(),
+                               &speech_type);
+    ASSERT_GT(full_samples, 0);
+    const int samples_per_channel = full_samples / 6;
+    ASSERT_EQ(samples_per_channel, mono_samples);
+    ASSERT_EQ(2 * samples_per_channel, stereo_samples);
+
+    // Channels in Vorbis order: FL, C, FR, RL, RR, LFE.
+    for (int i = 0; i < samples_per_channel; ++i) {
+      const int16_t* frame = &full[i * 6];
+      EXPECT_NEAR((frame[0] + frame[1] + frame[2] + frame[3] + frame[4]) / 5,
+                  mono[i], 1);
+      EXPECT_NEAR((2 * frame[0] + frame[1] + 2 * frame[3]) / 5, stereo[2 * i],
+                  1);
+      EXPECT_NEAR((frame[1] + 2 * frame[2] + 2 * frame[4]) / 5,
+                  stereo[2 * i + 1], 1);
+    }
+  }
+}
+
 }  // namespace webrtc
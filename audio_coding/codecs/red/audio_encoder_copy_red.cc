@@ -25,8 +25,11 @@ AudioEncoderCopyRed::Config::~Config() = default;
 
 AudioEncoderCopyRed::AudioEncoderCopyRed(Config&& config)
     : speech_encoder_(std::move(config.speech_encoder)),
-      red_payload_type_(config.payload_type) {
+      red_payload_type_(config.payload_type),
+      redundant_payloads_(config.num_redundant_payloads),
+      newest_payload_(0) {
   RTC_CHECK(speech_encoder_) << "Speech encoder not provided.";
+  RTC_CHECK_GT(config.num_redundant_payloads, 0);
 }
 
 AudioEncoderCopyRed::~AudioEncoderCopyRed() = default;
@@ -55,6 +58,14 @@ int AudioEncoderCopyRed::GetTargetBitrate() const {
   return speech_encoder_->GetTargetBitrate();
 }
 
+const AudioEncoderCopyRed::RedundantPayload& AudioEncoderCopyRed::Redundant(
+    size_t k) const {
+  const size_t num_payloads = redundant_payloads_.size();
+  RTC_DCHECK_LT(k, num_payloads);
+  return redundant_payloads_[(newest_payload_ + num_payloads - k) %
+                             num_payloads];
+}
+
 AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
     uint32_t rtp_timestamp,
     rtc::ArrayView<const int16_t> audio,
@@ -71,15 +82,28 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
     // intentional.
     info.redundant.push_back(info);
     RTC_DCHECK_EQ(info.redundant.size(), 1);
-    if (secondary_info_.encoded_bytes > 0) {
-      encoded->AppendData(secondary_encoded_);
-      info.redundant.push_back(secondary_info_);
-      RTC_DCHECK_EQ(info.redundant.size(), 2);
+    // Append the previous encodings, newest first. The ring is filled in
+    // order, so the first empty one ends the history.
+    const size_t num_payloads = redundant_payloads_.size();
+    size_t num_redundant = 0;
+    size_t redundant_bytes = 0;
+    while (num_redundant < num_payloads &&
+           Redundant(num_redundant).info.encoded_bytes > 0) {
+      redundant_bytes += Redundant(num_redundant).encoded.size();
+      ++num_redundant;
     }
-    // Save primary to secondary.
-    secondary_encoded_.SetData(encoded->data() + primary_offset,
-                               info.encoded_bytes);
-    secondary_info_ = info;
+    encoded->EnsureCapacity(encoded->size() + redundant_bytes);
+    for (size_t k = 0; k < num_redundant; ++k) {
+      const RedundantPayload& payload = Redundant(k);
+      encoded->AppendData(payload.encoded);
+      info.redundant.push_back(payload.info);
+    }
+    // Save primary in place of the oldest encoding.
+    newest_payload_ = (newest_payload_ + 1) % num_payloads;
+    RedundantPayload& primary = redundant_payloads_[newest_payload_];
+    primary.encoded.SetData(encoded->data() + primary_offset,
+                            info.encoded_bytes);
+    primary.info = info;
     RTC_DCHECK_EQ(info.speech, info.redundant[0].speech);
   }
   // Update main EncodedInfo.
@@ -94,8 +118,11 @@ AudioEncoder::EncodedInfo AudioEncoderCopyRed::EncodeImpl(
 
 void AudioEncoderCopyRed::Reset() {
   speech_encoder_->Reset();
-  secondary_encoded_.Clear();
-  secondary_info_.encoded_bytes = 0;
+  for (RedundantPayload& payload : redundant_payloads_) {
+    payload.encoded.Clear();
+    payload.info.encoded_bytes = 0;
+  }
+  newest_payload_ = 0;
 }
 
 bool AudioEncoderCopyRed::SetFec(bool enable) {
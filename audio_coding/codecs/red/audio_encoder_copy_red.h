@@ -15,6 +15,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/array_view.h"
@@ -26,8 +27,9 @@ namespace webrtc {
 
 // This class implements redundant audio coding. The class object will have an
 // underlying AudioEncoder object that performs the actual encodings. The
-// current class will gather the two latest encodings from the underlying codec
-// into one packet.
+// current class will gather the latest encoding and the
+// |num_redundant_payloads| preceding ones from the underlying codec into one
+// packet.
 class AudioEncoderCopyRed final : public AudioEncoder {
  public:
   struct Config {
@@ -36,6 +38,8 @@ class AudioEncoderCopyRed final : public AudioEncoder {
     ~Config();
     int payload_type;
     std::unique_ptr<AudioEncoder> speech_encoder;
+    // Number of previous encodings repeated in each packet.
+    size_t num_redundant_payloads = 1;
   };
 
   explicit AudioEncoderCopyRed(Config&& config);
@@ -69,10 +73,21 @@ class AudioEncoderCopyRed final : public AudioEncoder {
                          rtc::Buffer* encoded) override;
 
  private:
+  struct RedundantPayload {
+    rtc::Buffer encoded;
+    EncodedInfoLeaf info;
+  };
+
+  // Returns the |k|th latest encoding, where 0 is the newest one.
+  const RedundantPayload& Redundant(size_t k) const;
+
   std::unique_ptr<AudioEncoder> speech_encoder_;
   int red_payload_type_;
-  rtc::Buffer secondary_encoded_;
-  EncodedInfoLeaf secondary_info_;
+  // Ring of the latest encodings, with the newest at |newest_payload_|. The
+  // oldest one is overwritten in place, so that the buffers are reused and no
+  // payload is moved when a new one is added.
+  std::vector<RedundantPayload> redundant_payloads_;
+  size_t newest_payload_;
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioEncoderCopyRed);
 };
 
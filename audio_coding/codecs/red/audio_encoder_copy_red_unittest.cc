@@ -179,6 +179,54 @@ TEST_F(AudioEncoderCopyRedTest, CheckPayloadSizes) {
   }
 }
 
+// Checks that the configured number of previous payloads is repeated, newest
+// first, and that Reset() drops them.
+TEST_F(AudioEncoderCopyRedTest, CheckMultipleRedundantPayloads) {
+  mock_encoder_ = new MockAudioEncoder;
+  AudioEncoderCopyRed::Config config;
+  config.payload_type = red_payload_type_;
+  config.speech_encoder = std::unique_ptr<AudioEncoder>(mock_encoder_);
+  config.num_redundant_payloads = 2;
+  red_.reset(new AudioEncoderCopyRed(std::move(config)));
+  EXPECT_CALL(*mock_encoder_, NumChannels()).WillRepeatedly(Return(1U));
+  EXPECT_CALL(*mock_encoder_, SampleRateHz())
+      .WillRepeatedly(Return(sample_rate_hz_));
+  EXPECT_CALL(*mock_encoder_, Reset());
+
+  // Let the mock encoder return payload sizes 1, 2, 3, ..., 10 for the sequence
+  // of calls, and then 11 after the reset.
+  static const int kNumPackets = 10;
+  {
+    InSequence s;
+    for (int encode_size = 1; encode_size <= kNumPackets + 1; ++encode_size) {
+      EXPECT_CALL(*mock_encoder_, EncodeImpl(_, _, _))
+          .WillOnce(Invoke(MockAudioEncoder::FakeEncoding(encode_size)));
+    }
+  }
+
+  Encode();
+  EXPECT_EQ(1u, encoded_info_.redundant.size());
+  Encode();
+  ASSERT_EQ(2u, encoded_info_.redundant.size());
+  EXPECT_EQ(2u, encoded_info_.redundant[0].encoded_bytes);
+  EXPECT_EQ(1u, encoded_info_.redundant[1].encoded_bytes);
+
+  for (size_t i = 3; i <= kNumPackets; ++i) {
+    Encode();
+    ASSERT_EQ(3u, encoded_info_.redundant.size());
+    EXPECT_EQ(i, encoded_info_.redundant[0].encoded_bytes);
+    EXPECT_EQ(i - 1, encoded_info_.redundant[1].encoded_bytes);
+    EXPECT_EQ(i - 2, encoded_info_.redundant[2].encoded_bytes);
+    EXPECT_EQ(3 * i - 3, encoded_info_.encoded_bytes);
+    EXPECT_EQ(3 * i - 3, encoded_.size());
+  }
+
+  red_->Reset();
+  Encode();
+  ASSERT_EQ(1u, encoded_info_.redundant.size());
+  EXPECT_EQ(kNumPackets + 1u, encoded_info_.encoded_bytes);
+}
+
 // Checks that the correct timestamps are returned.
 TEST_F(AudioEncoderCopyRedTest, CheckTimestamps) {
   uint32_t primary_timestamp = timestamp_;
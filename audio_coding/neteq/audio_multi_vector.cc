@@ -13,27 +13,32 @@
 #include <assert.h>
 
 #include <algorithm>
+#include <memory>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-AudioMultiVector::AudioMultiVector(size_t N) {
-  assert(N > 0);
-  if (N < 1)
-    N = 1;
-  for (size_t n = 0; n < N; ++n) {
-    channels_.push_back(new AudioVector);
-  }
-  num_channels_ = N;
+namespace {
+// Same as the initial capacity of a default constructed AudioVector.
+constexpr size_t kDefaultInitialSize = 10;
+}  // namespace
+
+AudioMultiVector::AudioMultiVector(size_t N)
+    : AudioMultiVector(N, kDefaultInitialSize) {
+  Clear();
 }
 
 AudioMultiVector::AudioMultiVector(size_t N, size_t initial_size) {
   assert(N > 0);
   if (N < 1)
     N = 1;
+  // All channels share one planar allocation, see |storage_|.
+  channel_capacity_ = initial_size + 1;
+  storage_.reset(new int16_t[N * channel_capacity_]);
   for (size_t n = 0; n < N; ++n) {
-    channels_.push_back(new AudioVector(initial_size));
+    channels_.push_back(
+        new AudioVector(initial_size, &storage_[n * channel_capacity_]));
   }
   num_channels_ = N;
 }
@@ -53,6 +58,8 @@ void AudioMultiVector::Clear() {
 }
 
 void AudioMultiVector::Zeros(size_t length) {
+  Clear();
+  Reserve(length);
   for (size_t i = 0; i < num_channels_; ++i) {
     channels_[i]->Clear();
     channels_[i]->Extend(length);
@@ -61,6 +68,7 @@ void AudioMultiVector::Zeros(size_t length) {
 
 void AudioMultiVector::CopyTo(AudioMultiVector* copy_to) const {
   if (copy_to) {
+    copy_to->Reserve(Size());
     for (size_t i = 0; i < num_channels_; ++i) {
       channels_[i]->CopyTo(&(*copy_to)[i]);
     }
@@ -70,29 +78,24 @@ void AudioMultiVector::CopyTo(AudioMultiVector* copy_to) const {
 void AudioMultiVector::PushBackInterleaved(
     rtc::ArrayView<const int16_t> append_this) {
   RTC_DCHECK_EQ(append_this.size() % num_channels_, 0);
+  const size_t length_per_channel = append_this.size() / num_channels_;
+  Reserve(Size() + length_per_channel);
   if (num_channels_ == 1) {
     // Special case to avoid extra allocation and data shuffling.
     channels_[0]->PushBack(append_this.data(), append_this.size());
     return;
   }
-  size_t length_per_channel = append_this.size() / num_channels_;
-  int16_t* temp_array = new int16_t[length_per_channel];  // Temporary storage.
+  // Deinterleave directly into each channel, without temporary storage.
   for (size_t channel = 0; channel < num_channels_; ++channel) {
-    // Copy elements to |temp_array|.
-    // Set |source_ptr| to first element of this channel.
-    const int16_t* source_ptr = &append_this[channel];
-    for (size_t i = 0; i < length_per_channel; ++i) {
-      temp_array[i] = *source_ptr;
-      source_ptr += num_channels_;  // Jump to next element of this channel.
-    }
-    channels_[channel]->PushBack(temp_array, length_per_channel);
+    channels_[channel]->PushBackStrided(&append_this[channel],
+                                        length_per_channel, num_channels_);
   }
-  delete[] temp_array;
 }
 
 void AudioMultiVector::PushBack(const AudioMultiVector& append_this) {
   assert(num_channels_ == append_this.num_channels_);
   if (num_channels_ == append_this.num_channels_) {
+    Reserve(Size() + append_this.Size());
     for (size_t i = 0; i < num_channels_; ++i) {
       channels_[i]->PushBack(append_this[i]);
     }
@@ -106,6 +109,7 @@ void AudioMultiVector::PushBackFromIndex(const AudioMultiVector& append_this,
   size_t length = append_this.Size() - index;
   assert(num_channels_ == append_this.num_channels_);
   if (num_channels_ == append_this.num_channels_) {
+    Reserve(Size() + length);
     for (size_t i = 0; i < num_channels_; ++i) {
       channels_[i]->PushBack(append_this[i], length, index);
     }
@@ -133,7 +137,6 @@ size_t AudioMultiVector::ReadInterleavedFromIndex(size_t start_index,
                                                   size_t length,
                                                   int16_t* destination) const {
   RTC_DCHECK(destination);
-  size_t index = 0;  // Number of elements written to |destination| so far.
   RTC_DCHECK_LE(start_index, Size());
   start_index = std::min(start_index, Size());
   if (length + start_index > Size()) {
@@ -144,13 +147,13 @@ size_t AudioMultiVector::ReadInterleavedFromIndex(size_t start_index,
     (*this)[0].CopyTo(length, start_index, destination);
     return length;
   }
-  for (size_t i = 0; i < length; ++i) {
-    for (size_t channel = 0; channel < num_channels_; ++channel) {
-      destination[index] = (*this)[channel][i + start_index];
-      ++index;
-    }
+  // Interleave one channel at a time, using bulk copies that handle the
+  // wrap-around of each channel's circular buffer once.
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    channels_[channel]->CopyToStrided(length, start_index, num_channels_,
+                                      &destination[channel]);
   }
-  return index;
+  return length * num_channels_;
 }
 
 size_t AudioMultiVector::ReadInterleavedFromEnd(size_t length,
@@ -167,6 +170,7 @@ void AudioMultiVector::OverwriteAt(const AudioMultiVector& insert_this,
   assert(length <= insert_this.Size());
   length = std::min(length, insert_this.Size());
   if (num_channels_ == insert_this.num_channels_) {
+    Reserve(std::max(Size(), position + length));
     for (size_t i = 0; i < num_channels_; ++i) {
       channels_[i]->OverwriteAt(insert_this[i], length, position);
     }
@@ -177,6 +181,7 @@ void AudioMultiVector::CrossFade(const AudioMultiVector& append_this,
                                  size_t fade_length) {
   assert(num_channels_ == append_this.num_channels_);
   if (num_channels_ == append_this.num_channels_) {
+    Reserve(Size() + append_this.Size());
     for (size_t i = 0; i < num_channels_; ++i) {
       channels_[i]->CrossFade(append_this[i], fade_length);
     }
@@ -195,6 +200,7 @@ size_t AudioMultiVector::Size() const {
 void AudioMultiVector::AssertSize(size_t required_size) {
   if (Size() < required_size) {
     size_t extend_length = required_size - Size();
+    Reserve(required_size);
     for (size_t channel = 0; channel < num_channels_; ++channel) {
       channels_[channel]->Extend(extend_length);
     }
@@ -212,6 +218,23 @@ void AudioMultiVector::CopyChannel(size_t from_channel, size_t to_channel) {
   channels_[from_channel]->CopyTo(channels_[to_channel]);
 }
 
+void AudioMultiVector::Reserve(size_t n) {
+  if (channel_capacity_ > n)
+    return;
+  size_t max_size = n;
+  for (const AudioVector* channel : channels_) {
+    max_size = std::max(max_size, channel->Size());
+  }
+  // One more sample than needed, as in AudioVector::Reserve().
+  const size_t capacity = max_size + 1;
+  std::unique_ptr<int16_t[]> storage(new int16_t[num_channels_ * capacity]);
+  for (size_t channel = 0; channel < num_channels_; ++channel) {
+    channels_[channel]->MoveToStorage(&storage[channel * capacity], capacity);
+  }
+  storage_.swap(storage);
+  channel_capacity_ = capacity;
+}
+
 const AudioVector& AudioMultiVector::operator[](size_t index) const {
   return *(channels_[index]);
 }
@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
@@ -132,6 +133,18 @@ class AudioMultiVector {
   size_t num_channels_;
 
  private:
+  // Makes sure that each channel can hold |n| samples. If not, all channels
+  // are moved to one new allocation, instead of growing one at a time.
+  void Reserve(size_t n);
+
+  // Planar storage for all channels: channel i keeps its samples in the
+  // |channel_capacity_| samples from i * |channel_capacity_|, so that a
+  // multi-channel vector is a single allocation. A channel that is grown
+  // directly through operator[] moves to an allocation of its own, until the
+  // next Reserve() that needs more room.
+  std::unique_ptr<int16_t[]> storage_;
+  size_t channel_capacity_ = 0;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMultiVector);
 };
 
@@ -10,6 +10,7 @@
 
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 
+#include <stddef.h>
 #include <stdlib.h>
 
 #include <string>
@@ -309,6 +310,30 @@ TEST_P(AudioMultiVectorTest, CopyChannel) {
   }
 }
 
+// Growing the vector moves all channels into one planar allocation, where
+// consecutive channels are equally far apart.
+TEST_P(AudioMultiVectorTest, ChannelsShareOneAllocationWhenGrowing) {
+  AudioMultiVector vec(num_channels_);
+  vec.PushBackInterleaved(array_interleaved_);
+  vec.PushBackInterleaved(array_interleaved_);
+  ASSERT_EQ(2 * array_length(), vec.Size());
+  const int16_t* const first_channel = &vec[0][0];
+  if (num_channels_ > 1) {
+    const ptrdiff_t channel_distance = &vec[1][0] - first_channel;
+    EXPECT_GE(channel_distance, static_cast<ptrdiff_t>(vec.Size()));
+    for (size_t channel = 2; channel < num_channels_; ++channel) {
+      EXPECT_EQ(first_channel + channel * channel_distance, &vec[channel][0]);
+    }
+  }
+  std::vector<int16_t> output(2 * array_interleaved_.size());
+  ASSERT_EQ(output.size(), vec.ReadInterleaved(vec.Size(), output.data()));
+  EXPECT_EQ(0, memcmp(array_interleaved_.data(), output.data(),
+                      array_interleaved_.size() * sizeof(int16_t)));
+  EXPECT_EQ(0, memcmp(array_interleaved_.data(),
+                      &output[array_interleaved_.size()],
+                      array_interleaved_.size() * sizeof(int16_t)));
+}
+
 INSTANTIATE_TEST_SUITE_P(TestNumChannels,
                          AudioMultiVectorTest,
                          ::testing::Values(static_cast<size_t>(1),
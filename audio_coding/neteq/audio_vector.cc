@@ -19,16 +19,54 @@
 
 namespace webrtc {
 
+namespace {
+
+// Copies |length| samples from |source| to |destination|, reading with a
+// distance of |source_stride| and writing with a distance of
+// |destination_stride| samples. The common strides are spelled out so that
+// the compiler can vectorize the loops.
+void StridedCopy(const int16_t* source,
+                 size_t source_stride,
+                 size_t length,
+                 size_t destination_stride,
+                 int16_t* destination) {
+  if (source_stride == 1 && destination_stride == 2) {
+    for (size_t i = 0; i < length; ++i) {
+      destination[2 * i] = source[i];
+    }
+  } else if (source_stride == 2 && destination_stride == 1) {
+    for (size_t i = 0; i < length; ++i) {
+      destination[i] = source[2 * i];
+    }
+  } else {
+    for (size_t i = 0; i < length; ++i) {
+      destination[i * destination_stride] = source[i * source_stride];
+    }
+  }
+}
+
+}  // namespace
+
 AudioVector::AudioVector() : AudioVector(kDefaultInitialSize) {
   Clear();
 }
 
 AudioVector::AudioVector(size_t initial_size)
-    : array_(new int16_t[initial_size + 1]),
+    : owned_array_(new int16_t[initial_size + 1]),
+      array_(owned_array_.get()),
+      capacity_(initial_size + 1),
+      begin_index_(0),
+      end_index_(capacity_ - 1) {
+  memset(array_, 0, capacity_ * sizeof(int16_t));
+}
+
+AudioVector::AudioVector(size_t initial_size, int16_t* storage)
+    : array_(storage),
       capacity_(initial_size + 1),
       begin_index_(0),
       end_index_(capacity_ - 1) {
-  memset(array_.get(), 0, capacity_ * sizeof(int16_t));
+  RTC_DCHECK(storage);
+  memset(array_, 0, capacity_ * sizeof(int16_t));
 }
 
 AudioVector::~AudioVector() = default;
@@ -40,7 +78,7 @@ void AudioVector::Clear() {
 void AudioVector::CopyTo(AudioVector* copy_to) const {
   RTC_DCHECK(copy_to);
   copy_to->Reserve(Size());
-  CopyTo(Size(), 0, copy_to->array_.get());
+  CopyTo(Size(), 0, copy_to->array_);
   copy_to->begin_index_ = 0;
   copy_to->end_index_ = Size();
 }
@@ -56,11 +94,28 @@ void AudioVector::CopyTo(size_t length,
   memcpy(copy_to, &array_[copy_index], first_chunk_length * sizeof(int16_t));
   const size_t remaining_length = length - first_chunk_length;
   if (remaining_length > 0) {
-    memcpy(&copy_to[first_chunk_length], array_.get(),
+    memcpy(&copy_to[first_chunk_length], array_,
            remaining_length * sizeof(int16_t));
   }
 }
 
+void AudioVector::CopyToStrided(size_t length,
+                                size_t position,
+                                size_t stride,
+                                int16_t* copy_to) const {
+  if (length == 0)
+    return;
+  length = std::min(length, Size() - position);
+  const size_t copy_index = (begin_index_ + position) % capacity_;
+  const size_t first_chunk_length = std::min(length, capacity_ - copy_index);
+  StridedCopy(&array_[copy_index], 1, first_chunk_length, stride, copy_to);
+  const size_t remaining_length = length - first_chunk_length;
+  if (remaining_length > 0) {
+    StridedCopy(array_, 1, remaining_length, stride,
+                &copy_to[first_chunk_length * stride]);
+  }
+}
+
 void AudioVector::PushFront(const AudioVector& prepend_this) {
   const size_t length = prepend_this.Size();
   if (length == 0)
@@ -74,7 +129,7 @@ void AudioVector::PushFront(const AudioVector& prepend_this) {
       std::min(length, prepend_this.capacity_ - prepend_this.begin_index_);
   const size_t remaining_length = length - first_chunk_length;
   if (remaining_length > 0)
-    PushFront(prepend_this.array_.get(), remaining_length);
+    PushFront(prepend_this.array_, remaining_length);
   PushFront(&prepend_this.array_[prepend_this.begin_index_],
             first_chunk_length);
 }
@@ -120,7 +175,7 @@ void AudioVector::PushBack(const AudioVector& append_this,
 
   const size_t remaining_length = length - first_chunk_length;
   if (remaining_length > 0)
-    PushBack(append_this.array_.get(), remaining_length);
+    PushBack(append_this.array_, remaining_length);
 }
 
 void AudioVector::PushBack(const int16_t* append_this, size_t length) {
@@ -132,12 +187,28 @@ void AudioVector::PushBack(const int16_t* append_this, size_t length) {
          first_chunk_length * sizeof(int16_t));
   const size_t remaining_length = length - first_chunk_length;
   if (remaining_length > 0) {
-    memcpy(array_.get(), &append_this[first_chunk_length],
+    memcpy(array_, &append_this[first_chunk_length],
            remaining_length * sizeof(int16_t));
   }
   end_index_ = (end_index_ + length) % capacity_;
 }
 
+void AudioVector::PushBackStrided(const int16_t* append_this,
+                                  size_t length,
+                                  size_t stride) {
+  if (length == 0)
+    return;
+  Reserve(Size() + length);
+  const size_t first_chunk_length = std::min(length, capacity_ - end_index_);
+  StridedCopy(append_this, stride, first_chunk_length, 1, &array_[end_index_]);
+  const size_t remaining_length = length - first_chunk_length;
+  if (remaining_length > 0) {
+    StridedCopy(&append_this[first_chunk_length * stride], stride,
+                remaining_length, 1, array_);
+  }
+  end_index_ = (end_index_ + length) % capacity_;
+}
+
 void AudioVector::PopFront(size_t length) {
   if (length == 0)
     return;
@@ -214,7 +285,7 @@ void AudioVector::OverwriteAt(const AudioVector& insert_this,
               position);
   const size_t remaining_length = length - first_chunk_length;
   if (remaining_length > 0) {
-    OverwriteAt(insert_this.array_.get(), remaining_length,
+    OverwriteAt(insert_this.array_, remaining_length,
                 position + first_chunk_length);
   }
 }
@@ -237,7 +308,7 @@ void AudioVector::OverwriteAt(const int16_t* insert_this,
          first_chunk_length * sizeof(int16_t));
   const size_t remaining_length = length - first_chunk_length;
   if (remaining_length > 0) {
-    memcpy(array_.get(), &insert_this[first_chunk_length],
+    memcpy(array_, &insert_this[first_chunk_length],
            remaining_length * sizeof(int16_t));
   }
 
@@ -292,12 +363,25 @@ void AudioVector::Reserve(size_t n) {
   // full vector.
   std::unique_ptr<int16_t[]> temp_array(new int16_t[n + 1]);
   CopyTo(length, 0, temp_array.get());
-  array_.swap(temp_array);
+  owned_array_.swap(temp_array);
+  array_ = owned_array_.get();
   begin_index_ = 0;
   end_index_ = length;
   capacity_ = n + 1;
 }
 
+void AudioVector::MoveToStorage(int16_t* storage, size_t capacity) {
+  RTC_DCHECK(storage);
+  const size_t length = Size();
+  RTC_DCHECK_GT(capacity, length);
+  CopyTo(length, 0, storage);
+  owned_array_.reset();
+  array_ = storage;
+  begin_index_ = 0;
+  end_index_ = length;
+  capacity_ = capacity;
+}
+
 void AudioVector::InsertByPushBack(const int16_t* insert_this,
                                    size_t length,
                                    size_t position) {
@@ -349,7 +433,7 @@ void AudioVector::InsertZerosByPushBack(size_t length, size_t position) {
   memset(&array_[end_index_], 0, first_zero_chunk_length * sizeof(int16_t));
   const size_t remaining_zero_length = length - first_zero_chunk_length;
   if (remaining_zero_length > 0)
-    memset(array_.get(), 0, remaining_zero_length * sizeof(int16_t));
+    memset(array_, 0, remaining_zero_length * sizeof(int16_t));
   end_index_ = (end_index_ + length) % capacity_;
 
   if (move_chunk_length > 0)
@@ -29,6 +29,11 @@ class AudioVector {
   // Creates an AudioVector with an initial size.
   explicit AudioVector(size_t initial_size);
 
+  // Like above, but keeps the samples in |storage|, which holds
+  // |initial_size| + 1 samples and is owned by the caller. The vector moves to
+  // an allocation of its own if it outgrows |storage|.
+  AudioVector(size_t initial_size, int16_t* storage);
+
   virtual ~AudioVector();
 
   // Deletes all values and make the vector empty.
@@ -42,6 +47,14 @@ class AudioVector {
   // Copies |length| values from |position| in this vector to |copy_to|.
   virtual void CopyTo(size_t length, size_t position, int16_t* copy_to) const;
 
+  // Copies |length| values from |position| in this vector to |copy_to|, where
+  // consecutive values are written |stride| elements apart. This is used to
+  // write one channel of an interleaved array.
+  virtual void CopyToStrided(size_t length,
+                             size_t position,
+                             size_t stride,
+                             int16_t* copy_to) const;
+
   // Prepends the contents of AudioVector |prepend_this| to this object. The
   // length of this object is increased with the length of |prepend_this|.
   virtual void PushFront(const AudioVector& prepend_this);
@@ -62,6 +75,13 @@ class AudioVector {
   // Same as PushFront but will append to the end of this object.
   virtual void PushBack(const int16_t* append_this, size_t length);
 
+  // Appends |length| values read from |append_this|, where consecutive values
+  // are |stride| elements apart. This is used to append one channel of an
+  // interleaved array.
+  virtual void PushBackStrided(const int16_t* append_this,
+                               size_t length,
+                               size_t stride);
+
   // Removes |length| elements from the beginning of this object.
   virtual void PopFront(size_t length);
 
@@ -112,6 +132,11 @@ class AudioVector {
   // Returns true if this AudioVector is empty.
   virtual bool Empty() const;
 
+  // Moves the contents to the start of |storage|, which holds |capacity|
+  // samples and is owned by the caller, and keeps using it as above.
+  // |capacity| must be larger than Size().
+  void MoveToStorage(int16_t* storage, size_t capacity);
+
   // Accesses and modifies an element of AudioVector.
   inline const int16_t& operator[](size_t index) const {
     return array_[WrapIndex(index, begin_index_, capacity_)];
@@ -154,7 +179,11 @@ class AudioVector {
 
   void InsertZerosByPushFront(size_t length, size_t position);
 
-  std::unique_ptr<int16_t[]> array_;
+  // Set unless the samples are kept in storage owned by the caller.
+  std::unique_ptr<int16_t[]> owned_array_;
+
+  // Points to either |owned_array_| or the caller's storage.
+  int16_t* array_;
 
   size_t capacity_;  // Allocated number of samples in the array.
 
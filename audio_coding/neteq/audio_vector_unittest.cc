@@ -13,6 +13,7 @@
 #include <stdlib.h>
 
 #include <string>
+#include <vector>
 
 #include "rtc_base/numerics/safe_conversions.h"
 #include "test/gtest.h"
@@ -98,6 +99,38 @@ TEST_F(AudioVectorTest, PushBackVector) {
   }
 }
 
+// Test PushBackStrided() and CopyToStrided() with data that wraps around the
+// end of the circular buffer.
+TEST_F(AudioVectorTest, PushBackAndCopyStrided) {
+  for (size_t stride : {1, 2, 3, 6}) {
+    AudioVector vec;
+    // Move the start of the buffer to make the appended data wrap around.
+    vec.Extend(8);
+    vec.PopFront(8);
+    std::vector<int16_t> interleaved(array_length() * stride, -1);
+    for (size_t i = 0; i < array_length(); ++i) {
+      interleaved[i * stride] = array_[i];
+    }
+    vec.PushBackStrided(interleaved.data(), array_length(), stride);
+    ASSERT_EQ(array_length(), vec.Size());
+    for (size_t i = 0; i < array_length(); ++i) {
+      EXPECT_EQ(array_[i], vec[i]);
+    }
+
+    const size_t kPosition = 3;
+    std::vector<int16_t> output(array_length() * stride, -1);
+    vec.CopyToStrided(array_length(), kPosition, stride, output.data());
+    for (size_t i = 0; i < array_length(); ++i) {
+      const int16_t expected =
+          i < array_length() - kPosition ? array_[i + kPosition] : -1;
+      EXPECT_EQ(expected, output[i * stride]);
+      for (size_t j = 1; j < stride; ++j) {
+        EXPECT_EQ(-1, output[i * stride + j]);
+      }
+    }
+  }
+}
+
 // Test the PushFront method.
 TEST_F(AudioVectorTest, PushFront) {
   AudioVector vec;
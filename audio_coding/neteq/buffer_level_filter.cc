@@ -15,16 +15,27 @@
 #include <algorithm>
 
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
-BufferLevelFilter::BufferLevelFilter() {
+namespace {
+// Reduction of the filter factors in low-latency mode, in Q8. This roughly
+// halves the time constant of the filter.
+constexpr int kLowLatencyLevelFactorReduction = 4;
+}  // namespace
+
+BufferLevelFilter::BufferLevelFilter()
+    : low_latency_(field_trial::IsEnabled("WebRTC-Audio-NetEqLowLatency")) {
   Reset();
 }
 
 void BufferLevelFilter::Reset() {
   filtered_current_level_ = 0;
   level_factor_ = 253;
+  if (low_latency_) {
+    level_factor_ -= kLowLatencyLevelFactorReduction;
+  }
 }
 
 void BufferLevelFilter::Update(size_t buffer_size_samples,
@@ -55,6 +66,9 @@ void BufferLevelFilter::SetTargetBufferLevel(int target_buffer_level) {
   } else {
     level_factor_ = 254;
   }
+  if (low_latency_) {
+    level_factor_ -= kLowLatencyLevelFactorReduction;
+  }
 }
 
 }  // namespace webrtc
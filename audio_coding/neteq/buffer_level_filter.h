@@ -40,6 +40,9 @@ class BufferLevelFilter {
   }
 
  private:
+  // Makes the filter follow the buffer level faster, which lets NetEq react
+  // sooner when the buffer has grown after a delay spike.
+  const bool low_latency_;
   int level_factor_;  // Filter factor for the buffer level filter in Q8.
   int filtered_current_level_;  // Filtered current buffer level in Q8.
 
@@ -15,6 +15,7 @@
 #include <math.h>  // Access to pow function.
 
 #include "rtc_base/strings/string_builder.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -50,6 +51,29 @@ TEST(BufferLevelFilter, ConvergenceTest) {
   }
 }
 
+// Verify that the low-latency mode makes the filter converge faster.
+TEST(BufferLevelFilter, LowLatencyConvergesFaster) {
+  const int kTimes = 10;
+  const int kValue = 100;
+  BufferLevelFilter filter;
+  filter.SetTargetBufferLevel(1);
+  for (int i = 0; i < kTimes; ++i) {
+    filter.Update(kValue, 0 /* time_stretched_samples */);
+  }
+
+  test::ScopedFieldTrials field_trial("WebRTC-Audio-NetEqLowLatency/Enabled/");
+  BufferLevelFilter low_latency_filter;
+  low_latency_filter.SetTargetBufferLevel(1);  // Coefficient 247/256.
+  for (int i = 0; i < kTimes; ++i) {
+    low_latency_filter.Update(kValue, 0 /* time_stretched_samples */);
+  }
+  // Expect the filtered value to be
+  // (1 - (247/256) ^ |kTimes|) * |kValue|.
+  EXPECT_NEAR(29, low_latency_filter.filtered_current_level(), 1);
+  EXPECT_GT(low_latency_filter.filtered_current_level(),
+            filter.filtered_current_level());
+}
+
 // Verify that target buffer level impacts on the filter convergence.
 TEST(BufferLevelFilter, FilterFactor) {
   BufferLevelFilter filter;
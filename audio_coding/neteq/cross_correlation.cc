@@ -14,11 +14,32 @@
 #include <limits>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
+void CrossCorrelation(int32_t* cross_correlation,
+                      const int16_t* seq1,
+                      const int16_t* seq2,
+                      size_t dim_seq,
+                      size_t dim_cross_correlation,
+                      int right_shifts,
+                      int step_seq2) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static const bool use_sse2 = (WebRtc_GetCPUInfo(kSSE2) != 0);
+  if (use_sse2) {
+    CrossCorrelationSse2(cross_correlation, seq1, seq2, dim_seq,
+                         dim_cross_correlation, right_shifts, step_seq2);
+    return;
+  }
+#endif
+  // Dispatches to the NEON or MIPS implementation where available.
+  WebRtcSpl_CrossCorrelation(cross_correlation, seq1, seq2, dim_seq,
+                             dim_cross_correlation, right_shifts, step_seq2);
+}
+
 // This function decides the overflow-protecting scaling and calls
-// WebRtcSpl_CrossCorrelation.
+// CrossCorrelation().
 int CrossCorrelationWithAutoShift(const int16_t* sequence_1,
                                   const int16_t* sequence_2,
                                   size_t sequence_1_length,
@@ -53,9 +74,8 @@ int CrossCorrelationWithAutoShift(const int16_t* sequence_1,
                          static_cast<int32_t>(sequence_1_length));
   const int scaling = factor == 0 ? 0 : 31 - WebRtcSpl_NormW32(factor);
 
-  WebRtcSpl_CrossCorrelation(cross_correlation, sequence_1, sequence_2,
-                             sequence_1_length, cross_correlation_length,
-                             scaling, cross_correlation_step);
+  CrossCorrelation(cross_correlation, sequence_1, sequence_2, sequence_1_length,
+                   cross_correlation_length, scaling, cross_correlation_step);
 
   return scaling;
 }
@@ -14,8 +14,33 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "rtc_base/system/arch.h"
+
 namespace webrtc {
 
+// Calculates |dim_cross_correlation| cross-correlations between |seq1| and
+// |seq2|, where |seq2| is moved by |step_seq2| samples for each lag. Each
+// product is right shifted by |right_shifts| before being accumulated. The
+// result is bit-exact to WebRtcSpl_CrossCorrelationC(), which is also used
+// when no optimized implementation is available for the current CPU.
+void CrossCorrelation(int32_t* cross_correlation,
+                      const int16_t* seq1,
+                      const int16_t* seq2,
+                      size_t dim_seq,
+                      size_t dim_cross_correlation,
+                      int right_shifts,
+                      int step_seq2);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void CrossCorrelationSse2(int32_t* cross_correlation,
+                          const int16_t* seq1,
+                          const int16_t* seq2,
+                          size_t dim_seq,
+                          size_t dim_cross_correlation,
+                          int right_shifts,
+                          int step_seq2);
+#endif
+
 // The function calculates the cross-correlation between two sequences
 // |sequence_1| and |sequence_2|. |sequence_1| is taken as reference, with
 // |sequence_1_length| as its length. |sequence_2| slides for the calculation of
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/neteq/cross_correlation.h"
+
+namespace webrtc {
+
+namespace {
+
+// Computes the correlation for a single lag. All sums are accumulated with
+// wrap-around, which makes the result independent of the summation order and
+// hence bit-exact to the sequential C implementation.
+int32_t CorrelateSse2(const int16_t* seq1,
+                      const int16_t* seq2,
+                      size_t dim_seq,
+                      int right_shifts) {
+  __m128i sum = _mm_setzero_si128();
+  size_t j = 0;
+  if (right_shifts == 0) {
+    // Without scaling, pairs of products can be summed directly.
+    for (; j + 8 <= dim_seq; j += 8) {
+      const __m128i a =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&seq1[j]));
+      const __m128i b =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&seq2[j]));
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+    }
+  } else {
+    // Each product has to be scaled before the accumulation. The 32 bit
+    // products are formed from their low and high halves.
+    const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+    for (; j + 8 <= dim_seq; j += 8) {
+      const __m128i a =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&seq1[j]));
+      const __m128i b =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&seq2[j]));
+      const __m128i low = _mm_mullo_epi16(a, b);
+      const __m128i high = _mm_mulhi_epi16(a, b);
+      const __m128i products_0 = _mm_unpacklo_epi16(low, high);
+      const __m128i products_1 = _mm_unpackhi_epi16(low, high);
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(products_0, shift));
+      sum = _mm_add_epi32(sum, _mm_sra_epi32(products_1, shift));
+    }
+  }
+
+  // Horizontal sum.
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  uint32_t corr = static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+
+  // Remaining samples.
+  for (; j < dim_seq; ++j) {
+    corr += static_cast<uint32_t>((seq1[j] * seq2[j]) >> right_shifts);
+  }
+  return static_cast<int32_t>(corr);
+}
+
+}  // namespace
+
+void CrossCorrelationSse2(int32_t* cross_correlation,
+                          const int16_t* seq1,
+                          const int16_t* seq2,
+                          size_t dim_seq,
+                          size_t dim_cross_correlation,
+                          int right_shifts,
+                          int step_seq2) {
+  for (size_t i = 0; i < dim_cross_correlation; ++i) {
+    cross_correlation[i] = CorrelateSse2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
+
+}  // namespace webrtc
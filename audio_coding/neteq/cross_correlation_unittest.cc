@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/cross_correlation.h"
+
+#include <random>
+#include <vector>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Sequential reference, matching WebRtcSpl_CrossCorrelationC().
+void ReferenceCrossCorrelation(int32_t* cross_correlation,
+                               const int16_t* seq1,
+                               const int16_t* seq2,
+                               size_t dim_seq,
+                               size_t dim_cross_correlation,
+                               int right_shifts,
+                               int step_seq2) {
+  for (size_t i = 0; i < dim_cross_correlation; ++i) {
+    uint32_t corr = 0;
+    for (size_t j = 0; j < dim_seq; ++j) {
+      corr += static_cast<uint32_t>((seq1[j] * seq2[j]) >> right_shifts);
+    }
+    cross_correlation[i] = static_cast<int32_t>(corr);
+    seq2 += step_seq2;
+  }
+}
+
+using CrossCorrelationFunction = void (*)(int32_t*,
+                                          const int16_t*,
+                                          const int16_t*,
+                                          size_t,
+                                          size_t,
+                                          int,
+                                          int);
+
+void VerifyBitExactness(CrossCorrelationFunction cross_correlation) {
+  constexpr size_t kMaxLags = 60;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> sample(-32768, 32767);
+  std::vector<int16_t> seq1(400);
+  std::vector<int16_t> seq2(seq1.size() + 2 * kMaxLags);
+  for (auto& x : seq1) {
+    x = static_cast<int16_t>(sample(generator));
+  }
+  for (auto& x : seq2) {
+    x = static_cast<int16_t>(sample(generator));
+  }
+  // Include the extreme products.
+  seq1[0] = seq1[1] = -32768;
+  seq2[kMaxLags] = seq2[kMaxLags + 1] = -32768;
+
+  for (size_t dim_seq : {1, 7, 8, 9, 60, 255, 400}) {
+    for (int right_shifts : {0, 1, 5, 16}) {
+      for (int step : {1, -1}) {
+        const int16_t* seq2_start = &seq2[kMaxLags];
+        std::vector<int32_t> expected(kMaxLags);
+        std::vector<int32_t> actual(kMaxLags);
+        ReferenceCrossCorrelation(expected.data(), seq1.data(), seq2_start,
+                                  dim_seq, kMaxLags, right_shifts, step);
+        cross_correlation(actual.data(), seq1.data(), seq2_start, dim_seq,
+                          kMaxLags, right_shifts, step);
+        EXPECT_EQ(expected, actual) << "dim_seq=" << dim_seq
+                                    << ", right_shifts=" << right_shifts
+                                    << ", step=" << step;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CrossCorrelation, BitExactToReference) {
+  VerifyBitExactness(&CrossCorrelation);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(CrossCorrelation, Sse2BitExactToReference) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  VerifyBitExactness(&CrossCorrelationSse2);
+}
+#endif
+
+TEST(CrossCorrelation, AutoShiftAvoidsOverflow) {
+  const std::vector<int16_t> seq1(240, 32767);
+  const std::vector<int16_t> seq2(240 + 10, -32768);
+  std::vector<int32_t> correlation(10);
+  const int scaling = CrossCorrelationWithAutoShift(
+      seq1.data(), seq2.data(), seq1.size(), correlation.size(), 1,
+      correlation.data());
+  EXPECT_GT(scaling, 0);
+  for (int32_t c : correlation) {
+    EXPECT_LT(c, 0);
+  }
+}
+
+}  // namespace webrtc
@@ -68,8 +68,12 @@ DecisionLogic::DecisionLogic(int fs_hz,
       sample_memory_(0),
       prev_time_scale_(false),
       disallow_time_stretching_(disallow_time_stretching),
+      min_timescale_interval_(
+          field_trial::IsEnabled("WebRTC-Audio-NetEqLowLatency")
+              ? kLowLatencyMinTimescaleInterval
+              : kMinTimescaleInterval),
       timescale_countdown_(
-          tick_timer_->GetNewCountdown(kMinTimescaleInterval + 1)),
+          tick_timer_->GetNewCountdown(min_timescale_interval_ + 1)),
       num_consecutive_expands_(0),
       time_stretched_cn_samples_(0),
       estimate_dtx_delay_("estimate_dtx_delay", false),
@@ -87,7 +91,8 @@ DecisionLogic::DecisionLogic(int fs_hz,
   RTC_LOG(LS_INFO) << "NetEq decision logic settings:"
                    << " estimate_dtx_delay=" << estimate_dtx_delay_
                    << " time_stretch_cn=" << time_stretch_cn_
-                   << " target_level_window_ms=" << target_level_window_ms_;
+                   << " target_level_window_ms=" << target_level_window_ms_
+                   << " min_timescale_interval=" << min_timescale_interval_;
 }
 
 DecisionLogic::~DecisionLogic() = default;
@@ -108,7 +113,7 @@ void DecisionLogic::SoftReset() {
   sample_memory_ = 0;
   prev_time_scale_ = false;
   timescale_countdown_ =
-      tick_timer_->GetNewCountdown(kMinTimescaleInterval + 1);
+      tick_timer_->GetNewCountdown(min_timescale_interval_ + 1);
   time_stretched_cn_samples_ = 0;
 }
 
@@ -240,7 +245,8 @@ void DecisionLogic::FilterBufferLevel(size_t buffer_size_samples) {
   int time_stretched_samples = time_stretched_cn_samples_;
   if (prev_time_scale_) {
     time_stretched_samples += sample_memory_;
-    timescale_countdown_ = tick_timer_->GetNewCountdown(kMinTimescaleInterval);
+    timescale_countdown_ =
+        tick_timer_->GetNewCountdown(min_timescale_interval_);
   }
 
   buffer_level_filter_->Update(buffer_size_samples, time_stretched_samples);
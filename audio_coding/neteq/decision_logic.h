@@ -112,6 +112,8 @@ class DecisionLogic final {
  private:
   // The value 5 sets maximum time-stretch rate to about 100 ms/s.
   static const int kMinTimescaleInterval = 5;
+  // Used in low-latency mode, allowing about 250 ms/s of time-stretching.
+  static const int kLowLatencyMinTimescaleInterval = 2;
 
   enum CngState { kCngOff, kCngRfc3389On, kCngInternalOn };
 
@@ -177,6 +179,8 @@ class DecisionLogic final {
   int sample_memory_;
   bool prev_time_scale_;
   bool disallow_time_stretching_;
+  // Minimum number of ticks between two time-stretch operations.
+  const int min_timescale_interval_;
   std::unique_ptr<TickTimer::Countdown> timescale_countdown_;
   int num_consecutive_expands_;
   int time_stretched_cn_samples_;
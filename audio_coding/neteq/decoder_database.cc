@@ -28,7 +28,8 @@ namespace webrtc {
 DecoderDatabase::DecoderDatabase(
     const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory,
     absl::optional<AudioCodecPairId> codec_pair_id)
-    : active_decoder_type_(-1),
+    : num_decoders_(0),
+      active_decoder_type_(-1),
       active_cng_decoder_type_(-1),
       decoder_factory_(decoder_factory),
       codec_pair_id_(codec_pair_id) {}
@@ -106,17 +107,15 @@ DecoderDatabase::DecoderInfo::SubtypeFromFormat(const SdpAudioFormat& format) {
 }
 
 bool DecoderDatabase::Empty() const {
-  return decoders_.empty();
+  return num_decoders_ == 0;
 }
 
 int DecoderDatabase::Size() const {
-  return static_cast<int>(decoders_.size());
+  return num_decoders_;
 }
 
 void DecoderDatabase::Reset() {
-  decoders_.clear();
-  active_decoder_type_ = -1;
-  active_cng_decoder_type_ = -1;
+  RemoveAll();
 }
 
 std::vector<int> DecoderDatabase::SetCodecs(
@@ -124,10 +123,15 @@ std::vector<int> DecoderDatabase::SetCodecs(
   // First collect all payload types that we'll remove or reassign, then remove
   // them from the database.
   std::vector<int> changed_payload_types;
-  for (const std::pair<uint8_t, const DecoderInfo&> kv : decoders_) {
-    auto i = codecs.find(kv.first);
-    if (i == codecs.end() || i->second != kv.second.GetFormat()) {
-      changed_payload_types.push_back(kv.first);
+  for (size_t rtp_payload_type = 0; rtp_payload_type < decoders_.size();
+       ++rtp_payload_type) {
+    const DecoderInfo* info = decoders_[rtp_payload_type].get();
+    if (!info) {
+      continue;
+    }
+    auto i = codecs.find(static_cast<int>(rtp_payload_type));
+    if (i == codecs.end() || i->second != info->GetFormat()) {
+      changed_payload_types.push_back(static_cast<int>(rtp_payload_type));
     }
   }
   for (int pl_type : changed_payload_types) {
@@ -140,10 +144,14 @@ std::vector<int> DecoderDatabase::SetCodecs(
     const SdpAudioFormat& audio_format = kv.second;
     RTC_DCHECK_GE(rtp_payload_type, 0);
     RTC_DCHECK_LE(rtp_payload_type, 0x7f);
-    if (decoders_.count(rtp_payload_type) == 0) {
-      decoders_.insert(std::make_pair(
-          rtp_payload_type,
-          DecoderInfo(audio_format, codec_pair_id_, decoder_factory_.get())));
+    if (rtp_payload_type < 0 || rtp_payload_type > 0x7f) {
+      // Packets can never carry this payload type.
+      continue;
+    }
+    if (!decoders_[rtp_payload_type]) {
+      decoders_[rtp_payload_type] = std::make_unique<DecoderInfo>(
+          audio_format, codec_pair_id_, decoder_factory_.get());
+      ++num_decoders_;
     } else {
       // The mapping for this payload type hasn't changed.
     }
@@ -157,21 +165,23 @@ int DecoderDatabase::RegisterPayload(int rtp_payload_type,
   if (rtp_payload_type < 0 || rtp_payload_type > 0x7f) {
     return kInvalidRtpPayloadType;
   }
-  const auto ret = decoders_.insert(std::make_pair(
-      rtp_payload_type,
-      DecoderInfo(audio_format, codec_pair_id_, decoder_factory_.get())));
-  if (ret.second == false) {
+  if (decoders_[rtp_payload_type]) {
     // Database already contains a decoder with type |rtp_payload_type|.
     return kDecoderExists;
   }
+  decoders_[rtp_payload_type] = std::make_unique<DecoderInfo>(
+      audio_format, codec_pair_id_, decoder_factory_.get());
+  ++num_decoders_;
   return kOK;
 }
 
 int DecoderDatabase::Remove(uint8_t rtp_payload_type) {
-  if (decoders_.erase(rtp_payload_type) == 0) {
+  if (rtp_payload_type >= decoders_.size() || !decoders_[rtp_payload_type]) {
     // No decoder with that |rtp_payload_type|.
     return kDecoderNotFound;
   }
+  decoders_[rtp_payload_type].reset();
+  --num_decoders_;
   if (active_decoder_type_ == rtp_payload_type) {
     active_decoder_type_ = -1;  // No active decoder.
   }
@@ -182,19 +192,21 @@ int DecoderDatabase::Remove(uint8_t rtp_payload_type) {
 }
 
 void DecoderDatabase::RemoveAll() {
-  decoders_.clear();
+  for (auto& info : decoders_) {
+    info.reset();
+  }
+  num_decoders_ = 0;
   active_decoder_type_ = -1;      // No active decoder.
   active_cng_decoder_type_ = -1;  // No active CNG decoder.
 }
 
 const DecoderDatabase::DecoderInfo* DecoderDatabase::GetDecoderInfo(
     uint8_t rtp_payload_type) const {
-  DecoderMap::const_iterator it = decoders_.find(rtp_payload_type);
-  if (it == decoders_.end()) {
-    // Decoder not found.
+  if (rtp_payload_type >= decoders_.size()) {
+    // Not a valid RTP payload type.
     return NULL;
   }
-  return &it->second;
+  return decoders_[rtp_payload_type].get();
 }
 
 int DecoderDatabase::SetActiveDecoder(uint8_t rtp_payload_type,
@@ -11,9 +11,11 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_DECODER_DATABASE_H_
 #define MODULES_AUDIO_CODING_NETEQ_DECODER_DATABASE_H_
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/audio_codecs/audio_decoder_factory.h"
 #include "api/audio_codecs/audio_format.h"
@@ -200,9 +202,13 @@ class DecoderDatabase {
   int CheckPayloadTypes(const PacketList& packet_list) const;
 
  private:
-  typedef std::map<uint8_t, DecoderInfo> DecoderMap;
+  // Number of RTP payload types, which are 7 bits.
+  static constexpr size_t kNumRtpPayloadTypes = 128;
 
-  DecoderMap decoders_;
+  // The registered decoders, indexed by RTP payload type, so that the lookups
+  // done for every packet are a single load.
+  std::array<std::unique_ptr<DecoderInfo>, kNumRtpPayloadTypes> decoders_;
+  int num_decoders_;
   int active_decoder_type_;
   int active_cng_decoder_type_;
   mutable std::unique_ptr<ComfortNoiseDecoder> active_cng_decoder_;
@@ -66,6 +66,26 @@ TEST(DecoderDatabase, InsertAndRemoveAll) {
   EXPECT_TRUE(db.Empty());
 }
 
+TEST(DecoderDatabase, PayloadTypeRange) {
+  rtc::scoped_refptr<MockAudioDecoderFactory> factory(
+      new rtc::RefCountedObject<MockAudioDecoderFactory>);
+  DecoderDatabase db(factory, absl::nullopt);
+  EXPECT_EQ(DecoderDatabase::kOK,
+            db.RegisterPayload(0x7f, SdpAudioFormat("pcmu", 8000, 1)));
+  EXPECT_EQ(DecoderDatabase::kInvalidRtpPayloadType,
+            db.RegisterPayload(0x80, SdpAudioFormat("pcmu", 8000, 1)));
+  EXPECT_EQ(DecoderDatabase::kDecoderExists,
+            db.RegisterPayload(0x7f, SdpAudioFormat("pcma", 8000, 1)));
+  EXPECT_EQ(1, db.Size());
+  ASSERT_TRUE(db.GetDecoderInfo(0x7f));
+  EXPECT_TRUE(db.GetDecoderInfo(0x7f)->IsType("pcmu"));
+  EXPECT_FALSE(db.GetDecoderInfo(0x80));
+  EXPECT_FALSE(db.GetDecoderInfo(0xff));
+  EXPECT_EQ(DecoderDatabase::kDecoderNotFound, db.Remove(0xff));
+  EXPECT_EQ(DecoderDatabase::kOK, db.Remove(0x7f));
+  EXPECT_TRUE(db.Empty());
+}
+
 TEST(DecoderDatabase, GetDecoderInfo) {
   rtc::scoped_refptr<MockAudioDecoderFactory> factory(
       new rtc::RefCountedObject<MockAudioDecoderFactory>);
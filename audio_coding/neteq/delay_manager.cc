@@ -55,6 +55,14 @@ DelayHistogramConfig GetDelayHistogramConfig() {
   constexpr char kDelayHistogramFieldTrial[] =
       "WebRTC-Audio-NetEqDelayHistogram";
   DelayHistogramConfig config;
+  if (webrtc::field_trial::IsEnabled("WebRTC-Audio-NetEqLowLatency")) {
+    // Target a lower quantile of the delays over a window of about 60
+    // packets, which lets the target level fall back within a few seconds
+    // after a delay spike. An explicit histogram config still takes
+    // precedence.
+    config.quantile = PercentileToQuantile(95.0);
+    config.forget_factor = 32211;  // 0.983 in Q15.
+  }
   if (webrtc::field_trial::IsEnabled(kDelayHistogramFieldTrial)) {
     const auto field_trial_string =
         webrtc::field_trial::FindFullName(kDelayHistogramFieldTrial);
@@ -480,7 +480,7 @@ void Expand::AnalyzeSignal(int16_t* random_vector) {
     correlation_scale = std::max(0, correlation_scale);
 
     // Calculate the correlation, store in |correlation_vector2|.
-    WebRtcSpl_CrossCorrelation(
+    CrossCorrelation(
         correlation_vector2,
         &(audio_history[signal_length - correlation_length]),
         &(audio_history[signal_length - correlation_length - start_index]),
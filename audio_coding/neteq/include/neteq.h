@@ -24,6 +24,8 @@
 #include "api/rtp_headers.h"
 #include "api/scoped_refptr.h"
 #include "modules/audio_coding/neteq/defines.h"
+#include "modules/include/module_common_types_public.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
@@ -114,6 +116,8 @@ struct NetEqOperationsAndState {
   uint64_t current_frame_size_ms = 0;
   // Flag to indicate that the next packet is available.
   bool next_packet_available = false;
+  // The operation performed by the last call to GetAudio.
+  Modes last_mode = kModeUndefined;
 };
 
 // This is the interface class for NetEq.
@@ -137,6 +141,9 @@ class NetEq {
     bool enable_fast_accelerate = false;
     bool enable_muted_state = false;
     bool enable_rtx_handling = false;
+    // Caps the payload bytes in the packet buffer, which is flushed when a
+    // packet would take it above the limit. 0 means no limit.
+    size_t max_packet_buffer_bytes = 0;
     absl::optional<AudioCodecPairId> codec_pair_id;
     bool for_test_no_time_stretching = false;  // Use only for testing.
   };
@@ -172,6 +179,14 @@ class NetEq {
     return InsertPacket(rtp_header, payload);
   }
 
+  // Same as above, but NetEq takes ownership of |payload| instead of copying
+  // it. The buffer is reused for the packet handed to the decoder, also for
+  // the primary payload of a RED packet. The default implementation copies.
+  virtual int InsertPacketWithBuffer(const RTPHeader& rtp_header,
+                                     rtc::Buffer&& payload) {
+    return InsertPacket(rtp_header, payload);
+  }
+
   // Lets NetEq know that a packet arrived with an empty payload. This typically
   // happens when empty packets are used for probing the network channel, and
   // these packets use RTP sequence numbers from the same series as the actual
@@ -251,7 +266,8 @@ class NetEq {
   virtual NetEqLifetimeStatistics GetLifetimeStatistics() const = 0;
 
   // Returns statistics about the performed operations and internal state. These
-  // statistics are never reset.
+  // statistics are never reset, and reflect the latest call that changed them,
+  // such as InsertPacket(), GetAudio() or FlushBuffers().
   virtual NetEqOperationsAndState GetOperationsAndState() const = 0;
 
   // Enables post-decode VAD. When enabled, GetAudio() will return
@@ -300,6 +316,10 @@ class NetEq {
   // Mainly intended for testing.
   virtual int SyncBufferSizeMs() const = 0;
 
+  // Returns the memory held by the packet buffer and by the sync buffer.
+  virtual BufferMemoryUsage GetPacketBufferMemoryUsage() const = 0;
+  virtual BufferMemoryUsage GetSyncBufferMemoryUsage() const = 0;
+
  protected:
   NetEq() {}
 
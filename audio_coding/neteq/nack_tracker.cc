@@ -35,6 +35,8 @@ NackTracker::NackTracker(int nack_threshold_packets)
       any_rtp_decoded_(false),
       sample_rate_khz_(kDefaultSampleRateKhz),
       samples_per_packet_(sample_rate_khz_ * kDefaultPacketSizeMs),
+      nack_list_begin_(0),
+      nack_list_span_(0),
       max_nack_list_size_(kNackListSizeLimit) {}
 
 NackTracker::~NackTracker() = default;
@@ -69,7 +71,10 @@ void NackTracker::UpdateLastReceivedPacket(uint16_t sequence_number,
     return;
 
   // Received RTP should not be in the list.
-  nack_list_.erase(sequence_number);
+  if (static_cast<uint16_t>(sequence_number - nack_list_begin_) <
+      nack_list_span_) {
+    Slot(sequence_number).in_list = false;
+  }
 
   // If this is an old sequence number, no more action is required, return.
   if (IsNewerSequenceNumber(sequence_num_last_received_rtp_, sequence_number))
@@ -106,12 +111,29 @@ void NackTracker::UpdateList(uint16_t sequence_number_current_received_rtp) {
 
 void NackTracker::ChangeFromLateToMissing(
     uint16_t sequence_number_current_received_rtp) {
-  NackList::const_iterator lower_bound =
-      nack_list_.lower_bound(static_cast<uint16_t>(
-          sequence_number_current_received_rtp - nack_threshold_packets_));
+  const uint16_t upper_bound_missing =
+      sequence_number_current_received_rtp - nack_threshold_packets_;
+  // The packets older than the previous bound are already flagged as missing.
+  const uint16_t lower_bound_late = static_cast<uint16_t>(
+      sequence_num_last_received_rtp_ - nack_threshold_packets_);
+  size_t k = 0;
+  if (IsNewerSequenceNumber(lower_bound_late, nack_list_begin_))
+    k = static_cast<uint16_t>(lower_bound_late - nack_list_begin_);
+  for (; k < nack_list_span_; ++k) {
+    const uint16_t sequence_number = nack_list_begin_ + k;
+    if (!IsNewerSequenceNumber(upper_bound_missing, sequence_number))
+      break;
+    Slot(sequence_number).element.is_missing = true;
+  }
+}
 
-  for (NackList::iterator it = nack_list_.begin(); it != lower_bound; ++it)
-    it->second.is_missing = true;
+void NackTracker::EraseOlderThan(uint16_t sequence_number) {
+  while (nack_list_span_ > 0 &&
+         IsNewerSequenceNumber(sequence_number, nack_list_begin_)) {
+    Slot(nack_list_begin_).in_list = false;
+    ++nack_list_begin_;
+    --nack_list_span_;
+  }
 }
 
 uint32_t NackTracker::EstimateTimestamp(uint16_t sequence_num) {
@@ -129,22 +151,43 @@ void NackTracker::AddToList(uint16_t sequence_number_current_received_rtp) {
   uint16_t upper_bound_missing =
       sequence_number_current_received_rtp - nack_threshold_packets_;
 
-  for (uint16_t n = sequence_num_last_received_rtp_ + 1;
-       IsNewerSequenceNumber(sequence_number_current_received_rtp, n); ++n) {
+  // The packets which LimitNackListSize() would remove are not added, so that
+  // the list fits in the ring.
+  const uint16_t lower_bound_in_list =
+      sequence_number_current_received_rtp -
+      static_cast<uint16_t>(max_nack_list_size_);
+  EraseOlderThan(lower_bound_in_list);
+  uint16_t n = sequence_num_last_received_rtp_ + 1;
+  if (IsNewerSequenceNumber(lower_bound_in_list, n))
+    n = lower_bound_in_list;
+  // The sequence numbers between the end of the list and |n| are received.
+  if (nack_list_span_ == 0)
+    nack_list_begin_ = n;
+  else
+    nack_list_span_ = static_cast<uint16_t>(n - nack_list_begin_);
+
+  for (; IsNewerSequenceNumber(sequence_number_current_received_rtp, n); ++n) {
     bool is_missing = IsNewerSequenceNumber(upper_bound_missing, n);
     uint32_t timestamp = EstimateTimestamp(n);
-    NackElement nack_element(TimeToPlay(timestamp), timestamp, is_missing);
-    nack_list_.insert(nack_list_.end(), std::make_pair(n, nack_element));
+    NackSlot& slot = Slot(n);
+    slot.element = NackElement(TimeToPlay(timestamp), timestamp, is_missing);
+    slot.in_list = true;
+    ++nack_list_span_;
   }
+  RTC_DCHECK_LE(nack_list_span_, kNackRingSize);
 }
 
 void NackTracker::UpdateEstimatedPlayoutTimeBy10ms() {
-  while (!nack_list_.empty() &&
-         nack_list_.begin()->second.time_to_play_ms <= 10)
-    nack_list_.erase(nack_list_.begin());
+  while (nack_list_span_ > 0 &&
+         (!Slot(nack_list_begin_).in_list ||
+          Slot(nack_list_begin_).element.time_to_play_ms <= 10)) {
+    Slot(nack_list_begin_).in_list = false;
+    ++nack_list_begin_;
+    --nack_list_span_;
+  }
 
-  for (NackList::iterator it = nack_list_.begin(); it != nack_list_.end(); ++it)
-    it->second.time_to_play_ms -= 10;
+  for (size_t k = 0; k < nack_list_span_; ++k)
+    Slot(nack_list_begin_ + k).element.time_to_play_ms -= 10;
 }
 
 void NackTracker::UpdateLastDecodedPacket(uint16_t sequence_number,
@@ -156,13 +199,13 @@ void NackTracker::UpdateLastDecodedPacket(uint16_t sequence_number,
     // Packets in the list with sequence numbers less than the
     // sequence number of the decoded RTP should be removed from the lists.
     // They will be discarded by the jitter buffer if they arrive.
-    nack_list_.erase(nack_list_.begin(),
-                     nack_list_.upper_bound(sequence_num_last_decoded_rtp_));
+    EraseOlderThan(sequence_num_last_decoded_rtp_ + 1);
 
     // Update estimated time-to-play.
-    for (NackList::iterator it = nack_list_.begin(); it != nack_list_.end();
-         ++it)
-      it->second.time_to_play_ms = TimeToPlay(it->second.estimated_timestamp);
+    for (size_t k = 0; k < nack_list_span_; ++k) {
+      NackElement& element = Slot(nack_list_begin_ + k).element;
+      element.time_to_play_ms = TimeToPlay(element.estimated_timestamp);
+    }
   } else {
     assert(sequence_number == sequence_num_last_decoded_rtp_);
 
@@ -178,11 +221,19 @@ void NackTracker::UpdateLastDecodedPacket(uint16_t sequence_number,
 }
 
 NackTracker::NackList NackTracker::GetNackList() const {
-  return nack_list_;
+  NackList nack_list;
+  for (size_t k = 0; k < nack_list_span_; ++k) {
+    const uint16_t sequence_number = nack_list_begin_ + k;
+    const NackSlot& slot = Slot(sequence_number);
+    if (slot.in_list)
+      nack_list.push_back(std::make_pair(sequence_number, slot.element));
+  }
+  return nack_list;
 }
 
 void NackTracker::Reset() {
-  nack_list_.clear();
+  EraseOlderThan(nack_list_begin_ + nack_list_span_);
+  nack_list_begin_ = 0;
 
   sequence_num_last_received_rtp_ = 0;
   timestamp_last_received_rtp_ = 0;
@@ -205,9 +256,8 @@ void NackTracker::SetMaxNackListSize(size_t max_nack_list_size) {
 }
 
 void NackTracker::LimitNackListSize() {
-  uint16_t limit = sequence_num_last_received_rtp_ -
-                   static_cast<uint16_t>(max_nack_list_size_) - 1;
-  nack_list_.erase(nack_list_.begin(), nack_list_.upper_bound(limit));
+  EraseOlderThan(sequence_num_last_received_rtp_ -
+                 static_cast<uint16_t>(max_nack_list_size_));
 }
 
 int64_t NackTracker::TimeToPlay(uint32_t timestamp) const {
@@ -218,15 +268,22 @@ int64_t NackTracker::TimeToPlay(uint32_t timestamp) const {
 // We don't erase elements with time-to-play shorter than round-trip-time.
 std::vector<uint16_t> NackTracker::GetNackList(
     int64_t round_trip_time_ms) const {
-  RTC_DCHECK_GE(round_trip_time_ms, 0);
   std::vector<uint16_t> sequence_numbers;
-  for (NackList::const_iterator it = nack_list_.begin(); it != nack_list_.end();
-       ++it) {
-    if (it->second.is_missing &&
-        it->second.time_to_play_ms > round_trip_time_ms)
-      sequence_numbers.push_back(it->first);
-  }
+  GetNackList(round_trip_time_ms, &sequence_numbers);
   return sequence_numbers;
 }
 
+void NackTracker::GetNackList(int64_t round_trip_time_ms,
+                              std::vector<uint16_t>* nack_list) const {
+  RTC_DCHECK_GE(round_trip_time_ms, 0);
+  nack_list->clear();
+  for (size_t k = 0; k < nack_list_span_; ++k) {
+    const uint16_t sequence_number = nack_list_begin_ + k;
+    const NackSlot& slot = Slot(sequence_number);
+    if (slot.in_list && slot.element.is_missing &&
+        slot.element.time_to_play_ms > round_trip_time_ms)
+      nack_list->push_back(sequence_number);
+  }
+}
+
 }  // namespace webrtc
@@ -14,7 +14,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <map>
+#include <array>
+#include <utility>
 #include <vector>
 
 #include "modules/include/module_common_types_public.h"
@@ -88,6 +89,9 @@ class NackTracker {
   // than the given round-trip-time (in milliseconds).
   // Note: Late packets are not included.
   std::vector<uint16_t> GetNackList(int64_t round_trip_time_ms) const;
+  // Same as above, but writes the list to |nack_list|, reusing its storage.
+  void GetNackList(int64_t round_trip_time_ms,
+                   std::vector<uint16_t>* nack_list) const;
 
   // Reset to default values. The NACK list is cleared.
   // |nack_threshold_packets_| & |max_nack_list_size_| preserve their values.
@@ -122,15 +126,23 @@ class NackTracker {
     bool is_missing;
   };
 
-  class NackListCompare {
-   public:
-    bool operator()(uint16_t sequence_number_old,
-                    uint16_t sequence_number_new) const {
-      return IsNewerSequenceNumber(sequence_number_new, sequence_number_old);
-    }
+  // A slot of |nack_ring_|.
+  struct NackSlot {
+    NackElement element{0, 0, false};
+    // True if the sequence number of the slot is in the NACK list.
+    bool in_list = false;
   };
 
-  typedef std::map<uint16_t, NackElement, NackListCompare> NackList;
+  // The NACK list in sequence number order, as returned to the tests.
+  typedef std::vector<std::pair<uint16_t, NackElement>> NackList;
+
+  // Size of |nack_ring_|. A power of two, so that the slot of a sequence number
+  // does not change when the sequence number wraps around.
+  static constexpr size_t kNackRingSize = 512;
+  static_assert(kNackRingSize >= kNackListSizeLimit,
+                "The NACK ring must fit the largest NACK list");
+  static_assert((1 << 16) % kNackRingSize == 0,
+                "The NACK ring size must divide the sequence number range");
 
   // Constructor.
   explicit NackTracker(int nack_threshold_packets);
@@ -162,6 +174,18 @@ class NackTracker {
   // |nack_threshold_packets_|) are flagged as missing.
   void ChangeFromLateToMissing(uint16_t sequence_number_current_received_rtp);
 
+  // Returns the slot of |nack_ring_| of the given sequence number.
+  NackSlot& Slot(uint16_t sequence_number) {
+    return nack_ring_[sequence_number % kNackRingSize];
+  }
+  const NackSlot& Slot(uint16_t sequence_number) const {
+    return nack_ring_[sequence_number % kNackRingSize];
+  }
+
+  // Removes the packets with sequence number older than |sequence_number| from
+  // the NACK list.
+  void EraseOlderThan(uint16_t sequence_number);
+
   // Packets which have sequence number older that
   // |sequence_num_last_received_rtp_| - |max_nack_list_size_| are removed
   // from the NACK list.
@@ -196,10 +220,13 @@ class NackTracker {
   // packet, not only for consecutive packets.
   int samples_per_packet_;
 
-  // A list of missing packets to be retransmitted. Components of the list
-  // contain the sequence number of missing packets and the estimated time that
-  // each pack is going to be played out.
-  NackList nack_list_;
+  // A list of missing packets to be retransmitted, as a ring of slots indexed
+  // by sequence number. The list spans the |nack_list_span_| sequence numbers
+  // starting at |nack_list_begin_|, of which those with |in_list| set are in
+  // the list. The slots outside of the span are never in the list.
+  std::array<NackSlot, kNackRingSize> nack_ring_;
+  uint16_t nack_list_begin_;
+  size_t nack_list_span_;
 
   // NACK list will not keep track of missing packets prior to
   // |sequence_num_last_received_rtp_| - |max_nack_list_size_|.
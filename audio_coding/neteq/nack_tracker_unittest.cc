@@ -479,4 +479,39 @@ TEST(NackTrackerTest, RoudTripTimeIsApplied) {
   EXPECT_EQ(5, nack_list[1]);
 }
 
+// A loss burst longer than the NACK list only leaves the newest packets of the
+// burst in the list, and the list is filled into the given vector.
+TEST(NackTrackerTest, LongLossBurstKeepsNewestPackets) {
+  std::unique_ptr<NackTracker> nack(NackTracker::Create(kNackThreshold));
+  nack->UpdateSampleRate(kSampleRateHz);
+  const size_t kNackListSize = NackTracker::kNackListSizeLimit;
+  nack->SetMaxNackListSize(kNackListSize);
+
+  for (int m = 0; m < 2; ++m) {
+    const uint16_t seq_num_offset = (m == 0) ? 0 : 65000;  // Wrap around.
+    nack->Reset();
+    nack->UpdateSampleRate(kSampleRateHz);
+    uint16_t seq_num = seq_num_offset;
+    uint32_t timestamp = 0;
+    nack->UpdateLastReceivedPacket(seq_num, timestamp);
+    seq_num++;
+    timestamp += kTimestampIncrement;
+    nack->UpdateLastReceivedPacket(seq_num, timestamp);
+
+    const int kNumLostPackets = 3 * kNackListSize;
+    seq_num += kNumLostPackets + 1;
+    timestamp += (kNumLostPackets + 1) * kTimestampIncrement;
+    nack->UpdateLastReceivedPacket(seq_num, timestamp);
+
+    std::vector<uint16_t> nack_list(1, 0);
+    nack->GetNackList(kShortRoundTripTimeMs, &nack_list);
+    EXPECT_EQ(nack->GetNackList(kShortRoundTripTimeMs), nack_list);
+    ASSERT_EQ(kNackListSize - kNackThreshold, nack_list.size());
+    for (size_t k = 0; k < nack_list.size(); ++k) {
+      EXPECT_EQ(static_cast<uint16_t>(seq_num - kNackListSize + k),
+                nack_list[k]);
+    }
+  }
+}
+
 }  // namespace webrtc
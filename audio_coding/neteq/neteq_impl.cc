@@ -84,7 +84,9 @@ NetEqImpl::Dependencies::Dependencies(
       timestamp_scaler(new TimestampScaler(*decoder_database)),
       accelerate_factory(new AccelerateFactory),
       expand_factory(new ExpandFactory),
-      preemptive_expand_factory(new PreemptiveExpandFactory) {}
+      preemptive_expand_factory(new PreemptiveExpandFactory) {
+  packet_buffer->SetByteLimit(config.max_packet_buffer_bytes);
+}
 
 NetEqImpl::Dependencies::~Dependencies() = default;
 
@@ -146,6 +148,10 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
   if (config.enable_post_decode_vad) {
     vad_->Enable();
   }
+  if (create_components) {
+    rtc::CritScope lock(&crit_sect_);
+    PublishStatistics();
+  }
 }
 
 NetEqImpl::~NetEqImpl() = default;
@@ -155,7 +161,23 @@ int NetEqImpl::InsertPacket(const RTPHeader& rtp_header,
   rtc::MsanCheckInitialized(payload);
   TRACE_EVENT0("webrtc", "NetEqImpl::InsertPacket");
   rtc::CritScope lock(&crit_sect_);
-  if (InsertPacketInternal(rtp_header, payload) != 0) {
+  const int error = InsertPacketInternal(
+      rtp_header, rtc::Buffer(payload.data(), payload.size()));
+  PublishStatistics();
+  if (error != 0) {
+    return kFail;
+  }
+  return kOK;
+}
+
+int NetEqImpl::InsertPacketWithBuffer(const RTPHeader& rtp_header,
+                                      rtc::Buffer&& payload) {
+  rtc::MsanCheckInitialized(rtc::ArrayView<const uint8_t>(payload));
+  TRACE_EVENT0("webrtc", "NetEqImpl::InsertPacketWithBuffer");
+  rtc::CritScope lock(&crit_sect_);
+  const int error = InsertPacketInternal(rtp_header, std::move(payload));
+  PublishStatistics();
+  if (error != 0) {
     return kFail;
   }
   return kOK;
@@ -222,7 +244,9 @@ int NetEqImpl::GetAudio(AudioFrame* audio_frame,
                         absl::optional<Operations> action_override) {
   TRACE_EVENT0("webrtc", "NetEqImpl::GetAudio");
   rtc::CritScope lock(&crit_sect_);
-  if (GetAudioInternal(audio_frame, muted, action_override) != 0) {
+  const int error = GetAudioInternal(audio_frame, muted, action_override);
+  PublishStatistics();
+  if (error != 0) {
     return kFail;
   }
   RTC_DCHECK_EQ(
@@ -248,6 +272,7 @@ void NetEqImpl::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
   for (const int pt : changed_payload_types) {
     packet_buffer_->DiscardPacketsWithPayloadType(pt, stats_.get());
   }
+  PublishStatistics();
 }
 
 bool NetEqImpl::RegisterPayloadType(int rtp_payload_type,
@@ -266,6 +291,7 @@ int NetEqImpl::RemovePayloadType(uint8_t rtp_payload_type) {
   if (ret == DecoderDatabase::kOK || ret == DecoderDatabase::kDecoderNotFound) {
     packet_buffer_->DiscardPacketsWithPayloadType(rtp_payload_type,
                                                   stats_.get());
+    PublishStatistics();
     return kOK;
   }
   return kFail;
@@ -345,22 +371,11 @@ int NetEqImpl::NetworkStatistics(NetEqNetworkStatistics* stats) {
 }
 
 NetEqLifetimeStatistics NetEqImpl::GetLifetimeStatistics() const {
-  rtc::CritScope lock(&crit_sect_);
-  return stats_->GetLifetimeStatistics();
+  return lifetime_stats_snapshot_.Read();
 }
 
 NetEqOperationsAndState NetEqImpl::GetOperationsAndState() const {
-  rtc::CritScope lock(&crit_sect_);
-  auto result = stats_->GetOperationsAndState();
-  result.current_buffer_size_ms =
-      (packet_buffer_->NumSamplesInBuffer(decoder_frame_length_) +
-       sync_buffer_->FutureLength()) *
-      1000 / fs_hz_;
-  result.current_frame_size_ms = decoder_frame_length_ * 1000 / fs_hz_;
-  result.next_packet_available = packet_buffer_->PeekNextPacket() &&
-                                 packet_buffer_->PeekNextPacket()->timestamp ==
-                                     sync_buffer_->end_timestamp();
-  return result;
+  return operations_and_state_snapshot_.Read();
 }
 
 void NetEqImpl::EnableVad() {
@@ -422,6 +437,7 @@ void NetEqImpl::FlushBuffers() {
                                expand_->overlap_length());
   // Set to wait for new codec.
   first_packet_ = true;
+  PublishStatistics();
 }
 
 void NetEqImpl::EnableNack(size_t max_nack_list_size) {
@@ -461,6 +477,16 @@ int NetEqImpl::SyncBufferSizeMs() const {
                                  rtc::CheckedDivExact(fs_hz_, 1000));
 }
 
+BufferMemoryUsage NetEqImpl::GetPacketBufferMemoryUsage() const {
+  rtc::CritScope lock(&crit_sect_);
+  return packet_buffer_->GetMemoryUsage();
+}
+
+BufferMemoryUsage NetEqImpl::GetSyncBufferMemoryUsage() const {
+  rtc::CritScope lock(&crit_sect_);
+  return sync_buffer_->GetMemoryUsage();
+}
+
 const SyncBuffer* NetEqImpl::sync_buffer_for_test() const {
   rtc::CritScope lock(&crit_sect_);
   return sync_buffer_.get();
@@ -474,7 +500,7 @@ Operations NetEqImpl::last_operation_for_test() const {
 // Methods below this line are private.
 
 int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
-                                    rtc::ArrayView<const uint8_t> payload) {
+                                    rtc::Buffer payload) {
   if (payload.empty()) {
     RTC_LOG_F(LS_ERROR) << "payload is empty";
     return kInvalidPointer;
@@ -491,7 +517,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
     packet.payload_type = rtp_header.payloadType;
     packet.sequence_number = rtp_header.sequenceNumber;
     packet.timestamp = rtp_header.timestamp;
-    packet.payload.SetData(payload.data(), payload.size());
+    packet.payload = std::move(payload);
     packet.packet_info = RtpPacketInfo(rtp_header, receive_time_ms);
     // Waiting time will be set upon inserting the packet in the buffer.
     RTC_DCHECK(!packet.waiting_time);
@@ -613,6 +639,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
       const auto payload_type = packet.payload_type;
       const Packet::Priority original_priority = packet.priority;
       const auto& packet_info = packet.packet_info;
+      const size_t payload_size = packet.payload.size();
       auto packet_from_result = [&](AudioDecoder::ParseResult& result) {
         Packet new_packet;
         new_packet.sequence_number = sequence_number;
@@ -622,6 +649,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
         new_packet.priority.red_level = original_priority.red_level;
         new_packet.packet_info = packet_info;
         new_packet.frame = std::move(result.frame);
+        new_packet.parsed_payload_size = payload_size;
         return new_packet;
       };
 
@@ -2092,4 +2120,20 @@ void NetEqImpl::CreateDecisionLogic() {
       decoder_database_.get(), *packet_buffer_.get(), delay_manager_.get(),
       buffer_level_filter_.get(), tick_timer_.get()));
 }
+
+void NetEqImpl::PublishStatistics() {
+  lifetime_stats_snapshot_.Publish(stats_->GetLifetimeStatistics());
+  auto result = stats_->GetOperationsAndState();
+  result.current_buffer_size_ms =
+      (packet_buffer_->NumSamplesInBuffer(decoder_frame_length_) +
+       sync_buffer_->FutureLength()) *
+      1000 / fs_hz_;
+  result.current_frame_size_ms = decoder_frame_length_ * 1000 / fs_hz_;
+  result.next_packet_available = packet_buffer_->PeekNextPacket() &&
+                                 packet_buffer_->PeekNextPacket()->timestamp ==
+                                     sync_buffer_->end_timestamp();
+  result.last_mode = last_mode_;
+  operations_and_state_snapshot_.Publish(result);
+}
+
 }  // namespace webrtc
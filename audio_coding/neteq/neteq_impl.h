@@ -28,6 +28,7 @@
 #include "modules/audio_coding/neteq/random_vector.h"
 #include "modules/audio_coding/neteq/statistics_calculator.h"
 #include "modules/audio_coding/neteq/tick_timer.h"
+#include "modules/utility/include/statistics_snapshot.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
@@ -133,6 +134,9 @@ class NetEqImpl : public webrtc::NetEq {
   int InsertPacket(const RTPHeader& rtp_header,
                    rtc::ArrayView<const uint8_t> payload) override;
 
+  int InsertPacketWithBuffer(const RTPHeader& rtp_header,
+                             rtc::Buffer&& payload) override;
+
   void InsertEmptyPacket(const RTPHeader& rtp_header) override;
 
   int GetAudio(
@@ -167,8 +171,14 @@ class NetEqImpl : public webrtc::NetEq {
   // after the call.
   int NetworkStatistics(NetEqNetworkStatistics* stats) override;
 
+  // Returns the statistics as of the last call that changed them, such as
+  // InsertPacket() and GetAudio(). Does not take |crit_sect_|, so it never
+  // waits for the audio thread.
   NetEqLifetimeStatistics GetLifetimeStatistics() const override;
 
+  // Returns the operations and state as of the last call that changed them,
+  // such as InsertPacket(), GetAudio() and FlushBuffers(). Does not take
+  // |crit_sect_|, so it never waits for the audio thread.
   NetEqOperationsAndState GetOperationsAndState() const override;
 
   // Enables post-decode VAD. When enabled, GetAudio() will return
@@ -198,6 +208,10 @@ class NetEqImpl : public webrtc::NetEq {
 
   int SyncBufferSizeMs() const override;
 
+  BufferMemoryUsage GetPacketBufferMemoryUsage() const override;
+
+  BufferMemoryUsage GetSyncBufferMemoryUsage() const override;
+
   // This accessor method is only intended for testing purposes.
   const SyncBuffer* sync_buffer_for_test() const;
   Operations last_operation_for_test() const;
@@ -213,8 +227,7 @@ class NetEqImpl : public webrtc::NetEq {
   // Inserts a new packet into NetEq. This is used by the InsertPacket method
   // above. Returns 0 on success, otherwise an error code.
   // TODO(hlundin): Merge this with InsertPacket above?
-  int InsertPacketInternal(const RTPHeader& rtp_header,
-                           rtc::ArrayView<const uint8_t> payload)
+  int InsertPacketInternal(const RTPHeader& rtp_header, rtc::Buffer payload)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
   // Delivers 10 ms of audio data. The data is written to |audio_frame|.
@@ -341,6 +354,10 @@ class NetEqImpl : public webrtc::NetEq {
   // Creates DecisionLogic object with the mode given by |playout_mode_|.
   virtual void CreateDecisionLogic() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
+  // Publishes the lifetime statistics and the operations and state to
+  // GetLifetimeStatistics() and GetOperationsAndState().
+  void PublishStatistics() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
   Clock* const clock_;
 
   rtc::CriticalSection crit_sect_;
@@ -368,6 +385,8 @@ class NetEqImpl : public webrtc::NetEq {
   const std::unique_ptr<PreemptiveExpandFactory> preemptive_expand_factory_
       RTC_GUARDED_BY(crit_sect_);
   const std::unique_ptr<StatisticsCalculator> stats_ RTC_GUARDED_BY(crit_sect_);
+  StatisticsSnapshot<NetEqLifetimeStatistics> lifetime_stats_snapshot_;
+  StatisticsSnapshot<NetEqOperationsAndState> operations_and_state_snapshot_;
 
   std::unique_ptr<BackgroundNoise> background_noise_ RTC_GUARDED_BY(crit_sect_);
   std::unique_ptr<DecisionLogic> decision_logic_ RTC_GUARDED_BY(crit_sect_);
@@ -422,6 +422,80 @@ TEST_F(NetEqImplTest, InsertPacketsUntilBufferIsFull) {
   EXPECT_EQ(rtp_header.sequenceNumber, test_packet->sequence_number);
 }
 
+TEST_F(NetEqImplTest, OperationsAndStateAreCurrentAfterInsertAndFlush) {
+  UseNoMocks();
+  CreateInstance();
+
+  const int kPayloadLengthSamples = 80;
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;  // PCM 16-bit.
+  const uint8_t kPayloadType = 17;   // Just an arbitrary number.
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+
+  EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                          SdpAudioFormat("l16", 8000, 1)));
+  const uint64_t initial_buffer_size_ms =
+      neteq_->GetOperationsAndState().current_buffer_size_ms;
+
+  // The buffer level grows with every inserted packet, without having to pull
+  // audio first.
+  uint64_t last_buffer_size_ms = initial_buffer_size_ms;
+  for (size_t i = 1; i <= config_.max_packets_in_buffer; ++i) {
+    EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+    rtp_header.timestamp += kPayloadLengthSamples;
+    rtp_header.sequenceNumber += 1;
+    const NetEqOperationsAndState ops_state = neteq_->GetOperationsAndState();
+    EXPECT_GT(ops_state.current_buffer_size_ms, last_buffer_size_ms);
+    EXPECT_EQ(0u, ops_state.packet_buffer_flushes);
+    last_buffer_size_ms = ops_state.current_buffer_size_ms;
+  }
+
+  // Overflowing the buffer is reported by the same InsertPacket() call.
+  EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+  EXPECT_EQ(1u, neteq_->GetOperationsAndState().packet_buffer_flushes);
+
+  neteq_->FlushBuffers();
+  EXPECT_LE(neteq_->GetOperationsAndState().current_buffer_size_ms,
+            initial_buffer_size_ms);
+}
+
+TEST_F(NetEqImplTest, InsertPacketWithBuffer) {
+  UseNoMocks();
+  CreateInstance();
+
+  const int kPayloadLengthSamples = 80;
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;  // PCM 16-bit.
+  const uint8_t kPayloadType = 17;   // Just an arbitrary number.
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+
+  EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                          SdpAudioFormat("l16", 8000, 1)));
+
+  for (size_t i = 1; i <= 3; ++i) {
+    rtc::Buffer payload(kPayloadLengthBytes);
+    memset(payload.data(), 0, payload.size());
+    EXPECT_EQ(NetEq::kOK,
+              neteq_->InsertPacketWithBuffer(rtp_header, std::move(payload)));
+    // NetEq has taken ownership of the payload.
+    EXPECT_TRUE(payload.empty());
+    rtp_header.timestamp += kPayloadLengthSamples;
+    rtp_header.sequenceNumber += 1;
+    EXPECT_EQ(i, packet_buffer_->NumPacketsInBuffer());
+  }
+
+  // An empty payload is rejected, as with InsertPacket().
+  EXPECT_EQ(NetEq::kFail,
+            neteq_->InsertPacketWithBuffer(rtp_header, rtc::Buffer()));
+}
+
 TEST_F(NetEqImplTest, TestDtmfPacketAVT) {
   TestDtmfPacket(8000);
 }
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_offline_decoder.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+constexpr int kOutputFrameSizeMs = 10;
+}  // namespace
+
+NetEqOfflineDecoder::NetEqOfflineDecoder(
+    const NetEq::Config& config,
+    const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory,
+    const std::map<int, SdpAudioFormat>& codecs)
+    : clock_(0), neteq_(NetEq::Create(config, &clock_, decoder_factory)) {
+  neteq_->SetCodecs(codecs);
+}
+
+NetEqOfflineDecoder::~NetEqOfflineDecoder() = default;
+
+bool NetEqOfflineDecoder::InsertPacket(int64_t arrival_time_ms,
+                                       const RTPHeader& rtp_header,
+                                       rtc::ArrayView<const uint8_t> payload,
+                                       AudioSink sink) {
+  if (!started_) {
+    started_ = true;
+    next_output_time_ms_ = arrival_time_ms;
+    clock_.AdvanceTimeMilliseconds(arrival_time_ms -
+                                   clock_.TimeInMilliseconds());
+  }
+  RTC_DCHECK_GE(arrival_time_ms, clock_.TimeInMilliseconds());
+  if (!AdvanceTo(arrival_time_ms, sink)) {
+    return false;
+  }
+  clock_.AdvanceTimeMilliseconds(arrival_time_ms -
+                                 clock_.TimeInMilliseconds());
+  if (neteq_->InsertPacket(rtp_header, payload) != NetEq::kOK) {
+    RTC_LOG(LS_WARNING) << "NetEq rejected packet with sequence number "
+                        << rtp_header.sequenceNumber;
+    return false;
+  }
+  return true;
+}
+
+bool NetEqOfflineDecoder::AdvanceTo(int64_t time_ms, AudioSink sink) {
+  if (!started_) {
+    return true;
+  }
+  // Packets arriving at the time of an output frame are inserted before the
+  // frame is produced, which is how NetEqTest orders the events.
+  while (next_output_time_ms_ < time_ms) {
+    clock_.AdvanceTimeMilliseconds(next_output_time_ms_ -
+                                   clock_.TimeInMilliseconds());
+    bool muted;
+    if (neteq_->GetAudio(&output_frame_, &muted) != NetEq::kOK) {
+      RTC_LOG(LS_WARNING) << "NetEq failed to produce output";
+      return false;
+    }
+    sink(output_frame_);
+    ++num_output_frames_;
+    next_output_time_ms_ += kOutputFrameSizeMs;
+  }
+  return true;
+}
+
+}  // namespace webrtc
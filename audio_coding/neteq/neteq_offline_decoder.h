@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_NETEQ_OFFLINE_DECODER_H_
+#define MODULES_AUDIO_CODING_NETEQ_NETEQ_OFFLINE_DECODER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/audio_decoder_factory.h"
+#include "api/audio_codecs/audio_format.h"
+#include "api/function_view.h"
+#include "api/rtp_headers.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/neteq/include/neteq.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Decodes recorded RTP streams with NetEq as fast as possible. The packets
+// are inserted in arrival order, together with their arrival times, and the
+// decoder produces all the 10 ms output frames that NetEq would have produced
+// up to that time on a simulated clock. Unlike the NetEq test tools, no
+// packet sources or output files are involved. Each instance is independent,
+// so several recordings can be decoded in parallel on different threads, as
+// long as each instance is used by one thread at a time.
+class NetEqOfflineDecoder {
+ public:
+  // Receives each output frame. |audio_frame| is only valid during the call.
+  using AudioSink = rtc::FunctionView<void(const AudioFrame& audio_frame)>;
+
+  // |codecs| maps the RTP payload types to the formats to decode.
+  NetEqOfflineDecoder(
+      const NetEq::Config& config,
+      const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory,
+      const std::map<int, SdpAudioFormat>& codecs);
+  ~NetEqOfflineDecoder();
+  NetEqOfflineDecoder(const NetEqOfflineDecoder&) = delete;
+  NetEqOfflineDecoder& operator=(const NetEqOfflineDecoder&) = delete;
+
+  // Produces the output up to |arrival_time_ms| and then inserts the packet.
+  // Arrival times must not decrease between calls. The time of the first
+  // packet is the start of the simulation. Returns false if the output could
+  // not be produced or NetEq rejected the packet.
+  bool InsertPacket(int64_t arrival_time_ms,
+                    const RTPHeader& rtp_header,
+                    rtc::ArrayView<const uint8_t> payload,
+                    AudioSink sink);
+
+  // Produces the output up to |time_ms|, e.g., to drain the jitter buffer
+  // after the last packet. Returns false if NetEq failed to produce output.
+  bool AdvanceTo(int64_t time_ms, AudioSink sink);
+
+  // Returns the simulated time of the next output frame.
+  int64_t next_output_time_ms() const { return next_output_time_ms_; }
+
+  // Returns the number of output frames produced so far.
+  int64_t num_output_frames() const { return num_output_frames_; }
+
+  NetEq* neteq() { return neteq_.get(); }
+
+ private:
+  SimulatedClock clock_;
+  const std::unique_ptr<NetEq> neteq_;
+  AudioFrame output_frame_;
+  bool started_ = false;
+  int64_t next_output_time_ms_ = 0;
+  int64_t num_output_frames_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_NETEQ_OFFLINE_DECODER_H_
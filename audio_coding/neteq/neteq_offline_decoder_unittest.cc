@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_offline_decoder.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr int kPayloadType = 94;
+constexpr int kPacketSizeMs = 20;
+constexpr size_t kPacketSizeSamples = kSampleRateHz * kPacketSizeMs / 1000;
+
+// Decodes |num_packets| packets of a tone and returns the output.
+std::vector<int16_t> DecodeTone(int num_packets,
+                                int64_t* num_output_frames,
+                                int64_t end_time_ms) {
+  NetEq::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  NetEqOfflineDecoder decoder(
+      config, CreateBuiltinAudioDecoderFactory(),
+      {{kPayloadType, SdpAudioFormat("l16", kSampleRateHz, 1)}});
+
+  std::vector<int16_t> output;
+  auto sink = [&output](const AudioFrame& audio_frame) {
+    const int16_t* data = audio_frame.data();
+    output.insert(output.end(), data,
+                  data + audio_frame.samples_per_channel_ *
+                             audio_frame.num_channels_);
+  };
+
+  RTPHeader header;
+  header.payloadType = kPayloadType;
+  header.ssrc = 0x1234;
+  for (int i = 0; i < num_packets; ++i) {
+    int16_t samples[kPacketSizeSamples];
+    for (size_t j = 0; j < kPacketSizeSamples; ++j) {
+      const size_t n = i * kPacketSizeSamples + j;
+      samples[j] = static_cast<int16_t>(
+          5000 * sin(2 * M_PI * 440.0 * n / kSampleRateHz));
+    }
+    uint8_t payload[kPacketSizeSamples * 2];
+    WebRtcPcm16b_Encode(samples, kPacketSizeSamples, payload);
+    header.sequenceNumber = static_cast<uint16_t>(i);
+    header.timestamp = static_cast<uint32_t>(i * kPacketSizeSamples);
+    EXPECT_TRUE(
+        decoder.InsertPacket(1000 + i * kPacketSizeMs, header, payload, sink));
+  }
+  EXPECT_TRUE(decoder.AdvanceTo(end_time_ms, sink));
+  *num_output_frames = decoder.num_output_frames();
+  return output;
+}
+
+}  // namespace
+
+TEST(NetEqOfflineDecoder, ProducesOutputUpToTheRequestedTime) {
+  constexpr int kNumPackets = 50;
+  constexpr int64_t kEndTimeMs = 1000 + kNumPackets * kPacketSizeMs + 100;
+  int64_t num_output_frames = 0;
+  const std::vector<int16_t> output =
+      DecodeTone(kNumPackets, &num_output_frames, kEndTimeMs);
+
+  // One 10 ms frame per 10 ms since the arrival of the first packet.
+  EXPECT_EQ((kEndTimeMs - 1000) / 10, num_output_frames);
+  EXPECT_EQ(static_cast<size_t>(num_output_frames * kSampleRateHz / 100),
+            output.size());
+
+  // The tone is decoded.
+  int16_t max_abs = 0;
+  for (int16_t sample : output) {
+    max_abs = std::max<int16_t>(max_abs, std::abs(sample));
+  }
+  EXPECT_GT(max_abs, 4000);
+}
+
+TEST(NetEqOfflineDecoder, IsDeterministic) {
+  int64_t num_output_frames_1 = 0;
+  int64_t num_output_frames_2 = 0;
+  EXPECT_EQ(DecodeTone(30, &num_output_frames_1, 2000),
+            DecodeTone(30, &num_output_frames_2, 2000));
+  EXPECT_EQ(num_output_frames_1, num_output_frames_2);
+}
+
+}  // namespace webrtc
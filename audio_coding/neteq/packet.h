@@ -77,6 +77,9 @@ struct Packet {
   RtpPacketInfo packet_info;
   std::unique_ptr<TickTimer::Stopwatch> waiting_time;
   std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame;
+  // Size of the payload that |frame| was parsed from, which the frame holds on
+  // to. Only used for memory accounting.
+  size_t parsed_payload_size = 0;
 
   Packet();
   Packet(Packet&& b);
@@ -8,14 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// of contiguous packet slots. The ring is kept sorted at all times so that the
+// next packet to decode is at the beginning of the ring.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -36,7 +35,9 @@ class NewTimestampIsLarger {
  public:
   explicit NewTimestampIsLarger(const Packet& new_packet)
       : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
+  bool operator()(const Packet& packet) const {
+    return (new_packet_ >= packet);
+  }
 
  private:
   const Packet& new_packet_;
@@ -52,6 +53,13 @@ bool EqualSampleRates(uint8_t pt1,
   return di1 && di2 && di1->SampleRateHz() == di2->SampleRateHz();
 }
 
+size_t PacketSize(const Packet& packet) {
+  return packet.payload.size() + packet.parsed_payload_size;
+}
+
+// Initial number of slots of the packet ring.
+constexpr size_t kInitialRingSize = 16;
+
 void LogPacketDiscarded(int codec_level, StatisticsCalculator* stats) {
   RTC_CHECK(stats);
   if (codec_level > 0) {
@@ -74,11 +82,16 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  buffer_.clear();
+  for (size_t k = 0; k < size_; ++k) {
+    At(k) = Packet();
+  }
+  begin_ = 0;
+  size_ = 0;
+  memory_usage_.Clear();
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
@@ -94,7 +107,9 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_ ||
+      (byte_limit_ > 0 &&
+       memory_usage_.bytes + PacketSize(packet) > byte_limit_)) {
     // Buffer is full. Flush it.
     Flush();
     stats->FlushedPacketBuffer();
@@ -102,29 +117,34 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
     return_val = kFlushed;
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the place in the buffer where the new packet should be inserted. The
+  // buffer is searched from the back, since the most likely case is that the
+  // new packet should be near the end of the buffer.
+  const NewTimestampIsLarger goes_before_new_packet(packet);
+  size_t index = size_;
+  while (index > 0 && !goes_before_new_packet(At(index - 1))) {
+    --index;
+  }
 
-  // The new packet is to be inserted to the right of |rit|. If it has the same
-  // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted after the packet at |index - 1|. If it
+  // has the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet to the buffer.
+  if (index > 0 && packet.timestamp == At(index - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of |it|. If it has the same
-  // timestamp as |it|, which has a lower priority, replace |it| with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+  // The new packet is to be inserted before the packet at |index|. If it has
+  // the same timestamp as that packet, which has a lower priority, replace that
+  // packet with the new packet.
+  if (index < size_ && packet.timestamp == At(index).timestamp) {
+    LogPacketDiscarded(At(index).priority.codec_level, stats);
+    memory_usage_.Remove(PacketSize(At(index)));
+    memory_usage_.Add(PacketSize(packet));
+    At(index) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  InsertAt(index, std::move(packet));  // Insert the packet at that position.
 
   return return_val;
 }
@@ -182,7 +202,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = At(0).timestamp;
   return kOK;
 }
 
@@ -194,11 +214,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t k = 0; k < size_; ++k) {
+    if (At(k).timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = At(k).timestamp;
       return kOK;
     }
   }
@@ -206,7 +225,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &At(0);
 }
 
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
@@ -215,10 +234,11 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
     return absl::nullopt;
   }
 
-  absl::optional<Packet> packet(std::move(buffer_.front()));
+  absl::optional<Packet> packet(std::move(At(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  memory_usage_.Remove(PacketSize(*packet));
+  PopFront();
 
   return packet;
 }
@@ -228,17 +248,19 @@ int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  const Packet& packet = At(0);
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level, stats);
-  buffer_.pop_front();
+  memory_usage_.Remove(PacketSize(packet));
+  At(0) = Packet();
+  PopFront();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
+  RemoveIf([timestamp_limit, horizon_samples, stats](const Packet& p) {
     if (timestamp_limit == p.timestamp ||
         !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
       return false;
@@ -255,7 +277,7 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
+  RemoveIf([payload_type, stats](const Packet& p) {
     if (p.payload_type != payload_type) {
       return false;
     }
@@ -265,13 +287,14 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t k = 0; k < size_; ++k) {
+    const Packet& packet = At(k);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -291,16 +314,17 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
 size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
                                     size_t sample_rate,
                                     bool count_dtx_waiting_time) const {
-  if (buffer_.size() == 0) {
+  if (size_ == 0) {
     return 0;
   }
 
-  size_t span = buffer_.back().timestamp - buffer_.front().timestamp;
-  if (buffer_.back().frame && buffer_.back().frame->Duration() > 0) {
-    size_t duration = buffer_.back().frame->Duration();
-    if (count_dtx_waiting_time && buffer_.back().frame->IsDtxPacket()) {
+  const Packet& last_packet = At(size_ - 1);
+  size_t span = last_packet.timestamp - At(0).timestamp;
+  if (last_packet.frame && last_packet.frame->Duration() > 0) {
+    size_t duration = last_packet.frame->Duration();
+    if (count_dtx_waiting_time && last_packet.frame->IsDtxPacket()) {
       size_t waiting_time_samples = rtc::dchecked_cast<size_t>(
-          buffer_.back().waiting_time->ElapsedMs() * (sample_rate / 1000));
+          last_packet.waiting_time->ElapsedMs() * (sample_rate / 1000));
       duration = std::max(duration, waiting_time_samples);
     }
     span += duration;
@@ -310,10 +334,19 @@ size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
   return span;
 }
 
+void PacketBuffer::SetByteLimit(size_t byte_limit) {
+  byte_limit_ = byte_limit;
+}
+
+BufferMemoryUsage PacketBuffer::GetMemoryUsage() const {
+  return memory_usage_;
+}
+
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t k = 0; k < size_; ++k) {
+    const Packet& packet = At(k);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -322,4 +355,73 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+Packet& PacketBuffer::At(size_t index) {
+  RTC_DCHECK_LT(index, size_);
+  const size_t slot = begin_ + index;
+  return ring_[slot < ring_.size() ? slot : slot - ring_.size()];
+}
+
+const Packet& PacketBuffer::At(size_t index) const {
+  RTC_DCHECK_LT(index, size_);
+  const size_t slot = begin_ + index;
+  return ring_[slot < ring_.size() ? slot : slot - ring_.size()];
+}
+
+void PacketBuffer::InsertAt(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  if (size_ == ring_.size()) {
+    Grow();
+  }
+  ++size_;
+  if (index < size_ / 2) {
+    // Closer to the front: move the preceding packets one slot backwards.
+    begin_ = begin_ == 0 ? ring_.size() - 1 : begin_ - 1;
+    for (size_t k = 0; k < index; ++k) {
+      At(k) = std::move(At(k + 1));
+    }
+  } else {
+    // Closer to the back: move the following packets one slot forward.
+    for (size_t k = size_ - 1; k > index; --k) {
+      At(k) = std::move(At(k - 1));
+    }
+  }
+  memory_usage_.Add(PacketSize(packet));
+  At(index) = std::move(packet);
+}
+
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  begin_ = begin_ + 1 == ring_.size() ? 0 : begin_ + 1;
+  --size_;
+}
+
+void PacketBuffer::RemoveIf(
+    rtc::FunctionView<bool(const Packet&)> predicate) {
+  size_t num_kept = 0;
+  for (size_t k = 0; k < size_; ++k) {
+    if (predicate(At(k))) {
+      memory_usage_.Remove(PacketSize(At(k)));
+      At(k) = Packet();
+    } else {
+      if (num_kept != k) {
+        At(num_kept) = std::move(At(k));
+      }
+      ++num_kept;
+    }
+  }
+  size_ = num_kept;
+}
+
+void PacketBuffer::Grow() {
+  const size_t new_ring_size = std::max<size_t>(
+      std::min(2 * ring_.size(), max_number_of_packets_), kInitialRingSize);
+  RTC_DCHECK_GT(new_ring_size, ring_.size());
+  std::vector<Packet> new_ring(new_ring_size);
+  for (size_t k = 0; k < size_; ++k) {
+    new_ring[k] = std::move(At(k));
+  }
+  ring_.swap(new_ring);
+  begin_ = 0;
+}
+
 }  // namespace webrtc
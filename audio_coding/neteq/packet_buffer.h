@@ -11,10 +11,13 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "absl/types/optional.h"
+#include "api/function_view.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
-#include "modules/include/module_common_types_public.h"  // IsNewerTimestamp
+#include "modules/include/module_common_types_public.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
@@ -127,6 +130,16 @@ class PacketBuffer {
                                 size_t sample_rate,
                                 bool count_dtx_waiting_time) const;
 
+  // Caps the payload bytes of the buffered packets. A packet that would take
+  // the buffer above |byte_limit| flushes the buffer, the same way as when it
+  // holds |max_number_of_packets| packets. A |byte_limit| of 0 is equivalent to
+  // no limit.
+  virtual void SetByteLimit(size_t byte_limit);
+
+  // The bytes of a parsed packet are those of the payload it was parsed from,
+  // see Packet::parsed_payload_size.
+  virtual BufferMemoryUsage GetMemoryUsage() const;
+
   // Returns true if the packet buffer contains any DTX or CNG packets.
   virtual bool ContainsDtxOrCngPacket(
       const DecoderDatabase* decoder_database) const;
@@ -146,8 +159,27 @@ class PacketBuffer {
   }
 
  private:
+  // The packets are stored in timestamp order in a ring of contiguous slots,
+  // which grows on demand and is never shrunk. Inserting near the end of the
+  // buffer and extracting the first packet therefore only move a few packets
+  // and, once the ring has grown, do not allocate.
+  Packet& At(size_t index);
+  const Packet& At(size_t index) const;
+  // Inserts |packet| before the packet at |index|.
+  void InsertAt(size_t index, Packet&& packet);
+  // Removes the first packet. The packet is deleted unless moved from.
+  void PopFront();
+  // Removes the packets for which |predicate| returns true, keeping the order
+  // of the remaining ones.
+  void RemoveIf(rtc::FunctionView<bool(const Packet&)> predicate);
+  void Grow();
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  size_t byte_limit_ = 0;
+  BufferMemoryUsage memory_usage_;
+  std::vector<Packet> ring_;
+  size_t begin_ = 0;
+  size_t size_ = 0;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
@@ -188,6 +188,51 @@ TEST(PacketBuffer, OverfillBuffer) {
   buffer.Flush();
 }
 
+TEST(PacketBuffer, TracksMemoryUsage) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);  // 10 packets.
+  PacketGenerator gen(0, 0, 0, 10);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(10, nullptr), &mock_stats));
+  }
+  EXPECT_EQ(30u, buffer.GetMemoryUsage().bytes);
+  EXPECT_EQ(3u, buffer.GetMemoryUsage().num_items);
+
+  EXPECT_TRUE(buffer.GetNextPacket());
+  EXPECT_EQ(20u, buffer.GetMemoryUsage().bytes);
+  EXPECT_EQ(2u, buffer.GetMemoryUsage().num_items);
+  EXPECT_EQ(30u, buffer.GetMemoryUsage().max_bytes);
+
+  buffer.Flush();
+  EXPECT_EQ(0u, buffer.GetMemoryUsage().bytes);
+  EXPECT_EQ(0u, buffer.GetMemoryUsage().num_items);
+}
+
+// Fill the buffer up to its byte limit, and verify that it flushes.
+TEST(PacketBuffer, FlushesAtByteLimit) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);  // 10 packets.
+  buffer.SetByteLimit(35);
+  PacketGenerator gen(0, 0, 0, 10);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(gen.NextPacket(10, nullptr), &mock_stats));
+  }
+  const Packet packet = gen.NextPacket(10, nullptr);
+  EXPECT_EQ(PacketBuffer::kFlushed,
+            buffer.InsertPacket(packet.Clone(), &mock_stats));
+  EXPECT_EQ(1u, buffer.NumPacketsInBuffer());
+  EXPECT_EQ(10u, buffer.GetMemoryUsage().bytes);
+  uint32_t next_ts;
+  EXPECT_EQ(PacketBuffer::kOK, buffer.NextTimestamp(&next_ts));
+  EXPECT_EQ(packet.timestamp, next_ts);
+}
+
 // Test inserting a list of packets.
 TEST(PacketBuffer, InsertPacketList) {
   TickTimer tick_timer;
@@ -451,6 +496,45 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Inserts and extracts packets so that the first packet wraps around the end
+// of the packet storage several times, with the storage growing in between,
+// and verifies that the packets come out in order.
+TEST(PacketBuffer, InterleavedInsertionAndExtraction) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(100, &tick_timer);  // 100 packets.
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(17, start_ts, 0, ts_increment);
+  StrictMock<MockStatisticsCalculator> mock_stats;
+
+  uint32_t next_ts = start_ts;
+  for (int round = 0; round < 20; ++round) {
+    // Insert pairs of packets in swapped order, a few more each round.
+    for (int i = 0; i < 5 + round; ++i) {
+      Packet first = gen.NextPacket(10, nullptr);
+      Packet second = gen.NextPacket(10, nullptr);
+      EXPECT_EQ(PacketBuffer::kOK,
+                buffer.InsertPacket(std::move(second), &mock_stats));
+      EXPECT_EQ(PacketBuffer::kOK,
+                buffer.InsertPacket(std::move(first), &mock_stats));
+    }
+    // Extract all but a few of the packets.
+    while (buffer.NumPacketsInBuffer() > 3) {
+      const absl::optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(next_ts, packet->timestamp);
+      next_ts += ts_increment;
+    }
+  }
+  while (!buffer.Empty()) {
+    const absl::optional<Packet> packet = buffer.GetNextPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(next_ts, packet->timestamp);
+    next_ts += ts_increment;
+  }
+  EXPECT_EQ(gen.ts_, next_ts);
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
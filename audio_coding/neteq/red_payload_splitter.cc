@@ -12,6 +12,7 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
 
 #include <cstdint>
 #include <list>
@@ -40,7 +41,7 @@ bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
   bool ret = true;
   PacketList::iterator it = packet_list->begin();
   while (it != packet_list->end()) {
-    const Packet& red_packet = *it;
+    Packet& red_packet = *it;
     assert(!red_packet.payload.empty());
     const uint8_t* payload_ptr = red_packet.payload.data();
 
@@ -117,7 +118,15 @@ bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
         new_packet.sequence_number = red_packet.sequence_number;
         new_packet.priority.red_level =
             rtc::dchecked_cast<int>((new_headers.size() - 1) - i);
-        new_packet.payload.SetData(payload_ptr, payload_length);
+        if (i + 1 == new_headers.size()) {
+          // The primary payload comes last. Move it to the front of the RED
+          // packet's buffer and reuse that, instead of allocating a new one.
+          memmove(red_packet.payload.data(), payload_ptr, payload_length);
+          red_packet.payload.SetSize(payload_length);
+          new_packet.payload = std::move(red_packet.payload);
+        } else {
+          new_packet.payload.SetData(payload_ptr, payload_length);
+        }
         new_packet.packet_info = RtpPacketInfo(
             /*ssrc=*/red_packet.packet_info.ssrc(),
             /*csrcs=*/std::vector<uint32_t>(),
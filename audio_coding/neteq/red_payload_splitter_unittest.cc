@@ -198,6 +198,24 @@ TEST(RedPayloadSplitter, OnePacketTwoPayloads) {
                kSequenceNumber, kBaseTimestamp - kTimestampOffset, 0, false);
 }
 
+// The primary payload reuses the buffer of the RED packet.
+TEST(RedPayloadSplitter, PrimaryPayloadReusesBuffer) {
+  uint8_t payload_types[] = {0, 0};
+  const int kTimestampOffset = 160;
+  PacketList packet_list;
+  packet_list.push_back(CreateRedPayload(2, payload_types, kTimestampOffset));
+  const uint8_t* red_buffer = packet_list.front().payload.data();
+  RedPayloadSplitter splitter;
+  EXPECT_TRUE(splitter.SplitRed(&packet_list));
+  ASSERT_EQ(2u, packet_list.size());
+  EXPECT_EQ(red_buffer, packet_list.front().payload.data());
+  VerifyPacket(packet_list.front(), kPayloadLength, payload_types[1],
+               kSequenceNumber, kBaseTimestamp, 1, true);
+  EXPECT_NE(red_buffer, packet_list.back().payload.data());
+  VerifyPacket(packet_list.back(), kPayloadLength, payload_types[0],
+               kSequenceNumber, kBaseTimestamp - kTimestampOffset, 0, false);
+}
+
 // Packets A and B are not split at all. Only the RED header in each packet is
 // removed.
 TEST(RedPayloadSplitter, TwoPacketsOnePayload) {
@@ -20,6 +20,14 @@ size_t SyncBuffer::FutureLength() const {
   return Size() - next_index_;
 }
 
+BufferMemoryUsage SyncBuffer::GetMemoryUsage() const {
+  BufferMemoryUsage usage;
+  usage.bytes = Channels() * Size() * sizeof(int16_t);
+  usage.max_bytes = usage.bytes;
+  usage.num_items = FutureLength();
+  return usage;
+}
+
 void SyncBuffer::PushBack(const AudioMultiVector& append_this) {
   size_t samples_added = append_this.Size();
   AudioMultiVector::PushBack(append_this);
@@ -19,6 +19,7 @@
 #include "api/audio/audio_frame.h"
 #include "modules/audio_coding/neteq/audio_multi_vector.h"
 #include "modules/audio_coding/neteq/audio_vector.h"
+#include "modules/include/module_common_types_public.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/constructor_magic.h"
 
@@ -35,6 +36,10 @@ class SyncBuffer : public AudioMultiVector {
   // Returns the number of samples yet to play out from the buffer.
   size_t FutureLength() const;
 
+  // Returns the bytes of the samples in the buffer, which keeps a constant
+  // size. The items are the samples per channel yet to play out.
+  BufferMemoryUsage GetMemoryUsage() const;
+
   // Adds the contents of |append_this| to the back of the SyncBuffer. Removes
   // the same number of samples from the beginning of the SyncBuffer, to
   // maintain a constant buffer size. The |next_index_| is updated to reflect
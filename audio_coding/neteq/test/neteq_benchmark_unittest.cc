@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_benchmark.h"
+
+#include <string>
+
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+using NetworkTrace = NetworkTraceNetEqInput::NetworkTrace;
+
+// Decodes |format| over each of the network traces, and reports the CPU time
+// per second of audio, in total and for each operation.
+void RunBenchmark(const std::string& codec_name,
+                  const SdpAudioFormat& format) {
+  const int64_t kAudioDurationMs = 600000;
+  const int64_t kQuickAudioDurationMs = 20000;
+  const int64_t audio_duration_ms =
+      field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickAudioDurationMs
+                                                     : kAudioDurationMs;
+  const NetworkTrace kTraces[] = {NetworkTraceNetEqInput::BurstyLossTrace(),
+                                  NetworkTraceNetEqInput::ReorderingTrace(),
+                                  NetworkTraceNetEqInput::ClockDriftTrace()};
+  for (const NetworkTrace& trace : kTraces) {
+    const NetEqBenchmark::Result result =
+        NetEqBenchmark::Run(format, trace, audio_duration_ms);
+    ASSERT_GT(result.audio_duration_ms, 0);
+    const std::string modifier = "_" + codec_name + "_" + trace.name;
+    PrintResult("neteq_benchmark", modifier, "total",
+                result.TotalMsPerSecond(), "ms/s", true);
+    for (int i = 0; i < NetEqBenchmark::kNumOperations; ++i) {
+      const auto operation = static_cast<NetEqBenchmark::Operation>(i);
+      PrintResult("neteq_benchmark", modifier,
+                  NetEqBenchmark::OperationName(operation),
+                  result.OperationMsPerSecond(operation), "ms/s", false);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(NetEqBenchmark, Opus) {
+  RunBenchmark("opus", SdpAudioFormat("opus", 48000, 2));
+}
+
+TEST(NetEqBenchmark, G711) {
+  RunBenchmark("pcmu", SdpAudioFormat("pcmu", 8000, 1));
+}
+
+TEST(NetEqBenchmark, Pcm16) {
+  RunBenchmark("l16", SdpAudioFormat("l16", 16000, 1));
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -47,3 +47,20 @@ TEST(NetEqPerformanceTest, RunClean) {
   webrtc::test::PrintResult("neteq_performance", "", "0_pl_0_drift", runtime,
                             "ms", true);
 }
+
+// Runs a test with 33% packet losses and 10% clock drift, to put emphasis on
+// the correlation-heavy expand and merge operations.
+TEST(NetEqPerformanceTest, RunHighLoss) {
+  const int kSimulationTimeMs = 10000000;
+  const int kQuickSimulationTimeMs = 100000;
+  const int kLossPeriod = 3;  // Drop every 3rd packet.
+  const double kDriftFactor = 0.1;
+  int64_t runtime = webrtc::test::NetEqPerformanceTest::Run(
+      webrtc::field_trial::IsEnabled("WebRTC-QuickPerfTest")
+          ? kQuickSimulationTimeMs
+          : kSimulationTimeMs,
+      kLossPeriod, kDriftFactor);
+  ASSERT_GT(runtime, 0);
+  webrtc::test::PrintResult("neteq_performance", "", "33_pl_10_drift", runtime,
+                            "ms", true);
+}
@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_benchmark.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "modules/audio_coding/neteq/tools/encode_neteq_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+#include "modules/audio_coding/neteq/tools/resample_input_audio_file.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int kPayloadType = 100;
+constexpr int kInputFileRateHz = 32000;
+
+// Reads the input file, resampled to the rate of the encoder.
+class FileGenerator : public EncodeNetEqInput::Generator {
+ public:
+  explicit FileGenerator(int sample_rate_hz)
+      : input_(ResourcePath("audio_coding/testfile32kHz", "pcm"),
+               kInputFileRateHz,
+               sample_rate_hz) {}
+
+  rtc::ArrayView<const int16_t> Generate(size_t num_samples) override {
+    samples_.resize(num_samples);
+    RTC_CHECK(input_.Read(num_samples, samples_.data()));
+    return samples_;
+  }
+
+ private:
+  ResampleInputAudioFile input_;
+  std::vector<int16_t> samples_;
+};
+
+NetEqBenchmark::Operation ModeToOperation(Modes mode) {
+  switch (mode) {
+    case kModeNormal:
+      return NetEqBenchmark::kNormal;
+    case kModeExpand:
+    case kModeCodecPlc:
+      return NetEqBenchmark::kExpand;
+    case kModeMerge:
+      return NetEqBenchmark::kMerge;
+    case kModeAccelerateSuccess:
+    case kModeAccelerateLowEnergy:
+    case kModeAccelerateFail:
+      return NetEqBenchmark::kAccelerate;
+    case kModePreemptiveExpandSuccess:
+    case kModePreemptiveExpandLowEnergy:
+    case kModePreemptiveExpandFail:
+      return NetEqBenchmark::kPreemptiveExpand;
+    default:
+      return NetEqBenchmark::kOther;
+  }
+}
+
+// Times each GetAudio call and attributes the time to the operation NetEq
+// performed.
+class OperationTimer : public NetEqGetAudioCallback {
+ public:
+  explicit OperationTimer(NetEqBenchmark::Result* result) : result_(result) {}
+
+  void BeforeGetAudio(NetEq* neteq) override {
+    start_time_us_ = rtc::TimeMicros();
+  }
+
+  void AfterGetAudio(int64_t time_now_ms,
+                     const AudioFrame& audio_frame,
+                     bool muted,
+                     NetEq* neteq) override {
+    const int64_t elapsed_us = rtc::TimeMicros() - start_time_us_;
+    const NetEqBenchmark::Operation operation =
+        ModeToOperation(neteq->GetOperationsAndState().last_mode);
+    result_->total_time_us += elapsed_us;
+    result_->operation_time_us[operation] += elapsed_us;
+    ++result_->operation_count[operation];
+  }
+
+ private:
+  NetEqBenchmark::Result* const result_;
+  int64_t start_time_us_ = 0;
+};
+
+}  // namespace
+
+double NetEqBenchmark::Result::TotalMsPerSecond() const {
+  return audio_duration_ms > 0
+             ? static_cast<double>(total_time_us) / audio_duration_ms
+             : 0.0;
+}
+
+double NetEqBenchmark::Result::OperationMsPerSecond(
+    Operation operation) const {
+  return audio_duration_ms > 0
+             ? static_cast<double>(operation_time_us[operation]) /
+                   audio_duration_ms
+             : 0.0;
+}
+
+const char* NetEqBenchmark::OperationName(Operation operation) {
+  switch (operation) {
+    case kNormal:
+      return "normal";
+    case kExpand:
+      return "expand";
+    case kMerge:
+      return "merge";
+    case kAccelerate:
+      return "accelerate";
+    case kPreemptiveExpand:
+      return "preemptive_expand";
+    case kOther:
+      return "other";
+    case kNumOperations:
+      break;
+  }
+  RTC_NOTREACHED();
+  return "";
+}
+
+NetEqBenchmark::Result NetEqBenchmark::Run(
+    const SdpAudioFormat& format,
+    const NetworkTraceNetEqInput::NetworkTrace& trace,
+    int64_t audio_duration_ms) {
+  std::unique_ptr<AudioEncoder> encoder =
+      CreateBuiltinAudioEncoderFactory()->MakeAudioEncoder(
+          kPayloadType, format, absl::nullopt);
+  RTC_CHECK(encoder) << "Unsupported format " << format.name;
+  std::unique_ptr<EncodeNetEqInput::Generator> generator(
+      new FileGenerator(encoder->SampleRateHz()));
+  std::unique_ptr<NetEqInput> input(new NetworkTraceNetEqInput(
+      std::unique_ptr<NetEqInput>(new EncodeNetEqInput(
+          std::move(generator), std::move(encoder), audio_duration_ms)),
+      trace));
+
+  Result result;
+  OperationTimer timer(&result);
+  NetEqTest::Callbacks callbacks;
+  callbacks.get_audio_callback = &timer;
+  NetEq::Config config;
+  config.sample_rate_hz = format.clockrate_hz;
+  NetEqTest neteq_test(config, CreateBuiltinAudioDecoderFactory(),
+                       {{kPayloadType, format}}, nullptr, std::move(input),
+                       nullptr, callbacks);
+  result.audio_duration_ms = neteq_test.Run();
+  return result;
+}
+
+}  // namespace test
+}  // namespace webrtc
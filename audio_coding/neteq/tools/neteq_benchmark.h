@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BENCHMARK_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <array>
+
+#include "api/audio_codecs/audio_format.h"
+#include "modules/audio_coding/neteq/tools/network_trace_neteq_input.h"
+
+namespace webrtc {
+namespace test {
+
+// Encodes a speech file with a given codec, sends the packets through a
+// simulated network and decodes them with NetEqTest, measuring the CPU time
+// spent in NetEq::GetAudio for each kind of operation.
+class NetEqBenchmark {
+ public:
+  enum Operation {
+    kNormal = 0,
+    kExpand,
+    kMerge,
+    kAccelerate,
+    kPreemptiveExpand,
+    kOther,  // Comfort noise, DTMF, etc.
+    kNumOperations
+  };
+
+  struct Result {
+    // The duration of the decoded audio.
+    int64_t audio_duration_ms = 0;
+    // The total CPU time spent in GetAudio, in microseconds.
+    int64_t total_time_us = 0;
+    // The CPU time spent in GetAudio, per operation, in microseconds.
+    std::array<int64_t, kNumOperations> operation_time_us = {};
+    // The number of GetAudio calls, per operation.
+    std::array<int, kNumOperations> operation_count = {};
+
+    // Returns the CPU time, in ms, per second of decoded audio.
+    double TotalMsPerSecond() const;
+    double OperationMsPerSecond(Operation operation) const;
+  };
+
+  static const char* OperationName(Operation operation);
+
+  // Runs the benchmark for |audio_duration_ms| of audio encoded as |format|.
+  static Result Run(const SdpAudioFormat& format,
+                    const NetworkTraceNetEqInput::NetworkTrace& trace,
+                    int64_t audio_duration_ms);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BENCHMARK_H_
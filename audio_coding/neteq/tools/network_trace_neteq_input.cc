@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/network_trace_neteq_input.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace test {
+
+NetworkTraceNetEqInput::NetworkTrace
+NetworkTraceNetEqInput::BurstyLossTrace() {
+  NetworkTrace trace;
+  trace.name = "bursty_loss";
+  trace.good_to_bad_probability = 0.0175;
+  trace.bad_to_good_probability = 0.33;
+  trace.loss_probability_bad = 1.0;
+  trace.max_jitter_ms = 20;
+  return trace;
+}
+
+NetworkTraceNetEqInput::NetworkTrace
+NetworkTraceNetEqInput::ReorderingTrace() {
+  NetworkTrace trace;
+  trace.name = "reordering";
+  trace.max_jitter_ms = 80;
+  trace.reorder_probability = 0.05;
+  trace.reorder_delay_ms = 60;
+  return trace;
+}
+
+NetworkTraceNetEqInput::NetworkTrace
+NetworkTraceNetEqInput::ClockDriftTrace() {
+  NetworkTrace trace;
+  trace.name = "clock_drift";
+  trace.max_jitter_ms = 40;
+  trace.drift_factor = 0.05;
+  return trace;
+}
+
+NetworkTraceNetEqInput::NetworkTraceNetEqInput(
+    std::unique_ptr<NetEqInput> source,
+    const NetworkTrace& trace)
+    : source_(std::move(source)), trace_(trace), random_(trace.seed) {
+  RTC_DCHECK_GE(trace_.base_delay_ms, 0);
+  RTC_DCHECK_GE(trace_.max_jitter_ms, 0);
+  RTC_DCHECK_GE(trace_.reorder_delay_ms, 0);
+  RTC_DCHECK_GT(1.0 + trace_.drift_factor, 0.0);
+  FillPendingPackets();
+}
+
+NetworkTraceNetEqInput::~NetworkTraceNetEqInput() = default;
+
+absl::optional<int64_t> NetworkTraceNetEqInput::NextPacketTime() const {
+  if (pending_packets_.empty()) {
+    return absl::nullopt;
+  }
+  return pending_packets_.begin()->first;
+}
+
+absl::optional<int64_t> NetworkTraceNetEqInput::NextOutputEventTime() const {
+  return source_->NextOutputEventTime();
+}
+
+std::unique_ptr<NetEqInput::PacketData> NetworkTraceNetEqInput::PopPacket() {
+  if (pending_packets_.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<PacketData> packet =
+      std::move(pending_packets_.begin()->second);
+  pending_packets_.erase(pending_packets_.begin());
+  FillPendingPackets();
+  return packet;
+}
+
+void NetworkTraceNetEqInput::AdvanceOutputEvent() {
+  source_->AdvanceOutputEvent();
+}
+
+bool NetworkTraceNetEqInput::ended() const {
+  return source_->ended();
+}
+
+absl::optional<RTPHeader> NetworkTraceNetEqInput::NextHeader() const {
+  if (pending_packets_.empty()) {
+    return absl::nullopt;
+  }
+  return pending_packets_.begin()->second->header;
+}
+
+void NetworkTraceNetEqInput::FillPendingPackets() {
+  // A packet from the source cannot arrive earlier than its send time plus
+  // the base delay, so the source only needs to be read that far ahead.
+  while (source_->NextPacketTime()) {
+    const int64_t send_time_ms = static_cast<int64_t>(
+        *source_->NextPacketTime() / (1.0 + trace_.drift_factor));
+    if (!pending_packets_.empty() &&
+        send_time_ms + trace_.base_delay_ms > pending_packets_.begin()->first) {
+      return;
+    }
+    std::unique_ptr<PacketData> packet = source_->PopPacket();
+    RTC_CHECK(packet);
+    const absl::optional<int64_t> arrival_time_ms = ArrivalTime(send_time_ms);
+    if (!arrival_time_ms) {
+      ++num_lost_packets_;
+      continue;
+    }
+    packet->time_ms = *arrival_time_ms;
+    pending_packets_.emplace(*arrival_time_ms, std::move(packet));
+  }
+}
+
+absl::optional<int64_t> NetworkTraceNetEqInput::ArrivalTime(
+    int64_t send_time_ms) {
+  bad_state_ = bad_state_
+                   ? random_.Rand<double>() >= trace_.bad_to_good_probability
+                   : random_.Rand<double>() < trace_.good_to_bad_probability;
+  const double loss_probability = bad_state_ ? trace_.loss_probability_bad
+                                             : trace_.loss_probability_good;
+  if (random_.Rand<double>() < loss_probability) {
+    return absl::nullopt;
+  }
+  int64_t arrival_time_ms = send_time_ms + trace_.base_delay_ms +
+                            random_.Rand(0, trace_.max_jitter_ms);
+  if (random_.Rand<double>() < trace_.reorder_probability) {
+    arrival_time_ms += trace_.reorder_delay_ms;
+  }
+  return arrival_time_ms;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETWORK_TRACE_NETEQ_INPUT_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETWORK_TRACE_NETEQ_INPUT_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "modules/audio_coding/neteq/tools/neteq_input.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace test {
+
+// Wrapper class that sends the packets of another NetEqInput through a
+// simulated network. The packets are delayed, lost and reordered according to
+// a NetworkTrace, and delivered in the order of their new arrival times. The
+// output events of the source are left untouched.
+class NetworkTraceNetEqInput final : public NetEqInput {
+ public:
+  struct NetworkTrace {
+    std::string name;
+    // Loss follows a Gilbert-Elliott model. In the good state, packets are
+    // lost with probability |loss_probability_good|, and in the bad state with
+    // |loss_probability_bad|. The state changes before each packet.
+    double good_to_bad_probability = 0.0;
+    double bad_to_good_probability = 1.0;
+    double loss_probability_good = 0.0;
+    double loss_probability_bad = 0.0;
+    // Each packet is delayed by |base_delay_ms| plus a uniformly distributed
+    // jitter in [0, |max_jitter_ms|].
+    int base_delay_ms = 20;
+    int max_jitter_ms = 0;
+    // With |reorder_probability|, a packet is held back an extra
+    // |reorder_delay_ms|, which makes it arrive after its successors.
+    double reorder_probability = 0.0;
+    int reorder_delay_ms = 0;
+    // The sender clock runs |drift_factor| faster than the receiver clock.
+    double drift_factor = 0.0;
+    uint64_t seed = 1;
+  };
+
+  // Bursts of about 3 lost packets, 5% loss on average, and mild jitter.
+  static NetworkTrace BurstyLossTrace();
+  // Heavy jitter with 5% of the packets reordered.
+  static NetworkTrace ReorderingTrace();
+  // Moderate jitter with a sender clock running 5% fast, which forces NetEq
+  // to time-stretch continuously.
+  static NetworkTrace ClockDriftTrace();
+
+  NetworkTraceNetEqInput(std::unique_ptr<NetEqInput> source,
+                         const NetworkTrace& trace);
+  ~NetworkTraceNetEqInput() override;
+
+  absl::optional<int64_t> NextPacketTime() const override;
+  absl::optional<int64_t> NextOutputEventTime() const override;
+  std::unique_ptr<PacketData> PopPacket() override;
+  void AdvanceOutputEvent() override;
+  bool ended() const override;
+  absl::optional<RTPHeader> NextHeader() const override;
+
+  int num_lost_packets() const { return num_lost_packets_; }
+
+ private:
+  // Moves packets from the source to |pending_packets_| until no packet left
+  // in the source can arrive before the first pending one.
+  void FillPendingPackets();
+  // Returns the arrival time of a packet sent at |send_time_ms|, or empty if
+  // the packet is lost.
+  absl::optional<int64_t> ArrivalTime(int64_t send_time_ms);
+
+  const std::unique_ptr<NetEqInput> source_;
+  const NetworkTrace trace_;
+  Random random_;
+  bool bad_state_ = false;
+  int num_lost_packets_ = 0;
+  // Packets sorted on arrival time. Packets with equal arrival times keep
+  // their send order.
+  std::multimap<int64_t, std::unique_ptr<PacketData>> pending_packets_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETWORK_TRACE_NETEQ_INPUT_H_
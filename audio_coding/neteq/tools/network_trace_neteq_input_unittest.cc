@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Unit tests for NetworkTraceNetEqInput class.
+
+#include "modules/audio_coding/neteq/tools/network_trace_neteq_input.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int kPacketSizeMs = 20;
+
+// Produces one packet every 20 ms, and an output event every 10 ms.
+class FakeInput : public NetEqInput {
+ public:
+  explicit FakeInput(int num_packets) : num_packets_(num_packets) {}
+
+  absl::optional<int64_t> NextPacketTime() const override {
+    if (sequence_number_ >= num_packets_) {
+      return absl::nullopt;
+    }
+    return sequence_number_ * kPacketSizeMs;
+  }
+
+  absl::optional<int64_t> NextOutputEventTime() const override {
+    return output_time_ms_;
+  }
+
+  std::unique_ptr<PacketData> PopPacket() override {
+    if (sequence_number_ >= num_packets_) {
+      return nullptr;
+    }
+    std::unique_ptr<PacketData> packet(new PacketData);
+    packet->header.sequenceNumber = static_cast<uint16_t>(sequence_number_);
+    packet->time_ms = sequence_number_ * kPacketSizeMs;
+    ++sequence_number_;
+    return packet;
+  }
+
+  void AdvanceOutputEvent() override { output_time_ms_ += 10; }
+
+  bool ended() const override {
+    return output_time_ms_ > num_packets_ * kPacketSizeMs;
+  }
+
+  absl::optional<RTPHeader> NextHeader() const override {
+    return absl::nullopt;
+  }
+
+ private:
+  const int num_packets_;
+  int sequence_number_ = 0;
+  int64_t output_time_ms_ = 0;
+};
+
+struct TraceStats {
+  int num_packets = 0;
+  int num_reordered = 0;
+  int64_t max_delay_ms = 0;
+};
+
+void RunTrace(const NetworkTraceNetEqInput::NetworkTrace& trace,
+              int num_packets,
+              TraceStats* stats) {
+  NetworkTraceNetEqInput input(
+      std::unique_ptr<NetEqInput>(new FakeInput(num_packets)), trace);
+  int64_t last_time_ms = 0;
+  int last_sequence_number = -1;
+  while (input.NextPacketTime()) {
+    const int64_t time_ms = *input.NextPacketTime();
+    ASSERT_TRUE(input.NextHeader());
+    const uint16_t next_sequence_number = input.NextHeader()->sequenceNumber;
+    std::unique_ptr<NetEqInput::PacketData> packet = input.PopPacket();
+    ASSERT_TRUE(packet);
+    EXPECT_EQ(time_ms, packet->time_ms);
+    EXPECT_EQ(next_sequence_number, packet->header.sequenceNumber);
+    EXPECT_GE(time_ms, last_time_ms);
+    last_time_ms = time_ms;
+    const int sequence_number = packet->header.sequenceNumber;
+    if (sequence_number < last_sequence_number) {
+      ++stats->num_reordered;
+    }
+    last_sequence_number = std::max(last_sequence_number, sequence_number);
+    stats->max_delay_ms = std::max(
+        stats->max_delay_ms,
+        time_ms - static_cast<int64_t>(sequence_number) * kPacketSizeMs);
+    ++stats->num_packets;
+  }
+  EXPECT_EQ(num_packets, stats->num_packets + input.num_lost_packets());
+}
+
+}  // namespace
+
+TEST(NetworkTraceNetEqInput, NoImpairments) {
+  NetworkTraceNetEqInput::NetworkTrace trace;
+  TraceStats stats;
+  RunTrace(trace, 100, &stats);
+  EXPECT_EQ(100, stats.num_packets);
+  EXPECT_EQ(0, stats.num_reordered);
+  EXPECT_EQ(trace.base_delay_ms, stats.max_delay_ms);
+}
+
+TEST(NetworkTraceNetEqInput, BurstyLoss) {
+  const int kNumPackets = 10000;
+  TraceStats stats;
+  RunTrace(NetworkTraceNetEqInput::BurstyLossTrace(), kNumPackets, &stats);
+  // About 5% loss.
+  EXPECT_NEAR(kNumPackets * 0.95, stats.num_packets, kNumPackets * 0.02);
+  EXPECT_EQ(0, stats.num_reordered);
+}
+
+TEST(NetworkTraceNetEqInput, Reordering) {
+  const NetworkTraceNetEqInput::NetworkTrace trace =
+      NetworkTraceNetEqInput::ReorderingTrace();
+  TraceStats stats;
+  RunTrace(trace, 1000, &stats);
+  EXPECT_EQ(1000, stats.num_packets);
+  EXPECT_GT(stats.num_reordered, 0);
+  EXPECT_LE(stats.max_delay_ms, trace.base_delay_ms + trace.max_jitter_ms +
+                                    trace.reorder_delay_ms);
+}
+
+}  // namespace test
+}  // namespace webrtc
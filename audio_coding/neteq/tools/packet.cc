@@ -29,12 +29,25 @@ Packet::Packet(uint8_t* packet_memory,
                const RtpUtility::RtpHeaderParser& parser,
                const RtpHeaderExtensionMap* extension_map /*= nullptr*/)
     : payload_memory_(packet_memory),
+      packet_memory_(packet_memory),
       packet_length_bytes_(allocated_bytes),
       virtual_packet_length_bytes_(virtual_packet_length_bytes),
       virtual_payload_length_bytes_(0),
       time_ms_(time_ms),
       valid_header_(ParseHeader(parser, extension_map)) {}
 
+Packet::Packet(rtc::ArrayView<const uint8_t> packet_memory,
+               size_t virtual_packet_length_bytes,
+               double time_ms,
+               const RtpUtility::RtpHeaderParser& parser,
+               const RtpHeaderExtensionMap* extension_map /*= nullptr*/)
+    : packet_memory_(packet_memory.data()),
+      packet_length_bytes_(packet_memory.size()),
+      virtual_packet_length_bytes_(virtual_packet_length_bytes),
+      virtual_payload_length_bytes_(0),
+      time_ms_(time_ms),
+      valid_header_(ParseHeader(parser, extension_map)) {}
+
 Packet::Packet(const RTPHeader& header,
                size_t virtual_packet_length_bytes,
                size_t virtual_payload_length_bytes,
@@ -125,7 +138,7 @@ bool Packet::ParseHeader(const RtpHeaderParser& parser,
     return false;
   }
   assert(header_.headerLength <= packet_length_bytes_);
-  payload_ = &payload_memory_[header_.headerLength];
+  payload_ = packet_memory_ + header_.headerLength;
   assert(packet_length_bytes_ >= header_.headerLength);
   payload_length_bytes_ = packet_length_bytes_ - header_.headerLength;
   RTC_CHECK_GE(virtual_packet_length_bytes_, packet_length_bytes_);
@@ -14,6 +14,7 @@
 #include <list>
 #include <memory>
 
+#include "api/array_view.h"
 #include "api/rtp_headers.h"  // NOLINT(build/include)
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "rtc_base/constructor_magic.h"
@@ -47,7 +48,17 @@ class Packet {
          const RtpUtility::RtpHeaderParser& parser,
          const RtpHeaderExtensionMap* extension_map = nullptr);
 
-  // Same as above, but creates the packet from an already parsed RTPHeader.
+  // Same as above, but the packet refers to |packet_memory| instead of taking
+  // ownership of it. The memory must outlive the packet. This is used by
+  // sources that hand out views into a memory mapped file.
+  Packet(rtc::ArrayView<const uint8_t> packet_memory,
+         size_t virtual_packet_length_bytes,
+         double time_ms,
+         const RtpUtility::RtpHeaderParser& parser,
+         const RtpHeaderExtensionMap* extension_map = nullptr);
+
+  // Same as the first constructor, but creates the packet from an already
+  // parsed RTPHeader.
   // This is typically used when reading RTP dump files that only contain the
   // RTP headers, and no payload. The |virtual_packet_length_bytes| tells what
   // size the packet had on wire, including the now discarded payload,
@@ -57,7 +68,7 @@ class Packet {
          size_t virtual_payload_length_bytes,
          double time_ms);
 
-  // The following constructors are the same as the first two, but without a
+  // The following constructors are the same as the first one, but without a
   // parser. Note that when the object is constructed using any of these
   // methods, the header will be parsed using a default RtpHeaderParser object.
   // In particular, RTP header extensions won't be parsed.
@@ -106,6 +117,8 @@ class Packet {
 
   RTPHeader header_;
   const std::unique_ptr<uint8_t[]> payload_memory_;
+  // The packet, either |payload_memory_| or memory owned by someone else.
+  const uint8_t* const packet_memory_ = nullptr;
   const uint8_t* payload_ = nullptr;      // First byte after header.
   const size_t packet_length_bytes_ = 0;  // Total length of packet.
   size_t payload_length_bytes_ = 0;  // Length of the payload, after RTP header.
@@ -12,6 +12,7 @@
 
 #include "modules/audio_coding/neteq/tools/packet.h"
 
+#include "modules/rtp_rtcp/source/rtp_utility.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -67,6 +68,32 @@ TEST(TestPacket, RegularPacket) {
   EXPECT_EQ(kPacketTime, packet.time_ms());
 }
 
+TEST(TestPacket, PacketReferringToMemory) {
+  const size_t kPacketLengthBytes = 100;
+  uint8_t packet_memory[kPacketLengthBytes] = {0};
+  const uint8_t kPayloadType = 17;
+  const uint16_t kSequenceNumber = 4711;
+  const uint32_t kTimestamp = 47114711;
+  const uint32_t kSsrc = 0x12345678;
+  MakeRtpHeader(kPayloadType, kSequenceNumber, kTimestamp, kSsrc,
+                packet_memory);
+  const double kPacketTime = 1.0;
+  // |packet| refers to |packet_memory| and doesn't delete it.
+  Packet packet(rtc::ArrayView<const uint8_t>(packet_memory),
+                kPacketLengthBytes, kPacketTime,
+                RtpUtility::RtpHeaderParser(packet_memory, kPacketLengthBytes));
+  ASSERT_TRUE(packet.valid_header());
+  EXPECT_EQ(kPayloadType, packet.header().payloadType);
+  EXPECT_EQ(kSequenceNumber, packet.header().sequenceNumber);
+  EXPECT_EQ(kTimestamp, packet.header().timestamp);
+  EXPECT_EQ(kSsrc, packet.header().ssrc);
+  EXPECT_EQ(packet_memory + kHeaderLengthBytes, packet.payload());
+  EXPECT_EQ(kPacketLengthBytes, packet.packet_length_bytes());
+  EXPECT_EQ(kPacketLengthBytes - kHeaderLengthBytes,
+            packet.payload_length_bytes());
+  EXPECT_EQ(kPacketTime, packet.time_ms());
+}
+
 TEST(TestPacket, DummyPacket) {
   const size_t kPacketLengthBytes = kHeaderLengthBytes;  // Only RTP header.
   const size_t kVirtualPacketLengthBytes = 100;
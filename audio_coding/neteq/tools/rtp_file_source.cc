@@ -10,17 +10,10 @@
 
 #include "modules/audio_coding/neteq/tools/rtp_file_source.h"
 
-#include <assert.h>
-#include <string.h>
-#ifndef WIN32
-#include <netinet/in.h>
-#endif
-
 #include <memory>
 
 #include "modules/audio_coding/neteq/tools/packet.h"
 #include "rtc_base/checks.h"
-#include "test/rtp_file_reader.h"
 
 namespace webrtc {
 namespace test {
@@ -33,15 +26,11 @@ RtpFileSource* RtpFileSource::Create(const std::string& file_name,
 }
 
 bool RtpFileSource::ValidRtpDump(const std::string& file_name) {
-  std::unique_ptr<RtpFileReader> temp_file(
-      RtpFileReader::Create(RtpFileReader::kRtpDump, file_name));
-  return !!temp_file;
+  return !!MappedRtpFile::Open(file_name, MappedRtpFile::Format::kRtpDump);
 }
 
 bool RtpFileSource::ValidPcap(const std::string& file_name) {
-  std::unique_ptr<RtpFileReader> temp_file(
-      RtpFileReader::Create(RtpFileReader::kPcap, file_name));
-  return !!temp_file;
+  return !!MappedRtpFile::Open(file_name, MappedRtpFile::Format::kPcap);
 }
 
 RtpFileSource::~RtpFileSource() {}
@@ -53,22 +42,19 @@ bool RtpFileSource::RegisterRtpHeaderExtension(RTPExtensionType type,
 
 std::unique_ptr<Packet> RtpFileSource::NextPacket() {
   while (true) {
-    RtpPacket temp_packet;
-    if (!rtp_reader_->NextPacket(&temp_packet)) {
+    MappedRtpFile::Packet file_packet;
+    if (!file_->NextPacket(&file_packet)) {
       return NULL;
     }
-    if (temp_packet.original_length == 0) {
-      // May be an RTCP packet.
+    if (file_packet.is_rtcp) {
       // Read the next one.
       continue;
     }
-    std::unique_ptr<uint8_t[]> packet_memory(new uint8_t[temp_packet.length]);
-    memcpy(packet_memory.get(), temp_packet.data, temp_packet.length);
-    RtpUtility::RtpHeaderParser parser(packet_memory.get(), temp_packet.length);
+    RtpUtility::RtpHeaderParser parser(file_packet.data.data(),
+                                       file_packet.data.size());
     auto packet = std::make_unique<Packet>(
-        packet_memory.release(), temp_packet.length,
-        temp_packet.original_length, temp_packet.time_ms, parser,
-        &rtp_header_extension_map_);
+        file_packet.data, file_packet.original_length, file_packet.time_ms,
+        parser, &rtp_header_extension_map_);
     if (!packet->valid_header()) {
       continue;
     }
@@ -86,11 +72,8 @@ RtpFileSource::RtpFileSource(absl::optional<uint32_t> ssrc_filter)
       ssrc_filter_(ssrc_filter) {}
 
 bool RtpFileSource::OpenFile(const std::string& file_name) {
-  rtp_reader_.reset(RtpFileReader::Create(RtpFileReader::kRtpDump, file_name));
-  if (rtp_reader_)
-    return true;
-  rtp_reader_.reset(RtpFileReader::Create(RtpFileReader::kPcap, file_name));
-  if (!rtp_reader_) {
+  file_ = MappedRtpFile::Open(file_name);
+  if (!file_) {
     FATAL() << "Couldn't open input file as either a rtpdump or .pcap. Note "
                "that .pcapng is not supported.";
   }
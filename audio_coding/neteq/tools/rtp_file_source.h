@@ -20,14 +20,15 @@
 #include "modules/audio_coding/neteq/tools/packet_source.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_utility.h"
+#include "modules/rtp_rtcp/test/mapped_rtp_file.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
 
 namespace test {
 
-class RtpFileReader;
-
+// Reads packets from a memory mapped rtpdump or pcap file. The packets refer to
+// the mapping, and must not be used after the source is destroyed.
 class RtpFileSource : public PacketSource {
  public:
   // Creates an RtpFileSource reading from |file_name|. If the file cannot be
@@ -48,15 +49,11 @@ class RtpFileSource : public PacketSource {
   std::unique_ptr<Packet> NextPacket() override;
 
  private:
-  static const int kFirstLineLength = 40;
-  static const int kRtpFileHeaderSize = 4 + 4 + 4 + 2 + 2;
-  static const size_t kPacketHeaderSize = 8;
-
   explicit RtpFileSource(absl::optional<uint32_t> ssrc_filter);
 
   bool OpenFile(const std::string& file_name);
 
-  std::unique_ptr<RtpFileReader> rtp_reader_;
+  std::unique_ptr<MappedRtpFile> file_;
   const absl::optional<uint32_t> ssrc_filter_;
   RtpHeaderExtensionMap rtp_header_extension_map_;
 
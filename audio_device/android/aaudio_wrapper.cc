@@ -156,9 +156,16 @@ bool AAudioWrapper::Init() {
   ScopedStreamBuilder builder;
   // Configures the stream builder using audio parameters given at construction.
   SetStreamConfiguration(builder.get());
-  // Opens a stream based on options in the stream builder.
+  // Opens a stream based on options in the stream builder. Some devices fail
+  // to open an exclusive stream instead of falling back to shared mode, in
+  // which case a shared stream is requested explicitly.
   if (!OpenStream(builder.get())) {
-    return false;
+    RTC_LOG(LS_WARNING) << "Retrying with shared sharing mode";
+    AAudioStreamBuilder_setSharingMode(builder.get(),
+                                       AAUDIO_SHARING_MODE_SHARED);
+    if (!OpenStream(builder.get())) {
+      return false;
+    }
   }
   // Ensures that the opened stream could activate the requested settings.
   if (!VerifyStreamConfiguration()) {
@@ -370,10 +377,11 @@ void AAudioWrapper::SetStreamConfiguration(AAudioStreamBuilder* builder) {
   AAudioStreamBuilder_setChannelCount(builder, audio_parameters().channels());
   // Always use 16-bit PCM audio sample format.
   AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_I16);
-  // TODO(henrika): investigate effect of using AAUDIO_SHARING_MODE_EXCLUSIVE.
-  // Ask for exclusive mode since this will give us the lowest possible latency.
-  // If exclusive mode isn't available, shared mode will be used instead.
-  AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_SHARED);
+  // Ask for exclusive mode since this will give us the lowest possible latency,
+  // using an MMAP buffer shared directly with the audio hardware on devices
+  // that support it. If exclusive mode isn't available, shared mode will be
+  // used instead.
+  AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
   // Use the direction that was given at construction.
   AAudioStreamBuilder_setDirection(builder, direction_);
   // TODO(henrika): investigate performance using different performance modes.
@@ -444,9 +452,10 @@ bool AAudioWrapper::VerifyStreamConfiguration() {
     RTC_LOG(LS_ERROR) << "Stream unable to use requested format";
     return false;
   }
-  if (AAudioStream_getSharingMode(stream_) != AAUDIO_SHARING_MODE_SHARED) {
-    RTC_LOG(LS_ERROR) << "Stream unable to use requested sharing mode";
-    return false;
+  if (AAudioStream_getSharingMode(stream_) != AAUDIO_SHARING_MODE_EXCLUSIVE) {
+    // Not an error since AAudio falls back to shared mode when the device
+    // can't give us an exclusive stream, e.g. when it is used by another app.
+    RTC_LOG(LS_WARNING) << "Stream unable to use exclusive sharing mode";
   }
   if (AAudioStream_getPerformanceMode(stream_) !=
       AAUDIO_PERFORMANCE_MODE_LOW_LATENCY) {
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/async_audio_device_data_observer.h"
+
+#include <string.h>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+constexpr size_t AsyncAudioDeviceDataObserver::kMaxBufferSizeBytes;
+constexpr size_t AsyncAudioDeviceDataObserver::kMaxQueuedBuffers;
+constexpr int AsyncAudioDeviceDataObserver::kDeliveryIntervalMs;
+
+AsyncAudioDeviceDataObserver::AsyncAudioDeviceDataObserver(
+    TaskQueueFactory* task_queue_factory,
+    AudioDeviceDataObserver* observer)
+    : observer_(observer),
+      capture_buffers_(kMaxQueuedBuffers),
+      render_buffers_(kMaxQueuedBuffers),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "AudioDeviceDataObserver",
+          TaskQueueFactory::Priority::LOW)) {
+  RTC_DCHECK(observer_);
+  task_queue_.PostTask([this] {
+    delivery_task_ = RepeatingTaskHandle::DelayedStart(
+        task_queue_.Get(), TimeDelta::ms(kDeliveryIntervalMs), [this] {
+          Deliver();
+          return TimeDelta::ms(kDeliveryIntervalMs);
+        });
+  });
+}
+
+AsyncAudioDeviceDataObserver::~AsyncAudioDeviceDataObserver() {
+  rtc::Event stopped;
+  task_queue_.PostTask([this, &stopped] {
+    delivery_task_.Stop();
+    Deliver();
+    stopped.Set();
+  });
+  stopped.Wait(rtc::Event::kForever);
+  const int num_dropped =
+      num_dropped_capture_buffers() + num_dropped_render_buffers();
+  if (num_dropped > 0) {
+    RTC_LOG(LS_WARNING) << "Dropped " << num_dropped
+                        << " buffers for the audio data observer.";
+  }
+}
+
+void AsyncAudioDeviceDataObserver::OnCaptureData(
+    const void* audio_samples,
+    const size_t num_samples,
+    const size_t bytes_per_sample,
+    const size_t num_channels,
+    const uint32_t samples_per_sec) {
+  Write(audio_samples, num_samples, bytes_per_sample, num_channels,
+        samples_per_sec, &capture_buffers_, &num_dropped_capture_buffers_);
+}
+
+void AsyncAudioDeviceDataObserver::OnRenderData(
+    const void* audio_samples,
+    const size_t num_samples,
+    const size_t bytes_per_sample,
+    const size_t num_channels,
+    const uint32_t samples_per_sec) {
+  Write(audio_samples, num_samples, bytes_per_sample, num_channels,
+        samples_per_sec, &render_buffers_, &num_dropped_render_buffers_);
+}
+
+int AsyncAudioDeviceDataObserver::num_dropped_capture_buffers() const {
+  return num_dropped_capture_buffers_.load(std::memory_order_relaxed);
+}
+
+int AsyncAudioDeviceDataObserver::num_dropped_render_buffers() const {
+  return num_dropped_render_buffers_.load(std::memory_order_relaxed);
+}
+
+// static
+void AsyncAudioDeviceDataObserver::Write(const void* audio_samples,
+                                         size_t num_samples,
+                                         size_t bytes_per_sample,
+                                         size_t num_channels,
+                                         uint32_t samples_per_sec,
+                                         SpscBufferQueue<AudioBuffer>* buffers,
+                                         std::atomic<int>* num_dropped) {
+  const size_t size = num_samples * bytes_per_sample;
+  AudioBuffer* buffer =
+      size <= kMaxBufferSizeBytes ? buffers->BeginWrite() : nullptr;
+  if (!buffer) {
+    num_dropped->fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  memcpy(buffer->data, audio_samples, size);
+  buffer->num_samples = num_samples;
+  buffer->bytes_per_sample = bytes_per_sample;
+  buffer->num_channels = num_channels;
+  buffer->samples_per_sec = samples_per_sec;
+  buffers->EndWrite();
+}
+
+void AsyncAudioDeviceDataObserver::Deliver() {
+  const AudioBuffer* buffer;
+  while ((buffer = capture_buffers_.BeginRead()) != nullptr) {
+    observer_->OnCaptureData(buffer->data, buffer->num_samples,
+                             buffer->bytes_per_sample, buffer->num_channels,
+                             buffer->samples_per_sec);
+    capture_buffers_.EndRead();
+  }
+  while ((buffer = render_buffers_.BeginRead()) != nullptr) {
+    observer_->OnRenderData(buffer->data, buffer->num_samples,
+                            buffer->bytes_per_sample, buffer->num_channels,
+                            buffer->samples_per_sec);
+    render_buffers_.EndRead();
+  }
+}
+
+}  // namespace webrtc
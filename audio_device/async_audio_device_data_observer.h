@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_DEVICE_ASYNC_AUDIO_DEVICE_DATA_OBSERVER_H_
+#define MODULES_AUDIO_DEVICE_ASYNC_AUDIO_DEVICE_DATA_OBSERVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/audio_device/include/audio_device_data_observer.h"
+#include "modules/audio_device/spsc_buffer_queue.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+
+namespace webrtc {
+
+// Forwards the PCM data to |observer| on a task queue instead of on the native
+// audio threads, so that a slow observer, e.g. one writing to a file, can't
+// cause audio glitches. The data is copied into a wait-free ring per direction
+// and delivered in batches; if the observer falls behind by more than
+// |kMaxQueuedBuffers| buffers, new buffers are dropped. Buffers larger than
+// |kMaxBufferSizeBytes| are dropped as well. Whatever is still queued when
+// the object is destroyed is delivered by the destructor.
+class AsyncAudioDeviceDataObserver : public AudioDeviceDataObserver {
+ public:
+  // 10ms in stereo @ 96kHz.
+  static constexpr size_t kMaxBufferSizeBytes = 3840;
+  // Number of 10ms buffers, per direction, that can wait for the observer.
+  static constexpr size_t kMaxQueuedBuffers = 25;
+  // Time between two deliveries to the wrapped observer.
+  static constexpr int kDeliveryIntervalMs = 10;
+
+  AsyncAudioDeviceDataObserver(TaskQueueFactory* task_queue_factory,
+                               AudioDeviceDataObserver* observer);
+  ~AsyncAudioDeviceDataObserver() override;
+
+  // Called on the native recording thread.
+  void OnCaptureData(const void* audio_samples,
+                     const size_t num_samples,
+                     const size_t bytes_per_sample,
+                     const size_t num_channels,
+                     const uint32_t samples_per_sec) override;
+
+  // Called on the native playout thread.
+  void OnRenderData(const void* audio_samples,
+                    const size_t num_samples,
+                    const size_t bytes_per_sample,
+                    const size_t num_channels,
+                    const uint32_t samples_per_sec) override;
+
+  // Number of buffers dropped so far in each direction. Can be called on any
+  // thread.
+  int num_dropped_capture_buffers() const;
+  int num_dropped_render_buffers() const;
+
+ private:
+  struct AudioBuffer {
+    uint8_t data[kMaxBufferSizeBytes];
+    size_t num_samples = 0;
+    size_t bytes_per_sample = 0;
+    size_t num_channels = 0;
+    uint32_t samples_per_sec = 0;
+  };
+
+  // Copies the buffer into |buffers|, or drops it and counts it in
+  // |num_dropped| if |buffers| is full or the buffer is too large.
+  static void Write(const void* audio_samples,
+                    size_t num_samples,
+                    size_t bytes_per_sample,
+                    size_t num_channels,
+                    uint32_t samples_per_sec,
+                    SpscBufferQueue<AudioBuffer>* buffers,
+                    std::atomic<int>* num_dropped);
+
+  // Called on |task_queue_|.
+  void Deliver();
+
+  AudioDeviceDataObserver* const observer_;
+  SpscBufferQueue<AudioBuffer> capture_buffers_;
+  SpscBufferQueue<AudioBuffer> render_buffers_;
+  std::atomic<int> num_dropped_capture_buffers_{0};
+  std::atomic<int> num_dropped_render_buffers_{0};
+  rtc::TaskQueue task_queue_;
+  RepeatingTaskHandle delivery_task_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_DEVICE_ASYNC_AUDIO_DEVICE_DATA_OBSERVER_H_
@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/async_audio_device_data_observer.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+constexpr uint32_t kSampleRate = 48000;
+constexpr size_t kChannels = 2;
+constexpr size_t kSamplesPerChannel = kSampleRate / 100;
+constexpr size_t kNumSamples = kSamplesPerChannel * kChannels;
+constexpr int kTimeoutMs = 1000;
+
+// Records the first sample of each buffer, which the tests set to the index
+// of the buffer. Can be told to block in the first capture callback until
+// released, to make the queue fill up.
+class FakeDataObserver : public AudioDeviceDataObserver {
+ public:
+  void OnCaptureData(const void* audio_samples,
+                     const size_t num_samples,
+                     const size_t bytes_per_sample,
+                     const size_t num_channels,
+                     const uint32_t samples_per_sec) override {
+    EXPECT_EQ(kSamplesPerChannel, num_samples);
+    EXPECT_EQ(kChannels * sizeof(int16_t), bytes_per_sample);
+    EXPECT_EQ(kChannels, num_channels);
+    EXPECT_EQ(kSampleRate, samples_per_sec);
+    captured_.push_back(static_cast<const int16_t*>(audio_samples)[0]);
+    if (block_first_capture_ && captured_.size() == 1) {
+      capture_blocked_.Set();
+      capture_released_.Wait(rtc::Event::kForever);
+    }
+  }
+
+  void OnRenderData(const void* audio_samples,
+                    const size_t num_samples,
+                    const size_t bytes_per_sample,
+                    const size_t num_channels,
+                    const uint32_t samples_per_sec) override {
+    rendered_.push_back(static_cast<const int16_t*>(audio_samples)[0]);
+  }
+
+  void BlockFirstCapture() { block_first_capture_ = true; }
+  bool WaitForBlockedCapture() { return capture_blocked_.Wait(kTimeoutMs); }
+  void ReleaseCapture() { capture_released_.Set(); }
+
+  // Only read once the AsyncAudioDeviceDataObserver is destroyed, which
+  // waits for its last delivery.
+  const std::vector<int16_t>& captured() const { return captured_; }
+  const std::vector<int16_t>& rendered() const { return rendered_; }
+
+ private:
+  bool block_first_capture_ = false;
+  rtc::Event capture_blocked_;
+  rtc::Event capture_released_;
+  std::vector<int16_t> captured_;
+  std::vector<int16_t> rendered_;
+};
+
+void WriteCaptureBuffer(AudioDeviceDataObserver* observer, int16_t index) {
+  std::vector<int16_t> samples(kNumSamples, index);
+  observer->OnCaptureData(samples.data(), kSamplesPerChannel,
+                          kChannels * sizeof(int16_t), kChannels, kSampleRate);
+}
+
+void WriteRenderBuffer(AudioDeviceDataObserver* observer, int16_t index) {
+  std::vector<int16_t> samples(kNumSamples, index);
+  observer->OnRenderData(samples.data(), kSamplesPerChannel,
+                         kChannels * sizeof(int16_t), kChannels, kSampleRate);
+}
+
+std::vector<int16_t> Indices(int num_buffers) {
+  std::vector<int16_t> indices;
+  for (int i = 0; i < num_buffers; ++i) {
+    indices.push_back(i);
+  }
+  return indices;
+}
+
+}  // namespace
+
+TEST(AsyncAudioDeviceDataObserverTest, DeliversBuffersInOrder) {
+  constexpr int kNumBuffers = 10;
+  const auto task_queue_factory = CreateDefaultTaskQueueFactory();
+  FakeDataObserver observer;
+  {
+    AsyncAudioDeviceDataObserver async_observer(task_queue_factory.get(),
+                                                &observer);
+    // Feed both directions from their own thread, as the native audio
+    // threads do.
+    rtc::TaskQueue recording_thread(task_queue_factory->CreateTaskQueue(
+        "Recording", TaskQueueFactory::Priority::HIGH));
+    rtc::TaskQueue playout_thread(task_queue_factory->CreateTaskQueue(
+        "Playout", TaskQueueFactory::Priority::HIGH));
+    rtc::Event recording_done;
+    rtc::Event playout_done;
+    recording_thread.PostTask([&] {
+      for (int i = 0; i < kNumBuffers; ++i) {
+        WriteCaptureBuffer(&async_observer, i);
+      }
+      recording_done.Set();
+    });
+    playout_thread.PostTask([&] {
+      for (int i = 0; i < kNumBuffers; ++i) {
+        WriteRenderBuffer(&async_observer, i);
+      }
+      playout_done.Set();
+    });
+    ASSERT_TRUE(recording_done.Wait(kTimeoutMs));
+    ASSERT_TRUE(playout_done.Wait(kTimeoutMs));
+    EXPECT_EQ(0, async_observer.num_dropped_capture_buffers());
+    EXPECT_EQ(0, async_observer.num_dropped_render_buffers());
+  }
+  EXPECT_THAT(observer.captured(), ElementsAreArray(Indices(kNumBuffers)));
+  EXPECT_THAT(observer.rendered(), ElementsAreArray(Indices(kNumBuffers)));
+}
+
+TEST(AsyncAudioDeviceDataObserverTest, DropsNewBuffersWhenObserverIsBlocked) {
+  constexpr int kNumBuffers = 30;
+  const auto task_queue_factory = CreateDefaultTaskQueueFactory();
+  FakeDataObserver observer;
+  observer.BlockFirstCapture();
+  {
+    AsyncAudioDeviceDataObserver async_observer(task_queue_factory.get(),
+                                                &observer);
+    WriteCaptureBuffer(&async_observer, 0);
+    ASSERT_TRUE(observer.WaitForBlockedCapture());
+
+    // The buffer being delivered still holds its slot, so only
+    // |kMaxQueuedBuffers| - 1 more fit.
+    for (int i = 1; i < kNumBuffers; ++i) {
+      WriteCaptureBuffer(&async_observer, i);
+    }
+    constexpr int kNumQueued =
+        AsyncAudioDeviceDataObserver::kMaxQueuedBuffers;
+    EXPECT_EQ(kNumBuffers - kNumQueued,
+              async_observer.num_dropped_capture_buffers());
+    EXPECT_EQ(0, async_observer.num_dropped_render_buffers());
+    observer.ReleaseCapture();
+  }
+  EXPECT_THAT(
+      observer.captured(),
+      ElementsAreArray(
+          Indices(AsyncAudioDeviceDataObserver::kMaxQueuedBuffers)));
+}
+
+TEST(AsyncAudioDeviceDataObserverTest, DeliversQueuedBuffersWhenDestroyed) {
+  constexpr int kNumBuffers = 5;
+  const auto task_queue_factory = CreateDefaultTaskQueueFactory();
+  FakeDataObserver observer;
+  {
+    AsyncAudioDeviceDataObserver async_observer(task_queue_factory.get(),
+                                                &observer);
+    // Written and destroyed well within the first delivery interval, so the
+    // buffers are left to the final delivery in the destructor.
+    for (int i = 0; i < kNumBuffers; ++i) {
+      WriteCaptureBuffer(&async_observer, i);
+      WriteRenderBuffer(&async_observer, i);
+    }
+  }
+  EXPECT_THAT(observer.captured(), ElementsAreArray(Indices(kNumBuffers)));
+  EXPECT_THAT(observer.rendered(), ElementsAreArray(Indices(kNumBuffers)));
+}
+
+TEST(AsyncAudioDeviceDataObserverTest, DropsOversizedBuffers) {
+  const auto task_queue_factory = CreateDefaultTaskQueueFactory();
+  FakeDataObserver observer;
+  {
+    AsyncAudioDeviceDataObserver async_observer(task_queue_factory.get(),
+                                                &observer);
+    constexpr size_t kOversizedSamplesPerChannel =
+        AsyncAudioDeviceDataObserver::kMaxBufferSizeBytes /
+            (kChannels * sizeof(int16_t)) +
+        1;
+    std::vector<int16_t> samples(kOversizedSamplesPerChannel * kChannels, 7);
+    async_observer.OnCaptureData(samples.data(), kOversizedSamplesPerChannel,
+                                 kChannels * sizeof(int16_t), kChannels,
+                                 kSampleRate);
+    WriteCaptureBuffer(&async_observer, 1);
+    EXPECT_EQ(1, async_observer.num_dropped_capture_buffers());
+  }
+  EXPECT_THAT(observer.captured(), ElementsAre(1));
+}
+
+}  // namespace webrtc
@@ -21,6 +21,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
@@ -41,11 +42,23 @@ static const size_t kMinValidCallTimeTimeInMilliseconds =
 static const double k2Pi = 6.28318530717959;
 #endif
 
+// Raises |max_level| to |level| if it is lower. Called on the native audio
+// threads, so a compare-and-swap loop is used instead of a lock.
+static void UpdateMaxLevel(std::atomic<int16_t>* max_level, int16_t level) {
+  int16_t current = max_level->load(std::memory_order_relaxed);
+  while (level > current &&
+         !max_level->compare_exchange_weak(current, level,
+                                           std::memory_order_relaxed)) {
+  }
+}
+
 AudioDeviceBuffer::AudioDeviceBuffer(TaskQueueFactory* task_queue_factory)
     : task_queue_(task_queue_factory->CreateTaskQueue(
           kTimerQueueName,
           TaskQueueFactory::Priority::NORMAL)),
       audio_transport_cb_(nullptr),
+      use_decoupled_transport_(
+          field_trial::IsEnabled("WebRTC-Audio-DecoupledDeviceCallbacks")),
       rec_sample_rate_(0),
       play_sample_rate_(0),
       rec_channels_(0),
@@ -84,7 +97,13 @@ int32_t AudioDeviceBuffer::RegisterAudioCallback(
     RTC_LOG(LS_ERROR) << "Failed to set audio transport since media was active";
     return -1;
   }
+  decoupled_transport_.reset();
   audio_transport_cb_ = audio_callback;
+  if (use_decoupled_transport_ && audio_callback) {
+    decoupled_transport_.reset(new DecoupledAudioTransport(
+        audio_callback, DecoupledAudioTransport::kDefaultNumPlayoutBuffers));
+    audio_transport_cb_ = decoupled_transport_.get();
+  }
   return 0;
 }
 
@@ -103,6 +122,9 @@ void AudioDeviceBuffer::StartPlayout() {
   // recording side.
   if (!recording_) {
     StartPeriodicLogging();
+    if (decoupled_transport_) {
+      decoupled_transport_->Start();
+    }
   }
   const int64_t now_time = rtc::TimeMillis();
   // Clear members that are only touched on the main (creating) thread.
@@ -122,6 +144,9 @@ void AudioDeviceBuffer::StartRecording() {
   // playout side.
   if (!playing_) {
     StartPeriodicLogging();
+    if (decoupled_transport_) {
+      decoupled_transport_->Start();
+    }
   }
   // Clear members that will be touched on the main (creating) thread.
   rec_start_time_ = rtc::TimeMillis();
@@ -142,6 +167,10 @@ void AudioDeviceBuffer::StopPlayout() {
   // Stop periodic logging if no more media is active.
   if (!recording_) {
     StopPeriodicLogging();
+    // The native audio threads have been stopped at this stage.
+    if (decoupled_transport_) {
+      decoupled_transport_->Stop();
+    }
   }
   RTC_LOG(INFO) << "total playout time: " << rtc::TimeSince(play_start_time_);
 }
@@ -156,6 +185,10 @@ void AudioDeviceBuffer::StopRecording() {
   // Stop periodic logging if no more media is active.
   if (!playing_) {
     StopPeriodicLogging();
+    // The native audio threads have been stopped at this stage.
+    if (decoupled_transport_) {
+      decoupled_transport_->Stop();
+    }
   }
   // Add UMA histogram to keep track of the case when only zeros have been
   // recorded. Measurements (max of absolute level) are taken twice per second,
@@ -385,12 +418,14 @@ void AudioDeviceBuffer::LogStats(LogState state) {
   last_timer_task_time_ = now_time;
 
   Stats stats;
-  {
-    rtc::CritScope cs(&lock_);
-    stats = stats_;
-    stats_.max_rec_level = 0;
-    stats_.max_play_level = 0;
-  }
+  stats.rec_callbacks = stats_.rec_callbacks.load(std::memory_order_relaxed);
+  stats.play_callbacks = stats_.play_callbacks.load(std::memory_order_relaxed);
+  stats.rec_samples = stats_.rec_samples.load(std::memory_order_relaxed);
+  stats.play_samples = stats_.play_samples.load(std::memory_order_relaxed);
+  stats.max_rec_level =
+      stats_.max_rec_level.exchange(0, std::memory_order_relaxed);
+  stats.max_play_level =
+      stats_.max_play_level.exchange(0, std::memory_order_relaxed);
 
   // Cache current sample rate from atomic members.
   const uint32_t rec_sample_rate = rec_sample_rate_;
@@ -452,35 +487,43 @@ void AudioDeviceBuffer::LogStats(LogState state) {
 void AudioDeviceBuffer::ResetRecStats() {
   RTC_DCHECK_RUN_ON(&task_queue_);
   last_stats_.ResetRecStats();
-  rtc::CritScope cs(&lock_);
-  stats_.ResetRecStats();
+  stats_.rec_callbacks.store(0, std::memory_order_relaxed);
+  stats_.rec_samples.store(0, std::memory_order_relaxed);
+  stats_.max_rec_level.store(0, std::memory_order_relaxed);
 }
 
 void AudioDeviceBuffer::ResetPlayStats() {
   RTC_DCHECK_RUN_ON(&task_queue_);
   last_stats_.ResetPlayStats();
-  rtc::CritScope cs(&lock_);
-  stats_.ResetPlayStats();
+  stats_.play_callbacks.store(0, std::memory_order_relaxed);
+  stats_.play_samples.store(0, std::memory_order_relaxed);
+  stats_.max_play_level.store(0, std::memory_order_relaxed);
+}
+
+AudioDeviceBuffer::Stats AudioDeviceBuffer::GetStats() const {
+  Stats stats;
+  stats.rec_callbacks = stats_.rec_callbacks.load(std::memory_order_relaxed);
+  stats.play_callbacks = stats_.play_callbacks.load(std::memory_order_relaxed);
+  stats.rec_samples = stats_.rec_samples.load(std::memory_order_relaxed);
+  stats.play_samples = stats_.play_samples.load(std::memory_order_relaxed);
+  stats.max_rec_level = stats_.max_rec_level.load(std::memory_order_relaxed);
+  stats.max_play_level = stats_.max_play_level.load(std::memory_order_relaxed);
+  return stats;
 }
 
 void AudioDeviceBuffer::UpdateRecStats(int16_t max_abs,
                                        size_t samples_per_channel) {
-  rtc::CritScope cs(&lock_);
-  ++stats_.rec_callbacks;
-  stats_.rec_samples += samples_per_channel;
-  if (max_abs > stats_.max_rec_level) {
-    stats_.max_rec_level = max_abs;
-  }
+  stats_.rec_callbacks.fetch_add(1, std::memory_order_relaxed);
+  stats_.rec_samples.fetch_add(samples_per_channel, std::memory_order_relaxed);
+  UpdateMaxLevel(&stats_.max_rec_level, max_abs);
 }
 
 void AudioDeviceBuffer::UpdatePlayStats(int16_t max_abs,
                                         size_t samples_per_channel) {
-  rtc::CritScope cs(&lock_);
-  ++stats_.play_callbacks;
-  stats_.play_samples += samples_per_channel;
-  if (max_abs > stats_.max_play_level) {
-    stats_.max_play_level = max_abs;
-  }
+  stats_.play_callbacks.fetch_add(1, std::memory_order_relaxed);
+  stats_.play_samples.fetch_add(samples_per_channel,
+                                std::memory_order_relaxed);
+  UpdateMaxLevel(&stats_.max_play_level, max_abs);
 }
 
 }  // namespace webrtc
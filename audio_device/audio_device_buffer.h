@@ -15,11 +15,12 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <memory>
 
 #include "api/task_queue/task_queue_factory.h"
+#include "modules/audio_device/decoupled_audio_transport.h"
 #include "modules/audio_device/include/audio_device_defines.h"
 #include "rtc_base/buffer.h"
-#include "rtc_base/critical_section.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
@@ -108,6 +109,11 @@ class AudioDeviceBuffer {
 
   int32_t SetTypingStatus(bool typing_status);
 
+  // Returns the current recording and playout stats. Can be called on any
+  // thread; the counters are read one by one, so they may be from slightly
+  // different points in time while audio is running.
+  Stats GetStats() const;
+
  private:
   // Starts/stops periodic logging of audio stats.
   void StartPeriodicLogging();
@@ -122,7 +128,8 @@ class AudioDeviceBuffer {
   void LogStats(LogState state);
 
   // Updates counters in each play/record callback. These counters are later
-  // (periodically) read by LogStats() using a lock.
+  // (periodically) read by LogStats(). No locks are taken, so that the native
+  // audio threads never wait for the task queue.
   void UpdateRecStats(int16_t max_abs, size_t samples_per_channel);
   void UpdatePlayStats(int16_t max_abs, size_t samples_per_channel);
 
@@ -139,11 +146,22 @@ class AudioDeviceBuffer {
   // edge cases and it is IMHO not worth the risk to use them in this class.
   // TODO(henrika): see if it is possible to refactor and annotate all members.
 
+  // Lock-free version of Stats. The recording counters are only written on
+  // the native recording thread and the playout counters only on the native
+  // playout thread, while LogStats() reads them and the Reset*Stats() methods
+  // clear them on the task queue.
+  struct AtomicStats {
+    std::atomic<uint64_t> rec_callbacks{0};
+    std::atomic<uint64_t> play_callbacks{0};
+    std::atomic<uint64_t> rec_samples{0};
+    std::atomic<uint64_t> play_samples{0};
+    std::atomic<int16_t> max_rec_level{0};
+    std::atomic<int16_t> max_play_level{0};
+  };
+
   // Main thread on which this object is created.
   rtc::ThreadChecker main_thread_checker_;
 
-  rtc::CriticalSection lock_;
-
   // Task queue used to invoke LogStats() periodically. Tasks are executed on a
   // worker thread but it does not necessarily have to be the same thread for
   // each task.
@@ -157,6 +175,13 @@ class AudioDeviceBuffer {
   // be transported.
   AudioTransport* audio_transport_cb_;
 
+  // Set when the "WebRTC-Audio-DecoupledDeviceCallbacks" field trial is
+  // enabled. Wraps the registered AudioTransport, and |audio_transport_cb_|
+  // then points to this object instead, so that the native audio threads
+  // never run audio processing or decoding themselves.
+  const bool use_decoupled_transport_;
+  std::unique_ptr<DecoupledAudioTransport> decoupled_transport_;
+
   // Sample rate in Hertz. Accessed atomically.
   std::atomic<uint32_t> rec_sample_rate_;
   std::atomic<uint32_t> play_sample_rate_;
@@ -203,7 +228,7 @@ class AudioDeviceBuffer {
   int64_t rec_start_time_ RTC_GUARDED_BY(main_thread_checker_);
 
   // Contains counters for playout and recording statistics.
-  Stats stats_ RTC_GUARDED_BY(lock_);
+  AtomicStats stats_;
 
   // Stores current stats at each timer task. Used to calculate differences
   // between two successive timer events.
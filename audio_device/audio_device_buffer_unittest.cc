@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/audio_device_buffer.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t kSampleRate = 48000;
+constexpr size_t kChannels = 2;
+constexpr size_t kSamplesPerChannel = kSampleRate / 100;
+constexpr size_t kNumSamples = kSamplesPerChannel * kChannels;
+// Enough callbacks for the levels to be measured, which happens every 50th.
+constexpr int kNumCallbacks = 200;
+constexpr int16_t kRecordingLevel = 1000;
+constexpr int16_t kPlayoutLevel = 2000;
+constexpr int kTimeoutMs = 5000;
+
+// Fills the playout data with |kPlayoutLevel|.
+class FakeAudioTransport : public AudioTransport {
+ public:
+  int32_t RecordedDataIsAvailable(const void* audio_samples,
+                                  const size_t samples_per_channel,
+                                  const size_t bytes_per_frame,
+                                  const size_t num_channels,
+                                  const uint32_t sample_rate,
+                                  const uint32_t total_delay_ms,
+                                  const int32_t clock_drift,
+                                  const uint32_t current_mic_level,
+                                  const bool key_pressed,
+                                  uint32_t& new_mic_level) override {
+    return 0;
+  }
+
+  int32_t NeedMorePlayData(const size_t samples_per_channel,
+                           const size_t bytes_per_frame,
+                           const size_t num_channels,
+                           const uint32_t sample_rate,
+                           void* audio_samples,
+                           size_t& num_samples_out,
+                           int64_t* elapsed_time_ms,
+                           int64_t* ntp_time_ms) override {
+    int16_t* samples = static_cast<int16_t*>(audio_samples);
+    for (size_t i = 0; i < samples_per_channel * num_channels; ++i) {
+      samples[i] = kPlayoutLevel;
+    }
+    num_samples_out = samples_per_channel * num_channels;
+    return 0;
+  }
+
+  void PullRenderData(int bits_per_sample,
+                      int sample_rate,
+                      size_t number_of_channels,
+                      size_t number_of_frames,
+                      void* audio_data,
+                      int64_t* elapsed_time_ms,
+                      int64_t* ntp_time_ms) override {}
+};
+
+}  // namespace
+
+TEST(AudioDeviceBufferTest, StatsCountCallbacksFromNativeAudioThreads) {
+  const auto task_queue_factory = CreateDefaultTaskQueueFactory();
+  FakeAudioTransport audio_transport;
+  AudioDeviceBuffer audio_device_buffer(task_queue_factory.get());
+  audio_device_buffer.RegisterAudioCallback(&audio_transport);
+  audio_device_buffer.SetRecordingSampleRate(kSampleRate);
+  audio_device_buffer.SetRecordingChannels(kChannels);
+  audio_device_buffer.SetPlayoutSampleRate(kSampleRate);
+  audio_device_buffer.SetPlayoutChannels(kChannels);
+
+  rtc::Event recording_done(/*manual_reset=*/true,
+                            /*initially_signaled=*/false);
+  rtc::Event playout_done(/*manual_reset=*/true,
+                          /*initially_signaled=*/false);
+  {
+    rtc::TaskQueue recording_thread(task_queue_factory->CreateTaskQueue(
+        "Recording", TaskQueueFactory::Priority::HIGH));
+    rtc::TaskQueue playout_thread(task_queue_factory->CreateTaskQueue(
+        "Playout", TaskQueueFactory::Priority::HIGH));
+    recording_thread.PostTask([&] {
+      const std::vector<int16_t> samples(kNumSamples, kRecordingLevel);
+      for (int i = 0; i < kNumCallbacks; ++i) {
+        audio_device_buffer.SetRecordedBuffer(samples.data(),
+                                              kSamplesPerChannel);
+      }
+      recording_done.Set();
+    });
+    playout_thread.PostTask([&] {
+      std::vector<int16_t> samples(kNumSamples);
+      for (int i = 0; i < kNumCallbacks; ++i) {
+        EXPECT_EQ(static_cast<int32_t>(kSamplesPerChannel),
+                  audio_device_buffer.RequestPlayoutData(kSamplesPerChannel));
+        audio_device_buffer.GetPlayoutData(samples.data());
+      }
+      playout_done.Set();
+    });
+
+    // Reading the stats while both threads update them never sees a counter
+    // go backwards.
+    AudioDeviceBuffer::Stats last_stats;
+    do {
+      const AudioDeviceBuffer::Stats stats = audio_device_buffer.GetStats();
+      EXPECT_GE(stats.rec_callbacks, last_stats.rec_callbacks);
+      EXPECT_GE(stats.play_callbacks, last_stats.play_callbacks);
+      EXPECT_GE(stats.rec_samples, last_stats.rec_samples);
+      EXPECT_GE(stats.play_samples, last_stats.play_samples);
+      last_stats = stats;
+    } while (!recording_done.Wait(0) || !playout_done.Wait(0));
+    ASSERT_TRUE(recording_done.Wait(kTimeoutMs));
+    ASSERT_TRUE(playout_done.Wait(kTimeoutMs));
+  }
+
+  const AudioDeviceBuffer::Stats stats = audio_device_buffer.GetStats();
+  EXPECT_EQ(static_cast<uint64_t>(kNumCallbacks), stats.rec_callbacks);
+  EXPECT_EQ(static_cast<uint64_t>(kNumCallbacks), stats.play_callbacks);
+  EXPECT_EQ(kNumCallbacks * kSamplesPerChannel, stats.rec_samples);
+  EXPECT_EQ(kNumCallbacks * kSamplesPerChannel, stats.play_samples);
+  EXPECT_EQ(kRecordingLevel, stats.max_rec_level);
+  EXPECT_EQ(kPlayoutLevel, stats.max_play_level);
+}
+
+}  // namespace webrtc
@@ -10,6 +10,10 @@
 
 #include "modules/audio_device/include/audio_device_data_observer.h"
 
+#include <memory>
+#include <utility>
+
+#include "modules/audio_device/async_audio_device_data_observer.h"
 #include "modules/audio_device/include/audio_device_defines.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/ref_counted_object.h"
@@ -25,7 +29,20 @@ class ADMWrapper : public AudioDeviceModule, public AudioTransport {
   ADMWrapper(AudioLayer audio_layer,
              TaskQueueFactory* task_queue_factory,
              AudioDeviceDataObserver* observer)
-      : impl_(AudioDeviceModule::Create(audio_layer, task_queue_factory)),
+      : ADMWrapper(audio_layer, task_queue_factory, observer, nullptr) {}
+  ADMWrapper(AudioLayer audio_layer,
+             TaskQueueFactory* task_queue_factory,
+             std::unique_ptr<AudioDeviceDataObserver> owned_observer)
+      : ADMWrapper(audio_layer,
+                   task_queue_factory,
+                   owned_observer.get(),
+                   std::move(owned_observer)) {}
+  ADMWrapper(AudioLayer audio_layer,
+             TaskQueueFactory* task_queue_factory,
+             AudioDeviceDataObserver* observer,
+             std::unique_ptr<AudioDeviceDataObserver> owned_observer)
+      : owned_observer_(std::move(owned_observer)),
+        impl_(AudioDeviceModule::Create(audio_layer, task_queue_factory)),
         observer_(observer) {
     // Register self as the audio transport callback for underlying ADM impl.
     auto res = impl_->RegisterAudioCallback(this);
@@ -275,6 +292,9 @@ class ADMWrapper : public AudioDeviceModule, public AudioTransport {
 #endif  // WEBRTC_IOS
 
  protected:
+  // Set if |observer_| is owned by this object. Declared before |impl_| so
+  // that it outlives the audio threads of |impl_|.
+  std::unique_ptr<AudioDeviceDataObserver> owned_observer_;
   rtc::scoped_refptr<AudioDeviceModule> impl_;
   AudioDeviceDataObserver* observer_ = nullptr;
   AudioTransport* audio_transport_ = nullptr;
@@ -297,4 +317,21 @@ rtc::scoped_refptr<AudioDeviceModule> CreateAudioDeviceWithDataObserver(
 
   return audio_device;
 }
+
+rtc::scoped_refptr<AudioDeviceModule> CreateAudioDeviceWithAsyncDataObserver(
+    AudioDeviceModule::AudioLayer audio_layer,
+    TaskQueueFactory* task_queue_factory,
+    AudioDeviceDataObserver* observer) {
+  rtc::scoped_refptr<ADMWrapper> audio_device(
+      new rtc::RefCountedObject<ADMWrapper>(
+          audio_layer, task_queue_factory,
+          std::make_unique<AsyncAudioDeviceDataObserver>(task_queue_factory,
+                                                         observer)));
+
+  if (!audio_device->IsValid()) {
+    return nullptr;
+  }
+
+  return audio_device;
+}
 }  // namespace webrtc
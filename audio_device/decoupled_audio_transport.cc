@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/decoupled_audio_transport.h"
+
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Upper bound on how long the processing thread sleeps when it is not woken up
+// by a recorded buffer, e.g. while only playout is active.
+constexpr int kProcessingIntervalMs = 10;
+
+// Number of recorded buffers that can be queued before new ones are dropped.
+constexpr size_t kNumRecordedBuffers = 4;
+
+}  // namespace
+
+constexpr size_t DecoupledAudioTransport::kMaxSamplesPerBuffer;
+constexpr size_t DecoupledAudioTransport::kDefaultNumPlayoutBuffers;
+
+// One slot is always left empty to tell a full queue from an empty one.
+DecoupledAudioTransport::DecoupledAudioTransport(
+    AudioTransport* audio_transport,
+    size_t num_playout_buffers)
+    : audio_transport_(audio_transport),
+      running_(false),
+      thread_(&DecoupledAudioTransport::ThreadFunc,
+              this,
+              "webrtc_audio_transport_thread",
+              rtc::kHighPriority),
+      recorded_buffers_(kNumRecordedBuffers),
+      playout_buffers_(num_playout_buffers),
+      play_samples_per_channel_(0),
+      play_num_channels_(0),
+      play_sample_rate_(0),
+      new_mic_level_(0),
+      num_dropped_recorded_buffers_(0),
+      num_playout_underruns_(0) {
+  RTC_DCHECK(audio_transport_);
+  RTC_DCHECK_GT(num_playout_buffers, 0);
+}
+
+DecoupledAudioTransport::~DecoupledAudioTransport() {
+  RTC_DCHECK(main_thread_checker_.IsCurrent());
+  Stop();
+}
+
+void DecoupledAudioTransport::Start() {
+  RTC_DCHECK(main_thread_checker_.IsCurrent());
+  if (running_.load()) {
+    return;
+  }
+  running_.store(true);
+  thread_.Start();
+}
+
+void DecoupledAudioTransport::Stop() {
+  RTC_DCHECK(main_thread_checker_.IsCurrent());
+  if (!running_.load()) {
+    return;
+  }
+  running_.store(false);
+  wake_up_.Set();
+  thread_.Stop();
+  RTC_LOG(INFO) << "Dropped recorded buffers: "
+                << num_dropped_recorded_buffers() << ", playout underruns: "
+                << num_playout_underruns();
+}
+
+int32_t DecoupledAudioTransport::RecordedDataIsAvailable(
+    const void* audio_samples,
+    const size_t samples_per_channel,
+    const size_t bytes_per_frame,
+    const size_t num_channels,
+    const uint32_t sample_rate,
+    const uint32_t total_delay_ms,
+    const int32_t clock_drift,
+    const uint32_t current_mic_level,
+    const bool key_pressed,
+    uint32_t& new_mic_level) {
+  // The mic level suggested for the previous buffer is the best we have.
+  new_mic_level = new_mic_level_.load(std::memory_order_relaxed);
+  const size_t num_samples = samples_per_channel * num_channels;
+  if (num_samples > kMaxSamplesPerBuffer) {
+    RTC_DLOG(LS_ERROR) << "Recorded buffer too large: " << num_samples;
+    return -1;
+  }
+  AudioBuffer* buffer = recorded_buffers_.BeginWrite();
+  if (!buffer) {
+    num_dropped_recorded_buffers_.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+  }
+  memcpy(buffer->data, audio_samples, num_samples * sizeof(int16_t));
+  buffer->samples_per_channel = samples_per_channel;
+  buffer->num_channels = num_channels;
+  buffer->sample_rate = sample_rate;
+  buffer->total_delay_ms = total_delay_ms;
+  buffer->clock_drift = clock_drift;
+  buffer->current_mic_level = current_mic_level;
+  buffer->key_pressed = key_pressed;
+  recorded_buffers_.EndWrite();
+  wake_up_.Set();
+  return 0;
+}
+
+int32_t DecoupledAudioTransport::NeedMorePlayData(
+    const size_t samples_per_channel,
+    const size_t bytes_per_frame,
+    const size_t num_channels,
+    const uint32_t sample_rate,
+    void* audio_samples,
+    size_t& num_samples_out,
+    int64_t* elapsed_time_ms,
+    int64_t* ntp_time_ms) {
+  const size_t num_samples = samples_per_channel * num_channels;
+  if (num_samples > kMaxSamplesPerBuffer) {
+    RTC_DLOG(LS_ERROR) << "Playout buffer too large: " << num_samples;
+    return -1;
+  }
+  play_samples_per_channel_.store(samples_per_channel,
+                                  std::memory_order_relaxed);
+  play_num_channels_.store(num_channels, std::memory_order_relaxed);
+  play_sample_rate_.store(sample_rate, std::memory_order_relaxed);
+
+  // Buffers produced for an old format are discarded.
+  const AudioBuffer* buffer;
+  while ((buffer = playout_buffers_.BeginRead()) != nullptr) {
+    if (buffer->samples_per_channel == samples_per_channel &&
+        buffer->num_channels == num_channels &&
+        buffer->sample_rate == sample_rate) {
+      break;
+    }
+    playout_buffers_.EndRead();
+  }
+
+  num_samples_out = samples_per_channel;
+  if (!buffer) {
+    memset(audio_samples, 0, num_samples * sizeof(int16_t));
+    *elapsed_time_ms = -1;
+    *ntp_time_ms = -1;
+    num_playout_underruns_.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+  }
+  memcpy(audio_samples, buffer->data, num_samples * sizeof(int16_t));
+  *elapsed_time_ms = buffer->elapsed_time_ms;
+  *ntp_time_ms = buffer->ntp_time_ms;
+  playout_buffers_.EndRead();
+  return 0;
+}
+
+void DecoupledAudioTransport::PullRenderData(int bits_per_sample,
+                                             int sample_rate,
+                                             size_t number_of_channels,
+                                             size_t number_of_frames,
+                                             void* audio_data,
+                                             int64_t* elapsed_time_ms,
+                                             int64_t* ntp_time_ms) {
+  audio_transport_->PullRenderData(bits_per_sample, sample_rate,
+                                   number_of_channels, number_of_frames,
+                                   audio_data, elapsed_time_ms, ntp_time_ms);
+}
+
+void DecoupledAudioTransport::ThreadFunc(void* context) {
+  static_cast<DecoupledAudioTransport*>(context)->Process();
+}
+
+void DecoupledAudioTransport::Process() {
+  while (running_.load()) {
+    wake_up_.Wait(kProcessingIntervalMs);
+    DeliverRecordedBuffers();
+    ProducePlayoutBuffers();
+  }
+}
+
+void DecoupledAudioTransport::DeliverRecordedBuffers() {
+  const AudioBuffer* buffer;
+  while ((buffer = recorded_buffers_.BeginRead()) != nullptr) {
+    uint32_t new_mic_level = 0;
+    audio_transport_->RecordedDataIsAvailable(
+        buffer->data, buffer->samples_per_channel,
+        sizeof(int16_t) * buffer->num_channels, buffer->num_channels,
+        buffer->sample_rate, buffer->total_delay_ms, buffer->clock_drift,
+        buffer->current_mic_level, buffer->key_pressed, new_mic_level);
+    recorded_buffers_.EndRead();
+    new_mic_level_.store(new_mic_level, std::memory_order_relaxed);
+  }
+}
+
+void DecoupledAudioTransport::ProducePlayoutBuffers() {
+  const size_t samples_per_channel =
+      play_samples_per_channel_.load(std::memory_order_relaxed);
+  const size_t num_channels = play_num_channels_.load(std::memory_order_relaxed);
+  const uint32_t sample_rate = play_sample_rate_.load(std::memory_order_relaxed);
+  if (samples_per_channel == 0) {
+    // Playout has not requested any data yet.
+    return;
+  }
+  AudioBuffer* buffer;
+  while ((buffer = playout_buffers_.BeginWrite()) != nullptr) {
+    size_t num_samples_out = 0;
+    buffer->elapsed_time_ms = -1;
+    buffer->ntp_time_ms = -1;
+    if (audio_transport_->NeedMorePlayData(
+            samples_per_channel, sizeof(int16_t) * num_channels, num_channels,
+            sample_rate, buffer->data, num_samples_out,
+            &buffer->elapsed_time_ms, &buffer->ntp_time_ms) != 0 ||
+        num_samples_out != samples_per_channel) {
+      return;
+    }
+    buffer->samples_per_channel = samples_per_channel;
+    buffer->num_channels = num_channels;
+    buffer->sample_rate = sample_rate;
+    playout_buffers_.EndWrite();
+  }
+}
+
+}  // namespace webrtc
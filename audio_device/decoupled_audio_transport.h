@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_DEVICE_DECOUPLED_AUDIO_TRANSPORT_H_
+#define MODULES_AUDIO_DEVICE_DECOUPLED_AUDIO_TRANSPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "modules/audio_device/include/audio_device_defines.h"
+#include "modules/audio_device/spsc_buffer_queue.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+// Wraps an AudioTransport so that the native audio threads never call into it
+// directly. Recorded buffers are queued by the native recording thread and
+// delivered to the wrapped transport on a processing thread owned by this
+// class. The same thread produces playout buffers ahead of time, which the
+// native playout thread then only has to copy. The queues between the threads
+// are wait-free, so a slow audio processing or encoding step can no longer
+// make the device miss its deadline; it results in dropped recorded buffers
+// or in silence instead. The price is |num_playout_buffers| buffers of extra
+// playout latency.
+class DecoupledAudioTransport : public AudioTransport {
+ public:
+  // The maximum number of samples, over all channels, of a single buffer:
+  // 10 ms in stereo at 96 kHz.
+  static constexpr size_t kMaxSamplesPerBuffer = 1920;
+  // Default number of playout buffers kept ready.
+  static constexpr size_t kDefaultNumPlayoutBuffers = 2;
+
+  DecoupledAudioTransport(AudioTransport* audio_transport,
+                          size_t num_playout_buffers);
+  ~DecoupledAudioTransport() override;
+  DecoupledAudioTransport(const DecoupledAudioTransport&) = delete;
+  DecoupledAudioTransport& operator=(const DecoupledAudioTransport&) = delete;
+
+  // Starts and stops the processing thread. Called on the creating thread.
+  void Start();
+  void Stop();
+
+  // Called on the native recording thread.
+  int32_t RecordedDataIsAvailable(const void* audio_samples,
+                                  const size_t samples_per_channel,
+                                  const size_t bytes_per_frame,
+                                  const size_t num_channels,
+                                  const uint32_t sample_rate,
+                                  const uint32_t total_delay_ms,
+                                  const int32_t clock_drift,
+                                  const uint32_t current_mic_level,
+                                  const bool key_pressed,
+                                  uint32_t& new_mic_level) override;
+
+  // Called on the native playout thread.
+  int32_t NeedMorePlayData(const size_t samples_per_channel,
+                           const size_t bytes_per_frame,
+                           const size_t num_channels,
+                           const uint32_t sample_rate,
+                           void* audio_samples,
+                           size_t& num_samples_out,
+                           int64_t* elapsed_time_ms,
+                           int64_t* ntp_time_ms) override;
+
+  // Forwarded directly to the wrapped transport.
+  void PullRenderData(int bits_per_sample,
+                      int sample_rate,
+                      size_t number_of_channels,
+                      size_t number_of_frames,
+                      void* audio_data,
+                      int64_t* elapsed_time_ms,
+                      int64_t* ntp_time_ms) override;
+
+  // Number of recorded buffers dropped because the processing thread did not
+  // keep up.
+  int num_dropped_recorded_buffers() const {
+    return num_dropped_recorded_buffers_.load(std::memory_order_relaxed);
+  }
+  // Number of playout requests answered with silence because no buffer was
+  // ready.
+  int num_playout_underruns() const {
+    return num_playout_underruns_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct AudioBuffer {
+    int16_t data[kMaxSamplesPerBuffer];
+    size_t samples_per_channel = 0;
+    size_t num_channels = 0;
+    uint32_t sample_rate = 0;
+    uint32_t total_delay_ms = 0;
+    int32_t clock_drift = 0;
+    uint32_t current_mic_level = 0;
+    bool key_pressed = false;
+    int64_t elapsed_time_ms = -1;
+    int64_t ntp_time_ms = -1;
+  };
+
+  static void ThreadFunc(void* context);
+  void Process();
+  void DeliverRecordedBuffers();
+  void ProducePlayoutBuffers();
+
+  AudioTransport* const audio_transport_;
+  rtc::ThreadChecker main_thread_checker_;
+  std::atomic<bool> running_;
+  rtc::Event wake_up_;
+  rtc::PlatformThread thread_;
+
+  SpscBufferQueue<AudioBuffer> recorded_buffers_;
+  SpscBufferQueue<AudioBuffer> playout_buffers_;
+
+  // The latest playout format requested by the native playout thread.
+  std::atomic<size_t> play_samples_per_channel_;
+  std::atomic<size_t> play_num_channels_;
+  std::atomic<uint32_t> play_sample_rate_;
+
+  std::atomic<uint32_t> new_mic_level_;
+  std::atomic<int> num_dropped_recorded_buffers_;
+  std::atomic<int> num_playout_underruns_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_DEVICE_DECOUPLED_AUDIO_TRANSPORT_H_
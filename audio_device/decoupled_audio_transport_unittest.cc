@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/decoupled_audio_transport.h"
+
+#include <atomic>
+
+#include "rtc_base/event.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t kSampleRate = 48000;
+constexpr size_t kChannels = 2;
+constexpr size_t kSamplesPerChannel = kSampleRate / 100;
+constexpr size_t kNumSamples = kSamplesPerChannel * kChannels;
+constexpr int kTimeoutMs = 1000;
+
+// Counts the callbacks and signals |event| once |expected_calls| of them have
+// been made. Playout data is filled with the index of the call.
+class FakeAudioTransport : public AudioTransport {
+ public:
+  explicit FakeAudioTransport(int expected_calls)
+      : expected_calls_(expected_calls) {}
+
+  int32_t RecordedDataIsAvailable(const void* audio_samples,
+                                  const size_t samples_per_channel,
+                                  const size_t bytes_per_frame,
+                                  const size_t num_channels,
+                                  const uint32_t sample_rate,
+                                  const uint32_t total_delay_ms,
+                                  const int32_t clock_drift,
+                                  const uint32_t current_mic_level,
+                                  const bool key_pressed,
+                                  uint32_t& new_mic_level) override {
+    last_recorded_sample_ = static_cast<const int16_t*>(audio_samples)[0];
+    new_mic_level = current_mic_level + 1;
+    OnCall();
+    return 0;
+  }
+
+  int32_t NeedMorePlayData(const size_t samples_per_channel,
+                           const size_t bytes_per_frame,
+                           const size_t num_channels,
+                           const uint32_t sample_rate,
+                           void* audio_samples,
+                           size_t& num_samples_out,
+                           int64_t* elapsed_time_ms,
+                           int64_t* ntp_time_ms) override {
+    int16_t* samples = static_cast<int16_t*>(audio_samples);
+    for (size_t i = 0; i < samples_per_channel * num_channels; ++i) {
+      samples[i] = static_cast<int16_t>(num_calls_.load() + 1);
+    }
+    num_samples_out = samples_per_channel;
+    *elapsed_time_ms = -1;
+    *ntp_time_ms = -1;
+    OnCall();
+    return 0;
+  }
+
+  void PullRenderData(int bits_per_sample,
+                      int sample_rate,
+                      size_t number_of_channels,
+                      size_t number_of_frames,
+                      void* audio_data,
+                      int64_t* elapsed_time_ms,
+                      int64_t* ntp_time_ms) override {}
+
+  bool WaitForCalls() { return event_.Wait(kTimeoutMs); }
+  int num_calls() const { return num_calls_.load(); }
+  int16_t last_recorded_sample() const { return last_recorded_sample_.load(); }
+
+ private:
+  void OnCall() {
+    if (++num_calls_ == expected_calls_) {
+      event_.Set();
+    }
+  }
+
+  const int expected_calls_;
+  std::atomic<int> num_calls_{0};
+  std::atomic<int16_t> last_recorded_sample_{0};
+  rtc::Event event_;
+};
+
+void Record(DecoupledAudioTransport* transport, int16_t value) {
+  int16_t samples[kNumSamples];
+  for (int16_t& sample : samples) {
+    sample = value;
+  }
+  uint32_t new_mic_level = 0;
+  EXPECT_EQ(0, transport->RecordedDataIsAvailable(
+                   samples, kSamplesPerChannel, sizeof(int16_t) * kChannels,
+                   kChannels, kSampleRate, 0, 0, 100, false, new_mic_level));
+}
+
+}  // namespace
+
+TEST(DecoupledAudioTransportTest, DeliversRecordedData) {
+  const int kNumBuffers = 3;
+  FakeAudioTransport fake_transport(kNumBuffers);
+  DecoupledAudioTransport transport(&fake_transport, 1);
+  for (int i = 0; i < kNumBuffers; ++i) {
+    Record(&transport, i + 1);
+  }
+  transport.Start();
+  ASSERT_TRUE(fake_transport.WaitForCalls());
+  transport.Stop();
+  EXPECT_EQ(kNumBuffers, fake_transport.num_calls());
+  EXPECT_EQ(kNumBuffers, fake_transport.last_recorded_sample());
+  EXPECT_EQ(0, transport.num_dropped_recorded_buffers());
+}
+
+TEST(DecoupledAudioTransportTest, DropsRecordedDataWhenQueueIsFull) {
+  FakeAudioTransport fake_transport(0);
+  DecoupledAudioTransport transport(&fake_transport, 1);
+  // The processing thread is not started, so nothing is consumed.
+  for (int i = 0; i < 10; ++i) {
+    Record(&transport, i);
+  }
+  EXPECT_GT(transport.num_dropped_recorded_buffers(), 0);
+  EXPECT_LT(transport.num_dropped_recorded_buffers(), 10);
+  EXPECT_EQ(0, fake_transport.num_calls());
+}
+
+TEST(DecoupledAudioTransportTest, PlaysOutPrefilledData) {
+  const size_t kNumPlayoutBuffers = 2;
+  FakeAudioTransport fake_transport(kNumPlayoutBuffers);
+  DecoupledAudioTransport transport(&fake_transport, kNumPlayoutBuffers);
+  transport.Start();
+
+  int16_t samples[kNumSamples];
+  size_t num_samples_out = 0;
+  int64_t elapsed_time_ms = 0;
+  int64_t ntp_time_ms = 0;
+  // Nothing is ready before the playout format is known.
+  EXPECT_EQ(0, transport.NeedMorePlayData(
+                   kSamplesPerChannel, sizeof(int16_t) * kChannels, kChannels,
+                   kSampleRate, samples, num_samples_out, &elapsed_time_ms,
+                   &ntp_time_ms));
+  EXPECT_EQ(kSamplesPerChannel, num_samples_out);
+  EXPECT_EQ(0, samples[0]);
+  EXPECT_EQ(1, transport.num_playout_underruns());
+
+  // The processing thread now fills the playout queue.
+  ASSERT_TRUE(fake_transport.WaitForCalls());
+  EXPECT_EQ(0, transport.NeedMorePlayData(
+                   kSamplesPerChannel, sizeof(int16_t) * kChannels, kChannels,
+                   kSampleRate, samples, num_samples_out, &elapsed_time_ms,
+                   &ntp_time_ms));
+  transport.Stop();
+  EXPECT_EQ(1, samples[0]);
+  EXPECT_EQ(1, samples[kNumSamples - 1]);
+  EXPECT_EQ(1, transport.num_playout_underruns());
+}
+
+}  // namespace webrtc
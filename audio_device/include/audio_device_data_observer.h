@@ -46,6 +46,15 @@ rtc::scoped_refptr<AudioDeviceModule> CreateAudioDeviceWithDataObserver(
     TaskQueueFactory* task_queue_factory,
     AudioDeviceDataObserver* observer);
 
+// Like CreateAudioDeviceWithDataObserver(), but |observer| is called on a
+// task queue created from |task_queue_factory| instead of on the native audio
+// threads. The PCM data is copied and delivered every 10ms; buffers are
+// dropped if |observer| falls behind. |observer| must outlive the ADM.
+rtc::scoped_refptr<AudioDeviceModule> CreateAudioDeviceWithAsyncDataObserver(
+    const AudioDeviceModule::AudioLayer audio_layer,
+    TaskQueueFactory* task_queue_factory,
+    AudioDeviceDataObserver* observer);
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_DEVICE_INCLUDE_AUDIO_DEVICE_DATA_OBSERVER_H_
@@ -44,6 +44,8 @@ namespace adm_linux_alsa {
   X(snd_pcm_close)                             \
   X(snd_pcm_delay)                             \
   X(snd_pcm_drop)                              \
+  X(snd_pcm_mmap_begin)                        \
+  X(snd_pcm_mmap_commit)                       \
   X(snd_pcm_open)                              \
   X(snd_pcm_prepare)                           \
   X(snd_pcm_readi)                             \
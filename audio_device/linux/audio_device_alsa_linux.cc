@@ -11,10 +11,16 @@
 #include "modules/audio_device/linux/audio_device_alsa_linux.h"
 
 #include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include <string>
 
 #include "modules/audio_device/audio_device_config.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/arch.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/sleep.h"
 
 WebRTCAlsaSymbolTable* GetAlsaSymbolTable() {
@@ -61,6 +67,22 @@ static const unsigned int ALSA_CAPTURE_FREQ = 48000;
 static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40 * 1000;  // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5;     // in ms
+static const unsigned int ALSA_MMAP_LATENCY = 10 * 1000;     // in us
+
+// rtc::kRealtimePriority asks for SCHED_FIFO, which is only granted with
+// CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO. Log what the audio thread got,
+// since it decides whether the small mmap periods can be kept up with.
+static void LogThreadScheduling(const char* name) {
+  int policy = 0;
+  sched_param param = {0};
+  if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << name << " thread runs "
+                   << (policy == SCHED_FIFO ? "with SCHED_FIFO" : "without")
+                   << " realtime scheduling, priority "
+                   << param.sched_priority;
+}
 
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
@@ -96,8 +118,25 @@ AudioDeviceLinuxALSA::AudioDeviceLinuxALSA()
       _recIsInitialized(false),
       _playIsInitialized(false),
       _recordingDelay(0),
-      _playoutDelay(0) {
+      _playoutDelay(0),
+      _useMmap(false),
+      _mmapLatencyUs(ALSA_MMAP_LATENCY),
+      _recordingUsesMmap(false),
+      _playoutUsesMmap(false) {
   memset(_oldKeyState, 0, sizeof(_oldKeyState));
+  // The trial is "Enabled" or "Enabled-<latency in ms>".
+  const std::string mmapTrial =
+      field_trial::FindFullName("WebRTC-Audio-AlsaMmap");
+  if (mmapTrial.find("Enabled") == 0) {
+    _useMmap = true;
+    int latencyMs = 0;
+    if (sscanf(mmapTrial.c_str(), "Enabled-%d", &latencyMs) == 1 &&
+        latencyMs > 0) {
+      _mmapLatencyUs = latencyMs * 1000;
+    }
+    RTC_LOG(LS_INFO) << "ALSA mmap access with " << _mmapLatencyUs / 1000
+                     << " ms latency";
+  }
   RTC_LOG(LS_INFO) << __FUNCTION__ << " created";
 }
 
@@ -805,20 +844,17 @@ int32_t AudioDeviceLinuxALSA::InitPlayout() {
   }
 
   _playoutFramesIn10MS = _playoutFreq / 100;
-  if ((errVal = LATE(snd_pcm_set_params)(
-           _handlePlayout,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-           SND_PCM_FORMAT_S16_BE,
-#else
-           SND_PCM_FORMAT_S16_LE,                             // format
-#endif
-           SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-           _playChannels,                  // channels
-           _playoutFreq,                   // rate
-           1,                              // soft_resample
-           ALSA_PLAYOUT_LATENCY  // 40*1000 //latency required overall latency
-                                 // in us
-           )) < 0) {             /* 0.5sec */
+  _playoutUsesMmap = _useMmap;
+  errVal = SetPcmParams(_handlePlayout, _playChannels, _playoutFreq,
+                        _playoutUsesMmap, ALSA_PLAYOUT_LATENCY);
+  if (errVal < 0 && _playoutUsesMmap) {
+    RTC_LOG(LS_WARNING) << "mmap playout not supported: "
+                        << LATE(snd_strerror)(errVal);
+    _playoutUsesMmap = false;
+    errVal = SetPcmParams(_handlePlayout, _playChannels, _playoutFreq,
+                          _playoutUsesMmap, ALSA_PLAYOUT_LATENCY);
+  }
+  if (errVal < 0) {
     _playoutFramesIn10MS = 0;
     RTC_LOG(LS_ERROR) << "unable to set playback device: "
                       << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -839,6 +875,11 @@ int32_t AudioDeviceLinuxALSA::InitPlayout() {
     RTC_LOG(LS_VERBOSE) << "playout snd_pcm_get_params buffer_size:"
                         << _playoutBufferSizeInFrame
                         << " period_size :" << _playoutPeriodSizeInFrame;
+    RTC_LOG(LS_INFO) << "playout latency: "
+                     << _playoutBufferSizeInFrame * 1000 / _playoutFreq
+                     << " ms buffer, "
+                     << _playoutPeriodSizeInFrame * 1000 / _playoutFreq
+                     << " ms period, mmap: " << _playoutUsesMmap;
   }
 
   if (_ptrAudioBuffer) {
@@ -928,38 +969,26 @@ int32_t AudioDeviceLinuxALSA::InitRecording() {
   }
 
   _recordingFramesIn10MS = _recordingFreq / 100;
-  if ((errVal =
-           LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-                                    SND_PCM_FORMAT_S16_BE,  // format
-#else
-                                    SND_PCM_FORMAT_S16_LE,    // format
-#endif
-                                    SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-                                    _recChannels,                   // channels
-                                    _recordingFreq,                 // rate
-                                    1,                    // soft_resample
-                                    ALSA_CAPTURE_LATENCY  // latency in us
-                                    )) < 0) {
+  _recordingUsesMmap = _useMmap;
+  errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                        _recordingUsesMmap, ALSA_CAPTURE_LATENCY);
+  if (errVal < 0 && _recordingUsesMmap) {
+    RTC_LOG(LS_WARNING) << "mmap capture not supported: "
+                        << LATE(snd_strerror)(errVal);
+    _recordingUsesMmap = false;
+    errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                          _recordingUsesMmap, ALSA_CAPTURE_LATENCY);
+  }
+  if (errVal < 0) {
     // Fall back to another mode then.
     if (_recChannels == 1)
       _recChannels = 2;
     else
       _recChannels = 1;
 
-    if ((errVal =
-             LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-                                      SND_PCM_FORMAT_S16_BE,  // format
-#else
-                                      SND_PCM_FORMAT_S16_LE,  // format
-#endif
-                                      SND_PCM_ACCESS_RW_INTERLEAVED,  // access
-                                      _recChannels,         // channels
-                                      _recordingFreq,       // rate
-                                      1,                    // soft_resample
-                                      ALSA_CAPTURE_LATENCY  // latency in us
-                                      )) < 0) {
+    if ((errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                               _recordingUsesMmap, ALSA_CAPTURE_LATENCY)) <
+        0) {
       _recordingFramesIn10MS = 0;
       RTC_LOG(LS_ERROR) << "unable to set record settings: "
                         << LATE(snd_strerror)(errVal) << " (" << errVal << ")";
@@ -981,6 +1010,11 @@ int32_t AudioDeviceLinuxALSA::InitRecording() {
     RTC_LOG(LS_VERBOSE) << "capture snd_pcm_get_params, buffer_size:"
                         << _recordingBuffersizeInFrame
                         << ", period_size:" << _recordingPeriodSizeInFrame;
+    RTC_LOG(LS_INFO) << "capture latency: "
+                     << _recordingBuffersizeInFrame * 1000 / _recordingFreq
+                     << " ms buffer, "
+                     << _recordingPeriodSizeInFrame * 1000 / _recordingFreq
+                     << " ms period, mmap: " << _recordingUsesMmap;
   }
 
   if (_ptrAudioBuffer) {
@@ -1453,18 +1487,94 @@ int32_t AudioDeviceLinuxALSA::ErrorRecovery(int32_t error,
   return res;
 }
 
+int AudioDeviceLinuxALSA::SetPcmParams(snd_pcm_t* deviceHandle,
+                                       uint8_t channels,
+                                       uint32_t freq,
+                                       bool useMmap,
+                                       unsigned int defaultLatencyUs) {
+  const snd_pcm_access_t access = useMmap ? SND_PCM_ACCESS_MMAP_INTERLEAVED
+                                           : SND_PCM_ACCESS_RW_INTERLEAVED;
+  const unsigned int latencyUs = useMmap ? _mmapLatencyUs : defaultLatencyUs;
+  return LATE(snd_pcm_set_params)(deviceHandle,
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+                                  SND_PCM_FORMAT_S16_BE,  // format
+#else
+                                  SND_PCM_FORMAT_S16_LE,  // format
+#endif
+                                  access,      // access
+                                  channels,    // channels
+                                  freq,        // rate
+                                  1,           // soft_resample
+                                  latencyUs);  // latency in us
+}
+
+snd_pcm_sframes_t AudioDeviceLinuxALSA::MmapTransfer(
+    snd_pcm_t* deviceHandle,
+    int8_t* buffer,
+    snd_pcm_uframes_t frames) {
+  const bool playback =
+      LATE(snd_pcm_stream)(deviceHandle) == SND_PCM_STREAM_PLAYBACK;
+  snd_pcm_uframes_t transferred = 0;
+  // The area returned by snd_pcm_mmap_begin() ends at the end of the ring
+  // buffer, so a transfer can take two rounds.
+  while (transferred < frames) {
+    const snd_pcm_channel_area_t* areas = NULL;
+    snd_pcm_uframes_t offset = 0;
+    snd_pcm_uframes_t chunk = frames - transferred;
+    int err = LATE(snd_pcm_mmap_begin)(deviceHandle, &areas, &offset, &chunk);
+    if (err < 0) {
+      return err;
+    }
+    if (chunk == 0) {
+      break;
+    }
+    // Interleaved access: all channels share one area.
+    int8_t* deviceBuffer = static_cast<int8_t*>(areas[0].addr) +
+                           (areas[0].first + offset * areas[0].step) / 8;
+    int8_t* userBuffer =
+        buffer + LATE(snd_pcm_frames_to_bytes)(deviceHandle, transferred);
+    const size_t size = LATE(snd_pcm_frames_to_bytes)(deviceHandle, chunk);
+    if (playback) {
+      memcpy(deviceBuffer, userBuffer, size);
+    } else {
+      memcpy(userBuffer, deviceBuffer, size);
+    }
+    snd_pcm_sframes_t committed =
+        LATE(snd_pcm_mmap_commit)(deviceHandle, offset, chunk);
+    if (committed < 0) {
+      return committed;
+    }
+    if (static_cast<snd_pcm_uframes_t>(committed) != chunk) {
+      return -EPIPE;
+    }
+    transferred += chunk;
+  }
+  // Unlike snd_pcm_writei(), committing to the ring buffer does not start a
+  // prepared playback stream.
+  if (playback && transferred > 0 &&
+      LATE(snd_pcm_state)(deviceHandle) == SND_PCM_STATE_PREPARED) {
+    int err = LATE(snd_pcm_start)(deviceHandle);
+    if (err < 0) {
+      return err;
+    }
+  }
+  return transferred;
+}
+
 // ============================================================================
 //                                  Thread Methods
 // ============================================================================
 
 void AudioDeviceLinuxALSA::PlayThreadFunc(void* pThis) {
   AudioDeviceLinuxALSA* device = static_cast<AudioDeviceLinuxALSA*>(pThis);
+  LogThreadScheduling("playout");
   while (device->PlayThreadProcess()) {
   }
 }
 
 void AudioDeviceLinuxALSA::RecThreadFunc(void* pThis) {
   AudioDeviceLinuxALSA* device = static_cast<AudioDeviceLinuxALSA*>(pThis);
+  LogThreadScheduling("capture");
   while (device->RecThreadProcess()) {
   }
 }
@@ -1511,12 +1621,18 @@ bool AudioDeviceLinuxALSA::PlayThreadProcess() {
     avail_frames = _playoutFramesLeft;
 
   int size = LATE(snd_pcm_frames_to_bytes)(_handlePlayout, _playoutFramesLeft);
-  frames = LATE(snd_pcm_writei)(
-      _handlePlayout, &_playoutBuffer[_playoutBufferSizeIn10MS - size],
-      avail_frames);
+  if (_playoutUsesMmap) {
+    frames = MmapTransfer(_handlePlayout,
+                          &_playoutBuffer[_playoutBufferSizeIn10MS - size],
+                          avail_frames);
+  } else {
+    frames = LATE(snd_pcm_writei)(
+        _handlePlayout, &_playoutBuffer[_playoutBufferSizeIn10MS - size],
+        avail_frames);
+  }
 
   if (frames < 0) {
-    RTC_LOG(LS_VERBOSE) << "playout snd_pcm_writei error: "
+    RTC_LOG(LS_VERBOSE) << "playout write error: "
                         << LATE(snd_strerror)(frames);
     _playoutFramesLeft = 0;
     ErrorRecovery(frames, _handlePlayout);
@@ -1564,10 +1680,14 @@ bool AudioDeviceLinuxALSA::RecThreadProcess() {
   if (static_cast<uint32_t>(avail_frames) > _recordingFramesLeft)
     avail_frames = _recordingFramesLeft;
 
-  frames = LATE(snd_pcm_readi)(_handleRecord, buffer,
-                               avail_frames);  // frames to be written
+  if (_recordingUsesMmap) {
+    frames = MmapTransfer(_handleRecord, buffer, avail_frames);
+  } else {
+    frames = LATE(snd_pcm_readi)(_handleRecord, buffer,
+                                 avail_frames);  // frames to be written
+  }
   if (frames < 0) {
-    RTC_LOG(LS_ERROR) << "capture snd_pcm_readi error: "
+    RTC_LOG(LS_ERROR) << "capture read error: "
                       << LATE(snd_strerror)(frames);
     ErrorRecovery(frames, _handleRecord);
     UnLock();
@@ -128,6 +128,21 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
                          char* enumDeviceName = NULL,
                          const int32_t ednLen = 0) const;
   int32_t ErrorRecovery(int32_t error, snd_pcm_t* deviceHandle);
+  // Configures |deviceHandle| for interleaved 16-bit samples, using mmap
+  // access with the low latency from the "WebRTC-Audio-AlsaMmap" field trial
+  // if |useMmap| is set, and read/write access with |defaultLatencyUs|
+  // otherwise.
+  int SetPcmParams(snd_pcm_t* deviceHandle,
+                   uint8_t channels,
+                   uint32_t freq,
+                   bool useMmap,
+                   unsigned int defaultLatencyUs);
+  // Copies |frames| frames between |buffer| and the mmapped device ring
+  // buffer. Returns the number of frames transferred, or a negative error
+  // code, like snd_pcm_writei() and snd_pcm_readi().
+  snd_pcm_sframes_t MmapTransfer(snd_pcm_t* deviceHandle,
+                                 int8_t* buffer,
+                                 snd_pcm_uframes_t frames);
 
   bool KeyPressed() const;
 
@@ -190,6 +205,13 @@ class AudioDeviceLinuxALSA : public AudioDeviceGeneric {
   snd_pcm_sframes_t _recordingDelay;
   snd_pcm_sframes_t _playoutDelay;
 
+  // Set from the "WebRTC-Audio-AlsaMmap" field trial. Each direction falls
+  // back to read/write access if the device does not support mmap.
+  bool _useMmap;
+  unsigned int _mmapLatencyUs;
+  bool _recordingUsesMmap;
+  bool _playoutUsesMmap;
+
   char _oldKeyState[32];
 #if defined(WEBRTC_USE_X11)
   Display* _XDisplay;
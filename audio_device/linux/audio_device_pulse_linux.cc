@@ -12,9 +12,13 @@
 
 #include <string.h>
 
+#include <algorithm>
+
+#include "api/array_view.h"
 #include "modules/audio_device/linux/latebindingsymboltable_linux.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 WebRTCPulseSymbolTable* GetPulseSymbolTable() {
   static WebRTCPulseSymbolTable* pulse_symbol_table =
@@ -77,7 +81,9 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse()
       _recStream(NULL),
       _playStream(NULL),
       _recStreamFlags(0),
-      _playStreamFlags(0) {
+      _playStreamFlags(0),
+      _playDirectWrite(
+          field_trial::IsEnabled("WebRTC-Audio-PulseDirectWrite")) {
   RTC_LOG(LS_INFO) << __FUNCTION__ << " created";
 
   memset(_paServerVersion, 0, sizeof(_paServerVersion));
@@ -890,6 +896,11 @@ int32_t AudioDeviceLinuxPulse::InitPlayout() {
     // Update audio buffer with the selected parameters
     _ptrAudioBuffer->SetPlayoutSampleRate(sample_rate_hz_);
     _ptrAudioBuffer->SetPlayoutChannels((uint8_t)_playChannels);
+    if (_playDirectWrite) {
+      // Pulse asks for any number of bytes; FineAudioBuffer splits the 10 ms
+      // chunks from the audio buffer accordingly.
+      _playFineBuffer.reset(new FineAudioBuffer(_ptrAudioBuffer));
+    }
   }
 
   RTC_LOG(LS_VERBOSE) << "stream state "
@@ -1254,6 +1265,7 @@ int32_t AudioDeviceLinuxPulse::StopPlayout() {
     delete[] _playBuffer;
     _playBuffer = NULL;
   }
+  _playFineBuffer.reset();
 
   return 0;
 }
@@ -1722,6 +1734,20 @@ void AudioDeviceLinuxPulse::WaitForOperationCompletion(
 // ============================================================================
 
 void AudioDeviceLinuxPulse::EnableWriteCallback() {
+  if (_playFineBuffer) {
+    // The callback stays registered and does all the writing; only fill the
+    // space that is already available.
+    if (LATE(pa_stream_get_state)(_playStream) == PA_STREAM_READY) {
+      size_t bufferSpace = LATE(pa_stream_writable_size)(_playStream);
+      if (bufferSpace != static_cast<size_t>(-1) && bufferSpace > 0) {
+        WritePlayoutDataDirectly(bufferSpace);
+      }
+    }
+    LATE(pa_stream_set_write_callback)(_playStream, &PaStreamWriteCallback,
+                                       this);
+    return;
+  }
+
   if (LATE(pa_stream_get_state)(_playStream) == PA_STREAM_READY) {
     // May already have available space. Must check.
     _tempBufferSpace = LATE(pa_stream_writable_size)(_playStream);
@@ -1749,6 +1775,11 @@ void AudioDeviceLinuxPulse::PaStreamWriteCallback(pa_stream* /*unused*/,
 }
 
 void AudioDeviceLinuxPulse::PaStreamWriteCallbackHandler(size_t bufferSpace) {
+  if (_playFineBuffer) {
+    WritePlayoutDataDirectly(bufferSpace);
+    return;
+  }
+
   _tempBufferSpace = bufferSpace;
 
   // Since we write the data asynchronously on a different thread, we have
@@ -1758,6 +1789,45 @@ void AudioDeviceLinuxPulse::PaStreamWriteCallbackHandler(size_t bufferSpace) {
   _timeEventPlay.Set();
 }
 
+void AudioDeviceLinuxPulse::WritePlayoutDataDirectly(size_t bufferSpace) {
+  // Must not take |_critSect| here: the playout and control threads take it
+  // before the mainloop lock, which this thread already holds.
+  const size_t frameSize = sizeof(int16_t) * _playChannels;
+  const int playoutDelayMs = LatencyUsecs(_playStream) / 1000;
+  while (bufferSpace >= frameSize) {
+    void* data = NULL;
+    size_t bytes = bufferSpace;
+    if (LATE(pa_stream_begin_write)(_playStream, &data, &bytes) != PA_OK ||
+        !data) {
+      RTC_LOG(LS_ERROR) << "pa_stream_begin_write failed, err="
+                        << LATE(pa_context_errno)(_paContext);
+      return;
+    }
+    // Pulse may offer more than asked for, and not a whole number of frames.
+    bytes = std::min(bytes, bufferSpace);
+    bytes -= bytes % frameSize;
+    if (bytes == 0) {
+      LATE(pa_stream_cancel_write)(_playStream);
+      return;
+    }
+    _playFineBuffer->GetPlayoutData(
+        rtc::ArrayView<int16_t>(static_cast<int16_t*>(data),
+                                bytes / sizeof(int16_t)),
+        playoutDelayMs);
+    if (LATE(pa_stream_write)(_playStream, data, bytes, NULL, (int64_t)0,
+                              PA_SEEK_RELATIVE) != PA_OK) {
+      _writeErrors++;
+      if (_writeErrors > 10) {
+        RTC_LOG(LS_ERROR) << "Playout error: _writeErrors=" << _writeErrors
+                          << ", error=" << LATE(pa_context_errno)(_paContext);
+        _writeErrors = 0;
+      }
+      return;
+    }
+    bufferSpace -= bytes;
+  }
+}
+
 void AudioDeviceLinuxPulse::PaStreamUnderflowCallback(pa_stream* /*unused*/,
                                                       void* pThis) {
   static_cast<AudioDeviceLinuxPulse*>(pThis)
@@ -2083,7 +2153,7 @@ bool AudioDeviceLinuxPulse::PlayThreadProcess() {
     return true;
   }
 
-  if (_playing) {
+  if (_playing && !_playFineBuffer) {
     if (!_recording) {
       // Update the playout delay
       _sndCardPlayDelay = (uint32_t)(LatencyUsecs(_playStream) / 1000);
@@ -15,6 +15,7 @@
 
 #include "modules/audio_device/audio_device_buffer.h"
 #include "modules/audio_device/audio_device_generic.h"
+#include "modules/audio_device/fine_audio_buffer.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_device/include/audio_device_defines.h"
 #include "modules/audio_device/linux/audio_mixer_manager_pulse_linux.h"
@@ -229,6 +230,10 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
                                     size_t buffer_space,
                                     void* pThis);
   void PaStreamWriteCallbackHandler(size_t buffer_space);
+  // Fills |buffer_space| bytes of the play stream straight from
+  // |_playFineBuffer| without waking up the playout thread. Runs on the
+  // PulseAudio mainloop thread, which holds the mainloop lock.
+  void WritePlayoutDataDirectly(size_t buffer_space);
   static void PaStreamUnderflowCallback(pa_stream* unused, void* pThis);
   void PaStreamUnderflowCallbackHandler();
   void EnableReadCallback();
@@ -338,6 +343,12 @@ class AudioDeviceLinuxPulse : public AudioDeviceGeneric {
   pa_buffer_attr _playBufferAttr;
   pa_buffer_attr _recBufferAttr;
 
+  // Set by the "WebRTC-Audio-PulseDirectWrite" field trial. Playout data is
+  // then written from the PulseAudio write callback into buffers returned by
+  // pa_stream_begin_write(), and the playout thread only connects the stream.
+  const bool _playDirectWrite;
+  std::unique_ptr<FineAudioBuffer> _playFineBuffer;
+
   char _oldKeyState[32];
 #if defined(WEBRTC_USE_X11)
   Display* _XDisplay;
@@ -80,6 +80,8 @@ namespace adm_linux_pulse {
   X(pa_stream_set_underflow_callback)      \
   X(pa_stream_set_write_callback)          \
   X(pa_stream_unref)                       \
+  X(pa_stream_begin_write)                 \
+  X(pa_stream_cancel_write)                \
   X(pa_stream_writable_size)               \
   X(pa_stream_write)                       \
   X(pa_strerror)                           \
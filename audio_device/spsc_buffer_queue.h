@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_DEVICE_SPSC_BUFFER_QUEUE_H_
+#define MODULES_AUDIO_DEVICE_SPSC_BUFFER_QUEUE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+namespace webrtc {
+
+// Wait-free queue of |T| for a single producer thread and a single consumer
+// thread. All elements are allocated by the constructor and reused: the
+// producer fills the element returned by BeginWrite() and publishes it with
+// EndWrite(); the consumer reads the element returned by BeginRead() and
+// releases it with EndRead(). Neither end blocks or allocates, so both can be
+// native audio threads.
+template <typename T>
+class SpscBufferQueue {
+ public:
+  explicit SpscBufferQueue(size_t capacity) : buffers_(capacity + 1) {}
+  SpscBufferQueue(const SpscBufferQueue&) = delete;
+  SpscBufferQueue& operator=(const SpscBufferQueue&) = delete;
+
+  // Called on the producer thread. Returns nullptr if the queue is full.
+  T* BeginWrite() {
+    const size_t write_index = write_index_.load(std::memory_order_relaxed);
+    if (Next(write_index) == read_index_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &buffers_[write_index];
+  }
+  // Publishes the element returned by the last BeginWrite().
+  void EndWrite() {
+    const size_t write_index = write_index_.load(std::memory_order_relaxed);
+    write_index_.store(Next(write_index), std::memory_order_release);
+  }
+
+  // Called on the consumer thread. Returns nullptr if the queue is empty.
+  const T* BeginRead() {
+    const size_t read_index = read_index_.load(std::memory_order_relaxed);
+    if (read_index == write_index_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &buffers_[read_index];
+  }
+  // Releases the element returned by the last BeginRead().
+  void EndRead() {
+    const size_t read_index = read_index_.load(std::memory_order_relaxed);
+    read_index_.store(Next(read_index), std::memory_order_release);
+  }
+
+ private:
+  size_t Next(size_t index) const { return (index + 1) % buffers_.size(); }
+
+  // One more element than the capacity, so that a full queue can be told
+  // apart from an empty one.
+  std::vector<T> buffers_;
+  std::atomic<size_t> read_index_{0};
+  std::atomic<size_t> write_index_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_DEVICE_SPSC_BUFFER_QUEUE_H_
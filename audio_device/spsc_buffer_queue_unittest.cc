@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_device/spsc_buffer_queue.h"
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kCapacity = 3;
+
+struct Buffer {
+  int value = 0;
+};
+
+struct ProducerContext {
+  SpscBufferQueue<Buffer>* queue;
+  int num_values;
+};
+
+void Produce(void* obj) {
+  ProducerContext* context = static_cast<ProducerContext*>(obj);
+  int value = 0;
+  while (value < context->num_values) {
+    Buffer* buffer = context->queue->BeginWrite();
+    if (!buffer)
+      continue;
+    buffer->value = value++;
+    context->queue->EndWrite();
+  }
+}
+
+}  // namespace
+
+TEST(SpscBufferQueueTest, StartsEmpty) {
+  SpscBufferQueue<Buffer> queue(kCapacity);
+  EXPECT_EQ(nullptr, queue.BeginRead());
+}
+
+TEST(SpscBufferQueueTest, HoldsCapacityElements) {
+  SpscBufferQueue<Buffer> queue(kCapacity);
+  for (size_t i = 0; i < kCapacity; ++i) {
+    Buffer* buffer = queue.BeginWrite();
+    ASSERT_NE(nullptr, buffer);
+    buffer->value = static_cast<int>(i);
+    queue.EndWrite();
+  }
+  EXPECT_EQ(nullptr, queue.BeginWrite());
+
+  for (size_t i = 0; i < kCapacity; ++i) {
+    const Buffer* buffer = queue.BeginRead();
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(static_cast<int>(i), buffer->value);
+    queue.EndRead();
+  }
+  EXPECT_EQ(nullptr, queue.BeginRead());
+}
+
+TEST(SpscBufferQueueTest, ReadingFreesSpace) {
+  SpscBufferQueue<Buffer> queue(kCapacity);
+  // Wrap around the end of the storage a few times.
+  for (int i = 0; i < 10; ++i) {
+    Buffer* buffer = queue.BeginWrite();
+    ASSERT_NE(nullptr, buffer);
+    buffer->value = i;
+    queue.EndWrite();
+    const Buffer* read_buffer = queue.BeginRead();
+    ASSERT_NE(nullptr, read_buffer);
+    EXPECT_EQ(i, read_buffer->value);
+    queue.EndRead();
+  }
+}
+
+TEST(SpscBufferQueueTest, DeliversInOrderAcrossThreads) {
+  constexpr int kNumValues = 10000;
+  SpscBufferQueue<Buffer> queue(kCapacity);
+  ProducerContext context = {&queue, kNumValues};
+  rtc::PlatformThread producer(&Produce, &context, "SpscProducer",
+                               rtc::kNormalPriority);
+  producer.Start();
+
+  int expected_value = 0;
+  while (expected_value < kNumValues) {
+    const Buffer* buffer = queue.BeginRead();
+    if (!buffer)
+      continue;
+    EXPECT_EQ(expected_value++, buffer->value);
+    queue.EndRead();
+  }
+  producer.Stop();
+  EXPECT_EQ(nullptr, queue.BeginRead());
+}
+
+}  // namespace webrtc
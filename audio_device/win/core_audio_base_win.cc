@@ -20,6 +20,7 @@
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/win/windows_version.h"
+#include "system_wrappers/include/field_trial.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -27,12 +28,6 @@ namespace webrtc {
 namespace webrtc_win {
 namespace {
 
-// Even if the device supports low latency and even if IAudioClient3 can be
-// used (requires Win10 or higher), we currently disable any attempts to
-// initialize the client for low-latency.
-// TODO(henrika): more research is needed before we can enable low-latency.
-const bool kEnableLowLatencyIfSupported = false;
-
 // Each unit of reference time is 100 nanoseconds, hence |kReftimesPerSec|
 // corresponds to one second.
 // TODO(henrika): possibly add usage in Init().
@@ -89,6 +84,22 @@ const char* SessionDisconnectReasonToString(
   }
 }
 
+// Creates the most recent IAudioClient version supported by the platform.
+ComPtr<IAudioClient> CreateClient(const std::string& device_id,
+                                  EDataFlow data_flow,
+                                  ERole role) {
+  if (core_audio_utility::GetAudioClientVersion() == 3) {
+    RTC_DLOG(INFO) << "Using IAudioClient3";
+    return core_audio_utility::CreateClient3(device_id, data_flow, role);
+  }
+  if (core_audio_utility::GetAudioClientVersion() == 2) {
+    RTC_DLOG(INFO) << "Using IAudioClient2";
+    return core_audio_utility::CreateClient2(device_id, data_flow, role);
+  }
+  RTC_DLOG(INFO) << "Using IAudioClient";
+  return core_audio_utility::CreateClient(device_id, data_flow, role);
+}
+
 void Run(void* obj) {
   RTC_DCHECK(obj);
   reinterpret_cast<CoreAudioBase*>(obj)->ThreadRun();
@@ -134,6 +145,10 @@ CoreAudioBase::CoreAudioBase(Direction direction,
       automatic_restart_(automatic_restart),
       on_data_callback_(data_callback),
       on_error_callback_(error_callback),
+      low_latency_enabled_(
+          field_trial::IsEnabled("WebRTC-Audio-CoreAudioLowLatency")),
+      exclusive_mode_enabled_(
+          field_trial::IsEnabled("WebRTC-Audio-CoreAudioExclusiveMode")),
       device_index_(kUndefined),
       is_restarting_(false) {
   RTC_DLOG(INFO) << __FUNCTION__ << "[" << DirectionToString(direction) << "]";
@@ -320,20 +335,8 @@ bool CoreAudioBase::Init() {
 
   // Create an IAudioClient interface which enables us to create and initialize
   // an audio stream between an audio application and the audio engine.
-  ComPtr<IAudioClient> audio_client;
-  if (core_audio_utility::GetAudioClientVersion() == 3) {
-    RTC_DLOG(INFO) << "Using IAudioClient3";
-    audio_client =
-        core_audio_utility::CreateClient3(device_id, GetDataFlow(), role);
-  } else if (core_audio_utility::GetAudioClientVersion() == 2) {
-    RTC_DLOG(INFO) << "Using IAudioClient2";
-    audio_client =
-        core_audio_utility::CreateClient2(device_id, GetDataFlow(), role);
-  } else {
-    RTC_DLOG(INFO) << "Using IAudioClient";
-    audio_client =
-        core_audio_utility::CreateClient(device_id, GetDataFlow(), role);
-  }
+  ComPtr<IAudioClient> audio_client =
+      CreateClient(device_id, GetDataFlow(), role);
   if (!audio_client) {
     return false;
   }
@@ -404,24 +407,55 @@ bool CoreAudioBase::Init() {
     }
   }
 
+  // Try an exclusive-mode stream first if it has been asked for. The audio
+  // engine, and hence rate conversion, is bypassed in exclusive mode. A
+  // separate client is used since a client which has failed to initialize
+  // can not be initialized again.
+  share_mode_ = AUDCLNT_SHAREMODE_SHARED;
+  if (exclusive_mode_enabled_ && !sample_rate_) {
+    ComPtr<IAudioClient> exclusive_client =
+        CreateClient(device_id, GetDataFlow(), role);
+    REFERENCE_TIME min_period = 0;
+    if (exclusive_client &&
+        core_audio_utility::IsFormatSupported(
+            exclusive_client.Get(), AUDCLNT_SHAREMODE_EXCLUSIVE, &format_) &&
+        SUCCEEDED(core_audio_utility::GetDevicePeriod(
+            exclusive_client.Get(), AUDCLNT_SHAREMODE_EXCLUSIVE,
+            &min_period)) &&
+        SUCCEEDED(core_audio_utility::ExclusiveModeInitialize(
+            exclusive_client.Get(), &format_, audio_samples_event_, min_period,
+            &endpoint_buffer_size_frames_))) {
+      RTC_LOG(INFO) << "Using exclusive mode with a period of "
+                    << core_audio_utility::ReferenceTimeToTimeDelta(min_period)
+                           .us()
+                    << " us";
+      audio_client = exclusive_client;
+      share_mode_ = AUDCLNT_SHAREMODE_EXCLUSIVE;
+    } else {
+      RTC_LOG(LS_WARNING) << "Exclusive mode is not available";
+    }
+  }
+
   // Check if low-latency is supported and use special initialization if it is.
   // Low-latency initialization requires these things:
   // - IAudioClient3 (>= Win10)
   // - HDAudio driver
-  // - kEnableLowLatencyIfSupported changed from false (default) to true.
+  // - The "WebRTC-Audio-CoreAudioLowLatency" field trial.
   // TODO(henrika): IsLowLatencySupported() returns AUDCLNT_E_UNSUPPORTED_FORMAT
   // when |sample_rate_.has_value()| returns true if rate conversion is
   // actually required (i.e., client asks for other than the default rate).
   bool low_latency_support = false;
   uint32_t min_period_in_frames = 0;
-  if (kEnableLowLatencyIfSupported &&
+  if (share_mode_ == AUDCLNT_SHAREMODE_SHARED && low_latency_enabled_ &&
       core_audio_utility::GetAudioClientVersion() >= 3) {
     low_latency_support =
         IsLowLatencySupported(static_cast<IAudioClient3*>(audio_client.Get()),
                               &format_, &min_period_in_frames);
   }
 
-  if (low_latency_support) {
+  if (share_mode_ == AUDCLNT_SHAREMODE_EXCLUSIVE) {
+    // Already initialized above.
+  } else if (low_latency_support) {
     RTC_DCHECK_GE(core_audio_utility::GetAudioClientVersion(), 3);
     // Use IAudioClient3::InitializeSharedAudioStream() API to initialize a
     // low-latency event-driven client. Request the smallest possible
@@ -455,7 +489,7 @@ bool CoreAudioBase::Init() {
   // TODO(henrika): compare with IAudioClient3::GetSharedModeEnginePeriod().
   REFERENCE_TIME device_period;
   if (FAILED(core_audio_utility::GetDevicePeriod(
-          audio_client.Get(), AUDCLNT_SHAREMODE_SHARED, &device_period))) {
+          audio_client.Get(), share_mode_, &device_period))) {
     return false;
   }
   const double device_period_in_seconds =
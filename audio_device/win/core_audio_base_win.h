@@ -140,12 +140,22 @@ class CoreAudioBase : public IAudioSessionEvents {
   int64_t num_data_callbacks_ = 0;
   int latency_ms_ = 0;
   absl::optional<uint32_t> sample_rate_;
+  // Exclusive if the stream bypasses the audio engine. Set by Init().
+  AUDCLNT_SHAREMODE share_mode_ = AUDCLNT_SHAREMODE_SHARED;
 
  private:
   const Direction direction_;
   const bool automatic_restart_;
   const OnDataCallback on_data_callback_;
   const OnErrorCallback on_error_callback_;
+  // Set by the "WebRTC-Audio-CoreAudioLowLatency" field trial: use the
+  // smallest shared engine period of IAudioClient3 if it is below the
+  // default period.
+  const bool low_latency_enabled_;
+  // Set by the "WebRTC-Audio-CoreAudioExclusiveMode" field trial: attempt an
+  // event-driven exclusive-mode stream at the minimum device period first,
+  // and fall back to shared mode if the device does not allow it.
+  const bool exclusive_mode_enabled_;
   ScopedHandle audio_samples_event_;
   ScopedHandle stop_event_;
   ScopedHandle restart_event_;
@@ -17,6 +17,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/metrics.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -311,6 +312,8 @@ bool CoreAudioInput::OnDataCallback(uint64_t device_frequency) {
       opt_record_delay_ms = EstimateLatencyMillis(capture_time_100ns);
       if (opt_record_delay_ms) {
         latency_ms_ = *opt_record_delay_ms;
+        RTC_HISTOGRAM_COUNTS_1000("WebRTC.Audio.CoreAudio.InputLatencyMs",
+                                  latency_ms_);
       } else {
         RTC_DLOG(LS_WARNING) << "Input latency is set to fixed value";
         latency_ms_ = 20;
@@ -18,6 +18,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -281,9 +282,14 @@ bool CoreAudioOutput::OnDataCallback(uint64_t device_frequency) {
     RTC_LOG(INFO) << "--- Output audio stream is alive ---";
   }
   // Get the padding value which indicates the amount of valid unread data that
-  // the endpoint buffer currently contains.
+  // the endpoint buffer currently contains. An event-driven exclusive-mode
+  // stream instead fills the entire buffer on each event, and the padding
+  // value is of no use.
   UINT32 num_unread_frames = 0;
-  _com_error error = audio_client_->GetCurrentPadding(&num_unread_frames);
+  _com_error error(S_OK);
+  if (share_mode_ == AUDCLNT_SHAREMODE_SHARED) {
+    error = audio_client_->GetCurrentPadding(&num_unread_frames);
+  }
   if (error.Error() == AUDCLNT_E_DEVICE_INVALIDATED) {
     // Avoid breaking the thread loop implicitly by returning false and return
     // true instead for AUDCLNT_E_DEVICE_INVALIDATED even it is a valid error
@@ -325,6 +331,8 @@ bool CoreAudioOutput::OnDataCallback(uint64_t device_frequency) {
   if (num_data_callbacks_ % 100 == 0) {
     // TODO(henrika): note that FineAudioBuffer adds latency as well.
     latency_ms_ = EstimateOutputLatencyMillis(device_frequency);
+    RTC_HISTOGRAM_COUNTS_1000("WebRTC.Audio.CoreAudio.OutputLatencyMs",
+                              latency_ms_);
     if (num_data_callbacks_ % 500 == 0) {
       RTC_DLOG(INFO) << "latency: " << latency_ms_;
     }
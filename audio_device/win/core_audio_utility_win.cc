@@ -1253,6 +1253,55 @@ HRESULT SharedModeInitializeLowLatency(IAudioClient3* client,
   return error.Error();
 }
 
+HRESULT ExclusiveModeInitialize(IAudioClient* client,
+                                const WAVEFORMATEXTENSIBLE* format,
+                                HANDLE event_handle,
+                                REFERENCE_TIME period,
+                                uint32_t* endpoint_buffer_size) {
+  RTC_DLOG(INFO) << "ExclusiveModeInitialize: period="
+                 << ReferenceTimeToTimeDelta(period).ms() << " [ms]";
+  RTC_DCHECK(client);
+  RTC_DCHECK_GT(period, 0);
+  RTC_DCHECK(event_handle != nullptr && event_handle != INVALID_HANDLE_VALUE);
+
+  // Event-driven exclusive-mode streams require that the buffer duration and
+  // the periodicity are equal.
+  const DWORD stream_flags =
+      AUDCLNT_STREAMFLAGS_NOPERSIST | AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
+  _com_error error = client->Initialize(
+      AUDCLNT_SHAREMODE_EXCLUSIVE, stream_flags, period, period,
+      reinterpret_cast<const WAVEFORMATEX*>(format), nullptr);
+  if (FAILED(error.Error())) {
+    RTC_LOG(LS_ERROR) << "IAudioClient::Initialize (exclusive) failed: "
+                      << ErrorToString(error);
+    return error.Error();
+  }
+
+  error = client->SetEventHandle(event_handle);
+  if (FAILED(error.Error())) {
+    RTC_LOG(LS_ERROR) << "IAudioClient::SetEventHandle failed: "
+                      << ErrorToString(error);
+    return error.Error();
+  }
+
+  UINT32 buffer_size_in_frames = 0;
+  error = client->GetBufferSize(&buffer_size_in_frames);
+  if (FAILED(error.Error())) {
+    RTC_LOG(LS_ERROR) << "IAudioClient::GetBufferSize failed: "
+                      << ErrorToString(error);
+    return error.Error();
+  }
+
+  *endpoint_buffer_size = buffer_size_in_frames;
+  RTC_DLOG(INFO) << "endpoint buffer size: " << buffer_size_in_frames
+                 << " [audio frames]";
+  REFERENCE_TIME latency = 0;
+  error = client->GetStreamLatency(&latency);
+  RTC_DLOG(INFO) << "stream latency: " << ReferenceTimeToTimeDelta(latency).ms()
+                 << " [ms]";
+  return error.Error();
+}
+
 ComPtr<IAudioRenderClient> CreateRenderClient(IAudioClient* client) {
   RTC_DLOG(INFO) << "CreateRenderClient";
   RTC_DCHECK(client);
@@ -540,6 +540,21 @@ HRESULT SharedModeInitializeLowLatency(IAudioClient3* client,
                                        bool auto_convert_pcm,
                                        uint32_t* endpoint_buffer_size);
 
+// Initializes |client| for an event-driven exclusive-mode stream, i.e., the
+// client bypasses the audio engine and exchanges data with the device driver
+// directly. |format| must be supported by the device in exclusive mode and
+// |period| is used both as buffer duration and periodicity, as required for
+// event-driven exclusive-mode streams. Fails with
+// AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED if |period| does not match the alignment
+// required by the driver; |client| can not be used again in that case.
+// Each event then corresponds to one full buffer of
+// |endpoint_buffer_size| frames.
+HRESULT ExclusiveModeInitialize(IAudioClient* client,
+                                const WAVEFORMATEXTENSIBLE* format,
+                                HANDLE event_handle,
+                                REFERENCE_TIME period,
+                                uint32_t* endpoint_buffer_size);
+
 // Creates an IAudioRenderClient client for an existing IAudioClient given by
 // |client|. The IAudioRenderClient interface enables a client to write
 // output data to a rendering endpoint buffer. The methods in this interface
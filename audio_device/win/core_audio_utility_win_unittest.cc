@@ -592,6 +592,49 @@ TEST_F(CoreAudioUtilityWinTest, SharedModeInitialize) {
   // sample rate.
 }
 
+TEST_F(CoreAudioUtilityWinTest, ExclusiveModeInitialize) {
+  ABORT_TEST_IF_NOT(DevicesAvailable());
+
+  ComPtr<IAudioClient> client;
+  client = core_audio_utility::CreateClient(AudioDeviceName::kDefaultDeviceId,
+                                            eRender, eConsole);
+  EXPECT_TRUE(client.Get());
+
+  // Exclusive-mode streams use the format of the device; 16-bit stereo at
+  // 48kHz is the most common one.
+  WAVEFORMATEXTENSIBLE format = {};
+  format.Format.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+  format.Format.nChannels = 2;
+  format.Format.nSamplesPerSec = 48000;
+  format.Format.wBitsPerSample = 16;
+  format.Format.nBlockAlign = 4;
+  format.Format.nAvgBytesPerSec = 48000 * 4;
+  format.Format.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+  format.Samples.wValidBitsPerSample = 16;
+  format.dwChannelMask = KSAUDIO_SPEAKER_STEREO;
+  format.SubFormat = KSDATAFORMAT_SUBTYPE_PCM;
+  if (!core_audio_utility::IsFormatSupported(
+          client.Get(), AUDCLNT_SHAREMODE_EXCLUSIVE, &format)) {
+    return;
+  }
+
+  REFERENCE_TIME min_period = 0;
+  EXPECT_TRUE(SUCCEEDED(core_audio_utility::GetDevicePeriod(
+      client.Get(), AUDCLNT_SHAREMODE_EXCLUSIVE, &min_period)));
+  ScopedHandle event_handle(::CreateEvent(nullptr, TRUE, FALSE, nullptr));
+  uint32_t endpoint_buffer_size = 0;
+  HRESULT hr = core_audio_utility::ExclusiveModeInitialize(
+      client.Get(), &format, event_handle, min_period, &endpoint_buffer_size);
+  // Another application may own the device, or the user may have disallowed
+  // exclusive mode.
+  if (hr == AUDCLNT_E_DEVICE_IN_USE ||
+      hr == AUDCLNT_E_EXCLUSIVE_MODE_NOT_ALLOWED) {
+    return;
+  }
+  EXPECT_TRUE(SUCCEEDED(hr));
+  EXPECT_GT(endpoint_buffer_size, 0u);
+}
+
 TEST_F(CoreAudioUtilityWinTest, CreateRenderAndCaptureClients) {
   ABORT_TEST_IF_NOT(DevicesAvailable());
 
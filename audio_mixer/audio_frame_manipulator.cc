@@ -10,11 +10,130 @@
 
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 
-#include "audio/utility/audio_frame_operations.h"
+#include <algorithm>
+#include <array>
+
 #include "audio/utility/channel_mixer.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace {
+
+// The gain ramps are applied one block of samples at a time. The gains of a
+// block are accumulated first, in the same order as a plain loop so that the
+// result is unchanged, and are then applied in a loop without dependencies
+// between iterations, which the compiler can vectorize.
+constexpr size_t kRampBlockSize = 64;
+
+// Fills |gains| with |num_gains| values starting at |*gain|, and advances
+// |*gain| past them.
+void AccumulateGains(float increment,
+                     size_t num_gains,
+                     float* gain,
+                     std::array<float, kRampBlockSize>* gains) {
+  for (size_t i = 0; i < num_gains; ++i) {
+    (*gains)[i] = *gain;
+    *gain += increment;
+  }
+}
+
+void RampMono(float start_gain,
+              float increment,
+              size_t samples_per_channel,
+              int16_t* data) {
+  std::array<float, kRampBlockSize> gains;
+  float gain = start_gain;
+  for (size_t begin = 0; begin < samples_per_channel;
+       begin += kRampBlockSize) {
+    const size_t size = std::min(kRampBlockSize, samples_per_channel - begin);
+    AccumulateGains(increment, size, &gain, &gains);
+    int16_t* const block = &data[begin];
+    for (size_t i = 0; i < size; ++i) {
+      block[i] = static_cast<int16_t>(block[i] * gains[i]);
+    }
+  }
+}
+
+void RampStereo(float start_gain,
+                float increment,
+                size_t samples_per_channel,
+                int16_t* data) {
+  std::array<float, kRampBlockSize> gains;
+  float gain = start_gain;
+  for (size_t begin = 0; begin < samples_per_channel;
+       begin += kRampBlockSize) {
+    const size_t size = std::min(kRampBlockSize, samples_per_channel - begin);
+    AccumulateGains(increment, size, &gain, &gains);
+    int16_t* const block = &data[2 * begin];
+    for (size_t i = 0; i < size; ++i) {
+      block[2 * i] = static_cast<int16_t>(block[2 * i] * gains[i]);
+      block[2 * i + 1] = static_cast<int16_t>(block[2 * i + 1] * gains[i]);
+    }
+  }
+}
+
+void RampMultiChannel(float start_gain,
+                      float increment,
+                      size_t samples_per_channel,
+                      size_t num_channels,
+                      int16_t* data) {
+  std::array<float, kRampBlockSize> gains;
+  float gain = start_gain;
+  for (size_t begin = 0; begin < samples_per_channel;
+       begin += kRampBlockSize) {
+    const size_t size = std::min(kRampBlockSize, samples_per_channel - begin);
+    AccumulateGains(increment, size, &gain, &gains);
+    int16_t* const block = &data[num_channels * begin];
+    for (size_t i = 0; i < size; ++i) {
+      // The same gain applies to the ith sample of every channel.
+      int16_t* const sample = &block[num_channels * i];
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        sample[ch] = static_cast<int16_t>(sample[ch] * gains[i]);
+      }
+    }
+  }
+}
+
+// The remix kernels go through a copy of the input, since an in place
+// conversion would have to alias input and output, which keeps the compiler
+// from vectorizing it.
+void UpmixMonoToStereo(AudioFrame* frame) {
+  RTC_DCHECK_EQ(frame->num_channels_, 1);
+  const size_t samples_per_channel = frame->samples_per_channel_;
+  RTC_DCHECK_LE(2 * samples_per_channel, AudioFrame::kMaxDataSizeSamples);
+  if (!frame->muted()) {
+    std::array<int16_t, AudioFrame::kMaxDataSizeSamples / 2> mono;
+    std::copy(frame->data(), frame->data() + samples_per_channel,
+              mono.begin());
+    int16_t* const stereo = frame->mutable_data();
+    for (size_t i = 0; i < samples_per_channel; ++i) {
+      stereo[2 * i] = mono[i];
+      stereo[2 * i + 1] = mono[i];
+    }
+  }
+  frame->num_channels_ = 2;
+}
+
+// Averages the two channels, rounding towards zero like
+// AudioFrameOperations::DownmixChannels().
+void DownmixStereoToMono(AudioFrame* frame) {
+  RTC_DCHECK_EQ(frame->num_channels_, 2);
+  const size_t samples_per_channel = frame->samples_per_channel_;
+  RTC_DCHECK_LE(2 * samples_per_channel, AudioFrame::kMaxDataSizeSamples);
+  if (!frame->muted()) {
+    std::array<int16_t, AudioFrame::kMaxDataSizeSamples / 2> mono;
+    const int16_t* const stereo = frame->data();
+    for (size_t i = 0; i < samples_per_channel; ++i) {
+      mono[i] = static_cast<int16_t>(
+          (static_cast<int32_t>(stereo[2 * i]) + stereo[2 * i + 1]) / 2);
+    }
+    std::copy(mono.begin(), mono.begin() + samples_per_channel,
+              frame->mutable_data());
+  }
+  frame->num_channels_ = 1;
+}
+
+}  // namespace
 
 uint32_t AudioMixerCalculateEnergy(const AudioFrame& audio_frame) {
   if (audio_frame.muted()) {
@@ -40,18 +159,21 @@ void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
     return;
   }
 
-  size_t samples = audio_frame->samples_per_channel_;
+  const size_t samples = audio_frame->samples_per_channel_;
   RTC_DCHECK_LT(0, samples);
-  float increment = (target_gain - start_gain) / samples;
-  float gain = start_gain;
+  const float increment = (target_gain - start_gain) / samples;
   int16_t* frame_data = audio_frame->mutable_data();
-  for (size_t i = 0; i < samples; ++i) {
-    // If the audio is interleaved of several channels, we want to
-    // apply the same gain change to the ith sample of every channel.
-    for (size_t ch = 0; ch < audio_frame->num_channels_; ++ch) {
-      frame_data[audio_frame->num_channels_ * i + ch] *= gain;
-    }
-    gain += increment;
+  switch (audio_frame->num_channels_) {
+    case 1:
+      RampMono(start_gain, increment, samples, frame_data);
+      break;
+    case 2:
+      RampStereo(start_gain, increment, samples, frame_data);
+      break;
+    default:
+      RampMultiChannel(start_gain, increment, samples,
+                       audio_frame->num_channels_, frame_data);
+      break;
   }
 }
 
@@ -62,15 +184,15 @@ void RemixFrame(size_t target_number_of_channels, AudioFrame* frame) {
     return;
   }
 
-  // Use legacy components for the most simple cases (mono <-> stereo) to ensure
-  // that native WebRTC clients are not affected when support for multi-channel
-  // audio is added to Chrome.
+  // Use the legacy mono <-> stereo conversions for the most simple cases to
+  // ensure that native WebRTC clients are not affected when support for
+  // multi-channel audio is added to Chrome.
   // TODO(bugs.webrtc.org/10783): utilize channel mixer for mono/stereo as well.
   if (target_number_of_channels < 3 && frame->num_channels() < 3) {
     if (frame->num_channels() > target_number_of_channels) {
-      AudioFrameOperations::DownmixChannels(target_number_of_channels, frame);
+      DownmixStereoToMono(frame);
     } else {
-      AudioFrameOperations::UpmixChannels(target_number_of_channels, frame);
+      UpmixMonoToStereo(frame);
     }
   } else {
     // Use generic channel mixer when the number of channels for input our
@@ -11,6 +11,8 @@
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 #include "test/gtest.h"
 
@@ -63,4 +65,64 @@ TEST(AudioFrameManipulator, CompareBackwardRampWithExpectedResultMono) {
       std::equal(frame_data, frame_data + total_samples, expected_result));
 }
 
+TEST(AudioFrameManipulator, RampMatchesAccumulatedGainForAllChannelCounts) {
+  constexpr size_t kSamplesPerChannel = 480;
+  for (size_t num_channels = 1; num_channels <= 8; ++num_channels) {
+    AudioFrame frame;
+    frame.num_channels_ = num_channels;
+    frame.samples_per_channel_ = kSamplesPerChannel;
+    int16_t* frame_data = frame.mutable_data();
+    for (size_t i = 0; i < kSamplesPerChannel * num_channels; ++i) {
+      frame_data[i] = static_cast<int16_t>((i * 7919) % 65536 - 32768);
+    }
+    std::vector<int16_t> expected(
+        frame_data, frame_data + kSamplesPerChannel * num_channels);
+    const float kStartGain = 0.1f;
+    const float kTargetGain = 0.9f;
+    const float increment = (kTargetGain - kStartGain) / kSamplesPerChannel;
+    float gain = kStartGain;
+    for (size_t i = 0; i < kSamplesPerChannel; ++i) {
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        expected[num_channels * i + ch] *= gain;
+      }
+      gain += increment;
+    }
+
+    Ramp(kStartGain, kTargetGain, &frame);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), frame.data()))
+        << num_channels << " channels";
+  }
+}
+
+TEST(AudioFrameManipulator, UpmixesMonoToStereo) {
+  AudioFrame frame;
+  FillFrameWithConstants(3, 1, 0, &frame);
+  int16_t* frame_data = frame.mutable_data();
+  frame_data[0] = 1;
+  frame_data[1] = -2;
+  frame_data[2] = 3;
+
+  RemixFrame(2, &frame);
+
+  EXPECT_EQ(2u, frame.num_channels());
+  const int16_t expected_result[] = {1, 1, -2, -2, 3, 3};
+  EXPECT_TRUE(std::equal(std::begin(expected_result),
+                         std::end(expected_result), frame.data()));
+}
+
+TEST(AudioFrameManipulator, DownmixesStereoToMonoRoundingTowardsZero) {
+  AudioFrame frame;
+  FillFrameWithConstants(3, 2, 0, &frame);
+  int16_t* frame_data = frame.mutable_data();
+  const int16_t kStereo[] = {1, 2, -1, -2, 32767, 32767};
+  std::copy(std::begin(kStereo), std::end(kStereo), frame_data);
+
+  RemixFrame(1, &frame);
+
+  EXPECT_EQ(1u, frame.num_channels());
+  const int16_t expected_result[] = {1, -1, 32767};
+  EXPECT_TRUE(std::equal(std::begin(expected_result),
+                         std::end(expected_result), frame.data()));
+}
+
 }  // namespace webrtc
@@ -54,6 +54,8 @@ struct SourceFrame {
   AudioFrame* audio_frame = nullptr;
   bool muted = true;
   uint32_t energy = 0;
+  // Position of the source in the mixer's source list.
+  size_t position = 0;
 };
 
 // ShouldMixBefore(a, b) is used to select mixer sources.
@@ -69,7 +71,13 @@ bool ShouldMixBefore(const SourceFrame& a, const SourceFrame& b) {
     return a_activity == AudioFrame::kVadActive;
   }
 
-  return a.energy > b.energy;
+  if (a.energy != b.energy) {
+    return a.energy > b.energy;
+  }
+
+  // Break ties by the order of the sources, to make the selection
+  // independent of the selection algorithm.
+  return a.position < b.position;
 }
 
 void RampAndUpdateGain(
@@ -95,12 +103,19 @@ AudioMixerImpl::SourceStatusList::const_iterator FindSourceInList(
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-    bool use_limiter)
+    bool use_limiter,
+    size_t max_num_parallel_sources)
     : output_rate_calculator_(std::move(output_rate_calculator)),
       output_frequency_(0),
       sample_size_(0),
       audio_source_list_(),
-      frame_combiner_(use_limiter) {}
+      frame_combiner_(use_limiter),
+      use_limiter_(use_limiter) {
+  if (max_num_parallel_sources > 1) {
+    source_runner_ =
+        std::make_unique<ChannelGroupRunner>(max_num_parallel_sources);
+  }
+}
 
 AudioMixerImpl::~AudioMixerImpl() {}
 
@@ -113,9 +128,17 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create() {
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter) {
+  return Create(std::move(output_rate_calculator), use_limiter, 1);
+}
+
+rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    size_t max_num_parallel_sources) {
   return rtc::scoped_refptr<AudioMixerImpl>(
       new rtc::RefCountedObject<AudioMixerImpl>(
-          std::move(output_rate_calculator), use_limiter));
+          std::move(output_rate_calculator), use_limiter,
+          max_num_parallel_sources));
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
@@ -136,6 +159,50 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
   return;
 }
 
+void AudioMixerImpl::MixMinus(
+    size_t number_of_channels,
+    AudioFrame* audio_frame_for_mixing,
+    rtc::ArrayView<Source* const> listeners,
+    rtc::ArrayView<AudioFrame* const> listener_frames) {
+  RTC_DCHECK(number_of_channels >= 1);
+  RTC_DCHECK_EQ(listeners.size(), listener_frames.size());
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+
+  CalculateOutputFrequency();
+
+  rtc::CritScope lock(&crit_);
+  const size_t number_of_streams = audio_source_list_.size();
+  const AudioFrameList mix_list = GetAudioFromSources();
+  frame_combiner_.Combine(mix_list, number_of_channels, OutputFrequency(),
+                          number_of_streams, audio_frame_for_mixing);
+
+  for (size_t i = 0; i < listeners.size(); ++i) {
+    RTC_DCHECK(listener_frames[i]);
+    const auto iter = FindSourceInList(listeners[i], &audio_source_list_);
+    SourceStatus* const status =
+        iter != audio_source_list_.end() ? iter->get() : nullptr;
+    if (!status || !status->is_mixed) {
+      // The listener does not contribute to the full mix.
+      listener_frames[i]->CopyFrom(*audio_frame_for_mixing);
+      continue;
+    }
+
+    AudioFrameList mix_minus_list;
+    for (AudioFrame* frame : mix_list) {
+      if (frame != &status->audio_frame) {
+        mix_minus_list.push_back(frame);
+      }
+    }
+    if (!status->mix_minus_combiner) {
+      status->mix_minus_combiner =
+          std::make_unique<FrameCombiner>(use_limiter_);
+    }
+    status->mix_minus_combiner->Combine(mix_minus_list, number_of_channels,
+                                        OutputFrequency(), number_of_streams,
+                                        listener_frames[i]);
+  }
+}
+
 void AudioMixerImpl::CalculateOutputFrequency() {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
   rtc::CritScope lock(&crit_);
@@ -181,11 +248,29 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
 
-  // Get audio from the audio sources and put it in the SourceFrame vector.
-  for (auto& source_and_status : audio_source_list_) {
-    const auto audio_frame_info =
+  // Get audio from the audio sources. The frames are collected in the order
+  // of |audio_source_list_| regardless of how they are fetched, which makes
+  // the result deterministic.
+  audio_frame_infos_.resize(audio_source_list_.size());
+  const int output_frequency = OutputFrequency();
+  auto get_audio = [&](size_t index) {
+    SourceStatus* source_and_status = audio_source_list_[index].get();
+    audio_frame_infos_[index] =
         source_and_status->audio_source->GetAudioFrameWithInfo(
-            OutputFrequency(), &source_and_status->audio_frame);
+            output_frequency, &source_and_status->audio_frame);
+  };
+  if (source_runner_) {
+    source_runner_->Run(audio_source_list_.size(), get_audio);
+  } else {
+    for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+      get_audio(i);
+    }
+  }
+
+  // Put the audio in the SourceFrame vector.
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    auto& source_and_status = audio_source_list_[i];
+    const auto audio_frame_info = audio_frame_infos_[i];
 
     if (audio_frame_info == Source::AudioFrameInfo::kError) {
       RTC_LOG_F(LS_WARNING) << "failed to GetAudioFrameWithInfo() from source";
@@ -194,31 +279,37 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
     audio_source_mixing_data_list.emplace_back(
         source_and_status.get(), &source_and_status->audio_frame,
         audio_frame_info == Source::AudioFrameInfo::kMuted);
+    audio_source_mixing_data_list.back().position = i;
   }
 
-  // Sort frames by sorting function.
-  std::sort(audio_source_mixing_data_list.begin(),
-            audio_source_mixing_data_list.end(), ShouldMixBefore);
-
-  int max_audio_frame_counter = kMaximumAmountOfMixedAudioSources;
-
-  // Go through list in order and put unmuted frames in result list.
-  for (const auto& p : audio_source_mixing_data_list) {
-    // Filter muted.
-    if (p.muted) {
-      p.source_status->is_mixed = false;
+  // Only the first |kMaximumAmountOfMixedAudioSources| frames in mixing
+  // order can be mixed. Since muted frames are ordered last, a partial sort
+  // selecting these is sufficient, which keeps the cost linear in the number
+  // of sources.
+  const size_t num_selected =
+      std::min<size_t>(kMaximumAmountOfMixedAudioSources,
+                       audio_source_mixing_data_list.size());
+  const auto selected_end =
+      audio_source_mixing_data_list.begin() + num_selected;
+  std::partial_sort(audio_source_mixing_data_list.begin(), selected_end,
+                    audio_source_mixing_data_list.end(), ShouldMixBefore);
+
+  // Put the unmuted selected frames in the result list.
+  for (auto it = audio_source_mixing_data_list.begin(); it != selected_end;
+       ++it) {
+    it->source_status->is_mixed = !it->muted;
+    if (it->muted) {
       continue;
     }
-
-    // Add frame to result vector for mixing.
-    bool is_mixed = false;
-    if (max_audio_frame_counter > 0) {
-      --max_audio_frame_counter;
-      result.push_back(p.audio_frame);
-      ramp_list.emplace_back(p.source_status, p.audio_frame, false, -1);
-      is_mixed = true;
+    result.push_back(it->audio_frame);
+    // Only sources that were not mixed in the last call need to be ramped.
+    if (it->source_status->gain != 1.0f) {
+      ramp_list.emplace_back(it->source_status, it->audio_frame, false, -1);
     }
-    p.source_status->is_mixed = is_mixed;
+  }
+  for (auto it = selected_end; it != audio_source_mixing_data_list.end();
+       ++it) {
+    it->source_status->is_mixed = false;
   }
   RampAndUpdateGain(ramp_list);
   return result;
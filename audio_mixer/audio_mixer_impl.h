@@ -16,11 +16,13 @@
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/audio/audio_frame.h"
 #include "api/audio/audio_mixer.h"
 #include "api/scoped_refptr.h"
 #include "modules/audio_mixer/frame_combiner.h"
 #include "modules/audio_mixer/output_rate_calculator.h"
+#include "modules/audio_processing/utility/channel_group_runner.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/race_checker.h"
@@ -41,6 +43,10 @@ class AudioMixerImpl : public AudioMixer {
 
     // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
     AudioFrame audio_frame;
+
+    // Combiner for the mix excluding this source, created by MixMinus() when
+    // this source is mixed. It has its own limiter state.
+    std::unique_ptr<FrameCombiner> mix_minus_combiner;
   };
 
   using SourceStatusList = std::vector<std::unique_ptr<SourceStatus>>;
@@ -55,6 +61,16 @@ class AudioMixerImpl : public AudioMixer {
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter);
 
+  // Like above, but fetches the audio of up to |max_num_parallel_sources|
+  // sources at a time, using worker threads owned by the mixer. The sources
+  // must then allow GetAudioFrameWithInfo() to be called concurrently on
+  // different sources. The mixing result does not depend on the number of
+  // threads.
+  static rtc::scoped_refptr<AudioMixerImpl> Create(
+      std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+      bool use_limiter,
+      size_t max_num_parallel_sources);
+
   ~AudioMixerImpl() override;
 
   // AudioMixer functions
@@ -65,6 +81,19 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(crit_);
 
+  // Like Mix(), but also produces a mix-minus for each source in |listeners|:
+  // the mix of all sources except the listener itself, written to the frame
+  // at the same index in |listener_frames|. The sources are fetched and the
+  // full mix is computed once. Only the listeners that are among the mixed
+  // sources get a mix of their own, with a limiter of their own; every other
+  // listener gets a copy of the full mix. This makes the cost independent of
+  // the number of listeners, apart from the copies.
+  void MixMinus(size_t number_of_channels,
+                AudioFrame* audio_frame_for_mixing,
+                rtc::ArrayView<Source* const> listeners,
+                rtc::ArrayView<AudioFrame* const> listener_frames)
+      RTC_LOCKS_EXCLUDED(crit_);
+
   // Returns true if the source was mixed last round. Returns
   // false and logs an error if the source was never added to the
   // mixer.
@@ -72,7 +101,8 @@ class AudioMixerImpl : public AudioMixer {
 
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-                 bool use_limiter);
+                 bool use_limiter,
+                 size_t max_num_parallel_sources);
 
  private:
   // Set mixing frequency through OutputFrequencyCalculator.
@@ -101,6 +131,13 @@ class AudioMixerImpl : public AudioMixer {
 
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_ RTC_GUARDED_BY(race_checker_);
+  const bool use_limiter_;
+
+  // Fetches the audio from the sources in parallel, if enabled.
+  std::unique_ptr<ChannelGroupRunner> source_runner_
+      RTC_GUARDED_BY(race_checker_);
+  std::vector<Source::AudioFrameInfo> audio_frame_infos_
+      RTC_GUARDED_BY(race_checker_);
 
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
@@ -641,4 +641,108 @@ TEST(AudioMixer, MultipleChannelsAndHighRate) {
 #endif
 }
 
+TEST(AudioMixer, LoudestSourcesMixedAmongMany) {
+  constexpr int kAudioSources = 100;
+  const auto mixer = AudioMixerImpl::Create();
+
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    // Give the sources distinct energies in a scrambled order.
+    participants[i].fake_frame()->mutable_data()[80] =
+        static_cast<int16_t>((i * 37) % kAudioSources + 1);
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+  }
+
+  AudioFrame audio_frame;
+  mixer->Mix(1, &audio_frame);
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    const bool is_loudest =
+        (i * 37) % kAudioSources >=
+        kAudioSources - AudioMixerImpl::kMaximumAmountOfMixedAudioSources;
+    EXPECT_EQ(is_loudest,
+              mixer->GetAudioSourceMixabilityStatusForTest(&participants[i]))
+        << "Mixing status of AudioSource #" << i << " wrong.";
+  }
+}
+
+TEST(AudioMixer, MixMinusExcludesListener) {
+  constexpr int kAudioSources = 5;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), false);
+
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    AudioFrame* frame = participants[i].fake_frame();
+    std::fill(frame->mutable_data(),
+              frame->mutable_data() + frame->samples_per_channel_,
+              static_cast<int16_t>(100 * (i + 1)));
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+  }
+
+  // The last three sources are the loudest and are mixed.
+  AudioMixer::Source* const listeners[] = {&participants[0],
+                                           &participants[kAudioSources - 1]};
+  AudioFrame full_mix;
+  AudioFrame mix_minus_0;
+  AudioFrame mix_minus_last;
+  AudioFrame* const listener_frames[] = {&mix_minus_0, &mix_minus_last};
+  // Mix twice, to get past the ramping of the newly mixed sources.
+  for (int k = 0; k < 2; ++k) {
+    mixer->MixMinus(1, &full_mix, listeners, listener_frames);
+  }
+
+  ASSERT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&participants[0]));
+  ASSERT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(
+      &participants[kAudioSources - 1]));
+  EXPECT_EQ(300 + 400 + 500, full_mix.data()[100]);
+  EXPECT_EQ(300 + 400 + 500, mix_minus_0.data()[100]);
+  EXPECT_EQ(300 + 400, mix_minus_last.data()[100]);
+  EXPECT_EQ(full_mix.samples_per_channel_, mix_minus_last.samples_per_channel_);
+}
+
+// Fetching the audio of the sources in parallel should give the same result
+// as fetching it one source at a time.
+TEST(AudioMixer, ParallelSourcesGiveSameResultAsSequential) {
+  constexpr int kAudioSources =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources + 5;
+  const auto sequential_mixer = AudioMixerImpl::Create();
+  const auto parallel_mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), true, 4);
+
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    int16_t* data = participants[i].fake_frame()->mutable_data();
+    for (size_t j = 0; j < participants[i].fake_frame()->samples_per_channel_;
+         ++j) {
+      data[j] = static_cast<int16_t>((i + 1) * ((j % 50) - 25));
+    }
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(_, _)).Times(Exactly(6));
+    EXPECT_TRUE(sequential_mixer->AddSource(&participants[i]));
+    EXPECT_TRUE(parallel_mixer->AddSource(&participants[i]));
+  }
+
+  for (int k = 0; k < 3; ++k) {
+    AudioFrame sequential_frame;
+    AudioFrame parallel_frame;
+    sequential_mixer->Mix(1, &sequential_frame);
+    parallel_mixer->Mix(1, &parallel_frame);
+    ASSERT_EQ(sequential_frame.samples_per_channel_,
+              parallel_frame.samples_per_channel_);
+    EXPECT_EQ(0, memcmp(sequential_frame.data(), parallel_frame.data(),
+                        sequential_frame.samples_per_channel_ *
+                            sizeof(int16_t)));
+    for (int i = 0; i < kAudioSources; ++i) {
+      EXPECT_EQ(
+          sequential_mixer->GetAudioSourceMixabilityStatusForTest(
+              &participants[i]),
+          parallel_mixer->GetAudioSourceMixabilityStatusForTest(
+              &participants[i]));
+    }
+  }
+}
+
 }  // namespace webrtc
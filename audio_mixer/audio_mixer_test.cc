@@ -10,8 +10,11 @@
 
 #include "api/audio/audio_mixer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "absl/flags/flag.h"
@@ -20,6 +23,7 @@
 #include "modules/audio_mixer/audio_mixer_impl.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
 
 ABSL_FLAG(int,
           sampling_rate,
@@ -40,6 +44,15 @@ ABSL_FLAG(std::string, input_file_1, "", "First input. Default none.");
 ABSL_FLAG(std::string, input_file_2, "", "Second input. Default none.");
 ABSL_FLAG(std::string, input_file_3, "", "Third input. Default none.");
 ABSL_FLAG(std::string, input_file_4, "", "Fourth input. Default none.");
+ABSL_FLAG(bool,
+          benchmark,
+          false,
+          "Instead of mixing the input files, measure the time to mix 3, 10 "
+          "and 50 synthetic sources.");
+ABSL_FLAG(int,
+          benchmark_num_frames,
+          10000,
+          "Number of 10 ms frames to mix per benchmark run.");
 
 namespace webrtc {
 namespace test {
@@ -91,6 +104,78 @@ class FilePlayingSource : public AudioMixer::Source {
   int number_of_channels_;
   bool file_has_ended_ = false;
 };
+
+// Source producing a tone at a source-specific frequency.
+class ToneSource : public AudioMixer::Source {
+ public:
+  ToneSource(int sample_rate_hz, size_t num_channels, int index)
+      : sample_rate_hz_(sample_rate_hz),
+        num_channels_(num_channels),
+        frequency_hz_(200.f + 37.f * index),
+        amplitude_(1000.f + 100.f * (index % 10)) {}
+
+  AudioFrameInfo GetAudioFrameWithInfo(int target_rate_hz,
+                                       AudioFrame* frame) override {
+    RTC_CHECK_EQ(target_rate_hz, sample_rate_hz_);
+    frame->samples_per_channel_ = sample_rate_hz_ / 100;
+    frame->num_channels_ = num_channels_;
+    frame->sample_rate_hz_ = sample_rate_hz_;
+    frame->vad_activity_ = AudioFrame::kVadActive;
+    int16_t* data = frame->mutable_data();
+    const float phase_increment = 2.f * 3.14159265f * frequency_hz_ /
+                                  static_cast<float>(sample_rate_hz_);
+    for (size_t i = 0; i < frame->samples_per_channel_; ++i) {
+      const int16_t sample =
+          static_cast<int16_t>(amplitude_ * std::sin(phase_));
+      for (size_t ch = 0; ch < num_channels_; ++ch) {
+        data[i * num_channels_ + ch] = sample;
+      }
+      phase_ = std::fmod(phase_ + phase_increment, 2.f * 3.14159265f);
+    }
+    return AudioFrameInfo::kNormal;
+  }
+
+  int Ssrc() const override { return 0; }
+
+  int PreferredSampleRate() const override { return sample_rate_hz_; }
+
+ private:
+  const int sample_rate_hz_;
+  const size_t num_channels_;
+  const float frequency_hz_;
+  const float amplitude_;
+  float phase_ = 0.f;
+};
+
+// Prints the average time per Mix() call for a number of tone sources.
+void RunBenchmark(int sample_rate_hz,
+                  size_t num_channels,
+                  bool use_limiter,
+                  int num_frames) {
+  for (int num_sources : {3, 10, 50}) {
+    rtc::scoped_refptr<AudioMixerImpl> mixer(AudioMixerImpl::Create(
+        std::unique_ptr<OutputRateCalculator>(
+            new DefaultOutputRateCalculator()),
+        use_limiter));
+    std::vector<std::unique_ptr<ToneSource>> sources;
+    for (int i = 0; i < num_sources; ++i) {
+      sources.emplace_back(new ToneSource(sample_rate_hz, num_channels, i));
+      RTC_CHECK(mixer->AddSource(sources.back().get()));
+    }
+
+    AudioFrame frame;
+    const int64_t start_time_ns = rtc::TimeNanos();
+    for (int i = 0; i < num_frames; ++i) {
+      mixer->Mix(num_channels, &frame);
+    }
+    const int64_t elapsed_time_ns = rtc::TimeNanos() - start_time_ns;
+    std::cout << "Sources: " << num_sources << ", rate: " << sample_rate_hz
+              << ", channels: " << num_channels
+              << ", ns per mix: " << elapsed_time_ns / std::max(num_frames, 1)
+              << "\n";
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
 
@@ -112,6 +197,14 @@ const std::vector<std::string> parse_input_files() {
 int main(int argc, char* argv[]) {
   absl::ParseCommandLine(argc, argv);
 
+  if (absl::GetFlag(FLAGS_benchmark)) {
+    webrtc::test::RunBenchmark(absl::GetFlag(FLAGS_sampling_rate),
+                               absl::GetFlag(FLAGS_stereo) ? 2 : 1,
+                               absl::GetFlag(FLAGS_limiter),
+                               absl::GetFlag(FLAGS_benchmark_num_frames));
+    return 0;
+  }
+
   rtc::scoped_refptr<webrtc::AudioMixerImpl> mixer(
       webrtc::AudioMixerImpl::Create(
           std::unique_ptr<webrtc::OutputRateCalculator>(
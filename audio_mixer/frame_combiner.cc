@@ -80,21 +80,41 @@ void MixToFloatFrame(const std::vector<AudioFrame*>& mix_list,
                      MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  for (auto& one_channel_buffer : *mixing_buffer) {
-    std::fill(one_channel_buffer.begin(), one_channel_buffer.end(), 0.f);
+  const size_t output_number_of_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t output_samples_per_channel =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+
+  // Clear the part of the mixing buffer that is used.
+  for (size_t j = 0; j < output_number_of_channels; ++j) {
+    std::fill((*mixing_buffer)[j].begin(),
+              (*mixing_buffer)[j].begin() + output_samples_per_channel, 0.f);
   }
 
-  // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame->data()[number_of_channels * k + j];
+  // Convert to FloatS16 and mix. The frames are added one block of samples
+  // at a time, which keeps that part of the mixing buffer in the cache while
+  // all the frames are added to it. The sums of 16 bit integers are exact in
+  // float, so the result does not depend on the order of the additions.
+  constexpr size_t kBlockSize = 64;
+  for (size_t block_begin = 0; block_begin < output_samples_per_channel;
+       block_begin += kBlockSize) {
+    const size_t block_end =
+        std::min(block_begin + kBlockSize, output_samples_per_channel);
+    for (const AudioFrame* frame : mix_list) {
+      const int16_t* const frame_data = frame->data();
+      if (number_of_channels == 1) {
+        // Contiguous input and output, which the compiler can vectorize.
+        float* const channel = (*mixing_buffer)[0].data();
+        for (size_t k = block_begin; k < block_end; ++k) {
+          channel[k] += frame_data[k];
+        }
+        continue;
+      }
+      for (size_t k = block_begin; k < block_end; ++k) {
+        const int16_t* const sample = &frame_data[number_of_channels * k];
+        for (size_t j = 0; j < output_number_of_channels; ++j) {
+          (*mixing_buffer)[j][k] += sample[j];
+        }
       }
     }
   }
@@ -113,10 +133,18 @@ void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
                             AudioFrame* audio_frame_for_mixing) {
   const size_t number_of_channels = mixing_buffer_view.num_channels();
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
-  // Put data in the result frame.
-  for (size_t i = 0; i < number_of_channels; ++i) {
+  int16_t* const output = audio_frame_for_mixing->mutable_data();
+  if (number_of_channels == 1) {
+    rtc::ArrayView<const float> channel = mixing_buffer_view.channel(0);
     for (size_t j = 0; j < samples_per_channel; ++j) {
-      audio_frame_for_mixing->mutable_data()[number_of_channels * j + i] =
+      output[j] = FloatS16ToS16(channel[j]);
+    }
+    return;
+  }
+  // Put data in the result frame, writing it sequentially.
+  for (size_t j = 0; j < samples_per_channel; ++j) {
+    for (size_t i = 0; i < number_of_channels; ++i) {
+      output[number_of_channels * j + i] =
           FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
     }
   }
@@ -32,6 +32,7 @@ extern "C" {
 #include "modules/audio_processing/aec/aec_core_optimized_methods.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/utility/delay_estimator_wrapper.h"
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 #include "system_wrappers/include/metrics.h"
@@ -1489,6 +1490,10 @@ AecCore* WebRtcAec_CreateAec(int instance_count) {
   if (WebRtc_GetCPUInfo(kSSE2)) {
     WebRtcAec_InitAec_SSE2();
   }
+  // Replaces only some of the SSE2 functions, with bitexact versions.
+  if (GetCpuSupportsAvx2()) {
+    WebRtcAec_InitAec_AVX2();
+  }
 #endif
 
 #if defined(MIPS_FPU_LE)
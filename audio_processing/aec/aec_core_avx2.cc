@@ -0,0 +1,269 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * The core AEC algorithm, AVX2 version of speed-critical functions.
+ *
+ * The functions perform the same operations as their SSE2 versions on each
+ * element, eight at once, and without fused multiply-adds, so that the results
+ * are bitexact with the SSE2 versions.
+ */
+
+#include <immintrin.h>
+#include <math.h>
+#include <string.h>  // memset
+
+#include "modules/audio_processing/aec/aec_common.h"
+#include "modules/audio_processing/aec/aec_core_optimized_methods.h"
+#include "modules/audio_processing/utility/ooura_fft.h"
+
+namespace webrtc {
+
+namespace {
+
+// Splits the eight interleaved complex values of |c3210| and |c7654| into
+// their real and imaginary parts.
+void Deinterleave(__m256 c3210, __m256 c7654, __m256* re, __m256* im) {
+  // The shuffles work on each 128 bit lane, which results in the order
+  // 0 1 4 5 2 3 6 7.
+  const __m256 re_lanes =
+      _mm256_shuffle_ps(c3210, c7654, _MM_SHUFFLE(2, 0, 2, 0));
+  const __m256 im_lanes =
+      _mm256_shuffle_ps(c3210, c7654, _MM_SHUFFLE(3, 1, 3, 1));
+  *re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re_lanes),
+                                               _MM_SHUFFLE(3, 1, 2, 0)));
+  *im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im_lanes),
+                                               _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+float MulRe(float aRe, float aIm, float bRe, float bIm) {
+  return aRe * bRe - aIm * bIm;
+}
+
+float MulIm(float aRe, float aIm, float bRe, float bIm) {
+  return aRe * bIm + aIm * bRe;
+}
+
+void FilterFarAVX2(int num_partitions,
+                   int x_fft_buf_block_pos,
+                   float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1],
+                   float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1],
+                   float y_fft[2][PART_LEN1]) {
+  for (int i = 0; i < num_partitions; i++) {
+    int xPos = (i + x_fft_buf_block_pos) * PART_LEN1;
+    const int pos = i * PART_LEN1;
+    // Check for wrap
+    if (i + x_fft_buf_block_pos >= num_partitions) {
+      xPos -= num_partitions * (PART_LEN1);
+    }
+
+    int j = 0;
+    // vectorized code (eight at once)
+    for (; j + 7 < PART_LEN1; j += 8) {
+      const __m256 x_fft_buf_re = _mm256_loadu_ps(&x_fft_buf[0][xPos + j]);
+      const __m256 x_fft_buf_im = _mm256_loadu_ps(&x_fft_buf[1][xPos + j]);
+      const __m256 h_fft_buf_re = _mm256_loadu_ps(&h_fft_buf[0][pos + j]);
+      const __m256 h_fft_buf_im = _mm256_loadu_ps(&h_fft_buf[1][pos + j]);
+      const __m256 y_fft_re = _mm256_loadu_ps(&y_fft[0][j]);
+      const __m256 y_fft_im = _mm256_loadu_ps(&y_fft[1][j]);
+      const __m256 a = _mm256_mul_ps(x_fft_buf_re, h_fft_buf_re);
+      const __m256 b = _mm256_mul_ps(x_fft_buf_im, h_fft_buf_im);
+      const __m256 c = _mm256_mul_ps(x_fft_buf_re, h_fft_buf_im);
+      const __m256 d = _mm256_mul_ps(x_fft_buf_im, h_fft_buf_re);
+      const __m256 e = _mm256_sub_ps(a, b);
+      const __m256 f = _mm256_add_ps(c, d);
+      _mm256_storeu_ps(&y_fft[0][j], _mm256_add_ps(y_fft_re, e));
+      _mm256_storeu_ps(&y_fft[1][j], _mm256_add_ps(y_fft_im, f));
+    }
+    // scalar code for the remaining items.
+    for (; j < PART_LEN1; j++) {
+      y_fft[0][j] += MulRe(x_fft_buf[0][xPos + j], x_fft_buf[1][xPos + j],
+                           h_fft_buf[0][pos + j], h_fft_buf[1][pos + j]);
+      y_fft[1][j] += MulIm(x_fft_buf[0][xPos + j], x_fft_buf[1][xPos + j],
+                           h_fft_buf[0][pos + j], h_fft_buf[1][pos + j]);
+    }
+  }
+}
+
+void ScaleErrorSignalAVX2(float mu,
+                          float error_threshold,
+                          float x_pow[PART_LEN1],
+                          float ef[2][PART_LEN1]) {
+  const __m256 k1e_10f = _mm256_set1_ps(1e-10f);
+  const __m256 kMu = _mm256_set1_ps(mu);
+  const __m256 kThresh = _mm256_set1_ps(error_threshold);
+
+  int i = 0;
+  // vectorized code (eight at once)
+  for (; i + 7 < PART_LEN1; i += 8) {
+    const __m256 xPowPlus = _mm256_add_ps(_mm256_loadu_ps(&x_pow[i]), k1e_10f);
+    __m256 ef_re = _mm256_div_ps(_mm256_loadu_ps(&ef[0][i]), xPowPlus);
+    __m256 ef_im = _mm256_div_ps(_mm256_loadu_ps(&ef[1][i]), xPowPlus);
+    const __m256 ef_sum2 = _mm256_add_ps(_mm256_mul_ps(ef_re, ef_re),
+                                         _mm256_mul_ps(ef_im, ef_im));
+    const __m256 absEf = _mm256_sqrt_ps(ef_sum2);
+    const __m256 bigger = _mm256_cmp_ps(absEf, kThresh, _CMP_GT_OQ);
+    const __m256 absEfInv =
+        _mm256_div_ps(kThresh, _mm256_add_ps(absEf, k1e_10f));
+    ef_re = _mm256_blendv_ps(ef_re, _mm256_mul_ps(ef_re, absEfInv), bigger);
+    ef_im = _mm256_blendv_ps(ef_im, _mm256_mul_ps(ef_im, absEfInv), bigger);
+    _mm256_storeu_ps(&ef[0][i], _mm256_mul_ps(ef_re, kMu));
+    _mm256_storeu_ps(&ef[1][i], _mm256_mul_ps(ef_im, kMu));
+  }
+  // scalar code for the remaining items.
+  for (; i < PART_LEN1; i++) {
+    ef[0][i] /= (x_pow[i] + 1e-10f);
+    ef[1][i] /= (x_pow[i] + 1e-10f);
+    float abs_ef = sqrtf(ef[0][i] * ef[0][i] + ef[1][i] * ef[1][i]);
+
+    if (abs_ef > error_threshold) {
+      abs_ef = error_threshold / (abs_ef + 1e-10f);
+      ef[0][i] *= abs_ef;
+      ef[1][i] *= abs_ef;
+    }
+
+    // Stepsize factor
+    ef[0][i] *= mu;
+    ef[1][i] *= mu;
+  }
+}
+
+void FilterAdaptationAVX2(
+    const OouraFft& ooura_fft,
+    int num_partitions,
+    int x_fft_buf_block_pos,
+    float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1],
+    float e_fft[2][PART_LEN1],
+    float h_fft_buf[2][kExtendedNumPartitions * PART_LEN1]) {
+  float fft[PART_LEN2];
+  for (int i = 0; i < num_partitions; i++) {
+    int xPos = (i + x_fft_buf_block_pos) * (PART_LEN1);
+    const int pos = i * PART_LEN1;
+    // Check for wrap
+    if (i + x_fft_buf_block_pos >= num_partitions) {
+      xPos -= num_partitions * PART_LEN1;
+    }
+
+    // Process the whole array...
+    for (int j = 0; j < PART_LEN; j += 8) {
+      const __m256 x_fft_buf_re = _mm256_loadu_ps(&x_fft_buf[0][xPos + j]);
+      const __m256 x_fft_buf_im = _mm256_loadu_ps(&x_fft_buf[1][xPos + j]);
+      const __m256 e_fft_re = _mm256_loadu_ps(&e_fft[0][j]);
+      const __m256 e_fft_im = _mm256_loadu_ps(&e_fft[1][j]);
+      // Calculate the product of conjugate(x_fft_buf) by e_fft.
+      //   re(conjugate(a) * b) = aRe * bRe + aIm * bIm
+      //   im(conjugate(a) * b)=  aRe * bIm - aIm * bRe
+      const __m256 a = _mm256_mul_ps(x_fft_buf_re, e_fft_re);
+      const __m256 b = _mm256_mul_ps(x_fft_buf_im, e_fft_im);
+      const __m256 c = _mm256_mul_ps(x_fft_buf_re, e_fft_im);
+      const __m256 d = _mm256_mul_ps(x_fft_buf_im, e_fft_re);
+      const __m256 e = _mm256_add_ps(a, b);
+      const __m256 f = _mm256_sub_ps(c, d);
+      // Interleave real and imaginary parts. The unpacks work on each 128 bit
+      // lane, so |g| holds the values 0 1 4 5 and |h| the values 2 3 6 7.
+      const __m256 g = _mm256_unpacklo_ps(e, f);
+      const __m256 h = _mm256_unpackhi_ps(e, f);
+      _mm256_storeu_ps(&fft[2 * j + 0], _mm256_permute2f128_ps(g, h, 0x20));
+      _mm256_storeu_ps(&fft[2 * j + 8], _mm256_permute2f128_ps(g, h, 0x31));
+    }
+    // ... and fixup the first imaginary entry.
+    fft[1] =
+        MulRe(x_fft_buf[0][xPos + PART_LEN], -x_fft_buf[1][xPos + PART_LEN],
+              e_fft[0][PART_LEN], e_fft[1][PART_LEN]);
+
+    ooura_fft.InverseFft(fft);
+    memset(fft + PART_LEN, 0, sizeof(float) * PART_LEN);
+
+    // fft scaling
+    {
+      const __m256 scale = _mm256_set1_ps(2.0f / PART_LEN2);
+      for (int j = 0; j < PART_LEN; j += 8) {
+        _mm256_storeu_ps(&fft[j],
+                         _mm256_mul_ps(_mm256_loadu_ps(&fft[j]), scale));
+      }
+    }
+    ooura_fft.Fft(fft);
+
+    {
+      const float wt1 = h_fft_buf[1][pos];
+      h_fft_buf[0][pos + PART_LEN] += fft[1];
+      for (int j = 0; j < PART_LEN; j += 8) {
+        __m256 fft_re;
+        __m256 fft_im;
+        Deinterleave(_mm256_loadu_ps(&fft[2 * j + 0]),
+                     _mm256_loadu_ps(&fft[2 * j + 8]), &fft_re, &fft_im);
+        const __m256 wtBuf_re =
+            _mm256_add_ps(_mm256_loadu_ps(&h_fft_buf[0][pos + j]), fft_re);
+        const __m256 wtBuf_im =
+            _mm256_add_ps(_mm256_loadu_ps(&h_fft_buf[1][pos + j]), fft_im);
+        _mm256_storeu_ps(&h_fft_buf[0][pos + j], wtBuf_re);
+        _mm256_storeu_ps(&h_fft_buf[1][pos + j], wtBuf_im);
+      }
+      h_fft_buf[1][pos] = wt1;
+    }
+  }
+}
+
+void ComputeCoherenceAVX2(const CoherenceState* coherence_state,
+                          float* cohde,
+                          float* cohxd) {
+  const __m256 vec_1eminus10 = _mm256_set1_ps(1e-10f);
+
+  int i = 0;
+  // Subband coherence
+  for (; i + 7 < PART_LEN1; i += 8) {
+    const __m256 vec_sd = _mm256_loadu_ps(&coherence_state->sd[i]);
+    const __m256 vec_se = _mm256_loadu_ps(&coherence_state->se[i]);
+    const __m256 vec_sx = _mm256_loadu_ps(&coherence_state->sx[i]);
+    const __m256 vec_sdse =
+        _mm256_add_ps(vec_1eminus10, _mm256_mul_ps(vec_sd, vec_se));
+    const __m256 vec_sdsx =
+        _mm256_add_ps(vec_1eminus10, _mm256_mul_ps(vec_sd, vec_sx));
+    __m256 vec_sde_0;
+    __m256 vec_sde_1;
+    Deinterleave(_mm256_loadu_ps(&coherence_state->sde[i][0]),
+                 _mm256_loadu_ps(&coherence_state->sde[i + 4][0]), &vec_sde_0,
+                 &vec_sde_1);
+    __m256 vec_sxd_0;
+    __m256 vec_sxd_1;
+    Deinterleave(_mm256_loadu_ps(&coherence_state->sxd[i][0]),
+                 _mm256_loadu_ps(&coherence_state->sxd[i + 4][0]), &vec_sxd_0,
+                 &vec_sxd_1);
+    __m256 vec_cohde = _mm256_mul_ps(vec_sde_0, vec_sde_0);
+    __m256 vec_cohxd = _mm256_mul_ps(vec_sxd_0, vec_sxd_0);
+    vec_cohde = _mm256_add_ps(vec_cohde, _mm256_mul_ps(vec_sde_1, vec_sde_1));
+    vec_cohde = _mm256_div_ps(vec_cohde, vec_sdse);
+    vec_cohxd = _mm256_add_ps(vec_cohxd, _mm256_mul_ps(vec_sxd_1, vec_sxd_1));
+    vec_cohxd = _mm256_div_ps(vec_cohxd, vec_sdsx);
+    _mm256_storeu_ps(&cohde[i], vec_cohde);
+    _mm256_storeu_ps(&cohxd[i], vec_cohxd);
+  }
+
+  // scalar code for the remaining items.
+  for (; i < PART_LEN1; i++) {
+    cohde[i] = (coherence_state->sde[i][0] * coherence_state->sde[i][0] +
+                coherence_state->sde[i][1] * coherence_state->sde[i][1]) /
+               (coherence_state->sd[i] * coherence_state->se[i] + 1e-10f);
+    cohxd[i] = (coherence_state->sxd[i][0] * coherence_state->sxd[i][0] +
+                coherence_state->sxd[i][1] * coherence_state->sxd[i][1]) /
+               (coherence_state->sx[i] * coherence_state->sd[i] + 1e-10f);
+  }
+}
+
+}  // namespace
+
+void WebRtcAec_InitAec_AVX2(void) {
+  WebRtcAec_FilterFar = FilterFarAVX2;
+  WebRtcAec_ScaleErrorSignal = ScaleErrorSignalAVX2;
+  WebRtcAec_FilterAdaptation = FilterAdaptationAVX2;
+  WebRtcAec_ComputeCoherence = ComputeCoherenceAVX2;
+}
+
+}  // namespace webrtc
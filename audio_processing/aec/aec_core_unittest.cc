@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec/aec_core.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "modules/audio_processing/aec/aec_core_optimized_methods.h"
+#include "modules/audio_processing/utility/ooura_fft.h"
+#include "modules/utility/include/cpu_features.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+// The functions replaced by WebRtcAec_InitAec_AVX2().
+struct Functions {
+  WebRtcAecFilterFar filter_far;
+  WebRtcAecScaleErrorSignal scale_error_signal;
+  WebRtcAecFilterAdaptation filter_adaptation;
+  WebRtcAecComputeCoherence compute_coherence;
+};
+
+Functions CurrentFunctions() {
+  return {WebRtcAec_FilterFar, WebRtcAec_ScaleErrorSignal,
+          WebRtcAec_FilterAdaptation, WebRtcAec_ComputeCoherence};
+}
+
+// Fills |data| with random values in [-scale, scale).
+void RandomFill(Random* random, float scale, float* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = scale * (2.f * random->Rand<float>() - 1.f);
+  }
+}
+
+}  // namespace
+
+// Verifies that the AVX2 functions give the same results as the SSE2 ones, so
+// that the bitexactness tests hold whichever of them the CPU supports.
+TEST(AecCore, Avx2FunctionsAreBitexactWithSse2) {
+  if (!GetCpuSupportsAvx2() || WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  WebRtcAec_InitAec_SSE2();
+  const Functions sse2 = CurrentFunctions();
+  WebRtcAec_InitAec_AVX2();
+  const Functions avx2 = CurrentFunctions();
+
+  Random random(42);
+  OouraFft ooura_fft;
+  const int kNumPartitions[] = {kNormalNumPartitions, kExtendedNumPartitions};
+  for (int num_partitions : kNumPartitions) {
+    for (int block_pos : {0, 1, num_partitions - 1}) {
+      SCOPED_TRACE(num_partitions);
+      SCOPED_TRACE(block_pos);
+      float x_fft_buf[2][kExtendedNumPartitions * PART_LEN1];
+      float h_fft_buf_sse2[2][kExtendedNumPartitions * PART_LEN1];
+      float h_fft_buf_avx2[2][kExtendedNumPartitions * PART_LEN1];
+      RandomFill(&random, 1000.f, &x_fft_buf[0][0],
+                 sizeof(x_fft_buf) / sizeof(float));
+      RandomFill(&random, 1.f, &h_fft_buf_sse2[0][0],
+                 sizeof(h_fft_buf_sse2) / sizeof(float));
+      memcpy(h_fft_buf_avx2, h_fft_buf_sse2, sizeof(h_fft_buf_sse2));
+
+      float y_fft_sse2[2][PART_LEN1];
+      float y_fft_avx2[2][PART_LEN1];
+      RandomFill(&random, 1000.f, &y_fft_sse2[0][0],
+                 sizeof(y_fft_sse2) / sizeof(float));
+      memcpy(y_fft_avx2, y_fft_sse2, sizeof(y_fft_sse2));
+      sse2.filter_far(num_partitions, block_pos, x_fft_buf, h_fft_buf_sse2,
+                      y_fft_sse2);
+      avx2.filter_far(num_partitions, block_pos, x_fft_buf, h_fft_buf_avx2,
+                      y_fft_avx2);
+      EXPECT_EQ(0, memcmp(y_fft_sse2, y_fft_avx2, sizeof(y_fft_sse2)));
+
+      float x_pow[PART_LEN1];
+      RandomFill(&random, 1000.f, x_pow, PART_LEN1);
+      for (float& x : x_pow) {
+        x = fabsf(x);
+      }
+      // Thresholds such that both branches are exercised.
+      sse2.scale_error_signal(0.5f, 1.f, x_pow, y_fft_sse2);
+      avx2.scale_error_signal(0.5f, 1.f, x_pow, y_fft_avx2);
+      EXPECT_EQ(0, memcmp(y_fft_sse2, y_fft_avx2, sizeof(y_fft_sse2)));
+
+      sse2.filter_adaptation(ooura_fft, num_partitions, block_pos, x_fft_buf,
+                             y_fft_sse2, h_fft_buf_sse2);
+      avx2.filter_adaptation(ooura_fft, num_partitions, block_pos, x_fft_buf,
+                             y_fft_avx2, h_fft_buf_avx2);
+      EXPECT_EQ(0,
+                memcmp(h_fft_buf_sse2, h_fft_buf_avx2, sizeof(h_fft_buf_sse2)));
+    }
+  }
+
+  CoherenceState coherence_state;
+  RandomFill(&random, 1000.f, &coherence_state.sde[0][0], 2 * PART_LEN1);
+  RandomFill(&random, 1000.f, &coherence_state.sxd[0][0], 2 * PART_LEN1);
+  RandomFill(&random, 1000.f, coherence_state.sx, PART_LEN1);
+  RandomFill(&random, 1000.f, coherence_state.sd, PART_LEN1);
+  RandomFill(&random, 1000.f, coherence_state.se, PART_LEN1);
+  float cohde_sse2[PART_LEN1];
+  float cohxd_sse2[PART_LEN1];
+  float cohde_avx2[PART_LEN1];
+  float cohxd_avx2[PART_LEN1];
+  sse2.compute_coherence(&coherence_state, cohde_sse2, cohxd_sse2);
+  avx2.compute_coherence(&coherence_state, cohde_avx2, cohxd_avx2);
+  EXPECT_EQ(0, memcmp(cohde_sse2, cohde_avx2, sizeof(cohde_sse2)));
+  EXPECT_EQ(0, memcmp(cohxd_sse2, cohxd_avx2, sizeof(cohxd_sse2)));
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -31,6 +31,7 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/random.h"
@@ -274,6 +275,131 @@ TEST(AdaptiveFirFilter, ComputeFrequencyResponseSse2Optimization) {
   }
 }
 
+// Verifies that the AVX2 methods for filter adaptation match their SSE2
+// counterparts. The fused multiply-adds round differently, so the outputs are
+// compared with a tolerance relative to the largest value produced.
+TEST(AdaptiveFirFilter, FilterAdaptationAvx2Optimizations) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+
+  if (GetCpuSupportsAvx2()) {
+    for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+      for (size_t num_render_channels : {1, 2, 4, 8}) {
+        std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+            RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
+                                      num_render_channels));
+        Random random_generator(42U);
+        std::vector<std::vector<std::vector<float>>> x(
+            kNumBands,
+            std::vector<std::vector<float>>(
+                num_render_channels, std::vector<float>(kBlockSize, 0.f)));
+        FftData S_Sse2;
+        FftData S_Avx2;
+        FftData G;
+        std::vector<std::vector<FftData>> H_Sse2(
+            num_partitions, std::vector<FftData>(num_render_channels));
+        std::vector<std::vector<FftData>> H_Avx2(
+            num_partitions, std::vector<FftData>(num_render_channels));
+        for (size_t p = 0; p < num_partitions; ++p) {
+          for (size_t ch = 0; ch < num_render_channels; ++ch) {
+            H_Sse2[p][ch].Clear();
+            H_Avx2[p][ch].Clear();
+          }
+        }
+
+        for (size_t k = 0; k < 500; ++k) {
+          for (size_t band = 0; band < x.size(); ++band) {
+            for (size_t ch = 0; ch < x[band].size(); ++ch) {
+              RandomizeSampleVector(&random_generator, x[band][ch]);
+            }
+          }
+          render_delay_buffer->Insert(x);
+          if (k == 0) {
+            render_delay_buffer->Reset();
+          }
+          render_delay_buffer->PrepareCaptureProcessing();
+          auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+          ApplyFilter_Avx2(*render_buffer, num_partitions, H_Avx2, &S_Avx2);
+          ApplyFilter_Sse2(*render_buffer, num_partitions, H_Sse2, &S_Sse2);
+          float S_peak = 1.f;
+          for (size_t j = 0; j < S_Sse2.re.size(); ++j) {
+            S_peak = std::max(S_peak, fabsf(S_Sse2.re[j]));
+            S_peak = std::max(S_peak, fabsf(S_Sse2.im[j]));
+          }
+          for (size_t j = 0; j < S_Sse2.re.size(); ++j) {
+            EXPECT_NEAR(S_Sse2.re[j], S_Avx2.re[j], S_peak * 1e-4f);
+            EXPECT_NEAR(S_Sse2.im[j], S_Avx2.im[j], S_peak * 1e-4f);
+          }
+
+          std::for_each(G.re.begin(), G.re.end(),
+                        [&](float& a) { a = random_generator.Rand<float>(); });
+          std::for_each(G.im.begin(), G.im.end(),
+                        [&](float& a) { a = random_generator.Rand<float>(); });
+
+          AdaptPartitions_Avx2(*render_buffer, G, num_partitions, &H_Avx2);
+          AdaptPartitions_Sse2(*render_buffer, G, num_partitions, &H_Sse2);
+
+          float H_peak = 1.f;
+          for (size_t p = 0; p < num_partitions; ++p) {
+            for (size_t ch = 0; ch < num_render_channels; ++ch) {
+              for (size_t j = 0; j < H_Sse2[p][ch].re.size(); ++j) {
+                H_peak = std::max(H_peak, fabsf(H_Sse2[p][ch].re[j]));
+                H_peak = std::max(H_peak, fabsf(H_Sse2[p][ch].im[j]));
+              }
+            }
+          }
+          for (size_t p = 0; p < num_partitions; ++p) {
+            for (size_t ch = 0; ch < num_render_channels; ++ch) {
+              for (size_t j = 0; j < H_Sse2[p][ch].re.size(); ++j) {
+                EXPECT_NEAR(H_Sse2[p][ch].re[j], H_Avx2[p][ch].re[j],
+                            H_peak * 1e-4f);
+                EXPECT_NEAR(H_Sse2[p][ch].im[j], H_Avx2[p][ch].im[j],
+                            H_peak * 1e-4f);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the AVX2 method for frequency response computation matches the
+// SSE2 counterpart.
+TEST(AdaptiveFirFilter, ComputeFrequencyResponseAvx2Optimization) {
+  if (GetCpuSupportsAvx2()) {
+    for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+      for (size_t num_render_channels : {1, 2, 4, 8}) {
+        std::vector<std::vector<FftData>> H(
+            num_partitions, std::vector<FftData>(num_render_channels));
+        std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Sse2(
+            num_partitions);
+        std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Avx2(
+            num_partitions);
+
+        for (size_t p = 0; p < num_partitions; ++p) {
+          for (size_t ch = 0; ch < num_render_channels; ++ch) {
+            for (size_t k = 0; k < H[p][ch].re.size(); ++k) {
+              H[p][ch].re[k] = k + p / 3.f + ch;
+              H[p][ch].im[k] = p + k / 7.f - ch;
+            }
+          }
+        }
+
+        ComputeFrequencyResponse_Sse2(num_partitions, H, &H2_Sse2);
+        ComputeFrequencyResponse_Avx2(num_partitions, H, &H2_Avx2);
+
+        for (size_t p = 0; p < num_partitions; ++p) {
+          for (size_t k = 0; k < H2_Sse2[p].size(); ++k) {
+            EXPECT_FLOAT_EQ(H2_Sse2[p][k], H2_Avx2[p][k]);
+          }
+        }
+      }
+    }
+  }
+}
+
 #endif
 
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
@@ -20,6 +21,9 @@ namespace webrtc {
 
 Aec3Optimization DetectOptimization() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCpuSupportsAvx2()) {
+    return Aec3Optimization::kAvx2;
+  }
   if (WebRtc_GetCPUInfo(kSSE2) != 0) {
     return Aec3Optimization::kSse2;
   }
@@ -15,11 +15,25 @@
 #include <iterator>
 
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
 namespace {
 
+Aec3Fft::Backend DefaultBackend() {
+  return field_trial::IsEnabled("WebRTC-Aec3UsePffft")
+             ? Aec3Fft::Backend::kPffft
+             : Aec3Fft::Backend::kOoura;
+}
+
+std::unique_ptr<Pffft> CreatePffft(Aec3Fft::Backend backend) {
+  if (backend != Aec3Fft::Backend::kPffft) {
+    return nullptr;
+  }
+  return std::make_unique<Pffft>(kFftLength, Pffft::FftType::kReal);
+}
+
 const float kHanning64[kFftLengthBy2] = {
     0.f,         0.00248461f, 0.00991376f, 0.0222136f,  0.03926189f,
     0.06088921f, 0.08688061f, 0.11697778f, 0.15088159f, 0.1882551f,
@@ -72,6 +86,62 @@ const float kSqrtHanning128[kFftLength] = {
 
 }  // namespace
 
+Aec3Fft::Aec3Fft() : Aec3Fft(DefaultBackend()) {}
+
+Aec3Fft::Aec3Fft(Backend backend)
+    : backend_(backend),
+      pffft_(CreatePffft(backend)),
+      pffft_in_(pffft_ ? pffft_->CreateBuffer() : nullptr),
+      pffft_out_(pffft_ ? pffft_->CreateBuffer() : nullptr) {}
+
+Aec3Fft::~Aec3Fft() = default;
+
+void Aec3Fft::Fft(std::array<float, kFftLength>* x, FftData* X) const {
+  RTC_DCHECK(x);
+  RTC_DCHECK(X);
+  if (backend_ == Backend::kOoura) {
+    ooura_fft_.Fft(x->data());
+  } else {
+    rtc::ArrayView<float> in = pffft_in_->GetView();
+    std::copy(x->begin(), x->end(), in.begin());
+    pffft_->ForwardTransform(*pffft_in_, pffft_out_.get(), /*ordered=*/true);
+
+    // Both transforms pack the output as the real DC and Nyquist components
+    // followed by interleaved complex bins, but the imaginary parts produced by
+    // Ooura have the opposite sign.
+    rtc::ArrayView<const float> out = pffft_out_->GetConstView();
+    (*x)[0] = out[0];
+    (*x)[1] = out[1];
+    for (size_t k = 2; k < kFftLength; k += 2) {
+      (*x)[k] = out[k];
+      (*x)[k + 1] = -out[k + 1];
+    }
+  }
+  X->CopyFromPackedArray(*x);
+}
+
+void Aec3Fft::Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
+  RTC_DCHECK(x);
+  X.CopyToPackedArray(x);
+  if (backend_ == Backend::kOoura) {
+    ooura_fft_.InverseFft(x->data());
+    return;
+  }
+
+  // Pffft scales the inverse transform by kFftLength while Ooura scales it by
+  // kFftLengthBy2, and the imaginary parts have the opposite sign. See Fft().
+  rtc::ArrayView<float> in = pffft_in_->GetView();
+  in[0] = 0.5f * (*x)[0];
+  in[1] = 0.5f * (*x)[1];
+  for (size_t k = 2; k < kFftLength; k += 2) {
+    in[k] = 0.5f * (*x)[k];
+    in[k + 1] = -0.5f * (*x)[k + 1];
+  }
+  pffft_->BackwardTransform(*pffft_in_, pffft_out_.get(), /*ordered=*/true);
+  rtc::ArrayView<const float> out = pffft_out_->GetConstView();
+  std::copy(out.begin(), out.end(), x->begin());
+}
+
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
                             Window window,
@@ -12,36 +12,35 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_AEC3_FFT_H_
 
 #include <array>
+#include <memory>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/utility/ooura_fft.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
 
 // Wrapper class that provides 128 point real valued FFT functionality with the
-// FftData type.
+// FftData type. The Pffft backend is not thread safe.
 class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
+  enum class Backend { kOoura, kPffft };
+
+  // Uses the Ooura backend unless the WebRTC-Aec3UsePffft field trial is
+  // enabled.
+  Aec3Fft();
+  explicit Aec3Fft(Backend backend);
+  ~Aec3Fft();
 
-  Aec3Fft() = default;
   // Computes the FFT. Note that both the input and output are modified.
-  void Fft(std::array<float, kFftLength>* x, FftData* X) const {
-    RTC_DCHECK(x);
-    RTC_DCHECK(X);
-    ooura_fft_.Fft(x->data());
-    X->CopyFromPackedArray(*x);
-  }
+  void Fft(std::array<float, kFftLength>* x, FftData* X) const;
   // Computes the inverse Fft.
-  void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
-    RTC_DCHECK(x);
-    X.CopyToPackedArray(x);
-    ooura_fft_.InverseFft(x->data());
-  }
+  void Ifft(const FftData& X, std::array<float, kFftLength>* x) const;
 
   // Windows the input using a Hanning window, and then adds padding of
   // kFftLengthBy2 initial zeros before computing the Fft.
@@ -63,8 +62,16 @@ class Aec3Fft {
                  Window window,
                  FftData* X) const;
 
+  Backend backend() const { return backend_; }
+
  private:
+  const Backend backend_;
   const OouraFft ooura_fft_;
+  // Only created for the Pffft backend. The transforms are done in these, since
+  // Pffft requires SIMD aligned buffers.
+  const std::unique_ptr<Pffft> pffft_;
+  const std::unique_ptr<Pffft::FloatBuffer> pffft_in_;
+  const std::unique_ptr<Pffft::FloatBuffer> pffft_out_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(Aec3Fft);
 };
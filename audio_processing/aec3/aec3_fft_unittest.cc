@@ -12,6 +12,7 @@
 
 #include <algorithm>
 
+#include "rtc_base/random.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -210,4 +211,57 @@ TEST(Aec3Fft, PaddedFft) {
   }
 }
 
+// Verifies that the Pffft backend produces the same transforms as the Ooura
+// backend.
+TEST(Aec3Fft, PffftMatchesOoura) {
+  Aec3Fft ooura_fft(Aec3Fft::Backend::kOoura);
+  Aec3Fft pffft_fft(Aec3Fft::Backend::kPffft);
+  EXPECT_EQ(Aec3Fft::Backend::kPffft, pffft_fft.backend());
+  Random random_generator(42U);
+  FftData X_ooura;
+  FftData X_pffft;
+  std::array<float, kFftLength> x_ooura;
+  std::array<float, kFftLength> x_pffft;
+
+  for (int k = 0; k < 20; ++k) {
+    for (size_t j = 0; j < x_ooura.size(); ++j) {
+      x_ooura[j] = x_pffft[j] = 2.f * random_generator.Rand<float>() - 1.f;
+    }
+
+    ooura_fft.Fft(&x_ooura, &X_ooura);
+    pffft_fft.Fft(&x_pffft, &X_pffft);
+    for (size_t j = 0; j < X_ooura.re.size(); ++j) {
+      EXPECT_NEAR(X_ooura.re[j], X_pffft.re[j], 0.0001f);
+      EXPECT_NEAR(X_ooura.im[j], X_pffft.im[j], 0.0001f);
+    }
+
+    ooura_fft.Ifft(X_ooura, &x_ooura);
+    pffft_fft.Ifft(X_ooura, &x_pffft);
+    for (size_t j = 0; j < x_ooura.size(); ++j) {
+      EXPECT_NEAR(x_ooura[j], x_pffft[j], 0.001f);
+    }
+  }
+}
+
+// Verifies that InverseFft and Fft work as intended with the Pffft backend.
+TEST(Aec3Fft, PffftFftAndIfft) {
+  Aec3Fft fft(Aec3Fft::Backend::kPffft);
+  FftData X;
+  std::array<float, kFftLength> x;
+  std::array<float, kFftLength> x_ref;
+
+  int v = 0;
+  for (int k = 0; k < 20; ++k) {
+    for (size_t j = 0; j < x.size(); ++j) {
+      x[j] = v++;
+      x_ref[j] = x[j] * 64.f;
+    }
+    fft.Fft(&x, &X);
+    fft.Ifft(X, &x);
+    for (size_t j = 0; j < x.size(); ++j) {
+      EXPECT_NEAR(x_ref[j], x[j], 0.1f);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -50,6 +50,27 @@ EchoCanceller3Config AdjustConfig(const EchoCanceller3Config& config) {
     adjusted_cfg.erle.clamp_quality_estimate_to_one = false;
   }
 
+  if (field_trial::IsEnabled("WebRTC-Aec3LowComplexityProfile")) {
+    // Reduced-complexity profile for targets where the CPU budget is tight.
+    // The shadow filter mainly serves to quickly track the direct path and
+    // early reflections, so it is shortened to 8 blocks (~32 ms). This lowers
+    // the cost of the shadow filtering and adaptation by roughly a third at
+    // the price of a slower recovery after echo path changes with long tails.
+    constexpr size_t kLowComplexityShadowFilterLengthBlocks = 8;
+    adjusted_cfg.filter.shadow.length_blocks =
+        std::min(adjusted_cfg.filter.shadow.length_blocks,
+                 kLowComplexityShadowFilterLengthBlocks);
+    adjusted_cfg.filter.shadow_initial.length_blocks =
+        std::min(adjusted_cfg.filter.shadow_initial.length_blocks,
+                 kLowComplexityShadowFilterLengthBlocks);
+
+    // Running the matched filters at 2 kHz instead of 4 kHz halves the number
+    // of taps, and thereby the cost, of the delay estimation while covering
+    // the same delay range. The delay estimate becomes coarser, which is
+    // absorbed by the delay headroom of the adaptive filters.
+    adjusted_cfg.delay.down_sampling_factor = 8;
+  }
+
   return adjusted_cfg;
 }
 
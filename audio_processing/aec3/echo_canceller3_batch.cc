@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/echo_canceller3_batch.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+EchoCanceller3Batch::EchoCanceller3Batch(const EchoCanceller3Config& config,
+                                         int sample_rate_hz,
+                                         size_t num_render_channels,
+                                         size_t num_capture_channels,
+                                         size_t num_sessions) {
+  RTC_DCHECK_LT(0, num_sessions);
+  sessions_.reserve(num_sessions);
+  for (size_t k = 0; k < num_sessions; ++k) {
+    sessions_.push_back(std::make_unique<EchoCanceller3>(
+        config, sample_rate_hz, num_render_channels, num_capture_channels));
+  }
+}
+
+EchoCanceller3Batch::~EchoCanceller3Batch() = default;
+
+void EchoCanceller3Batch::AnalyzeRender(
+    rtc::ArrayView<AudioBuffer* const> render) {
+  RTC_DCHECK_EQ(sessions_.size(), render.size());
+  for (size_t k = 0; k < sessions_.size(); ++k) {
+    RTC_DCHECK(render[k]);
+    sessions_[k]->AnalyzeRender(render[k]);
+  }
+}
+
+void EchoCanceller3Batch::AnalyzeCapture(
+    rtc::ArrayView<AudioBuffer* const> capture) {
+  RTC_DCHECK_EQ(sessions_.size(), capture.size());
+  for (size_t k = 0; k < sessions_.size(); ++k) {
+    RTC_DCHECK(capture[k]);
+    sessions_[k]->AnalyzeCapture(capture[k]);
+  }
+}
+
+void EchoCanceller3Batch::ProcessCapture(
+    rtc::ArrayView<AudioBuffer* const> capture,
+    const std::vector<bool>& level_change) {
+  RTC_DCHECK_EQ(sessions_.size(), capture.size());
+  RTC_DCHECK_EQ(sessions_.size(), level_change.size());
+  for (size_t k = 0; k < sessions_.size(); ++k) {
+    RTC_DCHECK(capture[k]);
+    sessions_[k]->ProcessCapture(capture[k], level_change[k]);
+  }
+}
+
+}  // namespace webrtc
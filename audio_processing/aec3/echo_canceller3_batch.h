@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_ECHO_CANCELLER3_BATCH_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_ECHO_CANCELLER3_BATCH_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/echo_canceller3.h"
+#include "modules/audio_processing/audio_buffer.h"
+
+namespace webrtc {
+
+// Runs a number of independent echo canceller sessions, e.g., one per
+// participant on a mixing server, with the same configuration and sample rate.
+// Each call processes the 10 ms frames of all the sessions back to back on the
+// calling thread, which avoids the per-session locking and API overhead of
+// running one AudioProcessing instance per session and keeps the AEC3 code hot
+// in the instruction cache. The sessions do not share any adaptive state, so
+// the output of each session is identical to that of a standalone
+// EchoCanceller3.
+//
+// The class is not thread-safe. AnalyzeRender() and ProcessCapture() must be
+// called on the same thread.
+class EchoCanceller3Batch {
+ public:
+  EchoCanceller3Batch(const EchoCanceller3Config& config,
+                      int sample_rate_hz,
+                      size_t num_render_channels,
+                      size_t num_capture_channels,
+                      size_t num_sessions);
+  ~EchoCanceller3Batch();
+  EchoCanceller3Batch(const EchoCanceller3Batch&) = delete;
+  EchoCanceller3Batch& operator=(const EchoCanceller3Batch&) = delete;
+
+  size_t num_sessions() const { return sessions_.size(); }
+
+  // Analyzes and stores internal copies of the split-band domain render
+  // signals. |render| must hold one buffer per session.
+  void AnalyzeRender(rtc::ArrayView<AudioBuffer* const> render);
+
+  // Analyzes the full-band domain capture signals to detect signal saturation.
+  // |capture| must hold one buffer per session.
+  void AnalyzeCapture(rtc::ArrayView<AudioBuffer* const> capture);
+
+  // Removes the echo from the split-band domain capture signals. |capture| must
+  // hold one buffer per session and |level_change| one flag per session.
+  void ProcessCapture(rtc::ArrayView<AudioBuffer* const> capture,
+                      const std::vector<bool>& level_change);
+
+  // Returns the echo canceller of session |index|, e.g., for collecting its
+  // metrics or reporting echo leakage.
+  EchoCanceller3* session(size_t index) { return sessions_[index].get(); }
+
+ private:
+  std::vector<std::unique_ptr<EchoCanceller3>> sessions_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_ECHO_CANCELLER3_BATCH_H_
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/echo_canceller3_batch.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<AudioBuffer> CreateAudioBuffer(int sample_rate_hz) {
+  return std::make_unique<AudioBuffer>(sample_rate_hz, 1, sample_rate_hz, 1,
+                                       sample_rate_hz, 1);
+}
+
+// Fills |buffer| with |samples| and splits it into bands.
+void PopulateAudioBuffer(const std::vector<float>& samples,
+                         AudioBuffer* buffer) {
+  std::copy(samples.begin(), samples.end(), buffer->channels()[0]);
+  if (buffer->num_bands() > 1) {
+    buffer->SplitIntoFrequencyBands();
+  }
+}
+
+}  // namespace
+
+// Verifies that each session of the batch produces the same output as a
+// standalone EchoCanceller3 fed with the same signals.
+TEST(EchoCanceller3Batch, MatchesStandaloneEchoCancellers) {
+  constexpr size_t kNumSessions = 3;
+  constexpr size_t kNumFramesToProcess = 200;
+  for (int rate : {16000, 48000}) {
+    SCOPED_TRACE(rate);
+    const size_t frame_length = rate / 100;
+    EchoCanceller3Batch batch(EchoCanceller3Config(), rate, 1, 1,
+                              kNumSessions);
+    ASSERT_EQ(kNumSessions, batch.num_sessions());
+
+    std::vector<std::unique_ptr<EchoCanceller3>> references;
+    std::vector<std::unique_ptr<AudioBuffer>> render_buffers;
+    std::vector<std::unique_ptr<AudioBuffer>> capture_buffers;
+    std::vector<std::unique_ptr<AudioBuffer>> reference_render_buffers;
+    std::vector<std::unique_ptr<AudioBuffer>> reference_capture_buffers;
+    std::vector<AudioBuffer*> render;
+    std::vector<AudioBuffer*> capture;
+    for (size_t k = 0; k < kNumSessions; ++k) {
+      references.push_back(
+          std::make_unique<EchoCanceller3>(EchoCanceller3Config(), rate, 1, 1));
+      render_buffers.push_back(CreateAudioBuffer(rate));
+      capture_buffers.push_back(CreateAudioBuffer(rate));
+      reference_render_buffers.push_back(CreateAudioBuffer(rate));
+      reference_capture_buffers.push_back(CreateAudioBuffer(rate));
+      render.push_back(render_buffers.back().get());
+      capture.push_back(capture_buffers.back().get());
+    }
+
+    Random random_generator(42U);
+    std::vector<float> render_samples(frame_length);
+    std::vector<float> capture_samples(frame_length);
+    const std::vector<bool> level_change(kNumSessions, false);
+    for (size_t frame_index = 0; frame_index < kNumFramesToProcess;
+         ++frame_index) {
+      for (size_t k = 0; k < kNumSessions; ++k) {
+        RandomizeSampleVector(&random_generator, render_samples);
+        for (size_t j = 0; j < frame_length; ++j) {
+          capture_samples[j] = 0.1f * (k + 1) * render_samples[j];
+        }
+
+        PopulateAudioBuffer(render_samples, render[k]);
+        PopulateAudioBuffer(render_samples, reference_render_buffers[k].get());
+        std::copy(capture_samples.begin(), capture_samples.end(),
+                  capture[k]->channels()[0]);
+        std::copy(capture_samples.begin(), capture_samples.end(),
+                  reference_capture_buffers[k]->channels()[0]);
+      }
+
+      batch.AnalyzeRender(render);
+      batch.AnalyzeCapture(capture);
+      for (size_t k = 0; k < kNumSessions; ++k) {
+        references[k]->AnalyzeRender(reference_render_buffers[k].get());
+        references[k]->AnalyzeCapture(reference_capture_buffers[k].get());
+        if (rate > 16000) {
+          capture[k]->SplitIntoFrequencyBands();
+          reference_capture_buffers[k]->SplitIntoFrequencyBands();
+        }
+      }
+
+      batch.ProcessCapture(capture, level_change);
+      for (size_t k = 0; k < kNumSessions; ++k) {
+        references[k]->ProcessCapture(reference_capture_buffers[k].get(),
+                                      false);
+        const float* output = capture[k]->split_bands_const(0)[0];
+        const float* reference_output =
+            reference_capture_buffers[k]->split_bands_const(0)[0];
+        for (size_t j = 0; j < capture[k]->num_frames_per_band(); ++j) {
+          ASSERT_EQ(reference_output[j], output[j]);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
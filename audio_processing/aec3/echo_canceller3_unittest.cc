@@ -22,10 +22,15 @@
 #include "modules/audio_processing/aec3/mock/mock_block_processor.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/high_pass_filter.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 namespace {
@@ -682,6 +687,126 @@ TEST(EchoCanceller3Messaging, EchoLeakage) {
   }
 }
 
+// Verifies that the echo canceller still removes the echo when the
+// reduced-complexity profile is used.
+TEST(EchoCanceller3, LowComplexityProfileRemovesEcho) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Aec3LowComplexityProfile/Enabled/");
+  constexpr size_t kNumFramesToProcess = 500;
+  constexpr size_t kNumFramesToAnalyze = 100;
+  for (auto rate : {16000, 48000}) {
+    SCOPED_TRACE(ProduceDebugText(rate));
+    const size_t frame_length = rate / 100;
+    const size_t band_length = frame_length / NumBandsForRate(rate);
+    EchoCanceller3 aec3(EchoCanceller3Config(), rate, 1, 1);
+    AudioBuffer capture_buffer(rate, 1, rate, 1, rate, 1);
+    AudioBuffer render_buffer(rate, 1, rate, 1, rate, 1);
+    Random random_generator(42U);
+    std::vector<float> render(frame_length);
+
+    float echo_energy = 0.f;
+    float output_energy = 0.f;
+    for (size_t frame_index = 0; frame_index < kNumFramesToProcess;
+         ++frame_index) {
+      RandomizeSampleVector(&random_generator, render);
+      std::copy(render.begin(), render.end(), render_buffer.channels()[0]);
+      std::transform(render.begin(), render.end(),
+                     capture_buffer.channels()[0],
+                     [](float a) { return 0.5f * a; });
+
+      aec3.AnalyzeCapture(&capture_buffer);
+      capture_buffer.SplitIntoFrequencyBands();
+      render_buffer.SplitIntoFrequencyBands();
+      aec3.AnalyzeRender(&render_buffer);
+
+      const bool analyze =
+          frame_index >= kNumFramesToProcess - kNumFramesToAnalyze;
+      const float* y = capture_buffer.split_bands(0)[0];
+      if (analyze) {
+        for (size_t k = 0; k < band_length; ++k) {
+          echo_energy += y[k] * y[k];
+        }
+      }
+      aec3.ProcessCapture(&capture_buffer, false);
+      if (analyze) {
+        for (size_t k = 0; k < band_length; ++k) {
+          output_energy += y[k] * y[k];
+        }
+      }
+      capture_buffer.MergeFrequencyBands();
+    }
+
+    EXPECT_GT(0.25f * echo_energy, output_energy);
+  }
+}
+
+namespace {
+
+// Returns the average cost in microseconds of EchoCanceller3::ProcessCapture
+// per block for a 48 kHz mono echo canceller using the current field trials.
+double MeasureProcessCaptureCostPerBlockUs() {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kFrameLength = kSampleRateHz / 100;
+  constexpr size_t kNumFramesToProcess = 6000;
+  constexpr float kNumBlocksPerFrame = kNumBlocksPerSecond / 100.f;
+
+  EchoCanceller3 aec3(EchoCanceller3Config(), kSampleRateHz, 1, 1);
+  AudioBuffer capture_buffer(kSampleRateHz, 1, kSampleRateHz, 1, kSampleRateHz,
+                             1);
+  AudioBuffer render_buffer(kSampleRateHz, 1, kSampleRateHz, 1, kSampleRateHz,
+                            1);
+  Random random_generator(42U);
+  std::vector<float> render(kFrameLength);
+
+  int64_t process_capture_ns = 0;
+  for (size_t frame_index = 0; frame_index < kNumFramesToProcess;
+       ++frame_index) {
+    RandomizeSampleVector(&random_generator, render);
+    std::copy(render.begin(), render.end(), render_buffer.channels()[0]);
+    std::transform(render.begin(), render.end(), capture_buffer.channels()[0],
+                   [](float a) { return 0.5f * a; });
+
+    aec3.AnalyzeCapture(&capture_buffer);
+    capture_buffer.SplitIntoFrequencyBands();
+    render_buffer.SplitIntoFrequencyBands();
+    aec3.AnalyzeRender(&render_buffer);
+
+    const int64_t start_ns = rtc::TimeNanos();
+    aec3.ProcessCapture(&capture_buffer, false);
+    process_capture_ns += rtc::TimeNanos() - start_ns;
+  }
+
+  return process_capture_ns /
+         (static_cast<double>(rtc::kNumNanosecsPerMicrosec) *
+          kNumFramesToProcess * kNumBlocksPerFrame);
+}
+
+}  // namespace
+
+// Measures the average cost of EchoCanceller3::ProcessCapture per block with
+// the Ooura and the Pffft backends of Aec3Fft.
+TEST(EchoCanceller3, DISABLED_ProcessCaptureCostPerFftBackend) {
+  for (bool use_pffft : {false, true}) {
+    test::ScopedFieldTrials field_trials(
+        use_pffft ? "WebRTC-Aec3UsePffft/Enabled/" : "");
+    test::PrintResult("aec3_process_capture", "_48000Hz",
+                      use_pffft ? "pffft" : "ooura",
+                      MeasureProcessCaptureCostPerBlockUs(), "us", false);
+  }
+}
+
+// Measures the average cost of EchoCanceller3::ProcessCapture per block with
+// the default and the reduced-complexity profiles.
+TEST(EchoCanceller3, DISABLED_ProcessCaptureCostPerProfile) {
+  for (bool low_complexity : {false, true}) {
+    test::ScopedFieldTrials field_trials(
+        low_complexity ? "WebRTC-Aec3LowComplexityProfile/Enabled/" : "");
+    test::PrintResult("aec3_process_capture", "_48000Hz",
+                      low_complexity ? "low_complexity" : "default",
+                      MeasureProcessCaptureCostPerBlockUs(), "us", false);
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 TEST(EchoCanceller3InputCheck, WrongCaptureNumBandsCheckVerification) {
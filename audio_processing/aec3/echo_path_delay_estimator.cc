@@ -9,6 +9,7 @@
  */
 #include "modules/audio_processing/aec3/echo_path_delay_estimator.h"
 
+#include <algorithm>
 #include <array>
 
 #include "api/audio/echo_canceller3_config.h"
@@ -16,9 +17,33 @@
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
+namespace {
+
+// Number of blocks with an unchanged refined delay estimate before the search
+// is narrowed to the matched filters covering that delay.
+constexpr size_t kNumBlocksBeforeNarrowSearch = kNumBlocksPerSecond;
+
+// Number of consecutive blocks where the narrowed search does not produce any
+// reliable lag estimate for an excited render signal before the full search is
+// resumed.
+constexpr size_t kNumBlocksBeforeLostLag = kNumBlocksPerSecond / 4;
+
+// The full search is run during the first |kFullSearchDurationBlocks| of every
+// |kFullSearchIntervalBlocks| blocks to detect delay changes outside of the
+// narrowed search range.
+constexpr size_t kFullSearchIntervalBlocks = 4 * kNumBlocksPerSecond;
+constexpr size_t kFullSearchDurationBlocks = kNumBlocksPerSecond / 2;
+
+bool UseAdaptiveSearch() {
+  return !field_trial::IsEnabled("WebRTC-Aec3AdaptiveDelaySearchKillSwitch");
+}
+
+}  // namespace
+
 EchoPathDelayEstimator::EchoPathDelayEstimator(
     ApmDataDumper* data_dumper,
     const EchoCanceller3Config& config)
@@ -43,7 +68,8 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
       matched_filter_lag_aggregator_(data_dumper_,
                                      matched_filter_.GetMaxFilterLag(),
                                      config.delay.delay_selection_thresholds),
-      downmix_(config.delay.downmix_before_delay_estimation) {
+      downmix_(config.delay.downmix_before_delay_estimation),
+      adaptive_search_(UseAdaptiveSearch()) {
   RTC_DCHECK(data_dumper);
   RTC_DCHECK(down_sampling_factor_ > 0);
 }
@@ -66,12 +92,58 @@ absl::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   data_dumper_->DumpWav("aec3_capture_decimator_output",
                         downsampled_capture.size(), downsampled_capture.data(),
                         16000 / down_sampling_factor_, 1);
-  matched_filter_.Update(render_buffer, downsampled_capture);
+
+  // Narrow the search to the matched filters covering the stable delay, unless
+  // a periodic full search is ongoing or the delay may be drifting.
+  size_t first_filter = 0;
+  size_t num_filters = matched_filter_.NumFilters();
+  const bool full_search = search_block_counter_ < kFullSearchDurationBlocks;
+  search_block_counter_ =
+      (search_block_counter_ + 1) % kFullSearchIntervalBlocks;
+  if (adaptive_search_ && !full_search &&
+      stable_lag_counter_ >= kNumBlocksBeforeNarrowSearch &&
+      clockdrift_detector_.ClockdriftLevel() ==
+          ClockdriftDetector::Level::kNone) {
+    RTC_DCHECK(stable_lag_);
+    matched_filter_.GetFiltersCoveringLag(*stable_lag_, &first_filter,
+                                          &num_filters);
+  }
+  matched_filter_.Update(render_buffer, downsampled_capture, first_filter,
+                         num_filters);
+
+  if (num_filters < matched_filter_.NumFilters()) {
+    bool excited = false;
+    bool reliable = false;
+    for (const auto& lag_estimate : matched_filter_.GetLagEstimates()) {
+      excited = excited || lag_estimate.updated;
+      reliable = reliable || (lag_estimate.updated && lag_estimate.reliable);
+    }
+    if (reliable) {
+      lost_lag_counter_ = 0;
+    } else if (excited && ++lost_lag_counter_ >= kNumBlocksBeforeLostLag) {
+      stable_lag_ = absl::nullopt;
+      stable_lag_counter_ = 0;
+      lost_lag_counter_ = 0;
+    }
+  }
 
   absl::optional<DelayEstimate> aggregated_matched_filter_lag =
       matched_filter_lag_aggregator_.Aggregate(
           matched_filter_.GetLagEstimates());
 
+  // Track for how long the refined delay estimate has been unchanged.
+  if (aggregated_matched_filter_lag) {
+    if (aggregated_matched_filter_lag->quality ==
+            DelayEstimate::Quality::kRefined &&
+        stable_lag_ && *stable_lag_ == aggregated_matched_filter_lag->delay) {
+      stable_lag_counter_ =
+          std::min(stable_lag_counter_ + 1, kNumBlocksBeforeNarrowSearch);
+    } else {
+      stable_lag_ = aggregated_matched_filter_lag->delay;
+      stable_lag_counter_ = 0;
+    }
+  }
+
   // Run clockdrift detection.
   if (aggregated_matched_filter_lag &&
       (*aggregated_matched_filter_lag).quality ==
@@ -112,6 +184,11 @@ void EchoPathDelayEstimator::Reset(bool reset_lag_aggregator,
                                    bool reset_delay_confidence) {
   if (reset_lag_aggregator) {
     matched_filter_lag_aggregator_.Reset(reset_delay_confidence);
+    // Restart with a full search.
+    stable_lag_ = absl::nullopt;
+    stable_lag_counter_ = 0;
+    lost_lag_counter_ = 0;
+    search_block_counter_ = 0;
   }
   matched_filter_.Reset();
   old_aggregated_lag_ = absl::nullopt;
@@ -28,7 +28,10 @@ class ApmDataDumper;
 struct DownsampledRenderBuffer;
 struct EchoCanceller3Config;
 
-// Estimates the delay of the echo path.
+// Estimates the delay of the echo path. Once the delay estimate has been
+// stable for a while, only the matched filters covering that delay are updated.
+// The full search over all the filters is resumed when those filters lose track
+// of the delay, after a reset, and periodically to detect new echo paths.
 class EchoPathDelayEstimator {
  public:
   EchoPathDelayEstimator(ApmDataDumper* data_dumper,
@@ -66,6 +69,11 @@ class EchoPathDelayEstimator {
   size_t consistent_estimate_counter_ = 0;
   ClockdriftDetector clockdrift_detector_;
   bool downmix_;
+  const bool adaptive_search_;
+  absl::optional<size_t> stable_lag_;
+  size_t stable_lag_counter_ = 0;
+  size_t lost_lag_counter_ = 0;
+  size_t search_block_counter_ = 0;
 
   // Internal reset method with more granularity.
   void Reset(bool reset_lag_aggregator, bool reset_delay_confidence);
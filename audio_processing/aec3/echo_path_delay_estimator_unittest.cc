@@ -114,6 +114,71 @@ TEST(EchoPathDelayEstimator, DelayEstimation) {
   }
 }
 
+// Verifies that a delay change is detected after the search has been narrowed
+// around a stable delay, both through the periodic full search and directly
+// after a reset.
+TEST(EchoPathDelayEstimator, DelayChangeDetectionAfterStableDelay) {
+  constexpr size_t kNumChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  constexpr size_t kInitialDelaySamples = 150;
+  constexpr size_t kNewDelaySamples = 2000;
+
+  Random random_generator(42U);
+  std::vector<std::vector<std::vector<float>>> render(
+      kNumBands, std::vector<std::vector<float>>(
+                     kNumChannels, std::vector<float>(kBlockSize)));
+  std::vector<std::vector<float>> capture(1, std::vector<float>(kBlockSize));
+  ApmDataDumper data_dumper(0);
+  EchoCanceller3Config config;
+
+  for (bool reset_on_delay_change : {false, true}) {
+    SCOPED_TRACE(reset_on_delay_change ? "Reset" : "No reset");
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+    EchoPathDelayEstimator estimator(&data_dumper, config);
+
+    auto run_estimator = [&](DelayBuffer<float>* signal_delay_buffer,
+                             size_t num_blocks) {
+      absl::optional<DelayEstimate> estimated_delay_samples;
+      for (size_t k = 0; k < num_blocks; ++k) {
+        RandomizeSampleVector(&random_generator, render[0][0]);
+        signal_delay_buffer->Delay(render[0][0], capture[0]);
+        render_delay_buffer->Insert(render);
+        render_delay_buffer->PrepareCaptureProcessing();
+        auto estimate = estimator.EstimateDelay(
+            render_delay_buffer->GetDownsampledRenderBuffer(), capture);
+        if (estimate) {
+          estimated_delay_samples = estimate;
+        }
+      }
+      return estimated_delay_samples;
+    };
+
+    render_delay_buffer->Reset();
+    DelayBuffer<float> initial_delay_buffer(kInitialDelaySamples);
+    auto estimate = run_estimator(&initial_delay_buffer,
+                                  3 * kNumBlocksPerSecond);
+    ASSERT_TRUE(estimate);
+    EXPECT_NEAR(kInitialDelaySamples / config.delay.down_sampling_factor,
+                estimate->delay / config.delay.down_sampling_factor, 1);
+
+    if (reset_on_delay_change) {
+      estimator.Reset(true);
+    }
+
+    // A delay change outside of the narrowed search range is detected both
+    // with and without a reset of the estimator.
+    DelayBuffer<float> new_delay_buffer(kNewDelaySamples);
+    estimate = run_estimator(&new_delay_buffer, reset_on_delay_change
+                                                    ? 2 * kNumBlocksPerSecond
+                                                    : 5 * kNumBlocksPerSecond);
+    ASSERT_TRUE(estimate);
+    EXPECT_NEAR(kNewDelaySamples / config.delay.down_sampling_factor,
+                estimate->delay / config.delay.down_sampling_factor, 1);
+  }
+}
+
 // Verifies that the delay estimator does not produce delay estimates for render
 // signals of low level.
 TEST(EchoPathDelayEstimator, NoDelayEstimatesForLowLevelRenderSignals) {
@@ -10,6 +10,7 @@
 
 #include "modules/audio_processing/aec3/fft_data.h"
 
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
@@ -39,6 +40,30 @@ TEST(FftData, TestOptimizations) {
     EXPECT_EQ(spectrum, spectrum_sse2);
   }
 }
+
+// Verifies that the AVX2 spectrum computation matches the SSE2 one. All the
+// values are exactly representable, so the fused multiply-add does not change
+// the result.
+TEST(FftData, TestAvx2Optimizations) {
+  if (GetCpuSupportsAvx2()) {
+    FftData x;
+
+    for (size_t k = 0; k < x.re.size(); ++k) {
+      x.re[k] = k + 1;
+    }
+
+    x.im[0] = x.im[x.im.size() - 1] = 0.f;
+    for (size_t k = 1; k < x.im.size() - 1; ++k) {
+      x.im[k] = 2.f * (k + 1);
+    }
+
+    std::array<float, kFftLengthBy2Plus1> spectrum_sse2;
+    std::array<float, kFftLengthBy2Plus1> spectrum_avx2;
+    x.Spectrum(Aec3Optimization::kSse2, spectrum_sse2);
+    x.Spectrum(Aec3Optimization::kAvx2, spectrum_avx2);
+    EXPECT_EQ(spectrum_sse2, spectrum_avx2);
+  }
+}
 #endif
 
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
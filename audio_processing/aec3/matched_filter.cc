@@ -341,15 +341,32 @@ void MatchedFilter::Reset() {
 
 void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
                            rtc::ArrayView<const float> capture) {
+  Update(render_buffer, capture, 0, filters_.size());
+}
+
+void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
+                           rtc::ArrayView<const float> capture,
+                           size_t first_filter,
+                           size_t num_filters) {
   RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  RTC_DCHECK_LT(0, num_filters);
+  RTC_DCHECK_LE(first_filter + num_filters, filters_.size());
   auto& y = capture;
+  const size_t end_filter = first_filter + num_filters;
+
+  // Flag the filters that are not applied as not updated.
+  for (size_t n = 0; n < filters_.size(); ++n) {
+    if (n < first_filter || n >= end_filter) {
+      lag_estimates_[n].updated = false;
+    }
+  }
 
   const float x2_sum_threshold =
       filters_[0].size() * excitation_limit_ * excitation_limit_;
 
-  // Apply all matched filters.
-  size_t alignment_shift = 0;
-  for (size_t n = 0; n < filters_.size(); ++n) {
+  // Apply the selected matched filters.
+  size_t alignment_shift = first_filter * filter_intra_lag_shift_;
+  for (size_t n = first_filter; n < end_filter; ++n) {
     float error_sum = 0.f;
     bool filters_updated = false;
 
@@ -364,6 +381,11 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
                                      smoothing_, render_buffer.buffer, y,
                                      filters_[n], &filters_updated, &error_sum);
         break;
+      case Aec3Optimization::kAvx2:
+        aec3::MatchedFilterCore_AVX2(x_start_index, x2_sum_threshold,
+                                     smoothing_, render_buffer.buffer, y,
+                                     filters_[n], &filters_updated, &error_sum);
+        break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
       case Aec3Optimization::kNeon:
@@ -438,6 +460,33 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
   }
 }
 
+bool MatchedFilter::GetFiltersCoveringLag(size_t lag,
+                                          size_t* first_filter,
+                                          size_t* num_filters) const {
+  RTC_DCHECK(first_filter);
+  RTC_DCHECK(num_filters);
+  // The lag estimate of a filter is only deemed reliable when the peak is at
+  // least 3 taps from the start and 10 taps from the end of the filter, see
+  // Update().
+  size_t num_covering_filters = 0;
+  size_t alignment_shift = 0;
+  for (size_t n = 0; n < filters_.size(); ++n) {
+    if (lag > alignment_shift + 2 &&
+        lag + 10 < alignment_shift + filters_[n].size()) {
+      if (num_covering_filters == 0) {
+        *first_filter = n;
+      }
+      ++num_covering_filters;
+    }
+    alignment_shift += filter_intra_lag_shift_;
+  }
+  if (num_covering_filters == 0) {
+    return false;
+  }
+  *num_filters = num_covering_filters;
+  return true;
+}
+
 void MatchedFilter::LogFilterProperties(int sample_rate_hz,
                                         size_t shift,
                                         size_t downsampling_factor) const {
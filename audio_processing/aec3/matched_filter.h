@@ -53,6 +53,16 @@ void MatchedFilterCore_SSE2(size_t x_start_index,
                             bool* filters_updated,
                             float* error_sum);
 
+// Filter core for the matched filter that is optimized for AVX2.
+void MatchedFilterCore_AVX2(size_t x_start_index,
+                            float x2_sum_threshold,
+                            float smoothing,
+                            rtc::ArrayView<const float> x,
+                            rtc::ArrayView<const float> y,
+                            rtc::ArrayView<float> h,
+                            bool* filters_updated,
+                            float* error_sum);
+
 #endif
 
 // Filter core for the matched filter.
@@ -100,6 +110,20 @@ class MatchedFilter {
   void Update(const DownsampledRenderBuffer& render_buffer,
               rtc::ArrayView<const float> capture);
 
+  // Updates the correlation for the |num_filters| matched filters starting at
+  // |first_filter| only. The lag estimates of the other filters are flagged as
+  // not updated.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              rtc::ArrayView<const float> capture,
+              size_t first_filter,
+              size_t num_filters);
+
+  // Identifies the range of matched filters that are able to produce a
+  // reliable estimate of |lag|. Returns false if no filter can do that.
+  bool GetFiltersCoveringLag(size_t lag,
+                             size_t* first_filter,
+                             size_t* num_filters) const;
+
   // Resets the matched filter.
   void Reset();
 
@@ -108,6 +132,9 @@ class MatchedFilter {
     return lag_estimates_;
   }
 
+  // Returns the number of matched filters.
+  size_t NumFilters() const { return filters_.size(); }
+
   // Returns the maximum filter lag.
   size_t GetMaxFilterLag() const {
     return filters_.size() * filter_intra_lag_shift_ + filters_[0].size();
@@ -24,6 +24,7 @@
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
@@ -133,6 +134,49 @@ TEST(MatchedFilter, TestSse2Optimizations) {
   }
 }
 
+// Verifies that the optimized methods for AVX2 are bitexact to their SSE2
+// counterparts, up to the rounding differences of the fused multiply-adds.
+TEST(MatchedFilter, TestAvx2Optimizations) {
+  if (GetCpuSupportsAvx2()) {
+    Random random_generator(42U);
+    constexpr float kSmoothing = 0.7f;
+    for (auto down_sampling_factor : kDownSamplingFactors) {
+      const size_t sub_block_size = kBlockSize / down_sampling_factor;
+      std::vector<float> x(2000);
+      RandomizeSampleVector(&random_generator, x);
+      std::vector<float> y(sub_block_size);
+      std::vector<float> h_AVX2(512);
+      std::vector<float> h_SSE2(512);
+      int x_index = 0;
+      for (int k = 0; k < 1000; ++k) {
+        RandomizeSampleVector(&random_generator, y);
+
+        bool filters_updated_SSE2 = false;
+        float error_sum_SSE2 = 0.f;
+        bool filters_updated_AVX2 = false;
+        float error_sum_AVX2 = 0.f;
+
+        MatchedFilterCore_AVX2(x_index, h_AVX2.size() * 150.f * 150.f,
+                               kSmoothing, x, y, h_AVX2, &filters_updated_AVX2,
+                               &error_sum_AVX2);
+
+        MatchedFilterCore_SSE2(x_index, h_SSE2.size() * 150.f * 150.f,
+                               kSmoothing, x, y, h_SSE2, &filters_updated_SSE2,
+                               &error_sum_SSE2);
+
+        EXPECT_EQ(filters_updated_SSE2, filters_updated_AVX2);
+        EXPECT_NEAR(error_sum_SSE2, error_sum_AVX2, error_sum_SSE2 / 100000.f);
+
+        for (size_t j = 0; j < h_SSE2.size(); ++j) {
+          EXPECT_NEAR(h_SSE2[j], h_AVX2[j], 0.00001f);
+        }
+
+        x_index = (x_index + sub_block_size) % x.size();
+      }
+    }
+  }
+}
+
 #endif
 
 // Verifies that the matched filter produces proper lag estimates for
@@ -372,6 +416,86 @@ TEST(MatchedFilter, NumberOfLagEstimates) {
   }
 }
 
+// Verifies that the filters able to reliably estimate a lag are identified.
+TEST(MatchedFilter, FiltersCoveringLag) {
+  ApmDataDumper data_dumper(0);
+  EchoCanceller3Config config;
+  constexpr size_t kSubBlockSize = 16;
+  MatchedFilter filter(&data_dumper, DetectOptimization(), kSubBlockSize,
+                       kWindowSizeSubBlocks, kNumMatchedFilters,
+                       kAlignmentShiftSubBlocks, 150,
+                       config.delay.delay_estimate_smoothing,
+                       config.delay.delay_candidate_detection_threshold);
+  constexpr size_t kFilterLength = kWindowSizeSubBlocks * kSubBlockSize;
+  constexpr size_t kFilterShift = kAlignmentShiftSubBlocks * kSubBlockSize;
+
+  size_t first_filter = 0;
+  size_t num_filters = 0;
+  ASSERT_TRUE(filter.GetFiltersCoveringLag(100, &first_filter, &num_filters));
+  EXPECT_EQ(0u, first_filter);
+  EXPECT_EQ(1u, num_filters);
+
+  // Lag in the overlap between the first two filters.
+  ASSERT_TRUE(filter.GetFiltersCoveringLag(kFilterShift + 50, &first_filter,
+                                           &num_filters));
+  EXPECT_EQ(0u, first_filter);
+  EXPECT_EQ(2u, num_filters);
+
+  ASSERT_TRUE(filter.GetFiltersCoveringLag(3 * kFilterShift + 200,
+                                           &first_filter, &num_filters));
+  EXPECT_EQ(3u, first_filter);
+  EXPECT_EQ(1u, num_filters);
+
+  // Lag beyond the last filter.
+  EXPECT_FALSE(filter.GetFiltersCoveringLag(
+      (kNumMatchedFilters - 1) * kFilterShift + kFilterLength, &first_filter,
+      &num_filters));
+}
+
+// Verifies that only the selected filters are updated when updating a subset of
+// the matched filters.
+TEST(MatchedFilter, UpdateOfFilterSubset) {
+  Random random_generator(42U);
+  constexpr size_t kNumChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  constexpr size_t kFirstFilter = 2;
+  constexpr size_t kNumUpdatedFilters = 3;
+
+  ApmDataDumper data_dumper(0);
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = kDownSamplingFactor;
+  config.delay.num_filters = kNumMatchedFilters;
+  MatchedFilter filter(&data_dumper, DetectOptimization(), kSubBlockSize,
+                       kWindowSizeSubBlocks, kNumMatchedFilters,
+                       kAlignmentShiftSubBlocks, 150,
+                       config.delay.delay_estimate_smoothing,
+                       config.delay.delay_candidate_detection_threshold);
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+  std::vector<std::vector<std::vector<float>>> render(
+      kNumBands, std::vector<std::vector<float>>(
+                     kNumChannels, std::vector<float>(kBlockSize, 0.f)));
+  std::array<float, kSubBlockSize> capture;
+
+  for (size_t k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator, render[0][0]);
+    RandomizeSampleVector(&random_generator, capture);
+    render_delay_buffer->Insert(render);
+    render_delay_buffer->PrepareCaptureProcessing();
+    filter.Update(render_delay_buffer->GetDownsampledRenderBuffer(), capture,
+                  kFirstFilter, kNumUpdatedFilters);
+  }
+
+  auto lag_estimates = filter.GetLagEstimates();
+  for (size_t n = 0; n < kNumMatchedFilters; ++n) {
+    EXPECT_EQ(n >= kFirstFilter && n < kFirstFilter + kNumUpdatedFilters,
+              lag_estimates[n].updated);
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 // Verifies the check for non-zero windows size.
@@ -19,11 +19,27 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
 namespace {
 
+// Maximum number of capture channels that are processed serially, and maximum
+// number of channel groups that are processed in parallel.
+constexpr size_t kMaxNumSerialCaptureChannels = 4;
+constexpr size_t kMaxNumChannelGroups = 4;
+
+size_t NumChannelGroups(size_t num_capture_channels) {
+  if (num_capture_channels <= kMaxNumSerialCaptureChannels ||
+      field_trial::IsEnabled("WebRTC-Aec3ParallelSubtractorKillSwitch")) {
+    return 1;
+  }
+  // Use at least two channels per group to amortize the thread handoff. The
+  // runner further limits the number of groups to the number of cores.
+  return std::min(kMaxNumChannelGroups, (num_capture_channels + 1) / 2);
+}
+
 void PredictionError(const Aec3Fft& fft,
                      const FftData& S,
                      rtc::ArrayView<const float> y,
@@ -83,7 +99,8 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
           std::vector<float>(GetTimeDomainLength(std::max(
                                  config_.filter.main_initial.length_blocks,
                                  config_.filter.main.length_blocks)),
-                             0.f)) {
+                             0.f)),
+      channel_group_runner_(NumChannelGroups(num_capture_channels_)) {
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     main_filter_[ch] = std::make_unique<AdaptiveFirFilter>(
         config_.filter.main.length_blocks,
@@ -110,6 +127,10 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
       H2_k.fill(0.f);
     }
   }
+
+  for (size_t group = 1; group < channel_group_runner_.num_groups(); ++group) {
+    channel_group_ffts_.push_back(std::make_unique<Aec3Fft>());
+  }
 }
 
 Subtractor::~Subtractor() = default;
@@ -180,104 +201,127 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_shadow);
   }
 
-  // Process all capture channels
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
-    RTC_DCHECK_EQ(kBlockSize, capture[ch].size());
-    SubtractorOutput& output = outputs[ch];
-    rtc::ArrayView<const float> y = capture[ch];
-    FftData& E_main = output.E_main;
-    FftData E_shadow;
-    std::array<float, kBlockSize>& e_main = output.e_main;
-    std::array<float, kBlockSize>& e_shadow = output.e_shadow;
-
-    FftData S;
-    FftData& G = S;
-
-    // Form the outputs of the main and shadow filters.
-    main_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_main, &output.s_main);
-
-    shadow_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_shadow, &output.s_shadow);
-
-    // Compute the signal powers in the subtractor output.
-    output.ComputeMetrics(y);
-
-    // Adjust the filter if needed.
-    bool main_filter_adjusted = false;
-    filter_misadjustment_estimator_[ch].Update(output);
-    if (filter_misadjustment_estimator_[ch].IsAdjustmentNeeded()) {
-      float scale = filter_misadjustment_estimator_[ch].GetMisadjustment();
-      main_filter_[ch]->ScaleFilter(scale);
-      for (auto& h_k : main_impulse_response_[ch]) {
-        h_k *= scale;
-      }
-      ScaleFilterOutput(y, scale, e_main, output.s_main);
-      filter_misadjustment_estimator_[ch].Reset();
-      main_filter_adjusted = true;
+  // Process all capture channels, with each channel group processing a
+  // contiguous range of channels. Channel 0, whose data is dumped, is always
+  // processed on the calling thread. Running one task per group makes each
+  // group's Aec3Fft be used by a single thread.
+  const size_t num_channel_groups = channel_group_runner_.num_groups();
+  channel_group_runner_.Run(num_channel_groups, [&](size_t group) {
+    const Aec3Fft& fft = group == 0 ? fft_ : *channel_group_ffts_[group - 1];
+    const size_t ch_begin = group * num_capture_channels_ / num_channel_groups;
+    const size_t ch_end =
+        (group + 1) * num_capture_channels_ / num_channel_groups;
+    for (size_t ch = ch_begin; ch < ch_end; ++ch) {
+      ProcessChannel(ch, fft, render_buffer, capture[ch], X2_main, X2_shadow,
+                     render_signal_analyzer, aec_state, &outputs[ch]);
     }
+  });
+}
 
-    // Compute the FFts of the main and shadow filter outputs.
-    fft_.ZeroPaddedFft(e_main, Aec3Fft::Window::kHanning, &E_main);
-    fft_.ZeroPaddedFft(e_shadow, Aec3Fft::Window::kHanning, &E_shadow);
-
-    // Compute spectra for future use.
-    E_shadow.Spectrum(optimization_, output.E2_shadow);
-    E_main.Spectrum(optimization_, output.E2_main);
-
-    // Update the main filter.
-    if (!main_filter_adjusted) {
-      std::array<float, kFftLengthBy2Plus1> erl;
-      ComputeErl(optimization_, main_frequency_response_[ch], erl);
-      G_main_[ch]->Compute(X2_main, render_signal_analyzer, output, erl,
-                           main_filter_[ch]->SizePartitions(),
-                           aec_state.SaturatedCapture(), &G);
-    } else {
-      G.re.fill(0.f);
-      G.im.fill(0.f);
+void Subtractor::ProcessChannel(
+    size_t ch,
+    const Aec3Fft& fft,
+    const RenderBuffer& render_buffer,
+    rtc::ArrayView<const float> y,
+    const std::array<float, kFftLengthBy2Plus1>& X2_main,
+    const std::array<float, kFftLengthBy2Plus1>& X2_shadow,
+    const RenderSignalAnalyzer& render_signal_analyzer,
+    const AecState& aec_state,
+    SubtractorOutput* output_ptr) {
+  RTC_DCHECK_EQ(kBlockSize, y.size());
+  SubtractorOutput& output = *output_ptr;
+  FftData& E_main = output.E_main;
+  FftData E_shadow;
+  std::array<float, kBlockSize>& e_main = output.e_main;
+  std::array<float, kBlockSize>& e_shadow = output.e_shadow;
+
+  FftData S;
+  FftData& G = S;
+
+  // Form the outputs of the main and shadow filters.
+  main_filter_[ch]->Filter(render_buffer, &S);
+  PredictionError(fft, S, y, &e_main, &output.s_main);
+
+  shadow_filter_[ch]->Filter(render_buffer, &S);
+  PredictionError(fft, S, y, &e_shadow, &output.s_shadow);
+
+  // Compute the signal powers in the subtractor output.
+  output.ComputeMetrics(y);
+
+  // Adjust the filter if needed.
+  bool main_filter_adjusted = false;
+  filter_misadjustment_estimator_[ch].Update(output);
+  if (filter_misadjustment_estimator_[ch].IsAdjustmentNeeded()) {
+    float scale = filter_misadjustment_estimator_[ch].GetMisadjustment();
+    main_filter_[ch]->ScaleFilter(scale);
+    for (auto& h_k : main_impulse_response_[ch]) {
+      h_k *= scale;
     }
-    main_filter_[ch]->Adapt(render_buffer, G, &main_impulse_response_[ch]);
-    main_filter_[ch]->ComputeFrequencyResponse(&main_frequency_response_[ch]);
+    ScaleFilterOutput(y, scale, e_main, output.s_main);
+    filter_misadjustment_estimator_[ch].Reset();
+    main_filter_adjusted = true;
+  }
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_main", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_main", G.im);
-    }
+  // Compute the FFts of the main and shadow filter outputs.
+  fft.ZeroPaddedFft(e_main, Aec3Fft::Window::kHanning, &E_main);
+  fft.ZeroPaddedFft(e_shadow, Aec3Fft::Window::kHanning, &E_shadow);
+
+  // Compute spectra for future use.
+  E_shadow.Spectrum(optimization_, output.E2_shadow);
+  E_main.Spectrum(optimization_, output.E2_main);
+
+  // Update the main filter.
+  if (!main_filter_adjusted) {
+    std::array<float, kFftLengthBy2Plus1> erl;
+    ComputeErl(optimization_, main_frequency_response_[ch], erl);
+    G_main_[ch]->Compute(X2_main, render_signal_analyzer, output, erl,
+                         main_filter_[ch]->SizePartitions(),
+                         aec_state.SaturatedCapture(), &G);
+  } else {
+    G.re.fill(0.f);
+    G.im.fill(0.f);
+  }
+  main_filter_[ch]->Adapt(render_buffer, G, &main_impulse_response_[ch]);
+  main_filter_[ch]->ComputeFrequencyResponse(&main_frequency_response_[ch]);
 
-    // Update the shadow filter.
-    poor_shadow_filter_counter_[ch] = output.e2_main < output.e2_shadow
-                                          ? poor_shadow_filter_counter_[ch] + 1
-                                          : 0;
-    if (poor_shadow_filter_counter_[ch] < 5) {
-      G_shadow_[ch]->Compute(X2_shadow, render_signal_analyzer, E_shadow,
-                             shadow_filter_[ch]->SizePartitions(),
-                             aec_state.SaturatedCapture(), &G);
-    } else {
-      poor_shadow_filter_counter_[ch] = 0;
-      shadow_filter_[ch]->SetFilter(main_filter_[ch]->SizePartitions(),
-                                    main_filter_[ch]->GetFilter());
-      G_shadow_[ch]->Compute(X2_shadow, render_signal_analyzer, E_main,
-                             shadow_filter_[ch]->SizePartitions(),
-                             aec_state.SaturatedCapture(), &G);
-    }
+  if (ch == 0) {
+    data_dumper_->DumpRaw("aec3_subtractor_G_main", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_main", G.im);
+  }
 
-    shadow_filter_[ch]->Adapt(render_buffer, G);
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.im);
-      filter_misadjustment_estimator_[ch].Dump(data_dumper_);
-      DumpFilters();
-    }
+  // Update the shadow filter.
+  poor_shadow_filter_counter_[ch] = output.e2_main < output.e2_shadow
+                                        ? poor_shadow_filter_counter_[ch] + 1
+                                        : 0;
+  if (poor_shadow_filter_counter_[ch] < 5) {
+    G_shadow_[ch]->Compute(X2_shadow, render_signal_analyzer, E_shadow,
+                           shadow_filter_[ch]->SizePartitions(),
+                           aec_state.SaturatedCapture(), &G);
+  } else {
+    poor_shadow_filter_counter_[ch] = 0;
+    shadow_filter_[ch]->SetFilter(main_filter_[ch]->SizePartitions(),
+                                  main_filter_[ch]->GetFilter());
+    G_shadow_[ch]->Compute(X2_shadow, render_signal_analyzer, E_main,
+                           shadow_filter_[ch]->SizePartitions(),
+                           aec_state.SaturatedCapture(), &G);
+  }
 
-    std::for_each(e_main.begin(), e_main.end(),
-                  [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+  shadow_filter_[ch]->Adapt(render_buffer, G);
+  if (ch == 0) {
+    data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.re);
+    data_dumper_->DumpRaw("aec3_subtractor_G_shadow", G.im);
+    filter_misadjustment_estimator_[ch].Dump(data_dumper_);
+    DumpFilters();
+  }
 
-    if (ch == 0) {
-      data_dumper_->DumpWav("aec3_main_filter_output", kBlockSize, &e_main[0],
-                            16000, 1);
-      data_dumper_->DumpWav("aec3_shadow_filter_output", kBlockSize,
-                            &e_shadow[0], 16000, 1);
-    }
+  std::for_each(e_main.begin(), e_main.end(),
+                [](float& a) { a = rtc::SafeClamp(a, -32768.f, 32767.f); });
+
+  if (ch == 0) {
+    data_dumper_->DumpWav("aec3_main_filter_output", kBlockSize, &e_main[0],
+                          16000, 1);
+    data_dumper_->DumpWav("aec3_shadow_filter_output", kBlockSize,
+                          &e_shadow[0], 16000, 1);
   }
 }
 
@@ -15,6 +15,7 @@
 #include <stddef.h>
 
 #include <array>
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
@@ -30,11 +31,14 @@
 #include "modules/audio_processing/aec3/shadow_filter_update_gain.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/utility/channel_group_runner.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-// Proves linear echo cancellation functionality
+// Proves linear echo cancellation functionality. With more than four capture
+// channels, the channels are split into groups that are processed in parallel
+// on worker threads. The output is the same as with serial processing.
 class Subtractor {
  public:
   Subtractor(const EchoCanceller3Config& config,
@@ -114,6 +118,18 @@ class Subtractor {
     int overhang_ = 0.f;
   };
 
+  // Performs the echo subtraction for capture channel |ch|, using |fft| which
+  // must not be used concurrently by another channel group.
+  void ProcessChannel(size_t ch,
+                      const Aec3Fft& fft,
+                      const RenderBuffer& render_buffer,
+                      rtc::ArrayView<const float> y,
+                      const std::array<float, kFftLengthBy2Plus1>& X2_main,
+                      const std::array<float, kFftLengthBy2Plus1>& X2_shadow,
+                      const RenderSignalAnalyzer& render_signal_analyzer,
+                      const AecState& aec_state,
+                      SubtractorOutput* output);
+
   const Aec3Fft fft_;
   ApmDataDumper* data_dumper_;
   const Aec3Optimization optimization_;
@@ -129,6 +145,11 @@ class Subtractor {
   std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>
       main_frequency_response_;
   std::vector<std::vector<float>> main_impulse_response_;
+
+  // Channel group 0 is processed on the calling thread using |fft_|, the other
+  // groups on the runner's workers using their own Aec3Fft.
+  ChannelGroupRunner channel_group_runner_;
+  std::vector<std::unique_ptr<Aec3Fft>> channel_group_ffts_;
 };
 
 }  // namespace webrtc
@@ -21,6 +21,7 @@
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -308,4 +309,23 @@ TEST(Subtractor, NonConvergenceOnUncorrelatedSignalsMultiChannel) {
   }
 }
 
+// Verifies that processing many capture channels in parallel gives the same
+// result as processing them serially.
+TEST(Subtractor, ParallelCaptureChannelProcessingIsBitExact) {
+  std::vector<int> blocks_with_echo_path_changes = {100};
+  for (size_t num_capture_channels : {5, 8}) {
+    SCOPED_TRACE(ProduceDebugText(2, num_capture_channels, 64, 20));
+    std::vector<float> parallel_powers = RunSubtractorTest(
+        2, num_capture_channels, 500, 64, 20, 20, false,
+        blocks_with_echo_path_changes);
+
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-Aec3ParallelSubtractorKillSwitch/Enabled/");
+    std::vector<float> serial_powers = RunSubtractorTest(
+        2, num_capture_channels, 500, 64, 20, 20, false,
+        blocks_with_echo_path_changes);
+    EXPECT_EQ(serial_powers, parallel_powers);
+  }
+}
+
 }  // namespace webrtc
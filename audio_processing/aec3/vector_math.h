@@ -40,9 +40,13 @@ class VectorMath {
       : optimization_(optimization) {}
 
   // Elementwise square root.
+  void SqrtAVX2(rtc::ArrayView<float> x);
   void Sqrt(rtc::ArrayView<float> x) {
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kAvx2:
+        SqrtAVX2(x);
+        break;
       case Aec3Optimization::kSse2: {
         const int x_size = static_cast<int>(x.size());
         const int vector_limit = x_size >> 2;
@@ -110,6 +114,9 @@ class VectorMath {
   }
 
   // Elementwise vector multiplication z = x * y.
+  void MultiplyAVX2(rtc::ArrayView<const float> x,
+                    rtc::ArrayView<const float> y,
+                    rtc::ArrayView<float> z);
   void Multiply(rtc::ArrayView<const float> x,
                 rtc::ArrayView<const float> y,
                 rtc::ArrayView<float> z) {
@@ -117,6 +124,9 @@ class VectorMath {
     RTC_DCHECK_EQ(z.size(), y.size());
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kAvx2:
+        MultiplyAVX2(x, y, z);
+        break;
       case Aec3Optimization::kSse2: {
         const int x_size = static_cast<int>(x.size());
         const int vector_limit = x_size >> 2;
@@ -159,10 +169,14 @@ class VectorMath {
   }
 
   // Elementwise vector accumulation z += x.
+  void AccumulateAVX2(rtc::ArrayView<const float> x, rtc::ArrayView<float> z);
   void Accumulate(rtc::ArrayView<const float> x, rtc::ArrayView<float> z) {
     RTC_DCHECK_EQ(z.size(), x.size());
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kAvx2:
+        AccumulateAVX2(x, z);
+        break;
       case Aec3Optimization::kSse2: {
         const int x_size = static_cast<int>(x.size());
         const int vector_limit = x_size >> 2;
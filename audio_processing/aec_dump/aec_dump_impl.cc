@@ -58,15 +58,18 @@ void CopyFromConfigToEvent(const webrtc::InternalAPMConfig& config,
 AecDumpImpl::AecDumpImpl(FileWrapper debug_file,
                          int64_t max_log_size_bytes,
                          rtc::TaskQueue* worker_queue)
-    : debug_file_(std::move(debug_file)),
-      num_bytes_left_for_log_(max_log_size_bytes),
+    : writer_(std::move(debug_file), max_log_size_bytes),
       worker_queue_(worker_queue),
       capture_stream_info_(CreateWriteToFileTask()) {}
 
 AecDumpImpl::~AecDumpImpl() {
-  // Block until all tasks have finished running.
+  // Block until all tasks have finished running and the buffered events have
+  // been written.
   rtc::Event thread_sync_event;
-  worker_queue_->PostTask([&thread_sync_event] { thread_sync_event.Set(); });
+  worker_queue_->PostTask([this, &thread_sync_event] {
+    writer_.Flush();
+    thread_sync_event.Set();
+  });
   // Wait until the event has been signaled with .Set(). By then all
   // pending tasks will have finished.
   thread_sync_event.Wait(rtc::Event::kForever);
@@ -204,6 +207,12 @@ void AecDumpImpl::WriteRuntimeSetting(
       setting->set_playout_volume_change(x);
       break;
     }
+    case AudioProcessing::RuntimeSetting::Type::kCapturePerformanceTier: {
+      int x;
+      runtime_setting.GetInt(&x);
+      setting->set_capture_performance_tier(x);
+      break;
+    }
     case AudioProcessing::RuntimeSetting::Type::kNotSpecified:
       RTC_NOTREACHED();
       break;
@@ -212,8 +221,7 @@ void AecDumpImpl::WriteRuntimeSetting(
 }
 
 std::unique_ptr<WriteToFileTask> AecDumpImpl::CreateWriteToFileTask() {
-  return std::make_unique<WriteToFileTask>(&debug_file_,
-                                           &num_bytes_left_for_log_);
+  return std::make_unique<WriteToFileTask>(&writer_);
 }
 
 std::unique_ptr<AecDump> AecDumpFactory::Create(webrtc::FileWrapper file,
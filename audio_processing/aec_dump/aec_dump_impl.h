@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "api/audio/audio_frame.h"
+#include "modules/audio_processing/aec_dump/buffered_file_writer.h"
 #include "modules/audio_processing/aec_dump/capture_stream_info.h"
 #include "modules/audio_processing/aec_dump/write_to_file_task.h"
 #include "modules/audio_processing/include/aec_dump.h"
@@ -72,8 +73,8 @@ class AecDumpImpl : public AecDump {
  private:
   std::unique_ptr<WriteToFileTask> CreateWriteToFileTask();
 
-  FileWrapper debug_file_;
-  int64_t num_bytes_left_for_log_ = 0;
+  // Only accessed on |worker_queue_|.
+  BufferedFileWriter writer_;
   rtc::RaceChecker race_checker_;
   rtc::TaskQueue* worker_queue_;
   CaptureStreamInfo capture_stream_info_;
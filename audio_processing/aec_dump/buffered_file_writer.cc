@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/buffered_file_writer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr size_t BufferedFileWriter::kFlushSizeBytes;
+
+BufferedFileWriter::BufferedFileWriter(FileWrapper file,
+                                       int64_t max_log_size_bytes)
+    : file_(std::move(file)), num_bytes_left_for_log_(max_log_size_bytes) {
+  buffer_.reserve(kFlushSizeBytes);
+}
+
+BufferedFileWriter::~BufferedFileWriter() {
+  Flush();
+}
+
+void BufferedFileWriter::WriteEvent(const audioproc::Event& event) {
+  const size_t event_byte_size = event.ByteSizeLong();
+  const int64_t message_size = event_byte_size + sizeof(int32_t);
+  if (num_bytes_left_for_log_ >= 0) {
+    if (num_bytes_left_for_log_ < message_size) {
+      // Ensure that no further events are written, even if they're smaller
+      // than the current event.
+      num_bytes_left_for_log_ = 0;
+      return;
+    }
+    num_bytes_left_for_log_ -= message_size;
+  }
+
+  // Write the message preceded by its size. The sizes computed above are
+  // cached in |event| and reused by the serialization.
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + message_size);
+  const int32_t size_prefix = static_cast<int32_t>(event_byte_size);
+  memcpy(&buffer_[offset], &size_prefix, sizeof(size_prefix));
+  event.SerializeWithCachedSizesToArray(&buffer_[offset + sizeof(int32_t)]);
+
+  if (buffer_.size() >= kFlushSizeBytes) {
+    Flush();
+  }
+}
+
+void BufferedFileWriter::Flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  if (!file_.Write(buffer_.data(), buffer_.size())) {
+    RTC_NOTREACHED();
+  }
+  buffer_.clear();
+}
+
+}  // namespace webrtc
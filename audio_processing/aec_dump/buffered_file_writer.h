@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC_DUMP_BUFFERED_FILE_WRITER_H_
+#define MODULES_AUDIO_PROCESSING_AEC_DUMP_BUFFERED_FILE_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/ignore_wundef.h"
+#include "rtc_base/system/file_wrapper.h"
+
+// Files generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/modules/audio_processing/debug.pb.h"
+#else
+#include "modules/audio_processing/debug.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+// Serializes the events of an aec dump, each preceded by its size, directly
+// into a buffer and writes the buffer to the file once it holds at least
+// |kFlushSizeBytes|. This replaces two small file writes and a temporary
+// string per event by one large write per batch of events, while bounding
+// the buffered memory to |kFlushSizeBytes| plus one event. Not thread safe;
+// all calls must be made on the same task queue.
+class BufferedFileWriter {
+ public:
+  static constexpr size_t kFlushSizeBytes = 256 * 1024;
+
+  // |max_log_size_bytes == -1| means that the log size is unlimited.
+  BufferedFileWriter(FileWrapper file, int64_t max_log_size_bytes);
+  ~BufferedFileWriter();
+  BufferedFileWriter(const BufferedFileWriter&) = delete;
+  BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+  // Adds |event| to the buffer, unless the log size limit has been reached.
+  // Once an event does not fit, no further events are written, even if they
+  // are smaller.
+  void WriteEvent(const audioproc::Event& event);
+
+  // Writes the buffered events to the file.
+  void Flush();
+
+ private:
+  FileWrapper file_;
+  int64_t num_bytes_left_for_log_;
+  std::vector<uint8_t> buffer_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC_DUMP_BUFFERED_FILE_WRITER_H_
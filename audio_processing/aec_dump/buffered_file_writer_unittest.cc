@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec_dump/buffered_file_writer.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+audioproc::Event CreateRenderEvent(size_t num_bytes) {
+  audioproc::Event event;
+  event.set_type(audioproc::Event::REVERSE_STREAM);
+  event.mutable_reverse_stream()->set_data(std::string(num_bytes, 'x'));
+  return event;
+}
+
+// Reads the size-prefixed events of a dump file.
+std::vector<audioproc::Event> ReadEvents(const std::string& filename) {
+  std::vector<audioproc::Event> events;
+  FILE* file = fopen(filename.c_str(), "rb");
+  EXPECT_TRUE(file);
+  if (!file) {
+    return events;
+  }
+  int32_t size;
+  while (fread(&size, sizeof(size), 1, file) == 1) {
+    std::string bytes(size, '\0');
+    EXPECT_EQ(static_cast<size_t>(size), fread(&bytes[0], 1, size, file));
+    events.emplace_back();
+    EXPECT_TRUE(events.back().ParseFromString(bytes));
+  }
+  fclose(file);
+  return events;
+}
+
+}  // namespace
+
+TEST(BufferedFileWriter, WritesAllEventsInOrder) {
+  const std::string filename =
+      test::TempFilename(test::OutputPath(), "buffered_file_writer");
+  // Enough events to trigger several flushes.
+  const size_t kNumEvents =
+      3 * BufferedFileWriter::kFlushSizeBytes / 1000 + 1;
+  {
+    BufferedFileWriter writer(FileWrapper::OpenWriteOnly(filename), -1);
+    for (size_t k = 0; k < kNumEvents; ++k) {
+      writer.WriteEvent(CreateRenderEvent(k % 2000));
+    }
+  }
+
+  const std::vector<audioproc::Event> events = ReadEvents(filename);
+  ASSERT_EQ(kNumEvents, events.size());
+  for (size_t k = 0; k < kNumEvents; ++k) {
+    ASSERT_EQ(audioproc::Event::REVERSE_STREAM, events[k].type());
+    EXPECT_EQ(k % 2000, events[k].reverse_stream().data().size());
+  }
+  ASSERT_EQ(0, remove(filename.c_str()));
+}
+
+TEST(BufferedFileWriter, StopsWritingAtMaxLogSize) {
+  const std::string filename =
+      test::TempFilename(test::OutputPath(), "buffered_file_writer");
+  const audioproc::Event large_event = CreateRenderEvent(1000);
+  const audioproc::Event small_event = CreateRenderEvent(10);
+  const int64_t kMaxLogSizeBytes =
+      2 * (large_event.ByteSizeLong() + sizeof(int32_t)) + 1;
+  {
+    BufferedFileWriter writer(FileWrapper::OpenWriteOnly(filename),
+                              kMaxLogSizeBytes);
+    writer.WriteEvent(large_event);
+    writer.WriteEvent(large_event);
+    // Neither the event exceeding the limit nor the later ones are written.
+    writer.WriteEvent(large_event);
+    writer.WriteEvent(small_event);
+  }
+
+  EXPECT_EQ(2u, ReadEvents(filename).size());
+  ASSERT_EQ(0, remove(filename.c_str()));
+}
+
+}  // namespace webrtc
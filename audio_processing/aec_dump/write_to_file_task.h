@@ -16,10 +16,10 @@
 #include <utility>
 
 #include "api/task_queue/queued_task.h"
+#include "modules/audio_processing/aec_dump/buffered_file_writer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/ignore_wundef.h"
-#include "rtc_base/system/file_wrapper.h"
 
 // Files generated at build-time by the protobuf compiler.
 RTC_PUSH_IGNORING_WUNDEF()
@@ -34,22 +34,16 @@ namespace webrtc {
 
 class WriteToFileTask : public QueuedTask {
  public:
-  WriteToFileTask(webrtc::FileWrapper* debug_file,
-                  int64_t* num_bytes_left_for_log);
+  explicit WriteToFileTask(BufferedFileWriter* writer);
   ~WriteToFileTask() override;
 
   audioproc::Event* GetEvent();
 
  private:
-  bool IsRoomForNextEvent(size_t event_byte_size) const;
-
-  void UpdateBytesLeft(size_t event_byte_size);
-
   bool Run() override;
 
-  webrtc::FileWrapper* const debug_file_;
+  BufferedFileWriter* const writer_;
   audioproc::Event event_;
-  int64_t* const num_bytes_left_for_log_;
 };
 
 }  // namespace webrtc
@@ -23,6 +23,7 @@ extern "C" {
 #include "modules/audio_processing/utility/delay_estimator_wrapper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 #ifdef AEC_DEBUG
 FILE* dfile;
@@ -333,6 +334,15 @@ static void WebRtcAecm_InitNeon(void) {
 }
 #endif
 
+// Initialize function pointers for x86 platforms with SSE2.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+static void WebRtcAecm_InitSse2(void) {
+  WebRtcAecm_StoreAdaptiveChannel = WebRtcAecm_StoreAdaptiveChannelSse2;
+  WebRtcAecm_ResetAdaptiveChannel = WebRtcAecm_ResetAdaptiveChannelSse2;
+  WebRtcAecm_CalcLinearEnergies = WebRtcAecm_CalcLinearEnergiesSse2;
+}
+#endif
+
 // Initialize function pointers for MIPS platform.
 #if defined(MIPS32_LE)
 static void WebRtcAecm_InitMips(void) {
@@ -468,6 +478,12 @@ int WebRtcAecm_InitCore(AecmCore* const aecm, int samplingFreq) {
   WebRtcAecm_InitNeon();
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcAecm_InitSse2();
+  }
+#endif
+
 #if defined(MIPS32_LE)
   WebRtcAecm_InitMips();
 #endif
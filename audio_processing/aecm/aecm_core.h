@@ -18,6 +18,7 @@ extern "C" {
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 }
 #include "modules/audio_processing/aecm/aecm_defines.h"
+#include "rtc_base/system/arch.h"
 
 #ifdef _MSC_VER  // visual c++
 #define ALIGN8_BEG __declspec(align(8))
@@ -416,6 +417,21 @@ void WebRtcAecm_StoreAdaptiveChannelNeon(AecmCore* aecm,
 void WebRtcAecm_ResetAdaptiveChannelNeon(AecmCore* aecm);
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcAecm_CalcLinearEnergiesSse2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored);
+
+void WebRtcAecm_StoreAdaptiveChannelSse2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est);
+
+void WebRtcAecm_ResetAdaptiveChannelSse2(AecmCore* aecm);
+#endif
+
 #if defined(MIPS32_LE)
 void WebRtcAecm_CalcLinearEnergies_mips(AecmCore* aecm,
                                         const uint16_t* far_spectrum,
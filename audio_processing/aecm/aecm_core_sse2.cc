@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_processing/aecm/aecm_core.h"
+
+namespace {
+
+// Multiplies the signed 16-bit lanes of |a| with the unsigned 16-bit lanes of
+// |b|, as WEBRTC_SPL_MUL_16_U16 does, and returns the 32-bit products of the
+// four lower and the four upper lanes.
+inline void MulS16U16(__m128i a, __m128i b, __m128i* low, __m128i* high) {
+  const __m128i product_low = _mm_mullo_epi16(a, b);
+  // The unsigned high half is off by |b| for the lanes where |a| is negative.
+  const __m128i sign_a = _mm_srai_epi16(a, 15);
+  const __m128i product_high =
+      _mm_sub_epi16(_mm_mulhi_epu16(a, b), _mm_and_si128(sign_a, b));
+  *low = _mm_unpacklo_epi16(product_low, product_high);
+  *high = _mm_unpackhi_epi16(product_low, product_high);
+}
+
+inline uint32_t AddLanes(__m128i v) {
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+}  // namespace
+
+void WebRtcAecm_CalcLinearEnergiesSse2(AecmCore* aecm,
+                                       const uint16_t* far_spectrum,
+                                       int32_t* echo_est,
+                                       uint32_t* far_energy,
+                                       uint32_t* echo_energy_adapt,
+                                       uint32_t* echo_energy_stored) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i far_energy_v = zero;
+  __m128i echo_adapt_v = zero;
+  __m128i echo_stored_v = zero;
+
+  // Get energy for the delayed far end signal and estimated
+  // echo using both stored and adapted channels.
+  int i;
+  for (i = 0; i < PART_LEN; i += 8) {
+    const __m128i far_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&far_spectrum[i]));
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    const __m128i adapt_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelAdapt16[i]));
+
+    __m128i echo_low, echo_high;
+    MulS16U16(stored_v, far_v, &echo_low, &echo_high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i]), echo_low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i + 4]), echo_high);
+    echo_stored_v = _mm_add_epi32(echo_stored_v, echo_low);
+    echo_stored_v = _mm_add_epi32(echo_stored_v, echo_high);
+
+    __m128i adapt_low, adapt_high;
+    MulS16U16(adapt_v, far_v, &adapt_low, &adapt_high);
+    echo_adapt_v = _mm_add_epi32(echo_adapt_v, adapt_low);
+    echo_adapt_v = _mm_add_epi32(echo_adapt_v, adapt_high);
+
+    far_energy_v = _mm_add_epi32(far_energy_v, _mm_unpacklo_epi16(far_v, zero));
+    far_energy_v = _mm_add_epi32(far_energy_v, _mm_unpackhi_epi16(far_v, zero));
+  }
+
+  // The sums wrap around like the unsigned accumulation of the C version.
+  *far_energy += AddLanes(far_energy_v);
+  *echo_energy_adapt += AddLanes(echo_adapt_v);
+  *echo_energy_stored += AddLanes(echo_stored_v);
+
+  // Get estimated echo energies for adaptive channel and stored channel.
+  echo_est[i] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[i], far_spectrum[i]);
+  *echo_energy_stored += static_cast<uint32_t>(echo_est[i]);
+  *far_energy += static_cast<uint32_t>(far_spectrum[i]);
+  *echo_energy_adapt += aecm->channelAdapt16[i] * far_spectrum[i];
+}
+
+void WebRtcAecm_StoreAdaptiveChannelSse2(AecmCore* aecm,
+                                         const uint16_t* far_spectrum,
+                                         int32_t* echo_est) {
+  // During startup we store the channel every block, and
+  // recalculate echo estimate.
+  int i;
+  for (i = 0; i < PART_LEN; i += 8) {
+    const __m128i far_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&far_spectrum[i]));
+    const __m128i adapt_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelAdapt16[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelStored[i]),
+                     adapt_v);
+
+    __m128i echo_low, echo_high;
+    MulS16U16(adapt_v, far_v, &echo_low, &echo_high);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i]), echo_low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&echo_est[i + 4]), echo_high);
+  }
+  aecm->channelStored[i] = aecm->channelAdapt16[i];
+  echo_est[i] = WEBRTC_SPL_MUL_16_U16(aecm->channelStored[i], far_spectrum[i]);
+}
+
+void WebRtcAecm_ResetAdaptiveChannelSse2(AecmCore* aecm) {
+  const __m128i zero = _mm_setzero_si128();
+
+  // The stored channel has a significantly lower MSE than the adaptive one for
+  // two consecutive calculations. Reset the adaptive channel.
+  int i;
+  for (i = 0; i < PART_LEN; i += 8) {
+    const __m128i stored_v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(&aecm->channelStored[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt16[i]),
+                     stored_v);
+    // Restore the W32 channel: interleaving with zeros puts each 16-bit value
+    // in the upper half of a 32-bit lane, which is the shift by 16.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt32[i]),
+                     _mm_unpacklo_epi16(zero, stored_v));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&aecm->channelAdapt32[i + 4]),
+                     _mm_unpackhi_epi16(zero, stored_v));
+  }
+  aecm->channelAdapt16[i] = aecm->channelStored[i];
+  aecm->channelAdapt32[i] = (int32_t)aecm->channelStored[i] << 16;
+}
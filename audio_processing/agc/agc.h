@@ -30,6 +30,12 @@ class Agc {
   // |audio| must be mono; in a multi-channel stream, provide the first (usually
   // left) channel.
   virtual void Process(const int16_t* audio, size_t length, int sample_rate_hz);
+  // Same as Process(), but uses |voice_activity|, the decision of a WebRTC VAD
+  // in the most aggressive mode for |audio|, instead of computing it.
+  virtual void ProcessWithVoiceActivity(const int16_t* audio,
+                                        size_t length,
+                                        int sample_rate_hz,
+                                        bool voice_activity);
 
   // Retrieves the difference between the target RMS level and the current
   // signal RMS level in dB. Returns true if an update is available and false
@@ -42,6 +48,9 @@ class Agc {
   virtual float voice_probability() const;
 
  private:
+  // Updates |histogram_| with the latest output of |vad_|.
+  void UpdateHistogram();
+
   double target_level_loudness_;
   int target_level_dbfs_;
   std::unique_ptr<LoudnessHistogram> histogram_;
@@ -317,6 +317,13 @@ void AgcManagerDirect::AnalyzePreProcess(float* audio,
 void AgcManagerDirect::Process(const float* audio,
                                size_t length,
                                int sample_rate_hz) {
+  Process(audio, length, sample_rate_hz, absl::nullopt);
+}
+
+void AgcManagerDirect::Process(const float* audio,
+                               size_t length,
+                               int sample_rate_hz,
+                               absl::optional<bool> voice_activity) {
   if (capture_muted_) {
     return;
   }
@@ -340,7 +347,12 @@ void AgcManagerDirect::Process(const float* audio,
     CheckVolumeAndReset();
   }
 
-  agc_->Process(audio_fix, safe_length, sample_rate_hz);
+  if (voice_activity) {
+    agc_->ProcessWithVoiceActivity(audio_fix, safe_length, sample_rate_hz,
+                                   *voice_activity);
+  } else {
+    agc_->Process(audio_fix, safe_length, sample_rate_hz);
+  }
 
   UpdateGain();
   if (!disable_digital_adaptive_) {
@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "modules/audio_processing/agc/agc.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/constructor_magic.h"
@@ -60,6 +61,12 @@ class AgcManagerDirect final {
                          int num_channels,
                          size_t samples_per_channel);
   void Process(const float* audio, size_t length, int sample_rate_hz);
+  // Same as above, using |voice_activity| when set as the decision of a WebRTC
+  // VAD in the most aggressive mode for |audio|, instead of computing it.
+  void Process(const float* audio,
+               size_t length,
+               int sample_rate_hz,
+               absl::optional<bool> voice_activity);
 
   // Call when the capture stream has been muted/unmuted. This causes the
   // manager to disregard all incoming audio; chances are good it's background
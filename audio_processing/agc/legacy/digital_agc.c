@@ -21,6 +21,7 @@
 
 #include "rtc_base/checks.h"
 #include "modules/audio_processing/agc/legacy/gain_control.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 // To generate the gaintable, copy&paste the following lines to a Matlab window:
 // MaxGain = 6; MinGain = 0; CompRatio = 3; Knee = 1;
@@ -242,7 +243,65 @@ int32_t WebRtcAgc_CalculateGainTable(int32_t* gainTable,       // Q16
   return 0;
 }
 
+void WebRtcAgc_CalculateEnvelopeC(const int16_t* in,
+                                  size_t subframe_length,
+                                  int32_t* env) {
+  size_t k, n;
+
+  // iterate over sub frames
+  for (k = 0; k < 10; k++) {
+    // iterate over samples
+    int32_t max_nrg = 0;
+    for (n = 0; n < subframe_length; n++) {
+      int32_t nrg = in[k * subframe_length + n] * in[k * subframe_length + n];
+      if (nrg > max_nrg) {
+        max_nrg = nrg;
+      }
+    }
+    env[k] = max_nrg;
+  }
+}
+
+void WebRtcAgc_ApplyGainC(int32_t gain32,
+                          int32_t delta,
+                          size_t num_samples,
+                          int16_t* out) {
+  size_t n;
+
+  for (n = 0; n < num_samples; n++) {
+    int64_t tmp64 = ((int64_t)(out[n])) * (gain32 >> 4);
+    tmp64 = tmp64 >> 16;
+    if (tmp64 > 32767) {
+      out[n] = 32767;
+    } else if (tmp64 < -32768) {
+      out[n] = -32768;
+    } else {
+      out[n] = (int16_t)(tmp64);
+    }
+    gain32 += delta;
+  }
+}
+
+// Declare function pointers.
+AgcCalculateEnvelope WebRtcAgc_CalculateEnvelope;
+AgcApplyGain WebRtcAgc_ApplyGain;
+
+// Initialize function pointers, selecting the SSE2 versions when supported.
+static void InitFunctionPointers(void) {
+  WebRtcAgc_CalculateEnvelope = WebRtcAgc_CalculateEnvelopeC;
+  WebRtcAgc_ApplyGain = WebRtcAgc_ApplyGainC;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcAgc_CalculateEnvelope = WebRtcAgc_CalculateEnvelopeSse2;
+    WebRtcAgc_ApplyGain = WebRtcAgc_ApplyGainSse2;
+  }
+#endif
+}
+
 int32_t WebRtcAgc_InitDigital(DigitalAgc* stt, int16_t agcMode) {
+  InitFunctionPointers();
+
   if (agcMode == kAgcModeFixedDigital) {
     // start at minimum to find correct gain faster
     stt->capacitorSlow = 0;
@@ -286,7 +345,6 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
 
   int32_t out_tmp, tmp32;
   int32_t env[10];
-  int32_t max_nrg;
   int32_t cur_level;
   int32_t gain32, delta;
   int16_t logratio;
@@ -364,18 +422,7 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
           logratio, decay, stt->vadNearend.stdLongTerm);
 #endif
   // Find max amplitude per sub frame
-  // iterate over sub frames
-  for (k = 0; k < 10; k++) {
-    // iterate over samples
-    max_nrg = 0;
-    for (n = 0; n < L; n++) {
-      int32_t nrg = out[0][k * L + n] * out[0][k * L + n];
-      if (nrg > max_nrg) {
-        max_nrg = nrg;
-      }
-    }
-    env[k] = max_nrg;
-  }
+  WebRtcAgc_CalculateEnvelope(out[0], L, env);
 
   // Calculate gain per sub frame
   gains[0] = stt->gain;
@@ -522,22 +569,8 @@ int32_t WebRtcAgc_ProcessDigital(DigitalAgc* stt,
   for (k = 1; k < 10; k++) {
     delta = (gains[k + 1] - gains[k]) * (1 << (4 - L2));
     gain32 = gains[k] * (1 << 4);
-    // iterate over samples
-    for (n = 0; n < L; n++) {
-      for (i = 0; i < num_bands; ++i) {
-        int64_t tmp64 = ((int64_t)(out[i][k * L + n])) * (gain32 >> 4);
-        tmp64 = tmp64 >> 16;
-        if (tmp64 > 32767) {
-          out[i][k * L + n] = 32767;
-        }
-        else if (tmp64 < -32768) {
-          out[i][k * L + n] = -32768;
-        }
-        else {
-          out[i][k * L + n] = (int16_t)(tmp64);
-        }
-      }
-      gain32 += delta;
+    for (i = 0; i < num_bands; ++i) {
+      WebRtcAgc_ApplyGain(gain32, delta, L, &out[i][k * L]);
     }
   }
 
@@ -15,6 +15,11 @@
 #include <stdio.h>
 #endif
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/system/arch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 // the 32 most significant bits of A(19) * B(26) >> 13
 #define AGC_MUL32(A, B) (((B) >> 13) * (A) + (((0x00001FFF & (B)) * (A)) >> 13))
@@ -75,4 +80,45 @@ int32_t WebRtcAgc_CalculateGainTable(int32_t* gainTable,         // Q16
                                      uint8_t limiterEnable,
                                      int16_t analogTarget);
 
+// Some function pointers, for the per-sample loops of WebRtcAgc_ProcessDigital
+// shared by SSE2 and generic C code. All versions are bit-exact.
+//
+// Computes the envelope |env| of the 10 subframes of |subframe_length|
+// samples starting at |in|, i.e., the maximum energy of each subframe.
+typedef void (*AgcCalculateEnvelope)(const int16_t* in,
+                                     size_t subframe_length,
+                                     int32_t* env);
+extern AgcCalculateEnvelope WebRtcAgc_CalculateEnvelope;
+
+// Multiplies the |num_samples| samples of |out| with the Q20 gain |gain32|,
+// which is incremented by |delta| after each sample, saturating the result.
+typedef void (*AgcApplyGain)(int32_t gain32,
+                             int32_t delta,
+                             size_t num_samples,
+                             int16_t* out);
+extern AgcApplyGain WebRtcAgc_ApplyGain;
+
+void WebRtcAgc_CalculateEnvelopeC(const int16_t* in,
+                                  size_t subframe_length,
+                                  int32_t* env);
+void WebRtcAgc_ApplyGainC(int32_t gain32,
+                          int32_t delta,
+                          size_t num_samples,
+                          int16_t* out);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Defined in digital_agc_sse2.c.
+void WebRtcAgc_CalculateEnvelopeSse2(const int16_t* in,
+                                     size_t subframe_length,
+                                     int32_t* env);
+void WebRtcAgc_ApplyGainSse2(int32_t gain32,
+                             int32_t delta,
+                             size_t num_samples,
+                             int16_t* out);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif  // MODULES_AUDIO_PROCESSING_AGC_LEGACY_DIGITAL_AGC_H_
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_processing/agc/legacy/digital_agc.h"
+
+// The SSE2 versions below process eight samples at a time and handle the
+// remaining samples with the same scalar code as in digital_agc.c.
+
+void WebRtcAgc_CalculateEnvelopeSse2(const int16_t* in,
+                                     size_t subframe_length,
+                                     int32_t* env) {
+  size_t k, n;
+
+  for (k = 0; k < 10; k++) {
+    const int16_t* subframe = &in[k * subframe_length];
+    int32_t max_nrg = 0;
+    n = 0;
+    if (subframe_length >= 8) {
+      // The largest energy is the square of either the largest or the
+      // smallest sample, which avoids the 32-bit maximum missing in SSE2.
+      __m128i max_v = _mm_loadu_si128((const __m128i*)subframe);
+      __m128i min_v = max_v;
+      int32_t max_sample, min_sample;
+      for (n = 8; n + 8 <= subframe_length; n += 8) {
+        const __m128i in_v = _mm_loadu_si128((const __m128i*)&subframe[n]);
+        max_v = _mm_max_epi16(max_v, in_v);
+        min_v = _mm_min_epi16(min_v, in_v);
+      }
+      // Reduce the eight lanes to the first one.
+      max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 8));
+      max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 4));
+      max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 2));
+      min_v = _mm_min_epi16(min_v, _mm_srli_si128(min_v, 8));
+      min_v = _mm_min_epi16(min_v, _mm_srli_si128(min_v, 4));
+      min_v = _mm_min_epi16(min_v, _mm_srli_si128(min_v, 2));
+      max_sample = (int16_t)_mm_extract_epi16(max_v, 0);
+      min_sample = (int16_t)_mm_extract_epi16(min_v, 0);
+      max_nrg = max_sample * max_sample;
+      if (min_sample * min_sample > max_nrg) {
+        max_nrg = min_sample * min_sample;
+      }
+    }
+    for (; n < subframe_length; n++) {
+      int32_t nrg = subframe[n] * subframe[n];
+      if (nrg > max_nrg) {
+        max_nrg = nrg;
+      }
+    }
+    env[k] = max_nrg;
+  }
+}
+
+void WebRtcAgc_ApplyGainSse2(int32_t gain32,
+                             int32_t delta,
+                             size_t num_samples,
+                             int16_t* out) {
+  // The gains of eight consecutive samples, in two vectors of four.
+  __m128i gains_first = _mm_set_epi32(gain32 + 3 * delta, gain32 + 2 * delta,
+                                      gain32 + delta, gain32);
+  __m128i gains_last = _mm_add_epi32(gains_first, _mm_set1_epi32(4 * delta));
+  const __m128i step = _mm_set1_epi32(8 * delta);
+  size_t n = 0;
+
+  for (; n + 8 <= num_samples; n += 8) {
+    // Split the Q16 gains g = gain32 >> 4 into g = 2^16 * g_msb + g_lsb,
+    // with 0 <= g_lsb < 2^16, so that (x * g) >> 16, which needs more than 32
+    // bits, equals x * g_msb + ((x * g_lsb) >> 16).
+    const __m128i g_first = _mm_srai_epi32(gains_first, 4);
+    const __m128i g_last = _mm_srai_epi32(gains_last, 4);
+    const __m128i g_msb = _mm_packs_epi32(_mm_srai_epi32(g_first, 16),
+                                          _mm_srai_epi32(g_last, 16));
+    // Sign extension of the lower halves keeps their bits through the pack.
+    const __m128i g_lsb =
+        _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(g_first, 16), 16),
+                        _mm_srai_epi32(_mm_slli_epi32(g_last, 16), 16));
+    const __m128i x = _mm_loadu_si128((const __m128i*)&out[n]);
+
+    // x * g_msb in 32 bits.
+    const __m128i msb_product_low = _mm_mullo_epi16(x, g_msb);
+    const __m128i msb_product_high = _mm_mulhi_epi16(x, g_msb);
+    // (x * g_lsb) >> 16 for signed x and unsigned g_lsb: the unsigned high
+    // half is off by g_lsb for the negative samples.
+    const __m128i lsb_product = _mm_sub_epi16(
+        _mm_mulhi_epu16(x, g_lsb), _mm_and_si128(_mm_srai_epi16(x, 15), g_lsb));
+    const __m128i lsb_product_sign = _mm_srai_epi16(lsb_product, 15);
+
+    const __m128i y_low =
+        _mm_add_epi32(_mm_unpacklo_epi16(msb_product_low, msb_product_high),
+                      _mm_unpacklo_epi16(lsb_product, lsb_product_sign));
+    const __m128i y_high =
+        _mm_add_epi32(_mm_unpackhi_epi16(msb_product_low, msb_product_high),
+                      _mm_unpackhi_epi16(lsb_product, lsb_product_sign));
+    // Saturates to [-32768, 32767].
+    _mm_storeu_si128((__m128i*)&out[n], _mm_packs_epi32(y_low, y_high));
+
+    gains_first = _mm_add_epi32(gains_first, step);
+    gains_last = _mm_add_epi32(gains_last, step);
+  }
+  gain32 += (int32_t)n * delta;
+
+  for (; n < num_samples; n++) {
+    int64_t tmp64 = ((int64_t)(out[n])) * (gain32 >> 4);
+    tmp64 = tmp64 >> 16;
+    if (tmp64 > 32767) {
+      out[n] = 32767;
+    } else if (tmp64 < -32768) {
+      out[n] = -32768;
+    } else {
+      out[n] = (int16_t)(tmp64);
+    }
+    gain32 += delta;
+  }
+}
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc/legacy/digital_agc.h"
+
+#include <string.h>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+// Samples per subframe at 8 kHz and at the higher rates.
+const size_t kSubframeLengths[] = {8, 16};
+
+// Fills |data| with random samples, including the extreme values.
+void RandomFill(Random* random, int16_t* data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    switch (random->Rand(0, 7)) {
+      case 0:
+        data[i] = -32768;
+        break;
+      case 1:
+        data[i] = 32767;
+        break;
+      default:
+        data[i] = static_cast<int16_t>(random->Rand(-32768, 32767));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(DigitalAgc, Sse2EnvelopeIsBitexactWithC) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  Random random(42);
+  for (size_t subframe_length : kSubframeLengths) {
+    SCOPED_TRACE(subframe_length);
+    for (int i = 0; i < 100; ++i) {
+      int16_t in[160];
+      RandomFill(&random, in, 10 * subframe_length);
+      int32_t env_c[10];
+      int32_t env_sse2[10];
+      WebRtcAgc_CalculateEnvelopeC(in, subframe_length, env_c);
+      WebRtcAgc_CalculateEnvelopeSse2(in, subframe_length, env_sse2);
+      EXPECT_EQ(0, memcmp(env_c, env_sse2, sizeof(env_c)));
+    }
+  }
+}
+
+TEST(DigitalAgc, Sse2GainIsBitexactWithC) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  Random random(42);
+  for (size_t subframe_length : kSubframeLengths) {
+    SCOPED_TRACE(subframe_length);
+    const int kLog2SubframeLength = subframe_length == 8 ? 3 : 4;
+    for (int i = 0; i < 1000; ++i) {
+      // Q16 gains between -inf and +42 dB, such that the output is saturated
+      // for some of the samples.
+      const int32_t start_gain = random.Rand(0, 1 << 23);
+      const int32_t end_gain = random.Rand(0, 1 << 23);
+      const int32_t gain32 = start_gain * (1 << 4);
+      const int32_t delta =
+          (end_gain - start_gain) * (1 << (4 - kLog2SubframeLength));
+
+      int16_t out_c[16];
+      int16_t out_sse2[16];
+      RandomFill(&random, out_c, subframe_length);
+      memcpy(out_sse2, out_c, sizeof(out_c));
+      WebRtcAgc_ApplyGainC(gain32, delta, subframe_length, out_c);
+      WebRtcAgc_ApplyGainSse2(gain32, delta, subframe_length, out_sse2);
+      EXPECT_EQ(0, memcmp(out_c, out_sse2, subframe_length * sizeof(out_c[0])));
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -22,6 +22,11 @@ class MockAgc : public Agc {
   MOCK_METHOD2(AnalyzePreproc, float(const int16_t* audio, size_t length));
   MOCK_METHOD3(Process,
                void(const int16_t* audio, size_t length, int sample_rate_hz));
+  MOCK_METHOD4(ProcessWithVoiceActivity,
+               void(const int16_t* audio,
+                    size_t length,
+                    int sample_rate_hz,
+                    bool voice_activity));
   MOCK_METHOD1(GetRmsErrorDb, bool(int* error));
   MOCK_METHOD0(Reset, void());
   MOCK_METHOD1(set_target_level_dbfs, int(int level));
@@ -43,7 +43,11 @@ AdaptiveAgc::~AdaptiveAgc() = default;
 void AdaptiveAgc::Process(AudioFrameView<float> float_frame,
                           float last_audio_level) {
   auto signal_with_levels = SignalWithLevels(float_frame);
-  signal_with_levels.vad_result = vad_.AnalyzeFrame(float_frame);
+  if (frames_since_vad_ == 0) {
+    vad_result_ = vad_.AnalyzeFrame(float_frame);
+  }
+  frames_since_vad_ = (frames_since_vad_ + 1) % vad_frame_interval_;
+  signal_with_levels.vad_result = vad_result_;
   apm_data_dumper_->DumpRaw("agc2_vad_probability",
                             signal_with_levels.vad_result.speech_probability);
   apm_data_dumper_->DumpRaw("agc2_vad_rms_dbfs",
@@ -78,4 +82,10 @@ void AdaptiveAgc::Reset() {
   speech_level_estimator_.Reset();
 }
 
+void AdaptiveAgc::SetVadFrameInterval(int num_frames) {
+  RTC_DCHECK_GT(num_frames, 0);
+  vad_frame_interval_ = num_frames;
+  frames_since_vad_ = 0;
+}
+
 }  // namespace webrtc
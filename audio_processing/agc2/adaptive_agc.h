@@ -31,12 +31,19 @@ class AdaptiveAgc {
   void Process(AudioFrameView<float> float_frame, float last_audio_level);
   void Reset();
 
+  // Makes the VAD analyze one frame every |num_frames| frames, the other frames
+  // reuse the latest VAD result. Trades accuracy for CPU usage.
+  void SetVadFrameInterval(int num_frames);
+
  private:
   AdaptiveModeLevelEstimator speech_level_estimator_;
   VadWithLevel vad_;
   AdaptiveDigitalGainApplier gain_applier_;
   ApmDataDumper* const apm_data_dumper_;
   NoiseLevelEstimator noise_level_estimator_;
+  int vad_frame_interval_ = 1;
+  int frames_since_vad_ = 0;
+  VadWithLevel::LevelAndProbability vad_result_;
 };
 
 }  // namespace webrtc
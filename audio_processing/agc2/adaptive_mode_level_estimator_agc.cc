@@ -41,6 +41,14 @@ void AdaptiveModeLevelEstimatorAgc::Process(const int16_t* audio,
   level_estimator_.UpdateEstimation(vad_prob);
 }
 
+void AdaptiveModeLevelEstimatorAgc::ProcessWithVoiceActivity(
+    const int16_t* audio,
+    size_t length,
+    int sample_rate_hz,
+    bool /*voice_activity*/) {
+  Process(audio, length, sample_rate_hz);
+}
+
 // Retrieves the difference between the target RMS level and the current
 // signal RMS level in dB. Returns true if an update is available and false
 // otherwise, in which case |error| should be ignored and no action taken.
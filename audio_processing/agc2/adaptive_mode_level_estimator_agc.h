@@ -29,6 +29,12 @@ class AdaptiveModeLevelEstimatorAgc : public Agc {
   void Process(const int16_t* audio,
                size_t length,
                int sample_rate_hz) override;
+  // The RNN VAD has no use for a WebRTC VAD decision, hence |voice_activity| is
+  // ignored.
+  void ProcessWithVoiceActivity(const int16_t* audio,
+                                size_t length,
+                                int sample_rate_hz,
+                                bool voice_activity) override;
 
   // Retrieves the difference between the target RMS level and the current
   // signal RMS level in dB. Returns true if an update is available and false
@@ -16,12 +16,55 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
 
 constexpr float kInitialFilterStateLevel = 0.f;
 
+// Returns the maximum of |initial_value| and the absolute values of |x|. The
+// maximum does not depend on the order of the comparisons, so the vectorized
+// versions give the same result as the scalar code.
+float MaxAbs(rtc::ArrayView<const float> x, float initial_value) {
+  float max_abs = initial_value;
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (x.size() >= 4) {
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    __m128 max_v = _mm_set1_ps(initial_value);
+    for (; i + 4 <= x.size(); i += 4) {
+      // The operand order keeps the current maximum for NaN, like std::max.
+      max_v = _mm_max_ps(_mm_andnot_ps(sign_mask, _mm_loadu_ps(&x[i])), max_v);
+    }
+    max_v = _mm_max_ps(max_v, _mm_movehl_ps(max_v, max_v));
+    max_v = _mm_max_ss(max_v, _mm_shuffle_ps(max_v, max_v, 1));
+    max_abs = _mm_cvtss_f32(max_v);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (x.size() >= 4) {
+    float32x4_t max_v = vdupq_n_f32(initial_value);
+    for (; i + 4 <= x.size(); i += 4) {
+      max_v = vmaxq_f32(max_v, vabsq_f32(vld1q_f32(&x[i])));
+    }
+    float32x2_t max_pair = vmax_f32(vget_low_f32(max_v), vget_high_f32(max_v));
+    max_pair = vpmax_f32(max_pair, max_pair);
+    max_abs = vget_lane_f32(max_pair, 0);
+  }
+#endif
+  for (; i < x.size(); ++i) {
+    max_abs = std::max(max_abs, std::abs(x[i]));
+  }
+  return max_abs;
+}
+
 }  // namespace
 
 FixedDigitalLevelEstimator::FixedDigitalLevelEstimator(
@@ -53,13 +96,10 @@ std::array<float, kSubFramesInFrame> FixedDigitalLevelEstimator::ComputeLevel(
        ++channel_idx) {
     const auto channel = float_frame.channel(channel_idx);
     for (size_t sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
-      for (size_t sample_in_sub_frame = 0;
-           sample_in_sub_frame < samples_in_sub_frame_; ++sample_in_sub_frame) {
-        envelope[sub_frame] =
-            std::max(envelope[sub_frame],
-                     std::abs(channel[sub_frame * samples_in_sub_frame_ +
-                                      sample_in_sub_frame]));
-      }
+      envelope[sub_frame] =
+          MaxAbs(channel.subview(sub_frame * samples_in_sub_frame_,
+                                 samples_in_sub_frame_),
+                 envelope[sub_frame]);
     }
   }
 
@@ -19,6 +19,14 @@
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -64,9 +72,34 @@ void ComputePerSampleSubframeFactors(
     const float scaling_start = scaling_factors[i];
     const float scaling_end = scaling_factors[i + 1];
     const float scaling_diff = (scaling_end - scaling_start) / subframe_size;
-    for (size_t j = 0; j < subframe_size; ++j) {
-      per_sample_scaling_factors[subframe_start + j] =
-          scaling_start + scaling_diff * j;
+    float* subframe_factors = &per_sample_scaling_factors[subframe_start];
+    size_t j = 0;
+    // The vectorized ramps compute the same products and sums as the scalar
+    // code, as the sample indices are exactly represented as floats.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    const __m128 start_v = _mm_set1_ps(scaling_start);
+    const __m128 diff_v = _mm_set1_ps(scaling_diff);
+    const __m128 four = _mm_set1_ps(4.f);
+    __m128 j_v = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+    for (; j + 4 <= subframe_size; j += 4) {
+      _mm_storeu_ps(&subframe_factors[j],
+                    _mm_add_ps(start_v, _mm_mul_ps(diff_v, j_v)));
+      j_v = _mm_add_ps(j_v, four);
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    const float32x4_t start_v = vdupq_n_f32(scaling_start);
+    const float32x4_t diff_v = vdupq_n_f32(scaling_diff);
+    const float32x4_t four = vdupq_n_f32(4.f);
+    const float kInitialIndices[4] = {0.f, 1.f, 2.f, 3.f};
+    float32x4_t j_v = vld1q_f32(kInitialIndices);
+    for (; j + 4 <= subframe_size; j += 4) {
+      vst1q_f32(&subframe_factors[j],
+                vaddq_f32(start_v, vmulq_f32(diff_v, j_v)));
+      j_v = vaddq_f32(j_v, four);
+    }
+#endif
+    for (; j < subframe_size; ++j) {
+      subframe_factors[j] = scaling_start + scaling_diff * j;
     }
   }
 }
@@ -77,7 +110,27 @@ void ScaleSamples(rtc::ArrayView<const float> per_sample_scaling_factors,
   RTC_DCHECK_EQ(samples_per_channel, per_sample_scaling_factors.size());
   for (size_t i = 0; i < signal.num_channels(); ++i) {
     auto channel = signal.channel(i);
-    for (size_t j = 0; j < samples_per_channel; ++j) {
+    size_t j = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    const __m128 min_v = _mm_set1_ps(kMinFloatS16Value);
+    const __m128 max_v = _mm_set1_ps(kMaxFloatS16Value);
+    for (; j + 4 <= samples_per_channel; j += 4) {
+      const __m128 scaled =
+          _mm_mul_ps(_mm_loadu_ps(&channel[j]),
+                     _mm_loadu_ps(&per_sample_scaling_factors[j]));
+      // The operand order lets NaN through, like rtc::SafeClamp.
+      _mm_storeu_ps(&channel[j], _mm_min_ps(max_v, _mm_max_ps(min_v, scaled)));
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    const float32x4_t min_v = vdupq_n_f32(kMinFloatS16Value);
+    const float32x4_t max_v = vdupq_n_f32(kMaxFloatS16Value);
+    for (; j + 4 <= samples_per_channel; j += 4) {
+      const float32x4_t scaled = vmulq_f32(
+          vld1q_f32(&channel[j]), vld1q_f32(&per_sample_scaling_factors[j]));
+      vst1q_f32(&channel[j], vminq_f32(vmaxq_f32(scaled, min_v), max_v));
+    }
+#endif
+    for (; j < samples_per_channel; ++j) {
       channel[j] = rtc::SafeClamp(channel[j] * per_sample_scaling_factors[j],
                                   kMinFloatS16Value, kMaxFloatS16Value);
     }
@@ -18,6 +18,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
 #include "modules/audio_processing/agc2/rnn_vad/pitch_info.h"
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -47,7 +48,8 @@ float ComputePitchGainThreshold(int candidate_pitch_period,
 // that of "b" to the frame size (e.g., 16 ms and 20 ms respectively).
 void ComputeSlidingFrameSquareEnergies(
     rtc::ArrayView<const float, kBufSize24kHz> pitch_buf,
-    rtc::ArrayView<float, kMaxPitch24kHz + 1> yy_values);
+    rtc::ArrayView<float, kMaxPitch24kHz + 1> yy_values,
+    const VectorMath& vector_math);
 
 // Given the auto-correlation coefficients stored according to
 // ComputePitchAutoCorrelation() (i.e., using inverted lags), returns the best
@@ -62,14 +64,16 @@ std::array<size_t, 2> FindBestPitchPeriods(
 // 48 kHz.
 size_t RefinePitchPeriod48kHz(
     rtc::ArrayView<const float, kBufSize24kHz> pitch_buf,
-    rtc::ArrayView<const size_t, 2> inv_lags);
+    rtc::ArrayView<const size_t, 2> inv_lags,
+    const VectorMath& vector_math);
 
 // Refines the pitch period estimation and compute the pitch gain. Returns the
 // refined pitch estimation data at 48 kHz.
 PitchInfo CheckLowerPitchPeriodsAndComputePitchGain(
     rtc::ArrayView<const float, kBufSize24kHz> pitch_buf,
     int initial_pitch_period_48kHz,
-    PitchInfo prev_pitch_48kHz);
+    PitchInfo prev_pitch_48kHz,
+    const VectorMath& vector_math);
 
 }  // namespace rnn_vad
 }  // namespace webrtc
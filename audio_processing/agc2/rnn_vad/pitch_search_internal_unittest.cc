@@ -87,16 +87,21 @@ INSTANTIATE_TEST_SUITE_P(
 // within tolerance given test input data.
 TEST(RnnVadTest, ComputeSlidingFrameSquareEnergiesWithinTolerance) {
   PitchTestData test_data;
-  std::array<float, kNumPitchBufSquareEnergies> computed_output;
-  {
-    // TODO(bugs.webrtc.org/8948): Add when the issue is fixed.
-    // FloatingPointExceptionObserver fpe_observer;
-    ComputeSlidingFrameSquareEnergies(test_data.GetPitchBufView(),
-                                      computed_output);
-  }
   auto square_energies_view = test_data.GetPitchBufSquareEnergiesView();
-  ExpectNearAbsolute({square_energies_view.data(), square_energies_view.size()},
-                     computed_output, 3e-2f);
+  for (Optimization optimization : GetAvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    const VectorMath vector_math(optimization);
+    std::array<float, kNumPitchBufSquareEnergies> computed_output;
+    {
+      // TODO(bugs.webrtc.org/8948): Add when the issue is fixed.
+      // FloatingPointExceptionObserver fpe_observer;
+      ComputeSlidingFrameSquareEnergies(test_data.GetPitchBufView(),
+                                        computed_output, vector_math);
+    }
+    ExpectNearAbsolute(
+        {square_energies_view.data(), square_energies_view.size()},
+        computed_output, 3e-2f);
+  }
 }
 
 // Checks that the estimated pitch period is bit-exact given test input data.
@@ -120,15 +125,19 @@ TEST(RnnVadTest, FindBestPitchPeriodsBitExactness) {
 // Checks that the refined pitch period is bit-exact given test input data.
 TEST(RnnVadTest, RefinePitchPeriod48kHzBitExactness) {
   PitchTestData test_data;
-  size_t pitch_inv_lag;
-  {
-    // TODO(bugs.webrtc.org/8948): Add when the issue is fixed.
-    // FloatingPointExceptionObserver fpe_observer;
-    const std::array<size_t, 2> pitch_candidates_inv_lags = {280, 284};
-    pitch_inv_lag = RefinePitchPeriod48kHz(test_data.GetPitchBufView(),
-                                           pitch_candidates_inv_lags);
+  for (Optimization optimization : GetAvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    const VectorMath vector_math(optimization);
+    size_t pitch_inv_lag;
+    {
+      // TODO(bugs.webrtc.org/8948): Add when the issue is fixed.
+      // FloatingPointExceptionObserver fpe_observer;
+      const std::array<size_t, 2> pitch_candidates_inv_lags = {280, 284};
+      pitch_inv_lag = RefinePitchPeriod48kHz(
+          test_data.GetPitchBufView(), pitch_candidates_inv_lags, vector_math);
+    }
+    EXPECT_EQ(560u, pitch_inv_lag);
   }
-  EXPECT_EQ(560u, pitch_inv_lag);
 }
 
 class CheckLowerPitchPeriodsAndComputePitchGainTest
@@ -151,12 +160,14 @@ TEST_P(CheckLowerPitchPeriodsAndComputePitchGainTest,
   const int expected_pitch_period = std::get<3>(params);
   const float expected_pitch_gain = std::get<4>(params);
   PitchTestData test_data;
-  {
+  for (Optimization optimization : GetAvailableOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    const VectorMath vector_math(optimization);
     // TODO(bugs.webrtc.org/8948): Add when the issue is fixed.
     // FloatingPointExceptionObserver fpe_observer;
     const auto computed_output = CheckLowerPitchPeriodsAndComputePitchGain(
         test_data.GetPitchBufView(), initial_pitch_period,
-        {prev_pitch_period, prev_pitch_gain});
+        {prev_pitch_period, prev_pitch_gain}, vector_math);
     EXPECT_EQ(expected_pitch_period, computed_output.period);
     EXPECT_NEAR(expected_pitch_gain, computed_output.gain, 1e-6f);
   }
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "rtc_base/checks.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -48,17 +49,44 @@ using rnnoise::RectifiedLinearUnit;
 using rnnoise::SigmoidApproximated;
 using rnnoise::TansigApproximated;
 
+namespace {
+
+// Casts the bias terms to float.
+std::vector<float> GetPreprocessedBias(rtc::ArrayView<const int8_t> bias) {
+  return std::vector<float>(bias.begin(), bias.end());
+}
+
+// Casts the weights to float and transposes them from the (input, output)
+// layout of the model to an (output, input) layout, so that the weights of each
+// output unit are contiguous.
+std::vector<float> GetPreprocessedWeights(rtc::ArrayView<const int8_t> weights,
+                                          size_t output_size) {
+  RTC_DCHECK_EQ(0u, weights.size() % output_size);
+  const size_t input_size = weights.size() / output_size;
+  std::vector<float> preprocessed_weights(weights.size());
+  for (size_t o = 0; o < output_size; ++o) {
+    for (size_t i = 0; i < input_size; ++i) {
+      preprocessed_weights[o * input_size + i] = weights[i * output_size + o];
+    }
+  }
+  return preprocessed_weights;
+}
+
+}  // namespace
+
 FullyConnectedLayer::FullyConnectedLayer(
     const size_t input_size,
     const size_t output_size,
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(bias),
-      weights_(weights),
-      activation_function_(activation_function) {
+      bias_(GetPreprocessedBias(bias)),
+      weights_(GetPreprocessedWeights(weights, output_size)),
+      activation_function_(activation_function),
+      vector_math_(optimization) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayersMaxUnits)
       << "Static over-allocation of fully-connected layers output vectors is "
          "not sufficient.";
@@ -75,16 +103,13 @@ rtc::ArrayView<const float> FullyConnectedLayer::GetOutput() const {
 }
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
+  RTC_DCHECK_EQ(input_size_, input.size());
+  rtc::ArrayView<const float> weights(weights_);
   for (size_t o = 0; o < output_size_; ++o) {
-    output_[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| change the performance across different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {
-      output_[o] += input[i] * weights_[i * output_size_ + o];
-    }
-    output_[o] = (*activation_function_)(kWeightsScale * output_[o]);
+    output_[o] = (*activation_function_)(
+        kWeightsScale *
+        (bias_[o] + vector_math_.DotProduct(
+                        input, weights.subview(o * input_size_, input_size_))));
   }
 }
 
@@ -94,13 +119,18 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
-      bias_(bias),
-      weights_(weights),
-      recurrent_weights_(recurrent_weights),
-      activation_function_(activation_function) {
+      bias_(GetPreprocessedBias(bias)),
+      weights_(GetPreprocessedWeights(weights, 3 * output_size)),
+      // Only the weights of the first |output_size| recurrent inputs are used.
+      recurrent_weights_(GetPreprocessedWeights(
+          recurrent_weights.subview(0, 3 * output_size * output_size),
+          3 * output_size)),
+      activation_function_(activation_function),
+      vector_math_(optimization) {
   RTC_DCHECK_LE(output_size_, kRecurrentLayersMaxUnits)
       << "Static over-allocation of recurrent layers state vectors is not "
       << "sufficient.";
@@ -108,7 +138,7 @@ GatedRecurrentLayer::GatedRecurrentLayer(
       << "Mismatching output size and bias terms array size.";
   RTC_DCHECK_EQ(3 * input_size_ * output_size_, weights_.size())
       << "Mismatching input-output size and weight coefficients array size.";
-  RTC_DCHECK_EQ(3 * input_size_ * output_size_, recurrent_weights_.size())
+  RTC_DCHECK_EQ(3 * input_size_ * output_size_, recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
       << " size.";
   Reset();
@@ -125,56 +155,51 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
-  // Stride and offset used to read parameter arrays.
-  const size_t stride = 3 * output_size_;
+  RTC_DCHECK_EQ(input_size_, input.size());
+  rtc::ArrayView<const float> weights(weights_);
+  rtc::ArrayView<const float> recurrent_weights(recurrent_weights_);
+  rtc::ArrayView<const float> state(state_.data(), output_size_);
+  // Offset used to read the parameters of the current gate.
   size_t offset = 0;
 
+  // Computes the weighted sum of the input and of |recurrent_input| for the
+  // |o|-th unit of the current gate.
+  auto weighted_sum = [&](size_t o,
+                          rtc::ArrayView<const float> recurrent_input) {
+    const size_t unit = offset + o;
+    return bias_[unit] +
+           vector_math_.DotProduct(
+               input, weights.subview(unit * input_size_, input_size_)) +
+           vector_math_.DotProduct(
+               recurrent_input,
+               recurrent_weights.subview(unit * output_size_, output_size_));
+  };
+
   // Compute update gates.
   std::array<float, kRecurrentLayersMaxUnits> update;
   for (size_t o = 0; o < output_size_; ++o) {
-    update[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| and |recurrent_weights_| change the performance across
-    // different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      update[o] += input[i] * weights_[i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {
-      update[o] += state_[s] * recurrent_weights_[s * stride + o];
-    }  // Add state.
-    update[o] = SigmoidApproximated(kWeightsScale * update[o]);
+    update[o] = SigmoidApproximated(kWeightsScale * weighted_sum(o, state));
   }
 
   // Compute reset gates.
   offset += output_size_;
   std::array<float, kRecurrentLayersMaxUnits> reset;
   for (size_t o = 0; o < output_size_; ++o) {
-    reset[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      reset[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {  // Add state.
-      reset[o] += state_[s] * recurrent_weights_[offset + s * stride + o];
-    }
-    reset[o] = SigmoidApproximated(kWeightsScale * reset[o]);
+    reset[o] = SigmoidApproximated(kWeightsScale * weighted_sum(o, state));
   }
 
-  // Compute output.
+  // Compute output, adding the state through the reset gates.
   offset += output_size_;
+  std::array<float, kRecurrentLayersMaxUnits> reset_state;
+  for (size_t s = 0; s < output_size_; ++s) {
+    reset_state[s] = state_[s] * reset[s];
+  }
+  rtc::ArrayView<const float> reset_state_view(reset_state.data(),
+                                               output_size_);
   std::array<float, kRecurrentLayersMaxUnits> output;
   for (size_t o = 0; o < output_size_; ++o) {
-    output[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      output[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_;
-         ++s) {  // Add state through reset gates.
-      output[o] +=
-          state_[s] * recurrent_weights_[offset + s * stride + o] * reset[s];
-    }
-    output[o] = (*activation_function_)(kWeightsScale * output[o]);
+    output[o] = (*activation_function_)(kWeightsScale *
+                                        weighted_sum(o, reset_state_view));
     // Update output through the update gates.
     output[o] = update[o] * state_[o] + (1.f - update[o]) * output[o];
   }
@@ -184,23 +209,28 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   std::copy(output.begin(), output.end(), state_.begin());
 }
 
-RnnBasedVad::RnnBasedVad()
+RnnBasedVad::RnnBasedVad() : RnnBasedVad(DetectOptimization()) {}
+
+RnnBasedVad::RnnBasedVad(Optimization optimization)
     : input_layer_(kInputLayerInputSize,
                    kInputLayerOutputSize,
                    kInputDenseBias,
                    kInputDenseWeights,
-                   TansigApproximated),
+                   TansigApproximated,
+                   optimization),
       hidden_layer_(kInputLayerOutputSize,
                     kHiddenLayerOutputSize,
                     kHiddenGruBias,
                     kHiddenGruWeights,
                     kHiddenGruRecurrentWeights,
-                    RectifiedLinearUnit),
+                    RectifiedLinearUnit,
+                    optimization),
       output_layer_(kHiddenLayerOutputSize,
                     kOutputLayerOutputSize,
                     kOutputDenseBias,
                     kOutputDenseWeights,
-                    SigmoidApproximated) {
+                    SigmoidApproximated,
+                    optimization) {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_layer_.output_size(), hidden_layer_.input_size())
       << "The input and the hidden layers sizes do not match.";
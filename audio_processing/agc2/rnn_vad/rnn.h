@@ -15,9 +15,11 @@
 #include <sys/types.h>
 
 #include <array>
+#include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -34,14 +36,17 @@ constexpr size_t kFullyConnectedLayersMaxUnits = 24;
 // recurrent layer.
 constexpr size_t kRecurrentLayersMaxUnits = 24;
 
-// Fully-connected layer.
+// Fully-connected layer. The weights are stored as floats, transposed so that
+// those of each output unit are contiguous, in order to compute each output as
+// a vectorized dot product.
 class FullyConnectedLayer {
  public:
   FullyConnectedLayer(const size_t input_size,
                       const size_t output_size,
                       const rtc::ArrayView<const int8_t> bias,
                       const rtc::ArrayView<const int8_t> weights,
-                      float (*const activation_function)(float));
+                      float (*const activation_function)(float),
+                      Optimization optimization);
   FullyConnectedLayer(const FullyConnectedLayer&) = delete;
   FullyConnectedLayer& operator=(const FullyConnectedLayer&) = delete;
   ~FullyConnectedLayer();
@@ -54,15 +59,18 @@ class FullyConnectedLayer {
  private:
   const size_t input_size_;
   const size_t output_size_;
-  const rtc::ArrayView<const int8_t> bias_;
-  const rtc::ArrayView<const int8_t> weights_;
+  const std::vector<float> bias_;
+  const std::vector<float> weights_;
   float (*const activation_function_)(float);
+  const VectorMath vector_math_;
   // The output vector of a recurrent layer has length equal to |output_size_|.
   // However, for efficiency, over-allocation is used.
   std::array<float, kFullyConnectedLayersMaxUnits> output_;
 };
 
-// Recurrent layer with gated recurrent units (GRUs).
+// Recurrent layer with gated recurrent units (GRUs). The weights are stored
+// like those of FullyConnectedLayer, with the update, reset and output gates
+// one after the other.
 class GatedRecurrentLayer {
  public:
   GatedRecurrentLayer(const size_t input_size,
@@ -70,7 +78,8 @@ class GatedRecurrentLayer {
                       const rtc::ArrayView<const int8_t> bias,
                       const rtc::ArrayView<const int8_t> weights,
                       const rtc::ArrayView<const int8_t> recurrent_weights,
-                      float (*const activation_function)(float));
+                      float (*const activation_function)(float),
+                      Optimization optimization);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
   ~GatedRecurrentLayer();
@@ -84,10 +93,11 @@ class GatedRecurrentLayer {
  private:
   const size_t input_size_;
   const size_t output_size_;
-  const rtc::ArrayView<const int8_t> bias_;
-  const rtc::ArrayView<const int8_t> weights_;
-  const rtc::ArrayView<const int8_t> recurrent_weights_;
+  const std::vector<float> bias_;
+  const std::vector<float> weights_;
+  const std::vector<float> recurrent_weights_;
   float (*const activation_function_)(float);
+  const VectorMath vector_math_;
   // The state vector of a recurrent layer has length equal to |output_size_|.
   // However, to avoid dynamic allocation, over-allocation is used.
   std::array<float, kRecurrentLayersMaxUnits> state_;
@@ -97,6 +107,7 @@ class GatedRecurrentLayer {
 class RnnBasedVad {
  public:
   RnnBasedVad();
+  explicit RnnBasedVad(Optimization optimization);
   RnnBasedVad(const RnnBasedVad&) = delete;
   RnnBasedVad& operator=(const RnnBasedVad&) = delete;
   ~RnnBasedVad();
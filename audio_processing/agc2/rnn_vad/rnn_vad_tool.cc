@@ -20,6 +20,7 @@
 #include "modules/audio_processing/agc2/rnn_vad/features_extraction.h"
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 
 ABSL_FLAG(std::string, i, "", "Path to the input wav file");
 ABSL_FLAG(std::string, f, "", "Path to the output features file");
@@ -65,6 +66,10 @@ int main(int argc, char* argv[]) {
   FeaturesExtractor features_extractor;
   std::array<float, kFeatureVectorSize> feature_vector;
   RnnBasedVad rnn_vad;
+  // Time spent in feature extraction and in the RNN.
+  int64_t features_time_us = 0;
+  int64_t rnn_time_us = 0;
+  int num_frames = 0;
 
   // Compute VAD probabilities.
   while (true) {
@@ -79,10 +84,16 @@ int main(int argc, char* argv[]) {
                        samples_10ms_24kHz.data(), samples_10ms_24kHz.size());
 
     // Extract features and feed the RNN.
+    const int64_t features_start_us = rtc::TimeMicros();
     bool is_silence = features_extractor.CheckSilenceComputeFeatures(
         samples_10ms_24kHz, feature_vector);
+    const int64_t rnn_start_us = rtc::TimeMicros();
     float vad_probability =
         rnn_vad.ComputeVadProbability(feature_vector, is_silence);
+    const int64_t rnn_end_us = rtc::TimeMicros();
+    features_time_us += rnn_start_us - features_start_us;
+    rnn_time_us += rnn_end_us - rnn_start_us;
+    ++num_frames;
     // Write voice probability.
     RTC_DCHECK_GE(vad_probability, 0.f);
     RTC_DCHECK_GE(1.f, vad_probability);
@@ -108,6 +119,16 @@ int main(int argc, char* argv[]) {
     RTC_LOG(LS_INFO) << "features written to " << output_feature_file;
   }
 
+  // Report the average processing time per 10 ms frame.
+  if (num_frames > 0) {
+    RTC_LOG(LS_INFO) << "Processed " << num_frames << " frames";
+    RTC_LOG(LS_INFO) << "Feature extraction: "
+                     << static_cast<float>(features_time_us) / num_frames
+                     << " us/frame";
+    RTC_LOG(LS_INFO) << "RNN: " << static_cast<float>(rnn_time_us) / num_frames
+                     << " us/frame";
+  }
+
   return 0;
 }
 
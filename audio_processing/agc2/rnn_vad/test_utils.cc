@@ -12,7 +12,10 @@
 
 #include <memory>
 
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -103,6 +106,22 @@ PitchTestData::GetPitchBufAutoCorrCoeffsView() const {
           kNumPitchBufAutoCorrCoeffs};
 }
 
+std::vector<Optimization> GetAvailableOptimizations() {
+  std::vector<Optimization> optimizations = {Optimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(Optimization::kSse2);
+  }
+  if (GetCpuSupportsAvx2()) {
+    optimizations.push_back(Optimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(Optimization::kNeon);
+#endif
+  return optimizations;
+}
+
 }  // namespace test
 }  // namespace rnn_vad
 }  // namespace webrtc
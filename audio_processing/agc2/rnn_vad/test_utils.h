@@ -130,6 +130,10 @@ CreateLpResidualAndPitchPeriodGainReader();
 std::pair<std::unique_ptr<BinaryFileReader<float>>, const size_t>
 CreateVadProbsReader();
 
+// Returns the optimizations supported by the current CPU, including the
+// non-optimized code path.
+std::vector<Optimization> GetAvailableOptimizations();
+
 constexpr size_t kNumPitchBufAutoCorrCoeffs = 147;
 constexpr size_t kNumPitchBufSquareEnergies = 385;
 constexpr size_t kPitchTestDataSize =
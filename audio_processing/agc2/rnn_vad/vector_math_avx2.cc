@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+// Computes the dot product between two equally sized vectors.
+float VectorMath::DotProductAVX2(rtc::ArrayView<const float> x,
+                                 rtc::ArrayView<const float> y) const {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const size_t x_size = x.size();
+  const size_t vector_limit = x_size & ~static_cast<size_t>(7);
+
+  __m256 accumulator = _mm256_setzero_ps();
+  size_t j = 0;
+  for (; j < vector_limit; j += 8) {
+    const __m256 x_j = _mm256_loadu_ps(&x[j]);
+    const __m256 y_j = _mm256_loadu_ps(&y[j]);
+    accumulator = _mm256_fmadd_ps(x_j, y_j, accumulator);
+  }
+  // Reduce the accumulator to a single value.
+  __m128 sum = _mm_add_ps(_mm256_extractf128_ps(accumulator, 0),
+                          _mm256_extractf128_ps(accumulator, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  float dot_product = _mm_cvtss_f32(sum);
+
+  for (; j < x_size; ++j) {
+    dot_product += x[j] * y[j];
+  }
+  return dot_product;
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
+
+#include <numeric>
+#include <vector>
+
+#include "modules/audio_processing/agc2/rnn_vad/test_utils.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace rnn_vad {
+namespace test {
+
+// Verifies that the optimized dot products match the non-optimized one for
+// vector sizes that are and are not multiples of the SIMD widths.
+TEST(RnnVadTest, VectorMathDotProduct) {
+  Random random_generator(42U);
+  for (size_t size : {1, 3, 4, 7, 8, 13, 24, 42}) {
+    SCOPED_TRACE(size);
+    std::vector<float> x(size);
+    std::vector<float> y(size);
+    for (size_t k = 0; k < size; ++k) {
+      x[k] = 2.f * random_generator.Rand<float>() - 1.f;
+      y[k] = 2.f * random_generator.Rand<float>() - 1.f;
+    }
+    const float expected =
+        std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
+    for (Optimization optimization : GetAvailableOptimizations()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      VectorMath vector_math(optimization);
+      EXPECT_NEAR(expected, vector_math.DotProduct(x, y), 1e-5f);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -97,10 +97,27 @@ AudioBuffer::AudioBuffer(size_t input_num_frames,
     splitting_filter_.reset(new SplittingFilter(
         buffer_num_channels_, num_bands_, buffer_num_frames_));
   }
+
+  split_data_s16_.reset(new ChannelBuffer<int16_t>(
+      buffer_num_frames_, buffer_num_channels_, num_bands_));
+  // Mark all the integer copies as outdated.
+  split_data_s16_version_.resize(buffer_num_channels_, float_data_version_ - 1);
 }
 
 AudioBuffer::~AudioBuffer() {}
 
+bool AudioBuffer::HasFormat(size_t input_rate,
+                            size_t input_num_channels,
+                            size_t buffer_rate,
+                            size_t buffer_num_channels,
+                            size_t output_rate) const {
+  return input_num_frames_ == input_rate / 100 &&
+         input_num_channels_ == input_num_channels &&
+         buffer_num_frames_ == buffer_rate / 100 &&
+         buffer_num_channels_ == buffer_num_channels &&
+         output_num_frames_ == output_rate / 100;
+}
+
 void AudioBuffer::set_downmixing_to_specific_channel(size_t channel) {
   downmix_by_averaging_ = false;
   RTC_DCHECK_GT(input_num_channels_, channel);
@@ -116,6 +133,7 @@ void AudioBuffer::CopyFrom(const float* const* data,
   RTC_DCHECK_EQ(stream_config.num_frames(), input_num_frames_);
   RTC_DCHECK_EQ(stream_config.num_channels(), input_num_channels_);
   RestoreNumChannels();
+  ++float_data_version_;
   const bool downmix_needed = input_num_channels_ > 1 && num_channels_ == 1;
 
   const bool resampling_needed = input_num_frames_ != buffer_num_frames_;
@@ -167,6 +185,7 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
 
   const bool resampling_needed = output_num_frames_ != buffer_num_frames_;
   if (resampling_needed) {
+    ++float_data_version_;
     for (size_t i = 0; i < num_channels_; ++i) {
       FloatS16ToFloat(data_->channels()[i], buffer_num_frames_,
                       data_->channels()[i]);
@@ -226,13 +245,21 @@ void AudioBuffer::set_num_channels(size_t num_channels) {
 
 // The resampler is only for supporting 48kHz to 16kHz in the reverse stream.
 void AudioBuffer::CopyFrom(const AudioFrame* frame) {
-  RTC_DCHECK_EQ(frame->num_channels_, input_num_channels_);
   RTC_DCHECK_EQ(frame->samples_per_channel_, input_num_frames_);
+  CopyFrom(frame->data(),
+           StreamConfig(frame->sample_rate_hz_, frame->num_channels_));
+}
+
+void AudioBuffer::CopyFrom(const int16_t* const interleaved_data,
+                           const StreamConfig& stream_config) {
+  RTC_DCHECK_EQ(stream_config.num_channels(), input_num_channels_);
+  RTC_DCHECK_EQ(stream_config.num_frames(), input_num_frames_);
   RestoreNumChannels();
+  ++float_data_version_;
 
   const bool resampling_required = input_num_frames_ != buffer_num_frames_;
 
-  const int16_t* interleaved = frame->data();
+  const int16_t* interleaved = interleaved_data;
   if (num_channels_ == 1) {
     if (input_num_channels_ == 1) {
       if (resampling_required) {
@@ -298,12 +325,20 @@ void AudioBuffer::CopyFrom(const AudioFrame* frame) {
 }
 
 void AudioBuffer::CopyTo(AudioFrame* frame) const {
-  RTC_DCHECK(frame->num_channels_ == num_channels_ || num_channels_ == 1);
   RTC_DCHECK_EQ(frame->samples_per_channel_, output_num_frames_);
+  CopyTo(StreamConfig(frame->sample_rate_hz_, frame->num_channels_),
+         frame->mutable_data());
+}
+
+void AudioBuffer::CopyTo(const StreamConfig& stream_config,
+                         int16_t* const interleaved_data) const {
+  const size_t config_num_channels = stream_config.num_channels();
+  RTC_DCHECK(config_num_channels == num_channels_ || num_channels_ == 1);
+  RTC_DCHECK_EQ(stream_config.num_frames(), output_num_frames_);
 
   const bool resampling_required = buffer_num_frames_ != output_num_frames_;
 
-  int16_t* interleaved = frame->mutable_data();
+  int16_t* interleaved = interleaved_data;
   if (num_channels_ == 1) {
     std::array<float, kMaxSamplesPerChannel> float_buffer;
 
@@ -314,14 +349,14 @@ void AudioBuffer::CopyTo(AudioFrame* frame) const {
     const float* deinterleaved =
         resampling_required ? float_buffer.data() : data_->channels()[0];
 
-    if (frame->num_channels_ == 1) {
+    if (config_num_channels == 1) {
       for (size_t j = 0; j < output_num_frames_; ++j) {
         interleaved[j] = FloatS16ToS16(deinterleaved[j]);
       }
     } else {
       for (size_t i = 0, k = 0; i < output_num_frames_; ++i) {
         float tmp = FloatS16ToS16(deinterleaved[i]);
-        for (size_t j = 0; j < frame->num_channels_; ++j, ++k) {
+        for (size_t j = 0; j < config_num_channels; ++j, ++k) {
           interleaved[k] = tmp;
         }
       }
@@ -342,19 +377,19 @@ void AudioBuffer::CopyTo(AudioFrame* frame) const {
         output_resamplers_[i]->Resample(data_->channels()[i],
                                         buffer_num_frames_, float_buffer.data(),
                                         output_num_frames_);
-        interleave_channel(i, frame->num_channels_, output_num_frames_,
+        interleave_channel(i, config_num_channels, output_num_frames_,
                            float_buffer.data(), interleaved);
       }
     } else {
       for (size_t i = 0; i < num_channels_; ++i) {
-        interleave_channel(i, frame->num_channels_, output_num_frames_,
+        interleave_channel(i, config_num_channels, output_num_frames_,
                            data_->channels()[i], interleaved);
       }
     }
 
-    for (size_t i = num_channels_; i < frame->num_channels_; ++i) {
+    for (size_t i = num_channels_; i < config_num_channels; ++i) {
       for (size_t j = 0, k = i, n = num_channels_; j < output_num_frames_;
-           ++j, k += frame->num_channels_, n += frame->num_channels_) {
+           ++j, k += config_num_channels, n += config_num_channels) {
         interleaved[k] = interleaved[n];
       }
     }
@@ -362,17 +397,29 @@ void AudioBuffer::CopyTo(AudioFrame* frame) const {
 }
 
 void AudioBuffer::SplitIntoFrequencyBands() {
+  ++float_data_version_;
   splitting_filter_->Analysis(data_.get(), split_data_.get());
 }
 
 void AudioBuffer::MergeFrequencyBands() {
+  ++float_data_version_;
   splitting_filter_->Synthesis(split_data_.get(), data_.get());
 }
 
 void AudioBuffer::ExportSplitChannelData(size_t channel,
                                          int16_t* const* split_band_data) {
+  RTC_DCHECK_LT(channel, split_data_s16_version_.size());
+  if (split_data_s16_version_[channel] == float_data_version_) {
+    for (size_t k = 0; k < num_bands(); ++k) {
+      RTC_DCHECK(split_band_data[k]);
+      memcpy(split_band_data[k], split_data_s16_->bands(channel)[k],
+             num_frames_per_band() * sizeof(split_band_data[k][0]));
+    }
+    return;
+  }
+
   for (size_t k = 0; k < num_bands(); ++k) {
-    const float* band_data = split_bands(channel)[k];
+    const float* band_data = split_bands_const(channel)[k];
 
     RTC_DCHECK(split_band_data[k]);
     RTC_DCHECK(band_data);
@@ -385,14 +432,22 @@ void AudioBuffer::ExportSplitChannelData(size_t channel,
 void AudioBuffer::ImportSplitChannelData(
     size_t channel,
     const int16_t* const* split_band_data) {
+  RTC_DCHECK_LT(channel, split_data_s16_version_.size());
+  // The bands are accessed without split_bands() as only this channel is
+  // modified, which keeps the integer copies of the other channels valid.
+  float* const* bands =
+      split_data_.get() ? split_data_->bands(channel) : data_->bands(channel);
   for (size_t k = 0; k < num_bands(); ++k) {
-    float* band_data = split_bands(channel)[k];
+    float* band_data = bands[k];
+    int16_t* band_data_s16 = split_data_s16_->bands(channel)[k];
     RTC_DCHECK(split_band_data[k]);
     RTC_DCHECK(band_data);
     for (size_t i = 0; i < num_frames_per_band(); ++i) {
       band_data[i] = split_band_data[k][i];
+      band_data_s16[i] = split_band_data[k][i];
     }
   }
+  split_data_s16_version_[channel] = float_data_version_;
 }
 
 }  // namespace webrtc
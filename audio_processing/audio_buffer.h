@@ -52,6 +52,15 @@ class AudioBuffer {
   AudioBuffer(const AudioBuffer&) = delete;
   AudioBuffer& operator=(const AudioBuffer&) = delete;
 
+  // Returns true if the buffer matches the format specified with the
+  // constructor arguments, in which case it can be reused instead of creating
+  // a new buffer for that format.
+  bool HasFormat(size_t input_rate,
+                 size_t input_num_channels,
+                 size_t buffer_rate,
+                 size_t buffer_num_channels,
+                 size_t output_rate) const;
+
   // Specify that downmixing should be done by selecting a single channel.
   void set_downmixing_to_specific_channel(size_t channel);
 
@@ -74,7 +83,10 @@ class AudioBuffer {
   // Where:
   // 0 <= channel < |buffer_num_channels_|
   // 0 <= sample < |buffer_num_frames_|
-  float* const* channels() { return data_->channels(); }
+  float* const* channels() {
+    ++float_data_version_;
+    return data_->channels();
+  }
   const float* const* channels_const() const { return data_->channels(); }
 
   // Returns pointer arrays to the bands for a specific channel.
@@ -89,6 +101,7 @@ class AudioBuffer {
                              : data_->bands(channel);
   }
   float* const* split_bands(size_t channel) {
+    ++float_data_version_;
     return split_data_.get() ? split_data_->bands(channel)
                              : data_->bands(channel);
   }
@@ -110,10 +123,14 @@ class AudioBuffer {
 
   // Copies data into the buffer.
   void CopyFrom(const AudioFrame* frame);
+  void CopyFrom(const int16_t* const interleaved_data,
+                const StreamConfig& stream_config);
   void CopyFrom(const float* const* data, const StreamConfig& stream_config);
 
   // Copies data from the buffer.
   void CopyTo(AudioFrame* frame) const;
+  void CopyTo(const StreamConfig& stream_config,
+              int16_t* const interleaved_data) const;
   void CopyTo(const StreamConfig& stream_config, float* const* data);
   void CopyTo(AudioBuffer* buffer) const;
 
@@ -123,7 +140,10 @@ class AudioBuffer {
   // Recombines the frequency bands into a full-band signal.
   void MergeFrequencyBands();
 
-  // Copies the split bands data into the integer two-dimensional array.
+  // Copies the split bands data into the integer two-dimensional array. If the
+  // split bands have not been modified since the last call to
+  // ImportSplitChannelData() for |channel|, the imported integer data is
+  // copied instead of converting the float data.
   void ExportSplitChannelData(size_t channel, int16_t* const* split_band_data);
 
   // Copies the data in the integer two-dimensional array into the split_bands
@@ -165,6 +185,14 @@ class AudioBuffer {
 
   std::unique_ptr<ChannelBuffer<float>> data_;
   std::unique_ptr<ChannelBuffer<float>> split_data_;
+  // Integer copy of the split bands from the last ImportSplitChannelData()
+  // call for each channel. The copy of a channel is only valid while its
+  // version matches |float_data_version_|, which is incremented whenever the
+  // float data may be modified, so that consecutive integer submodules avoid
+  // a float to integer conversion.
+  std::unique_ptr<ChannelBuffer<int16_t>> split_data_s16_;
+  std::vector<size_t> split_data_s16_version_;
+  size_t float_data_version_ = 0;
   std::unique_ptr<SplittingFilter> splitting_filter_;
   std::vector<std::unique_ptr<PushSincResampler>> input_resamplers_;
   std::vector<std::unique_ptr<PushSincResampler>> output_resamplers_;
@@ -88,4 +88,35 @@ TEST(AudioBufferTest, CopyWithResampling) {
   // Verify that energies match.
   EXPECT_NEAR(energy_ab1, energy_ab2 * 32000.f / 48000.f, .01f * energy_ab1);
 }
+
+TEST(AudioBufferTest, ExportAfterImportReturnsImportedOrModifiedData) {
+  AudioBuffer ab(48000, 2, 48000, 2, 48000, 2);
+  ab.SplitIntoFrequencyBands();
+  int16_t data[AudioBuffer::kMaxNumBands][AudioBuffer::kMaxSplitFrameLength];
+  int16_t* bands[AudioBuffer::kMaxNumBands] = {data[0], data[1], data[2]};
+  for (size_t ch = 0; ch < ab.num_channels(); ++ch) {
+    for (size_t k = 0; k < ab.num_bands(); ++k) {
+      for (size_t i = 0; i < ab.num_frames_per_band(); ++i) {
+        data[k][i] = static_cast<int16_t>(100 * ch + 10 * k + i);
+      }
+    }
+    ab.ImportSplitChannelData(ch, bands);
+  }
+
+  // The exported data matches the imported data for all channels.
+  for (size_t ch = 0; ch < ab.num_channels(); ++ch) {
+    ab.ExportSplitChannelData(ch, bands);
+    for (size_t k = 0; k < ab.num_bands(); ++k) {
+      for (size_t i = 0; i < ab.num_frames_per_band(); ++i) {
+        EXPECT_EQ(100 * ch + 10 * k + i, static_cast<size_t>(data[k][i]));
+      }
+    }
+  }
+
+  // Modifications of the float data are reflected by the exported data.
+  ab.split_bands(1)[0][0] = -1.f;
+  ab.ExportSplitChannelData(1, bands);
+  EXPECT_EQ(-1, data[0][0]);
+  EXPECT_EQ(101, data[0][1]);
+}
 }  // namespace webrtc
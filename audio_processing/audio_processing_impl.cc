@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -38,11 +39,13 @@
 #include "modules/audio_processing/noise_suppression.h"
 #include "modules/audio_processing/residual_echo_detector.h"
 #include "modules/audio_processing/transient/transient_suppressor.h"
+#include "modules/audio_processing/utility/channel_group_runner.h"
 #include "modules/audio_processing/voice_detection.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -61,6 +64,14 @@ namespace webrtc {
 
 constexpr int AudioProcessing::kNativeSampleRatesHz[];
 constexpr int kRuntimeSettingQueueSize = 100;
+// Number of audio buffers kept for reuse after a reinitialization. Allows the
+// buffers of two complete render and capture formats to be kept.
+constexpr size_t kMaxNumReleasedAudioBuffers = 6;
+// Maximum number of capture channels that are processed serially, and maximum
+// number of channel groups that are processed in parallel, when
+// |pipeline.parallel_capture_channels| is set.
+constexpr size_t kMaxNumSerialCaptureChannels = 4;
+constexpr size_t kMaxNumCaptureChannelGroups = 4;
 
 namespace {
 
@@ -136,10 +147,30 @@ GainControl::Mode Agc1ConfigModeToInterfaceMode(
 static const size_t kMaxAllowedValuesOfSamplesPerBand = 160;
 static const size_t kMaxAllowedValuesOfSamplesPerFrame = 480;
 
+// Maximum number of 10 ms chunks in a capture AudioFrame.
+static const size_t kMaxNumChunksPerFrame = 2;
+
 // Maximum number of frames to buffer in the render queue.
 // TODO(peah): Decrease this once we properly handle hugely unbalanced
 // reverse and forward call numbers.
 static const size_t kMaxNumFramesToBuffer = 100;
+
+// Maximum number of channels and frames of the render frames stored for later
+// analysis in the wait-free render mode.
+static const size_t kMaxNumDeferredRenderChannels = 8;
+static const size_t kMaxNumDeferredRenderFrames = 20;
+
+bool CanDeferRenderFrame(size_t num_channels, size_t num_frames) {
+  return num_channels > 0 && num_channels <= kMaxNumDeferredRenderChannels &&
+         num_frames <= kMaxAllowedValuesOfSamplesPerFrame;
+}
+
+bool IsNativeRate(int sample_rate_hz) {
+  return sample_rate_hz == AudioProcessing::kSampleRate8kHz ||
+         sample_rate_hz == AudioProcessing::kSampleRate16kHz ||
+         sample_rate_hz == AudioProcessing::kSampleRate32kHz ||
+         sample_rate_hz == AudioProcessing::kSampleRate48kHz;
+}
 }  // namespace
 
 // Throughout webrtc, it's assumed that success is represented by zero.
@@ -212,16 +243,17 @@ bool AudioProcessingImpl::ApmSubmoduleStates::
 
 bool AudioProcessingImpl::ApmSubmoduleStates::CaptureMultiBandProcessingActive(
     bool ec_processing_active) const {
-  return high_pass_filter_enabled_ || echo_canceller_enabled_ ||
-         mobile_echo_controller_enabled_ || noise_suppressor_enabled_ ||
-         adaptive_gain_controller_enabled_ ||
+  return (high_pass_filter_enabled_ &&
+          !CaptureFullBandHighPassFilterActive()) ||
+         echo_canceller_enabled_ || mobile_echo_controller_enabled_ ||
+         noise_suppressor_enabled_ || adaptive_gain_controller_enabled_ ||
          (echo_controller_enabled_ && ec_processing_active);
 }
 
 bool AudioProcessingImpl::ApmSubmoduleStates::CaptureFullBandProcessingActive()
     const {
   return gain_controller2_enabled_ || capture_post_processor_enabled_ ||
-         pre_amplifier_enabled_;
+         pre_amplifier_enabled_ || CaptureFullBandHighPassFilterActive();
 }
 
 bool AudioProcessingImpl::ApmSubmoduleStates::CaptureAnalyzerActive() const {
@@ -251,6 +283,14 @@ bool AudioProcessingImpl::ApmSubmoduleStates::HighPassFilteringRequired()
          mobile_echo_controller_enabled_ || noise_suppressor_enabled_;
 }
 
+bool AudioProcessingImpl::ApmSubmoduleStates::
+    CaptureFullBandHighPassFilterActive() const {
+  return high_pass_filter_enabled_ && !echo_canceller_enabled_ &&
+         !mobile_echo_controller_enabled_ && !noise_suppressor_enabled_ &&
+         !adaptive_gain_controller_enabled_ && !echo_controller_enabled_ &&
+         !voice_detector_enabled_ && !transient_suppressor_enabled_;
+}
+
 struct AudioProcessingImpl::ApmPublicSubmodules {
   ApmPublicSubmodules() {}
   // Historically accessed externally of APM without any lock acquired.
@@ -287,6 +327,7 @@ struct AudioProcessingImpl::ApmPrivateSubmodules {
   std::unique_ptr<CustomAudioAnalyzer> capture_analyzer;
   std::unique_ptr<LevelEstimator> output_level_estimator;
   std::unique_ptr<VoiceDetection> voice_detector;
+  std::unique_ptr<ChannelGroupRunner> capture_channel_group_runner;
 };
 
 AudioProcessingBuilder::AudioProcessingBuilder() = default;
@@ -399,6 +440,8 @@ AudioProcessingImpl::AudioProcessingImpl(
   capture_nonlocked_.echo_controller_enabled =
       static_cast<bool>(echo_control_factory_);
 
+  released_audio_buffers_.reserve(kMaxNumReleasedAudioBuffers);
+
   public_submodules_->gain_control.reset(new GainControlImpl());
   public_submodules_->gain_control_for_experimental_agc.reset(
       new GainControlForExperimentalAgc(
@@ -425,6 +468,11 @@ AudioProcessingImpl::AudioProcessingImpl(
 }
 
 AudioProcessingImpl::~AudioProcessingImpl() {
+  if (render_analysis_thread_) {
+    stop_render_analysis_.store(true, std::memory_order_release);
+    render_analysis_event_.Set();
+    render_analysis_thread_->Stop();
+  }
   // Depends on gain_control_ and
   // public_submodules_->gain_control_for_experimental_agc.
   private_submodules_->agc_manager.reset();
@@ -480,53 +528,68 @@ int AudioProcessingImpl::MaybeInitializeRender(
 int AudioProcessingImpl::InitializeLocked() {
   UpdateActiveSubmoduleStates();
 
+  // Release the current buffers before acquiring the new ones so that the
+  // buffers whose format is unchanged are reused.
+  ReleaseAudioBuffer(std::move(render_.render_audio));
+  ReleaseAudioBuffer(std::move(capture_.capture_audio));
+  ReleaseAudioBuffer(std::move(capture_.capture_fullband_audio));
+
   const int render_audiobuffer_sample_rate_hz =
       formats_.api_format.reverse_output_stream().num_frames() == 0
           ? formats_.render_processing_format.sample_rate_hz()
           : formats_.api_format.reverse_output_stream().sample_rate_hz();
   if (formats_.api_format.reverse_input_stream().num_channels() > 0) {
-    render_.render_audio.reset(new AudioBuffer(
+    render_.render_audio = AcquireAudioBuffer(
         formats_.api_format.reverse_input_stream().sample_rate_hz(),
         formats_.api_format.reverse_input_stream().num_channels(),
         formats_.render_processing_format.sample_rate_hz(),
         formats_.render_processing_format.num_channels(),
         render_audiobuffer_sample_rate_hz,
-        formats_.render_processing_format.num_channels()));
-    if (formats_.api_format.reverse_input_stream() !=
-        formats_.api_format.reverse_output_stream()) {
-      render_.render_converter = AudioConverter::Create(
-          formats_.api_format.reverse_input_stream().num_channels(),
-          formats_.api_format.reverse_input_stream().num_frames(),
-          formats_.api_format.reverse_output_stream().num_channels(),
-          formats_.api_format.reverse_output_stream().num_frames());
+        formats_.render_processing_format.num_channels());
+    const StreamConfig& reverse_input =
+        formats_.api_format.reverse_input_stream();
+    const StreamConfig& reverse_output =
+        formats_.api_format.reverse_output_stream();
+    if (reverse_input != reverse_output) {
+      const bool converter_reusable =
+          render_.render_converter &&
+          render_.render_converter->src_channels() ==
+              reverse_input.num_channels() &&
+          render_.render_converter->src_frames() ==
+              reverse_input.num_frames() &&
+          render_.render_converter->dst_channels() ==
+              reverse_output.num_channels() &&
+          render_.render_converter->dst_frames() == reverse_output.num_frames();
+      if (!converter_reusable) {
+        render_.render_converter = AudioConverter::Create(
+            reverse_input.num_channels(), reverse_input.num_frames(),
+            reverse_output.num_channels(), reverse_output.num_frames());
+      }
     } else {
       render_.render_converter.reset(nullptr);
     }
   } else {
-    render_.render_audio.reset(nullptr);
     render_.render_converter.reset(nullptr);
   }
 
-  capture_.capture_audio.reset(new AudioBuffer(
+  capture_.capture_audio = AcquireAudioBuffer(
       formats_.api_format.input_stream().sample_rate_hz(),
       formats_.api_format.input_stream().num_channels(),
       capture_nonlocked_.capture_processing_format.sample_rate_hz(),
       formats_.api_format.output_stream().num_channels(),
       formats_.api_format.output_stream().sample_rate_hz(),
-      formats_.api_format.output_stream().num_channels()));
+      formats_.api_format.output_stream().num_channels());
 
   if (capture_nonlocked_.capture_processing_format.sample_rate_hz() <
           formats_.api_format.output_stream().sample_rate_hz() &&
       formats_.api_format.output_stream().sample_rate_hz() == 48000) {
-    capture_.capture_fullband_audio.reset(
-        new AudioBuffer(formats_.api_format.input_stream().sample_rate_hz(),
-                        formats_.api_format.input_stream().num_channels(),
-                        formats_.api_format.output_stream().sample_rate_hz(),
-                        formats_.api_format.output_stream().num_channels(),
-                        formats_.api_format.output_stream().sample_rate_hz(),
-                        formats_.api_format.output_stream().num_channels()));
-  } else {
-    capture_.capture_fullband_audio.reset();
+    capture_.capture_fullband_audio =
+        AcquireAudioBuffer(formats_.api_format.input_stream().sample_rate_hz(),
+                           formats_.api_format.input_stream().num_channels(),
+                           formats_.api_format.output_stream().sample_rate_hz(),
+                           formats_.api_format.output_stream().num_channels(),
+                           formats_.api_format.output_stream().sample_rate_hz(),
+                           formats_.api_format.output_stream().num_channels());
   }
 
   AllocateRenderQueue();
@@ -548,6 +611,7 @@ int AudioProcessingImpl::InitializeLocked() {
     public_submodules_->gain_control_for_experimental_agc->Initialize();
   }
   InitializeTransient();
+  InitializeCaptureChannelGroupRunner();
   InitializeHighPassFilter();
   InitializeVoiceDetector();
   InitializeResidualEchoDetector();
@@ -698,8 +762,21 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
       config_.noise_suppression.enabled != config.noise_suppression.enabled ||
       config_.noise_suppression.level != config.noise_suppression.level;
 
+  const bool processing_time_measurement_enabled =
+      !config_.pipeline.measure_capture_processing_time &&
+      config.pipeline.measure_capture_processing_time;
+
   config_ = config;
 
+  if (processing_time_measurement_enabled) {
+    capture_processing_times_.capture.Reset();
+    capture_processing_times_.band_split.Reset();
+    capture_processing_times_.high_pass_filter.Reset();
+    capture_processing_times_.noise_suppression.Reset();
+    capture_processing_times_.echo_controller.Reset();
+    capture_processing_times_.gain_controller2.Reset();
+  }
+
   if (aec_config_changed) {
     InitializeEchoController();
   }
@@ -709,6 +786,7 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
   }
 
   InitializeHighPassFilter();
+  InitializeCaptureChannelGroupRunner();
 
   RTC_LOG(LS_INFO) << "Highpass filter activated: "
                    << config_.high_pass_filter.enabled;
@@ -728,6 +806,7 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
   InitializeGainController2();
   InitializePreAmplifier();
   private_submodules_->gain_controller2->ApplyConfig(config_.gain_controller2);
+  ApplyPerformanceTier();
   RTC_LOG(LS_INFO) << "Gain Controller 2 activated: "
                    << config_.gain_controller2.enabled;
   RTC_LOG(LS_INFO) << "Pre-amplifier activated: "
@@ -743,6 +822,30 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
     InitializeVoiceDetector();
   }
 
+  if (config_.pipeline.wait_free_render ||
+      config_.pipeline.asynchronous_render_analysis) {
+    AllocateDeferredRenderQueue();
+  } else {
+    AnalyzeDeferredRenderFrames();
+  }
+  if (config_.pipeline.asynchronous_render_analysis &&
+      !render_analysis_thread_) {
+    // The thread is only stopped in the destructor, as stopping it here would
+    // deadlock with an ongoing analysis waiting for |crit_render_|.
+    render_analysis_thread_ = std::make_unique<rtc::PlatformThread>(
+        &AudioProcessingImpl::RenderAnalysisThreadFunc, this,
+        "apm_render_analysis", rtc::kHighPriority);
+    render_analysis_thread_->Start();
+  }
+  wait_free_render_.store(config_.pipeline.wait_free_render,
+                          std::memory_order_release);
+  async_render_analysis_.store(config_.pipeline.asynchronous_render_analysis,
+                               std::memory_order_release);
+  RTC_LOG(LS_INFO) << "Wait-free render activated: "
+                   << config_.pipeline.wait_free_render;
+  RTC_LOG(LS_INFO) << "Asynchronous render analysis activated: "
+                   << config_.pipeline.asynchronous_render_analysis;
+
   // Reinitialization must happen after all submodule configuration to avoid
   // additional reinitializations on the next capture / render processing call.
   if (pipeline_config_changed) {
@@ -866,6 +969,7 @@ void AudioProcessingImpl::SetRuntimeSetting(RuntimeSetting setting) {
     case RuntimeSetting::Type::kCaptureCompressionGain:
     case RuntimeSetting::Type::kCaptureFixedPostGain:
     case RuntimeSetting::Type::kPlayoutVolumeChange:
+    case RuntimeSetting::Type::kCapturePerformanceTier:
       capture_runtime_settings_enqueuer_.Enqueue(setting);
       return;
   }
@@ -1035,6 +1139,14 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
         capture_.playout_volume = value;
         break;
       }
+      case RuntimeSetting::Type::kCapturePerformanceTier: {
+        int value;
+        setting.GetInt(&value);
+        config_.performance_tier.tier =
+            static_cast<Config::PerformanceTier::Tier>(value);
+        ApplyPerformanceTier();
+        break;
+      }
       case RuntimeSetting::Type::kCustomRenderProcessingRuntimeSetting:
         RTC_NOTREACHED();
         break;
@@ -1045,6 +1157,23 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
   }
 }
 
+void AudioProcessingImpl::ApplyPerformanceTier() {
+  int agc2_vad_frame_interval = 1;
+  switch (config_.performance_tier.tier) {
+    case Config::PerformanceTier::kFull:
+      agc2_vad_frame_interval = 1;
+      break;
+    case Config::PerformanceTier::kReduced:
+      agc2_vad_frame_interval = 2;
+      break;
+    case Config::PerformanceTier::kMinimal:
+      agc2_vad_frame_interval = 4;
+      break;
+  }
+  private_submodules_->gain_controller2->SetVadFrameInterval(
+      agc2_vad_frame_interval);
+}
+
 void AudioProcessingImpl::HandleRenderRuntimeSettings() {
   RuntimeSetting setting;
   while (render_runtime_settings_.Remove(&setting)) {
@@ -1061,6 +1190,7 @@ void AudioProcessingImpl::HandleRenderRuntimeSettings() {
       case RuntimeSetting::Type::kCaptureCompressionGain:  // fall-through
       case RuntimeSetting::Type::kCaptureFixedPostGain:    // fall-through
       case RuntimeSetting::Type::kPlayoutVolumeChange:     // fall-through
+      case RuntimeSetting::Type::kCapturePerformanceTier:  // fall-through
       case RuntimeSetting::Type::kNotSpecified:
         RTC_NOTREACHED();
         break;
@@ -1078,10 +1208,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
                                                 num_reverse_channels(),
                                                 &aec_render_queue_buffer_);
 
-    if (!aec_render_signal_queue_->Insert(&aec_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
+    if (!aec_render_signal_queue_->Insert(&aec_render_queue_buffer_) &&
+        HandleFullRenderQueue()) {
       // Retry the insert (should always work).
       bool result = aec_render_signal_queue_->Insert(&aec_render_queue_buffer_);
       RTC_DCHECK(result);
@@ -1094,10 +1222,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
                                                  &aecm_render_queue_buffer_);
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
-    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
+    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_) &&
+        HandleFullRenderQueue()) {
       // Retry the insert (should always work).
       bool result =
           aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
@@ -1108,10 +1234,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
   if (!constants_.use_experimental_agc) {
     GainControlImpl::PackRenderAudioBuffer(audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
-    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
+    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_) &&
+        HandleFullRenderQueue()) {
       // Retry the insert (should always work).
       bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
       RTC_DCHECK(result);
@@ -1123,16 +1247,24 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
   ResidualEchoDetector::PackRenderAudioBuffer(audio, &red_render_queue_buffer_);
 
   // Insert the samples into the queue.
-  if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-    // The data queue is full and needs to be emptied.
-    EmptyQueuedRenderAudio();
-
+  if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_) &&
+      HandleFullRenderQueue()) {
     // Retry the insert (should always work).
     bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
     RTC_DCHECK(result);
   }
 }
 
+bool AudioProcessingImpl::HandleFullRenderQueue() {
+  if (wait_free_render_.load(std::memory_order_relaxed)) {
+    ++num_dropped_render_frames_;
+    return false;
+  }
+  // The data queue is full and needs to be emptied.
+  EmptyQueuedRenderAudio();
+  return true;
+}
+
 void AudioProcessingImpl::AllocateRenderQueue() {
   const size_t new_agc_render_queue_element_max_size =
       std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerBand);
@@ -1270,35 +1402,72 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   }
 
   rtc::CritScope cs_capture(&crit_capture_);
-  if (frame->samples_per_channel_ !=
-      formats_.api_format.input_stream().num_frames()) {
+  // Frames spanning several 10 ms chunks are processed chunk by chunk.
+  const StreamConfig& stream_config = formats_.api_format.input_stream();
+  const size_t chunk_size = stream_config.num_frames();
+  if (frame->samples_per_channel_ % chunk_size != 0 ||
+      frame->samples_per_channel_ < chunk_size ||
+      frame->samples_per_channel_ > kMaxNumChunksPerFrame * chunk_size) {
     return kBadDataLengthError;
   }
+  const size_t num_chunks = frame->samples_per_channel_ / chunk_size;
+  const size_t chunk_length = chunk_size * stream_config.num_channels();
 
-  if (aec_dump_) {
-    RecordUnprocessedCaptureStream(*frame);
-  }
+  const bool copy_output =
+      submodule_states_.CaptureMultiBandProcessingPresent() ||
+      submodule_states_.CaptureFullBandProcessingActive();
+  bool voice_detected = false;
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    const int16_t* const chunk_input = frame->data() + chunk * chunk_length;
 
-  capture_.capture_audio->CopyFrom(frame);
-  if (capture_.capture_fullband_audio) {
-    capture_.capture_fullband_audio->CopyFrom(frame);
-  }
-  RETURN_ON_ERR(ProcessCaptureStreamLocked());
-  if (submodule_states_.CaptureMultiBandProcessingPresent() ||
-      submodule_states_.CaptureFullBandProcessingActive()) {
+    // The unprocessed and processed audio is dumped in 10 ms chunks, as
+    // expected by the tools reading the dumps.
+    std::unique_ptr<AudioFrame> dump_frame;
+    if (aec_dump_) {
+      if (num_chunks == 1) {
+        RecordUnprocessedCaptureStream(*frame);
+      } else {
+        dump_frame = std::make_unique<AudioFrame>();
+        dump_frame->UpdateFrame(frame->timestamp_, chunk_input, chunk_size,
+                                frame->sample_rate_hz_, frame->speech_type_,
+                                frame->vad_activity_, frame->num_channels_);
+        RecordUnprocessedCaptureStream(*dump_frame);
+      }
+    }
+
+    capture_.capture_audio->CopyFrom(chunk_input, stream_config);
     if (capture_.capture_fullband_audio) {
-      capture_.capture_fullband_audio->CopyTo(frame);
-    } else {
-      capture_.capture_audio->CopyTo(frame);
+      capture_.capture_fullband_audio->CopyFrom(chunk_input, stream_config);
+    }
+    RETURN_ON_ERR(ProcessCaptureStreamLocked());
+    if (copy_output) {
+      int16_t* const chunk_output =
+          frame->mutable_data() + chunk * chunk_length;
+      if (capture_.capture_fullband_audio) {
+        capture_.capture_fullband_audio->CopyTo(stream_config, chunk_output);
+      } else {
+        capture_.capture_audio->CopyTo(stream_config, chunk_output);
+      }
+    }
+    if (capture_.stats.voice_detected) {
+      voice_detected = voice_detected || *capture_.stats.voice_detected;
+    }
+
+    if (dump_frame) {
+      dump_frame->UpdateFrame(frame->timestamp_,
+                              frame->data() + chunk * chunk_length,
+                              chunk_size, frame->sample_rate_hz_,
+                              frame->speech_type_, frame->vad_activity_,
+                              frame->num_channels_);
+      RecordProcessedCaptureStream(*dump_frame);
     }
   }
   if (capture_.stats.voice_detected) {
-    frame->vad_activity_ = *capture_.stats.voice_detected
-                               ? AudioFrame::kVadActive
-                               : AudioFrame::kVadPassive;
+    frame->vad_activity_ =
+        voice_detected ? AudioFrame::kVadActive : AudioFrame::kVadPassive;
   }
 
-  if (aec_dump_) {
+  if (aec_dump_ && num_chunks == 1) {
     RecordProcessedCaptureStream(*frame);
   }
 
@@ -1306,6 +1475,21 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
 }
 
 int AudioProcessingImpl::ProcessCaptureStreamLocked() {
+  const bool measure_time = config_.pipeline.measure_capture_processing_time;
+  ProcessingTimeMeasurement capture_time(&capture_processing_times_.capture,
+                                         measure_time);
+  ProcessingTimeMeasurement::ScopedSection capture_section(&capture_time);
+  ProcessingTimeMeasurement band_split_time(
+      &capture_processing_times_.band_split, measure_time);
+  ProcessingTimeMeasurement high_pass_filter_time(
+      &capture_processing_times_.high_pass_filter, measure_time);
+  ProcessingTimeMeasurement noise_suppression_time(
+      &capture_processing_times_.noise_suppression, measure_time);
+  ProcessingTimeMeasurement echo_controller_time(
+      &capture_processing_times_.echo_controller, measure_time);
+  ProcessingTimeMeasurement gain_controller2_time(
+      &capture_processing_times_.gain_controller2, measure_time);
+
   HandleCaptureRuntimeSettings();
 
   // Ensure that not both the AEC and AECM are active at the same time.
@@ -1318,6 +1502,21 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
 
   AudioBuffer* capture_buffer = capture_.capture_audio.get();  // For brevity.
 
+  // The submodules reduced by the performance tier, see
+  // AudioProcessing::Config::PerformanceTier.
+  const Config::PerformanceTier::Tier performance_tier =
+      config_.performance_tier.tier;
+  NoiseSuppression* const noise_suppressor =
+      performance_tier == Config::PerformanceTier::kMinimal
+          ? nullptr
+          : private_submodules_->noise_suppressor.get();
+  const bool analyze_residual_echo =
+      config_.residual_echo_detector.enabled &&
+      performance_tier == Config::PerformanceTier::kFull;
+  const bool suppress_transients =
+      capture_.transient_suppressor_enabled &&
+      performance_tier == Config::PerformanceTier::kFull;
+
   if (private_submodules_->pre_amplifier) {
     private_submodules_->pre_amplifier->ApplyGain(AudioFrameView<float>(
         capture_buffer->channels(), capture_buffer->num_channels(),
@@ -1362,6 +1561,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
          capture_.prev_playout_volume >= 0);
     capture_.prev_playout_volume = capture_.playout_volume;
 
+    ProcessingTimeMeasurement::ScopedSection section(&echo_controller_time);
     private_submodules_->echo_controller->AnalyzeCapture(capture_buffer);
   }
 
@@ -1382,6 +1582,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodule_states_.CaptureMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
+    ProcessingTimeMeasurement::ScopedSection section(&band_split_time);
     capture_buffer->SplitIntoFrequencyBands();
   }
 
@@ -1397,13 +1598,19 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     capture_buffer->set_num_channels(1);
   }
 
-  if (private_submodules_->high_pass_filter) {
-    private_submodules_->high_pass_filter->Process(capture_buffer);
+  ChannelGroupRunner* const channel_group_runner =
+      private_submodules_->capture_channel_group_runner.get();
+  if (private_submodules_->high_pass_filter &&
+      !submodule_states_.CaptureFullBandHighPassFilterActive()) {
+    ProcessingTimeMeasurement::ScopedSection section(&high_pass_filter_time);
+    private_submodules_->high_pass_filter->Process(
+        capture_buffer, /*use_split_band_data=*/true, channel_group_runner);
   }
   RETURN_ON_ERR(
       public_submodules_->gain_control->AnalyzeCaptureAudio(capture_buffer));
-  if (private_submodules_->noise_suppressor) {
-    private_submodules_->noise_suppressor->AnalyzeCaptureAudio(capture_buffer);
+  if (noise_suppressor) {
+    ProcessingTimeMeasurement::ScopedSection section(&noise_suppression_time);
+    noise_suppressor->AnalyzeCaptureAudio(capture_buffer, channel_group_runner);
   }
 
   if (private_submodules_->echo_control_mobile) {
@@ -1413,11 +1620,12 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
       return AudioProcessing::kStreamParameterNotSetError;
     }
 
-    if (private_submodules_->noise_suppressor) {
+    if (noise_suppressor) {
       private_submodules_->echo_control_mobile->CopyLowPassReference(
           capture_buffer);
-      private_submodules_->noise_suppressor->ProcessCaptureAudio(
-          capture_buffer);
+      ProcessingTimeMeasurement::ScopedSection section(&noise_suppression_time);
+      noise_suppressor->ProcessCaptureAudio(capture_buffer,
+                                            channel_group_runner);
     }
 
     RETURN_ON_ERR(private_submodules_->echo_control_mobile->ProcessCaptureAudio(
@@ -1431,6 +1639,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
             stream_delay_ms());
       }
 
+      ProcessingTimeMeasurement::ScopedSection section(&echo_controller_time);
       private_submodules_->echo_controller->ProcessCapture(
           capture_buffer, capture_.echo_path_gain_change);
     } else if (private_submodules_->echo_cancellation) {
@@ -1444,9 +1653,10 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
           capture_buffer, stream_delay_ms()));
     }
 
-    if (private_submodules_->noise_suppressor) {
-      private_submodules_->noise_suppressor->ProcessCaptureAudio(
-          capture_buffer);
+    if (noise_suppressor) {
+      ProcessingTimeMeasurement::ScopedSection section(&noise_suppression_time);
+      noise_suppressor->ProcessCaptureAudio(capture_buffer,
+                                            channel_group_runner);
     }
   }
 
@@ -1461,9 +1671,16 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (constants_.use_experimental_agc &&
       public_submodules_->gain_control->is_enabled() &&
       !constants_.use_experimental_agc_process_before_aec) {
+    // The voice detection decision of the frame, when shared, spares the AGC
+    // its own VAD run on the same band.
+    const absl::optional<bool> voice_activity =
+        config_.voice_detection.share_with_experimental_agc
+            ? capture_.stats.voice_detected
+            : absl::nullopt;
     private_submodules_->agc_manager->Process(
         capture_buffer->split_bands_const_f(0)[kBand0To8kHz],
-        capture_buffer->num_frames_per_band(), capture_nonlocked_.split_rate);
+        capture_buffer->num_frames_per_band(), capture_nonlocked_.split_rate,
+        voice_activity);
   }
   // TODO(peah): Add reporting from AEC3 whether there is echo.
   RETURN_ON_ERR(public_submodules_->gain_control->ProcessCaptureAudio(
@@ -1474,6 +1691,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodule_states_.CaptureMultiBandProcessingPresent() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
+    ProcessingTimeMeasurement::ScopedSection section(&band_split_time);
     capture_buffer->MergeFrequencyBands();
   }
 
@@ -1488,7 +1706,14 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     capture_buffer = capture_.capture_fullband_audio.get();
   }
 
-  if (config_.residual_echo_detector.enabled) {
+  if (private_submodules_->high_pass_filter &&
+      submodule_states_.CaptureFullBandHighPassFilterActive()) {
+    ProcessingTimeMeasurement::ScopedSection section(&high_pass_filter_time);
+    private_submodules_->high_pass_filter->Process(
+        capture_buffer, /*use_split_band_data=*/false, channel_group_runner);
+  }
+
+  if (analyze_residual_echo) {
     RTC_DCHECK(private_submodules_->echo_detector);
     private_submodules_->echo_detector->AnalyzeCaptureAudio(
         rtc::ArrayView<const float>(capture_buffer->channels()[0],
@@ -1497,7 +1722,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
 
   // TODO(aluebs): Investigate if the transient suppression placement should be
   // before or after the AGC.
-  if (capture_.transient_suppressor_enabled) {
+  if (suppress_transients) {
     float voice_probability =
         private_submodules_->agc_manager.get()
             ? private_submodules_->agc_manager->voice_probability()
@@ -1521,6 +1746,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (config_.gain_controller2.enabled) {
     private_submodules_->gain_controller2->NotifyAnalogLevel(
         agc1()->stream_analog_level());
+    ProcessingTimeMeasurement::ScopedSection section(&gain_controller2_time);
     private_submodules_->gain_controller2->Process(capture_buffer);
   }
 
@@ -1557,7 +1783,6 @@ int AudioProcessingImpl::AnalyzeReverseStream(const float* const* data,
                                               int sample_rate_hz,
                                               ChannelLayout layout) {
   TRACE_EVENT0("webrtc", "AudioProcessing::AnalyzeReverseStream_ChannelLayout");
-  rtc::CritScope cs(&crit_render_);
   const StreamConfig reverse_config = {
       sample_rate_hz,
       ChannelsFromLayout(layout),
@@ -1566,6 +1791,36 @@ int AudioProcessingImpl::AnalyzeReverseStream(const float* const* data,
   if (samples_per_channel != reverse_config.num_frames()) {
     return kBadDataLengthError;
   }
+
+  if (async_render_analysis_.load(std::memory_order_acquire) &&
+      CanDeferRenderFrame(reverse_config.num_channels(),
+                          reverse_config.num_frames())) {
+    if (data == nullptr) {
+      return kNullPointerError;
+    }
+    if (DeferRenderFrame(data, reverse_config)) {
+      render_analysis_event_.Set();
+    }
+    return kNoError;
+  }
+
+  if (wait_free_render_.load(std::memory_order_acquire)) {
+    if (!crit_render_.TryEnter()) {
+      if (data == nullptr) {
+        return kNullPointerError;
+      }
+      DeferRenderFrame(data, reverse_config);
+      return kNoError;
+    }
+    AnalyzeDeferredRenderFrames();
+    const int result =
+        AnalyzeReverseStreamLocked(data, reverse_config, reverse_config);
+    crit_render_.Leave();
+    return result;
+  }
+
+  rtc::CritScope cs(&crit_render_);
+  AnalyzeDeferredRenderFrames();
   return AnalyzeReverseStreamLocked(data, reverse_config, reverse_config);
 }
 
@@ -1574,7 +1829,52 @@ int AudioProcessingImpl::ProcessReverseStream(const float* const* src,
                                               const StreamConfig& output_config,
                                               float* const* dest) {
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessReverseStream_StreamConfig");
+  // Frames needing format conversion cannot be passed through without the
+  // render state, hence they are processed with the lock acquired.
+  const bool can_defer =
+      input_config == output_config &&
+      CanDeferRenderFrame(input_config.num_channels(),
+                          input_config.num_frames());
+  if (async_render_analysis_.load(std::memory_order_acquire) && can_defer) {
+    if (src == nullptr || dest == nullptr) {
+      return kNullPointerError;
+    }
+    if (DeferRenderFrame(src, input_config)) {
+      render_analysis_event_.Set();
+    }
+    CopyAudioIfNeeded(src, input_config.num_frames(),
+                      input_config.num_channels(), dest);
+    return kNoError;
+  }
+
+  if (wait_free_render_.load(std::memory_order_acquire) &&
+      input_config == output_config) {
+    if (!crit_render_.TryEnter()) {
+      if (src == nullptr || dest == nullptr) {
+        return kNullPointerError;
+      }
+      DeferRenderFrame(src, input_config);
+      CopyAudioIfNeeded(src, input_config.num_frames(),
+                        input_config.num_channels(), dest);
+      return kNoError;
+    }
+    AnalyzeDeferredRenderFrames();
+    const int result =
+        ProcessReverseStreamLocked(src, input_config, output_config, dest);
+    crit_render_.Leave();
+    return result;
+  }
+
   rtc::CritScope cs(&crit_render_);
+  AnalyzeDeferredRenderFrames();
+  return ProcessReverseStreamLocked(src, input_config, output_config, dest);
+}
+
+int AudioProcessingImpl::ProcessReverseStreamLocked(
+    const float* const* src,
+    const StreamConfig& input_config,
+    const StreamConfig& output_config,
+    float* const* dest) {
   RETURN_ON_ERR(AnalyzeReverseStreamLocked(src, input_config, output_config));
   if (submodule_states_.RenderMultiBandProcessingActive() ||
       submodule_states_.RenderFullBandProcessingActive()) {
@@ -1627,7 +1927,39 @@ int AudioProcessingImpl::AnalyzeReverseStreamLocked(
 
 int AudioProcessingImpl::ProcessReverseStream(AudioFrame* frame) {
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessReverseStream_AudioFrame");
+  if (async_render_analysis_.load(std::memory_order_acquire) && frame &&
+      CanDeferRenderFrame(frame->num_channels_, frame->samples_per_channel_)) {
+    if (!IsNativeRate(frame->sample_rate_hz_)) {
+      return kBadSampleRateError;
+    }
+    // The frame is passed through unmodified.
+    if (DeferRenderFrame(*frame)) {
+      render_analysis_event_.Set();
+    }
+    return kNoError;
+  }
+
+  if (wait_free_render_.load(std::memory_order_acquire)) {
+    if (!crit_render_.TryEnter()) {
+      if (frame == nullptr) {
+        return kNullPointerError;
+      }
+      // The frame is passed through unmodified.
+      DeferRenderFrame(*frame);
+      return kNoError;
+    }
+    AnalyzeDeferredRenderFrames();
+    const int result = ProcessReverseStreamLocked(frame);
+    crit_render_.Leave();
+    return result;
+  }
+
   rtc::CritScope cs(&crit_render_);
+  AnalyzeDeferredRenderFrames();
+  return ProcessReverseStreamLocked(frame);
+}
+
+int AudioProcessingImpl::ProcessReverseStreamLocked(AudioFrame* frame) {
   if (frame == nullptr) {
     return kNullPointerError;
   }
@@ -1672,6 +2004,104 @@ int AudioProcessingImpl::ProcessReverseStream(AudioFrame* frame) {
   return kNoError;
 }
 
+bool AudioProcessingImpl::DeferRenderFrame(const float* const* src,
+                                           const StreamConfig& config) {
+  const size_t num_frames = config.num_frames();
+  const size_t num_channels = config.num_channels();
+  if (!CanDeferRenderFrame(num_channels, num_frames)) {
+    ++num_dropped_render_frames_;
+    return false;
+  }
+
+  RTC_DCHECK_GE(deferred_render_input_.samples.size(),
+                num_channels * num_frames);
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    std::copy(src[ch], src[ch] + num_frames,
+              &deferred_render_input_.samples[ch * num_frames]);
+  }
+  deferred_render_input_.config = config;
+  if (!deferred_render_queue_->Insert(&deferred_render_input_)) {
+    ++num_dropped_render_frames_;
+    return false;
+  }
+  return true;
+}
+
+bool AudioProcessingImpl::DeferRenderFrame(const AudioFrame& frame) {
+  const size_t num_frames = frame.samples_per_channel_;
+  const size_t num_channels = frame.num_channels_;
+  if (!CanDeferRenderFrame(num_channels, num_frames)) {
+    ++num_dropped_render_frames_;
+    return false;
+  }
+
+  RTC_DCHECK_GE(deferred_render_input_.samples.size(),
+                num_channels * num_frames);
+  const int16_t* const interleaved = frame.data();
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    float* const channel = &deferred_render_input_.samples[ch * num_frames];
+    for (size_t k = 0; k < num_frames; ++k) {
+      channel[k] = S16ToFloat(interleaved[k * num_channels + ch]);
+    }
+  }
+  deferred_render_input_.config =
+      StreamConfig(frame.sample_rate_hz_, num_channels);
+  if (!deferred_render_queue_->Insert(&deferred_render_input_)) {
+    ++num_dropped_render_frames_;
+    return false;
+  }
+  return true;
+}
+
+void AudioProcessingImpl::AnalyzeDeferredRenderFrames() {
+  if (!deferred_render_queue_) {
+    return;
+  }
+
+  const int num_dropped_frames = num_dropped_render_frames_.exchange(0);
+  if (num_dropped_frames > 0) {
+    RTC_LOG(LS_WARNING) << "Dropped " << num_dropped_frames
+                        << " deferred render frames.";
+  }
+
+  while (deferred_render_queue_->Remove(&deferred_render_output_)) {
+    const StreamConfig& config = deferred_render_output_.config;
+    float* channels[kMaxNumDeferredRenderChannels];
+    for (size_t ch = 0; ch < config.num_channels(); ++ch) {
+      channels[ch] = &deferred_render_output_.samples[ch * config.num_frames()];
+    }
+    const int error = AnalyzeReverseStreamLocked(channels, config, config);
+    if (error != kNoError) {
+      RTC_LOG(LS_ERROR) << "Deferred render frame analysis failed: " << error;
+    }
+  }
+}
+
+void AudioProcessingImpl::RenderAnalysisThreadFunc(void* context) {
+  AudioProcessingImpl* apm = static_cast<AudioProcessingImpl*>(context);
+  while (true) {
+    apm->render_analysis_event_.Wait(rtc::Event::kForever);
+    if (apm->stop_render_analysis_.load(std::memory_order_acquire)) {
+      return;
+    }
+    rtc::CritScope cs(&apm->crit_render_);
+    apm->AnalyzeDeferredRenderFrames();
+  }
+}
+
+void AudioProcessingImpl::AllocateDeferredRenderQueue() {
+  if (deferred_render_queue_) {
+    return;
+  }
+  DeferredRenderFrame template_queue_element;
+  template_queue_element.samples.resize(kMaxNumDeferredRenderChannels *
+                                        kMaxAllowedValuesOfSamplesPerFrame);
+  deferred_render_input_ = template_queue_element;
+  deferred_render_output_ = template_queue_element;
+  deferred_render_queue_ = std::make_unique<SwapQueue<DeferredRenderFrame>>(
+      kMaxNumDeferredRenderFrames, template_queue_element);
+}
+
 int AudioProcessingImpl::ProcessRenderStreamLocked() {
   AudioBuffer* render_buffer = render_.render_audio.get();  // For brevity.
 
@@ -1802,10 +2232,24 @@ void AudioProcessingImpl::DetachPlayoutAudioGenerator() {
 AudioProcessingStats AudioProcessingImpl::GetStatistics(
     bool has_remote_tracks) const {
   rtc::CritScope cs_capture(&crit_capture_);
+  AudioProcessingStats stats = capture_.stats;
+  if (config_.pipeline.measure_capture_processing_time) {
+    stats.capture_processing_time =
+        capture_processing_times_.capture.GetStatistics();
+    stats.band_split_processing_time =
+        capture_processing_times_.band_split.GetStatistics();
+    stats.high_pass_filter_processing_time =
+        capture_processing_times_.high_pass_filter.GetStatistics();
+    stats.noise_suppression_processing_time =
+        capture_processing_times_.noise_suppression.GetStatistics();
+    stats.echo_controller_processing_time =
+        capture_processing_times_.echo_controller.GetStatistics();
+    stats.gain_controller2_processing_time =
+        capture_processing_times_.gain_controller2.GetStatistics();
+  }
   if (!has_remote_tracks) {
-    return capture_.stats;
+    return stats;
   }
-  AudioProcessingStats stats = capture_.stats;
   EchoCancellationImpl::Metrics metrics;
   if (private_submodules_->echo_controller) {
     auto ec_metrics = private_submodules_->echo_controller->GetMetrics();
@@ -1862,17 +2306,69 @@ void AudioProcessingImpl::InitializeTransient() {
   }
 }
 
+std::unique_ptr<AudioBuffer> AudioProcessingImpl::AcquireAudioBuffer(
+    int input_rate,
+    size_t input_num_channels,
+    int buffer_rate,
+    size_t buffer_num_channels,
+    int output_rate,
+    size_t output_num_channels) {
+  for (auto it = released_audio_buffers_.rbegin();
+       it != released_audio_buffers_.rend(); ++it) {
+    if ((*it)->HasFormat(input_rate, input_num_channels, buffer_rate,
+                         buffer_num_channels, output_rate)) {
+      std::unique_ptr<AudioBuffer> buffer = std::move(*it);
+      released_audio_buffers_.erase(std::next(it).base());
+      return buffer;
+    }
+  }
+  return std::make_unique<AudioBuffer>(input_rate, input_num_channels,
+                                       buffer_rate, buffer_num_channels,
+                                       output_rate, output_num_channels);
+}
+
+void AudioProcessingImpl::ReleaseAudioBuffer(
+    std::unique_ptr<AudioBuffer> buffer) {
+  if (!buffer) {
+    return;
+  }
+  if (released_audio_buffers_.size() == kMaxNumReleasedAudioBuffers) {
+    released_audio_buffers_.erase(released_audio_buffers_.begin());
+  }
+  released_audio_buffers_.push_back(std::move(buffer));
+}
+
 void AudioProcessingImpl::InitializeHighPassFilter() {
   if (submodule_states_.HighPassFilteringRequired()) {
+    // When no other submodule needs the split bands, the filter runs on the
+    // full-band signal instead of on the lowest band.
+    const int sample_rate_hz =
+        submodule_states_.CaptureFullBandHighPassFilterActive()
+            ? proc_fullband_sample_rate_hz()
+            : proc_split_sample_rate_hz();
     private_submodules_->high_pass_filter.reset(
-        new HighPassFilter(num_proc_channels()));
+        new HighPassFilter(sample_rate_hz, num_proc_channels()));
   } else {
     private_submodules_->high_pass_filter.reset();
   }
 }
 
+void AudioProcessingImpl::InitializeCaptureChannelGroupRunner() {
+  if (config_.pipeline.parallel_capture_channels &&
+      num_proc_channels() > kMaxNumSerialCaptureChannels) {
+    if (!private_submodules_->capture_channel_group_runner) {
+      private_submodules_->capture_channel_group_runner =
+          std::make_unique<ChannelGroupRunner>(kMaxNumCaptureChannelGroups);
+    }
+  } else {
+    private_submodules_->capture_channel_group_runner.reset();
+  }
+}
+
 void AudioProcessingImpl::InitializeVoiceDetector() {
   if (config_.voice_detection.enabled) {
+    // The most aggressive mode, as in the VAD of the experimental AGC, such
+    // that the decisions can be shared with it.
     private_submodules_->voice_detector = std::make_unique<VoiceDetection>(
         proc_split_sample_rate_hz(), VoiceDetection::kVeryLowLikelihood);
   } else {
@@ -2201,4 +2697,6 @@ AudioProcessingImpl::ApmRenderState::ApmRenderState() = default;
 
 AudioProcessingImpl::ApmRenderState::~ApmRenderState() = default;
 
+AudioProcessingImpl::DeferredRenderFrame::DeferredRenderFrame() = default;
+
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_IMPL_H_
 #define MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_IMPL_H_
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <vector>
@@ -21,11 +22,14 @@
 #include "modules/audio_processing/include/aec_dump.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/include/audio_processing_statistics.h"
+#include "modules/audio_processing/processing_time_histogram.h"
 #include "modules/audio_processing/render_queue_item_verifier.h"
 #include "modules/audio_processing/rms_level.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/ignore_wundef.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/swap_queue.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -130,6 +134,13 @@ class AudioProcessingImpl : public AudioProcessing {
   FRIEND_TEST_ALL_PREFIXES(ApmConfiguration, DefaultBehavior);
   FRIEND_TEST_ALL_PREFIXES(ApmConfiguration, ValidConfigBehavior);
   FRIEND_TEST_ALL_PREFIXES(ApmConfiguration, InValidConfigBehavior);
+  // Hold |crit_render_| from another thread to emulate a contending setter.
+  FRIEND_TEST_ALL_PREFIXES(AudioProcessingImplTest,
+                           WaitFreeRenderDefersFramesWhileRenderLockIsHeld);
+  FRIEND_TEST_ALL_PREFIXES(AudioProcessingImplTest,
+                           WaitFreeRenderDropsFramesBeyondQueueCapacity);
+  FRIEND_TEST_ALL_PREFIXES(AudioProcessingImplTest,
+                           ReusesAudioBuffersWhenSwitchingBackToEarlierFormat);
 
   // Class providing thread-safe message pipe functionality for
   // |runtime_settings_|.
@@ -184,6 +195,10 @@ class AudioProcessingImpl : public AudioProcessing {
     bool RenderFullBandProcessingActive() const;
     bool RenderMultiBandProcessingActive() const;
     bool HighPassFilteringRequired() const;
+    // Returns true if the high-pass filter is the only capture submodule that
+    // would need the split bands, in which case it is applied to the full-band
+    // signal and the band splitting is avoided.
+    bool CaptureFullBandHighPassFilterActive() const;
 
    private:
     const bool capture_post_processor_enabled_ = false;
@@ -227,6 +242,8 @@ class AudioProcessingImpl : public AudioProcessing {
   void InitializeResidualEchoDetector()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
   void InitializeHighPassFilter() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
+  void InitializeCaptureChannelGroupRunner()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
   void InitializeVoiceDetector() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
   void InitializeEchoController()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
@@ -247,6 +264,9 @@ class AudioProcessingImpl : public AudioProcessing {
   void HandleRenderRuntimeSettings() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
   void ApplyAgc1Config(const Config::GainController1& agc_config)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
+  // Applies the submodule settings of config_.performance_tier that are not
+  // evaluated per frame.
+  void ApplyPerformanceTier() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
 
   // Returns a direct pointer to the AGC1 submodule: either a GainControlImpl
   // or GainControlForExperimentalAgc instance.
@@ -254,8 +274,25 @@ class AudioProcessingImpl : public AudioProcessing {
   const GainControl* agc1() const;
 
   void EmptyQueuedRenderAudio();
+  // Called when a render signal queue is full. Empties the queues unless in
+  // wait-free render mode, where the render thread must not wait for the
+  // capture lock and the frame is dropped for the full queue instead. Returns
+  // true if the insertion should be retried.
+  bool HandleFullRenderQueue() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
+  // Returns an AudioBuffer with the specified format. A buffer previously
+  // handed to ReleaseAudioBuffer() is reused if it has that format, so that
+  // switching back to an earlier stream format does not allocate.
+  std::unique_ptr<AudioBuffer> AcquireAudioBuffer(int input_rate,
+                                                  size_t input_num_channels,
+                                                  int buffer_rate,
+                                                  size_t buffer_num_channels,
+                                                  int output_rate,
+                                                  size_t output_num_channels)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
+  void ReleaseAudioBuffer(std::unique_ptr<AudioBuffer> buffer)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_capture_);
   void QueueBandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
   void QueueNonbandedRenderAudio(AudioBuffer* audio)
@@ -273,6 +310,27 @@ class AudioProcessingImpl : public AudioProcessing {
                                  const StreamConfig& output_config)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
   int ProcessRenderStreamLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+  int ProcessReverseStreamLocked(const float* const* src,
+                                 const StreamConfig& input_config,
+                                 const StreamConfig& output_config,
+                                 float* const* dest)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+  int ProcessReverseStreamLocked(AudioFrame* frame)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+
+  // Methods for the wait-free render mode and the asynchronous render
+  // analysis, see Config::Pipeline. DeferRenderFrame() is called on the render
+  // thread without any lock. It stores a copy of the frame for later analysis
+  // and returns false if the frame had to be dropped.
+  // AnalyzeDeferredRenderFrames() analyzes the stored frames and is called by
+  // the render analysis thread and by any render call acquiring the lock.
+  bool DeferRenderFrame(const float* const* src, const StreamConfig& config);
+  bool DeferRenderFrame(const AudioFrame& frame);
+  void AnalyzeDeferredRenderFrames()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+  static void RenderAnalysisThreadFunc(void* context);
+  void AllocateDeferredRenderQueue()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_, crit_capture_);
 
   // Collects configuration settings from public and private
   // submodules to be saved as an audioproc::Config message on the
@@ -426,6 +484,11 @@ class AudioProcessingImpl : public AudioProcessing {
     std::unique_ptr<AudioBuffer> render_audio;
   } render_ RTC_GUARDED_BY(crit_render_);
 
+  // Audio buffers kept from earlier initializations for reuse, ordered from
+  // the least to the most recently released.
+  std::vector<std::unique_ptr<AudioBuffer>> released_audio_buffers_
+      RTC_GUARDED_BY(crit_capture_);
+
   std::vector<float> aec_render_queue_buffer_ RTC_GUARDED_BY(crit_render_);
   std::vector<float> aec_capture_queue_buffer_ RTC_GUARDED_BY(crit_capture_);
 
@@ -446,6 +509,17 @@ class AudioProcessingImpl : public AudioProcessing {
   RmsLevel capture_output_rms_ RTC_GUARDED_BY(crit_capture_);
   int capture_rms_interval_counter_ RTC_GUARDED_BY(crit_capture_) = 0;
 
+  // Processing time histograms of the capture side, written by the capture
+  // processing when |pipeline.measure_capture_processing_time| is set.
+  struct CaptureProcessingTimes {
+    ProcessingTimeHistogram capture;
+    ProcessingTimeHistogram band_split;
+    ProcessingTimeHistogram high_pass_filter;
+    ProcessingTimeHistogram noise_suppression;
+    ProcessingTimeHistogram echo_controller;
+    ProcessingTimeHistogram gain_controller2;
+  } capture_processing_times_;
+
   // Lock protection not needed.
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       aec_render_signal_queue_;
@@ -457,6 +531,30 @@ class AudioProcessingImpl : public AudioProcessing {
       agc_render_signal_queue_;
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       red_render_signal_queue_;
+
+  // State for deferring the render analysis. The queue and the render-side
+  // frame are allocated before |wait_free_render_| or |async_render_analysis_|
+  // is first set and are never released, so the render thread may use them
+  // without a lock whenever it reads either flag as true. The render-side frame
+  // is only accessed on the render thread.
+  struct DeferredRenderFrame {
+    DeferredRenderFrame();
+    std::vector<float> samples;
+    StreamConfig config;
+  };
+  std::atomic<bool> wait_free_render_{false};
+  std::atomic<bool> async_render_analysis_{false};
+  std::atomic<int> num_dropped_render_frames_{0};
+  std::unique_ptr<SwapQueue<DeferredRenderFrame>> deferred_render_queue_;
+  DeferredRenderFrame deferred_render_input_;
+  DeferredRenderFrame deferred_render_output_ RTC_GUARDED_BY(crit_render_);
+
+  // Thread running the render analysis in the asynchronous render analysis
+  // mode. It is started when the mode is first enabled and is signaled by
+  // |render_analysis_event_| for each deferred frame.
+  rtc::Event render_analysis_event_;
+  std::atomic<bool> stop_render_analysis_{false};
+  std::unique_ptr<rtc::PlatformThread> render_analysis_thread_;
 };
 
 }  // namespace webrtc
@@ -10,20 +10,31 @@
 
 #include "modules/audio_processing/audio_processing_impl.h"
 
+#include <algorithm>
+#include <cmath>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "api/scoped_refptr.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/test/echo_control_mock.h"
 #include "modules/audio_processing/test/test_utils.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/platform_thread_types.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 namespace {
 
+using ::testing::_;
 using ::testing::Invoke;
 using ::testing::NotNull;
 
@@ -90,13 +101,15 @@ class TestEchoDetector : public EchoDetector {
  public:
   TestEchoDetector()
       : analyze_render_audio_called_(false),
-        last_render_audio_first_sample_(0.f) {}
+        last_render_audio_first_sample_(0.f),
+        num_analyze_capture_audio_calls_(0) {}
   ~TestEchoDetector() override = default;
   void AnalyzeRenderAudio(rtc::ArrayView<const float> render_audio) override {
     last_render_audio_first_sample_ = render_audio[0];
     analyze_render_audio_called_ = true;
   }
   void AnalyzeCaptureAudio(rtc::ArrayView<const float> capture_audio) override {
+    ++num_analyze_capture_audio_calls_;
   }
   void Initialize(int capture_sample_rate_hz,
                   int num_capture_channels,
@@ -111,10 +124,15 @@ class TestEchoDetector : public EchoDetector {
   float last_render_audio_first_sample() const {
     return last_render_audio_first_sample_;
   }
+  // Returns the number of calls to AnalyzeCaptureAudio().
+  int num_analyze_capture_audio_calls() const {
+    return num_analyze_capture_audio_calls_;
+  }
 
  private:
   bool analyze_render_audio_called_;
   float last_render_audio_first_sample_;
+  int num_analyze_capture_audio_calls_;
 };
 
 // Mocks CustomProcessing and applies ProcessSample() to all the samples.
@@ -140,6 +158,62 @@ class TestRenderPreProcessor : public CustomProcessing {
   static constexpr float ProcessSample(float x) { return 2.f * x; }
 };
 
+// Holds a lock on a separate thread during its lifetime. Used to emulate an
+// application thread that holds the render lock of an APM in a setter.
+class LockHolderThread {
+ public:
+  explicit LockHolderThread(rtc::CriticalSection* crit)
+      : crit_(crit), thread_(&Run, this, "lock_holder") {
+    thread_.Start();
+    locked_.Wait(rtc::Event::kForever);
+  }
+  ~LockHolderThread() {
+    release_.Set();
+    thread_.Stop();
+  }
+
+ private:
+  static void Run(void* context) {
+    LockHolderThread* self = static_cast<LockHolderThread*>(context);
+    rtc::CritScope cs(self->crit_);
+    self->locked_.Set();
+    self->release_.Wait(rtc::Event::kForever);
+  }
+
+  rtc::CriticalSection* const crit_;
+  rtc::Event locked_;
+  rtc::Event release_;
+  rtc::PlatformThread thread_;
+};
+
+// Repeatedly applies a config on a separate thread during its lifetime. Used to
+// emulate an application thread contending with the render thread.
+class ConfigSetterThread {
+ public:
+  ConfigSetterThread(AudioProcessing* apm,
+                     const AudioProcessing::Config& config)
+      : apm_(apm), config_(config), thread_(&Run, this, "config_setter") {
+    thread_.Start();
+  }
+  ~ConfigSetterThread() {
+    stop_ = true;
+    thread_.Stop();
+  }
+
+ private:
+  static void Run(void* context) {
+    ConfigSetterThread* self = static_cast<ConfigSetterThread*>(context);
+    while (!self->stop_) {
+      self->apm_->ApplyConfig(self->config_);
+    }
+  }
+
+  AudioProcessing* const apm_;
+  const AudioProcessing::Config config_;
+  std::atomic<bool> stop_{false};
+  rtc::PlatformThread thread_;
+};
+
 }  // namespace
 
 TEST(AudioProcessingImplTest, AudioParameterChangeTriggersInit) {
@@ -400,4 +474,400 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+TEST(AudioProcessingImplTest, PerformanceTierGatesEchoDetectorAtRuntime) {
+  rtc::scoped_refptr<TestEchoDetector> test_echo_detector(
+      new rtc::RefCountedObject<TestEchoDetector>());
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder().SetEchoDetector(test_echo_detector).Create());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.residual_echo_detector.enabled = true;
+  apm->ApplyConfig(apm_config);
+
+  constexpr int16_t kAudioLevel = 1000;
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kNumChannels = 1;
+  AudioFrame frame;
+  InitializeAudioFrame(kSampleRateHz, kNumChannels, &frame);
+  FillFixedFrame(kAudioLevel, &frame);
+
+  ASSERT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  EXPECT_EQ(1, test_echo_detector->num_analyze_capture_audio_calls());
+
+  // The residual echo detector does not analyze the capture audio in the
+  // reduced tier.
+  apm->SetRuntimeSetting(
+      AudioProcessing::RuntimeSetting::CreateCapturePerformanceTier(
+          AudioProcessing::Config::PerformanceTier::kReduced));
+  ASSERT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  EXPECT_EQ(1, test_echo_detector->num_analyze_capture_audio_calls());
+
+  apm->SetRuntimeSetting(
+      AudioProcessing::RuntimeSetting::CreateCapturePerformanceTier(
+          AudioProcessing::Config::PerformanceTier::kFull));
+  ASSERT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  EXPECT_EQ(2, test_echo_detector->num_analyze_capture_audio_calls());
+}
+
+TEST(AudioProcessingImplTest, WaitFreeRenderDefersFramesWhileRenderLockIsHeld) {
+  auto echo_control_factory = std::make_unique<MockEchoControlFactory>();
+  const auto* echo_control_factory_ptr = echo_control_factory.get();
+
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder()
+          .SetEchoControlFactory(std::move(echo_control_factory))
+          .Create());
+  AudioProcessingImpl* apm_impl = static_cast<AudioProcessingImpl*>(apm.get());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.gain_controller1.enabled = false;
+  apm_config.pipeline.wait_free_render = true;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame frame;
+  constexpr int16_t kAudioLevel = 10000;
+  constexpr size_t kSampleRateHz = 48000;
+  constexpr size_t kNumChannels = 2;
+  InitializeAudioFrame(kSampleRateHz, kNumChannels, &frame);
+  FillFixedFrame(kAudioLevel, &frame);
+
+  // The first call initializes APM, which creates the echo controller.
+  MockEchoControl* echo_control_mock = echo_control_factory_ptr->GetNext();
+  EXPECT_CALL(*echo_control_mock, AnalyzeRender(NotNull())).Times(1);
+  EXPECT_EQ(AudioProcessing::Error::kNoError,
+            apm->ProcessReverseStream(&frame));
+  testing::Mock::VerifyAndClearExpectations(echo_control_mock);
+
+  // While the render lock is held, the render calls return without analyzing
+  // the frames and pass the audio through.
+  constexpr int kNumDeferredFrames = 5;
+  {
+    LockHolderThread lock_holder(&apm_impl->crit_render_);
+    EXPECT_CALL(*echo_control_mock, AnalyzeRender(_)).Times(0);
+    for (int k = 0; k < kNumDeferredFrames; ++k) {
+      FillFixedFrame(kAudioLevel, &frame);
+      EXPECT_EQ(AudioProcessing::Error::kNoError,
+                apm->ProcessReverseStream(&frame));
+      EXPECT_EQ(kAudioLevel, frame.data()[0]);
+    }
+    testing::Mock::VerifyAndClearExpectations(echo_control_mock);
+  }
+
+  // The deferred frames are analyzed by the next call acquiring the lock.
+  EXPECT_CALL(*echo_control_mock, AnalyzeRender(NotNull()))
+      .Times(kNumDeferredFrames + 1);
+  EXPECT_EQ(AudioProcessing::Error::kNoError,
+            apm->ProcessReverseStream(&frame));
+}
+
+TEST(AudioProcessingImplTest, WaitFreeRenderDropsFramesBeyondQueueCapacity) {
+  auto echo_control_factory = std::make_unique<MockEchoControlFactory>();
+  const auto* echo_control_factory_ptr = echo_control_factory.get();
+
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder()
+          .SetEchoControlFactory(std::move(echo_control_factory))
+          .Create());
+  AudioProcessingImpl* apm_impl = static_cast<AudioProcessingImpl*>(apm.get());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.gain_controller1.enabled = false;
+  apm_config.pipeline.wait_free_render = true;
+  apm->ApplyConfig(apm_config);
+
+  constexpr int kSampleRateHz = 32000;
+  const StreamConfig stream_config(kSampleRateHz, 1);
+  std::vector<float> render(stream_config.num_frames(), 0.1f);
+  float* channels[] = {render.data()};
+
+  // The first call initializes APM, which creates the echo controller.
+  MockEchoControl* echo_control_mock = echo_control_factory_ptr->GetNext();
+  EXPECT_CALL(*echo_control_mock, AnalyzeRender(NotNull())).Times(1);
+  EXPECT_EQ(AudioProcessing::Error::kNoError,
+            apm->ProcessReverseStream(channels, stream_config, stream_config,
+                                      channels));
+  testing::Mock::VerifyAndClearExpectations(echo_control_mock);
+
+  // The queue holds 200 ms of render audio, the remaining frames are dropped.
+  constexpr int kQueueCapacity = 20;
+  {
+    LockHolderThread lock_holder(&apm_impl->crit_render_);
+    for (int k = 0; k < 2 * kQueueCapacity; ++k) {
+      EXPECT_EQ(AudioProcessing::Error::kNoError,
+                apm->ProcessReverseStream(channels, stream_config,
+                                          stream_config, channels));
+    }
+  }
+
+  EXPECT_CALL(*echo_control_mock, AnalyzeRender(NotNull()))
+      .Times(kQueueCapacity + 1);
+  EXPECT_EQ(AudioProcessing::Error::kNoError,
+            apm->ProcessReverseStream(channels, stream_config, stream_config,
+                                      channels));
+}
+
+TEST(AudioProcessingImplTest,
+     ReusesAudioBuffersWhenSwitchingBackToEarlierFormat) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  AudioProcessingImpl* apm_impl = static_cast<AudioProcessingImpl*>(apm.get());
+  auto capture_audio = [apm_impl]() {
+    rtc::CritScope cs(&apm_impl->crit_capture_);
+    return apm_impl->capture_.capture_audio.get();
+  };
+
+  AudioFrame frame;
+  InitializeAudioFrame(16000, 1, &frame);
+  EXPECT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  const AudioBuffer* const capture_audio_16k = capture_audio();
+
+  // A reinitialization that leaves the capture format unchanged keeps the
+  // buffer.
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.noise_suppression.enabled = true;
+  apm->ApplyConfig(apm_config);
+  EXPECT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  EXPECT_EQ(capture_audio_16k, capture_audio());
+
+  // Switching to another format and back reuses the earlier buffer.
+  InitializeAudioFrame(48000, 2, &frame);
+  EXPECT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  EXPECT_NE(capture_audio_16k, capture_audio());
+  InitializeAudioFrame(16000, 1, &frame);
+  EXPECT_EQ(AudioProcessing::Error::kNoError, apm->ProcessStream(&frame));
+  EXPECT_EQ(capture_audio_16k, capture_audio());
+}
+
+TEST(AudioProcessingImplTest, ParallelCaptureChannelsAreBitExact) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumChannels = 8;
+  constexpr size_t kNumFrames = kSampleRateHz / 100;
+  const StreamConfig stream_config(kSampleRateHz, kNumChannels);
+
+  std::unique_ptr<AudioProcessing> apm[2];
+  for (int k = 0; k < 2; ++k) {
+    apm[k].reset(AudioProcessingBuilder().Create());
+    webrtc::AudioProcessing::Config apm_config;
+    apm_config.high_pass_filter.enabled = true;
+    apm_config.noise_suppression.enabled = true;
+    apm_config.pipeline.parallel_capture_channels = k == 1;
+    apm[k]->ApplyConfig(apm_config);
+  }
+
+  std::vector<std::vector<float>> audio[2];
+  std::vector<float*> channels[2];
+  for (int k = 0; k < 2; ++k) {
+    audio[k].assign(kNumChannels, std::vector<float>(kNumFrames));
+    for (auto& channel : audio[k]) {
+      channels[k].push_back(channel.data());
+    }
+  }
+
+  for (int frame = 0; frame < 50; ++frame) {
+    for (int k = 0; k < 2; ++k) {
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        for (size_t i = 0; i < kNumFrames; ++i) {
+          audio[k][ch][i] =
+              0.5f * std::sin(0.01f * (ch + 1) * (frame * kNumFrames + i)) +
+              0.01f * ((i * 7919 + ch * 104729 + frame) % 101) / 101.f;
+        }
+      }
+      ASSERT_EQ(AudioProcessing::kNoError,
+                apm[k]->ProcessStream(channels[k].data(), stream_config,
+                                      stream_config, channels[k].data()));
+    }
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      ASSERT_EQ(audio[0][ch], audio[1][ch]);
+    }
+  }
+}
+
+TEST(AudioProcessingImplTest, TwentyMsFrameMatchesTwoTenMsFrames) {
+  constexpr int kSampleRateHz = 32000;
+  constexpr size_t kNumChannels = 2;
+  constexpr size_t kChunkSize = kSampleRateHz / 100;
+
+  std::unique_ptr<AudioProcessing> apm[2];
+  for (int k = 0; k < 2; ++k) {
+    apm[k].reset(AudioProcessingBuilder().Create());
+    webrtc::AudioProcessing::Config apm_config;
+    apm_config.high_pass_filter.enabled = true;
+    apm_config.noise_suppression.enabled = true;
+    apm[k]->ApplyConfig(apm_config);
+  }
+
+  AudioFrame long_frame;
+  long_frame.num_channels_ = kNumChannels;
+  long_frame.sample_rate_hz_ = kSampleRateHz;
+  long_frame.samples_per_channel_ = 2 * kChunkSize;
+  AudioFrame short_frame;
+  short_frame.num_channels_ = kNumChannels;
+  short_frame.sample_rate_hz_ = kSampleRateHz;
+  short_frame.samples_per_channel_ = kChunkSize;
+
+  const size_t chunk_length = kChunkSize * kNumChannels;
+  for (int frame = 0; frame < 20; ++frame) {
+    int16_t* long_data = long_frame.mutable_data();
+    for (size_t i = 0; i < 2 * chunk_length; ++i) {
+      long_data[i] = static_cast<int16_t>(
+          10000.f * std::sin(0.003f * (frame * 2 * chunk_length + i)) +
+          (i * 7919 + frame) % 301);
+    }
+    std::vector<int16_t> expected(long_data, long_data + 2 * chunk_length);
+
+    for (size_t chunk = 0; chunk < 2; ++chunk) {
+      std::copy(expected.begin() + chunk * chunk_length,
+                expected.begin() + (chunk + 1) * chunk_length,
+                short_frame.mutable_data());
+      ASSERT_EQ(AudioProcessing::kNoError, apm[0]->ProcessStream(&short_frame));
+      std::copy(short_frame.data(), short_frame.data() + chunk_length,
+                expected.begin() + chunk * chunk_length);
+    }
+    ASSERT_EQ(AudioProcessing::kNoError, apm[1]->ProcessStream(&long_frame));
+
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+                           long_frame.data()));
+  }
+
+  // Frames longer than 20 ms or not made of whole 10 ms chunks are rejected.
+  long_frame.samples_per_channel_ = 3 * kChunkSize;
+  EXPECT_EQ(AudioProcessing::kBadDataLengthError,
+            apm[1]->ProcessStream(&long_frame));
+  long_frame.samples_per_channel_ = kChunkSize + kChunkSize / 2;
+  EXPECT_EQ(AudioProcessing::kBadDataLengthError,
+            apm[1]->ProcessStream(&long_frame));
+}
+
+TEST(AudioProcessingImplTest, ReportsCaptureProcessingTimes) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.high_pass_filter.enabled = true;
+  apm_config.noise_suppression.enabled = true;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame frame;
+  InitializeAudioFrame(32000, 1, &frame);
+  FillFixedFrame(1000, &frame);
+  ASSERT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+  EXPECT_FALSE(apm->GetStatistics(false).capture_processing_time);
+
+  apm_config.pipeline.measure_capture_processing_time = true;
+  apm->ApplyConfig(apm_config);
+  constexpr int kNumFrames = 10;
+  for (int k = 0; k < kNumFrames; ++k) {
+    FillFixedFrame(1000, &frame);
+    ASSERT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+  }
+
+  const AudioProcessingStats stats = apm->GetStatistics(false);
+  ASSERT_TRUE(stats.capture_processing_time);
+  EXPECT_EQ(kNumFrames, stats.capture_processing_time->num_calls);
+  ASSERT_TRUE(stats.band_split_processing_time);
+  EXPECT_EQ(kNumFrames, stats.band_split_processing_time->num_calls);
+  ASSERT_TRUE(stats.high_pass_filter_processing_time);
+  ASSERT_TRUE(stats.noise_suppression_processing_time);
+  EXPECT_LE(stats.noise_suppression_processing_time->p50_ns,
+            stats.noise_suppression_processing_time->max_ns);
+  EXPECT_FALSE(stats.echo_controller_processing_time);
+  EXPECT_FALSE(stats.gain_controller2_processing_time);
+}
+
+TEST(AudioProcessingImplTest, AsynchronousRenderAnalysisOffRenderThread) {
+  auto echo_control_factory = std::make_unique<MockEchoControlFactory>();
+  const auto* echo_control_factory_ptr = echo_control_factory.get();
+
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder()
+          .SetEchoControlFactory(std::move(echo_control_factory))
+          .Create());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.gain_controller1.enabled = false;
+  apm_config.pipeline.asynchronous_render_analysis = true;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame frame;
+  constexpr int16_t kAudioLevel = 10000;
+  constexpr size_t kSampleRateHz = 48000;
+  constexpr size_t kNumChannels = 2;
+  InitializeAudioFrame(kSampleRateHz, kNumChannels, &frame);
+
+  // The echo controller is created when the analysis thread initializes APM
+  // for the render format of the first frame.
+  constexpr int kNumFrames = 10;
+  MockEchoControl* echo_control_mock = echo_control_factory_ptr->GetNext();
+  const rtc::PlatformThreadRef render_thread = rtc::CurrentThreadRef();
+  rtc::Event all_frames_analyzed;
+  int num_analyzed_frames = 0;
+  EXPECT_CALL(*echo_control_mock, AnalyzeRender(NotNull()))
+      .Times(kNumFrames)
+      .WillRepeatedly(Invoke([&](AudioBuffer* render) {
+        EXPECT_FALSE(rtc::IsThreadRefEqual(render_thread,
+                                           rtc::CurrentThreadRef()));
+        if (++num_analyzed_frames == kNumFrames) {
+          all_frames_analyzed.Set();
+        }
+      }));
+
+  for (int k = 0; k < kNumFrames; ++k) {
+    FillFixedFrame(kAudioLevel, &frame);
+    EXPECT_EQ(AudioProcessing::Error::kNoError,
+              apm->ProcessReverseStream(&frame));
+    EXPECT_EQ(kAudioLevel, frame.data()[0]);
+  }
+  EXPECT_TRUE(all_frames_analyzed.Wait(1000));
+}
+
+// Measures the worst-case duration of the render calls while another thread
+// continuously applies configs, with and without the wait-free render mode and
+// the asynchronous render analysis.
+TEST(AudioProcessingImplTest, DISABLED_RenderCallLatencyWithContendingSetter) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumFramesToProcess = 3000;
+  const StreamConfig stream_config(kSampleRateHz, 2);
+
+  const struct {
+    const char* trace;
+    bool wait_free_render;
+    bool asynchronous_render_analysis;
+  } kModes[] = {{"locking", false, false},
+                {"wait_free", true, false},
+                {"asynchronous", false, true}};
+
+  for (const auto& mode : kModes) {
+    std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+    webrtc::AudioProcessing::Config apm_config;
+    apm_config.echo_canceller.enabled = true;
+    apm_config.pipeline.wait_free_render = mode.wait_free_render;
+    apm_config.pipeline.asynchronous_render_analysis =
+        mode.asynchronous_render_analysis;
+    apm->ApplyConfig(apm_config);
+
+    std::vector<float> left(stream_config.num_frames(), 0.1f);
+    std::vector<float> right(stream_config.num_frames(), -0.1f);
+    float* channels[] = {left.data(), right.data()};
+    ASSERT_EQ(AudioProcessing::Error::kNoError,
+              apm->ProcessReverseStream(channels, stream_config,
+                                        stream_config, channels));
+
+    int64_t max_call_ns = 0;
+    int64_t total_call_ns = 0;
+    {
+      ConfigSetterThread setter(apm.get(), apm_config);
+      for (size_t k = 0; k < kNumFramesToProcess; ++k) {
+        const int64_t start_ns = rtc::TimeNanos();
+        apm->ProcessReverseStream(channels, stream_config, stream_config,
+                                  channels);
+        const int64_t call_ns = rtc::TimeNanos() - start_ns;
+        max_call_ns = std::max(max_call_ns, call_ns);
+        total_call_ns += call_ns;
+      }
+    }
+
+    test::PrintResult(
+        "apm_render_call_max", "_48000Hz", mode.trace,
+        static_cast<double>(max_call_ns) / rtc::kNumNanosecsPerMicrosec, "us",
+        false);
+    test::PrintResult("apm_render_call_mean", "_48000Hz", mode.trace,
+                      static_cast<double>(total_call_ns) /
+                          (rtc::kNumNanosecsPerMicrosec * kNumFramesToProcess),
+                      "us", false);
+  }
+}
+
 }  // namespace webrtc
@@ -2261,6 +2261,16 @@ TEST(RuntimeSettingTest, TestCaptureFixedPostGain) {
 #endif
 }
 
+TEST(RuntimeSettingTest, TestCapturePerformanceTier) {
+  using Type = AudioProcessing::RuntimeSetting::Type;
+  auto s = AudioProcessing::RuntimeSetting::CreateCapturePerformanceTier(
+      AudioProcessing::Config::PerformanceTier::kMinimal);
+  EXPECT_EQ(Type::kCapturePerformanceTier, s.type());
+  int v;
+  s.GetInt(&v);
+  EXPECT_EQ(AudioProcessing::Config::PerformanceTier::kMinimal, v);
+}
+
 TEST(RuntimeSettingTest, TestUsageWithSwapQueue) {
   SwapQueue<AudioProcessing::RuntimeSetting> q(1);
   auto s = AudioProcessing::RuntimeSetting();
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/echo_detector/multi_lag_covariance_estimator.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_ARM64)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+// Parameter controlling the adaptation speed, same as in
+// NormalizedCovarianceEstimator.
+constexpr float kAlpha = 0.001f;
+
+}  // namespace
+
+MultiLagCovarianceEstimator::MultiLagCovarianceEstimator(size_t num_lags)
+    : normalized_cross_correlations_(num_lags, 0.f),
+      covariances_(num_lags, 0.f) {}
+
+MultiLagCovarianceEstimator::~MultiLagCovarianceEstimator() = default;
+
+// The operations are those of NormalizedCovarianceEstimator::Update(), in the
+// same order, so that the estimates are bit-exact with it.
+void MultiLagCovarianceEstimator::Update(float x,
+                                         float x_mean,
+                                         float x_sigma,
+                                         rtc::ArrayView<const float> y,
+                                         rtc::ArrayView<const float> y_mean,
+                                         rtc::ArrayView<const float> y_sigma) {
+  const size_t num_lags = covariances_.size();
+  RTC_DCHECK_EQ(num_lags, y.size());
+  RTC_DCHECK_EQ(num_lags, y_mean.size());
+  RTC_DCHECK_EQ(num_lags, y_sigma.size());
+  const float weighted_x = kAlpha * (x - x_mean);
+  float* covariances = covariances_.data();
+  float* normalized_cross_correlations = normalized_cross_correlations_.data();
+
+  size_t k = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128 forgetting_factor = _mm_set1_ps(1.f - kAlpha);
+  const __m128 weighted_x_v = _mm_set1_ps(weighted_x);
+  const __m128 x_sigma_v = _mm_set1_ps(x_sigma);
+  const __m128 regularization = _mm_set1_ps(.0001f);
+  for (; k + 4 <= num_lags; k += 4) {
+    const __m128 y_centered =
+        _mm_sub_ps(_mm_loadu_ps(&y[k]), _mm_loadu_ps(&y_mean[k]));
+    const __m128 covariance = _mm_add_ps(
+        _mm_mul_ps(forgetting_factor, _mm_loadu_ps(&covariances[k])),
+        _mm_mul_ps(weighted_x_v, y_centered));
+    const __m128 sigma_product = _mm_add_ps(
+        _mm_mul_ps(x_sigma_v, _mm_loadu_ps(&y_sigma[k])), regularization);
+    _mm_storeu_ps(&covariances[k], covariance);
+    _mm_storeu_ps(&normalized_cross_correlations[k],
+                  _mm_div_ps(covariance, sigma_product));
+  }
+#elif defined(WEBRTC_ARCH_ARM64)
+  const float32x4_t forgetting_factor = vdupq_n_f32(1.f - kAlpha);
+  const float32x4_t weighted_x_v = vdupq_n_f32(weighted_x);
+  const float32x4_t x_sigma_v = vdupq_n_f32(x_sigma);
+  const float32x4_t regularization = vdupq_n_f32(.0001f);
+  for (; k + 4 <= num_lags; k += 4) {
+    // No fused multiply-adds, which would round differently.
+    const float32x4_t y_centered =
+        vsubq_f32(vld1q_f32(&y[k]), vld1q_f32(&y_mean[k]));
+    const float32x4_t covariance =
+        vaddq_f32(vmulq_f32(forgetting_factor, vld1q_f32(&covariances[k])),
+                  vmulq_f32(weighted_x_v, y_centered));
+    const float32x4_t sigma_product =
+        vaddq_f32(vmulq_f32(x_sigma_v, vld1q_f32(&y_sigma[k])), regularization);
+    vst1q_f32(&covariances[k], covariance);
+    vst1q_f32(&normalized_cross_correlations[k],
+              vdivq_f32(covariance, sigma_product));
+  }
+#endif
+
+  for (; k < num_lags; ++k) {
+    covariances[k] = (1.f - kAlpha) * covariances[k] +
+                     weighted_x * (y[k] - y_mean[k]);
+    normalized_cross_correlations[k] =
+        covariances[k] / (x_sigma * y_sigma[k] + .0001f);
+  }
+
+#if RTC_DCHECK_IS_ON
+  for (k = 0; k < num_lags; ++k) {
+    RTC_DCHECK(isfinite(covariances[k]));
+    RTC_DCHECK(isfinite(normalized_cross_correlations[k]));
+  }
+#endif
+}
+
+void MultiLagCovarianceEstimator::Clear() {
+  std::fill(covariances_.begin(), covariances_.end(), 0.f);
+  std::fill(normalized_cross_correlations_.begin(),
+            normalized_cross_correlations_.end(), 0.f);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_MULTI_LAG_COVARIANCE_ESTIMATOR_H_
+#define MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_MULTI_LAG_COVARIANCE_ESTIMATOR_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// This class iteratively estimates the normalized covariance between a signal
+// x and a number of lagged versions of a signal y. The estimate of each lag is
+// identical to that of a NormalizedCovarianceEstimator, but all lags are
+// updated at once using SIMD instructions where available.
+class MultiLagCovarianceEstimator {
+ public:
+  explicit MultiLagCovarianceEstimator(size_t num_lags);
+  ~MultiLagCovarianceEstimator();
+
+  size_t num_lags() const { return covariances_.size(); }
+
+  // Updates the estimates of all lags with the current value of x and the
+  // values of y per lag, which are stored contiguously.
+  void Update(float x,
+              float x_mean,
+              float x_sigma,
+              rtc::ArrayView<const float> y,
+              rtc::ArrayView<const float> y_mean,
+              rtc::ArrayView<const float> y_sigma);
+  // Returns the estimates of the Pearson product-moment correlation
+  // coefficient of the two signals per lag.
+  rtc::ArrayView<const float> normalized_cross_correlations() const {
+    return normalized_cross_correlations_;
+  }
+  float covariance(size_t lag) const { return covariances_[lag]; }
+  // This function resets the estimated values to zero.
+  void Clear();
+
+ private:
+  std::vector<float> normalized_cross_correlations_;
+  // Estimates of the covariance values.
+  std::vector<float> covariances_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_ECHO_DETECTOR_MULTI_LAG_COVARIANCE_ESTIMATOR_H_
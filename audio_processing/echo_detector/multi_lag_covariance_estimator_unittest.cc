@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/echo_detector/multi_lag_covariance_estimator.h"
+
+#include <vector>
+
+#include "modules/audio_processing/echo_detector/normalized_covariance_estimator.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that the estimate of each lag matches that of a
+// NormalizedCovarianceEstimator, also for a number of lags that is not a
+// multiple of the vector size.
+TEST(MultiLagCovarianceEstimatorTests, MatchesNormalizedCovarianceEstimator) {
+  constexpr size_t kNumLags = 23;
+  Random random(42);
+  MultiLagCovarianceEstimator test_estimator(kNumLags);
+  std::vector<NormalizedCovarianceEstimator> reference_estimators(kNumLags);
+  std::vector<float> y(kNumLags);
+  std::vector<float> y_mean(kNumLags);
+  std::vector<float> y_sigma(kNumLags);
+  for (size_t i = 0; i < 1000; i++) {
+    const float x = random.Rand<float>();
+    const float x_mean = random.Rand<float>();
+    const float x_sigma = random.Rand<float>();
+    for (size_t k = 0; k < kNumLags; k++) {
+      y[k] = random.Rand<float>();
+      y_mean[k] = random.Rand<float>();
+      y_sigma[k] = random.Rand<float>();
+      reference_estimators[k].Update(x, x_mean, x_sigma, y[k], y_mean[k],
+                                     y_sigma[k]);
+    }
+    test_estimator.Update(x, x_mean, x_sigma, y, y_mean, y_sigma);
+    for (size_t k = 0; k < kNumLags; k++) {
+      EXPECT_FLOAT_EQ(reference_estimators[k].covariance(),
+                      test_estimator.covariance(k));
+      EXPECT_FLOAT_EQ(reference_estimators[k].normalized_cross_correlation(),
+                      test_estimator.normalized_cross_correlations()[k]);
+    }
+  }
+  test_estimator.Clear();
+  for (size_t k = 0; k < kNumLags; k++) {
+    EXPECT_EQ(0.f, test_estimator.covariance(k));
+    EXPECT_EQ(0.f, test_estimator.normalized_cross_correlations()[k]);
+  }
+}
+
+}  // namespace webrtc
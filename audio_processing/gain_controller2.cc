@@ -73,6 +73,12 @@ void GainController2::ApplyConfig(
   }
   gain_applier_.SetGainFactor(DbToRatio(config_.fixed_digital.gain_db));
   adaptive_agc_.reset(new AdaptiveAgc(data_dumper_.get(), config_));
+  adaptive_agc_->SetVadFrameInterval(vad_frame_interval_);
+}
+
+void GainController2::SetVadFrameInterval(int num_frames) {
+  vad_frame_interval_ = num_frames;
+  adaptive_agc_->SetVadFrameInterval(vad_frame_interval_);
 }
 
 bool GainController2::Validate(
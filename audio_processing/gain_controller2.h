@@ -37,6 +37,9 @@ class GainController2 {
   void NotifyAnalogLevel(int level);
 
   void ApplyConfig(const AudioProcessing::Config::GainController2& config);
+  // Makes the adaptive digital controller run its VAD on one frame every
+  // |num_frames| frames. Kept across ApplyConfig() calls.
+  void SetVadFrameInterval(int num_frames);
   static bool Validate(const AudioProcessing::Config::GainController2& config);
   static std::string ToString(
       const AudioProcessing::Config::GainController2& config);
@@ -49,6 +52,7 @@ class GainController2 {
   std::unique_ptr<AdaptiveAgc> adaptive_agc_;
   Limiter limiter_;
   int analog_level_ = -1;
+  int vad_frame_interval_ = 1;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(GainController2);
 };
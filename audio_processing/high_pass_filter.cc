@@ -12,66 +12,104 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/utility/channel_group_runner.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
 namespace {
 // [B,A] = butter(2,100/8000,'high')
-constexpr CascadedBiQuadFilter::BiQuadCoefficients kHighPassFilterCoefficients =
-    {{0.97261f, -1.94523f, 0.97261f}, {-1.94448f, 0.94598f}};
+constexpr CascadedBiQuadFilter::BiQuadCoefficients
+    kHighPassFilterCoefficients16kHz = {{0.97261f, -1.94523f, 0.97261f},
+                                        {-1.94448f, 0.94598f}};
 
-constexpr size_t kNumberOfHighPassBiQuads = 1;
+// [B,A] = butter(2,100/16000,'high')
+constexpr CascadedBiQuadFilter::BiQuadCoefficients
+    kHighPassFilterCoefficients32kHz = {
+        {0.9862119f, -1.9724238f, 0.9862119f},
+        {-1.9722337f, 0.9726140f}};
 
-}  // namespace
+// [B,A] = butter(2,100/24000,'high')
+constexpr CascadedBiQuadFilter::BiQuadCoefficients
+    kHighPassFilterCoefficients48kHz = {
+        {0.9907867f, -1.9815734f, 0.9907867f},
+        {-1.9814885f, 0.9816583f}};
 
-HighPassFilter::HighPassFilter(size_t num_channels) {
-  filters_.resize(num_channels);
-  for (size_t k = 0; k < filters_.size(); ++k) {
-    filters_[k].reset(new CascadedBiQuadFilter(kHighPassFilterCoefficients,
-                                               kNumberOfHighPassBiQuads));
+constexpr size_t kNumberOfHighPassBiQuads = 1;
+
+const CascadedBiQuadFilter::BiQuadCoefficients& ChooseCoefficients(
+    int sample_rate_hz) {
+  if (sample_rate_hz <= 16000) {
+    return kHighPassFilterCoefficients16kHz;
+  }
+  if (sample_rate_hz <= 32000) {
+    return kHighPassFilterCoefficients32kHz;
   }
+  return kHighPassFilterCoefficients48kHz;
 }
 
+}  // namespace
+
+HighPassFilter::HighPassFilter(size_t num_channels)
+    : HighPassFilter(16000, num_channels) {}
+
+HighPassFilter::HighPassFilter(int sample_rate_hz, size_t num_channels)
+    : filter_(ChooseCoefficients(sample_rate_hz),
+              kNumberOfHighPassBiQuads,
+              num_channels),
+      channel_data_(num_channels, nullptr) {}
+
 HighPassFilter::~HighPassFilter() = default;
 
 void HighPassFilter::Process(AudioBuffer* audio) {
+  Process(audio, /*use_split_band_data=*/true);
+}
+
+void HighPassFilter::Process(AudioBuffer* audio, bool use_split_band_data) {
+  Process(audio, use_split_band_data, /*channel_group_runner=*/nullptr);
+}
+
+void HighPassFilter::Process(AudioBuffer* audio,
+                             bool use_split_band_data,
+                             ChannelGroupRunner* channel_group_runner) {
   RTC_DCHECK(audio);
-  RTC_DCHECK_EQ(filters_.size(), audio->num_channels());
+  RTC_DCHECK_EQ(filter_.num_channels(), audio->num_channels());
+  // The channel pointers are obtained upfront, as the AudioBuffer accessors
+  // must not be called concurrently.
   for (size_t k = 0; k < audio->num_channels(); ++k) {
-    rtc::ArrayView<float> channel_data = rtc::ArrayView<float>(
-        audio->split_bands(k)[0], audio->num_frames_per_band());
-    filters_[k]->Process(channel_data);
+    channel_data_[k] =
+        use_split_band_data ? audio->split_bands(k)[0] : audio->channels()[k];
+  }
+  const size_t num_frames = use_split_band_data ? audio->num_frames_per_band()
+                                                : audio->num_frames();
+
+  if (channel_group_runner) {
+    // Each group of channels is filtered in the SIMD lanes of one thread.
+    channel_group_runner->Run(filter_.num_channel_groups(), [&](size_t group) {
+      filter_.ProcessChannelGroup(group, channel_data_, num_frames);
+    });
+  } else {
+    filter_.Process(channel_data_, num_frames);
   }
 }
 
 void HighPassFilter::Process(std::vector<std::vector<float>>* audio) {
-  RTC_DCHECK_EQ(filters_.size(), audio->size());
+  RTC_DCHECK_EQ(filter_.num_channels(), audio->size());
+  const size_t num_frames = audio->empty() ? 0 : (*audio)[0].size();
   for (size_t k = 0; k < audio->size(); ++k) {
-    filters_[k]->Process((*audio)[k]);
+    RTC_DCHECK_EQ(num_frames, (*audio)[k].size());
+    channel_data_[k] = (*audio)[k].data();
   }
+  filter_.Process(channel_data_, num_frames);
 }
 
 void HighPassFilter::Reset() {
-  for (size_t k = 0; k < filters_.size(); ++k) {
-    filters_[k]->Reset();
-  }
+  filter_.Reset();
 }
 
 void HighPassFilter::Reset(size_t num_channels) {
-  const size_t old_num_channels = filters_.size();
-  filters_.resize(num_channels);
-  if (filters_.size() < old_num_channels) {
-    Reset();
-  } else {
-    for (size_t k = 0; k < old_num_channels; ++k) {
-      filters_[k]->Reset();
-    }
-    for (size_t k = old_num_channels; k < filters_.size(); ++k) {
-      filters_[k].reset(new CascadedBiQuadFilter(kHighPassFilterCoefficients,
-                                                 kNumberOfHighPassBiQuads));
-    }
-  }
+  filter_.Reset(num_channels);
+  channel_data_.resize(num_channels, nullptr);
 }
 
 }  // namespace webrtc
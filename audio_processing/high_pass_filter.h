@@ -11,31 +11,46 @@
 #ifndef MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
 #define MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
 
-#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "modules/audio_processing/utility/multi_channel_biquad_filter.h"
 
 namespace webrtc {
 
 class AudioBuffer;
+class ChannelGroupRunner;
 
 // Filters that high
 class HighPassFilter {
  public:
+  // Creates a filter for signals sampled at 16 kHz, which is the rate of the
+  // lowest split band.
   explicit HighPassFilter(size_t num_channels);
+  // Creates a filter for signals sampled at |sample_rate_hz|.
+  HighPassFilter(int sample_rate_hz, size_t num_channels);
   ~HighPassFilter();
   HighPassFilter(const HighPassFilter&) = delete;
   HighPassFilter& operator=(const HighPassFilter&) = delete;
 
+  // Filters the lowest split band of |audio|.
   void Process(AudioBuffer* audio);
+  // Filters either the lowest split band or the full-band channels of |audio|.
+  // The latter requires the filter to be created for the full-band rate.
+  void Process(AudioBuffer* audio, bool use_split_band_data);
+  // Same as above, with the channels processed in parallel by
+  // |channel_group_runner| unless it is null.
+  void Process(AudioBuffer* audio,
+               bool use_split_band_data,
+               ChannelGroupRunner* channel_group_runner);
   void Process(std::vector<std::vector<float>>* audio);
   void Reset();
   void Reset(size_t num_channels);
 
  private:
-  std::vector<std::unique_ptr<CascadedBiQuadFilter>> filters_;
+  MultiChannelBiQuadFilter filter_;
+  std::vector<float*> channel_data_;
 };
 }  // namespace webrtc
 
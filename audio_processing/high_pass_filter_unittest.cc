@@ -298,4 +298,26 @@ TEST(HighPassFilterAccuracyTest, MonoConverged) {
   }
 }
 
+// Verifies that the full-band processing removes a DC offset at the rates
+// above the split-band rate.
+TEST(HighPassFilterAccuracyTest, FullBandProcessingRemovesDc) {
+  for (int sample_rate_hz : {32000, 48000}) {
+    SCOPED_TRACE(sample_rate_hz);
+    const StreamConfig stream_config(sample_rate_hz, 1, false);
+    AudioBuffer audio_buffer(sample_rate_hz, 1, sample_rate_hz, 1,
+                             sample_rate_hz, 1);
+    HighPassFilter hpf(sample_rate_hz, 1);
+    const std::vector<float> x(stream_config.num_frames(), 1000.f);
+    std::vector<float> y;
+    for (int frame = 0; frame < 100; ++frame) {
+      test::CopyVectorToAudioBuffer(stream_config, x, &audio_buffer);
+      hpf.Process(&audio_buffer, /*use_split_band_data=*/false);
+      test::ExtractVectorFromAudioBuffer(stream_config, &audio_buffer, &y);
+    }
+    for (float y_k : y) {
+      EXPECT_NEAR(0.f, y_k, 1.f);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -52,6 +52,18 @@ std::string GainController2LevelEstimatorToString(
   }
 }
 
+std::string PerformanceTierToString(
+    const AudioProcessing::Config::PerformanceTier::Tier& tier) {
+  switch (tier) {
+    case AudioProcessing::Config::PerformanceTier::Tier::kFull:
+      return "Full";
+    case AudioProcessing::Config::PerformanceTier::Tier::kReduced:
+      return "Reduced";
+    case AudioProcessing::Config::PerformanceTier::Tier::kMinimal:
+      return "Minimal";
+  }
+}
+
 int GetDefaultMaxInternalRate() {
 #ifdef WEBRTC_ARCH_ARM_FAMILY
   return 32000;
@@ -84,6 +96,8 @@ std::string AudioProcessing::Config::ToString() const {
           << ", level: "
           << NoiseSuppressionLevelToString(noise_suppression.level)
           << " }, voice_detection: { enabled: " << voice_detection.enabled
+          << ", share_with_experimental_agc: "
+          << voice_detection.share_with_experimental_agc
           << " }, gain_controller1: { enabled: " << gain_controller1.enabled
           << ", mode: " << GainController1ModeToString(gain_controller1.mode)
           << ", target_level_dbfs: " << gain_controller1.target_level_dbfs
@@ -105,7 +119,8 @@ std::string AudioProcessing::Config::ToString() const {
           << " } }, residual_echo_detector: { enabled: "
           << residual_echo_detector.enabled
           << " }, level_estimation: { enabled: " << level_estimation.enabled
-          << " } }";
+          << " }, performance_tier: { tier: "
+          << PerformanceTierToString(performance_tier.tier) << " } }";
   return builder.str();
 }
 
@@ -257,6 +257,46 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
       // Force multi-channel processing on playout and capture audio. This is an
       // experimental feature, and is likely to change without warning.
       bool experimental_multi_channel = false;
+      // Makes the render calls wait-free with respect to the other APM calls.
+      // When the render lock is held by a setter, e.g., ApplyConfig(), the
+      // render frame is copied into a preallocated single-producer
+      // single-consumer queue and passed through unprocessed, and it is
+      // analyzed by the next render call that gets the lock. Frames with more
+      // than 8 channels and frames that do not fit into the 200 ms queue are
+      // dropped from the analysis. Furthermore, the render data for the
+      // capture side is dropped instead of waiting for the capture lock when
+      // the capture side falls behind. For these calls, the worst-case render
+      // call latency is therefore bounded by the copy of one frame, or by the
+      // render processing itself when the lock is free. A
+      // ProcessReverseStream() call whose input and output configs differ
+      // needs format conversion and is not covered: it waits for the render
+      // lock as without this setting, and can block. A render format change
+      // also still reinitializes APM with both locks acquired. Clients should
+      // apply configuration changes at runtime via SetRuntimeSetting(), which
+      // never contends with the render thread.
+      bool wait_free_render = false;
+      // Moves the render-side analysis off the render thread. Each render call
+      // only copies the frame into the queue described above and passes the
+      // audio through unprocessed, while an APM-owned thread runs the render
+      // analysis, e.g., of the echo controller and the residual echo detector.
+      // The capture side consumes the analyzed render data as before. Only
+      // meant for clients without render-side processing that modifies the
+      // audio. Frames that cannot be queued, e.g., due to their format, are
+      // processed on the render thread. Takes precedence over
+      // |wait_free_render|.
+      bool asynchronous_render_analysis = false;
+      // Processes the capture channels of the high-pass filter and the noise
+      // suppressor in parallel on APM-owned worker threads when there are more
+      // than four capture channels. Each stage waits for all channels before
+      // the next one starts, so the output is identical to the sequential
+      // processing. The AEC3 subtractor processes its channels in parallel
+      // regardless of this setting.
+      bool parallel_capture_channels = false;
+      // Measures the processing time of the capture side and of its band
+      // split, high-pass filter, noise suppressor, echo controller and AGC2
+      // stages, and reports their percentiles in AudioProcessingStats. The
+      // measurements restart when this is enabled.
+      bool measure_capture_processing_time = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
@@ -293,6 +333,9 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
     // be modified to reflect the current decision.
     struct VoiceDetection {
       bool enabled = false;
+      // Lets the experimental AGC use the voice detection decision of each
+      // frame instead of running the same kind of VAD again on the frame.
+      bool share_with_experimental_agc = false;
     } voice_detection;
 
     // Enables automatic gain control (AGC) functionality.
@@ -376,6 +419,28 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
     struct LevelEstimation {
       bool enabled = false;
     } level_estimation;
+
+    // Trades audio quality for CPU usage across the capture submodules, e.g.,
+    // to degrade gracefully under thermal throttling. Each tier maps to a
+    // coherent set of reductions of the enabled submodules, and none of them
+    // needs a reinitialization, so the tier can be changed at runtime via
+    // RuntimeSetting::CreateCapturePerformanceTier(). Submodules that are not
+    // enabled in the config are never enabled by a tier.
+    struct PerformanceTier {
+      enum Tier {
+        // Runs the enabled submodules as configured.
+        kFull,
+        // Skips the transient suppressor and the capture analysis of the
+        // residual echo detector, and runs the AGC2 RNN VAD on every second
+        // frame only.
+        kReduced,
+        // Like kReduced, but also skips the noise suppressor and runs the AGC2
+        // RNN VAD on every fourth frame only. Echo cancellation and gain
+        // control keep running as configured.
+        kMinimal
+      };
+      Tier tier = kFull;
+    } performance_tier;
       
       Config() = default;
       Config(Config const&) = default;
@@ -415,7 +480,8 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
       kCaptureCompressionGain,
       kCaptureFixedPostGain,
       kPlayoutVolumeChange,
-      kCustomRenderProcessingRuntimeSetting
+      kCustomRenderProcessingRuntimeSetting,
+      kCapturePerformanceTier
     };
 
     RuntimeSetting() : type_(Type::kNotSpecified), value_(0.f) {}
@@ -450,6 +516,13 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
       return {Type::kCustomRenderProcessingRuntimeSetting, payload};
     }
 
+    // Corresponds to Config::PerformanceTier::tier, but for runtime
+    // configuration.
+    static RuntimeSetting CreateCapturePerformanceTier(
+        Config::PerformanceTier::Tier tier) {
+      return {Type::kCapturePerformanceTier, static_cast<int>(tier)};
+    }
+
     Type type() const { return type_; }
     void GetFloat(float* value) const {
       RTC_DCHECK(value);
@@ -533,8 +606,9 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
   // Enqueue a runtime setting.
   virtual void SetRuntimeSetting(RuntimeSetting setting) = 0;
 
-  // Processes a 10 ms |frame| of the primary audio stream. On the client-side,
-  // this is the near-end (or captured) audio.
+  // Processes a 10 ms or 20 ms |frame| of the primary audio stream. On the
+  // client-side, this is the near-end (or captured) audio. A 20 ms frame is
+  // processed as two consecutive 10 ms chunks.
   //
   // If needed for enabled functionality, any function with the set_stream_ tag
   // must be called prior to processing the current frame. Any getter function
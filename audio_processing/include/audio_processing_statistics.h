@@ -66,6 +66,29 @@ struct RTC_EXPORT AudioProcessingStats {
   // milliseconds and the value is the instantaneous value at the time of the
   // call to |GetStatistics()|.
   absl::optional<int32_t> delay_ms;
+
+  // Processing time of a capture submodule per 10 ms chunk, accumulated since
+  // the measurements were enabled. The percentiles are upper bounds that
+  // exceed the exact values by at most 25%.
+  struct ProcessingTime {
+    int64_t num_calls = 0;
+    int64_t p50_ns = 0;
+    int64_t p90_ns = 0;
+    int64_t p99_ns = 0;
+    int64_t max_ns = 0;
+  };
+
+  // Processing times of the capture side, only reported if
+  // |pipeline.measure_capture_processing_time| is set in
+  // AudioProcessing::Config. The band-split time covers both the splitting
+  // into bands and the merging, and the echo controller time covers the
+  // capture analysis and processing of AEC3 or a custom echo controller.
+  absl::optional<ProcessingTime> capture_processing_time;
+  absl::optional<ProcessingTime> band_split_processing_time;
+  absl::optional<ProcessingTime> high_pass_filter_processing_time;
+  absl::optional<ProcessingTime> noise_suppression_processing_time;
+  absl::optional<ProcessingTime> echo_controller_processing_time;
+  absl::optional<ProcessingTime> gain_controller2_processing_time;
 };
 
 }  // namespace webrtc
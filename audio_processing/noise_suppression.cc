@@ -11,6 +11,7 @@
 #include "modules/audio_processing/noise_suppression.h"
 
 #include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/utility/channel_group_runner.h"
 #include "rtc_base/checks.h"
 #if defined(WEBRTC_NS_FLOAT)
 #include "modules/audio_processing/ns/noise_suppression.h"
@@ -70,7 +71,8 @@ class NoiseSuppression::Suppressor {
 
 NoiseSuppression::NoiseSuppression(size_t channels,
                                    int sample_rate_hz,
-                                   Level level) {
+                                   Level level)
+    : split_bands_(channels, nullptr) {
   const int policy = NoiseSuppressionLevelToPolicy(level);
   for (size_t i = 0; i < channels; ++i) {
     suppressors_.push_back(std::make_unique<Suppressor>(sample_rate_hz));
@@ -82,25 +84,52 @@ NoiseSuppression::NoiseSuppression(size_t channels,
 NoiseSuppression::~NoiseSuppression() {}
 
 void NoiseSuppression::AnalyzeCaptureAudio(AudioBuffer* audio) {
+  AnalyzeCaptureAudio(audio, /*channel_group_runner=*/nullptr);
+}
+
+void NoiseSuppression::ProcessCaptureAudio(AudioBuffer* audio) {
+  ProcessCaptureAudio(audio, /*channel_group_runner=*/nullptr);
+}
+
+void NoiseSuppression::AnalyzeCaptureAudio(
+    AudioBuffer* audio,
+    ChannelGroupRunner* channel_group_runner) {
   RTC_DCHECK(audio);
 #if defined(WEBRTC_NS_FLOAT)
   RTC_DCHECK_GE(160, audio->num_frames_per_band());
   RTC_DCHECK_EQ(suppressors_.size(), audio->num_channels());
-  for (size_t i = 0; i < suppressors_.size(); i++) {
+  auto analyze_channel = [&](size_t i) {
     WebRtcNs_Analyze(suppressors_[i]->state(),
                      audio->split_bands_const(i)[kBand0To8kHz]);
+  };
+  if (channel_group_runner) {
+    channel_group_runner->Run(suppressors_.size(), analyze_channel);
+  } else {
+    for (size_t i = 0; i < suppressors_.size(); i++) {
+      analyze_channel(i);
+    }
   }
 #endif
 }
 
-void NoiseSuppression::ProcessCaptureAudio(AudioBuffer* audio) {
+void NoiseSuppression::ProcessCaptureAudio(
+    AudioBuffer* audio,
+    ChannelGroupRunner* channel_group_runner) {
   RTC_DCHECK(audio);
   RTC_DCHECK_GE(160, audio->num_frames_per_band());
   RTC_DCHECK_EQ(suppressors_.size(), audio->num_channels());
+#if defined(WEBRTC_NS_FLOAT)
+  // The band pointers are obtained upfront, as the AudioBuffer accessors that
+  // allow modifications must not be called concurrently.
   for (size_t i = 0; i < suppressors_.size(); i++) {
+    split_bands_[i] = audio->split_bands(i);
+  }
+#endif
+
+  auto process_channel = [&](size_t i) {
 #if defined(WEBRTC_NS_FLOAT)
     WebRtcNs_Process(suppressors_[i]->state(), audio->split_bands_const(i),
-                     audio->num_bands(), audio->split_bands(i));
+                     audio->num_bands(), split_bands_[i]);
 #elif defined(WEBRTC_NS_FIXED)
     int16_t split_band_data[AudioBuffer::kMaxNumBands]
                            [AudioBuffer::kMaxSplitFrameLength];
@@ -113,6 +142,14 @@ void NoiseSuppression::ProcessCaptureAudio(AudioBuffer* audio) {
 
     audio->ImportSplitChannelData(i, split_bands);
 #endif
+  };
+
+  if (channel_group_runner) {
+    channel_group_runner->Run(suppressors_.size(), process_channel);
+  } else {
+    for (size_t i = 0; i < suppressors_.size(); i++) {
+      process_channel(i);
+    }
   }
 }
 
@@ -17,6 +17,7 @@
 namespace webrtc {
 
 class AudioBuffer;
+class ChannelGroupRunner;
 
 // The noise suppression (NS) component attempts to remove noise while
 // retaining speech. Recommended to be enabled on the client-side.
@@ -34,6 +35,12 @@ class NoiseSuppression {
 
   void AnalyzeCaptureAudio(AudioBuffer* audio);
   void ProcessCaptureAudio(AudioBuffer* audio);
+  // Same as above, with the channels processed in parallel by
+  // |channel_group_runner| unless it is null.
+  void AnalyzeCaptureAudio(AudioBuffer* audio,
+                           ChannelGroupRunner* channel_group_runner);
+  void ProcessCaptureAudio(AudioBuffer* audio,
+                           ChannelGroupRunner* channel_group_runner);
 
   // LEGACY: Returns the internally computed prior speech probability of current
   // frame averaged over output channels. This is not supported in fixed point,
@@ -51,6 +58,7 @@ class NoiseSuppression {
   class Suppressor;
 
   std::vector<std::unique_ptr<Suppressor>> suppressors_;
+  std::vector<float* const*> split_bands_;
 };
 }  // namespace webrtc
 
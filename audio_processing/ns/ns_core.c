@@ -18,6 +18,9 @@
 #include "modules/audio_processing/ns/noise_suppression.h"
 #include "modules/audio_processing/ns/ns_core.h"
 #include "modules/audio_processing/ns/windows_private.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+static void InitFunctionPointers(void);
 
 // Set Feature Extraction Parameters.
 static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
@@ -211,6 +214,8 @@ int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
   // Default mode.
   WebRtcNs_set_policy_core(self, 0);
 
+  InitFunctionPointers();
+
   self->initFlag = 1;
   return 0;
 }
@@ -565,11 +570,11 @@ static void ComputeSpectralFlatness(NoiseSuppressionC* self,
 // Outputs:
 //   * |snrLocPrior| is the computed prior SNR.
 //   * |snrLocPost| is the computed post SNR.
-static void ComputeSnr(const NoiseSuppressionC* self,
-                       const float* magn,
-                       const float* noise,
-                       float* snrLocPrior,
-                       float* snrLocPost) {
+static void ComputeSnrC(const NoiseSuppressionC* self,
+                        const float* magn,
+                        const float* noise,
+                        float* snrLocPrior,
+                        float* snrLocPost) {
   size_t i;
 
   for (i = 0; i < self->magnLen; i++) {
@@ -796,15 +801,11 @@ static void FeatureUpdate(NoiseSuppressionC* self,
 // Update the noise estimate.
 // Inputs:
 //   * |magn| is the signal magnitude spectrum estimate.
-//   * |snrLocPrior| is the prior SNR.
-//   * |snrLocPost| is the post SNR.
 // Output:
 //   * |noise| is the updated noise magnitude spectrum estimate.
-static void UpdateNoiseEstimate(NoiseSuppressionC* self,
-                                const float* magn,
-                                const float* snrLocPrior,
-                                const float* snrLocPost,
-                                float* noise) {
+static void UpdateNoiseEstimateC(NoiseSuppressionC* self,
+                                 const float* magn,
+                                 float* noise) {
   size_t i;
   float probSpeech, probNonSpeech;
   // Time-avg parameter for noise update.
@@ -908,7 +909,20 @@ static void FFT(NoiseSuppressionC* self,
   for (i = 1; i < magnitude_length - 1; ++i) {
     real[i] = time_data[2 * i];
     imag[i] = time_data[2 * i + 1];
-    // Magnitude spectrum.
+  }
+  // Magnitude spectrum.
+  WebRtcNs_ComputeMagnitude(&real[1], &imag[1], magnitude_length - 2,
+                            &magn[1]);
+}
+
+// Computes the magnitude spectrum of |length| bins.
+static void ComputeMagnitudeC(const float* real,
+                              const float* imag,
+                              size_t length,
+                              float* magn) {
+  size_t i;
+
+  for (i = 0; i < length; ++i) {
     magn[i] = sqrtf(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
   }
 }
@@ -985,9 +999,9 @@ static void Windowing(const float* window,
 //   * |magn| is the signal magnitude spectrum estimate.
 // Output:
 //   * |theFilter| is the frequency response of the computed Wiener filter.
-static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
-                                       const float* magn,
-                                       float* theFilter) {
+static void ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                        const float* magn,
+                                        float* theFilter) {
   size_t i;
   float snrPrior, previousEstimateStsa, currentEstimateStsa;
 
@@ -1009,6 +1023,37 @@ static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
   }  // End of loop over frequencies.
 }
 
+// Declare function pointers.
+ComputeMagnitude WebRtcNs_ComputeMagnitude;
+ComputeSnr WebRtcNs_ComputeSnr;
+ComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+UpdateNoiseEstimate WebRtcNs_UpdateNoiseEstimate;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Initialize function pointers for SSE2.
+static void InitSse2(void) {
+  WebRtcNs_ComputeMagnitude = WebRtcNs_ComputeMagnitudeSse2;
+  WebRtcNs_ComputeSnr = WebRtcNs_ComputeSnrSse2;
+  WebRtcNs_ComputeDdBasedWienerFilter =
+      WebRtcNs_ComputeDdBasedWienerFilterSse2;
+  WebRtcNs_UpdateNoiseEstimate = WebRtcNs_UpdateNoiseEstimateSse2;
+}
+#endif
+
+// Initialize function pointers, selecting the SSE2 versions when supported.
+static void InitFunctionPointers(void) {
+  WebRtcNs_ComputeMagnitude = ComputeMagnitudeC;
+  WebRtcNs_ComputeSnr = ComputeSnrC;
+  WebRtcNs_ComputeDdBasedWienerFilter = ComputeDdBasedWienerFilterC;
+  WebRtcNs_UpdateNoiseEstimate = UpdateNoiseEstimateC;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    InitSse2();
+  }
+#endif
+}
+
 // Changes the aggressiveness of the noise suppression method.
 // |mode| = 0 is mild (6dB), |mode| = 1 is medium (10dB) and |mode| = 2 is
 // aggressive (15dB).
@@ -1173,11 +1218,11 @@ void WebRtcNs_AnalyzeCore(NoiseSuppressionC* self, const float* speechFrame) {
   }
 
   // Post and prior SNR needed for SpeechNoiseProb.
-  ComputeSnr(self, magn, noise, snrLocPrior, snrLocPost);
+  WebRtcNs_ComputeSnr(self, magn, noise, snrLocPrior, snrLocPost);
 
   FeatureUpdate(self, magn, updateParsFlag);
   SpeechNoiseProb(self, self->speechProb, snrLocPrior, snrLocPost);
-  UpdateNoiseEstimate(self, magn, snrLocPrior, snrLocPost, noise);
+  WebRtcNs_UpdateNoiseEstimate(self, magn, noise);
 
   // Keep track of noise spectrum for next frame.
   memcpy(self->noise, noise, sizeof(*noise) * self->magnLen);
@@ -1275,7 +1320,7 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
     }
   }
 
-  ComputeDdBasedWienerFilter(self, magn, theFilter);
+  WebRtcNs_ComputeDdBasedWienerFilter(self, magn, theFilter);
 
   for (i = 0; i < self->magnLen; i++) {
     // Flooring bottom.
@@ -11,7 +11,11 @@
 #ifndef MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 #define MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "modules/audio_processing/ns/defines.h"
+#include "rtc_base/system/arch.h"
 
 typedef struct NSParaExtract_ {
   // Bin size of histogram.
@@ -183,6 +187,61 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
                           size_t num_bands,
                           float* const* outFrame);
 
+/****************************************************************************
+ * Some function pointers, for the spectral loops shared by SSE2 and generic C
+ * code. The vectorized versions perform the same operations in the same order
+ * for each frequency bin, so the output is bit-exact with the C code.
+ */
+// Computes the magnitude spectrum |magn| = |real| + j * |imag| + 1 for
+// |length| bins.
+typedef void (*ComputeMagnitude)(const float* real,
+                                 const float* imag,
+                                 size_t length,
+                                 float* magn);
+extern ComputeMagnitude WebRtcNs_ComputeMagnitude;
+
+// Computes the prior and post SNR based on the quantile noise estimation.
+typedef void (*ComputeSnr)(const NoiseSuppressionC* self,
+                           const float* magn,
+                           const float* noise,
+                           float* snrLocPrior,
+                           float* snrLocPost);
+extern ComputeSnr WebRtcNs_ComputeSnr;
+
+// Computes the decision-directed prior SNR based Wiener filter.
+typedef void (*ComputeDdBasedWienerFilter)(const NoiseSuppressionC* self,
+                                           const float* magn,
+                                           float* theFilter);
+extern ComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+// Updates the noise estimate |noise| and the conservative noise spectrum based
+// on the speech probability of each bin.
+typedef void (*UpdateNoiseEstimate)(NoiseSuppressionC* self,
+                                    const float* magn,
+                                    float* noise);
+extern UpdateNoiseEstimate WebRtcNs_UpdateNoiseEstimate;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// For the above function pointers, functions for generic platforms are declared
+// and defined as static in file ns_core.c, while those for SSE2 are declared
+// below and defined in file ns_core_sse2.c.
+void WebRtcNs_ComputeMagnitudeSse2(const float* real,
+                                   const float* imag,
+                                   size_t length,
+                                   float* magn);
+void WebRtcNs_ComputeSnrSse2(const NoiseSuppressionC* self,
+                             const float* magn,
+                             const float* noise,
+                             float* snrLocPrior,
+                             float* snrLocPost);
+void WebRtcNs_ComputeDdBasedWienerFilterSse2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter);
+void WebRtcNs_UpdateNoiseEstimateSse2(NoiseSuppressionC* self,
+                                      const float* magn,
+                                      float* noise);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
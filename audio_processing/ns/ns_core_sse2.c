@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include "modules/audio_processing/ns/ns_core.h"
+
+// The SSE2 versions below process four frequency bins at a time and handle the
+// remaining bins with the same scalar code as in ns_core.c. No fused or
+// reordered operations are used, so that the results are bit-exact with the
+// generic C versions.
+
+void WebRtcNs_ComputeMagnitudeSse2(const float* real,
+                                   const float* imag,
+                                   size_t length,
+                                   float* magn) {
+  const __m128 one = _mm_set1_ps(1.f);
+  size_t i = 0;
+
+  for (; i + 4 <= length; i += 4) {
+    const __m128 re = _mm_loadu_ps(&real[i]);
+    const __m128 im = _mm_loadu_ps(&imag[i]);
+    const __m128 power = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    _mm_storeu_ps(&magn[i], _mm_add_ps(_mm_sqrt_ps(power), one));
+  }
+  for (; i < length; ++i) {
+    magn[i] = sqrtf(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+  }
+}
+
+void WebRtcNs_ComputeSnrSse2(const NoiseSuppressionC* self,
+                             const float* magn,
+                             const float* noise,
+                             float* snrLocPrior,
+                             float* snrLocPost) {
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 epsilon = _mm_set1_ps(0.0001f);
+  const __m128 dd_pr_snr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 one_minus_dd_pr_snr = _mm_set1_ps(1.f - DD_PR_SNR);
+  size_t i = 0;
+
+  for (; i + 4 <= self->magnLen; i += 4) {
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevAnalyze[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), epsilon)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post SNR.
+    const __m128 magn_128 = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_128 = _mm_loadu_ps(&noise[i]);
+    const __m128 post_snr = _mm_and_ps(
+        _mm_cmpgt_ps(magn_128, noise_128),
+        _mm_sub_ps(_mm_div_ps(magn_128, _mm_add_ps(noise_128, epsilon)), one));
+    _mm_storeu_ps(&snrLocPost[i], post_snr);
+    // DD estimate is sum of two terms: current estimate and previous estimate.
+    _mm_storeu_ps(&snrLocPrior[i],
+                  _mm_add_ps(_mm_mul_ps(dd_pr_snr, previous_estimate_stsa),
+                             _mm_mul_ps(one_minus_dd_pr_snr, post_snr)));
+  }
+  for (; i < self->magnLen; ++i) {
+    float previousEstimateStsa = self->magnPrevAnalyze[i] /
+        (self->noisePrev[i] + 0.0001f) * self->smooth[i];
+    snrLocPost[i] = 0.f;
+    if (magn[i] > noise[i]) {
+      snrLocPost[i] = magn[i] / (noise[i] + 0.0001f) - 1.f;
+    }
+    snrLocPrior[i] =
+        DD_PR_SNR * previousEstimateStsa + (1.f - DD_PR_SNR) * snrLocPost[i];
+  }
+}
+
+void WebRtcNs_ComputeDdBasedWienerFilterSse2(const NoiseSuppressionC* self,
+                                             const float* magn,
+                                             float* theFilter) {
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 epsilon = _mm_set1_ps(0.0001f);
+  const __m128 dd_pr_snr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 one_minus_dd_pr_snr = _mm_set1_ps(1.f - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(self->overdrive);
+  size_t i = 0;
+
+  for (; i + 4 <= self->magnLen; i += 4) {
+    // Previous estimate: based on previous frame with gain filter.
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(_mm_loadu_ps(&self->magnPrevProcess[i]),
+                   _mm_add_ps(_mm_loadu_ps(&self->noisePrev[i]), epsilon)),
+        _mm_loadu_ps(&self->smooth[i]));
+    // Post and prior SNR.
+    const __m128 magn_128 = _mm_loadu_ps(&magn[i]);
+    const __m128 noise_128 = _mm_loadu_ps(&self->noise[i]);
+    const __m128 current_estimate_stsa = _mm_and_ps(
+        _mm_cmpgt_ps(magn_128, noise_128),
+        _mm_sub_ps(_mm_div_ps(magn_128, _mm_add_ps(noise_128, epsilon)), one));
+    // DD estimate is sum of two terms: current estimate and previous estimate.
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(dd_pr_snr, previous_estimate_stsa),
+                   _mm_mul_ps(one_minus_dd_pr_snr, current_estimate_stsa));
+    // Gain filter.
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  for (; i < self->magnLen; ++i) {
+    float snrPrior;
+    float previousEstimateStsa = self->magnPrevProcess[i] /
+                                 (self->noisePrev[i] + 0.0001f) *
+                                 self->smooth[i];
+    float currentEstimateStsa = 0.f;
+    if (magn[i] > self->noise[i]) {
+      currentEstimateStsa = magn[i] / (self->noise[i] + 0.0001f) - 1.f;
+    }
+    snrPrior = DD_PR_SNR * previousEstimateStsa +
+               (1.f - DD_PR_SNR) * currentEstimateStsa;
+    theFilter[i] = snrPrior / (self->overdrive + snrPrior);
+  }
+}
+
+// Returns the time constant of the noise update for a bin with speech
+// probability |probSpeech|.
+static float NoiseUpdateTimeConstant(float probSpeech) {
+  return probSpeech > PROB_RANGE ? SPEECH_UPDATE : NOISE_UPDATE;
+}
+
+// Updates the noise estimate of bin |i| as done in ns_core.c.
+static void UpdateNoiseEstimateBin(NoiseSuppressionC* self,
+                                   const float* magn,
+                                   size_t i,
+                                   float* noise) {
+  const float probSpeech = self->speechProb[i];
+  const float probNonSpeech = 1.f - probSpeech;
+  const float gammaNoiseOld =
+      i == 0 ? NOISE_UPDATE : NoiseUpdateTimeConstant(self->speechProb[i - 1]);
+  const float gammaNoiseTmp = NoiseUpdateTimeConstant(probSpeech);
+  const float noiseUpdateTmp =
+      gammaNoiseOld * self->noisePrev[i] +
+      (1.f - gammaNoiseOld) *
+          (probNonSpeech * magn[i] + probSpeech * self->noisePrev[i]);
+  if (probSpeech < PROB_RANGE) {
+    self->magnAvgPause[i] += GAMMA_PAUSE * (magn[i] - self->magnAvgPause[i]);
+  }
+  if (gammaNoiseTmp == gammaNoiseOld) {
+    noise[i] = noiseUpdateTmp;
+  } else {
+    noise[i] = gammaNoiseTmp * self->noisePrev[i] +
+               (1.f - gammaNoiseTmp) *
+                   (probNonSpeech * magn[i] + probSpeech * self->noisePrev[i]);
+    if (noiseUpdateTmp < noise[i]) {
+      noise[i] = noiseUpdateTmp;
+    }
+  }
+}
+
+// In the C version the temporary noise update of a bin uses the time constant
+// selected for the previous bin. Here that time constant is derived from the
+// speech probabilities shifted by one bin, which removes the dependency between
+// consecutive bins.
+void WebRtcNs_UpdateNoiseEstimateSse2(NoiseSuppressionC* self,
+                                      const float* magn,
+                                      float* noise) {
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 prob_range = _mm_set1_ps(PROB_RANGE);
+  const __m128 noise_update = _mm_set1_ps(NOISE_UPDATE);
+  const __m128 speech_update = _mm_set1_ps(SPEECH_UPDATE);
+  const __m128 gamma_pause = _mm_set1_ps(GAMMA_PAUSE);
+  size_t i;
+
+  // The first bin has no previous bin.
+  UpdateNoiseEstimateBin(self, magn, 0, noise);
+  for (i = 1; i + 4 <= self->magnLen; i += 4) {
+    const __m128 prob_speech = _mm_loadu_ps(&self->speechProb[i]);
+    const __m128 noise_prev = _mm_loadu_ps(&self->noisePrev[i]);
+    const __m128 magn_128 = _mm_loadu_ps(&magn[i]);
+    const __m128 magn_avg_pause = _mm_loadu_ps(&self->magnAvgPause[i]);
+    const __m128 mixed_noise =
+        _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, prob_speech), magn_128),
+                   _mm_mul_ps(prob_speech, noise_prev));
+    const __m128 speech_old =
+        _mm_cmpgt_ps(_mm_loadu_ps(&self->speechProb[i - 1]), prob_range);
+    const __m128 gamma_old =
+        _mm_or_ps(_mm_and_ps(speech_old, speech_update),
+                  _mm_andnot_ps(speech_old, noise_update));
+    const __m128 speech = _mm_cmpgt_ps(prob_speech, prob_range);
+    const __m128 gamma = _mm_or_ps(_mm_and_ps(speech, speech_update),
+                                   _mm_andnot_ps(speech, noise_update));
+    const __m128 pause = _mm_cmplt_ps(prob_speech, prob_range);
+    const __m128 noise_update_tmp =
+        _mm_add_ps(_mm_mul_ps(gamma_old, noise_prev),
+                   _mm_mul_ps(_mm_sub_ps(one, gamma_old), mixed_noise));
+    const __m128 noise_new =
+        _mm_add_ps(_mm_mul_ps(gamma, noise_prev),
+                   _mm_mul_ps(_mm_sub_ps(one, gamma), mixed_noise));
+    const __m128 updated_avg_pause = _mm_add_ps(
+        magn_avg_pause,
+        _mm_mul_ps(gamma_pause, _mm_sub_ps(magn_128, magn_avg_pause)));
+    // Conservative noise update.
+    _mm_storeu_ps(&self->magnAvgPause[i],
+                  _mm_or_ps(_mm_and_ps(pause, updated_avg_pause),
+                            _mm_andnot_ps(pause, magn_avg_pause)));
+    // When the time constants match, both updates are identical. Otherwise the
+    // noise update is only allowed downwards.
+    _mm_storeu_ps(&noise[i], _mm_min_ps(noise_update_tmp, noise_new));
+  }
+  for (; i < self->magnLen; ++i) {
+    UpdateNoiseEstimateBin(self, magn, i, noise);
+  }
+}
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/processing_time_histogram.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Returns the index of the highest set bit of |value| > 0.
+int HighestSetBit(uint64_t value) {
+  int bit = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if (value >> shift) {
+      value >>= shift;
+      bit += shift;
+    }
+  }
+  return bit;
+}
+
+// Durations below 4 ns get one bin each. Longer durations are binned by their
+// highest set bit and the two bits below it.
+size_t BinIndex(int64_t duration_ns) {
+  const uint64_t value =
+      static_cast<uint64_t>(std::max<int64_t>(duration_ns, 0));
+  if (value < 4) {
+    return static_cast<size_t>(value);
+  }
+  const int bit = HighestSetBit(value);
+  return 4 * bit + ((value >> (bit - 2)) & 3);
+}
+
+// Returns the largest duration mapped to bin |index|.
+int64_t BinUpperBound(size_t index) {
+  if (index < 4) {
+    return static_cast<int64_t>(index);
+  }
+  const int bit = static_cast<int>(index / 4);
+  const uint64_t fraction = index % 4;
+  return static_cast<int64_t>(((5 + fraction) << (bit - 2)) - 1);
+}
+
+}  // namespace
+
+ProcessingTimeHistogram::ProcessingTimeHistogram() {
+  Reset();
+}
+
+void ProcessingTimeHistogram::Add(int64_t duration_ns) {
+  const size_t index = BinIndex(duration_ns);
+  RTC_DCHECK_LT(index, kNumBins);
+  // There is a single writer, so plain loads and stores suffice.
+  bins_[index].store(bins_[index].load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+  if (duration_ns > max_duration_ns_.load(std::memory_order_relaxed)) {
+    max_duration_ns_.store(duration_ns, std::memory_order_relaxed);
+  }
+}
+
+void ProcessingTimeHistogram::Reset() {
+  for (auto& bin : bins_) {
+    bin.store(0, std::memory_order_relaxed);
+  }
+  max_duration_ns_.store(0, std::memory_order_relaxed);
+}
+
+absl::optional<AudioProcessingStats::ProcessingTime>
+ProcessingTimeHistogram::GetStatistics() const {
+  std::array<uint32_t, kNumBins> counts;
+  int64_t num_calls = 0;
+  for (size_t k = 0; k < kNumBins; ++k) {
+    counts[k] = bins_[k].load(std::memory_order_relaxed);
+    num_calls += counts[k];
+  }
+  if (num_calls == 0) {
+    return absl::nullopt;
+  }
+
+  AudioProcessingStats::ProcessingTime stats;
+  stats.num_calls = num_calls;
+  stats.max_ns = max_duration_ns_.load(std::memory_order_relaxed);
+
+  // Returns the upper bound of the bin holding the measurement of the given
+  // rank, counted from 1.
+  auto percentile = [&](int percent) {
+    const int64_t rank =
+        std::max<int64_t>((num_calls * percent + 99) / 100, 1);
+    int64_t accumulated = 0;
+    for (size_t k = 0; k < kNumBins; ++k) {
+      accumulated += counts[k];
+      if (accumulated >= rank) {
+        return std::min(BinUpperBound(k), stats.max_ns);
+      }
+    }
+    return stats.max_ns;
+  };
+  stats.p50_ns = percentile(50);
+  stats.p90_ns = percentile(90);
+  stats.p99_ns = percentile(99);
+  return stats;
+}
+
+ProcessingTimeMeasurement::ScopedSection::ScopedSection(
+    ProcessingTimeMeasurement* measurement)
+    : measurement_(measurement) {
+  if (measurement_->enabled_) {
+    start_ns_ = rtc::TimeNanos();
+  }
+}
+
+ProcessingTimeMeasurement::ScopedSection::~ScopedSection() {
+  if (measurement_->enabled_) {
+    measurement_->duration_ns_ += rtc::TimeNanos() - start_ns_;
+    measurement_->timed_ = true;
+  }
+}
+
+ProcessingTimeMeasurement::ProcessingTimeMeasurement(
+    ProcessingTimeHistogram* histogram,
+    bool enabled)
+    : histogram_(histogram), enabled_(enabled) {
+  RTC_DCHECK(histogram_);
+}
+
+ProcessingTimeMeasurement::~ProcessingTimeMeasurement() {
+  if (timed_) {
+    histogram_->Add(duration_ns_);
+  }
+}
+
+}  // namespace webrtc
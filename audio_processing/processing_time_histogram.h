@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_PROCESSING_TIME_HISTOGRAM_H_
+#define MODULES_AUDIO_PROCESSING_PROCESSING_TIME_HISTOGRAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "absl/types/optional.h"
+#include "modules/audio_processing/include/audio_processing_statistics.h"
+
+namespace webrtc {
+
+// Histogram of processing times with logarithmically spaced bins, four per
+// octave. Add() is wait-free and the bins are atomic, so the histogram can be
+// read from any thread while the processing thread keeps adding measurements.
+// The reported percentiles are upper bounds that exceed the exact values by at
+// most 25%.
+class ProcessingTimeHistogram {
+ public:
+  ProcessingTimeHistogram();
+  ProcessingTimeHistogram(const ProcessingTimeHistogram&) = delete;
+  ProcessingTimeHistogram& operator=(const ProcessingTimeHistogram&) = delete;
+
+  // Adds a measurement. Must only be called from one thread at a time.
+  void Add(int64_t duration_ns);
+
+  // Removes all measurements. Must not be called concurrently with Add().
+  void Reset();
+
+  // Returns the statistics of the measurements added since the last reset, or
+  // absl::nullopt if there are none. Measurements added during the call may
+  // be partially accounted for.
+  absl::optional<AudioProcessingStats::ProcessingTime> GetStatistics() const;
+
+ private:
+  static constexpr size_t kNumBins = 256;
+
+  std::array<std::atomic<uint32_t>, kNumBins> bins_;
+  std::atomic<int64_t> max_duration_ns_;
+};
+
+// Measures the total duration of the sections timed during its lifetime and
+// adds it as one measurement to a histogram when destroyed. Does nothing when
+// disabled, apart from checking a flag.
+class ProcessingTimeMeasurement {
+ public:
+  // Times a section of the processing.
+  class ScopedSection {
+   public:
+    explicit ScopedSection(ProcessingTimeMeasurement* measurement);
+    ~ScopedSection();
+    ScopedSection(const ScopedSection&) = delete;
+    ScopedSection& operator=(const ScopedSection&) = delete;
+
+   private:
+    ProcessingTimeMeasurement* const measurement_;
+    int64_t start_ns_ = 0;
+  };
+
+  ProcessingTimeMeasurement(ProcessingTimeHistogram* histogram, bool enabled);
+  ~ProcessingTimeMeasurement();
+  ProcessingTimeMeasurement(const ProcessingTimeMeasurement&) = delete;
+  ProcessingTimeMeasurement& operator=(const ProcessingTimeMeasurement&) =
+      delete;
+
+ private:
+  ProcessingTimeHistogram* const histogram_;
+  const bool enabled_;
+  bool timed_ = false;
+  int64_t duration_ns_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_PROCESSING_TIME_HISTOGRAM_H_
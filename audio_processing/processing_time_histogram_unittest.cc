@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/processing_time_histogram.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(ProcessingTimeHistogram, ReportsNothingWithoutMeasurements) {
+  ProcessingTimeHistogram histogram;
+  EXPECT_FALSE(histogram.GetStatistics());
+  histogram.Add(1000);
+  EXPECT_TRUE(histogram.GetStatistics());
+  histogram.Reset();
+  EXPECT_FALSE(histogram.GetStatistics());
+}
+
+// Verifies that the percentiles are upper bounds within 25% of the exact
+// values.
+TEST(ProcessingTimeHistogram, PercentilesBoundExactValues) {
+  ProcessingTimeHistogram histogram;
+  for (int64_t k = 1; k <= 1000; ++k) {
+    histogram.Add(1000 * k);
+  }
+  const auto stats = histogram.GetStatistics();
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(1000, stats->num_calls);
+  EXPECT_EQ(1000000, stats->max_ns);
+  EXPECT_GE(stats->p50_ns, 500000);
+  EXPECT_LE(stats->p50_ns, 625000);
+  EXPECT_GE(stats->p90_ns, 900000);
+  EXPECT_LE(stats->p90_ns, 1000000);
+  EXPECT_GE(stats->p99_ns, 990000);
+  EXPECT_LE(stats->p99_ns, 1000000);
+}
+
+TEST(ProcessingTimeHistogram, HandlesExtremeDurations) {
+  ProcessingTimeHistogram histogram;
+  histogram.Add(0);
+  histogram.Add(-5);
+  histogram.Add(3);
+  histogram.Add(INT64_MAX);
+  const auto stats = histogram.GetStatistics();
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(4, stats->num_calls);
+  EXPECT_EQ(0, stats->p50_ns);
+  EXPECT_EQ(INT64_MAX, stats->max_ns);
+  EXPECT_EQ(INT64_MAX, stats->p99_ns);
+}
+
+TEST(ProcessingTimeMeasurement, AddsOneMeasurementPerTimedLifetime) {
+  ProcessingTimeHistogram histogram;
+  { ProcessingTimeMeasurement untimed(&histogram, /*enabled=*/true); }
+  {
+    ProcessingTimeMeasurement disabled(&histogram, /*enabled=*/false);
+    ProcessingTimeMeasurement::ScopedSection section(&disabled);
+  }
+  EXPECT_FALSE(histogram.GetStatistics());
+
+  {
+    ProcessingTimeMeasurement measurement(&histogram, /*enabled=*/true);
+    { ProcessingTimeMeasurement::ScopedSection section(&measurement); }
+    { ProcessingTimeMeasurement::ScopedSection section(&measurement); }
+  }
+  const auto stats = histogram.GetStatistics();
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(1, stats->num_calls);
+}
+
+}  // namespace webrtc
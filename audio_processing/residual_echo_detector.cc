@@ -44,15 +44,25 @@ namespace webrtc {
 
 int ResidualEchoDetector::instance_count_ = 0;
 
-ResidualEchoDetector::ResidualEchoDetector()
+ResidualEchoDetector::ResidualEchoDetector() : ResidualEchoDetector(1) {}
+
+ResidualEchoDetector::ResidualEchoDetector(size_t lag_decimation)
     : data_dumper_(
           new ApmDataDumper(rtc::AtomicOps::Increment(&instance_count_))),
       render_buffer_(kRenderBufferSize),
-      render_power_(kLookbackFrames),
-      render_power_mean_(kLookbackFrames),
-      render_power_std_dev_(kLookbackFrames),
-      covariances_(kLookbackFrames),
-      recent_likelihood_max_(kAggregationBufferSize) {}
+      render_power_(2 * kLookbackFrames),
+      render_power_mean_(2 * kLookbackFrames),
+      render_power_std_dev_(2 * kLookbackFrames),
+      lag_decimation_(lag_decimation),
+      covariances_((kLookbackFrames + lag_decimation - 1) / lag_decimation),
+      recent_likelihood_max_(kAggregationBufferSize) {
+  RTC_DCHECK_GE(lag_decimation_, 1);
+  if (lag_decimation_ > 1) {
+    decimated_render_power_.resize(covariances_.num_lags());
+    decimated_render_power_mean_.resize(covariances_.num_lags());
+    decimated_render_power_std_dev_.resize(covariances_.num_lags());
+  }
+}
 
 ResidualEchoDetector::~ResidualEchoDetector() = default;
 
@@ -99,13 +109,16 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
     // TODO(ivoc): Include how often this happens in APM stats.
     return;
   }
-  // Update the render statistics, and store the statistics in circular buffers.
+  // Update the render statistics, and store the statistics in circular buffers
+  // as the values of delay zero, which drops those of the largest delay.
   render_statistics_.Update(*buffered_render_power);
-  RTC_DCHECK_LT(next_insertion_index_, kLookbackFrames);
-  render_power_[next_insertion_index_] = *buffered_render_power;
-  render_power_mean_[next_insertion_index_] = render_statistics_.mean();
-  render_power_std_dev_[next_insertion_index_] =
-      render_statistics_.std_deviation();
+  render_position_ =
+      render_position_ > 0 ? render_position_ - 1 : kLookbackFrames - 1;
+  for (size_t index : {render_position_, render_position_ + kLookbackFrames}) {
+    render_power_[index] = *buffered_render_power;
+    render_power_mean_[index] = render_statistics_.mean();
+    render_power_std_dev_[index] = render_statistics_.std_deviation();
+  }
 
   // Get the next capture value, update capture statistics and add the relevant
   // values to the buffers.
@@ -115,21 +128,34 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
   const float capture_std_deviation = capture_statistics_.std_deviation();
 
   // Update the covariance values and determine the new echo likelihood.
+  rtc::ArrayView<const float> render_power(&render_power_[render_position_],
+                                           kLookbackFrames);
+  rtc::ArrayView<const float> render_power_mean(
+      &render_power_mean_[render_position_], kLookbackFrames);
+  rtc::ArrayView<const float> render_power_std_dev(
+      &render_power_std_dev_[render_position_], kLookbackFrames);
+  if (lag_decimation_ > 1) {
+    for (size_t lag = 0; lag < covariances_.num_lags(); ++lag) {
+      const size_t delay = lag * lag_decimation_;
+      decimated_render_power_[lag] = render_power[delay];
+      decimated_render_power_mean_[lag] = render_power_mean[delay];
+      decimated_render_power_std_dev_[lag] = render_power_std_dev[delay];
+    }
+    render_power = decimated_render_power_;
+    render_power_mean = decimated_render_power_mean_;
+    render_power_std_dev = decimated_render_power_std_dev_;
+  }
+  covariances_.Update(capture_power, capture_mean, capture_std_deviation,
+                      render_power, render_power_mean, render_power_std_dev);
+
   echo_likelihood_ = 0.f;
-  size_t read_index = next_insertion_index_;
-
-  int best_delay = -1;
-  for (size_t delay = 0; delay < covariances_.size(); ++delay) {
-    RTC_DCHECK_LT(read_index, render_power_.size());
-    covariances_[delay].Update(capture_power, capture_mean,
-                               capture_std_deviation, render_power_[read_index],
-                               render_power_mean_[read_index],
-                               render_power_std_dev_[read_index]);
-    read_index = read_index > 0 ? read_index - 1 : kLookbackFrames - 1;
-
-    if (covariances_[delay].normalized_cross_correlation() > echo_likelihood_) {
-      echo_likelihood_ = covariances_[delay].normalized_cross_correlation();
-      best_delay = static_cast<int>(delay);
+  int best_lag = -1;
+  rtc::ArrayView<const float> normalized_cross_correlations =
+      covariances_.normalized_cross_correlations();
+  for (size_t lag = 0; lag < normalized_cross_correlations.size(); ++lag) {
+    if (normalized_cross_correlations[lag] > echo_likelihood_) {
+      echo_likelihood_ = normalized_cross_correlations[lag];
+      best_lag = static_cast<int>(lag);
     }
   }
   // This is a temporary log message to help find the underlying cause for echo
@@ -137,17 +163,15 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
   // TODO(ivoc): Remove once the issue is resolved.
   if (echo_likelihood_ > 1.1f) {
     // Make sure we don't spam the log.
-    if (log_counter_ < 5 && best_delay != -1) {
-      size_t read_index = kLookbackFrames + next_insertion_index_ - best_delay;
-      if (read_index >= kLookbackFrames) {
-        read_index -= kLookbackFrames;
-      }
+    if (log_counter_ < 5 && best_lag != -1) {
+      const size_t best_delay = best_lag * lag_decimation_;
+      const size_t read_index = render_position_ + best_delay;
       RTC_DCHECK_LT(read_index, render_power_.size());
       RTC_LOG_F(LS_ERROR) << "Echo detector internal state: {"
                              "Echo likelihood: "
                           << echo_likelihood_ << ", Best Delay: " << best_delay
                           << ", Covariance: "
-                          << covariances_[best_delay].covariance()
+                          << covariances_.covariance(best_lag)
                           << ", Last capture power: " << capture_power
                           << ", Capture mean: " << capture_mean
                           << ", Capture_standard deviation: "
@@ -173,11 +197,6 @@ void ResidualEchoDetector::AnalyzeCaptureAudio(
 
   // Update the buffer of recent likelihood values.
   recent_likelihood_max_.Update(echo_likelihood_);
-
-  // Update the next insertion index.
-  next_insertion_index_ = next_insertion_index_ < (kLookbackFrames - 1)
-                              ? next_insertion_index_ + 1
-                              : 0;
 }
 
 void ResidualEchoDetector::Initialize(int /*capture_sample_rate_hz*/,
@@ -191,11 +210,9 @@ void ResidualEchoDetector::Initialize(int /*capture_sample_rate_hz*/,
   render_statistics_.Clear();
   capture_statistics_.Clear();
   recent_likelihood_max_.Clear();
-  for (auto& cov : covariances_) {
-    cov.Clear();
-  }
+  covariances_.Clear();
   echo_likelihood_ = 0.f;
-  next_insertion_index_ = 0;
+  render_position_ = 0;
   reliability_ = 0.f;
 }
 
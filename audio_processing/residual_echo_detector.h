@@ -17,7 +17,7 @@
 #include "modules/audio_processing/echo_detector/circular_buffer.h"
 #include "modules/audio_processing/echo_detector/mean_variance_estimator.h"
 #include "modules/audio_processing/echo_detector/moving_max.h"
-#include "modules/audio_processing/echo_detector/normalized_covariance_estimator.h"
+#include "modules/audio_processing/echo_detector/multi_lag_covariance_estimator.h"
 #include "modules/audio_processing/include/audio_processing.h"
 
 namespace webrtc {
@@ -28,6 +28,10 @@ class AudioBuffer;
 class ResidualEchoDetector : public EchoDetector {
  public:
   ResidualEchoDetector();
+  // Only analyzes the delays that are multiples of |lag_decimation| frames,
+  // which divides the cost of the covariance updates by |lag_decimation| at
+  // the price of a coarser delay resolution.
+  explicit ResidualEchoDetector(size_t lag_decimation);
   ~ResidualEchoDetector() override;
 
   // This function should be called while holding the render lock.
@@ -64,15 +68,22 @@ class ResidualEchoDetector : public EchoDetector {
   size_t frames_since_zero_buffer_size_ = 0;
 
   // Circular buffers containing delayed versions of the power, mean and
-  // standard deviation, for calculating the delayed covariance values.
+  // standard deviation, for calculating the delayed covariance values. Each
+  // value is stored twice, kLookbackFrames apart, such that the values of all
+  // delays are contiguous from |render_position_|, in increasing delay order.
   std::vector<float> render_power_;
   std::vector<float> render_power_mean_;
   std::vector<float> render_power_std_dev_;
-  // Covariance estimates for different delay values.
-  std::vector<NormalizedCovarianceEstimator> covariances_;
-  // Index where next element should be inserted in all of the above circular
-  // buffers.
-  size_t next_insertion_index_ = 0;
+  // Index of the values of delay zero in all of the above circular buffers.
+  size_t render_position_ = 0;
+  // The delays analyzed are the multiples of |lag_decimation_|.
+  const size_t lag_decimation_;
+  // The render values of the analyzed delays when |lag_decimation_| > 1.
+  std::vector<float> decimated_render_power_;
+  std::vector<float> decimated_render_power_mean_;
+  std::vector<float> decimated_render_power_std_dev_;
+  // Covariance estimates for the analyzed delay values.
+  MultiLagCovarianceEstimator covariances_;
 
   MeanVarianceEstimator render_statistics_;
   MeanVarianceEstimator capture_statistics_;
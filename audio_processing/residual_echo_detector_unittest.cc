@@ -44,6 +44,33 @@ TEST(ResidualEchoDetectorTests, Echo) {
   EXPECT_NEAR(1.f, ed_metrics.echo_likelihood, 0.01f);
 }
 
+TEST(ResidualEchoDetectorTests, EchoWithLagDecimation) {
+  rtc::scoped_refptr<ResidualEchoDetector> echo_detector =
+      new rtc::RefCountedObject<ResidualEchoDetector>(5);
+  echo_detector->SetReliabilityForTest(1.0f);
+  std::vector<float> ones(160, 1.f);
+  std::vector<float> zeros(160, 0.f);
+
+  // In this test the capture signal has a delay of 10 frames w.r.t. the render
+  // signal, which is one of the analyzed delays, but is otherwise identical.
+  // Both signals are periodic with a 20 frame interval.
+  for (int i = 0; i < 1000; i++) {
+    if (i % 20 == 0) {
+      echo_detector->AnalyzeRenderAudio(ones);
+      echo_detector->AnalyzeCaptureAudio(zeros);
+    } else if (i % 20 == 10) {
+      echo_detector->AnalyzeRenderAudio(zeros);
+      echo_detector->AnalyzeCaptureAudio(ones);
+    } else {
+      echo_detector->AnalyzeRenderAudio(zeros);
+      echo_detector->AnalyzeCaptureAudio(zeros);
+    }
+  }
+  // We expect to detect echo with near certain likelihood.
+  auto ed_metrics = echo_detector->GetMetrics();
+  EXPECT_NEAR(1.f, ed_metrics.echo_likelihood, 0.01f);
+}
+
 TEST(ResidualEchoDetectorTests, NoEcho) {
   rtc::scoped_refptr<ResidualEchoDetector> echo_detector =
       new rtc::RefCountedObject<ResidualEchoDetector>();
@@ -597,6 +597,11 @@ void AecDumpBasedSimulator::HandleMessage(
     ap_->SetRuntimeSetting(
         AudioProcessing::RuntimeSetting::CreatePlayoutVolumeChange(
             msg.playout_volume_change()));
+  } else if (msg.has_capture_performance_tier()) {
+    ap_->SetRuntimeSetting(
+        AudioProcessing::RuntimeSetting::CreateCapturePerformanceTier(
+            static_cast<AudioProcessing::Config::PerformanceTier::Tier>(
+                msg.capture_performance_tier())));
   }
 }
 
@@ -25,6 +25,18 @@ void ApiCallStatistics::Add(int64_t duration_nanos, CallType call_type) {
   calls_.push_back(CallData(duration_nanos, call_type));
 }
 
+void ApiCallStatistics::Add(const ApiCallStatistics& other) {
+  calls_.insert(calls_.end(), other.calls_.begin(), other.calls_.end());
+}
+
+int64_t ApiCallStatistics::GetTotalDurationNanos() const {
+  int64_t sum = 0;
+  for (auto v : calls_) {
+    sum += v.duration_nanos;
+  }
+  return sum;
+}
+
 void ApiCallStatistics::PrintReport() const {
   int64_t min_render = std::numeric_limits<int64_t>::max();
   int64_t min_capture = std::numeric_limits<int64_t>::max();
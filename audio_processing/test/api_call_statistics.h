@@ -25,6 +25,12 @@ class ApiCallStatistics {
   // Adds a new datapoint.
   void Add(int64_t duration_nanos, CallType call_type);
 
+  // Adds all the datapoints of |other|.
+  void Add(const ApiCallStatistics& other);
+
+  // Returns the sum of the durations of all calls.
+  int64_t GetTotalDurationNanos() const;
+
   // Prints out a report of the statistics.
   void PrintReport() const;
 
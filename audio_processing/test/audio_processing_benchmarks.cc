@@ -0,0 +1,325 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the APM throughput for a sweep of sample rates, channel counts and
+// submodule configurations, and writes the results as JSON or CSV.
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/string_to_number.h"
+#include "rtc_base/time_utils.h"
+
+ABSL_FLAG(std::string,
+          sample_rates,
+          "8000,16000,32000,48000",
+          "Comma-separated list of sample rates in Hz.");
+ABSL_FLAG(std::string,
+          num_channels,
+          "1,2",
+          "Comma-separated list of capture and render channel counts.");
+ABSL_FLAG(std::string,
+          configs,
+          "all",
+          "Comma-separated list of submodule configurations, or all.");
+ABSL_FLAG(int, num_frames, 1000, "Number of measured 10 ms frames per run.");
+ABSL_FLAG(int,
+          num_warmup_frames,
+          100,
+          "Number of unmeasured 10 ms frames processed before each run.");
+ABSL_FLAG(std::string, format, "json", "Output format: json or csv.");
+ABSL_FLAG(std::string, output_file, "", "Output file, stdout if empty.");
+
+namespace webrtc {
+namespace {
+
+const char kUsage[] =
+    "Usage: audio_processing_benchmarks [--sample_rates=<list>]\n"
+    "           [--num_channels=<list>] [--configs=<list>]\n"
+    "           [--num_frames=<n>] [--num_warmup_frames=<n>]\n"
+    "           [--format=json|csv] [--output_file=<path>]\n"
+    "\n"
+    "Processes synthetic render and capture audio through APM and reports\n"
+    "the processing time per 10 ms frame for each combination of sample\n"
+    "rate, channel count and submodule configuration.\n";
+
+struct NamedConfig {
+  const char* name;
+  AudioProcessing::Config config;
+};
+
+std::vector<NamedConfig> CreateConfigs() {
+  std::vector<NamedConfig> configs;
+  AudioProcessing::Config none;
+  none.residual_echo_detector.enabled = false;
+  configs.push_back({"none", none});
+
+  AudioProcessing::Config hpf = none;
+  hpf.high_pass_filter.enabled = true;
+  configs.push_back({"hpf", hpf});
+
+  const struct {
+    const char* name;
+    AudioProcessing::Config::NoiseSuppression::Level level;
+  } kNsLevels[] = {
+      {"ns_low", AudioProcessing::Config::NoiseSuppression::kLow},
+      {"ns_moderate", AudioProcessing::Config::NoiseSuppression::kModerate},
+      {"ns_high", AudioProcessing::Config::NoiseSuppression::kHigh},
+      {"ns_very_high", AudioProcessing::Config::NoiseSuppression::kVeryHigh}};
+  for (const auto& ns_level : kNsLevels) {
+    AudioProcessing::Config ns = none;
+    ns.noise_suppression.enabled = true;
+    ns.noise_suppression.level = ns_level.level;
+    configs.push_back({ns_level.name, ns});
+  }
+
+  AudioProcessing::Config aec3 = none;
+  aec3.echo_canceller.enabled = true;
+  configs.push_back({"aec3", aec3});
+
+  AudioProcessing::Config aecm = none;
+  aecm.echo_canceller.enabled = true;
+  aecm.echo_canceller.mobile_mode = true;
+  configs.push_back({"aecm", aecm});
+
+  AudioProcessing::Config agc1 = none;
+  agc1.gain_controller1.enabled = true;
+  agc1.gain_controller1.mode =
+      AudioProcessing::Config::GainController1::kAdaptiveDigital;
+  configs.push_back({"agc1", agc1});
+
+  AudioProcessing::Config agc2 = none;
+  agc2.gain_controller2.enabled = true;
+  agc2.gain_controller2.adaptive_digital.enabled = true;
+  configs.push_back({"agc2", agc2});
+
+  // Typical desktop and mobile setups.
+  AudioProcessing::Config desktop = aec3;
+  desktop.high_pass_filter.enabled = true;
+  desktop.noise_suppression.enabled = true;
+  desktop.gain_controller2 = agc2.gain_controller2;
+  desktop.residual_echo_detector.enabled = true;
+  configs.push_back({"aec3_ns_agc2", desktop});
+
+  AudioProcessing::Config mobile = aecm;
+  mobile.high_pass_filter.enabled = true;
+  mobile.noise_suppression.enabled = true;
+  mobile.gain_controller1 = agc1.gain_controller1;
+  configs.push_back({"aecm_ns_agc1", mobile});
+  return configs;
+}
+
+std::vector<int> ParseIntList(const std::string& list) {
+  std::vector<int> values;
+  for (absl::string_view item : absl::StrSplit(list, ',')) {
+    absl::optional<int> value = rtc::StringToNumber<int>(std::string(item));
+    RTC_CHECK(value && *value > 0) << "Invalid list item: " << item;
+    values.push_back(*value);
+  }
+  return values;
+}
+
+struct Result {
+  std::string config_name;
+  int sample_rate_hz;
+  int num_channels;
+  int error = AudioProcessing::kNoError;
+  double render_ns_per_frame = 0.0;
+  double capture_ns_per_frame = 0.0;
+  int64_t capture_p50_ns = 0;
+  int64_t capture_p99_ns = 0;
+};
+
+// Fills |channels| with a frame of noise at about -20 dBFS, which keeps the
+// level-dependent submodules in their active states.
+void FillWithNoise(Random* random_generator,
+                   std::vector<std::vector<float>>* channels) {
+  for (auto& channel : *channels) {
+    for (float& sample : channel) {
+      sample = static_cast<float>(random_generator->Gaussian(0.0, 0.1));
+    }
+  }
+}
+
+Result RunBenchmark(const NamedConfig& named_config,
+                    int sample_rate_hz,
+                    int num_channels,
+                    int num_frames,
+                    int num_warmup_frames) {
+  Result result;
+  result.config_name = named_config.name;
+  result.sample_rate_hz = sample_rate_hz;
+  result.num_channels = num_channels;
+
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  apm->ApplyConfig(named_config.config);
+
+  const StreamConfig stream_config(sample_rate_hz, num_channels);
+  std::vector<std::vector<float>> render(
+      num_channels, std::vector<float>(stream_config.num_frames()));
+  std::vector<std::vector<float>> capture = render;
+  std::vector<float*> render_channels;
+  std::vector<float*> capture_channels;
+  for (int ch = 0; ch < num_channels; ++ch) {
+    render_channels.push_back(render[ch].data());
+    capture_channels.push_back(capture[ch].data());
+  }
+
+  Random random_generator(42);
+  int64_t render_duration_ns = 0;
+  std::vector<int64_t> capture_durations_ns;
+  capture_durations_ns.reserve(num_frames);
+  for (int frame = 0; frame < num_warmup_frames + num_frames; ++frame) {
+    FillWithNoise(&random_generator, &render);
+    FillWithNoise(&random_generator, &capture);
+
+    const int64_t render_start_ns = rtc::TimeNanos();
+    result.error =
+        apm->ProcessReverseStream(render_channels.data(), stream_config,
+                                  stream_config, render_channels.data());
+    const int64_t capture_start_ns = rtc::TimeNanos();
+    if (result.error == AudioProcessing::kNoError) {
+      apm->set_stream_delay_ms(0);
+      result.error =
+          apm->ProcessStream(capture_channels.data(), stream_config,
+                             stream_config, capture_channels.data());
+    }
+    const int64_t end_ns = rtc::TimeNanos();
+    if (result.error != AudioProcessing::kNoError) {
+      return result;
+    }
+
+    if (frame >= num_warmup_frames) {
+      render_duration_ns += capture_start_ns - render_start_ns;
+      capture_durations_ns.push_back(end_ns - capture_start_ns);
+    }
+  }
+
+  int64_t capture_duration_ns = 0;
+  for (int64_t duration_ns : capture_durations_ns) {
+    capture_duration_ns += duration_ns;
+  }
+  result.render_ns_per_frame =
+      static_cast<double>(render_duration_ns) / num_frames;
+  result.capture_ns_per_frame =
+      static_cast<double>(capture_duration_ns) / num_frames;
+  std::sort(capture_durations_ns.begin(), capture_durations_ns.end());
+  result.capture_p50_ns = capture_durations_ns[(num_frames - 1) / 2];
+  result.capture_p99_ns = capture_durations_ns[(num_frames - 1) * 99 / 100];
+  return result;
+}
+
+void WriteJson(const std::vector<Result>& results, FILE* file) {
+  fprintf(file, "{\n  \"benchmarks\": [");
+  for (size_t k = 0; k < results.size(); ++k) {
+    const Result& r = results[k];
+    fprintf(file,
+            "%s\n    {\"name\": \"%s/%d/%d\", \"config\": \"%s\", "
+            "\"sample_rate_hz\": %d, \"num_channels\": %d, \"error\": %d, "
+            "\"render_ns_per_frame\": %.0f, \"capture_ns_per_frame\": %.0f, "
+            "\"capture_p50_ns\": %lld, \"capture_p99_ns\": %lld}",
+            k == 0 ? "" : ",", r.config_name.c_str(), r.sample_rate_hz,
+            r.num_channels, r.config_name.c_str(), r.sample_rate_hz,
+            r.num_channels, r.error, r.render_ns_per_frame,
+            r.capture_ns_per_frame, static_cast<long long>(r.capture_p50_ns),
+            static_cast<long long>(r.capture_p99_ns));
+  }
+  fprintf(file, "\n  ]\n}\n");
+}
+
+void WriteCsv(const std::vector<Result>& results, FILE* file) {
+  fprintf(file,
+          "config,sample_rate_hz,num_channels,error,render_ns_per_frame,"
+          "capture_ns_per_frame,capture_p50_ns,capture_p99_ns\n");
+  for (const Result& r : results) {
+    fprintf(file, "%s,%d,%d,%d,%.0f,%.0f,%lld,%lld\n", r.config_name.c_str(),
+            r.sample_rate_hz, r.num_channels, r.error, r.render_ns_per_frame,
+            r.capture_ns_per_frame, static_cast<long long>(r.capture_p50_ns),
+            static_cast<long long>(r.capture_p99_ns));
+  }
+}
+
+}  // namespace
+
+int RunBenchmarks() {
+  const std::string format = absl::GetFlag(FLAGS_format);
+  const int num_frames = absl::GetFlag(FLAGS_num_frames);
+  const int num_warmup_frames = absl::GetFlag(FLAGS_num_warmup_frames);
+  if ((format != "json" && format != "csv") || num_frames <= 0 ||
+      num_warmup_frames < 0) {
+    printf("%s", kUsage);
+    return 1;
+  }
+
+  const std::vector<NamedConfig> all_configs = CreateConfigs();
+  std::vector<NamedConfig> configs;
+  const std::string config_list = absl::GetFlag(FLAGS_configs);
+  if (config_list == "all") {
+    configs = all_configs;
+  } else {
+    for (absl::string_view name : absl::StrSplit(config_list, ',')) {
+      auto it = std::find_if(
+          all_configs.begin(), all_configs.end(),
+          [name](const NamedConfig& config) { return name == config.name; });
+      if (it == all_configs.end()) {
+        fprintf(stderr, "Unknown config: %s\n", std::string(name).c_str());
+        return 1;
+      }
+      configs.push_back(*it);
+    }
+  }
+
+  std::vector<Result> results;
+  for (const NamedConfig& config : configs) {
+    for (int sample_rate_hz : ParseIntList(absl::GetFlag(FLAGS_sample_rates))) {
+      for (int num_channels : ParseIntList(absl::GetFlag(FLAGS_num_channels))) {
+        results.push_back(RunBenchmark(config, sample_rate_hz, num_channels,
+                                       num_frames, num_warmup_frames));
+      }
+    }
+  }
+
+  const std::string output_file = absl::GetFlag(FLAGS_output_file);
+  FILE* file = output_file.empty() ? stdout : fopen(output_file.c_str(), "w");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", output_file.c_str());
+    return 1;
+  }
+  if (format == "json") {
+    WriteJson(results, file);
+  } else {
+    WriteCsv(results, file);
+  }
+  if (file != stdout) {
+    fclose(file);
+  }
+  return 0;
+}
+
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 1) {
+    printf("%s", webrtc::kUsage);
+    return 1;
+  }
+  return webrtc::RunBenchmarks();
+}
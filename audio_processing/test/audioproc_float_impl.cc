@@ -12,6 +12,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -24,9 +26,12 @@
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/audio_processing/test/aec_dump_based_simulator.h"
 #include "modules/audio_processing/test/audio_processing_simulator.h"
+#include "modules/audio_processing/test/simulation_batch.h"
 #include "modules/audio_processing/test/wav_based_simulator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/string_encode.h"
 #include "rtc_base/strings/string_builder.h"
+#include "system_wrappers/include/cpu_info.h"
 
 constexpr int kParameterNotSpecifiedValue = -10000;
 
@@ -265,6 +270,18 @@ ABSL_FLAG(std::string,
           dump_data_output_dir,
           "",
           "Internal data dump output directory");
+ABSL_FLAG(std::string,
+          batch_manifest,
+          "",
+          "File listing the inputs of a batch of simulations, one simulation "
+          "per line as space-separated key=value pairs with the keys "
+          "dump_input, i, ri, o, ro and aec_settings. The other flags apply "
+          "to all the simulations");
+ABSL_FLAG(int,
+          batch_num_threads,
+          0,
+          "Number of simulations of the batch to run in parallel (0 uses one "
+          "per core)");
 
 namespace webrtc {
 namespace test {
@@ -274,6 +291,8 @@ const char kUsageDescription[] =
     "Usage: audioproc_f [options] -i <input.wav>\n"
     "                   or\n"
     "       audioproc_f [options] -dump_input <aec_dump>\n"
+    "                   or\n"
+    "       audioproc_f [options] -batch_manifest <manifest>\n"
     "\n\n"
     "Command-line tool to simulate a call using the audio "
     "processing module, either based on wav files or "
@@ -632,6 +651,121 @@ void PerformBasicParameterSanityChecks(const SimulationSettings& settings) {
       "specified and set.\n");
 }
 
+void PerformBatchParameterSanityChecks(const SimulationSettings& settings) {
+  ReportConditionalErrorAndExit(
+      settings.input_filename || settings.reverse_input_filename ||
+          settings.output_filename || settings.reverse_output_filename ||
+          settings.aec_dump_input_filename,
+      "Error: --i, --ri, --o, --ro and --dump_input must be specified per "
+      "simulation in the batch manifest.\n");
+
+  ReportConditionalErrorAndExit(
+      settings.aec_dump_output_filename || settings.ed_graph_output_filename ||
+          settings.call_order_input_filename ||
+          settings.call_order_output_filename,
+      "Error: --dump_output, --ed_graph, --custom_call_order_file and "
+      "--output_custom_call_order_file cannot be used with "
+      "--batch_manifest.\n");
+
+  ReportConditionalErrorAndExit(
+      settings.dump_internal_data,
+      "Error: --dump_data cannot be used with --batch_manifest.\n");
+
+  ReportConditionalErrorAndExit(
+      absl::GetFlag(FLAGS_batch_num_threads) < 0,
+      "Error: --batch_num_threads cannot be negative.\n");
+}
+
+// Reads the settings of the simulations listed in |manifest_filename|, on top
+// of |base_settings|. Empty lines and lines starting with '#' are skipped.
+std::vector<SimulationSettings> ReadBatchManifest(
+    const std::string& manifest_filename,
+    const SimulationSettings& base_settings) {
+  std::ifstream manifest(manifest_filename);
+  ReportConditionalErrorAndExit(
+      !manifest.is_open(),
+      "Error: Cannot open the batch manifest " + manifest_filename + "\n");
+
+  std::vector<SimulationSettings> batch;
+  std::string line;
+  for (int line_number = 1; std::getline(manifest, line); ++line_number) {
+    std::vector<std::string> tokens;
+    rtc::tokenize(line, ' ', &tokens);
+    if (tokens.empty() || tokens[0][0] == '#') {
+      continue;
+    }
+
+    SimulationSettings settings = base_settings;
+    for (const auto& token : tokens) {
+      std::string key;
+      std::string value;
+      const bool valid_pair = rtc::tokenize_first(token, '=', &key, &value);
+      const std::string error_prefix = "Error: Batch manifest line " +
+                                       std::to_string(line_number) + ": ";
+      ReportConditionalErrorAndExit(
+          !valid_pair || value.empty(),
+          error_prefix + "Expected key=value instead of " + token + "\n");
+      if (key == "dump_input") {
+        settings.aec_dump_input_filename = value;
+      } else if (key == "i") {
+        settings.input_filename = value;
+      } else if (key == "ri") {
+        settings.reverse_input_filename = value;
+      } else if (key == "o") {
+        settings.output_filename = value;
+      } else if (key == "ro") {
+        settings.reverse_output_filename = value;
+      } else if (key == "aec_settings") {
+        settings.aec_settings_filename = value;
+      } else {
+        ReportConditionalErrorAndExit(
+            true, error_prefix + "Unknown key " + key + "\n");
+      }
+    }
+    PerformBasicParameterSanityChecks(settings);
+    batch.push_back(settings);
+  }
+  return batch;
+}
+
+int RunBatch(const SimulationSettings& base_settings) {
+  PerformBatchParameterSanityChecks(base_settings);
+  const std::vector<SimulationSettings> batch =
+      ReadBatchManifest(absl::GetFlag(FLAGS_batch_manifest), base_settings);
+  size_t num_threads = absl::GetFlag(FLAGS_batch_num_threads);
+  if (num_threads == 0) {
+    num_threads =
+        static_cast<size_t>(std::max(CpuInfo::DetectNumberOfCores(), 1u));
+  }
+
+  const std::vector<SimulationResult> results =
+      RunSimulationBatch(batch, num_threads);
+
+  ApiCallStatistics aggregated_statistics;
+  for (size_t k = 0; k < batch.size(); ++k) {
+    const SimulationSettings& settings = batch[k];
+    std::cout << (settings.aec_dump_input_filename
+                      ? *settings.aec_dump_input_filename
+                      : *settings.input_filename)
+              << ": real-time factor " << results[k].RealTimeFactor();
+    if (base_settings.report_bitexactness) {
+      std::cout << (results[k].bitexact_output ? ", bitexact"
+                                               : ", not bitexact");
+    }
+    std::cout << std::endl;
+    aggregated_statistics.Add(results[k].api_call_statistics);
+  }
+
+  if (base_settings.report_performance) {
+    aggregated_statistics.PrintReport();
+  }
+  if (base_settings.performance_report_output_filename) {
+    aggregated_statistics.WriteReportToFile(
+        *base_settings.performance_report_output_filename);
+  }
+  return 0;
+}
+
 }  // namespace
 
 int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
@@ -646,6 +780,15 @@ int AudioprocFloatImpl(std::unique_ptr<AudioProcessingBuilder> ap_builder,
   }
 
   SimulationSettings settings = CreateSettings();
+  if (!absl::GetFlag(FLAGS_batch_manifest).empty()) {
+    // The simulations of the batch run at the same time and need an
+    // AudioProcessingBuilder each, so |ap_builder| cannot be used.
+    ReportConditionalErrorAndExit(
+        !input_aecdump.empty(),
+        "Error: --batch_manifest cannot be used with an input aec dump "
+        "string.\n");
+    return RunBatch(settings);
+  }
   if (!input_aecdump.empty()) {
     settings.aec_dump_input_string = input_aecdump;
     settings.processed_capture_samples = processed_capture_samples;
@@ -8,10 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <iostream>
-#include <vector>
-
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -20,11 +21,23 @@
 #include "modules/audio_processing/test/conversational_speech/simulator.h"
 #include "modules/audio_processing/test/conversational_speech/timing.h"
 #include "modules/audio_processing/test/conversational_speech/wavreader_factory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/string_encode.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "test/testsupport/file_utils.h"
 
 ABSL_FLAG(std::string, i, "", "Directory containing the speech turn wav files");
-ABSL_FLAG(std::string, t, "", "Path to the timing text file");
+ABSL_FLAG(std::string,
+          t,
+          "",
+          "Path to the timing text file, or comma-separated paths to the "
+          "timing files of several conversations");
 ABSL_FLAG(std::string, o, "", "Output wav files destination path");
+ABSL_FLAG(int,
+          num_threads,
+          0,
+          "Number of conversations to generate in parallel (0 uses one per "
+          "core)");
 
 namespace webrtc {
 namespace test {
@@ -37,7 +50,17 @@ const char kUsageDescription[] =
     "          -o <output/path>\n"
     "\n\n"
     "Command-line tool to generate multiple-end audio tracks to simulate "
-    "conversational speech with two or more participants.\n";
+    "conversational speech with two or more participants. When several "
+    "timing files are given, the tracks of each conversation are written in "
+    "the sub-directory of the output path named after its timing file.\n";
+
+// Returns the file name in |filepath| without the directories and extension.
+std::string FileNameWithoutExtension(const std::string& filepath) {
+  const size_t delimiter = filepath.find_last_of("/\\");
+  const std::string filename =
+      filepath.substr(delimiter == std::string::npos ? 0 : delimiter + 1);
+  return filename.substr(0, filename.find_last_of('.'));
+}
 
 }  // namespace
 
@@ -48,34 +71,67 @@ int main(int argc, char* argv[]) {
     return 1;
   }
   RTC_CHECK(DirExists(absl::GetFlag(FLAGS_i)));
-  RTC_CHECK(FileExists(absl::GetFlag(FLAGS_t)));
   RTC_CHECK(DirExists(absl::GetFlag(FLAGS_o)));
+  RTC_CHECK_GE(absl::GetFlag(FLAGS_num_threads), 0);
+  std::vector<std::string> timing_filepaths;
+  rtc::split(absl::GetFlag(FLAGS_t), ',', &timing_filepaths);
+  RTC_CHECK(!timing_filepaths.empty());
+
+  // One configuration per conversation. A conversation only gets its own
+  // output sub-directory when there are several.
+  std::vector<conversational_speech::Config> configs;
+  for (const std::string& timing_filepath : timing_filepaths) {
+    RTC_CHECK(FileExists(timing_filepath));
+    std::string output_path = absl::GetFlag(FLAGS_o);
+    if (timing_filepaths.size() > 1) {
+      output_path = JoinFilename(output_path,
+                                 FileNameWithoutExtension(timing_filepath));
+      RTC_CHECK(DirExists(output_path) || CreateDir(output_path));
+    }
+    configs.emplace_back(absl::GetFlag(FLAGS_i), timing_filepath, output_path);
+  }
 
-  conversational_speech::Config config(
-      absl::GetFlag(FLAGS_i), absl::GetFlag(FLAGS_t), absl::GetFlag(FLAGS_o));
-
-  // Load timing.
-  std::vector<conversational_speech::Turn> timing =
-      conversational_speech::LoadTiming(config.timing_filepath());
-
-  // Parse timing and audio tracks.
-  auto wavreader_factory =
-      std::make_unique<conversational_speech::WavReaderFactory>();
-  conversational_speech::MultiEndCall multiend_call(
-      timing, config.audiotracks_path(), std::move(wavreader_factory));
+  // Load timing and parse timing and audio tracks. The timings must outlive the
+  // calls, hence they are loaded first.
+  std::vector<std::vector<conversational_speech::Turn>> timings;
+  for (const auto& config : configs) {
+    timings.push_back(
+        conversational_speech::LoadTiming(config.timing_filepath()));
+  }
+  std::vector<std::unique_ptr<conversational_speech::MultiEndCall>>
+      multiend_calls;
+  std::vector<const conversational_speech::MultiEndCall*> calls;
+  std::vector<std::string> output_paths;
+  for (size_t k = 0; k < configs.size(); ++k) {
+    multiend_calls.push_back(
+        std::make_unique<conversational_speech::MultiEndCall>(
+            timings[k], configs[k].audiotracks_path(),
+            std::make_unique<conversational_speech::WavReaderFactory>()));
+    RTC_CHECK(multiend_calls.back()->valid())
+        << "Invalid timing file " << configs[k].timing_filepath();
+    calls.push_back(multiend_calls.back().get());
+    output_paths.push_back(configs[k].output_path());
+  }
 
   // Generate output audio tracks.
+  size_t num_threads = absl::GetFlag(FLAGS_num_threads);
+  if (num_threads == 0) {
+    num_threads =
+        static_cast<size_t>(std::max(CpuInfo::DetectNumberOfCores(), 1u));
+  }
   auto generated_audiotrack_pairs =
-      conversational_speech::Simulate(multiend_call, config.output_path());
+      conversational_speech::SimulateCalls(calls, output_paths, num_threads);
 
   // Show paths to created audio tracks.
   std::cout << "Output files:" << std::endl;
-  for (const auto& output_paths_entry : *generated_audiotrack_pairs) {
-    std::cout << "  speaker: " << output_paths_entry.first << std::endl;
-    std::cout << "    near end: " << output_paths_entry.second.near_end
-              << std::endl;
-    std::cout << "    far end: " << output_paths_entry.second.far_end
-              << std::endl;
+  for (const auto& audiotrack_pairs : generated_audiotrack_pairs) {
+    for (const auto& output_paths_entry : *audiotrack_pairs) {
+      std::cout << "  speaker: " << output_paths_entry.first << std::endl;
+      std::cout << "    near end: " << output_paths_entry.second.near_end
+                << std::endl;
+      std::cout << "    far end: " << output_paths_entry.second.far_end
+                << std::endl;
+    }
   }
 
   return 0;
@@ -46,6 +46,7 @@
 #include "absl/types/optional.h"
 #include "common_audio/wav_file.h"
 #include "modules/audio_processing/test/conversational_speech/config.h"
+#include "modules/audio_processing/test/conversational_speech/mock_wavreader.h"
 #include "modules/audio_processing/test/conversational_speech/mock_wavreader_factory.h"
 #include "modules/audio_processing/test/conversational_speech/multiend_call.h"
 #include "modules/audio_processing/test/conversational_speech/simulator.h"
@@ -60,7 +61,9 @@ namespace webrtc {
 namespace test {
 namespace {
 
+using conversational_speech::AudioTrackCache;
 using conversational_speech::LoadTiming;
+using conversational_speech::MockWavReader;
 using conversational_speech::MockWavReaderFactory;
 using conversational_speech::MultiEndCall;
 using conversational_speech::SaveTiming;
@@ -147,6 +150,14 @@ void CheckAudioTrackParams(const WavReaderFactory& wav_reader_factory,
   EXPECT_EQ(expeted_params.num_samples, wav_reader->NumSamples());
 }
 
+std::vector<int16_t> ReadWavFile(const std::string& filepath) {
+  WavReader wav_reader(filepath);
+  std::vector<int16_t> samples(wav_reader.num_samples());
+  EXPECT_EQ(samples.size(),
+            wav_reader.ReadSamples(samples.size(), samples.data()));
+  return samples;
+}
+
 void DeleteFolderAndContents(const std::string& dir) {
   if (!DirExists(dir)) {
     return;
@@ -670,5 +681,87 @@ TEST(ConversationalSpeechTest, DISABLED_MultiEndCallSimulator) {
   EXPECT_NO_FATAL_FAILURE(DeleteFolderAndContents(audiotracks_path));
 }
 
+TEST(ConversationalSpeechTest, AudioTrackCacheReadsEachTrackOnce) {
+  MockWavReader first_wavreader(kDefaultSampleRate, 1u, 100u);
+  MockWavReader second_wavreader(kDefaultSampleRate, 1u, 100u);
+  EXPECT_CALL(first_wavreader, ReadInt16Samples(_))
+      .WillOnce(::testing::Return(100u));
+  EXPECT_CALL(second_wavreader, ReadInt16Samples(_)).Times(0);
+
+  AudioTrackCache cache;
+  auto first = cache.Get("/path/to/a1", &first_wavreader);
+  auto second = cache.Get("/path/to/a1", &second_wavreader);
+  EXPECT_EQ(100u, first->size());
+  EXPECT_EQ(first, second);
+}
+
+// Verifies that the calls simulated in parallel are identical to those
+// simulated one at a time.
+TEST(ConversationalSpeechTest, MultiEndCallSimulateCallsInParallel) {
+  // Call 0:
+  // A 0*****.....2*****
+  // B .....1*****......
+  // Call 1:
+  // A 0*****...
+  // B ...1*****
+  const std::vector<std::vector<Turn>> timings = {
+      {{"A", "t500_440.wav", 0, 0},
+       {"B", "t500_880.wav", 0, -6},
+       {"A", "t500_440.wav", 0, 3}},
+      {{"A", "t500_880.wav", 0, 0}, {"B", "t500_440.wav", -200, 0}},
+  };
+
+  // Create temporary audio track files.
+  const int sample_rate = 16000;
+  const std::map<std::string, SineAudioTrackParams> sine_tracks_params = {
+      {"t500_440.wav", {{sample_rate, 1u, sample_rate / 2}, 440.0}},
+      {"t500_880.wav", {{sample_rate, 1u, sample_rate / 2}, 880.0}},
+  };
+  const std::string audiotracks_path =
+      CreateTemporarySineAudioTracks(sine_tracks_params);
+
+  std::vector<std::unique_ptr<MultiEndCall>> multiend_calls;
+  std::vector<const MultiEndCall*> calls;
+  std::vector<std::string> output_paths;
+  for (size_t k = 0; k < timings.size(); ++k) {
+    multiend_calls.push_back(std::make_unique<MultiEndCall>(
+        timings[k], audiotracks_path, std::make_unique<WavReaderFactory>()));
+    ASSERT_TRUE(multiend_calls.back()->valid());
+    calls.push_back(multiend_calls.back().get());
+    output_paths.push_back(
+        JoinFilename(audiotracks_path, "parallel" + std::to_string(k)));
+    CreateDir(output_paths.back());
+  }
+
+  // Simulate the calls in parallel.
+  auto parallel_audiotrack_pairs =
+      conversational_speech::SimulateCalls(calls, output_paths, 2);
+  ASSERT_EQ(timings.size(), parallel_audiotrack_pairs.size());
+
+  for (size_t k = 0; k < timings.size(); ++k) {
+    // Simulate the same call alone, with new readers.
+    MultiEndCall multiend_call(timings[k], audiotracks_path,
+                               std::make_unique<WavReaderFactory>());
+    const std::string output_path =
+        JoinFilename(audiotracks_path, "sequential" + std::to_string(k));
+    CreateDir(output_path);
+    auto audiotrack_pairs =
+        conversational_speech::Simulate(multiend_call, output_path);
+
+    ASSERT_TRUE(parallel_audiotrack_pairs[k]);
+    ASSERT_EQ(audiotrack_pairs->size(), parallel_audiotrack_pairs[k]->size());
+    for (const auto& it : *audiotrack_pairs) {
+      const auto& parallel_paths = parallel_audiotrack_pairs[k]->at(it.first);
+      EXPECT_EQ(ReadWavFile(it.second.near_end),
+                ReadWavFile(parallel_paths.near_end));
+      EXPECT_EQ(ReadWavFile(it.second.far_end),
+                ReadWavFile(parallel_paths.far_end));
+    }
+  }
+
+  // Clean.
+  EXPECT_NO_FATAL_FAILURE(DeleteFolderAndContents(audiotracks_path));
+}
+
 }  // namespace test
 }  // namespace webrtc
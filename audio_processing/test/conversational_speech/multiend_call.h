@@ -57,6 +57,7 @@ class MultiEndCall {
       std::unique_ptr<WavReaderAbstractFactory> wavreader_abstract_factory);
   ~MultiEndCall();
 
+  const std::string& audiotracks_path() const { return audiotracks_path_; }
   const std::set<std::string>& speaker_names() const { return speaker_names_; }
   const std::map<std::string, std::unique_ptr<WavReaderInterface>>&
   audiotrack_readers() const {
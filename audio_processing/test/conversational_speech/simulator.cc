@@ -13,6 +13,7 @@
 #include <math.h>
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <set>
 #include <utility>
@@ -22,9 +23,11 @@
 #include "common_audio/include/audio_util.h"
 #include "common_audio/wav_file.h"
 #include "modules/audio_processing/test/conversational_speech/wavreader_interface.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/platform_thread.h"
 #include "test/testsupport/file_utils.h"
 
 namespace webrtc {
@@ -102,60 +105,54 @@ InitSpeakersWavWriters(const std::map<std::string, SpeakerOutputFilePaths>&
   return speaker_wav_writers_map;
 }
 
-// Reads all the samples for each audio track.
-std::unique_ptr<std::map<std::string, std::vector<int16_t>>> PreloadAudioTracks(
-    const std::map<std::string, std::unique_ptr<WavReaderInterface>>&
-        audiotrack_readers) {
-  // Create map.
-  auto audiotracks_map =
-      std::make_unique<std::map<std::string, std::vector<int16_t>>>();
-
-  // Add audio track vectors.
-  for (auto it = audiotrack_readers.begin(); it != audiotrack_readers.end();
-       ++it) {
-    // Add map entry.
-    audiotracks_map->emplace(std::piecewise_construct,
-                             std::forward_as_tuple(it->first),
-                             std::forward_as_tuple(it->second->NumSamples()));
-
-    // Read samples.
-    it->second->ReadInt16Samples(audiotracks_map->at(it->first));
-  }
+// Number of samples written at once.
+constexpr size_t kChunkSize = 4096;
 
-  return audiotracks_map;
+// Reads all the samples of an audio track.
+std::shared_ptr<const std::vector<int16_t>> ReadAudioTrack(
+    WavReaderInterface* wavreader) {
+  auto samples =
+      std::make_shared<std::vector<int16_t>>(wavreader->NumSamples());
+  wavreader->ReadInt16Samples(*samples);
+  return samples;
 }
 
-// Writes all the values in |source_samples| via |wav_writer|. If the number of
-// previously written samples in |wav_writer| is less than |interval_begin|, it
-// adds zeros as left padding. The padding corresponds to intervals during which
-// a speaker is not active.
-void PadLeftWriteChunk(rtc::ArrayView<const int16_t> source_samples,
-                       size_t interval_begin,
-                       WavWriter* wav_writer) {
-  // Add left padding.
-  RTC_CHECK(wav_writer);
-  RTC_CHECK_GE(interval_begin, wav_writer->num_samples());
-  size_t padding_size = interval_begin - wav_writer->num_samples();
-  if (padding_size != 0) {
-    const std::vector<int16_t> padding(padding_size, 0);
-    wav_writer->WriteSamples(padding.data(), padding_size);
+// Reads all the samples for each audio track, or gets them from |cache| if not
+// null.
+std::map<std::string, std::shared_ptr<const std::vector<int16_t>>>
+LoadAudioTracks(const MultiEndCall& multiend_call,
+                conversational_speech::AudioTrackCache* cache) {
+  std::map<std::string, std::shared_ptr<const std::vector<int16_t>>>
+      audiotracks;
+  for (const auto& it : multiend_call.audiotrack_readers()) {
+    audiotracks.emplace(
+        it.first,
+        cache ? cache->Get(test::JoinFilename(multiend_call.audiotracks_path(),
+                                              it.first),
+                           it.second.get())
+              : ReadAudioTrack(it.second.get()));
   }
+  return audiotracks;
+}
 
-  // Write source samples.
-  wav_writer->WriteSamples(source_samples.data(), source_samples.size());
+// Appends |num_zeros| zeros via |wav_writer|, one chunk at a time.
+void WriteZeros(size_t num_zeros, WavWriter* wav_writer) {
+  static constexpr int16_t kZeros[kChunkSize] = {};
+  while (num_zeros > 0) {
+    const size_t chunk_size = std::min(num_zeros, kChunkSize);
+    wav_writer->WriteSamples(kZeros, chunk_size);
+    num_zeros -= chunk_size;
+  }
 }
 
 // Appends zeros via |wav_writer|. The number of zeros is always non-negative
 // and equal to the difference between the previously written samples and
-// |pad_samples|.
-void PadRightWrite(WavWriter* wav_writer, size_t pad_samples) {
+// |pad_samples|. The padding corresponds to intervals during which a speaker is
+// not active.
+void PadWrite(WavWriter* wav_writer, size_t pad_samples) {
   RTC_CHECK(wav_writer);
   RTC_CHECK_GE(pad_samples, wav_writer->num_samples());
-  size_t padding_size = pad_samples - wav_writer->num_samples();
-  if (padding_size != 0) {
-    const std::vector<int16_t> padding(padding_size, 0);
-    wav_writer->WriteSamples(padding.data(), padding_size);
-  }
+  WriteZeros(pad_samples - wav_writer->num_samples(), wav_writer);
 }
 
 void ScaleSignal(rtc::ArrayView<const int16_t> source_samples,
@@ -169,13 +166,112 @@ void ScaleSignal(rtc::ArrayView<const int16_t> source_samples,
                  });
 }
 
+// Writes the values in |source_samples| scaled by |gain| via each of
+// |wav_writers|. If the number of previously written samples in a writer is
+// less than |interval_begin|, it adds zeros as left padding. The samples are
+// scaled one chunk at a time, which is then written via all the writers.
+void PadLeftWriteScaledChunk(rtc::ArrayView<const int16_t> source_samples,
+                             int gain,
+                             size_t interval_begin,
+                             rtc::ArrayView<WavWriter* const> wav_writers) {
+  for (WavWriter* wav_writer : wav_writers) {
+    PadWrite(wav_writer, interval_begin);
+  }
+
+  std::array<int16_t, kChunkSize> scaled_samples;
+  for (size_t begin = 0; begin < source_samples.size(); begin += kChunkSize) {
+    const size_t chunk_size =
+        std::min(kChunkSize, source_samples.size() - begin);
+    rtc::ArrayView<int16_t> scaled_chunk(scaled_samples.data(), chunk_size);
+    ScaleSignal(source_samples.subview(begin, chunk_size), gain, scaled_chunk);
+    for (WavWriter* wav_writer : wav_writers) {
+      wav_writer->WriteSamples(scaled_chunk.data(), chunk_size);
+    }
+  }
+}
+
+// The calls not yet simulated by SimulateCalls(), shared by its threads.
+class CallQueue {
+ public:
+  CallQueue(rtc::ArrayView<const MultiEndCall* const> multiend_calls,
+            rtc::ArrayView<const std::string> output_paths,
+            std::vector<std::unique_ptr<
+                std::map<std::string, SpeakerOutputFilePaths>>>* results)
+      : multiend_calls_(multiend_calls),
+        output_paths_(output_paths),
+        results_(results) {
+    RTC_DCHECK_EQ(multiend_calls_.size(), output_paths_.size());
+    RTC_DCHECK_EQ(multiend_calls_.size(), results_->size());
+  }
+
+  // Simulates calls until there are none left.
+  static void Run(void* obj) {
+    CallQueue* queue = static_cast<CallQueue*>(obj);
+    size_t index;
+    while (queue->Next(&index)) {
+      (*queue->results_)[index] = conversational_speech::Simulate(
+          *queue->multiend_calls_[index], queue->output_paths_[index],
+          &queue->cache_);
+    }
+  }
+
+ private:
+  // Sets |index| to the index of the next call to simulate. Returns false when
+  // all the calls have been started.
+  bool Next(size_t* index) {
+    rtc::CritScope cs(&crit_);
+    if (next_ == multiend_calls_.size()) {
+      return false;
+    }
+    *index = next_++;
+    return true;
+  }
+
+  const rtc::ArrayView<const MultiEndCall* const> multiend_calls_;
+  const rtc::ArrayView<const std::string> output_paths_;
+  std::vector<std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>>>*
+      const results_;
+  conversational_speech::AudioTrackCache cache_;
+  rtc::CriticalSection crit_;
+  size_t next_ RTC_GUARDED_BY(crit_) = 0;
+};
+
 }  // namespace
 
 namespace conversational_speech {
 
+AudioTrackCache::AudioTrackCache() = default;
+
+AudioTrackCache::~AudioTrackCache() = default;
+
+std::shared_ptr<const std::vector<int16_t>> AudioTrackCache::Get(
+    const std::string& filepath,
+    WavReaderInterface* wavreader) {
+  {
+    rtc::CritScope cs(&crit_);
+    auto it = audiotracks_.find(filepath);
+    if (it != audiotracks_.end())
+      return it->second;
+  }
+
+  // Read without holding the lock, so that other threads are not blocked. If
+  // the same track was read meanwhile by another thread, the first one read is
+  // kept.
+  auto samples = ReadAudioTrack(wavreader);
+  rtc::CritScope cs(&crit_);
+  return audiotracks_.emplace(filepath, std::move(samples)).first->second;
+}
+
 std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>> Simulate(
     const MultiEndCall& multiend_call,
     const std::string& output_path) {
+  return Simulate(multiend_call, output_path, nullptr);
+}
+
+std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>> Simulate(
+    const MultiEndCall& multiend_call,
+    const std::string& output_path,
+    AudioTrackCache* cache) {
   // Set output file paths and initialize wav writers.
   const auto& speaker_names = multiend_call.speaker_names();
   auto speaker_output_file_paths =
@@ -183,9 +279,8 @@ std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>> Simulate(
   auto speakers_wav_writers = InitSpeakersWavWriters(
       *speaker_output_file_paths, multiend_call.sample_rate());
 
-  // Preload all the input audio tracks.
-  const auto& audiotrack_readers = multiend_call.audiotrack_readers();
-  auto audiotracks = PreloadAudioTracks(audiotrack_readers);
+  // Load all the input audio tracks.
+  const auto audiotracks = LoadAudioTracks(multiend_call, cache);
 
   // TODO(alessiob): When speaker_names.size() == 2, near-end and far-end
   // across the 2 speakers are symmetric; hence, the code below could be
@@ -195,41 +290,63 @@ std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>> Simulate(
   // be signinificant.
 
   // Write near-end and far-end output tracks.
+  std::vector<WavWriter*> wav_writers;
   for (const auto& speaking_turn : multiend_call.speaking_turns()) {
     const std::string& active_speaker_name = speaking_turn.speaker_name;
-    const auto source_audiotrack =
-        audiotracks->at(speaking_turn.audiotrack_file_name);
-    std::vector<int16_t> scaled_audiotrack(source_audiotrack.size());
-    ScaleSignal(source_audiotrack, speaking_turn.gain, scaled_audiotrack);
-
-    // Write active speaker's chunk to active speaker's near-end.
-    PadLeftWriteChunk(
-        scaled_audiotrack, speaking_turn.begin,
-        speakers_wav_writers->at(active_speaker_name).near_end_wav_writer());
 
-    // Write active speaker's chunk to other participants' far-ends.
+    // Active speaker's chunk goes to active speaker's near-end and to other
+    // participants' far-ends.
+    wav_writers.clear();
+    wav_writers.push_back(
+        speakers_wav_writers->at(active_speaker_name).near_end_wav_writer());
     for (const std::string& speaker_name : speaker_names) {
       if (speaker_name == active_speaker_name)
         continue;
-      PadLeftWriteChunk(
-          scaled_audiotrack, speaking_turn.begin,
+      wav_writers.push_back(
           speakers_wav_writers->at(speaker_name).far_end_wav_writer());
     }
+
+    PadLeftWriteScaledChunk(
+        *audiotracks.at(speaking_turn.audiotrack_file_name), speaking_turn.gain,
+        speaking_turn.begin, wav_writers);
   }
 
   // Finalize all the output tracks with right padding.
   // This is required to make all the output tracks duration equal.
   size_t duration_samples = multiend_call.total_duration_samples();
   for (const std::string& speaker_name : speaker_names) {
-    PadRightWrite(speakers_wav_writers->at(speaker_name).near_end_wav_writer(),
-                  duration_samples);
-    PadRightWrite(speakers_wav_writers->at(speaker_name).far_end_wav_writer(),
-                  duration_samples);
+    PadWrite(speakers_wav_writers->at(speaker_name).near_end_wav_writer(),
+             duration_samples);
+    PadWrite(speakers_wav_writers->at(speaker_name).far_end_wav_writer(),
+             duration_samples);
   }
 
   return speaker_output_file_paths;
 }
 
+std::vector<std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>>>
+SimulateCalls(rtc::ArrayView<const MultiEndCall* const> multiend_calls,
+              rtc::ArrayView<const std::string> output_paths,
+              size_t num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  std::vector<std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>>>
+      results(multiend_calls.size());
+  CallQueue queue(multiend_calls, output_paths, &results);
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t k = 0; k < std::min(num_threads, multiend_calls.size()); ++k) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &CallQueue::Run, &queue, "conversational_speech_simulator"));
+  }
+  for (auto& thread : threads) {
+    thread->Start();
+  }
+  for (auto& thread : threads) {
+    thread->Stop();
+  }
+  return results;
+}
+
 }  // namespace conversational_speech
 }  // namespace test
 }  // namespace webrtc
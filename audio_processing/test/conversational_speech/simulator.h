@@ -11,13 +11,21 @@
 #ifndef MODULES_AUDIO_PROCESSING_TEST_CONVERSATIONAL_SPEECH_SIMULATOR_H_
 #define MODULES_AUDIO_PROCESSING_TEST_CONVERSATIONAL_SPEECH_SIMULATOR_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "api/array_view.h"
 #include "modules/audio_processing/test/conversational_speech/multiend_call.h"
+#include "modules/audio_processing/test/conversational_speech/wavreader_interface.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace test {
@@ -32,11 +40,49 @@ struct SpeakerOutputFilePaths {
   const std::string far_end;
 };
 
-// Generates the near-end and far-end audio track pairs for each speaker.
+// Decoded audio tracks, which can be shared by the simulations of several
+// calls so that each audio track file is only read once. Thread-safe.
+class AudioTrackCache {
+ public:
+  AudioTrackCache();
+  ~AudioTrackCache();
+
+  // Returns the samples of the audio track file at |filepath|. If the track is
+  // not in the cache yet, its samples are read via |wavreader|.
+  std::shared_ptr<const std::vector<int16_t>> Get(
+      const std::string& filepath,
+      WavReaderInterface* wavreader);
+
+ private:
+  rtc::CriticalSection crit_;
+  std::map<std::string, std::shared_ptr<const std::vector<int16_t>>>
+      audiotracks_ RTC_GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AudioTrackCache);
+};
+
+// Generates the near-end and far-end audio track pairs for each speaker. The
+// output tracks are written chunk by chunk, hence the memory used does not
+// depend on the duration of the call.
 std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>> Simulate(
     const MultiEndCall& multiend_call,
     const std::string& output_path);
 
+// Like Simulate() above, but the audio tracks are read via |cache|.
+std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>> Simulate(
+    const MultiEndCall& multiend_call,
+    const std::string& output_path,
+    AudioTrackCache* cache);
+
+// Generates the audio track pairs of independent calls in parallel, on at most
+// |num_threads| threads. The tracks of the call |multiend_calls[k]| are written
+// in |output_paths[k]|, and the audio tracks used by several calls are read
+// once. Returns the output file paths of each call, in the order of the calls.
+std::vector<std::unique_ptr<std::map<std::string, SpeakerOutputFilePaths>>>
+SimulateCalls(rtc::ArrayView<const MultiEndCall* const> multiend_calls,
+              rtc::ArrayView<const std::string> output_paths,
+              size_t num_threads);
+
 }  // namespace conversational_speech
 }  // namespace test
 }  // namespace webrtc
@@ -18,11 +18,12 @@ void ReplayRuntimeSetting(AudioProcessing* apm,
                           const webrtc::audioproc::RuntimeSetting& setting) {
   RTC_CHECK(apm);
   // TODO(bugs.webrtc.org/9138): Add ability to handle different types
-  // of settings. Currently CapturePreGain, CaptureFixedPostGain and
-  // PlayoutVolumeChange are supported.
+  // of settings. Currently CapturePreGain, CaptureFixedPostGain,
+  // PlayoutVolumeChange and CapturePerformanceTier are supported.
   RTC_CHECK(setting.has_capture_pre_gain() ||
             setting.has_capture_fixed_post_gain() ||
-            setting.has_playout_volume_change());
+            setting.has_playout_volume_change() ||
+            setting.has_capture_performance_tier());
 
   if (setting.has_capture_pre_gain()) {
     apm->SetRuntimeSetting(
@@ -36,6 +37,11 @@ void ReplayRuntimeSetting(AudioProcessing* apm,
     apm->SetRuntimeSetting(
         AudioProcessing::RuntimeSetting::CreatePlayoutVolumeChange(
             setting.playout_volume_change()));
+  } else if (setting.has_capture_performance_tier()) {
+    apm->SetRuntimeSetting(
+        AudioProcessing::RuntimeSetting::CreateCapturePerformanceTier(
+            static_cast<AudioProcessing::Config::PerformanceTier::Tier>(
+                setting.capture_performance_tier())));
   }
 }
 }  // namespace webrtc
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/test/simulation_batch.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "modules/audio_processing/test/aec_dump_based_simulator.h"
+#include "modules/audio_processing/test/wav_based_simulator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// The simulations not yet started, shared by the worker threads.
+class SimulationQueue {
+ public:
+  SimulationQueue(const std::vector<SimulationSettings>& settings,
+                  std::vector<SimulationResult>* results)
+      : settings_(settings), results_(results) {
+    RTC_DCHECK_EQ(settings_.size(), results_->size());
+  }
+
+  // Runs simulations until there are none left.
+  static void Run(void* obj) {
+    SimulationQueue* queue = static_cast<SimulationQueue*>(obj);
+    size_t index;
+    std::unique_ptr<AudioProcessingSimulator> simulator;
+    while ((simulator = queue->Next(&index))) {
+      simulator->Process();
+      SimulationResult& result = (*queue->results_)[index];
+      result.audio_duration_nanos = simulator->get_num_process_stream_calls() *
+                                    AudioProcessing::kChunkSizeMs *
+                                    rtc::kNumNanosecsPerMillisec;
+      result.api_call_statistics = simulator->GetApiCallStatistics();
+      result.bitexact_output = simulator->OutputWasBitexact();
+    }
+  }
+
+ private:
+  // Returns the simulator of the next simulation and its index, or nullptr when
+  // all simulations have been started.
+  std::unique_ptr<AudioProcessingSimulator> Next(size_t* index) {
+    rtc::CritScope cs(&crit_);
+    if (next_ == settings_.size()) {
+      return nullptr;
+    }
+    *index = next_++;
+    // The simulators are created under the lock since their constructors set
+    // the global data dumper state.
+    const SimulationSettings& settings = settings_[*index];
+    if (settings.aec_dump_input_filename) {
+      return std::make_unique<AecDumpBasedSimulator>(settings, nullptr);
+    }
+    return std::make_unique<WavBasedSimulator>(settings, nullptr);
+  }
+
+  const std::vector<SimulationSettings>& settings_;
+  std::vector<SimulationResult>* const results_;
+  rtc::CriticalSection crit_;
+  size_t next_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace
+
+double SimulationResult::RealTimeFactor() const {
+  if (audio_duration_nanos == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(api_call_statistics.GetTotalDurationNanos()) /
+         audio_duration_nanos;
+}
+
+std::vector<SimulationResult> RunSimulationBatch(
+    const std::vector<SimulationSettings>& settings,
+    size_t num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  std::vector<SimulationResult> results(settings.size());
+  SimulationQueue queue(settings, &results);
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t k = 0; k < std::min(num_threads, settings.size()); ++k) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &SimulationQueue::Run, &queue, "simulation_worker"));
+  }
+  for (auto& thread : threads) {
+    thread->Start();
+  }
+  for (auto& thread : threads) {
+    thread->Stop();
+  }
+  return results;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_TEST_SIMULATION_BATCH_H_
+#define MODULES_AUDIO_PROCESSING_TEST_SIMULATION_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "modules/audio_processing/test/api_call_statistics.h"
+#include "modules/audio_processing/test/audio_processing_simulator.h"
+
+namespace webrtc {
+namespace test {
+
+// The outcome of one of the simulations of a batch.
+struct SimulationResult {
+  // Duration of the processed capture audio.
+  int64_t audio_duration_nanos = 0;
+  ApiCallStatistics api_call_statistics;
+  bool bitexact_output = true;
+
+  // Returns the ratio between the time spent in the AudioProcessing calls and
+  // the duration of the processed audio.
+  double RealTimeFactor() const;
+};
+
+// Runs the simulations specified by |settings| in parallel on |num_threads|
+// threads, each simulation with an AudioProcessing instance of its own that is
+// created by a default AudioProcessingBuilder. The simulations must write to
+// distinct output files and must not dump internal data, since the data dumper
+// state is shared. Returns the results in the order of |settings|.
+std::vector<SimulationResult> RunSimulationBatch(
+    const std::vector<SimulationSettings>& settings,
+    size_t num_threads);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_TEST_SIMULATION_BATCH_H_
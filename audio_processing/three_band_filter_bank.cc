@@ -35,9 +35,19 @@
 
 #include "modules/audio_processing/three_band_filter_bank.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 namespace {
@@ -55,6 +65,11 @@ const size_t kSparsity = 4;
 //   3. The computation complexity also increases linearly with |kNumCoeffs|.
 const size_t kNumCoeffs = 4;
 
+// The longest delay of the polyphase filters is the one of the last
+// coefficient of the filter with the largest offset.
+static_assert(kSparsity * (kNumCoeffs - 1) + kSparsity - 1 == 15,
+              "ThreeBandFilterBank::kMemorySize must be updated");
+
 // The Matlab code to generate these |kLowpassCoeffs| is:
 //
 // N = kNumBands * kSparsity * kNumCoeffs - 1;
@@ -82,6 +97,37 @@ const float kLowpassCoeffs[kNumBands * kSparsity][kNumCoeffs] = {
     {+0.00994113f, +0.14989004f, -0.01585778f, -0.00173287f},
     {+0.00425496f, +0.16547118f, -0.00496888f, -0.00047749f}};
 
+// Computes |out| += |scale| * |in|, where |in| and |out| have |length|
+// elements.
+void AccumulateScaled(const float* in,
+                      float scale,
+                      size_t length,
+                      bool use_sse2,
+                      float* out) {
+  size_t k = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2) {
+    const __m128 scale_128 = _mm_set1_ps(scale);
+    for (; k + 4 <= length; k += 4) {
+      const __m128 in_128 = _mm_loadu_ps(&in[k]);
+      const __m128 out_128 = _mm_loadu_ps(&out[k]);
+      _mm_storeu_ps(&out[k],
+                    _mm_add_ps(out_128, _mm_mul_ps(scale_128, in_128)));
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  const float32x4_t scale_128 = vdupq_n_f32(scale);
+  for (; k + 4 <= length; k += 4) {
+    const float32x4_t in_128 = vld1q_f32(&in[k]);
+    const float32x4_t out_128 = vld1q_f32(&out[k]);
+    vst1q_f32(&out[k], vaddq_f32(out_128, vmulq_f32(scale_128, in_128)));
+  }
+#endif
+  for (; k < length; ++k) {
+    out[k] += scale * in[k];
+  }
+}
+
 // Downsamples |in| into |out|, taking one every |kNumbands| starting from
 // |offset|. |split_length| is the |out| length. |in| has to be at least
 // |kNumBands| * |split_length| long.
@@ -105,21 +151,26 @@ void Upsample(const float* in, size_t split_length, size_t offset, float* out) {
 
 }  // namespace
 
+constexpr size_t ThreeBandFilterBank::kMemorySize;
+
 // Because the low-pass filter prototype has half bandwidth it is possible to
 // use a DCT to shift it in both directions at the same time, to the center
 // frequencies [1 / 12, 3 / 12, 5 / 12].
 ThreeBandFilterBank::ThreeBandFilterBank(size_t length)
-    : in_buffer_(rtc::CheckedDivExact(length, kNumBands)),
-      out_buffer_(in_buffer_.size()) {
-  for (size_t i = 0; i < kSparsity; ++i) {
-    for (size_t j = 0; j < kNumBands; ++j) {
-      analysis_filters_.push_back(
-          std::unique_ptr<SparseFIRFilter>(new SparseFIRFilter(
-              kLowpassCoeffs[i * kNumBands + j], kNumCoeffs, kSparsity, i)));
-      synthesis_filters_.push_back(
-          std::unique_ptr<SparseFIRFilter>(new SparseFIRFilter(
-              kLowpassCoeffs[i * kNumBands + j], kNumCoeffs, kSparsity, i)));
-    }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    : use_sse2_(WebRtc_GetCPUInfo(kSSE2) != 0),
+#else
+    : use_sse2_(false),
+#endif
+      in_buffer_(kMemorySize + rtc::CheckedDivExact(length, kNumBands), 0.f),
+      out_buffer_(in_buffer_.size() - kMemorySize),
+      analysis_states_(kNumBands),
+      synthesis_states_(kNumBands * kSparsity) {
+  for (auto& state : analysis_states_) {
+    state.fill(0.f);
+  }
+  for (auto& state : synthesis_states_) {
+    state.fill(0.f);
   }
   dct_modulation_.resize(kNumBands * kSparsity);
   for (size_t i = 0; i < dct_modulation_.size(); ++i) {
@@ -142,18 +193,23 @@ ThreeBandFilterBank::~ThreeBandFilterBank() = default;
 void ThreeBandFilterBank::Analysis(const float* in,
                                    size_t length,
                                    float* const* out) {
-  RTC_CHECK_EQ(in_buffer_.size(), rtc::CheckedDivExact(length, kNumBands));
+  const size_t split_length = out_buffer_.size();
+  RTC_CHECK_EQ(split_length, rtc::CheckedDivExact(length, kNumBands));
   for (size_t i = 0; i < kNumBands; ++i) {
-    memset(out[i], 0, in_buffer_.size() * sizeof(*out[i]));
+    memset(out[i], 0, split_length * sizeof(*out[i]));
   }
   for (size_t i = 0; i < kNumBands; ++i) {
-    Downsample(in, in_buffer_.size(), kNumBands - i - 1, &in_buffer_[0]);
+    // All the filters of a branch process the same downsampled signal, which
+    // only needs to be stored once after the past samples of the branch.
+    FilterState& state = analysis_states_[i];
+    std::copy(state.begin(), state.end(), in_buffer_.begin());
+    Downsample(in, split_length, kNumBands - i - 1, &in_buffer_[kMemorySize]);
     for (size_t j = 0; j < kSparsity; ++j) {
       const size_t offset = i + j * kNumBands;
-      analysis_filters_[offset]->Filter(&in_buffer_[0], in_buffer_.size(),
-                                        &out_buffer_[0]);
-      DownModulate(&out_buffer_[0], out_buffer_.size(), offset, out);
+      FilterPolyphase(offset, split_length, nullptr, &out_buffer_[0]);
+      DownModulate(&out_buffer_[0], split_length, offset, out);
     }
+    std::copy(in_buffer_.end() - kMemorySize, in_buffer_.end(), state.begin());
   }
 }
 
@@ -166,19 +222,44 @@ void ThreeBandFilterBank::Analysis(const float* in,
 void ThreeBandFilterBank::Synthesis(const float* const* in,
                                     size_t split_length,
                                     float* out) {
-  RTC_CHECK_EQ(in_buffer_.size(), split_length);
-  memset(out, 0, kNumBands * in_buffer_.size() * sizeof(*out));
+  RTC_CHECK_EQ(out_buffer_.size(), split_length);
+  memset(out, 0, kNumBands * split_length * sizeof(*out));
   for (size_t i = 0; i < kNumBands; ++i) {
     for (size_t j = 0; j < kSparsity; ++j) {
       const size_t offset = i + j * kNumBands;
-      UpModulate(in, in_buffer_.size(), offset, &in_buffer_[0]);
-      synthesis_filters_[offset]->Filter(&in_buffer_[0], in_buffer_.size(),
-                                         &out_buffer_[0]);
-      Upsample(&out_buffer_[0], out_buffer_.size(), i, out);
+      UpModulate(in, split_length, offset, &in_buffer_[kMemorySize]);
+      FilterPolyphase(offset, split_length, &synthesis_states_[offset],
+                      &out_buffer_[0]);
+      Upsample(&out_buffer_[0], split_length, i, out);
     }
   }
 }
 
+// Filters the samples in |in_buffer_| with the polyphase component |offset| of
+// the low-pass prototype, upsampled by a factor of |kSparsity| and delayed by
+// |offset| / |kNumBands| samples, and writes the |split_length| output samples
+// in |out|. If |state| is not null, the past samples in |in_buffer_| are first
+// loaded from |state| and |state| is then updated with the newest samples.
+void ThreeBandFilterBank::FilterPolyphase(size_t offset,
+                                          size_t split_length,
+                                          FilterState* state,
+                                          float* out) {
+  if (state) {
+    std::copy(state->begin(), state->end(), in_buffer_.begin());
+  }
+  const size_t delay = offset / kNumBands;
+  const float* coeffs = kLowpassCoeffs[offset];
+  memset(out, 0, split_length * sizeof(*out));
+  for (size_t k = 0; k < kNumCoeffs; ++k) {
+    const float* in = &in_buffer_[kMemorySize - delay - k * kSparsity];
+    AccumulateScaled(in, coeffs[k], split_length, use_sse2_, out);
+  }
+  if (state) {
+    std::copy(in_buffer_.end() - kMemorySize, in_buffer_.end(),
+              state->begin());
+  }
+}
+
 // Modulates |in| by |dct_modulation_| and accumulates it in each of the
 // |kNumBands| bands of |out|. |offset| is the index in the period of the
 // cosines used for modulation. |split_length| is the length of |in| and each
@@ -188,9 +269,8 @@ void ThreeBandFilterBank::DownModulate(const float* in,
                                        size_t offset,
                                        float* const* out) {
   for (size_t i = 0; i < kNumBands; ++i) {
-    for (size_t j = 0; j < split_length; ++j) {
-      out[i][j] += dct_modulation_[offset][i] * in[j];
-    }
+    AccumulateScaled(in, dct_modulation_[offset][i], split_length, use_sse2_,
+                     out[i]);
   }
 }
 
@@ -204,9 +284,8 @@ void ThreeBandFilterBank::UpModulate(const float* const* in,
                                      float* out) {
   memset(out, 0, split_length * sizeof(*out));
   for (size_t i = 0; i < kNumBands; ++i) {
-    for (size_t j = 0; j < split_length; ++j) {
-      out[j] += dct_modulation_[offset][i] * in[i][j];
-    }
+    AccumulateScaled(in[i], dct_modulation_[offset][i], split_length,
+                     use_sse2_, out);
   }
 }
 
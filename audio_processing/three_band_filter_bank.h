@@ -11,12 +11,10 @@
 #ifndef MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_H_
 #define MODULES_AUDIO_PROCESSING_THREE_BAND_FILTER_BANK_H_
 
+#include <array>
 #include <cstring>
-#include <memory>
 #include <vector>
 
-#include "common_audio/sparse_fir_filter.h"
-
 namespace webrtc {
 
 // An implementation of a 3-band FIR filter-bank with DCT modulation, similar to
@@ -32,6 +30,11 @@ namespace webrtc {
 // This filter bank does not satisfy perfect reconstruction. The SNR after
 // analysis and synthesis (with no processing in between) is approximately 9.5dB
 // depending on the input signal after compensating for the delay.
+//
+// The polyphase filtering and the modulation are vectorized with SSE2 or NEON
+// when available. Each output sample is computed with the same sequence of
+// operations as in the scalar code, so the output does not depend on the
+// selected implementation.
 class ThreeBandFilterBank final {
  public:
   explicit ThreeBandFilterBank(size_t length);
@@ -48,6 +51,10 @@ class ThreeBandFilterBank final {
   void Synthesis(const float* const* in, size_t split_length, float* out);
 
  private:
+  // Number of past samples needed by the sparse polyphase filters.
+  static constexpr size_t kMemorySize = 15;
+  using FilterState = std::array<float, kMemorySize>;
+
   void DownModulate(const float* in,
                     size_t split_length,
                     size_t offset,
@@ -56,11 +63,19 @@ class ThreeBandFilterBank final {
                   size_t split_length,
                   size_t offset,
                   float* out);
+  void FilterPolyphase(size_t offset,
+                       size_t split_length,
+                       FilterState* state,
+                       float* out);
 
+  const bool use_sse2_;
+  // Holds |kMemorySize| past samples followed by the samples to filter.
   std::vector<float> in_buffer_;
   std::vector<float> out_buffer_;
-  std::vector<std::unique_ptr<SparseFIRFilter>> analysis_filters_;
-  std::vector<std::unique_ptr<SparseFIRFilter>> synthesis_filters_;
+  // Past downsampled inputs of the |kNumBands| analysis branches.
+  std::vector<FilterState> analysis_states_;
+  // Past modulated inputs of each of the synthesis filters.
+  std::vector<FilterState> synthesis_states_;
   std::vector<std::vector<float>> dct_modulation_;
 };
 
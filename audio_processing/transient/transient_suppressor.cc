@@ -19,7 +19,6 @@
 
 #include "common_audio/include/audio_util.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
-#include "common_audio/third_party/fft4g/fft4g.h"
 #include "modules/audio_processing/ns/windows_private.h"
 #include "modules/audio_processing/transient/common.h"
 #include "modules/audio_processing/transient/transient_detector.h"
@@ -117,12 +116,10 @@ int TransientSuppressor::Initialize(int sample_rate_hz,
   out_buffer_.reset(new float[analysis_length_ * num_channels_]);
   memset(out_buffer_.get(), 0,
          analysis_length_ * num_channels_ * sizeof(out_buffer_[0]));
-  // ip[0] must be zero to trigger initialization using rdft().
-  size_t ip_length = 2 + sqrtf(analysis_length_);
-  ip_.reset(new size_t[ip_length]());
-  memset(ip_.get(), 0, ip_length * sizeof(ip_[0]));
-  wfft_.reset(new float[complex_analysis_length_ - 1]);
-  memset(wfft_.get(), 0, (complex_analysis_length_ - 1) * sizeof(wfft_[0]));
+  RTC_DCHECK(Pffft::IsValidFftSize(analysis_length_, Pffft::FftType::kReal));
+  fft_.reset(new Pffft(analysis_length_, Pffft::FftType::kReal));
+  fft_time_data_ = fft_->CreateBuffer();
+  fft_frequency_data_ = fft_->CreateBuffer();
   spectral_mean_.reset(new float[complex_analysis_length_ * num_channels_]);
   memset(spectral_mean_.get(), 0,
          complex_analysis_length_ * num_channels_ * sizeof(spectral_mean_[0]));
@@ -226,18 +223,27 @@ void TransientSuppressor::Suppress(float* in_ptr,
                                    float* spectral_mean,
                                    float* out_ptr) {
   // Go to frequency domain.
+  rtc::ArrayView<float> time_data = fft_time_data_->GetView();
   for (size_t i = 0; i < analysis_length_; ++i) {
     // TODO(aluebs): Rename windows
-    fft_buffer_[i] = in_ptr[i] * window_[i];
+    time_data[i] = in_ptr[i] * window_[i];
   }
 
-  WebRtc_rdft(analysis_length_, 1, fft_buffer_.get(), ip_.get(), wfft_.get());
+  fft_->ForwardTransform(*fft_time_data_, fft_frequency_data_.get(),
+                         /*ordered=*/true);
 
-  // Since WebRtc_rdft puts R[n/2] in fft_buffer_[1], we move it to the end
-  // for convenience.
-  fft_buffer_[analysis_length_] = fft_buffer_[1];
-  fft_buffer_[analysis_length_ + 1] = 0.f;
+  // The ordered output puts R[n/2] in the second element, which we move to the
+  // end for convenience. The imaginary parts are negated to keep the sign
+  // convention of the Ooura FFT used by the restoration.
+  rtc::ArrayView<float> frequency_data = fft_frequency_data_->GetView();
+  fft_buffer_[0] = frequency_data[0];
   fft_buffer_[1] = 0.f;
+  for (size_t i = 2; i < analysis_length_; i += 2) {
+    fft_buffer_[i] = frequency_data[i];
+    fft_buffer_[i + 1] = -frequency_data[i + 1];
+  }
+  fft_buffer_[analysis_length_] = frequency_data[1];
+  fft_buffer_[analysis_length_ + 1] = 0.f;
 
   for (size_t i = 0; i < complex_analysis_length_; ++i) {
     magnitudes_[i] =
@@ -259,14 +265,20 @@ void TransientSuppressor::Suppress(float* in_ptr,
   }
 
   // Back to time domain.
-  // Put R[n/2] back in fft_buffer_[1].
-  fft_buffer_[1] = fft_buffer_[analysis_length_];
+  // Put R[n/2] back in the second element.
+  frequency_data[0] = fft_buffer_[0];
+  frequency_data[1] = fft_buffer_[analysis_length_];
+  for (size_t i = 2; i < analysis_length_; i += 2) {
+    frequency_data[i] = fft_buffer_[i];
+    frequency_data[i + 1] = -fft_buffer_[i + 1];
+  }
 
-  WebRtc_rdft(analysis_length_, -1, fft_buffer_.get(), ip_.get(), wfft_.get());
-  const float fft_scaling = 2.f / analysis_length_;
+  fft_->BackwardTransform(*fft_frequency_data_, fft_time_data_.get(),
+                          /*ordered=*/true);
+  const float fft_scaling = 1.f / analysis_length_;
 
   for (size_t i = 0; i < analysis_length_; ++i) {
-    out_ptr[i] += fft_buffer_[i] * window_[i] * fft_scaling;
+    out_ptr[i] += time_data[i] * window_[i] * fft_scaling;
   }
 }
 
@@ -16,6 +16,7 @@
 
 #include <memory>
 
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/gtest_prod_util.h"
 
 namespace webrtc {
@@ -85,9 +86,10 @@ class TransientSuppressor {
   // Output buffer where the restored samples are stored.
   std::unique_ptr<float[]> out_buffer_;
 
-  // Arrays for fft.
-  std::unique_ptr<size_t[]> ip_;
-  std::unique_ptr<float[]> wfft_;
+  // FFT and its input and output buffers.
+  std::unique_ptr<Pffft> fft_;
+  std::unique_ptr<Pffft::FloatBuffer> fft_time_data_;
+  std::unique_ptr<Pffft::FloatBuffer> fft_frequency_data_;
 
   std::unique_ptr<float[]> spectral_mean_;
 
@@ -13,26 +13,36 @@
 #include <math.h>
 #include <string.h>
 
-#include "common_audio/fir_filter.h"
-#include "common_audio/fir_filter_factory.h"
-#include "modules/audio_processing/transient/dyadic_decimator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
 WPDNode::WPDNode(size_t length,
                  const float* coefficients,
                  size_t coefficients_length)
-    :  // The data buffer has parent data length to be able to contain and
-       // filter it.
-      data_(new float[2 * length + 1]),
+    : data_(new float[length]),
       length_(length),
-      filter_(
-          CreateFirFilter(coefficients, coefficients_length, 2 * length + 1)) {
+      coefficients_(new float[coefficients_length]),
+      coefficients_length_(coefficients_length),
+      // The history has room for the state and the longest parent data.
+      history_(new float[coefficients_length - 1 + 2 * length + 1]) {
   RTC_DCHECK_GT(length, 0);
   RTC_DCHECK(coefficients);
   RTC_DCHECK_GT(coefficients_length, 0);
-  memset(data_.get(), 0.f, (2 * length + 1) * sizeof(data_[0]));
+  for (size_t i = 0; i < coefficients_length_; ++i) {
+    coefficients_[i] = coefficients[coefficients_length_ - i - 1];
+  }
+  memset(data_.get(), 0, length_ * sizeof(data_[0]));
+  memset(history_.get(), 0,
+         (coefficients_length_ - 1 + 2 * length_ + 1) * sizeof(history_[0]));
 }
 
 WPDNode::~WPDNode() {}
@@ -42,22 +52,54 @@ int WPDNode::Update(const float* parent_data, size_t parent_data_length) {
     return -1;
   }
 
-  // Filter data.
-  filter_->Filter(parent_data, parent_data_length, data_.get());
+  const size_t state_length = coefficients_length_ - 1;
+  memcpy(&history_[state_length], parent_data,
+         parent_data_length * sizeof(history_[0]));
 
-  // Decimate data.
-  const bool kOddSequence = true;
-  size_t output_samples = DyadicDecimate(data_.get(), parent_data_length,
-                                         kOddSequence, data_.get(), length_);
-  if (output_samples != length_) {
-    return -1;
+  // Filter the parent data, computing only the odd samples that are kept by
+  // the decimation. Filtered sample n is the sum of history_[n + j] *
+  // coefficients_[j], accumulated with increasing j. Several output samples
+  // are computed at once, one per lane, in the same order.
+  const float* history = history_.get();
+  const float* coefficients = coefficients_.get();
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  for (; i + 4 <= length_; i += 4) {
+    __m128 sum = _mm_setzero_ps();
+    for (size_t j = 0; j < coefficients_length_; ++j) {
+      const float* samples = &history[2 * i + 1 + j];
+      // Every other sample of eight consecutive samples.
+      const __m128 odd = _mm_shuffle_ps(_mm_loadu_ps(samples),
+                                        _mm_loadu_ps(samples + 4),
+                                        _MM_SHUFFLE(2, 0, 2, 0));
+      sum = _mm_add_ps(sum, _mm_mul_ps(odd, _mm_set1_ps(coefficients[j])));
+    }
+    // Get abs to the values by clearing the sign bits.
+    _mm_storeu_ps(&data_[i], _mm_andnot_ps(_mm_set1_ps(-0.f), sum));
   }
-
-  // Get abs to all values.
-  for (size_t i = 0; i < length_; ++i) {
-    data_[i] = fabs(data_[i]);
+#elif defined(WEBRTC_HAS_NEON)
+  for (; i + 4 <= length_; i += 4) {
+    float32x4_t sum = vdupq_n_f32(0.f);
+    for (size_t j = 0; j < coefficients_length_; ++j) {
+      // Every other sample of eight consecutive samples.
+      const float32x4_t odd = vld2q_f32(&history[2 * i + 1 + j]).val[0];
+      sum = vaddq_f32(sum, vmulq_f32(odd, vdupq_n_f32(coefficients[j])));
+    }
+    vst1q_f32(&data_[i], vabsq_f32(sum));
+  }
+#endif
+  for (; i < length_; ++i) {
+    float sum = 0.f;
+    for (size_t j = 0; j < coefficients_length_; ++j) {
+      sum += history[2 * i + 1 + j] * coefficients[j];
+    }
+    data_[i] = fabs(sum);
   }
 
+  // Keep the last samples as the state of the next update.
+  memmove(history_.get(), &history_[parent_data_length],
+          state_length * sizeof(history_[0]));
+
   return 0;
 }
 
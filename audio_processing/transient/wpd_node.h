@@ -11,13 +11,17 @@
 #ifndef MODULES_AUDIO_PROCESSING_TRANSIENT_WPD_NODE_H_
 #define MODULES_AUDIO_PROCESSING_TRANSIENT_WPD_NODE_H_
 
+#include <stddef.h>
+
 #include <memory>
 
 namespace webrtc {
 
-class FIRFilter;
-
 // A single node of a Wavelet Packet Decomposition (WPD) tree.
+//
+// The node data is the absolute value of the odd samples of the parent data
+// filtered with the node coefficients. Only those samples are computed, which
+// fuses the filtering and the dyadic decimation.
 class WPDNode {
  public:
   // Creates a WPDNode. The data vector will contain zeros. The filter will have
@@ -37,7 +41,12 @@ class WPDNode {
  private:
   std::unique_ptr<float[]> data_;
   size_t length_;
-  std::unique_ptr<FIRFilter> filter_;
+  // Reversed coefficients, such that the oldest sample is multiplied first.
+  std::unique_ptr<float[]> coefficients_;
+  size_t coefficients_length_;
+  // The filter state of |coefficients_length_| - 1 samples followed by the
+  // parent data of the current update.
+  std::unique_ptr<float[]> history_;
 };
 
 }  // namespace webrtc
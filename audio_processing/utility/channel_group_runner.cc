@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/channel_group_runner.h"
+
+#include <algorithm>
+
+#include "modules/utility/include/task_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+void ChannelGroupRunner::GroupTask::operator()() const {
+  for (size_t channel = channel_begin; channel < channel_end; ++channel) {
+    process_channel(channel);
+  }
+}
+
+ChannelGroupRunner::ChannelGroupRunner(size_t max_num_groups) {
+  const size_t num_cores =
+      static_cast<size_t>(std::max(CpuInfo::DetectNumberOfCores(), 1u));
+  const size_t num_groups =
+      std::max<size_t>(std::min(max_num_groups, num_cores), 1);
+  for (size_t group = 1; group < num_groups; ++group) {
+    workers_.push_back(std::make_unique<TaskThread>("ApmChannelGroup",
+                                                    rtc::kRealtimePriority));
+  }
+  group_tasks_.resize(workers_.size());
+}
+
+ChannelGroupRunner::~ChannelGroupRunner() = default;
+
+void ChannelGroupRunner::Run(
+    size_t num_channels,
+    rtc::FunctionView<void(size_t channel)> process_channel) {
+  if (num_channels == 0) {
+    return;
+  }
+
+  // Never use more groups than channels.
+  const size_t num_active_groups = std::min(num_groups(), num_channels);
+  for (size_t group = 1; group < num_active_groups; ++group) {
+    GroupTask& task = group_tasks_[group - 1];
+    task.process_channel = process_channel;
+    task.channel_begin = group * num_channels / num_active_groups;
+    task.channel_end = (group + 1) * num_channels / num_active_groups;
+    workers_[group - 1]->StartTask(task);
+  }
+
+  for (size_t channel = 0; channel < num_channels / num_active_groups;
+       ++channel) {
+    process_channel(channel);
+  }
+
+  for (size_t group = 1; group < num_active_groups; ++group) {
+    workers_[group - 1]->Wait();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_CHANNEL_GROUP_RUNNER_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_CHANNEL_GROUP_RUNNER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+
+namespace webrtc {
+
+class TaskThread;
+
+// Runs a per-channel task on contiguous groups of channels in parallel. The
+// first group runs on the calling thread and every other group on a worker
+// thread owned by the runner. Run() returns when all the groups are done,
+// which makes the result identical to processing the channels in order, as
+// long as the processing of one channel does not depend on the others.
+class ChannelGroupRunner {
+ public:
+  // Creates a runner for at most |max_num_groups| groups, which is further
+  // limited by the number of CPU cores.
+  explicit ChannelGroupRunner(size_t max_num_groups);
+  ~ChannelGroupRunner();
+  ChannelGroupRunner(const ChannelGroupRunner&) = delete;
+  ChannelGroupRunner& operator=(const ChannelGroupRunner&) = delete;
+
+  size_t num_groups() const { return workers_.size() + 1; }
+
+  // Calls |process_channel| once for each channel in [0, |num_channels|).
+  void Run(size_t num_channels,
+           rtc::FunctionView<void(size_t channel)> process_channel);
+
+ private:
+  // The channels of one group, handed to a worker thread by Run().
+  struct GroupTask {
+    void operator()() const;
+
+    rtc::FunctionView<void(size_t channel)> process_channel;
+    size_t channel_begin = 0;
+    size_t channel_end = 0;
+  };
+
+  std::vector<std::unique_ptr<TaskThread>> workers_;
+  // One task per worker, kept here as the workers don't copy them.
+  std::vector<GroupTask> group_tasks_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_CHANNEL_GROUP_RUNNER_H_
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/channel_group_runner.h"
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that every channel is processed exactly once in each call.
+TEST(ChannelGroupRunner, ProcessesEachChannelOnce) {
+  for (size_t max_num_groups : {1, 2, 4}) {
+    ChannelGroupRunner runner(max_num_groups);
+    EXPECT_LE(runner.num_groups(), max_num_groups);
+    for (size_t num_channels : {0, 1, 3, 16}) {
+      SCOPED_TRACE(max_num_groups);
+      SCOPED_TRACE(num_channels);
+      std::vector<int> num_calls(num_channels, 0);
+      for (int k = 0; k < 10; ++k) {
+        runner.Run(num_channels,
+                   [&num_calls](size_t channel) { ++num_calls[channel]; });
+      }
+      for (int calls : num_calls) {
+        EXPECT_EQ(10, calls);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -16,6 +16,14 @@
 #include <algorithm>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 // Number of right shifts for scaling is linearly depending on number of bits in
 // the far-end binary spectrum.
@@ -40,6 +48,10 @@ static const float kMinFractionWhenPossiblyNonCausal = 0.25f;
 
 // Counts and returns number of bits of a 32-bit word.
 static int BitCount(uint32_t u32) {
+#if defined(__GNUC__)
+  // A single instruction on targets with a population count.
+  return __builtin_popcount(u32);
+#else
   uint32_t tmp =
       u32 - ((u32 >> 1) & 033333333333) - ((u32 >> 2) & 011111111111);
   tmp = ((tmp + (tmp >> 3)) & 030707070707);
@@ -47,6 +59,7 @@ static int BitCount(uint32_t u32) {
   tmp = (tmp + (tmp >> 12) + (tmp >> 24)) & 077;
 
   return ((int)tmp);
+#endif
 }
 
 // Compares the |binary_vector| with all rows of the |binary_matrix| and counts
@@ -68,12 +81,72 @@ static void BitCountComparison(uint32_t binary_vector,
                                int32_t* bit_counts) {
   int n = 0;
 
-  // Compare |binary_vector| with all rows of the |binary_matrix|
+  // Compare |binary_vector| with four rows of the |binary_matrix| at a time.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128i vector = _mm_set1_epi32((int32_t)binary_vector);
+  const __m128i mask1 = _mm_set1_epi32(0x55555555);
+  const __m128i mask2 = _mm_set1_epi32(0x33333333);
+  const __m128i mask4 = _mm_set1_epi32(0x0f0f0f0f);
+  for (; n + 4 <= matrix_size; n += 4) {
+    __m128i x = _mm_xor_si128(
+        vector, _mm_loadu_si128((const __m128i*)&binary_matrix[n]));
+    // Sums of bit pairs, nibbles and bytes, followed by the sum of the four
+    // bytes of each word.
+    x = _mm_sub_epi32(x, _mm_and_si128(_mm_srli_epi32(x, 1), mask1));
+    x = _mm_add_epi32(_mm_and_si128(x, mask2),
+                      _mm_and_si128(_mm_srli_epi32(x, 2), mask2));
+    x = _mm_and_si128(_mm_add_epi32(x, _mm_srli_epi32(x, 4)), mask4);
+    x = _mm_add_epi32(x, _mm_srli_epi32(x, 8));
+    x = _mm_add_epi32(x, _mm_srli_epi32(x, 16));
+    x = _mm_and_si128(x, _mm_set1_epi32(0x3f));
+    _mm_storeu_si128((__m128i*)&bit_counts[n], x);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  const uint32x4_t vector = vdupq_n_u32(binary_vector);
+  for (; n + 4 <= matrix_size; n += 4) {
+    const uint32x4_t x = veorq_u32(vector, vld1q_u32(&binary_matrix[n]));
+    // Bit counts per byte, summed pairwise to bit counts per word.
+    const uint8x16_t byte_counts = vcntq_u8(vreinterpretq_u8_u32(x));
+    const uint32x4_t word_counts = vpaddlq_u16(vpaddlq_u8(byte_counts));
+    vst1q_s32(&bit_counts[n], vreinterpretq_s32_u32(word_counts));
+  }
+#endif
+
+  // Compare |binary_vector| with the remaining rows of the |binary_matrix|
   for (; n < matrix_size; n++) {
     bit_counts[n] = (int32_t)BitCount(binary_vector ^ binary_matrix[n]);
   }
 }
 
+// Moves the history entries of delays 0 to |history_size| - 1 to the
+// beginning of the history buffers.
+static void LinearizeFarHistory(BinaryDelayEstimatorFarend* self) {
+  if (self->history_position == 0) {
+    return;
+  }
+  memmove(&self->binary_far_history[0],
+          &self->binary_far_history[self->history_position],
+          sizeof(*self->binary_far_history) * self->history_size);
+  memmove(&self->far_bit_counts[0],
+          &self->far_bit_counts[self->history_position],
+          sizeof(*self->far_bit_counts) * self->history_size);
+  self->history_position = 0;
+}
+
+// Copies the first |history_size| history entries to the second half of the
+// history buffers. Requires a linearized history.
+static void MirrorFarHistory(BinaryDelayEstimatorFarend* self) {
+  RTC_DCHECK_EQ(0, self->history_position);
+  if (self->history_size == 0) {
+    return;
+  }
+  memcpy(&self->binary_far_history[self->history_size],
+         &self->binary_far_history[0],
+         sizeof(*self->binary_far_history) * self->history_size);
+  memcpy(&self->far_bit_counts[self->history_size], &self->far_bit_counts[0],
+         sizeof(*self->far_bit_counts) * self->history_size);
+}
+
 // Collects necessary statistics for the HistogramBasedValidation().  This
 // function has to be called prior to calling HistogramBasedValidation().  The
 // statistics updated and used by the HistogramBasedValidation() are:
@@ -291,6 +364,7 @@ BinaryDelayEstimatorFarend* WebRtc_CreateBinaryDelayEstimatorFarend(
   }
 
   self->history_size = 0;
+  self->history_position = 0;
   self->binary_far_history = NULL;
   self->far_bit_counts = NULL;
   if (WebRtc_AllocateFarendBufferMemory(self, history_size) == 0) {
@@ -303,12 +377,15 @@ BinaryDelayEstimatorFarend* WebRtc_CreateBinaryDelayEstimatorFarend(
 int WebRtc_AllocateFarendBufferMemory(BinaryDelayEstimatorFarend* self,
                                       int history_size) {
   RTC_DCHECK(self);
-  // (Re-)Allocate memory for history buffers.
+  // Keep the entries of the smallest delays when resizing.
+  LinearizeFarHistory(self);
+  // (Re-)Allocate memory for history buffers, which hold each entry twice.
   self->binary_far_history = static_cast<uint32_t*>(
       realloc(self->binary_far_history,
-              history_size * sizeof(*self->binary_far_history)));
-  self->far_bit_counts = static_cast<int*>(realloc(
-      self->far_bit_counts, history_size * sizeof(*self->far_bit_counts)));
+              2 * history_size * sizeof(*self->binary_far_history)));
+  self->far_bit_counts = static_cast<int*>(
+      realloc(self->far_bit_counts,
+              2 * history_size * sizeof(*self->far_bit_counts)));
   if ((self->binary_far_history == NULL) || (self->far_bit_counts == NULL)) {
     history_size = 0;
   }
@@ -321,14 +398,17 @@ int WebRtc_AllocateFarendBufferMemory(BinaryDelayEstimatorFarend* self,
            sizeof(*self->far_bit_counts) * size_diff);
   }
   self->history_size = history_size;
+  MirrorFarHistory(self);
 
   return self->history_size;
 }
 
 void WebRtc_InitBinaryDelayEstimatorFarend(BinaryDelayEstimatorFarend* self) {
   RTC_DCHECK(self);
-  memset(self->binary_far_history, 0, sizeof(uint32_t) * self->history_size);
-  memset(self->far_bit_counts, 0, sizeof(int) * self->history_size);
+  memset(self->binary_far_history, 0,
+         2 * sizeof(uint32_t) * self->history_size);
+  memset(self->far_bit_counts, 0, 2 * sizeof(int) * self->history_size);
+  self->history_position = 0;
 }
 
 void WebRtc_SoftResetBinaryDelayEstimatorFarend(
@@ -353,6 +433,7 @@ void WebRtc_SoftResetBinaryDelayEstimatorFarend(
   }
 
   // Shift and zero pad buffers.
+  LinearizeFarHistory(self);
   memmove(&self->binary_far_history[dest_index],
           &self->binary_far_history[src_index],
           sizeof(*self->binary_far_history) * shift_size);
@@ -362,21 +443,27 @@ void WebRtc_SoftResetBinaryDelayEstimatorFarend(
           sizeof(*self->far_bit_counts) * shift_size);
   memset(&self->far_bit_counts[padding_index], 0,
          sizeof(*self->far_bit_counts) * abs_shift);
+  MirrorFarHistory(self);
 }
 
 void WebRtc_AddBinaryFarSpectrum(BinaryDelayEstimatorFarend* handle,
                                  uint32_t binary_far_spectrum) {
+  int position = 0;
   RTC_DCHECK(handle);
-  // Shift binary spectrum history and insert current |binary_far_spectrum|.
-  memmove(&(handle->binary_far_history[1]), &(handle->binary_far_history[0]),
-          (handle->history_size - 1) * sizeof(uint32_t));
-  handle->binary_far_history[0] = binary_far_spectrum;
-
-  // Shift history of far-end binary spectrum bit counts and insert bit count
-  // of current |binary_far_spectrum|.
-  memmove(&(handle->far_bit_counts[1]), &(handle->far_bit_counts[0]),
-          (handle->history_size - 1) * sizeof(int));
-  handle->far_bit_counts[0] = BitCount(binary_far_spectrum);
+  // Step the history one entry back, which drops the oldest entry, and insert
+  // current |binary_far_spectrum| and its bit count as delay zero. Both copies
+  // of the entry are written to keep the history contiguous.
+  if (handle->history_position == 0) {
+    handle->history_position = handle->history_size;
+  }
+  handle->history_position--;
+  position = handle->history_position;
+  handle->binary_far_history[position] = binary_far_spectrum;
+  handle->binary_far_history[position + handle->history_size] =
+      binary_far_spectrum;
+  handle->far_bit_counts[position] = BitCount(binary_far_spectrum);
+  handle->far_bit_counts[position + handle->history_size] =
+      handle->far_bit_counts[position];
 }
 
 void WebRtc_FreeBinaryDelayEstimator(BinaryDelayEstimator* self) {
@@ -525,12 +612,19 @@ int WebRtc_ProcessBinarySpectrum(BinaryDelayEstimator* self,
   int32_t value_best_candidate = kMaxBitCountsQ9;
   int32_t value_worst_candidate = 0;
   int32_t valley_depth = 0;
+  const uint32_t* binary_far_history = NULL;
+  const int* far_bit_counts = NULL;
 
   RTC_DCHECK(self);
   if (self->farend->history_size != self->history_size) {
     // Non matching history sizes.
     return -1;
   }
+  // The farend entries of delays 0 to |history_size| - 1.
+  binary_far_history =
+      &self->farend->binary_far_history[self->farend->history_position];
+  far_bit_counts =
+      &self->farend->far_bit_counts[self->farend->history_position];
   if (self->near_history_size > 1) {
     // If we apply lookahead, shift near-end binary spectrum history. Insert
     // current |binary_near_spectrum| and pull out the delayed one.
@@ -541,7 +635,7 @@ int WebRtc_ProcessBinarySpectrum(BinaryDelayEstimator* self,
   }
 
   // Compare with delayed spectra and store the |bit_counts| for each delay.
-  BitCountComparison(binary_near_spectrum, self->farend->binary_far_history,
+  BitCountComparison(binary_near_spectrum, binary_far_history,
                      self->history_size, self->bit_counts);
 
   // Update |mean_bit_counts|, which is the smoothed version of |bit_counts|.
@@ -553,10 +647,10 @@ int WebRtc_ProcessBinarySpectrum(BinaryDelayEstimator* self,
     // Update |mean_bit_counts| only when far-end signal has something to
     // contribute. If |far_bit_counts| is zero the far-end signal is weak and
     // we likely have a poor echo condition, hence don't update.
-    if (self->farend->far_bit_counts[i] > 0) {
+    if (far_bit_counts[i] > 0) {
       // Make number of right shifts piecewise linear w.r.t. |far_bit_counts|.
       int shifts = kShiftsAtZero;
-      shifts -= (kShiftsLinearSlope * self->farend->far_bit_counts[i]) >> 4;
+      shifts -= (kShiftsLinearSlope * far_bit_counts[i]) >> 4;
       WebRtc_MeanEstimatorFix(bit_count, shifts, &(self->mean_bit_counts[i]));
     }
   }
@@ -619,8 +713,7 @@ int WebRtc_ProcessBinarySpectrum(BinaryDelayEstimator* self,
 
   // Check for nonstationary farend signal.
   const bool non_stationary_farend =
-      std::any_of(self->farend->far_bit_counts,
-                  self->farend->far_bit_counts + self->history_size,
+      std::any_of(far_bit_counts, far_bit_counts + self->history_size,
                   [](int a) { return a > 0; });
 
   if (non_stationary_farend) {
@@ -24,6 +24,10 @@ typedef struct {
   // Binary history variables.
   uint32_t* binary_far_history;
   int history_size;
+  // The history buffers hold 2 * |history_size| entries, each history entry
+  // being stored at both i and i + |history_size|. The entries of delays 0 to
+  // |history_size| - 1 are then contiguous from |history_position|.
+  int history_position;
 } BinaryDelayEstimatorFarend;
 
 typedef struct {
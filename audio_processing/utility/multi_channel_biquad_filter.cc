@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/audio_processing/utility/multi_channel_biquad_filter.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+bool DetectSse2() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  return WebRtc_GetCPUInfo(kSSE2) != 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+constexpr size_t MultiChannelBiQuadFilter::kChannelsPerGroup;
+
+MultiChannelBiQuadFilter::MultiChannelBiQuadFilter(
+    const CascadedBiQuadFilter::BiQuadCoefficients& coefficients,
+    size_t num_biquads,
+    size_t num_channels)
+    : coefficients_(coefficients),
+      num_biquads_(num_biquads),
+      use_sse2_(DetectSse2()) {
+  Reset(num_channels);
+}
+
+MultiChannelBiQuadFilter::~MultiChannelBiQuadFilter() = default;
+
+void MultiChannelBiQuadFilter::Process(rtc::ArrayView<float* const> channels,
+                                       size_t num_frames) {
+  for (size_t group = 0; group < num_channel_groups(); ++group) {
+    ProcessChannelGroup(group, channels, num_frames);
+  }
+}
+
+void MultiChannelBiQuadFilter::ProcessChannelGroup(
+    size_t group,
+    rtc::ArrayView<float* const> channels,
+    size_t num_frames) {
+  RTC_DCHECK_EQ(num_channels_, channels.size());
+  RTC_DCHECK_LT(group, num_channel_groups());
+  const size_t first_channel = group * kChannelsPerGroup;
+  const size_t num_lanes =
+      std::min(kChannelsPerGroup, num_channels_ - first_channel);
+  GroupState* states = &states_[group * num_biquads_];
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  // A single channel gains nothing from the lanes.
+  if (use_sse2_ && num_lanes > 1) {
+    ProcessGroupSse2(&channels[first_channel], num_lanes, num_frames, states);
+    return;
+  }
+#endif
+  ProcessGroupScalar(&channels[first_channel], num_lanes, num_frames, states);
+}
+
+void MultiChannelBiQuadFilter::Reset() {
+  for (auto& state : states_) {
+    std::fill(&state.x[0][0], &state.x[0][0] + 2 * kChannelsPerGroup, 0.f);
+    std::fill(&state.y[0][0], &state.y[0][0] + 2 * kChannelsPerGroup, 0.f);
+  }
+}
+
+void MultiChannelBiQuadFilter::Reset(size_t num_channels) {
+  num_channels_ = num_channels;
+  states_.resize(num_channel_groups() * num_biquads_);
+  Reset();
+}
+
+// Same computation as CascadedBiQuadFilter::ApplyBiQuad().
+void MultiChannelBiQuadFilter::ProcessGroupScalar(float* const* lanes,
+                                                  size_t num_lanes,
+                                                  size_t num_frames,
+                                                  GroupState* states) {
+  const float* c_b = coefficients_.b;
+  const float* c_a = coefficients_.a;
+  for (size_t biquad = 0; biquad < num_biquads_; ++biquad) {
+    GroupState& state = states[biquad];
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+      float* y = lanes[lane];
+      float m_x[2] = {state.x[0][lane], state.x[1][lane]};
+      float m_y[2] = {state.y[0][lane], state.y[1][lane]};
+      for (size_t k = 0; k < num_frames; ++k) {
+        const float tmp = y[k];
+        y[k] = c_b[0] * tmp + c_b[1] * m_x[0] + c_b[2] * m_x[1] -
+               c_a[0] * m_y[0] - c_a[1] * m_y[1];
+        m_x[1] = m_x[0];
+        m_x[0] = tmp;
+        m_y[1] = m_y[0];
+        m_y[0] = y[k];
+      }
+      state.x[0][lane] = m_x[0];
+      state.x[1][lane] = m_x[1];
+      state.y[0][lane] = m_y[0];
+      state.y[1][lane] = m_y[1];
+    }
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Performs the operations of the scalar version in the same order, lane by
+// lane, so that the results are bit-exact.
+void MultiChannelBiQuadFilter::ProcessGroupSse2(float* const* lanes,
+                                                size_t num_lanes,
+                                                size_t num_frames,
+                                                GroupState* states) {
+  const __m128 b0 = _mm_set1_ps(coefficients_.b[0]);
+  const __m128 b1 = _mm_set1_ps(coefficients_.b[1]);
+  const __m128 b2 = _mm_set1_ps(coefficients_.b[2]);
+  const __m128 a0 = _mm_set1_ps(coefficients_.a[0]);
+  const __m128 a1 = _mm_set1_ps(coefficients_.a[1]);
+
+  // The lanes without a channel filter the zeros of |unused|, which remain
+  // zeros.
+  float unused[kChannelsPerGroup] = {};
+
+  auto apply_biquads = [&](__m128* samples, size_t num_samples) {
+    for (size_t biquad = 0; biquad < num_biquads_; ++biquad) {
+      GroupState& state = states[biquad];
+      __m128 x0 = _mm_loadu_ps(state.x[0]);
+      __m128 x1 = _mm_loadu_ps(state.x[1]);
+      __m128 y0 = _mm_loadu_ps(state.y[0]);
+      __m128 y1 = _mm_loadu_ps(state.y[1]);
+      for (size_t k = 0; k < num_samples; ++k) {
+        const __m128 tmp = samples[k];
+        __m128 y = _mm_add_ps(_mm_mul_ps(b0, tmp), _mm_mul_ps(b1, x0));
+        y = _mm_add_ps(y, _mm_mul_ps(b2, x1));
+        y = _mm_sub_ps(y, _mm_mul_ps(a0, y0));
+        y = _mm_sub_ps(y, _mm_mul_ps(a1, y1));
+        x1 = x0;
+        x0 = tmp;
+        y1 = y0;
+        y0 = y;
+        samples[k] = y;
+      }
+      _mm_storeu_ps(state.x[0], x0);
+      _mm_storeu_ps(state.x[1], x1);
+      _mm_storeu_ps(state.y[0], y0);
+      _mm_storeu_ps(state.y[1], y1);
+    }
+  };
+
+  // Four samples of each lane at a time, transposed such that each vector
+  // holds one sample of all the lanes.
+  size_t n = 0;
+  for (; n + 4 <= num_frames; n += 4) {
+    float* chunks[kChannelsPerGroup];
+    __m128 samples[4];
+    for (size_t lane = 0; lane < kChannelsPerGroup; ++lane) {
+      chunks[lane] = lane < num_lanes ? &lanes[lane][n] : unused;
+      samples[lane] = _mm_loadu_ps(chunks[lane]);
+    }
+    _MM_TRANSPOSE4_PS(samples[0], samples[1], samples[2], samples[3]);
+    apply_biquads(samples, 4);
+    _MM_TRANSPOSE4_PS(samples[0], samples[1], samples[2], samples[3]);
+    for (size_t lane = 0; lane < kChannelsPerGroup; ++lane) {
+      _mm_storeu_ps(chunks[lane], samples[lane]);
+    }
+  }
+
+  // The remaining samples, one at a time.
+  for (; n < num_frames; ++n) {
+    float values[kChannelsPerGroup] = {};
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+      values[lane] = lanes[lane][n];
+    }
+    __m128 sample = _mm_loadu_ps(values);
+    apply_biquads(&sample, 1);
+    _mm_storeu_ps(values, sample);
+    for (size_t lane = 0; lane < num_lanes; ++lane) {
+      lanes[lane][n] = values[lane];
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace webrtc
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_UTILITY_MULTI_CHANNEL_BIQUAD_FILTER_H_
+#define MODULES_AUDIO_PROCESSING_UTILITY_MULTI_CHANNEL_BIQUAD_FILTER_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/utility/cascaded_biquad_filter.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Applies the same cascade of biquads to a number of channels. The channels
+// are processed in groups of kChannelsPerGroup, one channel per SIMD lane, so
+// that the recursion of several channels advances with each instruction. The
+// output is identical to that of one CascadedBiQuadFilter per channel.
+class MultiChannelBiQuadFilter {
+ public:
+  static constexpr size_t kChannelsPerGroup = 4;
+
+  MultiChannelBiQuadFilter(
+      const CascadedBiQuadFilter::BiQuadCoefficients& coefficients,
+      size_t num_biquads,
+      size_t num_channels);
+  ~MultiChannelBiQuadFilter();
+  MultiChannelBiQuadFilter(const MultiChannelBiQuadFilter&) = delete;
+  MultiChannelBiQuadFilter& operator=(const MultiChannelBiQuadFilter&) =
+      delete;
+
+  size_t num_channels() const { return num_channels_; }
+  size_t num_channel_groups() const {
+    return (num_channels_ + kChannelsPerGroup - 1) / kChannelsPerGroup;
+  }
+
+  // Applies the biquads in-place on the |num_frames| first values of each of
+  // the num_channels() channels in |channels|.
+  void Process(rtc::ArrayView<float* const> channels, size_t num_frames);
+  // Same as above for the channels of group |group| only, i.e., channels
+  // [kChannelsPerGroup * group, kChannelsPerGroup * (group + 1)). Different
+  // groups may be processed concurrently.
+  void ProcessChannelGroup(size_t group,
+                           rtc::ArrayView<float* const> channels,
+                           size_t num_frames);
+  // Resets the filter to its initial state.
+  void Reset();
+  // Resets the filter to its initial state for |num_channels| channels.
+  void Reset(size_t num_channels);
+
+ private:
+  // The state of one biquad for the channels of a group, one per lane.
+  struct GroupState {
+    float x[2][kChannelsPerGroup];
+    float y[2][kChannelsPerGroup];
+  };
+
+  void ProcessGroupScalar(float* const* lanes,
+                          size_t num_lanes,
+                          size_t num_frames,
+                          GroupState* states);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  void ProcessGroupSse2(float* const* lanes,
+                        size_t num_lanes,
+                        size_t num_frames,
+                        GroupState* states);
+#endif
+
+  const CascadedBiQuadFilter::BiQuadCoefficients coefficients_;
+  const size_t num_biquads_;
+  size_t num_channels_;
+  // The states of the biquads of each group, indexed by
+  // group * num_biquads_ + biquad.
+  std::vector<GroupState> states_;
+  const bool use_sse2_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_UTILITY_MULTI_CHANNEL_BIQUAD_FILTER_H_
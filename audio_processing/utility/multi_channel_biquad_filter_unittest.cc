@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/multi_channel_biquad_filter.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Coefficients for a second order Butterworth high-pass filter with cutoff
+// frequency 100 Hz.
+const CascadedBiQuadFilter::BiQuadCoefficients kHighPassFilterCoefficients = {
+    {0.97261f, -1.94523f, 0.97261f},
+    {-1.94448f, 0.94598f}};
+
+constexpr size_t kNumBiQuads = 2;
+
+std::vector<std::vector<float>> CreateRandomChannels(Random* random,
+                                                     size_t num_channels,
+                                                     size_t num_frames) {
+  std::vector<std::vector<float>> channels(num_channels,
+                                           std::vector<float>(num_frames));
+  for (auto& channel : channels) {
+    for (float& value : channel) {
+      value = 32767.f * (2.f * random->Rand<float>() - 1.f);
+    }
+  }
+  return channels;
+}
+
+std::vector<float*> ChannelPointers(std::vector<std::vector<float>>* channels) {
+  std::vector<float*> pointers;
+  for (auto& channel : *channels) {
+    pointers.push_back(channel.data());
+  }
+  return pointers;
+}
+
+}  // namespace
+
+// Verifies that the output is identical to that of one CascadedBiQuadFilter
+// per channel, for complete and partial channel groups and for frame lengths
+// that are not multiples of the vector size.
+TEST(MultiChannelBiQuadFilter, BitexactWithCascadedBiQuadFilters) {
+  Random random(42);
+  for (size_t num_channels = 1; num_channels <= 9; ++num_channels) {
+    for (size_t num_frames : {160, 161, 3}) {
+      SCOPED_TRACE(num_channels);
+      SCOPED_TRACE(num_frames);
+      MultiChannelBiQuadFilter filter(kHighPassFilterCoefficients, kNumBiQuads,
+                                      num_channels);
+      std::vector<std::unique_ptr<CascadedBiQuadFilter>> reference_filters;
+      for (size_t k = 0; k < num_channels; ++k) {
+        reference_filters.emplace_back(
+            new CascadedBiQuadFilter(kHighPassFilterCoefficients, kNumBiQuads));
+      }
+
+      // Several frames, to cover the filter states.
+      for (int frame = 0; frame < 5; ++frame) {
+        std::vector<std::vector<float>> channels =
+            CreateRandomChannels(&random, num_channels, num_frames);
+        std::vector<std::vector<float>> reference_channels = channels;
+        filter.Process(ChannelPointers(&channels), num_frames);
+        for (size_t k = 0; k < num_channels; ++k) {
+          reference_filters[k]->Process(reference_channels[k]);
+        }
+        EXPECT_EQ(reference_channels, channels);
+      }
+    }
+  }
+}
+
+// Verifies that processing the channel groups one by one is identical to
+// processing all channels at once.
+TEST(MultiChannelBiQuadFilter, ChannelGroupsAreIndependent) {
+  constexpr size_t kNumChannels = 6;
+  constexpr size_t kNumFrames = 160;
+  Random random(42);
+  MultiChannelBiQuadFilter filter(kHighPassFilterCoefficients, kNumBiQuads,
+                                  kNumChannels);
+  MultiChannelBiQuadFilter group_filter(kHighPassFilterCoefficients,
+                                        kNumBiQuads, kNumChannels);
+  ASSERT_EQ(2u, group_filter.num_channel_groups());
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<std::vector<float>> channels =
+        CreateRandomChannels(&random, kNumChannels, kNumFrames);
+    std::vector<std::vector<float>> group_channels = channels;
+    filter.Process(ChannelPointers(&channels), kNumFrames);
+    const std::vector<float*> pointers = ChannelPointers(&group_channels);
+    for (size_t group = group_filter.num_channel_groups(); group > 0;
+         --group) {
+      group_filter.ProcessChannelGroup(group - 1, pointers, kNumFrames);
+    }
+    EXPECT_EQ(channels, group_channels);
+  }
+}
+
+// Verifies that Reset() restores the initial state, also when changing the
+// number of channels.
+TEST(MultiChannelBiQuadFilter, Reset) {
+  constexpr size_t kNumFrames = 160;
+  Random random(42);
+  std::vector<std::vector<float>> input =
+      CreateRandomChannels(&random, 5, kNumFrames);
+
+  MultiChannelBiQuadFilter filter(kHighPassFilterCoefficients, kNumBiQuads, 3);
+  std::vector<std::vector<float>> first(input.begin(), input.begin() + 3);
+  filter.Process(ChannelPointers(&first), kNumFrames);
+
+  std::vector<std::vector<float>> second(input.begin(), input.begin() + 3);
+  filter.Reset();
+  filter.Process(ChannelPointers(&second), kNumFrames);
+  EXPECT_EQ(first, second);
+
+  MultiChannelBiQuadFilter five_channel_filter(kHighPassFilterCoefficients,
+                                               kNumBiQuads, 5);
+  std::vector<std::vector<float>> expected = input;
+  five_channel_filter.Process(ChannelPointers(&expected), kNumFrames);
+  filter.Reset(5);
+  EXPECT_EQ(5u, filter.num_channels());
+  filter.Process(ChannelPointers(&input), kNumFrames);
+  EXPECT_EQ(expected, input);
+}
+
+}  // namespace webrtc
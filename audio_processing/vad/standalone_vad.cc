@@ -20,7 +20,12 @@ namespace webrtc {
 static const int kDefaultStandaloneVadMode = 3;
 
 StandaloneVad::StandaloneVad(VadInst* vad)
-    : vad_(vad), buffer_(), index_(0), mode_(kDefaultStandaloneVadMode) {}
+    : vad_(vad),
+      buffer_(),
+      index_(0),
+      num_activities_(0),
+      any_activity_(false),
+      mode_(kDefaultStandaloneVadMode) {}
 
 StandaloneVad::~StandaloneVad() {
   WebRtcVad_Free(vad_);
@@ -43,6 +48,7 @@ StandaloneVad* StandaloneVad::Create() {
 int StandaloneVad::AddAudio(const int16_t* data, size_t length) {
   if (length != kLength10Ms)
     return -1;
+  RTC_DCHECK_EQ(0, num_activities_) << "Audio and activities can't be mixed";
 
   if (index_ + length > kLength10Ms * kMaxNum10msFrames)
     // Reset the buffer if it's full.
@@ -55,16 +61,34 @@ int StandaloneVad::AddAudio(const int16_t* data, size_t length) {
   return 0;
 }
 
+void StandaloneVad::AddActivity(bool active) {
+  RTC_DCHECK_EQ(0, index_) << "Audio and activities can't be mixed";
+  if (num_activities_ == kMaxNum10msFrames) {
+    // Reset the buffer if it's full, as in AddAudio().
+    num_activities_ = 0;
+    any_activity_ = false;
+  }
+  any_activity_ = any_activity_ || active;
+  ++num_activities_;
+}
+
 int StandaloneVad::GetActivity(double* p, size_t length_p) {
-  if (index_ == 0)
+  if (index_ == 0 && num_activities_ == 0)
     return -1;
 
-  const size_t num_frames = index_ / kLength10Ms;
+  const size_t num_frames =
+      num_activities_ > 0 ? num_activities_ : index_ / kLength10Ms;
   if (num_frames > length_p)
     return -1;
-  RTC_DCHECK_EQ(0, WebRtcVad_ValidRateAndFrameLength(kSampleRateHz, index_));
 
-  int activity = WebRtcVad_Process(vad_, kSampleRateHz, buffer_, index_);
+  int activity = 0;
+  if (num_activities_ > 0) {
+    // The buffered frames are active if any of them is.
+    activity = any_activity_ ? 1 : 0;
+  } else {
+    RTC_DCHECK_EQ(0, WebRtcVad_ValidRateAndFrameLength(kSampleRateHz, index_));
+    activity = WebRtcVad_Process(vad_, kSampleRateHz, buffer_, index_);
+  }
   if (activity < 0)
     return -1;
   else if (activity == 0)
@@ -75,6 +99,8 @@ int StandaloneVad::GetActivity(double* p, size_t length_p) {
     p[n] = p[0];
   // Reset the buffer to start from the beginning.
   index_ = 0;
+  num_activities_ = 0;
+  any_activity_ = false;
   return activity;
 }
 
@@ -45,6 +45,12 @@ class StandaloneVad {
   // Expecting 10 ms of 16 kHz audio to be pushed in.
   int AddAudio(const int16_t* data, size_t length);
 
+  // Pushes in the decision of another WebRTC VAD instance for 10 ms of audio,
+  // instead of the audio itself. GetActivity() then reports the buffered
+  // frames as active if any of them is, without running the VAD. Audio and
+  // decisions must not be buffered at the same time.
+  void AddActivity(bool active);
+
   // Set aggressiveness of VAD, 0 is the least aggressive and 3 is the most
   // aggressive mode. Returns -1 if the input is less than 0 or larger than 3,
   // otherwise 0 is returned.
@@ -61,6 +67,9 @@ class StandaloneVad {
   VadInst* vad_;
   int16_t buffer_[kMaxNum10msFrames * kLength10Ms];
   size_t index_;
+  // Number of decisions pushed in by AddActivity() and whether any was active.
+  size_t num_activities_;
+  bool any_activity_;
   int mode_;
 };
 
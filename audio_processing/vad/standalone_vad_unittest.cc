@@ -54,6 +54,37 @@ TEST(StandaloneVadTest, Api) {
   EXPECT_EQ(kMode, vad->mode());
 }
 
+TEST(StandaloneVadTest, SharedActivities) {
+  std::unique_ptr<StandaloneVad> vad(StandaloneVad::Create());
+  const size_t kMaxNumFrames = 3;
+  double p[kMaxNumFrames];
+
+  // The frames are active if any of them is.
+  vad->AddActivity(false);
+  vad->AddActivity(true);
+  vad->AddActivity(false);
+  EXPECT_EQ(-1, vad->GetActivity(p, kMaxNumFrames - 1));
+  EXPECT_EQ(1, vad->GetActivity(p, kMaxNumFrames));
+  for (size_t n = 0; n < kMaxNumFrames; n++)
+    EXPECT_EQ(0.5, p[n]);
+
+  // Ask for activity when buffer is empty.
+  EXPECT_EQ(-1, vad->GetActivity(p, kMaxNumFrames));
+
+  // Should reset and result in one inactive frame.
+  vad->AddActivity(true);
+  vad->AddActivity(true);
+  vad->AddActivity(true);
+  vad->AddActivity(false);
+  EXPECT_EQ(0, vad->GetActivity(p, 1));
+  EXPECT_EQ(0.01, p[0]);
+
+  // Audio can be added again once the activities are consumed.
+  int16_t data[kLength10Ms] = {0};
+  EXPECT_EQ(0, vad->AddAudio(data, kLength10Ms));
+  EXPECT_EQ(0, vad->GetActivity(p, 1));
+}
+
 #if defined(WEBRTC_IOS)
 TEST(StandaloneVadTest, DISABLED_ActivityDetection) {
 #else
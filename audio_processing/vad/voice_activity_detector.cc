@@ -31,12 +31,27 @@ VoiceActivityDetector::VoiceActivityDetector()
 
 VoiceActivityDetector::~VoiceActivityDetector() = default;
 
-// Because ISAC has a different chunk length, it updates
-// |chunkwise_voice_probabilities_| and |chunkwise_rms_| when there is new data.
-// Otherwise it clears them.
 void VoiceActivityDetector::ProcessChunk(const int16_t* audio,
                                          size_t length,
                                          int sample_rate_hz) {
+  ProcessChunkInternal(audio, length, sample_rate_hz, absl::nullopt);
+}
+
+void VoiceActivityDetector::ProcessChunk(const int16_t* audio,
+                                         size_t length,
+                                         int sample_rate_hz,
+                                         bool voice_activity) {
+  ProcessChunkInternal(audio, length, sample_rate_hz, voice_activity);
+}
+
+// Because ISAC has a different chunk length, it updates
+// |chunkwise_voice_probabilities_| and |chunkwise_rms_| when there is new data.
+// Otherwise it clears them.
+void VoiceActivityDetector::ProcessChunkInternal(
+    const int16_t* audio,
+    size_t length,
+    int sample_rate_hz,
+    absl::optional<bool> voice_activity) {
   RTC_DCHECK_EQ(length, sample_rate_hz / 100);
   // Resample to the required rate.
   const int16_t* resampled_ptr = audio;
@@ -51,8 +66,12 @@ void VoiceActivityDetector::ProcessChunk(const int16_t* audio,
 
   // Each chunk needs to be passed into |standalone_vad_|, because internally it
   // buffers the audio and processes it all at once when GetActivity() is
-  // called.
-  RTC_CHECK_EQ(standalone_vad_->AddAudio(resampled_ptr, length), 0);
+  // called. A shared decision spares that processing.
+  if (voice_activity) {
+    standalone_vad_->AddActivity(*voice_activity);
+  } else {
+    RTC_CHECK_EQ(standalone_vad_->AddAudio(resampled_ptr, length), 0);
+  }
 
   audio_processing_.ExtractFeatures(resampled_ptr, length, &features_);
 
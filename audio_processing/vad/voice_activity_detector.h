@@ -17,6 +17,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "common_audio/resampler/include/resampler.h"
 #include "modules/audio_processing/vad/common.h"
 #include "modules/audio_processing/vad/pitch_based_vad.h"
@@ -34,6 +35,13 @@ class VoiceActivityDetector {
 
   // Processes each audio chunk and estimates the voice probability.
   void ProcessChunk(const int16_t* audio, size_t length, int sample_rate_hz);
+  // Same as above, but uses |voice_activity|, the decision of a WebRTC VAD in
+  // the most aggressive mode for the chunk, instead of running the
+  // StandaloneVad on it.
+  void ProcessChunk(const int16_t* audio,
+                    size_t length,
+                    int sample_rate_hz,
+                    bool voice_activity);
 
   // Returns a vector of voice probabilities for each chunk. It can be empty for
   // some chunks, but it catches up afterwards returning multiple values at
@@ -51,6 +59,11 @@ class VoiceActivityDetector {
   float last_voice_probability() const { return last_voice_probability_; }
 
  private:
+  void ProcessChunkInternal(const int16_t* audio,
+                            size_t length,
+                            int sample_rate_hz,
+                            absl::optional<bool> voice_activity);
+
   // TODO(aluebs): Change these to float.
   std::vector<double> chunkwise_voice_probabilities_;
   std::vector<double> chunkwise_rms_;
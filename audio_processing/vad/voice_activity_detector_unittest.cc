@@ -165,4 +165,29 @@ TEST(VoiceActivityDetectorTest, Noise32kHzHasLowVoiceProbabilities) {
   EXPECT_LT(max_probability, kMaxNoiseProbability);
 }
 
+TEST(VoiceActivityDetectorTest,
+     Noise16kHzWithSharedInactivityHasLowVoiceProbabilities) {
+  VoiceActivityDetector vad;
+
+  std::vector<int16_t> data(kLength10Ms);
+  float max_probability = 0.f;
+
+  std::srand(42);
+
+  for (size_t i = 0; i < kNumChunks; ++i) {
+    GenerateNoise(&data);
+
+    vad.ProcessChunk(&data[0], data.size(), kSampleRateHz,
+                     /*voice_activity=*/false);
+
+    // Before the |vad has enough data to process an ISAC block it will return
+    // the default value, 1.f, which would ruin the |max_probability| value.
+    if (i > kNumChunksPerIsacBlock) {
+      max_probability = std::max(max_probability, vad.last_voice_probability());
+    }
+  }
+
+  EXPECT_LT(max_probability, kMaxNoiseProbability);
+}
+
 }  // namespace webrtc
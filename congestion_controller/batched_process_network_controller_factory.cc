@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/include/batched_process_network_controller_factory.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+
+namespace webrtc {
+
+namespace {
+
+// Merges |update| into |pending|. The values of |update| are the newer ones
+// and win, while the probe clusters of both are kept.
+void MergeUpdate(NetworkControlUpdate update, NetworkControlUpdate* pending) {
+  if (update.congestion_window)
+    pending->congestion_window = update.congestion_window;
+  if (update.pacer_config)
+    pending->pacer_config = update.pacer_config;
+  if (update.target_rate)
+    pending->target_rate = update.target_rate;
+  pending->probe_cluster_configs.insert(pending->probe_cluster_configs.end(),
+                                        update.probe_cluster_configs.begin(),
+                                        update.probe_cluster_configs.end());
+}
+
+}  // namespace
+
+class BatchedProcessNetworkControllerFactory::BatchedController
+    : public NetworkControllerInterface {
+ public:
+  BatchedController(std::unique_ptr<NetworkControllerInterface> controller,
+                    BatchedProcessNetworkControllerFactory* factory)
+      : factory_(factory), controller_(std::move(controller)) {
+    factory_->AddController(this);
+  }
+  ~BatchedController() override { factory_->RemoveController(this); }
+
+  // Called by the factory on its task queue.
+  void Process(ProcessInterval msg) {
+    rtc::CritScope cs(&crit_);
+    MergeUpdate(controller_->OnProcessInterval(msg), &pending_update_);
+  }
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnNetworkAvailability(msg));
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnNetworkRouteChange(msg));
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnProcessInterval(msg));
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnRemoteBitrateReport(msg));
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnRoundTripTimeUpdate(msg));
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnSentPacket(msg));
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnReceivedPacket(msg));
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnStreamsConfig(msg));
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnTargetRateConstraints(msg));
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnTransportLossReport(msg));
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnTransportPacketsFeedback(msg));
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override {
+    rtc::CritScope cs(&crit_);
+    return WithPendingUpdate(controller_->OnNetworkStateEstimate(msg));
+  }
+
+ private:
+  NetworkControlUpdate WithPendingUpdate(NetworkControlUpdate update)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_) {
+    NetworkControlUpdate result = std::move(pending_update_);
+    pending_update_ = NetworkControlUpdate();
+    MergeUpdate(std::move(update), &result);
+    return result;
+  }
+
+  BatchedProcessNetworkControllerFactory* const factory_;
+  rtc::CriticalSection crit_;
+  const std::unique_ptr<NetworkControllerInterface> controller_
+      RTC_GUARDED_BY(crit_);
+  NetworkControlUpdate pending_update_ RTC_GUARDED_BY(crit_);
+};
+
+BatchedProcessNetworkControllerFactory::BatchedProcessNetworkControllerFactory(
+    std::unique_ptr<NetworkControllerFactoryInterface> factory,
+    rtc::TaskQueue* task_queue,
+    Clock* clock)
+    : factory_(std::move(factory)),
+      task_queue_(task_queue),
+      clock_(clock),
+      process_interval_(factory_->GetProcessInterval()) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK(clock_);
+  if (!process_interval_.IsFinite())
+    return;
+  task_queue_->PostTask([this] {
+    process_task_ = RepeatingTaskHandle::DelayedStart(
+        task_queue_->Get(), process_interval_, [this] {
+          ProcessControllers();
+          return process_interval_;
+        });
+  });
+}
+
+BatchedProcessNetworkControllerFactory::
+    ~BatchedProcessNetworkControllerFactory() {
+  RTC_DCHECK(!task_queue_->IsCurrent());
+  RTC_DCHECK_EQ(0, num_controllers());
+  rtc::Event stopped;
+  task_queue_->PostTask([this, &stopped] {
+    process_task_.Stop();
+    stopped.Set();
+  });
+  stopped.Wait(rtc::Event::kForever);
+}
+
+std::unique_ptr<NetworkControllerInterface>
+BatchedProcessNetworkControllerFactory::Create(NetworkControllerConfig config) {
+  return std::make_unique<BatchedController>(factory_->Create(config), this);
+}
+
+TimeDelta BatchedProcessNetworkControllerFactory::GetProcessInterval() const {
+  return TimeDelta::PlusInfinity();
+}
+
+size_t BatchedProcessNetworkControllerFactory::num_controllers() const {
+  rtc::CritScope cs(&crit_);
+  return controllers_.size();
+}
+
+void BatchedProcessNetworkControllerFactory::AddController(
+    BatchedController* controller) {
+  rtc::CritScope cs(&crit_);
+  controllers_.push_back(controller);
+}
+
+void BatchedProcessNetworkControllerFactory::RemoveController(
+    BatchedController* controller) {
+  rtc::CritScope cs(&crit_);
+  auto it = std::find(controllers_.begin(), controllers_.end(), controller);
+  RTC_DCHECK(it != controllers_.end());
+  controllers_.erase(it);
+}
+
+void BatchedProcessNetworkControllerFactory::ProcessControllers() {
+  ProcessInterval msg;
+  msg.at_time = Timestamp::ms(clock_->TimeInMilliseconds());
+  rtc::CritScope cs(&crit_);
+  for (BatchedController* controller : controllers_) {
+    controller->Process(msg);
+  }
+}
+
+}  // namespace webrtc
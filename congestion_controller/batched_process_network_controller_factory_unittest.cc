@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/include/batched_process_network_controller_factory.h"
+
+#include <atomic>
+#include <memory>
+
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int kTimeoutMs = 1000;
+constexpr int kMinProcessCalls = 3;
+
+// Returns a target rate from OnProcessInterval() and an empty update from
+// everything else. Signals |processed| once OnProcessInterval() has been
+// called kMinProcessCalls times.
+class FakeNetworkController : public NetworkControllerInterface {
+ public:
+  explicit FakeNetworkController(rtc::Event* processed)
+      : processed_(processed) {}
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    if (++num_process_calls_ == kMinProcessCalls)
+      processed_->Set();
+    NetworkControlUpdate update;
+    update.target_rate = TargetTransferRate();
+    update.target_rate->at_time = msg.at_time;
+    return update;
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback) override {
+    return NetworkControlUpdate();
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(NetworkStateEstimate) override {
+    return NetworkControlUpdate();
+  }
+
+  int num_process_calls() const { return num_process_calls_.load(); }
+
+ private:
+  rtc::Event* const processed_;
+  std::atomic<int> num_process_calls_{0};
+};
+
+class FakeNetworkControllerFactory : public NetworkControllerFactoryInterface {
+ public:
+  explicit FakeNetworkControllerFactory(TimeDelta process_interval)
+      : process_interval_(process_interval) {}
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    auto controller = std::make_unique<FakeNetworkController>(&processed_);
+    last_controller_ = controller.get();
+    return controller;
+  }
+  TimeDelta GetProcessInterval() const override { return process_interval_; }
+
+  rtc::Event* processed() { return &processed_; }
+  FakeNetworkController* last_controller() const { return last_controller_; }
+
+ private:
+  const TimeDelta process_interval_;
+  rtc::Event processed_;
+  FakeNetworkController* last_controller_ = nullptr;
+};
+
+}  // namespace
+
+TEST(BatchedProcessNetworkControllerFactoryTest, ReportsInfiniteInterval) {
+  TaskQueueForTest task_queue("batched_process");
+  BatchedProcessNetworkControllerFactory factory(
+      std::make_unique<FakeNetworkControllerFactory>(TimeDelta::ms(25)),
+      &task_queue, Clock::GetRealTimeClock());
+  EXPECT_TRUE(factory.GetProcessInterval().IsPlusInfinity());
+}
+
+TEST(BatchedProcessNetworkControllerFactoryTest, ProcessesAllControllers) {
+  TaskQueueForTest task_queue("batched_process");
+  auto inner_factory =
+      std::make_unique<FakeNetworkControllerFactory>(TimeDelta::ms(5));
+  FakeNetworkControllerFactory* fake_factory = inner_factory.get();
+  BatchedProcessNetworkControllerFactory factory(
+      std::move(inner_factory), &task_queue, Clock::GetRealTimeClock());
+
+  std::unique_ptr<NetworkControllerInterface> first =
+      factory.Create(NetworkControllerConfig());
+  FakeNetworkController* fake_first = fake_factory->last_controller();
+  std::unique_ptr<NetworkControllerInterface> second =
+      factory.Create(NetworkControllerConfig());
+  FakeNetworkController* fake_second = fake_factory->last_controller();
+  EXPECT_EQ(2u, factory.num_controllers());
+
+  ASSERT_TRUE(fake_factory->processed()->Wait(kTimeoutMs));
+  // Both controllers are processed in the same batch, so the second one has
+  // been reached as well once the batch has finished.
+  task_queue.SendTask([] {});
+  EXPECT_GE(fake_first->num_process_calls(), kMinProcessCalls);
+  EXPECT_GE(fake_second->num_process_calls(), kMinProcessCalls);
+
+  // The result of the batched processing is returned by the next call.
+  NetworkControlUpdate update = first->OnSentPacket(SentPacket());
+  EXPECT_TRUE(update.target_rate.has_value());
+
+  first.reset();
+  second.reset();
+  EXPECT_EQ(0u, factory.num_controllers());
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -16,6 +16,12 @@
 
 namespace webrtc {
 
+namespace {
+// The process interval lets the controller track the pacer queue, which is
+// used for app limited detection and for postponing PROBE_RTT.
+constexpr int64_t kProcessIntervalMs = 25;
+}  // namespace
+
 BbrNetworkControllerFactory::BbrNetworkControllerFactory() {}
 
 std::unique_ptr<NetworkControllerInterface> BbrNetworkControllerFactory::Create(
@@ -24,7 +30,7 @@ std::unique_ptr<NetworkControllerInterface> BbrNetworkControllerFactory::Create(
 }
 
 TimeDelta BbrNetworkControllerFactory::GetProcessInterval() const {
-  return TimeDelta::PlusInfinity();
+  return TimeDelta::ms(kProcessIntervalMs);
 }
 
 }  // namespace webrtc
@@ -61,6 +61,9 @@ const BbrRoundTripCount kBandwidthWindowSize = kGainCycleLength + 2;
 constexpr int64_t kMinRttExpirySeconds = 10;
 // The minimum time the connection can spend in PROBE_RTT mode.
 constexpr int64_t kProbeRttTimeMs = 200;
+// The maximum time PROBE_RTT is postponed while the pacer queue is too large
+// to be sent during PROBE_RTT.
+constexpr int64_t kMaxProbeRttPostponementMs = 1000;
 // If the bandwidth does not increase by the factor of |kStartupGrowthTarget|
 // within |kRoundTripsWithoutGrowthBeforeExitingStartup| rounds, the connection
 // will exit the STARTUP mode.
@@ -119,9 +122,13 @@ BbrNetworkController::BbrControllerConfig::BbrControllerConfig(
       probe_rtt_skipped_if_similar_rtt("probe_rtt_skipped_if_similar_rtt",
                                        false),
       probe_rtt_disabled_if_app_limited("probe_rtt_disabled_if_app_limited",
-                                        false) {
+                                        false),
+      app_limited_from_pacer("app_limited_from_pacer", true),
+      probe_rtt_postponed_by_pacer_queue("probe_rtt_postponed_by_pacer_queue",
+                                         true) {
   ParseFieldTrial(
       {
+          &app_limited_from_pacer,
           &exit_startup_on_loss,
           &encoder_rate_gain,
           &encoder_rate_gain_in_probe_rtt,
@@ -139,6 +146,7 @@ BbrNetworkController::BbrControllerConfig::BbrControllerConfig(
           &probe_rtt_based_on_bdp,
           &probe_rtt_congestion_window_gain,
           &probe_rtt_disabled_if_app_limited,
+          &probe_rtt_postponed_by_pacer_queue,
           &probe_rtt_skipped_if_similar_rtt,
           &rate_based_recovery,
           &rate_based_startup,
@@ -214,7 +222,9 @@ BbrNetworkController::BbrNetworkController(NetworkControllerConfig config)
       end_recovery_at_(),
       recovery_window_(max_congestion_window_),
       app_limited_since_last_probe_rtt_(false),
-      min_rtt_since_last_probe_rtt_(TimeDelta::PlusInfinity()) {
+      min_rtt_since_last_probe_rtt_(TimeDelta::PlusInfinity()),
+      data_in_flight_(DataSize::Zero()),
+      pacer_queue_(DataSize::Zero()) {
   RTC_LOG(LS_INFO) << "Creating BBR controller";
   if (config.constraints.starting_rate)
     default_bandwidth_ = *config.constraints.starting_rate;
@@ -318,6 +328,13 @@ NetworkControlUpdate BbrNetworkController::OnNetworkRouteChange(
 
 NetworkControlUpdate BbrNetworkController::OnProcessInterval(
     ProcessInterval msg) {
+  if (msg.pacer_queue) {
+    pacer_queue_ = *msg.pacer_queue;
+    // With nothing left to send in the pacer, the sending rate is limited by
+    // the application rather than by the network.
+    if (config_.app_limited_from_pacer && pacer_queue_.IsZero())
+      OnApplicationLimited(data_in_flight_);
+  }
   return CreateRateUpdate(msg.at_time);
 }
 
@@ -337,6 +354,7 @@ bool BbrNetworkController::InSlowStart() const {
 
 NetworkControlUpdate BbrNetworkController::OnSentPacket(SentPacket msg) {
   last_sent_packet_ = msg.sequence_number;
+  data_in_flight_ = msg.data_in_flight;
 
   if (msg.data_in_flight.IsZero() && sampler_->is_app_limited()) {
     exiting_quiescence_ = true;
@@ -401,6 +419,7 @@ NetworkControlUpdate BbrNetworkController::OnTransportPacketsFeedback(
   if (msg.packet_feedbacks.empty())
     return NetworkControlUpdate();
 
+  data_in_flight_ = msg.data_in_flight;
   Timestamp feedback_recv_time = msg.feedback_time;
   SentPacket last_sent_packet = msg.PacketsWithFeedback().back().sent_packet;
 
@@ -601,6 +620,11 @@ bool BbrNetworkController::UpdateBandwidthAndMinRtt(
   // Do not expire min_rtt if none was ever available.
   bool min_rtt_expired =
       !min_rtt_.IsZero() && (now > (min_rtt_timestamp_ + kMinRttExpiry));
+  if (min_rtt_expired && ShouldPostponeProbeRtt(now)) {
+    // Keep the expired min_rtt, the expiry is checked again on the next
+    // feedback.
+    min_rtt_expired = false;
+  }
 
   if (min_rtt_expired || sample_rtt < min_rtt_ || min_rtt_.IsZero()) {
     if (ShouldExtendMinRttExpiry()) {
@@ -636,6 +660,16 @@ bool BbrNetworkController::ShouldExtendMinRttExpiry() const {
   return false;
 }
 
+bool BbrNetworkController::ShouldPostponeProbeRtt(Timestamp now) const {
+  if (!config_.probe_rtt_postponed_by_pacer_queue)
+    return false;
+  const TimeDelta kMaxPostponedExpiry =
+      TimeDelta::seconds(kMinRttExpirySeconds) +
+      TimeDelta::ms(kMaxProbeRttPostponementMs);
+  return now <= min_rtt_timestamp_ + kMaxPostponedExpiry &&
+         pacer_queue_ > ProbeRttCongestionWindow();
+}
+
 void BbrNetworkController::UpdateGainCyclePhase(Timestamp now,
                                                 DataSize prior_in_flight,
                                                 bool has_losses) {
@@ -944,11 +978,14 @@ void BbrNetworkController::OnApplicationLimited(DataSize bytes_in_flight) {
   }
 
   app_limited_since_last_probe_rtt_ = true;
+  const bool was_app_limited = sampler_->is_app_limited();
   sampler_->OnAppLimited();
 
-  RTC_LOG(LS_INFO) << "Becoming application limited. Last sent packet: "
-                   << last_sent_packet_
-                   << ", CWND: " << ToString(GetCongestionWindow());
+  if (!was_app_limited) {
+    RTC_LOG(LS_INFO) << "Becoming application limited. Last sent packet: "
+                     << last_sent_packet_
+                     << ", CWND: " << ToString(GetCongestionWindow());
+  }
 }
 }  // namespace bbr
 }  // namespace webrtc
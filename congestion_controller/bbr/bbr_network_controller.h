@@ -112,6 +112,13 @@ class BbrNetworkController : public NetworkControllerInterface {
     // If true, disable PROBE_RTT entirely as long as the connection was
     // recently app limited.
     FieldTrialParameter<bool> probe_rtt_disabled_if_app_limited;
+    // If true, the connection is marked as app limited whenever the pacer
+    // reports an empty queue while the congestion window is not full.
+    FieldTrialParameter<bool> app_limited_from_pacer;
+    // If true, PROBE_RTT is postponed while the pacer queue holds more data
+    // than the PROBE_RTT congestion window allows in flight, e.g. a key frame,
+    // for at most one second.
+    FieldTrialParameter<bool> probe_rtt_postponed_by_pacer_queue;
 
     explicit BbrControllerConfig(std::string field_trial);
     ~BbrControllerConfig();
@@ -216,6 +223,9 @@ class BbrNetworkController : public NetworkControllerInterface {
   // Returns true if the current min_rtt should be kept and we should not enter
   // PROBE_RTT immediately.
   bool ShouldExtendMinRttExpiry() const;
+  // Returns true if the expired min_rtt should be kept for now because
+  // entering PROBE_RTT would stall the data queued in the pacer.
+  bool ShouldPostponeProbeRtt(Timestamp now) const;
 
   // Enters the STARTUP mode.
   void EnterStartupMode();
@@ -383,6 +393,11 @@ class BbrNetworkController : public NetworkControllerInterface {
   bool app_limited_since_last_probe_rtt_;
   TimeDelta min_rtt_since_last_probe_rtt_;
 
+  // The latest data in flight and pacer queue size reported to the
+  // controller.
+  DataSize data_in_flight_;
+  DataSize pacer_queue_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(BbrNetworkController);
 };
 
@@ -12,11 +12,14 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 
+#include "api/transport/goog_cc_factory.h"
 #include "modules/congestion_controller/bbr/bbr_factory.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/scenario/scenario.h"
+#include "test/testsupport/perf_test.h"
 
 using ::testing::_;
 using ::testing::AllOf;
@@ -63,6 +66,44 @@ ProcessInterval InitialProcessInterval() {
   return process_interval;
 }
 
+SentPacket CreateSentPacket(Timestamp send_time, int64_t sequence_number) {
+  SentPacket sent_packet;
+  sent_packet.send_time = send_time;
+  sent_packet.sequence_number = sequence_number;
+  sent_packet.size = DataSize::bytes(1200);
+  sent_packet.data_in_flight = sent_packet.size;
+  return sent_packet;
+}
+
+// Runs a video call over a link with a high bandwidth-delay product, such as
+// a geostationary satellite link, and returns the final send bandwidth.
+DataRate RunHighBdpCall(NetworkControllerFactoryInterface* factory,
+                        std::string name,
+                        DataRate link_capacity) {
+  Scenario s("bbr_unit/high_bdp_" + name, false);
+  CallClientConfig config;
+  config.transport.cc_factory = factory;
+  config.transport.rates.min_rate = DataRate::kbps(30);
+  config.transport.rates.max_rate = link_capacity * 2;
+  config.transport.rates.start_rate = DataRate::kbps(300);
+  auto send_net = s.CreateSimulationNode([&](NetworkSimulationConfig* c) {
+    c->bandwidth = link_capacity;
+    c->delay = TimeDelta::ms(300);
+  });
+  auto ret_net = s.CreateSimulationNode(
+      [](NetworkSimulationConfig* c) { c->delay = TimeDelta::ms(300); });
+  auto* client = s.CreateClient("send", config);
+  auto routes = s.CreateRoutes(client, {send_net},
+                               s.CreateClient("recv", CallClientConfig()),
+                               {ret_net});
+  VideoStreamConfig video;
+  video.source.generator.width = 1280;
+  video.source.generator.height = 720;
+  s.CreateVideoStream(routes->forward(), video);
+  s.RunFor(TimeDelta::seconds(60));
+  return client->send_bandwidth();
+}
+
 NetworkRouteChange CreateRouteChange(Timestamp at_time,
                                      DataRate start_rate,
                                      DataRate min_rate = DataRate::Zero(),
@@ -114,6 +155,26 @@ TEST_F(BbrNetworkControllerTest, SendsConfigurationOnNetworkRouteChanged) {
   EXPECT_TRUE(update.congestion_window.has_value());
 }
 
+TEST_F(BbrNetworkControllerTest, MarksAppLimitedWhenPacerQueueIsEmpty) {
+  bbr::BbrNetworkController controller(InitialConfig());
+  controller.OnProcessInterval(InitialProcessInterval());
+  controller.OnSentPacket(CreateSentPacket(kDefaultStartTime, 1));
+  EXPECT_EQ(0, bbr::BbrNetworkController::DebugState(controller)
+                   .end_of_app_limited_phase);
+
+  ProcessInterval process_interval;
+  process_interval.at_time = kDefaultStartTime + TimeDelta::ms(25);
+  process_interval.pacer_queue = DataSize::bytes(5000);
+  controller.OnProcessInterval(process_interval);
+  EXPECT_EQ(0, bbr::BbrNetworkController::DebugState(controller)
+                   .end_of_app_limited_phase);
+
+  process_interval.pacer_queue = DataSize::Zero();
+  controller.OnProcessInterval(process_interval);
+  EXPECT_EQ(1, bbr::BbrNetworkController::DebugState(controller)
+                   .end_of_app_limited_phase);
+}
+
 // Bandwidth estimation is updated when feedbacks are received.
 // Feedbacks which show an increasing delay cause the estimation to be reduced.
 TEST_F(BbrNetworkControllerTest, UpdatesTargetSendRate) {
@@ -159,5 +220,19 @@ TEST_F(BbrNetworkControllerTest, UpdatesTargetSendRate) {
   EXPECT_NEAR(client->send_bandwidth().kbps(), 200, 40);
 }
 
+TEST_F(BbrNetworkControllerTest, HighBdpThroughputComparedToGoogCc) {
+  const DataRate kLinkCapacity = DataRate::kbps(2000);
+  BbrNetworkControllerFactory bbr_factory;
+  GoogCcNetworkControllerFactory goog_cc_factory;
+  DataRate bbr_rate = RunHighBdpCall(&bbr_factory, "bbr", kLinkCapacity);
+  DataRate goog_cc_rate =
+      RunHighBdpCall(&goog_cc_factory, "goog_cc", kLinkCapacity);
+  PrintResult("high_bdp_send_bandwidth", "", "bbr", bbr_rate.kbps(), "kbps",
+              false);
+  PrintResult("high_bdp_send_bandwidth", "", "goog_cc", goog_cc_rate.kbps(),
+              "kbps", false);
+  EXPECT_GT(bbr_rate, kLinkCapacity * 0.5);
+}
+
 }  // namespace test
 }  // namespace webrtc
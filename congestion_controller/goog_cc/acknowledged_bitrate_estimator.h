@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/transport/network_types.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "api/units/data_rate.h"
@@ -32,8 +33,9 @@ class AcknowledgedBitrateEstimator {
       const WebRtcKeyValueConfig* key_value_config);
   ~AcknowledgedBitrateEstimator();
 
+  // |packet_feedback_vector| must be sorted by receive time.
   void IncomingPacketFeedbackVector(
-      const std::vector<PacketResult>& packet_feedback_vector);
+      rtc::ArrayView<const PacketResult> packet_feedback_vector);
   absl::optional<DataRate> bitrate() const;
   absl::optional<DataRate> PeekRate() const;
   void SetAlr(bool in_alr);
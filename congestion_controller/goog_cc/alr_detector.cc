@@ -24,6 +24,10 @@
 namespace webrtc {
 
 namespace {
+// Send rates for the ALR window are measured over intervals of at least this
+// length, which smooths out the bursts produced by the pacer.
+constexpr int64_t kSendRateIntervalMs = 20;
+
 AlrDetectorConfig GetConfigFromTrials(
     const WebRtcKeyValueConfig* key_value_config) {
   RTC_CHECK(AlrExperimentSettings::MaxOneFieldTrialEnabled(*key_value_config));
@@ -55,11 +59,15 @@ std::unique_ptr<StructParametersParser> AlrDetectorConfig::Parser() {
   return StructParametersParser::Create(   //
       "bw_usage", &bandwidth_usage_ratio,  //
       "start", &start_budget_level_ratio,  //
-      "stop", &stop_budget_level_ratio);
+      "stop", &stop_budget_level_ratio,    //
+      "rate_window", &send_rate_window_ms);
 }
 
 AlrDetector::AlrDetector(AlrDetectorConfig config, RtcEventLog* event_log)
-    : conf_(config), alr_budget_(0, true), event_log_(event_log) {}
+    : conf_(config),
+      alr_budget_(0, true),
+      max_send_rate_bps_(conf_.send_rate_window_ms, 0, 0),
+      event_log_(event_log) {}
 
 AlrDetector::AlrDetector(const WebRtcKeyValueConfig* key_value_config)
     : AlrDetector(GetConfigFromTrials(key_value_config), nullptr) {}
@@ -72,6 +80,8 @@ AlrDetector::~AlrDetector() {}
 void AlrDetector::OnBytesSent(size_t bytes_sent, int64_t send_time_ms) {
   if (!last_send_time_ms_.has_value()) {
     last_send_time_ms_ = send_time_ms;
+    first_send_time_ms_ = send_time_ms;
+    rate_interval_start_ms_ = send_time_ms;
     // Since the duration for sending the bytes is unknwon, return without
     // updating alr state.
     return;
@@ -79,26 +89,58 @@ void AlrDetector::OnBytesSent(size_t bytes_sent, int64_t send_time_ms) {
   int64_t delta_time_ms = send_time_ms - *last_send_time_ms_;
   last_send_time_ms_ = send_time_ms;
 
+  bool state_changed = uses_send_rate_window()
+                           ? UpdateSendRateWindow(bytes_sent, send_time_ms)
+                           : UpdateBudget(bytes_sent, delta_time_ms);
+  if (event_log_ && state_changed) {
+    event_log_->Log(
+        std::make_unique<RtcEventAlrState>(alr_started_time_ms_.has_value()));
+  }
+}
+
+bool AlrDetector::UpdateBudget(size_t bytes_sent, int64_t delta_time_ms) {
   alr_budget_.UseBudget(bytes_sent);
   alr_budget_.IncreaseBudget(delta_time_ms);
-  bool state_changed = false;
   if (alr_budget_.budget_ratio() > conf_.start_budget_level_ratio &&
       !alr_started_time_ms_) {
     alr_started_time_ms_.emplace(rtc::TimeMillis());
-    state_changed = true;
+    return true;
   } else if (alr_budget_.budget_ratio() < conf_.stop_budget_level_ratio &&
              alr_started_time_ms_) {
-    state_changed = true;
     alr_started_time_ms_.reset();
+    return true;
   }
-  if (event_log_ && state_changed) {
-    event_log_->Log(
-        std::make_unique<RtcEventAlrState>(alr_started_time_ms_.has_value()));
+  return false;
+}
+
+bool AlrDetector::UpdateSendRateWindow(size_t bytes_sent,
+                                       int64_t send_time_ms) {
+  rate_interval_bytes_ += bytes_sent;
+  const int64_t interval_ms = send_time_ms - rate_interval_start_ms_;
+  if (interval_ms < kSendRateIntervalMs)
+    return false;
+  const int64_t send_rate_bps = rate_interval_bytes_ * 8000 / interval_ms;
+  rate_interval_start_ms_ = send_time_ms;
+  rate_interval_bytes_ = 0;
+  max_send_rate_bps_.Update(send_rate_bps, send_time_ms);
+
+  const double usage_threshold_bps =
+      estimated_bitrate_bps_ * conf_.bandwidth_usage_ratio;
+  if (!alr_started_time_ms_ &&
+      send_time_ms - *first_send_time_ms_ >= conf_.send_rate_window_ms &&
+      max_send_rate_bps_.GetBest() < usage_threshold_bps) {
+    alr_started_time_ms_.emplace(rtc::TimeMillis());
+    return true;
+  } else if (alr_started_time_ms_ && send_rate_bps > usage_threshold_bps) {
+    alr_started_time_ms_.reset();
+    return true;
   }
+  return false;
 }
 
 void AlrDetector::SetEstimatedBitrate(int bitrate_bps) {
   RTC_DCHECK(bitrate_bps);
+  estimated_bitrate_bps_ = bitrate_bps;
   int target_rate_kbps =
       static_cast<double>(bitrate_bps) * conf_.bandwidth_usage_ratio / 1000;
   alr_budget_.set_target_rate_kbps(target_rate_kbps);
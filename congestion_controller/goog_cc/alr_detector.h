@@ -17,6 +17,7 @@
 
 #include "absl/types/optional.h"
 #include "api/transport/webrtc_key_value_config.h"
+#include "modules/congestion_controller/bbr/windowed_filter.h"
 #include "modules/pacing/interval_budget.h"
 #include "rtc_base/experiments/alr_experiment.h"
 #include "rtc_base/experiments/struct_parameters_parser.h"
@@ -34,6 +35,11 @@ struct AlrDetectorConfig {
   double bandwidth_usage_ratio = 0.65;
   double start_budget_level_ratio = 0.80;
   double stop_budget_level_ratio = 0.50;
+  // If positive, ALR is instead detected from the maximum send rate over a
+  // sliding window of this length. ALR starts when the maximum rate over the
+  // window is below |bandwidth_usage_ratio| of the estimate and ends as soon
+  // as the most recent send rate is above it.
+  int send_rate_window_ms = 0;
   std::unique_ptr<StructParametersParser> Parser();
 };
 // Application limited region detector is a class that utilizes signals of
@@ -63,8 +69,21 @@ class AlrDetector {
   void UpdateBudgetWithElapsedTime(int64_t delta_time_ms);
   void UpdateBudgetWithBytesSent(size_t bytes_sent);
 
+  // True if ALR is detected from the windowed send rate, in which case the
+  // state reacts quickly enough for callers to act on every change.
+  bool uses_send_rate_window() const { return conf_.send_rate_window_ms > 0; }
+
  private:
   friend class GoogCcStatePrinter;
+  using MaxSendRateFilter = bbr::WindowedFilter<int64_t,
+                                                bbr::MaxFilter<int64_t>,
+                                                int64_t,
+                                                int64_t>;
+
+  // Returns true if the ALR state changed.
+  bool UpdateBudget(size_t bytes_sent, int64_t delta_time_ms);
+  bool UpdateSendRateWindow(size_t bytes_sent, int64_t send_time_ms);
+
   const AlrDetectorConfig conf_;
 
   absl::optional<int64_t> last_send_time_ms_;
@@ -72,6 +91,13 @@ class AlrDetector {
   IntervalBudget alr_budget_;
   absl::optional<int64_t> alr_started_time_ms_;
 
+  // Used when ALR is detected from the windowed send rate.
+  int64_t estimated_bitrate_bps_ = 0;
+  MaxSendRateFilter max_send_rate_bps_;
+  absl::optional<int64_t> first_send_time_ms_;
+  int64_t rate_interval_start_ms_ = 0;
+  size_t rate_interval_bytes_ = 0;
+
   RtcEventLog* event_log_;
 };
 }  // namespace webrtc
@@ -152,6 +152,45 @@ TEST(AlrDetectorTest, BandwidthEstimateChanges) {
   EXPECT_FALSE(alr_detector.GetApplicationLimitedRegionStartTime());
 }
 
+TEST(AlrDetectorTest, SendRateWindowDetection) {
+  AlrDetectorConfig config;
+  config.send_rate_window_ms = 200;
+  AlrDetector alr_detector(config, nullptr);
+  EXPECT_TRUE(alr_detector.uses_send_rate_window());
+  int64_t timestamp_ms = 1000;
+  alr_detector.SetEstimatedBitrate(kEstimatedBitrateBps);
+
+  // Stay in non-ALR state when usage is close to 100%.
+  SimulateOutgoingTrafficIn(&alr_detector, &timestamp_ms)
+      .ForTimeMs(1000)
+      .AtPercentOfEstimatedBitrate(90);
+  EXPECT_FALSE(alr_detector.GetApplicationLimitedRegionStartTime());
+
+  // ALR does not start before a full window at low usage has passed.
+  SimulateOutgoingTrafficIn(&alr_detector, &timestamp_ms)
+      .ForTimeMs(100)
+      .AtPercentOfEstimatedBitrate(20);
+  EXPECT_FALSE(alr_detector.GetApplicationLimitedRegionStartTime());
+  SimulateOutgoingTrafficIn(&alr_detector, &timestamp_ms)
+      .ForTimeMs(200)
+      .AtPercentOfEstimatedBitrate(20);
+  EXPECT_TRUE(alr_detector.GetApplicationLimitedRegionStartTime());
+
+  // ALR ends as soon as the send rate is above 65% again.
+  SimulateOutgoingTrafficIn(&alr_detector, &timestamp_ms)
+      .ForTimeMs(50)
+      .AtPercentOfEstimatedBitrate(100);
+  EXPECT_FALSE(alr_detector.GetApplicationLimitedRegionStartTime());
+}
+
+TEST(AlrDetectorTest, ParseSendRateWindowFieldTrial) {
+  webrtc::test::ScopedFieldTrials scoped_field_trial(
+      "WebRTC-AlrDetectorParameters/rate_window:100/");
+  FieldTrialBasedConfig field_trials;
+  AlrDetector alr_detector(&field_trials);
+  EXPECT_TRUE(alr_detector.uses_send_rate_window());
+}
+
 TEST(AlrDetectorTest, ParseControlFieldTrial) {
   webrtc::test::ScopedFieldTrials scoped_field_trial(
       "WebRTC-ProbingScreenshareBwe/Control/");
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_BOUNDED_DEQUE_H_
+#define MODULES_CONGESTION_CONTROLLER_GOOG_CC_BOUNDED_DEQUE_H_
+
+#include <stddef.h>
+
+#include <array>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// A double ended queue holding at most |N| elements in inline storage, so
+// that pushing and popping never allocates. Intended for the short sliding
+// windows kept by the estimators, which are updated for every feedback
+// report. |T| must be default constructible; popped slots keep their old
+// value until overwritten.
+template <typename T, size_t N>
+class BoundedDeque {
+ public:
+  static_assert(N > 0, "BoundedDeque needs a non zero capacity.");
+
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == N; }
+  size_t size() const { return size_; }
+  static constexpr size_t capacity() { return N; }
+
+  void clear() {
+    begin_ = 0;
+    size_ = 0;
+  }
+
+  void push_back(const T& value) {
+    RTC_DCHECK(!full());
+    elements_[(begin_ + size_) % N] = value;
+    ++size_;
+  }
+  void pop_front() {
+    RTC_DCHECK(!empty());
+    begin_ = (begin_ + 1) % N;
+    --size_;
+  }
+  void pop_back() {
+    RTC_DCHECK(!empty());
+    --size_;
+  }
+
+  const T& front() const {
+    RTC_DCHECK(!empty());
+    return elements_[begin_];
+  }
+  const T& back() const {
+    RTC_DCHECK(!empty());
+    return elements_[(begin_ + size_ - 1) % N];
+  }
+  // |index| counts from the front.
+  const T& operator[](size_t index) const {
+    RTC_DCHECK_LT(index, size_);
+    return elements_[(begin_ + index) % N];
+  }
+
+ private:
+  std::array<T, N> elements_{};
+  size_t begin_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_GOOG_CC_BOUNDED_DEQUE_H_
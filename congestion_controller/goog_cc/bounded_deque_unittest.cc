@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/goog_cc/bounded_deque.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(BoundedDequeTest, PushAndPopAtBothEnds) {
+  BoundedDeque<int, 4> deque;
+  EXPECT_TRUE(deque.empty());
+  deque.push_back(1);
+  deque.push_back(2);
+  deque.push_back(3);
+  EXPECT_EQ(3u, deque.size());
+  EXPECT_EQ(1, deque.front());
+  EXPECT_EQ(3, deque.back());
+
+  deque.pop_front();
+  deque.pop_back();
+  EXPECT_EQ(1u, deque.size());
+  EXPECT_EQ(2, deque.front());
+  EXPECT_EQ(2, deque.back());
+}
+
+TEST(BoundedDequeTest, WrapsAroundItsStorage) {
+  BoundedDeque<int, 3> deque;
+  for (int i = 0; i < 10; ++i) {
+    if (deque.full())
+      deque.pop_front();
+    deque.push_back(i);
+  }
+  ASSERT_EQ(3u, deque.size());
+  EXPECT_EQ(7, deque[0]);
+  EXPECT_EQ(8, deque[1]);
+  EXPECT_EQ(9, deque[2]);
+  EXPECT_EQ(7, deque.front());
+  EXPECT_EQ(9, deque.back());
+}
+
+TEST(BoundedDequeTest, ClearEmptiesTheDeque) {
+  BoundedDeque<int, 2> deque;
+  deque.push_back(1);
+  deque.push_back(2);
+  EXPECT_TRUE(deque.full());
+  deque.clear();
+  EXPECT_TRUE(deque.empty());
+  deque.push_back(3);
+  EXPECT_EQ(3, deque.front());
+}
+
+}  // namespace webrtc
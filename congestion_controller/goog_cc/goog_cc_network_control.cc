@@ -16,11 +16,11 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
-#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/units/time_delta.h"
 #include "logging/rtc_event_log/events/rtc_event_remote_estimate.h"
 #include "modules/congestion_controller/goog_cc/acknowledged_bitrate_estimator.h"
@@ -240,8 +240,20 @@ NetworkControlUpdate GoogCcNetworkController::OnSentPacket(
     SentPacket sent_packet) {
   alr_detector_->OnBytesSent(sent_packet.size.bytes(),
                              sent_packet.send_time.ms());
-  acknowledged_bitrate_estimator_->SetAlr(
-      alr_detector_->GetApplicationLimitedRegionStartTime().has_value());
+  absl::optional<int64_t> alr_start_time =
+      alr_detector_->GetApplicationLimitedRegionStartTime();
+  acknowledged_bitrate_estimator_->SetAlr(alr_start_time.has_value());
+  if (alr_detector_->uses_send_rate_window() &&
+      previously_in_alr_ != alr_start_time.has_value()) {
+    // Act on the change right away rather than on the next feedback or
+    // process interval.
+    probe_controller_->SetAlrStartTimeMs(alr_start_time);
+    if (previously_in_alr_) {
+      acknowledged_bitrate_estimator_->SetAlrEndedTime(sent_packet.send_time);
+      probe_controller_->SetAlrEndedTimeMs(sent_packet.send_time.ms());
+    }
+    previously_in_alr_ = alr_start_time.has_value();
+  }
 
   if (!first_packet_sent_) {
     first_packet_sent_ = true;
@@ -371,8 +383,11 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportLossReport(
 
 void GoogCcNetworkController::UpdateCongestionWindowSize(
     TimeDelta time_since_last_packet) {
-  TimeDelta min_feedback_max_rtt = TimeDelta::ms(
-      *std::min_element(feedback_max_rtts_.begin(), feedback_max_rtts_.end()));
+  int64_t min_feedback_max_rtt_ms = feedback_max_rtts_.front();
+  for (size_t i = 1; i < feedback_max_rtts_.size(); ++i)
+    min_feedback_max_rtt_ms =
+        std::min(min_feedback_max_rtt_ms, feedback_max_rtts_[i]);
+  TimeDelta min_feedback_max_rtt = TimeDelta::ms(min_feedback_max_rtt_ms);
 
   const DataSize kMinCwnd = DataSize::bytes(2 * 1500);
   TimeDelta time_window =
@@ -410,9 +425,20 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
   TimeDelta min_propagation_rtt = TimeDelta::PlusInfinity();
   Timestamp max_recv_time = Timestamp::MinusInfinity();
 
-  std::vector<PacketResult> feedbacks = report.ReceivedWithSendInfo();
-  for (const auto& feedback : feedbacks)
-    max_recv_time = std::max(max_recv_time, feedback.receive_time);
+  // Same as report.SortedByReceiveTime(), without a new allocation per report.
+  sorted_received_packets_.clear();
+  for (const PacketResult& feedback : report.packet_feedbacks) {
+    if (feedback.receive_time.IsFinite())
+      sorted_received_packets_.push_back(feedback);
+  }
+  std::sort(sorted_received_packets_.begin(), sorted_received_packets_.end(),
+            PacketResult::ReceiveTimeOrder());
+  rtc::ArrayView<const PacketResult> feedbacks(sorted_received_packets_);
+  // Every packet that did not make it into the received list was lost.
+  const int lost_packets = static_cast<int>(report.packet_feedbacks.size() -
+                                            sorted_received_packets_.size());
+  if (!feedbacks.empty())
+    max_recv_time = feedbacks.back().receive_time;
 
   for (const auto& feedback : feedbacks) {
     TimeDelta feedback_rtt =
@@ -424,18 +450,18 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
   }
 
   if (max_feedback_rtt.IsFinite()) {
-    feedback_max_rtts_.push_back(max_feedback_rtt.ms());
-    const size_t kMaxFeedbackRttWindow = 32;
-    if (feedback_max_rtts_.size() > kMaxFeedbackRttWindow)
+    if (feedback_max_rtts_.full())
       feedback_max_rtts_.pop_front();
+    feedback_max_rtts_.push_back(max_feedback_rtt.ms());
     // TODO(srte): Use time since last unacknowledged packet.
     bandwidth_estimation_->UpdatePropagationRtt(report.feedback_time,
                                                 min_propagation_rtt);
   }
   if (packet_feedback_only_) {
     if (!feedback_max_rtts_.empty()) {
-      int64_t sum_rtt_ms = std::accumulate(feedback_max_rtts_.begin(),
-                                           feedback_max_rtts_.end(), 0);
+      int64_t sum_rtt_ms = 0;
+      for (size_t i = 0; i < feedback_max_rtts_.size(); ++i)
+        sum_rtt_ms += feedback_max_rtts_[i];
       int64_t mean_rtt_ms = sum_rtt_ms / feedback_max_rtts_.size();
       if (delay_based_bwe_)
         delay_based_bwe_->OnRttUpdate(TimeDelta::ms(mean_rtt_ms));
@@ -453,12 +479,8 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
       bandwidth_estimation_->UpdateRtt(feedback_min_rtt, report.feedback_time);
     }
 
-    expected_packets_since_last_loss_update_ +=
-        report.PacketsWithFeedback().size();
-    for (const auto& packet_feedback : report.PacketsWithFeedback()) {
-      if (packet_feedback.receive_time.IsInfinite())
-        lost_packets_since_last_loss_update_ += 1;
-    }
+    expected_packets_since_last_loss_update_ += report.packet_feedbacks.size();
+    lost_packets_since_last_loss_update_ += lost_packets;
     if (report.feedback_time > next_loss_update_) {
       next_loss_update_ = report.feedback_time + kLossUpdateInterval;
       bandwidth_estimation_->UpdatePacketsLost(
@@ -477,10 +499,9 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     probe_controller_->SetAlrEndedTimeMs(now_ms);
   }
   previously_in_alr_ = alr_start_time.has_value();
-  acknowledged_bitrate_estimator_->IncomingPacketFeedbackVector(
-      report.SortedByReceiveTime());
+  acknowledged_bitrate_estimator_->IncomingPacketFeedbackVector(feedbacks);
   auto acknowledged_bitrate = acknowledged_bitrate_estimator_->bitrate();
-  for (const auto& feedback : report.SortedByReceiveTime()) {
+  for (const auto& feedback : feedbacks) {
     if (feedback.sent_packet.pacing_info.probe_cluster_id !=
         PacedPacketInfo::kNotAProbe) {
       probe_bitrate_estimator_->HandleProbeAndEstimateBitrate(feedback);
@@ -493,7 +514,9 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     acknowledged_bitrate = probe_bitrate_estimator_->last_estimate();
   bandwidth_estimation_->SetAcknowledgedRate(acknowledged_bitrate,
                                              report.feedback_time);
-  bandwidth_estimation_->IncomingPacketFeedbackVector(report);
+  bandwidth_estimation_->IncomingPacketFeedbackLoss(
+      lost_packets, static_cast<int>(report.packet_feedbacks.size()),
+      report.feedback_time);
 
   if (network_estimator_) {
     network_estimator_->OnTransportPacketsFeedback(report);
@@ -514,8 +537,8 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
 
   DelayBasedBwe::Result result;
   result = delay_based_bwe_->IncomingPacketFeedbackVector(
-      report, acknowledged_bitrate, probe_bitrate, estimate_,
-      alr_start_time.has_value());
+      feedbacks, report.feedback_time, acknowledged_bitrate, probe_bitrate,
+      estimate_, alr_start_time.has_value());
 
   if (result.updated) {
     if (result.probe) {
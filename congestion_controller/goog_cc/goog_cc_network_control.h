@@ -13,7 +13,6 @@
 
 #include <stdint.h>
 
-#include <deque>
 #include <memory>
 #include <vector>
 
@@ -29,6 +28,7 @@
 #include "api/units/timestamp.h"
 #include "modules/congestion_controller/goog_cc/acknowledged_bitrate_estimator.h"
 #include "modules/congestion_controller/goog_cc/alr_detector.h"
+#include "modules/congestion_controller/goog_cc/bounded_deque.h"
 #include "modules/congestion_controller/goog_cc/congestion_window_pushback_controller.h"
 #include "modules/congestion_controller/goog_cc/delay_based_bwe.h"
 #include "modules/congestion_controller/goog_cc/probe_controller.h"
@@ -116,7 +116,11 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   int lost_packets_since_last_loss_update_ = 0;
   int expected_packets_since_last_loss_update_ = 0;
 
-  std::deque<int64_t> feedback_max_rtts_;
+  static constexpr size_t kMaxFeedbackRttWindow = 32;
+  BoundedDeque<int64_t, kMaxFeedbackRttWindow> feedback_max_rtts_;
+  // The received packets of the feedback being processed, sorted by receive
+  // time. Kept as a member to reuse the allocation across feedback reports.
+  std::vector<PacketResult> sorted_received_packets_;
 
   DataRate last_loss_based_target_rate_;
   DataRate last_pushback_target_rate_;
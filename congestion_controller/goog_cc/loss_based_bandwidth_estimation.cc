@@ -117,17 +117,14 @@ LossBasedBandwidthEstimation::LossBasedBandwidthEstimation()
       last_loss_ratio_(0) {}
 
 void LossBasedBandwidthEstimation::UpdateLossStatistics(
-    const std::vector<PacketResult>& packet_results,
+    int lost_packets,
+    int total_packets,
     Timestamp at_time) {
-  if (packet_results.empty()) {
+  if (total_packets <= 0) {
     RTC_DCHECK(false);
     return;
   }
-  int loss_count = 0;
-  for (const auto& pkt : packet_results) {
-    loss_count += pkt.receive_time.IsInfinite() ? 1 : 0;
-  }
-  last_loss_ratio_ = static_cast<double>(loss_count) / packet_results.size();
+  last_loss_ratio_ = static_cast<double>(lost_packets) / total_packets;
   const TimeDelta time_passed = last_loss_packet_report_.IsFinite()
                                     ? at_time - last_loss_packet_report_
                                     : TimeDelta::seconds(1);
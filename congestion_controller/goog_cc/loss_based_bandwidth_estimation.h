@@ -55,7 +55,10 @@ class LossBasedBandwidthEstimation {
   void MaybeReset(DataRate bitrate);
   void SetInitialBitrate(DataRate bitrate);
   bool Enabled() const { return config_.enabled; }
-  void UpdateLossStatistics(const std::vector<PacketResult>& packet_results,
+  // Updates the loss statistics with |lost_packets| out of |total_packets|
+  // reported by one transport feedback.
+  void UpdateLossStatistics(int lost_packets,
+                            int total_packets,
                             Timestamp at_time);
   DataRate GetEstimate() const { return loss_based_bitrate_; }
 
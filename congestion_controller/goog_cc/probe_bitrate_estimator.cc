@@ -66,7 +66,7 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
 
   EraseOldClusters(packet_feedback.receive_time);
 
-  AggregatedCluster* cluster = &clusters_[cluster_id];
+  AggregatedCluster* cluster = FindOrCreateCluster(cluster_id);
 
   if (packet_feedback.sent_packet.send_time < cluster->first_send) {
     cluster->first_send = packet_feedback.sent_packet.send_time;
@@ -188,12 +188,30 @@ absl::optional<DataRate> ProbeBitrateEstimator::last_estimate() const {
 }
 
 void ProbeBitrateEstimator::EraseOldClusters(Timestamp timestamp) {
-  for (auto it = clusters_.begin(); it != clusters_.end();) {
-    if (it->second.last_receive + kMaxClusterHistory < timestamp) {
-      it = clusters_.erase(it);
-    } else {
-      ++it;
+  for (AggregatedCluster& cluster : clusters_) {
+    if (cluster.id != PacedPacketInfo::kNotAProbe &&
+        cluster.last_receive + kMaxClusterHistory < timestamp) {
+      cluster = AggregatedCluster();
     }
   }
 }
+
+ProbeBitrateEstimator::AggregatedCluster*
+ProbeBitrateEstimator::FindOrCreateCluster(int cluster_id) {
+  AggregatedCluster* replaced = &clusters_[0];
+  for (AggregatedCluster& cluster : clusters_) {
+    if (cluster.id == cluster_id) {
+      return &cluster;
+    }
+    // Prefer a free slot, otherwise the least recently received cluster.
+    if (replaced->id != PacedPacketInfo::kNotAProbe &&
+        (cluster.id == PacedPacketInfo::kNotAProbe ||
+         cluster.last_receive < replaced->last_receive)) {
+      replaced = &cluster;
+    }
+  }
+  *replaced = AggregatedCluster();
+  replaced->id = cluster_id;
+  return replaced;
+}
 }  // namespace webrtc
@@ -11,8 +11,10 @@
 #ifndef MODULES_CONGESTION_CONTROLLER_GOOG_CC_PROBE_BITRATE_ESTIMATOR_H_
 #define MODULES_CONGESTION_CONTROLLER_GOOG_CC_PROBE_BITRATE_ESTIMATOR_H_
 
+#include <stddef.h>
+
+#include <array>
 #include <limits>
-#include <map>
 
 #include "absl/types/optional.h"
 #include "api/transport/network_types.h"
@@ -37,6 +39,7 @@ class ProbeBitrateEstimator {
 
  private:
   struct AggregatedCluster {
+    int id = PacedPacketInfo::kNotAProbe;
     int num_probes = 0;
     Timestamp first_send = Timestamp::PlusInfinity();
     Timestamp last_send = Timestamp::MinusInfinity();
@@ -47,10 +50,17 @@ class ProbeBitrateEstimator {
     DataSize size_total = DataSize::Zero();
   };
 
+  // Probe clusters are short lived and only a few are in flight at a time, so
+  // a fixed number of slots is tracked. When a new cluster finds all of them
+  // in use, it replaces the least recently received one.
+  static constexpr size_t kMaxActiveClusters = 16;
+
   // Erases old cluster data that was seen before |timestamp|.
   void EraseOldClusters(Timestamp timestamp);
+  // Returns the aggregate of |cluster_id|, starting a new one if needed.
+  AggregatedCluster* FindOrCreateCluster(int cluster_id);
 
-  std::map<int, AggregatedCluster> clusters_;
+  std::array<AggregatedCluster, kMaxActiveClusters> clusters_;
   RtcEventLog* const event_log_;
   absl::optional<DataRate> estimated_data_rate_;
   absl::optional<DataRate> last_estimate_;
@@ -80,6 +80,16 @@ TEST_F(TestProbeBitrateEstimator, OneClusterTooFewBytes) {
   EXPECT_FALSE(measured_data_rate_);
 }
 
+TEST_F(TestProbeBitrateEstimator, MoreClustersThanTrackedAtOnce) {
+  for (int cluster_id = 0; cluster_id < 20; ++cluster_id)
+    AddPacketFeedback(cluster_id, 1000, 0, 10);
+  AddPacketFeedback(19, 1000, 10, 20);
+  AddPacketFeedback(19, 1000, 20, 30);
+  AddPacketFeedback(19, 1000, 30, 40);
+
+  EXPECT_NEAR(measured_data_rate_->bps(), 800000, 10);
+}
+
 TEST_F(TestProbeBitrateEstimator, SmallCluster) {
   const int kMinBytes = 1000;
   AddPacketFeedback(0, 150, 0, 10, kDefaultMinProbes, kMinBytes);
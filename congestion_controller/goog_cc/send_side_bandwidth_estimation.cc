@@ -331,11 +331,13 @@ void SendSideBandwidthEstimation::SetAcknowledgedRate(
   }
 }
 
-void SendSideBandwidthEstimation::IncomingPacketFeedbackVector(
-    const TransportPacketsFeedback& report) {
+void SendSideBandwidthEstimation::IncomingPacketFeedbackLoss(
+    int packets_lost,
+    int number_of_packets,
+    Timestamp at_time) {
   if (loss_based_bandwidth_estimation_.Enabled()) {
     loss_based_bandwidth_estimation_.UpdateLossStatistics(
-        report.packet_feedbacks, report.feedback_time);
+        packets_lost, number_of_packets, at_time);
   }
 }
 
@@ -447,10 +449,10 @@ void SendSideBandwidthEstimation::UpdateEstimate(Timestamp at_time) {
     if (new_bitrate != current_target_) {
       min_bitrate_history_.clear();
       if (loss_based_bandwidth_estimation_.Enabled()) {
-        min_bitrate_history_.push_back(std::make_pair(at_time, new_bitrate));
+        min_bitrate_history_.push_back(MinBitrateSample{at_time, new_bitrate});
       } else {
         min_bitrate_history_.push_back(
-            std::make_pair(at_time, current_target_));
+            MinBitrateSample{at_time, current_target_});
       }
       UpdateTargetBitrate(new_bitrate, at_time);
       return;
@@ -466,7 +468,7 @@ void SendSideBandwidthEstimation::UpdateEstimate(Timestamp at_time) {
 
   if (loss_based_bandwidth_estimation_.Enabled()) {
     loss_based_bandwidth_estimation_.Update(
-        at_time, min_bitrate_history_.front().second, last_round_trip_time_);
+        at_time, min_bitrate_history_.front().bitrate, last_round_trip_time_);
     DataRate new_bitrate = MaybeRampupOrBackoff(current_target_, at_time);
     UpdateTargetBitrate(new_bitrate, at_time);
     return;
@@ -490,8 +492,8 @@ void SendSideBandwidthEstimation::UpdateEstimate(Timestamp at_time) {
       //   If instead one would do: current_bitrate_ *= 1.08^(delta time),
       //   it would take over one second since the lower packet loss to achieve
       //   108kbps.
-      DataRate new_bitrate =
-          DataRate::bps(min_bitrate_history_.front().second.bps() * 1.08 + 0.5);
+      DataRate new_bitrate = DataRate::bps(
+          min_bitrate_history_.front().bitrate.bps() * 1.08 + 0.5);
 
       // Add 1 kbps extra, just to make sure that we do not get stuck
       // (gives a little extra increase at low rates, negligible at higher
@@ -549,7 +551,7 @@ void SendSideBandwidthEstimation::UpdateMinHistory(Timestamp at_time) {
   // Since history precision is in ms, add one so it is able to increase
   // bitrate if it is off by as little as 0.5ms.
   while (!min_bitrate_history_.empty() &&
-         at_time - min_bitrate_history_.front().first + TimeDelta::ms(1) >
+         at_time - min_bitrate_history_.front().time + TimeDelta::ms(1) >
              kBweIncreaseInterval) {
     min_bitrate_history_.pop_front();
   }
@@ -557,11 +559,15 @@ void SendSideBandwidthEstimation::UpdateMinHistory(Timestamp at_time) {
   // Typical minimum sliding-window algorithm: Pop values higher than current
   // bitrate before pushing it.
   while (!min_bitrate_history_.empty() &&
-         current_target_ <= min_bitrate_history_.back().second) {
+         current_target_ <= min_bitrate_history_.back().bitrate) {
     min_bitrate_history_.pop_back();
   }
 
-  min_bitrate_history_.push_back(std::make_pair(at_time, current_target_));
+  // Dropping the oldest, lowest, sample only makes the ramp up start from a
+  // slightly higher bitrate.
+  if (min_bitrate_history_.full())
+    min_bitrate_history_.pop_front();
+  min_bitrate_history_.push_back(MinBitrateSample{at_time, current_target_});
 }
 
 DataRate SendSideBandwidthEstimation::MaybeRampupOrBackoff(DataRate new_bitrate,
@@ -571,7 +577,7 @@ DataRate SendSideBandwidthEstimation::MaybeRampupOrBackoff(DataRate new_bitrate,
   const TimeDelta time_since_loss_packet_report =
       at_time - last_loss_packet_report_;
   if (time_since_loss_packet_report < 1.2 * kMaxRtcpFeedbackInterval) {
-    new_bitrate = min_bitrate_history_.front().second * 1.08;
+    new_bitrate = min_bitrate_history_.front().bitrate * 1.08;
     new_bitrate += DataRate::bps(1000);
   }
   return new_bitrate;
@@ -15,8 +15,6 @@
 
 #include <stdint.h>
 
-#include <deque>
-#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -24,6 +22,7 @@
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/congestion_controller/goog_cc/bounded_deque.h"
 #include "modules/congestion_controller/goog_cc/loss_based_bandwidth_estimation.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 
@@ -111,19 +110,32 @@ class SendSideBandwidthEstimation {
   int GetMinBitrate() const;
   void SetAcknowledgedRate(absl::optional<DataRate> acknowledged_rate,
                            Timestamp at_time);
-  void IncomingPacketFeedbackVector(const TransportPacketsFeedback& report);
+  // Updates the loss based controller with the number of packets lost out of
+  // |number_of_packets| reported by one transport feedback.
+  void IncomingPacketFeedbackLoss(int packets_lost,
+                                  int number_of_packets,
+                                  Timestamp at_time);
 
  private:
   friend class GoogCcStatePrinter;
 
   enum UmaState { kNoUpdate, kFirstDone, kDone };
 
+  struct MinBitrateSample {
+    Timestamp time = Timestamp::MinusInfinity();
+    DataRate bitrate = DataRate::Zero();
+  };
+  // Upper bound of the min bitrate history. The history only holds strictly
+  // increasing bitrates seen over the last kBweIncreaseInterval, so it rarely
+  // gets close to this.
+  static constexpr size_t kMaxMinBitrateHistorySize = 128;
+
   bool IsInStartPhase(Timestamp at_time) const;
 
   void UpdateUmaStatsPacketsLost(Timestamp at_time, int packets_lost);
 
   // Updates history of min bitrates.
-  // After this method returns min_bitrate_history_.front().second contains the
+  // After this method returns min_bitrate_history_.front().bitrate contains the
   // min bitrate used during last kBweIncreaseIntervalMs.
   void UpdateMinHistory(Timestamp at_time);
 
@@ -150,7 +162,8 @@ class SendSideBandwidthEstimation {
   RttBasedBackoff rtt_backoff_;
   LinkCapacityTracker link_capacity_;
 
-  std::deque<std::pair<Timestamp, DataRate> > min_bitrate_history_;
+  BoundedDeque<MinBitrateSample, kMaxMinBitrateHistorySize>
+      min_bitrate_history_;
 
   // incoming filters
   int lost_packets_since_last_loss_update_;
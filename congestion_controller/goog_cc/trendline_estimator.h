@@ -17,6 +17,7 @@
 #include <memory>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/congestion_controller/goog_cc/delay_increase_detector_interface.h"
@@ -72,6 +73,12 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
 
   void UpdateThreshold(double modified_offset, int64_t now_ms);
 
+  // Maintain the sums of the linear least squares fit over |delay_hist_|.
+  void AddToLinearFit(const std::pair<double, double>& point);
+  void RemoveFromLinearFit(const std::pair<double, double>& point);
+  void RecenterLinearFit();
+  absl::optional<double> LinearFitSlope() const;
+
   // Filtering out small packets. (Intention is to base the detection only
   // on video packets even if we have TWCC sequence number for audio.)
   BweIgnoreSmallPacketsSettings ignore_small_packets_;
@@ -90,6 +97,15 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   double smoothed_delay_;
   // Linear least squares regression.
   std::deque<std::pair<double, double>> delay_hist_;
+  // Running sums over |delay_hist_|, with the points taken relative to
+  // |fit_origin_|. The origin is moved to the oldest point, and the sums are
+  // recomputed, every |window_size_| updates to bound the rounding error.
+  std::pair<double, double> fit_origin_;
+  double sum_x_;
+  double sum_y_;
+  double sum_xx_;
+  double sum_xy_;
+  size_t updates_since_recenter_;
 
   const double k_up_;
   const double k_down_;
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_INCLUDE_BATCHED_PROCESS_NETWORK_CONTROLLER_FACTORY_H_
+#define MODULES_CONGESTION_CONTROLLER_INCLUDE_BATCHED_PROCESS_NETWORK_CONTROLLER_FACTORY_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/transport/network_control.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Wraps a network controller factory so that the periodic OnProcessInterval()
+// work of all the controllers it creates is done in one batch on a single
+// shared timer running on |task_queue|. This is meant for servers where many
+// send side controllers share the same egress, so that they don't each need
+// a timer of their own.
+//
+// The factory reports an infinite process interval, so the owners of the
+// controllers don't start their own periodic processing. The updates produced
+// by the batched processing are kept by each controller and returned, merged
+// with the result, from the next call its owner makes into it. The batched
+// ProcessInterval messages don't carry the pacer queue size.
+//
+// The controllers may be used on any thread, but must be destroyed before the
+// factory. The factory must not be destroyed on |task_queue|.
+class BatchedProcessNetworkControllerFactory
+    : public NetworkControllerFactoryInterface {
+ public:
+  BatchedProcessNetworkControllerFactory(
+      std::unique_ptr<NetworkControllerFactoryInterface> factory,
+      rtc::TaskQueue* task_queue,
+      Clock* clock);
+  ~BatchedProcessNetworkControllerFactory() override;
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override;
+  TimeDelta GetProcessInterval() const override;
+
+  size_t num_controllers() const;
+
+ private:
+  class BatchedController;
+
+  void AddController(BatchedController* controller);
+  void RemoveController(BatchedController* controller);
+  void ProcessControllers();
+
+  const std::unique_ptr<NetworkControllerFactoryInterface> factory_;
+  rtc::TaskQueue* const task_queue_;
+  Clock* const clock_;
+  const TimeDelta process_interval_;
+  RepeatingTaskHandle process_task_;
+
+  rtc::CriticalSection crit_;
+  std::vector<BatchedController*> controllers_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_INCLUDE_BATCHED_PROCESS_NETWORK_CONTROLLER_FACTORY_H_
@@ -25,6 +25,14 @@ PccMonitorInterval::PccMonitorInterval(DataRate target_sending_rate,
     : target_sending_rate_(target_sending_rate),
       start_time_(start_time),
       interval_duration_(duration),
+      num_received_packets_(0),
+      num_lost_packets_(0),
+      first_received_packet_{TimeDelta::Zero(), Timestamp::MinusInfinity()},
+      last_received_packet_{TimeDelta::Zero(), Timestamp::MinusInfinity()},
+      sum_times_(0),
+      sum_delays_(0),
+      sum_squared_times_(0),
+      sum_time_delay_products_(0),
       received_packets_size_(DataSize::Zero()),
       feedback_collection_done_(false) {}
 
@@ -48,11 +56,22 @@ void PccMonitorInterval::OnPacketsFeedback(
       return;
     }
     if (packet_result.receive_time.IsInfinite()) {
-      lost_packets_sent_time_.push_back(packet_result.sent_packet.send_time);
+      ++num_lost_packets_;
     } else {
-      received_packets_.push_back(
-          {packet_result.receive_time - packet_result.sent_packet.send_time,
-           packet_result.sent_packet.send_time});
+      const ReceivedPacket packet = {
+          packet_result.receive_time - packet_result.sent_packet.send_time,
+          packet_result.sent_packet.send_time};
+      if (num_received_packets_ == 0)
+        first_received_packet_ = packet;
+      last_received_packet_ = packet;
+      ++num_received_packets_;
+      const double time_delta_us =
+          (packet.sent_time - first_received_packet_.sent_time).us();
+      const double delay_us = packet.delay.us();
+      sum_times_ += time_delta_us;
+      sum_delays_ += delay_us;
+      sum_squared_times_ += time_delta_us * time_delta_us;
+      sum_time_delay_products_ += time_delta_us * delay_us;
       received_packets_size_ += packet_result.sent_packet.size;
     }
   }
@@ -61,35 +80,23 @@ void PccMonitorInterval::OnPacketsFeedback(
 // For the formula used in computations see formula for "slope" in the second
 // method:
 // https://www.johndcook.com/blog/2008/10/20/comparing-two-ways-to-fit-a-line-to-data/
+// The centered sums of that formula are expanded so that they can be computed
+// from the plain sums.
 double PccMonitorInterval::ComputeDelayGradient(
     double delay_gradient_threshold) const {
   // Early return to prevent division by 0 in case all packets are sent at the
   // same time.
-  if (received_packets_.empty() || received_packets_.front().sent_time ==
-                                       received_packets_.back().sent_time) {
+  if (num_received_packets_ == 0 ||
+      first_received_packet_.sent_time == last_received_packet_.sent_time) {
     return 0;
   }
-  double sum_times = 0;
-  double sum_delays = 0;
-  for (const ReceivedPacket& packet : received_packets_) {
-    double time_delta_us =
-        (packet.sent_time - received_packets_[0].sent_time).us();
-    double delay = packet.delay.us();
-    sum_times += time_delta_us;
-    sum_delays += delay;
-  }
-  double sum_squared_scaled_time_deltas = 0;
-  double sum_scaled_time_delta_dot_delay = 0;
-  for (const ReceivedPacket& packet : received_packets_) {
-    double time_delta_us =
-        (packet.sent_time - received_packets_[0].sent_time).us();
-    double delay = packet.delay.us();
-    double scaled_time_delta_us =
-        time_delta_us - sum_times / received_packets_.size();
-    sum_squared_scaled_time_deltas +=
-        scaled_time_delta_us * scaled_time_delta_us;
-    sum_scaled_time_delta_dot_delay += scaled_time_delta_us * delay;
-  }
+  const double mean_time = sum_times_ / num_received_packets_;
+  const double sum_squared_scaled_time_deltas =
+      sum_squared_times_ - mean_time * sum_times_;
+  const double sum_scaled_time_delta_dot_delay =
+      sum_time_delay_products_ - mean_time * sum_delays_;
+  if (sum_squared_scaled_time_deltas <= 0)
+    return 0;
   double rtt_gradient =
       sum_scaled_time_delta_dot_delay / sum_squared_scaled_time_deltas;
   if (std::abs(rtt_gradient) < delay_gradient_threshold)
@@ -106,11 +113,10 @@ Timestamp PccMonitorInterval::GetEndTime() const {
 }
 
 double PccMonitorInterval::GetLossRate() const {
-  size_t packets_lost = lost_packets_sent_time_.size();
-  size_t packets_received = received_packets_.size();
-  if (packets_lost == 0)
+  if (num_lost_packets_ == 0)
     return 0;
-  return static_cast<double>(packets_lost) / (packets_lost + packets_received);
+  return static_cast<double>(num_lost_packets_) /
+         (num_lost_packets_ + num_received_packets_);
 }
 
 DataRate PccMonitorInterval::GetTargetSendingRate() const {
@@ -118,13 +124,13 @@ DataRate PccMonitorInterval::GetTargetSendingRate() const {
 }
 
 DataRate PccMonitorInterval::GetTransmittedPacketsRate() const {
-  if (received_packets_.empty()) {
+  if (num_received_packets_ == 0) {
     return target_sending_rate_;
   }
   Timestamp receive_time_of_first_packet =
-      received_packets_.front().sent_time + received_packets_.front().delay;
+      first_received_packet_.sent_time + first_received_packet_.delay;
   Timestamp receive_time_of_last_packet =
-      received_packets_.back().sent_time + received_packets_.back().delay;
+      last_received_packet_.sent_time + last_received_packet_.delay;
   if (receive_time_of_first_packet == receive_time_of_last_packet) {
     RTC_LOG(LS_WARNING)
         << "All packets in monitor interval were received at the same time.";
@@ -11,6 +11,8 @@
 #ifndef MODULES_CONGESTION_CONTROLLER_PCC_MONITOR_INTERVAL_H_
 #define MODULES_CONGESTION_CONTROLLER_PCC_MONITOR_INTERVAL_H_
 
+#include <stddef.h>
+
 #include <vector>
 
 #include "api/transport/network_types.h"
@@ -41,7 +43,9 @@ class PccMonitorInterval {
 
   double GetLossRate() const;
   // Estimates the gradient using linear regression on the 2-dimensional
-  // dataset (sampled packets delay, time of sampling).
+  // dataset (sampled packets delay, time of sampling). The regression is
+  // computed from sums kept while receiving feedback, so it does not depend
+  // on the number of packets in the interval.
   double ComputeDelayGradient(double delay_gradient_threshold) const;
   DataRate GetTargetSendingRate() const;
   // How fast receiving side gets packets.
@@ -58,9 +62,20 @@ class PccMonitorInterval {
   // Start time is not included into interval while end time is included.
   Timestamp start_time_;
   TimeDelta interval_duration_;
-  // Vectors below updates while receiving feedback.
-  std::vector<ReceivedPacket> received_packets_;
-  std::vector<Timestamp> lost_packets_sent_time_;
+  // Members below are updated while receiving feedback. Only aggregates are
+  // kept, so the cost per packet is constant.
+  size_t num_received_packets_;
+  size_t num_lost_packets_;
+  // The first and the last packet received, in feedback order.
+  ReceivedPacket first_received_packet_;
+  ReceivedPacket last_received_packet_;
+  // Sums for the delay gradient regression, with the send times in us
+  // relative to the send time of the first received packet and the delays in
+  // us.
+  double sum_times_;
+  double sum_delays_;
+  double sum_squared_times_;
+  double sum_time_delay_products_;
   DataSize received_packets_size_;
   bool feedback_collection_done_;
 };
@@ -91,14 +91,31 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
     packet.long_sequence_number =
         seq_num_unwrapper_.Unwrap(packet.sequence_number);
 
+    // The front entry is always present, see RemoveFromHistory().
     while (!history_.empty() &&
-           creation_time.ms() - history_.begin()->second.creation_time_ms >
+           creation_time.ms() - history_.front()->creation_time_ms >
                packet_age_limit_ms_) {
       // TODO(sprang): Warn if erasing (too many) old items?
-      RemoveInFlightPacketBytes(history_.begin()->second);
-      history_.erase(history_.begin());
+      RemoveInFlightPacketBytes(*history_.front());
+      RemoveFromHistory(history_first_seq_num_);
+    }
+
+    const int64_t seq_num = packet.long_sequence_number;
+    if (history_.empty()) {
+      history_first_seq_num_ = seq_num;
+    }
+    if (seq_num < history_first_seq_num_) {
+      history_.insert(history_.begin(), history_first_seq_num_ - seq_num,
+                      absl::nullopt);
+      history_first_seq_num_ = seq_num;
+    }
+    const size_t index = seq_num - history_first_seq_num_;
+    if (index >= history_.size()) {
+      history_.resize(index + 1);
+    }
+    if (!history_[index]) {
+      history_[index] = packet;
     }
-    history_.insert(std::make_pair(packet.long_sequence_number, packet));
   }
 
   {
@@ -116,10 +133,10 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.send_time_ms >= 0;
-      it->second.send_time_ms = sent_packet.send_time_ms;
+    PacketFeedback* packet_feedback = FindInHistory(unwrapped_seq_num);
+    if (packet_feedback) {
+      bool packet_retransmit = packet_feedback->send_time_ms >= 0;
+      packet_feedback->send_time_ms = sent_packet.send_time_ms;
       last_send_time_ms_ =
           std::max(last_send_time_ms_, sent_packet.send_time_ms);
       // TODO(srte): Don't do this on retransmit.
@@ -129,12 +146,12 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
               << "appending acknowledged data for out of order packet. (Diff: "
               << last_untracked_send_time_ms_ - sent_packet.send_time_ms
               << " ms.)";
-        it->second.unacknowledged_data += pending_untracked_size_;
+        packet_feedback->unacknowledged_data += pending_untracked_size_;
         pending_untracked_size_ = 0;
       }
       if (!packet_retransmit) {
-        AddInFlightPacketBytes(it->second);
-        auto packet = it->second;
+        AddInFlightPacketBytes(*packet_feedback);
+        const PacketFeedback& packet = *packet_feedback;
         SentPacket msg;
         msg.size = DataSize::bytes(packet.payload_size);
         msg.send_time = Timestamp::ms(packet.send_time_ms);
@@ -161,8 +178,8 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
     Timestamp feedback_receive_time) {
   DataSize prior_in_flight = GetOutstandingData();
 
-  last_packet_feedback_vector_ =
-      GetPacketFeedbackVector(feedback, feedback_receive_time);
+  GetPacketFeedbackVector(feedback, feedback_receive_time,
+                          &last_packet_feedback_vector_);
   {
     rtc::CritScope cs(&observers_lock_);
     for (auto* observer : observers_) {
@@ -170,12 +187,12 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
     }
   }
 
-  std::vector<PacketFeedback> feedback_vector = last_packet_feedback_vector_;
-  if (feedback_vector.empty())
+  if (last_packet_feedback_vector_.empty())
     return absl::nullopt;
 
   TransportPacketsFeedback msg;
-  for (const PacketFeedback& rtp_feedback : feedback_vector) {
+  msg.packet_feedbacks.reserve(last_packet_feedback_vector_.size());
+  for (const PacketFeedback& rtp_feedback : last_packet_feedback_vector_) {
     if (rtp_feedback.send_time_ms != PacketFeedback::kNoSendTime) {
       auto feedback = NetworkPacketFeedbackFromRtpPacketFeedback(rtp_feedback);
       msg.packet_feedbacks.push_back(feedback);
@@ -188,10 +205,9 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   }
   {
     rtc::CritScope cs(&lock_);
-    auto it = history_.find(last_ack_seq_num_);
-    if (it != history_.end() &&
-        it->second.send_time_ms != PacketFeedback::kNoSendTime) {
-      msg.first_unacked_send_time = Timestamp::ms(it->second.send_time_ms);
+    const PacketFeedback* last_acked = FindInHistory(last_ack_seq_num_);
+    if (last_acked && last_acked->send_time_ms != PacketFeedback::kNoSendTime) {
+      msg.first_unacked_send_time = Timestamp::ms(last_acked->send_time_ms);
     }
   }
   msg.feedback_time = feedback_receive_time;
@@ -217,9 +233,10 @@ DataSize TransportFeedbackAdapter::GetOutstandingData() const {
   }
 }
 
-std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
+void TransportFeedbackAdapter::GetPacketFeedbackVector(
     const rtcp::TransportFeedback& feedback,
-    Timestamp feedback_time) {
+    Timestamp feedback_time,
+    std::vector<PacketFeedback>* packet_feedback_vector) {
   // Add timestamp deltas to a local time base selected on first packet arrival.
   // This won't be the true time base, but makes it easier to manually inspect
   // time stamps.
@@ -230,12 +247,12 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
   }
   last_timestamp_us_ = feedback.GetBaseTimeUs();
 
-  std::vector<PacketFeedback> packet_feedback_vector;
+  packet_feedback_vector->clear();
   if (feedback.GetPacketStatusCount() == 0) {
     RTC_LOG(LS_INFO) << "Empty transport feedback packet received.";
-    return packet_feedback_vector;
+    return;
   }
-  packet_feedback_vector.reserve(feedback.GetPacketStatusCount());
+  packet_feedback_vector->reserve(feedback.GetPacketStatusCount());
   {
     rtc::CritScope cs(&lock_);
     size_t failed_lookups = 0;
@@ -253,7 +270,7 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
           ++failed_lookups;
         if (packet_feedback.local_net_id == local_net_id_ &&
             packet_feedback.remote_net_id == remote_net_id_) {
-          packet_feedback_vector.push_back(packet_feedback);
+          packet_feedback_vector->push_back(packet_feedback);
         }
       }
 
@@ -265,7 +282,7 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
         ++failed_lookups;
       if (packet_feedback.local_net_id == local_net_id_ &&
           packet_feedback.remote_net_id == remote_net_id_) {
-        packet_feedback_vector.push_back(packet_feedback);
+        packet_feedback_vector->push_back(packet_feedback);
       }
 
       ++seq_num;
@@ -277,7 +294,6 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
                           << ". Send time history too small?";
     }
   }
-  return packet_feedback_vector;
 }
 
 std::vector<PacketFeedback>
@@ -292,30 +308,61 @@ bool TransportFeedbackAdapter::GetFeedback(PacketFeedback* packet_feedback,
       seq_num_unwrapper_.Unwrap(packet_feedback->sequence_number);
 
   if (acked_seq_num > last_ack_seq_num_) {
-    // Returns history_.begin() if last_ack_seq_num_ < 0, since any valid
-    // sequence number is >= 0.
-    auto unacked_it = history_.lower_bound(last_ack_seq_num_);
-    auto newly_acked_end = history_.upper_bound(acked_seq_num);
-    for (; unacked_it != newly_acked_end; ++unacked_it) {
-      RemoveInFlightPacketBytes(unacked_it->second);
+    // Packets up to and including |last_ack_seq_num_| are no longer in
+    // flight.
+    const int64_t history_end_seq_num =
+        history_first_seq_num_ + static_cast<int64_t>(history_.size());
+    const int64_t newly_acked_end =
+        std::min(acked_seq_num + 1, history_end_seq_num);
+    for (int64_t seq_num =
+             std::max(last_ack_seq_num_ + 1, history_first_seq_num_);
+         seq_num < newly_acked_end; ++seq_num) {
+      const absl::optional<PacketFeedback>& packet =
+          history_[seq_num - history_first_seq_num_];
+      if (packet)
+        RemoveInFlightPacketBytes(*packet);
     }
     last_ack_seq_num_ = acked_seq_num;
   }
 
-  auto it = history_.find(acked_seq_num);
-  if (it == history_.end())
+  const PacketFeedback* packet = FindInHistory(acked_seq_num);
+  if (!packet)
     return false;
 
   // Save arrival_time not to overwrite it.
   int64_t arrival_time_ms = packet_feedback->arrival_time_ms;
-  *packet_feedback = it->second;
+  *packet_feedback = *packet;
   packet_feedback->arrival_time_ms = arrival_time_ms;
 
   if (remove)
-    history_.erase(it);
+    RemoveFromHistory(acked_seq_num);
   return true;
 }
 
+PacketFeedback* TransportFeedbackAdapter::FindInHistory(
+    int64_t sequence_number) {
+  if (sequence_number < history_first_seq_num_)
+    return nullptr;
+  const uint64_t index = sequence_number - history_first_seq_num_;
+  if (index >= history_.size() || !history_[index])
+    return nullptr;
+  return &*history_[index];
+}
+
+void TransportFeedbackAdapter::RemoveFromHistory(int64_t sequence_number) {
+  if (sequence_number < history_first_seq_num_)
+    return;
+  const uint64_t index = sequence_number - history_first_seq_num_;
+  if (index >= history_.size())
+    return;
+  history_[index].reset();
+  // Keeps the front entry present.
+  while (!history_.empty() && !history_.front()) {
+    history_.pop_front();
+    ++history_first_seq_num_;
+  }
+}
+
 void TransportFeedbackAdapter::AddInFlightPacketBytes(
     const PacketFeedback& packet) {
   RTC_DCHECK_NE(packet.send_time_ms, -1);
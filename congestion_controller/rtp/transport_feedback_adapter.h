@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/transport/network_types.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -64,9 +65,15 @@ class TransportFeedbackAdapter {
 
   void OnTransportFeedback(const rtcp::TransportFeedback& feedback);
 
-  std::vector<PacketFeedback> GetPacketFeedbackVector(
+  // Fills |packet_feedback_vector|, reusing its capacity.
+  void GetPacketFeedbackVector(
       const rtcp::TransportFeedback& feedback,
-      Timestamp feedback_time);
+      Timestamp feedback_time,
+      std::vector<PacketFeedback>* packet_feedback_vector);
+
+  // Returns the history entry of the unwrapped |sequence_number|, or nullptr.
+  PacketFeedback* FindInHistory(int64_t sequence_number) RTC_RUN_ON(&lock_);
+  void RemoveFromHistory(int64_t sequence_number) RTC_RUN_ON(&lock_);
 
   // Look up PacketFeedback for a sent packet, based on the sequence number, and
   // populate all fields except for arrival_time. The packet parameter must
@@ -84,7 +91,12 @@ class TransportFeedbackAdapter {
   int64_t last_send_time_ms_ RTC_GUARDED_BY(&lock_) = -1;
   int64_t last_untracked_send_time_ms_ RTC_GUARDED_BY(&lock_) = -1;
   SequenceNumberUnwrapper seq_num_unwrapper_ RTC_GUARDED_BY(&lock_);
-  std::map<int64_t, PacketFeedback> history_ RTC_GUARDED_BY(&lock_);
+  // Send history indexed by the unwrapped transport sequence number, starting
+  // at |history_first_seq_num_|. Sequence numbers are allocated in order, so
+  // the entries are mostly contiguous. Removed entries are left empty until
+  // they reach the front.
+  std::deque<absl::optional<PacketFeedback>> history_ RTC_GUARDED_BY(&lock_);
+  int64_t history_first_seq_num_ RTC_GUARDED_BY(&lock_) = 0;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
@@ -315,6 +315,34 @@ TEST_F(TransportFeedbackAdapterTest, HandlesArrivalReordering) {
   ComparePacketFeedbackVectors(packets, adapter_->GetTransportFeedbackVector());
 }
 
+TEST_F(TransportFeedbackAdapterTest, HandlesPacketsAddedOutOfOrder) {
+  std::vector<PacketFeedback> packets;
+  packets.push_back(PacketFeedback(100, 200, 0, 1500, kPacingInfo0));
+  packets.push_back(PacketFeedback(110, 210, 1, 1500, kPacingInfo0));
+  packets.push_back(PacketFeedback(120, 220, 2, 1500, kPacingInfo0));
+
+  // The send history must also find packets which were added before a packet
+  // with a lower sequence number.
+  OnSentPacket(packets[1]);
+  OnSentPacket(packets[2]);
+  OnSentPacket(packets[0]);
+
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(packets[0].sequence_number,
+                   packets[0].arrival_time_ms * 1000);
+
+  for (const PacketFeedback& packet : packets) {
+    EXPECT_TRUE(feedback.AddReceivedPacket(packet.sequence_number,
+                                           packet.arrival_time_ms * 1000));
+  }
+
+  feedback.Build();
+
+  adapter_->ProcessTransportFeedback(
+      feedback, Timestamp::ms(clock_.TimeInMilliseconds()));
+  ComparePacketFeedbackVectors(packets, adapter_->GetTransportFeedbackVector());
+}
+
 TEST_F(TransportFeedbackAdapterTest, TimestampDeltas) {
   std::vector<PacketFeedback> sent_packets;
   const int64_t kSmallDeltaUs =
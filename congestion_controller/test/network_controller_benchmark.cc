@@ -0,0 +1,372 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/test/network_controller_benchmark.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int64_t kTimeStepMs = 1;
+constexpr int64_t kFeedbackIntervalMs = 50;
+// Used when the factory does not ask for periodic processing.
+constexpr int64_t kDefaultProcessIntervalMs = 25;
+constexpr int64_t kPacketSizeBytes = 1200;
+// The pacer never sends more than this much of its rate at once.
+constexpr int64_t kMaxPacingBurstMs = 5;
+// Media produced beyond this many queued packets is dropped, as an encoder
+// would drop frames.
+constexpr int kMaxQueuedPackets = 1000;
+constexpr double kDefaultPacingFactor = 2.5;
+const DataRate kStartRate = DataRate::kbps(300);
+const DataRate kMinRate = DataRate::kbps(30);
+const DataRate kMaxRate = DataRate::kbps(50000);
+
+class Simulation {
+ public:
+  Simulation(NetworkControllerFactoryInterface* factory,
+             const NetworkControllerBenchmark::Link& link);
+
+  NetworkControllerBenchmark::Result Run(TimeDelta duration);
+
+ private:
+  struct PendingFeedback {
+    Timestamp arrival_time = Timestamp::PlusInfinity();
+    std::vector<PacketResult> packets;
+  };
+
+  struct ActiveProbe {
+    ProbeClusterConfig config;
+    double sent_bytes = 0;
+    double budget_bytes = 0;
+  };
+
+  void ApplyUpdate(const NetworkControlUpdate& update);
+  bool CanSend() const;
+  void GenerateMedia();
+  void SendPackets(Timestamp now);
+  void SendPacket(Timestamp now, const PacedPacketInfo& pacing_info);
+  void SendCrossTraffic(Timestamp now);
+  // Returns the time the packet reaches the receiver, or nothing if it is
+  // dropped by the link.
+  absl::optional<Timestamp> SendOverLink(Timestamp now, double size_bytes);
+  void CreateFeedback(Timestamp now);
+  void DeliverFeedback(Timestamp now);
+
+  const NetworkControllerBenchmark::Link link_;
+  const TimeDelta process_interval_;
+  const Timestamp start_time_;
+  std::unique_ptr<NetworkControllerInterface> controller_;
+
+  // Controller outputs.
+  DataRate target_rate_;
+  DataRate pacing_rate_;
+  DataRate pad_rate_;
+  absl::optional<DataSize> congestion_window_;
+  std::deque<ProbeClusterConfig> probe_clusters_;
+  absl::optional<ActiveProbe> active_probe_;
+
+  // Sender state.
+  int64_t next_sequence_number_ = 1;
+  DataSize data_in_flight_ = DataSize::Zero();
+  int queued_packets_ = 0;
+  double media_budget_bytes_ = 0;
+  double pacing_budget_bytes_ = 0;
+  double padding_budget_bytes_ = 0;
+  double cross_traffic_budget_bytes_ = 0;
+
+  // Link and receiver state.
+  Timestamp link_free_time_;
+  std::deque<PacketResult> packets_in_transit_;
+  std::deque<PendingFeedback> pending_feedback_;
+
+  // Statistics.
+  NetworkControllerBenchmark::Result result_;
+  int64_t num_sent_packets_ = 0;
+  int64_t num_lost_packets_ = 0;
+  int64_t received_bytes_ = 0;
+  TimeDelta total_queue_delay_ = TimeDelta::Zero();
+  double target_rate_sum_bps_ = 0;
+};
+
+Simulation::Simulation(NetworkControllerFactoryInterface* factory,
+                       const NetworkControllerBenchmark::Link& link)
+    : link_(link),
+      process_interval_(factory->GetProcessInterval().IsFinite()
+                            ? factory->GetProcessInterval()
+                            : TimeDelta::ms(kDefaultProcessIntervalMs)),
+      start_time_(Timestamp::seconds(10000)),
+      target_rate_(kStartRate),
+      pacing_rate_(kStartRate * kDefaultPacingFactor),
+      pad_rate_(DataRate::Zero()),
+      link_free_time_(start_time_) {
+  RTC_DCHECK(link_.capacity > link_.cross_traffic);
+  NetworkControllerConfig config;
+  config.constraints.at_time = start_time_;
+  config.constraints.starting_rate = kStartRate;
+  config.constraints.min_data_rate = kMinRate;
+  config.constraints.max_data_rate = kMaxRate;
+  controller_ = factory->Create(config);
+
+  NetworkAvailability availability;
+  availability.at_time = start_time_;
+  availability.network_available = true;
+  ApplyUpdate(controller_->OnNetworkAvailability(availability));
+}
+
+NetworkControllerBenchmark::Result Simulation::Run(TimeDelta duration) {
+  const TimeDelta time_step = TimeDelta::ms(kTimeStepMs);
+  const Timestamp end_time = start_time_ + duration;
+  Timestamp next_process_time = start_time_;
+  Timestamp next_feedback_time = start_time_;
+  for (Timestamp now = start_time_; now < end_time; now += time_step) {
+    if (now >= next_process_time) {
+      ProcessInterval msg;
+      msg.at_time = now;
+      msg.pacer_queue = DataSize::bytes(queued_packets_ * kPacketSizeBytes);
+      ApplyUpdate(controller_->OnProcessInterval(msg));
+      next_process_time += process_interval_;
+    }
+    DeliverFeedback(now);
+    if (now >= next_feedback_time) {
+      CreateFeedback(now);
+      next_feedback_time += TimeDelta::ms(kFeedbackIntervalMs);
+    }
+    SendCrossTraffic(now);
+    GenerateMedia();
+    SendPackets(now);
+    target_rate_sum_bps_ += target_rate_.bps();
+  }
+
+  const int64_t num_steps = duration.ms() / kTimeStepMs;
+  const DataRate available_rate = link_.capacity - link_.cross_traffic;
+  result_.utilization = received_bytes_ * 8.0 /
+                        (duration.seconds<double>() * available_rate.bps());
+  const int64_t num_delivered = num_sent_packets_ - num_lost_packets_;
+  if (num_delivered > 0)
+    result_.mean_queue_delay = total_queue_delay_ / num_delivered;
+  if (num_sent_packets_ > 0)
+    result_.loss_ratio = static_cast<double>(num_lost_packets_) /
+                         num_sent_packets_;
+  if (num_steps > 0)
+    result_.mean_target_rate =
+        DataRate::bps(static_cast<int64_t>(target_rate_sum_bps_ / num_steps));
+  return result_;
+}
+
+void Simulation::ApplyUpdate(const NetworkControlUpdate& update) {
+  if (update.target_rate)
+    target_rate_ = update.target_rate->target_rate;
+  if (update.pacer_config) {
+    pacing_rate_ = update.pacer_config->data_rate();
+    pad_rate_ = update.pacer_config->pad_rate();
+  }
+  if (update.congestion_window)
+    congestion_window_ = update.congestion_window;
+  probe_clusters_.insert(probe_clusters_.end(),
+                         update.probe_cluster_configs.begin(),
+                         update.probe_cluster_configs.end());
+}
+
+bool Simulation::CanSend() const {
+  return !congestion_window_ || congestion_window_->IsInfinite() ||
+         data_in_flight_ < *congestion_window_;
+}
+
+void Simulation::GenerateMedia() {
+  media_budget_bytes_ += target_rate_.bps() * kTimeStepMs / 8000.0;
+  while (media_budget_bytes_ >= kPacketSizeBytes) {
+    media_budget_bytes_ -= kPacketSizeBytes;
+    if (queued_packets_ < kMaxQueuedPackets)
+      ++queued_packets_;
+  }
+}
+
+void Simulation::SendPackets(Timestamp now) {
+  // Probe clusters are sent at their own rate, ahead of the media.
+  if (!active_probe_ && !probe_clusters_.empty()) {
+    active_probe_.emplace();
+    active_probe_->config = probe_clusters_.front();
+    probe_clusters_.pop_front();
+  }
+  if (active_probe_) {
+    const ProbeClusterConfig& config = active_probe_->config;
+    const double cluster_bytes =
+        config.target_data_rate.bps() * config.target_duration.ms() / 8000.0;
+    active_probe_->budget_bytes +=
+        config.target_data_rate.bps() * kTimeStepMs / 8000.0;
+    const PacedPacketInfo pacing_info(config.id, config.target_probe_count,
+                                      static_cast<int>(cluster_bytes));
+    while (active_probe_->budget_bytes >= kPacketSizeBytes &&
+           active_probe_->sent_bytes < cluster_bytes) {
+      active_probe_->budget_bytes -= kPacketSizeBytes;
+      active_probe_->sent_bytes += kPacketSizeBytes;
+      SendPacket(now, pacing_info);
+    }
+    if (active_probe_->sent_bytes >= cluster_bytes)
+      active_probe_.reset();
+  }
+
+  const double max_burst_bytes =
+      pacing_rate_.bps() * kMaxPacingBurstMs / 8000.0;
+  pacing_budget_bytes_ =
+      std::min(pacing_budget_bytes_ + pacing_rate_.bps() * kTimeStepMs / 8000.0,
+               std::max(max_burst_bytes, 1.0 * kPacketSizeBytes));
+  while (queued_packets_ > 0 && pacing_budget_bytes_ >= kPacketSizeBytes &&
+         CanSend()) {
+    --queued_packets_;
+    pacing_budget_bytes_ -= kPacketSizeBytes;
+    SendPacket(now, PacedPacketInfo());
+  }
+
+  if (queued_packets_ > 0 || pad_rate_.IsZero())
+    return;
+  const double max_padding_bytes = pad_rate_.bps() * kMaxPacingBurstMs / 8000.0;
+  padding_budget_bytes_ =
+      std::min(padding_budget_bytes_ + pad_rate_.bps() * kTimeStepMs / 8000.0,
+               std::max(max_padding_bytes, 1.0 * kPacketSizeBytes));
+  while (padding_budget_bytes_ >= kPacketSizeBytes &&
+         pacing_budget_bytes_ >= kPacketSizeBytes && CanSend()) {
+    padding_budget_bytes_ -= kPacketSizeBytes;
+    pacing_budget_bytes_ -= kPacketSizeBytes;
+    SendPacket(now, PacedPacketInfo());
+  }
+}
+
+void Simulation::SendPacket(Timestamp now, const PacedPacketInfo& pacing_info) {
+  SentPacket sent_packet;
+  sent_packet.send_time = now;
+  sent_packet.size = DataSize::bytes(kPacketSizeBytes);
+  sent_packet.sequence_number = next_sequence_number_++;
+  sent_packet.pacing_info = pacing_info;
+  sent_packet.prior_unacked_data = data_in_flight_;
+  data_in_flight_ += sent_packet.size;
+  sent_packet.data_in_flight = data_in_flight_;
+  ApplyUpdate(controller_->OnSentPacket(sent_packet));
+
+  PacketResult packet;
+  packet.sent_packet = sent_packet;
+  const TimeDelta queue_delay = std::max(now, link_free_time_) - now;
+  absl::optional<Timestamp> arrival_time = SendOverLink(now, kPacketSizeBytes);
+  ++num_sent_packets_;
+  if (arrival_time) {
+    packet.receive_time = *arrival_time;
+    total_queue_delay_ += queue_delay;
+    result_.max_queue_delay = std::max(result_.max_queue_delay, queue_delay);
+  } else {
+    packet.receive_time = Timestamp::PlusInfinity();
+    ++num_lost_packets_;
+  }
+  packets_in_transit_.push_back(packet);
+}
+
+void Simulation::SendCrossTraffic(Timestamp now) {
+  cross_traffic_budget_bytes_ +=
+      link_.cross_traffic.bps() * kTimeStepMs / 8000.0;
+  while (cross_traffic_budget_bytes_ >= kPacketSizeBytes) {
+    cross_traffic_budget_bytes_ -= kPacketSizeBytes;
+    SendOverLink(now, kPacketSizeBytes);
+  }
+}
+
+absl::optional<Timestamp> Simulation::SendOverLink(Timestamp now,
+                                                   double size_bytes) {
+  const Timestamp transmit_time = std::max(now, link_free_time_);
+  if (transmit_time - now > link_.max_queue_delay)
+    return absl::nullopt;
+  link_free_time_ =
+      transmit_time +
+      TimeDelta::us(static_cast<int64_t>(size_bytes * 8000000 /
+                                         link_.capacity.bps()));
+  return link_free_time_ + link_.rtt / 2;
+}
+
+void Simulation::CreateFeedback(Timestamp now) {
+  // Reports everything up to the last packet received so far. Lost packets
+  // after it are reported once a later packet has been received.
+  size_t num_reported = 0;
+  for (size_t i = 0; i < packets_in_transit_.size(); ++i) {
+    const Timestamp receive_time = packets_in_transit_[i].receive_time;
+    if (receive_time.IsInfinite())
+      continue;
+    if (receive_time > now)
+      break;
+    num_reported = i + 1;
+  }
+  if (num_reported == 0)
+    return;
+  PendingFeedback feedback;
+  feedback.arrival_time = now + link_.rtt / 2;
+  feedback.packets.assign(packets_in_transit_.begin(),
+                          packets_in_transit_.begin() + num_reported);
+  packets_in_transit_.erase(packets_in_transit_.begin(),
+                            packets_in_transit_.begin() + num_reported);
+  for (const PacketResult& packet : feedback.packets) {
+    if (packet.receive_time.IsFinite())
+      received_bytes_ += packet.sent_packet.size.bytes();
+  }
+  pending_feedback_.push_back(std::move(feedback));
+}
+
+void Simulation::DeliverFeedback(Timestamp now) {
+  while (!pending_feedback_.empty() &&
+         pending_feedback_.front().arrival_time <= now) {
+    TransportPacketsFeedback msg;
+    msg.feedback_time = now;
+    msg.prior_in_flight = data_in_flight_;
+    msg.packet_feedbacks = std::move(pending_feedback_.front().packets);
+    pending_feedback_.pop_front();
+    for (const PacketResult& packet : msg.packet_feedbacks)
+      data_in_flight_ -= packet.sent_packet.size;
+    msg.data_in_flight = data_in_flight_;
+    msg.first_unacked_send_time =
+        packets_in_transit_.empty()
+            ? now
+            : packets_in_transit_.front().sent_packet.send_time;
+
+    const int64_t start_time_us = rtc::TimeMicros();
+    NetworkControlUpdate update = controller_->OnTransportPacketsFeedback(msg);
+    result_.feedback_time_us += rtc::TimeMicros() - start_time_us;
+    ++result_.num_feedbacks;
+    ApplyUpdate(update);
+  }
+}
+
+}  // namespace
+
+double NetworkControllerBenchmark::Result::FeedbackUsPerCall() const {
+  return num_feedbacks > 0
+             ? static_cast<double>(feedback_time_us) / num_feedbacks
+             : 0;
+}
+
+NetworkControllerBenchmark::Result NetworkControllerBenchmark::Run(
+    NetworkControllerFactoryInterface* factory,
+    const Link& link,
+    TimeDelta duration) {
+  Simulation simulation(factory, link);
+  return simulation.Run(duration);
+}
+
+}  // namespace test
+}  // namespace webrtc
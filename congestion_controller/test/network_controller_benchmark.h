@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_TEST_NETWORK_CONTROLLER_BENCHMARK_H_
+#define MODULES_CONGESTION_CONTROLLER_TEST_NETWORK_CONTROLLER_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "api/transport/network_control.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+namespace test {
+
+// Runs a network controller in a closed loop against a simulated bottleneck
+// link and measures how well it uses the link and how much CPU time it spends
+// on each transport feedback. The sender produces media at the target rate
+// and paces it at the pacing rate, limited by the congestion window; probe
+// clusters and padding are sent as requested. The link is a FIFO queue shared
+// with constant rate cross traffic and drops packets when the queueing delay
+// would exceed |max_queue_delay|. The receiver sends transport feedback at a
+// fixed interval.
+class NetworkControllerBenchmark {
+ public:
+  struct Link {
+    std::string name;
+    DataRate capacity = DataRate::kbps(2000);
+    TimeDelta rtt = TimeDelta::ms(100);
+    DataRate cross_traffic = DataRate::Zero();
+    TimeDelta max_queue_delay = TimeDelta::ms(500);
+  };
+
+  struct Result {
+    // The number of feedback messages given to the controller.
+    int num_feedbacks = 0;
+    // The total time spent in OnTransportPacketsFeedback, in microseconds.
+    int64_t feedback_time_us = 0;
+    // The media and padding received over the link, divided by the capacity
+    // left by the cross traffic.
+    double utilization = 0;
+    // The mean and maximum queueing delay of the sent packets.
+    TimeDelta mean_queue_delay = TimeDelta::Zero();
+    TimeDelta max_queue_delay = TimeDelta::Zero();
+    // The fraction of the sent packets dropped by the link.
+    double loss_ratio = 0;
+    // The mean target rate reported by the controller.
+    DataRate mean_target_rate = DataRate::Zero();
+
+    // Returns the CPU time, in microseconds, per feedback message.
+    double FeedbackUsPerCall() const;
+  };
+
+  static Result Run(NetworkControllerFactoryInterface* factory,
+                    const Link& link,
+                    TimeDelta duration);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_TEST_NETWORK_CONTROLLER_BENCHMARK_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/test/network_controller_benchmark.h"
+
+#include <string>
+
+#include "api/transport/goog_cc_factory.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/pcc/pcc_factory.h"
+#include "system_wrappers/include/field_trial.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+// Sweeps the link capacity, RTT and cross traffic share, and reports the
+// link utilization, queueing delay, loss and CPU time per feedback message
+// of the controllers created by |factory|.
+void RunBenchmark(const std::string& controller_name,
+                  NetworkControllerFactoryInterface* factory) {
+  const TimeDelta kDuration = TimeDelta::seconds(60);
+  const TimeDelta kQuickDuration = TimeDelta::seconds(10);
+  const TimeDelta duration = field_trial::IsEnabled("WebRTC-QuickPerfTest")
+                                 ? kQuickDuration
+                                 : kDuration;
+  const int kCapacitiesKbps[] = {500, 2000, 10000};
+  const int kRttsMs[] = {40, 150, 600};
+  const double kCrossTrafficShares[] = {0, 0.3};
+  for (int capacity_kbps : kCapacitiesKbps) {
+    for (int rtt_ms : kRttsMs) {
+      for (double cross_traffic_share : kCrossTrafficShares) {
+        NetworkControllerBenchmark::Link link;
+        link.capacity = DataRate::kbps(capacity_kbps);
+        link.rtt = TimeDelta::ms(rtt_ms);
+        link.cross_traffic = link.capacity * cross_traffic_share;
+        const NetworkControllerBenchmark::Result result =
+            NetworkControllerBenchmark::Run(factory, link, duration);
+        ASSERT_GT(result.num_feedbacks, 0);
+        const std::string modifier =
+            "_" + controller_name + "_" + std::to_string(capacity_kbps) +
+            "kbps_" + std::to_string(rtt_ms) + "ms_cross" +
+            std::to_string(static_cast<int>(cross_traffic_share * 100));
+        PrintResult("network_controller_benchmark", modifier, "utilization",
+                    100 * result.utilization, "percent", true);
+        PrintResult("network_controller_benchmark", modifier,
+                    "mean_queue_delay", result.mean_queue_delay.ms(), "ms",
+                    false);
+        PrintResult("network_controller_benchmark", modifier,
+                    "max_queue_delay", result.max_queue_delay.ms(), "ms",
+                    false);
+        PrintResult("network_controller_benchmark", modifier, "loss",
+                    100 * result.loss_ratio, "percent", false);
+        PrintResult("network_controller_benchmark", modifier,
+                    "mean_target_rate", result.mean_target_rate.kbps(), "kbps",
+                    false);
+        PrintResult("network_controller_benchmark", modifier,
+                    "feedback_cpu_time", result.FeedbackUsPerCall(), "us",
+                    true);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(NetworkControllerBenchmark, GoogCc) {
+  GoogCcNetworkControllerFactory factory;
+  RunBenchmark("goog_cc", &factory);
+}
+
+TEST(NetworkControllerBenchmark, Bbr) {
+  BbrNetworkControllerFactory factory;
+  RunBenchmark("bbr", &factory);
+}
+
+TEST(NetworkControllerBenchmark, Pcc) {
+  PccNetworkControllerFactory factory;
+  RunBenchmark("pcc", &factory);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/alpha_blend_sse2.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+const int kBytesPerPixel = 4;
+
+// Blends two pixels, held in 16-bit lanes.
+__m128i BlendPixels(__m128i dest, __m128i src) {
+  // Spread the alpha of each pixel to all of its lanes, and invert it.
+  __m128i base_alpha = _mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+  base_alpha = _mm_shufflehi_epi16(base_alpha, _MM_SHUFFLE(3, 3, 3, 3));
+  base_alpha = _mm_sub_epi16(_mm_set1_epi16(255), base_alpha);
+  // dest * base_alpha / 255, where x / 255 == (x + 1 + (x >> 8)) >> 8 for the
+  // products of two bytes.
+  __m128i product = _mm_mullo_epi16(dest, base_alpha);
+  product = _mm_add_epi16(product, _mm_set1_epi16(1));
+  product = _mm_add_epi16(product, _mm_srli_epi16(product, 8));
+  product = _mm_srli_epi16(product, 8);
+  // Like the byte arithmetic of the C version, the sum wraps around.
+  return _mm_and_si128(_mm_add_epi16(product, src), _mm_set1_epi16(0xff));
+}
+
+}  // namespace
+
+extern void AlphaBlend_SSE2(uint8_t* dest,
+                            int dest_stride,
+                            const uint8_t* src,
+                            int src_stride,
+                            int width,
+                            int height) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+  for (int y = 0; y < height; ++y) {
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+      __m128i* dest_pixels =
+          reinterpret_cast<__m128i*>(dest + x * kBytesPerPixel);
+      const __m128i s = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(src + x * kBytesPerPixel));
+      const __m128i d = _mm_loadu_si128(dest_pixels);
+      __m128i blended = _mm_packus_epi16(
+          BlendPixels(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero)),
+          BlendPixels(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero)));
+      // The alpha of |dest| is kept, unless |src| is opaque and replaces it.
+      const __m128i src_opaque =
+          _mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), alpha_mask);
+      const __m128i alpha = _mm_or_si128(_mm_and_si128(src_opaque, s),
+                                         _mm_andnot_si128(src_opaque, d));
+      blended = _mm_or_si128(_mm_andnot_si128(alpha_mask, blended),
+                             _mm_and_si128(alpha_mask, alpha));
+      // Fully transparent pixels of |src| leave |dest| untouched.
+      const __m128i src_transparent =
+          _mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), zero);
+      blended = _mm_or_si128(_mm_and_si128(src_transparent, d),
+                             _mm_andnot_si128(src_transparent, blended));
+      _mm_storeu_si128(dest_pixels, blended);
+    }
+    for (; x < width; ++x) {
+      uint8_t* d = dest + x * kBytesPerPixel;
+      const uint8_t* s = src + x * kBytesPerPixel;
+      const uint32_t base_alpha = 255 - s[3];
+      if (base_alpha == 255) {
+        continue;
+      } else if (base_alpha == 0) {
+        d[0] = s[0];
+        d[1] = s[1];
+        d[2] = s[2];
+        d[3] = s[3];
+      } else {
+        d[0] = d[0] * base_alpha / 255 + s[0];
+        d[1] = d[1] * base_alpha / 255 + s[1];
+        d[2] = d[2] * base_alpha / 255 + s[2];
+      }
+    }
+    src += src_stride;
+    dest += dest_stride;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by desktop_and_cursor_composer.cc. It defines
+// the SSE2 routine for blending the mouse cursor into a frame.
+
+#ifndef MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_SSE2_H_
+#define MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_SSE2_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+
+// Blends the 32-bit pixels of |src|, which must be pre-multiplied with the
+// alpha channel, into |dest|, which is assumed to be opaque.
+extern void AlphaBlend_SSE2(uint8_t* dest,
+                            int dest_stride,
+                            const uint8_t* src,
+                            int src_stride,
+                            int width,
+                            int height);
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_SSE2_H_
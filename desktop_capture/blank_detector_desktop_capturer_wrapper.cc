@@ -21,6 +21,14 @@
 
 namespace webrtc {
 
+namespace {
+
+// Every kSampleDistance-th pixel of the frame, counted row by row, is checked.
+// That is 7489 pixels for a frame with 1024 x 768 resolution.
+constexpr int kSampleDistance = 105;
+
+}  // namespace
+
 BlankDetectorDesktopCapturerWrapper::BlankDetectorDesktopCapturerWrapper(
     std::unique_ptr<DesktopCapturer> capturer,
     RgbaColor blank_pixel)
@@ -77,7 +85,15 @@ void BlankDetectorDesktopCapturerWrapper::OnCaptureResult(
   // If nothing has been changed in current frame, we do not need to check it
   // again.
   if (!frame->updated_region().is_empty() || is_first_frame_) {
-    last_frame_is_blank_ = IsBlankFrame(*frame);
+    // Only blank frames get here after the first one, and the pixels outside
+    // of the updated region are unchanged, so they are still blank.
+    if (is_first_frame_ || !frame->size().equals(last_checked_frame_size_)) {
+      last_frame_is_blank_ = IsBlankRegion(
+          *frame, DesktopRegion(DesktopRect::MakeSize(frame->size())));
+    } else {
+      last_frame_is_blank_ = IsBlankRegion(*frame, frame->updated_region());
+    }
+    last_checked_frame_size_ = frame->size();
     is_first_frame_ = false;
   }
   RTC_HISTOGRAM_BOOLEAN("WebRTC.DesktopCapture.BlankFrameDetected",
@@ -92,20 +108,34 @@ void BlankDetectorDesktopCapturerWrapper::OnCaptureResult(
                              std::unique_ptr<DesktopFrame>());
 }
 
-bool BlankDetectorDesktopCapturerWrapper::IsBlankFrame(
-    const DesktopFrame& frame) const {
-  // We will check 7489 pixels for a frame with 1024 x 768 resolution.
-  for (int i = 0; i < frame.size().width() * frame.size().height(); i += 105) {
-    const int x = i % frame.size().width();
-    const int y = i / frame.size().width();
-    if (!IsBlankPixel(frame, x, y)) {
+bool BlankDetectorDesktopCapturerWrapper::IsBlankRegion(
+    const DesktopFrame& frame,
+    const DesktopRegion& region) const {
+  const int width = frame.size().width();
+  // We are verifying the pixel in the center as well.
+  const DesktopVector center(width / 2, frame.size().height() / 2);
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    DesktopRect rect = it.rect();
+    rect.IntersectWith(DesktopRect::MakeSize(frame.size()));
+    for (int y = rect.top(); y < rect.bottom(); ++y) {
+      // The first sampled pixel of the row, moved to the first one in |rect|,
+      // without walking the pixels before |rect|.
+      int x = (kSampleDistance - y * width % kSampleDistance) % kSampleDistance;
+      if (x < rect.left()) {
+        x += (rect.left() - x + kSampleDistance - 1) / kSampleDistance *
+             kSampleDistance;
+      }
+      for (; x < rect.right(); x += kSampleDistance) {
+        if (!IsBlankPixel(frame, x, y)) {
+          return false;
+        }
+      }
+    }
+    if (rect.Contains(center) && !IsBlankPixel(frame, center.x(), center.y())) {
       return false;
     }
   }
-
-  // We are verifying the pixel in the center as well.
-  return IsBlankPixel(frame, frame.size().width() / 2,
-                      frame.size().height() / 2);
+  return true;
 }
 
 bool BlankDetectorDesktopCapturerWrapper::IsBlankPixel(
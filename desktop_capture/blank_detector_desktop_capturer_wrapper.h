@@ -16,6 +16,8 @@
 #include "modules/desktop_capture/desktop_capture_types.h"
 #include "modules/desktop_capture/desktop_capturer.h"
 #include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
 #include "modules/desktop_capture/rgba_color.h"
 #include "modules/desktop_capture/shared_memory.h"
 
@@ -52,7 +54,10 @@ class BlankDetectorDesktopCapturerWrapper final
   void OnCaptureResult(Result result,
                        std::unique_ptr<DesktopFrame> frame) override;
 
-  bool IsBlankFrame(const DesktopFrame& frame) const;
+  // Detects whether the sampled pixels of |frame| within |region| all equal
+  // to |blank_pixel_|.
+  bool IsBlankRegion(const DesktopFrame& frame,
+                     const DesktopRegion& region) const;
 
   // Detects whether pixel at (x, y) equals to |blank_pixel_|.
   bool IsBlankPixel(const DesktopFrame& frame, int x, int y) const;
@@ -69,6 +74,9 @@ class BlankDetectorDesktopCapturerWrapper final
   // Whether current frame is the first frame.
   bool is_first_frame_ = true;
 
+  // The size of the last frame checked by IsBlankRegion().
+  DesktopSize last_checked_frame_size_;
+
   DesktopCapturer::Callback* callback_ = nullptr;
 };
 
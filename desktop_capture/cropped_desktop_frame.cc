@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/desktop_capture/desktop_region.h"
 #include "rtc_base/checks.h"
@@ -59,6 +60,23 @@ CroppedDesktopFrame::CroppedDesktopFrame(std::unique_ptr<DesktopFrame> frame,
   set_top_left(frame_->top_left().add(rect.top_left()));
   mutable_updated_region()->IntersectWith(rect);
   mutable_updated_region()->Translate(-rect.left(), -rect.top());
+
+  // Keeps the part of each move whose source and destination are both inside
+  // |rect|.
+  std::vector<DesktopMoveRect> moves;
+  moves.swap(*mutable_move_rects());
+  for (const DesktopMoveRect& move : moves) {
+    const DesktopVector offset = move.source.subtract(move.dest.top_left());
+    DesktopRect dest = move.dest;
+    dest.IntersectWith(rect);
+    DesktopRect source_rect = rect;
+    source_rect.Translate(-offset.x(), -offset.y());
+    dest.IntersectWith(source_rect);
+    if (dest.is_empty())
+      continue;
+    dest.Translate(-rect.left(), -rect.top());
+    mutable_move_rects()->push_back({dest.top_left().add(offset), dest});
+  }
 }
 
 }  // namespace webrtc
@@ -107,4 +107,27 @@ TEST(CroppedDesktopFrameTest, IccProfile) {
   EXPECT_EQ(shared_other->icc_profile(), icc_profile);
 }
 
+TEST(CroppedDesktopFrameTest, CropsMoveRects) {
+  std::unique_ptr<DesktopFrame> frame = CreateTestFrame();
+  // Entirely inside the crop rect.
+  frame->mutable_move_rects()->push_back(
+      {DesktopVector(2, 4), DesktopRect::MakeLTRB(2, 2, 8, 10)});
+  // Only the part that moved from inside the crop rect is kept.
+  frame->mutable_move_rects()->push_back(
+      {DesktopVector(2, 14), DesktopRect::MakeLTRB(2, 12, 8, 20)});
+  // Outside of the crop rect.
+  frame->mutable_move_rects()->push_back(
+      {DesktopVector(0, 0), DesktopRect::MakeLTRB(0, 0, 2, 20)});
+
+  frame = CreateCroppedDesktopFrame(std::move(frame),
+                                    DesktopRect::MakeLTRB(2, 2, 8, 18));
+  ASSERT_EQ(2u, frame->move_rects().size());
+  EXPECT_TRUE(frame->move_rects()[0].source.equals(DesktopVector(0, 2)));
+  EXPECT_TRUE(
+      frame->move_rects()[0].dest.equals(DesktopRect::MakeLTRB(0, 0, 6, 8)));
+  EXPECT_TRUE(frame->move_rects()[1].source.equals(DesktopVector(0, 12)));
+  EXPECT_TRUE(
+      frame->move_rects()[1].dest.equals(DesktopRect::MakeLTRB(0, 10, 6, 14)));
+}
+
 }  // namespace webrtc
@@ -230,7 +230,9 @@ std::unique_ptr<DesktopCapturer> CroppingWindowCapturer::CreateCapturer(
   std::unique_ptr<DesktopCapturer> capturer(
       new CroppingWindowCapturerWin(options));
   if (capturer && options.detect_updated_region()) {
-    capturer.reset(new DesktopCapturerDifferWrapper(std::move(capturer)));
+    capturer.reset(new DesktopCapturerDifferWrapper(
+        std::move(capturer), options.num_differ_threads(),
+        options.detect_moved_regions()));
   }
 
   return capturer;
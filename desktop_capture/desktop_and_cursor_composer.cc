@@ -16,12 +16,19 @@
 #include <memory>
 #include <utility>
 
+#include "modules/desktop_capture/alpha_blend_sse2.h"
 #include "modules/desktop_capture/desktop_capturer.h"
 #include "modules/desktop_capture/desktop_frame.h"
 #include "modules/desktop_capture/mouse_cursor.h"
 #include "modules/desktop_capture/mouse_cursor_monitor.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace webrtc {
 
@@ -29,13 +36,14 @@ namespace {
 
 // Helper function that blends one image into another. Source image must be
 // pre-multiplied with the alpha channel. Destination is assumed to be opaque.
-void AlphaBlend(uint8_t* dest,
-                int dest_stride,
-                const uint8_t* src,
-                int src_stride,
-                const DesktopSize& size) {
-  for (int y = 0; y < size.height(); ++y) {
-    for (int x = 0; x < size.width(); ++x) {
+void AlphaBlend_C(uint8_t* dest,
+                  int dest_stride,
+                  const uint8_t* src,
+                  int src_stride,
+                  int width,
+                  int height) {
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
       uint32_t base_alpha = 255 - src[x * DesktopFrame::kBytesPerPixel + 3];
       if (base_alpha == 255) {
         continue;
@@ -60,6 +68,71 @@ void AlphaBlend(uint8_t* dest,
   }
 }
 
+#if defined(WEBRTC_HAS_NEON)
+void AlphaBlend_NEON(uint8_t* dest,
+                     int dest_stride,
+                     const uint8_t* src,
+                     int src_stride,
+                     int width,
+                     int height) {
+  const int vector_width = width - width % 8;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < vector_width; x += 8) {
+      uint8_t* dest_pixels = dest + x * DesktopFrame::kBytesPerPixel;
+      // Loads 8 pixels, with one channel per vector.
+      uint8x8x4_t d = vld4_u8(dest_pixels);
+      const uint8x8x4_t s = vld4_u8(src + x * DesktopFrame::kBytesPerPixel);
+      const uint8x8_t base_alpha = vmvn_u8(s.val[3]);
+      const uint8x8_t transparent = vceq_u8(s.val[3], vdup_n_u8(0));
+      const uint8x8_t opaque = vceq_u8(s.val[3], vdup_n_u8(255));
+      for (int c = 0; c < 3; ++c) {
+        // dest * base_alpha / 255, where x / 255 == (x + 1 + (x >> 8)) >> 8
+        // for the products of two bytes.
+        uint16x8_t product = vmull_u8(d.val[c], base_alpha);
+        product = vaddq_u16(product, vdupq_n_u16(1));
+        product = vsraq_n_u16(product, product, 8);
+        const uint8x8_t blended = vadd_u8(vshrn_n_u16(product, 8), s.val[c]);
+        d.val[c] = vbsl_u8(transparent, d.val[c], blended);
+      }
+      d.val[3] = vbsl_u8(opaque, s.val[3], d.val[3]);
+      vst4_u8(dest_pixels, d);
+    }
+    // Blends the remaining pixels of the row.
+    AlphaBlend_C(dest + vector_width * DesktopFrame::kBytesPerPixel,
+                 dest_stride,
+                 src + vector_width * DesktopFrame::kBytesPerPixel, src_stride,
+                 width - vector_width, 1);
+    src += src_stride;
+    dest += dest_stride;
+  }
+}
+#endif
+
+using AlphaBlendProc = void (*)(uint8_t*, int, const uint8_t*, int, int, int);
+
+AlphaBlendProc SelectAlphaBlend() {
+#if defined(WEBRTC_HAS_NEON)
+  return &AlphaBlend_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0)
+    return &AlphaBlend_SSE2;
+  return &AlphaBlend_C;
+#else
+  return &AlphaBlend_C;
+#endif
+}
+
+void AlphaBlend(uint8_t* dest,
+                int dest_stride,
+                const uint8_t* src,
+                int src_stride,
+                const DesktopSize& size) {
+  // Initialized once in a thread-safe way, since several capturers may run
+  // on different threads.
+  static const AlphaBlendProc blend_proc = SelectAlphaBlend();
+  blend_proc(dest, dest_stride, src, src_stride, size.width(), size.height());
+}
+
 // DesktopFrame wrapper that draws mouse on a frame and restores original
 // content before releasing the underlying frame.
 class DesktopFrameWithCursor : public DesktopFrame {
@@ -70,9 +143,14 @@ class DesktopFrameWithCursor : public DesktopFrame {
                          const DesktopVector& position);
   ~DesktopFrameWithCursor() override;
 
+  // The part of the frame the cursor was drawn on.
+  const DesktopRect& cursor_rect() const { return cursor_rect_; }
+
  private:
   const std::unique_ptr<DesktopFrame> original_frame_;
 
+  DesktopRect cursor_rect_;
+
   DesktopVector restore_position_;
   std::unique_ptr<DesktopFrame> restore_frame_;
 
@@ -98,6 +176,7 @@ DesktopFrameWithCursor::DesktopFrameWithCursor(
 
   if (target_rect.is_empty())
     return;
+  cursor_rect_ = target_rect;
 
   // Copy original screen content under cursor to |restore_frame_|.
   restore_position_ = target_rect.top_left();
@@ -169,6 +248,7 @@ void DesktopAndCursorComposer::SetExcludedWindow(WindowId window) {
 void DesktopAndCursorComposer::OnCaptureResult(
     DesktopCapturer::Result result,
     std::unique_ptr<DesktopFrame> frame) {
+  DesktopRect cursor_rect;
   if (frame && cursor_) {
     if (frame->rect().Contains(cursor_position_) &&
         !desktop_capturer_->IsOccluded(cursor_position_)) {
@@ -185,9 +265,26 @@ void DesktopAndCursorComposer::OnCaptureResult(
       relative_position.set(relative_position.x() * scale,
                             relative_position.y() * scale);
 #endif
-      frame = std::make_unique<DesktopFrameWithCursor>(
+      auto frame_with_cursor = std::make_unique<DesktopFrameWithCursor>(
           std::move(frame), *cursor_, relative_position);
+      cursor_rect = frame_with_cursor->cursor_rect();
+      frame = std::move(frame_with_cursor);
+    }
+  }
+
+  if (frame) {
+    // The capturer only reports what changed on the screen, so the cursor is
+    // added to the updated region when it moved or changed shape, both where
+    // it was drawn before and where it is drawn now. A cursor that stays put
+    // over unchanged content is drawn over the same pixels again.
+    if (cursor_changed_ || !cursor_rect.equals(last_cursor_rect_)) {
+      DesktopRect last_cursor_rect = last_cursor_rect_;
+      last_cursor_rect.IntersectWith(DesktopRect::MakeSize(frame->size()));
+      frame->mutable_updated_region()->AddRect(last_cursor_rect);
+      frame->mutable_updated_region()->AddRect(cursor_rect);
     }
+    last_cursor_rect_ = cursor_rect;
+    cursor_changed_ = false;
   }
 
   callback_->OnCaptureResult(result, std::move(frame));
@@ -195,6 +292,7 @@ void DesktopAndCursorComposer::OnCaptureResult(
 
 void DesktopAndCursorComposer::OnMouseCursor(MouseCursor* cursor) {
   cursor_.reset(cursor);
+  cursor_changed_ = true;
 }
 
 void DesktopAndCursorComposer::OnMouseCursorPosition(
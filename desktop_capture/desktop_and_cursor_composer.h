@@ -74,6 +74,10 @@ class RTC_EXPORT DesktopAndCursorComposer
 
   std::unique_ptr<MouseCursor> cursor_;
   DesktopVector cursor_position_;
+  // Set when |cursor_| is replaced, until the next frame is delivered.
+  bool cursor_changed_ = false;
+  // Where the cursor was drawn on the last delivered frame, empty if it wasn't.
+  DesktopRect last_cursor_rect_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(DesktopAndCursorComposer);
 };
@@ -144,6 +144,7 @@ class FakeMouseMonitor : public MouseCursorMonitor {
       }
 
       callback_->OnMouseCursor(new MouseCursor(image.release(), hotspot_));
+      changed_ = false;
     }
 
     callback_->OnMouseCursorPosition(position_);
@@ -324,4 +325,36 @@ TEST_F(DesktopAndCursorComposerTest, CursorIncluded) {
   }
 }
 
+TEST_F(DesktopAndCursorComposerTest, UpdatedRegionIncludesCursorChanges) {
+  std::unique_ptr<SharedDesktopFrame> frame(
+      SharedDesktopFrame::Wrap(CreateTestFrame()));
+
+  // The first frame shows the cursor.
+  fake_screen_->SetNextFrame(frame->Share());
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE, DesktopVector(20, 20));
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  EXPECT_TRUE(frame_->updated_region().Equals(DesktopRegion(
+      DesktopRect::MakeXYWH(20, 20, kCursorWidth, kCursorHeight))));
+  frame_.reset();
+
+  // A cursor that didn't move doesn't update the frame.
+  fake_screen_->SetNextFrame(frame->Share());
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  EXPECT_TRUE(frame_->updated_region().is_empty());
+  frame_.reset();
+
+  // A moved cursor updates where it was and where it is.
+  fake_screen_->SetNextFrame(frame->Share());
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE, DesktopVector(50, 60));
+  blender_.CaptureFrame();
+  ASSERT_TRUE(frame_);
+  DesktopRegion expected_region(
+      DesktopRect::MakeXYWH(20, 20, kCursorWidth, kCursorHeight));
+  expected_region.AddRect(
+      DesktopRect::MakeXYWH(50, 60, kCursorWidth, kCursorHeight));
+  EXPECT_TRUE(frame_->updated_region().Equals(expected_region));
+}
+
 }  // namespace webrtc
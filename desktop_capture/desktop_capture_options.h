@@ -10,6 +10,8 @@
 #ifndef MODULES_DESKTOP_CAPTURE_DESKTOP_CAPTURE_OPTIONS_H_
 #define MODULES_DESKTOP_CAPTURE_DESKTOP_CAPTURE_OPTIONS_H_
 
+#include <stddef.h>
+
 #include "api/scoped_refptr.h"
 #include "rtc_base/system/rtc_export.h"
 
@@ -24,6 +26,10 @@
 
 namespace webrtc {
 
+#if defined(WEBRTC_WIN)
+class DxgiTextureCallback;
+#endif
+
 // An object that stores initialization parameters for screen and window
 // capturers.
 class RTC_EXPORT DesktopCaptureOptions {
@@ -99,6 +105,29 @@ class RTC_EXPORT DesktopCaptureOptions {
     detect_updated_region_ = detect_updated_region;
   }
 
+  // Flag that should be set if the consumer uses DesktopFrame::move_rects(),
+  // e.g. as motion hints for encoding scrolled content. Only takes effect
+  // together with detect_updated_region().
+  bool detect_moved_regions() const { return detect_moved_regions_; }
+  void set_detect_moved_regions(bool detect_moved_regions) {
+    detect_moved_regions_ = detect_moved_regions;
+  }
+
+  // Number of threads used to compare frames when detect_updated_region() is
+  // set. Large updated regions are split into bands that are compared in
+  // parallel, which helps when sharing high resolution screens.
+  int num_differ_threads() const { return num_differ_threads_; }
+  void set_num_differ_threads(int num_differ_threads) {
+    num_differ_threads_ = num_differ_threads;
+  }
+
+  // Number of released frames whose buffers the capturers that allocate a
+  // frame per capture keep for reuse, see DesktopFramePool.
+  size_t max_pooled_frames() const { return max_pooled_frames_; }
+  void set_max_pooled_frames(size_t max_pooled_frames) {
+    max_pooled_frames_ = max_pooled_frames;
+  }
+
 #if defined(WEBRTC_WIN)
   bool allow_use_magnification_api() const {
     return allow_use_magnification_api_;
@@ -113,6 +142,19 @@ class RTC_EXPORT DesktopCaptureOptions {
     allow_directx_capturer_ = enabled;
   }
 
+  // If set, the directx based capturer delivers single monitor captures as
+  // shared textures to this callback instead of copying them into the
+  // DesktopFrame, whenever the monitor supports it. The callback must outlive
+  // the capturers created with these options. Since the frames carry no
+  // pixels then, this should not be combined with detect_updated_region() or
+  // allow_cropping_window_capturer(). See DxgiTextureCallback.
+  DxgiTextureCallback* dxgi_texture_callback() const {
+    return dxgi_texture_callback_;
+  }
+  void set_dxgi_texture_callback(DxgiTextureCallback* callback) {
+    dxgi_texture_callback_ = callback;
+  }
+
   // Flag that may be set to allow use of the cropping window capturer (which
   // captures the screen & crops that to the window region in some cases). An
   // advantage of using this is significantly higher capture frame rates than
@@ -150,6 +192,7 @@ class RTC_EXPORT DesktopCaptureOptions {
 #if defined(WEBRTC_WIN)
   bool allow_use_magnification_api_ = false;
   bool allow_directx_capturer_ = false;
+  DxgiTextureCallback* dxgi_texture_callback_ = nullptr;
   bool allow_cropping_window_capturer_ = false;
 #endif
 #if defined(USE_X11)
@@ -159,6 +202,9 @@ class RTC_EXPORT DesktopCaptureOptions {
 #endif
   bool disable_effects_ = true;
   bool detect_updated_region_ = false;
+  bool detect_moved_regions_ = false;
+  int num_differ_threads_ = 1;
+  size_t max_pooled_frames_ = 2;
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
 #endif
@@ -56,7 +56,9 @@ std::unique_ptr<DesktopCapturer> DesktopCapturer::CreateWindowCapturer(
 
   std::unique_ptr<DesktopCapturer> capturer = CreateRawWindowCapturer(options);
   if (capturer && options.detect_updated_region()) {
-    capturer.reset(new DesktopCapturerDifferWrapper(std::move(capturer)));
+    capturer.reset(new DesktopCapturerDifferWrapper(
+        std::move(capturer), options.num_differ_threads(),
+        options.detect_moved_regions()));
   }
 
   return capturer;
@@ -67,7 +69,9 @@ std::unique_ptr<DesktopCapturer> DesktopCapturer::CreateScreenCapturer(
     const DesktopCaptureOptions& options) {
   std::unique_ptr<DesktopCapturer> capturer = CreateRawScreenCapturer(options);
   if (capturer && options.detect_updated_region()) {
-    capturer.reset(new DesktopCapturerDifferWrapper(std::move(capturer)));
+    capturer.reset(new DesktopCapturerDifferWrapper(
+        std::move(capturer), options.num_differ_threads(),
+        options.detect_moved_regions()));
   }
 
   return capturer;
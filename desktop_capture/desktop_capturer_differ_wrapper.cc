@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <utility>
 
 #include "modules/desktop_capture/desktop_geometry.h"
@@ -25,6 +26,10 @@ namespace webrtc {
 
 namespace {
 
+// Rects with fewer block rows per band than this are compared on a single
+// thread, since handing them to the band workers costs more than it saves.
+constexpr int kMinBlockRowsPerBand = 4;
+
 // Returns true if (0, 0) - (|width|, |height|) vector in |old_buffer| and
 // |new_buffer| are equal. |width| should be less than 32
 // (defined by kBlockSize), otherwise BlockDifference() should be used.
@@ -146,8 +151,30 @@ void CompareFrames(const DesktopFrame& old_frame,
 
 DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
     std::unique_ptr<DesktopCapturer> base_capturer)
-    : base_capturer_(std::move(base_capturer)) {
+    : DesktopCapturerDifferWrapper(std::move(base_capturer), 1) {}
+
+DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    int num_threads)
+    : DesktopCapturerDifferWrapper(std::move(base_capturer),
+                                   num_threads,
+                                   false) {}
+
+DesktopCapturerDifferWrapper::DesktopCapturerDifferWrapper(
+    std::unique_ptr<DesktopCapturer> base_capturer,
+    int num_threads,
+    bool detect_moved_regions)
+    : base_capturer_(std::move(base_capturer)),
+      num_bands_(num_threads),
+      band_regions_(num_threads),
+      move_detector_(detect_moved_regions ? new MoveDetector() : nullptr) {
   RTC_DCHECK(base_capturer_);
+  RTC_DCHECK_GT(num_bands_, 0);
+  for (int i = 1; i < num_bands_; ++i) {
+    band_workers_.push_back(
+        std::make_unique<TaskThread>("DifferBandWorker", rtc::kHighPriority));
+  }
+  band_tasks_.resize(band_workers_.size());
 }
 
 DesktopCapturerDifferWrapper::~DesktopCapturerDifferWrapper() {}
@@ -208,8 +235,22 @@ void DesktopCapturerDifferWrapper::OnCaptureResult(
     DesktopRegion hints;
     hints.Swap(frame->mutable_updated_region());
     for (DesktopRegion::Iterator it(hints); !it.IsAtEnd(); it.Advance()) {
-      CompareFrames(*last_frame_, *frame, it.rect(),
+      if (!move_detector_) {
+        CompareRect(*last_frame_, *frame, it.rect(),
                     frame->mutable_updated_region());
+        continue;
+      }
+
+      // Moves are searched for in the bounding rect of what changed, which
+      // for a scrolled window is usually the scrolled content.
+      DesktopRegion updated;
+      CompareRect(*last_frame_, *frame, it.rect(), &updated);
+      DesktopRect bounds;
+      for (DesktopRegion::Iterator u(updated); !u.IsAtEnd(); u.Advance())
+        bounds.UnionWith(u.rect());
+      move_detector_->DetectMoves(*last_frame_, *frame, bounds,
+                                  frame->mutable_move_rects());
+      frame->mutable_updated_region()->AddRegion(updated);
     }
   } else {
     frame->mutable_updated_region()->SetRect(
@@ -223,4 +264,45 @@ void DesktopCapturerDifferWrapper::OnCaptureResult(
   callback_->OnCaptureResult(result, std::move(frame));
 }
 
+void DesktopCapturerDifferWrapper::CompareRect(const DesktopFrame& old_frame,
+                                               const DesktopFrame& new_frame,
+                                               const DesktopRect& rect,
+                                               DesktopRegion* output) {
+  DesktopRect frame_rect = rect;
+  frame_rect.IntersectWith(DesktopRect::MakeSize(new_frame.size()));
+  const int block_rows = (frame_rect.height() + kBlockSize - 1) / kBlockSize;
+  const int num_bands = std::min(num_bands_, block_rows / kMinBlockRowsPerBand);
+  if (num_bands <= 1) {
+    CompareFrames(old_frame, new_frame, rect, output);
+    return;
+  }
+
+  // Bands start on block row boundaries of |frame_rect|, so that the blocks
+  // compared are the same as when comparing the whole rect at once.
+  auto compare_band = [&](int band) {
+    const int first_block_row = band * block_rows / num_bands;
+    const int end_block_row = (band + 1) * block_rows / num_bands;
+    const int top = frame_rect.top() + first_block_row * kBlockSize;
+    const int bottom = std::min(frame_rect.bottom(),
+                                frame_rect.top() + end_block_row * kBlockSize);
+    band_regions_[band].Clear();
+    CompareFrames(old_frame, new_frame,
+                  DesktopRect::MakeLTRB(frame_rect.left(), top,
+                                        frame_rect.right(), bottom),
+                  &band_regions_[band]);
+  };
+  for (int band = 1; band < num_bands; ++band) {
+    BandTask& task = band_tasks_[band - 1];
+    task.compare_band = compare_band;
+    task.band = band;
+    band_workers_[band - 1]->StartTask(task);
+  }
+  compare_band(0);
+  for (int band = 1; band < num_bands; ++band)
+    band_workers_[band - 1]->Wait();
+
+  for (int band = 0; band < num_bands; ++band)
+    output->AddRegion(band_regions_[band]);
+}
+
 }  // namespace webrtc
@@ -12,13 +12,18 @@
 #define MODULES_DESKTOP_CAPTURE_DESKTOP_CAPTURER_DIFFER_WRAPPER_H_
 
 #include <memory>
+#include <vector>
 
+#include "api/function_view.h"
 #include "modules/desktop_capture/desktop_capture_types.h"
 #include "modules/desktop_capture/desktop_capturer.h"
 #include "modules/desktop_capture/desktop_frame.h"
 #include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "modules/desktop_capture/move_detector.h"
 #include "modules/desktop_capture/shared_desktop_frame.h"
 #include "modules/desktop_capture/shared_memory.h"
+#include "modules/utility/include/task_thread.h"
 
 namespace webrtc {
 
@@ -38,6 +43,18 @@ class DesktopCapturerDifferWrapper : public DesktopCapturer,
   explicit DesktopCapturerDifferWrapper(
       std::unique_ptr<DesktopCapturer> base_capturer);
 
+  // Same as above, but compares large updated regions of a frame in bands of
+  // block rows on |num_threads| threads, including the capturing thread.
+  DesktopCapturerDifferWrapper(std::unique_ptr<DesktopCapturer> base_capturer,
+                               int num_threads);
+
+  // Same as above, but also reports content that was scrolled since the
+  // previous frame in DesktopFrame::move_rects() if |detect_moved_regions| is
+  // true, see MoveDetector.
+  DesktopCapturerDifferWrapper(std::unique_ptr<DesktopCapturer> base_capturer,
+                               int num_threads,
+                               bool detect_moved_regions);
+
   ~DesktopCapturerDifferWrapper() override;
 
   // DesktopCapturer interface.
@@ -52,13 +69,39 @@ class DesktopCapturerDifferWrapper : public DesktopCapturer,
   bool IsOccluded(const DesktopVector& pos) override;
 
  private:
+  // The band handed to a worker thread by CompareRect().
+  struct BandTask {
+    void operator()() const { compare_band(band); }
+
+    rtc::FunctionView<void(int band)> compare_band;
+    int band = 0;
+  };
+
   // DesktopCapturer::Callback interface.
   void OnCaptureResult(Result result,
                        std::unique_ptr<DesktopFrame> frame) override;
 
+  // Compares |rect| area in |old_frame| and |new_frame|, splitting it into
+  // bands if it is large enough, and adds dirty regions to |output|.
+  void CompareRect(const DesktopFrame& old_frame,
+                   const DesktopFrame& new_frame,
+                   const DesktopRect& rect,
+                   DesktopRegion* output);
+
   const std::unique_ptr<DesktopCapturer> base_capturer_;
   DesktopCapturer::Callback* callback_;
   std::unique_ptr<SharedDesktopFrame> last_frame_;
+
+  const int num_bands_;
+  // One per band except the first, which runs on the capturing thread.
+  std::vector<std::unique_ptr<TaskThread>> band_workers_;
+  // The tasks of |band_workers_|, kept here as the workers don't copy them.
+  std::vector<BandTask> band_tasks_;
+  // Dirty regions found in each band of the rect being compared.
+  std::vector<DesktopRegion> band_regions_;
+
+  // Null unless moved regions are detected.
+  const std::unique_ptr<MoveDetector> move_detector_;
 };
 
 }  // namespace webrtc
@@ -153,7 +153,9 @@ void ExecuteCapturer(DesktopCapturerDifferWrapper* capturer,
 void ExecuteDifferWrapperTest(bool with_hints,
                               bool enlarge_updated_region,
                               bool random_updated_region,
-                              bool check_result) {
+                              bool check_result,
+                              int num_threads = 1,
+                              bool detect_moved_regions = false) {
   const bool updated_region_should_exactly_match =
       with_hints && !enlarge_updated_region && !random_updated_region;
   BlackWhiteDesktopFramePainter frame_painter;
@@ -161,7 +163,8 @@ void ExecuteDifferWrapperTest(bool with_hints,
   frame_generator.set_desktop_frame_painter(&frame_painter);
   std::unique_ptr<FakeDesktopCapturer> fake(new FakeDesktopCapturer());
   fake->set_frame_generator(&frame_generator);
-  DesktopCapturerDifferWrapper capturer(std::move(fake));
+  DesktopCapturerDifferWrapper capturer(std::move(fake), num_threads,
+                                        detect_moved_regions);
   MockDesktopCapturerCallback callback;
   frame_generator.set_provide_updated_region_hints(with_hints);
   frame_generator.set_enlarge_updated_region(enlarge_updated_region);
@@ -244,6 +247,18 @@ TEST(DesktopCapturerDifferWrapperTest, CaptureWithEnlargedAndRandomHints) {
   ExecuteDifferWrapperTest(true, true, true, true);
 }
 
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithoutHintsInBands) {
+  ExecuteDifferWrapperTest(false, false, false, true, 3);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithRandomHintsInBands) {
+  ExecuteDifferWrapperTest(true, false, true, true, 3);
+}
+
+TEST(DesktopCapturerDifferWrapperTest, CaptureWithRandomHintsDetectingMoves) {
+  ExecuteDifferWrapperTest(true, false, true, true, 1, true);
+}
+
 // When hints are provided, DesktopCapturerDifferWrapper has a slightly better
 // performance in current configuration, but not so significant. Following is
 // one run result.
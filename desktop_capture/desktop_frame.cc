@@ -44,8 +44,15 @@ void DesktopFrame::CopyPixelsFrom(const uint8_t* src_buffer,
   RTC_CHECK(DesktopRect::MakeSize(size()).ContainsRect(dest_rect));
 
   uint8_t* dest = GetFrameDataAtPos(dest_rect.top_left());
+  const int row_bytes = DesktopFrame::kBytesPerPixel * dest_rect.width();
+  if (row_bytes == stride() && row_bytes == src_stride) {
+    // Both buffers store the rows back to back, copy them at once.
+    memcpy(dest, src_buffer, row_bytes * dest_rect.height());
+    return;
+  }
+
   for (int y = 0; y < dest_rect.height(); ++y) {
-    memcpy(dest, src_buffer, DesktopFrame::kBytesPerPixel * dest_rect.width());
+    memcpy(dest, src_buffer, row_bytes);
     src_buffer += src_stride;
     dest += stride();
   }
@@ -132,6 +139,7 @@ void DesktopFrame::CopyFrameInfoFrom(const DesktopFrame& other) {
   set_capture_time_ms(other.capture_time_ms());
   set_capturer_id(other.capturer_id());
   *mutable_updated_region() = other.updated_region();
+  move_rects_ = other.move_rects();
   set_top_left(other.top_left());
   set_icc_profile(other.icc_profile());
 }
@@ -141,6 +149,7 @@ void DesktopFrame::MoveFrameInfoFrom(DesktopFrame* other) {
   set_capture_time_ms(other->capture_time_ms());
   set_capturer_id(other->capturer_id());
   mutable_updated_region()->Swap(other->mutable_updated_region());
+  move_rects_.swap(*other->mutable_move_rects());
   set_top_left(other->top_left());
   set_icc_profile(other->icc_profile());
 }
@@ -158,11 +167,8 @@ BasicDesktopFrame::~BasicDesktopFrame() {
 // static
 DesktopFrame* BasicDesktopFrame::CopyOf(const DesktopFrame& frame) {
   DesktopFrame* result = new BasicDesktopFrame(frame.size());
-  for (int y = 0; y < frame.size().height(); ++y) {
-    memcpy(result->data() + y * result->stride(),
-           frame.data() + y * frame.stride(),
-           frame.size().width() * kBytesPerPixel);
-  }
+  result->CopyPixelsFrom(frame.data(), frame.stride(),
+                         DesktopRect::MakeSize(frame.size()));
   result->CopyFrameInfoFrom(frame);
   return result;
 }
@@ -26,6 +26,14 @@ namespace webrtc {
 
 const float kStandardDPI = 96.0f;
 
+// An area of a frame whose content was at another position in the previous
+// frame, e.g. after scrolling. |dest| is the area in this frame, |source| the
+// top-left corner of the same content in the previous frame.
+struct DesktopMoveRect {
+  DesktopVector source;
+  DesktopRect dest;
+};
+
 // DesktopFrame represents a video frame captured from the screen.
 class RTC_EXPORT DesktopFrame {
  public:
@@ -67,6 +75,15 @@ class RTC_EXPORT DesktopFrame {
   const DesktopRegion& updated_region() const { return updated_region_; }
   DesktopRegion* mutable_updated_region() { return &updated_region_; }
 
+  // Areas of the frame that moved since the previous frame. The moved areas
+  // are still part of updated_region(); they are hints that encoders may use
+  // to find the motion, e.g. of scrolled content. Usually empty, unless the
+  // capturer detects moves.
+  const std::vector<DesktopMoveRect>& move_rects() const {
+    return move_rects_;
+  }
+  std::vector<DesktopMoveRect>* mutable_move_rects() { return &move_rects_; }
+
   // DPI of the screen being captured. May be set to zero, e.g. if DPI is
   // unknown.
   const DesktopVector& dpi() const { return dpi_; }
@@ -148,6 +165,7 @@ class RTC_EXPORT DesktopFrame {
   const int stride_;
 
   DesktopRegion updated_region_;
+  std::vector<DesktopMoveRect> move_rects_;
   DesktopVector top_left_;
   DesktopVector dpi_;
   int64_t capture_time_ms_;
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+namespace {
+
+int RoundUpToGranularity(int value) {
+  return (value + DesktopFramePool::kSizeGranularity - 1) /
+         DesktopFramePool::kSizeGranularity *
+         DesktopFramePool::kSizeGranularity;
+}
+
+}  // namespace
+
+// The buffers of released frames, shared by the pool and its frames so that
+// frames released after the pool still have somewhere to go.
+class DesktopFramePool::FreeFrames : public rtc::RefCountInterface {
+ public:
+  explicit FreeFrames(size_t max_frames) : max_frames_(max_frames) {}
+
+  // Returns the smallest buffer that |size| fits in, or nullptr if none does.
+  std::unique_ptr<DesktopFrame> Take(const DesktopSize& size) {
+    rtc::CritScope lock(&crit_);
+    auto best = frames_.end();
+    for (auto it = frames_.begin(); it != frames_.end(); ++it) {
+      const DesktopSize& buffer_size = (*it)->size();
+      if (buffer_size.width() < size.width() ||
+          buffer_size.height() < size.height()) {
+        continue;
+      }
+      if (best == frames_.end() ||
+          buffer_size.width() * buffer_size.height() <
+              (*best)->size().width() * (*best)->size().height()) {
+        best = it;
+      }
+    }
+    if (best == frames_.end())
+      return nullptr;
+    std::unique_ptr<DesktopFrame> frame = std::move(*best);
+    frames_.erase(best);
+    return frame;
+  }
+
+  // Keeps |frame| for reuse, dropping the least recently released buffer if
+  // the maximum is reached.
+  void Put(std::unique_ptr<DesktopFrame> frame) {
+    rtc::CritScope lock(&crit_);
+    if (max_frames_ == 0)
+      return;
+    if (frames_.size() == max_frames_)
+      frames_.erase(frames_.begin());
+    frames_.push_back(std::move(frame));
+  }
+
+ protected:
+  ~FreeFrames() override = default;
+
+ private:
+  const size_t max_frames_;
+  rtc::CriticalSection crit_;
+  // Ordered from the least to the most recently released.
+  std::vector<std::unique_ptr<DesktopFrame>> frames_ RTC_GUARDED_BY(crit_);
+};
+
+// A frame using the buffer of a pooled frame, which goes back to the pool
+// when this frame is destroyed.
+class DesktopFramePool::PooledFrame : public DesktopFrame {
+ public:
+  PooledFrame(const DesktopSize& size,
+              std::unique_ptr<DesktopFrame> buffer,
+              rtc::scoped_refptr<FreeFrames> free_frames)
+      : DesktopFrame(size,
+                     buffer->stride(),
+                     buffer->data(),
+                     buffer->shared_memory()),
+        buffer_(std::move(buffer)),
+        free_frames_(std::move(free_frames)) {}
+
+  ~PooledFrame() override { free_frames_->Put(std::move(buffer_)); }
+
+ private:
+  std::unique_ptr<DesktopFrame> buffer_;
+  const rtc::scoped_refptr<FreeFrames> free_frames_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PooledFrame);
+};
+
+DesktopFramePool::DesktopFramePool(size_t max_free_frames)
+    : max_free_frames_(max_free_frames),
+      free_frames_(new rtc::RefCountedObject<FreeFrames>(max_free_frames)) {}
+
+DesktopFramePool::~DesktopFramePool() = default;
+
+std::unique_ptr<DesktopFrame> DesktopFramePool::CreateFrame(
+    const DesktopSize& size) {
+  std::unique_ptr<DesktopFrame> buffer = free_frames_->Take(size);
+  if (!buffer) {
+    const DesktopSize buffer_size(RoundUpToGranularity(size.width()),
+                                  RoundUpToGranularity(size.height()));
+    if (shared_memory_factory_) {
+      buffer = SharedMemoryDesktopFrame::Create(buffer_size,
+                                                shared_memory_factory_.get());
+      if (!buffer)
+        return nullptr;
+    } else {
+      buffer = std::make_unique<BasicDesktopFrame>(buffer_size);
+    }
+  }
+  return std::make_unique<PooledFrame>(size, std::move(buffer), free_frames_);
+}
+
+void DesktopFramePool::SetSharedMemoryFactory(
+    std::unique_ptr<SharedMemoryFactory> shared_memory_factory) {
+  shared_memory_factory_ = std::move(shared_memory_factory);
+  // Frames still in use return their buffers to the old free frames, which
+  // are freed together with the last of them.
+  free_frames_ = new rtc::RefCountedObject<FreeFrames>(max_free_frames_);
+}
+
+}  // namespace webrtc
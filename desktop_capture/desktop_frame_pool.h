@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_POOL_H_
+#define MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "api/scoped_refptr.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/shared_memory.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Creates DesktopFrames whose buffers are kept when the frames are released,
+// to be reused by later frames instead of allocating new ones. Buffer sizes
+// are rounded up to buckets of kSizeGranularity pixels, and a buffer is
+// reused for every frame that fits in it, so that a window being resized, or
+// several windows captured in turn, don't allocate a frame per capture.
+//
+// The frames may outlive the pool and may be released on any thread, but
+// CreateFrame() and SetSharedMemoryFactory() must be called on one thread.
+class RTC_EXPORT DesktopFramePool {
+ public:
+  static const int kSizeGranularity = 64;
+
+  // Keeps the buffers of up to |max_free_frames| released frames.
+  explicit DesktopFramePool(size_t max_free_frames);
+  ~DesktopFramePool();
+
+  // Returns a frame of |size|, whose stride may exceed the width, and whose
+  // content is undefined. Returns nullptr if the shared memory factory failed
+  // to allocate a buffer.
+  std::unique_ptr<DesktopFrame> CreateFrame(const DesktopSize& size);
+
+  // Allocates the buffers of later frames with |shared_memory_factory|, or in
+  // process memory if it is null. Buffers allocated before are freed.
+  void SetSharedMemoryFactory(
+      std::unique_ptr<SharedMemoryFactory> shared_memory_factory);
+
+ private:
+  class FreeFrames;
+  class PooledFrame;
+
+  const size_t max_free_frames_;
+  rtc::scoped_refptr<FreeFrames> free_frames_;
+  std::unique_ptr<SharedMemoryFactory> shared_memory_factory_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DesktopFramePool);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_POOL_H_
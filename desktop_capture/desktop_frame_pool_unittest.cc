@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Gives every buffer a new id, to tell the buffers apart after some of them
+// were freed.
+class FakeSharedMemoryFactory : public SharedMemoryFactory {
+ public:
+  std::unique_ptr<SharedMemory> CreateSharedMemory(size_t size) override {
+    return std::make_unique<FakeSharedMemory>(size, next_id_++);
+  }
+
+ private:
+  class FakeSharedMemory : public SharedMemory {
+   public:
+    FakeSharedMemory(size_t size, int id)
+        : FakeSharedMemory(std::vector<uint8_t>(size), id) {}
+    ~FakeSharedMemory() override = default;
+
+   private:
+    FakeSharedMemory(std::vector<uint8_t> buffer, int id)
+        : SharedMemory(buffer.data(), buffer.size(), 0, id),
+          buffer_(std::move(buffer)) {}
+
+    std::vector<uint8_t> buffer_;
+  };
+
+  int next_id_ = 0;
+};
+
+}  // namespace
+
+TEST(DesktopFramePoolTest, ReusesBufferOfReleasedFrame) {
+  DesktopFramePool pool(2);
+  std::unique_ptr<DesktopFrame> frame = pool.CreateFrame(DesktopSize(100, 50));
+  ASSERT_TRUE(frame);
+  const uint8_t* data = frame->data();
+  frame.reset();
+
+  frame = pool.CreateFrame(DesktopSize(100, 50));
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(data, frame->data());
+  EXPECT_TRUE(frame->size().equals(DesktopSize(100, 50)));
+}
+
+TEST(DesktopFramePoolTest, ReusesLargerBufferForSmallerFrame) {
+  DesktopFramePool pool(2);
+  std::unique_ptr<DesktopFrame> frame = pool.CreateFrame(DesktopSize(200, 100));
+  const uint8_t* data = frame->data();
+  const int stride = frame->stride();
+  frame.reset();
+
+  // A window shrinking by a few pixels keeps using the same buffer.
+  frame = pool.CreateFrame(DesktopSize(190, 97));
+  EXPECT_EQ(data, frame->data());
+  EXPECT_EQ(stride, frame->stride());
+  EXPECT_TRUE(frame->size().equals(DesktopSize(190, 97)));
+}
+
+TEST(DesktopFramePoolTest, DoesNotReuseBufferOfFrameInUse) {
+  DesktopFramePool pool(2);
+  std::unique_ptr<DesktopFrame> frame1 = pool.CreateFrame(DesktopSize(64, 64));
+  std::unique_ptr<DesktopFrame> frame2 = pool.CreateFrame(DesktopSize(64, 64));
+  EXPECT_NE(frame1->data(), frame2->data());
+}
+
+TEST(DesktopFramePoolTest, DoesNotReuseTooSmallBuffer) {
+  DesktopFramePool pool(2);
+  std::unique_ptr<DesktopFrame> frame = pool.CreateFrame(DesktopSize(64, 64));
+  const uint8_t* data = frame->data();
+  frame.reset();
+
+  std::unique_ptr<DesktopFrame> larger_frame =
+      pool.CreateFrame(DesktopSize(65, 64));
+  EXPECT_NE(data, larger_frame->data());
+  EXPECT_GE(larger_frame->stride(), 65 * DesktopFrame::kBytesPerPixel);
+}
+
+TEST(DesktopFramePoolTest, KeepsAtMostMaxFreeFrames) {
+  DesktopFramePool pool(1);
+  pool.SetSharedMemoryFactory(std::make_unique<FakeSharedMemoryFactory>());
+  std::unique_ptr<DesktopFrame> frame1 = pool.CreateFrame(DesktopSize(64, 64));
+  std::unique_ptr<DesktopFrame> frame2 = pool.CreateFrame(DesktopSize(64, 64));
+  ASSERT_TRUE(frame1->shared_memory());
+  ASSERT_TRUE(frame2->shared_memory());
+  const int id1 = frame1->shared_memory()->id();
+  const int id2 = frame2->shared_memory()->id();
+  frame2.reset();
+  // Replaces the buffer of |frame2| in the pool.
+  frame1.reset();
+
+  frame1 = pool.CreateFrame(DesktopSize(64, 64));
+  frame2 = pool.CreateFrame(DesktopSize(64, 64));
+  EXPECT_EQ(id1, frame1->shared_memory()->id());
+  EXPECT_NE(id2, frame2->shared_memory()->id());
+}
+
+TEST(DesktopFramePoolTest, DropsBuffersOnNewSharedMemoryFactory) {
+  DesktopFramePool pool(2);
+  std::unique_ptr<DesktopFrame> frame = pool.CreateFrame(DesktopSize(64, 64));
+  EXPECT_FALSE(frame->shared_memory());
+  frame.reset();
+
+  pool.SetSharedMemoryFactory(std::make_unique<FakeSharedMemoryFactory>());
+  frame = pool.CreateFrame(DesktopSize(64, 64));
+  EXPECT_TRUE(frame->shared_memory());
+}
+
+TEST(DesktopFramePoolTest, FrameMayOutlivePool) {
+  auto pool = std::make_unique<DesktopFramePool>(2);
+  std::unique_ptr<DesktopFrame> frame = pool->CreateFrame(DesktopSize(64, 64));
+  pool.reset();
+  // The frame stays valid.
+  frame->data()[0] = 1;
+  frame.reset();
+}
+
+}  // namespace webrtc
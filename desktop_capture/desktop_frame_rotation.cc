@@ -106,6 +106,11 @@ void RotateDesktopFrame(const DesktopFrame& source,
     return;
   }
 
+  if (rotation == Rotation::CLOCK_WISE_0) {
+    target->CopyPixelsFrom(source, source_rect.top_left(), target_rect);
+    return;
+  }
+
   int result = libyuv::ARGBRotate(
       source.GetFrameDataAtPos(source_rect.top_left()), source.stride(),
       target->GetFrameDataAtPos(target_rect.top_left()), target->stride(),
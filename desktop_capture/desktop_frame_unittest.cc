@@ -87,6 +87,41 @@ void RunTests(const TestData* tests, int num_tests) {
 
 }  // namespace
 
+TEST(DesktopFrameTest, CopyPixelsFromContiguousRows) {
+  const DesktopSize kSize(4, 3);
+  auto src_frame = CreateTestFrame(DesktopRect::MakeSize(kSize), 0);
+  for (int i = 0; i < kSize.width() * kSize.height(); i++) {
+    reinterpret_cast<uint32_t*>(src_frame->data())[i] = i + 1;
+  }
+
+  // The rows of both frames are continuous, so the rectangle is copied by one
+  // memcpy.
+  auto dest_frame = CreateTestFrame(DesktopRect::MakeSize(kSize), 0);
+  dest_frame->CopyPixelsFrom(*src_frame, DesktopVector(0, 1),
+                             DesktopRect::MakeXYWH(0, 0, 4, 2));
+  for (int y = 0; y < kSize.height(); y++) {
+    for (int x = 0; x < kSize.width(); x++) {
+      uint32_t pixel = *reinterpret_cast<uint32_t*>(
+          dest_frame->GetFrameDataAtPos(DesktopVector(x, y)));
+      EXPECT_EQ(y < 2 ? static_cast<uint32_t>((y + 1) * 4 + x + 1) : 0u,
+                pixel);
+    }
+  }
+
+  // A narrower rectangle is still copied row by row.
+  dest_frame = CreateTestFrame(DesktopRect::MakeSize(kSize), 0);
+  dest_frame->CopyPixelsFrom(*src_frame, DesktopVector(1, 0),
+                             DesktopRect::MakeXYWH(1, 0, 2, 3));
+  for (int y = 0; y < kSize.height(); y++) {
+    for (int x = 0; x < kSize.width(); x++) {
+      uint32_t pixel = *reinterpret_cast<uint32_t*>(
+          dest_frame->GetFrameDataAtPos(DesktopVector(x, y)));
+      EXPECT_EQ(x == 1 || x == 2 ? static_cast<uint32_t>(y * 4 + x + 1) : 0u,
+                pixel);
+    }
+  }
+}
+
 TEST(DesktopFrameTest, CopyIntersectingPixelsMatchingRects) {
   const TestData tests[] = {
     {"0 origin",
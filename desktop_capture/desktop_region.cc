@@ -166,10 +166,90 @@ void DesktopRegion::MergeWithPrecedingRow(Rows::iterator row) {
 }
 
 void DesktopRegion::AddRegion(const DesktopRegion& region) {
-  // TODO(sergeyu): This function is not optimized - potentially it can iterate
-  // over rows of the two regions similar to how it works in Intersect().
-  for (Iterator it(region); !it.IsAtEnd(); it.Advance()) {
-    AddRect(it.rect());
+  if (region.rows_.empty() || &region == this)
+    return;
+
+  if (rows_.empty()) {
+    *this = region;
+    return;
+  }
+
+  // Walks through the rows of the two regions from top to bottom, like
+  // Intersect(), instead of inserting the rectangles of |region| one by one,
+  // which splits and merges the rows of the current region again and again.
+  DesktopRegion old_region;
+  Swap(&old_region);
+
+  Rows::const_iterator it1 = old_region.rows_.begin();
+  Rows::const_iterator end1 = old_region.rows_.end();
+  Rows::const_iterator it2 = region.rows_.begin();
+  Rows::const_iterator end2 = region.rows_.end();
+
+  // Top of the part of the regions that hasn't been added yet.
+  int32_t top = std::min(it1->second->top, it2->second->top);
+  while (it1 != end1 || it2 != end2) {
+    const Row* row1 =
+        (it1 != end1 && it1->second->top <= top) ? it1->second : nullptr;
+    const Row* row2 =
+        (it2 != end2 && it2->second->top <= top) ? it2->second : nullptr;
+
+    if (!row1 && !row2) {
+      // Skip the gap between the rows.
+      top = std::min(it1 != end1 ? it1->second->top : INT32_MAX,
+                     it2 != end2 ? it2->second->top : INT32_MAX);
+      continue;
+    }
+
+    // The new row ends where any of the two regions starts or ends a row.
+    int32_t bottom = INT32_MAX;
+    if (row1) {
+      bottom = std::min(bottom, row1->bottom);
+    } else if (it1 != end1) {
+      bottom = std::min(bottom, it1->second->top);
+    }
+    if (row2) {
+      bottom = std::min(bottom, row2->bottom);
+    } else if (it2 != end2) {
+      bottom = std::min(bottom, it2->second->top);
+    }
+
+    Rows::iterator new_row = rows_.insert(
+        rows_.end(), Rows::value_type(bottom, new Row(top, bottom)));
+    if (row1 && row2) {
+      UnionRows(row1->spans, row2->spans, &new_row->second->spans);
+    } else {
+      new_row->second->spans = row1 ? row1->spans : row2->spans;
+    }
+    MergeWithPrecedingRow(new_row);
+
+    top = bottom;
+    if (row1 && row1->bottom == bottom)
+      ++it1;
+    if (row2 && row2->bottom == bottom)
+      ++it2;
+  }
+}
+
+// static
+void DesktopRegion::UnionRows(const RowSpanSet& set1,
+                              const RowSpanSet& set2,
+                              RowSpanSet* output) {
+  RowSpanSet::const_iterator it1 = set1.begin();
+  RowSpanSet::const_iterator it2 = set2.begin();
+  output->reserve(set1.size() + set2.size());
+
+  while (it1 != set1.end() || it2 != set2.end()) {
+    // Take the left-most of the two spans.
+    const RowSpan& span =
+        (it2 == set2.end() || (it1 != set1.end() && it1->left <= it2->left))
+            ? *it1++
+            : *it2++;
+    // Same as AddSpanToRow(), touching spans are coalesced.
+    if (!output->empty() && span.left <= output->back().right) {
+      output->back().right = std::max(output->back().right, span.right);
+    } else {
+      output->push_back(span);
+    }
   }
 }
 
@@ -146,6 +146,11 @@ class RTC_EXPORT DesktopRegion {
   // Returns true if the |span| exists in the given |row|.
   static bool IsSpanInRow(const Row& row, const RowSpan& rect);
 
+  // Calculates the union of two sets of spans.
+  static void UnionRows(const RowSpanSet& set1,
+                        const RowSpanSet& set2,
+                        RowSpanSet* output);
+
   // Calculates the intersection of two sets of spans.
   static void IntersectRows(const RowSpanSet& set1,
                             const RowSpanSet& set2,
@@ -811,6 +811,56 @@ TEST(DesktopRegionTest, SubtractRectOnSameCol) {
   }
 }
 
+TEST(DesktopRegionTest, AddRegion) {
+  for (int i = 0; i < 1000; ++i) {
+    DesktopRegion region1;
+    DesktopRegion region2;
+    DesktopRegion expected;
+    for (int j = 0; j < 20; ++j) {
+      DesktopRect rect = DesktopRect::MakeXYWH(RadmonInt(100), RadmonInt(100),
+                                               1 + RadmonInt(30),
+                                               1 + RadmonInt(30));
+      (j % 2 ? region1 : region2).AddRect(rect);
+      expected.AddRect(rect);
+    }
+
+    DesktopRegion result(region1);
+    result.AddRegion(region2);
+    EXPECT_TRUE(result.Equals(expected));
+
+    result = region2;
+    result.AddRegion(region1);
+    EXPECT_TRUE(result.Equals(expected));
+
+    // Adding a region to itself or to an empty region.
+    result.AddRegion(result);
+    EXPECT_TRUE(result.Equals(expected));
+    result.Clear();
+    result.AddRegion(expected);
+    EXPECT_TRUE(result.Equals(expected));
+  }
+}
+
+// Unions and subtracts regions made of many small rectangles, similar to the
+// updated regions of text scrolling.
+TEST(DesktopRegionTest, DISABLED_PerformanceOfManyRects) {
+  for (int c = 0; c < 100; ++c) {
+    DesktopRegion accumulated;
+    for (int frame = 0; frame < 10; ++frame) {
+      DesktopRegion updated;
+      for (int line = 0; line < 100; ++line) {
+        for (int glyph = 0; glyph < 20; ++glyph) {
+          updated.AddRect(DesktopRect::MakeXYWH(
+              RadmonInt(2000), line * 16 + RadmonInt(4), 8 + RadmonInt(32),
+              12));
+        }
+      }
+      accumulated.AddRegion(updated);
+      accumulated.Subtract(DesktopRect::MakeXYWH(0, frame * 160, 2000, 160));
+    }
+  }
+}
+
 TEST(DesktopRegionTest, DISABLED_Performance) {
   for (int c = 0; c < 1000; ++c) {
     DesktopRegion r;
@@ -12,10 +12,16 @@
 
 #include <string.h>
 
+#include "modules/desktop_capture/differ_vector_avx2.h"
 #include "modules/desktop_capture/differ_vector_sse2.h"
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace webrtc {
 
 namespace {
@@ -24,29 +30,48 @@ bool VectorDifference_C(const uint8_t* image1, const uint8_t* image2) {
   return memcmp(image1, image2, kBlockSize * kBytesPerPixel) != 0;
 }
 
-}  // namespace
+#if defined(WEBRTC_HAS_NEON)
+bool VectorDifference_NEON(const uint8_t* image1, const uint8_t* image2) {
+  uint8x16_t acc = vdupq_n_u8(0);
+  for (int i = 0; i < kBlockSize * kBytesPerPixel; i += 16) {
+    acc = vorrq_u8(acc, veorq_u8(vld1q_u8(image1 + i), vld1q_u8(image2 + i)));
+  }
+  const uint64x2_t acc64 = vreinterpretq_u64_u8(acc);
+  return (vgetq_lane_u64(acc64, 0) | vgetq_lane_u64(acc64, 1)) != 0;
+}
+#endif
 
-bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
-  static bool (*diff_proc)(const uint8_t*, const uint8_t*) = nullptr;
+using VectorDifferenceProc = bool (*)(const uint8_t*, const uint8_t*);
 
-  if (!diff_proc) {
-#if defined(WEBRTC_ARCH_ARM_FAMILY) || defined(WEBRTC_ARCH_MIPS_FAMILY)
-    // For ARM and MIPS processors, always use C version.
-    // TODO(hclam): Implement a NEON version.
-    diff_proc = &VectorDifference_C;
+VectorDifferenceProc SelectVectorDifference() {
+#if defined(WEBRTC_HAS_NEON)
+  return &VectorDifference_NEON;
+#elif defined(WEBRTC_ARCH_ARM_FAMILY) || defined(WEBRTC_ARCH_MIPS_FAMILY)
+  // For ARM processors without NEON and MIPS processors, always use C version.
+  return &VectorDifference_C;
 #else
-    bool have_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
-    // For x86 processors, check if SSE2 is supported.
-    if (have_sse2 && kBlockSize == 32) {
-      diff_proc = &VectorDifference_SSE2_W32;
-    } else if (have_sse2 && kBlockSize == 16) {
-      diff_proc = &VectorDifference_SSE2_W16;
-    } else {
-      diff_proc = &VectorDifference_C;
-    }
-#endif
+  bool have_avx2 = GetCpuSupportsAvx2();
+  bool have_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  // For x86 processors, check if AVX2 or SSE2 is supported.
+  if (have_avx2 && kBlockSize == 32) {
+    return &VectorDifference_AVX2_W32;
+  } else if (have_avx2 && kBlockSize == 16) {
+    return &VectorDifference_AVX2_W16;
+  } else if (have_sse2 && kBlockSize == 32) {
+    return &VectorDifference_SSE2_W32;
+  } else if (have_sse2 && kBlockSize == 16) {
+    return &VectorDifference_SSE2_W16;
   }
+  return &VectorDifference_C;
+#endif
+}
 
+}  // namespace
+
+bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
+  // Initialized once in a thread-safe way, since frames may be compared on
+  // several threads.
+  static const VectorDifferenceProc diff_proc = SelectVectorDifference();
   return diff_proc(image1, image2);
 }
 
@@ -86,4 +86,18 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(VectorDifferenceTestEveryByte, VectorDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+
+  // A difference in any byte of the vector should be found.
+  for (int i = 0; i < kBlockSize * kBytesPerPixel; ++i) {
+    block2[i] += 1;
+    EXPECT_TRUE(VectorDifference(block1, block2));
+    block2[i] -= 1;
+    EXPECT_FALSE(VectorDifference(block1, block2));
+  }
+}
+
 }  // namespace webrtc
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bits that differ between the 32 bytes at |i1| and |i2|.
+inline __m256i XorVector(const __m256i* i1, const __m256i* i2) {
+  return _mm256_xor_si256(_mm256_loadu_si256(i1), _mm256_loadu_si256(i2));
+}
+
+}  // namespace
+
+extern bool VectorDifference_AVX2_W16(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  const __m256i* i1 = reinterpret_cast<const __m256i*>(image1);
+  const __m256i* i2 = reinterpret_cast<const __m256i*>(image2);
+  const __m256i acc = _mm256_or_si256(XorVector(i1, i2),
+                                      XorVector(i1 + 1, i2 + 1));
+  return !_mm256_testz_si256(acc, acc);
+}
+
+extern bool VectorDifference_AVX2_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  const __m256i* i1 = reinterpret_cast<const __m256i*>(image1);
+  const __m256i* i2 = reinterpret_cast<const __m256i*>(image2);
+  const __m256i acc0 = _mm256_or_si256(XorVector(i1, i2),
+                                       XorVector(i1 + 1, i2 + 1));
+  const __m256i acc1 = _mm256_or_si256(XorVector(i1 + 2, i2 + 2),
+                                       XorVector(i1 + 3, i2 + 3));
+  const __m256i acc = _mm256_or_si256(acc0, acc1);
+  return !_mm256_testz_si256(acc, acc);
+}
+
+}  // namespace webrtc
@@ -10,12 +10,16 @@
 
 #include "modules/desktop_capture/linux/base_capturer_pipewire.h"
 
+#include <errno.h>
 #include <gio/gunixfdlist.h>
 #include <glib-object.h>
+#include <linux/dma-buf.h>
 #include <spa/param/format-utils.h>
 #include <spa/param/props.h>
 #include <spa/param/video/raw-utils.h>
 #include <spa/support/type-map.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
 
 #include <memory>
 #include <utility>
@@ -50,6 +54,20 @@ const int kBytesPerPixel = 4;
 const char kPipeWireLib[] = "libpipewire-0.2.so.1";
 #endif
 
+namespace {
+
+// Brackets CPU access to a mapped DMA-BUF, so the exporter can flush or
+// invalidate caches as needed. A no-op for the exporters which do not need it.
+void SyncDmaBuf(int fd, uint64_t start_or_end) {
+  struct dma_buf_sync sync = {0};
+  sync.flags = start_or_end | DMA_BUF_SYNC_READ;
+  while (ioctl(fd, DMA_BUF_IOCTL_SYNC, &sync) == -1 &&
+         (errno == EINTR || errno == EAGAIN)) {
+  }
+}
+
+}  // namespace
+
 // static
 void BaseCapturerPipeWire::OnStateChanged(void* data,
                                           pw_remote_state old_state,
@@ -211,10 +229,6 @@ BaseCapturerPipeWire::~BaseCapturerPipeWire() {
     pw_loop_destroy(pw_loop_);
   }
 
-  if (current_frame_) {
-    free(current_frame_);
-  }
-
   if (start_request_signal_id_) {
     g_dbus_connection_signal_unsubscribe(connection_, start_request_signal_id_);
   }
@@ -381,38 +395,72 @@ void BaseCapturerPipeWire::CreateReceivingStream() {
 
 void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
   spa_buffer* spaBuffer = buffer->buffer;
-  void* src = nullptr;
+  spa_data* data = &spaBuffer->datas[0];
+  uint8_t* src = static_cast<uint8_t*>(data->data);
+  uint8_t* map = nullptr;
+  size_t map_size = 0;
+
+  // PipeWire only maps the shared memory buffers. DMA-BUFs are mapped here,
+  // only for the time of the copy.
+  if (!src && data->type == pw_core_type_->data.DmaBuf && data->fd >= 0) {
+    map_size = data->maxsize + data->mapoffset;
+    void* result = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, data->fd, 0);
+    if (result == MAP_FAILED) {
+      RTC_LOG(LS_ERROR) << "Failed to mmap the DMA-BUF: " << errno;
+      return;
+    }
+    map = static_cast<uint8_t*>(result);
+    SyncDmaBuf(data->fd, DMA_BUF_SYNC_START);
+    src = map + data->mapoffset;
+  }
 
-  if (!(src = spaBuffer->datas[0].data)) {
+  if (!src) {
     return;
   }
 
-  uint32_t maxSize = spaBuffer->datas[0].maxsize;
-  int32_t srcStride = spaBuffer->datas[0].chunk->stride;
-  if (srcStride != (desktop_size_.width() * kBytesPerPixel)) {
-    RTC_LOG(LS_ERROR) << "Got buffer with stride different from screen stride: "
-                      << srcStride
-                      << " != " << (desktop_size_.width() * kBytesPerPixel);
+  if (!CopyToNextFrame(src + data->chunk->offset, data->chunk->stride)) {
     portal_init_failed_ = true;
-    return;
   }
 
-  if (!current_frame_) {
-    current_frame_ = static_cast<uint8_t*>(malloc(maxSize));
+  if (map) {
+    SyncDmaBuf(data->fd, DMA_BUF_SYNC_END);
+    munmap(map, map_size);
   }
-  RTC_DCHECK(current_frame_ != nullptr);
+}
+
+bool BaseCapturerPipeWire::CopyToNextFrame(const uint8_t* src,
+                                           int32_t src_stride) {
+  if (src_stride < (desktop_size_.width() * kBytesPerPixel)) {
+    RTC_LOG(LS_ERROR) << "Got buffer with stride smaller than screen stride: "
+                      << src_stride
+                      << " < " << (desktop_size_.width() * kBytesPerPixel);
+    return false;
+  }
+
+  rtc::CritScope lock(&queue_lock_);
+  // The previous frame stays intact if the consumer still holds it.
+  queue_.MoveToNextFrame();
+  if (!queue_.current_frame() || queue_.current_frame()->IsShared() ||
+      !queue_.current_frame()->size().equals(desktop_size_)) {
+    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(
+        std::make_unique<BasicDesktopFrame>(desktop_size_)));
+  }
+
+  SharedDesktopFrame* frame = queue_.current_frame();
+  frame->CopyPixelsFrom(src, src_stride, DesktopRect::MakeSize(desktop_size_));
 
   // If both sides decided to go with the RGBx format we need to convert it to
   // BGRx to match color format expected by WebRTC.
   if (spa_video_format_->format == pw_type_->video_format.RGBx) {
-    uint8_t* tempFrame = static_cast<uint8_t*>(malloc(maxSize));
-    std::memcpy(tempFrame, src, maxSize);
-    ConvertRGBxToBGRx(tempFrame, maxSize);
-    std::memcpy(current_frame_, tempFrame, maxSize);
-    free(tempFrame);
-  } else {
-    std::memcpy(current_frame_, src, maxSize);
+    for (int y = 0; y < desktop_size_.height(); y++) {
+      ConvertRGBxToBGRx(frame->GetFrameDataAtPos(DesktopVector(0, y)),
+                        desktop_size_.width() * kBytesPerPixel);
+    }
   }
+  frame->mutable_updated_region()->SetRect(
+      DesktopRect::MakeSize(desktop_size_));
+  has_frame_ = true;
+  return true;
 }
 
 void BaseCapturerPipeWire::ConvertRGBxToBGRx(uint8_t* frame, uint32_t size) {
@@ -854,15 +902,13 @@ void BaseCapturerPipeWire::CaptureFrame() {
     return;
   }
 
-  if (!current_frame_) {
-    callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
-    return;
+  std::unique_ptr<DesktopFrame> result;
+  {
+    rtc::CritScope lock(&queue_lock_);
+    if (has_frame_) {
+      result = queue_.current_frame()->Share();
+    }
   }
-
-  std::unique_ptr<DesktopFrame> result(new BasicDesktopFrame(desktop_size_));
-  result->CopyPixelsFrom(
-      current_frame_, (desktop_size_.width() * kBytesPerPixel),
-      DesktopRect::MakeWH(desktop_size_.width(), desktop_size_.height()));
   if (!result) {
     callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
     return;
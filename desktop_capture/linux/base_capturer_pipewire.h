@@ -18,7 +18,11 @@
 
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/screen_capture_frame_queue.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -82,7 +86,13 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   DesktopSize desktop_size_ = {};
   DesktopCaptureOptions options_ = {};
 
-  uint8_t* current_frame_ = nullptr;
+  // The frames are written on the PipeWire thread by HandleBuffer() and handed
+  // out by CaptureFrame() without another copy.
+  rtc::CriticalSection queue_lock_;
+  ScreenCaptureFrameQueue<SharedDesktopFrame> queue_
+      RTC_GUARDED_BY(queue_lock_);
+  // Whether the current frame of |queue_| holds a complete frame.
+  bool has_frame_ RTC_GUARDED_BY(queue_lock_) = false;
   Callback* callback_ = nullptr;
 
   bool portal_init_failed_ = false;
@@ -94,6 +104,10 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   void CreateReceivingStream();
   void HandleBuffer(pw_buffer* buffer);
 
+  // Copies |src| into the next frame of |queue_|. Returns false if |src|
+  // does not hold the format negotiated for the stream.
+  bool CopyToNextFrame(const uint8_t* src, int32_t src_stride);
+
   void ConvertRGBxToBGRx(uint8_t* frame, uint32_t size);
 
   static void OnStateChanged(void* data,
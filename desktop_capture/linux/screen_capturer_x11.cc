@@ -79,8 +79,13 @@ bool ScreenCapturerX11::Init(const DesktopCaptureOptions& options) {
     RTC_LOG(LS_INFO) << "X server does not support XFixes.";
   }
 
-  // Register for changes to the dimensions of the root window.
-  XSelectInput(display(), root_window_, StructureNotifyMask);
+  // Register for changes to the dimensions of the root window, keeping the
+  // events others sharing the display selected on it.
+  XWindowAttributes root_attributes;
+  long root_event_mask = 0;
+  if (XGetWindowAttributes(display(), root_window_, &root_attributes))
+    root_event_mask = root_attributes.your_event_mask;
+  XSelectInput(display(), root_window_, root_event_mask | StructureNotifyMask);
 
   if (!x_server_pixel_buffer_.Init(atom_cache_.get(),
                                    DefaultRootWindow(display()))) {
@@ -205,7 +210,8 @@ bool ScreenCapturerX11::HandleXEvent(const XEvent& event) {
       return false;
     RTC_DCHECK(damage_event->level == XDamageReportNonEmpty);
     return true;
-  } else if (event.type == ConfigureNotify) {
+  } else if (event.type == ConfigureNotify &&
+             event.xconfigure.window == root_window_) {
     ScreenConfigurationChanged();
     return true;
   }
@@ -220,13 +226,6 @@ std::unique_ptr<DesktopFrame> ScreenCapturerX11::CaptureScreen() {
   // expands that region to a grid.
   helper_.set_size_most_recent(frame->size());
 
-  // In the DAMAGE case, ensure the frame is up-to-date with the previous frame
-  // if any.  If there isn't a previous frame, that means a screen-resolution
-  // change occurred, and |invalid_rects| will be updated to include the whole
-  // screen.
-  if (use_damage_ && queue_.previous_frame())
-    SynchronizeFrame();
-
   DesktopRegion* updated_region = frame->mutable_updated_region();
 
   x_server_pixel_buffer_.Synchronize();
@@ -253,11 +252,14 @@ std::unique_ptr<DesktopFrame> ScreenCapturerX11::CaptureScreen() {
     updated_region->IntersectWith(
         DesktopRect::MakeSize(x_server_pixel_buffer_.window_size()));
 
-    for (DesktopRegion::Iterator it(*updated_region); !it.IsAtEnd();
-         it.Advance()) {
-      if (!x_server_pixel_buffer_.CaptureRect(it.rect(), frame.get()))
-        return nullptr;
-    }
+    // In the DAMAGE case, ensure the frame is up-to-date with the previous
+    // frame outside of the damaged portions. If there isn't a previous frame,
+    // that means a screen-resolution change occurred, and the whole screen is
+    // captured below.
+    SynchronizeFrame(*updated_region);
+
+    if (!x_server_pixel_buffer_.CaptureRegion(*updated_region, frame.get()))
+      return nullptr;
   } else {
     // Doing full-screen polling, or this is the first capture after a
     // screen-resolution change.  In either case, need a full-screen capture.
@@ -283,22 +285,21 @@ void ScreenCapturerX11::ScreenConfigurationChanged() {
   }
 }
 
-void ScreenCapturerX11::SynchronizeFrame() {
+void ScreenCapturerX11::SynchronizeFrame(const DesktopRegion& captured_region) {
   // Synchronize the current buffer with the previous one since we do not
   // capture the entire desktop. Note that encoder may be reading from the
   // previous buffer at this time so thread access complaints are false
   // positives.
-
-  // TODO(hclam): We can reduce the amount of copying here by subtracting
-  // |capturer_helper_|s region from |last_invalid_region_|.
-  // http://crbug.com/92354
   RTC_DCHECK(queue_.previous_frame());
 
   DesktopFrame* current = queue_.current_frame();
   DesktopFrame* last = queue_.previous_frame();
   RTC_DCHECK(current != last);
-  for (DesktopRegion::Iterator it(last_invalid_region_); !it.IsAtEnd();
-       it.Advance()) {
+
+  // The pixels in |captured_region| are overwritten by the capture anyway.
+  DesktopRegion copy_region(last_invalid_region_);
+  copy_region.Subtract(captured_region);
+  for (DesktopRegion::Iterator it(copy_region); !it.IsAtEnd(); it.Advance()) {
     current->CopyPixelsFrom(*last, it.rect().top_left(), it.rect());
   }
 }
@@ -76,11 +76,12 @@ class ScreenCapturerX11 : public DesktopCapturer,
   void ScreenConfigurationChanged();
 
   // Synchronize the current buffer with |last_buffer_|, by copying pixels from
-  // the area of |last_invalid_rects|.
+  // the area of |last_invalid_rects|, except the ones in |captured_region|,
+  // which are about to be captured into the current buffer.
   // Note this only works on the assumption that kNumBuffers == 2, as
   // |last_invalid_rects| holds the differences from the previous buffer and
   // the one prior to that (which will then be the current buffer).
-  void SynchronizeFrame();
+  void SynchronizeFrame(const DesktopRegion& captured_region);
 
   void DeinitXlib();
 
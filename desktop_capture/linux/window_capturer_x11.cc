@@ -35,7 +35,8 @@ namespace webrtc {
 WindowCapturerX11::WindowCapturerX11(const DesktopCaptureOptions& options)
     : x_display_(options.x_display()),
       atom_cache_(display()),
-      window_finder_(&atom_cache_) {
+      window_finder_(&atom_cache_, x_display_.get()),
+      frame_pool_(options.max_pooled_frames()) {
   int event_base, error_base, major_version, minor_version;
   if (XCompositeQueryExtension(display(), &event_base, &error_base) &&
       XCompositeQueryVersion(display(), &major_version, &minor_version) &&
@@ -166,8 +167,13 @@ void WindowCapturerX11::CaptureFrame() {
     return;
   }
 
-  std::unique_ptr<DesktopFrame> frame(
-      new BasicDesktopFrame(x_server_pixel_buffer_.window_size()));
+  std::unique_ptr<DesktopFrame> frame =
+      frame_pool_.CreateFrame(x_server_pixel_buffer_.window_size());
+  if (!frame) {
+    RTC_LOG(LS_WARNING) << "Failed to allocate a frame.";
+    callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
+    return;
+  }
 
   x_server_pixel_buffer_.Synchronize();
   if (!x_server_pixel_buffer_.CaptureRect(DesktopRect::MakeSize(frame->size()),
@@ -184,6 +190,11 @@ void WindowCapturerX11::CaptureFrame() {
   callback_->OnCaptureResult(Result::SUCCESS, std::move(frame));
 }
 
+void WindowCapturerX11::SetSharedMemoryFactory(
+    std::unique_ptr<SharedMemoryFactory> shared_memory_factory) {
+  frame_pool_.SetSharedMemoryFactory(std::move(shared_memory_factory));
+}
+
 bool WindowCapturerX11::IsOccluded(const DesktopVector& pos) {
   return window_finder_.GetWindowUnderPoint(pos) !=
          static_cast<WindowId>(selected_window_);
@@ -20,6 +20,7 @@
 #include "api/scoped_refptr.h"
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/desktop_frame_pool.h"
 #include "modules/desktop_capture/desktop_geometry.h"
 #include "modules/desktop_capture/linux/shared_x_display.h"
 #include "modules/desktop_capture/linux/window_finder_x11.h"
@@ -41,6 +42,8 @@ class WindowCapturerX11 : public DesktopCapturer,
   // DesktopCapturer interface.
   void Start(Callback* callback) override;
   void CaptureFrame() override;
+  void SetSharedMemoryFactory(
+      std::unique_ptr<SharedMemoryFactory> shared_memory_factory) override;
   bool GetSourceList(SourceList* sources) override;
   bool SelectSource(SourceId id) override;
   bool FocusOnSelectedSource() override;
@@ -65,6 +68,8 @@ class WindowCapturerX11 : public DesktopCapturer,
   XServerPixelBuffer x_server_pixel_buffer_;
   XAtomCache atom_cache_;
   WindowFinderX11 window_finder_;
+  // Frames are allocated per capture, since their size follows the window.
+  DesktopFramePool frame_pool_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(WindowCapturerX11);
 };
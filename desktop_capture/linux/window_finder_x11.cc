@@ -19,24 +19,93 @@
 
 namespace webrtc {
 
+namespace {
+
+// The events on the children of the root windows that change which window is
+// visible at a point.
+const int kWindowStackEvents[] = {ConfigureNotify, CreateNotify,
+                                  DestroyNotify,   MapNotify,
+                                  UnmapNotify,     ReparentNotify,
+                                  CirculateNotify};
+
+}  // namespace
+
 WindowFinderX11::WindowFinderX11(XAtomCache* cache) : cache_(cache) {
   RTC_DCHECK(cache_);
 }
 
-WindowFinderX11::~WindowFinderX11() = default;
+WindowFinderX11::WindowFinderX11(XAtomCache* cache, SharedXDisplay* x_display)
+    : cache_(cache), x_display_(x_display) {
+  RTC_DCHECK(cache_);
+  RTC_DCHECK(x_display_);
+  Display* display = x_display_->display();
+  for (int screen = 0; screen < XScreenCount(display); ++screen) {
+    ::Window root = RootWindow(display, screen);
+    // Keeps the events others selected on the root window.
+    XWindowAttributes attributes;
+    if (!XGetWindowAttributes(display, root, &attributes)) {
+      continue;
+    }
+    XSelectInput(display, root,
+                 attributes.your_event_mask | SubstructureNotifyMask);
+  }
+  for (int type : kWindowStackEvents) {
+    x_display_->AddEventHandler(type, this);
+  }
+}
+
+WindowFinderX11::~WindowFinderX11() {
+  if (x_display_) {
+    for (int type : kWindowStackEvents) {
+      x_display_->RemoveEventHandler(type, this);
+    }
+  }
+}
 
 WindowId WindowFinderX11::GetWindowUnderPoint(DesktopVector point) {
-  WindowId id = kNullWindowId;
-  GetWindowList(cache_, [&id, this, point](::Window window) {
+  if (!x_display_) {
+    WindowId id = kNullWindowId;
+    GetWindowList(cache_, [&id, this, point](::Window window) {
+      DesktopRect rect;
+      if (GetWindowRect(this->cache_->display(), window, &rect) &&
+          rect.Contains(point)) {
+        id = window;
+        return false;
+      }
+      return true;
+    });
+    return id;
+  }
+
+  if (windows_changed_) {
+    windows_ = ListWindows();
+    windows_changed_ = false;
+  }
+  for (const auto& window : windows_) {
+    if (window.second.Contains(point)) {
+      return window.first;
+    }
+  }
+  return kNullWindowId;
+}
+
+bool WindowFinderX11::HandleXEvent(const XEvent& event) {
+  windows_changed_ = true;
+  // Always returns false, so other observers can still receive the events.
+  return false;
+}
+
+std::vector<std::pair<WindowId, DesktopRect>> WindowFinderX11::ListWindows()
+    const {
+  std::vector<std::pair<WindowId, DesktopRect>> windows;
+  GetWindowList(cache_, [&windows, this](::Window window) {
     DesktopRect rect;
-    if (GetWindowRect(this->cache_->display(), window, &rect) &&
-        rect.Contains(point)) {
-      id = window;
-      return false;
+    if (GetWindowRect(this->cache_->display(), window, &rect)) {
+      windows.emplace_back(window, rect);
     }
     return true;
   });
-  return id;
+  return windows;
 }
 
 // static
@@ -11,6 +11,12 @@
 #ifndef MODULES_DESKTOP_CAPTURE_LINUX_WINDOW_FINDER_X11_H_
 #define MODULES_DESKTOP_CAPTURE_LINUX_WINDOW_FINDER_X11_H_
 
+#include <utility>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/linux/shared_x_display.h"
 #include "modules/desktop_capture/window_finder.h"
 
 namespace webrtc {
@@ -18,16 +24,34 @@ namespace webrtc {
 class XAtomCache;
 
 // The implementation of WindowFinder for X11.
-class WindowFinderX11 final : public WindowFinder {
+class WindowFinderX11 final : public WindowFinder,
+                              public SharedXDisplay::XEventHandler {
  public:
   explicit WindowFinderX11(XAtomCache* cache);
+  // Keeps the windows and their bounds between calls to
+  // GetWindowUnderPoint(), and only queries the X server again after
+  // |x_display| has delivered an event that changed the window stack. The
+  // owner is expected to call |x_display|->ProcessPendingXEvents() before
+  // each query, as the window capturer does on each capture.
+  WindowFinderX11(XAtomCache* cache, SharedXDisplay* x_display);
   ~WindowFinderX11() override;
 
   // WindowFinder implementation.
   WindowId GetWindowUnderPoint(DesktopVector point) override;
 
+  // SharedXDisplay::XEventHandler interface.
+  bool HandleXEvent(const XEvent& event) override;
+
  private:
+  // Returns the top-level windows with their bounds, from top to bottom.
+  std::vector<std::pair<WindowId, DesktopRect>> ListWindows() const;
+
   XAtomCache* const cache_;
+  const rtc::scoped_refptr<SharedXDisplay> x_display_;
+
+  // Result of ListWindows(), valid until |windows_changed_| is set.
+  std::vector<std::pair<WindowId, DesktopRect>> windows_;
+  bool windows_changed_ = true;
 };
 
 }  // namespace webrtc
@@ -131,6 +131,26 @@ void SlowBlit(XImage* x_image,
   }
 }
 
+// Copies |rect| of |x_image|, which starts at |src_pos|, into |frame|.
+void Blit(XImage* x_image,
+          uint8_t* src_pos,
+          const DesktopRect& rect,
+          DesktopFrame* frame) {
+  if (IsXImageRGBFormat(x_image)) {
+    FastBlit(x_image, src_pos, rect, frame);
+  } else {
+    SlowBlit(x_image, src_pos, rect, frame);
+  }
+}
+
+// Returns the position of the top left corner of |rect| in |x_image|, which
+// covers the whole window.
+uint8_t* GetRectPosition(XImage* x_image, const DesktopRect& rect) {
+  return reinterpret_cast<uint8_t*>(x_image->data) +
+         rect.top() * x_image->bytes_per_line +
+         rect.left() * x_image->bits_per_pixel / 8;
+}
+
 }  // namespace
 
 XServerPixelBuffer::XServerPixelBuffer() {}
@@ -328,9 +348,6 @@ bool XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
   RTC_DCHECK_LE(rect.right(), window_rect_.width());
   RTC_DCHECK_LE(rect.bottom(), window_rect_.height());
 
-  XImage* image;
-  uint8_t* data;
-
   if (shm_segment_info_ && (shm_pixmap_ || xshm_get_image_succeeded_)) {
     if (shm_pixmap_) {
       XCopyArea(display_, window_, shm_pixmap_, shm_gc_, rect.left(),
@@ -339,11 +356,7 @@ bool XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
       XSync(display_, False);
     }
 
-    image = x_shm_image_;
-    data = reinterpret_cast<uint8_t*>(image->data) +
-           rect.top() * image->bytes_per_line +
-           rect.left() * image->bits_per_pixel / 8;
-
+    Blit(x_shm_image_, GetRectPosition(x_shm_image_, rect), rect, frame);
   } else {
     if (x_image_)
       XDestroyImage(x_image_);
@@ -352,14 +365,39 @@ bool XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
     if (!x_image_)
       return false;
 
-    image = x_image_;
-    data = reinterpret_cast<uint8_t*>(image->data);
+    Blit(x_image_, reinterpret_cast<uint8_t*>(x_image_->data), rect, frame);
   }
 
-  if (IsXImageRGBFormat(image)) {
-    FastBlit(image, data, rect, frame);
-  } else {
-    SlowBlit(image, data, rect, frame);
+  if (!icc_profile_.empty())
+    frame->set_icc_profile(icc_profile_);
+
+  return true;
+}
+
+bool XServerPixelBuffer::CaptureRegion(const DesktopRegion& region,
+                                       DesktopFrame* frame) {
+  if (!shm_segment_info_ || !shm_pixmap_) {
+    for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+      if (!CaptureRect(it.rect(), frame))
+        return false;
+    }
+    return true;
+  }
+
+  // Queue the copies of all the rectangles into the shared memory pixmap and
+  // wait for the X server once, instead of once per rectangle.
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    const DesktopRect& rect = it.rect();
+    RTC_DCHECK_LE(rect.right(), window_rect_.width());
+    RTC_DCHECK_LE(rect.bottom(), window_rect_.height());
+    XCopyArea(display_, window_, shm_pixmap_, shm_gc_, rect.left(), rect.top(),
+              rect.width(), rect.height(), rect.left(), rect.top());
+  }
+  XSync(display_, False);
+
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    Blit(x_shm_image_, GetRectPosition(x_shm_image_, it.rect()), it.rect(),
+         frame);
   }
 
   if (!icc_profile_.empty())
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
@@ -64,6 +65,11 @@ class XServerPixelBuffer {
   // that |rect| is not larger than window_size().
   bool CaptureRect(const DesktopRect& rect, DesktopFrame* frame);
 
+  // Same as CaptureRect(), but captures all the rectangles in |region|. If a
+  // shared memory pixmap is used, the X server is synchronized only once for
+  // the whole |region|.
+  bool CaptureRegion(const DesktopRegion& region, DesktopFrame* frame);
+
  private:
   void ReleaseSharedMemorySegment();
 
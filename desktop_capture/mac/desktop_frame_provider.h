@@ -35,6 +35,12 @@ class DesktopFrameProvider {
   std::unique_ptr<DesktopFrame> TakeLatestFrameForDisplay(
       CGDirectDisplayID display_id);
 
+  // Returns a frame sharing the latest IOSurface of |display_id|, without
+  // falling back to a snapshot. Returns null if IOSurfaces are not allowed or
+  // none has been received for |display_id| yet.
+  std::unique_ptr<DesktopFrame> TakeLatestIOSurfaceFrameForDisplay(
+      CGDirectDisplayID display_id);
+
   // OS sends the latest IOSurfaceRef through
   // CGDisplayStreamFrameAvailableHandler callback; we store it here.
   void InvalidateIOSurface(CGDirectDisplayID display_id,
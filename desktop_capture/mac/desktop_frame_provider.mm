@@ -41,6 +41,18 @@ std::unique_ptr<DesktopFrame> DesktopFrameProvider::TakeLatestFrameForDisplay(
   return io_surfaces_[display_id]->Share();
 }
 
+std::unique_ptr<DesktopFrame> DesktopFrameProvider::TakeLatestIOSurfaceFrameForDisplay(
+    CGDirectDisplayID display_id) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+
+  auto it = io_surfaces_.find(display_id);
+  if (!allow_iosurface_ || it == io_surfaces_.end() || !it->second) {
+    return nullptr;
+  }
+
+  return it->second->Share();
+}
+
 void DesktopFrameProvider::InvalidateIOSurface(CGDirectDisplayID display_id,
                                                rtc::ScopedCFTypeRef<IOSurfaceRef> io_surface) {
   RTC_DCHECK(thread_checker_.IsCurrent());
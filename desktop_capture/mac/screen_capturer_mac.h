@@ -53,8 +53,13 @@ class ScreenCapturerMac final : public DesktopCapturer {
   bool SelectSource(SourceId id) override;
 
  private:
-  // Returns false if the selected screen is no longer valid.
-  bool CgBlit(const DesktopFrame& frame, const DesktopRegion& region);
+  // Returns false if the selected screen is no longer valid. |is_new_frame| is
+  // true if |frame| was just allocated and holds no earlier capture.
+  bool CgBlit(const DesktopFrame& frame, const DesktopRegion& region, bool is_new_frame);
+
+  // Returns a frame referencing the latest IOSurface of the selected display,
+  // without copying it, or null if the frame has to be composed by CgBlit().
+  std::unique_ptr<DesktopFrame> TakeIOSurfaceFrame();
 
   // Called when the screen configuration is changed.
   void ScreenConfigurationChanged();
@@ -98,6 +103,10 @@ class ScreenCapturerMac final : public DesktopCapturer {
   // Contains an invalid region from the previous capture.
   DesktopRegion last_invalid_region_;
 
+  // True if the previous capture returned an IOSurface frame, leaving the
+  // frames in |queue_| outdated.
+  bool last_frame_from_iosurface_ = false;
+
   // Monitoring display reconfiguration.
   rtc::scoped_refptr<DesktopConfigurationMonitor> desktop_config_monitor_;
 
@@ -229,18 +229,34 @@ void ScreenCapturerMac::CaptureFrame() {
   DesktopRegion region;
   helper_.TakeInvalidRegion(&region);
 
-  // If the current buffer is from an older generation then allocate a new one.
-  // Note that we can't reallocate other buffers at this point, since the caller
-  // may still be reading from them.
-  if (!queue_.current_frame()) queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(CreateFrame()));
+  std::unique_ptr<DesktopFrame> new_frame = TakeIOSurfaceFrame();
+  if (new_frame) {
+    last_frame_from_iosurface_ = true;
+  } else {
+    if (last_frame_from_iosurface_) {
+      // The buffers missed the changes delivered through IOSurface frames.
+      queue_.Reset();
+      region.SetRect(DesktopRect::MakeSize(screen_pixel_bounds_.size()));
+      last_frame_from_iosurface_ = false;
+    }
 
-  DesktopFrame* current_frame = queue_.current_frame();
+    // If the current buffer is from an older generation then allocate a new one.
+    // Note that we can't reallocate other buffers at this point, since the caller
+    // may still be reading from them.
+    const bool is_new_frame = !queue_.current_frame();
+    if (is_new_frame) queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(CreateFrame()));
 
-  if (!CgBlit(*current_frame, region)) {
-    callback_->OnCaptureResult(Result::ERROR_PERMANENT, nullptr);
-    return;
+    DesktopFrame* current_frame = queue_.current_frame();
+
+    if (!CgBlit(*current_frame, region, is_new_frame)) {
+      callback_->OnCaptureResult(Result::ERROR_PERMANENT, nullptr);
+      return;
+    }
+    // Remember what was updated, so that the next capture into the other buffer
+    // only has to copy these parts from this one.
+    *current_frame->mutable_updated_region() = region;
+    new_frame = queue_.current_frame()->Share();
   }
-  std::unique_ptr<DesktopFrame> new_frame = queue_.current_frame()->Share();
   if (detect_updated_region_) {
     *new_frame->mutable_updated_region() = region;
   } else {
@@ -292,11 +308,47 @@ bool ScreenCapturerMac::SelectSource(SourceId id) {
   return true;
 }
 
-bool ScreenCapturerMac::CgBlit(const DesktopFrame& frame, const DesktopRegion& region) {
-  // If not all screen region is dirty, copy the entire contents of the previous capture buffer,
-  // to capture over.
+std::unique_ptr<DesktopFrame> ScreenCapturerMac::TakeIOSurfaceFrame() {
+  // The excluded window has to be painted over, and several displays have to
+  // be composed, so both need a frame of our own.
+  if (!current_display_ || excluded_window_) {
+    return nullptr;
+  }
+
+  std::unique_ptr<DesktopFrame> frame =
+      desktop_frame_provider_.TakeLatestIOSurfaceFrameForDisplay(current_display_);
+  // The IOSurface has the previous size for a while after the screen is resized.
+  if (!frame || !frame->size().equals(screen_pixel_bounds_.size())) {
+    return nullptr;
+  }
+  return frame;
+}
+
+bool ScreenCapturerMac::CgBlit(const DesktopFrame& frame,
+                               const DesktopRegion& region,
+                               bool is_new_frame) {
+  // If not all screen region is dirty, bring the buffer up to date with the previous capture, to
+  // capture over.
   if (queue_.previous_frame() && !region.Equals(DesktopRegion(screen_pixel_bounds_))) {
-    memcpy(frame.data(), queue_.previous_frame()->data(), frame.stride() * frame.size().height());
+    const DesktopFrame& previous_frame = *queue_.previous_frame();
+    if (is_new_frame || excluded_window_) {
+      // Parts of the excluded window are painted outside of the updated region.
+      memcpy(frame.data(), previous_frame.data(), frame.stride() * frame.size().height());
+    } else {
+      // |frame| holds the capture before the previous one, so it only lacks what the previous
+      // capture updated, except for what is captured over anyway.
+      DesktopRegion stale_region = previous_frame.updated_region();
+      stale_region.Subtract(region);
+      stale_region.IntersectWith(DesktopRect::MakeSize(frame.size()));
+      for (DesktopRegion::Iterator i(stale_region); !i.IsAtEnd(); i.Advance()) {
+        CopyRect(previous_frame.data(),
+                 previous_frame.stride(),
+                 frame.data(),
+                 frame.stride(),
+                 DesktopFrame::kBytesPerPixel,
+                 i.rect());
+      }
+    }
   }
 
   MacDisplayConfigurations displays_to_capture;
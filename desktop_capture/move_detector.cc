@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/move_detector.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Fewer lines than this matching with the same shift are taken as chance.
+constexpr int kMinMatchingLines = 8;
+
+// FNV-1a, one 32-bit pixel at a time.
+constexpr uint64_t kHashOffsetBasis = 0xcbf29ce484222325ull;
+constexpr uint64_t kHashPrime = 0x100000001b3ull;
+
+uint64_t HashStep(uint64_t hash, uint32_t pixel) {
+  return (hash ^ pixel) * kHashPrime;
+}
+
+uint32_t LoadPixel(const uint8_t* data) {
+  uint32_t pixel;
+  memcpy(&pixel, data, sizeof(pixel));
+  return pixel;
+}
+
+// Hashes |width| pixels at |row|. The pixels are spread over four independent
+// hashes so that the multiplications don't wait on each other.
+uint64_t HashRow(const uint8_t* row, int width) {
+  uint64_t lanes[4] = {kHashOffsetBasis, kHashOffsetBasis + 1,
+                       kHashOffsetBasis + 2, kHashOffsetBasis + 3};
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    for (int i = 0; i < 4; ++i) {
+      lanes[i] = HashStep(
+          lanes[i], LoadPixel(row + (x + i) * DesktopFrame::kBytesPerPixel));
+    }
+  }
+  for (; x < width; ++x) {
+    lanes[0] =
+        HashStep(lanes[0], LoadPixel(row + x * DesktopFrame::kBytesPerPixel));
+  }
+
+  uint64_t hash = lanes[0];
+  for (int i = 1; i < 4; ++i) {
+    hash = HashStep(hash, static_cast<uint32_t>(lanes[i]));
+    hash = HashStep(hash, static_cast<uint32_t>(lanes[i] >> 32));
+  }
+  return hash;
+}
+
+void HashRows(const DesktopFrame& frame,
+              const DesktopRect& rect,
+              std::vector<uint64_t>* hashes) {
+  hashes->resize(rect.height());
+  const uint8_t* row = frame.GetFrameDataAtPos(rect.top_left());
+  for (int y = 0; y < rect.height(); ++y) {
+    (*hashes)[y] = HashRow(row, rect.width());
+    row += frame.stride();
+  }
+}
+
+// Hashes the columns of |rect| row by row, so that the frame is read in memory
+// order.
+void HashColumns(const DesktopFrame& frame,
+                 const DesktopRect& rect,
+                 std::vector<uint64_t>* hashes) {
+  hashes->assign(rect.width(), kHashOffsetBasis);
+  const uint8_t* row = frame.GetFrameDataAtPos(rect.top_left());
+  for (int y = 0; y < rect.height(); ++y) {
+    for (int x = 0; x < rect.width(); ++x) {
+      (*hashes)[x] = HashStep(
+          (*hashes)[x], LoadPixel(row + x * DesktopFrame::kBytesPerPixel));
+    }
+    row += frame.stride();
+  }
+}
+
+}  // namespace
+
+constexpr int MoveDetector::kMinMoveLength;
+
+MoveDetector::MoveDetector() = default;
+
+MoveDetector::~MoveDetector() = default;
+
+void MoveDetector::DetectMoves(const DesktopFrame& old_frame,
+                               const DesktopFrame& new_frame,
+                               const DesktopRect& rect,
+                               std::vector<DesktopMoveRect>* moves) {
+  RTC_DCHECK(old_frame.size().equals(new_frame.size()));
+  RTC_DCHECK_EQ(old_frame.stride(), new_frame.stride());
+  RTC_DCHECK(moves);
+  DesktopRect area = rect;
+  area.IntersectWith(DesktopRect::MakeSize(new_frame.size()));
+  if (area.width() < kMinMoveLength || area.height() < kMinMoveLength)
+    return;
+
+  // Vertical moves, e.g. scrolling a document, are the most common, so they
+  // are looked for first.
+  for (bool vertical : {true, false}) {
+    if (vertical) {
+      HashRows(old_frame, area, &old_hashes_);
+      HashRows(new_frame, area, &new_hashes_);
+    } else {
+      HashColumns(old_frame, area, &old_hashes_);
+      HashColumns(new_frame, area, &new_hashes_);
+    }
+    const int shift = FindShift();
+    if (shift == 0)
+      continue;
+
+    // Reports each run of lines that matches with |shift|.
+    const int num_lines = static_cast<int>(new_hashes_.size());
+    const int end = std::min(num_lines, num_lines + shift);
+    const size_t moves_before = moves->size();
+    int run_start = -1;
+    for (int i = std::max(0, shift); i <= end; ++i) {
+      if (i < end && new_hashes_[i] == old_hashes_[i - shift]) {
+        if (run_start < 0)
+          run_start = i;
+        continue;
+      }
+      if (run_start >= 0 && i - run_start >= kMinMoveLength) {
+        DesktopMoveRect move;
+        if (vertical) {
+          move.source =
+              DesktopVector(area.left(), area.top() + run_start - shift);
+          move.dest = DesktopRect::MakeLTRB(area.left(), area.top() + run_start,
+                                            area.right(), area.top() + i);
+        } else {
+          move.source =
+              DesktopVector(area.left() + run_start - shift, area.top());
+          move.dest = DesktopRect::MakeLTRB(area.left() + run_start, area.top(),
+                                            area.left() + i, area.bottom());
+        }
+        // Guards against hash collisions, which would otherwise make the
+        // encoder copy wrong content.
+        if (AreasEqual(old_frame, move.source, new_frame,
+                       move.dest.top_left(), move.dest.width(),
+                       move.dest.height())) {
+          moves->push_back(move);
+        }
+      }
+      run_start = -1;
+    }
+    if (moves->size() > moves_before)
+      return;
+  }
+}
+
+int MoveDetector::FindShift() {
+  const int num_lines = static_cast<int>(new_hashes_.size());
+  RTC_DCHECK_EQ(old_hashes_.size(), new_hashes_.size());
+  old_lines_.clear();
+  for (int i = 0; i < num_lines; ++i) {
+    auto result = old_lines_.emplace(old_hashes_[i], i);
+    if (!result.second)
+      result.first->second = -1;
+  }
+
+  votes_.assign(2 * num_lines + 1, 0);
+  for (int i = 0; i < num_lines; ++i) {
+    // Lines that didn't move say nothing about the shift.
+    if (new_hashes_[i] == old_hashes_[i])
+      continue;
+    auto it = old_lines_.find(new_hashes_[i]);
+    if (it == old_lines_.end() || it->second < 0)
+      continue;
+    ++votes_[i - it->second + num_lines];
+  }
+
+  int best = num_lines;
+  for (int i = 0; i < static_cast<int>(votes_.size()); ++i) {
+    if (i != num_lines && (best == num_lines || votes_[i] > votes_[best]))
+      best = i;
+  }
+  if (best == num_lines || votes_[best] < kMinMatchingLines)
+    return 0;
+  return best - num_lines;
+}
+
+// static
+bool MoveDetector::AreasEqual(const DesktopFrame& old_frame,
+                              const DesktopVector& old_pos,
+                              const DesktopFrame& new_frame,
+                              const DesktopVector& new_pos,
+                              int width,
+                              int height) {
+  const uint8_t* old_row = old_frame.GetFrameDataAtPos(old_pos);
+  const uint8_t* new_row = new_frame.GetFrameDataAtPos(new_pos);
+  const size_t width_bytes = width * DesktopFrame::kBytesPerPixel;
+  for (int y = 0; y < height; ++y) {
+    if (memcmp(old_row, new_row, width_bytes) != 0)
+      return false;
+    old_row += old_frame.stride();
+    new_row += new_frame.stride();
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_MOVE_DETECTOR_H_
+#define MODULES_DESKTOP_CAPTURE_MOVE_DETECTOR_H_
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Finds content that was scrolled, i.e. moved vertically or horizontally,
+// between two frames. Every pixel row (or column) of the compared area is
+// hashed in both frames, the shift that matches most rows of the new frame to
+// rows of the old frame is selected, and the runs of rows matching with that
+// shift are verified and reported as DesktopMoveRects.
+class MoveDetector {
+ public:
+  // Content must move at least this many pixel rows or columns together to be
+  // reported.
+  static constexpr int kMinMoveLength = 32;
+
+  MoveDetector();
+  ~MoveDetector();
+
+  // Appends to |moves| the areas of |rect| in |new_frame| whose content is in
+  // |old_frame|, shifted vertically or, if there is no vertical shift,
+  // horizontally, within |rect|. Both frames must have the same size and
+  // stride.
+  void DetectMoves(const DesktopFrame& old_frame,
+                   const DesktopFrame& new_frame,
+                   const DesktopRect& rect,
+                   std::vector<DesktopMoveRect>* moves);
+
+ private:
+  // Returns the shift d != 0 for which |new_hashes_|[i] equals
+  // |old_hashes_|[i - d] for the most lines i, counting only lines that are
+  // unique in the old frame, or 0 if no shift matches enough lines.
+  int FindShift();
+
+  // Returns true if (|width|, |height|) pixels at the two positions are equal.
+  static bool AreasEqual(const DesktopFrame& old_frame,
+                         const DesktopVector& old_pos,
+                         const DesktopFrame& new_frame,
+                         const DesktopVector& new_pos,
+                         int width,
+                         int height);
+
+  // Hashes of each pixel row or column of the compared area.
+  std::vector<uint64_t> old_hashes_;
+  std::vector<uint64_t> new_hashes_;
+  // Position of each line hash of the old frame, or -1 if it is repeated, e.g.
+  // in a uniform background.
+  std::unordered_map<uint64_t, int> old_lines_;
+  // Number of matching lines per shift, offset by the number of lines.
+  std::vector<int> votes_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MoveDetector);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_MOVE_DETECTOR_H_
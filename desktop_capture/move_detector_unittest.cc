@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/move_detector.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "modules/desktop_capture/desktop_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kWidth = 200;
+constexpr int kHeight = 300;
+
+// Fills |rect| of |frame| with pixels that differ in every row and column.
+void FillRandom(DesktopFrame* frame, const DesktopRect& rect, uint32_t seed) {
+  uint32_t state = seed;
+  for (int y = rect.top(); y < rect.bottom(); ++y) {
+    for (int x = rect.left(); x < rect.right(); ++x) {
+      state = state * 1664525u + 1013904223u;
+      memcpy(frame->GetFrameDataAtPos(DesktopVector(x, y)), &state,
+             sizeof(state));
+    }
+  }
+}
+
+std::unique_ptr<DesktopFrame> CreateRandomFrame(uint32_t seed) {
+  std::unique_ptr<DesktopFrame> frame(
+      new BasicDesktopFrame(DesktopSize(kWidth, kHeight)));
+  FillRandom(frame.get(), DesktopRect::MakeSize(frame->size()), seed);
+  return frame;
+}
+
+// Copies |source| of |old_frame| to |dest| of |new_frame|.
+void CopyArea(const DesktopFrame& old_frame,
+              const DesktopVector& source,
+              DesktopFrame* new_frame,
+              const DesktopRect& dest) {
+  for (int y = 0; y < dest.height(); ++y) {
+    memcpy(new_frame->GetFrameDataAtPos(
+               DesktopVector(dest.left(), dest.top() + y)),
+           old_frame.GetFrameDataAtPos(
+               DesktopVector(source.x(), source.y() + y)),
+           dest.width() * DesktopFrame::kBytesPerPixel);
+  }
+}
+
+}  // namespace
+
+TEST(MoveDetectorTest, DetectsVerticalScroll) {
+  std::unique_ptr<DesktopFrame> old_frame = CreateRandomFrame(1);
+  std::unique_ptr<DesktopFrame> new_frame = CreateRandomFrame(2);
+  // Scrolls the content up by 40 rows.
+  CopyArea(*old_frame, DesktopVector(0, 40), new_frame.get(),
+           DesktopRect::MakeWH(kWidth, kHeight - 40));
+
+  MoveDetector detector;
+  std::vector<DesktopMoveRect> moves;
+  detector.DetectMoves(*old_frame, *new_frame,
+                       DesktopRect::MakeWH(kWidth, kHeight), &moves);
+  ASSERT_EQ(1u, moves.size());
+  EXPECT_TRUE(moves[0].source.equals(DesktopVector(0, 40)));
+  EXPECT_TRUE(moves[0].dest.equals(DesktopRect::MakeWH(kWidth, kHeight - 40)));
+}
+
+TEST(MoveDetectorTest, DetectsHorizontalScroll) {
+  std::unique_ptr<DesktopFrame> old_frame = CreateRandomFrame(1);
+  std::unique_ptr<DesktopFrame> new_frame = CreateRandomFrame(2);
+  // Scrolls the content right by 24 columns.
+  CopyArea(*old_frame, DesktopVector(0, 0), new_frame.get(),
+           DesktopRect::MakeLTRB(24, 0, kWidth, kHeight));
+
+  MoveDetector detector;
+  std::vector<DesktopMoveRect> moves;
+  detector.DetectMoves(*old_frame, *new_frame,
+                       DesktopRect::MakeWH(kWidth, kHeight), &moves);
+  ASSERT_EQ(1u, moves.size());
+  EXPECT_TRUE(moves[0].source.equals(DesktopVector(0, 0)));
+  EXPECT_TRUE(
+      moves[0].dest.equals(DesktopRect::MakeLTRB(24, 0, kWidth, kHeight)));
+}
+
+TEST(MoveDetectorTest, DetectsScrollInsideRect) {
+  std::unique_ptr<DesktopFrame> old_frame = CreateRandomFrame(1);
+  std::unique_ptr<DesktopFrame> new_frame = CreateRandomFrame(2);
+  // A 100x200 window at (50, 60) whose content scrolls down by 16 rows.
+  const DesktopRect window = DesktopRect::MakeXYWH(50, 60, 100, 200);
+  CopyArea(*old_frame, DesktopVector(50, 60), new_frame.get(),
+           DesktopRect::MakeXYWH(50, 76, 100, 184));
+
+  MoveDetector detector;
+  std::vector<DesktopMoveRect> moves;
+  detector.DetectMoves(*old_frame, *new_frame, window, &moves);
+  ASSERT_EQ(1u, moves.size());
+  EXPECT_TRUE(moves[0].source.equals(DesktopVector(50, 60)));
+  EXPECT_TRUE(moves[0].dest.equals(DesktopRect::MakeXYWH(50, 76, 100, 184)));
+}
+
+TEST(MoveDetectorTest, NoMovesInUnrelatedContent) {
+  std::unique_ptr<DesktopFrame> old_frame = CreateRandomFrame(1);
+  std::unique_ptr<DesktopFrame> new_frame = CreateRandomFrame(2);
+
+  MoveDetector detector;
+  std::vector<DesktopMoveRect> moves;
+  detector.DetectMoves(*old_frame, *new_frame,
+                       DesktopRect::MakeWH(kWidth, kHeight), &moves);
+  EXPECT_TRUE(moves.empty());
+
+  // Nor in unchanged content.
+  detector.DetectMoves(*old_frame, *old_frame,
+                       DesktopRect::MakeWH(kWidth, kHeight), &moves);
+  EXPECT_TRUE(moves.empty());
+}
+
+TEST(MoveDetectorTest, IgnoresMovesShorterThanMinMoveLength) {
+  std::unique_ptr<DesktopFrame> old_frame = CreateRandomFrame(1);
+  std::unique_ptr<DesktopFrame> new_frame = CreateRandomFrame(2);
+  CopyArea(*old_frame, DesktopVector(0, 100), new_frame.get(),
+           DesktopRect::MakeXYWH(0, 50, kWidth,
+                                 MoveDetector::kMinMoveLength - 1));
+
+  MoveDetector detector;
+  std::vector<DesktopMoveRect> moves;
+  detector.DetectMoves(*old_frame, *new_frame,
+                       DesktopRect::MakeWH(kWidth, kHeight), &moves);
+  EXPECT_TRUE(moves.empty());
+}
+
+}  // namespace webrtc
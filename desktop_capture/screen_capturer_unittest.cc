@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <memory>
 
 #include "modules/desktop_capture/desktop_capture_options.h"
@@ -17,6 +18,7 @@
 #include "modules/desktop_capture/mock_desktop_capturer_callback.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -214,4 +216,38 @@ TEST_F(ScreenCapturerTest, UseDirectxCapturerWithSharedBuffers) {
 
 #endif  // defined(WEBRTC_WIN)
 
+#if defined(USE_X11)
+
+// Logs the frame rate of the X11 capturer with and without XDamage. Needs a
+// real X display, so it is disabled by default. Run it manually on a large
+// (e.g. multi-monitor) display to compare the capture modes.
+TEST_F(ScreenCapturerTest, DISABLED_CaptureThroughput) {
+  const int kNumFrames = 100;
+  for (bool use_update_notifications : {false, true}) {
+    DesktopCaptureOptions options(DesktopCaptureOptions::CreateDefault());
+    options.set_use_update_notifications(use_update_notifications);
+    capturer_ = DesktopCapturer::CreateScreenCapturer(options);
+    ASSERT_TRUE(capturer_);
+
+    MockDesktopCapturerCallback callback;
+    EXPECT_CALL(callback,
+                OnCaptureResultPtr(DesktopCapturer::Result::SUCCESS, _))
+        .Times(kNumFrames);
+    capturer_->Start(&callback);
+
+    int64_t start_ms = rtc::TimeMillis();
+    for (int i = 0; i < kNumFrames; i++) {
+      capturer_->CaptureFrame();
+    }
+    int64_t elapsed_ms = std::max<int64_t>(rtc::TimeMillis() - start_ms, 1);
+    RTC_LOG(LS_INFO) << "Captured " << kNumFrames << " frames "
+                     << (use_update_notifications ? "with" : "without")
+                     << " XDamage in " << elapsed_ms << " ms, "
+                     << kNumFrames * 1000 / elapsed_ms << " fps.";
+    capturer_.reset();
+  }
+}
+
+#endif  // defined(USE_X11)
+
 }  // namespace webrtc
@@ -24,10 +24,16 @@ namespace webrtc {
 
 namespace {
 
-std::unique_ptr<DesktopCapturer> CreateScreenCapturerWinDirectx() {
-  std::unique_ptr<DesktopCapturer> capturer(new ScreenCapturerWinDirectx());
-  capturer.reset(new BlankDetectorDesktopCapturerWrapper(
-      std::move(capturer), RgbaColor(0, 0, 0, 0)));
+std::unique_ptr<DesktopCapturer> CreateScreenCapturerWinDirectx(
+    const DesktopCaptureOptions& options) {
+  std::unique_ptr<DesktopCapturer> capturer(
+      new ScreenCapturerWinDirectx(options.dxgi_texture_callback()));
+  // The pixels of the frames are not filled when the capturer outputs shared
+  // textures, so the blank detector would reject every frame.
+  if (!options.dxgi_texture_callback()) {
+    capturer.reset(new BlankDetectorDesktopCapturerWrapper(
+        std::move(capturer), RgbaColor(0, 0, 0, 0)));
+  }
   return capturer;
 }
 
@@ -43,7 +49,7 @@ std::unique_ptr<DesktopCapturer> DesktopCapturer::CreateRawScreenCapturer(
     auto dxgi_duplicator_controller = DxgiDuplicatorController::Instance();
     if (ScreenCapturerWinDirectx::IsSupported()) {
       capturer.reset(new FallbackDesktopCapturerWrapper(
-          CreateScreenCapturerWinDirectx(), std::move(capturer)));
+          CreateScreenCapturerWinDirectx(options), std::move(capturer)));
     }
   }
 
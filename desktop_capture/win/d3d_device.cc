@@ -66,6 +66,14 @@ bool D3dDevice::Initialize(const ComPtr<IDXGIAdapter>& adapter) {
   return true;
 }
 
+bool D3dDevice::RecreateDevice() {
+  const ComPtr<IDXGIAdapter> adapter = dxgi_adapter_;
+  d3d_device_.Reset();
+  context_.Reset();
+  dxgi_device_.Reset();
+  return Initialize(adapter);
+}
+
 // static
 std::vector<D3dDevice> D3dDevice::EnumDevices() {
   ComPtr<IDXGIFactory1> factory;
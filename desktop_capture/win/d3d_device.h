@@ -36,6 +36,11 @@ class D3dDevice {
 
   IDXGIAdapter* dxgi_adapter() const { return dxgi_adapter_.Get(); }
 
+  // Replaces the ID3D11Device and its context with newly created ones on the
+  // same video card. The devices are created single-threaded, so a copy of a
+  // D3dDevice can be used on another thread once this function succeeds.
+  bool RecreateDevice();
+
   // Returns all D3dDevice instances on the system. Returns an empty vector if
   // anything wrong.
   static std::vector<D3dDevice> EnumDevices();
@@ -12,6 +12,7 @@
 
 #include <comdef.h>
 #include <dxgi.h>
+#include <string.h>
 
 #include <algorithm>
 
@@ -80,7 +81,16 @@ bool DxgiAdapterDuplicator::DoInitialize() {
                  "DirectX 11";
           continue;
         }
-        DxgiOutputDuplicator duplicator(device_, output1, desc);
+        // The first screen uses |device_|, the others get their own device so
+        // that the screens can be duplicated on different threads.
+        D3dDevice device = device_;
+        if (!duplicators_.empty() && !device.RecreateDevice()) {
+          RTC_LOG(LS_WARNING) << "Failed to create a D3D device for output "
+                              << i << ", its duplication won't be concurrent.";
+          device = device_;
+          concurrent_ = false;
+        }
+        DxgiOutputDuplicator duplicator(device, output1, desc);
         if (!duplicator.Initialize()) {
           RTC_LOG(LS_WARNING) << "Failed to initialize DxgiOutputDuplicator on "
                                  "output "
@@ -131,15 +141,24 @@ bool DxgiAdapterDuplicator::Duplicate(Context* context,
                                       SharedDesktopFrame* target) {
   RTC_DCHECK_EQ(context->contexts.size(), duplicators_.size());
   for (size_t i = 0; i < duplicators_.size(); i++) {
-    if (!duplicators_[i].Duplicate(&context->contexts[i],
-                                   duplicators_[i].desktop_rect().top_left(),
-                                   target)) {
+    if (!DuplicateScreen(context, static_cast<int>(i), target)) {
       return false;
     }
   }
   return true;
 }
 
+bool DxgiAdapterDuplicator::DuplicateScreen(Context* context,
+                                            int id,
+                                            SharedDesktopFrame* target) {
+  RTC_DCHECK_GE(id, 0);
+  RTC_DCHECK_LT(id, duplicators_.size());
+  RTC_DCHECK_EQ(context->contexts.size(), duplicators_.size());
+  return duplicators_[id].Duplicate(&context->contexts[id],
+                                    duplicators_[id].desktop_rect().top_left(),
+                                    target);
+}
+
 bool DxgiAdapterDuplicator::DuplicateMonitor(Context* context,
                                              int monitor_id,
                                              SharedDesktopFrame* target) {
@@ -150,6 +169,31 @@ bool DxgiAdapterDuplicator::DuplicateMonitor(Context* context,
                                             DesktopVector(), target);
 }
 
+bool DxgiAdapterDuplicator::DuplicateMonitorTexture(
+    Context* context,
+    int monitor_id,
+    DesktopRegion* updated_region,
+    HANDLE* shared_handle) {
+  RTC_DCHECK_GE(monitor_id, 0);
+  RTC_DCHECK_LT(monitor_id, duplicators_.size());
+  RTC_DCHECK_EQ(context->contexts.size(), duplicators_.size());
+  return duplicators_[monitor_id].DuplicateTexture(
+      &context->contexts[monitor_id], updated_region, shared_handle);
+}
+
+bool DxgiAdapterDuplicator::SupportsTextureOutput(int monitor_id) const {
+  RTC_DCHECK_GE(monitor_id, 0);
+  RTC_DCHECK_LT(monitor_id, duplicators_.size());
+  return duplicators_[monitor_id].SupportsTextureOutput();
+}
+
+LUID DxgiAdapterDuplicator::adapter_luid() const {
+  DXGI_ADAPTER_DESC desc;
+  memset(&desc, 0, sizeof(desc));
+  device_.dxgi_adapter()->GetDesc(&desc);
+  return desc.AdapterLuid;
+}
+
 DesktopRect DxgiAdapterDuplicator::ScreenRect(int id) const {
   RTC_DCHECK_GE(id, 0);
   RTC_DCHECK_LT(id, duplicators_.size());
@@ -46,12 +46,37 @@ class DxgiAdapterDuplicator {
   // instances owned by this instance, and writes into |target|.
   bool Duplicate(Context* context, SharedDesktopFrame* target);
 
+  // Captures one screen into its position in the desktop, the same as
+  // Duplicate() does for each of them. |id| should be between
+  // [0, screen_count()). If SupportsConcurrentDuplication() returns true,
+  // different screens can be captured at the same time on different threads,
+  // as long as each thread writes into its own SharedDesktopFrame.
+  bool DuplicateScreen(Context* context, int id, SharedDesktopFrame* target);
+
+  // Whether each screen owns its own D3D device, so DuplicateScreen() can be
+  // called concurrently.
+  bool SupportsConcurrentDuplication() const { return concurrent_; }
+
   // Captures one monitor and writes into |target|. |monitor_id| should be
   // between [0, screen_count()).
   bool DuplicateMonitor(Context* context,
                         int monitor_id,
                         SharedDesktopFrame* target);
 
+  // Captures one monitor into a shared texture. See
+  // DxgiOutputDuplicator::DuplicateTexture(). |monitor_id| should be between
+  // [0, screen_count()).
+  bool DuplicateMonitorTexture(Context* context,
+                               int monitor_id,
+                               DesktopRegion* updated_region,
+                               HANDLE* shared_handle);
+
+  // Whether DuplicateMonitorTexture() can be used for |monitor_id|.
+  bool SupportsTextureOutput(int monitor_id) const;
+
+  // Returns the LUID of the video card.
+  LUID adapter_luid() const;
+
   // Returns desktop rect covered by this DxgiAdapterDuplicator.
   DesktopRect desktop_rect() const { return desktop_rect_; }
 
@@ -85,6 +110,7 @@ class DxgiAdapterDuplicator {
   const D3dDevice device_;
   std::vector<DxgiOutputDuplicator> duplicators_;
   DesktopRect desktop_rect_;
+  bool concurrent_ = true;
 };
 
 }  // namespace webrtc
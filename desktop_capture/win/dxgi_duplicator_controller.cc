@@ -13,18 +13,77 @@
 #include <windows.h>
 
 #include <algorithm>
+#include <functional>
 #include <string>
+#include <utility>
 
 #include "modules/desktop_capture/desktop_capture_types.h"
 #include "modules/desktop_capture/win/dxgi_frame.h"
 #include "modules/desktop_capture/win/screen_capture_utils.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/sleep.h"
 
 namespace webrtc {
 
+class DxgiDuplicatorController::Worker {
+ public:
+  using Task = std::function<bool(SharedDesktopFrame*)>;
+
+  Worker() : thread_(&Worker::Run, this, "DxgiDuplicatorWorker") {
+    thread_.Start();
+  }
+
+  ~Worker() {
+    stop_ = true;
+    start_.Set();
+    thread_.Stop();
+  }
+
+  // Starts running |task| on the thread of this instance. |target| should
+  // not be used by any other thread until Wait() returns.
+  void Start(Task task, std::unique_ptr<SharedDesktopFrame> target) {
+    task_ = std::move(task);
+    target_ = std::move(target);
+    start_.Set();
+  }
+
+  // Waits for the task given to Start(), adds the updated region of its
+  // |target| into |updated_region| and returns its result.
+  bool Wait(DesktopRegion* updated_region) {
+    done_.Wait(rtc::Event::kForever);
+    updated_region->AddRegion(target_->updated_region());
+    target_.reset();
+    task_ = nullptr;
+    return result_;
+  }
+
+ private:
+  static void Run(void* obj) {
+    Worker* worker = static_cast<Worker*>(obj);
+    while (true) {
+      worker->start_.Wait(rtc::Event::kForever);
+      if (worker->stop_) {
+        return;
+      }
+      worker->result_ = worker->task_(worker->target_.get());
+      worker->done_.Set();
+    }
+  }
+
+  rtc::PlatformThread thread_;
+  rtc::Event start_;
+  rtc::Event done_;
+  // Written before |start_| is set, and read after |done_| is set.
+  bool stop_ = false;
+  bool result_ = false;
+  Task task_;
+  std::unique_ptr<SharedDesktopFrame> target_;
+};
+
 // static
 std::string DxgiDuplicatorController::ResultName(
     DxgiDuplicatorController::Result result) {
@@ -41,6 +100,8 @@ std::string DxgiDuplicatorController::ResultName(
       return "Duplication failed";
     case Result::INVALID_MONITOR_ID:
       return "Invalid monitor id";
+    case Result::UNSUPPORTED_TEXTURE_OUTPUT:
+      return "Unsupported texture output";
     default:
       return "Unknown error";
   }
@@ -105,14 +166,21 @@ bool DxgiDuplicatorController::RetrieveD3dInfo(D3dInfo* info) {
 
 DxgiDuplicatorController::Result DxgiDuplicatorController::Duplicate(
     DxgiFrame* frame) {
-  return DoDuplicate(frame, -1);
+  return DoDuplicate(frame, -1, false);
 }
 
 DxgiDuplicatorController::Result DxgiDuplicatorController::DuplicateMonitor(
     DxgiFrame* frame,
     int monitor_id) {
   RTC_DCHECK_GE(monitor_id, 0);
-  return DoDuplicate(frame, monitor_id);
+  return DoDuplicate(frame, monitor_id, false);
+}
+
+DxgiDuplicatorController::Result
+DxgiDuplicatorController::DuplicateMonitorTexture(DxgiFrame* frame,
+                                                  int monitor_id) {
+  RTC_DCHECK_GE(monitor_id, 0);
+  return DoDuplicate(frame, monitor_id, true);
 }
 
 DesktopVector DxgiDuplicatorController::dpi() {
@@ -143,7 +211,8 @@ bool DxgiDuplicatorController::GetDeviceNames(
 
 DxgiDuplicatorController::Result DxgiDuplicatorController::DoDuplicate(
     DxgiFrame* frame,
-    int monitor_id) {
+    int monitor_id,
+    bool texture_output) {
   RTC_DCHECK(frame);
   rtc::CritScope lock(&lock_);
 
@@ -181,7 +250,17 @@ DxgiDuplicatorController::Result DxgiDuplicatorController::DoDuplicate(
 
   frame->frame()->mutable_updated_region()->Clear();
 
-  if (DoDuplicateUnlocked(frame->context(), monitor_id, frame->frame())) {
+  bool result = false;
+  if (texture_output) {
+    if (monitor_id < ScreenCountUnlocked() &&
+        !SupportsTextureOutput(monitor_id)) {
+      return Result::UNSUPPORTED_TEXTURE_OUTPUT;
+    }
+    result = DoDuplicateTextureUnlocked(frame, monitor_id);
+  } else {
+    result = DoDuplicateUnlocked(frame->context(), monitor_id, frame->frame());
+  }
+  if (result) {
     succeeded_duplications_++;
     return Result::SUCCEEDED;
   }
@@ -289,6 +368,7 @@ bool DxgiDuplicatorController::DoInitialize() {
 void DxgiDuplicatorController::Deinitialize() {
   desktop_rect_ = DesktopRect();
   duplicators_.clear();
+  workers_.clear();
   display_configuration_monitor_.Reset();
 }
 
@@ -338,12 +418,45 @@ bool DxgiDuplicatorController::DoDuplicateUnlocked(Context* context,
 
 bool DxgiDuplicatorController::DoDuplicateAll(Context* context,
                                               SharedDesktopFrame* target) {
+  // Each task writes into its own region of |target|.
+  std::vector<Worker::Task> tasks;
   for (size_t i = 0; i < duplicators_.size(); i++) {
-    if (!duplicators_[i].Duplicate(&context->contexts[i], target)) {
-      return false;
+    DxgiAdapterDuplicator* duplicator = &duplicators_[i];
+    DxgiAdapterDuplicator::Context* adapter_context = &context->contexts[i];
+    if (duplicator->SupportsConcurrentDuplication()) {
+      for (int id = 0; id < duplicator->screen_count(); id++) {
+        tasks.push_back([duplicator, adapter_context, id](
+                            SharedDesktopFrame* frame) {
+          return duplicator->DuplicateScreen(adapter_context, id, frame);
+        });
+      }
+    } else {
+      tasks.push_back([duplicator, adapter_context](SharedDesktopFrame* frame) {
+        return duplicator->Duplicate(adapter_context, frame);
+      });
     }
   }
-  return true;
+  if (tasks.empty()) {
+    return true;
+  }
+
+  while (workers_.size() < tasks.size() - 1) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  // The workers write into frames sharing the pixels of |target|, so their
+  // updated regions do not race with the one of |target|.
+  for (size_t i = 1; i < tasks.size(); i++) {
+    std::unique_ptr<SharedDesktopFrame> frame = target->Share();
+    frame->mutable_updated_region()->Clear();
+    workers_[i - 1]->Start(std::move(tasks[i]), std::move(frame));
+  }
+  bool result = tasks[0](target);
+  for (size_t i = 1; i < tasks.size(); i++) {
+    if (!workers_[i - 1]->Wait(target->mutable_updated_region())) {
+      result = false;
+    }
+  }
+  return result;
 }
 
 bool DxgiDuplicatorController::DoDuplicateOne(Context* context,
@@ -366,6 +479,49 @@ bool DxgiDuplicatorController::DoDuplicateOne(Context* context,
   return false;
 }
 
+bool DxgiDuplicatorController::DoDuplicateTextureUnlocked(DxgiFrame* frame,
+                                                          int monitor_id) {
+  RTC_DCHECK(monitor_id >= 0);
+  Context* context = frame->context();
+  SharedDesktopFrame* target = frame->frame();
+  Setup(context);
+
+  if (!EnsureFrameCaptured(context, target)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < duplicators_.size() && i < context->contexts.size();
+       i++) {
+    if (monitor_id >= duplicators_[i].screen_count()) {
+      monitor_id -= duplicators_[i].screen_count();
+    } else {
+      HANDLE shared_handle = nullptr;
+      if (!duplicators_[i].DuplicateMonitorTexture(
+              &context->contexts[i], monitor_id,
+              target->mutable_updated_region(), &shared_handle)) {
+        return false;
+      }
+      frame->SetSharedTexture(shared_handle, duplicators_[i].adapter_luid());
+      target->set_top_left(duplicators_[i].ScreenRect(monitor_id).top_left());
+      target->set_dpi(dpi_);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DxgiDuplicatorController::SupportsTextureOutput(int monitor_id) const {
+  RTC_DCHECK(monitor_id >= 0);
+  for (const auto& duplicator : duplicators_) {
+    if (monitor_id >= duplicator.screen_count()) {
+      monitor_id -= duplicator.screen_count();
+    } else {
+      return duplicator.SupportsTextureOutput(monitor_id);
+    }
+  }
+  return false;
+}
+
 int64_t DxgiDuplicatorController::GetNumFramesCaptured() const {
   int64_t min = INT64_MAX;
   for (const auto& duplicator : duplicators_) {
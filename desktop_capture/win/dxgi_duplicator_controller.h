@@ -14,6 +14,7 @@
 #include <d3dcommon.h>
 
 #include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -66,6 +67,7 @@ class DxgiDuplicatorController {
     INITIALIZATION_FAILED,
     DUPLICATION_FAILED,
     INVALID_MONITOR_ID,
+    UNSUPPORTED_TEXTURE_OUTPUT,
   };
 
   // Converts |result| into user-friendly string representation. The return
@@ -100,6 +102,13 @@ class DxgiDuplicatorController {
   // this function returns false.
   Result DuplicateMonitor(DxgiFrame* frame, int monitor_id);
 
+  // Same as DuplicateMonitor(), but captures into the shared texture returned
+  // by |frame|->shared_texture_handle() instead of the pixels of
+  // |frame|->frame(). The other information of |frame|->frame(), such as its
+  // updated region, is still written. Returns UNSUPPORTED_TEXTURE_OUTPUT if the
+  // monitor can only be captured by DuplicateMonitor().
+  Result DuplicateMonitorTexture(DxgiFrame* frame, int monitor_id);
+
   // Returns dpi of current system. Returns an empty DesktopVector if system
   // does not support DXGI based capturer.
   DesktopVector dpi();
@@ -131,15 +140,20 @@ class DxgiDuplicatorController {
   // be deleted.
   ~DxgiDuplicatorController();
 
+  // Captures one DxgiAdapterDuplicator or one screen on its own thread. See
+  // DoDuplicateAll().
+  class Worker;
+
   // RefCountedInterface implementations.
   void AddRef();
   void Release();
 
   // Does the real duplication work. Setting |monitor_id| < 0 to capture entire
-  // screen. This function calls Initialize(). And if the duplication failed,
+  // screen. If |texture_output| is true, captures |monitor_id| into a shared
+  // texture. This function calls Initialize(). And if the duplication failed,
   // this function calls Deinitialize() to ensure the Dxgi components can be
   // reinitialized next time.
-  Result DoDuplicate(DxgiFrame* frame, int monitor_id);
+  Result DoDuplicate(DxgiFrame* frame, int monitor_id, bool texture_output);
 
   // Unload all the DXGI components and releases the resources. This function
   // wraps Deinitialize() with |lock_|.
@@ -175,7 +189,8 @@ class DxgiDuplicatorController {
                            int monitor_id,
                            SharedDesktopFrame* target);
 
-  // Captures all monitors.
+  // Captures all monitors. Monitors with their own D3D device are captured
+  // concurrently, on the calling thread and on |workers_|.
   bool DoDuplicateAll(Context* context, SharedDesktopFrame* target);
 
   // Captures one monitor.
@@ -183,6 +198,12 @@ class DxgiDuplicatorController {
                       int monitor_id,
                       SharedDesktopFrame* target);
 
+  // Captures one monitor into the shared texture of |frame|.
+  bool DoDuplicateTextureUnlocked(DxgiFrame* frame, int monitor_id);
+
+  // Whether |monitor_id| can be captured by DoDuplicateTextureUnlocked().
+  bool SupportsTextureOutput(int monitor_id) const;
+
   // The minimum GetNumFramesCaptured() returned by |duplicators_|.
   int64_t GetNumFramesCaptured() const;
 
@@ -231,6 +252,8 @@ class DxgiDuplicatorController {
   DisplayConfigurationMonitor display_configuration_monitor_;
   // A number to indicate how many succeeded duplications have been performed.
   uint32_t succeeded_duplications_ = 0;
+  // Created on demand by DoDuplicateAll(), and stopped by Deinitialize().
+  std::vector<std::unique_ptr<Worker>> workers_;
 };
 
 }  // namespace webrtc
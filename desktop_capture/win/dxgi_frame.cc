@@ -74,4 +74,9 @@ DxgiFrame::Context* DxgiFrame::context() {
   return &context_;
 }
 
+void DxgiFrame::SetSharedTexture(HANDLE shared_handle, LUID adapter_luid) {
+  shared_texture_handle_ = shared_handle;
+  adapter_luid_ = adapter_luid;
+}
+
 }  // namespace webrtc
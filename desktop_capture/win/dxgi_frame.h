@@ -11,6 +11,8 @@
 #ifndef MODULES_DESKTOP_CAPTURE_WIN_DXGI_FRAME_H_
 #define MODULES_DESKTOP_CAPTURE_WIN_DXGI_FRAME_H_
 
+#include <windows.h>
+
 #include <memory>
 #include <vector>
 
@@ -40,6 +42,13 @@ class DxgiFrame final {
   // Should not be called if Prepare() is not executed or returns false.
   SharedDesktopFrame* frame() const;
 
+  // The shared texture written by the last successful
+  // DxgiDuplicatorController::DuplicateMonitorTexture() call, or nullptr if
+  // nothing has been captured into a texture yet. See
+  // DxgiTextureCallback::OnTexture().
+  HANDLE shared_texture_handle() const { return shared_texture_handle_; }
+  LUID adapter_luid() const { return adapter_luid_; }
+
  private:
   // Allows DxgiDuplicatorController to access Prepare() and context() function
   // as well as Context class.
@@ -51,11 +60,15 @@ class DxgiFrame final {
   // Should not be called if Prepare() is not executed or returns false.
   Context* context();
 
+  void SetSharedTexture(HANDLE shared_handle, LUID adapter_luid);
+
   SharedMemoryFactory* const factory_;
   ResolutionTracker resolution_tracker_;
   DesktopCapturer::SourceId source_id_ = kFullDesktopScreenId;
   std::unique_ptr<SharedDesktopFrame> frame_;
   Context context_;
+  HANDLE shared_texture_handle_ = nullptr;
+  LUID adapter_luid_ = {0};
 };
 
 }  // namespace webrtc
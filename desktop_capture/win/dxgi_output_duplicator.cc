@@ -81,6 +81,7 @@ DxgiOutputDuplicator::~DxgiOutputDuplicator() {
     duplication_->ReleaseFrame();
   }
   texture_.reset();
+  shared_texture_.reset();
 }
 
 bool DxgiOutputDuplicator::Initialize() {
@@ -238,6 +239,78 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
   return error.Error() == DXGI_ERROR_WAIT_TIMEOUT || ReleaseFrame();
 }
 
+bool DxgiOutputDuplicator::DuplicateTexture(Context* context,
+                                            DesktopRegion* updated_region,
+                                            HANDLE* shared_handle) {
+  RTC_DCHECK(duplication_);
+  RTC_DCHECK(SupportsTextureOutput());
+  RTC_DCHECK(updated_region);
+  RTC_DCHECK(shared_handle);
+  if (!shared_texture_) {
+    shared_texture_.reset(new DxgiTextureShared(device_));
+  }
+
+  DXGI_OUTDUPL_FRAME_INFO frame_info;
+  memset(&frame_info, 0, sizeof(frame_info));
+  ComPtr<IDXGIResource> resource;
+  _com_error error = duplication_->AcquireNextFrame(
+      kAcquireTimeoutMs, &frame_info, resource.GetAddressOf());
+  if (error.Error() != S_OK && error.Error() != DXGI_ERROR_WAIT_TIMEOUT) {
+    RTC_LOG(LS_ERROR) << "Failed to capture frame, error "
+                      << error.ErrorMessage() << ", code " << error.Error();
+    return false;
+  }
+
+  // See Duplicate() for how |context|->updated_region is maintained.
+  DesktopRegion context_region;
+  context_region.Swap(&context->updated_region);
+  if (error.Error() == S_OK && frame_info.AccumulatedFrames > 0 && resource) {
+    DetectUpdatedRegion(frame_info, &context->updated_region);
+    SpreadContextChange(context);
+    ComPtr<ID3D11Texture2D> texture;
+    error = resource.As(&texture);
+    if (error.Error() != S_OK || !texture) {
+      RTC_LOG(LS_ERROR) << "Failed to convert IDXGIResource to "
+                           "ID3D11Texture2D, error "
+                        << error.ErrorMessage() << ", code " << error.Error();
+      ReleaseFrame();
+      return false;
+    }
+    const HANDLE last_shared_handle = shared_texture_->shared_handle();
+    if (!shared_texture_->CopyFrom(texture.Get())) {
+      ReleaseFrame();
+      return false;
+    }
+    context_region.AddRegion(context->updated_region);
+    if (shared_texture_->shared_handle() != last_shared_handle) {
+      // A new texture has none of the content of the previous one.
+      context_region.SetRect(GetUntranslatedDesktopRect());
+    }
+    updated_region->AddRegion(context_region);
+    *shared_handle = shared_texture_->shared_handle();
+    return ReleaseFrame();
+  }
+
+  *shared_handle = shared_texture_->shared_handle();
+  if (*shared_handle) {
+    // No change since last frame or AcquireNextFrame() timed out, the shared
+    // texture still has the latest content.
+    updated_region->AddRegion(context_region);
+  } else {
+    // Nothing has been captured into the shared texture yet, the
+    // context->updated_region should be kept unchanged for next attempt.
+    context->updated_region.Swap(&context_region);
+  }
+  // If AcquireNextFrame() failed with timeout error, we do not need to release
+  // the frame.
+  return error.Error() == DXGI_ERROR_WAIT_TIMEOUT || ReleaseFrame();
+}
+
+bool DxgiOutputDuplicator::SupportsTextureOutput() const {
+  return duplication_ && !desc_.DesktopImageInSystemMemory &&
+         rotation_ == Rotation::CLOCK_WISE_0;
+}
+
 DesktopRect DxgiOutputDuplicator::GetTranslatedDesktopRect(
     DesktopVector offset) const {
   DesktopRect result(DesktopRect::MakeSize(desktop_size()));
@@ -27,6 +27,7 @@
 #include "modules/desktop_capture/win/d3d_device.h"
 #include "modules/desktop_capture/win/dxgi_context.h"
 #include "modules/desktop_capture/win/dxgi_texture.h"
+#include "modules/desktop_capture/win/dxgi_texture_shared.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -66,6 +67,21 @@ class DxgiOutputDuplicator {
                  DesktopVector offset,
                  SharedDesktopFrame* target);
 
+  // Same as Duplicate(), but copies the content of current IDXGIOutput into a
+  // shared texture on the GPU instead of into a DesktopFrame, and returns the
+  // shared handle of the texture in |shared_handle|. The region updated since
+  // the last call with |context| is added to |updated_region|, relative to
+  // (0, 0). |shared_handle| is set to nullptr if no frame has been captured
+  // into the texture yet. Should only be called if SupportsTextureOutput()
+  // returns true. Returns false in case of a failure.
+  bool DuplicateTexture(Context* context,
+                        DesktopRegion* updated_region,
+                        HANDLE* shared_handle);
+
+  // Whether DuplicateTexture() can be used. Rotated outputs and outputs which
+  // are not backed by a GPU texture can only be captured by Duplicate().
+  bool SupportsTextureOutput() const;
+
   // Returns the desktop rect covered by this DxgiOutputDuplicator.
   DesktopRect desktop_rect() const { return desktop_rect_; }
 
@@ -122,6 +138,8 @@ class DxgiOutputDuplicator {
   DXGI_OUTDUPL_DESC desc_;
   std::vector<uint8_t> metadata_;
   std::unique_ptr<DxgiTexture> texture_;
+  // Only created when DuplicateTexture() is used.
+  std::unique_ptr<DxgiTextureShared> shared_texture_;
   Rotation rotation_;
   DesktopSize unrotated_size_;
 
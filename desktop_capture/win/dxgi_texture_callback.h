@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_CALLBACK_H_
+#define MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_CALLBACK_H_
+
+#include <windows.h>
+
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
+
+namespace webrtc {
+
+// Receives frames of ScreenCapturerWinDirectx as shared D3D11 textures, so that
+// consumers such as hardware encoders can use the screen content without it
+// being copied to system memory. See
+// DesktopCaptureOptions::set_dxgi_texture_callback().
+class DxgiTextureCallback {
+ public:
+  // Called on the capturing thread right before
+  // DesktopCapturer::Callback::OnCaptureResult() for a frame that has been
+  // captured into a texture. The DesktopFrame passed to OnCaptureResult() then
+  // carries the size, updated region and other frame information, but its
+  // pixels are not filled.
+  //
+  // |shared_handle| can be opened by ID3D11Device::OpenSharedResource() on any
+  // device of the adapter |adapter_luid| belongs to. The texture is in
+  // DXGI_FORMAT_B8G8R8A8_UNORM and has the size of the monitor. It is
+  // overwritten by the next frame of any DXGI capturer of the same monitor, so
+  // consumers should copy or encode it before returning from OnCaptureResult().
+  // |updated_region| is the area changed since the last texture delivered to
+  // this callback; a new |shared_handle| always comes with the entire texture
+  // as updated region.
+  virtual void OnTexture(HANDLE shared_handle,
+                         LUID adapter_luid,
+                         const DesktopSize& size,
+                         const DesktopRegion& updated_region) = 0;
+
+ protected:
+  virtual ~DxgiTextureCallback() = default;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_CALLBACK_H_
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/win/dxgi_texture_shared.h"
+
+#include <comdef.h>
+#include <dxgi.h>
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace webrtc {
+
+DxgiTextureShared::DxgiTextureShared(const D3dDevice& device)
+    : device_(device) {}
+
+DxgiTextureShared::~DxgiTextureShared() = default;
+
+bool DxgiTextureShared::InitializeTexture(ID3D11Texture2D* texture) {
+  RTC_DCHECK(texture);
+  D3D11_TEXTURE2D_DESC desc = {0};
+  texture->GetDesc(&desc);
+
+  desc.ArraySize = 1;
+  desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+  desc.CPUAccessFlags = 0;
+  desc.MipLevels = 1;
+  desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+  desc.SampleDesc.Count = 1;
+  desc.SampleDesc.Quality = 0;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  if (texture_) {
+    D3D11_TEXTURE2D_DESC current_desc;
+    texture_->GetDesc(&current_desc);
+    if (memcmp(&desc, &current_desc, sizeof(D3D11_TEXTURE2D_DESC)) == 0) {
+      return true;
+    }
+
+    // The descriptions are not consistent, we need to create a new
+    // ID3D11Texture2D instance.
+    texture_.Reset();
+    shared_handle_ = nullptr;
+  }
+
+  _com_error error = device_.d3d_device()->CreateTexture2D(
+      &desc, nullptr, texture_.GetAddressOf());
+  if (error.Error() != S_OK || !texture_) {
+    RTC_LOG(LS_ERROR) << "Failed to create a shared ID3D11Texture2D, error "
+                      << error.ErrorMessage() << ", code " << error.Error();
+    texture_.Reset();
+    return false;
+  }
+
+  ComPtr<IDXGIResource> resource;
+  error = texture_.As(&resource);
+  if (error.Error() == S_OK && resource) {
+    error = resource->GetSharedHandle(&shared_handle_);
+  }
+  if (error.Error() != S_OK || !shared_handle_) {
+    RTC_LOG(LS_ERROR) << "Failed to get the shared handle of ID3D11Texture2D, "
+                         "error "
+                      << error.ErrorMessage() << ", code " << error.Error();
+    texture_.Reset();
+    shared_handle_ = nullptr;
+    return false;
+  }
+
+  return true;
+}
+
+bool DxgiTextureShared::CopyFrom(ID3D11Texture2D* texture) {
+  RTC_DCHECK(texture);
+  if (!InitializeTexture(texture)) {
+    return false;
+  }
+
+  device_.context()->CopyResource(static_cast<ID3D11Resource*>(texture_.Get()),
+                                  static_cast<ID3D11Resource*>(texture));
+  // Other devices only see the content of a shared resource once the commands
+  // writing it have been submitted.
+  device_.context()->Flush();
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_SHARED_H_
+#define MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_SHARED_H_
+
+#include <d3d11.h>
+#include <windows.h>
+#include <wrl/client.h>
+
+#include "modules/desktop_capture/win/d3d_device.h"
+
+namespace webrtc {
+
+// An ID3D11Texture2D which can be opened by other ID3D11Device instances on the
+// same adapter through a shared handle. Unlike DxgiTexture, frames are copied
+// into it on the GPU, and never reach system memory.
+//
+// An ID3D11Texture2D is created by an ID3D11Device, so a DxgiTextureShared
+// cannot be shared between two DxgiAdapterDuplicators.
+class DxgiTextureShared {
+ public:
+  // Creates a DxgiTextureShared instance. Caller must maintain the lifetime of
+  // input device to make sure it outlives this instance.
+  explicit DxgiTextureShared(const D3dDevice& device);
+
+  ~DxgiTextureShared();
+
+  // Copies |texture|, which must be created by the same device, into the
+  // shared texture. The shared texture is recreated, and gets a new
+  // shared_handle(), if the description of |texture| changes. Returns false if
+  // anything wrong.
+  bool CopyFrom(ID3D11Texture2D* texture);
+
+  // Only valid after a successful CopyFrom() call.
+  HANDLE shared_handle() const { return shared_handle_; }
+
+ private:
+  // Creates |texture_| with the description of |texture| if it does not exist
+  // yet or the description has changed. Returns false if it failed to execute
+  // Windows APIs.
+  bool InitializeTexture(ID3D11Texture2D* texture);
+
+  const D3dDevice device_;
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> texture_;
+  HANDLE shared_handle_ = nullptr;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_WIN_DXGI_TEXTURE_SHARED_H_
@@ -99,7 +99,12 @@ int ScreenCapturerWinDirectx::GetIndexFromScreenId(
 }
 
 ScreenCapturerWinDirectx::ScreenCapturerWinDirectx()
-    : controller_(DxgiDuplicatorController::Instance()) {}
+    : ScreenCapturerWinDirectx(nullptr) {}
+
+ScreenCapturerWinDirectx::ScreenCapturerWinDirectx(
+    DxgiTextureCallback* texture_callback)
+    : controller_(DxgiDuplicatorController::Instance()),
+      texture_callback_(texture_callback) {}
 
 ScreenCapturerWinDirectx::~ScreenCapturerWinDirectx() = default;
 
@@ -127,15 +132,30 @@ void ScreenCapturerWinDirectx::CaptureFrame() {
         std::make_unique<DxgiFrame>(shared_memory_factory_.get()));
   }
 
-  DxgiDuplicatorController::Result result;
+  using DuplicateResult = DxgiDuplicatorController::Result;
+  DuplicateResult result;
+  bool texture_output = false;
   if (current_screen_id_ == kFullDesktopScreenId) {
     result = controller_->Duplicate(frames_.current_frame());
   } else {
-    result = controller_->DuplicateMonitor(frames_.current_frame(),
-                                           current_screen_id_);
+    result = DuplicateResult::UNSUPPORTED_TEXTURE_OUTPUT;
+    if (texture_callback_) {
+      result = controller_->DuplicateMonitorTexture(frames_.current_frame(),
+                                                    current_screen_id_);
+      texture_output = (result != DuplicateResult::UNSUPPORTED_TEXTURE_OUTPUT);
+    }
+    if (result == DuplicateResult::UNSUPPORTED_TEXTURE_OUTPUT) {
+      result = controller_->DuplicateMonitor(frames_.current_frame(),
+                                             current_screen_id_);
+    }
+  }
+
+  if (texture_output && result == DuplicateResult::SUCCEEDED &&
+      !frames_.current_frame()->shared_texture_handle()) {
+    // Nothing has been captured into the texture yet.
+    result = DuplicateResult::DUPLICATION_FAILED;
   }
 
-  using DuplicateResult = DxgiDuplicatorController::Result;
   if (result != DuplicateResult::SUCCEEDED) {
     RTC_LOG(LS_ERROR) << "DxgiDuplicatorController failed to capture desktop, "
                          "error code "
@@ -162,7 +182,8 @@ void ScreenCapturerWinDirectx::CaptureFrame() {
       break;
     }
     case DuplicateResult::INITIALIZATION_FAILED:
-    case DuplicateResult::DUPLICATION_FAILED: {
+    case DuplicateResult::DUPLICATION_FAILED:
+    case DuplicateResult::UNSUPPORTED_TEXTURE_OUTPUT: {
       callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
       break;
     }
@@ -176,6 +197,13 @@ void ScreenCapturerWinDirectx::CaptureFrame() {
       // TODO(julien.isorce): http://crbug.com/945468. Set the icc profile on
       // the frame, see WindowCapturerMac::CaptureFrame.
 
+      if (texture_output) {
+        // |frame| carries the metadata only, its pixels are in the texture.
+        texture_callback_->OnTexture(
+            frames_.current_frame()->shared_texture_handle(),
+            frames_.current_frame()->adapter_luid(), frame->size(),
+            frame->updated_region());
+      }
       callback_->OnCaptureResult(Result::SUCCESS, std::move(frame));
       break;
     }
@@ -23,6 +23,7 @@
 #include "modules/desktop_capture/screen_capture_frame_queue.h"
 #include "modules/desktop_capture/win/dxgi_duplicator_controller.h"
 #include "modules/desktop_capture/win/dxgi_frame.h"
+#include "modules/desktop_capture/win/dxgi_texture_callback.h"
 
 namespace webrtc {
 
@@ -70,6 +71,12 @@ class ScreenCapturerWinDirectx : public DesktopCapturer {
 
   explicit ScreenCapturerWinDirectx();
 
+  // Creates a capturer which delivers single monitor captures as shared
+  // textures to |texture_callback| when possible. |texture_callback| must
+  // outlive this instance. If it is nullptr, this constructor is the same as
+  // the default one.
+  explicit ScreenCapturerWinDirectx(DxgiTextureCallback* texture_callback);
+
   ~ScreenCapturerWinDirectx() override;
 
   // DesktopCapturer implementation.
@@ -85,6 +92,7 @@ class ScreenCapturerWinDirectx : public DesktopCapturer {
   ScreenCaptureFrameQueue<DxgiFrame> frames_;
   std::unique_ptr<SharedMemoryFactory> shared_memory_factory_;
   Callback* callback_ = nullptr;
+  DxgiTextureCallback* const texture_callback_;
   SourceId current_screen_id_ = kFullDesktopScreenId;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(ScreenCapturerWinDirectx);
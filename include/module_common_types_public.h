@@ -11,6 +11,9 @@
 #ifndef MODULES_INCLUDE_MODULE_COMMON_TYPES_PUBLIC_H_
 #define MODULES_INCLUDE_MODULE_COMMON_TYPES_PUBLIC_H_
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <limits>
 
 #include "absl/types/optional.h"
@@ -107,5 +110,42 @@ inline uint32_t LatestTimestamp(uint32_t timestamp1, uint32_t timestamp2) {
   return IsNewerTimestamp(timestamp1, timestamp2) ? timestamp1 : timestamp2;
 }
 
+// Memory held by a buffer of media packets or frames. Buffers keep one of
+// these up to date as items come and go, so reading it is cheap. The usage of
+// several buffers, e.g. of all streams, can be summed up with +=, in which case
+// |max_bytes| is an upper bound of the high-water mark of the sum.
+struct BufferMemoryUsage {
+  // Accounts for an item of |size| bytes added to the buffer.
+  void Add(size_t size) {
+    bytes += size;
+    ++num_items;
+    max_bytes = std::max(max_bytes, bytes);
+  }
+  // Accounts for an item of |size| bytes removed from the buffer.
+  void Remove(size_t size) {
+    bytes -= size;
+    --num_items;
+  }
+  // Accounts for all items being removed. Keeps the high-water mark.
+  void Clear() {
+    bytes = 0;
+    num_items = 0;
+  }
+
+  BufferMemoryUsage& operator+=(const BufferMemoryUsage& other) {
+    bytes += other.bytes;
+    max_bytes += other.max_bytes;
+    num_items += other.num_items;
+    return *this;
+  }
+
+  // Bytes of media currently held.
+  size_t bytes = 0;
+  // The largest |bytes| held so far.
+  size_t max_bytes = 0;
+  // Packets or frames currently held.
+  size_t num_items = 0;
+};
+
 }  // namespace webrtc
 #endif  // MODULES_INCLUDE_MODULE_COMMON_TYPES_PUBLIC_H_
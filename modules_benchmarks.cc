@@ -0,0 +1,788 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the per item cost of the hot paths of the modules, from RTP
+// parsing to audio mixing, on synthetic inputs generated from fixed seeds. The
+// results are written as JSON or CSV, and can be compared with the JSON output
+// of an earlier run to guard against performance regressions.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/rtp_headers.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/encoded_frame.h"
+#include "api/video/encoded_image.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "modules/audio_coding/neteq/include/neteq.h"
+#include "modules/audio_mixer/frame_combiner.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/video_coding/frame_buffer2.h"
+#include "modules/video_coding/frame_object.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "modules/video_coding/timing.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/json.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+
+#if defined(WEBRTC_MODULES_BENCHMARKS_DESKTOP_CAPTURE)
+#include "modules/desktop_capture/differ_block.h"
+#endif
+
+ABSL_FLAG(std::string,
+          filter,
+          "",
+          "Comma-separated list of benchmark name prefixes to run, all if "
+          "empty.");
+ABSL_FLAG(int, repetitions, 5, "Number of measured runs per benchmark.");
+ABSL_FLAG(double,
+          scale,
+          1.0,
+          "Factor applied to the number of items of every benchmark.");
+ABSL_FLAG(bool, list, false, "List the benchmarks instead of running them.");
+ABSL_FLAG(std::string, format, "json", "Output format: json or csv.");
+ABSL_FLAG(std::string, output_file, "", "Output file, stdout if empty.");
+ABSL_FLAG(std::string,
+          baseline_file,
+          "",
+          "JSON output of an earlier run to compare the results with.");
+ABSL_FLAG(double,
+          max_regression_percent,
+          10.0,
+          "Largest accepted increase of the median time per item over the "
+          "baseline, in percent.");
+
+namespace webrtc {
+namespace {
+
+const char kUsage[] =
+    "Usage: modules_benchmarks [--filter=<prefixes>] [--repetitions=<n>]\n"
+    "           [--scale=<factor>] [--list] [--format=json|csv]\n"
+    "           [--output_file=<path>] [--baseline_file=<path>]\n"
+    "           [--max_regression_percent=<percent>]\n"
+    "\n"
+    "Runs each benchmark a number of times on the same synthetic input and\n"
+    "reports the median, minimum and maximum time per item. With\n"
+    "--baseline_file, exits with an error if any median is more than\n"
+    "--max_regression_percent slower than in the baseline.\n";
+
+constexpr uint64_t kSeed = 0x1eaf5eed;
+constexpr uint32_t kSsrc = 0x12345678;
+
+// Keeps the compiler from removing computations whose result is unused.
+volatile int benchmark_sink = 0;
+
+// Runs |num_items| operations and returns the time they took in nanoseconds.
+// Setup is done, and the input generated, before the clock is started.
+using BenchmarkFunction = int64_t (*)(int num_items);
+
+struct Benchmark {
+  const char* name;
+  // What one item is.
+  const char* item;
+  int num_items;
+  BenchmarkFunction function;
+};
+
+// RTP.
+
+RtpHeaderExtensionMap CreateExtensionMap() {
+  RtpHeaderExtensionMap map;
+  map.Register<TransmissionOffset>(1);
+  map.Register<AbsoluteSendTime>(2);
+  map.Register<TransportSequenceNumber>(3);
+  map.Register<VideoOrientation>(4);
+  map.Register<PlayoutDelayLimits>(5);
+  map.Register<VideoContentTypeExtension>(6);
+  map.Register<VideoTimingExtension>(7);
+  return map;
+}
+
+// Writes a video packet with the extensions of a typical video stream and a
+// 1000 byte |payload|.
+void WriteRtpPacket(uint16_t seq_num,
+                    const uint8_t* payload,
+                    RtpPacketToSend* packet) {
+  constexpr size_t kPayloadSize = 1000;
+  packet->SetPayloadType(96);
+  packet->SetSequenceNumber(seq_num);
+  packet->SetTimestamp(seq_num * 3000u);
+  packet->SetSsrc(kSsrc);
+  packet->SetExtension<TransmissionOffset>(1234);
+  packet->SetExtension<AbsoluteSendTime>(0x123456);
+  packet->SetExtension<TransportSequenceNumber>(seq_num);
+  packet->SetExtension<VideoOrientation>(kVideoRotation_90);
+  packet->SetExtension<PlayoutDelayLimits>(PlayoutDelay{100, 200});
+  packet->SetExtension<VideoContentTypeExtension>(
+      VideoContentType::UNSPECIFIED);
+  packet->SetExtension<VideoTimingExtension>(VideoSendTiming{});
+  memcpy(packet->AllocatePayload(kPayloadSize), payload, kPayloadSize);
+}
+
+int64_t RtpParse(int num_items) {
+  const RtpHeaderExtensionMap map = CreateExtensionMap();
+  const std::vector<uint8_t> payload(1000, 0x5a);
+  RtpPacketToSend sent_packet(&map);
+  WriteRtpPacket(1, payload.data(), &sent_packet);
+
+  RtpPacketReceived packet(&map);
+  uint16_t transport_seq_num = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    RTC_CHECK(packet.Parse(sent_packet.data(), sent_packet.size()));
+    packet.GetExtension<TransportSequenceNumber>(&transport_seq_num);
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  RTC_CHECK_EQ(1, transport_seq_num);
+  return elapsed_ns;
+}
+
+int64_t RtpSerialize(int num_items) {
+  const RtpHeaderExtensionMap map = CreateExtensionMap();
+  const std::vector<uint8_t> payload(1000, 0x5a);
+  size_t total_size = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    RtpPacketToSend packet(&map);
+    WriteRtpPacket(static_cast<uint16_t>(i), payload.data(), &packet);
+    total_size += packet.size();
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = static_cast<int>(total_size);
+  return elapsed_ns;
+}
+
+// FEC.
+
+constexpr int kNumFecMediaPackets = 10;
+// About 30% overhead.
+constexpr uint8_t kFecProtectionFactor = 80;
+
+int64_t UlpfecEncode(int num_items) {
+  Random random(kSeed);
+  test::fec::MediaPacketGenerator generator(500, 1200, kSsrc, &random);
+  const ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(kNumFecMediaPackets, 0);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    fec_packets.clear();
+    RTC_CHECK_EQ(0, fec->EncodeFec(media_packets, kFecProtectionFactor, 0,
+                                   false, kFecMaskBursty, &fec_packets));
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = static_cast<int>(fec_packets.size());
+  return elapsed_ns;
+}
+
+// Each item is a frame whose first media packet is lost and recovered.
+int64_t UlpfecDecode(int num_items) {
+  Random random(kSeed);
+  test::fec::MediaPacketGenerator generator(500, 1200, kSsrc, &random);
+  const ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(kNumFecMediaPackets, 0);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kSsrc);
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  RTC_CHECK_EQ(0, fec->EncodeFec(media_packets, kFecProtectionFactor, 0, false,
+                                 kFecMaskBursty, &fec_packets));
+
+  std::vector<std::unique_ptr<ForwardErrorCorrection::ReceivedPacket>>
+      received_packets;
+  auto add_received_packet = [&received_packets](
+                                 const ForwardErrorCorrection::Packet& packet,
+                                 uint16_t seq_num, bool is_fec) {
+    auto received_packet =
+        std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
+    received_packet->pkt = new ForwardErrorCorrection::Packet();
+    received_packet->pkt->data = packet.data;
+    received_packet->ssrc = kSsrc;
+    received_packet->seq_num = seq_num;
+    received_packet->is_fec = is_fec;
+    received_packets.push_back(std::move(received_packet));
+  };
+  uint16_t seq_num = 0;
+  for (const auto& media_packet : media_packets) {
+    if (seq_num != 0)
+      add_received_packet(*media_packet, seq_num, false);
+    ++seq_num;
+  }
+  for (const ForwardErrorCorrection::Packet* fec_packet : fec_packets)
+    add_received_packet(*fec_packet, seq_num++, true);
+
+  ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+  size_t num_recovered_packets = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    for (const auto& received_packet : received_packets)
+      fec->DecodeFec(*received_packet, &recovered_packets);
+    num_recovered_packets = recovered_packets.size();
+    fec->ResetState(&recovered_packets);
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  RTC_CHECK_EQ(kNumFecMediaPackets, num_recovered_packets);
+  return elapsed_ns;
+}
+
+// Pacer.
+
+// Each item is one packet pushed and popped, with 10 video streams and one
+// audio stream sharing the queue.
+int64_t PacerPushPop(int num_items) {
+  constexpr int kNumStreams = 11;
+  constexpr int kPacketsPerStreamPerRound = 4;
+  constexpr int kPacketsPerRound = kNumStreams * kPacketsPerStreamPerRound;
+  Timestamp now = Timestamp::ms(1000);
+  RoundRobinPacketQueue queue(now, nullptr);
+  uint64_t enqueue_order = 0;
+  uint16_t seq_num = 0;
+  int num_popped = 0;
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; i += kPacketsPerRound) {
+    for (int k = 0; k < kPacketsPerStreamPerRound; ++k) {
+      for (uint32_t ssrc = 1; ssrc <= kNumStreams; ++ssrc) {
+        const bool audio = ssrc == kNumStreams;
+        queue.Push(audio ? 1 : 3,
+                   audio ? RtpPacketToSend::Type::kAudio
+                         : RtpPacketToSend::Type::kVideo,
+                   ssrc, seq_num++, now.ms(), now,
+                   DataSize::bytes(audio ? 100 : 1200), false,
+                   enqueue_order++);
+      }
+    }
+    now += TimeDelta::ms(5);
+    queue.UpdateQueueTime(now);
+    while (!queue.Empty()) {
+      queue.BeginPop();
+      queue.FinalizePop();
+      ++num_popped;
+    }
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = num_popped;
+  return elapsed_ns;
+}
+
+// Video.
+
+class FrameCounter : public video_coding::OnAssembledFrameCallback {
+ public:
+  void OnAssembledFrame(
+      std::unique_ptr<video_coding::RtpFrameObject> frame) override {
+    ++num_frames;
+    last_seq_num = frame->last_seq_num();
+  }
+
+  int num_frames = 0;
+  uint16_t last_seq_num = 0;
+};
+
+// Each item is one packet of a 3 Mbps, 30 fps generic codec stream, with
+// packets from neighbouring positions swapped now and then.
+int64_t PacketBufferInsert(int num_items) {
+  constexpr int kPacketsPerFrame = 10;
+  constexpr size_t kPayloadSize = 1200;
+  Random random(kSeed);
+  std::vector<int> arrival_order(num_items);
+  for (int i = 0; i < num_items; ++i)
+    arrival_order[i] = i;
+  for (int i = 1; i < num_items; ++i) {
+    if (random.Rand(0, 9) == 0)
+      std::swap(arrival_order[i - 1], arrival_order[i]);
+  }
+  std::vector<VCMPacket> packets(num_items);
+  for (int i = 0; i < num_items; ++i) {
+    const int index = arrival_order[i];
+    VCMPacket& packet = packets[i];
+    packet.video_header.codec = kVideoCodecGeneric;
+    packet.video_header.frame_type = index < kPacketsPerFrame
+                                         ? VideoFrameType::kVideoFrameKey
+                                         : VideoFrameType::kVideoFrameDelta;
+    packet.video_header.is_first_packet_in_frame =
+        index % kPacketsPerFrame == 0;
+    packet.video_header.is_last_packet_in_frame =
+        index % kPacketsPerFrame == kPacketsPerFrame - 1;
+    packet.seqNum = static_cast<uint16_t>(index);
+    packet.timestamp = index / kPacketsPerFrame * 3000u;
+    packet.sizeBytes = kPayloadSize;
+    packet.dataPtr = new uint8_t[kPayloadSize]();
+  }
+
+  SimulatedClock clock(0);
+  FrameCounter frame_counter;
+  video_coding::PacketBuffer packet_buffer(&clock, 512, 2048, &frame_counter);
+  const int64_t start_ns = rtc::TimeNanos();
+  for (VCMPacket& packet : packets) {
+    const int num_frames = frame_counter.num_frames;
+    RTC_CHECK(packet_buffer.InsertPacket(&packet));
+    if (frame_counter.num_frames != num_frames)
+      packet_buffer.ClearTo(frame_counter.last_seq_num);
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = frame_counter.num_frames;
+  return elapsed_ns;
+}
+
+class BenchmarkFrame : public video_coding::EncodedFrame {
+ public:
+  int64_t ReceivedTime() const override { return 0; }
+  int64_t RenderTime() const override { return _renderTimeMs; }
+};
+
+// Each item is one frame, referencing the previous frame, inserted into a
+// frame buffer that holds the frames of up to 10 s of video.
+int64_t FrameBufferInsert(int num_items) {
+  constexpr int kFramesPerBuffer = 300;
+  constexpr size_t kFrameSize = 10000;
+  int64_t elapsed_ns = 0;
+  for (int first = 0; first < num_items; first += kFramesPerBuffer) {
+    const int num_frames = std::min(kFramesPerBuffer, num_items - first);
+    std::vector<std::unique_ptr<BenchmarkFrame>> frames;
+    for (int i = 0; i < num_frames; ++i) {
+      auto frame = std::make_unique<BenchmarkFrame>();
+      frame->id.picture_id = i;
+      frame->SetTimestamp(i * 3000u);
+      if (i > 0) {
+        frame->num_references = 1;
+        frame->references[0] = i - 1;
+      }
+      frame->SetEncodedData(EncodedImageBuffer::Create(kFrameSize));
+      frames.push_back(std::move(frame));
+    }
+    SimulatedClock clock(1000);
+    VCMTiming timing(&clock);
+    video_coding::FrameBuffer frame_buffer(&clock, &timing, nullptr);
+
+    const int64_t start_ns = rtc::TimeNanos();
+    for (auto& frame : frames)
+      RTC_CHECK_GE(frame_buffer.InsertFrame(std::move(frame)), 0);
+    elapsed_ns += rtc::TimeNanos() - start_ns;
+  }
+  return elapsed_ns;
+}
+
+// Audio.
+
+constexpr int kNumAudioFrames = 100;
+
+// Returns |kNumAudioFrames| 10 ms frames of noise at about -20 dBFS.
+std::vector<AudioFrame> CreateNoiseFrames(int sample_rate_hz,
+                                          size_t num_channels,
+                                          Random* random) {
+  std::vector<AudioFrame> frames(kNumAudioFrames);
+  for (AudioFrame& frame : frames) {
+    frame.sample_rate_hz_ = sample_rate_hz;
+    frame.samples_per_channel_ = sample_rate_hz / 100;
+    frame.num_channels_ = num_channels;
+    int16_t* data = frame.mutable_data();
+    for (size_t i = 0; i < frame.samples_per_channel_ * num_channels; ++i)
+      data[i] = static_cast<int16_t>(random->Gaussian(0.0, 3000.0));
+  }
+  return frames;
+}
+
+// Each item is one 10 ms frame of 48 kHz mono render and capture audio
+// processed with |config|.
+int64_t RunAudioProcessing(const AudioProcessing::Config& config,
+                           int num_items) {
+  Random random(kSeed);
+  const std::vector<AudioFrame> render_frames =
+      CreateNoiseFrames(48000, 1, &random);
+  const std::vector<AudioFrame> capture_frames =
+      CreateNoiseFrames(48000, 1, &random);
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  apm->ApplyConfig(config);
+
+  AudioFrame render_frame;
+  AudioFrame capture_frame;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    render_frame.CopyFrom(render_frames[i % kNumAudioFrames]);
+    capture_frame.CopyFrom(capture_frames[i % kNumAudioFrames]);
+    RTC_CHECK_EQ(AudioProcessing::kNoError,
+                 apm->ProcessReverseStream(&render_frame));
+    apm->set_stream_delay_ms(0);
+    RTC_CHECK_EQ(AudioProcessing::kNoError, apm->ProcessStream(&capture_frame));
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = capture_frame.data()[0];
+  return elapsed_ns;
+}
+
+AudioProcessing::Config NoSubmodulesConfig() {
+  AudioProcessing::Config config;
+  config.residual_echo_detector.enabled = false;
+  return config;
+}
+
+int64_t Aec3(int num_items) {
+  AudioProcessing::Config config = NoSubmodulesConfig();
+  config.echo_canceller.enabled = true;
+  return RunAudioProcessing(config, num_items);
+}
+
+int64_t NoiseSuppression(int num_items) {
+  AudioProcessing::Config config = NoSubmodulesConfig();
+  config.noise_suppression.enabled = true;
+  return RunAudioProcessing(config, num_items);
+}
+
+int64_t Agc2(int num_items) {
+  AudioProcessing::Config config = NoSubmodulesConfig();
+  config.gain_controller2.enabled = true;
+  config.gain_controller2.adaptive_digital.enabled = true;
+  return RunAudioProcessing(config, num_items);
+}
+
+// Each item is one 10 ms, 32 kHz L16 packet inserted and one 10 ms frame
+// decoded, with the jitter buffer at a steady level.
+int64_t NetEqGetAudio(int num_items) {
+  constexpr int kSampleRateHz = 32000;
+  constexpr int kPayloadType = 95;
+  constexpr size_t kSamplesPerPacket = kSampleRateHz / 100;
+  constexpr int kNumPrebufferedPackets = 5;
+  Random random(kSeed);
+  const std::vector<AudioFrame> frames =
+      CreateNoiseFrames(kSampleRateHz, 1, &random);
+  std::vector<std::vector<uint8_t>> payloads;
+  for (const AudioFrame& frame : frames) {
+    std::vector<uint8_t> payload(kSamplesPerPacket * sizeof(int16_t));
+    RTC_CHECK_EQ(payload.size(),
+                 WebRtcPcm16b_Encode(frame.data(), kSamplesPerPacket,
+                                     payload.data()));
+    payloads.push_back(std::move(payload));
+  }
+
+  SimulatedClock clock(0);
+  NetEq::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  std::unique_ptr<NetEq> neteq(
+      NetEq::Create(config, &clock, CreateBuiltinAudioDecoderFactory()));
+  RTC_CHECK(neteq->RegisterPayloadType(
+      kPayloadType, SdpAudioFormat("l16", kSampleRateHz, 1)));
+
+  RTPHeader header;
+  header.payloadType = kPayloadType;
+  header.ssrc = kSsrc;
+  auto insert_packet = [&](int index) {
+    header.sequenceNumber = static_cast<uint16_t>(index);
+    header.timestamp = static_cast<uint32_t>(index * kSamplesPerPacket);
+    RTC_CHECK_EQ(NetEq::kOK, neteq->InsertPacket(
+                                 header, payloads[index % kNumAudioFrames]));
+  };
+  for (int i = 0; i < kNumPrebufferedPackets; ++i)
+    insert_packet(i);
+
+  AudioFrame output;
+  bool muted = false;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    insert_packet(i + kNumPrebufferedPackets);
+    RTC_CHECK_EQ(NetEq::kOK, neteq->GetAudio(&output, &muted));
+    clock.AdvanceTimeMilliseconds(10);
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = output.data()[0];
+  return elapsed_ns;
+}
+
+// Each item is one 10 ms frame mixed from 10 48 kHz stereo streams, with the
+// limiter enabled.
+int64_t MixerCombine(int num_items) {
+  constexpr size_t kNumStreams = 10;
+  Random random(kSeed);
+  std::vector<AudioFrame> frames = CreateNoiseFrames(48000, 2, &random);
+  std::vector<AudioFrame*> mix_list;
+  for (size_t i = 0; i < kNumStreams; ++i)
+    mix_list.push_back(&frames[i]);
+  FrameCombiner combiner(true);
+
+  AudioFrame output;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i)
+    combiner.Combine(mix_list, 2, 48000, kNumStreams, &output);
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  benchmark_sink = output.data()[0];
+  return elapsed_ns;
+}
+
+#if defined(WEBRTC_MODULES_BENCHMARKS_DESKTOP_CAPTURE)
+// Each item is one 1920x1080 frame compared block by block with the previous
+// frame, which differs only in one block, so nearly all pixels are read.
+int64_t DesktopBlockDifference(int num_items) {
+  constexpr int kWidth = 1920;
+  constexpr int kHeight = 1080;
+  constexpr int kStride = kWidth * kBytesPerPixel;
+  Random random(kSeed);
+  std::vector<uint8_t> old_frame(kStride * kHeight);
+  for (uint8_t& byte : old_frame)
+    byte = static_cast<uint8_t>(random.Rand(0, 255));
+  std::vector<uint8_t> new_frame = old_frame;
+  new_frame[kStride * 500 + 1000 * kBytesPerPixel] ^= 0xff;
+
+  int num_changed_blocks = 0;
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_items; ++i) {
+    for (int y = 0; y < kHeight; y += kBlockSize) {
+      const int height = std::min(kBlockSize, kHeight - y);
+      for (int x = 0; x < kWidth; x += kBlockSize) {
+        const size_t offset = y * kStride + x * kBytesPerPixel;
+        if (BlockDifference(&old_frame[offset], &new_frame[offset], height,
+                            kStride)) {
+          ++num_changed_blocks;
+        }
+      }
+    }
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  RTC_CHECK_EQ(num_items, num_changed_blocks);
+  return elapsed_ns;
+}
+#endif
+
+const Benchmark kBenchmarks[] = {
+    {"rtp/parse", "packet", 200000, &RtpParse},
+    {"rtp/serialize", "packet", 200000, &RtpSerialize},
+    {"fec/ulpfec_encode", "frame", 20000, &UlpfecEncode},
+    {"fec/ulpfec_decode", "frame", 20000, &UlpfecDecode},
+    {"pacing/round_robin_push_pop", "packet", 200000, &PacerPushPop},
+    {"video/packet_buffer_insert", "packet", 100000, &PacketBufferInsert},
+    {"video/frame_buffer_insert", "frame", 30000, &FrameBufferInsert},
+    {"audio_processing/aec3", "10 ms frame", 2000, &Aec3},
+    {"audio_processing/ns", "10 ms frame", 2000, &NoiseSuppression},
+    {"audio_processing/agc2", "10 ms frame", 2000, &Agc2},
+    {"neteq/get_audio", "10 ms frame", 10000, &NetEqGetAudio},
+    {"audio_mixer/combine", "10 ms frame", 10000, &MixerCombine},
+#if defined(WEBRTC_MODULES_BENCHMARKS_DESKTOP_CAPTURE)
+    {"desktop_capture/block_difference", "frame", 200,
+     &DesktopBlockDifference},
+#endif
+};
+
+struct Result {
+  std::string name;
+  std::string item;
+  int num_items = 0;
+  int repetitions = 0;
+  double median_ns = 0.0;
+  double min_ns = 0.0;
+  double max_ns = 0.0;
+};
+
+bool IsSelected(const Benchmark& benchmark, const std::string& filter) {
+  if (filter.empty())
+    return true;
+  for (absl::string_view prefix : absl::StrSplit(filter, ',')) {
+    if (!prefix.empty() && absl::StartsWith(benchmark.name, prefix))
+      return true;
+  }
+  return false;
+}
+
+Result RunBenchmark(const Benchmark& benchmark, double scale, int repetitions) {
+  Result result;
+  result.name = benchmark.name;
+  result.item = benchmark.item;
+  result.num_items = std::max(1, static_cast<int>(benchmark.num_items * scale));
+  result.repetitions = repetitions;
+
+  // An unmeasured run brings the code and the allocator into a warm state.
+  benchmark.function(std::max(1, result.num_items / 10));
+  std::vector<double> ns_per_item;
+  for (int i = 0; i < repetitions; ++i) {
+    ns_per_item.push_back(
+        static_cast<double>(benchmark.function(result.num_items)) /
+        result.num_items);
+  }
+  std::sort(ns_per_item.begin(), ns_per_item.end());
+  result.median_ns = ns_per_item[ns_per_item.size() / 2];
+  result.min_ns = ns_per_item.front();
+  result.max_ns = ns_per_item.back();
+  return result;
+}
+
+// The fields follow the JSON output of Google Benchmark, so that its tools can
+// compare results.
+void WriteJson(const std::vector<Result>& results, FILE* file) {
+  fprintf(file, "{\n  \"benchmarks\": [");
+  for (size_t k = 0; k < results.size(); ++k) {
+    const Result& r = results[k];
+    fprintf(file,
+            "%s\n    {\"name\": \"%s\", \"item\": \"%s\", \"iterations\": %d, "
+            "\"repetitions\": %d, \"real_time\": %.1f, "
+            "\"min_real_time\": %.1f, \"max_real_time\": %.1f, "
+            "\"time_unit\": \"ns\", \"items_per_second\": %.0f}",
+            k == 0 ? "" : ",", r.name.c_str(), r.item.c_str(), r.num_items,
+            r.repetitions, r.median_ns, r.min_ns, r.max_ns,
+            r.median_ns > 0 ? 1e9 / r.median_ns : 0.0);
+  }
+  fprintf(file, "\n  ]\n}\n");
+}
+
+void WriteCsv(const std::vector<Result>& results, FILE* file) {
+  fprintf(file,
+          "name,item,iterations,repetitions,median_ns,min_ns,max_ns,"
+          "items_per_second\n");
+  for (const Result& r : results) {
+    fprintf(file, "%s,%s,%d,%d,%.1f,%.1f,%.1f,%.0f\n", r.name.c_str(),
+            r.item.c_str(), r.num_items, r.repetitions, r.median_ns, r.min_ns,
+            r.max_ns, r.median_ns > 0 ? 1e9 / r.median_ns : 0.0);
+  }
+}
+
+// Reads the median time per item of each benchmark in the JSON file |path|.
+bool ReadBaseline(const std::string& path,
+                  std::map<std::string, double>* baseline) {
+  FILE* file = fopen(path.c_str(), "r");
+  if (!file)
+    return false;
+  std::string contents;
+  char buffer[4096];
+  size_t size;
+  while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    contents.append(buffer, size);
+  fclose(file);
+
+  Json::Reader reader;
+  Json::Value root;
+  if (!reader.parse(contents, root) || !root.isObject() ||
+      !root["benchmarks"].isArray()) {
+    return false;
+  }
+  for (const Json::Value& benchmark : root["benchmarks"]) {
+    if (benchmark["name"].isString() && benchmark["real_time"].isNumeric()) {
+      (*baseline)[benchmark["name"].asString()] =
+          benchmark["real_time"].asDouble();
+    }
+  }
+  return true;
+}
+
+// Returns the number of results more than |max_regression_percent| slower
+// than in |baseline|, and prints them.
+int CountRegressions(const std::vector<Result>& results,
+                     const std::map<std::string, double>& baseline,
+                     double max_regression_percent) {
+  int num_regressions = 0;
+  for (const Result& r : results) {
+    auto it = baseline.find(r.name);
+    if (it == baseline.end() || it->second <= 0)
+      continue;
+    const double change_percent = 100.0 * (r.median_ns / it->second - 1.0);
+    if (change_percent > max_regression_percent) {
+      fprintf(stderr,
+              "Regression: %s takes %.1f ns per %s, %.1f%% more than the "
+              "baseline %.1f ns\n",
+              r.name.c_str(), r.median_ns, r.item.c_str(), change_percent,
+              it->second);
+      ++num_regressions;
+    }
+  }
+  return num_regressions;
+}
+
+}  // namespace
+
+int RunBenchmarks() {
+  const std::string format = absl::GetFlag(FLAGS_format);
+  const int repetitions = absl::GetFlag(FLAGS_repetitions);
+  const double scale = absl::GetFlag(FLAGS_scale);
+  if ((format != "json" && format != "csv") || repetitions <= 0 ||
+      scale <= 0) {
+    printf("%s", kUsage);
+    return 1;
+  }
+
+  const std::string filter = absl::GetFlag(FLAGS_filter);
+  if (absl::GetFlag(FLAGS_list)) {
+    for (const Benchmark& benchmark : kBenchmarks) {
+      if (IsSelected(benchmark, filter))
+        printf("%s (%d %ss)\n", benchmark.name, benchmark.num_items,
+               benchmark.item);
+    }
+    return 0;
+  }
+
+  std::map<std::string, double> baseline;
+  const std::string baseline_file = absl::GetFlag(FLAGS_baseline_file);
+  if (!baseline_file.empty() && !ReadBaseline(baseline_file, &baseline)) {
+    fprintf(stderr, "Cannot read baseline %s\n", baseline_file.c_str());
+    return 1;
+  }
+
+  std::vector<Result> results;
+  for (const Benchmark& benchmark : kBenchmarks) {
+    if (IsSelected(benchmark, filter))
+      results.push_back(RunBenchmark(benchmark, scale, repetitions));
+  }
+
+  const std::string output_file = absl::GetFlag(FLAGS_output_file);
+  FILE* file = output_file.empty() ? stdout : fopen(output_file.c_str(), "w");
+  if (!file) {
+    fprintf(stderr, "Cannot open %s\n", output_file.c_str());
+    return 1;
+  }
+  if (format == "json") {
+    WriteJson(results, file);
+  } else {
+    WriteCsv(results, file);
+  }
+  if (file != stdout) {
+    fclose(file);
+  }
+
+  if (!baseline_file.empty() &&
+      CountRegressions(results, baseline,
+                       absl::GetFlag(FLAGS_max_regression_percent)) > 0) {
+    return 2;
+  }
+  return 0;
+}
+
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 1) {
+    printf("%s", webrtc::kUsage);
+    return 1;
+  }
+  return webrtc::RunBenchmarks();
+}
@@ -55,7 +55,7 @@ BitrateProber::~BitrateProber() {
 
 BitrateProber::BitrateProber(const WebRtcKeyValueConfig& field_trials)
     : probing_state_(ProbingState::kDisabled),
-      next_probe_time_ms_(-1),
+      next_probe_time_us_(-1),
       total_probe_count_(0),
       total_failed_probe_count_(0),
       config_(&field_trials) {
@@ -85,7 +85,7 @@ void BitrateProber::OnIncomingPacket(size_t packet_size) {
       packet_size >=
           std::min<size_t>(RecommendedMinProbeSize(), kMinProbePacketSize)) {
     // Send next probe right away.
-    next_probe_time_ms_ = -1;
+    next_probe_time_us_ = -1;
     probing_state_ = ProbingState::kActive;
   }
 }
@@ -125,22 +125,32 @@ void BitrateProber::CreateProbeCluster(int bitrate_bps,
 }
 
 int BitrateProber::TimeUntilNextProbe(int64_t now_ms) {
+  const Timestamp next_probe_time = NextProbeTime(Timestamp::ms(now_ms));
+  if (next_probe_time.IsPlusInfinity())
+    return -1;
+
+  // Rounded up, so that a caller waking up after the returned time never finds
+  // the probe still in the future.
+  const int64_t time_until_probe_us = next_probe_time.us() - now_ms * 1000;
+  return static_cast<int>(std::max<int64_t>((time_until_probe_us + 999) / 1000,
+                                            0));
+}
+
+Timestamp BitrateProber::NextProbeTime(Timestamp now) const {
   // Probing is not active or probing is already complete.
   if (probing_state_ != ProbingState::kActive || clusters_.empty())
-    return -1;
+    return Timestamp::PlusInfinity();
 
-  int time_until_probe_ms = 0;
-  if (next_probe_time_ms_ >= 0) {
-    time_until_probe_ms = next_probe_time_ms_ - now_ms;
-    if (time_until_probe_ms < -config_.max_probe_delay->ms()) {
-      RTC_DLOG(LS_WARNING) << "Probe delay too high"
-                           << " (next_ms:" << next_probe_time_ms_
-                           << ", now_ms: " << now_ms << ")";
-      return -1;
-    }
-  }
+  if (next_probe_time_us_ < 0)
+    return now;
 
-  return std::max(time_until_probe_ms, 0);
+  if (now.us() - next_probe_time_us_ > config_.max_probe_delay->us()) {
+    RTC_DLOG(LS_WARNING) << "Probe delay too high"
+                         << " (next_us:" << next_probe_time_us_
+                         << ", now_us: " << now.us() << ")";
+    return Timestamp::PlusInfinity();
+  }
+  return Timestamp::us(next_probe_time_us_);
 }
 
 PacedPacketInfo BitrateProber::CurrentCluster() const {
@@ -160,19 +170,36 @@ size_t BitrateProber::RecommendedMinProbeSize() const {
          config_.min_probe_delta->ms() / (8 * 1000);
 }
 
+size_t BitrateProber::RecommendedProbeSize(Timestamp now) const {
+  const size_t min_probe_size = RecommendedMinProbeSize();
+  if (next_probe_time_us_ < 0 || now.us() <= next_probe_time_us_)
+    return min_probe_size;
+
+  // Never catch up with more than the largest allowed probe delay.
+  const int64_t late_us = std::min(now.us() - next_probe_time_us_,
+                                   config_.max_probe_delay->us());
+  const int64_t catch_up_bytes =
+      clusters_.front().pace_info.send_bitrate_bps * late_us / (8 * 1000000);
+  return min_probe_size + static_cast<size_t>(catch_up_bytes);
+}
+
 void BitrateProber::ProbeSent(int64_t now_ms, size_t bytes) {
+  ProbeSent(Timestamp::ms(now_ms), bytes);
+}
+
+void BitrateProber::ProbeSent(Timestamp now, size_t bytes) {
   RTC_DCHECK(probing_state_ == ProbingState::kActive);
   RTC_DCHECK_GT(bytes, 0);
 
   if (!clusters_.empty()) {
     ProbeCluster* cluster = &clusters_.front();
     if (cluster->sent_probes == 0) {
-      RTC_DCHECK_EQ(cluster->time_started_ms, -1);
-      cluster->time_started_ms = now_ms;
+      RTC_DCHECK_EQ(cluster->time_started_us, -1);
+      cluster->time_started_us = now.us();
     }
     cluster->sent_bytes += static_cast<int>(bytes);
     cluster->sent_probes += 1;
-    next_probe_time_ms_ = GetNextProbeTime(*cluster);
+    next_probe_time_us_ = GetNextProbeTime(*cluster);
     if (cluster->sent_bytes >= cluster->pace_info.probe_cluster_min_bytes &&
         cluster->sent_probes >= cluster->pace_info.probe_cluster_min_probes) {
       RTC_HISTOGRAM_COUNTS_100000("WebRTC.BWE.Probing.ProbeClusterSizeInBytes",
@@ -180,7 +207,7 @@ void BitrateProber::ProbeSent(int64_t now_ms, size_t bytes) {
       RTC_HISTOGRAM_COUNTS_100("WebRTC.BWE.Probing.ProbesPerCluster",
                                cluster->sent_probes);
       RTC_HISTOGRAM_COUNTS_10000("WebRTC.BWE.Probing.TimePerProbeCluster",
-                                 now_ms - cluster->time_started_ms);
+                                 (now.us() - cluster->time_started_us) / 1000);
 
       clusters_.pop();
     }
@@ -191,14 +218,15 @@ void BitrateProber::ProbeSent(int64_t now_ms, size_t bytes) {
 
 int64_t BitrateProber::GetNextProbeTime(const ProbeCluster& cluster) {
   RTC_CHECK_GT(cluster.pace_info.send_bitrate_bps, 0);
-  RTC_CHECK_GE(cluster.time_started_ms, 0);
+  RTC_CHECK_GE(cluster.time_started_us, 0);
 
   // Compute the time delta from the cluster start to ensure probe bitrate stays
-  // close to the target bitrate. Result is in milliseconds.
-  int64_t delta_ms =
-      (8000ll * cluster.sent_bytes + cluster.pace_info.send_bitrate_bps / 2) /
-      cluster.pace_info.send_bitrate_bps;
-  return cluster.time_started_ms + delta_ms;
+  // close to the target bitrate. Result is in microseconds, so that probes at
+  // high bitrates are spread out rather than sent in millisecond bursts.
+  int64_t delta_us = (8000000ll * cluster.sent_bytes +
+                      cluster.pace_info.send_bitrate_bps / 2) /
+                     cluster.pace_info.send_bitrate_bps;
+  return cluster.time_started_us + delta_us;
 }
 
 }  // namespace webrtc
@@ -18,6 +18,7 @@
 
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/network_types.h"
+#include "api/units/timestamp.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 
 namespace webrtc {
@@ -64,9 +65,14 @@ class BitrateProber {
   void CreateProbeCluster(int bitrate_bps, int64_t now_ms, int cluster_id);
 
   // Returns the number of milliseconds until the next probe should be sent to
-  // get accurate probing.
+  // get accurate probing, rounded up, or -1 if no probe should be sent.
   int TimeUntilNextProbe(int64_t now_ms);
 
+  // Returns the time, with microsecond precision, at which the next probe
+  // should be sent, which may be in the past if the probe is late. Returns
+  // plus infinity if no probe should be sent.
+  Timestamp NextProbeTime(Timestamp now) const;
+
   // Information about the current probing cluster.
   PacedPacketInfo CurrentCluster() const;
 
@@ -74,11 +80,18 @@ class BitrateProber {
   // the next probe.
   size_t RecommendedMinProbeSize() const;
 
+  // Returns the number of bytes that should be sent, as one batch, for the
+  // probe due at |now|. This is RecommendedMinProbeSize() plus, if the probe
+  // is late, the bytes needed to catch up with the probe bitrate, so that a
+  // late wakeup doesn't have to be followed by several more.
+  size_t RecommendedProbeSize(Timestamp now) const;
+
   // Called to report to the prober that a probe has been sent. In case of
   // multiple packets per probe, this call would be made at the end of sending
   // the last packet in probe. |probe_size| is the total size of all packets
   // in probe.
   void ProbeSent(int64_t now_ms, size_t probe_size);
+  void ProbeSent(Timestamp now, size_t probe_size);
 
  private:
   enum class ProbingState {
@@ -102,10 +115,12 @@ class BitrateProber {
     int sent_probes = 0;
     int sent_bytes = 0;
     int64_t time_created_ms = -1;
-    int64_t time_started_ms = -1;
+    int64_t time_started_us = -1;
     int retries = 0;
   };
 
+  // Returns the time, in microseconds, at which the next probe of |cluster|
+  // should be sent.
   int64_t GetNextProbeTime(const ProbeCluster& cluster);
 
   ProbingState probing_state_;
@@ -115,8 +130,8 @@ class BitrateProber {
   // sent.
   std::queue<ProbeCluster> clusters_;
 
-  // Time the next probe should be sent when in kActive state.
-  int64_t next_probe_time_ms_;
+  // Time, in microseconds, the next probe should be sent when in kActive state.
+  int64_t next_probe_time_us_;
 
   int total_probe_count_;
   int total_failed_probe_count_;
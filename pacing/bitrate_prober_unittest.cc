@@ -204,4 +204,52 @@ TEST(BitrateProberTest, ProbeClusterTimeout) {
 
   EXPECT_FALSE(prober.IsProbing());
 }
+
+TEST(BitrateProberTest, SchedulesProbesWithMicrosecondPrecision) {
+  const FieldTrialBasedConfig config;
+  BitrateProber prober(config);
+  constexpr int kBitrateBps = 20000000;  // 20 Mbps.
+  constexpr int kPacketSizeBytes = 1000;
+
+  prober.CreateProbeCluster(kBitrateBps, 0, /*cluster_id=*/0);
+  prober.OnIncomingPacket(kPacketSizeBytes);
+  const Timestamp start = Timestamp::ms(100);
+  EXPECT_EQ(start, prober.NextProbeTime(start));
+
+  // Each packet takes 400 us at 20 Mbps.
+  prober.ProbeSent(start, kPacketSizeBytes);
+  EXPECT_EQ(start + TimeDelta::us(400), prober.NextProbeTime(start));
+  prober.ProbeSent(start + TimeDelta::us(400), kPacketSizeBytes);
+  EXPECT_EQ(start + TimeDelta::us(800), prober.NextProbeTime(start));
+  // The millisecond version rounds up.
+  EXPECT_EQ(1, prober.TimeUntilNextProbe(start.ms()));
+}
+
+TEST(BitrateProberTest, RecommendedProbeSizeCatchesUpWhenLate) {
+  const FieldTrialBasedConfig config;
+  BitrateProber prober(config);
+  constexpr int kBitrateBps = 20000000;  // 20 Mbps.
+  constexpr size_t kMinProbeSize = kBitrateBps * 2 / 8000;
+
+  prober.CreateProbeCluster(kBitrateBps, 0, /*cluster_id=*/0);
+  prober.OnIncomingPacket(1000);
+  const Timestamp start = Timestamp::ms(100);
+  EXPECT_EQ(kMinProbeSize, prober.RecommendedMinProbeSize());
+  EXPECT_EQ(kMinProbeSize, prober.RecommendedProbeSize(start));
+
+  prober.ProbeSent(start, kMinProbeSize);
+  const Timestamp next_probe_time = start + TimeDelta::ms(2);
+  EXPECT_EQ(next_probe_time, prober.NextProbeTime(start));
+  EXPECT_EQ(kMinProbeSize, prober.RecommendedProbeSize(next_probe_time));
+
+  // One millisecond late, the bytes of that millisecond are added.
+  EXPECT_EQ(kMinProbeSize + kBitrateBps / 8000,
+            prober.RecommendedProbeSize(next_probe_time + TimeDelta::ms(1)));
+
+  // Catching up is limited to the max probe delay, 3 ms by default.
+  const Timestamp too_late = next_probe_time + TimeDelta::ms(10);
+  EXPECT_TRUE(prober.NextProbeTime(too_late).IsPlusInfinity());
+  EXPECT_EQ(kMinProbeSize + 3 * kBitrateBps / 8000,
+            prober.RecommendedProbeSize(too_late));
+}
 }  // namespace webrtc
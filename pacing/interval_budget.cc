@@ -55,6 +55,10 @@ size_t IntervalBudget::bytes_remaining() const {
   return rtc::saturated_cast<size_t>(std::max<int64_t>(0, bytes_remaining_));
 }
 
+size_t IntervalBudget::bytes_in_debt() const {
+  return rtc::saturated_cast<size_t>(std::max<int64_t>(0, -bytes_remaining_));
+}
+
 double IntervalBudget::budget_ratio() const {
   if (max_bytes_in_budget_ == 0)
     return 0.0;
@@ -29,6 +29,9 @@ class IntervalBudget {
   void UseBudget(size_t bytes);
 
   size_t bytes_remaining() const;
+  // Number of bytes the budget has been overused by, i.e. that have to be
+  // earned back before bytes_remaining() becomes non-zero again.
+  size_t bytes_in_debt() const;
   double budget_ratio() const;
   int target_rate_kbps() const;
 
@@ -77,6 +77,14 @@ TEST(IntervalBudgetTest, Overuse) {
   EXPECT_DOUBLE_EQ(interval_budget.budget_ratio(),
                    -kWindowMs / static_cast<double>(100 * overuse_time_ms));
   EXPECT_EQ(interval_budget.bytes_remaining(), 0u);
+  EXPECT_EQ(interval_budget.bytes_in_debt(), static_cast<size_t>(used_bytes));
+
+  interval_budget.IncreaseBudget(overuse_time_ms / 2);
+  EXPECT_EQ(interval_budget.bytes_in_debt(),
+            static_cast<size_t>(
+                used_bytes - TimeToBytes(kBitrateKbps, overuse_time_ms / 2)));
+  interval_budget.IncreaseBudget(overuse_time_ms);
+  EXPECT_EQ(interval_budget.bytes_in_debt(), 0u);
 }
 
 TEST(IntervalBudgetTest, DontOveruseMoreThanMaxWindow) {
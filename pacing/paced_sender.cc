@@ -11,6 +11,7 @@
 #include "modules/pacing/paced_sender.h"
 
 #include <algorithm>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -24,6 +25,17 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+constexpr char kLockFreeIngressFieldTrial[] = "WebRTC-Pacer-LockFreeIngress";
+
+bool IsLockFreeIngressEnabled(const WebRtcKeyValueConfig* field_trials) {
+  const std::string value =
+      field_trials ? field_trials->Lookup(kLockFreeIngressFieldTrial)
+                   : FieldTrialBasedConfig().Lookup(kLockFreeIngressFieldTrial);
+  return value.find("Enabled") == 0;
+}
+}  // namespace
+
 const int64_t PacedSender::kMaxQueueLengthMs = 2000;
 const float PacedSender::kDefaultPaceMultiplier = 2.5f;
 
@@ -32,7 +44,8 @@ PacedSender::PacedSender(Clock* clock,
                          RtcEventLog* event_log,
                          const WebRtcKeyValueConfig* field_trials,
                          ProcessThread* process_thread)
-    : pacing_controller_(clock,
+    : lock_free_ingress_(IsLockFreeIngressEnabled(field_trials)),
+      pacing_controller_(clock,
                          static_cast<PacingController::PacketSender*>(this),
                          event_log,
                          field_trials),
@@ -93,6 +106,10 @@ void PacedSender::SetPacingRates(DataRate pacing_rate, DataRate padding_rate) {
 
 void PacedSender::EnqueuePackets(
     std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+  if (lock_free_ingress_) {
+    ingress_queue_.Push(std::move(packets));
+    return;
+  }
   rtc::CritScope cs(&critsect_);
   for (auto& packet : packets) {
     pacing_controller_.EnqueuePacket(std::move(packet));
@@ -114,6 +131,16 @@ DataSize PacedSender::QueueSizeData() const {
   return pacing_controller_.QueueSizeData();
 }
 
+BufferMemoryUsage PacedSender::QueueMemoryUsage() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.QueueMemoryUsage();
+}
+
+BufferMemoryUsage PacedSender::QueueMemoryUsage(uint32_t ssrc) const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.QueueMemoryUsage(ssrc);
+}
+
 absl::optional<Timestamp> PacedSender::FirstSentPacketTime() const {
   rtc::CritScope cs(&critsect_);
   return pacing_controller_.FirstSentPacketTime();
@@ -147,6 +174,7 @@ int64_t PacedSender::TimeUntilNextProcess() {
 
 void PacedSender::Process() {
   rtc::CritScope cs(&critsect_);
+  DrainIngressQueue();
   pacing_controller_.ProcessPackets();
 }
 
@@ -167,6 +195,22 @@ void PacedSender::SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   critsect_.Enter();
 }
 
+void PacedSender::SendRtpPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  critsect_.Leave();
+  packet_router_->SendPackets(std::move(packets), cluster_info);
+  critsect_.Enter();
+}
+
+void PacedSender::DrainIngressQueue() {
+  PacingController& pacing_controller = pacing_controller_;
+  ingress_queue_.Drain(
+      [&pacing_controller](std::unique_ptr<RtpPacketToSend> packet) {
+        pacing_controller.EnqueuePacket(std::move(packet));
+      });
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> PacedSender::GeneratePadding(
     DataSize size) {
   std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
@@ -27,6 +27,7 @@
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
 #include "modules/pacing/pacing_controller.h"
+#include "modules/pacing/packet_ingress_queue.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
@@ -71,7 +72,10 @@ class PacedSender : public Module,
   // Methods implementing RtpPacketSender.
 
   // Adds the packet to the queue and calls PacketRouter::SendPacket() when
-  // it's time to send.
+  // it's time to send. With the WebRTC-Pacer-LockFreeIngress field trial, the
+  // packets are instead handed over without taking the pacer lock, and only
+  // added to the queue at the start of the next Process() call. Until then
+  // they are not included in queue size and queue time estimates.
   void EnqueuePackets(
       std::vector<std::unique_ptr<RtpPacketToSend>> packet) override;
 
@@ -102,6 +106,10 @@ class PacedSender : public Module,
 
   DataSize QueueSizeData() const override;
 
+  // Returns the bytes and packets queued, in total or for the stream |ssrc|.
+  BufferMemoryUsage QueueMemoryUsage() const;
+  BufferMemoryUsage QueueMemoryUsage(uint32_t ssrc) const;
+
   // Returns the time when the first packet was sent;
   absl::optional<Timestamp> FirstSentPacketTime() const override;
 
@@ -141,9 +149,16 @@ class PacedSender : public Module,
                      const PacedPacketInfo& cluster_info) override
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
+  void SendRtpPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                      const PacedPacketInfo& cluster_info) override
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
+  // Moves packets from |ingress_queue_| into |pacing_controller_|.
+  void DrainIngressQueue() RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
   // Private implementation of Module to not expose those implementation details
   // publicly and control when the class is registered/deregistered.
   class ModuleProxy : public Module {
@@ -162,6 +177,11 @@ class PacedSender : public Module,
     PacedSender* const delegate_;
   } module_proxy_{this};
 
+  const bool lock_free_ingress_;
+  // Packets enqueued but not yet drained into |pacing_controller_|, if
+  // |lock_free_ingress_| is set.
+  PacketIngressQueue ingress_queue_;
+
   rtc::CriticalSection critsect_;
   PacingController pacing_controller_ RTC_GUARDED_BY(critsect_);
 
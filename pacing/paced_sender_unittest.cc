@@ -115,5 +115,44 @@ TEST(PacedSenderTest, PacesPackets) {
   EXPECT_GT(duration, TimeDelta::ms(900));
 }
 
+TEST(PacedSenderTest, LockFreeIngressQueuesPacketsOnProcess) {
+  ScopedFieldTrials trial("WebRTC-Pacer-LockFreeIngress/Enabled/");
+  SimulatedClock clock(0);
+  MockCallback callback;
+  MockProcessThread process_thread;
+  Module* paced_module = nullptr;
+  EXPECT_CALL(process_thread, RegisterModule(_, _))
+      .WillOnce(SaveArg<0>(&paced_module));
+  PacedSender pacer(&clock, &callback, nullptr, nullptr, &process_thread);
+  EXPECT_CALL(process_thread, DeRegisterModule(paced_module)).Times(1);
+
+  static constexpr size_t kPacketsToSend = 10;
+  pacer.SetPacingRates(DataRate::bps(kDefaultPacketSize * 8 * kPacketsToSend),
+                       DataRate::Zero());
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (size_t i = 0; i < kPacketsToSend; ++i) {
+    packets.emplace_back(BuildRtpPacket(RtpPacketToSend::Type::kVideo));
+  }
+  pacer.EnqueuePackets(std::move(packets));
+
+  // Packets are only handed to the pacing controller by the process thread.
+  EXPECT_EQ(pacer.QueueSizeData(), DataSize::Zero());
+
+  size_t packets_sent = 0;
+  EXPECT_CALL(callback, SendPacket)
+      .WillRepeatedly(
+          [&](std::unique_ptr<RtpPacketToSend> packet,
+              const PacedPacketInfo& cluster_info) { ++packets_sent; });
+  clock.AdvanceTimeMilliseconds(paced_module->TimeUntilNextProcess());
+  paced_module->Process();
+  EXPECT_GT(packets_sent, 0u);
+
+  while (packets_sent < kPacketsToSend) {
+    clock.AdvanceTimeMilliseconds(paced_module->TimeUntilNextProcess());
+    paced_module->Process();
+  }
+  EXPECT_EQ(pacer.QueueSizeData(), DataSize::Zero());
+}
+
 }  // namespace test
 }  // namespace webrtc
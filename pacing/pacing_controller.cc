@@ -79,7 +79,8 @@ const TimeDelta PacingController::kPausedProcessInterval =
 PacingController::PacingController(Clock* clock,
                                    PacketSender* packet_sender,
                                    RtcEventLog* event_log,
-                                   const WebRtcKeyValueConfig* field_trials)
+                                   const WebRtcKeyValueConfig* field_trials,
+                                   ProcessMode mode)
     : clock_(clock),
       packet_sender_(packet_sender),
       fallback_field_trials_(
@@ -92,11 +93,15 @@ PacingController::PacingController(Clock* clock,
       pace_audio_(!IsDisabled(*field_trials_, "WebRTC-Pacer-BlockAudio")),
       small_first_probe_packet_(
           IsEnabled(*field_trials_, "WebRTC-Pacer-SmallFirstProbePacket")),
+      send_packet_batches_(
+          IsEnabled(*field_trials_, "WebRTC-Pacer-SendPacketBatches")),
+      mode_(mode),
       min_packet_limit_(kDefaultMinPacketLimit),
       last_timestamp_(clock_->CurrentTime()),
       paused_(false),
       media_budget_(0),
       padding_budget_(0),
+      budget_time_remainder_(TimeDelta::Zero()),
       prober_(*field_trials_),
       probing_send_failure_(false),
       padding_failure_state_(false),
@@ -217,6 +222,14 @@ DataSize PacingController::QueueSizeData() const {
   return packet_queue_.Size();
 }
 
+BufferMemoryUsage PacingController::QueueMemoryUsage() const {
+  return packet_queue_.GetMemoryUsage();
+}
+
+BufferMemoryUsage PacingController::QueueMemoryUsage(uint32_t ssrc) const {
+  return packet_queue_.GetMemoryUsage(ssrc);
+}
+
 absl::optional<Timestamp> PacingController::FirstSentPacketTime() const {
   return first_sent_packet_time_;
 }
@@ -279,8 +292,13 @@ absl::optional<TimeDelta> PacingController::TimeUntilNextProbe() {
     return absl::nullopt;
   }
 
-  TimeDelta time_delta =
-      TimeDelta::ms(prober_.TimeUntilNextProbe(CurrentTime().ms()));
+  const Timestamp now = CurrentTime();
+  const Timestamp next_probe_time = prober_.NextProbeTime(now);
+  if (next_probe_time.IsPlusInfinity()) {
+    return absl::nullopt;
+  }
+
+  TimeDelta time_delta = std::max(next_probe_time - now, TimeDelta::Zero());
   if (time_delta > TimeDelta::Zero() ||
       (time_delta == TimeDelta::Zero() && !probing_send_failure_)) {
     return time_delta;
@@ -293,6 +311,24 @@ TimeDelta PacingController::TimeElapsedSinceLastProcess() const {
   return CurrentTime() - time_last_process_;
 }
 
+TimeDelta PacingController::TimeUntilAvailableBudget() const {
+  if (media_budget_.bytes_remaining() > 0) {
+    return TimeDelta::Zero();
+  }
+  const int64_t target_rate_kbps = media_budget_.target_rate_kbps();
+  if (target_rate_kbps <= 0) {
+    return TimeDelta::PlusInfinity();
+  }
+  // The budget is only increased in whole milliseconds, of the time elapsed
+  // since the last process call plus the carried over remainder, and must
+  // end up strictly positive.
+  const int64_t bytes_in_debt = media_budget_.bytes_in_debt();
+  const int64_t budget_ms = bytes_in_debt * 8 / target_rate_kbps + 1;
+  return std::max(TimeDelta::ms(budget_ms) - budget_time_remainder_ -
+                      TimeElapsedSinceLastProcess(),
+                  TimeDelta::Zero());
+}
+
 void PacingController::ProcessPackets() {
   Timestamp now = CurrentTime();
   TimeDelta elapsed_time = UpdateTimeAndGetElapsed(now);
@@ -343,7 +379,9 @@ void PacingController::ProcessPackets() {
   if (is_probing) {
     pacing_info = prober_.CurrentCluster();
     first_packet_in_probe = pacing_info.probe_cluster_bytes_sent == 0;
-    recommended_probe_size = DataSize::bytes(prober_.RecommendedMinProbeSize());
+    // A late wakeup sends the bytes needed to catch up with the probe bitrate
+    // in this batch, rather than waking up again right away.
+    recommended_probe_size = DataSize::bytes(prober_.RecommendedProbeSize(now));
   }
 
   DataSize data_sent = DataSize::Zero();
@@ -353,6 +391,7 @@ void PacingController::ProcessPackets() {
     if (small_first_probe_packet_ && first_packet_in_probe) {
       // If first packet in probe, insert a small padding packet so we have a
       // more reliable start window for the rate estimation.
+      SendPacketBatch(pacing_info);
       auto padding = packet_sender_->GeneratePadding(DataSize::bytes(1));
       // If no RTP modules sending media are registered, we may not get a
       // padding packet back.
@@ -371,6 +410,9 @@ void PacingController::ProcessPackets() {
       // No packet available to send, check if we should send padding.
       DataSize padding_to_add = PaddingToAdd(recommended_probe_size, data_sent);
       if (padding_to_add > DataSize::Zero()) {
+        // Padding may be generated from the packet history, send pending
+        // packets first so that they are eligible.
+        SendPacketBatch(pacing_info);
         std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets =
             packet_sender_->GeneratePadding(padding_to_add);
         if (padding_packets.empty()) {
@@ -390,7 +432,11 @@ void PacingController::ProcessPackets() {
 
     std::unique_ptr<RtpPacketToSend> rtp_packet = packet->ReleasePacket();
     RTC_DCHECK(rtp_packet);
-    packet_sender_->SendRtpPacket(std::move(rtp_packet), pacing_info);
+    if (send_packet_batches_) {
+      packet_batch_.push_back(std::move(rtp_packet));
+    } else {
+      packet_sender_->SendRtpPacket(std::move(rtp_packet), pacing_info);
+    }
 
     data_sent += packet->size();
     // Send succeeded, remove it from the queue.
@@ -399,10 +445,12 @@ void PacingController::ProcessPackets() {
       break;
   }
 
+  SendPacketBatch(pacing_info);
+
   if (is_probing) {
     probing_send_failure_ = data_sent == DataSize::Zero();
     if (!probing_send_failure_) {
-      prober_.ProbeSent(CurrentTime().ms(), data_sent.bytes());
+      prober_.ProbeSent(CurrentTime(), data_sent.bytes());
     }
   }
 }
@@ -474,6 +522,15 @@ void PacingController::OnPacketSent(
   padding_failure_state_ = false;
 }
 
+void PacingController::SendPacketBatch(const PacedPacketInfo& pacing_info) {
+  if (packet_batch_.empty()) {
+    return;
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.swap(packet_batch_);
+  packet_sender_->SendRtpPackets(std::move(packets), pacing_info);
+}
+
 void PacingController::OnPaddingSent(DataSize data_sent) {
   if (data_sent > DataSize::Zero()) {
     UpdateBudgetWithSentData(data_sent);
@@ -485,6 +542,16 @@ void PacingController::OnPaddingSent(DataSize data_sent) {
 
 void PacingController::UpdateBudgetWithElapsedTime(TimeDelta delta) {
   delta = std::min(kMaxProcessingInterval, delta);
+  if (mode_ == ProcessMode::kDynamic) {
+    // Process calls may be less than a millisecond apart, carry over what the
+    // budgets can't account for rather than dropping it.
+    delta += budget_time_remainder_;
+    const int64_t delta_ms = delta.us() / 1000;
+    budget_time_remainder_ = delta - TimeDelta::ms(delta_ms);
+    media_budget_.IncreaseBudget(delta_ms);
+    padding_budget_.IncreaseBudget(delta_ms);
+    return;
+  }
   media_budget_.IncreaseBudget(delta.ms());
   padding_budget_.IncreaseBudget(delta.ms());
 }
@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -49,6 +50,15 @@ class PacingController {
     virtual ~PacketSender() = default;
     virtual void SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
                                const PacedPacketInfo& cluster_info) = 0;
+    // Sends the packets released during one process call, if batch sending is
+    // enabled. The default implementation sends them one at a time.
+    virtual void SendRtpPackets(
+        std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+        const PacedPacketInfo& cluster_info) {
+      for (auto& packet : packets) {
+        SendRtpPacket(std::move(packet), cluster_info);
+      }
+    }
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
         DataSize size) = 0;
   };
@@ -69,10 +79,20 @@ class PacingController {
   // to lack of feedback.
   static const TimeDelta kPausedProcessInterval;
 
+  enum class ProcessMode {
+    // ProcessPackets() is called at a fixed interval, typically 5ms.
+    kPeriodic,
+    // ProcessPackets() is called whenever TimeUntilAvailableBudget() or
+    // TimeUntilNextProbe() expires, which may be less than a millisecond
+    // apart.
+    kDynamic
+  };
+
   PacingController(Clock* clock,
                    PacketSender* packet_sender,
                    RtcEventLog* event_log,
-                   const WebRtcKeyValueConfig* field_trials);
+                   const WebRtcKeyValueConfig* field_trials,
+                   ProcessMode mode = ProcessMode::kPeriodic);
 
   ~PacingController();
 
@@ -103,6 +123,9 @@ class PacingController {
 
   size_t QueueSizePackets() const;
   DataSize QueueSizeData() const;
+  // Returns the bytes and packets queued, in total or for the stream |ssrc|.
+  BufferMemoryUsage QueueMemoryUsage() const;
+  BufferMemoryUsage QueueMemoryUsage(uint32_t ssrc) const;
 
   // Returns the time when the first packet was sent;
   absl::optional<Timestamp> FirstSentPacketTime() const;
@@ -126,6 +149,8 @@ class PacingController {
   // Time since ProcessPackets() was last executed.
   TimeDelta TimeElapsedSinceLastProcess() const;
 
+  // Time until a ProcessPackets() call would find media budget available,
+  // i.e. until the debt left by the last burst has been paid off.
   TimeDelta TimeUntilAvailableBudget() const;
 
   // Check queue of pending packets and send them or padding packets, if budget
@@ -150,6 +175,8 @@ class PacingController {
   RoundRobinPacketQueue::QueuedPacket* GetPendingPacket(
       const PacedPacketInfo& pacing_info);
   void OnPacketSent(RoundRobinPacketQueue::QueuedPacket* packet);
+  // Hands |packet_batch_| to |packet_sender_|, if non-empty.
+  void SendPacketBatch(const PacedPacketInfo& pacing_info);
   void OnPaddingSent(DataSize padding_sent);
 
   Timestamp CurrentTime() const;
@@ -163,6 +190,10 @@ class PacingController {
   const bool send_padding_if_silent_;
   const bool pace_audio_;
   const bool small_first_probe_packet_;
+  // If set, packets released during one ProcessPackets() call are sent as a
+  // single batch at the end of the call, rather than one at a time.
+  const bool send_packet_batches_;
+  const ProcessMode mode_;
   TimeDelta min_packet_limit_;
 
   // TODO(webrtc:9716): Remove this when we are certain clocks are monotonic.
@@ -176,6 +207,9 @@ class PacingController {
   // allowed to send out during the current interval. This budget will be
   // utilized when there's no media to send.
   IntervalBudget padding_budget_;
+  // Part of the elapsed time not yet added to the budgets, which only have
+  // millisecond resolution. Only used in ProcessMode::kDynamic.
+  TimeDelta budget_time_remainder_;
 
   BitrateProber prober_;
   bool probing_send_failure_;
@@ -189,6 +223,9 @@ class PacingController {
 
   RoundRobinPacketQueue packet_queue_;
   uint64_t packet_counter_;
+  // Packets released but not yet handed to |packet_sender_|, when batch
+  // sending is enabled.
+  std::vector<std::unique_ptr<RtpPacketToSend>> packet_batch_;
 
   DataSize congestion_window_size_;
   DataSize outstanding_data_;
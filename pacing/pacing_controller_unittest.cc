@@ -105,6 +105,9 @@ class MockPacketSender : public PacingController::PacketSender {
   MOCK_METHOD2(SendRtpPacket,
                void(std::unique_ptr<RtpPacketToSend> packet,
                     const PacedPacketInfo& cluster_info));
+  MOCK_METHOD2(SendRtpPackets,
+               void(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                    const PacedPacketInfo& cluster_info));
   MOCK_METHOD1(
       GeneratePadding,
       std::vector<std::unique_ptr<RtpPacketToSend>>(DataSize target_size));
@@ -1307,5 +1310,104 @@ TEST_F(PacingControllerTest, SmallFirstProbePacket) {
     clock_.AdvanceTimeMilliseconds(5);
   }
 }
+
+TEST_F(PacingControllerTest, DynamicModeKeepsRateWithFrequentProcessCalls) {
+  MockPacketSender callback;
+  pacer_ = std::make_unique<PacingController>(
+      &clock_, &callback, nullptr, nullptr,
+      PacingController::ProcessMode::kDynamic);
+  pacer_->SetProbingEnabled(false);
+  pacer_->SetPacingRates(kTargetRate, DataRate::Zero());
+
+  DataSize data_sent = DataSize::Zero();
+  EXPECT_CALL(callback, SendRtpPacket)
+      .WillRepeatedly([&](std::unique_ptr<RtpPacketToSend> packet,
+                          const PacedPacketInfo& cluster_info) {
+        data_sent += DataSize::bytes(packet->payload_size());
+      });
+
+  // Process every 300us over one second, which the millisecond resolution
+  // budgets can only handle by carrying over the remainders.
+  const TimeDelta kProcessInterval = TimeDelta::us(300);
+  const Timestamp start_time = clock_.CurrentTime();
+  while (clock_.CurrentTime() - start_time < TimeDelta::seconds(1)) {
+    while (pacer_->QueueSizePackets() < 5) {
+      pacer_->EnqueuePacket(BuildRtpPacket(RtpPacketToSend::Type::kVideo));
+    }
+    clock_.AdvanceTimeMicroseconds(kProcessInterval.us());
+    pacer_->ProcessPackets();
+  }
+  EXPECT_NEAR((data_sent / TimeDelta::seconds(1)).kbps(), kTargetRate.kbps(),
+              kTargetRate.kbps() * 0.05);
+}
+
+TEST_F(PacingControllerTest, TimeUntilAvailableBudgetCoversDebt) {
+  MockPacketSender callback;
+  pacer_ = std::make_unique<PacingController>(
+      &clock_, &callback, nullptr, nullptr,
+      PacingController::ProcessMode::kDynamic);
+  pacer_->SetProbingEnabled(false);
+  pacer_->SetPacingRates(kTargetRate, DataRate::Zero());
+  for (int i = 0; i < 10; ++i) {
+    pacer_->EnqueuePacket(BuildRtpPacket(RtpPacketToSend::Type::kVideo));
+  }
+
+  size_t packets_sent = 0;
+  EXPECT_CALL(callback, SendRtpPacket)
+      .WillRepeatedly([&](std::unique_ptr<RtpPacketToSend> packet,
+                          const PacedPacketInfo& cluster_info) {
+        ++packets_sent;
+      });
+  clock_.AdvanceTimeMilliseconds(1);
+  pacer_->ProcessPackets();
+  ASSERT_GT(packets_sent, 0u);
+
+  // The budget is overused by the last packet of the burst, so nothing more
+  // can be sent until the time until available budget has passed.
+  const TimeDelta time_until_budget = pacer_->TimeUntilAvailableBudget();
+  EXPECT_GE(time_until_budget, TimeDelta::ms(1));
+  const size_t packets_sent_before = packets_sent;
+  clock_.AdvanceTimeMicroseconds(time_until_budget.us() - 100);
+  pacer_->ProcessPackets();
+  EXPECT_EQ(packets_sent, packets_sent_before);
+  EXPECT_GT(pacer_->TimeUntilAvailableBudget(), TimeDelta::Zero());
+
+  clock_.AdvanceTimeMicroseconds(pacer_->TimeUntilAvailableBudget().us());
+  pacer_->ProcessPackets();
+  EXPECT_GT(packets_sent, packets_sent_before);
+}
+
+TEST_F(PacingControllerTest, SendsPacketsInBatchesWithTrial) {
+  ScopedFieldTrials trial("WebRTC-Pacer-SendPacketBatches/Enabled/");
+  MockPacketSender callback;
+  pacer_ =
+      std::make_unique<PacingController>(&clock_, &callback, nullptr, nullptr);
+  pacer_->SetPacingRates(kTargetRate * kPaceMultiplier, DataRate::Zero());
+
+  const size_t kNumPackets = 10;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    pacer_->EnqueuePacket(BuildRtpPacket(RtpPacketToSend::Type::kVideo));
+  }
+
+  // Released packets must only be handed over as batches, in enqueue order.
+  size_t packets_sent = 0;
+  EXPECT_CALL(callback, SendRtpPacket).Times(0);
+  EXPECT_CALL(callback, SendRtpPackets)
+      .Times(::testing::AtLeast(1))
+      .WillRepeatedly(
+          [&](std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+              const PacedPacketInfo& cluster_info) {
+            EXPECT_FALSE(packets.empty());
+            for (const auto& packet : packets) {
+              EXPECT_EQ(packet->Ssrc(), kVideoSsrc);
+            }
+            packets_sent += packets.size();
+          });
+  while (packets_sent < kNumPackets) {
+    clock_.AdvanceTimeMilliseconds(5);
+    pacer_->ProcessPackets();
+  }
+  EXPECT_EQ(packets_sent, kNumPackets);
+}
 }  // namespace test
 }  // namespace webrtc
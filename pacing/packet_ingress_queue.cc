@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/packet_ingress_queue.h"
+
+#include <utility>
+
+namespace webrtc {
+
+PacketIngressQueue::PacketIngressQueue() : head_(nullptr) {}
+
+PacketIngressQueue::~PacketIngressQueue() {
+  Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+  while (node) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+void PacketIngressQueue::Push(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+  if (packets.empty()) {
+    return;
+  }
+  Node* node =
+      new Node{std::move(packets), head_.load(std::memory_order_relaxed)};
+  while (!head_.compare_exchange_weak(node->next, node,
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+size_t PacketIngressQueue::Drain(
+    rtc::FunctionView<void(std::unique_ptr<RtpPacketToSend>)> consumer) {
+  Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+  if (!node) {
+    return 0;
+  }
+
+  // Reverse the stack so that the oldest push comes first.
+  Node* oldest = nullptr;
+  while (node) {
+    Node* next = node->next;
+    node->next = oldest;
+    oldest = node;
+    node = next;
+  }
+
+  size_t num_packets = 0;
+  while (oldest) {
+    std::unique_ptr<Node> current(oldest);
+    oldest = current->next;
+    for (auto& packet : current->packets) {
+      consumer(std::move(packet));
+    }
+    num_packets += current->packets.size();
+  }
+  return num_packets;
+}
+
+bool PacketIngressQueue::Empty() const {
+  return head_.load(std::memory_order_relaxed) == nullptr;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACKET_INGRESS_QUEUE_H_
+#define MODULES_PACING_PACKET_INGRESS_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Multi-producer, single-consumer queue used to hand packets over to the
+// pacer without taking the pacer lock. Push() is lock-free and may be called
+// concurrently from any number of threads. Drain() may be called concurrently
+// with Push(), but only from one thread at a time.
+class PacketIngressQueue {
+ public:
+  PacketIngressQueue();
+  ~PacketIngressQueue();
+
+  // Adds |packets| to the queue. Packets from one call are kept together, and
+  // calls are drained in the order they completed.
+  void Push(std::vector<std::unique_ptr<RtpPacketToSend>> packets);
+
+  // Removes all packets currently in the queue and passes them, oldest first,
+  // to |consumer|. Returns the number of packets drained.
+  size_t Drain(
+      rtc::FunctionView<void(std::unique_ptr<RtpPacketToSend>)> consumer);
+
+  // Returns true if there is nothing to drain. Only a hint when called
+  // concurrently with Push().
+  bool Empty() const;
+
+ private:
+  struct Node {
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+    Node* next;
+  };
+
+  // Singly linked stack of pushed nodes, newest first. Producers push with a
+  // CAS loop and the consumer takes the whole stack with a single exchange,
+  // so no node is ever popped individually and the ABA problem cannot occur.
+  std::atomic<Node*> head_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketIngressQueue);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACKET_INGRESS_QUEUE_H_
@@ -24,6 +24,8 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace {
@@ -36,12 +38,15 @@ PacketRouter::PacketRouter() : PacketRouter(0) {}
 
 PacketRouter::PacketRouter(uint16_t start_transport_seq)
     : last_send_module_(nullptr),
+      packet_batch_observer_(nullptr),
       last_remb_time_ms_(rtc::TimeMillis()),
       last_send_bitrate_bps_(0),
       bitrate_bps_(0),
       max_bitrate_bps_(std::numeric_limits<decltype(max_bitrate_bps_)>::max()),
       active_remb_module_(nullptr),
-      transport_seq_(start_transport_seq) {}
+      transport_seq_(start_transport_seq),
+      latency_tracing_(
+          field_trial::IsEnabled("WebRTC-SendSideLatencyTracing")) {}
 
 PacketRouter::~PacketRouter() {
   RTC_DCHECK(rtp_send_modules_.empty());
@@ -127,12 +132,46 @@ RtpRtcp* PacketRouter::FindRtpModule(uint32_t ssrc) {
 void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
                               const PacedPacketInfo& cluster_info) {
   rtc::CritScope cs(&modules_crit_);
+  SendPacketLocked(std::move(packet), cluster_info);
+}
+
+void PacketRouter::SendPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  if (packets.empty()) {
+    return;
+  }
+  rtc::CritScope cs(&modules_crit_);
+  if (packet_batch_observer_) {
+    packet_batch_observer_->OnPacketBatchStarted();
+  }
+  for (auto& packet : packets) {
+    SendPacketLocked(std::move(packet), cluster_info);
+  }
+  if (packet_batch_observer_) {
+    packet_batch_observer_->OnPacketBatchComplete();
+  }
+}
+
+void PacketRouter::SetPacketBatchObserver(PacketBatchObserver* observer) {
+  rtc::CritScope cs(&modules_crit_);
+  packet_batch_observer_ = observer;
+}
+
+void PacketRouter::SendPacketLocked(std::unique_ptr<RtpPacketToSend> packet,
+                                    const PacedPacketInfo& cluster_info) {
   // With the new pacer code path, transport sequence numbers are only set here,
   // on the pacer thread. Therefore we don't need atomics/synchronization.
   if (packet->IsExtensionReserved<TransportSequenceNumber>()) {
     packet->SetExtension<TransportSequenceNumber>(AllocateSequenceNumber());
   }
 
+  if (latency_tracing_ && packet->capture_time_ms() > 0 &&
+      packet->packet_type() == RtpPacketToSend::Type::kVideo) {
+    RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.SendSideLatency.CaptureToSendMs",
+                              rtc::TimeMillis() - packet->capture_time_ms());
+  }
+
   auto it = rtp_module_cache_map_.find(packet->Ssrc());
   if (it != rtp_module_cache_map_.end()) {
     if (TrySendPacket(packet.get(), cluster_info, it->second)) {
@@ -32,6 +32,16 @@ namespace webrtc {
 
 class RtpRtcp;
 
+// Notified around each burst of packets handed to PacketRouter::SendPackets().
+// A transport that buffers the SendRtp() calls made in between can write the
+// whole burst with a single sendmmsg() or GSO send.
+class PacketBatchObserver {
+ public:
+  virtual ~PacketBatchObserver() = default;
+  virtual void OnPacketBatchStarted() = 0;
+  virtual void OnPacketBatchComplete() = 0;
+};
+
 // PacketRouter keeps track of rtp send modules to support the pacer.
 // In addition, it handles feedback messages, which are sent on a send
 // module if possible (sender report), otherwise on receive module
@@ -54,9 +64,19 @@ class PacketRouter : public RemoteBitrateObserver,
   virtual void SendPacket(std::unique_ptr<RtpPacketToSend> packet,
                           const PacedPacketInfo& cluster_info);
 
+  // Sends a burst of packets collected by the pacer during one process call,
+  // taking the module lock once for the whole burst.
+  virtual void SendPackets(
+      std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+      const PacedPacketInfo& cluster_info);
+
   virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       size_t target_size_bytes);
 
+  // Sets an observer to notify around bursts sent by SendPackets(). The
+  // observer must outlive the PacketRouter or be reset with nullptr.
+  void SetPacketBatchObserver(PacketBatchObserver* observer);
+
   // TODO(bugs.webrtc.org/11036): Remove when downstream usage is gone.
   void SetTransportWideSequenceNumber(uint16_t sequence_number);
   // TODO(bugs.webrtc.org/11036): Make private when downstream usage is gone.
@@ -95,6 +115,9 @@ class PacketRouter : public RemoteBitrateObserver,
       bool media_sender) RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
   void UnsetActiveRembModule() RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
   void DetermineActiveRembModule() RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
+  void SendPacketLocked(std::unique_ptr<RtpPacketToSend> packet,
+                        const PacedPacketInfo& cluster_info)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
   bool TrySendPacket(RtpPacketToSend* packet,
                      const PacedPacketInfo& cluster_info,
                      RtpRtcp* rtp_module)
@@ -108,6 +131,7 @@ class PacketRouter : public RemoteBitrateObserver,
       RTC_GUARDED_BY(modules_crit_);
   // The last module used to send media.
   RtpRtcp* last_send_module_ RTC_GUARDED_BY(modules_crit_);
+  PacketBatchObserver* packet_batch_observer_ RTC_GUARDED_BY(modules_crit_);
   // Rtcp modules of the rtp receivers.
   std::vector<RtcpFeedbackSenderInterface*> rtcp_feedback_senders_
       RTC_GUARDED_BY(modules_crit_);
@@ -133,6 +157,10 @@ class PacketRouter : public RemoteBitrateObserver,
 
   int transport_seq_ RTC_GUARDED_BY(modules_crit_);
 
+  // Set by the WebRTC-SendSideLatencyTracing field trial. Reports the capture
+  // to send delay of each video packet.
+  const bool latency_tracing_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketRouter);
 };
 }  // namespace webrtc
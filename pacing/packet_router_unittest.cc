@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -21,6 +22,8 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/fake_clock.h"
+#include "system_wrappers/include/metrics.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -47,6 +50,12 @@ using ::testing::SaveArg;
 constexpr int kProbeMinProbes = 5;
 constexpr int kProbeMinBytes = 1000;
 
+class MockPacketBatchObserver : public PacketBatchObserver {
+ public:
+  MOCK_METHOD0(OnPacketBatchStarted, void());
+  MOCK_METHOD0(OnPacketBatchComplete, void());
+};
+
 }  // namespace
 
 class PacketRouterTest : public ::testing::Test {
@@ -296,6 +305,41 @@ TEST_F(PacketRouterTest, SendPacketWithoutTransportSequenceNumbers) {
   packet_router_.RemoveSendRtpModule(&rtp_1);
 }
 
+TEST(PacketRouterLatencyTracingTest, ReportsCaptureToSendDelayOfVideo) {
+  test::ScopedFieldTrials trials("WebRTC-SendSideLatencyTracing/Enabled/");
+  rtc::ScopedFakeClock clock;
+  clock.AdvanceTime(TimeDelta::ms(1000));
+  metrics::Reset();
+  PacketRouter packet_router;
+  NiceMock<MockRtpRtcp> rtp_1;
+  packet_router.AddSendRtpModule(&rtp_1, false);
+
+  const uint16_t kSsrc1 = 1234;
+  ON_CALL(rtp_1, SendingMedia).WillByDefault(Return(true));
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  EXPECT_CALL(rtp_1, TrySendPacket).Times(2).WillRepeatedly(Return(true));
+
+  RtpHeaderExtensionMap extension_manager;
+  auto video_packet = std::make_unique<RtpPacketToSend>(&extension_manager);
+  video_packet->SetSsrc(kSsrc1);
+  video_packet->set_packet_type(RtpPacketToSend::Type::kVideo);
+  video_packet->set_capture_time_ms(rtc::TimeMillis());
+  auto audio_packet = std::make_unique<RtpPacketToSend>(*video_packet);
+  audio_packet->set_packet_type(RtpPacketToSend::Type::kAudio);
+
+  clock.AdvanceTime(TimeDelta::ms(17));
+  packet_router.SendPacket(std::move(video_packet), PacedPacketInfo());
+  packet_router.SendPacket(std::move(audio_packet), PacedPacketInfo());
+
+  // Only the video packet is reported.
+  EXPECT_EQ(1, metrics::NumSamples(
+                   "WebRTC.Video.SendSideLatency.CaptureToSendMs"));
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.Video.SendSideLatency.CaptureToSendMs", 17));
+
+  packet_router.RemoveSendRtpModule(&rtp_1);
+}
+
 TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   NiceMock<MockRtpRtcp> rtp_1;
   NiceMock<MockRtpRtcp> rtp_2;
@@ -343,6 +387,46 @@ TEST_F(PacketRouterTest, SendPacketAssignsTransportSequenceNumbers) {
   packet_router_.RemoveSendRtpModule(&rtp_2);
 }
 
+TEST_F(PacketRouterTest, SendPacketsNotifiesBatchObserverOnce) {
+  NiceMock<MockRtpRtcp> rtp_1;
+  NiceMock<MockRtpRtcp> rtp_2;
+  MockPacketBatchObserver batch_observer;
+
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+  packet_router_.SetPacketBatchObserver(&batch_observer);
+
+  const uint16_t kSsrc1 = 1234;
+  const uint16_t kSsrc2 = 2345;
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC).WillByDefault(Return(kSsrc2));
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.push_back(BuildRtpPacket(kSsrc1));
+  packets.push_back(BuildRtpPacket(kSsrc2));
+  packets.push_back(BuildRtpPacket(kSsrc1));
+
+  // All packets are routed between a single start/complete pair. As in
+  // SendPacketAssignsTransportSequenceNumbers, kSsrc2 is first tried on rtp_1.
+  const auto is_ssrc1 = Property(&RtpPacketToSend::Ssrc, kSsrc1);
+  const auto is_ssrc2 = Property(&RtpPacketToSend::Ssrc, kSsrc2);
+  ::testing::InSequence in_sequence;
+  EXPECT_CALL(batch_observer, OnPacketBatchStarted);
+  EXPECT_CALL(rtp_1, TrySendPacket(is_ssrc1, _)).WillOnce(Return(true));
+  EXPECT_CALL(rtp_1, TrySendPacket(is_ssrc2, _)).WillOnce(Return(false));
+  EXPECT_CALL(rtp_2, TrySendPacket(is_ssrc2, _)).WillOnce(Return(true));
+  EXPECT_CALL(rtp_1, TrySendPacket(is_ssrc1, _)).WillOnce(Return(true));
+  EXPECT_CALL(batch_observer, OnPacketBatchComplete);
+  packet_router_.SendPackets(std::move(packets), PacedPacketInfo());
+
+  // An empty batch is not reported.
+  packet_router_.SendPackets({}, PacedPacketInfo());
+
+  packet_router_.SetPacketBatchObserver(nullptr);
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+  packet_router_.RemoveSendRtpModule(&rtp_2);
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 TEST_F(PacketRouterTest, DoubleRegistrationOfSendModuleDisallowed) {
   NiceMock<MockRtpRtcp> module;
@@ -15,14 +15,20 @@
 #include <utility>
 
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace {
 static constexpr DataSize kMaxLeadingSize = DataSize::Bytes<1400>();
+static constexpr size_t kMinEnqueueTimesSize = 64;
 }
 
-RoundRobinPacketQueue::QueuedPacket::QueuedPacket(const QueuedPacket& rhs) =
+constexpr size_t RoundRobinPacketQueue::kNotScheduled;
+
+RoundRobinPacketQueue::QueuedPacket::QueuedPacket(QueuedPacket&& rhs) =
     default;
+RoundRobinPacketQueue::QueuedPacket&
+RoundRobinPacketQueue::QueuedPacket::operator=(QueuedPacket&& rhs) = default;
 RoundRobinPacketQueue::QueuedPacket::~QueuedPacket() = default;
 
 RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
@@ -35,9 +41,8 @@ RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
     DataSize size,
     bool retransmission,
     uint64_t enqueue_order,
-    std::multiset<Timestamp>::iterator enqueue_time_it,
-    absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
-        packet_it)
+    uint64_t enqueue_index,
+    std::unique_ptr<RtpPacketToSend> packet)
     : type_(type),
       priority_(priority),
       ssrc_(ssrc),
@@ -47,12 +52,12 @@ RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
       size_(size),
       retransmission_(retransmission),
       enqueue_order_(enqueue_order),
-      enqueue_time_it_(enqueue_time_it),
-      packet_it_(packet_it) {}
+      enqueue_index_(enqueue_index),
+      packet_(std::move(packet)) {}
 
 std::unique_ptr<RtpPacketToSend>
 RoundRobinPacketQueue::QueuedPacket::ReleasePacket() {
-  return packet_it_ ? std::move(**packet_it_) : nullptr;
+  return std::move(packet_);
 }
 
 void RoundRobinPacketQueue::QueuedPacket::SubtractPauseTime(
@@ -70,10 +75,24 @@ bool RoundRobinPacketQueue::QueuedPacket::operator<(
   return enqueue_order_ > other.enqueue_order_;
 }
 
-RoundRobinPacketQueue::Stream::Stream() : size(DataSize::Zero()), ssrc(0) {}
-RoundRobinPacketQueue::Stream::Stream(const Stream& stream) = default;
+RoundRobinPacketQueue::Stream::Stream()
+    : size(DataSize::Zero()),
+      ssrc(0),
+      schedule_position(kNotScheduled) {}
+RoundRobinPacketQueue::Stream::Stream(Stream&& stream) = default;
+RoundRobinPacketQueue::Stream& RoundRobinPacketQueue::Stream::operator=(
+    Stream&& stream) = default;
 RoundRobinPacketQueue::Stream::~Stream() {}
 
+bool RoundRobinPacketQueue::ScheduleEntry::operator<(
+    const ScheduleEntry& other) const {
+  if (priority != other.priority)
+    return priority < other.priority;
+  if (size != other.size)
+    return size < other.size;
+  return order < other.order;
+}
+
 bool IsEnabled(const WebRtcKeyValueConfig* field_trials, const char* name) {
   if (!field_trials) {
     return false;
@@ -91,8 +110,13 @@ RoundRobinPacketQueue::RoundRobinPacketQueue(
       max_size_(kMaxLeadingSize),
       queue_time_sum_(TimeDelta::Zero()),
       pause_time_sum_(TimeDelta::Zero()),
+      schedule_counter_(0),
+      oldest_enqueue_index_(0),
+      next_enqueue_index_(0),
       send_side_bwe_with_overhead_(
-          IsEnabled(field_trials, "WebRTC-SendSideBwe-WithOverhead")) {}
+          IsEnabled(field_trials, "WebRTC-SendSideBwe-WithOverhead")),
+      latency_tracing_(
+          IsEnabled(field_trials, "WebRTC-SendSideLatencyTracing")) {}
 
 RoundRobinPacketQueue::~RoundRobinPacketQueue() {}
 
@@ -107,7 +131,7 @@ void RoundRobinPacketQueue::Push(int priority,
                                  uint64_t enqueue_order) {
   Push(QueuedPacket(priority, type, ssrc, seq_number, capture_time_ms,
                     enqueue_time, size, retransmission, enqueue_order,
-                    enqueue_times_.insert(enqueue_time), absl::nullopt));
+                    AddEnqueueTime(enqueue_time), nullptr));
 }
 
 void RoundRobinPacketQueue::Push(int priority,
@@ -124,27 +148,31 @@ void RoundRobinPacketQueue::Push(int priority,
   auto type = packet->packet_type();
   RTC_DCHECK(type.has_value());
 
-  rtp_packets_.push_front(std::move(packet));
-  Push(QueuedPacket(
-      priority, *type, ssrc, sequence_number, capture_time_ms, enqueue_time,
-      size, *type == RtpPacketToSend::Type::kRetransmission, enqueue_order,
-      enqueue_times_.insert(enqueue_time), rtp_packets_.begin()));
+  Push(QueuedPacket(priority, *type, ssrc, sequence_number, capture_time_ms,
+                    enqueue_time, size,
+                    *type == RtpPacketToSend::Type::kRetransmission,
+                    enqueue_order, AddEnqueueTime(enqueue_time),
+                    std::move(packet)));
 }
 
 RoundRobinPacketQueue::QueuedPacket* RoundRobinPacketQueue::BeginPop() {
   RTC_CHECK(!pop_packet_ && !pop_stream_);
 
-  Stream* stream = GetHighestPriorityStream();
-  pop_stream_.emplace(stream);
-  pop_packet_.emplace(stream->packet_queue.top());
-  stream->packet_queue.pop();
+  size_t stream_index = GetHighestPriorityStream();
+  std::vector<QueuedPacket>& packet_queue = streams_[stream_index].packet_queue;
+  pop_stream_.emplace(stream_index);
+  std::pop_heap(packet_queue.begin(), packet_queue.end());
+  pop_packet_.emplace(std::move(packet_queue.back()));
+  packet_queue.pop_back();
 
   return &pop_packet_.value();
 }
 
 void RoundRobinPacketQueue::CancelPop() {
   RTC_CHECK(pop_packet_ && pop_stream_);
-  (*pop_stream_)->packet_queue.push(*pop_packet_);
+  std::vector<QueuedPacket>& packet_queue = streams_[*pop_stream_].packet_queue;
+  packet_queue.push_back(std::move(*pop_packet_));
+  std::push_heap(packet_queue.begin(), packet_queue.end());
   pop_packet_.reset();
   pop_stream_.reset();
 }
@@ -152,8 +180,9 @@ void RoundRobinPacketQueue::CancelPop() {
 void RoundRobinPacketQueue::FinalizePop() {
   if (!Empty()) {
     RTC_CHECK(pop_packet_ && pop_stream_);
-    Stream* stream = *pop_stream_;
-    stream_priorities_.erase(stream->priority_it);
+    const size_t stream_index = *pop_stream_;
+    Stream* stream = &streams_[stream_index];
+    UnscheduleStream(stream_index);
     const QueuedPacket& packet = *pop_packet_;
 
     // Calculate the total amount of time spent by this packet in the queue
@@ -164,15 +193,13 @@ void RoundRobinPacketQueue::FinalizePop() {
     TimeDelta time_in_non_paused_state =
         time_last_updated_ - packet.enqueue_time() - pause_time_sum_;
     queue_time_sum_ -= time_in_non_paused_state;
-
-    RTC_CHECK(packet.EnqueueTimeIterator() != enqueue_times_.end());
-    enqueue_times_.erase(packet.EnqueueTimeIterator());
-
-    auto packet_it = packet.PacketIterator();
-    if (packet_it) {
-      rtp_packets_.erase(*packet_it);
+    if (latency_tracing_ && packet.type() == RtpPacketToSend::Type::kVideo) {
+      RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.SendSideLatency.PacerQueueMs",
+                                time_in_non_paused_state.ms());
     }
 
+    RemoveEnqueueTime(packet.EnqueueIndex());
+
     // Update |bytes| of this stream. The general idea is that the stream that
     // has sent the least amount of bytes should have the highest priority.
     // The problem with that is if streams send with different rates, in which
@@ -185,16 +212,14 @@ void RoundRobinPacketQueue::FinalizePop() {
 
     size_ -= packet.size();
     size_packets_ -= 1;
+    memory_usage_.Remove(packet.size().bytes());
+    stream->memory_usage.Remove(packet.size().bytes());
     RTC_CHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
 
     // If there are packets left to be sent, schedule the stream again.
-    RTC_CHECK(!IsSsrcScheduled(stream->ssrc));
-    if (stream->packet_queue.empty()) {
-      stream->priority_it = stream_priorities_.end();
-    } else {
-      int priority = stream->packet_queue.top().priority();
-      stream->priority_it = stream_priorities_.emplace(
-          StreamPrioKey(priority, stream->size), stream->ssrc);
+    RTC_CHECK_EQ(stream->schedule_position, kNotScheduled);
+    if (!stream->packet_queue.empty()) {
+      ScheduleStream(stream_index, stream->packet_queue.front().priority());
     }
 
     pop_packet_.reset();
@@ -203,9 +228,9 @@ void RoundRobinPacketQueue::FinalizePop() {
 }
 
 bool RoundRobinPacketQueue::Empty() const {
-  RTC_CHECK((!stream_priorities_.empty() && size_packets_ > 0) ||
-            (stream_priorities_.empty() && size_packets_ == 0));
-  return stream_priorities_.empty();
+  RTC_CHECK((!stream_schedule_.empty() && size_packets_ > 0) ||
+            (stream_schedule_.empty() && size_packets_ == 0));
+  return stream_schedule_.empty();
 }
 
 size_t RoundRobinPacketQueue::SizeInPackets() const {
@@ -216,11 +241,28 @@ DataSize RoundRobinPacketQueue::Size() const {
   return size_;
 }
 
+BufferMemoryUsage RoundRobinPacketQueue::GetMemoryUsage() const {
+  return memory_usage_;
+}
+
+BufferMemoryUsage RoundRobinPacketQueue::GetMemoryUsage(uint32_t ssrc) const {
+  auto it = std::lower_bound(
+      stream_index_.begin(), stream_index_.end(), ssrc,
+      [](const std::pair<uint32_t, size_t>& entry, uint32_t ssrc) {
+        return entry.first < ssrc;
+      });
+  if (it == stream_index_.end() || it->first != ssrc) {
+    return BufferMemoryUsage();
+  }
+  return streams_[it->second].memory_usage;
+}
+
 Timestamp RoundRobinPacketQueue::OldestEnqueueTime() const {
   if (Empty())
     return Timestamp::MinusInfinity();
-  RTC_CHECK(!enqueue_times_.empty());
-  return *enqueue_times_.begin();
+  RTC_CHECK_LT(oldest_enqueue_index_, next_enqueue_index_);
+  const size_t mask = enqueue_times_.size() - 1;
+  return enqueue_times_[oldest_enqueue_index_ & mask].time;
 }
 
 void RoundRobinPacketQueue::UpdateQueueTime(Timestamp now) {
@@ -253,29 +295,20 @@ TimeDelta RoundRobinPacketQueue::AverageQueueTime() const {
 }
 
 void RoundRobinPacketQueue::Push(QueuedPacket packet) {
-  auto stream_info_it = streams_.find(packet.ssrc());
-  if (stream_info_it == streams_.end()) {
-    stream_info_it = streams_.emplace(packet.ssrc(), Stream()).first;
-    stream_info_it->second.priority_it = stream_priorities_.end();
-    stream_info_it->second.ssrc = packet.ssrc();
-  }
-
-  Stream* stream = &stream_info_it->second;
-
-  if (stream->priority_it == stream_priorities_.end()) {
-    // If the SSRC is not currently scheduled, add it to |stream_priorities_|.
-    RTC_CHECK(!IsSsrcScheduled(stream->ssrc));
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(packet.priority(), stream->size), packet.ssrc());
-  } else if (packet.priority() < stream->priority_it->first.priority) {
-    // If the priority of this SSRC increased, remove the outdated StreamPrioKey
-    // and insert a new one with the new priority. Note that |priority_| uses
-    // lower ordinal for higher priority.
-    stream_priorities_.erase(stream->priority_it);
-    stream->priority_it = stream_priorities_.emplace(
-        StreamPrioKey(packet.priority(), stream->size), packet.ssrc());
+  const size_t stream_index = GetOrCreateStream(packet.ssrc());
+  Stream* stream = &streams_[stream_index];
+
+  if (stream->schedule_position == kNotScheduled) {
+    // If the SSRC is not currently scheduled, add it to |stream_schedule_|.
+    ScheduleStream(stream_index, packet.priority());
+  } else if (packet.priority() <
+             stream_schedule_[stream->schedule_position].priority) {
+    // If the priority of this SSRC increased, reschedule it with the new
+    // priority. Note that |priority_| uses lower ordinal for higher priority.
+    UnscheduleStream(stream_index);
+    ScheduleStream(stream_index, packet.priority());
   }
-  RTC_CHECK(stream->priority_it != stream_priorities_.end());
+  RTC_CHECK(stream->schedule_position != kNotScheduled);
 
   // In order to figure out how much time a packet has spent in the queue while
   // not in a paused state, we subtract the total amount of time the queue has
@@ -284,32 +317,142 @@ void RoundRobinPacketQueue::Push(QueuedPacket packet) {
   // subtract the total amount of time the packet has spent in the queue while
   // in a paused state.
   UpdateQueueTime(packet.enqueue_time());
+  if (latency_tracing_ && packet.type() == RtpPacketToSend::Type::kVideo &&
+      packet.capture_time_ms() > 0) {
+    RTC_HISTOGRAM_COUNTS_1000(
+        "WebRTC.Video.SendSideLatency.CaptureToPacerEnqueueMs",
+        packet.enqueue_time().ms() - packet.capture_time_ms());
+  }
   packet.SubtractPauseTime(pause_time_sum_);
 
   size_packets_ += 1;
   size_ += packet.size();
+  memory_usage_.Add(packet.size().bytes());
+  stream->memory_usage.Add(packet.size().bytes());
+
+  stream->packet_queue.push_back(std::move(packet));
+  std::push_heap(stream->packet_queue.begin(), stream->packet_queue.end());
+}
+
+size_t RoundRobinPacketQueue::GetOrCreateStream(uint32_t ssrc) {
+  auto it = std::lower_bound(
+      stream_index_.begin(), stream_index_.end(), ssrc,
+      [](const std::pair<uint32_t, size_t>& entry, uint32_t ssrc) {
+        return entry.first < ssrc;
+      });
+  if (it != stream_index_.end() && it->first == ssrc) {
+    return it->second;
+  }
+
+  const size_t stream_index = streams_.size();
+  streams_.emplace_back();
+  streams_.back().ssrc = ssrc;
+  stream_index_.insert(it, std::make_pair(ssrc, stream_index));
+  return stream_index;
+}
 
-  stream->packet_queue.push(packet);
+size_t RoundRobinPacketQueue::GetHighestPriorityStream() const {
+  RTC_CHECK(!stream_schedule_.empty());
+  size_t stream_index = stream_schedule_.front().stream_index;
+  const Stream& stream = streams_[stream_index];
+  RTC_CHECK_EQ(stream.schedule_position, 0u);
+  RTC_CHECK(!stream.packet_queue.empty());
+  return stream_index;
 }
 
-RoundRobinPacketQueue::Stream*
-RoundRobinPacketQueue::GetHighestPriorityStream() {
-  RTC_CHECK(!stream_priorities_.empty());
-  uint32_t ssrc = stream_priorities_.begin()->second;
+void RoundRobinPacketQueue::ScheduleStream(size_t stream_index, int priority) {
+  Stream& stream = streams_[stream_index];
+  RTC_DCHECK_EQ(stream.schedule_position, kNotScheduled);
+  stream.schedule_position = stream_schedule_.size();
+  stream_schedule_.push_back(
+      ScheduleEntry{priority, stream.size, schedule_counter_++, stream_index});
+  SiftUp(stream.schedule_position);
+}
+
+void RoundRobinPacketQueue::UnscheduleStream(size_t stream_index) {
+  const size_t position = streams_[stream_index].schedule_position;
+  RTC_DCHECK_LT(position, stream_schedule_.size());
+  const size_t last = stream_schedule_.size() - 1;
+  if (position != last) {
+    SwapSchedulePositions(position, last);
+  }
+  stream_schedule_.pop_back();
+  streams_[stream_index].schedule_position = kNotScheduled;
+  if (position != last) {
+    SiftUp(position);
+    SiftDown(position);
+  }
+}
+
+void RoundRobinPacketQueue::SiftUp(size_t position) {
+  while (position > 0) {
+    const size_t parent = (position - 1) / 2;
+    if (!(stream_schedule_[position] < stream_schedule_[parent])) {
+      break;
+    }
+    SwapSchedulePositions(position, parent);
+    position = parent;
+  }
+}
+
+void RoundRobinPacketQueue::SiftDown(size_t position) {
+  const size_t size = stream_schedule_.size();
+  while (true) {
+    size_t best = position;
+    const size_t left = 2 * position + 1;
+    const size_t right = left + 1;
+    if (left < size && stream_schedule_[left] < stream_schedule_[best]) {
+      best = left;
+    }
+    if (right < size && stream_schedule_[right] < stream_schedule_[best]) {
+      best = right;
+    }
+    if (best == position) {
+      break;
+    }
+    SwapSchedulePositions(position, best);
+    position = best;
+  }
+}
+
+void RoundRobinPacketQueue::SwapSchedulePositions(size_t a, size_t b) {
+  std::swap(stream_schedule_[a], stream_schedule_[b]);
+  streams_[stream_schedule_[a].stream_index].schedule_position = a;
+  streams_[stream_schedule_[b].stream_index].schedule_position = b;
+}
+
+uint64_t RoundRobinPacketQueue::AddEnqueueTime(Timestamp enqueue_time) {
+  const size_t span = next_enqueue_index_ - oldest_enqueue_index_;
+  if (span == enqueue_times_.size()) {
+    // Ring is full, double its size and move the live span over.
+    std::vector<EnqueueTimeEntry> new_enqueue_times(
+        std::max(kMinEnqueueTimesSize, 2 * enqueue_times_.size()));
+    const size_t new_mask = new_enqueue_times.size() - 1;
+    for (uint64_t i = oldest_enqueue_index_; i < next_enqueue_index_; ++i) {
+      new_enqueue_times[i & new_mask] =
+          enqueue_times_[i & (enqueue_times_.size() - 1)];
+    }
+    enqueue_times_.swap(new_enqueue_times);
+  }
 
-  auto stream_info_it = streams_.find(ssrc);
-  RTC_CHECK(stream_info_it != streams_.end());
-  RTC_CHECK(stream_info_it->second.priority_it == stream_priorities_.begin());
-  RTC_CHECK(!stream_info_it->second.packet_queue.empty());
-  return &stream_info_it->second;
+  const uint64_t enqueue_index = next_enqueue_index_++;
+  EnqueueTimeEntry& entry =
+      enqueue_times_[enqueue_index & (enqueue_times_.size() - 1)];
+  entry.time = enqueue_time;
+  entry.in_queue = true;
+  return enqueue_index;
 }
 
-bool RoundRobinPacketQueue::IsSsrcScheduled(uint32_t ssrc) const {
-  for (const auto& scheduled_stream : stream_priorities_) {
-    if (scheduled_stream.second == ssrc)
-      return true;
+void RoundRobinPacketQueue::RemoveEnqueueTime(uint64_t enqueue_index) {
+  RTC_CHECK_GE(enqueue_index, oldest_enqueue_index_);
+  RTC_CHECK_LT(enqueue_index, next_enqueue_index_);
+  const size_t mask = enqueue_times_.size() - 1;
+  RTC_CHECK(enqueue_times_[enqueue_index & mask].in_queue);
+  enqueue_times_[enqueue_index & mask].in_queue = false;
+  while (oldest_enqueue_index_ < next_enqueue_index_ &&
+         !enqueue_times_[oldest_enqueue_index_ & mask].in_queue) {
+    ++oldest_enqueue_index_;
   }
-  return false;
 }
 
 }  // namespace webrtc
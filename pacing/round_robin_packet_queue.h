@@ -14,17 +14,16 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
-#include <map>
 #include <memory>
-#include <queue>
-#include <set>
+#include <utility>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "system_wrappers/include/clock.h"
@@ -39,20 +38,19 @@ class RoundRobinPacketQueue {
 
   struct QueuedPacket {
    public:
-    QueuedPacket(
-        int priority,
-        RtpPacketToSend::Type type,
-        uint32_t ssrc,
-        uint16_t seq_number,
-        int64_t capture_time_ms,
-        Timestamp enqueue_time,
-        DataSize size,
-        bool retransmission,
-        uint64_t enqueue_order,
-        std::multiset<Timestamp>::iterator enqueue_time_it,
-        absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
-            packet_it);
-    QueuedPacket(const QueuedPacket& rhs);
+    QueuedPacket(int priority,
+                 RtpPacketToSend::Type type,
+                 uint32_t ssrc,
+                 uint16_t seq_number,
+                 int64_t capture_time_ms,
+                 Timestamp enqueue_time,
+                 DataSize size,
+                 bool retransmission,
+                 uint64_t enqueue_order,
+                 uint64_t enqueue_index,
+                 std::unique_ptr<RtpPacketToSend> packet);
+    QueuedPacket(QueuedPacket&& rhs);
+    QueuedPacket& operator=(QueuedPacket&& rhs);
     ~QueuedPacket();
 
     bool operator<(const QueuedPacket& other) const;
@@ -69,13 +67,7 @@ class RoundRobinPacketQueue {
     std::unique_ptr<RtpPacketToSend> ReleasePacket();
 
     // For internal use.
-    absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
-    PacketIterator() const {
-      return packet_it_;
-    }
-    std::multiset<Timestamp>::iterator EnqueueTimeIterator() const {
-      return enqueue_time_it_;
-    }
+    uint64_t EnqueueIndex() const { return enqueue_index_; }
     void SubtractPauseTime(TimeDelta pause_time_sum);
 
    private:
@@ -88,11 +80,10 @@ class RoundRobinPacketQueue {
     DataSize size_;
     bool retransmission_;
     uint64_t enqueue_order_;
-    std::multiset<Timestamp>::iterator enqueue_time_it_;
-    // Iterator into |rtp_packets_| where the memory for RtpPacket is owned,
-    // if applicable.
-    absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
-        packet_it_;
+    // Position in |enqueue_times_|.
+    uint64_t enqueue_index_;
+    // The packet itself, if the queue has ownership of it.
+    std::unique_ptr<RtpPacketToSend> packet_;
   };
 
   void Push(int priority,
@@ -115,6 +106,9 @@ class RoundRobinPacketQueue {
   bool Empty() const;
   size_t SizeInPackets() const;
   DataSize Size() const;
+  // Returns the bytes and packets queued, in total or for the stream |ssrc|.
+  BufferMemoryUsage GetMemoryUsage() const;
+  BufferMemoryUsage GetMemoryUsage(uint32_t ssrc) const;
 
   Timestamp OldestEnqueueTime() const;
   TimeDelta AverageQueueTime() const;
@@ -122,76 +116,97 @@ class RoundRobinPacketQueue {
   void SetPauseState(bool paused, Timestamp now);
 
  private:
-  struct StreamPrioKey {
-    StreamPrioKey(int priority, DataSize size)
-        : priority(priority), size(size) {}
-
-    bool operator<(const StreamPrioKey& other) const {
-      if (priority != other.priority)
-        return priority < other.priority;
-      return size < other.size;
-    }
-
-    const int priority;
-    const DataSize size;
-  };
+  // Position of a stream that is not in |stream_schedule_|.
+  static constexpr size_t kNotScheduled = static_cast<size_t>(-1);
 
   struct Stream {
     Stream();
-    Stream(const Stream&);
-
-    virtual ~Stream();
+    Stream(Stream&&);
+    Stream& operator=(Stream&&);
+    ~Stream();
 
     DataSize size;
     uint32_t ssrc;
-    std::priority_queue<QueuedPacket> packet_queue;
-
-    // Whenever a packet is inserted for this stream we check if |priority_it|
-    // points to an element in |stream_priorities_|, and if it does it means
-    // this stream has already been scheduled, and if the scheduled priority is
-    // lower than the priority of the incoming packet we reschedule this stream
-    // with the higher priority.
-    std::multimap<StreamPrioKey, uint32_t>::iterator priority_it;
+    BufferMemoryUsage memory_usage;
+    // Binary max-heap ordered by QueuedPacket::operator<. Kept as a plain
+    // vector so that its capacity is reused across packets.
+    std::vector<QueuedPacket> packet_queue;
+
+    // Index into |stream_schedule_|, or kNotScheduled.
+    size_t schedule_position;
+  };
+
+  // Entry in |stream_schedule_|. Streams with lower priority value, and then
+  // with lower |size|, are sent first. |order| breaks ties in favor of the
+  // stream scheduled first. The keys are copied here so that heap operations
+  // don't need to touch |streams_|.
+  struct ScheduleEntry {
+    bool operator<(const ScheduleEntry& other) const;
+
+    int priority;
+    DataSize size;
+    uint64_t order;
+    size_t stream_index;
+  };
+
+  struct EnqueueTimeEntry {
+    Timestamp time = Timestamp::MinusInfinity();
+    bool in_queue = false;
   };
 
   void Push(QueuedPacket packet);
 
-  Stream* GetHighestPriorityStream();
+  // Returns the index in |streams_| for |ssrc|, adding a stream if needed.
+  size_t GetOrCreateStream(uint32_t ssrc);
+  size_t GetHighestPriorityStream() const;
+
+  // Intrusive min-heap operations on |stream_schedule_|.
+  void ScheduleStream(size_t stream_index, int priority);
+  void UnscheduleStream(size_t stream_index);
+  void SiftUp(size_t position);
+  void SiftDown(size_t position);
+  void SwapSchedulePositions(size_t a, size_t b);
 
-  // Just used to verify correctness.
-  bool IsSsrcScheduled(uint32_t ssrc) const;
+  // Records the enqueue time of a new packet and returns its index.
+  uint64_t AddEnqueueTime(Timestamp enqueue_time);
+  void RemoveEnqueueTime(uint64_t enqueue_index);
 
   Timestamp time_last_updated_;
   absl::optional<QueuedPacket> pop_packet_;
-  absl::optional<Stream*> pop_stream_;
+  absl::optional<size_t> pop_stream_;
 
   bool paused_;
   size_t size_packets_;
   DataSize size_;
   DataSize max_size_;
+  BufferMemoryUsage memory_usage_;
   TimeDelta queue_time_sum_;
   TimeDelta pause_time_sum_;
 
-  // A map of streams used to prioritize from which stream to send next. We use
-  // a multimap instead of a priority_queue since the priority of a stream can
-  // change as a new packet is inserted, and a multimap allows us to remove and
-  // then reinsert a StreamPrioKey if the priority has increased.
-  std::multimap<StreamPrioKey, uint32_t> stream_priorities_;
-
-  // A map of SSRCs to Streams.
-  std::map<uint32_t, Stream> streams_;
-
-  // The enqueue time of every packet currently in the queue. Used to figure out
-  // the age of the oldest packet in the queue.
-  std::multiset<Timestamp> enqueue_times_;
-
-  // List of RTP packets to be sent, not necessarily in the order they will be
-  // sent. PacketInfo.packet_it will point to an entry in this list, or the
-  // end iterator of this list if queue does not have direct ownership of the
-  // packet.
-  std::list<std::unique_ptr<RtpPacketToSend>> rtp_packets_;
+  // All streams that have ever had a packet pushed. Streams are never removed,
+  // so indices into this vector are stable.
+  std::vector<Stream> streams_;
+  // (ssrc, index into |streams_|) pairs, sorted by ssrc.
+  std::vector<std::pair<uint32_t, size_t>> stream_index_;
+
+  // Min-heap of the streams that have packets to send. The stream to send
+  // from next is at the front. A heap is used instead of a sorted container
+  // since the priority of a stream can change as a new packet is inserted, and
+  // each stream tracks its position so that it can be moved.
+  std::vector<ScheduleEntry> stream_schedule_;
+  uint64_t schedule_counter_;
+
+  // Enqueue times of every packet currently in the queue, as a power-of-two
+  // ring indexed by push order. Enqueue times are non-decreasing in push
+  // order, so the front entry that is still queued is the oldest.
+  std::vector<EnqueueTimeEntry> enqueue_times_;
+  uint64_t oldest_enqueue_index_;
+  uint64_t next_enqueue_index_;
 
   const bool send_side_bwe_with_overhead_;
+  // Set by the WebRTC-SendSideLatencyTracing field trial. Reports how long
+  // video packets waited before and inside the queue.
+  const bool latency_tracing_;
 };
 }  // namespace webrtc
 
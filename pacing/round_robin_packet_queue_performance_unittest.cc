@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumRounds = 200;
+constexpr int kPacketsPerStreamPerRound = 4;
+
+}  // namespace
+
+// Measures the cost of pushing and popping a packet with many concurrent
+// streams, as with one pacer serving a large number of SSRCs.
+TEST(RoundRobinPacketQueuePerformanceTest, DISABLED_ManyStreams) {
+  for (uint32_t num_streams : {1, 10, 50, 200, 500}) {
+    Timestamp now = Timestamp::ms(1000);
+    RoundRobinPacketQueue queue(now, nullptr);
+    uint64_t enqueue_order = 0;
+    uint16_t sequence_number = 0;
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+    int64_t push_us = 0;
+    int64_t pop_us = 0;
+    for (int round = 0; round < kNumRounds; ++round) {
+      for (int i = 0; i < kPacketsPerStreamPerRound; ++i) {
+        for (uint32_t ssrc = 1; ssrc <= num_streams; ++ssrc) {
+          auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+          packet->set_packet_type(ssrc % 10 == 0
+                                      ? RtpPacketToSend::Type::kAudio
+                                      : RtpPacketToSend::Type::kVideo);
+          packet->SetSsrc(ssrc);
+          packet->SetSequenceNumber(sequence_number++);
+          packet->SetPayloadSize(1000);
+          packets.push_back(std::move(packet));
+        }
+      }
+
+      int64_t start_us = rtc::TimeMicros();
+      for (auto& packet : packets) {
+        const int priority =
+            *packet->packet_type() == RtpPacketToSend::Type::kAudio ? 1 : 3;
+        queue.Push(priority, now, enqueue_order++, std::move(packet));
+      }
+      push_us += rtc::TimeMicros() - start_us;
+      packets.clear();
+
+      now += TimeDelta::ms(5);
+      queue.UpdateQueueTime(now);
+      start_us = rtc::TimeMicros();
+      while (!queue.Empty()) {
+        RoundRobinPacketQueue::QueuedPacket* queued_packet = queue.BeginPop();
+        packets.push_back(queued_packet->ReleasePacket());
+        queue.FinalizePop();
+      }
+      pop_us += rtc::TimeMicros() - start_us;
+      packets.clear();
+    }
+
+    const double num_packets =
+        kNumRounds * kPacketsPerStreamPerRound * num_streams;
+    rtc::StringBuilder story;
+    story << num_streams << "_streams";
+    test::PrintResult("round_robin_queue_push_time", "", story.str(),
+                      1000.0 * push_us / num_packets, "ns", false);
+    test::PrintResult("round_robin_queue_pop_time", "", story.str(),
+                      1000.0 * pop_us / num_packets, "ns", false);
+  }
+}
+
+}  // namespace webrtc
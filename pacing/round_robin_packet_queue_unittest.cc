@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/round_robin_packet_queue.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kAudioPriority = 1;
+constexpr int kRetransmissionPriority = 2;
+constexpr int kVideoPriority = 3;
+constexpr size_t kPayloadSize = 1000;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(RtpPacketToSend::Type type,
+                                              uint32_t ssrc,
+                                              uint16_t sequence_number) {
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->set_packet_type(type);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetPayloadSize(kPayloadSize);
+  return packet;
+}
+
+class RoundRobinPacketQueueTest : public ::testing::Test {
+ protected:
+  RoundRobinPacketQueueTest()
+      : now_(Timestamp::ms(1000)), queue_(now_, nullptr), enqueue_order_(0) {}
+
+  void Push(int priority,
+            RtpPacketToSend::Type type,
+            uint32_t ssrc,
+            uint16_t sequence_number) {
+    queue_.Push(priority, now_, enqueue_order_++,
+                CreatePacket(type, ssrc, sequence_number));
+  }
+
+  // Pops the next packet and returns it.
+  std::unique_ptr<RtpPacketToSend> Pop() {
+    RoundRobinPacketQueue::QueuedPacket* queued_packet = queue_.BeginPop();
+    std::unique_ptr<RtpPacketToSend> packet = queued_packet->ReleasePacket();
+    queue_.FinalizePop();
+    return packet;
+  }
+
+  Timestamp now_;
+  RoundRobinPacketQueue queue_;
+  uint64_t enqueue_order_;
+};
+
+}  // namespace
+
+TEST_F(RoundRobinPacketQueueTest, PopsByPriorityWithinStream) {
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 1);
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 2);
+  Push(kRetransmissionPriority, RtpPacketToSend::Type::kRetransmission, 1, 3);
+  Push(kAudioPriority, RtpPacketToSend::Type::kAudio, 1, 4);
+  EXPECT_EQ(4u, queue_.SizeInPackets());
+  EXPECT_EQ(DataSize::bytes(4 * kPayloadSize), queue_.Size());
+
+  EXPECT_EQ(4, Pop()->SequenceNumber());
+  EXPECT_EQ(3, Pop()->SequenceNumber());
+  EXPECT_EQ(1, Pop()->SequenceNumber());
+  EXPECT_EQ(2, Pop()->SequenceNumber());
+  EXPECT_TRUE(queue_.Empty());
+  EXPECT_EQ(DataSize::Zero(), queue_.Size());
+}
+
+TEST_F(RoundRobinPacketQueueTest, HigherPriorityPacketReschedulesStream) {
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 1);
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 2, 1);
+  // Stream 2 now has an audio packet, and should be sent from first.
+  Push(kAudioPriority, RtpPacketToSend::Type::kAudio, 2, 2);
+
+  std::unique_ptr<RtpPacketToSend> packet = Pop();
+  EXPECT_EQ(2u, packet->Ssrc());
+  EXPECT_EQ(2, packet->SequenceNumber());
+  EXPECT_EQ(1u, Pop()->Ssrc());
+  EXPECT_EQ(2u, Pop()->Ssrc());
+  EXPECT_TRUE(queue_.Empty());
+}
+
+TEST_F(RoundRobinPacketQueueTest, AlternatesBetweenStreamsOfEqualPriority) {
+  for (uint16_t i = 0; i < 3; ++i) {
+    Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, i);
+    Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 2, i);
+  }
+  std::vector<uint32_t> ssrcs;
+  while (!queue_.Empty()) {
+    ssrcs.push_back(Pop()->Ssrc());
+  }
+  EXPECT_EQ(std::vector<uint32_t>({1, 2, 1, 2, 1, 2}), ssrcs);
+}
+
+TEST_F(RoundRobinPacketQueueTest, CancelPopRestoresPacket) {
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 1);
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 2);
+
+  RoundRobinPacketQueue::QueuedPacket* queued_packet = queue_.BeginPop();
+  EXPECT_EQ(1, queued_packet->sequence_number());
+  queue_.CancelPop();
+  EXPECT_EQ(2u, queue_.SizeInPackets());
+
+  EXPECT_EQ(1, Pop()->SequenceNumber());
+  EXPECT_EQ(2, Pop()->SequenceNumber());
+}
+
+TEST_F(RoundRobinPacketQueueTest, OldestEnqueueTimeAfterOutOfOrderPops) {
+  const Timestamp first_time = now_;
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 1);
+  now_ += TimeDelta::ms(10);
+  const Timestamp second_time = now_;
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 2, 1);
+  now_ += TimeDelta::ms(10);
+  Push(kAudioPriority, RtpPacketToSend::Type::kAudio, 3, 1);
+  EXPECT_EQ(first_time, queue_.OldestEnqueueTime());
+
+  // The audio packet is sent first, oldest enqueue time is unchanged.
+  queue_.UpdateQueueTime(now_);
+  EXPECT_EQ(3u, Pop()->Ssrc());
+  EXPECT_EQ(first_time, queue_.OldestEnqueueTime());
+  EXPECT_EQ(1u, Pop()->Ssrc());
+  EXPECT_EQ(second_time, queue_.OldestEnqueueTime());
+  EXPECT_EQ(2u, Pop()->Ssrc());
+  EXPECT_EQ(Timestamp::MinusInfinity(), queue_.OldestEnqueueTime());
+}
+
+TEST_F(RoundRobinPacketQueueTest, AverageQueueTime) {
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 1);
+  now_ += TimeDelta::ms(10);
+  Push(kVideoPriority, RtpPacketToSend::Type::kVideo, 1, 2);
+  now_ += TimeDelta::ms(10);
+  queue_.UpdateQueueTime(now_);
+  // Packets have been queued for 20 ms and 10 ms.
+  EXPECT_EQ(TimeDelta::ms(15), queue_.AverageQueueTime());
+
+  // Time spent paused is not counted.
+  queue_.SetPauseState(true, now_);
+  now_ += TimeDelta::ms(100);
+  queue_.SetPauseState(false, now_);
+  EXPECT_EQ(TimeDelta::ms(15), queue_.AverageQueueTime());
+
+  Pop();
+  EXPECT_EQ(TimeDelta::ms(10), queue_.AverageQueueTime());
+  Pop();
+  EXPECT_EQ(TimeDelta::Zero(), queue_.AverageQueueTime());
+}
+
+// Interleaves pushes and pops across many streams, with the enqueue time ring
+// wrapping and growing while packets are popped out of order.
+TEST_F(RoundRobinPacketQueueTest, ManyStreams) {
+  constexpr uint32_t kNumStreams = 300;
+  constexpr int kPacketsPerStream = 20;
+  std::map<uint32_t, uint16_t> next_sequence_number;
+  std::map<uint32_t, uint16_t> expected_sequence_number;
+  size_t num_popped = 0;
+  // All packets of a stream have the same priority, so each stream's packets
+  // come out in order.
+  auto pop_and_verify = [&]() {
+    std::unique_ptr<RtpPacketToSend> packet = Pop();
+    EXPECT_EQ(expected_sequence_number[packet->Ssrc()]++,
+              packet->SequenceNumber());
+    ++num_popped;
+  };
+  for (int i = 0; i < kPacketsPerStream; ++i) {
+    for (uint32_t ssrc = kNumStreams; ssrc > 0; --ssrc) {
+      RtpPacketToSend::Type type = ssrc % 7 == 0
+                                       ? RtpPacketToSend::Type::kAudio
+                                       : RtpPacketToSend::Type::kVideo;
+      Push(type == RtpPacketToSend::Type::kAudio ? kAudioPriority
+                                                 : kVideoPriority,
+           type, ssrc, next_sequence_number[ssrc]++);
+      now_ += TimeDelta::us(100);
+    }
+    queue_.UpdateQueueTime(now_);
+    for (uint32_t j = 0; j < kNumStreams / 2; ++j) {
+      ASSERT_FALSE(queue_.Empty());
+      ASSERT_LE(queue_.OldestEnqueueTime(), now_);
+      pop_and_verify();
+    }
+  }
+  EXPECT_EQ(kNumStreams * kPacketsPerStream - num_popped,
+            queue_.SizeInPackets());
+
+  while (!queue_.Empty()) {
+    pop_and_verify();
+  }
+  EXPECT_EQ(kNumStreams * kPacketsPerStream, num_popped);
+  EXPECT_EQ(DataSize::Zero(), queue_.Size());
+}
+
+}  // namespace webrtc
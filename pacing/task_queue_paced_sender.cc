@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/task_queue_paced_sender.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+// Process interval used when there is no media to pace, so that padding and
+// keep-alive packets are handled at the same rate as with PacedSender.
+constexpr TimeDelta kIdleProcessInterval = TimeDelta::Millis<5>();
+}  // namespace
+
+TaskQueuePacedSender::TaskQueuePacedSender(
+    Clock* clock,
+    PacketRouter* packet_router,
+    RtcEventLog* event_log,
+    const WebRtcKeyValueConfig* field_trials,
+    TaskQueueFactory* task_queue_factory)
+    : clock_(clock),
+      packet_router_(packet_router),
+      pacing_controller_(clock,
+                         static_cast<PacingController::PacketSender*>(this),
+                         event_log,
+                         field_trials,
+                         PacingController::ProcessMode::kDynamic),
+      next_process_time_(Timestamp::PlusInfinity()),
+      task_queue_(task_queue_factory->CreateTaskQueue(
+          "TaskQueuePacedSender",
+          TaskQueueFactory::Priority::NORMAL)) {
+  rtc::CritScope cs(&critsect_);
+  MaybeScheduleProcess();
+}
+
+TaskQueuePacedSender::~TaskQueuePacedSender() = default;
+
+void TaskQueuePacedSender::EnqueuePackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets) {
+  rtc::CritScope cs(&critsect_);
+  for (auto& packet : packets) {
+    pacing_controller_.EnqueuePacket(std::move(packet));
+  }
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::CreateProbeCluster(DataRate bitrate,
+                                              int cluster_id) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.CreateProbeCluster(bitrate, cluster_id);
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::Pause() {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.Pause();
+}
+
+void TaskQueuePacedSender::Resume() {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.Resume();
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::SetCongestionWindow(
+    DataSize congestion_window_size) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.SetCongestionWindow(congestion_window_size);
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::UpdateOutstandingData(DataSize outstanding_data) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.UpdateOutstandingData(outstanding_data);
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::SetPacingRates(DataRate pacing_rate,
+                                          DataRate padding_rate) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::SetAccountForAudioPackets(bool account_for_audio) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.SetAccountForAudioPackets(account_for_audio);
+}
+
+TimeDelta TaskQueuePacedSender::OldestPacketWaitTime() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.OldestPacketWaitTime();
+}
+
+DataSize TaskQueuePacedSender::QueueSizeData() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.QueueSizeData();
+}
+
+BufferMemoryUsage TaskQueuePacedSender::QueueMemoryUsage() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.QueueMemoryUsage();
+}
+
+BufferMemoryUsage TaskQueuePacedSender::QueueMemoryUsage(uint32_t ssrc) const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.QueueMemoryUsage(ssrc);
+}
+
+absl::optional<Timestamp> TaskQueuePacedSender::FirstSentPacketTime() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.FirstSentPacketTime();
+}
+
+TimeDelta TaskQueuePacedSender::ExpectedQueueTime() const {
+  rtc::CritScope cs(&critsect_);
+  return pacing_controller_.ExpectedQueueTime();
+}
+
+void TaskQueuePacedSender::SetQueueTimeLimit(TimeDelta limit) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.SetQueueTimeLimit(limit);
+}
+
+TimeDelta TaskQueuePacedSender::TimeUntilNextProcess() {
+  const TimeDelta elapsed_time =
+      pacing_controller_.TimeElapsedSinceLastProcess();
+  if (pacing_controller_.IsPaused()) {
+    return std::max(PacingController::kPausedProcessInterval - elapsed_time,
+                    TimeDelta::Zero());
+  }
+
+  auto next_probe = pacing_controller_.TimeUntilNextProbe();
+  if (next_probe) {
+    return *next_probe;
+  }
+
+  const TimeDelta idle_time_left =
+      std::max(kIdleProcessInterval - elapsed_time, TimeDelta::Zero());
+  if (pacing_controller_.QueueSizePackets() == 0 ||
+      pacing_controller_.Congested()) {
+    return idle_time_left;
+  }
+  return std::min(idle_time_left,
+                  pacing_controller_.TimeUntilAvailableBudget());
+}
+
+void TaskQueuePacedSender::MaybeScheduleProcess() {
+  const Timestamp now = clock_->CurrentTime();
+  const Timestamp process_time = now + TimeUntilNextProcess();
+  if (next_process_time_.IsFinite() && next_process_time_ <= process_time) {
+    return;
+  }
+  next_process_time_ = process_time;
+
+  // Delayed tasks have millisecond resolution; round up so that the task
+  // never runs before the budget is available.
+  const int64_t delay_us = (process_time - now).us();
+  const uint32_t delay_ms = static_cast<uint32_t>((delay_us + 999) / 1000);
+  task_queue_.PostDelayedTask(
+      [this, process_time] { OnProcessTask(process_time); }, delay_ms);
+}
+
+void TaskQueuePacedSender::OnProcessTask(Timestamp scheduled_process_time) {
+  RTC_DCHECK_RUN_ON(&task_queue_);
+  rtc::CritScope cs(&critsect_);
+  if (scheduled_process_time != next_process_time_) {
+    return;
+  }
+  next_process_time_ = Timestamp::PlusInfinity();
+  pacing_controller_.ProcessPackets();
+  MaybeScheduleProcess();
+}
+
+void TaskQueuePacedSender::SendRtpPacket(
+    std::unique_ptr<RtpPacketToSend> packet,
+    const PacedPacketInfo& cluster_info) {
+  critsect_.Leave();
+  packet_router_->SendPacket(std::move(packet), cluster_info);
+  critsect_.Enter();
+}
+
+void TaskQueuePacedSender::SendRtpPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    const PacedPacketInfo& cluster_info) {
+  critsect_.Leave();
+  packet_router_->SendPackets(std::move(packets), cluster_info);
+  critsect_.Enter();
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+TaskQueuePacedSender::GeneratePadding(DataSize size) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
+  critsect_.Leave();
+  padding_packets = packet_router_->GeneratePadding(size.bytes());
+  critsect_.Enter();
+  return padding_packets;
+}
+}  // namespace webrtc
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_TASK_QUEUE_PACED_SENDER_H_
+#define MODULES_PACING_TASK_QUEUE_PACED_SENDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/pacing_controller.h"
+#include "modules/pacing/packet_router.h"
+#include "modules/pacing/rtp_packet_pacer.h"
+#include "modules/rtp_rtcp/include/rtp_packet_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+class Clock;
+class RtcEventLog;
+
+// Alternative to PacedSender that runs PacingController on a dedicated task
+// queue instead of a ProcessThread. Rather than polling every 5ms, the next
+// process call is scheduled for when the controller next has budget or a probe
+// to send, which gives shorter packet trains and lower queuing delay at high
+// rates.
+class TaskQueuePacedSender : public RtpPacketPacer,
+                             public RtpPacketSender,
+                             private PacingController::PacketSender {
+ public:
+  TaskQueuePacedSender(Clock* clock,
+                       PacketRouter* packet_router,
+                       RtcEventLog* event_log,
+                       const WebRtcKeyValueConfig* field_trials,
+                       TaskQueueFactory* task_queue_factory);
+
+  ~TaskQueuePacedSender() override;
+
+  // Methods implementing RtpPacketSender.
+
+  // Adds the packet to the queue and calls PacketRouter::SendPacket() when
+  // it's time to send.
+  void EnqueuePackets(
+      std::vector<std::unique_ptr<RtpPacketToSend>> packets) override;
+
+  // Methods implementing RtpPacketPacer:
+
+  void CreateProbeCluster(DataRate bitrate, int cluster_id) override;
+
+  // Temporarily pause all sending.
+  void Pause() override;
+
+  // Resume sending packets.
+  void Resume() override;
+
+  void SetCongestionWindow(DataSize congestion_window_size) override;
+  void UpdateOutstandingData(DataSize outstanding_data) override;
+
+  // Sets the pacing rates. Must be called once before packets can be sent.
+  void SetPacingRates(DataRate pacing_rate, DataRate padding_rate) override;
+
+  // Currently audio traffic is not accounted by pacer and passed through.
+  // With the introduction of audio BWE audio traffic will be accounted for
+  // the pacer budget calculation. The audio traffic still will be injected
+  // at high priority.
+  void SetAccountForAudioPackets(bool account_for_audio) override;
+
+  // Returns the time since the oldest queued packet was enqueued.
+  TimeDelta OldestPacketWaitTime() const override;
+
+  DataSize QueueSizeData() const override;
+
+  // Returns the bytes and packets queued, in total or for the stream |ssrc|.
+  BufferMemoryUsage QueueMemoryUsage() const;
+  BufferMemoryUsage QueueMemoryUsage(uint32_t ssrc) const;
+
+  // Returns the time when the first packet was sent;
+  absl::optional<Timestamp> FirstSentPacketTime() const override;
+
+  // Returns the number of milliseconds it will take to send the current
+  // packets in the queue, given the current size and bitrate, ignoring prio.
+  TimeDelta ExpectedQueueTime() const override;
+
+  void SetQueueTimeLimit(TimeDelta limit) override;
+
+ private:
+  // Methods implementing PacingController::PacketSender.
+
+  void SendRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
+                     const PacedPacketInfo& cluster_info) override
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
+  void SendRtpPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                      const PacedPacketInfo& cluster_info) override
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
+      DataSize size) override RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
+  // Returns the time until ProcessPackets() should be called next.
+  TimeDelta TimeUntilNextProcess() RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
+  // Posts a process task, unless one is already scheduled to run no later
+  // than it would.
+  void MaybeScheduleProcess() RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
+  // Runs on |task_queue_|. Tasks that have been superseded by an earlier
+  // scheduled one are ignored.
+  void OnProcessTask(Timestamp scheduled_process_time);
+
+  Clock* const clock_;
+  PacketRouter* const packet_router_;
+
+  rtc::CriticalSection critsect_;
+  PacingController pacing_controller_ RTC_GUARDED_BY(critsect_);
+
+  // Target time of the earliest pending process task, or PlusInfinity if no
+  // task is pending.
+  Timestamp next_process_time_ RTC_GUARDED_BY(critsect_);
+
+  // Declared last so that it is destroyed first, while the members used by
+  // pending tasks are still valid.
+  rtc::TaskQueue task_queue_;
+};
+}  // namespace webrtc
+#endif  // MODULES_PACING_TASK_QUEUE_PACED_SENDER_H_
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/task_queue_paced_sender.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "modules/pacing/packet_router.h"
+#include "rtc_base/event.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+constexpr uint32_t kAudioSsrc = 12345;
+constexpr uint32_t kVideoSsrc = 234565;
+constexpr uint32_t kVideoRtxSsrc = 34567;
+constexpr uint32_t kFlexFecSsrc = 45678;
+constexpr size_t kDefaultPacketSize = 1234;
+
+class MockPacketRouter : public PacketRouter {
+ public:
+  MOCK_METHOD2(SendPacket,
+               void(std::unique_ptr<RtpPacketToSend> packet,
+                    const PacedPacketInfo& cluster_info));
+  MOCK_METHOD1(
+      GeneratePadding,
+      std::vector<std::unique_ptr<RtpPacketToSend>>(size_t target_size_bytes));
+};
+
+std::unique_ptr<RtpPacketToSend> BuildRtpPacket(RtpPacketToSend::Type type) {
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->set_packet_type(type);
+  switch (type) {
+    case RtpPacketToSend::Type::kAudio:
+      packet->SetSsrc(kAudioSsrc);
+      break;
+    case RtpPacketToSend::Type::kVideo:
+      packet->SetSsrc(kVideoSsrc);
+      break;
+    case RtpPacketToSend::Type::kRetransmission:
+    case RtpPacketToSend::Type::kPadding:
+      packet->SetSsrc(kVideoRtxSsrc);
+      break;
+    case RtpPacketToSend::Type::kForwardErrorCorrection:
+      packet->SetSsrc(kFlexFecSsrc);
+      break;
+  }
+
+  packet->SetPayloadSize(kDefaultPacketSize);
+  return packet;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePackets(
+    RtpPacketToSend::Type type,
+    size_t num_packets) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  for (size_t i = 0; i < num_packets; ++i) {
+    packets.push_back(BuildRtpPacket(type));
+  }
+  return packets;
+}
+}  // namespace
+
+TEST(TaskQueuePacedSenderTest, PacesPacketsOverTime) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  Clock* clock = Clock::GetRealTimeClock();
+  MockPacketRouter packet_router;
+  TaskQueuePacedSender pacer(clock, &packet_router, nullptr, nullptr,
+                             task_queue_factory.get());
+
+  // Insert a number of packets, covering a quarter of a second.
+  static constexpr size_t kPacketsToSend = 50;
+  pacer.SetPacingRates(
+      DataRate::bps(kDefaultPacketSize * 8 * kPacketsToSend * 4),
+      DataRate::Zero());
+
+  std::atomic<size_t> packets_sent(0);
+  rtc::Event all_sent;
+  EXPECT_CALL(packet_router, SendPacket)
+      .WillRepeatedly([&](std::unique_ptr<RtpPacketToSend> packet,
+                          const PacedPacketInfo& cluster_info) {
+        if (++packets_sent == kPacketsToSend) {
+          all_sent.Set();
+        }
+      });
+
+  const Timestamp start_time = clock->CurrentTime();
+  pacer.EnqueuePackets(
+      GeneratePackets(RtpPacketToSend::Type::kVideo, kPacketsToSend));
+  ASSERT_TRUE(all_sent.Wait(5000));
+
+  // Packets should be sent over a period of close to 250ms. Expect a little
+  // lower than this since initial probing is a bit quicker.
+  EXPECT_GT(clock->CurrentTime() - start_time, TimeDelta::ms(200));
+}
+
+TEST(TaskQueuePacedSenderTest, SendsQueuedPacketsAfterResume) {
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  MockPacketRouter packet_router;
+  TaskQueuePacedSender pacer(Clock::GetRealTimeClock(), &packet_router,
+                             nullptr, nullptr, task_queue_factory.get());
+  pacer.SetPacingRates(DataRate::kbps(10000), DataRate::Zero());
+
+  rtc::Event packet_sent;
+  EXPECT_CALL(packet_router, SendPacket).Times(0);
+  pacer.Pause();
+  pacer.EnqueuePackets(GeneratePackets(RtpPacketToSend::Type::kVideo, 1));
+  EXPECT_FALSE(packet_sent.Wait(50));
+
+  ::testing::Mock::VerifyAndClearExpectations(&packet_router);
+  EXPECT_CALL(packet_router, SendPacket)
+      .WillOnce([&](std::unique_ptr<RtpPacketToSend> packet,
+                    const PacedPacketInfo& cluster_info) {
+        packet_sent.Set();
+      });
+  pacer.Resume();
+  EXPECT_TRUE(packet_sent.Wait(1000));
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+constexpr int64_t PacketArrivalTimeMap::kNotReceived;
+constexpr size_t PacketArrivalTimeMap::kMinCapacity;
+
+PacketArrivalTimeMap::PacketArrivalTimeMap()
+    : begin_sequence_number_(0), end_sequence_number_(0) {}
+
+PacketArrivalTimeMap::~PacketArrivalTimeMap() = default;
+
+bool PacketArrivalTimeMap::has_received(int64_t sequence_number) const {
+  return sequence_number >= begin_sequence_number_ &&
+         sequence_number < end_sequence_number_ &&
+         slot(sequence_number) != kNotReceived;
+}
+
+int64_t PacketArrivalTimeMap::get(int64_t sequence_number) const {
+  RTC_DCHECK(has_received(sequence_number));
+  return slot(sequence_number);
+}
+
+int64_t PacketArrivalTimeMap::LowerBound(int64_t sequence_number) const {
+  sequence_number = std::max(sequence_number, begin_sequence_number_);
+  while (sequence_number < end_sequence_number_ &&
+         slot(sequence_number) == kNotReceived) {
+    ++sequence_number;
+  }
+  return std::min(sequence_number, end_sequence_number_);
+}
+
+void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
+                                     int64_t arrival_time_ms) {
+  RTC_DCHECK_GE(arrival_time_ms, 0);
+  RTC_DCHECK(!has_received(sequence_number));
+  if (empty()) {
+    Reserve(1);
+    begin_sequence_number_ = sequence_number;
+    end_sequence_number_ = sequence_number + 1;
+  } else if (sequence_number < begin_sequence_number_) {
+    Reserve(end_sequence_number_ - sequence_number);
+    for (int64_t seq = sequence_number + 1; seq < begin_sequence_number_;
+         ++seq) {
+      slot(seq) = kNotReceived;
+    }
+    begin_sequence_number_ = sequence_number;
+  } else if (sequence_number >= end_sequence_number_) {
+    Reserve(sequence_number + 1 - begin_sequence_number_);
+    for (int64_t seq = end_sequence_number_; seq < sequence_number; ++seq) {
+      slot(seq) = kNotReceived;
+    }
+    end_sequence_number_ = sequence_number + 1;
+  }
+  slot(sequence_number) = arrival_time_ms;
+}
+
+void PacketArrivalTimeMap::EraseTo(int64_t sequence_number) {
+  if (sequence_number >= end_sequence_number_) {
+    begin_sequence_number_ = end_sequence_number_;
+    return;
+  }
+  if (sequence_number > begin_sequence_number_) {
+    begin_sequence_number_ = sequence_number;
+    TrimHoles();
+  }
+}
+
+void PacketArrivalTimeMap::RemoveOldPackets(int64_t sequence_number,
+                                            int64_t arrival_time_limit_ms) {
+  while (!empty() && begin_sequence_number_ < sequence_number &&
+         slot(begin_sequence_number_) <= arrival_time_limit_ms) {
+    ++begin_sequence_number_;
+    TrimHoles();
+  }
+}
+
+int64_t& PacketArrivalTimeMap::slot(int64_t sequence_number) {
+  // The size is a power of two, so masking the two's complement
+  // representation gives a valid index for negative sequence numbers too.
+  return arrival_times_ms_[static_cast<uint64_t>(sequence_number) &
+                           (arrival_times_ms_.size() - 1)];
+}
+
+int64_t PacketArrivalTimeMap::slot(int64_t sequence_number) const {
+  return arrival_times_ms_[static_cast<uint64_t>(sequence_number) &
+                           (arrival_times_ms_.size() - 1)];
+}
+
+void PacketArrivalTimeMap::Reserve(size_t size) {
+  if (size <= arrival_times_ms_.size())
+    return;
+  size_t capacity = std::max(arrival_times_ms_.size(), kMinCapacity);
+  while (capacity < size)
+    capacity *= 2;
+  std::vector<int64_t> arrival_times_ms(capacity, kNotReceived);
+  const uint64_t mask = capacity - 1;
+  for (int64_t seq = begin_sequence_number_; seq < end_sequence_number_;
+       ++seq) {
+    arrival_times_ms[static_cast<uint64_t>(seq) & mask] = slot(seq);
+  }
+  arrival_times_ms_.swap(arrival_times_ms);
+}
+
+void PacketArrivalTimeMap::TrimHoles() {
+  while (begin_sequence_number_ < end_sequence_number_ &&
+         slot(begin_sequence_number_) == kNotReceived) {
+    ++begin_sequence_number_;
+  }
+}
+
+}  // namespace webrtc
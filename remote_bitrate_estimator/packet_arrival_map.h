@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// PacketArrivalTimeMap is an optimized map of packet sequence number to
+// arrival time. The arrival times are stored in a ring buffer indexed by the
+// unwrapped sequence number, covering the range from the oldest to the newest
+// packet. Sequence numbers in that range which have not been received are
+// stored as holes. The buffer only grows, so adding packets does not allocate
+// once it has reached the size needed for the traffic.
+//
+// The first and the last sequence number in the range are always received
+// packets.
+class PacketArrivalTimeMap {
+ public:
+  PacketArrivalTimeMap();
+  ~PacketArrivalTimeMap();
+
+  bool empty() const { return begin_sequence_number_ == end_sequence_number_; }
+
+  // Returns the sequence number of the oldest packet, which is received.
+  int64_t begin_sequence_number() const { return begin_sequence_number_; }
+
+  // Returns the sequence number after the newest packet.
+  int64_t end_sequence_number() const { return end_sequence_number_; }
+
+  // Returns true if |sequence_number| has been received and is in the map.
+  bool has_received(int64_t sequence_number) const;
+
+  // Returns the arrival time of |sequence_number|, which must have been
+  // received.
+  int64_t get(int64_t sequence_number) const;
+
+  // Returns the smallest received sequence number which is not less than
+  // |sequence_number|, or end_sequence_number() if there is none.
+  int64_t LowerBound(int64_t sequence_number) const;
+
+  // Records the arrival time of a packet which has not been received before.
+  void AddPacket(int64_t sequence_number, int64_t arrival_time_ms);
+
+  // Removes all packets with a sequence number less than |sequence_number|.
+  void EraseTo(int64_t sequence_number);
+
+  // Removes packets, oldest first, with a sequence number less than
+  // |sequence_number| and an arrival time not later than
+  // |arrival_time_limit_ms|. Stops at the first packet that is kept.
+  void RemoveOldPackets(int64_t sequence_number,
+                        int64_t arrival_time_limit_ms);
+
+ private:
+  static constexpr int64_t kNotReceived = -1;
+  static constexpr size_t kMinCapacity = 128;
+
+  int64_t& slot(int64_t sequence_number);
+  int64_t slot(int64_t sequence_number) const;
+
+  // Makes the buffer large enough to hold |size| sequence numbers.
+  void Reserve(size_t size);
+
+  // Advances |begin_sequence_number_| past packets which have not been
+  // received, so that the oldest packet is always a received one.
+  void TrimHoles();
+
+  // Ring buffer with a power of two size, indexed by the sequence number.
+  std::vector<int64_t> arrival_times_ms_;
+  int64_t begin_sequence_number_;
+  int64_t end_sequence_number_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(PacketArrivalMapTest, IsConsistentWhenEmpty) {
+  PacketArrivalTimeMap map;
+
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin_sequence_number(), map.end_sequence_number());
+  EXPECT_FALSE(map.has_received(0));
+}
+
+TEST(PacketArrivalMapTest, InsertsFirstItemIntoMap) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(42, 10);
+  EXPECT_FALSE(map.empty());
+  EXPECT_EQ(map.begin_sequence_number(), 42);
+  EXPECT_EQ(map.end_sequence_number(), 43);
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_TRUE(map.has_received(42));
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_EQ(map.get(42), 10);
+}
+
+TEST(PacketArrivalMapTest, InsertsWithGaps) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(42, 10);
+  map.AddPacket(45, 11);
+  EXPECT_EQ(map.begin_sequence_number(), 42);
+  EXPECT_EQ(map.end_sequence_number(), 46);
+  EXPECT_TRUE(map.has_received(42));
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_FALSE(map.has_received(44));
+  EXPECT_TRUE(map.has_received(45));
+  EXPECT_EQ(map.get(45), 11);
+  EXPECT_EQ(map.LowerBound(43), 45);
+  EXPECT_EQ(map.LowerBound(46), 46);
+}
+
+TEST(PacketArrivalMapTest, InsertsReorderedPacketsBeforeBegin) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(42, 10);
+  map.AddPacket(40, 12);
+  EXPECT_EQ(map.begin_sequence_number(), 40);
+  EXPECT_EQ(map.end_sequence_number(), 43);
+  EXPECT_TRUE(map.has_received(40));
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_EQ(map.get(40), 12);
+  EXPECT_EQ(map.get(42), 10);
+}
+
+TEST(PacketArrivalMapTest, HandlesNegativeSequenceNumbers) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(-2, 10);
+  map.AddPacket(1, 11);
+  EXPECT_TRUE(map.has_received(-2));
+  EXPECT_FALSE(map.has_received(0));
+  EXPECT_EQ(map.get(-2), 10);
+  EXPECT_EQ(map.get(1), 11);
+}
+
+TEST(PacketArrivalMapTest, KeepsArrivalTimesWhenGrowing) {
+  PacketArrivalTimeMap map;
+
+  for (int64_t seq = 1000; seq < 3000; seq += 3)
+    map.AddPacket(seq, seq * 2);
+  for (int64_t seq = 1000; seq < 3000; ++seq) {
+    ASSERT_EQ(map.has_received(seq), seq % 3 == 1000 % 3);
+    if (map.has_received(seq))
+      EXPECT_EQ(map.get(seq), seq * 2);
+  }
+}
+
+TEST(PacketArrivalMapTest, EraseToSkipsHoles) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(42, 10);
+  map.AddPacket(43, 11);
+  map.AddPacket(46, 12);
+  map.EraseTo(44);
+  EXPECT_EQ(map.begin_sequence_number(), 46);
+  EXPECT_EQ(map.end_sequence_number(), 47);
+  EXPECT_FALSE(map.has_received(43));
+
+  map.EraseTo(47);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PacketArrivalMapTest, RemovesOldPacketsUntilFirstNewPacket) {
+  PacketArrivalTimeMap map;
+
+  map.AddPacket(42, 10);
+  map.AddPacket(43, 20);
+  map.AddPacket(45, 11);
+  map.AddPacket(46, 30);
+
+  map.RemoveOldPackets(46, 15);
+  EXPECT_EQ(map.begin_sequence_number(), 43);
+
+  map.RemoveOldPackets(46, 25);
+  EXPECT_EQ(map.begin_sequence_number(), 46);
+
+  // The sequence number limit is exclusive.
+  map.RemoveOldPackets(46, 35);
+  EXPECT_EQ(map.begin_sequence_number(), 46);
+  EXPECT_TRUE(map.has_received(46));
+}
+
+}  // namespace
+}  // namespace webrtc
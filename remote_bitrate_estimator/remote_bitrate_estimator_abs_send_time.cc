@@ -115,7 +115,7 @@ void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
   Cluster current;
   int64_t prev_send_time = -1;
   int64_t prev_recv_time = -1;
-  for (std::list<Probe>::const_iterator it = probes_.begin();
+  for (std::deque<Probe>::const_iterator it = probes_.begin();
        it != probes_.end(); ++it) {
     if (prev_send_time >= 0) {
       int send_delta_ms = it->send_time_ms - prev_send_time;
@@ -234,30 +234,59 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacket(
            "is missing absolute send time extension!";
     return;
   }
-  IncomingPacketInfo(arrival_time_ms, header.extension.absoluteSendTime,
-                     payload_size, header.ssrc);
+  const PacketInfo packet = {arrival_time_ms, payload_size, header.ssrc,
+                             header.extension.absoluteSendTime};
+  IncomingPackets(rtc::ArrayView<const PacketInfo>(&packet, 1));
 }
 
-void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
-    int64_t arrival_time_ms,
-    uint32_t send_time_24bits,
-    size_t payload_size,
-    uint32_t ssrc) {
-  RTC_CHECK(send_time_24bits < (1ul << 24));
+void RemoteBitrateEstimatorAbsSendTime::IncomingPackets(
+    rtc::ArrayView<const PacketInfo> packets) {
+  RTC_DCHECK_RUNS_SERIALIZED(&network_race_);
+  if (packets.empty())
+    return;
   if (!uma_recorded_) {
     RTC_HISTOGRAM_ENUMERATION(kBweTypeHistogram, BweNames::kReceiverAbsSendTime,
                               BweNames::kBweNamesMax);
     uma_recorded_ = true;
   }
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (first_packet_time_ms_ == -1)
+    first_packet_time_ms_ = now_ms;
+
+  bool update_estimate = false;
+  uint32_t target_bitrate_bps = 0;
+  std::vector<uint32_t> ssrcs;
+  {
+    rtc::CritScope lock(&crit_);
+    // All packets are received at |now_ms|, so timing out the streams once
+    // for the batch is enough.
+    TimeoutStreams(now_ms);
+    for (const PacketInfo& packet : packets) {
+      if (ProcessIncomingPacket(now_ms, packet, &target_bitrate_bps))
+        update_estimate = true;
+    }
+    // TODO(holmer): SSRCs are only needed for REMB, should be broken out from
+    // here.
+    if (update_estimate)
+      ssrcs = Keys(ssrcs_);
+  }
+  if (update_estimate)
+    observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate_bps);
+}
+
+bool RemoteBitrateEstimatorAbsSendTime::ProcessIncomingPacket(
+    int64_t now_ms,
+    const PacketInfo& packet,
+    uint32_t* target_bitrate_bps) {
+  const int64_t arrival_time_ms = packet.arrival_time_ms;
+  const size_t payload_size = packet.payload_size;
+  RTC_CHECK(packet.send_time_24bits < (1ul << 24));
   // Shift up send time to use the full 32 bits that inter_arrival works with,
   // so wrapping works properly.
-  uint32_t timestamp = send_time_24bits << kAbsSendTimeInterArrivalUpshift;
+  uint32_t timestamp = packet.send_time_24bits
+                       << kAbsSendTimeInterArrivalUpshift;
   int64_t send_time_ms = static_cast<int64_t>(timestamp) * kTimestampToMs;
 
-  int64_t now_ms = clock_->TimeInMilliseconds();
-  // TODO(holmer): SSRCs are only needed for REMB, should be broken out from
-  // here.
-
   // Check if incoming bitrate estimate is valid, and if it needs to be reset.
   absl::optional<uint32_t> incoming_bitrate =
       incoming_bitrate_.Rate(arrival_time_ms);
@@ -272,94 +301,84 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
   }
   incoming_bitrate_.Update(payload_size, arrival_time_ms);
 
-  if (first_packet_time_ms_ == -1)
-    first_packet_time_ms_ = now_ms;
-
   uint32_t ts_delta = 0;
   int64_t t_delta = 0;
   int size_delta = 0;
   bool update_estimate = false;
-  uint32_t target_bitrate_bps = 0;
-  std::vector<uint32_t> ssrcs;
-  {
-    rtc::CritScope lock(&crit_);
 
-    TimeoutStreams(now_ms);
-    RTC_DCHECK(inter_arrival_.get());
-    RTC_DCHECK(estimator_.get());
-    ssrcs_[ssrc] = now_ms;
-
-    // For now only try to detect probes while we don't have a valid estimate.
-    // We currently assume that only packets larger than 200 bytes are paced by
-    // the sender.
-    const size_t kMinProbePacketSize = 200;
-    if (payload_size > kMinProbePacketSize &&
-        (!remote_rate_.ValidEstimate() ||
-         now_ms - first_packet_time_ms_ < kInitialProbingIntervalMs)) {
-      // TODO(holmer): Use a map instead to get correct order?
-      if (total_probes_received_ < kMaxProbePackets) {
-        int send_delta_ms = -1;
-        int recv_delta_ms = -1;
-        if (!probes_.empty()) {
-          send_delta_ms = send_time_ms - probes_.back().send_time_ms;
-          recv_delta_ms = arrival_time_ms - probes_.back().recv_time_ms;
-        }
-        RTC_LOG(LS_INFO) << "Probe packet received: send time=" << send_time_ms
-                         << " ms, recv time=" << arrival_time_ms
-                         << " ms, send delta=" << send_delta_ms
-                         << " ms, recv delta=" << recv_delta_ms << " ms.";
+  RTC_DCHECK(inter_arrival_.get());
+  RTC_DCHECK(estimator_.get());
+  ssrcs_[packet.ssrc] = now_ms;
+
+  // For now only try to detect probes while we don't have a valid estimate.
+  // We currently assume that only packets larger than 200 bytes are paced by
+  // the sender.
+  const size_t kMinProbePacketSize = 200;
+  if (payload_size > kMinProbePacketSize &&
+      (!remote_rate_.ValidEstimate() ||
+       now_ms - first_packet_time_ms_ < kInitialProbingIntervalMs)) {
+    // TODO(holmer): Use a map instead to get correct order?
+    if (total_probes_received_ < kMaxProbePackets) {
+      int send_delta_ms = -1;
+      int recv_delta_ms = -1;
+      if (!probes_.empty()) {
+        send_delta_ms = send_time_ms - probes_.back().send_time_ms;
+        recv_delta_ms = arrival_time_ms - probes_.back().recv_time_ms;
       }
-      probes_.push_back(Probe(send_time_ms, arrival_time_ms, payload_size));
-      ++total_probes_received_;
-      // Make sure that a probe which updated the bitrate immediately has an
-      // effect by calling the OnReceiveBitrateChanged callback.
-      if (ProcessClusters(now_ms) == ProbeResult::kBitrateUpdated)
-        update_estimate = true;
-    }
-    if (inter_arrival_->ComputeDeltas(timestamp, arrival_time_ms, now_ms,
-                                      payload_size, &ts_delta, &t_delta,
-                                      &size_delta)) {
-      double ts_delta_ms = (1000.0 * ts_delta) / (1 << kInterArrivalShift);
-      estimator_->Update(t_delta, ts_delta_ms, size_delta, detector_.State(),
-                         arrival_time_ms);
-      detector_.Detect(estimator_->offset(), ts_delta_ms,
-                       estimator_->num_of_deltas(), arrival_time_ms);
+      RTC_LOG(LS_INFO) << "Probe packet received: send time=" << send_time_ms
+                       << " ms, recv time=" << arrival_time_ms
+                       << " ms, send delta=" << send_delta_ms
+                       << " ms, recv delta=" << recv_delta_ms << " ms.";
     }
+    probes_.emplace_back(send_time_ms, arrival_time_ms, payload_size);
+    ++total_probes_received_;
+    // Make sure that a probe which updated the bitrate immediately has an
+    // effect by calling the OnReceiveBitrateChanged callback.
+    if (ProcessClusters(now_ms) == ProbeResult::kBitrateUpdated)
+      update_estimate = true;
+  }
+  if (inter_arrival_->ComputeDeltas(timestamp, arrival_time_ms, now_ms,
+                                    payload_size, &ts_delta, &t_delta,
+                                    &size_delta)) {
+    double ts_delta_ms = (1000.0 * ts_delta) / (1 << kInterArrivalShift);
+    estimator_->Update(t_delta, ts_delta_ms, size_delta, detector_.State(),
+                       arrival_time_ms);
+    detector_.Detect(estimator_->offset(), ts_delta_ms,
+                     estimator_->num_of_deltas(), arrival_time_ms);
+  }
 
-    if (!update_estimate) {
-      // Check if it's time for a periodic update or if we should update because
-      // of an over-use.
-      if (last_update_ms_ == -1 ||
-          now_ms - last_update_ms_ > remote_rate_.GetFeedbackInterval().ms()) {
+  if (!update_estimate) {
+    // Check if it's time for a periodic update or if we should update because
+    // of an over-use.
+    if (last_update_ms_ == -1 ||
+        now_ms - last_update_ms_ > remote_rate_.GetFeedbackInterval().ms()) {
+      update_estimate = true;
+    } else if (detector_.State() == BandwidthUsage::kBwOverusing) {
+      absl::optional<uint32_t> incoming_rate =
+          incoming_bitrate_.Rate(arrival_time_ms);
+      if (incoming_rate &&
+          remote_rate_.TimeToReduceFurther(Timestamp::ms(now_ms),
+                                           DataRate::bps(*incoming_rate))) {
         update_estimate = true;
-      } else if (detector_.State() == BandwidthUsage::kBwOverusing) {
-        absl::optional<uint32_t> incoming_rate =
-            incoming_bitrate_.Rate(arrival_time_ms);
-        if (incoming_rate &&
-            remote_rate_.TimeToReduceFurther(Timestamp::ms(now_ms),
-                                             DataRate::bps(*incoming_rate))) {
-          update_estimate = true;
-        }
       }
     }
-
-    if (update_estimate) {
-      // The first overuse should immediately trigger a new estimate.
-      // We also have to update the estimate immediately if we are overusing
-      // and the target bitrate is too high compared to what we are receiving.
-      const RateControlInput input(
-          detector_.State(),
-          OptionalRateFromOptionalBps(incoming_bitrate_.Rate(arrival_time_ms)));
-      target_bitrate_bps =
-          remote_rate_.Update(&input, Timestamp::ms(now_ms)).bps<uint32_t>();
-      update_estimate = remote_rate_.ValidEstimate();
-      ssrcs = Keys(ssrcs_);
-    }
-  }
-  if (update_estimate) {
-    last_update_ms_ = now_ms;
-    observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate_bps);
   }
+
+  if (!update_estimate)
+    return false;
+  // The first overuse should immediately trigger a new estimate.
+  // We also have to update the estimate immediately if we are overusing
+  // and the target bitrate is too high compared to what we are receiving.
+  const RateControlInput input(
+      detector_.State(),
+      OptionalRateFromOptionalBps(incoming_bitrate_.Rate(arrival_time_ms)));
+  uint32_t target_bps =
+      remote_rate_.Update(&input, Timestamp::ms(now_ms)).bps<uint32_t>();
+  if (!remote_rate_.ValidEstimate())
+    return false;
+  last_update_ms_ = now_ms;
+  *target_bitrate_bps = target_bps;
+  return true;
 }
 
 void RemoteBitrateEstimatorAbsSendTime::Process() {}
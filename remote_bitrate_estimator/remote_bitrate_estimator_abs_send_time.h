@@ -14,11 +14,13 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/rtp_headers.h"
 #include "api/transport/field_trial_based_config.h"
 #include "modules/remote_bitrate_estimator/aimd_rate_control.h"
@@ -74,6 +76,14 @@ struct Cluster {
 
 class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
  public:
+  // A received packet carrying the absolute send time header extension.
+  struct PacketInfo {
+    int64_t arrival_time_ms;
+    size_t payload_size;
+    uint32_t ssrc;
+    uint32_t send_time_24bits;
+  };
+
   RemoteBitrateEstimatorAbsSendTime(RemoteBitrateObserver* observer,
                                     Clock* clock);
   ~RemoteBitrateEstimatorAbsSendTime() override;
@@ -81,6 +91,11 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  // Same as calling IncomingPacket() for each of |packets| in order, except
+  // that the lock is taken once and the observer is notified at most once,
+  // with the estimate after the last packet. All |packets| are considered
+  // received at the current time of the clock.
+  void IncomingPackets(rtc::ArrayView<const PacketInfo> packets);
   // This class relies on Process() being called periodically (at least once
   // every other second) for streams to be timed out properly. Therefore it
   // shouldn't be detached from the ProcessThread except if it's about to be
@@ -102,10 +117,12 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
 
   static void AddCluster(std::list<Cluster>* clusters, Cluster* cluster);
 
-  void IncomingPacketInfo(int64_t arrival_time_ms,
-                          uint32_t send_time_24bits,
-                          size_t payload_size,
-                          uint32_t ssrc);
+  // Returns true and sets |target_bitrate_bps| if the packet updated the
+  // estimate and the observer should be notified.
+  bool ProcessIncomingPacket(int64_t now_ms,
+                             const PacketInfo& packet,
+                             uint32_t* target_bitrate_bps)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&crit_);
 
   void ComputeClusters(std::list<Cluster>* clusters) const;
 
@@ -132,7 +149,9 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   bool incoming_bitrate_initialized_;
   std::vector<int> recent_propagation_delta_ms_;
   std::vector<int64_t> recent_update_time_ms_;
-  std::list<Probe> probes_;
+  // A deque keeps the probes in blocks which are reused as probes are added
+  // and removed, so receiving probes rarely allocates.
+  std::deque<Probe> probes_;
   size_t total_probes_received_;
   int64_t first_packet_time_ms_;
   int64_t last_update_ms_;
@@ -10,6 +10,8 @@
 
 #include "modules/remote_bitrate_estimator/remote_bitrate_estimator_abs_send_time.h"
 
+#include <vector>
+
 #include "modules/remote_bitrate_estimator/remote_bitrate_estimator_unittest_helper.h"
 #include "rtc_base/constructor_magic.h"
 #include "test/gtest.h"
@@ -132,6 +134,31 @@ TEST_F(RemoteBitrateEstimatorAbsSendTimeTest, TestProbeDetection) {
   EXPECT_GT(bitrate_observer_->latest_bitrate(), 1500000u);
 }
 
+TEST_F(RemoteBitrateEstimatorAbsSendTimeTest, TestProbeDetectionInBatches) {
+  const int kProbeLength = 5;
+  RemoteBitrateEstimatorAbsSendTime* estimator =
+      static_cast<RemoteBitrateEstimatorAbsSendTime*>(
+          bitrate_estimator_.get());
+  std::vector<RemoteBitrateEstimatorAbsSendTime::PacketInfo> packets;
+  int64_t send_time_ms = clock_.TimeInMilliseconds();
+  // First burst sent at 800 kbps and second burst at 1600 kbps, each given to
+  // the estimator as one batch.
+  for (int delta_ms : {10, 5}) {
+    packets.clear();
+    for (int i = 0; i < kProbeLength; ++i) {
+      send_time_ms += delta_ms;
+      packets.push_back(
+          {send_time_ms, 1000, 0, AbsSendTime(send_time_ms, 1000)});
+    }
+    clock_.AdvanceTimeMilliseconds(kProbeLength * delta_ms);
+    estimator->IncomingPackets(packets);
+  }
+
+  bitrate_estimator_->Process();
+  EXPECT_TRUE(bitrate_observer_->updated());
+  EXPECT_GT(bitrate_observer_->latest_bitrate(), 1500000u);
+}
+
 TEST_F(RemoteBitrateEstimatorAbsSendTimeTest,
        TestProbeDetectionNonPacedPackets) {
   const int kProbeLength = 5;
@@ -12,7 +12,9 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <utility>
 
 #include "absl/types/optional.h"
@@ -42,16 +44,19 @@ enum { kTimestampGroupLengthMs = 5 };
 static const double kTimestampToMs = 1.0 / 90.0;
 
 struct RemoteBitrateEstimatorSingleStream::Detector {
-  explicit Detector(int64_t last_packet_time_ms,
-                    const OverUseDetectorOptions& options,
-                    bool enable_burst_grouping,
-                    const WebRtcKeyValueConfig* key_value_config)
-      : last_packet_time_ms(last_packet_time_ms),
+  Detector(uint32_t ssrc,
+           int64_t last_packet_time_ms,
+           const OverUseDetectorOptions& options,
+           bool enable_burst_grouping,
+           const WebRtcKeyValueConfig* key_value_config)
+      : ssrc(ssrc),
+        last_packet_time_ms(last_packet_time_ms),
         inter_arrival(90 * kTimestampGroupLengthMs,
                       kTimestampToMs,
                       enable_burst_grouping),
         estimator(options),
         detector(key_value_config) {}
+  const uint32_t ssrc;
   int64_t last_packet_time_ms;
   InterArrival inter_arrival;
   OveruseEstimator estimator;
@@ -72,45 +77,76 @@ RemoteBitrateEstimatorSingleStream::RemoteBitrateEstimatorSingleStream(
   RTC_LOG(LS_INFO) << "RemoteBitrateEstimatorSingleStream: Instantiating.";
 }
 
-RemoteBitrateEstimatorSingleStream::~RemoteBitrateEstimatorSingleStream() {
-  while (!overuse_detectors_.empty()) {
-    SsrcOveruseEstimatorMap::iterator it = overuse_detectors_.begin();
-    delete it->second;
-    overuse_detectors_.erase(it);
-  }
-}
+RemoteBitrateEstimatorSingleStream::~RemoteBitrateEstimatorSingleStream() =
+    default;
 
 void RemoteBitrateEstimatorSingleStream::IncomingPacket(
     int64_t arrival_time_ms,
     size_t payload_size,
     const RTPHeader& header) {
+  const PacketInfo packet = {
+      arrival_time_ms, payload_size, header.ssrc,
+      header.timestamp + header.extension.transmissionTimeOffset,
+      header.extension.hasTransmissionTimeOffset};
+  IncomingPackets(rtc::ArrayView<const PacketInfo>(&packet, 1));
+}
+
+void RemoteBitrateEstimatorSingleStream::IncomingPackets(
+    rtc::ArrayView<const PacketInfo> packets) {
+  if (packets.empty())
+    return;
   if (!uma_recorded_) {
     BweNames type = BweNames::kReceiverTOffset;
-    if (!header.extension.hasTransmissionTimeOffset)
+    if (!packets[0].has_transmission_time_offset)
       type = BweNames::kReceiverNoExtension;
     RTC_HISTOGRAM_ENUMERATION(kBweTypeHistogram, type, BweNames::kBweNamesMax);
     uma_recorded_ = true;
   }
-  uint32_t ssrc = header.ssrc;
-  uint32_t rtp_timestamp =
-      header.timestamp + header.extension.transmissionTimeOffset;
   int64_t now_ms = clock_->TimeInMilliseconds();
   rtc::CritScope cs(&crit_sect_);
-  SsrcOveruseEstimatorMap::iterator it = overuse_detectors_.find(ssrc);
-  if (it == overuse_detectors_.end()) {
-    // This is a new SSRC. Adding to map.
+  bool update_estimate = false;
+  uint32_t target_bitrate_bps = 0;
+  Detector* detector = nullptr;
+  for (const PacketInfo& packet : packets) {
+    // Batches usually hold runs of packets of the same stream.
+    if (!detector || detector->ssrc != packet.ssrc)
+      detector = GetDetector(packet.ssrc, now_ms);
+    // A new estimate only removes streams that timed out, so |detector|, which
+    // just received a packet, stays valid.
+    if (ProcessIncomingPacket(now_ms, packet, detector, &target_bitrate_bps))
+      update_estimate = true;
+  }
+  if (update_estimate)
+    NotifyObserver(target_bitrate_bps);
+}
+
+RemoteBitrateEstimatorSingleStream::Detector*
+RemoteBitrateEstimatorSingleStream::GetDetector(uint32_t ssrc, int64_t now_ms) {
+  auto it = std::lower_bound(
+      overuse_detectors_.begin(), overuse_detectors_.end(), ssrc,
+      [](const std::unique_ptr<Detector>& detector, uint32_t value) {
+        return detector->ssrc < value;
+      });
+  if (it == overuse_detectors_.end() || (*it)->ssrc != ssrc) {
+    // This is a new SSRC.
     // TODO(holmer): If the channel changes SSRC the old SSRC will still be
-    // around in this map until the channel is deleted. This is OK since the
-    // callback will no longer be called for the old SSRC. This will be
-    // automatically cleaned up when we have one RemoteBitrateEstimator per REMB
-    // group.
-    std::pair<SsrcOveruseEstimatorMap::iterator, bool> insert_result =
-        overuse_detectors_.insert(
-            std::make_pair(ssrc, new Detector(now_ms, OverUseDetectorOptions(),
-                                              true, &field_trials_)));
-    it = insert_result.first;
+    // around in |overuse_detectors_| until the channel is deleted. This is OK
+    // since the callback will no longer be called for the old SSRC. This will
+    // be automatically cleaned up when we have one RemoteBitrateEstimator per
+    // REMB group.
+    it = overuse_detectors_.insert(
+        it, std::make_unique<Detector>(ssrc, now_ms, OverUseDetectorOptions(),
+                                       true, &field_trials_));
   }
-  Detector* estimator = it->second;
+  return it->get();
+}
+
+bool RemoteBitrateEstimatorSingleStream::ProcessIncomingPacket(
+    int64_t now_ms,
+    const PacketInfo& packet,
+    Detector* estimator,
+    uint32_t* target_bitrate_bps) {
+  const size_t payload_size = packet.payload_size;
   estimator->last_packet_time_ms = now_ms;
 
   // Check if incoming bitrate estimate is valid, and if it needs to be reset.
@@ -131,7 +167,7 @@ void RemoteBitrateEstimatorSingleStream::IncomingPacket(
   int64_t time_delta = 0;
   int size_delta = 0;
   if (estimator->inter_arrival.ComputeDeltas(
-          rtp_timestamp, arrival_time_ms, now_ms, payload_size,
+          packet.send_timestamp, packet.arrival_time_ms, now_ms, payload_size,
           &timestamp_delta, &time_delta, &size_delta)) {
     double timestamp_delta_ms = timestamp_delta * kTimestampToMs;
     estimator->estimator.Update(time_delta, timestamp_delta_ms, size_delta,
@@ -150,15 +186,18 @@ void RemoteBitrateEstimatorSingleStream::IncomingPacket(
       // The first overuse should immediately trigger a new estimate.
       // We also have to update the estimate immediately if we are overusing
       // and the target bitrate is too high compared to what we are receiving.
-      UpdateEstimate(now_ms);
+      return UpdateEstimate(now_ms, target_bitrate_bps);
     }
   }
+  return false;
 }
 
 void RemoteBitrateEstimatorSingleStream::Process() {
   {
     rtc::CritScope cs(&crit_sect_);
-    UpdateEstimate(clock_->TimeInMilliseconds());
+    uint32_t target_bitrate_bps = 0;
+    if (UpdateEstimate(clock_->TimeInMilliseconds(), &target_bitrate_bps))
+      NotifyObserver(target_bitrate_bps);
   }
   last_process_time_ = clock_->TimeInMilliseconds();
 }
@@ -173,45 +212,47 @@ int64_t RemoteBitrateEstimatorSingleStream::TimeUntilNextProcess() {
          clock_->TimeInMilliseconds();
 }
 
-void RemoteBitrateEstimatorSingleStream::UpdateEstimate(int64_t now_ms) {
-  BandwidthUsage bw_state = BandwidthUsage::kBwNormal;
-  SsrcOveruseEstimatorMap::iterator it = overuse_detectors_.begin();
-  while (it != overuse_detectors_.end()) {
-    const int64_t time_of_last_received_packet =
-        it->second->last_packet_time_ms;
-    if (time_of_last_received_packet >= 0 &&
-        now_ms - time_of_last_received_packet > kStreamTimeOutMs) {
-      // This over-use detector hasn't received packets for |kStreamTimeOutMs|
-      // milliseconds and is considered stale.
-      delete it->second;
-      overuse_detectors_.erase(it++);
-    } else {
-      // Make sure that we trigger an over-use if any of the over-use detectors
-      // is detecting over-use.
-      if (it->second->detector.State() > bw_state) {
-        bw_state = it->second->detector.State();
-      }
-      ++it;
-    }
-  }
+bool RemoteBitrateEstimatorSingleStream::UpdateEstimate(
+    int64_t now_ms,
+    uint32_t* target_bitrate_bps) {
+  // Over-use detectors that haven't received packets for |kStreamTimeOutMs|
+  // milliseconds are considered stale.
+  overuse_detectors_.erase(
+      std::remove_if(overuse_detectors_.begin(), overuse_detectors_.end(),
+                     [now_ms](const std::unique_ptr<Detector>& detector) {
+                       return detector->last_packet_time_ms >= 0 &&
+                              now_ms - detector->last_packet_time_ms >
+                                  kStreamTimeOutMs;
+                     }),
+      overuse_detectors_.end());
   // We can't update the estimate if we don't have any active streams.
   if (overuse_detectors_.empty()) {
-    return;
+    return false;
   }
+  // Make sure that we trigger an over-use if any of the over-use detectors is
+  // detecting over-use.
+  BandwidthUsage bw_state = BandwidthUsage::kBwNormal;
+  for (const std::unique_ptr<Detector>& detector : overuse_detectors_)
+    bw_state = std::max(bw_state, detector->detector.State());
   AimdRateControl* remote_rate = GetRemoteRate();
 
   const RateControlInput input(
       bw_state, OptionalRateFromOptionalBps(incoming_bitrate_.Rate(now_ms)));
-  uint32_t target_bitrate =
+  *target_bitrate_bps =
       remote_rate->Update(&input, Timestamp::ms(now_ms)).bps<uint32_t>();
-  if (remote_rate->ValidEstimate()) {
-    process_interval_ms_ = remote_rate->GetFeedbackInterval().ms();
-    RTC_DCHECK_GT(process_interval_ms_, 0);
-    std::vector<uint32_t> ssrcs;
-    GetSsrcs(&ssrcs);
-    if (observer_)
-      observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate);
-  }
+  if (!remote_rate->ValidEstimate())
+    return false;
+  process_interval_ms_ = remote_rate->GetFeedbackInterval().ms();
+  RTC_DCHECK_GT(process_interval_ms_, 0);
+  return true;
+}
+
+void RemoteBitrateEstimatorSingleStream::NotifyObserver(
+    uint32_t target_bitrate_bps) {
+  std::vector<uint32_t> ssrcs;
+  GetSsrcs(&ssrcs);
+  if (observer_)
+    observer_->OnReceiveBitrateChanged(ssrcs, target_bitrate_bps);
 }
 
 void RemoteBitrateEstimatorSingleStream::OnRttUpdate(int64_t avg_rtt_ms,
@@ -222,11 +263,12 @@ void RemoteBitrateEstimatorSingleStream::OnRttUpdate(int64_t avg_rtt_ms,
 
 void RemoteBitrateEstimatorSingleStream::RemoveStream(unsigned int ssrc) {
   rtc::CritScope cs(&crit_sect_);
-  SsrcOveruseEstimatorMap::iterator it = overuse_detectors_.find(ssrc);
-  if (it != overuse_detectors_.end()) {
-    delete it->second;
-    overuse_detectors_.erase(it);
-  }
+  overuse_detectors_.erase(
+      std::remove_if(overuse_detectors_.begin(), overuse_detectors_.end(),
+                     [ssrc](const std::unique_ptr<Detector>& detector) {
+                       return detector->ssrc == ssrc;
+                     }),
+      overuse_detectors_.end());
 }
 
 bool RemoteBitrateEstimatorSingleStream::LatestEstimate(
@@ -249,11 +291,8 @@ void RemoteBitrateEstimatorSingleStream::GetSsrcs(
     std::vector<uint32_t>* ssrcs) const {
   assert(ssrcs);
   ssrcs->resize(overuse_detectors_.size());
-  int i = 0;
-  for (SsrcOveruseEstimatorMap::const_iterator it = overuse_detectors_.begin();
-       it != overuse_detectors_.end(); ++it, ++i) {
-    (*ssrcs)[i] = it->first;
-  }
+  for (size_t i = 0; i < overuse_detectors_.size(); ++i)
+    (*ssrcs)[i] = overuse_detectors_[i]->ssrc;
 }
 
 AimdRateControl* RemoteBitrateEstimatorSingleStream::GetRemoteRate() {
@@ -14,10 +14,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
+
 #include "api/transport/field_trial_based_config.h"
 #include "modules/remote_bitrate_estimator/aimd_rate_control.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
@@ -33,6 +34,16 @@ struct RTPHeader;
 
 class RemoteBitrateEstimatorSingleStream : public RemoteBitrateEstimator {
  public:
+  // A received RTP packet.
+  struct PacketInfo {
+    int64_t arrival_time_ms;
+    size_t payload_size;
+    uint32_t ssrc;
+    // The RTP timestamp plus the transmission time offset, if any.
+    uint32_t send_timestamp;
+    bool has_transmission_time_offset;
+  };
+
   RemoteBitrateEstimatorSingleStream(RemoteBitrateObserver* observer,
                                      Clock* clock);
   ~RemoteBitrateEstimatorSingleStream() override;
@@ -40,6 +51,11 @@ class RemoteBitrateEstimatorSingleStream : public RemoteBitrateEstimator {
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  // Same as calling IncomingPacket() for each of |packets| in order, except
+  // that the lock is taken once and the observer is notified at most once,
+  // with the estimate after the last packet. All |packets| are considered
+  // received at the current time of the clock.
+  void IncomingPackets(rtc::ArrayView<const PacketInfo> packets);
   void Process() override;
   int64_t TimeUntilNextProcess() override;
   void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
@@ -51,10 +67,25 @@ class RemoteBitrateEstimatorSingleStream : public RemoteBitrateEstimator {
  private:
   struct Detector;
 
-  typedef std::map<uint32_t, Detector*> SsrcOveruseEstimatorMap;
+  // Returns the detector of |ssrc|, adding one if it is a new stream.
+  Detector* GetDetector(uint32_t ssrc, int64_t now_ms)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  // Returns true and sets |target_bitrate_bps| if the packet requires a new
+  // estimate and the observer should be notified.
+  bool ProcessIncomingPacket(int64_t now_ms,
+                             const PacketInfo& packet,
+                             Detector* estimator,
+                             uint32_t* target_bitrate_bps)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
+  // Triggers a new estimate calculation. Returns true and sets
+  // |target_bitrate_bps| if the estimate is valid and the observer should be
+  // notified.
+  bool UpdateEstimate(int64_t time_now, uint32_t* target_bitrate_bps)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
-  // Triggers a new estimate calculation.
-  void UpdateEstimate(int64_t time_now)
+  void NotifyObserver(uint32_t target_bitrate_bps)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
   void GetSsrcs(std::vector<uint32_t>* ssrcs) const
@@ -66,7 +97,10 @@ class RemoteBitrateEstimatorSingleStream : public RemoteBitrateEstimator {
 
   Clock* const clock_;
   const FieldTrialBasedConfig field_trials_;
-  SsrcOveruseEstimatorMap overuse_detectors_ RTC_GUARDED_BY(crit_sect_);
+  // Sorted by ssrc. A vector rather than a map, since there are few streams
+  // and it is searched for every packet.
+  std::vector<std::unique_ptr<Detector>> overuse_detectors_
+      RTC_GUARDED_BY(crit_sect_);
   RateStatistics incoming_bitrate_ RTC_GUARDED_BY(crit_sect_);
   uint32_t last_valid_incoming_bitrate_ RTC_GUARDED_BY(crit_sect_);
   std::unique_ptr<AimdRateControl> remote_rate_ RTC_GUARDED_BY(crit_sect_);
@@ -10,6 +10,8 @@
 
 #include "modules/remote_bitrate_estimator/remote_bitrate_estimator_single_stream.h"
 
+#include <vector>
+
 #include "modules/remote_bitrate_estimator/remote_bitrate_estimator_unittest_helper.h"
 #include "rtc_base/constructor_magic.h"
 #include "test/gtest.h"
@@ -71,4 +73,35 @@ TEST_F(RemoteBitrateEstimatorSingleTest, CapacityDropThirtyStreamsWrap) {
 TEST_F(RemoteBitrateEstimatorSingleTest, TestTimestampGrouping) {
   TestTimestampGroupingTestHelper();
 }
+
+TEST_F(RemoteBitrateEstimatorSingleTest, IncomingPacketsInBatches) {
+  const uint32_t kSsrcs[] = {2, 1};
+  const int kPacketsPerFrame = 3;
+  RemoteBitrateEstimatorSingleStream* estimator =
+      static_cast<RemoteBitrateEstimatorSingleStream*>(
+          bitrate_estimator_.get());
+  std::vector<RemoteBitrateEstimatorSingleStream::PacketInfo> packets;
+  // Two streams at 30 fps, each frame of both streams given to the estimator
+  // as one batch.
+  for (int frame = 0; frame < 200; ++frame) {
+    const int64_t now_ms = clock_.TimeInMilliseconds();
+    packets.clear();
+    for (uint32_t ssrc : kSsrcs) {
+      for (int i = 0; i < kPacketsPerFrame; ++i) {
+        packets.push_back({now_ms, 1000, ssrc,
+                           static_cast<uint32_t>(90 * frame * 33), false});
+      }
+    }
+    estimator->IncomingPackets(packets);
+    clock_.AdvanceTimeMilliseconds(33);
+    bitrate_estimator_->Process();
+  }
+
+  EXPECT_TRUE(bitrate_observer_->updated());
+  EXPECT_GT(bitrate_observer_->latest_bitrate(), 0u);
+  std::vector<uint32_t> ssrcs;
+  uint32_t bitrate_bps = 0;
+  EXPECT_TRUE(bitrate_estimator_->LatestEstimate(&ssrcs, &bitrate_bps));
+  EXPECT_EQ(std::vector<uint32_t>({1, 2}), ssrcs);
+}
 }  // namespace webrtc
@@ -43,7 +43,14 @@ class RtpHeaderExtensionMap {
     return GetId(type) != kInvalidId;
   }
   // Return kInvalidType if not found.
-  RTPExtensionType GetType(int id) const;
+  RTPExtensionType GetType(int id) const {
+    RTC_DCHECK_GE(id, RtpExtension::kMinId);
+    RTC_DCHECK_LE(id, RtpExtension::kMaxId);
+    if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+      return static_cast<RTPExtensionType>(one_byte_types_[id]);
+    }
+    return GetTwoByteType(id);
+  }
   // Return kInvalidId if not found.
   uint8_t GetId(RTPExtensionType type) const {
     RTC_DCHECK_GT(type, kRtpExtensionNone);
@@ -68,8 +75,14 @@ class RtpHeaderExtensionMap {
 
  private:
   bool Register(int id, RTPExtensionType type, const char* uri);
+  RTPExtensionType GetTwoByteType(int id) const;
+  void Unregister(RTPExtensionType type);
 
   uint8_t ids_[kRtpExtensionNumberOfExtensions];
+  // Reverse of |ids_| for the ids that fit in a one-byte header, which are the
+  // ones used by the vast majority of streams, so that parsing a packet can
+  // resolve an extension type with a single load.
+  uint8_t one_byte_types_[RtpExtension::kOneByteHeaderExtensionMaxId + 1];
   bool extmap_allow_mixed_;
 };
 
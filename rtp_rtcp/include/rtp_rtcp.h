@@ -269,7 +269,7 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
 
   // Try to send the provided packet. Returns true iff packet matches any of
   // the SSRCs for this module (media/rtx/fec etc) and was forwarded to the
-  // transport.
+  // transport. The packet may have been moved from when this returns true.
   virtual bool TrySendPacket(RtpPacketToSend* packet,
                              const PacedPacketInfo& pacing_info) = 0;
 
@@ -18,14 +18,19 @@ namespace webrtc {
 namespace {
 
 constexpr Timestamp kInvalidLastReceiveTime = Timestamp::MinusInfinity();
+
+// Stands for an unknown remote to local clock offset. It is -2^31 seconds,
+// which a real offset never is.
+constexpr int64_t kNoClockOffset = std::numeric_limits<int64_t>::min();
 }  // namespace
 
 constexpr TimeDelta AbsoluteCaptureTimeReceiver::kInterpolationMaxInterval;
 
 AbsoluteCaptureTimeReceiver::AbsoluteCaptureTimeReceiver(Clock* clock)
     : clock_(clock),
-      remote_to_local_clock_offset_(absl::nullopt),
-      last_receive_time_(kInvalidLastReceiveTime) {}
+      remote_to_local_clock_offset_(kNoClockOffset),
+      last_receive_time_(kInvalidLastReceiveTime),
+      interpolated_absolute_capture_timestamp_(0) {}
 
 uint32_t AbsoluteCaptureTimeReceiver::GetSource(
     uint32_t ssrc,
@@ -39,9 +44,9 @@ uint32_t AbsoluteCaptureTimeReceiver::GetSource(
 
 void AbsoluteCaptureTimeReceiver::SetRemoteToLocalClockOffset(
     absl::optional<int64_t> value_q32x32) {
-  rtc::CritScope cs(&crit_);
-
-  remote_to_local_clock_offset_ = value_q32x32;
+  RTC_DCHECK(value_q32x32 != kNoClockOffset);
+  remote_to_local_clock_offset_.store(value_q32x32.value_or(kNoClockOffset),
+                                      std::memory_order_relaxed);
 }
 
 absl::optional<AbsoluteCaptureTime>
@@ -52,19 +57,27 @@ AbsoluteCaptureTimeReceiver::OnReceivePacket(
     const absl::optional<AbsoluteCaptureTime>& received_extension) {
   const Timestamp receive_time = clock_->CurrentTime();
 
-  rtc::CritScope cs(&crit_);
-
   AbsoluteCaptureTime extension;
   if (received_extension == absl::nullopt) {
     if (!ShouldInterpolateExtension(receive_time, source, rtp_timestamp,
                                     rtp_clock_frequency)) {
       last_receive_time_ = kInvalidLastReceiveTime;
+      interpolated_rtp_timestamp_ = absl::nullopt;
       return absl::nullopt;
     }
 
-    extension.absolute_capture_timestamp = InterpolateAbsoluteCaptureTimestamp(
-        rtp_timestamp, rtp_clock_frequency, last_rtp_timestamp_,
-        last_absolute_capture_timestamp_);
+    // The interpolation only depends on the RTP timestamp and on the last
+    // received extension, which resets |interpolated_rtp_timestamp_|.
+    if (interpolated_rtp_timestamp_ != rtp_timestamp) {
+      interpolated_absolute_capture_timestamp_ =
+          InterpolateAbsoluteCaptureTimestamp(rtp_timestamp,
+                                              rtp_clock_frequency,
+                                              last_rtp_timestamp_,
+                                              last_absolute_capture_timestamp_);
+      interpolated_rtp_timestamp_ = rtp_timestamp;
+    }
+    extension.absolute_capture_timestamp =
+        interpolated_absolute_capture_timestamp_;
     extension.estimated_capture_clock_offset =
         last_estimated_capture_clock_offset_;
   } else {
@@ -77,6 +90,7 @@ AbsoluteCaptureTimeReceiver::OnReceivePacket(
         received_extension->estimated_capture_clock_offset;
 
     last_receive_time_ = receive_time;
+    interpolated_rtp_timestamp_ = absl::nullopt;
 
     extension = *received_extension;
   }
@@ -137,14 +151,18 @@ bool AbsoluteCaptureTimeReceiver::ShouldInterpolateExtension(
 absl::optional<int64_t>
 AbsoluteCaptureTimeReceiver::AdjustEstimatedCaptureClockOffset(
     absl::optional<int64_t> received_value) const {
-  if (received_value == absl::nullopt ||
-      remote_to_local_clock_offset_ == absl::nullopt) {
+  if (received_value == absl::nullopt) {
+    return absl::nullopt;
+  }
+  const int64_t remote_to_local_clock_offset =
+      remote_to_local_clock_offset_.load(std::memory_order_relaxed);
+  if (remote_to_local_clock_offset == kNoClockOffset) {
     return absl::nullopt;
   }
 
   // Do calculations as "unsigned" to make overflows deterministic.
   return static_cast<uint64_t>(*received_value) +
-         static_cast<uint64_t>(*remote_to_local_clock_offset_);
+         static_cast<uint64_t>(remote_to_local_clock_offset);
 }
 
 }  // namespace webrtc
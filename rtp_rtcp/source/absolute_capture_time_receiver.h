@@ -11,12 +11,12 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_ABSOLUTE_CAPTURE_TIME_RECEIVER_H_
 #define MODULES_RTP_RTCP_SOURCE_ABSOLUTE_CAPTURE_TIME_RECEIVER_H_
 
+#include <atomic>
+
 #include "api/array_view.h"
 #include "api/rtp_headers.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
-#include "rtc_base/critical_section.h"
-#include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
@@ -33,6 +33,10 @@ namespace webrtc {
 //
 // See: https://webrtc.org/experiments/rtp-hdrext/abs-capture-time/
 //
+// SetRemoteToLocalClockOffset() may be called on any thread, but
+// OnReceivePacket() must be called on one sequence, or be protected by the
+// caller.
+//
 class AbsoluteCaptureTimeReceiver {
  public:
   static constexpr TimeDelta kInterpolationMaxInterval =
@@ -54,6 +58,8 @@ class AbsoluteCaptureTimeReceiver {
 
   // Returns a received header extension, an interpolated header extension, or
   // |absl::nullopt| if it's not possible to interpolate a header extension.
+  // The capture timestamp is only interpolated once for the packets of a
+  // frame.
   absl::optional<AbsoluteCaptureTime> OnReceivePacket(
       uint32_t source,
       uint32_t rtp_timestamp,
@@ -72,27 +78,29 @@ class AbsoluteCaptureTimeReceiver {
   bool ShouldInterpolateExtension(Timestamp receive_time,
                                   uint32_t source,
                                   uint32_t rtp_timestamp,
-                                  uint32_t rtp_clock_frequency) const
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+                                  uint32_t rtp_clock_frequency) const;
 
   absl::optional<int64_t> AdjustEstimatedCaptureClockOffset(
-      absl::optional<int64_t> received_value) const
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+      absl::optional<int64_t> received_value) const;
 
   Clock* const clock_;
 
-  rtc::CriticalSection crit_;
+  // Q32.32 offset, or |kNoClockOffset| if unknown. Read for every packet and
+  // written from RTCP, so it is kept lock-free.
+  std::atomic<int64_t> remote_to_local_clock_offset_;
 
-  absl::optional<int64_t> remote_to_local_clock_offset_ RTC_GUARDED_BY(crit_);
+  Timestamp last_receive_time_;
 
-  Timestamp last_receive_time_ RTC_GUARDED_BY(crit_);
+  uint32_t last_source_;
+  uint32_t last_rtp_timestamp_;
+  uint32_t last_rtp_clock_frequency_;
+  uint64_t last_absolute_capture_timestamp_;
+  absl::optional<int64_t> last_estimated_capture_clock_offset_;
 
-  uint32_t last_source_ RTC_GUARDED_BY(crit_);
-  uint32_t last_rtp_timestamp_ RTC_GUARDED_BY(crit_);
-  uint32_t last_rtp_clock_frequency_ RTC_GUARDED_BY(crit_);
-  uint64_t last_absolute_capture_timestamp_ RTC_GUARDED_BY(crit_);
-  absl::optional<int64_t> last_estimated_capture_clock_offset_
-      RTC_GUARDED_BY(crit_);
+  // RTP timestamp and interpolated capture timestamp of the most recent frame
+  // without a received extension.
+  absl::optional<uint32_t> interpolated_rtp_timestamp_;
+  uint64_t interpolated_absolute_capture_timestamp_;
 };  // AbsoluteCaptureTimeReceiver
 
 }  // namespace webrtc
@@ -413,4 +413,44 @@ TEST(AbsoluteCaptureTimeReceiverTest, SkipInterpolateIsSticky) {
                    .has_value());
 }
 
+TEST(AbsoluteCaptureTimeReceiverTest, InterpolateAllPacketsOfFrame) {
+  constexpr uint32_t kSource = 1337;
+  constexpr uint32_t kRtpClockFrequency = 64000;
+  constexpr uint32_t kRtpTimestamp0 = 1020300000;
+  constexpr uint32_t kRtpTimestamp1 = kRtpTimestamp0 + 1280;
+  constexpr uint32_t kRtpTimestamp2 = kRtpTimestamp0 + 2560;
+  static const absl::optional<AbsoluteCaptureTime> kExtension0 =
+      AbsoluteCaptureTime{Int64MsToUQ32x32(9000), Int64MsToQ32x32(-350)};
+  static const absl::optional<AbsoluteCaptureTime> kExtension2 =
+      AbsoluteCaptureTime{Int64MsToUQ32x32(9100), Int64MsToQ32x32(-350)};
+
+  SimulatedClock clock(0);
+  AbsoluteCaptureTimeReceiver receiver(&clock);
+
+  receiver.SetRemoteToLocalClockOffset(0);
+
+  EXPECT_EQ(receiver.OnReceivePacket(kSource, kRtpTimestamp0,
+                                     kRtpClockFrequency, kExtension0),
+            kExtension0);
+
+  // All packets of the second frame get the same interpolated timestamp.
+  for (int i = 0; i < 3; ++i) {
+    absl::optional<AbsoluteCaptureTime> extension = receiver.OnReceivePacket(
+        kSource, kRtpTimestamp1, kRtpClockFrequency, absl::nullopt);
+    ASSERT_TRUE(extension.has_value());
+    EXPECT_EQ(UQ32x32ToInt64Ms(extension->absolute_capture_timestamp),
+              UQ32x32ToInt64Ms(kExtension0->absolute_capture_timestamp) + 20);
+  }
+
+  // A newly received extension is used for later packets of the same frame.
+  EXPECT_EQ(receiver.OnReceivePacket(kSource, kRtpTimestamp2,
+                                     kRtpClockFrequency, kExtension2),
+            kExtension2);
+  absl::optional<AbsoluteCaptureTime> extension = receiver.OnReceivePacket(
+      kSource, kRtpTimestamp1, kRtpClockFrequency, absl::nullopt);
+  ASSERT_TRUE(extension.has_value());
+  EXPECT_EQ(UQ32x32ToInt64Ms(extension->absolute_capture_timestamp),
+            UQ32x32ToInt64Ms(kExtension2->absolute_capture_timestamp) - 20);
+}
+
 }  // namespace webrtc
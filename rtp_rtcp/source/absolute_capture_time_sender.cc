@@ -31,7 +31,9 @@ static_assert(
     "Receivers should be as willing to interpolate timestamps as senders.");
 
 AbsoluteCaptureTimeSender::AbsoluteCaptureTimeSender(Clock* clock)
-    : clock_(clock), last_send_time_(kInvalidLastSendTime) {}
+    : clock_(clock),
+      last_send_time_(kInvalidLastSendTime),
+      skipped_absolute_capture_timestamp_(0) {}
 
 uint32_t AbsoluteCaptureTimeSender::GetSource(
     uint32_t ssrc,
@@ -47,13 +49,20 @@ absl::optional<AbsoluteCaptureTime> AbsoluteCaptureTimeSender::OnSendPacket(
     absl::optional<int64_t> estimated_capture_clock_offset) {
   const Timestamp send_time = clock_->CurrentTime();
 
-  rtc::CritScope cs(&crit_);
+  if (IsSkippedFrame(send_time, source, rtp_timestamp, rtp_clock_frequency,
+                     absolute_capture_timestamp,
+                     estimated_capture_clock_offset)) {
+    return absl::nullopt;
+  }
 
   if (!ShouldSendExtension(send_time, source, rtp_timestamp,
                            rtp_clock_frequency, absolute_capture_timestamp,
                            estimated_capture_clock_offset)) {
+    skipped_rtp_timestamp_ = rtp_timestamp;
+    skipped_absolute_capture_timestamp_ = absolute_capture_timestamp;
     return absl::nullopt;
   }
+  skipped_rtp_timestamp_ = absl::nullopt;
 
   last_source_ = source;
   last_rtp_timestamp_ = rtp_timestamp;
@@ -69,6 +78,24 @@ absl::optional<AbsoluteCaptureTime> AbsoluteCaptureTimeSender::OnSendPacket(
   return extension;
 }
 
+bool AbsoluteCaptureTimeSender::IsSkippedFrame(
+    Timestamp send_time,
+    uint32_t source,
+    uint32_t rtp_timestamp,
+    uint32_t rtp_clock_frequency,
+    uint64_t absolute_capture_timestamp,
+    absl::optional<int64_t> estimated_capture_clock_offset) const {
+  // The skipped frame was compared to the last sent extension, which hasn't
+  // changed since, so only the send time has to be checked again.
+  return skipped_rtp_timestamp_ == rtp_timestamp &&
+         skipped_absolute_capture_timestamp_ == absolute_capture_timestamp &&
+         last_source_ == source &&
+         last_rtp_clock_frequency_ == rtp_clock_frequency &&
+         last_estimated_capture_clock_offset_ ==
+             estimated_capture_clock_offset &&
+         (send_time - last_send_time_) <= kInterpolationMaxInterval;
+}
+
 bool AbsoluteCaptureTimeSender::ShouldSendExtension(
     Timestamp send_time,
     uint32_t source,
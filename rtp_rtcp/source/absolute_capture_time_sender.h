@@ -15,8 +15,6 @@
 #include "api/rtp_headers.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
-#include "rtc_base/critical_section.h"
-#include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
@@ -38,6 +36,9 @@ namespace webrtc {
 //
 // See: https://webrtc.org/experiments/rtp-hdrext/abs-capture-time/
 //
+// Note that this class isn't thread-safe by itself and therefore relies on
+// being called on one sequence, or being protected by the caller.
+//
 class AbsoluteCaptureTimeSender {
  public:
   static constexpr TimeDelta kInterpolationMaxInterval =
@@ -51,7 +52,8 @@ class AbsoluteCaptureTimeSender {
                             rtc::ArrayView<const uint32_t> csrcs);
 
   // Returns a header extension to be sent, or |absl::nullopt| if the header
-  // extension shouldn't be sent.
+  // extension shouldn't be sent. The packets of a frame after the first one
+  // are resolved with a few comparisons.
   absl::optional<AbsoluteCaptureTime> OnSendPacket(
       uint32_t source,
       uint32_t rtp_timestamp,
@@ -66,21 +68,31 @@ class AbsoluteCaptureTimeSender {
       uint32_t rtp_timestamp,
       uint32_t rtp_clock_frequency,
       uint64_t absolute_capture_timestamp,
-      absl::optional<int64_t> estimated_capture_clock_offset) const
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+      absl::optional<int64_t> estimated_capture_clock_offset) const;
+
+  // Returns true if the packet belongs to the frame that was last found not to
+  // need the extension, and nothing else has changed since.
+  bool IsSkippedFrame(
+      Timestamp send_time,
+      uint32_t source,
+      uint32_t rtp_timestamp,
+      uint32_t rtp_clock_frequency,
+      uint64_t absolute_capture_timestamp,
+      absl::optional<int64_t> estimated_capture_clock_offset) const;
 
   Clock* const clock_;
 
-  rtc::CriticalSection crit_;
+  Timestamp last_send_time_;
 
-  Timestamp last_send_time_ RTC_GUARDED_BY(crit_);
+  uint32_t last_source_;
+  uint32_t last_rtp_timestamp_;
+  uint32_t last_rtp_clock_frequency_;
+  uint64_t last_absolute_capture_timestamp_;
+  absl::optional<int64_t> last_estimated_capture_clock_offset_;
 
-  uint32_t last_source_ RTC_GUARDED_BY(crit_);
-  uint32_t last_rtp_timestamp_ RTC_GUARDED_BY(crit_);
-  uint32_t last_rtp_clock_frequency_ RTC_GUARDED_BY(crit_);
-  uint64_t last_absolute_capture_timestamp_ RTC_GUARDED_BY(crit_);
-  absl::optional<int64_t> last_estimated_capture_clock_offset_
-      RTC_GUARDED_BY(crit_);
+  // The most recent frame that interpolation was found to be good enough for.
+  absl::optional<uint32_t> skipped_rtp_timestamp_;
+  uint64_t skipped_absolute_capture_timestamp_;
 };  // AbsoluteCaptureTimeSender
 
 }  // namespace webrtc
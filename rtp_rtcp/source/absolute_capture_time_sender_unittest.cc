@@ -371,4 +371,45 @@ TEST(AbsoluteCaptureTimeSenderTest,
             kExtension2);
 }
 
+TEST(AbsoluteCaptureTimeSenderTest, SkipAllPacketsOfInterpolatedFrame) {
+  constexpr uint32_t kSource = 1337;
+  constexpr uint32_t kRtpClockFrequency = 64000;
+  constexpr uint32_t kRtpTimestamp0 = 1020300000;
+  constexpr uint32_t kRtpTimestamp1 = kRtpTimestamp0 + 1280;
+  static const absl::optional<AbsoluteCaptureTime> kExtension0 =
+      AbsoluteCaptureTime{Int64MsToUQ32x32(9000), Int64MsToQ32x32(-350)};
+  static const absl::optional<AbsoluteCaptureTime> kExtension1 =
+      AbsoluteCaptureTime{Int64MsToUQ32x32(9000 + 20), Int64MsToQ32x32(-350)};
+
+  SimulatedClock clock(0);
+  AbsoluteCaptureTimeSender sender(&clock);
+
+  EXPECT_EQ(sender.OnSendPacket(kSource, kRtpTimestamp0, kRtpClockFrequency,
+                                kExtension0->absolute_capture_timestamp,
+                                kExtension0->estimated_capture_clock_offset),
+            kExtension0);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(sender.OnSendPacket(kSource, kRtpTimestamp1, kRtpClockFrequency,
+                                  kExtension1->absolute_capture_timestamp,
+                                  kExtension1->estimated_capture_clock_offset),
+              absl::nullopt);
+  }
+
+  // The interval is still checked for the later packets of the frame.
+  clock.AdvanceTime(AbsoluteCaptureTimeSender::kInterpolationMaxInterval +
+                    TimeDelta::us(1));
+  EXPECT_EQ(sender.OnSendPacket(kSource, kRtpTimestamp1, kRtpClockFrequency,
+                                kExtension1->absolute_capture_timestamp,
+                                kExtension1->estimated_capture_clock_offset),
+            kExtension1);
+
+  // As is a changed estimated capture clock offset.
+  EXPECT_EQ(sender.OnSendPacket(kSource, kRtpTimestamp1, kRtpClockFrequency,
+                                kExtension1->absolute_capture_timestamp,
+                                absl::nullopt),
+            (AbsoluteCaptureTime{kExtension1->absolute_capture_timestamp,
+                                 absl::nullopt}));
+}
+
 }  // namespace webrtc
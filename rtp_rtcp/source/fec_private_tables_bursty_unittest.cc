@@ -78,5 +78,65 @@ TEST(FecTable, TestRandomGenerated) {
   }
 }
 
+TEST(FecTable, CachedLookupMatchesTables) {
+  for (FecMaskType fec_mask_type : {kFecMaskRandom, kFecMaskBursty}) {
+    const uint8_t* table = fec_mask_type == kFecMaskRandom
+                               ? &kPacketMaskRandomTbl[0]
+                               : &kPacketMaskBurstyTbl[0];
+    for (int num_media_packets = 1; num_media_packets <= 12;
+         ++num_media_packets) {
+      for (int num_fec_packets = 1; num_fec_packets <= num_media_packets;
+           ++num_fec_packets) {
+        rtc::ArrayView<const uint8_t> expected = LookUpInFecTable(
+            table, num_media_packets - 1, num_fec_packets - 1);
+        // Look up twice, with separate tables, to hit the cache.
+        for (int i = 0; i < 2; ++i) {
+          internal::PacketMaskTable mask_table(fec_mask_type,
+                                               num_media_packets);
+          rtc::ArrayView<const uint8_t> mask =
+              mask_table.LookUp(num_media_packets, num_fec_packets);
+          EXPECT_EQ(expected.data(), mask.data());
+          EXPECT_EQ(expected.size(), mask.size());
+        }
+      }
+    }
+  }
+}
+
+TEST(FecTable, CachedGeneratedMasksAreInterleaved) {
+  for (int num_media_packets = 13;
+       num_media_packets <= static_cast<int>(kUlpfecMaxMediaPackets);
+       ++num_media_packets) {
+    const size_t mask_length = internal::PacketMaskSize(num_media_packets);
+    for (int num_fec_packets = 1; num_fec_packets <= num_media_packets;
+         ++num_fec_packets) {
+      rtc::ArrayView<const uint8_t> first_mask;
+      for (int i = 0; i < 2; ++i) {
+        internal::PacketMaskTable mask_table(kFecMaskRandom,
+                                             num_media_packets);
+        rtc::ArrayView<const uint8_t> mask =
+            mask_table.LookUp(num_media_packets, num_fec_packets);
+        ASSERT_EQ(num_fec_packets * mask_length, mask.size());
+        if (i == 0) {
+          first_mask = mask;
+        } else {
+          // The second lookup should be served from the cache.
+          EXPECT_EQ(first_mask.data(), mask.data());
+        }
+        for (int row = 0; row < num_fec_packets; ++row) {
+          for (size_t bit = 0; bit < 8 * mask_length; ++bit) {
+            const bool is_set = mask[row * mask_length + bit / 8] &
+                                (0x80 >> (bit % 8));
+            const bool expect_set =
+                bit < static_cast<size_t>(num_media_packets) &&
+                static_cast<int>(bit) % num_fec_packets == row;
+            EXPECT_EQ(expect_set, is_set);
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace fec_private_tables
 }  // namespace webrtc
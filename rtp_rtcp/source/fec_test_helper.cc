@@ -17,7 +17,10 @@
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtp_packet.h"
 #include "modules/rtp_rtcp/source/rtp_utility.h"
+#include "modules/utility/include/cpu_features.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 namespace test {
@@ -31,6 +34,22 @@ constexpr uint8_t kVp8PayloadType = 120;
 constexpr int kPacketTimestampIncrement = 3000;
 }  // namespace
 
+std::vector<FecXorOptimization> AvailableFecXorOptimizations() {
+  std::vector<FecXorOptimization> optimizations = {FecXorOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(FecXorOptimization::kSse2);
+  }
+  if (GetCpuSupportsAvx2()) {
+    optimizations.push_back(FecXorOptimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(FecXorOptimization::kNeon);
+#endif
+  return optimizations;
+}
+
 MediaPacketGenerator::MediaPacketGenerator(uint32_t min_packet_size,
                                            uint32_t max_packet_size,
                                            uint32_t ssrc,
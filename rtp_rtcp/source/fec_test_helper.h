@@ -12,7 +12,9 @@
 #define MODULES_RTP_RTCP_SOURCE_FEC_TEST_HELPER_H_
 
 #include <memory>
+#include <vector>
 
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/forward_error_correction.h"
 #include "rtc_base/random.h"
 
@@ -20,6 +22,10 @@ namespace webrtc {
 namespace test {
 namespace fec {
 
+// Returns the FEC XOR kernels that can run on this CPU, starting with the
+// portable one.
+std::vector<FecXorOptimization> AvailableFecXorOptimizations();
+
 struct AugmentedPacket : public ForwardErrorCorrection::Packet {
   RTPHeader header;
 };
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#include "modules/utility/include/cpu_features.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+// Processes eight bytes at a time through unaligned 64-bit loads. memcpy()
+// is turned into a single load/store by the compiler.
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t a;
+    uint64_t b;
+    memcpy(&a, src + i, 8);
+    memcpy(&b, dst + i, 8);
+    b ^= a;
+    memcpy(dst + i, &b, 8);
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_Sse2(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    const __m128i s0 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i s1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+    const __m128i s2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+    const __m128i s3 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+    __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d), s0));
+    _mm_storeu_si128(d + 1, _mm_xor_si128(_mm_loadu_si128(d + 1), s1));
+    _mm_storeu_si128(d + 2, _mm_xor_si128(_mm_loadu_si128(d + 2), s2));
+    _mm_storeu_si128(d + 3, _mm_xor_si128(_mm_loadu_si128(d + 3), s3));
+  }
+  for (; i + 16 <= length; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d), s));
+  }
+  XorBytes_C(src + i, length - i, dst + i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void XorBytes_Neon(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    const uint8x16_t s0 = vld1q_u8(src + i);
+    const uint8x16_t s1 = vld1q_u8(src + i + 16);
+    const uint8x16_t s2 = vld1q_u8(src + i + 32);
+    const uint8x16_t s3 = vld1q_u8(src + i + 48);
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), s0));
+    vst1q_u8(dst + i + 16, veorq_u8(vld1q_u8(dst + i + 16), s1));
+    vst1q_u8(dst + i + 32, veorq_u8(vld1q_u8(dst + i + 32), s2));
+    vst1q_u8(dst + i + 48, veorq_u8(vld1q_u8(dst + i + 48), s3));
+  }
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vld1q_u8(src + i)));
+  }
+  XorBytes_C(src + i, length - i, dst + i);
+}
+#endif
+
+}  // namespace
+
+FecXorOptimization DetectFecXorOptimization() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCpuSupportsAvx2()) {
+    return FecXorOptimization::kAvx2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return FecXorOptimization::kSse2;
+  }
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+  return FecXorOptimization::kNeon;
+#endif
+
+  return FecXorOptimization::kNone;
+}
+
+FecXorOptimization GetFecXorOptimization() {
+  static const FecXorOptimization optimization = DetectFecXorOptimization();
+  return optimization;
+}
+
+void XorBytes(FecXorOptimization optimization,
+              const uint8_t* src,
+              size_t length,
+              uint8_t* dst) {
+  RTC_DCHECK(src + length <= dst || dst + length <= src || src == dst);
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case FecXorOptimization::kAvx2:
+      fec_xor_impl::XorBytes_Avx2(src, length, dst);
+      break;
+    case FecXorOptimization::kSse2:
+      XorBytes_Sse2(src, length, dst);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case FecXorOptimization::kNeon:
+      XorBytes_Neon(src, length, dst);
+      break;
+#endif
+    default:
+      XorBytes_C(src, length, dst);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// Instruction set used by the FEC XOR kernels.
+enum class FecXorOptimization { kNone, kSse2, kAvx2, kNeon };
+
+// Returns the widest XOR kernel supported by the CPU.
+FecXorOptimization DetectFecXorOptimization();
+
+// Returns DetectFecXorOptimization(), computed once per process.
+FecXorOptimization GetFecXorOptimization();
+
+// Computes dst[i] ^= src[i] for all i in [0, length). The buffers may have any
+// alignment but must not partially overlap.
+void XorBytes(FecXorOptimization optimization,
+              const uint8_t* src,
+              size_t length,
+              uint8_t* dst);
+
+namespace fec_xor_impl {
+
+// Exposed for the AVX2 translation unit, which is compiled with its own
+// target flags.
+void XorBytes_Avx2(const uint8_t* src, size_t length, uint8_t* dst);
+
+}  // namespace fec_xor_impl
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+namespace webrtc {
+namespace fec_xor_impl {
+
+void XorBytes_Avx2(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 128 <= length; i += 128) {
+    const __m256i s0 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i s1 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+    const __m256i s2 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+    const __m256i s3 =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+    __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), s0));
+    _mm256_storeu_si256(d + 1,
+                        _mm256_xor_si256(_mm256_loadu_si256(d + 1), s1));
+    _mm256_storeu_si256(d + 2,
+                        _mm256_xor_si256(_mm256_loadu_si256(d + 2), s2));
+    _mm256_storeu_si256(d + 3,
+                        _mm256_xor_si256(_mm256_loadu_si256(d + 3), s3));
+  }
+  for (; i + 32 <= length; i += 32) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), s));
+  }
+  if (i + 16 <= length) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d), s));
+    i += 16;
+  }
+  for (; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+}  // namespace fec_xor_impl
+}  // namespace webrtc
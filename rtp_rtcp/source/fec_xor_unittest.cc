@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxLength = 1500;
+
+void FillRandom(Random* random, std::vector<uint8_t>* data) {
+  for (uint8_t& byte : *data) {
+    byte = random->Rand<uint8_t>();
+  }
+}
+
+}  // namespace
+
+// Verifies that every available kernel matches a byte-wise reference for all
+// lengths and for misaligned source and destination pointers.
+TEST(FecXorTest, MatchesReferenceForAllLengthsAndAlignments) {
+  Random random(0x5eed);
+  std::vector<uint8_t> src(kMaxLength + 16);
+  std::vector<uint8_t> dst(kMaxLength + 16);
+  for (FecXorOptimization optimization :
+       test::fec::AvailableFecXorOptimizations()) {
+    for (size_t src_offset : {0, 1, 7}) {
+      for (size_t dst_offset : {0, 3, 8}) {
+        for (size_t length = 0; length <= kMaxLength; length += 13) {
+          FillRandom(&random, &src);
+          FillRandom(&random, &dst);
+          std::vector<uint8_t> expected = dst;
+          for (size_t i = 0; i < length; ++i) {
+            expected[dst_offset + i] ^= src[src_offset + i];
+          }
+          XorBytes(optimization, src.data() + src_offset, length,
+                   dst.data() + dst_offset);
+          ASSERT_EQ(expected, dst)
+              << "optimization=" << static_cast<int>(optimization)
+              << " length=" << length << " src_offset=" << src_offset
+              << " dst_offset=" << dst_offset;
+        }
+      }
+    }
+  }
+}
+
+TEST(FecXorTest, XorWithSelfClears) {
+  Random random(0x1234);
+  std::vector<uint8_t> data(kMaxLength);
+  for (FecXorOptimization optimization :
+       test::fec::AvailableFecXorOptimizations()) {
+    FillRandom(&random, &data);
+    XorBytes(optimization, data.data(), data.size(), data.data());
+    EXPECT_EQ(std::vector<uint8_t>(kMaxLength, 0), data);
+  }
+}
+
+TEST(FecXorTest, DetectedOptimizationIsAvailable) {
+  const std::vector<FecXorOptimization> optimizations =
+      test::fec::AvailableFecXorOptimizations();
+  EXPECT_EQ(optimizations.back(), DetectFecXorOptimization());
+  EXPECT_EQ(DetectFecXorOptimization(), GetFecXorOptimization());
+}
+
+}  // namespace webrtc
@@ -12,6 +12,8 @@
 
 #include <string.h>
 
+#include <utility>
+
 #include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/checks.h"
@@ -50,6 +52,7 @@ FlexfecReceiver::FlexfecReceiver(
       recovered_packet_receiver_(recovered_packet_receiver),
       clock_(clock),
       last_recovered_packet_ms_(-1) {
+  erasure_code_->EnablePacketPool();
   // It's OK to create this object on a different thread/task queue than
   // the one used during main operation.
   sequence_checker_.Detach();
@@ -107,8 +110,7 @@ FlexfecReceiver::AddReceivedPacket(const RtpPacketReceived& packet) {
     ++packet_counter_.num_fec_packets;
 
     // Insert packet payload into erasure code.
-    received_packet->pkt = rtc::scoped_refptr<ForwardErrorCorrection::Packet>(
-        new ForwardErrorCorrection::Packet());
+    received_packet->pkt = erasure_code_->AllocatePacket();
     received_packet->pkt->data =
         packet.Buffer().Slice(packet.headers_size(), packet.payload_size());
   } else {
@@ -120,10 +122,14 @@ FlexfecReceiver::AddReceivedPacket(const RtpPacketReceived& packet) {
     received_packet->is_fec = false;
 
     // Insert entire packet into erasure code.
-    // Create a copy and fill with zeros all mutable extensions.
-    received_packet->pkt = rtc::scoped_refptr<ForwardErrorCorrection::Packet>(
-        new ForwardErrorCorrection::Packet());
+    // Create a copy and fill with zeros all mutable extensions. The copy is
+    // made into the reused storage of a pooled packet, and zeroed in place.
+    received_packet->pkt = erasure_code_->AllocatePacket();
+    received_packet->pkt->data.SetData(packet.data(), packet.size());
     RtpPacketReceived packet_copy(packet);
+    if (!packet_copy.Parse(std::move(received_packet->pkt->data))) {
+      return nullptr;
+    }
     packet_copy.ZeroMutableExtensions();
     received_packet->pkt->data = packet_copy.Buffer();
   }
@@ -19,12 +19,14 @@
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/mod_ops.h"
+#include "rtc_base/ref_counted_object.h"
 
 namespace webrtc {
 
@@ -34,6 +36,13 @@ constexpr size_t kTransportOverhead = 28;
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : data(0), ref_count_(0) {}
+ForwardErrorCorrection::Packet::Packet(const Packet& other)
+    : data(other.data), ref_count_(0) {}
+ForwardErrorCorrection::Packet& ForwardErrorCorrection::Packet::operator=(
+    const Packet& other) {
+  data = other.data;
+  return *this;
+}
 ForwardErrorCorrection::Packet::~Packet() = default;
 
 int32_t ForwardErrorCorrection::Packet::AddRef() {
@@ -43,11 +52,66 @@ int32_t ForwardErrorCorrection::Packet::AddRef() {
 int32_t ForwardErrorCorrection::Packet::Release() {
   int32_t ref_count;
   ref_count = --ref_count_;
-  if (ref_count == 0)
-    delete this;
+  if (ref_count == 0) {
+    if (pool_) {
+      // The pool may be destroyed, and this packet with it, when |pool| goes
+      // out of scope, so |this| must not be touched after Recycle().
+      rtc::scoped_refptr<PacketPool> pool = std::move(pool_);
+      pool->Recycle(this);
+    } else {
+      delete this;
+    }
+  }
   return ref_count;
 }
 
+ForwardErrorCorrection::PacketPool::PacketPool(size_t max_free_packets)
+    : max_free_packets_(max_free_packets) {
+  free_packets_.reserve(max_free_packets_);
+}
+
+ForwardErrorCorrection::PacketPool::~PacketPool() {
+  for (Packet* packet : free_packets_) {
+    delete packet;
+  }
+}
+
+rtc::scoped_refptr<ForwardErrorCorrection::Packet>
+ForwardErrorCorrection::PacketPool::Allocate() {
+  Packet* packet;
+  if (free_packets_.empty()) {
+    packet = new Packet();
+    packet->data.EnsureCapacity(IP_PACKET_SIZE);
+    ++stats_.num_allocated_packets;
+  } else {
+    packet = free_packets_.back();
+    free_packets_.pop_back();
+    ++stats_.num_reused_packets;
+  }
+  packet->pool_ = this;
+  return packet;
+}
+
+ForwardErrorCorrection::PacketPoolStats
+ForwardErrorCorrection::PacketPool::GetStats() const {
+  PacketPoolStats stats = stats_;
+  stats.num_free_packets = free_packets_.size();
+  return stats;
+}
+
+void ForwardErrorCorrection::PacketPool::Recycle(Packet* packet) {
+  RTC_DCHECK_EQ(packet->ref_count_, 0);
+  RTC_DCHECK(!packet->pool_);
+  if (free_packets_.size() >= max_free_packets_) {
+    delete packet;
+    return;
+  }
+  // Keeps the capacity, unless the buffer is shared with someone else, in
+  // which case the next EnsureCapacity() makes a private copy.
+  packet->data.SetSize(0);
+  free_packets_.push_back(packet);
+}
+
 // This comparator is used to compare std::unique_ptr's pointing to
 // subclasses of SortablePackets. It needs to be parametric since
 // the std::unique_ptr's are not covariant w.r.t. the types that
@@ -349,6 +413,31 @@ void ForwardErrorCorrection::FinalizeFecHeaders(size_t num_fec_packets,
   }
 }
 
+void ForwardErrorCorrection::EnablePacketPool() {
+  if (packet_pool_) {
+    return;
+  }
+  packet_pool_ = new rtc::RefCountedObject<PacketPool>(
+      fec_header_reader_->MaxMediaPackets() +
+      fec_header_reader_->MaxFecPackets());
+}
+
+rtc::scoped_refptr<ForwardErrorCorrection::Packet>
+ForwardErrorCorrection::AllocatePacket() {
+  if (packet_pool_) {
+    return packet_pool_->Allocate();
+  }
+  return new Packet();
+}
+
+ForwardErrorCorrection::PacketPoolStats
+ForwardErrorCorrection::GetPacketPoolStats() const {
+  if (!packet_pool_) {
+    return PacketPoolStats();
+  }
+  return packet_pool_->GetStats();
+}
+
 void ForwardErrorCorrection::ResetState(
     RecoveredPacketList* recovered_packets) {
   // Free the memory for any existing recovered packets, if the caller hasn't.
@@ -542,8 +631,7 @@ void ForwardErrorCorrection::InsertPacket(
 bool ForwardErrorCorrection::StartPacketRecovery(
     const ReceivedFecPacket& fec_packet,
     RecoveredPacket* recovered_packet) {
-  // Ensure pkt is initialized.
-  recovered_packet->pkt = new Packet();
+  RTC_DCHECK(recovered_packet->pkt);
   // Sanity check packet length.
   if (fec_packet.pkt->data.size() <
       fec_packet.fec_header_size + fec_packet.protection_length) {
@@ -623,6 +711,10 @@ void ForwardErrorCorrection::XorHeaders(const Packet& src, Packet* dst) {
   dst_data[7] ^= src_data[7];
 
   // Skip the 9th to 12th bytes of the header.
+  //
+  // Unlike the payload, this is left to the scalar code: the header is eight
+  // bytes with a computed length field in the middle, so a vector kernel would
+  // not save anything over these few byte operations.
 }
 
 void ForwardErrorCorrection::XorPayloads(const Packet& src,
@@ -635,11 +727,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   if (dst_offset + payload_length > dst->data.size()) {
     dst->data.SetSize(dst_offset + payload_length);
   }
-  uint8_t* dst_data = dst->data.data();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  XorBytes(GetFecXorOptimization(), src.data.cdata() + kRtpHeaderSize,
+           payload_length, dst->data.data() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -675,7 +764,7 @@ void ForwardErrorCorrection::AttemptRecovery(
     if (packets_missing == 1) {
       // Recovery possible.
       std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
-      recovered_packet->pkt = nullptr;
+      recovered_packet->pkt = AllocatePacket();
       if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
         // Can't recover using this packet, drop it.
         fec_packet_it = received_fec_packets_.erase(fec_packet_it);
@@ -23,6 +23,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ref_count.h"
 
 namespace webrtc {
 
@@ -41,22 +42,65 @@ class ForwardErrorCorrection {
   // refactored into proper classes, and their members should be made private.
   // This will require parts of the functionality in forward_error_correction.cc
   // and receiver_fec.cc to be refactored into the packet classes.
+  class Packet;
+
+  struct PacketPoolStats {
+    // Number of Packet objects the pool had to allocate from the heap.
+    size_t num_allocated_packets = 0;
+    // Number of times a previously released packet was handed out again.
+    size_t num_reused_packets = 0;
+    // Number of packets currently idle in the pool.
+    size_t num_free_packets = 0;
+  };
+
+  // Recycles Packet objects together with their buffer capacity. Packets
+  // allocated from the pool keep a reference to it, and return to it instead
+  // of being deleted when their own reference count reaches zero. Not thread
+  // safe, like the rest of this class.
+  class PacketPool : public rtc::RefCountInterface {
+   public:
+    explicit PacketPool(size_t max_free_packets);
+    ~PacketPool() override;
+
+    // Returns an empty packet with room for IP_PACKET_SIZE bytes.
+    rtc::scoped_refptr<Packet> Allocate();
+
+    PacketPoolStats GetStats() const;
+
+   private:
+    friend class Packet;
+
+    void Recycle(Packet* packet);
+
+    const size_t max_free_packets_;
+    std::vector<Packet*> free_packets_;
+    PacketPoolStats stats_;
+  };
+
   class Packet {
    public:
     Packet();
+    // Copies the packet data only; the copy is not reference counted and does
+    // not belong to any pool.
+    Packet(const Packet& other);
+    Packet& operator=(const Packet& other);
     virtual ~Packet();
 
     // Add a reference.
     virtual int32_t AddRef();
 
-    // Release a reference. Will delete the object if the reference count
-    // reaches zero.
+    // Release a reference. Will delete the object, or return it to the pool it
+    // was allocated from, if the reference count reaches zero.
     virtual int32_t Release();
 
     rtc::CopyOnWriteBuffer data;  // Packet data.
 
    private:
+    friend class PacketPool;
+
     int32_t ref_count_;  // Counts the number of references to a packet.
+    // Set while the packet is handed out by a PacketPool.
+    rtc::scoped_refptr<PacketPool> pool_;
   };
 
   // TODO(holmer): Refactor into a proper class.
@@ -228,6 +272,19 @@ class ForwardErrorCorrection {
   // accounted for as packet overhead.
   size_t MaxPacketOverhead() const;
 
+  // Enables recycling of packet storage on the decoding side. Recovered
+  // packets, and packets obtained through AllocatePacket(), then return to a
+  // pool when released instead of being freed, so that steady-state decoding
+  // does not allocate packet buffers. The pool keeps at most as many idle
+  // packets as the FEC scheme can have media and FEC packets in flight.
+  void EnablePacketPool();
+
+  // Returns a new, empty packet. Taken from the pool if it is enabled.
+  rtc::scoped_refptr<Packet> AllocatePacket();
+
+  // Returns packet pool statistics. All zero if the pool is not enabled.
+  PacketPoolStats GetPacketPoolStats() const;
+
   // Reset internal states from last frame and clear |recovered_packets|.
   // Frees all memory allocated by this class.
   void ResetState(RecoveredPacketList* recovered_packets);
@@ -293,7 +350,7 @@ class ForwardErrorCorrection {
   void AttemptRecovery(RecoveredPacketList* recovered_packets);
 
   // Initializes headers and payload before the XOR operation
-  // that recovers a packet.
+  // that recovers a packet. |recovered_packet->pkt| must be allocated.
   static bool StartPacketRecovery(const ReceivedFecPacket& fec_packet,
                                   RecoveredPacket* recovered_packet);
 
@@ -339,6 +396,9 @@ class ForwardErrorCorrection {
   std::vector<Packet> generated_fec_packets_;
   ReceivedFecPacketList received_fec_packets_;
 
+  // Null unless EnablePacketPool() has been called.
+  rtc::scoped_refptr<PacketPool> packet_pool_;
+
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
   // (There are never more than |kUlpfecMaxMediaPackets| FEC packets generated.)
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 
 #include "modules/rtp_rtcp/source/fec_private_tables_bursty.h"
 #include "modules/rtp_rtcp/source/fec_private_tables_random.h"
@@ -142,25 +143,30 @@ void ShiftFitSubMask(int num_mask_bytes,
 namespace webrtc {
 namespace internal {
 
-PacketMaskTable::PacketMaskTable(FecMaskType fec_mask_type,
-                                 int num_media_packets)
-    : table_(PickTable(fec_mask_type, num_media_packets)) {}
+namespace {
 
-PacketMaskTable::~PacketMaskTable() = default;
+// Number of (num_media_packets, num_fec_packets) pairs, with
+// 1 <= num_fec_packets <= num_media_packets <= kUlpfecMaxMediaPackets.
+constexpr size_t kNumPacketMasks =
+    kUlpfecMaxMediaPackets * (kUlpfecMaxMediaPackets + 1) / 2;
 
-rtc::ArrayView<const uint8_t> PacketMaskTable::LookUp(int num_media_packets,
-                                                      int num_fec_packets) {
-  RTC_DCHECK_GT(num_media_packets, 0);
-  RTC_DCHECK_GT(num_fec_packets, 0);
-  RTC_DCHECK_LE(num_media_packets, kUlpfecMaxMediaPackets);
-  RTC_DCHECK_LE(num_fec_packets, num_media_packets);
+// Process-wide cache of equal-protection packet masks, indexed by mask table
+// (bursty, random) and by the (num_media_packets, num_fec_packets) pair. Masks
+// found in the tables are cached as pointers into the tables, while generated
+// masks are allocated on first use and kept for the lifetime of the process,
+// so that views returned by PacketMaskTable::LookUp() never dangle.
+std::atomic<const uint8_t*> g_packet_mask_cache[2][kNumPacketMasks];
 
-  if (num_media_packets <= 12) {
-    return LookUpInFecTable(table_, num_media_packets - 1, num_fec_packets - 1);
-  }
-  int mask_length =
-      static_cast<int>(PacketMaskSize(static_cast<size_t>(num_media_packets)));
+size_t CacheIndex(int num_media_packets, int num_fec_packets) {
+  return (num_media_packets - 1) * num_media_packets / 2 + num_fec_packets - 1;
+}
 
+// Generates the interleaved mask used when there are more media packets than
+// covered by the mask tables.
+void GenerateInterleavedMask(int num_media_packets,
+                             int num_fec_packets,
+                             int mask_length,
+                             uint8_t* packet_mask) {
   // Generate FEC code mask for {num_media_packets(M), num_fec_packets(N)} (use
   // N FEC packets to protect M media packets) In the mask, each FEC packet
   // occupies one row, each bit / coloumn represent one media packet. E.g. Row
@@ -174,7 +180,7 @@ rtc::ArrayView<const uint8_t> PacketMaskTable::LookUp(int num_media_packets,
     // FEC packet. In this implementation, the protection is interleaved, thus
     // media packet X will be protected by FEC packet (X % N)
     for (int col = 0; col < mask_length; col++) {
-      fec_packet_mask_[row * mask_length + col] =
+      packet_mask[row * mask_length + col] =
           ((col * 8) % num_fec_packets == row && (col * 8) < num_media_packets
                ? 0x80
                : 0x00) |
@@ -208,8 +214,56 @@ rtc::ArrayView<const uint8_t> PacketMaskTable::LookUp(int num_media_packets,
                : 0x00);
     }
   }
-  return {&fec_packet_mask_[0],
-          static_cast<size_t>(num_fec_packets * mask_length)};
+}
+
+}  // namespace
+
+PacketMaskTable::PacketMaskTable(FecMaskType fec_mask_type,
+                                 int num_media_packets)
+    : table_(PickTable(fec_mask_type, num_media_packets)) {}
+
+PacketMaskTable::~PacketMaskTable() = default;
+
+rtc::ArrayView<const uint8_t> PacketMaskTable::LookUp(int num_media_packets,
+                                                      int num_fec_packets) {
+  RTC_DCHECK_GT(num_media_packets, 0);
+  RTC_DCHECK_GT(num_fec_packets, 0);
+  RTC_DCHECK_LE(num_media_packets, kUlpfecMaxMediaPackets);
+  RTC_DCHECK_LE(num_fec_packets, num_media_packets);
+
+  const size_t mask_size =
+      num_fec_packets * PacketMaskSize(static_cast<size_t>(num_media_packets));
+  const int table_index =
+      table_ == &fec_private_tables::kPacketMaskBurstyTbl[0] ? 0 : 1;
+  std::atomic<const uint8_t*>& cached_mask =
+      g_packet_mask_cache[table_index][CacheIndex(num_media_packets,
+                                                  num_fec_packets)];
+  const uint8_t* mask = cached_mask.load(std::memory_order_acquire);
+  if (mask != nullptr) {
+    return {mask, mask_size};
+  }
+
+  if (num_media_packets <= 12) {
+    mask = LookUpInFecTable(table_, num_media_packets - 1, num_fec_packets - 1)
+               .data();
+    cached_mask.store(mask, std::memory_order_release);
+    return {mask, mask_size};
+  }
+
+  // The generated mask is owned by the cache and intentionally never freed.
+  // If another thread raced us to populate the entry, use its copy instead.
+  uint8_t* generated_mask = new uint8_t[mask_size];
+  GenerateInterleavedMask(num_media_packets, num_fec_packets,
+                          static_cast<int>(mask_size / num_fec_packets),
+                          generated_mask);
+  const uint8_t* expected = nullptr;
+  if (!cached_mask.compare_exchange_strong(expected, generated_mask,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+    delete[] generated_mask;
+    return {expected, mask_size};
+  }
+  return {generated_mask, mask_size};
 }
 
 // If |num_media_packets| is larger than the maximum allowed by |fec_mask_type|
@@ -43,6 +43,9 @@ class PacketMaskTable {
   PacketMaskTable(FecMaskType fec_mask_type, int num_media_packets);
   ~PacketMaskTable();
 
+  // Returns the equal-protection mask for the given number of media and FEC
+  // packets. Masks are cached process-wide on first use, so the returned view
+  // stays valid after this object has been destroyed.
   rtc::ArrayView<const uint8_t> LookUp(int num_media_packets,
                                        int num_fec_packets);
 
@@ -50,7 +53,6 @@ class PacketMaskTable {
   static const uint8_t* PickTable(FecMaskType fec_mask_type,
                                   int num_media_packets);
   const uint8_t* table_;
-  uint8_t fec_packet_mask_[kFECPacketMaskMaxSize];
 };
 
 rtc::ArrayView<const uint8_t> LookUpInFecTable(const uint8_t* table,
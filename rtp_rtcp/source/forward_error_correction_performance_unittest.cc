@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kXorIterations = 20000;
+constexpr int kEncodeIterations = 2000;
+constexpr uint32_t kMediaSsrc = 1254983;
+
+const char* OptimizationName(FecXorOptimization optimization) {
+  switch (optimization) {
+    case FecXorOptimization::kNone:
+      return "c";
+    case FecXorOptimization::kSse2:
+      return "sse2";
+    case FecXorOptimization::kAvx2:
+      return "avx2";
+    case FecXorOptimization::kNeon:
+      return "neon";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+// Measures the raw XOR throughput of each kernel across typical RTP payload
+// sizes.
+TEST(ForwardErrorCorrectionPerformanceTest, DISABLED_XorKernels) {
+  Random random(0x600d);
+  std::vector<uint8_t> src(IP_PACKET_SIZE);
+  std::vector<uint8_t> dst(IP_PACKET_SIZE);
+  for (uint8_t& byte : src) {
+    byte = random.Rand<uint8_t>();
+  }
+  for (size_t packet_size : {100, 300, 600, 1200, 1500}) {
+    for (FecXorOptimization optimization :
+         test::fec::AvailableFecXorOptimizations()) {
+      const int64_t start_us = rtc::TimeMicros();
+      for (int i = 0; i < kXorIterations; ++i) {
+        XorBytes(optimization, src.data(), packet_size, dst.data());
+      }
+      const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      rtc::StringBuilder story;
+      story << OptimizationName(optimization) << "_" << packet_size << "B";
+      test::PrintResult("fec_xor_time_per_packet", "", story.str(),
+                        1000.0 * elapsed_us / kXorIterations, "ns", false);
+    }
+  }
+}
+
+// Measures ULPFEC encode time per frame across protection factors, i.e.
+// across FEC mask densities, for random and bursty masks.
+TEST(ForwardErrorCorrectionPerformanceTest, DISABLED_UlpfecEncode) {
+  Random random(0xfec);
+  test::fec::MediaPacketGenerator media_packet_generator(
+      1000, IP_PACKET_SIZE - 100, kMediaSsrc, &random);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  for (FecMaskType mask_type : {kFecMaskRandom, kFecMaskBursty}) {
+    for (int num_media_packets : {4, 12, 24, 48}) {
+      ForwardErrorCorrection::PacketList media_packets =
+          media_packet_generator.ConstructMediaPackets(num_media_packets);
+      for (uint8_t protection_factor : {26, 77, 128, 255}) {
+        std::list<ForwardErrorCorrection::Packet*> fec_packets;
+        const int64_t start_us = rtc::TimeMicros();
+        for (int i = 0; i < kEncodeIterations; ++i) {
+          fec_packets.clear();
+          ASSERT_EQ(0, fec->EncodeFec(media_packets, protection_factor, 0,
+                                      false, mask_type, &fec_packets));
+        }
+        const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+        rtc::StringBuilder story;
+        story << (mask_type == kFecMaskRandom ? "random" : "bursty") << "_"
+              << num_media_packets << "media_"
+              << static_cast<int>(protection_factor) << "pf";
+        test::PrintResult("ulpfec_encode_time_per_frame", "", story.str(),
+                          static_cast<double>(elapsed_us) / kEncodeIterations,
+                          "us", false);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
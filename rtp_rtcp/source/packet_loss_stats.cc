@@ -11,40 +11,62 @@
 #include "modules/rtp_rtcp/source/packet_loss_stats.h"
 
 #include <cstdint>
-#include <iterator>
-#include <vector>
 
 #include "rtc_base/checks.h"
 
-// After this many packets are added, adding additional packets will cause the
-// oldest packets to be pruned from the buffer.
-static const int kBufferSize = 100;
-
 namespace webrtc {
+namespace {
+
+int PopCount(uint64_t bits) {
+  bits = bits - ((bits >> 1) & 0x5555555555555555ull);
+  bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+  bits = (bits + (bits >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return static_cast<int>((bits * 0x0101010101010101ull) >> 56);
+}
+
+// Returns 64 if no bit is set.
+int CountTrailingZeros(uint64_t bits) {
+  return PopCount((bits & (~bits + 1)) - 1);
+}
+
+}  // namespace
+
+constexpr int PacketLossStats::kBitsPerWord;
+constexpr int PacketLossStats::kNumWords;
+constexpr int PacketLossStats::kWindowSize;
 
 PacketLossStats::PacketLossStats()
-    : single_loss_historic_count_(0),
+    : window_start_(0),
+      has_lost_packets_(false),
+      pruned_loss_length_(0),
+      single_loss_historic_count_(0),
       multiple_loss_historic_event_count_(0),
-      multiple_loss_historic_packet_count_(0) {}
+      multiple_loss_historic_packet_count_(0) {
+  lost_packets_bitmap_.fill(0);
+}
 
 PacketLossStats::~PacketLossStats() = default;
 
 void PacketLossStats::AddLostPacket(uint16_t sequence_number) {
-  // Detect sequence number wrap around.
-  if (!lost_packets_buffer_.empty() &&
-      static_cast<int>(*(lost_packets_buffer_.rbegin())) - sequence_number >
-          0x8000) {
-    // The buffer contains large numbers and this is a small number.
-    lost_packets_wrapped_buffer_.insert(sequence_number);
-  } else {
-    lost_packets_buffer_.insert(sequence_number);
+  // Place the window so that |sequence_number| is in its last word, leaving
+  // room for packets reported out of order.
+  const uint16_t window_start = static_cast<uint16_t>(
+      (sequence_number & ~(kBitsPerWord - 1)) - (kWindowSize - kBitsPerWord));
+  if (!has_lost_packets_) {
+    has_lost_packets_ = true;
+    window_start_ = window_start;
   }
-  if (lost_packets_wrapped_buffer_.size() + lost_packets_buffer_.size() >
-          kBufferSize ||
-      (!lost_packets_wrapped_buffer_.empty() &&
-       *(lost_packets_wrapped_buffer_.rbegin()) > 0x4000)) {
-    PruneBuffer();
+  const uint16_t offset =
+      static_cast<uint16_t>(sequence_number - window_start_);
+  if (offset >= kWindowSize) {
+    if (offset >= 0x8000) {
+      // Older than the window, probably a loss reported again.
+      return;
+    }
+    MoveWindow(window_start);
   }
+  lost_packets_bitmap_[(sequence_number / kBitsPerWord) % kNumWords] |=
+      uint64_t{1} << (sequence_number % kBitsPerWord);
 }
 
 int PacketLossStats::GetSingleLossCount() const {
@@ -72,70 +94,87 @@ void PacketLossStats::ComputeLossCounts(
   *out_single_loss_count = single_loss_historic_count_;
   *out_multiple_loss_event_count = multiple_loss_historic_event_count_;
   *out_multiple_loss_packet_count = multiple_loss_historic_packet_count_;
-  if (lost_packets_buffer_.empty()) {
-    RTC_DCHECK(lost_packets_wrapped_buffer_.empty());
-    return;
-  }
-  uint16_t last_num = 0;
-  int sequential_count = 0;
-  std::vector<const std::set<uint16_t>*> buffers;
-  buffers.push_back(&lost_packets_buffer_);
-  buffers.push_back(&lost_packets_wrapped_buffer_);
-  for (const auto* buffer : buffers) {
-    for (auto it = buffer->begin(); it != buffer->end(); ++it) {
-      uint16_t current_num = *it;
-      if (sequential_count > 0 && current_num != ((last_num + 1) & 0xFFFF)) {
-        if (sequential_count == 1) {
-          (*out_single_loss_count)++;
-        } else {
-          (*out_multiple_loss_event_count)++;
-          *out_multiple_loss_packet_count += sequential_count;
-        }
-        sequential_count = 0;
-      }
-      sequential_count++;
-      last_num = current_num;
-    }
+  // A loss event starts at a lost packet that follows a received one, and
+  // ends at a lost packet followed by a received one. The window end is
+  // treated as a received packet.
+  const int first_word = window_start_ / kBitsPerWord;
+  uint64_t previous_bit = pruned_loss_length_ > 0 ? 1 : 0;
+  int lost_count = 0;
+  int event_count = 0;
+  int single_loss_count = 0;
+  for (int i = 0; i < kNumWords; ++i) {
+    const uint64_t word = lost_packets_bitmap_[(first_word + i) % kNumWords];
+    const uint64_t next_bit =
+        i + 1 < kNumWords
+            ? lost_packets_bitmap_[(first_word + i + 1) % kNumWords] & 1
+            : 0;
+    const uint64_t event_starts = word & ~((word << 1) | previous_bit);
+    const uint64_t event_ends = word & ~((word >> 1) | (next_bit << 63));
+    lost_count += PopCount(word);
+    event_count += PopCount(event_starts);
+    single_loss_count += PopCount(event_starts & event_ends);
+    previous_bit = word >> 63;
   }
-  if (sequential_count == 1) {
+  *out_single_loss_count += single_loss_count;
+  *out_multiple_loss_event_count += event_count - single_loss_count;
+  *out_multiple_loss_packet_count += lost_count - single_loss_count;
+
+  if (pruned_loss_length_ == 0)
+    return;
+  const bool continues_in_window =
+      (lost_packets_bitmap_[first_word % kNumWords] & 1) != 0;
+  if (continues_in_window) {
+    // The packets in the window are already counted above.
+    (*out_multiple_loss_event_count)++;
+    *out_multiple_loss_packet_count += pruned_loss_length_;
+  } else if (pruned_loss_length_ == 1) {
     (*out_single_loss_count)++;
-  } else if (sequential_count > 1) {
+  } else {
     (*out_multiple_loss_event_count)++;
-    *out_multiple_loss_packet_count += sequential_count;
+    *out_multiple_loss_packet_count += pruned_loss_length_;
+  }
+}
+
+void PacketLossStats::MoveWindow(uint16_t window_start) {
+  const int num_pruned_words =
+      static_cast<uint16_t>(window_start - window_start_) / kBitsPerWord;
+  for (int i = 0; i < num_pruned_words && i < kNumWords; ++i) {
+    uint64_t& word = lost_packets_bitmap_[(window_start_ / kBitsPerWord + i) %
+                                          kNumWords];
+    PruneWord(word);
+    word = 0;
+  }
+  if (num_pruned_words > kNumWords) {
+    // There is a gap between the pruned words and the new window.
+    FinishPrunedLoss();
   }
+  window_start_ = window_start;
 }
 
-void PacketLossStats::PruneBuffer() {
-  // Remove the oldest lost packet and any contiguous packets and move them
-  // into the historic counts.
-  auto it = lost_packets_buffer_.begin();
-  uint16_t last_removed = 0;
-  int remove_count = 0;
-  // Count adjacent packets and continue counting if it is wrap around by
-  // swapping in the wrapped buffer and letting our value wrap as well.
-  while (remove_count == 0 || (!lost_packets_buffer_.empty() &&
-                               *it == ((last_removed + 1) & 0xFFFF))) {
-    last_removed = *it;
-    remove_count++;
-    auto to_erase = it++;
-    lost_packets_buffer_.erase(to_erase);
-    if (lost_packets_buffer_.empty()) {
-      lost_packets_buffer_.swap(lost_packets_wrapped_buffer_);
-      it = lost_packets_buffer_.begin();
+void PacketLossStats::PruneWord(uint64_t word) {
+  int position = 0;
+  while (position < kBitsPerWord) {
+    const uint64_t remaining = word >> position;
+    if (remaining & 1) {
+      // Bits shifted in from above are zero, so this stops at the word end.
+      const int length = CountTrailingZeros(~remaining);
+      pruned_loss_length_ += length;
+      position += length;
+    } else {
+      FinishPrunedLoss();
+      position += CountTrailingZeros(remaining);
     }
   }
-  if (remove_count > 1) {
+}
+
+void PacketLossStats::FinishPrunedLoss() {
+  if (pruned_loss_length_ > 1) {
     multiple_loss_historic_event_count_++;
-    multiple_loss_historic_packet_count_ += remove_count;
-  } else {
+    multiple_loss_historic_packet_count_ += pruned_loss_length_;
+  } else if (pruned_loss_length_ == 1) {
     single_loss_historic_count_++;
   }
-  // Continue pruning if the wrapped buffer is beyond a threshold and there are
-  // things left in the pre-wrapped buffer.
-  if (!lost_packets_wrapped_buffer_.empty() &&
-      *(lost_packets_wrapped_buffer_.rbegin()) > 0x4000) {
-    PruneBuffer();
-  }
+  pruned_loss_length_ = 0;
 }
 
 }  // namespace webrtc
@@ -13,12 +13,15 @@
 
 #include <stdint.h>
 
-#include <set>
+#include <array>
 
 namespace webrtc {
 
 // Keeps track of statistics of packet loss including whether losses are a
 // single packet or multiple packets in a row.
+// The most recent sequence numbers are kept in a bitmap. Losses that fall out
+// of it are moved into historic counts, and losses reported for sequence
+// numbers older than the bitmap are ignored.
 class PacketLossStats {
  public:
   PacketLossStats();
@@ -41,8 +44,21 @@ class PacketLossStats {
   int GetMultipleLossPacketCount() const;
 
  private:
-  std::set<uint16_t> lost_packets_buffer_;
-  std::set<uint16_t> lost_packets_wrapped_buffer_;
+  static constexpr int kBitsPerWord = 64;
+  static constexpr int kNumWords = 16;
+  static constexpr int kWindowSize = kBitsPerWord * kNumWords;
+
+  // Bit |sequence_number % kWindowSize| is set when that packet was lost.
+  // Since 2^16 is a multiple of kWindowSize, the word of a sequence number
+  // does not change when sequence numbers wrap around.
+  std::array<uint64_t, kNumWords> lost_packets_bitmap_;
+  // The oldest sequence number covered by the bitmap. Always the first bit of
+  // a word.
+  uint16_t window_start_;
+  bool has_lost_packets_;
+  // Length of the loss event that ends right before |window_start_|. It is
+  // not counted yet, since it may continue into the bitmap.
+  int pruned_loss_length_;
   int single_loss_historic_count_;
   int multiple_loss_historic_event_count_;
   int multiple_loss_historic_packet_count_;
@@ -50,7 +66,11 @@ class PacketLossStats {
   void ComputeLossCounts(int* out_single_loss_count,
                          int* out_multiple_loss_event_count,
                          int* out_multiple_loss_packet_count) const;
-  void PruneBuffer();
+  // Moves the window forward so that it starts at |window_start|, pruning the
+  // words that fall out of it into the historic counts.
+  void MoveWindow(uint16_t window_start);
+  void PruneWord(uint64_t word);
+  void FinishPrunedLoss();
 };
 
 }  // namespace webrtc
@@ -195,4 +195,25 @@ TEST_F(PacketLossStatsTest, OutOfOrderWrapped) {
   EXPECT_EQ(400, stats_.GetMultipleLossPacketCount());
 }
 
+// Report the same losses several times, as happens when packets are NACKed
+// repeatedly, and ensure that they are only counted once.
+TEST_F(PacketLossStatsTest, RepeatedLossesCountedOnce) {
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    for (int i = 0; i < 100; i += 10) {
+      stats_.AddLostPacket(i);
+      stats_.AddLostPacket(i + 4);
+      stats_.AddLostPacket(i + 5);
+    }
+  }
+  // Push the losses out of the tracked window and then report them again.
+  for (int i = 5000; i < 5010; i += 2) {
+    stats_.AddLostPacket(i);
+  }
+  stats_.AddLostPacket(0);
+  stats_.AddLostPacket(4);
+  EXPECT_EQ(15, stats_.GetSingleLossCount());
+  EXPECT_EQ(10, stats_.GetMultipleLossEventCount());
+  EXPECT_EQ(20, stats_.GetMultipleLossPacketCount());
+}
+
 }  // namespace webrtc
@@ -10,9 +10,11 @@
 
 #include "modules/rtp_rtcp/source/receive_statistics_impl.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "modules/remote_bitrate_estimator/test/bwe_test_logging.h"
@@ -298,54 +300,71 @@ std::unique_ptr<ReceiveStatistics> ReceiveStatistics::Create(Clock* clock) {
   return std::make_unique<ReceiveStatisticsImpl>(clock);
 }
 
+constexpr size_t ReceiveStatisticsImpl::kNumShards;
+
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       last_returned_ssrc_(0),
       max_reordering_threshold_(kDefaultMaxReorderingThreshold) {}
 
 ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
-  while (!statisticians_.empty()) {
-    delete statisticians_.begin()->second;
-    statisticians_.erase(statisticians_.begin());
+  for (Shard& shard : shards_) {
+    rtc::CritScope cs(&shard.lock);
+    for (auto& statistician : shard.statisticians)
+      delete statistician.second;
+    shard.statisticians.clear();
   }
 }
 
+size_t ReceiveStatisticsImpl::ShardIndex(uint32_t ssrc) {
+  // Fibonacci hashing, so that SSRCs differing in any bits spread out.
+  return (ssrc * 2654435761u) >> (32 - kNumShardBits);
+}
+
 void ReceiveStatisticsImpl::OnRtpPacket(const RtpPacketReceived& packet) {
   // StreamStatisticianImpl instance is created once and only destroyed when
   // this whole ReceiveStatisticsImpl is destroyed. StreamStatisticianImpl has
-  // it's own locking so don't hold receive_statistics_lock_ (potential
-  // deadlock).
+  // it's own locking so don't hold the shard lock (potential deadlock).
   GetOrCreateStatistician(packet.Ssrc())->UpdateCounters(packet);
 }
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetStatistician(
     uint32_t ssrc) const {
-  rtc::CritScope cs(&receive_statistics_lock_);
-  const auto& it = statisticians_.find(ssrc);
-  if (it == statisticians_.end())
+  const Shard& shard = shards_[ShardIndex(ssrc)];
+  rtc::CritScope cs(&shard.lock);
+  const auto& it = shard.statisticians.find(ssrc);
+  if (it == shard.statisticians.end())
     return NULL;
   return it->second;
 }
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetOrCreateStatistician(
     uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
-  StreamStatisticianImpl*& impl = statisticians_[ssrc];
+  Shard& shard = shards_[ShardIndex(ssrc)];
+  rtc::CritScope cs(&shard.lock);
+  StreamStatisticianImpl*& impl = shard.statisticians[ssrc];
   if (impl == nullptr) {  // new element
     impl = new StreamStatisticianImpl(ssrc, clock_, max_reordering_threshold_);
   }
   return impl;
 }
 
+std::vector<std::pair<uint32_t, StreamStatisticianImpl*>>
+ReceiveStatisticsImpl::AllStatisticians() const {
+  std::vector<std::pair<uint32_t, StreamStatisticianImpl*>> statisticians;
+  for (const Shard& shard : shards_) {
+    rtc::CritScope cs(&shard.lock);
+    statisticians.insert(statisticians.end(), shard.statisticians.begin(),
+                         shard.statisticians.end());
+  }
+  std::sort(statisticians.begin(), statisticians.end());
+  return statisticians;
+}
+
 void ReceiveStatisticsImpl::SetMaxReorderingThreshold(
     int max_reordering_threshold) {
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians;
-  {
-    rtc::CritScope cs(&receive_statistics_lock_);
-    max_reordering_threshold_ = max_reordering_threshold;
-    statisticians = statisticians_;
-  }
-  for (auto& statistician : statisticians) {
+  max_reordering_threshold_ = max_reordering_threshold;
+  for (auto& statistician : AllStatisticians()) {
     statistician.second->SetMaxReorderingThreshold(max_reordering_threshold);
   }
 }
@@ -364,11 +383,8 @@ void ReceiveStatisticsImpl::EnableRetransmitDetection(uint32_t ssrc,
 
 std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     size_t max_blocks) {
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians;
-  {
-    rtc::CritScope cs(&receive_statistics_lock_);
-    statisticians = statisticians_;
-  }
+  const std::vector<std::pair<uint32_t, StreamStatisticianImpl*>>
+      statisticians = AllStatisticians();
   std::vector<rtcp::ReportBlock> result;
   result.reserve(std::min(max_blocks, statisticians.size()));
   auto add_report_block = [&result](uint32_t media_ssrc,
@@ -390,7 +406,12 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     block.SetJitter(stats.jitter);
   };
 
-  const auto start_it = statisticians.upper_bound(last_returned_ssrc_);
+  const auto start_it = std::upper_bound(
+      statisticians.begin(), statisticians.end(), last_returned_ssrc_,
+      [](uint32_t ssrc,
+         const std::pair<uint32_t, StreamStatisticianImpl*>& statistician) {
+        return ssrc < statistician.first;
+      });
   for (auto it = start_it;
        result.size() < max_blocks && it != statisticians.end(); ++it)
     add_report_block(it->first, it->second);
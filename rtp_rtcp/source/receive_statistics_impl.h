@@ -12,7 +12,10 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <atomic>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -120,14 +123,30 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
  private:
+  // Statisticians are spread over independently locked shards by SSRC, so
+  // that packets of different streams rarely contend for the same lock.
+  static constexpr int kNumShardBits = 4;
+  static constexpr size_t kNumShards = 1 << kNumShardBits;
+  struct Shard {
+    rtc::CriticalSection lock;
+    std::unordered_map<uint32_t, StreamStatisticianImpl*> statisticians
+        RTC_GUARDED_BY(lock);
+  };
+
+  static size_t ShardIndex(uint32_t ssrc);
   StreamStatisticianImpl* GetOrCreateStatistician(uint32_t ssrc);
+  // Returns a snapshot of all statisticians sorted by SSRC. Each shard is
+  // locked only while it is being copied.
+  std::vector<std::pair<uint32_t, StreamStatisticianImpl*>> AllStatisticians()
+      const;
 
   Clock* const clock_;
-  rtc::CriticalSection receive_statistics_lock_;
   uint32_t last_returned_ssrc_;
-  int max_reordering_threshold_ RTC_GUARDED_BY(receive_statistics_lock_);
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians_
-      RTC_GUARDED_BY(receive_statistics_lock_);
+  // Used for statisticians created from now on. Read with a shard lock held
+  // and written before the shards are visited, so no statistician misses an
+  // update.
+  std::atomic<int> max_reordering_threshold_;
+  std::array<Shard, kNumShards> shards_;
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
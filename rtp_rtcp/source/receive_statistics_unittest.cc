@@ -22,6 +22,7 @@
 namespace webrtc {
 namespace {
 
+using ::testing::ElementsAreArray;
 using ::testing::SizeIs;
 using ::testing::UnorderedElementsAre;
 
@@ -174,6 +175,33 @@ TEST_F(ReceiveStatisticsTest,
               UnorderedElementsAre(kSsrc1, kSsrc2, kSsrc3, kSsrc4));
 }
 
+TEST_F(ReceiveStatisticsTest,
+       RtcpReportBlocksCyclesThroughManySsrcsInSsrcOrder) {
+  constexpr int kNumSsrcs = 100;
+  constexpr size_t kMaxBlocks = 31;
+  std::vector<uint32_t> ssrcs;
+  for (int i = 0; i < kNumSsrcs; ++i) {
+    ssrcs.push_back(0x10000000 + 0x01010101 * i);
+  }
+  // Report blocks are only produced for streams that received packets since
+  // the last report, so feed every stream before each call.
+  std::vector<uint32_t> observed_ssrcs;
+  while (observed_ssrcs.size() < ssrcs.size()) {
+    for (uint32_t ssrc : ssrcs) {
+      RtpPacketReceived packet = CreateRtpPacket(ssrc, kPacketSize1);
+      receive_statistics_->OnRtpPacket(packet);
+    }
+    std::vector<rtcp::ReportBlock> report_blocks =
+        receive_statistics_->RtcpReportBlocks(kMaxBlocks);
+    ASSERT_THAT(report_blocks, SizeIs(kMaxBlocks));
+    for (const rtcp::ReportBlock& block : report_blocks) {
+      if (observed_ssrcs.size() < ssrcs.size())
+        observed_ssrcs.push_back(block.source_ssrc());
+    }
+  }
+  EXPECT_THAT(observed_ssrcs, ElementsAreArray(ssrcs));
+}
+
 TEST_F(ReceiveStatisticsTest, ActiveStatisticians) {
   receive_statistics_->OnRtpPacket(packet1_);
   IncrementSequenceNumber(&packet1_);
@@ -71,6 +71,42 @@ constexpr int64_t kTimeWrapPeriodUs = (1ll << 24) * kBaseScaleFactor;
 //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 //    |           recv delta          |  recv delta   | zero padding  |
 //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+
+// Status vector symbols are converted between their packed form and one byte
+// per symbol a machine word at a time, instead of bit by bit.
+
+// Expands the eight one-bit symbols of |bits|, most significant bit first,
+// into |symbols[0..7]|.
+void SpreadOneBitSymbols(uint8_t bits, uint8_t* symbols) {
+  // Copy |bits| into every byte, keep bit 7 - i in byte i, then turn each
+  // non-zero byte into 1.
+  uint64_t spread = (bits * 0x0101010101010101ull) & 0x0102040810204080ull;
+  spread = ((spread + 0x7f7f7f7f7f7f7f7full) >> 7) & 0x0101010101010101ull;
+  ByteWriter<uint64_t>::WriteLittleEndian(symbols, spread);
+}
+
+// Inverse of SpreadOneBitSymbols(). |symbols[0..7]| must be 0 or 1.
+uint8_t PackOneBitSymbols(const uint8_t* symbols) {
+  // The multiplication moves bit 0 of byte i to bit 63 - i without carries.
+  uint64_t spread = ByteReader<uint64_t>::ReadLittleEndian(symbols);
+  return (spread * 0x8040201008040201ull) >> 56;
+}
+
+// Expands the four two-bit symbols of |bits|, most significant first, into
+// |symbols[0..3]|.
+void SpreadTwoBitSymbols(uint8_t bits, uint8_t* symbols) {
+  uint32_t spread = bits;
+  spread = (spread | (spread << 12)) & 0x000f000f;
+  spread = (spread | (spread << 6)) & 0x03030303;
+  ByteWriter<uint32_t>::WriteBigEndian(symbols, spread);
+}
+
+// Inverse of SpreadTwoBitSymbols(). |symbols[0..3]| must be at most 3.
+uint8_t PackTwoBitSymbols(const uint8_t* symbols) {
+  uint32_t spread = ByteReader<uint32_t>::ReadBigEndian(symbols);
+  spread = (spread | (spread >> 6)) & 0x000f000f;
+  return static_cast<uint8_t>(spread | (spread >> 12));
+}
 }  // namespace
 constexpr uint8_t TransportFeedback::kFeedbackMessageType;
 constexpr size_t TransportFeedback::kMaxReportedPackets;
@@ -79,6 +115,7 @@ constexpr size_t TransportFeedback::LastChunk::kMaxRunLengthCapacity;
 constexpr size_t TransportFeedback::LastChunk::kMaxOneBitCapacity;
 constexpr size_t TransportFeedback::LastChunk::kMaxTwoBitCapacity;
 constexpr size_t TransportFeedback::LastChunk::kMaxVectorCapacity;
+constexpr size_t TransportFeedback::LastChunk::kMaxDecodedPerChunk;
 
 TransportFeedback::LastChunk::LastChunk() {
   Clear();
@@ -173,6 +210,27 @@ void TransportFeedback::LastChunk::Decode(uint16_t chunk, size_t max_size) {
   }
 }
 
+size_t TransportFeedback::LastChunk::DecodeTo(uint16_t chunk,
+                                              size_t max_size,
+                                              DeltaSize* delta_sizes) {
+  if ((chunk & 0x8000) == 0) {
+    size_t size = std::min<size_t>(chunk & 0x1fff, max_size);
+    std::fill_n(delta_sizes, size, (chunk >> 13) & 0x03);
+    return size;
+  }
+  // Symbols are split into a leading byte and the remaining six bits.
+  uint8_t high = chunk >> 6;
+  uint8_t low = chunk << 2;
+  if ((chunk & 0x4000) == 0) {
+    SpreadOneBitSymbols(high, delta_sizes);
+    SpreadOneBitSymbols(low, delta_sizes + 8);
+    return std::min(kMaxOneBitCapacity, max_size);
+  }
+  SpreadTwoBitSymbols(high, delta_sizes);
+  SpreadTwoBitSymbols(low, delta_sizes + 4);
+  return std::min(kMaxTwoBitCapacity, max_size);
+}
+
 //  One Bit Status Vector Chunk
 //
 //  0                   1
@@ -187,10 +245,10 @@ void TransportFeedback::LastChunk::Decode(uint16_t chunk, size_t max_size) {
 uint16_t TransportFeedback::LastChunk::EncodeOneBit() const {
   RTC_DCHECK(!has_large_delta_);
   RTC_DCHECK_LE(size_, kMaxOneBitCapacity);
-  uint16_t chunk = 0x8000;
-  for (size_t i = 0; i < size_; ++i)
-    chunk |= delta_sizes_[i] << (kMaxOneBitCapacity - 1 - i);
-  return chunk;
+  DeltaSize symbols[16] = {};
+  std::copy_n(delta_sizes_, size_, symbols);
+  return 0x8000 | (PackOneBitSymbols(symbols) << 6) |
+         (PackOneBitSymbols(symbols + 8) >> 2);
 }
 
 void TransportFeedback::LastChunk::DecodeOneBit(uint16_t chunk,
@@ -216,10 +274,10 @@ void TransportFeedback::LastChunk::DecodeOneBit(uint16_t chunk,
 //  symbol list = 7 entries of two bits each.
 uint16_t TransportFeedback::LastChunk::EncodeTwoBit(size_t size) const {
   RTC_DCHECK_LE(size, size_);
-  uint16_t chunk = 0xc000;
-  for (size_t i = 0; i < size; ++i)
-    chunk |= delta_sizes_[i] << 2 * (kMaxTwoBitCapacity - 1 - i);
-  return chunk;
+  DeltaSize symbols[8] = {};
+  std::copy_n(delta_sizes_, size, symbols);
+  return 0xc000 | (PackTwoBitSymbols(symbols) << 6) |
+         (PackTwoBitSymbols(symbols + 4) >> 2);
 }
 
 void TransportFeedback::LastChunk::DecodeTwoBit(uint16_t chunk,
@@ -413,31 +471,46 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     return false;
   }
 
-  std::vector<uint8_t> delta_sizes;
-  delta_sizes.reserve(status_count);
-  while (delta_sizes.size() < status_count) {
+  // Delta sizes are decoded straight into a flat array, with room for the
+  // last chunk to write past |status_count|.
+  std::vector<DeltaSize> delta_sizes(status_count +
+                                     LastChunk::kMaxDecodedPerChunk);
+  size_t num_decoded = 0;
+  size_t last_chunk_max_size = 0;
+  uint16_t chunk = 0;
+  encoded_chunks_.reserve(
+      std::min<size_t>(status_count, (end_index - index) / kChunkSizeBytes));
+  while (num_decoded < status_count) {
     if (index + kChunkSizeBytes > end_index) {
       RTC_LOG(LS_WARNING) << "Buffer overflow while parsing packet.";
       Clear();
       return false;
     }
 
-    uint16_t chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[index]);
+    chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[index]);
     index += kChunkSizeBytes;
     encoded_chunks_.push_back(chunk);
-    last_chunk_.Decode(chunk, status_count - delta_sizes.size());
-    last_chunk_.AppendTo(&delta_sizes);
+    last_chunk_max_size = status_count - num_decoded;
+    num_decoded += LastChunk::DecodeTo(chunk, last_chunk_max_size,
+                                       &delta_sizes[num_decoded]);
   }
   // Last chunk is stored in the |last_chunk_|.
   encoded_chunks_.pop_back();
-  RTC_DCHECK_EQ(delta_sizes.size(), status_count);
+  last_chunk_.Decode(chunk, last_chunk_max_size);
+  RTC_DCHECK_EQ(num_decoded, status_count);
+  delta_sizes.resize(status_count);
   num_seq_no_ = status_count;
 
   uint16_t seq_no = base_seq_no_;
   size_t recv_delta_size = 0;
-  for (size_t delta_size : delta_sizes) {
+  size_t num_received = 0;
+  for (DeltaSize delta_size : delta_sizes) {
     recv_delta_size += delta_size;
+    num_received += delta_size != 0;
   }
+  received_packets_.reserve(num_received);
+  if (include_lost_)
+    all_packets_.reserve(status_count);
 
   // Determine if timestamps, that is, recv_delta are included in the packet.
   if (end_index >= index + recv_delta_size) {
@@ -125,6 +125,15 @@ class TransportFeedback : public Rtpfb {
 
     // Decode up to |max_size| delta sizes from |chunk|.
     void Decode(uint16_t chunk, size_t max_size);
+    // Decodes up to |max_size| delta sizes from |chunk| straight into
+    // |delta_sizes|, without keeping any state, and returns how many were
+    // decoded. May write up to |kMaxDecodedPerChunk| entries, so the
+    // destination must have that much room past the returned count.
+    static size_t DecodeTo(uint16_t chunk,
+                           size_t max_size,
+                           DeltaSize* delta_sizes);
+
+    static constexpr size_t kMaxDecodedPerChunk = 16;
     // Appends content of the Lastchunk to |deltas|.
     void AppendTo(std::vector<DeltaSize>* deltas) const;
 
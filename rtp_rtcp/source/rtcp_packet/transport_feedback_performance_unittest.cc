@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+using rtcp::TransportFeedback;
+
+constexpr int kNumRounds = 200;
+constexpr uint16_t kBaseSeqNo = 60000;
+constexpr int64_t kBaseTimestampUs = 1000000;
+
+struct PacketArrival {
+  uint16_t sequence_number;
+  int64_t timestamp_us;
+};
+
+// Generates arrivals for |num_packets| sequence numbers where roughly
+// |loss_percent| of the packets are missing and one in ten has a receive delta
+// that needs two bytes.
+std::vector<PacketArrival> GenerateArrivals(int num_packets, int loss_percent) {
+  Random random(0x7fb);
+  std::vector<PacketArrival> arrivals;
+  int64_t timestamp_us = kBaseTimestampUs;
+  for (int i = 0; i < num_packets; ++i) {
+    timestamp_us += random.Rand(0, 9) == 0 ? random.Rand(64000, 100000)
+                                           : random.Rand(0, 5000);
+    if (random.Rand(0, 99) >= loss_percent) {
+      arrivals.push_back(
+          {static_cast<uint16_t>(kBaseSeqNo + i), timestamp_us});
+    }
+  }
+  return arrivals;
+}
+
+}  // namespace
+
+// Measures the time needed to build, serialize and parse large transport
+// feedback packets.
+TEST(TransportFeedbackPerformanceTest, DISABLED_CreateAndParse) {
+  for (int num_packets : {100, 1000, 10000}) {
+    for (int loss_percent : {0, 5, 30}) {
+      const std::vector<PacketArrival> arrivals =
+          GenerateArrivals(num_packets, loss_percent);
+      int64_t add_us = 0;
+      int64_t create_us = 0;
+      int64_t parse_us = 0;
+      size_t num_received = 0;
+      for (int round = 0; round < kNumRounds; ++round) {
+        int64_t start_us = rtc::TimeMicros();
+        TransportFeedback feedback;
+        feedback.SetBase(kBaseSeqNo, kBaseTimestampUs);
+        for (const PacketArrival& arrival : arrivals) {
+          feedback.AddReceivedPacket(arrival.sequence_number,
+                                     arrival.timestamp_us);
+        }
+        add_us += rtc::TimeMicros() - start_us;
+
+        start_us = rtc::TimeMicros();
+        rtc::Buffer packet = feedback.Build();
+        create_us += rtc::TimeMicros() - start_us;
+
+        start_us = rtc::TimeMicros();
+        std::unique_ptr<TransportFeedback> parsed =
+            TransportFeedback::ParseFrom(packet.data(), packet.size());
+        parse_us += rtc::TimeMicros() - start_us;
+        ASSERT_TRUE(parsed);
+        num_received = parsed->GetReceivedPackets().size();
+      }
+      EXPECT_EQ(arrivals.size(), num_received);
+
+      rtc::StringBuilder story;
+      story << num_packets << "_packets_" << loss_percent << "_percent_loss";
+      test::PrintResult("transport_feedback_add_time", "", story.str(),
+                        static_cast<double>(add_us) / kNumRounds, "us", false);
+      test::PrintResult("transport_feedback_create_time", "", story.str(),
+                        static_cast<double>(create_us) / kNumRounds, "us",
+                        false);
+      test::PrintResult("transport_feedback_parse_time", "", story.str(),
+                        static_cast<double>(parse_us) / kNumRounds, "us",
+                        false);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -602,5 +602,38 @@ TEST(TransportFeedbackTest, ReportsMissingPacketsWithoutTimestamps) {
   EXPECT_FALSE(packets[2].received());
   EXPECT_TRUE(packets[3].received());
 }
+
+TEST(TransportFeedbackTest, ParsesMixOfAllChunkTypes) {
+  const uint16_t kBaseSeqNo = 65000;  // Wraps around.
+  const int64_t kBaseTimestampUs = 10000;
+  TransportFeedback feedback_builder(/*include_timestamps*/ true);
+  feedback_builder.SetBase(kBaseSeqNo, kBaseTimestampUs);
+  int64_t timestamp_us = kBaseTimestampUs;
+  for (int i = 0; i < 2000; ++i) {
+    // Long loss bursts give run length chunks, isolated losses one bit
+    // vectors and occasional large deltas two bit vectors.
+    if (i % 7 == 3 || (i % 400) < 30)
+      continue;
+    timestamp_us += (i % 5 == 0) ? 2 * kDeltaLimit : 1000;
+    ASSERT_TRUE(
+        feedback_builder.AddReceivedPacket(kBaseSeqNo + i, timestamp_us));
+  }
+  rtc::Buffer coded = feedback_builder.Build();
+
+  std::unique_ptr<TransportFeedback> feedback =
+      TransportFeedback::ParseFrom(coded.data(), coded.size());
+  ASSERT_TRUE(feedback);
+  EXPECT_TRUE(feedback->IsConsistent());
+  EXPECT_EQ(feedback_builder.GetPacketStatusCount(),
+            feedback->GetPacketStatusCount());
+  const auto& expected = feedback_builder.GetReceivedPackets();
+  const auto& received = feedback->GetReceivedPackets();
+  ASSERT_EQ(expected.size(), received.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].sequence_number(), received[i].sequence_number());
+    EXPECT_EQ(expected[i].delta_ticks(), received[i].delta_ticks());
+  }
+  EXPECT_EQ(coded, feedback->Build());
+}
 }  // namespace
 }  // namespace webrtc
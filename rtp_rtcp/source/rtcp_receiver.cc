@@ -89,7 +89,8 @@ struct RTCPReceiver::PacketInformation {
   std::vector<ReportBlockData> report_block_datas;
   int64_t rtt_ms = 0;
   uint32_t receiver_estimated_max_bitrate_bps = 0;
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback;
+  // More than one when several datagrams are handled as a batch.
+  std::vector<std::unique_ptr<rtcp::TransportFeedback>> transport_feedbacks;
   absl::optional<VideoBitrateAllocation> target_bitrate_allocation;
   absl::optional<NetworkStateEstimate> network_state_estimate;
   std::unique_ptr<rtcp::LossNotification> loss_notification;
@@ -170,14 +171,48 @@ RTCPReceiver::RTCPReceiver(const RtpRtcp::Configuration& config,
 RTCPReceiver::~RTCPReceiver() {}
 
 void RTCPReceiver::IncomingPacket(const uint8_t* packet, size_t packet_size) {
-  if (packet_size == 0) {
-    RTC_LOG(LS_WARNING) << "Incoming empty RTCP packet";
-    return;
-  }
+  const rtc::ArrayView<const uint8_t> packets[] = {
+      rtc::MakeArrayView(packet, packet_size)};
+  IncomingPackets(packets);
+}
 
+void RTCPReceiver::IncomingPackets(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets) {
+  // Blocks from all datagrams accumulate into the same |packet_information|,
+  // so observers are triggered once per batch.
   PacketInformation packet_information;
-  if (!ParseCompoundPacket(packet, packet + packet_size, &packet_information))
-    return;
+  {
+    rtc::CritScope lock(&rtcp_receiver_lock_);
+    bool any_parsed = false;
+    for (rtc::ArrayView<const uint8_t> packet : packets) {
+      if (packet.empty()) {
+        RTC_LOG(LS_WARNING) << "Incoming empty RTCP packet";
+        continue;
+      }
+      if (ParseCompoundPacket(packet.data(), packet.data() + packet.size(),
+                              &packet_information)) {
+        any_parsed = true;
+      }
+    }
+    if (!any_parsed)
+      return;
+
+    if (packet_type_counter_observer_) {
+      packet_type_counter_observer_->RtcpPacketTypesCounterUpdated(
+          main_ssrc_, packet_type_counter_);
+    }
+
+    int64_t now_ms = clock_->TimeInMilliseconds();
+    if (now_ms - last_skipped_packets_warning_ms_ >= kMaxWarningLogIntervalMs &&
+        num_skipped_packets_ > 0) {
+      last_skipped_packets_warning_ms_ = now_ms;
+      RTC_LOG(LS_WARNING)
+          << num_skipped_packets_
+          << " RTCP blocks were skipped due to being malformed or of "
+             "unrecognized/unsupported type, during the past "
+          << (kMaxWarningLogIntervalMs / 1000) << " second period.";
+    }
+  }
   TriggerCallbacksFromRtcpPacket(packet_information);
 }
 
@@ -325,8 +360,6 @@ std::vector<ReportBlockData> RTCPReceiver::GetLatestReportBlockData() const {
 bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
                                        const uint8_t* packet_end,
                                        PacketInformation* packet_information) {
-  rtc::CritScope lock(&rtcp_receiver_lock_);
-
   CommonHeader rtcp_block;
   for (const uint8_t* next_block = packet_begin; next_block != packet_end;
        next_block = rtcp_block.NextPacket()) {
@@ -408,22 +441,6 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
     }
   }
 
-  if (packet_type_counter_observer_) {
-    packet_type_counter_observer_->RtcpPacketTypesCounterUpdated(
-        main_ssrc_, packet_type_counter_);
-  }
-
-  int64_t now_ms = clock_->TimeInMilliseconds();
-  if (now_ms - last_skipped_packets_warning_ms_ >= kMaxWarningLogIntervalMs &&
-      num_skipped_packets_ > 0) {
-    last_skipped_packets_warning_ms_ = now_ms;
-    RTC_LOG(LS_WARNING)
-        << num_skipped_packets_
-        << " RTCP blocks were skipped due to being malformed or of "
-           "unrecognized/unsupported type, during the past "
-        << (kMaxWarningLogIntervalMs / 1000) << " second period.";
-  }
-
   return true;
 }
 
@@ -968,7 +985,8 @@ void RTCPReceiver::HandleTransportFeedback(
   }
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
-  packet_information->transport_feedback = std::move(transport_feedback);
+  packet_information->transport_feedbacks.push_back(
+      std::move(transport_feedback));
 }
 
 void RTCPReceiver::NotifyTmmbrUpdated() {
@@ -1090,12 +1108,13 @@ void RTCPReceiver::TriggerCallbacksFromRtcpPacket(
 
   if (transport_feedback_observer_ &&
       (packet_information.packet_type_flags & kRtcpTransportFeedback)) {
-    uint32_t media_source_ssrc =
-        packet_information.transport_feedback->media_ssrc();
-    if (media_source_ssrc == local_ssrc ||
-        registered_ssrcs.find(media_source_ssrc) != registered_ssrcs.end()) {
-      transport_feedback_observer_->OnTransportFeedback(
-          *packet_information.transport_feedback);
+    for (const auto& transport_feedback :
+         packet_information.transport_feedbacks) {
+      uint32_t media_source_ssrc = transport_feedback->media_ssrc();
+      if (media_source_ssrc == local_ssrc ||
+          registered_ssrcs.find(media_source_ssrc) != registered_ssrcs.end()) {
+        transport_feedback_observer_->OnTransportFeedback(*transport_feedback);
+      }
     }
   }
 
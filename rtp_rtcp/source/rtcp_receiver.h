@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 
+#include "api/array_view.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "modules/rtp_rtcp/include/rtcp_statistics.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp.h"
@@ -56,6 +57,12 @@ class RTCPReceiver {
   virtual ~RTCPReceiver();
 
   void IncomingPacket(const uint8_t* packet, size_t packet_size);
+  // Handles several RTCP datagrams, e.g. as drained from a socket in one go.
+  // All datagrams are parsed under a single lock acquisition and observers are
+  // notified once for the whole batch, as if the blocks had arrived in a
+  // single compound packet. Transport feedback is still delivered per block.
+  void IncomingPackets(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets);
 
   int64_t LastReceivedReportBlockMs() const;
 
@@ -126,7 +133,8 @@ class RTCPReceiver {
 
   bool ParseCompoundPacket(const uint8_t* packet_begin,
                            const uint8_t* packet_end,
-                           PacketInformation* packet_information);
+                           PacketInformation* packet_information)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
   void TriggerCallbacksFromRtcpPacket(
       const PacketInformation& packet_information);
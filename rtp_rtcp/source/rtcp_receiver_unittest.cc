@@ -1496,6 +1496,94 @@ TEST_F(RtcpReceiverTest, Nack) {
   InjectRtcpPacket(two_nacks);
 }
 
+TEST_F(RtcpReceiverTest, BatchedPacketsTriggerCallbacksOnce) {
+  const uint32_t kSenderSsrc2 = 0x20304;
+  const uint16_t kNackList1[] = {1, 2, 3};
+  const uint16_t kNackList2[] = {7, 9};
+  const uint16_t kNackList12[] = {1, 2, 3, 7, 9};
+  int64_t now = system_clock_.TimeInMilliseconds();
+
+  rtcp::ReportBlock rb;
+  rb.SetMediaSsrc(kReceiverMainSsrc);
+  rtcp::ReceiverReport rr1;
+  rr1.SetSenderSsrc(kSenderSsrc);
+  rr1.AddReportBlock(rb);
+  rtcp::ReceiverReport rr2;
+  rr2.SetSenderSsrc(kSenderSsrc2);
+  rr2.AddReportBlock(rb);
+  rtcp::Nack nack1;
+  nack1.SetSenderSsrc(kSenderSsrc);
+  nack1.SetMediaSsrc(kReceiverMainSsrc);
+  nack1.SetPacketIds(kNackList1, arraysize(kNackList1));
+  rtcp::Nack nack2;
+  nack2.SetSenderSsrc(kSenderSsrc);
+  nack2.SetMediaSsrc(kReceiverMainSsrc);
+  nack2.SetPacketIds(kNackList2, arraysize(kNackList2));
+
+  const rtc::Buffer raw[] = {rr1.Build(), nack1.Build(), rr2.Build(),
+                             nack2.Build()};
+  const rtc::ArrayView<const uint8_t> packets[] = {raw[0], raw[1], raw[2],
+                                                   raw[3]};
+
+  EXPECT_CALL(rtp_rtcp_impl_, OnReceivedRtcpReportBlocks(SizeIs(2)));
+  EXPECT_CALL(bandwidth_observer_,
+              OnReceivedRtcpReceiverReport(SizeIs(2), _, now));
+  EXPECT_CALL(rtp_rtcp_impl_, OnReceivedNack(ElementsAreArray(kNackList12)));
+  EXPECT_CALL(packet_type_counter_observer_,
+              RtcpPacketTypesCounterUpdated(
+                  kReceiverMainSsrc,
+                  Field(&RtcpPacketTypeCounter::nack_requests,
+                        arraysize(kNackList12))));
+  rtcp_receiver_.IncomingPackets(packets);
+
+  std::vector<RTCPReportBlock> received_blocks;
+  rtcp_receiver_.StatisticsReceived(&received_blocks);
+  EXPECT_EQ(2u, received_blocks.size());
+}
+
+TEST_F(RtcpReceiverTest, BatchedPacketsSkipInvalidDatagrams) {
+  const uint8_t kBadPacket[] = {0, 0, 0, 0};
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(kSenderSsrc);
+  const rtc::Buffer raw = rr.Build();
+  const rtc::ArrayView<const uint8_t> packets[] = {
+      kBadPacket, rtc::ArrayView<const uint8_t>(), raw};
+
+  EXPECT_CALL(rtp_rtcp_impl_, OnReceivedRtcpReportBlocks(IsEmpty()));
+  EXPECT_CALL(bandwidth_observer_,
+              OnReceivedRtcpReceiverReport(IsEmpty(), _, _));
+  rtcp_receiver_.IncomingPackets(packets);
+
+  // Nothing is triggered when no datagram in the batch could be parsed.
+  rtcp_receiver_.IncomingPackets(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>>(packets, 2));
+}
+
+TEST_F(RtcpReceiverTest, BatchedPacketsDeliverEachTransportFeedback) {
+  rtcp::TransportFeedback feedback1;
+  feedback1.SetMediaSsrc(kReceiverMainSsrc);
+  feedback1.SetSenderSsrc(kSenderSsrc);
+  feedback1.SetBase(1, 1000);
+  feedback1.AddReceivedPacket(1, 1000);
+  rtcp::TransportFeedback feedback2;
+  feedback2.SetMediaSsrc(kReceiverMainSsrc);
+  feedback2.SetSenderSsrc(kSenderSsrc);
+  feedback2.SetBase(2, 2000);
+  feedback2.AddReceivedPacket(2, 2000);
+
+  const rtc::Buffer raw[] = {feedback1.Build(), feedback2.Build()};
+  const rtc::ArrayView<const uint8_t> packets[] = {raw[0], raw[1]};
+
+  InSequence s;
+  EXPECT_CALL(transport_feedback_observer_,
+              OnTransportFeedback(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 1)));
+  EXPECT_CALL(transport_feedback_observer_,
+              OnTransportFeedback(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 2)));
+  rtcp_receiver_.IncomingPackets(packets);
+}
+
 TEST_F(RtcpReceiverTest, NackNotForUsIgnored) {
   const uint16_t kNackList1[] = {1, 2, 3, 5};
   const size_t kNackListLength1 = std::end(kNackList1) - std::begin(kNackList1);
@@ -20,7 +20,6 @@
 #include "logging/rtc_event_log/events/rtc_event_rtcp_packet_outgoing.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
-#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
@@ -50,39 +49,12 @@ const uint32_t kRtcpAnyExtendedReports = kRtcpXrReceiverReferenceTime |
                                          kRtcpXrTargetBitrate;
 constexpr int32_t kDefaultVideoReportInterval = 1000;
 constexpr int32_t kDefaultAudioReportInterval = 5000;
-
-class PacketContainer : public rtcp::CompoundPacket {
- public:
-  PacketContainer(Transport* transport, RtcEventLog* event_log)
-      : transport_(transport), event_log_(event_log) {}
-  ~PacketContainer() override {
-    for (RtcpPacket* packet : appended_packets_)
-      delete packet;
-  }
-
-  size_t SendPackets(size_t max_payload_length) {
-    size_t bytes_sent = 0;
-    Build(max_payload_length, [&](rtc::ArrayView<const uint8_t> packet) {
-      if (transport_->SendRtcp(packet.data(), packet.size())) {
-        bytes_sent += packet.size();
-        if (event_log_) {
-          event_log_->Log(std::make_unique<RtcEventRtcpPacketOutgoing>(packet));
-        }
-      }
-    });
-    return bytes_sent;
-  }
-
- private:
-  Transport* transport_;
-  RtcEventLog* const event_log_;
-
-  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(PacketContainer);
-};
+}  // namespace
 
 // Helper to put several RTCP packets into lower layer datagram RTCP packet.
-// Prefer to use this class instead of PacketContainer.
-class PacketSender {
+// Packets are serialized directly into a preallocated buffer, so building a
+// compound packet doesn't allocate per RTCP block.
+class RTCPSender::PacketSender {
  public:
   PacketSender(rtcp::RtcpPacket::PacketReadyCallback callback,
                size_t max_packet_size)
@@ -105,6 +77,9 @@ class PacketSender {
     }
   }
 
+  // Drops the pending rtcp packet without sending it.
+  void Reset() { index_ = 0; }
+
   bool IsEmpty() const { return index_ == 0; }
 
  private:
@@ -114,8 +89,6 @@ class PacketSender {
   uint8_t buffer_[IP_PACKET_SIZE];
 };
 
-}  // namespace
-
 RTCPSender::FeedbackState::FeedbackState()
     : packets_sent(0),
       media_bytes_sent(0),
@@ -453,7 +426,14 @@ bool RTCPSender::TimeToSendRTCPReport(bool sendKeyframeBeforeRTP) const {
   return false;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSR(const RtcpContext& ctx) {
+absl::optional<int64_t> RTCPSender::NextTimeToSendRTCPReport() const {
+  rtc::CritScope lock(&critical_section_rtcp_sender_);
+  if (method_ == RtcpMode::kOff)
+    return absl::nullopt;
+  return next_time_to_send_rtcp_;
+}
+
+bool RTCPSender::BuildSR(const RtcpContext& ctx, PacketSender* sender) {
   // Timestamp shouldn't be estimated before first media frame.
   RTC_DCHECK_GE(last_frame_capture_time_ms_, 0);
   // The timestamp of this RTCP packet should be estimated as the timestamp of
@@ -472,69 +452,73 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSR(const RtcpContext& ctx) {
       timestamp_offset_ + last_rtp_timestamp_ +
       ((ctx.now_us_ + 500) / 1000 - last_frame_capture_time_ms_) * rtp_rate;
 
-  rtcp::SenderReport* report = new rtcp::SenderReport();
-  report->SetSenderSsrc(ssrc_);
-  report->SetNtp(TimeMicrosToNtp(ctx.now_us_));
-  report->SetRtpTimestamp(rtp_timestamp);
-  report->SetPacketCount(ctx.feedback_state_.packets_sent);
-  report->SetOctetCount(ctx.feedback_state_.media_bytes_sent);
-  report->SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+  rtcp::SenderReport report;
+  report.SetSenderSsrc(ssrc_);
+  report.SetNtp(TimeMicrosToNtp(ctx.now_us_));
+  report.SetRtpTimestamp(rtp_timestamp);
+  report.SetPacketCount(ctx.feedback_state_.packets_sent);
+  report.SetOctetCount(ctx.feedback_state_.media_bytes_sent);
+  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
 
-  return std::unique_ptr<rtcp::RtcpPacket>(report);
+  sender->AppendPacket(report);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildSDES(
-    const RtcpContext& ctx) {
+bool RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender* sender) {
   size_t length_cname = cname_.length();
   RTC_CHECK_LT(length_cname, RTCP_CNAME_SIZE);
 
-  rtcp::Sdes* sdes = new rtcp::Sdes();
-  sdes->AddCName(ssrc_, cname_);
+  rtcp::Sdes sdes;
+  sdes.AddCName(ssrc_, cname_);
 
   for (const auto& it : csrc_cnames_)
-    RTC_CHECK(sdes->AddCName(it.first, it.second));
+    RTC_CHECK(sdes.AddCName(it.first, it.second));
 
-  return std::unique_ptr<rtcp::RtcpPacket>(sdes);
+  sender->AppendPacket(sdes);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildRR(const RtcpContext& ctx) {
-  rtcp::ReceiverReport* report = new rtcp::ReceiverReport();
-  report->SetSenderSsrc(ssrc_);
-  report->SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+bool RTCPSender::BuildRR(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::ReceiverReport report;
+  report.SetSenderSsrc(ssrc_);
+  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
 
-  return std::unique_ptr<rtcp::RtcpPacket>(report);
+  sender->AppendPacket(report);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildPLI(const RtcpContext& ctx) {
-  rtcp::Pli* pli = new rtcp::Pli();
-  pli->SetSenderSsrc(ssrc_);
-  pli->SetMediaSsrc(remote_ssrc_);
+bool RTCPSender::BuildPLI(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(ssrc_);
+  pli.SetMediaSsrc(remote_ssrc_);
 
   ++packet_type_counter_.pli_packets;
 
-  return std::unique_ptr<rtcp::RtcpPacket>(pli);
+  sender->AppendPacket(pli);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildFIR(const RtcpContext& ctx) {
+bool RTCPSender::BuildFIR(const RtcpContext& ctx, PacketSender* sender) {
   ++sequence_number_fir_;
 
-  rtcp::Fir* fir = new rtcp::Fir();
-  fir->SetSenderSsrc(ssrc_);
-  fir->AddRequestTo(remote_ssrc_, sequence_number_fir_);
+  rtcp::Fir fir;
+  fir.SetSenderSsrc(ssrc_);
+  fir.AddRequestTo(remote_ssrc_, sequence_number_fir_);
 
   ++packet_type_counter_.fir_packets;
 
-  return std::unique_ptr<rtcp::RtcpPacket>(fir);
+  sender->AppendPacket(fir);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildREMB(
-    const RtcpContext& ctx) {
-  rtcp::Remb* remb = new rtcp::Remb();
-  remb->SetSenderSsrc(ssrc_);
-  remb->SetBitrateBps(remb_bitrate_);
-  remb->SetSsrcs(remb_ssrcs_);
+bool RTCPSender::BuildREMB(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::Remb remb;
+  remb.SetSenderSsrc(ssrc_);
+  remb.SetBitrateBps(remb_bitrate_);
+  remb.SetSsrcs(remb_ssrcs_);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(remb);
+  sender->AppendPacket(remb);
+  return true;
 }
 
 void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
@@ -542,10 +526,9 @@ void RTCPSender::SetTargetBitrate(unsigned int target_bitrate) {
   tmmbr_send_bps_ = target_bitrate;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
-    const RtcpContext& ctx) {
+bool RTCPSender::BuildTMMBR(const RtcpContext& ctx, PacketSender* sender) {
   if (ctx.feedback_state_.module == nullptr)
-    return nullptr;
+    return false;
   // Before sending the TMMBR check the received TMMBN, only an owner is
   // allowed to raise the bitrate:
   // * If the sender is an owner of the TMMBN -> send TMMBR
@@ -565,7 +548,7 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
       if (candidate.bitrate_bps() == tmmbr_send_bps_ &&
           candidate.packet_overhead() == packet_oh_send_) {
         // Do not send the same tuple.
-        return nullptr;
+        return false;
       }
     }
     if (!tmmbr_owner) {
@@ -579,65 +562,67 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBR(
       tmmbr_owner = TMMBRHelp::IsOwner(bounding, ssrc_);
       if (!tmmbr_owner) {
         // Did not enter bounding set, no meaning to send this request.
-        return nullptr;
+        return false;
       }
     }
   }
 
   if (!tmmbr_send_bps_)
-    return nullptr;
+    return false;
 
-  rtcp::Tmmbr* tmmbr = new rtcp::Tmmbr();
-  tmmbr->SetSenderSsrc(ssrc_);
+  rtcp::Tmmbr tmmbr;
+  tmmbr.SetSenderSsrc(ssrc_);
   rtcp::TmmbItem request;
   request.set_ssrc(remote_ssrc_);
   request.set_bitrate_bps(tmmbr_send_bps_);
   request.set_packet_overhead(packet_oh_send_);
-  tmmbr->AddTmmbr(request);
+  tmmbr.AddTmmbr(request);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(tmmbr);
+  sender->AppendPacket(tmmbr);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildTMMBN(
-    const RtcpContext& ctx) {
-  rtcp::Tmmbn* tmmbn = new rtcp::Tmmbn();
-  tmmbn->SetSenderSsrc(ssrc_);
+bool RTCPSender::BuildTMMBN(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::Tmmbn tmmbn;
+  tmmbn.SetSenderSsrc(ssrc_);
   for (const rtcp::TmmbItem& tmmbr : tmmbn_to_send_) {
     if (tmmbr.bitrate_bps() > 0) {
-      tmmbn->AddTmmbr(tmmbr);
+      tmmbn.AddTmmbr(tmmbr);
     }
   }
 
-  return std::unique_ptr<rtcp::RtcpPacket>(tmmbn);
+  sender->AppendPacket(tmmbn);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildAPP(const RtcpContext& ctx) {
-  rtcp::App* app = new rtcp::App();
-  app->SetSenderSsrc(ssrc_);
-  app->SetSubType(app_sub_type_);
-  app->SetName(app_name_);
-  app->SetData(app_data_.get(), app_length_);
+bool RTCPSender::BuildAPP(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::App app;
+  app.SetSenderSsrc(ssrc_);
+  app.SetSubType(app_sub_type_);
+  app.SetName(app_name_);
+  app.SetData(app_data_.get(), app_length_);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(app);
+  sender->AppendPacket(app);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildLossNotification(
-    const RtcpContext& ctx) {
-  auto loss_notification = std::make_unique<rtcp::LossNotification>(
+bool RTCPSender::BuildLossNotification(const RtcpContext& ctx,
+                                       PacketSender* sender) {
+  rtcp::LossNotification loss_notification(
       loss_notification_state_.last_decoded_seq_num,
       loss_notification_state_.last_received_seq_num,
       loss_notification_state_.decodability_flag);
-  loss_notification->SetSenderSsrc(ssrc_);
-  loss_notification->SetMediaSsrc(remote_ssrc_);
-  return std::move(loss_notification);
+  loss_notification.SetSenderSsrc(ssrc_);
+  loss_notification.SetMediaSsrc(remote_ssrc_);
+  sender->AppendPacket(loss_notification);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildNACK(
-    const RtcpContext& ctx) {
-  rtcp::Nack* nack = new rtcp::Nack();
-  nack->SetSenderSsrc(ssrc_);
-  nack->SetMediaSsrc(remote_ssrc_);
-  nack->SetPacketIds(ctx.nack_list_, ctx.nack_size_);
+bool RTCPSender::BuildNACK(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::Nack nack;
+  nack.SetSenderSsrc(ssrc_);
+  nack.SetMediaSsrc(remote_ssrc_);
+  nack.SetPacketIds(ctx.nack_list_, ctx.nack_size_);
 
   // Report stats.
   for (int idx = 0; idx < ctx.nack_size_; ++idx) {
@@ -648,30 +633,32 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildNACK(
 
   ++packet_type_counter_.nack_packets;
 
-  return std::unique_ptr<rtcp::RtcpPacket>(nack);
+  sender->AppendPacket(nack);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildBYE(const RtcpContext& ctx) {
-  rtcp::Bye* bye = new rtcp::Bye();
-  bye->SetSenderSsrc(ssrc_);
-  bye->SetCsrcs(csrcs_);
+bool RTCPSender::BuildBYE(const RtcpContext& ctx, PacketSender* sender) {
+  rtcp::Bye bye;
+  bye.SetSenderSsrc(ssrc_);
+  bye.SetCsrcs(csrcs_);
 
-  return std::unique_ptr<rtcp::RtcpPacket>(bye);
+  sender->AppendPacket(bye);
+  return true;
 }
 
-std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildExtendedReports(
-    const RtcpContext& ctx) {
-  std::unique_ptr<rtcp::ExtendedReports> xr(new rtcp::ExtendedReports());
-  xr->SetSenderSsrc(ssrc_);
+bool RTCPSender::BuildExtendedReports(const RtcpContext& ctx,
+                                      PacketSender* sender) {
+  rtcp::ExtendedReports xr;
+  xr.SetSenderSsrc(ssrc_);
 
   if (!sending_ && xr_send_receiver_reference_time_enabled_) {
     rtcp::Rrtr rrtr;
     rrtr.SetNtp(TimeMicrosToNtp(ctx.now_us_));
-    xr->SetRrtr(rrtr);
+    xr.SetRrtr(rrtr);
   }
 
   for (const rtcp::ReceiveTimeInfo& rti : ctx.feedback_state_.last_xr_rtis) {
-    xr->AddDlrrItem(rti);
+    xr.AddDlrrItem(rti);
   }
 
   if (send_video_bitrate_allocation_) {
@@ -686,11 +673,12 @@ std::unique_ptr<rtcp::RtcpPacket> RTCPSender::BuildExtendedReports(
       }
     }
 
-    xr->SetTargetBitrate(target_bitrate);
+    xr.SetTargetBitrate(target_bitrate);
     send_video_bitrate_allocation_ = false;
   }
 
-  return std::move(xr);
+  sender->AppendPacket(xr);
+  return true;
 }
 
 int32_t RTCPSender::SendRTCP(const FeedbackState& feedback_state,
@@ -707,8 +695,15 @@ int32_t RTCPSender::SendCompoundRTCP(
     const std::set<RTCPPacketType>& packet_types,
     int32_t nack_size,
     const uint16_t* nack_list) {
-  PacketContainer container(transport_, event_log_);
-  size_t max_packet_size;
+  size_t bytes_sent = 0;
+  auto callback = [&](rtc::ArrayView<const uint8_t> packet) {
+    if (transport_->SendRtcp(packet.data(), packet.size())) {
+      bytes_sent += packet.size();
+      if (event_log_)
+        event_log_->Log(std::make_unique<RtcEventRtcpPacketOutgoing>(packet));
+    }
+  };
+  absl::optional<PacketSender> sender;
 
   {
     rtc::CritScope lock(&critical_section_rtcp_sender_);
@@ -745,7 +740,11 @@ int32_t RTCPSender::SendCompoundRTCP(
 
     PrepareReport(feedback_state);
 
-    std::unique_ptr<rtcp::RtcpPacket> packet_bye;
+    // Blocks are serialized as they are built. Packets exceeding the max
+    // packet size are sent as soon as the buffer is full, while the last one
+    // is sent after releasing the lock.
+    sender.emplace(callback, max_packet_size_);
+    bool add_bye = false;
 
     auto it = report_flags_.begin();
     while (it != report_flags_.end()) {
@@ -758,22 +757,21 @@ int32_t RTCPSender::SendCompoundRTCP(
         ++it;
       }
 
+      // If there is a BYE, don't append now - append it at the end later.
+      if (builder_it->first == kRtcpBye) {
+        add_bye = true;
+        continue;
+      }
       BuilderFunc func = builder_it->second;
-      std::unique_ptr<rtcp::RtcpPacket> packet = (this->*func)(context);
-      if (packet == nullptr)
+      if (!(this->*func)(context, &*sender)) {
+        sender->Reset();
         return -1;
-      // If there is a BYE, don't append now - save it and append it
-      // at the end later.
-      if (builder_it->first == kRtcpBye) {
-        packet_bye = std::move(packet);
-      } else {
-        container.Append(packet.release());
       }
     }
 
     // Append the BYE now at the end
-    if (packet_bye) {
-      container.Append(packet_bye.release());
+    if (add_bye) {
+      BuildBYE(context, &*sender);
     }
 
     if (packet_type_counter_observer_ != nullptr) {
@@ -782,10 +780,9 @@ int32_t RTCPSender::SendCompoundRTCP(
     }
 
     RTC_DCHECK(AllVolatileFlagsConsumed());
-    max_packet_size = max_packet_size_;
   }
 
-  size_t bytes_sent = container.SendPackets(max_packet_size);
+  sender->Send();
   return bytes_sent == 0 ? -1 : 0;
 }
 
@@ -97,6 +97,10 @@ class RTCPSender {
 
   bool TimeToSendRTCPReport(bool sendKeyframeBeforeRTP = false) const;
 
+  // Returns the time, in ms, at which the next regular report is due, or
+  // nullopt if RTCP is off.
+  absl::optional<int64_t> NextTimeToSendRTCPReport() const;
+
   int32_t SendRTCP(const FeedbackState& feedback_state,
                    RTCPPacketType packetType,
                    int32_t nackSize = 0,
@@ -142,6 +146,7 @@ class RTCPSender {
       std::vector<std::unique_ptr<rtcp::RtcpPacket>> rtcp_packets);
 
  private:
+  class PacketSender;
   class RtcpContext;
 
   // Determine which RTCP messages should be sent and setup flags.
@@ -152,33 +157,31 @@ class RTCPSender {
       const FeedbackState& feedback_state)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
 
-  std::unique_ptr<rtcp::RtcpPacket> BuildSR(const RtcpContext& context)
+  bool BuildSR(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildRR(const RtcpContext& context)
+  bool BuildRR(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildSDES(const RtcpContext& context)
+  bool BuildSDES(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildPLI(const RtcpContext& context)
+  bool BuildPLI(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildREMB(const RtcpContext& context)
+  bool BuildREMB(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildTMMBR(const RtcpContext& context)
+  bool BuildTMMBR(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildTMMBN(const RtcpContext& context)
+  bool BuildTMMBN(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildAPP(const RtcpContext& context)
+  bool BuildAPP(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildLossNotification(
-      const RtcpContext& context)
+  bool BuildLossNotification(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildExtendedReports(
-      const RtcpContext& context)
+  bool BuildExtendedReports(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildBYE(const RtcpContext& context)
+  bool BuildBYE(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildFIR(const RtcpContext& context)
+  bool BuildFIR(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
-  std::unique_ptr<rtcp::RtcpPacket> BuildNACK(const RtcpContext& context)
+  bool BuildNACK(const RtcpContext& context, PacketSender* sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(critical_section_rtcp_sender_);
 
  private:
@@ -289,8 +292,9 @@ class RTCPSender {
   std::set<ReportFlag> report_flags_
       RTC_GUARDED_BY(critical_section_rtcp_sender_);
 
-  typedef std::unique_ptr<rtcp::RtcpPacket> (RTCPSender::*BuilderFunc)(
-      const RtcpContext&);
+  // Builders serialize their block into the PacketSender and return false if
+  // the compound packet shouldn't be sent.
+  typedef bool (RTCPSender::*BuilderFunc)(const RtcpContext&, PacketSender*);
   // Map from RTCPPacketType to builder.
   std::map<uint32_t, BuilderFunc> builders_;
 
@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/base/macros.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
@@ -28,6 +29,7 @@
 
 using ::testing::_;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Invoke;
 using ::testing::SizeIs;
 
@@ -710,6 +712,45 @@ TEST_F(RtcpSenderTest, ByeMustBeLast) {
   EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpBye));
 }
 
+TEST_F(RtcpSenderTest, SplitsCompoundPacketLargerThanMaxPacketSize) {
+  constexpr size_t kMaxPacketSize = 100;
+  MockTransport mock_transport;
+  int num_datagrams = 0;
+  int num_receiver_reports = 0;
+  std::vector<uint16_t> nacked;
+  EXPECT_CALL(mock_transport, SendRtcp(_, _))
+      .WillRepeatedly(Invoke([&](const uint8_t* data, size_t len) {
+        EXPECT_LE(len, kMaxPacketSize);
+        test::RtcpPacketParser parser;
+        EXPECT_TRUE(parser.Parse(data, len));
+        ++num_datagrams;
+        num_receiver_reports += parser.receiver_report()->num_packets();
+        // Each datagram holds at most one part of the split nack.
+        if (parser.nack()->num_packets() > 0) {
+          const std::vector<uint16_t>& ids = parser.nack()->packet_ids();
+          nacked.insert(nacked.end(), ids.begin(), ids.end());
+        }
+        return true;
+      }));
+  RtpRtcp::Configuration config = GetDefaultConfig();
+  config.outgoing_transport = &mock_transport;
+  rtcp_sender_.reset(new RTCPSender(config));
+  rtcp_sender_->SetRemoteSSRC(kRemoteSsrc);
+  rtcp_sender_->SetRTCPStatus(RtcpMode::kCompound);
+  rtcp_sender_->SetMaxRtpPacketSize(kMaxPacketSize);
+
+  // Sequence numbers far enough apart to each need their own nack item.
+  std::vector<uint16_t> nack_list;
+  for (uint16_t i = 0; i < 50; ++i)
+    nack_list.push_back(i * 20);
+  EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpNack,
+                                      nack_list.size(), nack_list.data()));
+
+  EXPECT_GT(num_datagrams, 1);
+  EXPECT_EQ(1, num_receiver_reports);
+  EXPECT_THAT(nacked, ElementsAreArray(nack_list));
+}
+
 TEST_F(RtcpSenderTest, SendXrWithTargetBitrate) {
   rtcp_sender_->SetRTCPStatus(RtcpMode::kCompound);
   const size_t kNumSpatialLayers = 2;
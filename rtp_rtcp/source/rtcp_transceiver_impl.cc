@@ -10,6 +10,8 @@
 
 #include "modules/rtp_rtcp/source/rtcp_transceiver_impl.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -54,8 +56,12 @@ struct RtcpTransceiverImpl::RemoteSenderState {
 
 // Helper to put several RTCP packets into lower layer datagram composing
 // Compound or Reduced-Size RTCP packet, as defined by RFC 5506 section 2.
-// TODO(danilchap): When in compound mode and packets are so many that several
-// compound RTCP packets need to be generated, ensure each packet is compound.
+// Report blocks that do not fit into one receiver report are split over
+// several, so when a datagram fills up the next one starts with a receiver
+// report as well.
+// TODO(danilchap): When in compound mode and feedback packets are so many that
+// several compound RTCP packets need to be generated, ensure each packet is
+// compound.
 class RtcpTransceiverImpl::PacketSender {
  public:
   PacketSender(rtcp::RtcpPacket::PacketReadyCallback callback,
@@ -340,10 +346,22 @@ void RtcpTransceiverImpl::CreateCompoundPacket(PacketSender* sender) {
   RTC_DCHECK(sender->IsEmpty());
   const uint32_t sender_ssrc = config_.feedback_ssrc;
   int64_t now_us = rtc::TimeMicros();
-  rtcp::ReceiverReport receiver_report;
-  receiver_report.SetSenderSsrc(sender_ssrc);
-  receiver_report.SetReportBlocks(CreateReportBlocks(now_us));
-  sender->AppendPacket(receiver_report);
+  std::vector<rtcp::ReportBlock> report_blocks = CreateReportBlocks(now_us);
+  // RFC 3550, section 6.4.2: report blocks for more sources than fit into
+  // one receiver report are sent in additional receiver reports.
+  size_t num_sent_blocks = 0;
+  do {
+    const size_t num_blocks =
+        std::min(report_blocks.size() - num_sent_blocks,
+                 rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+    rtcp::ReceiverReport receiver_report;
+    receiver_report.SetSenderSsrc(sender_ssrc);
+    receiver_report.SetReportBlocks(std::vector<rtcp::ReportBlock>(
+        report_blocks.begin() + num_sent_blocks,
+        report_blocks.begin() + num_sent_blocks + num_blocks));
+    sender->AppendPacket(receiver_report);
+    num_sent_blocks += num_blocks;
+  } while (num_sent_blocks < report_blocks.size());
 
   if (!config_.cname.empty()) {
     rtcp::Sdes sdes;
@@ -417,11 +435,9 @@ std::vector<rtcp::ReportBlock> RtcpTransceiverImpl::CreateReportBlocks(
     int64_t now_us) {
   if (!config_.receive_statistics)
     return {};
-  // TODO(danilchap): Support sending more than
-  // |ReceiverReport::kMaxNumberOfReportBlocks| per compound rtcp packet.
   std::vector<rtcp::ReportBlock> report_blocks =
       config_.receive_statistics->RtcpReportBlocks(
-          rtcp::ReceiverReport::kMaxNumberOfReportBlocks);
+          std::numeric_limits<size_t>::max());
   uint32_t last_sr = 0;
   uint32_t last_delay = 0;
   for (rtcp::ReportBlock& report_block : report_blocks) {
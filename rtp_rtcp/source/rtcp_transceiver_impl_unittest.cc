@@ -32,6 +32,7 @@ namespace {
 
 using ::testing::_;
 using ::testing::ElementsAre;
+using ::testing::Ge;
 using ::testing::Return;
 using ::testing::SizeIs;
 using ::testing::StrictMock;
@@ -48,6 +49,7 @@ using ::webrtc::TimeMicrosToNtp;
 using ::webrtc::VideoBitrateAllocation;
 using ::webrtc::rtcp::Bye;
 using ::webrtc::rtcp::CompoundPacket;
+using ::webrtc::rtcp::ReceiverReport;
 using ::webrtc::rtcp::ReportBlock;
 using ::webrtc::rtcp::SenderReport;
 using ::webrtc::test::RtcpPacketParser;
@@ -755,6 +757,62 @@ TEST(RtcpTransceiverImplTest,
   EXPECT_EQ(CompactNtpRttToMs(report_blocks[1].delay_since_last_sr()), 100);
 }
 
+TEST(RtcpTransceiverImplTest, SplitsReportBlocksOverSeveralReceiverReports) {
+  const uint32_t kSenderSsrc = 1234;
+  const size_t kNumReportBlocks = 40;
+  std::vector<ReportBlock> statistics_report_blocks(kNumReportBlocks);
+  for (size_t i = 0; i < kNumReportBlocks; ++i)
+    statistics_report_blocks[i].SetMediaSsrc(1000 + i);
+  MockReceiveStatisticsProvider receive_statistics;
+  EXPECT_CALL(receive_statistics, RtcpReportBlocks(Ge(kNumReportBlocks)))
+      .WillOnce(Return(statistics_report_blocks));
+
+  RtcpTransceiverConfig config;
+  config.feedback_ssrc = kSenderSsrc;
+  config.schedule_periodic_compound_packets = false;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  // 40 report blocks fit into a single datagram, but not into a single
+  // receiver report.
+  EXPECT_EQ(transport.num_packets(), 1);
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 2);
+  EXPECT_EQ(rtcp_parser.receiver_report()->sender_ssrc(), kSenderSsrc);
+  EXPECT_THAT(rtcp_parser.receiver_report()->report_blocks(),
+              SizeIs(kNumReportBlocks -
+                     ReceiverReport::kMaxNumberOfReportBlocks));
+}
+
+TEST(RtcpTransceiverImplTest, SplitsManyReportBlocksOverSeveralDatagrams) {
+  const size_t kNumReportBlocks = 100;
+  std::vector<ReportBlock> statistics_report_blocks(kNumReportBlocks);
+  for (size_t i = 0; i < kNumReportBlocks; ++i)
+    statistics_report_blocks[i].SetMediaSsrc(1000 + i);
+  MockReceiveStatisticsProvider receive_statistics;
+  EXPECT_CALL(receive_statistics, RtcpReportBlocks(_))
+      .WillOnce(Return(statistics_report_blocks));
+
+  RtcpTransceiverConfig config;
+  config.schedule_periodic_compound_packets = false;
+  config.max_packet_size = 1200;
+  RtcpPacketParser rtcp_parser;
+  RtcpParserTransport transport(&rtcp_parser);
+  config.outgoing_transport = &transport;
+  config.receive_statistics = &receive_statistics;
+  RtcpTransceiverImpl rtcp_transceiver(config);
+
+  rtcp_transceiver.SendCompoundPacket();
+
+  // 100 report blocks take 2400 bytes, so they can't fit into one datagram.
+  EXPECT_GE(transport.num_packets(), 2);
+  EXPECT_EQ(rtcp_parser.receiver_report()->num_packets(), 4);
+}
+
 TEST(RtcpTransceiverImplTest, SendsNack) {
   const uint32_t kSenderSsrc = 1234;
   const uint32_t kRemoteSsrc = 4321;
@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+
+#include <memory>
+#include <vector>
+
+#include "common_video/generic_frame_descriptor/generic_frame_info.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+FrameDependencyTemplate CreateTemplate(
+    int spatial_id,
+    int temporal_id,
+    std::vector<DecodeTargetIndication> dtis,
+    std::vector<int> frame_diffs,
+    std::vector<int> chain_diffs) {
+  FrameDependencyTemplate frame_template;
+  frame_template.spatial_id = spatial_id;
+  frame_template.temporal_id = temporal_id;
+  frame_template.decode_target_indications.assign(dtis.begin(), dtis.end());
+  frame_template.frame_diffs.assign(frame_diffs.begin(), frame_diffs.end());
+  frame_template.chain_diffs.assign(chain_diffs.begin(), chain_diffs.end());
+  return frame_template;
+}
+
+// Two spatial layers with two temporal layers each, one chain per spatial
+// layer.
+FrameDependencyStructure CreateStructure() {
+  constexpr DecodeTargetIndication kS = DecodeTargetIndication::kSwitch;
+  constexpr DecodeTargetIndication kD = DecodeTargetIndication::kDiscardable;
+  constexpr DecodeTargetIndication kR = DecodeTargetIndication::kRequired;
+  constexpr DecodeTargetIndication kN = DecodeTargetIndication::kNotPresent;
+  FrameDependencyStructure structure;
+  structure.structure_id = 7;
+  structure.num_decode_targets = 4;
+  structure.num_chains = 2;
+  structure.decode_target_protected_by_chain = {0, 0, 1, 1};
+  structure.templates = {
+      CreateTemplate(0, 0, {kS, kS, kS, kS}, {}, {0, 0}),
+      CreateTemplate(0, 0, {kS, kS, kS, kS}, {4}, {4, 3}),
+      CreateTemplate(0, 1, {kN, kD, kN, kD}, {2}, {2, 1}),
+      CreateTemplate(1, 0, {kN, kN, kS, kS}, {1}, {1, 1}),
+      CreateTemplate(1, 0, {kN, kN, kR, kR}, {4, 1}, {1, 4}),
+      CreateTemplate(1, 1, {kN, kN, kN, kD}, {2, 1}, {3, 2}),
+  };
+  structure.resolutions = {RenderResolution(320, 180),
+                           RenderResolution(640, 360)};
+  return structure;
+}
+
+std::vector<uint8_t> Serialize(const FrameDependencyStructure& structure,
+                               const DependencyDescriptor& descriptor) {
+  std::vector<uint8_t> buffer(
+      RtpDependencyDescriptorExtension::ValueSize(structure, descriptor));
+  EXPECT_TRUE(
+      RtpDependencyDescriptorExtension::Write(buffer, structure, descriptor));
+  return buffer;
+}
+
+TEST(RtpDependencyDescriptorExtensionTest, WritesAndParsesAttachedStructure) {
+  const FrameDependencyStructure structure = CreateStructure();
+  DependencyDescriptor descriptor;
+  descriptor.first_packet_in_frame = true;
+  descriptor.last_packet_in_frame = false;
+  descriptor.frame_number = 0x1234;
+  descriptor.frame_dependencies = structure.templates[0];
+  descriptor.attached_structure =
+      std::make_unique<FrameDependencyStructure>(structure);
+  const std::vector<uint8_t> buffer = Serialize(structure, descriptor);
+
+  DependencyDescriptor parsed;
+  ASSERT_TRUE(RtpDependencyDescriptorExtension::Parse(
+      buffer, /*structure=*/nullptr, &parsed));
+  EXPECT_TRUE(parsed.first_packet_in_frame);
+  EXPECT_FALSE(parsed.last_packet_in_frame);
+  EXPECT_EQ(parsed.frame_number, 0x1234);
+  ASSERT_TRUE(parsed.attached_structure);
+  const FrameDependencyStructure& parsed_structure =
+      *parsed.attached_structure;
+  EXPECT_EQ(parsed_structure.structure_id, structure.structure_id);
+  EXPECT_EQ(parsed_structure.num_decode_targets, structure.num_decode_targets);
+  EXPECT_EQ(parsed_structure.num_chains, structure.num_chains);
+  EXPECT_THAT(parsed_structure.decode_target_protected_by_chain,
+              ElementsAre(0, 0, 1, 1));
+  ASSERT_EQ(parsed_structure.templates.size(), structure.templates.size());
+  for (size_t i = 0; i < structure.templates.size(); ++i) {
+    const FrameDependencyTemplate& expected = structure.templates[i];
+    const FrameDependencyTemplate& actual = parsed_structure.templates[i];
+    EXPECT_EQ(actual.spatial_id, expected.spatial_id);
+    EXPECT_EQ(actual.temporal_id, expected.temporal_id);
+    EXPECT_THAT(actual.decode_target_indications,
+                ElementsAreArray(expected.decode_target_indications));
+    EXPECT_THAT(actual.frame_diffs, ElementsAreArray(expected.frame_diffs));
+    EXPECT_THAT(actual.chain_diffs, ElementsAreArray(expected.chain_diffs));
+  }
+  ASSERT_EQ(parsed_structure.resolutions.size(), 2u);
+  EXPECT_EQ(parsed_structure.resolutions[1].Width(), 640);
+  EXPECT_EQ(parsed_structure.resolutions[1].Height(), 360);
+  ASSERT_TRUE(parsed.resolution);
+  EXPECT_EQ(parsed.resolution->Width(), 320);
+}
+
+TEST(RtpDependencyDescriptorExtensionTest, WritesAndParsesCustomFields) {
+  const FrameDependencyStructure structure = CreateStructure();
+  DependencyDescriptor descriptor;
+  descriptor.frame_number = 0xfedc;
+  descriptor.frame_dependencies = structure.templates[4];
+  descriptor.frame_dependencies.frame_diffs = {3, 20, 300};
+  descriptor.frame_dependencies.chain_diffs = {200, 17};
+  const std::vector<uint8_t> buffer = Serialize(structure, descriptor);
+
+  DependencyDescriptor parsed;
+  ASSERT_TRUE(
+      RtpDependencyDescriptorExtension::Parse(buffer, &structure, &parsed));
+  EXPECT_EQ(parsed.frame_number, 0xfedc);
+  EXPECT_EQ(parsed.frame_dependencies.spatial_id, 1);
+  EXPECT_EQ(parsed.frame_dependencies.temporal_id, 0);
+  EXPECT_THAT(parsed.frame_dependencies.decode_target_indications,
+              ElementsAreArray(
+                  structure.templates[4].decode_target_indications));
+  EXPECT_THAT(parsed.frame_dependencies.frame_diffs, ElementsAre(3, 20, 300));
+  EXPECT_THAT(parsed.frame_dependencies.chain_diffs, ElementsAre(200, 17));
+}
+
+TEST(RtpDependencyDescriptorExtensionTest, UsesThreeBytesForMatchingTemplate) {
+  const FrameDependencyStructure structure = CreateStructure();
+  DependencyDescriptor descriptor;
+  descriptor.frame_dependencies = structure.templates[5];
+  EXPECT_EQ(RtpDependencyDescriptorExtension::ValueSize(structure, descriptor),
+            3u);
+}
+
+TEST(RtpDependencyDescriptorExtensionTest, FailsOnTooShortBuffer) {
+  const FrameDependencyStructure structure = CreateStructure();
+  DependencyDescriptor descriptor;
+  descriptor.frame_dependencies = structure.templates[3];
+  descriptor.attached_structure =
+      std::make_unique<FrameDependencyStructure>(structure);
+  const std::vector<uint8_t> buffer = Serialize(structure, descriptor);
+
+  std::vector<uint8_t> short_buffer(buffer.size() - 1);
+  EXPECT_FALSE(RtpDependencyDescriptorExtension::Write(short_buffer, structure,
+                                                       descriptor));
+  DependencyDescriptor parsed;
+  EXPECT_FALSE(RtpDependencyDescriptorExtension::Parse(
+      rtc::MakeArrayView(buffer.data(), buffer.size() - 1), &structure,
+      &parsed));
+}
+
+}  // namespace
+}  // namespace webrtc
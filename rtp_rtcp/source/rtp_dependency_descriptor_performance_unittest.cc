@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "common_video/generic_frame_descriptor/generic_frame_info.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumDescriptors = 200000;
+constexpr int kNumSpatialLayers = 3;
+constexpr int kNumTemporalLayers = 3;
+
+// Creates the structure of an L3T3 stream: one template per layer, one decode
+// target per layer and one chain per spatial layer.
+FrameDependencyStructure CreateStructure() {
+  constexpr int kNumDecodeTargets = kNumSpatialLayers * kNumTemporalLayers;
+  FrameDependencyStructure structure;
+  structure.num_decode_targets = kNumDecodeTargets;
+  structure.num_chains = kNumSpatialLayers;
+  for (int dt = 0; dt < kNumDecodeTargets; ++dt) {
+    structure.decode_target_protected_by_chain.push_back(
+        dt / kNumTemporalLayers);
+  }
+  for (int sid = 0; sid < kNumSpatialLayers; ++sid) {
+    for (int tid = 0; tid < kNumTemporalLayers; ++tid) {
+      FrameDependencyTemplate frame_template;
+      frame_template.spatial_id = sid;
+      frame_template.temporal_id = tid;
+      for (int dt = 0; dt < kNumDecodeTargets; ++dt) {
+        frame_template.decode_target_indications.push_back(
+            dt / kNumTemporalLayers < sid || dt % kNumTemporalLayers < tid
+                ? DecodeTargetIndication::kNotPresent
+                : DecodeTargetIndication::kRequired);
+      }
+      frame_template.frame_diffs.push_back(1 << tid);
+      if (sid > 0)
+        frame_template.frame_diffs.push_back(1);
+      for (int chain = 0; chain < kNumSpatialLayers; ++chain)
+        frame_template.chain_diffs.push_back(chain + tid + 1);
+      structure.templates.push_back(frame_template);
+    }
+    structure.resolutions.emplace_back(320 << sid, 180 << sid);
+  }
+  return structure;
+}
+
+}  // namespace
+
+// Measures the time needed to write and to parse the dependency descriptors
+// of the packets of an L3T3 stream, both with and without the attached
+// structure.
+TEST(RtpDependencyDescriptorPerformanceTest, DISABLED_WriteAndParse) {
+  const FrameDependencyStructure structure = CreateStructure();
+  for (bool attach_structure : {false, true}) {
+    const char* story =
+        attach_structure ? "attached_structure" : "custom_frame_diffs";
+    std::vector<DependencyDescriptor> descriptors(structure.templates.size());
+    for (size_t i = 0; i < descriptors.size(); ++i) {
+      descriptors[i].frame_number = i;
+      descriptors[i].frame_dependencies = structure.templates[i];
+      // Forces the extended fields, as for frames that do not follow the
+      // regular pattern.
+      descriptors[i].frame_dependencies.frame_diffs.push_back(20);
+      if (attach_structure) {
+        descriptors[i].attached_structure =
+            std::make_unique<FrameDependencyStructure>(structure);
+      }
+    }
+
+    std::vector<uint8_t> buffer(
+        RtpDependencyDescriptorExtension::ValueSize(structure,
+                                                    descriptors.back()));
+    int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumDescriptors; ++i) {
+      const DependencyDescriptor& descriptor =
+          descriptors[i % descriptors.size()];
+      buffer.resize(
+          RtpDependencyDescriptorExtension::ValueSize(structure, descriptor));
+      ASSERT_TRUE(RtpDependencyDescriptorExtension::Write(buffer, structure,
+                                                          descriptor));
+    }
+    const int64_t write_us = rtc::TimeMicros() - start_us;
+
+    DependencyDescriptor parsed;
+    start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumDescriptors; ++i) {
+      ASSERT_TRUE(
+          RtpDependencyDescriptorExtension::Parse(buffer, &structure, &parsed));
+    }
+    const int64_t parse_us = rtc::TimeMicros() - start_us;
+    EXPECT_EQ(parsed.frame_number,
+              descriptors[(kNumDescriptors - 1) % descriptors.size()]
+                  .frame_number);
+
+    test::PrintResult("dependency_descriptor_write_time", "", story,
+                      1000.0 * write_us / kNumDescriptors, "ns", false);
+    test::PrintResult("dependency_descriptor_parse_time", "", story,
+                      1000.0 * parse_us / kNumDescriptors, "ns", false);
+  }
+}
+
+}  // namespace webrtc
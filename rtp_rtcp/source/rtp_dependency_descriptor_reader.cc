@@ -13,7 +13,7 @@
 #include <utility>
 #include <vector>
 
-#include "rtc_base/bit_buffer.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -31,7 +31,9 @@ RtpDependencyDescriptorReader::RtpDependencyDescriptorReader(
     rtc::ArrayView<const uint8_t> raw_data,
     const FrameDependencyStructure* structure,
     DependencyDescriptor* descriptor)
-    : descriptor_(descriptor), buffer_(raw_data.data(), raw_data.size()) {
+    : descriptor_(descriptor),
+      data_(raw_data.data()),
+      data_end_(raw_data.data() + raw_data.size()) {
   RTC_DCHECK(descriptor);
 
   ReadMandatoryFields();
@@ -49,17 +51,52 @@ RtpDependencyDescriptorReader::RtpDependencyDescriptorReader(
 }
 
 uint32_t RtpDependencyDescriptorReader::ReadBits(size_t bit_count) {
-  uint32_t value = 0;
-  if (!buffer_.ReadBits(&value, bit_count))
+  RTC_DCHECK_LE(bit_count, 32);
+  if (bit_count == 0)
+    return 0;
+  if (cache_bits_ < bit_count)
+    RefillCache();
+  if (cache_bits_ < bit_count) {
     parsing_failed_ = true;
+    return 0;
+  }
+  uint32_t value = static_cast<uint32_t>(cache_ >> (64 - bit_count));
+  cache_ <<= bit_count;
+  cache_bits_ -= bit_count;
   return value;
 }
 
 uint32_t RtpDependencyDescriptorReader::ReadNonSymmetric(size_t num_values) {
-  uint32_t value = 0;
-  if (!buffer_.ReadNonSymmetric(&value, num_values))
-    parsing_failed_ = true;
-  return value;
+  RTC_DCHECK_GT(num_values, 0);
+  RTC_DCHECK_LE(num_values, uint32_t{1} << 31);
+  if (num_values == 1)
+    return 0;
+  size_t count_bits = 0;
+  for (size_t values = num_values; values > 0; values >>= 1)
+    ++count_bits;
+  uint32_t num_min_bits_values = (uint32_t{1} << count_bits) - num_values;
+  uint32_t value = ReadBits(count_bits - 1);
+  if (value < num_min_bits_values)
+    return value;
+  uint32_t extra_bit = ReadBits(1);
+  return (value << 1) + extra_bit - num_min_bits_values;
+}
+
+void RtpDependencyDescriptorReader::RefillCache() {
+  RTC_DCHECK_LT(cache_bits_, 64);
+  if (data_end_ - data_ >= 8) {
+    // Loads a whole word. Its bits past the last whole byte that fits land
+    // exactly where the next refill puts the same bits again.
+    size_t num_bytes = (64 - cache_bits_) / 8;
+    cache_ |= ByteReader<uint64_t>::ReadBigEndian(data_) >> cache_bits_;
+    data_ += num_bytes;
+    cache_bits_ += 8 * num_bytes;
+    return;
+  }
+  while (cache_bits_ <= 56 && data_ != data_end_) {
+    cache_ |= uint64_t{*data_++} << (56 - cache_bits_);
+    cache_bits_ += 8;
+  }
 }
 
 void RtpDependencyDescriptorReader::ReadTemplateDependencyStructure() {
@@ -16,7 +16,6 @@
 
 #include "api/array_view.h"
 #include "common_video/generic_frame_descriptor/generic_frame_info.h"
-#include "rtc_base/bit_buffer.h"
 
 namespace webrtc {
 // Deserializes DependencyDescriptor rtp header extension.
@@ -34,10 +33,12 @@ class RtpDependencyDescriptorReader {
   bool ParseSuccessful() { return !parsing_failed_; }
 
  private:
-  // Reads bits from |buffer_|. If it fails, returns 0 and marks parsing as
-  // failed, but doesn't stop the parsing.
+  // Reads up to 32 bits from |cache_|. If it fails, returns 0 and marks
+  // parsing as failed, but doesn't stop the parsing.
   uint32_t ReadBits(size_t bit_count);
   uint32_t ReadNonSymmetric(size_t num_values);
+  // Moves as many whole bytes from the input to |cache_| as fit.
+  void RefillCache();
 
   // Functions to read template dependency structure.
   void ReadTemplateDependencyStructure();
@@ -61,7 +62,12 @@ class RtpDependencyDescriptorReader {
   DependencyDescriptor* const descriptor_;
   // Values that are needed while reading the descriptor, but can be discarded
   // when reading is complete.
-  rtc::BitBuffer buffer_;
+  // The unread input. Bits are consumed from the most significant end of
+  // |cache_|, whose |cache_bits_| top bits hold the next bits of the input.
+  const uint8_t* data_;
+  const uint8_t* const data_end_;
+  uint64_t cache_ = 0;
+  size_t cache_bits_ = 0;
   int frame_dependency_template_id_ = 0;
   bool custom_dtis_flag_ = false;
   bool custom_fdiffs_flag_ = false;
@@ -17,7 +17,6 @@
 #include "absl/algorithm/container.h"
 #include "api/array_view.h"
 #include "common_video/generic_frame_descriptor/generic_frame_info.h"
-#include "rtc_base/bit_buffer.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -56,6 +55,24 @@ NextLayerIdc GetNextLayerIdc(const FrameDependencyTemplate& previous,
   return NextLayerIdc::kInvalid;
 }
 
+// Returns the number of bits needed to represent |value|.
+int CountBits(uint32_t value) {
+  int bit_count = 0;
+  for (; value > 0; value >>= 1)
+    ++bit_count;
+  return bit_count;
+}
+
+// Returns the number of bits needed to write |value| out of |num_values|
+// with a non-symmetric unsigned encoding.
+int SizeNonSymmetricBits(uint32_t value, uint32_t num_values) {
+  RTC_DCHECK_GT(num_values, 0);
+  RTC_DCHECK_LE(num_values, uint32_t{1} << 31);
+  int count_bits = CountBits(num_values);
+  uint32_t num_min_bits_values = (uint32_t{1} << count_bits) - num_values;
+  return value < num_min_bits_values ? count_bits - 1 : count_bits;
+}
+
 }  // namespace
 
 RtpDependencyDescriptorWriter::RtpDependencyDescriptorWriter(
@@ -64,7 +81,7 @@ RtpDependencyDescriptorWriter::RtpDependencyDescriptorWriter(
     const DependencyDescriptor& descriptor)
     : descriptor_(descriptor),
       structure_(structure),
-      bit_writer_(data.data(), data.size()) {
+      data_(data) {
   FindBestTemplate();
 }
 
@@ -74,6 +91,13 @@ bool RtpDependencyDescriptorWriter::Write() {
     WriteExtendedFields();
     WriteFrameDependencyDefinition();
   }
+  StoreFullBytes();
+  if (accumulator_bits_ > 0) {
+    // Keeps the bits of the last byte that follow the descriptor.
+    uint8_t& last_byte = data_[bytes_written_];
+    last_byte = (last_byte & (0xFF >> accumulator_bits_)) |
+                static_cast<uint8_t>(accumulator_ >> 56);
+  }
   return !build_failed_;
 }
 
@@ -97,12 +121,11 @@ int RtpDependencyDescriptorWriter::StructureSizeBits() const {
   for (const FrameDependencyTemplate& frame_template : structure_.templates) {
     bits += 5 * frame_template.frame_diffs.size();
   }
-  bits += rtc::BitBufferWriter::SizeNonSymmetricBits(
-      structure_.num_chains, structure_.num_decode_targets + 1);
+  bits += SizeNonSymmetricBits(structure_.num_chains,
+                               structure_.num_decode_targets + 1);
   if (structure_.num_chains > 0) {
     for (int protected_by : structure_.decode_target_protected_by_chain) {
-      bits += rtc::BitBufferWriter::SizeNonSymmetricBits(
-          protected_by, structure_.num_chains + 1);
+      bits += SizeNonSymmetricBits(protected_by, structure_.num_chains + 1);
     }
     bits += 4 * structure_.templates.size() * structure_.num_chains;
   }
@@ -187,14 +210,37 @@ uint64_t RtpDependencyDescriptorWriter::TemplateId() const {
 }
 
 void RtpDependencyDescriptorWriter::WriteBits(uint64_t val, size_t bit_count) {
-  if (!bit_writer_.WriteBits(val, bit_count))
+  RTC_DCHECK_LE(bit_count, 32);
+  if (bit_count == 0)
+    return;
+  if (8 * (data_.size() - bytes_written_) - accumulator_bits_ < bit_count) {
     build_failed_ = true;
+    return;
+  }
+  if (accumulator_bits_ + bit_count > 64)
+    StoreFullBytes();
+  accumulator_bits_ += bit_count;
+  accumulator_ |= (val & ((uint64_t{1} << bit_count) - 1))
+                  << (64 - accumulator_bits_);
 }
 
 void RtpDependencyDescriptorWriter::WriteNonSymmetric(uint32_t value,
                                                       uint32_t num_values) {
-  if (!bit_writer_.WriteNonSymmetric(value, num_values))
-    build_failed_ = true;
+  RTC_DCHECK_LT(value, num_values);
+  int count_bits = CountBits(num_values);
+  uint32_t num_min_bits_values = (uint32_t{1} << count_bits) - num_values;
+  if (value < num_min_bits_values)
+    WriteBits(value, count_bits - 1);
+  else
+    WriteBits(value + num_min_bits_values, count_bits);
+}
+
+void RtpDependencyDescriptorWriter::StoreFullBytes() {
+  while (accumulator_bits_ >= 8) {
+    data_[bytes_written_++] = static_cast<uint8_t>(accumulator_ >> 56);
+    accumulator_ <<= 8;
+    accumulator_bits_ -= 8;
+  }
 }
 
 void RtpDependencyDescriptorWriter::WriteTemplateDependencyStructure() {
@@ -16,7 +16,6 @@
 
 #include "api/array_view.h"
 #include "common_video/generic_frame_descriptor/generic_frame_info.h"
-#include "rtc_base/bit_buffer.h"
 
 namespace webrtc {
 class RtpDependencyDescriptorWriter {
@@ -53,8 +52,11 @@ class RtpDependencyDescriptorWriter {
   bool HasExtendedFields() const;
   uint64_t TemplateId() const;
 
+  // Appends up to 32 bits to |accumulator_|.
   void WriteBits(uint64_t val, size_t bit_count);
   void WriteNonSymmetric(uint32_t value, uint32_t num_values);
+  // Moves the whole bytes of |accumulator_| to |data_|.
+  void StoreFullBytes();
 
   // Functions to read template dependency structure.
   void WriteTemplateDependencyStructure();
@@ -76,7 +78,12 @@ class RtpDependencyDescriptorWriter {
   bool build_failed_ = false;
   const DependencyDescriptor& descriptor_;
   const FrameDependencyStructure& structure_;
-  rtc::BitBufferWriter bit_writer_;
+  // Bits are collected most significant first in the |accumulator_bits_| top
+  // bits of |accumulator_| and stored to |data_| several bytes at a time.
+  const rtc::ArrayView<uint8_t> data_;
+  size_t bytes_written_ = 0;
+  uint64_t accumulator_ = 0;
+  size_t accumulator_bits_ = 0;
   TemplateMatch best_template_;
 };
 
@@ -333,6 +333,67 @@ TYPED_TEST(RtpFecTest, FecRecoveryWithLoss) {
   EXPECT_FALSE(this->IsRecoveryComplete());
 }
 
+TYPED_TEST(RtpFecTest, PacketPoolRecyclesRecoveredPackets) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr int kNumMediaPackets = 4;
+  constexpr uint8_t kProtectionFactor = 60;
+  constexpr int kNumFrames = 10;
+
+  this->fec_.EnablePacketPool();
+  for (int i = 0; i < kNumFrames; ++i) {
+    this->media_packets_ =
+        this->media_packet_generator_.ConstructMediaPackets(kNumMediaPackets);
+    this->generated_fec_packets_.clear();
+    EXPECT_EQ(
+        0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                                kNumImportantPackets, kUseUnequalProtection,
+                                kFecMaskBursty, &this->generated_fec_packets_));
+
+    memset(this->media_loss_mask_, 0, sizeof(this->media_loss_mask_));
+    memset(this->fec_loss_mask_, 0, sizeof(this->fec_loss_mask_));
+    this->media_loss_mask_[3] = 1;
+    this->NetworkReceivedPackets(this->media_loss_mask_, this->fec_loss_mask_);
+
+    for (const auto& received_packet : this->received_packets_) {
+      this->fec_.DecodeFec(*received_packet, &this->recovered_packets_);
+    }
+    EXPECT_TRUE(this->IsRecoveryComplete());
+    this->fec_.ResetState(&this->recovered_packets_);
+  }
+
+  // Only the first recovered packet needs an allocation, the following ones
+  // reuse it.
+  ForwardErrorCorrection::PacketPoolStats stats =
+      this->fec_.GetPacketPoolStats();
+  EXPECT_EQ(1u, stats.num_allocated_packets);
+  EXPECT_EQ(static_cast<size_t>(kNumFrames - 1), stats.num_reused_packets);
+  EXPECT_EQ(1u, stats.num_free_packets);
+}
+
+TYPED_TEST(RtpFecTest, PacketPoolOutlivesForwardErrorCorrection) {
+  rtc::scoped_refptr<ForwardErrorCorrection::Packet> packet;
+  {
+    TypeParam fec;
+    fec.EnablePacketPool();
+    packet = fec.AllocatePacket();
+    EXPECT_EQ(1u, fec.GetPacketPoolStats().num_allocated_packets);
+  }
+  packet->data.SetSize(kRtpHeaderSize);
+  // Releasing the last reference deletes the pool together with the packet.
+  packet = nullptr;
+}
+
+TYPED_TEST(RtpFecTest, PacketPoolStatsAreZeroWhenDisabled) {
+  rtc::scoped_refptr<ForwardErrorCorrection::Packet> packet =
+      this->fec_.AllocatePacket();
+  ForwardErrorCorrection::PacketPoolStats stats =
+      this->fec_.GetPacketPoolStats();
+  EXPECT_EQ(0u, stats.num_allocated_packets);
+  EXPECT_EQ(0u, stats.num_reused_packets);
+  EXPECT_EQ(0u, stats.num_free_packets);
+}
+
 // Verify that we don't use an old FEC packet for FEC decoding.
 TYPED_TEST(RtpFecTest, NoFecRecoveryWithOldFecPacket) {
   constexpr int kNumImportantPackets = 0;
@@ -72,6 +72,9 @@ class RtpDepacketizer {
 
     RTPVideoHeader video;
 
+    // Points into the |payload_data| passed to Parse() unless the payload had
+    // to be rewritten (e.g. H264 FU-A), in which case it points into memory
+    // owned by the depacketizer that is only valid until the next Parse().
     const uint8_t* payload;
     size_t payload_length;
   };
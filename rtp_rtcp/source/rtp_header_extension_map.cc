@@ -68,6 +68,8 @@ RtpHeaderExtensionMap::RtpHeaderExtensionMap(bool extmap_allow_mixed)
     : extmap_allow_mixed_(extmap_allow_mixed) {
   for (auto& id : ids_)
     id = kInvalidId;
+  for (auto& type : one_byte_types_)
+    type = kInvalidType;
 }
 
 RtpHeaderExtensionMap::RtpHeaderExtensionMap(
@@ -94,9 +96,8 @@ bool RtpHeaderExtensionMap::RegisterByUri(int id, absl::string_view uri) {
   return false;
 }
 
-RTPExtensionType RtpHeaderExtensionMap::GetType(int id) const {
-  RTC_DCHECK_GE(id, RtpExtension::kMinId);
-  RTC_DCHECK_LE(id, RtpExtension::kMaxId);
+RTPExtensionType RtpHeaderExtensionMap::GetTwoByteType(int id) const {
+  RTC_DCHECK_GT(id, RtpExtension::kOneByteHeaderExtensionMaxId);
   for (int type = kRtpExtensionNone + 1; type < kRtpExtensionNumberOfExtensions;
        ++type) {
     if (ids_[type] == id) {
@@ -108,7 +109,7 @@ RTPExtensionType RtpHeaderExtensionMap::GetType(int id) const {
 
 int32_t RtpHeaderExtensionMap::Deregister(RTPExtensionType type) {
   if (IsRegistered(type)) {
-    ids_[type] = kInvalidId;
+    Unregister(type);
   }
   return 0;
 }
@@ -116,12 +117,20 @@ int32_t RtpHeaderExtensionMap::Deregister(RTPExtensionType type) {
 void RtpHeaderExtensionMap::Deregister(absl::string_view uri) {
   for (const ExtensionInfo& extension : kExtensions) {
     if (extension.uri == uri) {
-      ids_[extension.type] = kInvalidId;
+      Unregister(extension.type);
       break;
     }
   }
 }
 
+void RtpHeaderExtensionMap::Unregister(RTPExtensionType type) {
+  uint8_t id = ids_[type];
+  if (id != kInvalidId && id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    one_byte_types_[id] = kInvalidType;
+  }
+  ids_[type] = kInvalidId;
+}
+
 bool RtpHeaderExtensionMap::Register(int id,
                                      RTPExtensionType type,
                                      const char* uri) {
@@ -150,9 +159,14 @@ bool RtpHeaderExtensionMap::Register(int id,
     return false;
   }
   RTC_DCHECK(!IsRegistered(type));
+  // Keep |one_byte_types_| consistent even if the type was registered before.
+  Unregister(type);
 
   // There is a run-time check above id fits into uint8_t.
   ids_[type] = static_cast<uint8_t>(id);
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    one_byte_types_[id] = type;
+  }
   return true;
 }
 
@@ -97,6 +97,33 @@ TEST(RtpHeaderExtensionTest, GetType) {
   EXPECT_EQ(TransmissionOffset::kId, map.GetType(3));
 }
 
+TEST(RtpHeaderExtensionTest, GetTypeForTwoByteId) {
+  RtpHeaderExtensionMap map;
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetType(18));
+  EXPECT_TRUE(map.Register<TransmissionOffset>(18));
+
+  EXPECT_EQ(TransmissionOffset::kId, map.GetType(18));
+}
+
+TEST(RtpHeaderExtensionTest, GetTypeAfterDeregister) {
+  RtpHeaderExtensionMap map;
+  EXPECT_TRUE(map.Register<TransmissionOffset>(3));
+  EXPECT_TRUE(map.Register<AudioLevel>(14));
+  EXPECT_TRUE(map.Register<AbsoluteSendTime>(15));
+
+  map.Deregister(TransmissionOffset::kId);
+  map.Deregister(AudioLevel::kUri);
+  map.Deregister(AbsoluteSendTime::kId);
+
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetType(3));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetType(14));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetType(15));
+
+  // Freed ids can be reused by other extensions.
+  EXPECT_TRUE(map.Register<AbsoluteSendTime>(3));
+  EXPECT_EQ(AbsoluteSendTime::kId, map.GetType(3));
+}
+
 TEST(RtpHeaderExtensionTest, GetId) {
   RtpHeaderExtensionMap map;
   EXPECT_EQ(RtpHeaderExtensionMap::kInvalidId,
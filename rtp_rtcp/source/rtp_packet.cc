@@ -59,6 +59,7 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions)
     : RtpPacket(extensions, kDefaultPacketSize) {}
 
 RtpPacket::RtpPacket(const RtpPacket&) = default;
+RtpPacket::RtpPacket(RtpPacket&&) = default;
 
 RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
     : extensions_(extensions ? *extensions : ExtensionManager()),
@@ -67,6 +68,14 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
   Clear();
 }
 
+RtpPacket::RtpPacket(const ExtensionManager* extensions,
+                     rtc::CopyOnWriteBuffer buffer)
+    : extensions_(extensions ? *extensions : ExtensionManager()),
+      buffer_(std::move(buffer)) {
+  RTC_DCHECK_GE(buffer_.size(), kFixedHeaderSize);
+  Clear();
+}
+
 RtpPacket::~RtpPacket() {}
 
 void RtpPacket::IdentifyExtensions(const ExtensionManager& extensions) {
@@ -127,6 +136,14 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   padding_size_ = 0;
 }
 
+void RtpPacket::CopyHeaderFrom(const RtpPacket& packet,
+                               rtc::CopyOnWriteBuffer buffer) {
+  RTC_DCHECK_GE(buffer.capacity(), packet.headers_size());
+  CopyHeaderFrom(packet);
+  buffer.SetData(packet.data(), packet.headers_size());
+  buffer_ = std::move(buffer);
+}
+
 void RtpPacket::SetMarker(bool marker_bit) {
   marker_ = marker_bit;
   if (marker_) {
@@ -494,57 +511,46 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
     if (extension_offset + extensions_capacity > size) {
       return false;
     }
-    if (profile != kOneByteExtensionProfileId &&
-        profile != kTwoByteExtensionProfileId) {
-      RTC_LOG(LS_WARNING) << "Unsupported rtp extension " << profile;
-    } else {
-      size_t extension_header_length = profile == kOneByteExtensionProfileId
-                                           ? kOneByteExtensionHeaderLength
-                                           : kTwoByteExtensionHeaderLength;
-      constexpr uint8_t kPaddingByte = 0;
-      constexpr uint8_t kPaddingId = 0;
+    constexpr uint8_t kPaddingByte = 0;
+    constexpr uint8_t kPaddingId = 0;
+    const uint8_t* const extensions = &buffer[extension_offset];
+    if (profile == kOneByteExtensionProfileId) {
       constexpr uint8_t kOneByteHeaderExtensionReservedId = 15;
-      while (extensions_size_ + extension_header_length < extensions_capacity) {
-        if (buffer[extension_offset + extensions_size_] == kPaddingByte) {
+      while (extensions_size_ + kOneByteExtensionHeaderLength <
+             extensions_capacity) {
+        const uint8_t header = extensions[extensions_size_];
+        if (header == kPaddingByte) {
           extensions_size_++;
           continue;
         }
-        int id;
-        uint8_t length;
-        if (profile == kOneByteExtensionProfileId) {
-          id = buffer[extension_offset + extensions_size_] >> 4;
-          length = 1 + (buffer[extension_offset + extensions_size_] & 0xf);
-          if (id == kOneByteHeaderExtensionReservedId ||
-              (id == kPaddingId && length != 1)) {
-            break;
-          }
-        } else {
-          id = buffer[extension_offset + extensions_size_];
-          length = buffer[extension_offset + extensions_size_ + 1];
+        // A non-zero header with id 0 has a length other than 1, which is
+        // not allowed for padding.
+        const int id = header >> 4;
+        if (id == kPaddingId || id == kOneByteHeaderExtensionReservedId) {
+          break;
         }
-
-        if (extensions_size_ + extension_header_length + length >
-            extensions_capacity) {
-          RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
+        if (!AddParsedExtension(id, 1 + (header & 0xf),
+                                kOneByteExtensionHeaderLength, extension_offset,
+                                extensions_capacity)) {
           break;
         }
-
-        ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
-        if (extension_info.length != 0) {
-          RTC_LOG(LS_VERBOSE)
-              << "Duplicate rtp header extension id " << id << ". Overwriting.";
+      }
+    } else if (profile == kTwoByteExtensionProfileId) {
+      while (extensions_size_ + kTwoByteExtensionHeaderLength <
+             extensions_capacity) {
+        if (extensions[extensions_size_] == kPaddingByte) {
+          extensions_size_++;
+          continue;
         }
-
-        size_t offset =
-            extension_offset + extensions_size_ + extension_header_length;
-        if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
-          RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
+        if (!AddParsedExtension(extensions[extensions_size_],
+                                extensions[extensions_size_ + 1],
+                                kTwoByteExtensionHeaderLength, extension_offset,
+                                extensions_capacity)) {
           break;
         }
-        extension_info.offset = static_cast<uint16_t>(offset);
-        extension_info.length = length;
-        extensions_size_ += extension_header_length + length;
       }
+    } else {
+      RTC_LOG(LS_WARNING) << "Unsupported rtp extension " << profile;
     }
     payload_offset_ = extension_offset + extensions_capacity;
   }
@@ -556,6 +562,34 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   return true;
 }
 
+bool RtpPacket::AddParsedExtension(int id,
+                                   uint8_t length,
+                                   size_t extension_header_length,
+                                   size_t extension_offset,
+                                   size_t extensions_capacity) {
+  if (extensions_size_ + extension_header_length + length >
+      extensions_capacity) {
+    RTC_LOG(LS_WARNING) << "Oversized rtp header extension.";
+    return false;
+  }
+
+  ExtensionInfo& extension_info = FindOrCreateExtensionInfo(id);
+  if (extension_info.length != 0) {
+    RTC_LOG(LS_VERBOSE) << "Duplicate rtp header extension id " << id
+                        << ". Overwriting.";
+  }
+
+  size_t offset = extension_offset + extensions_size_ + extension_header_length;
+  if (!rtc::IsValueInRangeForNumericType<uint16_t>(offset)) {
+    RTC_DLOG(LS_WARNING) << "Oversized rtp header extension.";
+    return false;
+  }
+  extension_info.offset = static_cast<uint16_t>(offset);
+  extension_info.length = length;
+  extensions_size_ += extension_header_length + length;
+  return true;
+}
+
 const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
   for (const ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
@@ -11,6 +11,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -33,10 +34,13 @@ class RtpPacket {
   RtpPacket();
   explicit RtpPacket(const ExtensionManager* extensions);
   RtpPacket(const RtpPacket&);
+  // Moving takes over the buffer, leaving the moved-from packet without one.
+  RtpPacket(RtpPacket&&);
   RtpPacket(const ExtensionManager* extensions, size_t capacity);
   ~RtpPacket();
 
   RtpPacket& operator=(const RtpPacket&) = default;
+  RtpPacket& operator=(RtpPacket&&) = default;
 
   // Parse and copy given buffer into Packet.
   // Does not require extension map to be registered (map is only required to
@@ -45,7 +49,9 @@ class RtpPacket {
   bool Parse(const uint8_t* buffer, size_t size);
   bool Parse(rtc::ArrayView<const uint8_t> packet);
 
-  // Parse and move given buffer into Packet.
+  // Parse and move given buffer into Packet. The packet shares the buffer
+  // with the caller rather than copying it, so views of the payload may be
+  // kept alive by holding on to Buffer().
   bool Parse(rtc::CopyOnWriteBuffer packet);
 
   // Maps extensions id to their types.
@@ -147,6 +153,20 @@ class RtpPacket {
   // Returns debug string of RTP packet (without detailed extension info).
   std::string ToString() const;
 
+ protected:
+  // Creates an empty packet that writes into |buffer|, which sets the
+  // capacity. Lets subclasses recycle packet storage.
+  RtpPacket(const ExtensionManager* extensions, rtc::CopyOnWriteBuffer buffer);
+
+  // Same as CopyHeaderFrom(), but writes the header into |buffer| instead of
+  // sharing the buffer of |packet|. |buffer| must not be shared and must have
+  // room for the header, so that neither the copy nor the payload written
+  // later allocates.
+  void CopyHeaderFrom(const RtpPacket& packet, rtc::CopyOnWriteBuffer buffer);
+
+  // Moves the storage out of the packet, which must not be used afterwards.
+  rtc::CopyOnWriteBuffer ReleaseBuffer() { return std::move(buffer_); }
+
  private:
   struct ExtensionInfo {
     explicit ExtensionInfo(uint8_t id) : ExtensionInfo(id, 0, 0) {}
@@ -161,6 +181,17 @@ class RtpPacket {
   // but does not touch packet own buffer, leaving packet in invalid state.
   bool ParseBuffer(const uint8_t* buffer, size_t size);
 
+  // Helper function for ParseBuffer. Records the extension with the given
+  // |id| and |length|, whose header starts |extensions_size_| bytes into the
+  // extension block at |extension_offset|, and advances |extensions_size_|.
+  // Returns false if the extension doesn't fit, in which case parsing of the
+  // remaining extensions should stop.
+  bool AddParsedExtension(int id,
+                          uint8_t length,
+                          size_t extension_header_length,
+                          size_t extension_offset,
+                          size_t extensions_capacity);
+
   // Returns pointer to extension info for a given id. Returns nullptr if not
   // found.
   const ExtensionInfo* FindExtensionInfo(int id) const;
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+// A process typically sends with a handful of distinct packet capacities: the
+// default one and the max packet size of each sender.
+constexpr size_t kMaxSizeClasses = 8;
+// Enough buffers to cover a key frame burst of full size packets.
+constexpr size_t kMaxIdleBuffersPerClass = 256;
+}  // namespace
+
+RtpPacketBufferPool* RtpPacketBufferPool::Global() {
+  static RtpPacketBufferPool* const pool =
+      new RtpPacketBufferPool(kMaxSizeClasses, kMaxIdleBuffersPerClass);
+  return pool;
+}
+
+RtpPacketBufferPool::RtpPacketBufferPool(size_t max_size_classes,
+                                         size_t max_idle_buffers_per_class)
+    : max_size_classes_(max_size_classes),
+      max_idle_buffers_per_class_(max_idle_buffers_per_class) {
+  size_classes_.reserve(max_size_classes_);
+}
+
+RtpPacketBufferPool::~RtpPacketBufferPool() = default;
+
+rtc::CopyOnWriteBuffer RtpPacketBufferPool::Allocate(size_t capacity) {
+  {
+    rtc::CritScope cs(&lock_);
+    SizeClass* size_class = FindSizeClass(capacity);
+    if (size_class && !size_class->buffers.empty()) {
+      rtc::CopyOnWriteBuffer buffer = std::move(size_class->buffers.back());
+      size_class->buffers.pop_back();
+      ++stats_.buffers_reused;
+      --stats_.buffers_idle;
+      // Recycled buffers are empty and unshared, so this neither allocates
+      // nor touches the contents.
+      buffer.SetSize(capacity);
+      return buffer;
+    }
+    ++stats_.buffers_allocated;
+  }
+  return rtc::CopyOnWriteBuffer(capacity);
+}
+
+std::vector<rtc::CopyOnWriteBuffer> RtpPacketBufferPool::AllocateMany(
+    size_t capacity,
+    size_t count) {
+  std::vector<rtc::CopyOnWriteBuffer> buffers;
+  buffers.reserve(count);
+  {
+    rtc::CritScope cs(&lock_);
+    SizeClass* size_class = FindSizeClass(capacity);
+    while (size_class && !size_class->buffers.empty() &&
+           buffers.size() < count) {
+      buffers.push_back(std::move(size_class->buffers.back()));
+      size_class->buffers.pop_back();
+      buffers.back().SetSize(capacity);
+    }
+    stats_.buffers_reused += buffers.size();
+    stats_.buffers_idle -= buffers.size();
+    stats_.buffers_allocated += count - buffers.size();
+  }
+  while (buffers.size() < count) {
+    buffers.emplace_back(capacity);
+  }
+  return buffers;
+}
+
+void RtpPacketBufferPool::Recycle(rtc::CopyOnWriteBuffer buffer) {
+  const size_t capacity = buffer.capacity();
+  if (capacity == 0) {
+    // Moved-from packets have no storage.
+    return;
+  }
+  // Clearing a buffer that is still shared, e.g. with a retransmission handed
+  // out by the packet history, swaps in a new empty buffer of the same
+  // capacity instead of touching the shared contents. That is an allocation,
+  // so it is done before taking the lock. Either way the pool only ever holds
+  // buffers that no packet can see.
+  const uint8_t* const data = buffer.cdata();
+  buffer.Clear();
+  RTC_DCHECK_EQ(buffer.capacity(), capacity);
+  const bool was_shared = buffer.cdata() != data;
+
+  rtc::CritScope cs(&lock_);
+  if (was_shared) {
+    ++stats_.shared_buffers_recycled;
+  }
+  SizeClass* size_class = FindSizeClass(capacity);
+  if (!size_class) {
+    if (size_classes_.size() == max_size_classes_) {
+      return;
+    }
+    size_classes_.push_back(SizeClass{capacity, {}});
+    size_class = &size_classes_.back();
+    size_class->buffers.reserve(max_idle_buffers_per_class_);
+  }
+  if (size_class->buffers.size() == max_idle_buffers_per_class_) {
+    return;
+  }
+  size_class->buffers.push_back(std::move(buffer));
+  ++stats_.buffers_idle;
+}
+
+RtpPacketBufferPool::Stats RtpPacketBufferPool::GetStats() const {
+  rtc::CritScope cs(&lock_);
+  return stats_;
+}
+
+RtpPacketBufferPool::SizeClass* RtpPacketBufferPool::FindSizeClass(
+    size_t capacity) {
+  for (SizeClass& size_class : size_classes_) {
+    if (size_class.capacity == capacity) {
+      return &size_class;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Recycles the buffers of RtpPacketToSend objects, so that steady-state
+// sending does not allocate packet storage. Buffers are kept in one free list
+// per capacity, since a sender allocates all its packets with the same
+// capacity and a packet must not be given more room than it asked for.
+//
+// Packets are created on the encoder and capture threads, and destroyed on
+// the pacer and network threads once they have been sent or evicted from the
+// packet history. The free lists are therefore shared by all threads rather
+// than cached per thread, where they would only ever fill or drain.
+class RtpPacketBufferPool {
+ public:
+  struct Stats {
+    // Number of buffers allocated because no free buffer was available.
+    size_t buffers_allocated = 0;
+    // Number of buffers handed out again from a free list.
+    size_t buffers_reused = 0;
+    // Number of buffers currently waiting in the free lists.
+    size_t buffers_idle = 0;
+    // Number of recycled buffers that were still shared with another packet,
+    // each of which cost an allocation to replace.
+    size_t shared_buffers_recycled = 0;
+  };
+
+  // The pool used by all RtpPacketToSend objects.
+  static RtpPacketBufferPool* Global();
+
+  // Keeps free lists for up to |max_size_classes| distinct capacities, with up
+  // to |max_idle_buffers_per_class| buffers each.
+  RtpPacketBufferPool(size_t max_size_classes,
+                      size_t max_idle_buffers_per_class);
+  ~RtpPacketBufferPool();
+
+  // Returns a buffer with both size and capacity |capacity|, the same as
+  // rtc::CopyOnWriteBuffer(capacity). The contents are unspecified.
+  rtc::CopyOnWriteBuffer Allocate(size_t capacity);
+
+  // Same as calling Allocate(|capacity|) |count| times, but takes the lock
+  // once, e.g. for all the packets of a frame.
+  std::vector<rtc::CopyOnWriteBuffer> AllocateMany(size_t capacity,
+                                                   size_t count);
+
+  // Returns |buffer| to the pool. If it is still shared with other packets,
+  // their contents are left alone and a new buffer of the same capacity is
+  // kept instead, allocated without holding the pool lock.
+  void Recycle(rtc::CopyOnWriteBuffer buffer);
+
+  Stats GetStats() const;
+
+ private:
+  struct SizeClass {
+    size_t capacity;
+    std::vector<rtc::CopyOnWriteBuffer> buffers;
+  };
+
+  SizeClass* FindSizeClass(size_t capacity)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const size_t max_size_classes_;
+  const size_t max_idle_buffers_per_class_;
+  rtc::CriticalSection lock_;
+  std::vector<SizeClass> size_classes_ RTC_GUARDED_BY(lock_);
+  Stats stats_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_BUFFER_POOL_H_
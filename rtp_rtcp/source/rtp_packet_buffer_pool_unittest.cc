@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
+
+#include <utility>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kCapacity = 1200;
+
+}  // namespace
+
+TEST(RtpPacketBufferPoolTest, ReusesRecycledBuffer) {
+  RtpPacketBufferPool pool(/*max_size_classes=*/2,
+                           /*max_idle_buffers_per_class=*/2);
+  rtc::CopyOnWriteBuffer buffer = pool.Allocate(kCapacity);
+  EXPECT_EQ(kCapacity, buffer.size());
+  EXPECT_EQ(kCapacity, buffer.capacity());
+  const uint8_t* data = buffer.cdata();
+  pool.Recycle(std::move(buffer));
+  EXPECT_EQ(1u, pool.GetStats().buffers_idle);
+
+  rtc::CopyOnWriteBuffer reused = pool.Allocate(kCapacity);
+  EXPECT_EQ(data, reused.cdata());
+  EXPECT_EQ(kCapacity, reused.size());
+  EXPECT_EQ(kCapacity, reused.capacity());
+
+  const RtpPacketBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(1u, stats.buffers_allocated);
+  EXPECT_EQ(1u, stats.buffers_reused);
+  EXPECT_EQ(0u, stats.buffers_idle);
+}
+
+TEST(RtpPacketBufferPoolTest, AllocatesManyFromFreeListFirst) {
+  RtpPacketBufferPool pool(/*max_size_classes=*/2,
+                           /*max_idle_buffers_per_class=*/2);
+  rtc::CopyOnWriteBuffer buffer = pool.Allocate(kCapacity);
+  const uint8_t* data = buffer.cdata();
+  pool.Recycle(std::move(buffer));
+
+  const std::vector<rtc::CopyOnWriteBuffer> buffers =
+      pool.AllocateMany(kCapacity, 3);
+  ASSERT_EQ(3u, buffers.size());
+  EXPECT_EQ(data, buffers[0].cdata());
+  for (const rtc::CopyOnWriteBuffer& allocated : buffers) {
+    EXPECT_EQ(kCapacity, allocated.size());
+    EXPECT_EQ(kCapacity, allocated.capacity());
+  }
+  EXPECT_NE(buffers[0].cdata(), buffers[1].cdata());
+  EXPECT_NE(buffers[1].cdata(), buffers[2].cdata());
+
+  const RtpPacketBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(3u, stats.buffers_allocated);
+  EXPECT_EQ(1u, stats.buffers_reused);
+  EXPECT_EQ(0u, stats.buffers_idle);
+}
+
+TEST(RtpPacketBufferPoolTest, OnlyReusesBuffersOfSameCapacity) {
+  RtpPacketBufferPool pool(/*max_size_classes=*/2,
+                           /*max_idle_buffers_per_class=*/2);
+  pool.Recycle(pool.Allocate(2 * kCapacity));
+  rtc::CopyOnWriteBuffer buffer = pool.Allocate(kCapacity);
+  EXPECT_EQ(kCapacity, buffer.capacity());
+  EXPECT_EQ(0u, pool.GetStats().buffers_reused);
+  EXPECT_EQ(1u, pool.GetStats().buffers_idle);
+}
+
+TEST(RtpPacketBufferPoolTest, SharedBufferKeepsContentsAfterRecycling) {
+  RtpPacketBufferPool pool(/*max_size_classes=*/2,
+                           /*max_idle_buffers_per_class=*/2);
+  rtc::CopyOnWriteBuffer buffer = pool.Allocate(kCapacity);
+  buffer.data()[0] = 42;
+  const rtc::CopyOnWriteBuffer copy = buffer;
+  pool.Recycle(std::move(buffer));
+  EXPECT_EQ(1u, pool.GetStats().shared_buffers_recycled);
+  EXPECT_EQ(1u, pool.GetStats().buffers_idle);
+
+  rtc::CopyOnWriteBuffer reused = pool.Allocate(kCapacity);
+  EXPECT_NE(copy.cdata(), reused.cdata());
+  reused.data()[0] = 17;
+  EXPECT_EQ(42, copy.cdata()[0]);
+  EXPECT_EQ(kCapacity, copy.size());
+  EXPECT_EQ(1u, pool.GetStats().buffers_allocated);
+  EXPECT_EQ(1u, pool.GetStats().buffers_reused);
+}
+
+TEST(RtpPacketBufferPoolTest, UnsharedBufferIsNotCountedAsShared) {
+  RtpPacketBufferPool pool(/*max_size_classes=*/2,
+                           /*max_idle_buffers_per_class=*/2);
+  pool.Recycle(pool.Allocate(kCapacity));
+  EXPECT_EQ(0u, pool.GetStats().shared_buffers_recycled);
+  EXPECT_EQ(1u, pool.GetStats().buffers_idle);
+}
+
+TEST(RtpPacketBufferPoolTest, LimitsIdleBuffers) {
+  RtpPacketBufferPool pool(/*max_size_classes=*/1,
+                           /*max_idle_buffers_per_class=*/2);
+  rtc::CopyOnWriteBuffer buffers[] = {pool.Allocate(kCapacity),
+                                      pool.Allocate(kCapacity),
+                                      pool.Allocate(kCapacity)};
+  for (rtc::CopyOnWriteBuffer& buffer : buffers) {
+    pool.Recycle(std::move(buffer));
+  }
+  EXPECT_EQ(2u, pool.GetStats().buffers_idle);
+
+  // Capacities beyond the size class limit are not kept.
+  pool.Recycle(pool.Allocate(2 * kCapacity));
+  EXPECT_EQ(2u, pool.GetStats().buffers_idle);
+}
+
+}  // namespace webrtc
@@ -23,6 +23,11 @@
 
 namespace webrtc {
 
+namespace {
+// Smallest ring allocated once a packet is stored.
+constexpr size_t kMinRingSize = 64;
+}  // namespace
+
 constexpr size_t RtpPacketHistory::kMaxCapacity;
 constexpr size_t RtpPacketHistory::kMaxPaddingtHistory;
 constexpr int64_t RtpPacketHistory::kMinPacketDurationMs;
@@ -33,6 +38,9 @@ RtpPacketHistory::PacketState::PacketState() = default;
 RtpPacketHistory::PacketState::PacketState(const PacketState&) = default;
 RtpPacketHistory::PacketState::~PacketState() = default;
 
+RtpPacketHistory::StoredPacket::StoredPacket()
+    : pending_transmission_(false), insert_order_(0), times_retransmitted_(0) {}
+
 RtpPacketHistory::StoredPacket::StoredPacket(
     std::unique_ptr<RtpPacketToSend> packet,
     absl::optional<int64_t> send_time_ms,
@@ -51,33 +59,14 @@ RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
-void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
-    PacketPrioritySet* priority_set) {
-  // Check if this StoredPacket is in the priority set. If so, we need to remove
-  // it before updating |times_retransmitted_| since that is used in sorting,
-  // and then add it back.
-  const bool in_priority_set = priority_set->erase(this) > 0;
-  ++times_retransmitted_;
-  if (in_priority_set) {
-    auto it = priority_set->insert(this);
-    RTC_DCHECK(it.second)
-        << "ERROR: Priority set already contains matching packet! In set: "
-           "insert order = "
-        << (*it.first)->insert_order_
-        << ", times retransmitted = " << (*it.first)->times_retransmitted_
-        << ". Trying to add: insert order = " << insert_order_
-        << ", times retransmitted = " << times_retransmitted_;
-  }
-}
-
-bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
-                                              StoredPacket* rhs) const {
+bool RtpPacketHistory::MoreUseful::operator()(const PaddingEntry& lhs,
+                                              const PaddingEntry& rhs) const {
   // Prefer to send packets we haven't already sent as padding.
-  if (lhs->times_retransmitted() != rhs->times_retransmitted()) {
-    return lhs->times_retransmitted() < rhs->times_retransmitted();
+  if (lhs.times_retransmitted != rhs.times_retransmitted) {
+    return lhs.times_retransmitted < rhs.times_retransmitted;
   }
   // All else being equal, prefer newer packets.
-  return lhs->insert_order() > rhs->insert_order();
+  return lhs.insert_order > rhs.insert_order;
 }
 
 RtpPacketHistory::RtpPacketHistory(Clock* clock)
@@ -85,7 +74,12 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_ms_(-1),
-      packets_inserted_(0) {}
+      byte_limit_(0),
+      first_sequence_number_(0),
+      num_slots_(0),
+      packets_inserted_(0) {
+  padding_priority_.reserve(kMaxPaddingtHistory);
+}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -133,36 +127,40 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0u &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < num_slots_ &&
+      SlotAt(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front(nullptr, absl::nullopt, 0);
+  if (num_slots_ == 0) {
+    first_sequence_number_ = rtp_seq_no;
+    packet_index = 0;
   }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back(nullptr, absl::nullopt, 0);
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    const size_t num_new_slots = -packet_index;
+    ReserveSlots(num_slots_ + num_new_slots);
+    first_sequence_number_ = rtp_seq_no;
+    num_slots_ += num_new_slots;
+    packet_index = 0;
+  } else if (static_cast<size_t>(packet_index) >= num_slots_) {
+    // Packet to be inserted behind last packet, expand back.
+    ReserveSlots(packet_index + 1);
+    num_slots_ = packet_index + 1;
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
-
-  packet_history_[packet_index] =
-      StoredPacket(std::move(packet), send_time_ms, packets_inserted_++);
-
-  if (padding_priority_.size() >= kMaxPaddingtHistory - 1) {
-    padding_priority_.erase(std::prev(padding_priority_.end()));
-  }
-  auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
-  RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
+  RTC_DCHECK_LT(packet_index, num_slots_);
+  StoredPacket& slot = SlotAt(packet_index);
+  RTC_DCHECK(slot.packet_ == nullptr);
+
+  slot = StoredPacket(std::move(packet), send_time_ms, packets_inserted_++);
+  memory_usage_.Add(slot.packet_->size());
+  AddToPaddingPriority(slot);
+  CullPacketsAboveByteLimit();
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
@@ -183,7 +181,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   }
 
   if (packet->send_time_ms_) {
-    packet->IncrementTimesRetransmitted(&padding_priority_);
+    IncrementTimesRetransmitted(packet);
   }
 
   // Update send-time and mark as no long in pacer queue.
@@ -211,6 +209,43 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
     return nullptr;
   }
 
+  bool aborted = false;
+  return GetPacketAndMarkAsPendingLocked(sequence_number, encapsulate,
+                                         &aborted);
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+RtpPacketHistory::GetPacketsAndMarkAsPending(
+    rtc::ArrayView<const uint16_t> sequence_numbers,
+    rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
+        encapsulate) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  rtc::CritScope cs(&lock_);
+  if (mode_ == StorageMode::kDisabled) {
+    return packets;
+  }
+
+  packets.reserve(sequence_numbers.size());
+  for (uint16_t sequence_number : sequence_numbers) {
+    bool aborted = false;
+    std::unique_ptr<RtpPacketToSend> packet = GetPacketAndMarkAsPendingLocked(
+        sequence_number, encapsulate, &aborted);
+    if (aborted) {
+      break;
+    }
+    if (packet) {
+      packets.push_back(std::move(packet));
+    }
+  }
+  return packets;
+}
+
+std::unique_ptr<RtpPacketToSend>
+RtpPacketHistory::GetPacketAndMarkAsPendingLocked(
+    uint16_t sequence_number,
+    rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
+        encapsulate,
+    bool* aborted) {
   StoredPacket* packet = GetStoredPacket(sequence_number);
   if (packet == nullptr) {
     return nullptr;
@@ -231,6 +266,8 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
       encapsulate(*packet->packet_);
   if (encapsulated_packet) {
     packet->pending_transmission_ = true;
+  } else {
+    *aborted = true;
   }
 
   return encapsulated_packet;
@@ -253,7 +290,7 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
   // transmission count.
   packet->send_time_ms_ = clock_->TimeInMilliseconds();
   packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted(&padding_priority_);
+  IncrementTimesRetransmitted(packet);
 }
 
 absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
@@ -264,11 +301,10 @@ absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_slots_) {
     return absl::nullopt;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = SlotAt(packet_index);
   if (packet.packet_ == nullptr) {
     return absl::nullopt;
   }
@@ -311,8 +347,9 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     return nullptr;
   }
 
-  auto best_packet_it = padding_priority_.begin();
-  StoredPacket* best_packet = *best_packet_it;
+  StoredPacket* best_packet =
+      GetStoredPacket(padding_priority_.front().sequence_number);
+  RTC_DCHECK(best_packet && best_packet->packet_);
   if (best_packet->pending_transmission_) {
     // Because PacedSender releases it's lock when it calls
     // GeneratePadding() there is the potential for a race where a new
@@ -328,18 +365,72 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   best_packet->send_time_ms_ = clock_->TimeInMilliseconds();
-  best_packet->IncrementTimesRetransmitted(&padding_priority_);
+  IncrementTimesRetransmitted(best_packet);
 
   return padding_packet;
 }
 
+std::vector<std::unique_ptr<RtpPacketToSend>>
+RtpPacketHistory::GetPayloadPaddingPackets(
+    size_t target_size_bytes,
+    size_t min_padding_bytes,
+    rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
+        encapsulate) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
+  rtc::CritScope cs(&lock_);
+  if (mode_ == StorageMode::kDisabled) {
+    return padding_packets;
+  }
+
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  size_t bytes_left = target_size_bytes;
+  while (bytes_left >= min_padding_bytes) {
+    // |padding_priority_| is sorted on retransmission count first, so the
+    // packets retransmitted the least are at the front.
+    StoredPacket* best_packet = nullptr;
+    size_t best_payload_size = 0;
+    size_t best_times_retransmitted = 0;
+    for (const PaddingEntry& entry : padding_priority_) {
+      if (best_packet &&
+          entry.times_retransmitted != best_times_retransmitted) {
+        break;
+      }
+      if (entry.payload_size <= best_payload_size) {
+        continue;
+      }
+      StoredPacket* packet = GetStoredPacket(entry.sequence_number);
+      RTC_DCHECK(packet && packet->packet_);
+      if (packet->pending_transmission_) {
+        continue;
+      }
+      best_packet = packet;
+      best_payload_size = entry.payload_size;
+      best_times_retransmitted = entry.times_retransmitted;
+    }
+    if (!best_packet) {
+      break;
+    }
+
+    auto padding_packet = encapsulate(*best_packet->packet_);
+    if (!padding_packet) {
+      break;
+    }
+
+    best_packet->send_time_ms_ = now_ms;
+    IncrementTimesRetransmitted(best_packet);
+    bytes_left -= std::min(bytes_left, padding_packet->payload_size());
+    padding_packets.push_back(std::move(padding_packet));
+  }
+  return padding_packets;
+}
+
 void RtpPacketHistory::CullAcknowledgedPackets(
     rtc::ArrayView<const uint16_t> sequence_numbers) {
   rtc::CritScope cs(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
-    if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+    if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_slots_ ||
+        SlotAt(packet_index).packet_ == nullptr) {
       continue;
     }
     RemovePacket(packet_index);
@@ -366,23 +457,39 @@ void RtpPacketHistory::Clear() {
   Reset();
 }
 
+void RtpPacketHistory::SetByteLimit(size_t byte_limit) {
+  rtc::CritScope cs(&lock_);
+  byte_limit_ = byte_limit;
+  CullPacketsAboveByteLimit();
+}
+
+BufferMemoryUsage RtpPacketHistory::GetMemoryUsage() const {
+  rtc::CritScope cs(&lock_);
+  return memory_usage_;
+}
+
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < num_slots_; ++i) {
+    SlotAt(i) = StoredPacket();
+  }
+  first_sequence_number_ = 0;
+  num_slots_ = 0;
   padding_priority_.clear();
+  memory_usage_.Clear();
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   int64_t packet_duration_ms =
       std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (num_slots_ > 0) {
+    if (num_slots_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = SlotAt(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -393,7 +500,7 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_slots_ >= number_to_store_ ||
         *stored_packet.send_time_ms_ +
                 (packet_duration_ms * kPacketCullingDelayFactor) <=
             now_ms) {
@@ -407,19 +514,30 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   }
 }
 
+void RtpPacketHistory::CullPacketsAboveByteLimit() {
+  while (byte_limit_ > 0 && memory_usage_.bytes > byte_limit_ &&
+         memory_usage_.num_items > 1) {
+    RemovePacket(0);
+  }
+}
+
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
+  StoredPacket& slot = SlotAt(packet_index);
   // Move the packet out from the StoredPacket container.
-  std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+  std::unique_ptr<RtpPacketToSend> rtp_packet = std::move(slot.packet_);
 
-  // Erase from padding priority set, if eligible.
-  padding_priority_.erase(&packet_history_[packet_index]);
+  // Erase from padding priority queue, if eligible.
+  if (rtp_packet) {
+    RemoveFromPaddingPriority(rtp_packet->SequenceNumber());
+    memory_usage_.Remove(rtp_packet->size());
+  }
+  slot = StoredPacket();
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (num_slots_ > 0 && SlotAt(0).packet_ == nullptr) {
+      ++first_sequence_number_;
+      --num_slots_;
     }
   }
 
@@ -427,12 +545,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (num_slots_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(SlotAt(0).packet_ != nullptr);
+  int first_seq = first_sequence_number_;
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -456,10 +574,84 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size()) {
+  if (index < 0 || static_cast<size_t>(index) >= num_slots_) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &SlotAt(index);
+}
+
+RtpPacketHistory::StoredPacket& RtpPacketHistory::SlotAt(int packet_index) {
+  RTC_DCHECK(!packet_history_.empty());
+  const size_t mask = packet_history_.size() - 1;
+  return packet_history_[(first_sequence_number_ + packet_index) & mask];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::SlotAt(
+    int packet_index) const {
+  RTC_DCHECK(!packet_history_.empty());
+  const size_t mask = packet_history_.size() - 1;
+  return packet_history_[(first_sequence_number_ + packet_index) & mask];
+}
+
+void RtpPacketHistory::ReserveSlots(size_t num_slots) {
+  if (num_slots <= packet_history_.size()) {
+    return;
+  }
+  // A span never exceeds half the sequence number space, see
+  // GetPacketIndex(), so the ring never needs more than 2^16 slots.
+  RTC_DCHECK_LE(num_slots, size_t{1} << 16);
+  size_t new_size = std::max(kMinRingSize, packet_history_.size());
+  while (new_size < num_slots) {
+    new_size *= 2;
+  }
+
+  std::vector<StoredPacket> new_history(new_size);
+  const size_t new_mask = new_size - 1;
+  for (size_t i = 0; i < num_slots_; ++i) {
+    new_history[(first_sequence_number_ + i) & new_mask] =
+        std::move(SlotAt(i));
+  }
+  packet_history_.swap(new_history);
+}
+
+void RtpPacketHistory::AddToPaddingPriority(const StoredPacket& packet) {
+  if (padding_priority_.size() >= kMaxPaddingtHistory - 1) {
+    padding_priority_.pop_back();
+  }
+  InsertPaddingEntry({packet.packet_->SequenceNumber(),
+                      packet.times_retransmitted(), packet.insert_order(),
+                      packet.packet_->payload_size()});
+}
+
+void RtpPacketHistory::InsertPaddingEntry(const PaddingEntry& entry) {
+  auto it = std::upper_bound(padding_priority_.begin(),
+                             padding_priority_.end(), entry, MoreUseful());
+  padding_priority_.insert(it, entry);
+}
+
+bool RtpPacketHistory::RemoveFromPaddingPriority(uint16_t sequence_number) {
+  auto it = std::find_if(padding_priority_.begin(), padding_priority_.end(),
+                         [sequence_number](const PaddingEntry& entry) {
+                           return entry.sequence_number == sequence_number;
+                         });
+  if (it == padding_priority_.end()) {
+    return false;
+  }
+  padding_priority_.erase(it);
+  return true;
+}
+
+void RtpPacketHistory::IncrementTimesRetransmitted(StoredPacket* packet) {
+  // The retransmission count is used in sorting, so an entry in the padding
+  // priority queue has to be removed before the update and added back after.
+  const bool in_priority_queue =
+      RemoveFromPaddingPriority(packet->packet_->SequenceNumber());
+  packet->IncrementTimesRetransmitted();
+  if (in_priority_queue) {
+    InsertPaddingEntry({packet->packet_->SequenceNumber(),
+                        packet->times_retransmitted(), packet->insert_order(),
+                        packet->packet_->payload_size()});
+  }
 }
 
 RtpPacketHistory::PacketState RtpPacketHistory::StoredPacketToPacketState(
@@ -11,13 +11,11 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
-#include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "api/function_view.h"
+#include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
@@ -101,6 +99,16 @@ class RtpPacketHistory {
       rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
           const RtpPacketToSend&)> encapsulate);
 
+  // Batched version of GetPacketAndMarkAsPending(), which resolves all of
+  // |sequence_numbers| under a single lock acquisition. Packets that are not
+  // found, already pending or (re)sent too recently are skipped. If the
+  // encapsulator returns nullptr, the remaining sequence numbers are not
+  // processed. Returned packets are in the order they were requested.
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetPacketsAndMarkAsPending(
+      rtc::ArrayView<const uint16_t> sequence_numbers,
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate);
+
   // Updates the send time for the given packet and increments the transmission
   // counter. Marks the packet as no longer being in the pacer queue.
   void MarkPacketAsSent(uint16_t sequence_number);
@@ -123,6 +131,19 @@ class RtpPacketHistory {
       rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
           const RtpPacketToSend&)> encapsulate);
 
+  // Batched version of GetPayloadPaddingPacket(), which returns packets under
+  // a single lock acquisition until fewer than |min_padding_bytes| of
+  // |target_size_bytes| remain, counting the payloads of the encapsulated
+  // packets. Among the packets retransmitted the least, the one with the
+  // largest payload is picked, so that the target is reached with as few
+  // packets as possible. Pending packets and packets without payload are
+  // skipped. Stops early if the encapsulator returns nullptr.
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetPayloadPaddingPackets(
+      size_t target_size_bytes,
+      size_t min_padding_bytes,
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate);
+
   // Cull packets that have been acknowledged as received by the remote end.
   void CullAcknowledgedPackets(rtc::ArrayView<const uint16_t> sequence_numbers);
 
@@ -135,13 +156,16 @@ class RtpPacketHistory {
   // capacity.
   void Clear();
 
- private:
-  struct MoreUseful;
-  class StoredPacket;
-  using PacketPrioritySet = std::set<StoredPacket*, MoreUseful>;
+  // Caps the bytes of the stored packets. The oldest packets are removed as
+  // soon as newer ones take the history above |byte_limit|, even if they could
+  // still be retransmitted. A |byte_limit| of 0 is equivalent to no limit.
+  void SetByteLimit(size_t byte_limit);
+  BufferMemoryUsage GetMemoryUsage() const;
 
+ private:
   class StoredPacket {
    public:
+    StoredPacket();
     StoredPacket(std::unique_ptr<RtpPacketToSend> packet,
                  absl::optional<int64_t> send_time_ms,
                  uint64_t insert_order);
@@ -151,7 +175,7 @@ class RtpPacketHistory {
 
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
-    void IncrementTimesRetransmitted(PacketPrioritySet* priority_set);
+    void IncrementTimesRetransmitted() { ++times_retransmitted_; }
 
     // The time of last transmission, including retransmissions.
     absl::optional<int64_t> send_time_ms_;
@@ -170,16 +194,37 @@ class RtpPacketHistory {
     // Number of times RE-transmitted, ie excluding the first transmission.
     size_t times_retransmitted_;
   };
+
+  // Entry in |padding_priority_|. Holds a copy of the sort keys, and of the
+  // payload size used by GetPayloadPaddingPackets(), so that walking the queue
+  // never needs to look up the packet in the ring.
+  struct PaddingEntry {
+    uint16_t sequence_number;
+    size_t times_retransmitted;
+    uint64_t insert_order;
+    size_t payload_size;
+  };
   struct MoreUseful {
-    bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
+    bool operator()(const PaddingEntry& lhs, const PaddingEntry& rhs) const;
   };
 
+  // Shared by the single and batched GetPacketAndMarkAsPending() versions.
+  // Sets |*aborted| if the encapsulator returned nullptr.
+  std::unique_ptr<RtpPacketToSend> GetPacketAndMarkAsPendingLocked(
+      uint16_t sequence_number,
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate,
+      bool* aborted) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
   // check if packet has too recently been sent.
   bool VerifyRtt(const StoredPacket& packet, int64_t now_ms) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Removes the oldest packets until the history is within |byte_limit_|,
+  // keeping at least the newest packet.
+  void CullPacketsAboveByteLimit() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
   // stored. Returns the RTP packet instance contained within the StoredPacket.
   std::unique_ptr<RtpPacketToSend> RemovePacket(int packet_index)
@@ -191,25 +236,51 @@ class RtpPacketHistory {
   static PacketState StoredPacketToPacketState(
       const StoredPacket& stored_packet);
 
+  // Returns the ring slot |packet_index| positions after the first packet.
+  StoredPacket& SlotAt(int packet_index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& SlotAt(int packet_index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Grows the ring, if needed, so that it can span |num_slots| consecutive
+  // sequence numbers starting at |first_sequence_number_|.
+  void ReserveSlots(size_t num_slots) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Inserts |packet| in |padding_priority_|, evicting the least useful entry
+  // if the queue is full.
+  void AddToPaddingPriority(const StoredPacket& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void InsertPaddingEntry(const PaddingEntry& entry)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns true if an entry for |sequence_number| was found and removed.
+  bool RemoveFromPaddingPriority(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void IncrementTimesRetransmitted(StoredPacket* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   Clock* const clock_;
   rtc::CriticalSection lock_;
   size_t number_to_store_ RTC_GUARDED_BY(lock_);
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   int64_t rtt_ms_ RTC_GUARDED_BY(lock_);
-
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
-  // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with |packet_| set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  size_t byte_limit_ RTC_GUARDED_BY(lock_);
+  BufferMemoryUsage memory_usage_ RTC_GUARDED_BY(lock_);
+
+  // Ring of stored packets with a power-of-two size, where the packet with
+  // sequence number |seq| lives in slot |seq & (size - 1)|. The ring spans
+  // |num_slots_| consecutive sequence numbers starting from
+  // |first_sequence_number_|; slots outside that span are always empty. Slots
+  // inside it may be empty if packets were removed out-of-order, but the first
+  // slot is always populated. The ring only ever grows, so steady-state
+  // operation does not allocate.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  uint16_t first_sequence_number_ RTC_GUARDED_BY(lock_);
+  size_t num_slots_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
-  // Objects from |packet_history_| ordered by "most likely to be useful", used
-  // in GetPayloadPaddingPacket().
-  PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
+  // Packets from |packet_history_| ordered by "most likely to be useful", used
+  // in GetPayloadPaddingPacket(). Kept as a small sorted array since it never
+  // holds more than |kMaxPaddingtHistory| entries.
+  std::vector<PaddingEntry> padding_priority_ RTC_GUARDED_BY(lock_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumRounds = 20;
+constexpr uint16_t kStartSeqNum = 60000;
+
+std::unique_ptr<RtpPacketToSend> CreateRtpPacket(uint16_t seq_num) {
+  std::unique_ptr<RtpPacketToSend> packet(new RtpPacketToSend(nullptr));
+  packet->SetSequenceNumber(seq_num);
+  packet->SetPayloadSize(1000);
+  packet->set_allow_retransmission(true);
+  return packet;
+}
+
+}  // namespace
+
+// Simulates a NACK-heavy stream: a full history of stored packets with random
+// retransmission requests and payload padding taken from the history.
+TEST(RtpPacketHistoryPerformanceTest, DISABLED_NackHeavyStream) {
+  for (size_t num_stored_packets : {600, 3000, 9000}) {
+    SimulatedClock clock(123456);
+    RtpPacketHistory history(&clock);
+    history.SetStorePacketsStatus(
+        RtpPacketHistory::StorageMode::kStoreAndCull, num_stored_packets);
+    Random random(0x7157);
+    uint16_t seq_num = kStartSeqNum;
+    for (size_t i = 0; i < num_stored_packets; ++i) {
+      history.PutRtpPacket(CreateRtpPacket(seq_num++),
+                           clock.TimeInMilliseconds());
+    }
+
+    std::vector<uint16_t> nacked;
+    int64_t put_us = 0;
+    int64_t resend_us = 0;
+    int64_t padding_us = 0;
+    for (int round = 0; round < kNumRounds; ++round) {
+      clock.AdvanceTimeMilliseconds(10);
+      std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+      for (size_t i = 0; i < num_stored_packets / 10; ++i) {
+        packets.push_back(CreateRtpPacket(seq_num++));
+      }
+      int64_t start_us = rtc::TimeMicros();
+      for (auto& packet : packets) {
+        history.PutRtpPacket(std::move(packet), clock.TimeInMilliseconds());
+      }
+      put_us += rtc::TimeMicros() - start_us;
+
+      nacked.clear();
+      for (size_t i = 0; i < num_stored_packets / 10; ++i) {
+        nacked.push_back(seq_num - 1 -
+                         random.Rand(0, static_cast<int>(num_stored_packets) -
+                                            1));
+      }
+      clock.AdvanceTimeMilliseconds(10);
+      start_us = rtc::TimeMicros();
+      for (uint16_t nacked_seq_num : nacked) {
+        history.GetPacketAndSetSendTime(nacked_seq_num);
+      }
+      resend_us += rtc::TimeMicros() - start_us;
+
+      start_us = rtc::TimeMicros();
+      for (int i = 0; i < 100; ++i) {
+        history.GetPayloadPaddingPacket();
+      }
+      padding_us += rtc::TimeMicros() - start_us;
+    }
+
+    const double num_ops = kNumRounds * (num_stored_packets / 10);
+    rtc::StringBuilder story;
+    story << num_stored_packets << "_stored";
+    test::PrintResult("packet_history_put_time", "", story.str(),
+                      1000.0 * put_us / num_ops, "ns", false);
+    test::PrintResult("packet_history_resend_time", "", story.str(),
+                      1000.0 * resend_us / num_ops, "ns", false);
+    test::PrintResult("packet_history_padding_time", "", story.str(),
+                      1000.0 * padding_us / (kNumRounds * 100), "ns", false);
+  }
+}
+
+}  // namespace webrtc
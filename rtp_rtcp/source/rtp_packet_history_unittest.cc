@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -735,6 +736,42 @@ TEST_F(RtpPacketHistoryTest, PayloadPaddingWithEncapsulation) {
   EXPECT_EQ(padding_packet->SequenceNumber(), kStartSeqNum + 1);
 }
 
+TEST_F(RtpPacketHistoryTest, PayloadPaddingPacketsPreferLargePayloads) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  const size_t kPayloadSizes[] = {100, 500, 0};
+  for (size_t i = 0; i < 3; ++i) {
+    std::unique_ptr<RtpPacketToSend> packet =
+        CreateRtpPacket(To16u(kStartSeqNum + i));
+    packet->SetPayloadSize(kPayloadSizes[i]);
+    hist_.PutRtpPacket(std::move(packet), fake_clock_.TimeInMilliseconds());
+  }
+  auto copy = [](const RtpPacketToSend& packet) {
+    return std::make_unique<RtpPacketToSend>(packet);
+  };
+
+  // The largest payload first, then the next one among the packets that have
+  // not been retransmitted, until less than 50 bytes are left. The packet
+  // without payload is never used.
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets =
+      hist_.GetPayloadPaddingPackets(600, 50, copy);
+  ASSERT_EQ(2u, packets.size());
+  EXPECT_EQ(To16u(kStartSeqNum + 1), packets[0]->SequenceNumber());
+  EXPECT_EQ(kStartSeqNum, packets[1]->SequenceNumber());
+
+  // Pending packets are skipped.
+  EXPECT_TRUE(hist_.SetPendingTransmission(To16u(kStartSeqNum + 1)));
+  packets = hist_.GetPayloadPaddingPackets(50, 50, copy);
+  ASSERT_EQ(1u, packets.size());
+  EXPECT_EQ(kStartSeqNum, packets[0]->SequenceNumber());
+
+  // Aborted padding.
+  EXPECT_TRUE(hist_
+                  .GetPayloadPaddingPackets(
+                      600, 50,
+                      [](const RtpPacketToSend& packet) { return nullptr; })
+                  .empty());
+}
+
 TEST_F(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
 
@@ -766,4 +803,141 @@ TEST_F(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
     expected_time_offset_ms += 33;
   }
 }
+
+// Stores enough packets for the ring to grow several times while the sequence
+// number wraps, and verifies that every packet can still be found.
+TEST_F(RtpPacketHistoryTest, StoresManyPacketsAcrossWrap) {
+  const size_t kNumPackets = RtpPacketHistory::kMaxCapacity - 1;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kNumPackets);
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.TimeInMilliseconds());
+  }
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + i)).has_value());
+  }
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 1)).has_value());
+  EXPECT_FALSE(
+      hist_.GetPacketState(To16u(kStartSeqNum + kNumPackets)).has_value());
+}
+
+// Removing the first packets out of order must advance the start of the
+// stored range past any gaps.
+TEST_F(RtpPacketHistoryTest, RemovesGapsAtFrontAfterCulling) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  for (int i = 0; i < 4; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.TimeInMilliseconds());
+  }
+  hist_.CullAcknowledgedPackets(
+      std::vector<uint16_t>{To16u(kStartSeqNum + 1), To16u(kStartSeqNum + 2)});
+  hist_.CullAcknowledgedPackets(std::vector<uint16_t>{kStartSeqNum});
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum).has_value());
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 3)).has_value());
+
+  // A packet older than the remaining one is inserted in front of it.
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 1)),
+                     fake_clock_.TimeInMilliseconds());
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 1)).has_value());
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 2)).has_value());
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 3)).has_value());
+}
+
+// Retransmissions reorder packets in the padding priority queue.
+TEST_F(RtpPacketHistoryTest, PaddingPriorityAfterRetransmissions) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  for (int i = 0; i < 3; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.TimeInMilliseconds());
+  }
+  // Retransmit the newest packet twice and the oldest once, leaving the
+  // middle one as the most useful.
+  fake_clock_.AdvanceTimeMilliseconds(1);
+  EXPECT_TRUE(hist_.GetPacketAndSetSendTime(To16u(kStartSeqNum + 2)));
+  fake_clock_.AdvanceTimeMilliseconds(1);
+  EXPECT_TRUE(hist_.GetPacketAndSetSendTime(To16u(kStartSeqNum + 2)));
+  fake_clock_.AdvanceTimeMilliseconds(1);
+  EXPECT_TRUE(hist_.GetPacketAndSetSendTime(kStartSeqNum));
+
+  std::unique_ptr<RtpPacketToSend> packet = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(To16u(kStartSeqNum + 1), packet->SequenceNumber());
+  packet = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(To16u(kStartSeqNum + 1), packet->SequenceNumber());
+  packet = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(kStartSeqNum, packet->SequenceNumber());
+}
+
+TEST_F(RtpPacketHistoryTest, GetPacketsAndMarkAsPendingSkipsAndAborts) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  for (int i = 0; i < 4; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.TimeInMilliseconds());
+  }
+  // Mark one packet as pending so that it is skipped.
+  EXPECT_TRUE(hist_.GetPacketAndMarkAsPending(To16u(kStartSeqNum + 1)));
+
+  const uint16_t kRequested[] = {kStartSeqNum, To16u(kStartSeqNum + 1),
+                                 To16u(kStartSeqNum + 100),
+                                 To16u(kStartSeqNum + 2),
+                                 To16u(kStartSeqNum + 3)};
+  // Abort when reaching the last packet.
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets =
+      hist_.GetPacketsAndMarkAsPending(
+          kRequested, [](const RtpPacketToSend& packet) {
+            std::unique_ptr<RtpPacketToSend> copy;
+            if (packet.SequenceNumber() != To16u(kStartSeqNum + 3)) {
+              copy = std::make_unique<RtpPacketToSend>(packet);
+            }
+            return copy;
+          });
+  ASSERT_EQ(2u, packets.size());
+  EXPECT_EQ(kStartSeqNum, packets[0]->SequenceNumber());
+  EXPECT_EQ(To16u(kStartSeqNum + 2), packets[1]->SequenceNumber());
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum)->pending_transmission);
+  EXPECT_TRUE(
+      hist_.GetPacketState(To16u(kStartSeqNum + 2))->pending_transmission);
+  EXPECT_FALSE(
+      hist_.GetPacketState(To16u(kStartSeqNum + 3))->pending_transmission);
+}
+
+TEST_F(RtpPacketHistoryTest, TracksMemoryUsage) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
+  const size_t packet_size = packet->size();
+  hist_.PutRtpPacket(std::move(packet), absl::nullopt);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 1)), absl::nullopt);
+  EXPECT_EQ(2 * packet_size, hist_.GetMemoryUsage().bytes);
+  EXPECT_EQ(2u, hist_.GetMemoryUsage().num_items);
+
+  hist_.CullAcknowledgedPackets(std::vector<uint16_t>{kStartSeqNum});
+  EXPECT_EQ(packet_size, hist_.GetMemoryUsage().bytes);
+  EXPECT_EQ(1u, hist_.GetMemoryUsage().num_items);
+  EXPECT_EQ(2 * packet_size, hist_.GetMemoryUsage().max_bytes);
+}
+
+TEST_F(RtpPacketHistoryTest, ByteLimitRemovesOldestPackets) {
+  hist_.SetStorePacketsStatus(StorageMode::kStore, 10);
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
+  const size_t packet_size = packet->size();
+  hist_.SetByteLimit(2 * packet_size);
+  hist_.PutRtpPacket(std::move(packet), absl::nullopt);
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 1)), absl::nullopt);
+  EXPECT_TRUE(hist_.GetPacketState(kStartSeqNum));
+
+  // A third packet exceeds the limit and evicts the oldest one.
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + 2)), absl::nullopt);
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 1)));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 2)));
+  EXPECT_EQ(2 * packet_size, hist_.GetMemoryUsage().bytes);
+
+  // Lowering the limit evicts immediately, but keeps the newest packet.
+  hist_.SetByteLimit(1);
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum + 1)));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 2)));
+  EXPECT_EQ(1u, hist_.GetMemoryUsage().num_items);
+}
 }  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_utility.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumPackets = 200000;
+constexpr uint32_t kSsrc = 0x12345678;
+
+// Registers the extensions a typical video stream carries, using either
+// one-byte or two-byte ids.
+RtpHeaderExtensionMap CreateExtensionMap(bool two_byte) {
+  RtpHeaderExtensionMap map(/*extmap_allow_mixed=*/two_byte);
+  const int first_id = two_byte ? 16 : 1;
+  map.Register<TransmissionOffset>(first_id);
+  map.Register<AbsoluteSendTime>(first_id + 1);
+  map.Register<TransportSequenceNumber>(first_id + 2);
+  map.Register<VideoOrientation>(first_id + 3);
+  map.Register<PlayoutDelayLimits>(first_id + 4);
+  map.Register<VideoContentTypeExtension>(first_id + 5);
+  map.Register<VideoTimingExtension>(first_id + 6);
+  return map;
+}
+
+rtc::CopyOnWriteBuffer CreatePacket(const RtpHeaderExtensionMap* map,
+                                    uint16_t seq_num) {
+  RtpPacketToSend packet(map);
+  packet.SetPayloadType(96);
+  packet.SetSequenceNumber(seq_num);
+  packet.SetTimestamp(seq_num * 3000u);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransmissionOffset>(1234);
+  packet.SetExtension<AbsoluteSendTime>(0x123456);
+  packet.SetExtension<TransportSequenceNumber>(seq_num);
+  packet.SetExtension<VideoOrientation>(kVideoRotation_90);
+  packet.SetExtension<PlayoutDelayLimits>(PlayoutDelay{100, 200});
+  packet.SetExtension<VideoContentTypeExtension>(VideoContentType::UNSPECIFIED);
+  packet.SetExtension<VideoTimingExtension>(VideoSendTiming{});
+  packet.SetPayloadSize(1000);
+  return packet.Buffer();
+}
+
+}  // namespace
+
+// Measures the time needed to parse the header of a packet carrying the
+// extensions of a typical video stream.
+TEST(RtpPacketPerformanceTest, DISABLED_ParseWithExtensions) {
+  for (bool two_byte : {false, true}) {
+    const RtpHeaderExtensionMap map = CreateExtensionMap(two_byte);
+    const rtc::CopyOnWriteBuffer buffer = CreatePacket(&map, 1);
+    const char* story = two_byte ? "two_byte_ids" : "one_byte_ids";
+
+    RtpPacketReceived packet(&map);
+    uint16_t transport_seq_num = 0;
+    int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumPackets; ++i) {
+      ASSERT_TRUE(packet.Parse(buffer));
+      packet.GetExtension<TransportSequenceNumber>(&transport_seq_num);
+    }
+    const int64_t parse_us = rtc::TimeMicros() - start_us;
+    EXPECT_EQ(1, transport_seq_num);
+
+    RTPHeader header;
+    RtpUtility::RtpHeaderParser parser(buffer.cdata(), buffer.size());
+    start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumPackets; ++i) {
+      ASSERT_TRUE(parser.Parse(&header, &map));
+    }
+    const int64_t header_parser_us = rtc::TimeMicros() - start_us;
+
+    test::PrintResult("rtp_packet_parse_time", "", story,
+                      1000.0 * parse_us / kNumPackets, "ns", false);
+    test::PrintResult("rtp_header_parser_parse_time", "", story,
+                      1000.0 * header_parser_us / kNumPackets, "ns", false);
+  }
+}
+
+}  // namespace webrtc
@@ -11,14 +11,22 @@
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 
 #include <cstdint>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
 
 namespace webrtc {
+namespace {
+// Same as the default capacity of RtpPacket.
+constexpr size_t kDefaultPacketSize = 1500;
+}  // namespace
 
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions)
-    : RtpPacket(extensions) {}
+    : RtpPacketToSend(extensions, kDefaultPacketSize) {}
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions,
                                  size_t capacity)
-    : RtpPacket(extensions, capacity) {}
+    : RtpPacket(extensions,
+                RtpPacketBufferPool::Global()->Allocate(capacity)) {}
 RtpPacketToSend::RtpPacketToSend(const RtpPacketToSend& packet) = default;
 RtpPacketToSend::RtpPacketToSend(RtpPacketToSend&& packet) = default;
 
@@ -26,6 +34,23 @@ RtpPacketToSend& RtpPacketToSend::operator=(const RtpPacketToSend& packet) =
     default;
 RtpPacketToSend& RtpPacketToSend::operator=(RtpPacketToSend&& packet) = default;
 
-RtpPacketToSend::~RtpPacketToSend() = default;
+RtpPacketToSend::~RtpPacketToSend() {
+  RtpPacketBufferPool::Global()->Recycle(ReleaseBuffer());
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>> RtpPacketToSend::CopyHeaders(
+    const RtpPacketToSend& packet,
+    size_t count) {
+  std::vector<rtc::CopyOnWriteBuffer> buffers =
+      RtpPacketBufferPool::Global()->AllocateMany(packet.capacity(), count);
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.reserve(count);
+  for (rtc::CopyOnWriteBuffer& buffer : buffers) {
+    auto copy = std::make_unique<RtpPacketToSend>(packet);
+    copy->CopyHeaderFrom(packet, std::move(buffer));
+    packets.push_back(std::move(copy));
+  }
+  return packets;
+}
 
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -43,6 +44,15 @@ class RtpPacketToSend : public RtpPacket {
 
   ~RtpPacketToSend();
 
+  // Returns |count| copies of |packet|, including its metadata but not its
+  // payload, for packetizing a frame. A plain copy shares the buffer of
+  // |packet| and allocates a new one when its payload is written; these each
+  // get their own buffer of the same capacity instead, all taken from the
+  // buffer pool at once.
+  static std::vector<std::unique_ptr<RtpPacketToSend>> CopyHeaders(
+      const RtpPacketToSend& packet,
+      size_t count);
+
   // Time in local time base as close as it can to frame capture time.
   int64_t capture_time_ms() const { return capture_time_ms_; }
 
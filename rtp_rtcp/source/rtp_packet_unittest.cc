@@ -239,6 +239,55 @@ TEST(RtpPacketTest, CreateWith2Extensions) {
               ElementsAreArray(packet.data(), packet.size()));
 }
 
+TEST(RtpPacketTest, MoveTakesOverTheBuffer) {
+  RtpPacketToSend packet(nullptr);
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSequenceNumber(kSeqNum);
+  packet.SetTimestamp(kTimestamp);
+  packet.SetSsrc(kSsrc);
+  const uint8_t* const data = packet.data();
+
+  RtpPacketToSend moved(std::move(packet));
+  EXPECT_EQ(data, moved.data());
+  EXPECT_THAT(kMinimumPacket, ElementsAreArray(moved.data(), moved.size()));
+  EXPECT_EQ(0u, packet.capacity());
+
+  RtpPacketToSend assigned(nullptr);
+  assigned = std::move(moved);
+  EXPECT_EQ(data, assigned.data());
+  EXPECT_EQ(0u, moved.capacity());
+}
+
+TEST(RtpPacketTest, CopyHeadersGivesEachCopyItsOwnBuffer) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacketToSend packet(&extensions);
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSequenceNumber(kSeqNum);
+  packet.SetTimestamp(kTimestamp);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransmissionOffset>(kTimeOffset);
+  packet.set_capture_time_ms(1234);
+
+  constexpr size_t kNumCopies = 3;
+  std::vector<std::unique_ptr<RtpPacketToSend>> copies =
+      RtpPacketToSend::CopyHeaders(packet, kNumCopies);
+  ASSERT_EQ(kNumCopies, copies.size());
+  for (const auto& copy : copies) {
+    EXPECT_THAT(kPacketWithTO, ElementsAreArray(copy->data(), copy->size()));
+    EXPECT_EQ(packet.capacity(), copy->capacity());
+    EXPECT_EQ(1234, copy->capture_time_ms());
+    EXPECT_NE(packet.data(), copy->data());
+
+    // Writing the payload does not need a new buffer.
+    const uint8_t* const data = copy->data();
+    copy->SetPayloadSize(copy->MaxPayloadSize());
+    EXPECT_EQ(data, copy->data());
+  }
+  EXPECT_NE(copies[0]->data(), copies[1]->data());
+  EXPECT_THAT(kPacketWithTO, ElementsAreArray(packet.data(), packet.size()));
+}
+
 TEST(RtpPacketTest, CreateWithTwoByteHeaderExtensionFirst) {
   RtpPacketToSend::ExtensionManager extensions(true);
   extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
@@ -19,9 +19,11 @@
 #include <string>
 #include <utility>
 
+#include "absl/strings/string_view.h"
 #include "api/transport/field_trial_based_config.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
+#include "modules/utility/include/process_thread.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 
@@ -36,6 +38,13 @@ const int64_t kRtpRtcpMaxIdleTimeProcessMs = 5;
 const int64_t kRtpRtcpRttProcessTimeMs = 1000;
 const int64_t kRtpRtcpBitrateProcessTimeMs = 10;
 const int64_t kDefaultExpectedRetransmissionTimeMs = 125;
+
+bool IsEnabled(absl::string_view name,
+               const WebRtcKeyValueConfig* field_trials) {
+  FieldTrialBasedConfig default_trials;
+  auto& trials = field_trials ? *field_trials : default_trials;
+  return trials.Lookup(name).find("Enabled") == 0;
+}
 }  // namespace
 
 RtpRtcp::Configuration::Configuration() = default;
@@ -54,6 +63,9 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const Configuration& configuration)
       last_rtt_process_time_(clock_->TimeInMilliseconds()),
       next_process_time_(clock_->TimeInMilliseconds() +
                          kRtpRtcpMaxIdleTimeProcessMs),
+      event_driven_process_(IsEnabled("WebRTC-RtpRtcpEventDrivenProcess",
+                                      configuration.field_trials)),
+      process_thread_(nullptr),
       packet_overhead_(28),  // IPV4 UDP.
       nack_last_time_sent_full_ms_(0),
       nack_last_seq_number_sent_(0),
@@ -86,7 +98,11 @@ int64_t ModuleRtpRtcpImpl::TimeUntilNextProcess() {
 // Process any pending tasks such as timeouts (non time critical events).
 void ModuleRtpRtcpImpl::Process() {
   const int64_t now = clock_->TimeInMilliseconds();
-  next_process_time_ = now + kRtpRtcpMaxIdleTimeProcessMs;
+  // In event driven mode the RTT processing interval is the longest wait;
+  // the RTCP report time is accounted for at the end.
+  next_process_time_ =
+      now + (event_driven_process_ ? kRtpRtcpRttProcessTimeMs
+                                   : kRtpRtcpMaxIdleTimeProcessMs);
 
   if (rtp_sender_) {
     if (now >= last_bitrate_process_time_ + kRtpRtcpBitrateProcessTimeMs) {
@@ -165,6 +181,30 @@ void ModuleRtpRtcpImpl::Process() {
   if (TMMBR() && rtcp_receiver_.UpdateTmmbrTimers()) {
     rtcp_receiver_.NotifyTmmbrUpdated();
   }
+
+  if (event_driven_process_) {
+    absl::optional<int64_t> next_rtcp_time_ms =
+        rtcp_sender_.NextTimeToSendRTCPReport();
+    if (next_rtcp_time_ms) {
+      // Never poll faster than in the polling mode, e.g. if the report could
+      // not be sent.
+      next_process_time_ = std::min(
+          next_process_time_,
+          std::max(*next_rtcp_time_ms, now + kRtpRtcpMaxIdleTimeProcessMs));
+    }
+  }
+}
+
+void ModuleRtpRtcpImpl::ProcessThreadAttached(ProcessThread* process_thread) {
+  process_thread_ = process_thread;
+}
+
+void ModuleRtpRtcpImpl::MaybeWakeUpProcessThread() {
+  if (!event_driven_process_)
+    return;
+  ProcessThread* process_thread = process_thread_;
+  if (process_thread)
+    process_thread->WakeUp(this);
 }
 
 void ModuleRtpRtcpImpl::SetRtxSendStatus(int mode) {
@@ -373,6 +413,7 @@ RtcpMode ModuleRtpRtcpImpl::RTCP() const {
 // Configure RTCP status i.e on/off.
 void ModuleRtpRtcpImpl::SetRTCPStatus(const RtcpMode method) {
   rtcp_sender_.SetRTCPStatus(method);
+  MaybeWakeUpProcessThread();
 }
 
 int32_t ModuleRtpRtcpImpl::SetCNAME(const char* c_name) {
@@ -501,6 +542,7 @@ std::vector<ReportBlockData> ModuleRtpRtcpImpl::GetLatestReportBlockData()
 void ModuleRtpRtcpImpl::SetRemb(int64_t bitrate_bps,
                                 std::vector<uint32_t> ssrcs) {
   rtcp_sender_.SetRemb(bitrate_bps, std::move(ssrcs));
+  MaybeWakeUpProcessThread();
 }
 
 void ModuleRtpRtcpImpl::UnsetRemb() {
@@ -744,6 +786,7 @@ int64_t ModuleRtpRtcpImpl::rtt_ms() const {
 void ModuleRtpRtcpImpl::SetVideoBitrateAllocation(
     const VideoBitrateAllocation& bitrate) {
   rtcp_sender_.SetVideoBitrateAllocation(bitrate);
+  MaybeWakeUpProcessThread();
 }
 
 RTPSender* ModuleRtpRtcpImpl::RtpSender() {
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
@@ -52,6 +53,8 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
   // Process any pending tasks such as timeouts.
   void Process() override;
 
+  void ProcessThreadAttached(ProcessThread* process_thread) override;
+
   // Receiver part.
 
   // Called when we receive an RTCP packet.
@@ -295,6 +298,10 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
 
   bool TimeToSendFullNackList(int64_t now) const;
 
+  // Wakes up the process thread if RTCP may need to be sent sooner than
+  // Process() is scheduled.
+  void MaybeWakeUpProcessThread();
+
   std::unique_ptr<RTPSender> rtp_sender_;
   RTCPSender rtcp_sender_;
   RTCPReceiver rtcp_receiver_;
@@ -304,6 +311,11 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
   int64_t last_bitrate_process_time_;
   int64_t last_rtt_process_time_;
   int64_t next_process_time_;
+  // If set, Process() is scheduled for when the next periodic task is due
+  // rather than polled every few ms, and changes that need an RTCP packet
+  // sent right away wake up the process thread.
+  const bool event_driven_process_;
+  std::atomic<ProcessThread*> process_thread_;
   uint16_t packet_overhead_;
 
   // Send side
@@ -24,6 +24,7 @@
 #include "modules/rtp_rtcp/source/rtp_sender_video.h"
 #include "rtc_base/rate_limiter.h"
 #include "test/gmock.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 #include "test/rtcp_packet_parser.h"
 #include "test/rtp_header_parser.h"
@@ -572,4 +573,26 @@ TEST_F(RtpRtcpImplTest, ConfigurableRtcpReportInterval) {
   EXPECT_EQ(sender_.transport_.NumRtcpSent(), 2u);
 }
 
+TEST(RtpRtcpImplEventDrivenProcessTest, WaitsUntilNextReportIsDue) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-RtpRtcpEventDrivenProcess/Enabled/");
+  const int kReportIntervalMs = 1000;
+  SimulatedClock clock(123456);
+  RtpRtcp::Configuration config;
+  config.clock = &clock;
+  config.receiver_only = true;
+  config.rtcp_report_interval_ms = kReportIntervalMs;
+  config.local_media_ssrc = kReceiverSsrc;
+  ModuleRtpRtcpImpl impl(config);
+
+  // Without RTCP, only the RTT processing is periodic.
+  impl.Process();
+  EXPECT_EQ(1000, impl.TimeUntilNextProcess());
+
+  // The first report is due after half the report interval.
+  impl.SetRTCPStatus(RtcpMode::kCompound);
+  impl.Process();
+  EXPECT_EQ(kReportIntervalMs / 2, impl.TimeUntilNextProcess());
+}
+
 }  // namespace webrtc
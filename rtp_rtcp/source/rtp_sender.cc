@@ -167,6 +167,7 @@ RTPSender::RTPSender(const RtpRtcp::Configuration& config)
       rtx_(kRtxOff),
       rtp_overhead_bytes_per_packet_(0),
       supports_bwe_extension_(false),
+      fec_or_padding_extensions_size_(0),
       retransmission_rate_limiter_(config.retransmission_rate_limiter),
       overhead_observer_(config.overhead_observer),
       populate_network2_timestamp_(config.populate_network2_timestamp),
@@ -223,14 +224,14 @@ int32_t RTPSender::RegisterRtpHeaderExtension(RTPExtensionType type,
                                               uint8_t id) {
   rtc::CritScope lock(&send_critsect_);
   bool registered = rtp_header_extension_map_.RegisterByType(id, type);
-  supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  UpdateHeaderExtensionState();
   return registered ? 0 : -1;
 }
 
 bool RTPSender::RegisterRtpHeaderExtension(absl::string_view uri, int id) {
   rtc::CritScope lock(&send_critsect_);
   bool registered = rtp_header_extension_map_.RegisterByUri(id, uri);
-  supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  UpdateHeaderExtensionState();
   return registered;
 }
 
@@ -242,14 +243,20 @@ bool RTPSender::IsRtpHeaderExtensionRegistered(RTPExtensionType type) const {
 int32_t RTPSender::DeregisterRtpHeaderExtension(RTPExtensionType type) {
   rtc::CritScope lock(&send_critsect_);
   int32_t deregistered = rtp_header_extension_map_.Deregister(type);
-  supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  UpdateHeaderExtensionState();
   return deregistered;
 }
 
 void RTPSender::DeregisterRtpHeaderExtension(absl::string_view uri) {
   rtc::CritScope lock(&send_critsect_);
   rtp_header_extension_map_.Deregister(uri);
+  UpdateHeaderExtensionState();
+}
+
+void RTPSender::UpdateHeaderExtensionState() {
   supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  fec_or_padding_extensions_size_ = RtpHeaderExtensionSize(
+      kFecOrPaddingExtensionSizes, rtp_header_extension_map_);
 }
 
 void RTPSender::SetMaxRtpPacketSize(size_t max_packet_size) {
@@ -314,25 +321,7 @@ int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
   std::unique_ptr<RtpPacketToSend> packet =
       packet_history_.GetPacketAndMarkAsPending(
           packet_id, [&](const RtpPacketToSend& stored_packet) {
-            // Check if we're overusing retransmission bitrate.
-            // TODO(sprang): Add histograms for nack success or failure
-            // reasons.
-            std::unique_ptr<RtpPacketToSend> retransmit_packet;
-            if (retransmission_rate_limiter_ &&
-                !retransmission_rate_limiter_->TryUseRate(packet_size)) {
-              return retransmit_packet;
-            }
-            if (rtx) {
-              retransmit_packet = BuildRtxPacket(stored_packet);
-            } else {
-              retransmit_packet =
-                  std::make_unique<RtpPacketToSend>(stored_packet);
-            }
-            if (retransmit_packet) {
-              retransmit_packet->set_retransmitted_sequence_number(
-                  stored_packet.SequenceNumber());
-            }
-            return retransmit_packet;
+            return BuildRetransmissionPacket(stored_packet, rtx);
           });
   if (!packet) {
     return -1;
@@ -345,6 +334,28 @@ int32_t RTPSender::ReSendPacket(uint16_t packet_id) {
   return packet_size;
 }
 
+std::unique_ptr<RtpPacketToSend> RTPSender::BuildRetransmissionPacket(
+    const RtpPacketToSend& stored_packet,
+    bool rtx) {
+  // Check if we're overusing retransmission bitrate.
+  // TODO(sprang): Add histograms for nack success or failure reasons.
+  std::unique_ptr<RtpPacketToSend> retransmit_packet;
+  if (retransmission_rate_limiter_ &&
+      !retransmission_rate_limiter_->TryUseRate(stored_packet.size())) {
+    return retransmit_packet;
+  }
+  if (rtx) {
+    retransmit_packet = BuildRtxPacket(stored_packet);
+  } else {
+    retransmit_packet = std::make_unique<RtpPacketToSend>(stored_packet);
+  }
+  if (retransmit_packet) {
+    retransmit_packet->set_retransmitted_sequence_number(
+        stored_packet.SequenceNumber());
+  }
+  return retransmit_packet;
+}
+
 void RTPSender::OnReceivedAckOnSsrc(int64_t extended_highest_sequence_number) {
   rtc::CritScope lock(&send_critsect_);
   ssrc_has_acked_ = true;
@@ -382,15 +393,33 @@ void RTPSender::OnReceivedNack(
     const std::vector<uint16_t>& nack_sequence_numbers,
     int64_t avg_rtt) {
   packet_history_.SetRtt(5 + avg_rtt);
-  for (uint16_t seq_no : nack_sequence_numbers) {
-    const int32_t bytes_sent = ReSendPacket(seq_no);
-    if (bytes_sent < 0) {
-      // Failed to send one Sequence number. Give up the rest in this nack.
-      RTC_LOG(LS_WARNING) << "Failed resending RTP packet " << seq_no
-                          << ", Discard rest of packets.";
-      break;
-    }
+  const bool rtx = (RtxStatus() & kRtxRetransmitted) > 0;
+
+  // Resolve all requested packets under a single history lock and hand them
+  // to the pacer in one batch.
+  absl::optional<uint16_t> failed_seq_no;
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets =
+      packet_history_.GetPacketsAndMarkAsPending(
+          nack_sequence_numbers, [&](const RtpPacketToSend& stored_packet) {
+            std::unique_ptr<RtpPacketToSend> retransmit_packet =
+                BuildRetransmissionPacket(stored_packet, rtx);
+            if (!retransmit_packet) {
+              failed_seq_no = stored_packet.SequenceNumber();
+            }
+            return retransmit_packet;
+          });
+  if (failed_seq_no) {
+    // Failed to send one Sequence number. Gave up the rest in this nack.
+    RTC_LOG(LS_WARNING) << "Failed resending RTP packet " << *failed_seq_no
+                        << ", Discard rest of packets.";
   }
+  if (packets.empty()) {
+    return;
+  }
+  for (auto& packet : packets) {
+    packet->set_packet_type(RtpPacketToSend::Type::kRetransmission);
+  }
+  paced_sender_->EnqueuePackets(std::move(packets));
 }
 
 // Called from pacer when we can send the packet.
@@ -488,15 +517,6 @@ bool RTPSender::TrySendPacket(RtpPacketToSend* packet,
 
   const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
 
-  // Put packet in retransmission history or update pending status even if
-  // actual sending fails.
-  if (is_media && packet->allow_retransmission()) {
-    packet_history_.PutRtpPacket(std::make_unique<RtpPacketToSend>(*packet),
-                                 now_ms);
-  } else if (packet->retransmitted_sequence_number()) {
-    packet_history_.MarkPacketAsSent(*packet->retransmitted_sequence_number());
-  }
-
   if (send_success) {
     UpdateRtpStats(*packet, is_rtx,
                    packet_type == RtpPacketToSend::Type::kRetransmission);
@@ -505,6 +525,17 @@ bool RTPSender::TrySendPacket(RtpPacketToSend* packet,
     media_has_been_sent_ = true;
   }
 
+  // Put packet in retransmission history or update pending status even if
+  // actual sending fails. The packet is moved rather than copied, so that its
+  // buffer has a single owner and can be recycled without being cloned once
+  // the history lets go of it.
+  if (is_media && packet->allow_retransmission()) {
+    packet_history_.PutRtpPacket(
+        std::make_unique<RtpPacketToSend>(std::move(*packet)), now_ms);
+  } else if (packet->retransmitted_sequence_number()) {
+    packet_history_.MarkPacketAsSent(*packet->retransmitted_sequence_number());
+  }
+
   // Return true even if transport failed (will be handled by retransmissions
   // instead in that case), so that PacketRouter does not have to iterate over
   // all other RTP modules and fail to send there too.
@@ -559,20 +590,15 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
   std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets;
   size_t bytes_left = target_size_bytes;
   if (SupportsRtxPayloadPadding()) {
-    while (bytes_left >= kMinPayloadPaddingBytes) {
-      std::unique_ptr<RtpPacketToSend> packet =
-          packet_history_.GetPayloadPaddingPacket(
-              [&](const RtpPacketToSend& packet)
-                  -> std::unique_ptr<RtpPacketToSend> {
-                return BuildRtxPacket(packet);
-              });
-      if (!packet) {
-        break;
-      }
-
+    padding_packets = packet_history_.GetPayloadPaddingPackets(
+        bytes_left, kMinPayloadPaddingBytes,
+        [&](const RtpPacketToSend& packet)
+            -> std::unique_ptr<RtpPacketToSend> {
+          return BuildRtxPacket(packet);
+        });
+    for (auto& packet : padding_packets) {
       bytes_left -= std::min(bytes_left, packet->payload_size());
       packet->set_packet_type(RtpPacketToSend::Type::kPadding);
-      padding_packets.push_back(std::move(packet));
     }
   }
 
@@ -580,6 +606,9 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
   if (!sending_media_) {
     return {};
   }
+  if (bytes_left == 0) {
+    return padding_packets;
+  }
 
   size_t padding_bytes_in_packet;
   const size_t max_payload_size = max_packet_size_ - RtpHeaderLength();
@@ -596,68 +625,75 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
     padding_bytes_in_packet = rtc::SafeMin(max_payload_size, kMaxPaddingLength);
   }
 
-  while (bytes_left > 0) {
-    auto padding_packet =
-        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
-    padding_packet->set_packet_type(RtpPacketToSend::Type::kPadding);
-    padding_packet->SetMarker(false);
-    padding_packet->SetTimestamp(last_rtp_timestamp_);
-    padding_packet->set_capture_time_ms(capture_time_ms_);
-    if (rtx_ == kRtxOff) {
-      if (last_payload_type_ == -1) {
-        break;
-      }
-      // Without RTX we can't send padding in the middle of frames.
-      // For audio marker bits doesn't mark the end of a frame and frames
-      // are usually a single packet, so for now we don't apply this rule
-      // for audio.
-      if (!audio_configured_ && !last_packet_marker_bit_) {
-        break;
-      }
-
-      padding_packet->SetSsrc(ssrc_);
-      padding_packet->SetPayloadType(last_payload_type_);
-      padding_packet->SetSequenceNumber(sequence_number_++);
-    } else {
-      // Without abs-send-time or transport sequence number a media packet
-      // must be sent before padding so that the timestamps used for
-      // estimation are correct.
-      if (!media_has_been_sent_ &&
-          !(rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId) ||
-            rtp_header_extension_map_.IsRegistered(
-                TransportSequenceNumber::kId))) {
-        break;
-      }
-      // Only change the timestamp of padding packets sent over RTX.
-      // Padding only packets over RTP has to be sent as part of a media
-      // frame (and therefore the same timestamp).
-      int64_t now_ms = clock_->TimeInMilliseconds();
-      if (last_timestamp_time_ms_ > 0) {
-        padding_packet->SetTimestamp(padding_packet->Timestamp() +
-                                     (now_ms - last_timestamp_time_ms_) *
-                                         kTimestampTicksPerMs);
-        padding_packet->set_capture_time_ms(padding_packet->capture_time_ms() +
-                                            (now_ms - last_timestamp_time_ms_));
-      }
-      RTC_DCHECK(rtx_ssrc_);
-      padding_packet->SetSsrc(*rtx_ssrc_);
-      padding_packet->SetSequenceNumber(sequence_number_rtx_++);
-      padding_packet->SetPayloadType(rtx_payload_type_map_.begin()->second);
+  // All padding-only packets of the batch are identical except for their
+  // sequence numbers, so the packet is serialized once and then copied.
+  RtpPacketToSend padding_packet(&rtp_header_extension_map_);
+  padding_packet.set_packet_type(RtpPacketToSend::Type::kPadding);
+  padding_packet.SetMarker(false);
+  padding_packet.SetTimestamp(last_rtp_timestamp_);
+  padding_packet.set_capture_time_ms(capture_time_ms_);
+  uint16_t* sequence_number;
+  if (rtx_ == kRtxOff) {
+    if (last_payload_type_ == -1) {
+      return padding_packets;
     }
-
-    if (rtp_header_extension_map_.IsRegistered(TransportSequenceNumber::kId)) {
-      padding_packet->ReserveExtension<TransportSequenceNumber>();
+    // Without RTX we can't send padding in the middle of frames.
+    // For audio marker bits doesn't mark the end of a frame and frames
+    // are usually a single packet, so for now we don't apply this rule
+    // for audio.
+    if (!audio_configured_ && !last_packet_marker_bit_) {
+      return padding_packets;
     }
-    if (rtp_header_extension_map_.IsRegistered(TransmissionOffset::kId)) {
-      padding_packet->ReserveExtension<TransmissionOffset>();
+
+    padding_packet.SetSsrc(ssrc_);
+    padding_packet.SetPayloadType(last_payload_type_);
+    sequence_number = &sequence_number_;
+  } else {
+    // Without abs-send-time or transport sequence number a media packet
+    // must be sent before padding so that the timestamps used for
+    // estimation are correct.
+    if (!media_has_been_sent_ &&
+        !(rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId) ||
+          rtp_header_extension_map_.IsRegistered(
+              TransportSequenceNumber::kId))) {
+      return padding_packets;
     }
-    if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
-      padding_packet->ReserveExtension<AbsoluteSendTime>();
+    // Only change the timestamp of padding packets sent over RTX.
+    // Padding only packets over RTP has to be sent as part of a media
+    // frame (and therefore the same timestamp).
+    int64_t now_ms = clock_->TimeInMilliseconds();
+    if (last_timestamp_time_ms_ > 0) {
+      padding_packet.SetTimestamp(padding_packet.Timestamp() +
+                                  (now_ms - last_timestamp_time_ms_) *
+                                      kTimestampTicksPerMs);
+      padding_packet.set_capture_time_ms(padding_packet.capture_time_ms() +
+                                         (now_ms - last_timestamp_time_ms_));
     }
+    RTC_DCHECK(rtx_ssrc_);
+    padding_packet.SetSsrc(*rtx_ssrc_);
+    padding_packet.SetPayloadType(rtx_payload_type_map_.begin()->second);
+    sequence_number = &sequence_number_rtx_;
+  }
 
-    padding_packet->SetPadding(padding_bytes_in_packet);
+  if (rtp_header_extension_map_.IsRegistered(TransportSequenceNumber::kId)) {
+    padding_packet.ReserveExtension<TransportSequenceNumber>();
+  }
+  if (rtp_header_extension_map_.IsRegistered(TransmissionOffset::kId)) {
+    padding_packet.ReserveExtension<TransmissionOffset>();
+  }
+  if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
+    padding_packet.ReserveExtension<AbsoluteSendTime>();
+  }
+  padding_packet.SetPadding(padding_bytes_in_packet);
+
+  padding_packets.reserve(padding_packets.size() +
+                          (bytes_left + padding_bytes_in_packet - 1) /
+                              padding_bytes_in_packet);
+  while (bytes_left > 0) {
+    auto packet = std::make_unique<RtpPacketToSend>(padding_packet);
+    packet->SetSequenceNumber((*sequence_number)++);
     bytes_left -= std::min(bytes_left, padding_bytes_in_packet);
-    padding_packets.push_back(std::move(padding_packet));
+    padding_packets.push_back(std::move(packet));
   }
 
   return padding_packets;
@@ -806,8 +842,7 @@ size_t RTPSender::RtpHeaderLength() const {
   rtc::CritScope lock(&send_critsect_);
   size_t rtp_header_length = kRtpHeaderLength;
   rtp_header_length += sizeof(uint32_t) * csrcs_.size();
-  rtp_header_length += RtpHeaderExtensionSize(kFecOrPaddingExtensionSizes,
-                                              rtp_header_extension_map_);
+  rtp_header_length += fec_or_padding_extensions_size_;
   return rtp_header_length;
 }
 
@@ -884,6 +919,28 @@ bool RTPSender::AssignSequenceNumber(RtpPacketToSend* packet) {
   return true;
 }
 
+bool RTPSender::AssignSequenceNumbers(
+    rtc::ArrayView<std::unique_ptr<RtpPacketToSend>> packets) {
+  RTC_DCHECK(!packets.empty());
+  rtc::CritScope lock(&send_critsect_);
+  if (!sending_media_)
+    return false;
+  for (auto& packet : packets) {
+    RTC_DCHECK(packet->Ssrc() == ssrc_);
+    packet->SetSequenceNumber(sequence_number_++);
+  }
+
+  // Remember the fields of the last packet to generate padding, as in
+  // AssignSequenceNumber().
+  const RtpPacketToSend& last_packet = *packets.back();
+  last_packet_marker_bit_ = last_packet.Marker();
+  last_payload_type_ = last_packet.PayloadType();
+  last_rtp_timestamp_ = last_packet.Timestamp();
+  last_timestamp_time_ms_ = clock_->TimeInMilliseconds();
+  capture_time_ms_ = last_packet.capture_time_ms();
+  return true;
+}
+
 void RTPSender::SetSendingMediaStatus(bool enabled) {
   rtc::CritScope lock(&send_critsect_);
   sending_media_ = enabled;
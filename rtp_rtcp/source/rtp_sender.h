@@ -89,7 +89,9 @@ class RTPSender {
 
   // Tries to send packet to transport. Also updates any timing extensions,
   // calls observers waiting for packet send events, and updates stats.
-  // Returns true if packet belongs to this RTP module, false otherwise.
+  // Returns true if packet belongs to this RTP module, false otherwise. Media
+  // packets kept for retransmission are moved into the packet history, so
+  // |packet| must not be used after a successful call.
   bool TrySendPacket(RtpPacketToSend* packet,
                      const PacedPacketInfo& pacing_info);
   bool SupportsPadding() const;
@@ -134,6 +136,9 @@ class RTPSender {
   // Save packet's fields to generate padding that doesn't break media stream.
   // Return false if sending was turned off.
   bool AssignSequenceNumber(RtpPacketToSend* packet);
+  // Same as above for all packets of a frame, in order, taking the lock once.
+  bool AssignSequenceNumbers(
+      rtc::ArrayView<std::unique_ptr<RtpPacketToSend>> packets);
 
   // Used for padding and FEC packets only.
   size_t RtpHeaderLength() const;
@@ -189,6 +194,11 @@ class RTPSender {
 
   std::unique_ptr<RtpPacketToSend> BuildRtxPacket(
       const RtpPacketToSend& packet);
+  // Copies |stored_packet|, or wraps it in RTX if |rtx| is set, for
+  // retransmission. Returns nullptr if the retransmission rate limit is hit.
+  std::unique_ptr<RtpPacketToSend> BuildRetransmissionPacket(
+      const RtpPacketToSend& stored_packet,
+      bool rtx);
 
   // Sends packet on to |transport_|, leaving the RTP module.
   bool SendPacketToNetwork(const RtpPacketToSend& packet,
@@ -214,6 +224,11 @@ class RTPSender {
 
   void UpdateRtpOverhead(const RtpPacketToSend& packet);
 
+  // Recomputes the state derived from |rtp_header_extension_map_|. Must be
+  // called whenever an extension is registered or deregistered.
+  void UpdateHeaderExtensionState()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(send_critsect_);
+
   Clock* const clock_;
   Random random_ RTC_GUARDED_BY(send_critsect_);
 
@@ -282,6 +297,8 @@ class RTPSender {
   std::map<int8_t, int8_t> rtx_payload_type_map_ RTC_GUARDED_BY(send_critsect_);
   size_t rtp_overhead_bytes_per_packet_ RTC_GUARDED_BY(send_critsect_);
   bool supports_bwe_extension_ RTC_GUARDED_BY(send_critsect_);
+  // Size of the registered extensions that FEC and padding packets may carry.
+  size_t fec_or_padding_extensions_size_ RTC_GUARDED_BY(send_critsect_);
 
   RateLimiter* const retransmission_rate_limiter_;
   OverheadObserver* overhead_observer_;
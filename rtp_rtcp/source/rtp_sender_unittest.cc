@@ -27,6 +27,7 @@
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor_extension.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_buffer_pool.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_sender_video.h"
@@ -80,6 +81,7 @@ using ::testing::NiceMock;
 using ::testing::Pointee;
 using ::testing::Property;
 using ::testing::Return;
+using ::testing::SizeIs;
 using ::testing::StrictMock;
 
 uint64_t ConvertMsToAbsSendTime(int64_t time_ms) {
@@ -394,6 +396,31 @@ TEST_P(RtpSenderTestWithoutPacer, AllocatePacketReserveExtensions) {
   EXPECT_FALSE(packet->HasExtension<VideoOrientation>());
 }
 
+TEST_P(RtpSenderTestWithoutPacer, HeaderLengthFollowsExtensionRegistration) {
+  EXPECT_EQ(12u, rtp_sender_->RtpHeaderLength());
+
+  // One extension: 4 bytes block header, 1 byte id and length, 3 bytes value.
+  ASSERT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionTransmissionTimeOffset,
+                   kTransmissionTimeOffsetExtensionId));
+  EXPECT_EQ(12u + 8u, rtp_sender_->RtpHeaderLength());
+  // Padded to a multiple of 4 bytes.
+  ASSERT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionTransportSequenceNumber,
+                   kTransportSequenceNumberExtensionId));
+  EXPECT_EQ(12u + 12u, rtp_sender_->RtpHeaderLength());
+  // Media specific extensions are not counted.
+  ASSERT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(kRtpExtensionAudioLevel,
+                                                       kAudioLevelExtensionId));
+  EXPECT_EQ(12u + 12u, rtp_sender_->RtpHeaderLength());
+
+  ASSERT_EQ(0, rtp_sender_->DeregisterRtpHeaderExtension(
+                   kRtpExtensionTransmissionTimeOffset));
+  EXPECT_EQ(12u + 8u, rtp_sender_->RtpHeaderLength());
+  rtp_sender_->SetCsrcs({0x23456789});
+  EXPECT_EQ(12u + 4u + 8u, rtp_sender_->RtpHeaderLength());
+}
+
 TEST_P(RtpSenderTestWithoutPacer, AssignSequenceNumberAdvanceSequenceNumber) {
   auto packet = rtp_sender_->AllocatePacket();
   ASSERT_TRUE(packet);
@@ -916,8 +943,10 @@ TEST_P(RtpSenderTest, TrafficSmoothingRetransmits) {
   packet->set_allow_retransmission(true);
   EXPECT_TRUE(
       rtp_sender_->SendToNetwork(std::make_unique<RtpPacketToSend>(*packet)));
-  // Immediately process send bucket and send packet.
-  rtp_sender_->TrySendPacket(packet.get(), PacedPacketInfo());
+  // Immediately process send bucket and send packet. The sent packet is moved
+  // into the packet history, so keep a copy for the retransmission below.
+  rtp_sender_->TrySendPacket(std::make_unique<RtpPacketToSend>(*packet).get(),
+                             PacedPacketInfo());
 
   EXPECT_EQ(1, transport_.packets_sent());
 
@@ -1111,6 +1140,38 @@ TEST_P(RtpSenderTest, OnSendPacketNotUpdatedForRetransmits) {
   EXPECT_TRUE(transport_.last_options_.is_retransmit);
 }
 
+TEST_P(RtpSenderTest, PacketKeptInHistoryRecyclesItsBufferUnshared) {
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+  EXPECT_CALL(mock_paced_sender_, EnqueuePackets);
+  auto packet = SendGenericPacket();
+  packet->set_packet_type(RtpPacketToSend::Type::kVideo);
+
+  RtpPacketBufferPool* const pool = RtpPacketBufferPool::Global();
+  const RtpPacketBufferPool::Stats before = pool->GetStats();
+  EXPECT_TRUE(rtp_sender_->TrySendPacket(packet.get(), PacedPacketInfo()));
+  EXPECT_EQ(1, transport_.packets_sent());
+  EXPECT_EQ(0u, packet->capacity());
+
+  // The buffer was moved into the packet history, so destroying the sent
+  // packet leaves nothing to recycle.
+  packet.reset();
+  RtpPacketBufferPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(before.buffers_idle, stats.buffers_idle);
+  EXPECT_EQ(before.shared_buffers_recycled, stats.shared_buffers_recycled);
+
+  // Purging the history recycles the buffer without having to replace it, and
+  // the next packet reuses it.
+  rtp_sender_->SetStorePacketsStatus(false, 0);
+  stats = pool->GetStats();
+  EXPECT_EQ(before.shared_buffers_recycled, stats.shared_buffers_recycled);
+  EXPECT_GT(stats.buffers_idle, 0u);
+
+  auto next_packet = rtp_sender_->AllocatePacket();
+  stats = pool->GetStats();
+  EXPECT_EQ(before.buffers_allocated, stats.buffers_allocated);
+  EXPECT_EQ(before.buffers_reused + 1, stats.buffers_reused);
+}
+
 TEST_P(RtpSenderTestWithoutPacer, SendGenericVideo) {
   const uint8_t kPayloadType = 127;
   const VideoCodecType kCodecType = VideoCodecType::kVideoCodecGeneric;
@@ -2182,6 +2243,36 @@ TEST_P(RtpSenderTest, TrySendPacketHandlesRetransmissionHistory) {
   EXPECT_EQ(rtp_sender_->ReSendPacket(packet->SequenceNumber()), 0);
 }
 
+TEST_P(RtpSenderTest, NackedPacketsAreEnqueuedInOneBatch) {
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+
+  std::vector<uint16_t> sequence_numbers;
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<RtpPacketToSend> packet =
+        BuildRtpPacket(kPayload, true, 0, fake_clock_.TimeInMilliseconds());
+    sequence_numbers.push_back(packet->SequenceNumber());
+    packet->set_packet_type(RtpPacketToSend::Type::kVideo);
+    packet->set_allow_retransmission(true);
+    EXPECT_TRUE(rtp_sender_->TrySendPacket(packet.get(), PacedPacketInfo()));
+  }
+  // Unknown sequence numbers are skipped without aborting the batch.
+  sequence_numbers.insert(sequence_numbers.begin() + 1,
+                          sequence_numbers.back() + 10);
+
+  fake_clock_.AdvanceTimeMilliseconds(30);
+  EXPECT_CALL(mock_paced_sender_,
+              EnqueuePackets(AllOf(
+                  SizeIs(3), Contains(Pointee(Property(
+                                 &RtpPacketToSend::packet_type,
+                                 RtpPacketToSend::Type::kRetransmission))))));
+  rtp_sender_->OnReceivedNack(sequence_numbers, 0);
+
+  // All packets are now pending, so a repeated NACK enqueues nothing.
+  fake_clock_.AdvanceTimeMilliseconds(30);
+  EXPECT_CALL(mock_paced_sender_, EnqueuePackets(_)).Times(0);
+  rtp_sender_->OnReceivedNack(sequence_numbers, 0);
+}
+
 TEST_P(RtpSenderTest, TrySendPacketUpdatesExtensions) {
   ASSERT_EQ(rtp_sender_->RegisterRtpHeaderExtension(
                 kRtpExtensionTransmissionTimeOffset,
@@ -2452,6 +2543,29 @@ TEST_P(RtpSenderTest, GeneratePaddingCreatesPurePaddingWithoutRtx) {
             kExpectedNumPaddingPackets * kMaxPaddingSize);
 }
 
+TEST_P(RtpSenderTest, GeneratePaddingRepeatsHeaderWithNewSequenceNumbers) {
+  rtp_sender_->SetRtxStatus(kRtxRetransmitted | kRtxRedundantPayloads);
+  rtp_sender_->SetRtxPayloadType(kRtxPayload, kPayload);
+  ASSERT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionTransportSequenceNumber,
+                   kTransportSequenceNumberExtensionId));
+
+  // Nothing is stored in the history, so only plain padding is generated.
+  std::vector<std::unique_ptr<RtpPacketToSend>> padding_packets =
+      rtp_sender_->GeneratePadding(3 * kMaxPaddingSize);
+  ASSERT_EQ(3u, padding_packets.size());
+  for (size_t i = 0; i < padding_packets.size(); ++i) {
+    const RtpPacketToSend& packet = *padding_packets[i];
+    EXPECT_EQ(packet.packet_type(), RtpPacketToSend::Type::kPadding);
+    EXPECT_EQ(packet.Ssrc(), kRtxSsrc);
+    EXPECT_EQ(packet.padding_size(), kMaxPaddingSize);
+    EXPECT_TRUE(packet.IsExtensionReserved<TransportSequenceNumber>());
+    EXPECT_EQ(packet.Timestamp(), padding_packets[0]->Timestamp());
+    EXPECT_EQ(packet.SequenceNumber(),
+              static_cast<uint16_t>(padding_packets[0]->SequenceNumber() + i));
+  }
+}
+
 TEST_P(RtpSenderTest, SupportsPadding) {
   bool kSendingMediaStats[] = {true, false};
   bool kEnableRedundantPayloads[] = {true, false};
@@ -30,6 +30,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 
@@ -54,6 +55,9 @@ constexpr int64_t kMaxUnretransmittableFrameIntervalMs = 33 * 4;
 const char kExcludeTransportSequenceNumberFromFecFieldTrial[] =
     "WebRTC-ExcludeTransportSequenceNumberFromFec";
 
+const char kSendSideLatencyTracingFieldTrial[] =
+    "WebRTC-SendSideLatencyTracing";
+
 void BuildRedPayload(const RtpPacketToSend& media_packet,
                      RtpPacketToSend* red_packet) {
   uint8_t* red_payload = red_packet->AllocatePayload(
@@ -249,6 +253,9 @@ RTPSenderVideo::RTPSenderVideo(const Config& config)
       exclude_transport_sequence_number_from_fec_experiment_(
           config.field_trials
               ->Lookup(kExcludeTransportSequenceNumberFromFecFieldTrial)
+              .find("Enabled") == 0),
+      latency_tracing_(
+          config.field_trials->Lookup(kSendSideLatencyTracingFieldTrial)
               .find("Enabled") == 0) {
   RTC_DCHECK(playout_delay_oracle_);
 }
@@ -621,9 +628,15 @@ bool RTPSenderVideo::SendVideo(
   if (num_packets == 0)
     return false;
 
-  uint16_t first_sequence_number;
   bool first_frame = first_frame_sent_();
-  std::vector<std::unique_ptr<RtpPacketToSend>> rtp_packets;
+  // Stamp the payloads onto copies of the header templates first, so that
+  // the sequence numbers of the whole frame can be assigned at once.
+  std::vector<std::unique_ptr<RtpPacketToSend>> media_packets(num_packets);
+  // The middle packets are created up front, with their buffers taken from
+  // the pool at once; a key frame can have well over a thousand of them.
+  std::vector<std::unique_ptr<RtpPacketToSend>> middle_packets =
+      RtpPacketToSend::CopyHeaders(*middle_packet,
+                                   num_packets > 2 ? num_packets - 2 : 0);
   for (size_t i = 0; i < num_packets; ++i) {
     std::unique_ptr<RtpPacketToSend> packet;
     int expected_payload_capacity;
@@ -641,19 +654,24 @@ bool RTPSenderVideo::SendVideo(
       expected_payload_capacity =
           limits.max_payload_len - limits.last_packet_reduction_len;
     } else {
-      packet = std::make_unique<RtpPacketToSend>(*middle_packet);
+      packet = std::move(middle_packets[i - 1]);
       expected_payload_capacity = limits.max_payload_len;
     }
 
     if (!packetizer->NextPacket(packet.get()))
       return false;
     RTC_DCHECK_LE(packet->payload_size(), expected_payload_capacity);
-    if (!rtp_sender_->AssignSequenceNumber(packet.get()))
-      return false;
+    media_packets[i] = std::move(packet);
+  }
+  if (!rtp_sender_->AssignSequenceNumbers(media_packets))
+    return false;
+  const uint16_t first_sequence_number = media_packets[0]->SequenceNumber();
 
-    if (rtp_sequence_number_map_ && i == 0) {
-      first_sequence_number = packet->SequenceNumber();
-    }
+  std::vector<std::unique_ptr<RtpPacketToSend>> rtp_packets;
+  // Room for the media packets; FEC packets, if any, may still grow it.
+  rtp_packets.reserve(num_packets);
+  for (size_t i = 0; i < num_packets; ++i) {
+    std::unique_ptr<RtpPacketToSend> packet = std::move(media_packets[i]);
 
     if (i == 0) {
       playout_delay_oracle_->OnSentPacket(packet->SequenceNumber(),
@@ -714,6 +732,18 @@ bool RTPSenderVideo::SendVideo(
 
   LogAndSendToNetwork(std::move(rtp_packets), unpacketized_payload_size);
 
+  if (latency_tracing_) {
+    // Only timing frames carry the encoder timestamps.
+    if (video_header.video_timing.flags != VideoSendTiming::kInvalid) {
+      RTC_HISTOGRAM_COUNTS_1000(
+          "WebRTC.Video.SendSideLatency.CaptureToEncodedMs",
+          video_header.video_timing.encode_finish_delta_ms);
+    }
+    RTC_HISTOGRAM_COUNTS_1000(
+        "WebRTC.Video.SendSideLatency.CaptureToPacketizedMs",
+        clock_->TimeInMilliseconds() - capture_time_ms);
+  }
+
   TRACE_EVENT_ASYNC_END1("webrtc", "Video", capture_time_ms, "timestamp",
                          rtp_timestamp);
   return true;
@@ -234,6 +234,10 @@ class RTPSenderVideo {
   const bool generic_descriptor_auth_experiment_;
 
   const bool exclude_transport_sequence_number_from_fec_experiment_;
+
+  // Set by the WebRTC-SendSideLatencyTracing field trial. Reports the
+  // capture to encoded and capture to packetized delay of each frame.
+  const bool latency_tracing_;
 };
 
 }  // namespace webrtc
@@ -11,18 +11,29 @@
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 
 #include <algorithm>
-#include <iterator>
 #include <limits>
 
-#include "absl/algorithm/container.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 
 namespace webrtc {
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
 
 RtpSequenceNumberMap::RtpSequenceNumberMap(size_t max_entries)
-    : max_entries_(max_entries) {
+    : max_entries_(max_entries),
+      associations_(RoundUpToPowerOfTwo(max_entries), Association(0)),
+      index_mask_(associations_.size() - 1) {
   RTC_DCHECK_GT(max_entries_, 4);  // See code paring down to |max_entries_|.
   RTC_DCHECK_LE(max_entries_, 1 << 15);
 }
@@ -30,33 +41,35 @@ RtpSequenceNumberMap::RtpSequenceNumberMap(size_t max_entries)
 RtpSequenceNumberMap::~RtpSequenceNumberMap() = default;
 
 void RtpSequenceNumberMap::InsertPacket(uint16_t sequence_number, Info info) {
-  RTC_DCHECK(associations_.size() < 2 ||
-             AheadOf(associations_.back().sequence_number,
-                     associations_.front().sequence_number));
+  RTC_DCHECK(size_ < 2 ||
+             AheadOf(At(size_ - 1).sequence_number, At(0).sequence_number));
 
-  if (associations_.empty()) {
-    associations_.emplace_back(sequence_number, info);
+  if (size_ == 0) {
+    begin_ = 0;
+    At(0) = Association(sequence_number, info);
+    size_ = 1;
     return;
   }
 
-  if (AheadOrAt(sequence_number, associations_.front().sequence_number) &&
-      AheadOrAt(associations_.back().sequence_number, sequence_number)) {
+  if (AheadOrAt(sequence_number, At(0).sequence_number) &&
+      AheadOrAt(At(size_ - 1).sequence_number, sequence_number)) {
     // The sequence number has wrapped around and is within the range
     // currently held by |associations_| - we should invalidate all entries.
     RTC_LOG(LS_WARNING) << "Sequence number wrapped-around unexpectedly.";
-    associations_.clear();
-    associations_.emplace_back(sequence_number, info);
+    begin_ = 0;
+    At(0) = Association(sequence_number, info);
+    size_ = 1;
     return;
   }
 
-  std::deque<Association>::iterator erase_to = associations_.begin();
+  size_t erase_count = 0;
 
-  RTC_DCHECK_LE(associations_.size(), max_entries_);
-  if (associations_.size() == max_entries_) {
+  RTC_DCHECK_LE(size_, max_entries_);
+  if (size_ == max_entries_) {
     // Pare down the container so that inserting some additional elements
     // would not exceed the maximum size.
     const size_t new_size = 3 * max_entries_ / 4;
-    erase_to = std::next(erase_to, max_entries_ - new_size);
+    erase_count = max_entries_ - new_size;
   }
 
   // It is guaranteed that |associations_| can be split into two partitions,
@@ -65,19 +78,16 @@ void RtpSequenceNumberMap::InsertPacket(uint16_t sequence_number, Info info) {
   //   This is the partition of the obsolete elements.
   // * In the second partition, the new element is AheadOf all the elements.
   //   The elements of this partition may stay.
-  auto cmp = [](const Association& a, uint16_t sequence_number) {
-    return AheadOf(a.sequence_number, sequence_number);
-  };
-  RTC_DCHECK(erase_to != associations_.end());
-  erase_to =
-      std::lower_bound(erase_to, associations_.end(), sequence_number, cmp);
-  associations_.erase(associations_.begin(), erase_to);
-
-  associations_.emplace_back(sequence_number, info);
-
-  RTC_DCHECK(associations_.size() == 1 ||
-             AheadOf(associations_.back().sequence_number,
-                     associations_.front().sequence_number));
+  RTC_DCHECK_LT(erase_count, size_);
+  erase_count = FirstNotObsoleted(erase_count, sequence_number);
+  begin_ = (begin_ + erase_count) & index_mask_;
+  size_ -= erase_count;
+
+  At(size_) = Association(sequence_number, info);
+  ++size_;
+
+  RTC_DCHECK(size_ == 1 ||
+             AheadOf(At(size_ - 1).sequence_number, At(0).sequence_number));
 }
 
 void RtpSequenceNumberMap::InsertFrame(uint16_t first_sequence_number,
@@ -96,34 +106,74 @@ void RtpSequenceNumberMap::InsertFrame(uint16_t first_sequence_number,
 
 absl::optional<RtpSequenceNumberMap::Info> RtpSequenceNumberMap::Get(
     uint16_t sequence_number) const {
-  // To make the binary search easier to understand, we use the fact that
-  // adding a constant offset to all elements, as well as to the searched
-  // element, does not change the relative ordering. This way, we can find
-  // an offset that would make all of the elements strictly ascending according
-  // to normal integer comparison.
+  // To make the search easier to understand, we use the fact that adding
+  // a constant offset to all elements, as well as to the searched element,
+  // does not change the relative ordering. This way, we can find an offset
+  // that would make all of the elements strictly ascending according to
+  // normal integer comparison.
   // Finding such an offset is easy - the offset that would map the oldest
   // element to 0 would serve this purpose.
 
-  if (associations_.empty()) {
+  if (size_ == 0) {
     return absl::nullopt;
   }
 
-  const uint16_t offset =
-      static_cast<uint16_t>(0) - associations_.front().sequence_number;
+  const uint16_t offset = static_cast<uint16_t>(0) - At(0).sequence_number;
+  const size_t target = static_cast<uint16_t>(sequence_number + offset);
+
+  // Packets are normally recorded without gaps in their sequence numbers,
+  // in which case the association is found at the index |target|.
+  // Otherwise, since the elements are strictly ascending, it can only be
+  // found before that index.
+  if (target < size_ && At(target).sequence_number == sequence_number) {
+    return At(target).info;
+  }
 
-  auto cmp = [offset](const Association& a, uint16_t sequence_number) {
-    return static_cast<uint16_t>(a.sequence_number + offset) <
-           static_cast<uint16_t>(sequence_number + offset);
-  };
-  const auto elem = absl::c_lower_bound(associations_, sequence_number, cmp);
+  size_t low = 0;
+  size_t high = std::min(target, size_);
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (static_cast<uint16_t>(At(middle).sequence_number + offset) < target) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
 
-  return elem != associations_.end() && elem->sequence_number == sequence_number
-             ? absl::optional<Info>(elem->info)
+  return low < size_ && At(low).sequence_number == sequence_number
+             ? absl::optional<Info>(At(low).info)
              : absl::nullopt;
 }
 
 size_t RtpSequenceNumberMap::AssociationCountForTesting() const {
-  return associations_.size();
+  return size_;
+}
+
+RtpSequenceNumberMap::Association& RtpSequenceNumberMap::At(size_t index) {
+  RTC_DCHECK_LE(index, size_);
+  return associations_[(begin_ + index) & index_mask_];
+}
+
+const RtpSequenceNumberMap::Association& RtpSequenceNumberMap::At(
+    size_t index) const {
+  RTC_DCHECK_LT(index, size_);
+  return associations_[(begin_ + index) & index_mask_];
+}
+
+size_t RtpSequenceNumberMap::FirstNotObsoleted(
+    size_t first_index,
+    uint16_t sequence_number) const {
+  size_t low = first_index;
+  size_t high = size_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (AheadOf(At(middle).sequence_number, sequence_number)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
 }
 
 }  // namespace webrtc
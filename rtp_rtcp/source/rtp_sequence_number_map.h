@@ -13,7 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <deque>
+#include <vector>
 
 #include "absl/types/optional.h"
 
@@ -73,11 +73,24 @@ class RtpSequenceNumberMap final {
     Info info;
   };
 
+  // The |index|-th oldest association.
+  Association& At(size_t index);
+  const Association& At(size_t index) const;
+
+  // Index of the first association that the new |sequence_number| is not
+  // AheadOf, searching from |first_index|.
+  size_t FirstNotObsoleted(size_t first_index, uint16_t sequence_number) const;
+
   const size_t max_entries_;
 
   // The non-transitivity of AheadOf() would be problematic with a map,
-  // so we use a deque instead.
-  std::deque<Association> associations_;
+  // so we use a ring buffer instead. Its capacity is |max_entries_| rounded
+  // up to a power of two, allocated once, so that the ring can be indexed
+  // with a mask.
+  std::vector<Association> associations_;
+  const size_t index_mask_;
+  size_t begin_ = 0;  // Ring position of the oldest association.
+  size_t size_ = 0;
 };
 
 }  // namespace webrtc
@@ -420,6 +420,32 @@ TEST_F(RtpSequenceNumberMapTest,
   EXPECT_EQ(uut.Get(new_association.sequence_number), new_association.info);
 }
 
+TEST_F(RtpSequenceNumberMapTest, GetFindsAssociationsAfterGapsAndParingDown) {
+  constexpr size_t kMaxEntries = 100;
+  RtpSequenceNumberMap uut(kMaxEntries);
+
+  // Every third sequence number is skipped, as if used by FEC packets.
+  std::vector<Association> associations;
+  uint32_t timestamp = 789;
+  uint16_t sequence_number = kUint16Max - 50;
+  for (size_t i = 0; i < 3 * kMaxEntries; ++i) {
+    if (i % 3 == 2) {
+      ++sequence_number;
+    }
+    associations.push_back(CreateAssociation(sequence_number++, ++timestamp));
+    uut.InsertPacket(associations.back().sequence_number,
+                     associations.back().info);
+  }
+
+  const auto expected_begin =
+      std::prev(associations.end(), uut.AssociationCountForTesting());
+  VerifyAssociations(uut, expected_begin, associations.end());
+  for (auto it = associations.begin(); it != expected_begin; ++it) {
+    EXPECT_FALSE(uut.Get(it->sequence_number));
+  }
+  EXPECT_FALSE(uut.Get(sequence_number));
+}
+
 TEST_F(RtpSequenceNumberMapTest, MaxEntriesObserved) {
   constexpr size_t kMaxEntries = 100;
   RtpSequenceNumberMap uut(kMaxEntries);
@@ -14,6 +14,13 @@
 #include <utility>
 
 namespace webrtc {
+namespace {
+
+bool HasSameSources(const RtpPacketInfo& lhs, const RtpPacketInfo& rhs) {
+  return lhs.ssrc() == rhs.ssrc() && lhs.csrcs() == rhs.csrcs();
+}
+
+}  // namespace
 
 constexpr int64_t SourceTracker::kTimeoutMs;
 
@@ -27,7 +34,16 @@ void SourceTracker::OnFrameDelivered(const RtpPacketInfos& packet_infos) {
   int64_t now_ms = clock_->TimeInMilliseconds();
   rtc::CritScope lock_scope(&lock_);
 
-  for (const auto& packet_info : packet_infos) {
+  for (size_t i = 0; i < packet_infos.size(); ++i) {
+    const RtpPacketInfo& packet_info = packet_infos[i];
+    // The packets of a frame normally come from the same sources. Everything
+    // a packet would update is then updated again by the next packet, so
+    // only the last packet of such a run needs to be applied.
+    if (i + 1 < packet_infos.size() &&
+        HasSameSources(packet_info, packet_infos[i + 1])) {
+      continue;
+    }
+
     for (uint32_t csrc : packet_info.csrcs()) {
       SourceKey key(RtpSourceType::CSRC, csrc);
       SourceEntry& entry = UpdateEntry(key);
@@ -68,6 +84,12 @@ std::vector<RtpSource> SourceTracker::GetSources() const {
 }
 
 SourceTracker::SourceEntry& SourceTracker::UpdateEntry(const SourceKey& key) {
+  // Updating the entry that was updated last, e.g. the SSRC of consecutive
+  // frames without CSRCs, needs no lookup.
+  if (!list_.empty() && SourceKeyComparator()(list_.front().first, key)) {
+    return list_.front().second;
+  }
+
   // We intentionally do |find() + emplace()|, instead of checking the return
   // value of |emplace()|, for performance reasons. It's much more likely for
   // the key to already exist than for it not to.
@@ -306,6 +306,40 @@ TEST(SourceTrackerTest, OnFrameDeliveredUpdatesSources) {
                             kAudioLevel0, kRtpTimestamp0)));
 }
 
+TEST(SourceTrackerTest, OnFrameDeliveredUsesLastPacketOfFrame) {
+  constexpr uint32_t kSsrc = 10;
+  constexpr uint32_t kCsrcs0 = 20;
+  constexpr uint32_t kCsrcs1 = 21;
+  constexpr uint32_t kRtpTimestamp = 40;
+  constexpr absl::optional<uint8_t> kAudioLevel0 = 50;
+  constexpr absl::optional<uint8_t> kAudioLevel1 = 51;
+  constexpr absl::optional<uint8_t> kAudioLevel2 = 52;
+  constexpr absl::optional<AbsoluteCaptureTime> kAbsoluteCaptureTime = {};
+  constexpr int64_t kReceiveTimeMs = 60;
+
+  SimulatedClock clock(1000000000000ULL);
+  SourceTracker tracker(&clock);
+
+  tracker.OnFrameDelivered(RtpPacketInfos(
+      {RtpPacketInfo(kSsrc, {kCsrcs0, kCsrcs1}, kRtpTimestamp, kAudioLevel0,
+                     kAbsoluteCaptureTime, kReceiveTimeMs),
+       RtpPacketInfo(kSsrc, {kCsrcs0, kCsrcs1}, kRtpTimestamp, kAudioLevel1,
+                     kAbsoluteCaptureTime, kReceiveTimeMs),
+       RtpPacketInfo(kSsrc, {kCsrcs1}, kRtpTimestamp, kAudioLevel2,
+                     kAbsoluteCaptureTime, kReceiveTimeMs)}));
+
+  int64_t timestamp_ms = clock.TimeInMilliseconds();
+
+  EXPECT_THAT(
+      tracker.GetSources(),
+      ElementsAre(RtpSource(timestamp_ms, kSsrc, RtpSourceType::SSRC,
+                            kAudioLevel2, kRtpTimestamp),
+                  RtpSource(timestamp_ms, kCsrcs1, RtpSourceType::CSRC,
+                            kAudioLevel2, kRtpTimestamp),
+                  RtpSource(timestamp_ms, kCsrcs0, RtpSourceType::CSRC,
+                            kAudioLevel1, kRtpTimestamp)));
+}
+
 TEST(SourceTrackerTest, TimedOutSourcesAreRemoved) {
   constexpr uint32_t kSsrc = 10;
   constexpr uint32_t kCsrcs0 = 20;
@@ -34,7 +34,9 @@ UlpfecReceiverImpl::UlpfecReceiverImpl(
     : ssrc_(ssrc),
       extensions_(extensions),
       recovered_packet_callback_(callback),
-      fec_(ForwardErrorCorrection::CreateUlpfec(ssrc_)) {}
+      fec_(ForwardErrorCorrection::CreateUlpfec(ssrc_)) {
+  fec_->EnablePacketPool();
+}
 
 UlpfecReceiverImpl::~UlpfecReceiverImpl() {
   received_packets_.clear();
@@ -95,10 +97,24 @@ bool UlpfecReceiverImpl::AddReceivedRedPacket(const RtpPacket& rtp_packet,
     return false;
   }
 
+  if (rtp_packet.payload()[0] & 0x80) {
+    // f bit set in RED header, i.e. there are more than one RED header blocks.
+    // WebRTC never generates multiple blocks in a RED packet for FEC.
+    RTC_LOG(LS_WARNING) << "More than 1 block in RED packet is not supported.";
+    return false;
+  }
+
   // Remove RED header of incoming packet and store as a virtual RTP packet.
-  auto received_packet =
-      std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
-  received_packet->pkt = new ForwardErrorCorrection::Packet();
+  // Both the packet and its storage are reused from previous packets.
+  std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> received_packet;
+  if (free_received_packets_.empty()) {
+    received_packet =
+        std::make_unique<ForwardErrorCorrection::ReceivedPacket>();
+  } else {
+    received_packet = std::move(free_received_packets_.back());
+    free_received_packets_.pop_back();
+  }
+  received_packet->pkt = fec_->AllocatePacket();
 
   // Get payload type from RED header and sequence number from RTP header.
   uint8_t payload_type = rtp_packet.payload()[0] & 0x7f;
@@ -106,13 +122,6 @@ bool UlpfecReceiverImpl::AddReceivedRedPacket(const RtpPacket& rtp_packet,
   received_packet->ssrc = rtp_packet.Ssrc();
   received_packet->seq_num = rtp_packet.SequenceNumber();
 
-  if (rtp_packet.payload()[0] & 0x80) {
-    // f bit set in RED header, i.e. there are more than one RED header blocks.
-    // WebRTC never generates multiple blocks in a RED packet for FEC.
-    RTC_LOG(LS_WARNING) << "More than 1 block in RED packet is not supported.";
-    return false;
-  }
-
   ++packet_counter_.num_packets;
   packet_counter_.num_bytes += rtp_packet.size();
   if (packet_counter_.first_packet_time_ms == -1) {
@@ -188,6 +197,18 @@ int32_t UlpfecReceiverImpl::ProcessReceivedFec() {
     fec_->DecodeFec(*received_packet, &recovered_packets_);
   }
 
+  // Keep the packets, and the vector if no packets were added meanwhile, for
+  // reuse by AddReceivedRedPacket. The packet storage is released to the
+  // pool of |fec_| once it no longer needs it for recovery.
+  for (auto& received_packet : received_packets) {
+    received_packet->pkt = nullptr;
+    free_received_packets_.push_back(std::move(received_packet));
+  }
+  received_packets.clear();
+  if (received_packets_.empty()) {
+    received_packets_.swap(received_packets);
+  }
+
   // Send any recovered media packets to VCM.
   for (const auto& recovered_packet : recovered_packets_) {
     if (recovered_packet->returned) {
@@ -53,6 +53,9 @@ class UlpfecReceiverImpl : public UlpfecReceiver {
   // ProcessReceivedFec into a single method, and we can then delete this list.
   std::vector<std::unique_ptr<ForwardErrorCorrection::ReceivedPacket>>
       received_packets_;
+  // Processed packets, reused by AddReceivedRedPacket.
+  std::vector<std::unique_ptr<ForwardErrorCorrection::ReceivedPacket>>
+      free_received_packets_;
   ForwardErrorCorrection::RecoveredPacketList recovered_packets_;
   FecPacketCounter packet_counter_;
 };
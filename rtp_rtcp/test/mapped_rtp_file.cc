@@ -0,0 +1,366 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/test/mapped_rtp_file.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr char kRtpDumpFirstLinePrefix[] = "#!rtpplay1.0 ";
+constexpr size_t kRtpDumpMaxFirstLineLength = 80;
+// start_sec, start_usec, source address, port and padding.
+constexpr size_t kRtpDumpFileHeaderSize = 16;
+// Record length, original packet length (0 for RTCP) and time offset.
+constexpr size_t kRtpDumpPacketHeaderSize = 8;
+
+constexpr uint32_t kPcapMagicMicroseconds = 0xa1b2c3d4;
+constexpr uint32_t kPcapMagicNanoseconds = 0xa1b23c4d;
+constexpr size_t kPcapFileHeaderSize = 24;
+constexpr size_t kPcapLinkTypeOffset = 20;
+// ts_sec, ts_usec (or ts_nsec), incl_len and orig_len.
+constexpr size_t kPcapRecordHeaderSize = 16;
+
+constexpr uint32_t kLinkTypeNull = 0;
+constexpr uint32_t kLinkTypeEthernet = 1;
+constexpr uint32_t kLinkTypeRaw = 101;
+constexpr uint32_t kLinkTypeLinuxSll = 113;
+constexpr uint32_t kLinkTypeIpv4 = 228;
+constexpr uint32_t kLinkTypeIpv6 = 229;
+
+constexpr size_t kNullHeaderSize = 4;
+constexpr size_t kEthernetHeaderSize = 14;
+constexpr size_t kVlanTagSize = 4;
+constexpr size_t kLinuxSllHeaderSize = 16;
+constexpr uint16_t kEtherTypeIpv4 = 0x0800;
+constexpr uint16_t kEtherTypeIpv6 = 0x86dd;
+constexpr uint16_t kEtherTypeVlan = 0x8100;
+constexpr size_t kIpv4MinHeaderSize = 20;
+constexpr size_t kIpv6HeaderSize = 40;
+constexpr uint8_t kIpProtocolUdp = 17;
+constexpr size_t kUdpHeaderSize = 8;
+
+std::vector<uint8_t> ReadFile(const std::string& file_name) {
+  std::vector<uint8_t> contents;
+  FILE* file = fopen(file_name.c_str(), "rb");
+  if (!file)
+    return contents;
+  uint8_t chunk[4096];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    contents.insert(contents.end(), chunk, chunk + read);
+  fclose(file);
+  return contents;
+}
+
+// RTCP packet types are 192-223, which as RTP would be a marker bit and a
+// payload type of 64-95.
+bool IsRtcp(rtc::ArrayView<const uint8_t> packet) {
+  return packet.size() >= 2 && packet[1] >= 192 && packet[1] <= 223;
+}
+
+// Returns the IP payload if |ip_packet| is an unfragmented UDP packet.
+rtc::ArrayView<const uint8_t> IpUdpPayload(
+    rtc::ArrayView<const uint8_t> ip_packet) {
+  if (ip_packet.empty())
+    return {};
+  size_t header_size;
+  uint8_t protocol;
+  const int version = ip_packet[0] >> 4;
+  if (version == 4) {
+    if (ip_packet.size() < kIpv4MinHeaderSize)
+      return {};
+    header_size = (ip_packet[0] & 0x0f) * 4;
+    protocol = ip_packet[9];
+    // The more fragments flag or a fragment offset marks a fragment.
+    const uint16_t fragment =
+        ByteReader<uint16_t>::ReadBigEndian(&ip_packet[6]);
+    if ((fragment & 0x3fff) != 0)
+      return {};
+  } else if (version == 6) {
+    header_size = kIpv6HeaderSize;
+    protocol = ip_packet.size() >= kIpv6HeaderSize ? ip_packet[6] : 0;
+  } else {
+    return {};
+  }
+  if (protocol != kIpProtocolUdp ||
+      ip_packet.size() < header_size + kUdpHeaderSize) {
+    return {};
+  }
+  const uint8_t* udp = ip_packet.data() + header_size;
+  const size_t udp_length = ByteReader<uint16_t>::ReadBigEndian(udp + 4);
+  if (udp_length < kUdpHeaderSize)
+    return {};
+  // The capture may have cut the packet short.
+  const size_t captured_length = ip_packet.size() - header_size;
+  return rtc::ArrayView<const uint8_t>(
+      udp + kUdpHeaderSize,
+      std::min(udp_length, captured_length) - kUdpHeaderSize);
+}
+
+}  // namespace
+
+std::unique_ptr<MappedRtpFile> MappedRtpFile::Open(const std::string& file_name,
+                                                   Format format) {
+  std::unique_ptr<MappedRtpFile> file = Map(file_name);
+  if (!file)
+    return nullptr;
+  file->format_ = format;
+  const bool valid = format == Format::kRtpDump ? file->ParseRtpDumpHeader()
+                                                : file->ParsePcapHeader();
+  if (!valid)
+    return nullptr;
+  return file;
+}
+
+std::unique_ptr<MappedRtpFile> MappedRtpFile::Open(
+    const std::string& file_name) {
+  std::unique_ptr<MappedRtpFile> file = Map(file_name);
+  if (!file)
+    return nullptr;
+  if (file->ParseRtpDumpHeader()) {
+    file->format_ = Format::kRtpDump;
+  } else if (file->ParsePcapHeader()) {
+    file->format_ = Format::kPcap;
+  } else {
+    RTC_LOG(LS_ERROR) << file_name << " is neither an rtpdump nor a pcap file.";
+    return nullptr;
+  }
+  return file;
+}
+
+std::unique_ptr<MappedRtpFile> MappedRtpFile::Map(
+    const std::string& file_name) {
+  std::unique_ptr<MappedRtpFile> file;
+#if defined(WEBRTC_POSIX)
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    RTC_LOG(LS_ERROR) << "Can't open " << file_name;
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      // Replay reads the file front to back.
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      file.reset(
+          new MappedRtpFile(static_cast<const uint8_t*>(mapping), size));
+    }
+  }
+  close(fd);
+#endif
+  if (!file) {
+    std::vector<uint8_t> contents = ReadFile(file_name);
+    if (contents.empty()) {
+      RTC_LOG(LS_ERROR) << "Can't read " << file_name;
+      return nullptr;
+    }
+    file.reset(new MappedRtpFile(std::move(contents)));
+  }
+  return file;
+}
+
+MappedRtpFile::MappedRtpFile(const uint8_t* mapped_data, size_t size)
+    : data_(mapped_data), size_(size), mapped_(true) {}
+
+MappedRtpFile::MappedRtpFile(std::vector<uint8_t> contents)
+    : contents_(std::move(contents)),
+      data_(contents_.data()),
+      size_(contents_.size()),
+      mapped_(false) {}
+
+MappedRtpFile::~MappedRtpFile() {
+#if defined(WEBRTC_POSIX)
+  if (mapped_)
+    munmap(const_cast<uint8_t*>(data_), size_);
+#else
+  RTC_DCHECK(!mapped_);
+#endif
+}
+
+bool MappedRtpFile::NextPacket(Packet* packet) {
+  return format_ == Format::kRtpDump ? NextRtpDumpPacket(packet)
+                                     : NextPcapPacket(packet);
+}
+
+void MappedRtpFile::Rewind() {
+  position_ = first_packet_;
+}
+
+bool MappedRtpFile::ParseRtpDumpHeader() {
+  const size_t prefix_length = strlen(kRtpDumpFirstLinePrefix);
+  if (size_ < prefix_length ||
+      memcmp(data_, kRtpDumpFirstLinePrefix, prefix_length) != 0) {
+    return false;
+  }
+  const size_t search_length = std::min(size_, kRtpDumpMaxFirstLineLength);
+  const void* line_end = memchr(data_, '\n', search_length);
+  if (!line_end)
+    return false;
+  first_packet_ = static_cast<const uint8_t*>(line_end) - data_ + 1 +
+                  kRtpDumpFileHeaderSize;
+  if (first_packet_ > size_)
+    return false;
+  position_ = first_packet_;
+  return true;
+}
+
+bool MappedRtpFile::ParsePcapHeader() {
+  if (size_ < kPcapFileHeaderSize)
+    return false;
+  const uint32_t magic = ByteReader<uint32_t>::ReadLittleEndian(data_);
+  const uint32_t swapped_magic = ByteReader<uint32_t>::ReadBigEndian(data_);
+  if (magic == kPcapMagicMicroseconds || magic == kPcapMagicNanoseconds) {
+    pcap_big_endian_ = false;
+    pcap_nanoseconds_ = magic == kPcapMagicNanoseconds;
+  } else if (swapped_magic == kPcapMagicMicroseconds ||
+             swapped_magic == kPcapMagicNanoseconds) {
+    pcap_big_endian_ = true;
+    pcap_nanoseconds_ = swapped_magic == kPcapMagicNanoseconds;
+  } else {
+    return false;
+  }
+  pcap_link_type_ = ReadPcapUint32(data_ + kPcapLinkTypeOffset) & 0xffff;
+  switch (pcap_link_type_) {
+    case kLinkTypeNull:
+    case kLinkTypeEthernet:
+    case kLinkTypeRaw:
+    case kLinkTypeLinuxSll:
+    case kLinkTypeIpv4:
+    case kLinkTypeIpv6:
+      break;
+    default:
+      RTC_LOG(LS_ERROR) << "Unsupported pcap link type " << pcap_link_type_;
+      return false;
+  }
+  first_packet_ = kPcapFileHeaderSize;
+  position_ = first_packet_;
+  return true;
+}
+
+bool MappedRtpFile::NextRtpDumpPacket(Packet* packet) {
+  if (size_ - position_ < kRtpDumpPacketHeaderSize)
+    return false;
+  const uint8_t* header = data_ + position_;
+  const size_t record_length = ByteReader<uint16_t>::ReadBigEndian(header);
+  const size_t original_length =
+      ByteReader<uint16_t>::ReadBigEndian(header + 2);
+  if (record_length < kRtpDumpPacketHeaderSize ||
+      record_length > size_ - position_) {
+    return false;
+  }
+  packet->data =
+      rtc::ArrayView<const uint8_t>(header + kRtpDumpPacketHeaderSize,
+                                    record_length - kRtpDumpPacketHeaderSize);
+  packet->is_rtcp = original_length == 0;
+  packet->original_length =
+      std::max(original_length, packet->data.size());
+  packet->time_ms = ByteReader<uint32_t>::ReadBigEndian(header + 4);
+  position_ += record_length;
+  return true;
+}
+
+bool MappedRtpFile::NextPcapPacket(Packet* packet) {
+  while (size_ - position_ >= kPcapRecordHeaderSize) {
+    const uint8_t* header = data_ + position_;
+    const uint32_t seconds = ReadPcapUint32(header);
+    const uint32_t fraction = ReadPcapUint32(header + 4);
+    const size_t captured_length = ReadPcapUint32(header + 8);
+    const size_t original_length = ReadPcapUint32(header + 12);
+    if (captured_length > size_ - position_ - kPcapRecordHeaderSize)
+      return false;
+    position_ += kPcapRecordHeaderSize + captured_length;
+
+    rtc::ArrayView<const uint8_t> payload = UdpPayload(
+        rtc::ArrayView<const uint8_t>(header + kPcapRecordHeaderSize,
+                                      captured_length));
+    // Only RTP and RTCP, both version 2, are of interest.
+    if (payload.empty() || (payload[0] >> 6) != 2)
+      continue;
+
+    const int64_t time_us =
+        seconds * rtc::kNumMicrosecsPerSec +
+        (pcap_nanoseconds_ ? fraction / 1000 : fraction);
+    if (!pcap_has_first_time_) {
+      pcap_has_first_time_ = true;
+      pcap_first_time_us_ = time_us;
+    }
+    packet->data = payload;
+    packet->original_length =
+        payload.size() + original_length -
+        std::min(original_length, captured_length);
+    packet->time_ms = static_cast<uint32_t>((time_us - pcap_first_time_us_) /
+                                            rtc::kNumMicrosecsPerMillisec);
+    packet->is_rtcp = IsRtcp(payload);
+    return true;
+  }
+  return false;
+}
+
+rtc::ArrayView<const uint8_t> MappedRtpFile::UdpPayload(
+    rtc::ArrayView<const uint8_t> frame) const {
+  switch (pcap_link_type_) {
+    case kLinkTypeNull:
+      if (frame.size() < kNullHeaderSize)
+        return {};
+      return IpUdpPayload(frame.subview(kNullHeaderSize));
+    case kLinkTypeEthernet: {
+      size_t header_size = kEthernetHeaderSize;
+      if (frame.size() < header_size)
+        return {};
+      uint16_t ether_type =
+          ByteReader<uint16_t>::ReadBigEndian(&frame[header_size - 2]);
+      if (ether_type == kEtherTypeVlan) {
+        header_size += kVlanTagSize;
+        if (frame.size() < header_size)
+          return {};
+        ether_type =
+            ByteReader<uint16_t>::ReadBigEndian(&frame[header_size - 2]);
+      }
+      if (ether_type != kEtherTypeIpv4 && ether_type != kEtherTypeIpv6)
+        return {};
+      return IpUdpPayload(frame.subview(header_size));
+    }
+    case kLinkTypeLinuxSll:
+      if (frame.size() < kLinuxSllHeaderSize)
+        return {};
+      return IpUdpPayload(frame.subview(kLinuxSllHeaderSize));
+    default:
+      return IpUdpPayload(frame);
+  }
+}
+
+uint32_t MappedRtpFile::ReadPcapUint32(const uint8_t* data) const {
+  return pcap_big_endian_ ? ByteReader<uint32_t>::ReadBigEndian(data)
+                          : ByteReader<uint32_t>::ReadLittleEndian(data);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_TEST_MAPPED_RTP_FILE_H_
+#define MODULES_RTP_RTCP_TEST_MAPPED_RTP_FILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+namespace test {
+
+// Read only view of an rtpdump ("#!rtpplay1.0") or pcap file, memory mapped
+// where the platform supports it so that replaying a recording neither copies
+// nor allocates per packet. Other platforms read the whole file into memory.
+// Pcap files must hold UDP over IPv4 or IPv6 on an Ethernet, Linux cooked,
+// loopback or raw IP link; other packets, and IP fragments, are skipped.
+class MappedRtpFile {
+ public:
+  enum class Format { kRtpDump, kPcap };
+
+  struct Packet {
+    // The RTP or RTCP packet. Points into the file, and is valid for the
+    // lifetime of the MappedRtpFile.
+    rtc::ArrayView<const uint8_t> data;
+    // The length of the packet when it was received. Larger than |data| if
+    // the recording only kept the start of the packet, e.g. the RTP header.
+    size_t original_length = 0;
+    // Time since the start of the recording, or since the first packet for
+    // pcap files.
+    uint32_t time_ms = 0;
+    bool is_rtcp = false;
+  };
+
+  // Returns nullptr if the file can't be read or has another format.
+  static std::unique_ptr<MappedRtpFile> Open(const std::string& file_name,
+                                             Format format);
+  // Same as above, but detects the format.
+  static std::unique_ptr<MappedRtpFile> Open(const std::string& file_name);
+
+  ~MappedRtpFile();
+
+  // Reads the next packet, returns false at the end of the file. A truncated
+  // last record is treated as the end of the file.
+  bool NextPacket(Packet* packet);
+  // Restarts reading from the first packet.
+  void Rewind();
+
+  Format format() const { return format_; }
+  size_t size_bytes() const { return size_; }
+
+ private:
+  // Takes ownership of the mapping of |size| bytes at |mapped_data|.
+  MappedRtpFile(const uint8_t* mapped_data, size_t size);
+  explicit MappedRtpFile(std::vector<uint8_t> contents);
+
+  static std::unique_ptr<MappedRtpFile> Map(const std::string& file_name);
+
+  // Checks the file header and finds the first packet. Returns false if the
+  // file has another format.
+  bool ParseRtpDumpHeader();
+  bool ParsePcapHeader();
+
+  bool NextRtpDumpPacket(Packet* packet);
+  bool NextPcapPacket(Packet* packet);
+  // Returns the UDP payload of a pcap record, or an empty view if the record
+  // isn't a UDP packet.
+  rtc::ArrayView<const uint8_t> UdpPayload(
+      rtc::ArrayView<const uint8_t> frame) const;
+  uint32_t ReadPcapUint32(const uint8_t* data) const;
+
+  // Holds the file contents when it is not mapped.
+  const std::vector<uint8_t> contents_;
+  const uint8_t* const data_;
+  const size_t size_;
+  // True if |data_| is a memory mapping to release with munmap().
+  const bool mapped_;
+  Format format_ = Format::kRtpDump;
+  size_t first_packet_ = 0;
+  size_t position_ = 0;
+
+  // Pcap specifics.
+  bool pcap_big_endian_ = false;
+  bool pcap_nanoseconds_ = false;
+  uint32_t pcap_link_type_ = 0;
+  bool pcap_has_first_time_ = false;
+  int64_t pcap_first_time_us_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MappedRtpFile);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_TEST_MAPPED_RTP_FILE_H_
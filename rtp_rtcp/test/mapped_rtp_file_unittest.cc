@@ -0,0 +1,214 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/test/mapped_rtp_file.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Version 2, payload type 96, sequence number 1, timestamp 2 and SSRC 3.
+const uint8_t kRtpPacket[] = {0x80, 96, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3, 0xab};
+// An empty receiver report.
+const uint8_t kRtcpPacket[] = {0x80, 201, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03};
+
+std::vector<uint8_t> ToVector(rtc::ArrayView<const uint8_t> data) {
+  return std::vector<uint8_t>(data.begin(), data.end());
+}
+
+std::string WriteToFile(const std::vector<uint8_t>& contents) {
+  const std::string file_name = TempFilename(OutputPath(), "mapped_rtp_file");
+  FILE* file = fopen(file_name.c_str(), "wb");
+  EXPECT_TRUE(file);
+  if (file) {
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+  }
+  return file_name;
+}
+
+void Append(std::vector<uint8_t>* contents, const uint8_t* data, size_t size) {
+  contents->insert(contents->end(), data, data + size);
+}
+
+std::vector<uint8_t> RtpDumpHeader() {
+  const std::string first_line = "#!rtpplay1.0 127.0.0.1/5000\n";
+  std::vector<uint8_t> contents(first_line.begin(), first_line.end());
+  contents.resize(contents.size() + 16);
+  return contents;
+}
+
+void AddRtpDumpPacket(std::vector<uint8_t>* contents,
+                      const uint8_t* data,
+                      size_t size,
+                      uint32_t time_ms,
+                      bool is_rtcp) {
+  uint8_t header[8];
+  ByteWriter<uint16_t>::WriteBigEndian(
+      header, static_cast<uint16_t>(size + sizeof(header)));
+  ByteWriter<uint16_t>::WriteBigEndian(
+      header + 2, is_rtcp ? 0 : static_cast<uint16_t>(size));
+  ByteWriter<uint32_t>::WriteBigEndian(header + 4, time_ms);
+  Append(contents, header, sizeof(header));
+  Append(contents, data, size);
+}
+
+// A little endian, microsecond resolution pcap file on an Ethernet link.
+std::vector<uint8_t> PcapHeader() {
+  std::vector<uint8_t> contents(24);
+  ByteWriter<uint32_t>::WriteLittleEndian(&contents[0], 0xa1b2c3d4);
+  ByteWriter<uint16_t>::WriteLittleEndian(&contents[4], 2);
+  ByteWriter<uint16_t>::WriteLittleEndian(&contents[6], 4);
+  ByteWriter<uint32_t>::WriteLittleEndian(&contents[16], 65535);
+  ByteWriter<uint32_t>::WriteLittleEndian(&contents[20], 1);
+  return contents;
+}
+
+// Adds an Ethernet frame holding an IPv4 packet with |protocol|, which holds a
+// UDP datagram with |payload| if |protocol| is UDP.
+void AddPcapPacket(std::vector<uint8_t>* contents,
+                   const uint8_t* payload,
+                   size_t size,
+                   uint32_t seconds,
+                   uint32_t microseconds,
+                   uint8_t protocol = 17) {
+  std::vector<uint8_t> frame(14 + 20 + 8);
+  ByteWriter<uint16_t>::WriteBigEndian(&frame[12], 0x0800);
+  uint8_t* ip = &frame[14];
+  ip[0] = 0x45;
+  ByteWriter<uint16_t>::WriteBigEndian(&ip[2],
+                                       static_cast<uint16_t>(20 + 8 + size));
+  ip[8] = 64;
+  ip[9] = protocol;
+  uint8_t* udp = ip + 20;
+  ByteWriter<uint16_t>::WriteBigEndian(&udp[0], 5000);
+  ByteWriter<uint16_t>::WriteBigEndian(&udp[2], 5002);
+  ByteWriter<uint16_t>::WriteBigEndian(&udp[4],
+                                       static_cast<uint16_t>(8 + size));
+  Append(&frame, payload, size);
+
+  uint8_t header[16];
+  ByteWriter<uint32_t>::WriteLittleEndian(header, seconds);
+  ByteWriter<uint32_t>::WriteLittleEndian(header + 4, microseconds);
+  ByteWriter<uint32_t>::WriteLittleEndian(header + 8,
+                                          static_cast<uint32_t>(frame.size()));
+  ByteWriter<uint32_t>::WriteLittleEndian(header + 12,
+                                          static_cast<uint32_t>(frame.size()));
+  Append(contents, header, sizeof(header));
+  Append(contents, frame.data(), frame.size());
+}
+
+}  // namespace
+
+TEST(MappedRtpFileTest, ReadsRtpDumpPacketsInOrder) {
+  std::vector<uint8_t> contents = RtpDumpHeader();
+  AddRtpDumpPacket(&contents, kRtpPacket, sizeof(kRtpPacket), 10, false);
+  AddRtpDumpPacket(&contents, kRtcpPacket, sizeof(kRtcpPacket), 20, true);
+  const std::string file_name = WriteToFile(contents);
+
+  std::unique_ptr<MappedRtpFile> file = MappedRtpFile::Open(file_name);
+  ASSERT_TRUE(file);
+  EXPECT_EQ(MappedRtpFile::Format::kRtpDump, file->format());
+  MappedRtpFile::Packet packet;
+  ASSERT_TRUE(file->NextPacket(&packet));
+  EXPECT_EQ(std::vector<uint8_t>(kRtpPacket, kRtpPacket + sizeof(kRtpPacket)),
+            ToVector(packet.data));
+  EXPECT_EQ(sizeof(kRtpPacket), packet.original_length);
+  EXPECT_EQ(10u, packet.time_ms);
+  EXPECT_FALSE(packet.is_rtcp);
+  ASSERT_TRUE(file->NextPacket(&packet));
+  EXPECT_EQ(sizeof(kRtcpPacket), packet.data.size());
+  EXPECT_EQ(20u, packet.time_ms);
+  EXPECT_TRUE(packet.is_rtcp);
+  EXPECT_FALSE(file->NextPacket(&packet));
+
+  file->Rewind();
+  ASSERT_TRUE(file->NextPacket(&packet));
+  EXPECT_EQ(10u, packet.time_ms);
+  RemoveFile(file_name);
+}
+
+TEST(MappedRtpFileTest, StopsAtTruncatedRtpDumpPacket) {
+  std::vector<uint8_t> contents = RtpDumpHeader();
+  AddRtpDumpPacket(&contents, kRtpPacket, sizeof(kRtpPacket), 0, false);
+  AddRtpDumpPacket(&contents, kRtpPacket, sizeof(kRtpPacket), 0, false);
+  contents.pop_back();
+  const std::string file_name = WriteToFile(contents);
+
+  std::unique_ptr<MappedRtpFile> file = MappedRtpFile::Open(file_name);
+  ASSERT_TRUE(file);
+  MappedRtpFile::Packet packet;
+  EXPECT_TRUE(file->NextPacket(&packet));
+  EXPECT_FALSE(file->NextPacket(&packet));
+  RemoveFile(file_name);
+}
+
+TEST(MappedRtpFileTest, ReadsPcapUdpPayloads) {
+  std::vector<uint8_t> contents = PcapHeader();
+  AddPcapPacket(&contents, kRtpPacket, sizeof(kRtpPacket), 100, 500000);
+  // A TCP segment, which is skipped.
+  AddPcapPacket(&contents, kRtpPacket, sizeof(kRtpPacket), 100, 600000, 6);
+  AddPcapPacket(&contents, kRtcpPacket, sizeof(kRtcpPacket), 101, 0);
+  const std::string file_name = WriteToFile(contents);
+
+  std::unique_ptr<MappedRtpFile> file = MappedRtpFile::Open(file_name);
+  ASSERT_TRUE(file);
+  EXPECT_EQ(MappedRtpFile::Format::kPcap, file->format());
+  MappedRtpFile::Packet packet;
+  ASSERT_TRUE(file->NextPacket(&packet));
+  EXPECT_EQ(std::vector<uint8_t>(kRtpPacket, kRtpPacket + sizeof(kRtpPacket)),
+            ToVector(packet.data));
+  EXPECT_EQ(sizeof(kRtpPacket), packet.original_length);
+  EXPECT_EQ(0u, packet.time_ms);
+  EXPECT_FALSE(packet.is_rtcp);
+  ASSERT_TRUE(file->NextPacket(&packet));
+  EXPECT_EQ(sizeof(kRtcpPacket), packet.data.size());
+  EXPECT_EQ(500u, packet.time_ms);
+  EXPECT_TRUE(packet.is_rtcp);
+  EXPECT_FALSE(file->NextPacket(&packet));
+
+  file->Rewind();
+  ASSERT_TRUE(file->NextPacket(&packet));
+  EXPECT_EQ(0u, packet.time_ms);
+  RemoveFile(file_name);
+}
+
+TEST(MappedRtpFileTest, OpensOnlyTheRequestedFormat) {
+  std::vector<uint8_t> contents = PcapHeader();
+  AddPcapPacket(&contents, kRtpPacket, sizeof(kRtpPacket), 0, 0);
+  const std::string file_name = WriteToFile(contents);
+
+  EXPECT_TRUE(MappedRtpFile::Open(file_name, MappedRtpFile::Format::kPcap));
+  EXPECT_FALSE(
+      MappedRtpFile::Open(file_name, MappedRtpFile::Format::kRtpDump));
+  RemoveFile(file_name);
+}
+
+TEST(MappedRtpFileTest, RejectsOtherFiles) {
+  const std::string text = "#!not an rtpdump file\n";
+  const std::string file_name =
+      WriteToFile(std::vector<uint8_t>(text.begin(), text.end()));
+  EXPECT_FALSE(MappedRtpFile::Open(file_name));
+  EXPECT_FALSE(MappedRtpFile::Open(file_name + ".missing"));
+  RemoveFile(file_name);
+}
+
+}  // namespace test
+}  // namespace webrtc
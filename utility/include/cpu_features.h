@@ -0,0 +1,24 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_UTILITY_INCLUDE_CPU_FEATURES_H_
+#define MODULES_UTILITY_INCLUDE_CPU_FEATURES_H_
+
+namespace webrtc {
+
+// Returns true if both the CPU and the operating system support the AVX2 and
+// FMA3 instruction sets. WebRtc_GetCPUInfo() in system_wrappers only reports
+// SSE2 and SSE3, so modules that ship AVX2 kernels use this to select them at
+// runtime. The result is computed once and cached.
+bool GetCpuSupportsAvx2();
+
+}  // namespace webrtc
+
+#endif  // MODULES_UTILITY_INCLUDE_CPU_FEATURES_H_
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_UTILITY_INCLUDE_STATISTICS_SNAPSHOT_H_
+#define MODULES_UTILITY_INCLUDE_STATISTICS_SNAPSHOT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace webrtc {
+
+// Holds the last published copy of a trivially copyable statistics struct.
+// Publish() must only be called by one thread at a time, while Read() may be
+// called from any thread. Readers never block the publisher: the copy is
+// protected by a sequence lock, and a reader retries only if a copy was
+// published while it was reading.
+template <typename T>
+class StatisticsSnapshot {
+ public:
+  StatisticsSnapshot() : sequence_(0) { Publish(T()); }
+
+  void Publish(const T& value) {
+    uint64_t words[kNumWords] = {};
+    memcpy(words, &value, sizeof(T));
+    const uint32_t sequence = sequence_.load(std::memory_order_relaxed) + 1;
+    sequence_.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t k = 0; k < kNumWords; ++k) {
+      words_[k].store(words[k], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 1, std::memory_order_release);
+  }
+
+  T Read() const {
+    uint64_t words[kNumWords];
+    uint32_t sequence;
+    do {
+      sequence = sequence_.load(std::memory_order_acquire);
+      for (size_t k = 0; k < kNumWords; ++k) {
+        words[k] = words_[k].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) != 0 ||
+             sequence != sequence_.load(std::memory_order_relaxed));
+    T value;
+    memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+ private:
+  static_assert(std::is_trivially_copyable<T>::value,
+                "The snapshot is copied word by word");
+  static constexpr size_t kNumWords = (sizeof(T) + 7) / 8;
+
+  // Odd while a copy is being published. The words are atomics so that racing
+  // reads are well defined; a reader discards what it read if the sequence
+  // changed meanwhile.
+  std::atomic<uint32_t> sequence_;
+  std::array<std::atomic<uint64_t>, kNumWords> words_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_UTILITY_INCLUDE_STATISTICS_SNAPSHOT_H_
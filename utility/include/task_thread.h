@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_UTILITY_INCLUDE_TASK_THREAD_H_
+#define MODULES_UTILITY_INCLUDE_TASK_THREAD_H_
+
+#include "api/function_view.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs one task at a time on a dedicated thread. Meant for code that splits a
+// piece of work between the calling thread and a few of these threads, and
+// joins them before returning: StartTask() hands a task to the thread and
+// Wait() blocks until it has returned. The two calls must alternate, and must
+// be made from the same thread.
+class TaskThread {
+ public:
+  TaskThread(const char* thread_name, rtc::ThreadPriority priority);
+  ~TaskThread();
+  TaskThread(const TaskThread&) = delete;
+  TaskThread& operator=(const TaskThread&) = delete;
+
+  // Runs |task| on the thread. |task| is not copied, so it must stay valid
+  // until Wait() returns.
+  void StartTask(rtc::FunctionView<void()> task);
+  // Blocks until the task started by StartTask() has returned. Everything the
+  // task wrote is visible to the caller once Wait() returns.
+  void Wait();
+
+ private:
+  static void Run(void* obj);
+  bool Process();
+
+  rtc::CriticalSection crit_;
+  bool stop_ RTC_GUARDED_BY(crit_) = false;
+  bool has_task_ RTC_GUARDED_BY(crit_) = false;
+  rtc::FunctionView<void()> task_ RTC_GUARDED_BY(crit_);
+
+  rtc::Event task_ready_;
+  rtc::Event task_done_;
+  rtc::PlatformThread thread_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_UTILITY_INCLUDE_TASK_THREAD_H_
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/include/cpu_features.h"
+
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void Cpuid(int cpu_info[4], int leaf, int subleaf) {
+#if defined(_MSC_VER)
+  __cpuidex(cpu_info, leaf, subleaf);
+#elif defined(__pic__) && defined(__i386__)
+  // EBX is reserved for the GOT pointer in 32-bit PIC code.
+  __asm__ volatile(
+      "mov %%ebx, %%edi\n"
+      "cpuid\n"
+      "xchg %%edi, %%ebx\n"
+      : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]),
+        "=d"(cpu_info[3])
+      : "a"(leaf), "c"(subleaf));
+#else
+  __asm__ volatile("cpuid\n"
+                   : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]),
+                     "=d"(cpu_info[3])
+                   : "a"(leaf), "c"(subleaf));
+#endif
+}
+
+uint64_t Xgetbv(int xcr) {
+#if defined(_MSC_VER)
+  return _xgetbv(xcr);
+#else
+  uint32_t eax;
+  uint32_t edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+bool DetectAvx2() {
+  int cpu_info[4];
+  Cpuid(cpu_info, 0, 0);
+  const int max_leaf = cpu_info[0];
+  if (max_leaf < 7) {
+    return false;
+  }
+
+  Cpuid(cpu_info, 1, 0);
+  constexpr int kFmaBit = 1 << 12;
+  constexpr int kOsxsaveBit = 1 << 27;
+  constexpr int kAvxBit = 1 << 28;
+  const int ecx = cpu_info[2];
+  if ((ecx & kFmaBit) == 0 || (ecx & kOsxsaveBit) == 0 ||
+      (ecx & kAvxBit) == 0) {
+    return false;
+  }
+
+  // The OS must save and restore the XMM and YMM registers on context switch.
+  constexpr uint64_t kXmmYmmState = 0x6;
+  if ((Xgetbv(0) & kXmmYmmState) != kXmmYmmState) {
+    return false;
+  }
+
+  Cpuid(cpu_info, 7, 0);
+  constexpr int kAvx2Bit = 1 << 5;
+  return (cpu_info[1] & kAvx2Bit) != 0;
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
+
+}  // namespace
+
+bool GetCpuSupportsAvx2() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static const bool supports_avx2 = DetectAvx2();
+  return supports_avx2;
+#else
+  return false;
+#endif
+}
+
+}  // namespace webrtc
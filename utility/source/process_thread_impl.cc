@@ -10,7 +10,9 @@
 
 #include "modules/utility/source/process_thread_impl.h"
 
+#include <iterator>
 #include <string>
+#include <utility>
 
 #include "modules/include/module.h"
 #include "rtc_base/checks.h"
@@ -25,6 +27,10 @@ namespace {
 // should be made, but Process() should be called directly.
 const int64_t kCallProcessImmediately = -1;
 
+// Stale schedule entries are dropped once there are this many more of them
+// than registered modules.
+const size_t kMaxStaleScheduleEntries = 64;
+
 int64_t GetNextCallbackTime(Module* module, int64_t time_now) {
   int64_t interval = module->TimeUntilNextProcess();
   if (interval < 0) {
@@ -96,9 +102,11 @@ void ProcessThreadImpl::WakeUp(Module* module) {
   // Allowed to be called on any thread.
   {
     rtc::CritScope lock(&lock_);
-    for (ModuleCallback& m : modules_) {
-      if (m.module == module)
-        m.next_callback = kCallProcessImmediately;
+    auto it = module_index_.find(module);
+    if (it != module_index_.end() &&
+        it->second->next_callback != kCallProcessImmediately) {
+      it->second->next_callback = kCallProcessImmediately;
+      Schedule(&*it->second);
     }
   }
   wake_up_.Set();
@@ -122,11 +130,11 @@ void ProcessThreadImpl::RegisterModule(Module* module,
   {
     // Catch programmer error.
     rtc::CritScope lock(&lock_);
-    for (const ModuleCallback& mc : modules_) {
-      RTC_DCHECK(mc.module != module)
-          << "Already registered here: " << mc.location.ToString() << "\n"
-          << "Now attempting from here: " << from.ToString();
-    }
+    auto it = module_index_.find(module);
+    RTC_DCHECK(it == module_index_.end())
+        << "Already registered here: " << it->second->location.ToString()
+        << "\n"
+        << "Now attempting from here: " << from.ToString();
   }
 #endif
 
@@ -138,7 +146,9 @@ void ProcessThreadImpl::RegisterModule(Module* module,
 
   {
     rtc::CritScope lock(&lock_);
-    modules_.push_back(ModuleCallback(module, from));
+    modules_.push_back(ModuleCallback(module, from, next_module_id_++));
+    module_index_[module] = std::prev(modules_.end());
+    Schedule(&modules_.back());
   }
 
   // Wake the thread calling ProcessThreadImpl::Process() to update the
@@ -153,8 +163,13 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
 
   {
     rtc::CritScope lock(&lock_);
-    modules_.remove_if(
-        [&module](const ModuleCallback& m) { return m.module == module; });
+    auto it = module_index_.find(module);
+    if (it != module_index_.end()) {
+      modules_.erase(it->second);
+      module_index_.erase(it);
+    }
+    // Its entries in |schedule_| are now stale.
+    MaybeCompactSchedule();
   }
 
   // Notify the module that it's been detached.
@@ -177,32 +192,43 @@ bool ProcessThreadImpl::Process() {
     rtc::CritScope lock(&lock_);
     if (stop_)
       return false;
-    for (ModuleCallback& m : modules_) {
+    // Pop the modules that are due. Each is processed at most once per
+    // call, so the rescheduled ones are pushed back after the loop.
+    std::vector<ModuleCallback*> rescheduled;
+    while (!schedule_.empty() && schedule_.top().next_callback <= now) {
+      ModuleCallback* m = FindScheduled(schedule_.top());
+      schedule_.pop();
+      if (!m)
+        continue;
       // TODO(tommi): Would be good to measure the time TimeUntilNextProcess
       // takes and dcheck if it takes too long (e.g. >=10ms).  Ideally this
       // operation should not require taking a lock, so querying all modules
       // should run in a matter of nanoseconds.
-      if (m.next_callback == 0)
-        m.next_callback = GetNextCallbackTime(m.module, now);
+      if (m->next_callback == 0)
+        m->next_callback = GetNextCallbackTime(m->module, now);
 
-      if (m.next_callback <= now ||
-          m.next_callback == kCallProcessImmediately) {
+      if (m->next_callback <= now ||
+          m->next_callback == kCallProcessImmediately) {
         {
           TRACE_EVENT2("webrtc", "ModuleProcess", "function",
-                       m.location.function_name(), "file",
-                       m.location.file_and_line());
-          m.module->Process();
+                       m->location.function_name(), "file",
+                       m->location.file_and_line());
+          m->module->Process();
         }
         // Use a new 'now' reference to calculate when the next callback
         // should occur.  We'll continue to use 'now' above for the baseline
         // of calculating how long we should wait, to reduce variance.
         int64_t new_now = rtc::TimeMillis();
-        m.next_callback = GetNextCallbackTime(m.module, new_now);
+        m->next_callback = GetNextCallbackTime(m->module, new_now);
       }
-
-      if (m.next_callback < next_checkpoint)
-        next_checkpoint = m.next_callback;
+      rescheduled.push_back(m);
     }
+    for (ModuleCallback* m : rescheduled)
+      Schedule(m);
+
+    // The top entry may be stale, which only makes the wait shorter.
+    if (!schedule_.empty() && schedule_.top().next_callback < next_checkpoint)
+      next_checkpoint = schedule_.top().next_callback;
 
     while (!queue_.empty()) {
       QueuedTask* task = queue_.front();
@@ -220,4 +246,35 @@ bool ProcessThreadImpl::Process() {
 
   return true;
 }
+
+ProcessThreadImpl::ModuleCallback* ProcessThreadImpl::FindScheduled(
+    const ScheduledModule& entry) {
+  auto it = module_index_.find(entry.module);
+  if (it == module_index_.end())
+    return nullptr;
+  ModuleCallback& m = *it->second;
+  if (m.id != entry.id || m.schedule_generation != entry.generation)
+    return nullptr;
+  return &m;
+}
+
+void ProcessThreadImpl::Schedule(ModuleCallback* m) {
+  schedule_.push(
+      {m->next_callback, m->module, m->id, ++m->schedule_generation});
+  MaybeCompactSchedule();
+}
+
+void ProcessThreadImpl::MaybeCompactSchedule() {
+  if (schedule_.size() <= modules_.size() + kMaxStaleScheduleEntries)
+    return;
+  std::vector<ScheduledModule> entries;
+  entries.reserve(modules_.size());
+  for (const ModuleCallback& m : modules_)
+    entries.push_back(
+        {m.next_callback, m.module, m.id, m.schedule_generation});
+  schedule_ = std::priority_queue<ScheduledModule, std::vector<ScheduledModule>,
+                                  std::greater<ScheduledModule>>(
+      std::greater<ScheduledModule>(), std::move(entries));
+}
+
 }  // namespace webrtc
@@ -13,9 +13,12 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "api/task_queue/queued_task.h"
 #include "modules/include/module.h"
@@ -24,6 +27,7 @@
 #include "rtc_base/event.h"
 #include "rtc_base/location.h"
 #include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
 
 namespace webrtc {
@@ -51,8 +55,8 @@ class ProcessThreadImpl : public ProcessThread {
     ModuleCallback() = delete;
     ModuleCallback(ModuleCallback&& cb) = default;
     ModuleCallback(const ModuleCallback& cb) = default;
-    ModuleCallback(Module* module, const rtc::Location& location)
-        : module(module), location(location) {}
+    ModuleCallback(Module* module, const rtc::Location& location, uint64_t id)
+        : module(module), location(location), id(id) {}
     bool operator==(const ModuleCallback& cb) const {
       return cb.module == module;
     }
@@ -60,6 +64,13 @@ class ProcessThreadImpl : public ProcessThread {
     Module* const module;
     int64_t next_callback = 0;  // Absolute timestamp.
     const rtc::Location location;
+    // Unique per registration, so that a module that is deregistered and
+    // registered again does not match schedule entries of its earlier
+    // registration.
+    const uint64_t id;
+    // Bumped every time the module is pushed to |schedule_|; only the entry
+    // with the latest generation is live.
+    uint64_t schedule_generation = 0;
 
    private:
     ModuleCallback& operator=(ModuleCallback&);
@@ -67,6 +78,27 @@ class ProcessThreadImpl : public ProcessThread {
 
   typedef std::list<ModuleCallback> ModuleList;
 
+  // An entry in |schedule_|. Entries are never updated in place; when a
+  // module is rescheduled a new entry is pushed, and older entries are
+  // dropped as they are popped.
+  struct ScheduledModule {
+    int64_t next_callback;
+    Module* module;
+    uint64_t id;
+    uint64_t generation;
+
+    bool operator>(const ScheduledModule& other) const {
+      return next_callback > other.next_callback;
+    }
+  };
+
+  // Returns the registration |entry| refers to, or null if it is stale.
+  ModuleCallback* FindScheduled(const ScheduledModule& entry)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void Schedule(ModuleCallback* m) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Drops the stale entries once they outnumber the modules.
+  void MaybeCompactSchedule() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Warning: For some reason, if |lock_| comes immediately before |modules_|
   // with the current class layout, we will  start to have mysterious crashes
   // on Mac 10.9 debug.  I (Tommi) suspect we're hitting some obscure alignemnt
@@ -81,6 +113,14 @@ class ProcessThreadImpl : public ProcessThread {
   std::unique_ptr<rtc::PlatformThread> thread_;
 
   ModuleList modules_;
+  std::unordered_map<Module*, ModuleList::iterator> module_index_;
+  // Min-heap of modules by next callback time, so that Process() only
+  // touches the modules that are due.
+  std::priority_queue<ScheduledModule,
+                      std::vector<ScheduledModule>,
+                      std::greater<ScheduledModule>>
+      schedule_;
+  uint64_t next_module_id_ = 0;
   std::queue<QueuedTask*> queue_;
   bool stop_;
   const char* thread_name_;
@@ -298,6 +298,35 @@ TEST(ProcessThreadImpl, WakeUp) {
   EXPECT_LE(diff, 100u);
 }
 
+// Verifies that a module that is not due is neither processed nor queried
+// again while another module is processed repeatedly.
+TEST(ProcessThreadImpl, OnlyQueriesDueModules) {
+  ProcessThreadImpl thread("ProcessThread");
+  rtc::Event event;
+
+  MockModule busy_module;
+  int busy_process_count = 0;
+  EXPECT_CALL(busy_module, TimeUntilNextProcess()).WillRepeatedly(Return(1));
+  EXPECT_CALL(busy_module, Process())
+      .WillRepeatedly(DoAll(Increment(&busy_process_count), Invoke([&] {
+                              if (busy_process_count == 10)
+                                event.Set();
+                            })));
+  EXPECT_CALL(busy_module, ProcessThreadAttached(_)).Times(2);
+
+  MockModule idle_module;
+  EXPECT_CALL(idle_module, TimeUntilNextProcess())
+      .WillOnce(Return(60 * 1000));
+  EXPECT_CALL(idle_module, Process()).Times(0);
+  EXPECT_CALL(idle_module, ProcessThreadAttached(_)).Times(2);
+
+  thread.RegisterModule(&idle_module, RTC_FROM_HERE);
+  thread.RegisterModule(&busy_module, RTC_FROM_HERE);
+  thread.Start();
+  EXPECT_TRUE(event.Wait(kEventWaitTimeout));
+  thread.Stop();
+}
+
 // Tests that we can post a task that gets run straight away on the worker
 // thread.
 TEST(ProcessThreadImpl, PostTask) {
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/include/statistics_snapshot.h"
+
+#include <atomic>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint64_t kNumPublishedValues = 100000;
+
+struct TestStatistics {
+  uint64_t a = 0;
+  uint64_t b = 0;
+  int32_t c = 0;
+  bool d = false;
+};
+
+struct PublisherState {
+  StatisticsSnapshot<TestStatistics> snapshot;
+  std::atomic<bool> done{false};
+};
+
+void Publish(void* obj) {
+  PublisherState* state = static_cast<PublisherState*>(obj);
+  for (uint64_t n = 1; n <= kNumPublishedValues; ++n) {
+    TestStatistics stats;
+    stats.a = n;
+    stats.b = 2 * n;
+    stats.c = static_cast<int32_t>(n);
+    stats.d = n % 2 == 1;
+    state->snapshot.Publish(stats);
+  }
+  state->done.store(true);
+}
+
+}  // namespace
+
+TEST(StatisticsSnapshot, ReadsDefaultBeforeFirstPublish) {
+  StatisticsSnapshot<TestStatistics> snapshot;
+  const TestStatistics stats = snapshot.Read();
+  EXPECT_EQ(0u, stats.a);
+  EXPECT_EQ(0, stats.c);
+  EXPECT_FALSE(stats.d);
+}
+
+TEST(StatisticsSnapshot, ReadsLastPublishedValue) {
+  StatisticsSnapshot<TestStatistics> snapshot;
+  TestStatistics stats;
+  stats.a = 17;
+  stats.c = -3;
+  stats.d = true;
+  snapshot.Publish(stats);
+  stats.a = 18;
+  snapshot.Publish(stats);
+
+  const TestStatistics read = snapshot.Read();
+  EXPECT_EQ(18u, read.a);
+  EXPECT_EQ(-3, read.c);
+  EXPECT_TRUE(read.d);
+}
+
+// Reads while another thread publishes, and checks that no read mixes the
+// fields of different published values.
+TEST(StatisticsSnapshot, ReadsAreConsistentWhilePublishing) {
+  PublisherState state;
+  rtc::PlatformThread publisher(&Publish, &state, "publisher");
+  publisher.Start();
+  uint64_t last_a = 0;
+  bool consistent = true;
+  while (consistent && !state.done.load()) {
+    const TestStatistics stats = state.snapshot.Read();
+    consistent = stats.b == 2 * stats.a &&
+                 stats.c == static_cast<int32_t>(stats.a) &&
+                 stats.d == (stats.a % 2 == 1) && stats.a >= last_a;
+    last_a = stats.a;
+  }
+  publisher.Stop();
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(kNumPublishedValues, state.snapshot.Read().a);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/include/task_thread.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+TaskThread::TaskThread(const char* thread_name, rtc::ThreadPriority priority)
+    : thread_(&TaskThread::Run, this, thread_name, priority) {
+  thread_.Start();
+}
+
+TaskThread::~TaskThread() {
+  {
+    rtc::CritScope lock(&crit_);
+    stop_ = true;
+  }
+  task_ready_.Set();
+  thread_.Stop();
+}
+
+void TaskThread::StartTask(rtc::FunctionView<void()> task) {
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(!has_task_);
+    task_ = task;
+    has_task_ = true;
+  }
+  task_ready_.Set();
+}
+
+void TaskThread::Wait() {
+  task_done_.Wait(rtc::Event::kForever);
+}
+
+// static
+void TaskThread::Run(void* obj) {
+  TaskThread* thread = static_cast<TaskThread*>(obj);
+  while (thread->Process()) {
+  }
+}
+
+bool TaskThread::Process() {
+  task_ready_.Wait(rtc::Event::kForever);
+  rtc::FunctionView<void()> task;
+  {
+    rtc::CritScope lock(&crit_);
+    if (stop_)
+      return false;
+    if (!has_task_)
+      return true;
+    task = task_;
+    has_task_ = false;
+  }
+
+  task();
+  task_done_.Set();
+  return true;
+}
+
+}  // namespace webrtc
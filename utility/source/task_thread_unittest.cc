@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/utility/include/task_thread.h"
+
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread_types.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TaskThreadTest, RunsTaskOnOtherThread) {
+  TaskThread thread("TaskThreadTest", rtc::kNormalPriority);
+  rtc::PlatformThreadRef task_thread_ref = rtc::CurrentThreadRef();
+  const auto task = [&task_thread_ref] {
+    task_thread_ref = rtc::CurrentThreadRef();
+  };
+  thread.StartTask(task);
+  thread.Wait();
+  EXPECT_FALSE(rtc::IsThreadRefEqual(task_thread_ref, rtc::CurrentThreadRef()));
+}
+
+TEST(TaskThreadTest, WaitReturnsAfterEachTask) {
+  TaskThread thread("TaskThreadTest", rtc::kNormalPriority);
+  std::vector<int> values;
+  for (int i = 0; i < 100; ++i) {
+    const auto task = [&values, i] { values.push_back(i); };
+    thread.StartTask(task);
+    thread.Wait();
+    ASSERT_EQ(static_cast<size_t>(i + 1), values.size());
+    EXPECT_EQ(i, values.back());
+  }
+}
+
+TEST(TaskThreadTest, TasksRunInParallelWithCaller) {
+  TaskThread thread("TaskThreadTest", rtc::kNormalPriority);
+  rtc::Event task_started;
+  rtc::Event caller_done;
+  bool caller_done_seen = false;
+  const auto task = [&] {
+    task_started.Set();
+    caller_done_seen = caller_done.Wait(rtc::Event::kForever);
+  };
+  thread.StartTask(task);
+  // The task blocks until the caller signals it, so both run at once.
+  EXPECT_TRUE(task_started.Wait(rtc::Event::kForever));
+  caller_done.Set();
+  thread.Wait();
+  EXPECT_TRUE(caller_done_seen);
+}
+
+TEST(TaskThreadTest, DestroysWithoutTask) {
+  TaskThread thread("TaskThreadTest", rtc::kNormalPriority);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,252 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+namespace {
+
+bool IsMultiPlanar(uint32_t buffer_type) {
+  return buffer_type == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+}
+
+// Prepares |buffer| for an ioctl on the buffer at |index|. With the
+// multi-planar API, |planes| receives the plane information and must hold
+// VIDEO_MAX_PLANES planes.
+void InitBuffer(uint32_t buffer_type,
+                int index,
+                struct v4l2_plane* planes,
+                struct v4l2_buffer* buffer) {
+  memset(buffer, 0, sizeof(struct v4l2_buffer));
+  buffer->type = buffer_type;
+  buffer->memory = V4L2_MEMORY_MMAP;
+  buffer->index = index;
+  if (IsMultiPlanar(buffer_type)) {
+    memset(planes, 0, VIDEO_MAX_PLANES * sizeof(struct v4l2_plane));
+    buffer->m.planes = planes;
+    buffer->length = VIDEO_MAX_PLANES;
+  }
+}
+
+}  // namespace
+
+V4L2BufferPool::V4L2BufferPool()
+    : device_fd_(-1),
+      buffer_type_(V4L2_BUF_TYPE_VIDEO_CAPTURE),
+      streaming_(false),
+      num_queued_(0) {}
+
+V4L2BufferPool::~V4L2BufferPool() {
+  for (const Buffer& buffer : buffers_) {
+    if (buffer.dmabuf_fd != -1)
+      close(buffer.dmabuf_fd);
+    munmap(buffer.start, buffer.length);
+  }
+}
+
+bool V4L2BufferPool::Allocate(int device_fd,
+                              uint32_t buffer_type,
+                              int count,
+                              bool export_dmabuf) {
+  RTC_DCHECK(buffers_.empty());
+  device_fd_ = device_fd;
+  buffer_type_ = buffer_type;
+
+  struct v4l2_requestbuffers rbuffer;
+  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
+  rbuffer.type = buffer_type_;
+  rbuffer.memory = V4L2_MEMORY_MMAP;
+  rbuffer.count = count;
+
+  if (ioctl(device_fd_, VIDIOC_REQBUFS, &rbuffer) < 0) {
+    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
+    return false;
+  }
+
+  if (rbuffer.count > static_cast<unsigned int>(count))
+    rbuffer.count = count;
+
+  rtc::CritScope cs(&crit_);
+  streaming_ = true;
+  for (unsigned int i = 0; i < rbuffer.count; i++) {
+    struct v4l2_plane planes[VIDEO_MAX_PLANES];
+    struct v4l2_buffer buffer;
+    InitBuffer(buffer_type_, i, planes, &buffer);
+
+    if (ioctl(device_fd_, VIDIOC_QUERYBUF, &buffer) < 0) {
+      return false;
+    }
+
+    size_t length = buffer.length;
+    off_t offset = buffer.m.offset;
+    if (IsMultiPlanar(buffer_type_)) {
+      if (buffer.length != 1) {
+        RTC_LOG(LS_INFO) << "Formats with " << buffer.length
+                         << " memory planes are not supported.";
+        return false;
+      }
+      length = planes[0].length;
+      offset = planes[0].m.mem_offset;
+    }
+
+    void* start = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       device_fd_, offset);
+    if (MAP_FAILED == start) {
+      return false;
+    }
+    buffers_.push_back({static_cast<uint8_t*>(start), length, -1});
+
+    if (export_dmabuf) {
+      struct v4l2_exportbuffer expbuf;
+      memset(&expbuf, 0, sizeof(v4l2_exportbuffer));
+      expbuf.type = buffer_type_;
+      expbuf.index = i;
+      expbuf.flags = O_CLOEXEC | O_RDONLY;
+      if (ioctl(device_fd_, VIDIOC_EXPBUF, &expbuf) == 0) {
+        buffers_.back().dmabuf_fd = expbuf.fd;
+      } else {
+        RTC_LOG(LS_INFO) << "Could not export buffer " << i
+                         << " as DMA-BUF. errno = " << errno;
+      }
+    }
+
+    if (ioctl(device_fd_, VIDIOC_QBUF, &buffer) < 0) {
+      return false;
+    }
+    ++num_queued_;
+  }
+  return true;
+}
+
+bool V4L2BufferPool::Dequeue(DequeuedBuffer* dequeued) {
+  struct v4l2_plane planes[VIDEO_MAX_PLANES];
+  struct v4l2_buffer buffer;
+  InitBuffer(buffer_type_, 0, planes, &buffer);
+  // dequeue a buffer - repeat until dequeued properly!
+  while (ioctl(device_fd_, VIDIOC_DQBUF, &buffer) < 0) {
+    if (errno == EAGAIN) {
+      // No more filled buffers.
+      return false;
+    }
+    if (errno != EINTR) {
+      RTC_LOG(LS_INFO) << "could not sync on a buffer on device "
+                       << strerror(errno);
+      return false;
+    }
+  }
+  {
+    rtc::CritScope cs(&crit_);
+    --num_queued_;
+  }
+  dequeued->index = buffer.index;
+  dequeued->bytes_used =
+      IsMultiPlanar(buffer_type_) ? planes[0].bytesused : buffer.bytesused;
+  dequeued->timestamp_us = -1;
+  if ((buffer.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) ==
+      V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+    dequeued->timestamp_us =
+        static_cast<int64_t>(buffer.timestamp.tv_sec) * 1000000 +
+        buffer.timestamp.tv_usec;
+  }
+  return true;
+}
+
+void V4L2BufferPool::Queue(int index) {
+  RTC_DCHECK_GE(index, 0);
+  RTC_DCHECK_LT(index, num_buffers());
+  rtc::CritScope cs(&crit_);
+  if (!streaming_)
+    return;
+  struct v4l2_plane planes[VIDEO_MAX_PLANES];
+  struct v4l2_buffer buffer;
+  InitBuffer(buffer_type_, index, planes, &buffer);
+  if (IsMultiPlanar(buffer_type_))
+    buffer.length = 1;
+  if (ioctl(device_fd_, VIDIOC_QBUF, &buffer) == -1) {
+    RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+    return;
+  }
+  ++num_queued_;
+}
+
+void V4L2BufferPool::Stop() {
+  rtc::CritScope cs(&crit_);
+  streaming_ = false;
+}
+
+int V4L2BufferPool::num_queued() const {
+  rtc::CritScope cs(&crit_);
+  return num_queued_;
+}
+
+V4L2FrameBuffer::V4L2FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                                 int index,
+                                 size_t size,
+                                 VideoType video_type,
+                                 int width,
+                                 int height)
+    : pool_(std::move(pool)),
+      index_(index),
+      size_(size),
+      video_type_(video_type),
+      width_(width),
+      height_(height) {}
+
+V4L2FrameBuffer::~V4L2FrameBuffer() {
+  pool_->Queue(index_);
+}
+
+VideoFrameBuffer::Type V4L2FrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int V4L2FrameBuffer::width() const {
+  return width_;
+}
+
+int V4L2FrameBuffer::height() const {
+  return height_;
+}
+
+rtc::scoped_refptr<I420BufferInterface> V4L2FrameBuffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+  const int conversion_result = libyuv::ConvertToI420(
+      data(), size_, buffer->MutableDataY(), buffer->StrideY(),
+      buffer->MutableDataU(), buffer->StrideU(), buffer->MutableDataV(),
+      buffer->StrideV(), 0, 0,  // No Cropping
+      width_, height_, width_, height_, libyuv::kRotate0,
+      ConvertVideoType(video_type_));
+  if (conversion_result < 0) {
+    RTC_LOG(LS_ERROR) << "Failed to convert capture frame from type "
+                      << static_cast<int>(video_type_) << " to I420.";
+    return nullptr;
+  }
+  return buffer;
+}
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
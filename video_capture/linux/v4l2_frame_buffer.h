@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// The memory mapped buffers of a V4L2 capture device. The pool is reference
+// counted so that frames wrapping its buffers keep the mappings alive after
+// capture has stopped. A buffer handed out in a frame is queued back to the
+// driver when the frame is released, unless capture has stopped by then.
+class V4L2BufferPool : public rtc::RefCountInterface {
+ public:
+  struct DequeuedBuffer {
+    int index;
+    size_t bytes_used;
+    // The time the driver captured the frame, on the rtc::TimeMicros() clock,
+    // or -1 if the driver does not use monotonic timestamps.
+    int64_t timestamp_us;
+  };
+
+  V4L2BufferPool();
+
+  // Requests up to |count| buffers of |buffer_type| from |device_fd|, maps
+  // them and queues them to the driver. |buffer_type| is either
+  // V4L2_BUF_TYPE_VIDEO_CAPTURE or V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE; only
+  // formats with a single memory plane are supported. If |export_dmabuf| is
+  // true, each buffer is also exported as a DMA-BUF; a buffer whose export
+  // fails has dmabuf_fd() -1.
+  bool Allocate(int device_fd,
+                uint32_t buffer_type,
+                int count,
+                bool export_dmabuf);
+
+  // Dequeues a filled buffer from the driver. Returns false if there is no
+  // buffer to dequeue.
+  bool Dequeue(DequeuedBuffer* buffer);
+  // Queues the buffer at |index| back to the driver, if still capturing.
+  void Queue(int index);
+  // Called before the device stops streaming. Buffers released after this
+  // are not queued again.
+  void Stop();
+
+  int num_buffers() const { return static_cast<int>(buffers_.size()); }
+  int num_queued() const;
+  uint8_t* data(int index) const { return buffers_[index].start; }
+  size_t length(int index) const { return buffers_[index].length; }
+  int dmabuf_fd(int index) const { return buffers_[index].dmabuf_fd; }
+
+ protected:
+  ~V4L2BufferPool() override;
+
+ private:
+  struct Buffer {
+    uint8_t* start;
+    size_t length;
+    int dmabuf_fd;
+  };
+
+  // Written only by Allocate(), before any buffer is handed out.
+  std::vector<Buffer> buffers_;
+  int device_fd_;
+  uint32_t buffer_type_;
+  rtc::CriticalSection crit_;
+  bool streaming_ RTC_GUARDED_BY(crit_);
+  int num_queued_ RTC_GUARDED_BY(crit_);
+};
+
+// A captured frame in the native format of the device, wrapping a buffer of a
+// V4L2BufferPool without copying it. Hardware encoders can use the mapped
+// data or the DMA-BUF directly; everything else gets an I420 conversion from
+// ToI420().
+class V4L2FrameBuffer : public VideoFrameBuffer {
+ public:
+  V4L2FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                  int index,
+                  size_t size,
+                  VideoType video_type,
+                  int width,
+                  int height);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  // The format of data(), e.g. kNV12 or kMJPEG.
+  VideoType video_type() const { return video_type_; }
+  const uint8_t* data() const { return pool_->data(index_); }
+  size_t size() const { return size_; }
+  // The DMA-BUF of the buffer, or -1 if it was not exported.
+  int dmabuf_fd() const { return pool_->dmabuf_fd(index_); }
+
+ protected:
+  ~V4L2FrameBuffer() override;
+
+ private:
+  const rtc::scoped_refptr<V4L2BufferPool> pool_;
+  const int index_;
+  const size_t size_;
+  const VideoType video_type_;
+  const int width_;
+  const int height_;
+};
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
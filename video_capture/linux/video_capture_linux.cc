@@ -16,8 +16,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/mman.h>
-#include <sys/select.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -27,11 +28,24 @@
 #include "api/scoped_refptr.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+
+// The capture thread checks for |quit_| at least this often.
+constexpr int kCaptureTimeoutMs = 1000;
+
+}  // namespace
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   rtc::scoped_refptr<VideoCaptureModuleV4L2> implementation(
@@ -45,15 +59,31 @@ rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
 
 VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
     : VideoCaptureImpl(),
+      quit_(false),
       _deviceId(-1),
       _deviceFd(-1),
+      _epollFd(-1),
+      _wakeupFd(-1),
+      _bufferType(V4L2_BUF_TYPE_VIDEO_CAPTURE),
+      _numBuffers(NumberOfBuffers()),
       _buffersAllocatedByDevice(-1),
       _currentWidth(-1),
       _currentHeight(-1),
       _currentFrameRate(-1),
       _captureStarted(false),
       _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      _zeroCopy(field_trial::IsEnabled("WebRTC-VideoCaptureV4L2ZeroCopy")) {}
+
+int VideoCaptureModuleV4L2::NumberOfBuffers() {
+  FieldTrialParameter<int> buffers(
+      "buffers", field_trial::IsEnabled("WebRTC-VideoCaptureV4L2ZeroCopy")
+                     ? kNoOfV4L2ZeroCopyBuffers
+                     : kNoOfV4L2Bufffers);
+  ParseFieldTrial({&buffers},
+                  field_trial::FindFullName("WebRTC-VideoCaptureV4L2Buffers"));
+  return rtc::SafeClamp<int>(buffers.Get(), kMinNoOfV4L2Buffers,
+                             kMaxNoOfV4L2Buffers);
+}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -125,31 +155,59 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
     return -1;
   }
 
+  // Use the multi-planar API only for devices that don't support the
+  // single-planar one, e.g. many CSI camera interfaces.
+  struct v4l2_capability cap;
+  memset(&cap, 0, sizeof(cap));
+  if (ioctl(_deviceFd, VIDIOC_QUERYCAP, &cap) < 0) {
+    RTC_LOG(LS_INFO) << "error in VIDIOC_QUERYCAP, errno = " << errno;
+    return -1;
+  }
+  const uint32_t device_caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS)
+                                   ? cap.device_caps
+                                   : cap.capabilities;
+  if (device_caps & V4L2_CAP_VIDEO_CAPTURE) {
+    _bufferType = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  } else if (device_caps & V4L2_CAP_VIDEO_CAPTURE_MPLANE) {
+    _bufferType = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  } else {
+    RTC_LOG(LS_INFO) << "device does not support video capture";
+    return -1;
+  }
+  const bool multi_planar = _bufferType == V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+
   // Supported video formats in preferred order.
   // If the requested resolution is larger than VGA, we prefer MJPEG. Go for
-  // I420 otherwise.
-  const int nFormats = 5;
+  // I420 otherwise. With zero-copy capture, NV12 is preferred since it can be
+  // passed to encoders without conversion.
+  const int nFormats = 6;
   unsigned int fmts[nFormats];
+  int numFmts = 0;
+  if (_zeroCopy)
+    fmts[numFmts++] = V4L2_PIX_FMT_NV12;
   if (capability.width > 640 || capability.height > 480) {
-    fmts[0] = V4L2_PIX_FMT_MJPEG;
-    fmts[1] = V4L2_PIX_FMT_YUV420;
-    fmts[2] = V4L2_PIX_FMT_YUYV;
-    fmts[3] = V4L2_PIX_FMT_UYVY;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts[numFmts++] = V4L2_PIX_FMT_MJPEG;
+    fmts[numFmts++] = V4L2_PIX_FMT_YUV420;
+    fmts[numFmts++] = V4L2_PIX_FMT_YUYV;
+    fmts[numFmts++] = V4L2_PIX_FMT_UYVY;
+    fmts[numFmts++] = V4L2_PIX_FMT_JPEG;
   } else {
-    fmts[0] = V4L2_PIX_FMT_YUV420;
-    fmts[1] = V4L2_PIX_FMT_YUYV;
-    fmts[2] = V4L2_PIX_FMT_UYVY;
-    fmts[3] = V4L2_PIX_FMT_MJPEG;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts[numFmts++] = V4L2_PIX_FMT_YUV420;
+    fmts[numFmts++] = V4L2_PIX_FMT_YUYV;
+    fmts[numFmts++] = V4L2_PIX_FMT_UYVY;
+    fmts[numFmts++] = V4L2_PIX_FMT_MJPEG;
+    fmts[numFmts++] = V4L2_PIX_FMT_JPEG;
   }
+  if (!_zeroCopy)
+    fmts[numFmts++] = V4L2_PIX_FMT_NV12;
+  RTC_DCHECK_EQ(numFmts, nFormats);
 
   // Enumerate image formats.
   struct v4l2_fmtdesc fmt;
   int fmtsIdx = nFormats;
   memset(&fmt, 0, sizeof(fmt));
   fmt.index = 0;
-  fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  fmt.type = _bufferType;
   RTC_LOG(LS_INFO) << "Video Capture enumerats supported image formats:";
   while (ioctl(_deviceFd, VIDIOC_ENUM_FMT, &fmt) == 0) {
     RTC_LOG(LS_INFO) << "  { pixelformat = "
@@ -174,20 +232,30 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
 
   struct v4l2_format video_fmt;
   memset(&video_fmt, 0, sizeof(struct v4l2_format));
-  video_fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-  video_fmt.fmt.pix.sizeimage = 0;
-  video_fmt.fmt.pix.width = capability.width;
-  video_fmt.fmt.pix.height = capability.height;
-  video_fmt.fmt.pix.pixelformat = fmts[fmtsIdx];
+  video_fmt.type = _bufferType;
+  const unsigned int pixelformat = fmts[fmtsIdx];
+  if (multi_planar) {
+    video_fmt.fmt.pix_mp.width = capability.width;
+    video_fmt.fmt.pix_mp.height = capability.height;
+    video_fmt.fmt.pix_mp.pixelformat = pixelformat;
+    video_fmt.fmt.pix_mp.num_planes = 1;
+  } else {
+    video_fmt.fmt.pix.sizeimage = 0;
+    video_fmt.fmt.pix.width = capability.width;
+    video_fmt.fmt.pix.height = capability.height;
+    video_fmt.fmt.pix.pixelformat = pixelformat;
+  }
 
-  if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_YUYV)
+  if (pixelformat == V4L2_PIX_FMT_YUYV)
     _captureVideoType = VideoType::kYUY2;
-  else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_YUV420)
+  else if (pixelformat == V4L2_PIX_FMT_YUV420)
     _captureVideoType = VideoType::kI420;
-  else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_UYVY)
+  else if (pixelformat == V4L2_PIX_FMT_UYVY)
     _captureVideoType = VideoType::kUYVY;
-  else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG ||
-           video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_JPEG)
+  else if (pixelformat == V4L2_PIX_FMT_NV12)
+    _captureVideoType = VideoType::kNV12;
+  else if (pixelformat == V4L2_PIX_FMT_MJPEG ||
+           pixelformat == V4L2_PIX_FMT_JPEG)
     _captureVideoType = VideoType::kMJPEG;
 
   // set format and frame size now
@@ -197,14 +265,24 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   }
 
   // initialize current width and height
-  _currentWidth = video_fmt.fmt.pix.width;
-  _currentHeight = video_fmt.fmt.pix.height;
+  if (multi_planar) {
+    if (video_fmt.fmt.pix_mp.num_planes != 1) {
+      RTC_LOG(LS_INFO) << "Formats with " << video_fmt.fmt.pix_mp.num_planes
+                       << " memory planes are not supported.";
+      return -1;
+    }
+    _currentWidth = video_fmt.fmt.pix_mp.width;
+    _currentHeight = video_fmt.fmt.pix_mp.height;
+  } else {
+    _currentWidth = video_fmt.fmt.pix.width;
+    _currentHeight = video_fmt.fmt.pix.height;
+  }
 
   // Trying to set frame rate, before check driver capability.
   bool driver_framerate_support = true;
   struct v4l2_streamparm streamparms;
   memset(&streamparms, 0, sizeof(streamparms));
-  streamparms.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  streamparms.type = _bufferType;
   if (ioctl(_deviceFd, VIDIOC_G_PARM, &streamparms) < 0) {
     RTC_LOG(LS_INFO) << "error in VIDIOC_G_PARM errno = " << errno;
     driver_framerate_support = false;
@@ -214,7 +292,7 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
     if (streamparms.parm.capture.capability & V4L2_CAP_TIMEPERFRAME) {
       // driver supports the feature. Set required framerate.
       memset(&streamparms, 0, sizeof(streamparms));
-      streamparms.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      streamparms.type = _bufferType;
       streamparms.parm.capture.timeperframe.numerator = 1;
       streamparms.parm.capture.timeperframe.denominator = capability.maxFPS;
       if (ioctl(_deviceFd, VIDIOC_S_PARM, &streamparms) < 0) {
@@ -242,6 +320,10 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
 
   // start capture thread;
   if (!_captureThread) {
+    if (!CreatePollFds()) {
+      RTC_LOG(LS_INFO) << "failed to set up polling of the capture device";
+      return -1;
+    }
     quit_ = false;
     _captureThread.reset(
         new rtc::PlatformThread(VideoCaptureModuleV4L2::CaptureThread, this,
@@ -251,7 +333,7 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
 
   // Needed to start UVC camera - from the uvcview application
   enum v4l2_buf_type type;
-  type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  type = static_cast<enum v4l2_buf_type>(_bufferType);
   if (ioctl(_deviceFd, VIDIOC_STREAMON, &type) == -1) {
     RTC_LOG(LS_INFO) << "Failed to turn on stream";
     return -1;
@@ -263,13 +345,16 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
 
 int32_t VideoCaptureModuleV4L2::StopCapture() {
   if (_captureThread) {
-    {
-      rtc::CritScope cs(&_captureCritSect);
-      quit_ = true;
+    quit_ = true;
+    // Wake the capture thread up so that it doesn't wait for the next frame.
+    const uint64_t wakeup = 1;
+    if (write(_wakeupFd, &wakeup, sizeof(wakeup)) < 0) {
+      RTC_LOG(LS_INFO) << "Failed to wake up the capture thread. errno = "
+                       << errno;
     }
-    // Make sure the capture thread stop stop using the critsect.
     _captureThread->Stop();
     _captureThread.reset();
+    ClosePollFds();
   }
 
   rtc::CritScope cs(&_captureCritSect);
@@ -287,65 +372,26 @@ int32_t VideoCaptureModuleV4L2::StopCapture() {
 // critical section protected by the caller
 
 bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
-  struct v4l2_requestbuffers rbuffer;
-  memset(&rbuffer, 0, sizeof(v4l2_requestbuffers));
-
-  rbuffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-  rbuffer.memory = V4L2_MEMORY_MMAP;
-  rbuffer.count = kNoOfV4L2Bufffers;
-
-  if (ioctl(_deviceFd, VIDIOC_REQBUFS, &rbuffer) < 0) {
-    RTC_LOG(LS_INFO) << "Could not get buffers from device. errno = " << errno;
+  _bufferPool = new rtc::RefCountedObject<V4L2BufferPool>();
+  if (!_bufferPool->Allocate(_deviceFd, _bufferType, _numBuffers,
+                            _zeroCopy)) {
+    _bufferPool = nullptr;
     return false;
   }
-
-  if (rbuffer.count > kNoOfV4L2Bufffers)
-    rbuffer.count = kNoOfV4L2Bufffers;
-
-  _buffersAllocatedByDevice = rbuffer.count;
-
-  // Map the buffers
-  _pool = new Buffer[rbuffer.count];
-
-  for (unsigned int i = 0; i < rbuffer.count; i++) {
-    struct v4l2_buffer buffer;
-    memset(&buffer, 0, sizeof(v4l2_buffer));
-    buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buffer.memory = V4L2_MEMORY_MMAP;
-    buffer.index = i;
-
-    if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
-      return false;
-    }
-
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
-
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
-      return false;
-    }
-
-    _pool[i].length = buffer.length;
-
-    if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
-      return false;
-    }
-  }
+  _buffersAllocatedByDevice = _bufferPool->num_buffers();
   return true;
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // Frames still holding buffers keep the pool, and with it the mappings,
+  // alive. Their buffers are not queued again.
+  if (_bufferPool)
+    _bufferPool->Stop();
+  _bufferPool = nullptr;
 
   // turn off stream
   enum v4l2_buf_type type;
-  type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  type = static_cast<enum v4l2_buf_type>(_bufferType);
   if (ioctl(_deviceFd, VIDIOC_STREAMOFF, &type) < 0) {
     RTC_LOG(LS_INFO) << "VIDIOC_STREAMOFF error. errno: " << errno;
   }
@@ -362,66 +408,94 @@ void VideoCaptureModuleV4L2::CaptureThread(void* obj) {
   while (capture->CaptureProcess()) {
   }
 }
-bool VideoCaptureModuleV4L2::CaptureProcess() {
-  int retVal = 0;
-  fd_set rSet;
-  struct timeval timeout;
-
-  FD_ZERO(&rSet);
-  FD_SET(_deviceFd, &rSet);
-  timeout.tv_sec = 1;
-  timeout.tv_usec = 0;
-
-  // _deviceFd written only in StartCapture, when this thread isn't running.
-  retVal = select(_deviceFd + 1, &rSet, NULL, NULL, &timeout);
-  if (retVal < 0 && errno != EINTR)  // continue if interrupted
-  {
-    // select failed
+bool VideoCaptureModuleV4L2::CreatePollFds() {
+  _wakeupFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  _epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (_wakeupFd < 0 || _epollFd < 0) {
+    ClosePollFds();
+    return false;
+  }
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.fd = _deviceFd;
+  if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, _deviceFd, &event) < 0) {
+    ClosePollFds();
     return false;
-  } else if (retVal == 0) {
-    // select timed out
-    return true;
-  } else if (!FD_ISSET(_deviceFd, &rSet)) {
-    // not event on camera handle
-    return true;
   }
+  event.data.fd = _wakeupFd;
+  if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, _wakeupFd, &event) < 0) {
+    ClosePollFds();
+    return false;
+  }
+  return true;
+}
 
-  {
-    rtc::CritScope cs(&_captureCritSect);
+void VideoCaptureModuleV4L2::ClosePollFds() {
+  if (_epollFd != -1)
+    close(_epollFd);
+  if (_wakeupFd != -1)
+    close(_wakeupFd);
+  _epollFd = -1;
+  _wakeupFd = -1;
+}
 
-    if (quit_) {
-      return false;
+bool VideoCaptureModuleV4L2::CaptureProcess() {
+  // |_deviceFd|, |_epollFd| and |_bufferPool| are written only in
+  // StartCapture() and StopCapture(), when this thread isn't running.
+  struct epoll_event events[2];
+  int num_events = epoll_wait(_epollFd, events, 2, kCaptureTimeoutMs);
+  if (num_events < 0 && errno != EINTR) {
+    // epoll failed
+    return false;
+  }
+  if (quit_) {
+    return false;
+  }
+  for (int i = 0; i < num_events; ++i) {
+    if (events[i].data.fd != _deviceFd)
+      continue;
+    if (events[i].events & EPOLLIN)
+      return DeliverFrames();
+    if (events[i].events & EPOLLERR) {
+      // The driver reports an error while it has no buffers queued, e.g.
+      // before streaming has been turned on. Back off instead of spinning.
+      usleep(1000);
+      return true;
     }
+  }
+  return true;
+}
 
-    if (_captureStarted) {
-      struct v4l2_buffer buf;
-      memset(&buf, 0, sizeof(struct v4l2_buffer));
-      buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-      buf.memory = V4L2_MEMORY_MMAP;
-      // dequeue a buffer - repeat until dequeued properly!
-      while (ioctl(_deviceFd, VIDIOC_DQBUF, &buf) < 0) {
-        if (errno != EINTR) {
-          RTC_LOG(LS_INFO) << "could not sync on a buffer on device "
-                           << strerror(errno);
-          return true;
-        }
-      }
-      VideoCaptureCapability frameInfo;
-      frameInfo.width = _currentWidth;
-      frameInfo.height = _currentHeight;
-      frameInfo.videoType = _captureVideoType;
-
+bool VideoCaptureModuleV4L2::DeliverFrames() {
+  V4L2BufferPool::DequeuedBuffer buf;
+  // Deliver every filled buffer, so that a burst of frames doesn't need one
+  // wakeup per frame.
+  while (!quit_ && _bufferPool->Dequeue(&buf)) {
+    VideoCaptureCapability frameInfo;
+    frameInfo.width = _currentWidth;
+    frameInfo.height = _currentHeight;
+    frameInfo.videoType = _captureVideoType;
+
+    if (_zeroCopy && _bufferPool->num_queued() >= kMinQueuedV4L2Buffers) {
+      // The buffer is queued again when the frame is released.
+      IncomingVideoFrameBuffer(new rtc::RefCountedObject<V4L2FrameBuffer>(
+          _bufferPool, buf.index, buf.bytes_used, _captureVideoType,
+          _currentWidth, _currentHeight));
+    } else {
       // convert to to I420 if needed
-      IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                    frameInfo);
+      IncomingFrame(_bufferPool->data(buf.index), buf.bytes_used, frameInfo);
       // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
-      }
+      _bufferPool->Queue(buf.index);
+    }
+
+    if (buf.timestamp_us >= 0) {
+      RTC_HISTOGRAM_COUNTS_1000(
+          "WebRTC.Video.Capture.V4L2.CaptureToDeliveryLatencyMs",
+          static_cast<int>((rtc::TimeMicros() - buf.timestamp_us) / 1000));
     }
   }
-  usleep(0);
-  return true;
+  return !quit_;
 }
 
 int32_t VideoCaptureModuleV4L2::CaptureSettings(
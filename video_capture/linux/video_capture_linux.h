@@ -14,8 +14,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 
+#include "api/scoped_refptr.h"
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/critical_section.h"
@@ -35,18 +38,43 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // With zero-copy capture, frames hold on to device buffers until they are
+  // released, so more buffers are requested.
+  enum { kNoOfV4L2ZeroCopyBuffers = 8 };
+  // The number of buffers can be set with the "buffers" parameter of the
+  // WebRTC-VideoCaptureV4L2Buffers field trial, within these limits.
+  enum { kMinNoOfV4L2Buffers = 2 };
+  enum { kMaxNoOfV4L2Buffers = 32 };
+  // A frame is copied instead of wrapped if wrapping it would leave the driver
+  // with fewer queued buffers than this.
+  enum { kMinQueuedV4L2Buffers = 2 };
 
+  // Returns the number of buffers to request from the device.
+  static int NumberOfBuffers();
   static void CaptureThread(void*);
   bool CaptureProcess();
+  // Delivers all filled buffers. Returns false if capture should stop.
+  bool DeliverFrames();
   bool AllocateVideoBuffers();
   bool DeAllocateVideoBuffers();
+  bool CreatePollFds();
+  void ClosePollFds();
 
   // TODO(pbos): Stop using unique_ptr and resetting the thread.
   std::unique_ptr<rtc::PlatformThread> _captureThread;
   rtc::CriticalSection _captureCritSect;
-  bool quit_ RTC_GUARDED_BY(_captureCritSect);
+  // Read by the capture thread without taking the lock, so that it doesn't
+  // contend with the rest of the module for every frame.
+  std::atomic<bool> quit_;
   int32_t _deviceId;
   int32_t _deviceFd;
+  // The capture thread waits on |_epollFd| for frames from |_deviceFd| and
+  // for |_wakeupFd|, which is signalled by StopCapture().
+  int _epollFd;
+  int _wakeupFd;
+  // V4L2_BUF_TYPE_VIDEO_CAPTURE or V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE.
+  uint32_t _bufferType;
+  const int _numBuffers;
 
   int32_t _buffersAllocatedByDevice;
   int32_t _currentWidth;
@@ -54,11 +82,11 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  // Set by the WebRTC-VideoCaptureV4L2ZeroCopy field trial. Frames are then
+  // delivered as V4L2FrameBuffers in the native format of the device instead
+  // of being converted to I420.
+  const bool _zeroCopy;
+  rtc::scoped_refptr<V4L2BufferPool> _bufferPool;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
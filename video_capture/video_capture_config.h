@@ -27,6 +27,8 @@ enum {
 enum { kFrameRateCallbackInterval = 1000 };
 enum { kFrameRateCountHistorySize = 90 };
 enum { kFrameRateHistoryWindowMs = 2000 };
+// Max number of I420 buffers reused for converted frames.
+enum { kMaxBufferPoolSize = 30 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
 
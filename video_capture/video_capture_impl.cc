@@ -21,10 +21,16 @@
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 #include "third_party/libyuv/include/libyuv.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+const char kSendSideLatencyTracingFieldTrial[] =
+    "WebRTC-SendSideLatencyTracing";
+}  // namespace
 
 const char* VideoCaptureImpl::CurrentDeviceName() const {
   return _deviceUniqueId;
@@ -80,7 +86,10 @@ VideoCaptureImpl::VideoCaptureImpl()
       _dataCallBack(NULL),
       _lastProcessFrameTimeNanos(rtc::TimeNanos()),
       _rotateFrame(kVideoRotation_0),
-      apply_rotation_(false) {
+      apply_rotation_(false),
+      buffer_pool_(false, kMaxBufferPoolSize),
+      latency_tracing_(
+          field_trial::IsEnabled(kSendSideLatencyTracingFieldTrial)) {
   _requestedCapability.width = kDefaultWidth;
   _requestedCapability.height = kDefaultHeight;
   _requestedCapability.maxFPS = 30;
@@ -119,6 +128,7 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
                                         const VideoCaptureCapability& frameInfo,
                                         int64_t captureTime /*=0*/) {
   rtc::CritScope cs(&_apiCs);
+  const int64_t incoming_time_ms = latency_tracing_ ? rtc::TimeMillis() : 0;
 
   const int32_t width = frameInfo.width;
   const int32_t height = frameInfo.height;
@@ -154,9 +164,13 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   // In Windows, the image starts bottom left, instead of top left.
   // Setting a negative source height, inverts the image (within LibYuv).
 
-  // TODO(nisse): Use a pool?
-  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(
-      target_width, target_height, stride_y, stride_uv, stride_uv);
+  rtc::scoped_refptr<I420Buffer> buffer =
+      buffer_pool_.CreateBuffer(target_width, target_height);
+  if (!buffer) {
+    // All pooled buffers are still held by consumers.
+    buffer = I420Buffer::Create(target_width, target_height, stride_y,
+                                stride_uv, stride_uv);
+  }
 
   libyuv::RotationMode rotation_mode = libyuv::kRotate0;
   if (apply_rotation) {
@@ -198,6 +212,48 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
           .build();
   captureFrame.set_ntp_time_ms(captureTime);
 
+  // The timestamp set above is the capture time that later send side stages
+  // measure their latency against; report what the conversion added to it.
+  if (latency_tracing_) {
+    RTC_HISTOGRAM_COUNTS_1000(
+        "WebRTC.Video.SendSideLatency.CaptureConversionMs",
+        captureFrame.render_time_ms() - incoming_time_ms);
+  }
+
+  DeliverCapturedFrame(captureFrame);
+
+  return 0;
+}
+
+int32_t VideoCaptureImpl::IncomingVideoFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t captureTime /*=0*/) {
+  rtc::CritScope cs(&_apiCs);
+
+  TRACE_EVENT1("webrtc", "VC::IncomingVideoFrameBuffer", "capture_time",
+               captureTime);
+
+  // SetApplyRotation doesn't take any lock. Make a local copy here.
+  bool apply_rotation = apply_rotation_;
+
+  if (apply_rotation && _rotateFrame != kVideoRotation_0) {
+    rtc::scoped_refptr<I420BufferInterface> i420_buffer = buffer->ToI420();
+    if (!i420_buffer) {
+      RTC_LOG(LS_ERROR) << "Failed to convert capture frame to I420.";
+      return -1;
+    }
+    buffer = I420Buffer::Rotate(*i420_buffer, _rotateFrame);
+  }
+
+  VideoFrame captureFrame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(buffer)
+          .set_timestamp_rtp(0)
+          .set_timestamp_ms(rtc::TimeMillis())
+          .set_rotation(!apply_rotation ? _rotateFrame : kVideoRotation_0)
+          .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
   DeliverCapturedFrame(captureFrame);
 
   return 0;
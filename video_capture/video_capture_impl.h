@@ -20,8 +20,10 @@
 
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
+#include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_capture/video_capture.h"
 #include "modules/video_capture/video_capture_config.h"
 #include "modules/video_capture/video_capture_defines.h"
@@ -66,6 +68,11 @@ class VideoCaptureImpl : public VideoCaptureModule {
                         size_t videoFrameLength,
                         const VideoCaptureCapability& frameInfo,
                         int64_t captureTime = 0);
+  // Delivers |buffer| as is, e.g. a native buffer wrapping the memory of the
+  // capture device. The rotation is only applied to the pixels, by converting
+  // to I420, if rotation is applied and set to anything but 0 degrees.
+  int32_t IncomingVideoFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                                   int64_t captureTime = 0);
 
   // Platform dependent
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
@@ -102,6 +109,13 @@ class VideoCaptureImpl : public VideoCaptureModule {
 
   // Indicate whether rotation should be applied before delivered externally.
   bool apply_rotation_;
+
+  // Recycles the I420 buffers of converted frames once they are released.
+  I420BufferPool buffer_pool_ RTC_GUARDED_BY(_apiCs);
+
+  // Set by the WebRTC-SendSideLatencyTracing field trial. Reports the time
+  // spent converting each incoming frame to a histogram.
+  const bool latency_tracing_;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -10,7 +10,7 @@
 
 #include "modules/video_coding/codec_timer.h"
 
-#include <cstdint>
+#include <algorithm>
 
 namespace webrtc {
 
@@ -22,11 +22,19 @@ const int kIgnoredSampleCount = 5;
 const float kPercentile = 0.95f;
 // The window size in ms.
 const int64_t kTimeLimitMs = 10000;
+// The maximum number of samples kept within the window. Above ~100 decoded
+// frames per second the oldest samples are dropped before they expire.
+const size_t kMaxSampleCount = 1024;
 
 }  // anonymous namespace
 
 VCMCodecTimer::VCMCodecTimer()
-    : ignored_sample_count_(0), filter_(kPercentile) {}
+    : ignored_sample_count_(0),
+      history_(kMaxSampleCount, Sample(0, 0)),
+      history_start_(0),
+      history_size_(0) {
+  sorted_decode_times_ms_.reserve(kMaxSampleCount);
+}
 VCMCodecTimer::~VCMCodecTimer() = default;
 
 void VCMCodecTimer::AddTiming(int64_t decode_time_ms, int64_t now_ms) {
@@ -36,21 +44,40 @@ void VCMCodecTimer::AddTiming(int64_t decode_time_ms, int64_t now_ms) {
     return;
   }
 
-  // Insert new decode time value.
-  filter_.Insert(decode_time_ms);
-  history_.emplace(decode_time_ms, now_ms);
-
-  // Pop old decode time values.
-  while (!history_.empty() &&
-         now_ms - history_.front().sample_time_ms > kTimeLimitMs) {
-    filter_.Erase(history_.front().decode_time_ms);
-    history_.pop();
+  // Pop old decode time values, and make room for the new one.
+  while (history_size_ > 0 &&
+         now_ms - history_[history_start_].sample_time_ms > kTimeLimitMs) {
+    PopOldestSample();
   }
+  if (history_size_ == kMaxSampleCount)
+    PopOldestSample();
+
+  // Insert new decode time value.
+  history_[(history_start_ + history_size_) % kMaxSampleCount] =
+      Sample(decode_time_ms, now_ms);
+  ++history_size_;
+  sorted_decode_times_ms_.insert(
+      std::upper_bound(sorted_decode_times_ms_.begin(),
+                       sorted_decode_times_ms_.end(), decode_time_ms),
+      decode_time_ms);
 }
 
 // Get the 95th percentile observed decode time within a time window.
 int64_t VCMCodecTimer::RequiredDecodeTimeMs() const {
-  return filter_.GetPercentileValue();
+  if (sorted_decode_times_ms_.empty())
+    return 0;
+  const size_t index =
+      static_cast<size_t>(kPercentile * (sorted_decode_times_ms_.size() - 1));
+  return sorted_decode_times_ms_[index];
+}
+
+void VCMCodecTimer::PopOldestSample() {
+  const int64_t decode_time_ms = history_[history_start_].decode_time_ms;
+  sorted_decode_times_ms_.erase(
+      std::lower_bound(sorted_decode_times_ms_.begin(),
+                       sorted_decode_times_ms_.end(), decode_time_ms));
+  history_start_ = (history_start_ + 1) % kMaxSampleCount;
+  --history_size_;
 }
 
 VCMCodecTimer::Sample::Sample(int64_t decode_time_ms, int64_t sample_time_ms)
@@ -11,9 +11,10 @@
 #ifndef MODULES_VIDEO_CODING_CODEC_TIMER_H_
 #define MODULES_VIDEO_CODING_CODEC_TIMER_H_
 
-#include <queue>
+#include <stddef.h>
+#include <stdint.h>
 
-#include "rtc_base/numerics/percentile_filter.h"
+#include <vector>
 
 namespace webrtc {
 
@@ -36,13 +37,19 @@ class VCMCodecTimer {
     int64_t sample_time_ms;
   };
 
+  void PopOldestSample();
+
   // The number of samples ignored so far.
   int ignored_sample_count_;
-  // Queue with history of latest decode time values.
-  std::queue<Sample> history_;
-  // |filter_| contains the same values as |history_|, but in a data structure
-  // that allows efficient retrieval of the percentile value.
-  PercentileFilter<int64_t> filter_;
+  // Ring buffer with history of latest decode time values, oldest at
+  // |history_start_|. Allocated once in the constructor.
+  std::vector<Sample> history_;
+  size_t history_start_;
+  size_t history_size_;
+  // |sorted_decode_times_ms_| contains the same values as |history_|, kept
+  // sorted so that the percentile value can be read directly. Its capacity
+  // is reserved up front, so inserting and erasing never allocates.
+  std::vector<int64_t> sorted_decode_times_ms_;
 };
 
 }  // namespace webrtc
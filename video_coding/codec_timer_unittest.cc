@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codec_timer.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+const int kIgnoredSampleCount = 5;
+const int64_t kTimeLimitMs = 10000;
+}  // namespace
+
+TEST(CodecTimerTest, IgnoresFirstSamples) {
+  VCMCodecTimer timer;
+  for (int i = 0; i < kIgnoredSampleCount; ++i)
+    timer.AddTiming(100, i);
+  EXPECT_EQ(0, timer.RequiredDecodeTimeMs());
+  timer.AddTiming(10, kIgnoredSampleCount);
+  EXPECT_EQ(10, timer.RequiredDecodeTimeMs());
+}
+
+TEST(CodecTimerTest, Returns95thPercentile) {
+  VCMCodecTimer timer;
+  for (int i = 0; i < kIgnoredSampleCount; ++i)
+    timer.AddTiming(0, 0);
+  // Insert 1..101 out of order; the 95th percentile is at index 95.
+  for (int i = 0; i < 101; ++i)
+    timer.AddTiming((i * 37) % 101 + 1, i);
+  EXPECT_EQ(96, timer.RequiredDecodeTimeMs());
+}
+
+TEST(CodecTimerTest, ExpiresOldSamples) {
+  VCMCodecTimer timer;
+  for (int i = 0; i < kIgnoredSampleCount; ++i)
+    timer.AddTiming(0, 0);
+  for (int i = 0; i < 100; ++i)
+    timer.AddTiming(50, i);
+  EXPECT_EQ(50, timer.RequiredDecodeTimeMs());
+  timer.AddTiming(5, 99 + kTimeLimitMs + 1);
+  EXPECT_EQ(5, timer.RequiredDecodeTimeMs());
+}
+
+TEST(CodecTimerTest, DropsOldestSamplesWhenFull) {
+  VCMCodecTimer timer;
+  for (int i = 0; i < kIgnoredSampleCount; ++i)
+    timer.AddTiming(0, 0);
+  // Many more samples than fit, all within the time window. Only the most
+  // recent ones are kept.
+  for (int i = 0; i < 5000; ++i)
+    timer.AddTiming(i < 2500 ? 100 : 1, 0);
+  EXPECT_EQ(1, timer.RequiredDecodeTimeMs());
+}
+
+}  // namespace webrtc
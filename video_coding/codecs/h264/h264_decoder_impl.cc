@@ -33,6 +33,7 @@ extern "C" {
 #include "modules/video_coding/codecs/h264/h264_color_space.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/field_trial.h"
@@ -48,6 +49,13 @@ const size_t kYPlaneIndex = 0;
 const size_t kUPlaneIndex = 1;
 const size_t kVPlaneIndex = 2;
 
+// Decoded frames are held by FFmpeg as references and by the application until
+// rendered. More buffers than this means that frames are not released.
+const size_t kMaxNumberOfBuffers = 300;
+
+// More frames than FFmpeg can have in flight with frame threads.
+const size_t kMaxPendingFrames = 64;
+
 // Used by histograms. Values of entries should not be changed.
 enum H264DecoderImplEvent {
   kH264DecoderEventInit = 0,
@@ -55,6 +63,35 @@ enum H264DecoderImplEvent {
   kH264DecoderEventMax = 16,
 };
 
+// Hands out the threads that all H264 decoders in the process may use
+// together.
+class DecoderThreadBudget {
+ public:
+  // Returns how many of |wanted_threads| a decoder may use, at least one.
+  int Acquire(int wanted_threads, int total_threads) {
+    rtc::CritScope lock(&lock_);
+    int granted_threads =
+        std::max(1, std::min(wanted_threads, total_threads - threads_in_use_));
+    threads_in_use_ += granted_threads;
+    return granted_threads;
+  }
+
+  void Release(int threads) {
+    rtc::CritScope lock(&lock_);
+    threads_in_use_ -= threads;
+    RTC_DCHECK_GE(threads_in_use_, 0);
+  }
+
+ private:
+  rtc::CriticalSection lock_;
+  int threads_in_use_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+DecoderThreadBudget* GetDecoderThreadBudget() {
+  static DecoderThreadBudget* const budget = new DecoderThreadBudget();
+  return budget;
+}
+
 }  // namespace
 
 int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
@@ -103,8 +140,17 @@ int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
   // http://crbug.com/390941. Our pool is set up to zero-initialize new buffers.
   // TODO(nisse): Delete that feature from the video pool, instead add
   // an explicit call to InitializeData here.
-  rtc::scoped_refptr<I420Buffer> frame_buffer =
-      decoder->pool_.CreateBuffer(width, height);
+  rtc::scoped_refptr<I420Buffer> frame_buffer;
+  {
+    rtc::CritScope lock(&decoder->pool_lock_);
+    frame_buffer = decoder->pool_.CreateBuffer(width, height);
+  }
+  if (!frame_buffer) {
+    // Pool has too many pending frames.
+    RTC_HISTOGRAM_BOOLEAN("WebRTC.Video.H264DecoderImpl.TooManyPendingFrames",
+                          1);
+    return AVERROR(ENOMEM);
+  }
 
   int y_size = width * height;
   int uv_size = frame_buffer->ChromaWidth() * frame_buffer->ChromaHeight();
@@ -153,7 +199,9 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
 H264DecoderImpl::H264DecoderImpl()
     : kEnable8bitHdrFix_(
           !field_trial::IsEnabled("WebRTC-8bitH264HdrKillSwitch")),
-      pool_(true),
+      threading_settings_(ParseThreadingSettings()),
+      pool_(true, kMaxNumberOfBuffers),
+      budgeted_threads_(0),
       decoded_image_callback_(nullptr),
       has_reported_init_(false),
       has_reported_error_(false) {}
@@ -162,6 +210,21 @@ H264DecoderImpl::~H264DecoderImpl() {
   Release();
 }
 
+// static
+H264DecoderImpl::ThreadingSettings H264DecoderImpl::ParseThreadingSettings() {
+  ThreadingSettings settings;
+  FieldTrialFlag frame_threads("frame_threads");
+  FieldTrialParameter<int> max_threads("max_threads", settings.max_threads);
+  FieldTrialParameter<int> total_threads("total_threads",
+                                         settings.total_threads);
+  ParseFieldTrial({&frame_threads, &max_threads, &total_threads},
+                  field_trial::FindFullName("WebRTC-H264DecoderThreads"));
+  settings.frame_threads = frame_threads.Get();
+  settings.max_threads = std::max(1, max_threads.Get());
+  settings.total_threads = total_threads.Get();
+  return settings;
+}
+
 int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
                                     int32_t number_of_cores) {
   ReportInit();
@@ -191,10 +254,22 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   av_context_->extradata = nullptr;
   av_context_->extradata_size = 0;
 
-  // If this is ever increased, look at |av_context_->thread_safe_callbacks| and
-  // make it possible to disable the thread checker in the frame buffer pool.
-  av_context_->thread_count = 1;
-  av_context_->thread_type = FF_THREAD_SLICE;
+  int num_threads =
+      std::min(threading_settings_.max_threads, std::max(number_of_cores, 1));
+  if (threading_settings_.total_threads > 0 && num_threads > 1) {
+    budgeted_threads_ = GetDecoderThreadBudget()->Acquire(
+        num_threads, threading_settings_.total_threads);
+    num_threads = budgeted_threads_;
+  }
+  av_context_->thread_count = num_threads;
+  if (threading_settings_.frame_threads && num_threads > 1) {
+    av_context_->thread_type = FF_THREAD_FRAME;
+    // |get_buffer2| is called on the frame threads, which is safe since
+    // |pool_| is locked.
+    av_context_->thread_safe_callbacks = 1;
+  } else {
+    av_context_->thread_type = FF_THREAD_SLICE;
+  }
 
   // Function used by FFmpeg to get buffers to store decoded frames in.
   av_context_->get_buffer2 = AVGetBuffer2;
@@ -224,8 +299,14 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
 }
 
 int32_t H264DecoderImpl::Release() {
+  // Stops the FFmpeg threads before they are returned to the budget.
   av_context_.reset();
   av_frame_.reset();
+  pending_frames_.clear();
+  if (budgeted_threads_ > 0) {
+    GetDecoderThreadBudget()->Release(budgeted_threads_);
+    budgeted_threads_ = 0;
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -263,8 +344,8 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   packet.size = static_cast<int>(input_image.size());
-  int64_t frame_timestamp_us = input_image.ntp_time_ms_ * 1000;  // ms -> μs
-  av_context_->reordered_opaque = frame_timestamp_us;
+  // Identifies the input of the frames returned by FFmpeg.
+  av_context_->reordered_opaque = input_image.Timestamp();
 
   int result = avcodec_send_packet(av_context_.get(), &packet);
   if (result < 0) {
@@ -273,24 +354,52 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
-  result = avcodec_receive_frame(av_context_.get(), av_frame_.get());
-  if (result < 0) {
-    RTC_LOG(LS_ERROR) << "avcodec_receive_frame error: " << result;
-    ReportError();
-    return WEBRTC_VIDEO_CODEC_ERROR;
-  }
-
-  // We don't expect reordering. Decoded frame tamestamp should match
-  // the input one.
-  RTC_DCHECK_EQ(av_frame_->reordered_opaque, frame_timestamp_us);
-
-  absl::optional<uint8_t> qp;
+  PendingFrame pending_frame;
+  pending_frame.rtp_timestamp = input_image.Timestamp();
+  if (input_image.ColorSpace())
+    pending_frame.color_space = *input_image.ColorSpace();
   // TODO(sakal): Maybe it is possible to get QP directly from FFmpeg.
   h264_bitstream_parser_.ParseBitstream(input_image.data(), input_image.size());
   int qp_int;
   if (h264_bitstream_parser_.GetLastSliceQp(&qp_int)) {
-    qp.emplace(qp_int);
+    pending_frame.qp.emplace(qp_int);
+  }
+  pending_frames_.push_back(pending_frame);
+  if (pending_frames_.size() > kMaxPendingFrames)
+    pending_frames_.pop_front();
+
+  while (true) {
+    result = avcodec_receive_frame(av_context_.get(), av_frame_.get());
+    // With frame threads, the output lags behind the input.
+    if (result == AVERROR(EAGAIN) &&
+        av_context_->active_thread_type == FF_THREAD_FRAME) {
+      return WEBRTC_VIDEO_CODEC_OK;
+    }
+    if (result < 0) {
+      RTC_LOG(LS_ERROR) << "avcodec_receive_frame error: " << result;
+      pending_frames_.clear();
+      ReportError();
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+
+    // Frames that FFmpeg dropped without output are never returned.
+    while (pending_frames_.size() > 1 &&
+           pending_frames_.front().rtp_timestamp !=
+               av_frame_->reordered_opaque) {
+      pending_frames_.pop_front();
+    }
+    RTC_DCHECK(!pending_frames_.empty());
+    DeliverFrame(pending_frames_.front());
+    pending_frames_.pop_front();
+    if (av_context_->active_thread_type != FF_THREAD_FRAME)
+      return WEBRTC_VIDEO_CODEC_OK;
   }
+}
+
+void H264DecoderImpl::DeliverFrame(const PendingFrame& pending_frame) {
+  // We don't expect reordering. Decoded frame tamestamp should match
+  // the input one.
+  RTC_DCHECK_EQ(av_frame_->reordered_opaque, pending_frame.rtp_timestamp);
 
   // Obtain the |video_frame| containing the decoded image.
   VideoFrame* input_frame =
@@ -328,8 +437,8 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
 
   // Pass on color space from input frame if explicitly specified.
   const ColorSpace& color_space =
-      input_image.ColorSpace() ? *input_image.ColorSpace()
-                               : ExtractH264ColorSpace(av_context_.get());
+      pending_frame.color_space ? *pending_frame.color_space
+                                : ExtractH264ColorSpace(av_context_.get());
   // 8-bit HDR is currently not being rendered correctly in Chrome on Windows.
   // If the ColorSpace transfer function is set to ST2084, convert the 8-bit
   // buffer to a 10-bit buffer. This way 8-bit HDR content is rendered correctly
@@ -348,20 +457,19 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
 
   VideoFrame decoded_frame = VideoFrame::Builder()
                                  .set_video_frame_buffer(decoded_buffer)
-                                 .set_timestamp_rtp(input_image.Timestamp())
+                                 .set_timestamp_rtp(pending_frame.rtp_timestamp)
                                  .set_color_space(color_space)
                                  .build();
 
   // Return decoded frame.
   // TODO(nisse): Timestamp and rotation are all zero here. Change decoder
   // interface to pass a VideoFrameBuffer instead of a VideoFrame?
-  decoded_image_callback_->Decoded(decoded_frame, absl::nullopt, qp);
+  decoded_image_callback_->Decoded(decoded_frame, absl::nullopt,
+                                   pending_frame.qp);
 
   // Stop referencing it, possibly freeing |input_frame|.
   av_frame_unref(av_frame_.get());
   input_frame = nullptr;
-
-  return WEBRTC_VIDEO_CODEC_OK;
 }
 
 const char* H264DecoderImpl::ImplementationName() const {
@@ -21,8 +21,11 @@
 #error "See: bugs.webrtc.org/9213#c13."
 #endif
 
+#include <deque>
 #include <memory>
 
+#include "absl/types/optional.h"
+#include "api/video/color_space.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 
 // CAVEAT: According to ffmpeg docs for avcodec_send_packet, ffmpeg requires a
@@ -45,6 +48,8 @@ extern "C" {
 
 #include "common_video/h264/h264_bitstream_parser.h"
 #include "common_video/include/i420_buffer_pool.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -77,7 +82,34 @@ class H264DecoderImpl : public H264Decoder {
   const char* ImplementationName() const override;
 
  private:
+  // How FFmpeg is allowed to use threads, configured by field trial:
+  // WebRTC-H264DecoderThreads/frame_threads,max_threads:4,total_threads:32/
+  struct ThreadingSettings {
+    // Decode several frames in parallel instead of the slices of one frame.
+    // Adds up to |max_threads| - 1 frames of decoding delay.
+    bool frame_threads = false;
+    // Maximum number of threads per decoder, also limited by the number of
+    // cores given to InitDecode().
+    int max_threads = 1;
+    // If positive, the total number of threads available to all H264 decoders
+    // in the process. Each decoder gets at least one thread.
+    int total_threads = 0;
+  };
+  static ThreadingSettings ParseThreadingSettings();
+
+  // What is needed to output a frame once FFmpeg returns it, which with frame
+  // threads may be a few Decode() calls later.
+  struct PendingFrame {
+    uint32_t rtp_timestamp;
+    absl::optional<ColorSpace> color_space;
+    absl::optional<uint8_t> qp;
+  };
+
+  // Outputs |av_frame_| as the decoded image of |pending_frame|.
+  void DeliverFrame(const PendingFrame& pending_frame);
+
   const bool kEnable8bitHdrFix_;
+  const ThreadingSettings threading_settings_;
   // Called by FFmpeg when it needs a frame buffer to store decoded frames in.
   // The |VideoFrame| returned by FFmpeg at |Decode| originate from here. Their
   // buffers are reference counted and freed by FFmpeg using |AVFreeBuffer2|.
@@ -93,7 +125,14 @@ class H264DecoderImpl : public H264Decoder {
   void ReportInit();
   void ReportError();
 
-  I420BufferPool pool_;
+  // |pool_| is used by FFmpeg's frame threads concurrently.
+  rtc::CriticalSection pool_lock_;
+  I420BufferPool pool_ RTC_GUARDED_BY(pool_lock_);
+  // Threads taken from the budget shared by all decoders, see
+  // |ThreadingSettings::total_threads|.
+  int budgeted_threads_;
+  // Frames passed to FFmpeg that it has not returned yet, oldest first.
+  std::deque<PendingFrame> pending_frames_;
   std::unique_ptr<AVCodecContext, AVCodecContextDeleter> av_context_;
   std::unique_ptr<AVFrame, AVFrameDeleter> av_frame_;
 
@@ -27,6 +27,8 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
+#include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -41,6 +43,10 @@ namespace {
 
 const bool kOpenH264EncoderDetailedLogging = false;
 
+// Encodes the simulcast layers on separate threads.
+const char kH264ParallelSimulcastEncoding[] =
+    "WebRTC-H264-ParallelSimulcastEncoding";
+
 // QP scaling thresholds.
 static const int kLowH264QpThreshold = 24;
 static const int kHighH264QpThreshold = 37;
@@ -154,6 +160,8 @@ H264EncoderImpl::H264EncoderImpl(const cricket::VideoCodec& codec)
       max_payload_size_(0),
       number_of_cores_(0),
       encoded_image_callback_(nullptr),
+      parallel_simulcast_encoding_(
+          field_trial::IsEnabled(kH264ParallelSimulcastEncoding)),
       has_reported_init_(false),
       has_reported_error_(false) {
   RTC_CHECK(absl::EqualsIgnoreCase(codec.name, cricket::kH264CodecName));
@@ -207,6 +215,7 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
   encoded_images_.resize(number_of_streams);
   encoders_.resize(number_of_streams);
   pictures_.resize(number_of_streams);
+  layer_infos_.resize(number_of_streams);
   configurations_.resize(number_of_streams);
   tl0sync_limit_.resize(number_of_streams);
 
@@ -296,6 +305,20 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
     tl0sync_limit_[i] = configurations_[i].num_temporal_layers;
   }
 
+  if (parallel_simulcast_encoding_) {
+    // |pictures_| and |layer_infos_| must not be resized while
+    // |layer_tasks_| point into them.
+    for (int i = 1; i < number_of_streams; ++i) {
+      layer_threads_.push_back(
+          std::make_unique<TaskThread>("H264LayerEncoder", rtc::kHighPriority));
+      LayerTask task;
+      task.encoder = encoders_[i];
+      task.picture = &pictures_[i];
+      task.info = &layer_infos_[i];
+      layer_tasks_.push_back(task);
+    }
+  }
+
   SimulcastRateAllocator init_allocator(codec_);
   VideoBitrateAllocation allocation =
       init_allocator.Allocate(VideoBitrateAllocationParameters(
@@ -305,6 +328,9 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
 }
 
 int32_t H264EncoderImpl::Release() {
+  // The layer threads must be stopped before their encoders are destroyed.
+  layer_threads_.clear();
+  layer_tasks_.clear();
   while (!encoders_.empty()) {
     ISVCEncoder* openh264_encoder = encoders_.back();
     if (openh264_encoder) {
@@ -317,6 +343,7 @@ int32_t H264EncoderImpl::Release() {
   configurations_.clear();
   encoded_images_.clear();
   pictures_.clear();
+  layer_infos_.clear();
   tl0sync_limit_.clear();
   return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -413,7 +440,8 @@ int32_t H264EncoderImpl::Encode(
   RTC_DCHECK_EQ(configurations_[0].width, frame_buffer->width());
   RTC_DCHECK_EQ(configurations_[0].height, frame_buffer->height());
 
-  // Encode image for each layer.
+  // Prepare the input of each layer.
+  std::vector<bool> encode_layer(encoders_.size(), false);
   for (size_t i = 0; i < encoders_.size(); ++i) {
     // EncodeFrame input.
     pictures_[i] = {0};
@@ -467,12 +495,18 @@ int32_t H264EncoderImpl::Encode(
       encoders_[i]->ForceIntraFrame(true);
       configurations_[i].key_frame_request = false;
     }
-    // EncodeFrame output.
-    SFrameBSInfo info;
-    memset(&info, 0, sizeof(SFrameBSInfo));
+    encode_layer[i] = true;
+  }
+
+  // Encode!
+  const std::vector<int> results = EncodeLayers(encode_layer);
 
-    // Encode!
-    int enc_ret = encoders_[i]->EncodeFrame(&pictures_[i], &info);
+  for (size_t i = 0; i < encoders_.size(); ++i) {
+    if (!encode_layer[i]) {
+      continue;
+    }
+    const SFrameBSInfo& info = layer_infos_[i];
+    const int enc_ret = results[i];
     if (enc_ret != 0) {
       RTC_LOG(LS_ERROR)
           << "OpenH264 frame encoding failed, EncodeFrame returned " << enc_ret
@@ -490,7 +524,8 @@ int32_t H264EncoderImpl::Encode(
     // Split encoded image up into fragments. This also updates
     // |encoded_image_|.
     RTPFragmentationHeader frag_header;
-    RtpFragmentize(&encoded_images_[i], *frame_buffer, &info, &frag_header);
+    RtpFragmentize(&encoded_images_[i], *frame_buffer, &layer_infos_[i],
+                   &frag_header);
 
     // Encoder can skip frames to save bandwidth in which case
     // |encoded_images_[i]._length| == 0.
@@ -528,6 +563,43 @@ int32_t H264EncoderImpl::Encode(
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+std::vector<int> H264EncoderImpl::EncodeLayers(
+    const std::vector<bool>& encode_layer) {
+  std::vector<int> results(encoders_.size(), 0);
+  for (size_t i = 0; i < encoders_.size(); ++i) {
+    if (encode_layer[i])
+      memset(&layer_infos_[i], 0, sizeof(SFrameBSInfo));
+  }
+
+  if (layer_threads_.empty()) {
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      if (!encode_layer[i])
+        continue;
+      results[i] = encoders_[i]->EncodeFrame(&pictures_[i], &layer_infos_[i]);
+      // Encode() doesn't deliver the layers after a failed one, so don't
+      // encode them.
+      if (results[i] != 0)
+        break;
+    }
+    return results;
+  }
+
+  for (size_t i = 1; i < encoders_.size(); ++i) {
+    if (encode_layer[i])
+      layer_threads_[i - 1]->StartTask(layer_tasks_[i - 1]);
+  }
+  if (encode_layer[0])
+    results[0] = encoders_[0]->EncodeFrame(&pictures_[0], &layer_infos_[0]);
+  // Wait for all layers, since the pictures are reused for the next frame.
+  for (size_t i = 1; i < encoders_.size(); ++i) {
+    if (!encode_layer[i])
+      continue;
+    layer_threads_[i - 1]->Wait();
+    results[i] = layer_tasks_[i - 1].result;
+  }
+  return results;
+}
+
 // Initialization parameters.
 // There are two ways to initialize. There is SEncParamBase (cleared with
 // memset(&p, 0, sizeof(SEncParamBase)) used in Initialize, and SEncParamExt
@@ -638,6 +710,11 @@ void H264EncoderImpl::LayerConfig::SetStreamState(bool send_stream) {
   sending = send_stream;
 }
 
+void H264EncoderImpl::LayerTask::operator()() {
+  TRACE_EVENT0("webrtc", "H264EncoderImpl::LayerTask");
+  result = encoder->EncodeFrame(picture, info);
+}
+
 }  // namespace webrtc
 
 #endif  // WEBRTC_USE_H264
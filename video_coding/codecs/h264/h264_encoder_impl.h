@@ -27,6 +27,7 @@
 #include "api/video/i420_buffer.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_video/h264/h264_bitstream_parser.h"
+#include "modules/utility/include/task_thread.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 #include "modules/video_coding/utility/quality_scaler.h"
 #include "third_party/openh264/src/codec/api/svc/codec_app_def.h"
@@ -85,8 +86,26 @@ class H264EncoderImpl : public H264Encoder {
   }
 
  private:
+  // Encodes the frames of one simulcast layer on one of |layer_threads_|.
+  // Used when the simulcast layers are encoded in parallel.
+  struct LayerTask {
+    // Encodes |picture| into |info| and sets |result| to the result of
+    // ISVCEncoder::EncodeFrame().
+    void operator()();
+
+    ISVCEncoder* encoder = nullptr;
+    SSourcePicture* picture = nullptr;
+    SFrameBSInfo* info = nullptr;
+    int result = 0;
+  };
+
   SEncParamExt CreateEncoderParams(size_t i) const;
 
+  // Encodes |pictures_| into |layer_infos_| with every encoder for which
+  // |encode_layer| is set, in parallel if |layer_threads_| are set up.
+  // Returns the result of EncodeFrame() for each encoder.
+  std::vector<int> EncodeLayers(const std::vector<bool>& encode_layer);
+
   webrtc::H264BitstreamParser h264_bitstream_parser_;
   // Reports statistics with histograms.
   void ReportInit();
@@ -97,6 +116,16 @@ class H264EncoderImpl : public H264Encoder {
   std::vector<rtc::scoped_refptr<I420Buffer>> downscaled_buffers_;
   std::vector<LayerConfig> configurations_;
   std::vector<EncodedImage> encoded_images_;
+  // EncodeFrame() output, per encoder.
+  std::vector<SFrameBSInfo> layer_infos_;
+
+  // If set, the simulcast layers are encoded on separate threads.
+  const bool parallel_simulcast_encoding_;
+  // One per encoder except |encoders_[0]|, which is encoded on the calling
+  // thread. Empty unless the layers are encoded in parallel.
+  std::vector<std::unique_ptr<TaskThread>> layer_threads_;
+  // The tasks of |layer_threads_|, kept here as the threads don't copy them.
+  std::vector<LayerTask> layer_tasks_;
 
   VideoCodec codec_;
   H264PacketizationMode packetization_mode_;
@@ -15,6 +15,7 @@
 #include "api/test/video/function_video_decoder_factory.h"
 #include "api/test/video/function_video_encoder_factory.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -99,5 +100,26 @@ TEST(TestH264Simulcast, TestSpatioTemporalLayers333PatternEncoder) {
   fixture->TestSpatioTemporalLayers333PatternEncoder();
 }
 
+TEST(TestH264Simulcast, TestKeyFrameRequestsOnAllStreamsInParallel) {
+  ScopedFieldTrials field_trials(
+      "WebRTC-H264-ParallelSimulcastEncoding/Enabled/");
+  auto fixture = CreateSpecificSimulcastTestFixture();
+  fixture->TestKeyFrameRequestsOnAllStreams();
+}
+
+TEST(TestH264Simulcast, TestDisablingStreamsInParallel) {
+  ScopedFieldTrials field_trials(
+      "WebRTC-H264-ParallelSimulcastEncoding/Enabled/");
+  auto fixture = CreateSpecificSimulcastTestFixture();
+  fixture->TestDisablingStreams();
+}
+
+TEST(TestH264Simulcast, TestStrideEncodeDecodeInParallel) {
+  ScopedFieldTrials field_trials(
+      "WebRTC-H264-ParallelSimulcastEncoding/Enabled/");
+  auto fixture = CreateSpecificSimulcastTestFixture();
+  fixture->TestStrideEncodeDecode();
+}
+
 }  // namespace test
 }  // namespace webrtc
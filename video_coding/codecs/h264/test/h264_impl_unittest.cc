@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/video/color_space.h"
@@ -26,11 +27,27 @@
 #include "modules/video_coding/codecs/test/video_codec_unittest.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/include/video_error_codes.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 #include "test/video_codec_settings.h"
 
 namespace webrtc {
 
+namespace {
+class DecodedTimestampsCallback : public DecodedImageCallback {
+ public:
+  int32_t Decoded(VideoFrame& decoded_image) override {
+    timestamps_.push_back(decoded_image.timestamp());
+    return 0;
+  }
+
+  const std::vector<uint32_t>& timestamps() const { return timestamps_; }
+
+ private:
+  std::vector<uint32_t> timestamps_;
+};
+}  // namespace
+
 class TestH264Impl : public VideoCodecUnitTest {
  protected:
   std::unique_ptr<VideoEncoder> CreateEncoder() override {
@@ -49,9 +66,11 @@ class TestH264Impl : public VideoCodecUnitTest {
 #ifdef WEBRTC_USE_H264
 #define MAYBE_EncodeDecode EncodeDecode
 #define MAYBE_DecodedQpEqualsEncodedQp DecodedQpEqualsEncodedQp
+#define MAYBE_DecodeWithFrameThreads DecodeWithFrameThreads
 #else
 #define MAYBE_EncodeDecode DISABLED_EncodeDecode
 #define MAYBE_DecodedQpEqualsEncodedQp DISABLED_DecodedQpEqualsEncodedQp
+#define MAYBE_DecodeWithFrameThreads DISABLED_DecodeWithFrameThreads
 #endif
 
 TEST_F(TestH264Impl, MAYBE_EncodeDecode) {
@@ -97,4 +116,35 @@ TEST_F(TestH264Impl, MAYBE_DecodedQpEqualsEncodedQp) {
   EXPECT_EQ(encoded_frame.qp_, *decoded_qp);
 }
 
+TEST_F(TestH264Impl, MAYBE_DecodeWithFrameThreads) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-H264DecoderThreads/frame_threads,max_threads:4/");
+  std::unique_ptr<VideoDecoder> decoder = H264Decoder::Create();
+  DecodedTimestampsCallback callback;
+  decoder->RegisterDecodeCompleteCallback(&callback);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder->InitDecode(&codec_settings_, 4 /* number of cores */));
+
+  const size_t kNumFrames = 10;
+  std::vector<uint32_t> timestamps;
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              encoder_->Encode(*NextInputFrame(), nullptr));
+    EncodedImage encoded_frame;
+    CodecSpecificInfo codec_specific_info;
+    ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+    if (i == 0)
+      encoded_frame._frameType = VideoFrameType::kVideoFrameKey;
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder->Decode(encoded_frame, false, 0));
+    timestamps.push_back(encoded_frame.Timestamp());
+  }
+
+  // With four frame threads the output lags up to three frames behind, but
+  // frames still come out in order with their own timestamps.
+  const std::vector<uint32_t>& decoded_timestamps = callback.timestamps();
+  ASSERT_GE(decoded_timestamps.size(), kNumFrames - 3);
+  for (size_t i = 0; i < decoded_timestamps.size(); ++i)
+    EXPECT_EQ(timestamps[i], decoded_timestamps[i]);
+}
+
 }  // namespace webrtc
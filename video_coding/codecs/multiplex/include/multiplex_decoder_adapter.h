@@ -18,7 +18,10 @@
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_decoder.h"
 #include "api/video_codecs/video_decoder_factory.h"
+#include "modules/utility/include/task_thread.h"
 #include "modules/video_coding/codecs/multiplex/include/multiplex_encoder_adapter.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -62,17 +65,25 @@ class MultiplexDecoderAdapter : public VideoDecoder {
                         const absl::optional<int32_t>& multiplex_decode_time_ms,
                         const absl::optional<uint8_t>& multiplex_qp,
                         std::unique_ptr<uint8_t[]> augmenting_data,
-                        uint16_t augmenting_data_length);
+                        uint16_t augmenting_data_length)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   VideoDecoderFactory* const factory_;
   const SdpVideoFormat associated_format_;
   std::vector<std::unique_ptr<VideoDecoder>> decoders_;
   std::vector<std::unique_ptr<AdapterDecodedImageCallback>> adapter_callbacks_;
   DecodedImageCallback* decoded_complete_callback_;
+  // Decodes the alpha component in parallel with the YUV component. Only set
+  // if the multiplex parallel coding field trial is enabled.
+  std::unique_ptr<TaskThread> alpha_decode_thread_;
 
+  // Taken by Decoded(), which is called on the thread of each decoder.
+  rtc::CriticalSection crit_;
   // Holds YUV or AXX decode output of a frame that is identified by timestamp.
-  std::map<uint32_t /* timestamp */, DecodedImageData> decoded_data_;
-  std::map<uint32_t /* timestamp */, AugmentingData> decoded_augmenting_data_;
+  std::map<uint32_t /* timestamp */, DecodedImageData> decoded_data_
+      RTC_GUARDED_BY(crit_);
+  std::map<uint32_t /* timestamp */, AugmentingData> decoded_augmenting_data_
+      RTC_GUARDED_BY(crit_);
   const bool supports_augmenting_data_;
 };
 
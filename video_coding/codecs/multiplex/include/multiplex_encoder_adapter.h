@@ -19,12 +19,17 @@
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
+#include "modules/utility/include/task_thread.h"
 #include "modules/video_coding/codecs/multiplex/multiplex_encoded_image_packer.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/critical_section.h"
 
 namespace webrtc {
 
+// Field trial that makes the multiplex adapters encode and decode the alpha
+// component on a TaskThread, in parallel with the YUV component.
+extern const char kMultiplexParallelCodingFieldTrial[];
+
 enum AlphaCodecStream {
   kYUVStream = 0,
   kAXXStream = 1,
@@ -69,6 +74,9 @@ class MultiplexEncoderAdapter : public VideoEncoder {
   std::vector<std::unique_ptr<VideoEncoder>> encoders_;
   std::vector<std::unique_ptr<AdapterEncodedImageCallback>> adapter_callbacks_;
   EncodedImageCallback* encoded_complete_callback_;
+  // Encodes the alpha component in parallel with the YUV component. Only set
+  // if the multiplex parallel coding field trial is enabled.
+  std::unique_ptr<TaskThread> alpha_encode_thread_;
 
   std::map<uint32_t /* timestamp */, MultiplexImage> stashed_images_
       RTC_GUARDED_BY(crit_);
@@ -10,6 +10,8 @@
 
 #include "modules/video_coding/codecs/multiplex/include/multiplex_decoder_adapter.h"
 
+#include <memory>
+
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
@@ -19,6 +21,7 @@
 #include "modules/video_coding/codecs/multiplex/multiplex_encoded_image_packer.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace {
 void KeepBufferRefs(rtc::scoped_refptr<webrtc::VideoFrameBuffer>,
@@ -124,6 +127,10 @@ int32_t MultiplexDecoderAdapter::InitDecode(const VideoCodec* codec_settings,
     decoder->RegisterDecodeCompleteCallback(adapter_callbacks_.back().get());
     decoders_.emplace_back(std::move(decoder));
   }
+  if (field_trial::IsEnabled(kMultiplexParallelCodingFieldTrial)) {
+    alpha_decode_thread_ = std::make_unique<TaskThread>("MultiplexAlphaDecoder",
+                                                        rtc::kHighPriority);
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -132,30 +139,58 @@ int32_t MultiplexDecoderAdapter::Decode(const EncodedImage& input_image,
                                         int64_t render_time_ms) {
   MultiplexImage image = MultiplexEncodedImagePacker::Unpack(input_image);
 
-  if (supports_augmenting_data_) {
-    RTC_DCHECK(decoded_augmenting_data_.find(input_image.Timestamp()) ==
-               decoded_augmenting_data_.end());
-    decoded_augmenting_data_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(input_image.Timestamp()),
-        std::forward_as_tuple(std::move(image.augmenting_data),
-                              image.augmenting_data_size));
+  {
+    rtc::CritScope cs(&crit_);
+    if (supports_augmenting_data_) {
+      RTC_DCHECK(decoded_augmenting_data_.find(input_image.Timestamp()) ==
+                 decoded_augmenting_data_.end());
+      decoded_augmenting_data_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(input_image.Timestamp()),
+          std::forward_as_tuple(std::move(image.augmenting_data),
+                                image.augmenting_data_size));
+    }
+
+    if (image.component_count == 1) {
+      RTC_DCHECK(decoded_data_.find(input_image.Timestamp()) ==
+                 decoded_data_.end());
+      decoded_data_.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(input_image.Timestamp()),
+                            std::forward_as_tuple(kAXXStream));
+    }
   }
 
-  if (image.component_count == 1) {
-    RTC_DCHECK(decoded_data_.find(input_image.Timestamp()) ==
-               decoded_data_.end());
-    decoded_data_.emplace(std::piecewise_construct,
-                          std::forward_as_tuple(input_image.Timestamp()),
-                          std::forward_as_tuple(kAXXStream));
+  const MultiplexImageComponent* alpha_component = nullptr;
+  if (alpha_decode_thread_ && image.image_components.size() > 1) {
+    for (const MultiplexImageComponent& component : image.image_components) {
+      if (component.component_index == kAXXStream)
+        alpha_component = &component;
+    }
+  }
+  int32_t alpha_rv = WEBRTC_VIDEO_CODEC_OK;
+  const auto decode_alpha = [&] {
+    alpha_rv = decoders_[kAXXStream]->Decode(alpha_component->encoded_image,
+                                             missing_frames, render_time_ms);
+  };
+  if (alpha_component) {
+    // The decoders are done with both components when Decode() returns, as
+    // when decoding them one after the other.
+    alpha_decode_thread_->StartTask(decode_alpha);
   }
   int32_t rv = 0;
   for (size_t i = 0; i < image.image_components.size(); i++) {
+    if (&image.image_components[i] == alpha_component)
+      continue;
     rv = decoders_[image.image_components[i].component_index]->Decode(
         image.image_components[i].encoded_image, missing_frames,
         render_time_ms);
     if (rv != WEBRTC_VIDEO_CODEC_OK)
-      return rv;
+      break;
+  }
+  if (alpha_component) {
+    alpha_decode_thread_->Wait();
+    if (rv == WEBRTC_VIDEO_CODEC_OK)
+      rv = alpha_rv;
   }
   return rv;
 }
@@ -167,6 +202,7 @@ int32_t MultiplexDecoderAdapter::RegisterDecodeCompleteCallback(
 }
 
 int32_t MultiplexDecoderAdapter::Release() {
+  alpha_decode_thread_.reset();
   for (auto& decoder : decoders_) {
     const int32_t rv = decoder->Release();
     if (rv)
@@ -181,6 +217,7 @@ void MultiplexDecoderAdapter::Decoded(AlphaCodecStream stream_idx,
                                       VideoFrame* decoded_image,
                                       absl::optional<int32_t> decode_time_ms,
                                       absl::optional<uint8_t> qp) {
+  rtc::CritScope cs(&crit_);
   const auto& other_decoded_data_it =
       decoded_data_.find(decoded_image->timestamp());
   const auto& augmenting_data_it =
@@ -130,7 +130,7 @@ MultiplexImageComponentHeader UnpackFrameHeader(const uint8_t* buffer) {
   return frame_header;
 }
 
-void PackBitstream(uint8_t* buffer, MultiplexImageComponent image) {
+void PackBitstream(uint8_t* buffer, const MultiplexImageComponent& image) {
   memcpy(buffer, image.encoded_image.data(), image.encoded_image.size());
 }
 
@@ -148,6 +148,7 @@ EncodedImage MultiplexEncodedImagePacker::PackAndRelease(
   MultiplexImageHeader header;
   std::vector<MultiplexImageComponentHeader> frame_headers;
 
+  frame_headers.reserve(multiplex_image.image_components.size());
   header.component_count = multiplex_image.component_count;
   header.image_index = multiplex_image.image_index;
   int header_offset = kMultiplexImageHeaderSize;
@@ -11,6 +11,7 @@
 #include "modules/video_coding/codecs/multiplex/include/multiplex_encoder_adapter.h"
 
 #include <cstring>
+#include <utility>
 
 #include "api/video/encoded_image.h"
 #include "api/video_codecs/video_encoder.h"
@@ -20,9 +21,13 @@
 #include "modules/video_coding/codecs/multiplex/include/augmented_video_frame_buffer.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/logging.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
+const char kMultiplexParallelCodingFieldTrial[] =
+    "WebRTC-Multiplex-ParallelCoding";
+
 // Callback wrapper that helps distinguish returned results from |encoders_|
 // instances.
 class MultiplexEncoderAdapter::AdapterEncodedImageCallback
@@ -138,6 +143,10 @@ int MultiplexEncoderAdapter::InitEncode(
   }
   encoder_info_.implementation_name += ")";
 
+  if (field_trial::IsEnabled(kMultiplexParallelCodingFieldTrial)) {
+    alpha_encode_thread_ = std::make_unique<TaskThread>("MultiplexAlphaEncoder",
+                                                        rtc::kHighPriority);
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -184,16 +193,12 @@ int MultiplexEncoderAdapter::Encode(
 
   ++picture_index_;
 
-  // Encode YUV
-  int rv = encoders_[kYUVStream]->Encode(input_image, &adjusted_frame_types);
-
   // If we do not receive an alpha frame, we send a single frame for this
   // |picture_index_|. The receiver will receive |frame_count| as 1 which
   // specifies this case.
-  if (rv || !has_alpha)
-    return rv;
+  if (!has_alpha)
+    return encoders_[kYUVStream]->Encode(input_image, &adjusted_frame_types);
 
-  // Encode AXX
   const I420ABufferInterface* yuva_buffer =
       supports_augmented_data_
           ? augmented_video_frame_buffer->GetVideoFrameBuffer()->GetI420A()
@@ -212,8 +217,28 @@ int MultiplexEncoderAdapter::Encode(
                                .set_id(input_image.id())
                                .set_packet_infos(input_image.packet_infos())
                                .build();
-  rv = encoders_[kAXXStream]->Encode(alpha_image, &adjusted_frame_types);
-  return rv;
+
+  if (alpha_encode_thread_) {
+    // Both components are encoded before returning, so that the next frame
+    // can't be started on one encoder before the other is done.
+    int alpha_rv = WEBRTC_VIDEO_CODEC_OK;
+    const auto encode_alpha = [&] {
+      alpha_rv =
+          encoders_[kAXXStream]->Encode(alpha_image, &adjusted_frame_types);
+    };
+    alpha_encode_thread_->StartTask(encode_alpha);
+    int rv = encoders_[kYUVStream]->Encode(input_image, &adjusted_frame_types);
+    alpha_encode_thread_->Wait();
+    return rv ? rv : alpha_rv;
+  }
+
+  // Encode YUV
+  int rv = encoders_[kYUVStream]->Encode(input_image, &adjusted_frame_types);
+  if (rv)
+    return rv;
+
+  // Encode AXX
+  return encoders_[kAXXStream]->Encode(alpha_image, &adjusted_frame_types);
 }
 
 int MultiplexEncoderAdapter::RegisterEncodeCompleteCallback(
@@ -259,6 +284,7 @@ void MultiplexEncoderAdapter::OnLossNotification(
 }
 
 int MultiplexEncoderAdapter::Release() {
+  alpha_encode_thread_.reset();
   for (auto& encoder : encoders_) {
     const int rv = encoder->Release();
     if (rv)
@@ -288,9 +314,6 @@ EncodedImageCallback::Result MultiplexEncoderAdapter::OnEncodedImage(
       PayloadStringToCodecType(associated_format_.name);
   image_component.encoded_image = encodedImage;
 
-  // If we don't already own the buffer, make a copy.
-  image_component.encoded_image.Retain();
-
   rtc::CritScope cs(&crit_);
   const auto& stashed_image_itr =
       stashed_images_.find(encodedImage.Timestamp());
@@ -299,9 +322,23 @@ EncodedImageCallback::Result MultiplexEncoderAdapter::OnEncodedImage(
   MultiplexImage& stashed_image = stashed_image_itr->second;
   const uint8_t frame_count = stashed_image.component_count;
 
-  stashed_image.image_components.push_back(image_component);
+  // Keep the components in the order of their index, since they are not
+  // necessarily encoded in that order.
+  std::vector<MultiplexImageComponent>& components =
+      stashed_image.image_components;
+  auto position = components.begin();
+  while (position != components.end() &&
+         position->component_index < stream_idx) {
+    ++position;
+  }
+  position = components.insert(position, std::move(image_component));
 
-  if (stashed_image.image_components.size() == frame_count) {
+  if (components.size() < frame_count) {
+    // The encoder may reuse its buffer after this call, so if we don't
+    // already own the buffer, make a copy until the other components arrive.
+    // The last component is packed straight from the encoder's buffer.
+    position->encoded_image.Retain();
+  } else {
     // Complete case
     for (auto iter = stashed_images_.begin();
          iter != stashed_images_.end() && iter != stashed_image_next_itr;
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -40,6 +41,7 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/keep_ref_until_done.h"
 #include "rtc_base/ref_counted_object.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/video_codec_settings.h"
@@ -321,4 +323,52 @@ INSTANTIATE_TEST_SUITE_P(TestMultiplexAdapter,
                          TestMultiplexAdapter,
                          ::testing::Bool());
 
+// Encodes and decodes the alpha component on a thread of its own.
+class TestMultiplexAdapterWithParallelCoding : public TestMultiplexAdapter {
+ public:
+  TestMultiplexAdapterWithParallelCoding()
+      : field_trials_(std::string(kMultiplexParallelCodingFieldTrial) +
+                      "/Enabled/") {}
+
+ private:
+  test::ScopedFieldTrials field_trials_;
+};
+
+TEST_P(TestMultiplexAdapterWithParallelCoding, EncodeDecodeI420AFrames) {
+  std::unique_ptr<VideoFrame> yuva_frame = CreateInputFrame(true);
+  std::unique_ptr<VideoFrame> input_axx_frame = ExtractAXXFrame(*yuva_frame);
+  for (uint16_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Encode(*yuva_frame, nullptr));
+    EncodedImage encoded_frame;
+    CodecSpecificInfo codec_specific_info;
+    ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+    EXPECT_EQ(kVideoCodecMultiplex, codec_specific_info.codecType);
+
+    // The components are packed in order even if the alpha component is
+    // encoded first.
+    const MultiplexImage& unpacked_frame =
+        MultiplexEncodedImagePacker::Unpack(encoded_frame);
+    EXPECT_EQ(i, unpacked_frame.image_index);
+    ASSERT_EQ(2u, unpacked_frame.image_components.size());
+    EXPECT_EQ(kYUVStream, unpacked_frame.image_components[0].component_index);
+    EXPECT_EQ(kAXXStream, unpacked_frame.image_components[1].component_index);
+
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              decoder_->Decode(encoded_frame, false, 0));
+    std::unique_ptr<VideoFrame> decoded_frame;
+    absl::optional<uint8_t> decoded_qp;
+    ASSERT_TRUE(WaitForDecodedFrame(&decoded_frame, &decoded_qp));
+    ASSERT_TRUE(decoded_frame);
+    EXPECT_GT(I420PSNR(yuva_frame.get(), decoded_frame.get()), 36);
+    std::unique_ptr<VideoFrame> output_axx_frame =
+        ExtractAXXFrame(*decoded_frame);
+    EXPECT_GT(I420PSNR(input_axx_frame.get(), output_axx_frame.get()), 47);
+    CheckData(decoded_frame->video_frame_buffer());
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(TestMultiplexAdapterWithParallelCoding,
+                         TestMultiplexAdapterWithParallelCoding,
+                         ::testing::Bool());
+
 }  // namespace webrtc
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#if defined(WEBRTC_POSIX)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "media/base/media_constants.h"
+#include "modules/video_coding/codecs/test/videocodec_test_fixture_impl.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr size_t kNumFrames = 300;
+// The first frames include the key frame and the encoder warming up.
+constexpr size_t kNumFramesToSkip = 10;
+
+struct Clip {
+  const char* filename;
+  size_t width;
+  size_t height;
+  size_t bitrate_kbps;
+};
+
+const Clip kClips[] = {{"foreman_cif", 352, 288, 500},
+                       {"FourPeople_1280x720_30", 1280, 720, 2000}};
+
+// Returns the |percentile| of |values|, which are reordered.
+int Percentile(std::vector<int>* values, double percentile) {
+  if (values->empty())
+    return 0;
+  const size_t index = static_cast<size_t>(percentile * (values->size() - 1));
+  std::nth_element(values->begin(), values->begin() + index, values->end());
+  return (*values)[index];
+}
+
+// Returns the peak resident memory of the process, or 0 if unknown.
+double MaxResidentMemoryKb() {
+#if defined(WEBRTC_POSIX)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(WEBRTC_MAC) || defined(WEBRTC_IOS)
+    // Reported in bytes rather than kilobytes.
+    return usage.ru_maxrss / 1024.0;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return 0;
+}
+
+// Encodes and decodes each clip with |codec_name|, on a single core and on
+// all cores, and reports the median and 99th percentile of the per-frame
+// encode and decode times together with the memory high-water mark.
+void RunCodecPerfTest(const std::string& codec_name) {
+  for (const Clip& clip : kClips) {
+    for (bool use_single_core : {true, false}) {
+      VideoCodecTestFixture::Config config;
+      config.filename = clip.filename;
+      config.filepath = ResourcePath(config.filename, "yuv");
+      config.num_frames = kNumFrames;
+      config.use_single_core = use_single_core;
+      config.SetCodecSettings(codec_name, 1, 1, 1, false, true, false,
+                              clip.width, clip.height);
+      VideoCodecTestFixtureImpl fixture(config);
+      fixture.RunTest({{clip.bitrate_kbps, 30, 0}}, nullptr, nullptr, nullptr);
+
+      std::vector<int> encode_times_us;
+      std::vector<int> decode_times_us;
+      for (const VideoCodecTestStats::FrameStatistics& frame_stat :
+           fixture.GetStats().GetFrameStatistics()) {
+        if (frame_stat.frame_number < kNumFramesToSkip)
+          continue;
+        if (frame_stat.encoding_successful)
+          encode_times_us.push_back(frame_stat.encode_time_us);
+        if (frame_stat.decoding_successful)
+          decode_times_us.push_back(frame_stat.decode_time_us);
+      }
+      EXPECT_FALSE(encode_times_us.empty());
+      EXPECT_FALSE(decode_times_us.empty());
+
+      rtc::StringBuilder story;
+      story << codec_name << "_" << clip.width << "x" << clip.height << "_"
+            << config.NumberOfCores() << "cores";
+      PrintResult("video_codec_perf", "", story.str() + "_encode_time_median",
+                  Percentile(&encode_times_us, 0.5), "us", false);
+      PrintResult("video_codec_perf", "", story.str() + "_encode_time_p99",
+                  Percentile(&encode_times_us, 0.99), "us", true);
+      PrintResult("video_codec_perf", "", story.str() + "_decode_time_median",
+                  Percentile(&decode_times_us, 0.5), "us", false);
+      PrintResult("video_codec_perf", "", story.str() + "_decode_time_p99",
+                  Percentile(&decode_times_us, 0.99), "us", true);
+      PrintResult("video_codec_perf", "", story.str() + "_max_resident_memory",
+                  MaxResidentMemoryKb(), "KB", false);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(VideoCodecPerfTest, Vp8) {
+  RunCodecPerfTest(cricket::kVp8CodecName);
+}
+
+#if defined(RTC_ENABLE_VP9)
+TEST(VideoCodecPerfTest, Vp9) {
+  RunCodecPerfTest(cricket::kVp9CodecName);
+}
+#endif
+
+#if defined(WEBRTC_USE_H264)
+TEST(VideoCodecPerfTest, H264) {
+  RunCodecPerfTest(cricket::kH264CodecName);
+}
+#endif
+
+}  // namespace test
+}  // namespace webrtc
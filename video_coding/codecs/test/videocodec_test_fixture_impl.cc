@@ -420,6 +420,7 @@ void VideoCodecTestFixtureImpl::ProcessAllFrames(
   // Set initial rates.
   auto rate_profile = rate_profiles.begin();
   task_queue->PostTask([this, rate_profile] {
+    codec_cpu_time_ns_ = -rtc::GetThreadCpuTimeNanos();
     processor_->SetRates(rate_profile->target_kbps, rate_profile->input_fps);
   });
 
@@ -447,7 +448,9 @@ void VideoCodecTestFixtureImpl::ProcessAllFrames(
   }
 
   // Wait until we know that the last frame has been sent for encode.
-  task_queue->SendTask([] {}, RTC_FROM_HERE);
+  task_queue->SendTask(
+      [this] { codec_cpu_time_ns_ += rtc::GetThreadCpuTimeNanos(); },
+      RTC_FROM_HERE);
 
   // Give the VideoProcessor pipeline some time to process the last frame,
   // and then release the codecs.
@@ -632,6 +635,10 @@ VideoCodecTestStats& VideoCodecTestFixtureImpl::GetStats() {
   return stats_;
 }
 
+int64_t VideoCodecTestFixtureImpl::GetCodecCpuTimeUs() const {
+  return codec_cpu_time_ns_ / rtc::kNumNanosecsPerMicrosec;
+}
+
 void VideoCodecTestFixtureImpl::SetUpAndInitObjects(
     TaskQueueForTest* task_queue,
     size_t initial_bitrate_kbps,
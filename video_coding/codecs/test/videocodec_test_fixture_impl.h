@@ -11,6 +11,8 @@
 #ifndef MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_FIXTURE_IMPL_H_
 #define MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_FIXTURE_IMPL_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -56,6 +58,10 @@ class VideoCodecTestFixtureImpl : public VideoCodecTestFixture {
 
   VideoCodecTestStats& GetStats() override;
 
+  // Returns the CPU time spent on the task queue that calls the codecs during
+  // the last RunTest().
+  int64_t GetCodecCpuTimeUs() const;
+
  private:
   class CpuProcessTime;
 
@@ -98,6 +104,8 @@ class VideoCodecTestFixtureImpl : public VideoCodecTestFixture {
   VideoProcessor::FrameWriterList decoded_frame_writers_;
   std::unique_ptr<VideoProcessor> processor_;
   std::unique_ptr<CpuProcessTime> cpu_process_time_;
+  // Written on the task queue while processing frames.
+  int64_t codec_cpu_time_ns_ = 0;
 };
 
 }  // namespace test
@@ -8,7 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <iterator>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/test/create_videocodec_test_fixture.h"
@@ -18,6 +20,7 @@
 #include "media/engine/internal_decoder_factory.h"
 #include "media/engine/internal_encoder_factory.h"
 #include "media/engine/simulcast_encoder_adapter.h"
+#include "modules/video_coding/codecs/test/videocodec_test_matrix.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "modules/video_coding/utility/vp9_uncompressed_header_parser.h"
 #include "test/gtest.h"
@@ -482,5 +485,31 @@ TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9RdPerf) {
   PrintRdPerf(rd_stats);
 }
 
+// Runs each clip with each codec at each bitrate, in parallel on all cores,
+// and prints one line of JSON per run.
+TEST(VideoCodecTestLibvpx, DISABLED_RdPerfMatrix) {
+  auto config = CreateConfig();
+  config.num_frames = kNumFramesShort;
+  const std::vector<VideoCodecTestMatrix::Clip> clips = {
+      {"foreman_cif", kCifWidth, kCifHeight, 30},
+      {"FourPeople_1280x720_30", 1280, 720, 30}};
+  std::vector<std::string> codec_names = {cricket::kVp8CodecName};
+#if defined(RTC_ENABLE_VP9)
+  codec_names.push_back(cricket::kVp9CodecName);
+#endif
+  const std::vector<size_t> bitrates_kbps(std::begin(kBitrateRdPerfKbps),
+                                          std::end(kBitrateRdPerfKbps));
+
+  const std::vector<VideoCodecTestMatrix::Result> results =
+      VideoCodecTestMatrix::RunAll(
+          VideoCodecTestMatrix::CreateRuns(config, clips, codec_names,
+                                           bitrates_kbps),
+          /*num_threads=*/0);
+
+  EXPECT_EQ(clips.size() * codec_names.size() * bitrates_kbps.size(),
+            results.size());
+  printf("%s", VideoCodecTestMatrix::ResultsToJson(results).c_str());
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/test/videocodec_test_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "modules/video_coding/codecs/test/videocodec_test_fixture_impl.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+// Shared by the worker threads, which take the next run to process until all
+// runs have been taken.
+struct RunQueue {
+  const std::vector<VideoCodecTestMatrix::Run>* runs;
+  std::vector<VideoCodecTestMatrix::Result>* results;
+  std::atomic<size_t> next_run{0};
+};
+
+VideoCodecTestMatrix::Result ProcessRun(const VideoCodecTestMatrix::Run& run) {
+  VideoCodecTestMatrix::Result result;
+  result.name = run.name;
+  result.codec_name = run.config.CodecName();
+  result.filename = run.config.filename;
+  result.target_bitrate_kbps = run.rate_profiles[0].target_kbps;
+
+  const int64_t start_time_us = rtc::TimeMicros();
+  VideoCodecTestFixtureImpl fixture(run.config);
+  fixture.RunTest(run.rate_profiles, nullptr, nullptr, nullptr);
+  result.run_time_us = rtc::TimeMicros() - start_time_us;
+  result.codec_cpu_time_us = fixture.GetCodecCpuTimeUs();
+
+  // Runs use a single layer, so this is the statistics of all frames.
+  std::vector<VideoCodecTestStats::VideoStatistics> layer_stats =
+      fixture.GetStats().SliceAndCalcLayerVideoStatistic(
+          0, run.config.num_frames - 1);
+  if (!layer_stats.empty())
+    result.video_stat = layer_stats.back();
+  return result;
+}
+
+void ProcessRuns(void* obj) {
+  RunQueue* queue = static_cast<RunQueue*>(obj);
+  for (size_t i = queue->next_run++; i < queue->runs->size();
+       i = queue->next_run++) {
+    // Each worker writes only the results of the runs it has taken.
+    (*queue->results)[i] = ProcessRun((*queue->runs)[i]);
+  }
+}
+
+}  // namespace
+
+std::vector<VideoCodecTestMatrix::Run> VideoCodecTestMatrix::CreateRuns(
+    const VideoCodecTestFixture::Config& base_config,
+    const std::vector<Clip>& clips,
+    const std::vector<std::string>& codec_names,
+    const std::vector<size_t>& bitrates_kbps) {
+  std::vector<Run> runs;
+  runs.reserve(clips.size() * codec_names.size() * bitrates_kbps.size());
+  for (const Clip& clip : clips) {
+    for (const std::string& codec_name : codec_names) {
+      for (size_t bitrate_kbps : bitrates_kbps) {
+        Run run;
+        run.name = clip.filename + "_" + codec_name + "_" +
+                   std::to_string(bitrate_kbps) + "kbps";
+        run.config = base_config;
+        run.config.filename = clip.filename;
+        run.config.filepath = ResourcePath(clip.filename, "yuv");
+        run.config.SetCodecSettings(codec_name, 1, 1, 1, false, true, false,
+                                    clip.width, clip.height);
+        run.rate_profiles = {{bitrate_kbps, clip.framerate_fps, 0}};
+        runs.push_back(std::move(run));
+      }
+    }
+  }
+  return runs;
+}
+
+std::vector<VideoCodecTestMatrix::Result> VideoCodecTestMatrix::RunAll(
+    const std::vector<Run>& runs,
+    size_t num_threads) {
+  std::vector<Result> results(runs.size());
+  if (num_threads == 0)
+    num_threads = CpuInfo::DetectNumberOfCores();
+  num_threads = std::max<size_t>(1, std::min(num_threads, runs.size()));
+
+  RunQueue queue;
+  queue.runs = &runs;
+  queue.results = &results;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &ProcessRuns, &queue, "VideoCodecTestMatrix"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  return results;
+}
+
+std::string VideoCodecTestMatrix::ResultsToJson(
+    const std::vector<Result>& results) {
+  rtc::StringBuilder json;
+  for (const Result& result : results) {
+    const VideoCodecTestStats::VideoStatistics& stat = result.video_stat;
+    json << "{\"name\": \"" << result.name << "\""
+         << ", \"codec\": \"" << result.codec_name << "\""
+         << ", \"clip\": \"" << result.filename << "\""
+         << ", \"target_bitrate_kbps\": " << result.target_bitrate_kbps
+         << ", \"bitrate_kbps\": " << stat.bitrate_kbps
+         << ", \"framerate_fps\": " << stat.framerate_fps
+         << ", \"enc_speed_fps\": " << stat.enc_speed_fps
+         << ", \"dec_speed_fps\": " << stat.dec_speed_fps
+         << ", \"avg_psnr\": " << stat.avg_psnr
+         << ", \"min_psnr\": " << stat.min_psnr
+         << ", \"avg_ssim\": " << stat.avg_ssim
+         << ", \"min_ssim\": " << stat.min_ssim
+         << ", \"codec_cpu_time_ms\": " << result.codec_cpu_time_us / 1000
+         << ", \"run_time_ms\": " << result.run_time_us / 1000 << "}\n";
+  }
+  return json.Release();
+}
+
+}  // namespace test
+}  // namespace webrtc
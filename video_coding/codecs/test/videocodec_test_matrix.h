@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_MATRIX_H_
+#define MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_MATRIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "api/test/videocodec_test_fixture.h"
+#include "api/test/videocodec_test_stats.h"
+
+namespace webrtc {
+namespace test {
+
+// Runs every combination of a set of clips, codecs and bitrates, each with its
+// own VideoCodecTestFixtureImpl, spreading the runs over several threads.
+// Since the runs are independent, a matrix that would take hours to process
+// sequentially finishes in roughly that time divided by the number of cores.
+class VideoCodecTestMatrix {
+ public:
+  struct Clip {
+    // Name of the clip in the test resources, without the ".yuv" extension.
+    std::string filename;
+    size_t width;
+    size_t height;
+    double framerate_fps;
+  };
+
+  struct Run {
+    std::string name;
+    VideoCodecTestFixture::Config config;
+    std::vector<VideoCodecTestFixture::RateProfile> rate_profiles;
+  };
+
+  struct Result {
+    std::string name;
+    std::string codec_name;
+    std::string filename;
+    size_t target_bitrate_kbps = 0;
+    // Statistics of all frames of the run, aggregated over the layers.
+    VideoCodecTestStats::VideoStatistics video_stat;
+    // CPU time spent on the thread that calls the codecs.
+    int64_t codec_cpu_time_us = 0;
+    // Wall clock time of the whole run.
+    int64_t run_time_us = 0;
+  };
+
+  // Creates one run per clip, codec and bitrate, each using a copy of
+  // |base_config| with a single layer and a constant rate.
+  static std::vector<Run> CreateRuns(
+      const VideoCodecTestFixture::Config& base_config,
+      const std::vector<Clip>& clips,
+      const std::vector<std::string>& codec_names,
+      const std::vector<size_t>& bitrates_kbps);
+
+  // Processes |runs| on |num_threads| threads, or on one thread per core if
+  // |num_threads| is 0. Results are returned in the order of |runs|.
+  static std::vector<Result> RunAll(const std::vector<Run>& runs,
+                                    size_t num_threads);
+
+  // Returns |results| as JSON, one object per run and line.
+  static std::string ResultsToJson(const std::vector<Result>& results);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_TEST_VIDEOCODEC_TEST_MATRIX_H_
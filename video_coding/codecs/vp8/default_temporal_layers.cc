@@ -360,9 +360,7 @@ Vp8FrameConfig DefaultTemporalLayers::NextFrameConfig(size_t stream_index,
     // Start of new pattern iteration, set up clear state by invalidating any
     // pending frames, so that we don't make an invalid reference to a buffer
     // containing data from a previous iteration.
-    for (auto& it : pending_frames_) {
-      it.second.expired = true;
-    }
+    pending_frames_.ForEach([](PendingFrame* frame) { frame->expired = true; });
   }
 
   if (first_frame) {
@@ -395,8 +393,9 @@ Vp8FrameConfig DefaultTemporalLayers::NextFrameConfig(size_t stream_index,
   }
 
   // Add frame to set of pending frames, awaiting completion.
-  pending_frames_[timestamp] =
-      PendingFrame{false, GetUpdatedBuffers(tl_config), dependency_info};
+  pending_frames_.Insert(
+      timestamp,
+      PendingFrame{false, GetUpdatedBuffers(tl_config), dependency_info});
 
 #if RTC_DCHECK_IS_ON
   // Checker does not yet support encoder frame dropping, so validate flags
@@ -479,10 +478,10 @@ void DefaultTemporalLayers::OnEncodeDone(size_t stream_index,
     return;
   }
 
-  auto pending_frame = pending_frames_.find(rtp_timestamp);
-  RTC_DCHECK(pending_frame != pending_frames_.end());
+  PendingFrame* pending_frame = pending_frames_.Find(rtp_timestamp);
+  RTC_DCHECK(pending_frame);
 
-  PendingFrame& frame = pending_frame->second;
+  PendingFrame& frame = *pending_frame;
   const Vp8FrameConfig& frame_config = frame.dependency_info.frame_config;
 #if RTC_DCHECK_IS_ON
   if (is_keyframe) {
@@ -567,14 +566,13 @@ void DefaultTemporalLayers::OnEncodeDone(size_t stream_index,
     }
   }
 
-  pending_frames_.erase(pending_frame);
+  pending_frames_.Erase(rtp_timestamp);
 }
 
 void DefaultTemporalLayers::OnFrameDropped(size_t stream_index,
                                            uint32_t rtp_timestamp) {
-  auto pending_frame = pending_frames_.find(rtp_timestamp);
-  RTC_DCHECK(pending_frame != pending_frames_.end());
-  pending_frames_.erase(pending_frame);
+  const bool erased = pending_frames_.Erase(rtp_timestamp);
+  RTC_DCHECK(erased);
 }
 
 void DefaultTemporalLayers::OnPacketLossRateUpdate(float packet_loss_rate) {}
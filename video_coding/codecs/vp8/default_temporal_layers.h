@@ -26,6 +26,7 @@
 #include "api/video_codecs/vp8_frame_config.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
 #include "modules/video_coding/codecs/vp8/include/temporal_layers_checker.h"
+#include "modules/video_coding/codecs/vp8/pending_frame_ring.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 
 namespace webrtc {
@@ -113,8 +114,8 @@ class DefaultTemporalLayers final : public Vp8FrameBufferController {
     // The frame config returned by NextFrameConfig() for this frame.
     DependencyInfo dependency_info;
   };
-  // Map from rtp timestamp to pending frame status. Reset on pattern loop.
-  std::map<uint32_t, PendingFrame> pending_frames_;
+  // Pending frame status, by rtp timestamp. Reset on pattern loop.
+  PendingFrameRing<PendingFrame> pending_frames_;
 
   // One counter per Vp8BufferReference, indicating number of frames since last
   // refresh. For non-base-layer frames (ie golden, altref buffers), this is
@@ -30,6 +30,7 @@
 #include "api/video_codecs/vp8_temporal_layers_factory.h"
 #include "modules/video_coding/codecs/interface/common_constants.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
+#include "modules/video_coding/codecs/vp8/screenshare_layers.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "modules/video_coding/utility/simulcast_utility.h"
@@ -38,6 +39,7 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -54,6 +56,25 @@ const char kVP8IosMaxNumberOfThreadFieldTrialParameter[] = "max_thread";
 const char kVp8ForcePartitionResilience[] =
     "WebRTC-VP8-ForcePartitionResilience";
 
+// Encodes the simulcast layers with independent encoders on separate threads.
+const char kVp8ParallelSimulcastEncoding[] =
+    "WebRTC-VP8-ParallelSimulcastEncoding";
+
+// Skips encoding unchanged screenshare frames in steady state.
+const char kVp8SkipUnchangedScreenshareFrames[] =
+    "WebRTC-VP8-SkipUnchangedScreenshareFrames";
+
+// Adapts cpu_speed to the measured encode time.
+const char kVp8AdaptiveCpuSpeed[] = "WebRTC-VP8-AdaptiveCpuSpeed";
+// Smoothing of the measured encode time.
+constexpr float kEncodeTimeFilterAlpha = 0.9f;
+// Frames to wait after a cpu_speed change, so that its effect on the encode
+// time is measured before the next change.
+constexpr int kMinFramesBetweenCpuSpeedChanges = 30;
+// The encoders are made slower again when the encode time is below this share
+// of the budget, leaving hysteresis between the thresholds.
+constexpr double kCpuSpeedRestoreRatio = 0.6;
+
 // QP is obtained from VP8-bitstream for HW, so the QP corresponds to the
 // bitstream range of [0, 127] and not the user-level range of [0,63].
 constexpr int kLowVp8QpThreshold = 29;
@@ -295,10 +316,16 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(
       frame_buffer_controller_factory_(
           std::move(frame_buffer_controller_factory)),
       key_frame_request_(kMaxSimulcastStreams, false),
+      parallel_simulcast_encoding_(
+          field_trial::IsEnabled(kVp8ParallelSimulcastEncoding)),
       variable_framerate_experiment_(ParseVariableFramerateConfig(
           "WebRTC-VP8VariableFramerateScreenshare")),
       framerate_controller_(variable_framerate_experiment_.framerate_limit),
       num_steady_state_frames_(0),
+      skip_unchanged_screenshare_frames_(
+          field_trial::IsEnabled(kVp8SkipUnchangedScreenshareFrames)),
+      adaptive_cpu_speed_experiment_(
+          ParseAdaptiveCpuSpeedConfig(kVp8AdaptiveCpuSpeed)),
       fec_controller_override_(nullptr) {
   // TODO(eladalon/ilnik): These reservations might be wasting memory.
   // InitEncode() is resizing to the actual size, which might be smaller.
@@ -320,6 +347,9 @@ int LibvpxVp8Encoder::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
   encoded_images_.clear();
+  // The layer threads must be stopped before their encoders are destroyed.
+  layer_threads_.clear();
+  layer_tasks_.clear();
 
   if (inited_) {
     for (auto it = encoders_.rbegin(); it != encoders_.rend(); ++it) {
@@ -506,6 +536,7 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
 
   number_of_cores_ = settings.number_of_cores;
   timestamp_ = 0;
+  last_encoded_rtp_timestamp_.reset();
   codec_ = *inst;
 
   // Code expects simulcastStream resolutions to be correct, make sure they are
@@ -627,6 +658,11 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
         GetCpuSpeed(inst->simulcastStream[number_of_streams - 1 - i].width,
                     inst->simulcastStream[number_of_streams - 1 - i].height);
   }
+  initial_cpu_speed_.assign(cpu_speed_.begin(),
+                            cpu_speed_.begin() + number_of_streams);
+  encode_time_ms_.assign(number_of_streams,
+                         rtc::ExpFilter(kEncodeTimeFilterAlpha));
+  frames_since_cpu_speed_change_.assign(number_of_streams, 0);
   vpx_configs_[0].g_w = inst->width;
   vpx_configs_[0].g_h = inst->height;
 
@@ -786,7 +822,26 @@ int LibvpxVp8Encoder::InitAndSetControlSettings() {
   vpx_codec_flags_t flags = 0;
   flags |= VPX_CODEC_USE_OUTPUT_PARTITION;
 
-  if (encoders_.size() > 1) {
+  if (encoders_.size() > 1 && parallel_simulcast_encoding_) {
+    // Independent encoders do not share mode decisions with the higher
+    // resolution layers like a multi-resolution encoder does, but can encode
+    // all layers at the same time.
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      if (libvpx_->codec_enc_init(&encoders_[i], vpx_codec_vp8_cx(),
+                                  &vpx_configs_[i], flags)) {
+        return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+      }
+    }
+    for (size_t i = 1; i < encoders_.size(); ++i) {
+      layer_threads_.push_back(
+          std::make_unique<TaskThread>("Vp8LayerEncoder", rtc::kHighPriority));
+      LayerTask task;
+      task.libvpx = libvpx_.get();
+      task.encoder = &encoders_[i];
+      task.raw_image = &raw_images_[i];
+      layer_tasks_.push_back(task);
+    }
+  } else if (encoders_.size() > 1) {
     int error = libvpx_->codec_enc_init_multi(
         &encoders_[0], vpx_codec_vp8_cx(), &vpx_configs_[0], encoders_.size(),
         flags, &downsampling_factors_[0]);
@@ -965,6 +1020,18 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
 
   if (frame.update_rect().IsEmpty() && num_steady_state_frames_ >= 3 &&
       !key_frame_requested) {
+    // The steady state frames already reached the quality the bitrate allows,
+    // so encoding a frame without updates would only cost cpu. A frame
+    // is still encoded every ScreenshareLayers::kMaxFrameIntervalMs, so that
+    // receivers don't take the stream for frozen.
+    if (skip_unchanged_screenshare_frames_ &&
+        codec_.mode == VideoCodecMode::kScreensharing &&
+        last_encoded_rtp_timestamp_ &&
+        frame.timestamp() - *last_encoded_rtp_timestamp_ <
+            static_cast<uint32_t>(ScreenshareLayers::kMaxFrameIntervalMs *
+                                  kRtpTicksPerMs)) {
+      return WEBRTC_VIDEO_CODEC_OK;
+    }
     if (variable_framerate_experiment_.enabled &&
         framerate_controller_.DropFrame(frame.timestamp() / kRtpTicksPerMs)) {
       return WEBRTC_VIDEO_CODEC_OK;
@@ -1092,8 +1159,7 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Note we must pass 0 for |flags| field in encode call below since they are
     // set above in |libvpx_interface_->vpx_codec_control_| function for each
     // encoder/spatial layer.
-    error = libvpx_->codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
-                                  duration, 0, VPX_DL_REALTIME);
+    error = EncodeLayers(duration);
     // Reset specific intra frame thresholds, following the key frame.
     if (send_key_frame) {
       libvpx_->codec_control(&(encoders_[0]), VP8E_SET_MAX_INTRA_BITRATE_PCT,
@@ -1109,6 +1175,71 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   return error;
 }
 
+int LibvpxVp8Encoder::EncodeLayers(uint32_t duration) {
+  if (layer_threads_.empty()) {
+    // With a multi-resolution encoder, this encodes all layers.
+    const int64_t start_time_us = rtc::TimeMicros();
+    int error = libvpx_->codec_encode(&encoders_[0], &raw_images_[0],
+                                      timestamp_, duration, 0, VPX_DL_REALTIME);
+    // The time of the layers can't be told apart, so all of them are held to
+    // the budget of the whole frame.
+    const int64_t encode_time_us = rtc::TimeMicros() - start_time_us;
+    for (size_t i = 0; i < encoders_.size(); ++i)
+      UpdateCpuSpeed(i, encode_time_us);
+    return error;
+  }
+
+  for (size_t i = 0; i < layer_threads_.size(); ++i) {
+    layer_tasks_[i].pts = timestamp_;
+    layer_tasks_[i].duration = duration;
+    layer_threads_[i]->StartTask(layer_tasks_[i]);
+  }
+  const int64_t start_time_us = rtc::TimeMicros();
+  int error = libvpx_->codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
+                                    duration, 0, VPX_DL_REALTIME);
+  UpdateCpuSpeed(0, rtc::TimeMicros() - start_time_us);
+  // Wait for all layers, since the images are reused for the next frame.
+  for (size_t i = 0; i < layer_threads_.size(); ++i) {
+    layer_threads_[i]->Wait();
+    if (!error)
+      error = layer_tasks_[i].result;
+    UpdateCpuSpeed(i + 1, layer_tasks_[i].encode_time_us);
+  }
+  return error;
+}
+
+void LibvpxVp8Encoder::UpdateCpuSpeed(size_t encoder_idx,
+                                      int64_t encode_time_us) {
+  if (!adaptive_cpu_speed_experiment_.enabled || codec_.maxFramerate == 0)
+    return;
+  rtc::ExpFilter& encode_time_ms = encode_time_ms_[encoder_idx];
+  encode_time_ms.Apply(1.0f, encode_time_us / 1000.0f);
+  if (++frames_since_cpu_speed_change_[encoder_idx] <
+      kMinFramesBetweenCpuSpeedChanges) {
+    return;
+  }
+
+  const double budget_ms =
+      adaptive_cpu_speed_experiment_.max_encode_time_ratio *
+      rtc::kNumMillisecsPerSec / codec_.maxFramerate;
+  // Speeds are negative for real-time encoding, with lower values being
+  // faster.
+  int cpu_speed = cpu_speed_[encoder_idx];
+  if (encode_time_ms.filtered() > budget_ms &&
+      cpu_speed > adaptive_cpu_speed_experiment_.fastest_cpu_speed) {
+    --cpu_speed;
+  } else if (encode_time_ms.filtered() < kCpuSpeedRestoreRatio * budget_ms &&
+             cpu_speed < initial_cpu_speed_[encoder_idx]) {
+    ++cpu_speed;
+  }
+  if (cpu_speed == cpu_speed_[encoder_idx])
+    return;
+
+  cpu_speed_[encoder_idx] = cpu_speed;
+  libvpx_->codec_control(&encoders_[encoder_idx], VP8E_SET_CPUUSED, cpu_speed);
+  frames_since_cpu_speed_change_[encoder_idx] = 0;
+}
+
 void LibvpxVp8Encoder::PopulateCodecSpecific(CodecSpecificInfo* codec_specific,
                                              const vpx_codec_cx_pkt_t& pkt,
                                              int stream_idx,
@@ -1190,6 +1321,7 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
         encoded_images_[encoder_idx].qp_ = qp_128;
         encoded_complete_callback_->OnEncodedImage(encoded_images_[encoder_idx],
                                                    &codec_specific, nullptr);
+        last_encoded_rtp_timestamp_ = input_image.timestamp();
         const size_t steady_state_size = SteadyStateSize(
             stream_idx, codec_specific.codecSpecific.VP8.temporalIdx);
         if (qp_128 > variable_framerate_experiment_.steady_state_qp ||
@@ -1268,6 +1400,21 @@ int LibvpxVp8Encoder::RegisterEncodeCompleteCallback(
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+// static
+LibvpxVp8Encoder::AdaptiveCpuSpeedExperiment
+LibvpxVp8Encoder::ParseAdaptiveCpuSpeedConfig(std::string group_name) {
+  FieldTrialFlag enabled = FieldTrialFlag("Enabled");
+  FieldTrialParameter<double> max_encode_time_ratio("budget", 0.5);
+  FieldTrialParameter<int> fastest_cpu_speed("fastest_speed", -16);
+  ParseFieldTrial({&enabled, &max_encode_time_ratio, &fastest_cpu_speed},
+                  field_trial::FindFullName(group_name));
+  AdaptiveCpuSpeedExperiment config;
+  config.enabled = enabled.Get();
+  config.max_encode_time_ratio = max_encode_time_ratio.Get();
+  config.fastest_cpu_speed = fastest_cpu_speed.Get();
+  return config;
+}
+
 // static
 LibvpxVp8Encoder::VariableFramerateExperiment
 LibvpxVp8Encoder::ParseVariableFramerateConfig(std::string group_name) {
@@ -1286,4 +1433,12 @@ LibvpxVp8Encoder::ParseVariableFramerateConfig(std::string group_name) {
   return config;
 }
 
+void LibvpxVp8Encoder::LayerTask::operator()() {
+  TRACE_EVENT0("webrtc", "LibvpxVp8Encoder::LayerTask");
+  const int64_t start_time_us = rtc::TimeMicros();
+  result = libvpx->codec_encode(encoder, raw_image, pts, duration, 0,
+                                VPX_DL_REALTIME);
+  encode_time_us = rtc::TimeMicros() - start_time_us;
+}
+
 }  // namespace webrtc
@@ -21,12 +21,14 @@
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_frame_buffer_controller.h"
 #include "api/video_codecs/vp8_frame_config.h"
+#include "modules/utility/include/task_thread.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/libvpx_interface.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/framerate_controller.h"
 #include "rtc_base/experiments/cpu_speed_experiment.h"
 #include "rtc_base/experiments/rate_control_settings.h"
+#include "rtc_base/numerics/exp_filter.h"
 #include "vpx/vp8cx.h"
 #include "vpx/vpx_encoder.h"
 
@@ -69,6 +71,23 @@ class LibvpxVp8Encoder : public VideoEncoder {
   static vpx_enc_frame_flags_t EncodeFlags(const Vp8FrameConfig& references);
 
  private:
+  // Encodes the frames of one simulcast layer on one of |layer_threads_|.
+  // Used when the simulcast layers are encoded in parallel.
+  struct LayerTask {
+    // Encodes |raw_image| with |encoder|, and sets |result| to the result of
+    // LibvpxInterface::codec_encode() and |encode_time_us| to the time the
+    // encode took.
+    void operator()();
+
+    LibvpxInterface* libvpx = nullptr;
+    vpx_codec_ctx_t* encoder = nullptr;
+    vpx_image_t* raw_image = nullptr;
+    int64_t pts = 0;
+    uint32_t duration = 0;
+    int result = 0;
+    int64_t encode_time_us = 0;
+  };
+
   // Get the cpu_speed setting for encoder based on resolution and/or platform.
   int GetCpuSpeed(int width, int height);
 
@@ -78,6 +97,14 @@ class LibvpxVp8Encoder : public VideoEncoder {
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings();
 
+  // Encodes the frame in |raw_images_| on all encoders, in parallel if
+  // |layer_threads_| are set up.
+  int EncodeLayers(uint32_t duration);
+
+  // Adapts the cpu_speed of |encoders_[encoder_idx]| to keep its encode time
+  // within the budget of the adaptive cpu speed experiment.
+  void UpdateCpuSpeed(size_t encoder_idx, int64_t encode_time_us);
+
   void PopulateCodecSpecific(CodecSpecificInfo* codec_specific,
                              const vpx_codec_cx_pkt& pkt,
                              int stream_idx,
@@ -126,6 +153,16 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<Vp8EncoderConfig> config_overrides_;
   std::vector<vpx_rational_t> downsampling_factors_;
 
+  // If set, the simulcast layers are encoded by independent libvpx encoders
+  // instead of a multi-resolution encoder, so that they can be encoded in
+  // parallel.
+  const bool parallel_simulcast_encoding_;
+  // One per encoder except |encoders_[0]|, which is encoded on the calling
+  // thread. Empty unless the layers are encoded in parallel.
+  std::vector<std::unique_ptr<TaskThread>> layer_threads_;
+  // The tasks of |layer_threads_|, kept here as the threads don't copy them.
+  std::vector<LayerTask> layer_tasks_;
+
   // Variable frame-rate screencast related fields and methods.
   const struct VariableFramerateExperiment {
     bool enabled = false;
@@ -139,8 +176,30 @@ class LibvpxVp8Encoder : public VideoEncoder {
   } variable_framerate_experiment_;
   static VariableFramerateExperiment ParseVariableFramerateConfig(
       std::string group_name);
+
+  // Closed-loop cpu_speed control, making the encoders faster when their
+  // encode time exceeds a share of the frame interval, and slower again, but
+  // never slower than the speed chosen on InitEncode, when there is headroom.
+  const struct AdaptiveCpuSpeedExperiment {
+    bool enabled = false;
+    // Share of the frame interval that encoding a frame may take.
+    double max_encode_time_ratio = 0.5;
+    // The fastest cpu_speed the control may set.
+    int fastest_cpu_speed = -16;
+  } adaptive_cpu_speed_experiment_;
+  static AdaptiveCpuSpeedExperiment ParseAdaptiveCpuSpeedConfig(
+      std::string group_name);
+  // Per encoder, indexed like |encoders_|.
+  std::vector<int> initial_cpu_speed_;
+  std::vector<rtc::ExpFilter> encode_time_ms_;
+  std::vector<int> frames_since_cpu_speed_change_;
   FramerateController framerate_controller_;
   int num_steady_state_frames_;
+  // If set, screenshare frames without updates are not encoded once the
+  // quality has reached a steady state, except to keep the stream alive.
+  const bool skip_unchanged_screenshare_frames_;
+  // RTP timestamp of the last frame passed to the encoded image callback.
+  absl::optional<uint32_t> last_encoded_rtp_timestamp_;
 
   FecControllerOverride* fec_controller_override_;
 };
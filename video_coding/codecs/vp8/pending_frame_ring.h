@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_VP8_PENDING_FRAME_RING_H_
+#define MODULES_VIDEO_CODING_CODECS_VP8_PENDING_FRAME_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+namespace webrtc {
+
+// Fixed size store of per frame state, keyed by RTP timestamp, for frames
+// handed to the encoder but not yet reported as encoded or dropped. Only a few
+// frames are in flight at a time, so a linear search, starting from the most
+// recently added frame, beats a map and never allocates. A frame is kept
+// until |kCapacity| more frames have been added, which bounds the memory used
+// by frames that the encoder skips without reporting them.
+template <typename T, size_t kCapacity = 32>
+class PendingFrameRing {
+ public:
+  // Adds |frame| for |timestamp|, replacing any frame with the same timestamp.
+  void Insert(uint32_t timestamp, const T& frame) {
+    T* existing = Find(timestamp);
+    if (existing) {
+      *existing = frame;
+      return;
+    }
+    Entry& entry = entries_[next_];
+    entry.in_use = true;
+    entry.timestamp = timestamp;
+    entry.frame = frame;
+    next_ = (next_ + 1) % kCapacity;
+  }
+
+  // Returns the frame for |timestamp|, or null if there is none.
+  T* Find(uint32_t timestamp) {
+    for (size_t i = 1; i <= kCapacity; ++i) {
+      Entry& entry = entries_[(next_ + kCapacity - i) % kCapacity];
+      if (entry.in_use && entry.timestamp == timestamp)
+        return &entry.frame;
+    }
+    return nullptr;
+  }
+
+  // Removes the frame for |timestamp|. Returns false if there is none.
+  bool Erase(uint32_t timestamp) {
+    for (Entry& entry : entries_) {
+      if (entry.in_use && entry.timestamp == timestamp) {
+        entry.in_use = false;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Calls |function| with a pointer to each frame.
+  template <typename Function>
+  void ForEach(Function function) {
+    for (Entry& entry : entries_) {
+      if (entry.in_use)
+        function(&entry.frame);
+    }
+  }
+
+ private:
+  struct Entry {
+    bool in_use = false;
+    uint32_t timestamp = 0;
+    T frame;
+  };
+
+  std::array<Entry, kCapacity> entries_;
+  // Where the next frame is added, i.e. the oldest entry.
+  size_t next_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_VP8_PENDING_FRAME_RING_H_
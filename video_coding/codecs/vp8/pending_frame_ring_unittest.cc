@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/vp8/pending_frame_ring.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(PendingFrameRingTest, FindsInsertedFrames) {
+  PendingFrameRing<int, 4> ring;
+  ring.Insert(1000, 1);
+  ring.Insert(4000, 2);
+  ASSERT_TRUE(ring.Find(1000));
+  EXPECT_EQ(1, *ring.Find(1000));
+  ASSERT_TRUE(ring.Find(4000));
+  EXPECT_EQ(2, *ring.Find(4000));
+  EXPECT_FALSE(ring.Find(7000));
+}
+
+TEST(PendingFrameRingTest, ReplacesFrameWithSameTimestamp) {
+  PendingFrameRing<int, 4> ring;
+  ring.Insert(1000, 1);
+  ring.Insert(1000, 2);
+  EXPECT_EQ(2, *ring.Find(1000));
+  EXPECT_TRUE(ring.Erase(1000));
+  EXPECT_FALSE(ring.Find(1000));
+}
+
+TEST(PendingFrameRingTest, ErasesFrames) {
+  PendingFrameRing<int, 4> ring;
+  ring.Insert(1000, 1);
+  ring.Insert(4000, 2);
+  EXPECT_TRUE(ring.Erase(1000));
+  EXPECT_FALSE(ring.Erase(1000));
+  EXPECT_FALSE(ring.Find(1000));
+  EXPECT_TRUE(ring.Find(4000));
+}
+
+TEST(PendingFrameRingTest, ReplacesOldestFrameWhenFull) {
+  PendingFrameRing<int, 4> ring;
+  for (int i = 0; i < 6; ++i)
+    ring.Insert(i * 3000, i);
+  EXPECT_FALSE(ring.Find(0));
+  EXPECT_FALSE(ring.Find(3000));
+  for (int i = 2; i < 6; ++i) {
+    ASSERT_TRUE(ring.Find(i * 3000));
+    EXPECT_EQ(i, *ring.Find(i * 3000));
+  }
+}
+
+TEST(PendingFrameRingTest, VisitsEachFrame) {
+  PendingFrameRing<int, 4> ring;
+  ring.Insert(1000, 1);
+  ring.Insert(4000, 2);
+  ring.Insert(7000, 3);
+  ring.Erase(4000);
+  int sum = 0;
+  ring.ForEach([&sum](int* frame) {
+    sum += *frame;
+    *frame = 0;
+  });
+  EXPECT_EQ(4, sum);
+  EXPECT_EQ(0, *ring.Find(7000));
+}
+
+}  // namespace webrtc
@@ -102,10 +102,10 @@ Vp8FrameConfig ScreenshareLayers::NextFrameConfig(size_t stream_index,
                                                   uint32_t timestamp) {
   RTC_DCHECK_LT(stream_index, StreamCount());
 
-  auto it = pending_frame_configs_.find(timestamp);
-  if (it != pending_frame_configs_.end()) {
+  const DependencyInfo* pending = pending_frame_configs_.Find(timestamp);
+  if (pending) {
     // Drop and re-encode, reuse the previous config.
-    return it->second.frame_config;
+    return pending->frame_config;
   }
 
   if (number_of_temporal_layers_ <= 1) {
@@ -113,7 +113,7 @@ Vp8FrameConfig ScreenshareLayers::NextFrameConfig(size_t stream_index,
     // TODO(pbos): Consider updating only last, and not all buffers.
     DependencyInfo dependency_info{
         "S", {kReferenceAndUpdate, kReferenceAndUpdate, kReferenceAndUpdate}};
-    pending_frame_configs_[timestamp] = dependency_info;
+    pending_frame_configs_.Insert(timestamp, dependency_info);
     return dependency_info.frame_config;
   }
 
@@ -241,7 +241,7 @@ Vp8FrameConfig ScreenshareLayers::NextFrameConfig(size_t stream_index,
       break;
   }
 
-  pending_frame_configs_[timestamp] = dependency_info;
+  pending_frame_configs_.Insert(timestamp, dependency_info);
   return dependency_info.frame_config;
 }
 
@@ -302,10 +302,10 @@ void ScreenshareLayers::OnEncodeDone(size_t stream_index,
   }
 
   absl::optional<DependencyInfo> dependency_info;
-  auto it = pending_frame_configs_.find(rtp_timestamp);
-  if (it != pending_frame_configs_.end()) {
-    dependency_info = it->second;
-    pending_frame_configs_.erase(it);
+  const DependencyInfo* pending = pending_frame_configs_.Find(rtp_timestamp);
+  if (pending) {
+    dependency_info = *pending;
+    pending_frame_configs_.Erase(rtp_timestamp);
 
     if (checker_) {
       RTC_DCHECK(checker_->CheckTemporalConfig(is_keyframe,
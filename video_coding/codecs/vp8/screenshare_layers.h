@@ -9,7 +9,6 @@
 #ifndef MODULES_VIDEO_CODING_CODECS_VP8_SCREENSHARE_LAYERS_H_
 #define MODULES_VIDEO_CODING_CODECS_VP8_SCREENSHARE_LAYERS_H_
 
-#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -17,6 +16,7 @@
 #include "api/video_codecs/vp8_frame_config.h"
 #include "api/video_codecs/vp8_temporal_layers.h"
 #include "modules/video_coding/codecs/vp8/include/temporal_layers_checker.h"
+#include "modules/video_coding/codecs/vp8/pending_frame_ring.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/frame_dropper.h"
 #include "rtc_base/rate_statistics.h"
@@ -102,7 +102,9 @@ class ScreenshareLayers final : public Vp8FrameBufferController {
   rtc::TimestampWrapAroundHandler time_wrap_handler_;
   uint32_t max_debt_bytes_;
 
-  std::map<uint32_t, DependencyInfo> pending_frame_configs_;
+  // Frames dropped by returning a config without buffers are never reported
+  // back, the ring replaces them eventually.
+  PendingFrameRing<DependencyInfo> pending_frame_configs_;
 
   // Configured max framerate.
   absl::optional<uint32_t> target_framerate_;
@@ -9,6 +9,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include <memory>
 
@@ -31,11 +32,17 @@ namespace webrtc {
 
 using ::testing::_;
 using ::testing::AllOf;
+using ::testing::An;
+using ::testing::DoAll;
 using ::testing::ElementsAreArray;
 using ::testing::Field;
 using ::testing::Invoke;
 using ::testing::NiceMock;
+using ::testing::Property;
 using ::testing::Return;
+using ::testing::SaveArg;
+using ::testing::SetArgPointee;
+using ::testing::TypedEq;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
 using FramerateFractions =
     absl::InlinedVector<uint8_t, webrtc::kMaxTemporalStreams>;
@@ -550,6 +557,199 @@ TEST_F(TestVp8Impl, KeepsTimestampOnReencode) {
   encoder.Encode(*NextInputFrame(), &delta_frame);
 }
 
+TEST_F(TestVp8Impl, ParallelSimulcastEncodingUsesIndependentEncoders) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8-ParallelSimulcastEncoding/Enabled/");
+  codec_settings_.numberOfSimulcastStreams = 3;
+  codec_settings_.simulcastStream[0] = {
+      kWidth / 4, kHeight / 4, kFramerateFps, 1, 4000, 3000, 2000, 80};
+  codec_settings_.simulcastStream[1] = {
+      kWidth / 2, kHeight / 2, kFramerateFps, 1, 4000, 3000, 2000, 80};
+  codec_settings_.simulcastStream[2] = {kWidth, kHeight, kFramerateFps, 1,
+                                        4000,   3000,    2000,          80};
+
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
+  EXPECT_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillOnce(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt, unsigned int d_w,
+                          unsigned int d_h, unsigned int stride_align,
+                          unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  EXPECT_CALL(*vpx, codec_enc_init_multi(_, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(*vpx, codec_enc_init(_, _, _, _)).Times(3);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+  MockEncodedImageCallback callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // Every layer is encoded with its own encoder.
+  EXPECT_CALL(*vpx, codec_encode(_, _, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Return(vpx_codec_err_t::VPX_CODEC_OK));
+  auto delta_frame =
+      std::vector<VideoFrameType>{VideoFrameType::kVideoFrameDelta};
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.Encode(*NextInputFrame(), &delta_frame));
+}
+
+TEST_F(TestVp8Impl, ParallelSimulcastEncodingEncodesAllLayers) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8-ParallelSimulcastEncoding/Enabled/");
+  codec_settings_.numberOfSimulcastStreams = 3;
+  for (int i = 0; i < codec_settings_.numberOfSimulcastStreams; ++i) {
+    codec_settings_.simulcastStream[i].active = true;
+    codec_settings_.simulcastStream[i].minBitrate = 30;
+    codec_settings_.simulcastStream[i].targetBitrate = 300;
+    codec_settings_.simulcastStream[i].maxBitrate = 300;
+    codec_settings_.simulcastStream[i].numberOfTemporalLayers = 1;
+    codec_settings_.simulcastStream[i].width =
+        codec_settings_.width >>
+        (codec_settings_.numberOfSimulcastStreams - i - 1);
+    codec_settings_.simulcastStream[i].height =
+        codec_settings_.height >>
+        (codec_settings_.numberOfSimulcastStreams - i - 1);
+  }
+  codec_settings_.startBitrate = 900;
+  codec_settings_.maxBitrate = 900;
+
+  // |encoder_| was created before the field trial was set.
+  std::unique_ptr<VideoEncoder> encoder = VP8Encoder::Create();
+  MockEncodedImageCallback callback;
+  encoder->RegisterEncodeCompleteCallback(&callback);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder->InitEncode(&codec_settings_, kSettings));
+
+  for (int i = 0; i < codec_settings_.numberOfSimulcastStreams; ++i) {
+    EXPECT_CALL(callback,
+                OnEncodedImage(AllOf(Property(&EncodedImage::SpatialIndex,
+                                              absl::optional<int>(i)),
+                                     Field(&EncodedImage::_frameType,
+                                           VideoFrameType::kVideoFrameKey)),
+                               _, _))
+        .WillOnce(Return(
+            EncodedImageCallback::Result(EncodedImageCallback::Result::OK)));
+  }
+  std::vector<VideoFrameType> frame_types(
+      codec_settings_.numberOfSimulcastStreams, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder->Encode(*NextInputFrame(), &frame_types));
+}
+
+TEST_F(TestVp8Impl, AdaptiveCpuSpeedSpeedsUpSlowEncodes) {
+  // A budget far below the time taken by codec_encode().
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8-AdaptiveCpuSpeed/Enabled,budget:0.01/");
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
+  EXPECT_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillOnce(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt, unsigned int d_w,
+                          unsigned int d_h, unsigned int stride_align,
+                          unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  int initial_cpu_speed = 0;
+  EXPECT_CALL(*vpx, codec_control(_, VP8E_SET_CPUUSED, An<int>()))
+      .WillOnce(DoAll(SaveArg<2>(&initial_cpu_speed),
+                      Return(vpx_codec_err_t::VPX_CODEC_OK)));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+  MockEncodedImageCallback callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  ON_CALL(*vpx, codec_encode(_, _, _, _, _, _))
+      .WillByDefault(Invoke([](vpx_codec_ctx_t*, const vpx_image_t*,
+                               vpx_codec_pts_t, uint64_t, vpx_enc_frame_flags_t,
+                               uint64_t) {
+        const int64_t start_time_us = rtc::TimeMicros();
+        while (rtc::TimeMicros() - start_time_us < 1000) {
+        }
+        return vpx_codec_err_t::VPX_CODEC_OK;
+      }));
+  // The speed is changed once the encode time has been measured for a while,
+  // and then not again until the change has been measured.
+  EXPECT_CALL(*vpx, codec_control(_, VP8E_SET_CPUUSED,
+                                   TypedEq<int>(initial_cpu_speed - 1)))
+      .Times(1);
+  auto delta_frame =
+      std::vector<VideoFrameType>{VideoFrameType::kVideoFrameDelta};
+  for (int i = 0; i < 40; ++i)
+    encoder.Encode(*NextInputFrame(), &delta_frame);
+}
+
+TEST_F(TestVp8Impl, SkipsUnchangedScreenshareFramesInSteadyState) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-VP8-SkipUnchangedScreenshareFrames/Enabled/");
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
+  codec_settings_.mode = VideoCodecMode::kScreensharing;
+  EXPECT_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillOnce(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt, unsigned int d_w,
+                          unsigned int d_h, unsigned int stride_align,
+                          unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, kSettings));
+  NiceMock<MockEncodedImageCallback> callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // Every frame encodes to a few bytes at a low qp, i.e. in steady state. The
+  // first one is a key frame.
+  int num_encodes = 0;
+  uint8_t data[10] = {0};
+  vpx_codec_cx_pkt_t packet;
+  memset(&packet, 0, sizeof(packet));
+  packet.kind = VPX_CODEC_CX_FRAME_PKT;
+  packet.data.frame.buf = data;
+  packet.data.frame.sz = sizeof(data);
+  ON_CALL(*vpx, codec_get_cx_data(_, _))
+      .WillByDefault(Invoke(
+          [&packet, &num_encodes](
+              vpx_codec_ctx_t*,
+              vpx_codec_iter_t* iter) -> const vpx_codec_cx_pkt_t* {
+            if (*iter)
+              return nullptr;
+            *iter = &packet;
+            packet.data.frame.flags = num_encodes == 1 ? VPX_FRAME_IS_KEY : 0;
+            return &packet;
+          }));
+  ON_CALL(*vpx, codec_control(_, VP8E_GET_LAST_QUANTIZER, An<int*>()))
+      .WillByDefault(DoAll(SetArgPointee<2>(10),
+                           Return(vpx_codec_err_t::VPX_CODEC_OK)));
+
+  // Three frames reach the steady state, the unchanged frames after them are
+  // skipped.
+  EXPECT_CALL(*vpx, codec_encode(_, _, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&num_encodes](vpx_codec_ctx_t*,
+                                            const vpx_image_t*, vpx_codec_pts_t,
+                                            uint64_t, vpx_enc_frame_flags_t,
+                                            uint64_t) {
+        ++num_encodes;
+        return vpx_codec_err_t::VPX_CODEC_OK;
+      }));
+  auto delta_frame =
+      std::vector<VideoFrameType>{VideoFrameType::kVideoFrameDelta};
+  for (int i = 0; i < 10; ++i) {
+    VideoFrame frame = *NextInputFrame();
+    frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 0, 0});
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.Encode(frame, &delta_frame));
+  }
+}
+
 TEST_F(TestVp8Impl, GetEncoderInfoFpsAllocationNoLayers) {
   FramerateFractions expected_fps_allocation[kMaxSpatialLayers] = {
       FramerateFractions(1, EncoderInfo::kMaxFramerateFraction)};
@@ -218,6 +218,14 @@ VideoBitrateAllocation SvcRateAllocator::Allocate(
     return VideoBitrateAllocation();  // All layers are deactivated.
   }
 
+  if (cached_allocation_ &&
+      cached_allocation_->total_bitrate == parameters.total_bitrate &&
+      cached_allocation_->stable_bitrate == parameters.stable_bitrate &&
+      cached_allocation_->last_active_layer_count == last_active_layer_count_) {
+    return cached_allocation_->allocation;
+  }
+  const size_t last_active_layer_count = last_active_layer_count_;
+
   // Figure out how many spatial layers should be active.
   if (experiment_settings_.IsEnabled() &&
       parameters.stable_bitrate > DataRate::Zero()) {
@@ -254,6 +262,9 @@ VideoBitrateAllocation SvcRateAllocator::Allocate(
                                             num_spatial_layers);
   }
   allocation.set_bw_limited(num_spatial_layers < num_active_layers);
+  cached_allocation_ =
+      CachedAllocation{parameters.total_bitrate, parameters.stable_bitrate,
+                       last_active_layer_count, allocation};
   return allocation;
 }
 
@@ -15,6 +15,7 @@
 #include <stdint.h>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_bitrate_allocator.h"
 #include "api/video/video_codec_constants.h"
@@ -55,6 +56,18 @@ class SvcRateAllocator : public VideoBitrateAllocator {
   const absl::InlinedVector<DataRate, kMaxSpatialLayers>
       cumulative_layer_start_bitrates_;
   size_t last_active_layer_count_;
+
+  // The result of the last Allocate() call. The allocation only depends on
+  // the requested rates and |last_active_layer_count_|, so it is returned
+  // again while those stay the same, e.g. when rates are set again for a new
+  // framerate.
+  struct CachedAllocation {
+    DataRate total_bitrate;
+    DataRate stable_bitrate;
+    size_t last_active_layer_count;
+    VideoBitrateAllocation allocation;
+  };
+  absl::optional<CachedAllocation> cached_allocation_;
 };
 
 }  // namespace webrtc
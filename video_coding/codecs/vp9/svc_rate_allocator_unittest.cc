@@ -242,6 +242,24 @@ TEST(SvcRateAllocatorTest, SignalsBwLimited) {
           .is_bw_limited());
 }
 
+TEST(SvcRateAllocatorTest, SameRatesGiveSameAllocation) {
+  VideoCodec codec = Configure(1280, 720, 3, 3, false);
+  SvcRateAllocator allocator = SvcRateAllocator(codec);
+
+  const VideoBitrateAllocation low_allocation =
+      allocator.Allocate(VideoBitrateAllocationParameters(300000, 30));
+  const VideoBitrateAllocation high_allocation =
+      allocator.Allocate(VideoBitrateAllocationParameters(1500000, 30));
+  EXPECT_NE(low_allocation, high_allocation);
+
+  EXPECT_EQ(high_allocation,
+            allocator.Allocate(VideoBitrateAllocationParameters(1500000, 15)));
+  EXPECT_EQ(low_allocation,
+            allocator.Allocate(VideoBitrateAllocationParameters(300000, 30)));
+  EXPECT_EQ(low_allocation,
+            allocator.Allocate(VideoBitrateAllocationParameters(300000, 30)));
+}
+
 TEST(SvcRateAllocatorTest, NoPaddingIfAllLayersAreDeactivated) {
   VideoCodec codec = Configure(1280, 720, 3, 1, false);
   EXPECT_EQ(codec.VP9()->numberOfSpatialLayers, 3U);
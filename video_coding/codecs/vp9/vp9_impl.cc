@@ -635,7 +635,14 @@ int VP9EncoderImpl::NumberOfThreads(int width,
                                     int number_of_cores) {
   // Keep the number of encoder threads equal to the possible number of column
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
+  // With row-based multithreading, threads beyond the number of tile columns
+  // still have rows to work on, so large frames may use 8 threads even though
+  // their width allows only 4 tile columns. For SVC, |width| and |height| are
+  // those of the top layer. Lower layers share the threads, and libvpx caps
+  // their tile columns by their own width.
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1280 * 720 && number_of_cores > 4) {
     return 4;
   } else if (width * height >= 640 * 360 && number_of_cores > 2) {
     return 2;
@@ -0,0 +1,244 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/decode_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "modules/video_coding/frame_buffer2.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/trace_event.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+// How long an idle worker sleeps before looking at the streams again, unless
+// it is woken up.
+constexpr int64_t kMaxIdleTimeMs = 60 * 1000;
+}  // namespace
+
+DecodeScheduler::Stream::Stream(FrameBuffer* frame_buffer,
+                                Receiver* receiver,
+                                int64_t max_wait_time_ms,
+                                int64_t now_ms)
+    : frame_buffer(frame_buffer),
+      receiver(receiver),
+      max_wait_time_ms(max_wait_time_ms),
+      latest_return_time_ms(now_ms + max_wait_time_ms) {}
+
+DecodeScheduler::Stream::~Stream() = default;
+
+DecodeScheduler::DecodeScheduler(Clock* clock, int num_workers)
+    : clock_(clock), num_workers_(num_workers), stop_(false) {
+  RTC_DCHECK_GT(num_workers_, 0);
+}
+
+DecodeScheduler::~DecodeScheduler() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  RTC_DCHECK(workers_.empty());
+  RTC_DCHECK(streams_.empty());
+}
+
+void DecodeScheduler::Start() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  RTC_DCHECK(workers_.empty());
+  if (!workers_.empty())
+    return;
+
+  for (int i = 0; i < num_workers_; ++i) {
+    workers_.emplace_back(new rtc::PlatformThread(
+        &DecodeScheduler::Run, this, "DecodeScheduler", rtc::kHighestPriority));
+    workers_.back()->Start();
+  }
+}
+
+void DecodeScheduler::Stop() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (workers_.empty())
+    return;
+
+  {
+    rtc::CritScope lock(&crit_);
+    stop_ = true;
+  }
+
+  wake_up_.Set();
+
+  for (auto& worker : workers_)
+    worker->Stop();
+  workers_.clear();
+
+  rtc::CritScope lock(&crit_);
+  stop_ = false;
+}
+
+void DecodeScheduler::AddStream(FrameBuffer* frame_buffer,
+                                Receiver* receiver,
+                                int64_t max_wait_time_ms) {
+  RTC_DCHECK(frame_buffer);
+  RTC_DCHECK(receiver);
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(!FindStream(frame_buffer));
+    streams_.emplace_back(new Stream(frame_buffer, receiver, max_wait_time_ms,
+                                     clock_->TimeInMilliseconds()));
+  }
+  wake_up_.Set();
+}
+
+void DecodeScheduler::RemoveStream(FrameBuffer* frame_buffer) {
+  std::unique_ptr<Stream> stream;
+  {
+    rtc::CritScope lock(&crit_);
+    auto it = std::find_if(streams_.begin(), streams_.end(),
+                           [frame_buffer](const std::unique_ptr<Stream>& s) {
+                             return s->frame_buffer == frame_buffer;
+                           });
+    RTC_DCHECK(it != streams_.end());
+    if (it == streams_.end())
+      return;
+
+    stream = std::move(*it);
+    streams_.erase(it);
+    if (!stream->in_use)
+      return;
+    stream->removed = true;
+  }
+
+  // A worker is calling into the stream; it signals |released| when done.
+  stream->released.Wait(rtc::Event::kForever);
+}
+
+void DecodeScheduler::SetKeyframeRequired(FrameBuffer* frame_buffer,
+                                          bool keyframe_required) {
+  {
+    rtc::CritScope lock(&crit_);
+    Stream* stream = FindStream(frame_buffer);
+    RTC_DCHECK(stream);
+    if (!stream || stream->keyframe_required == keyframe_required)
+      return;
+    stream->keyframe_required = keyframe_required;
+    stream->update_decode_time = true;
+  }
+  wake_up_.Set();
+}
+
+void DecodeScheduler::WakeUp(FrameBuffer* frame_buffer) {
+  // Allowed to be called on any thread.
+  {
+    rtc::CritScope lock(&crit_);
+    Stream* stream = FindStream(frame_buffer);
+    if (!stream)
+      return;
+    stream->update_decode_time = true;
+  }
+  wake_up_.Set();
+}
+
+// static
+void DecodeScheduler::Run(void* obj) {
+  DecodeScheduler* scheduler = static_cast<DecodeScheduler*>(obj);
+  while (scheduler->Process()) {
+  }
+}
+
+bool DecodeScheduler::Process() {
+  TRACE_EVENT0("webrtc", "DecodeScheduler::Process");
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  int64_t next_checkpoint_ms = now_ms + kMaxIdleTimeMs;
+  Stream* due_stream = nullptr;
+  bool keyframe_required = false;
+  int64_t latest_return_time_ms = 0;
+
+  {
+    rtc::CritScope lock(&crit_);
+    if (stop_) {
+      // Pass the wake up on so that all workers see |stop_|.
+      wake_up_.Set();
+      return false;
+    }
+
+    for (const std::unique_ptr<Stream>& stream : streams_) {
+      if (stream->in_use)
+        continue;
+
+      if (stream->update_decode_time) {
+        stream->decode_time_ms = stream->frame_buffer->NextFrameDecodeTimeMs(
+            stream->keyframe_required);
+        stream->update_decode_time = false;
+      }
+
+      int64_t due_ms = stream->latest_return_time_ms;
+      if (stream->decode_time_ms)
+        due_ms = std::min(due_ms, *stream->decode_time_ms);
+      if (due_ms < next_checkpoint_ms) {
+        next_checkpoint_ms = due_ms;
+        due_stream = stream.get();
+      }
+    }
+
+    if (due_stream && next_checkpoint_ms <= now_ms) {
+      due_stream->in_use = true;
+      keyframe_required = due_stream->keyframe_required;
+      latest_return_time_ms = due_stream->latest_return_time_ms;
+    } else {
+      due_stream = nullptr;
+    }
+  }
+
+  if (!due_stream) {
+    int64_t time_to_wait = next_checkpoint_ms - clock_->TimeInMilliseconds();
+    if (time_to_wait > 0)
+      wake_up_.Wait(static_cast<int>(time_to_wait));
+    return true;
+  }
+
+  std::unique_ptr<EncodedFrame> frame;
+  FrameBuffer::ReturnReason reason =
+      due_stream->frame_buffer->NextFrame(0, &frame, keyframe_required);
+  now_ms = clock_->TimeInMilliseconds();
+
+  // If the frame that was due has been cleared from the frame buffer, this is
+  // not a timeout yet. Look at the stream again on the next round.
+  bool restart_wait = true;
+  if (reason == FrameBuffer::kFrameFound) {
+    due_stream->receiver->OnFrame(std::move(frame));
+  } else if (reason == FrameBuffer::kTimeout &&
+             now_ms >= latest_return_time_ms) {
+    due_stream->receiver->OnTimeout();
+  } else if (reason == FrameBuffer::kTimeout) {
+    restart_wait = false;
+  }
+
+  rtc::CritScope lock(&crit_);
+  due_stream->in_use = false;
+  due_stream->update_decode_time = true;
+  if (restart_wait) {
+    due_stream->latest_return_time_ms =
+        clock_->TimeInMilliseconds() + due_stream->max_wait_time_ms;
+  }
+  if (due_stream->removed)
+    due_stream->released.Set();
+  return true;
+}
+
+DecodeScheduler::Stream* DecodeScheduler::FindStream(
+    FrameBuffer* frame_buffer) {
+  for (const std::unique_ptr<Stream>& stream : streams_) {
+    if (stream->frame_buffer == frame_buffer)
+      return stream.get();
+  }
+  return nullptr;
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_DECODE_SCHEDULER_H_
+#define MODULES_VIDEO_CODING_DECODE_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video/encoded_frame.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/thread_checker.h"
+
+namespace webrtc {
+
+class Clock;
+
+namespace video_coding {
+
+class FrameBuffer;
+
+// Hands out frames from many FrameBuffers using a small number of worker
+// threads, instead of one thread blocked in FrameBuffer::NextFrame per stream.
+// Whenever a worker is free, it serves the stream whose next frame is due for
+// decoding first, as decided by the VCMTiming of that stream.
+class DecodeScheduler {
+ public:
+  class Receiver {
+   public:
+    // Called on a worker thread with the next frame of the stream. Calls for
+    // the same stream never overlap.
+    virtual void OnFrame(std::unique_ptr<EncodedFrame> frame) = 0;
+
+    // Called on a worker thread when the stream has not produced a frame for
+    // its maximum wait time.
+    virtual void OnTimeout() = 0;
+
+   protected:
+    virtual ~Receiver() = default;
+  };
+
+  DecodeScheduler(Clock* clock, int num_workers);
+  ~DecodeScheduler();
+
+  void Start();
+  void Stop();
+
+  // Adds a stream to be served by the workers. |frame_buffer| must only be
+  // read from through this scheduler until it is removed again.
+  void AddStream(FrameBuffer* frame_buffer,
+                 Receiver* receiver,
+                 int64_t max_wait_time_ms);
+
+  // Removes a stream, waiting for an ongoing call to its receiver to return.
+  // Must not be called from within the receiver of that stream.
+  void RemoveStream(FrameBuffer* frame_buffer);
+
+  // Sets whether the next frame of the stream has to be a keyframe.
+  void SetKeyframeRequired(FrameBuffer* frame_buffer, bool keyframe_required);
+
+  // Must be called after a continuous frame has been inserted into
+  // |frame_buffer|, since that may change which frame is due next.
+  void WakeUp(FrameBuffer* frame_buffer);
+
+ private:
+  struct Stream {
+    Stream(FrameBuffer* frame_buffer,
+           Receiver* receiver,
+           int64_t max_wait_time_ms,
+           int64_t now_ms);
+    ~Stream();
+
+    FrameBuffer* const frame_buffer;
+    Receiver* const receiver;
+    const int64_t max_wait_time_ms;
+    bool keyframe_required = false;
+    // When the receiver is told about a timeout if no frame is handed out.
+    int64_t latest_return_time_ms;
+    // Cached result of FrameBuffer::NextFrameDecodeTimeMs, valid unless
+    // |update_decode_time| is set.
+    absl::optional<int64_t> decode_time_ms;
+    bool update_decode_time = true;
+    // Set while a worker is calling into the stream.
+    bool in_use = false;
+    bool removed = false;
+    rtc::Event released;
+  };
+
+  static void Run(void* obj);
+  bool Process();
+
+  Stream* FindStream(FrameBuffer* frame_buffer)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  const int num_workers_;
+  rtc::ThreadChecker thread_checker_;
+
+  rtc::CriticalSection crit_;
+  std::list<std::unique_ptr<Stream>> streams_ RTC_GUARDED_BY(crit_);
+  bool stop_ RTC_GUARDED_BY(crit_);
+
+  rtc::Event wake_up_;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DecodeScheduler);
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_DECODE_SCHEDULER_H_
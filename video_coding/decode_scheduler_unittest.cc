@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/decode_scheduler.h"
+
+#include <memory>
+#include <vector>
+
+#include "modules/video_coding/frame_buffer2.h"
+#include "modules/video_coding/timing.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr int64_t kMaxWaitTimeMs = 200;
+constexpr int kWaitForCallbackMs = 1000;
+
+// Renders every frame |render_offset_ms| after it is first looked at, and wants
+// it handed to the decoder at the render time.
+class VCMTimingFake : public VCMTiming {
+ public:
+  VCMTimingFake(Clock* clock, int64_t render_offset_ms)
+      : VCMTiming(clock), render_offset_ms_(render_offset_ms) {}
+
+  int64_t RenderTimeMs(uint32_t frame_timestamp,
+                       int64_t now_ms) const override {
+    return now_ms + render_offset_ms_;
+  }
+
+  int64_t MaxWaitingTime(int64_t render_time_ms,
+                         int64_t now_ms) const override {
+    return render_time_ms - now_ms;
+  }
+
+ private:
+  const int64_t render_offset_ms_;
+};
+
+class FrameObjectFake : public EncodedFrame {
+ public:
+  int64_t ReceivedTime() const override { return 0; }
+  int64_t RenderTime() const override { return _renderTimeMs; }
+};
+
+std::unique_ptr<FrameObjectFake> CreateKeyFrame(uint16_t picture_id) {
+  auto frame = std::make_unique<FrameObjectFake>();
+  frame->id.picture_id = picture_id;
+  frame->SetTimestamp(picture_id * 3000);
+  frame->is_last_spatial_layer = true;
+  frame->SetEncodedData(EncodedImageBuffer::Create(10));
+  return frame;
+}
+
+// Logs all callbacks of all streams in the order they happen.
+class CallbackLog {
+ public:
+  void Add(int stream_id, int64_t picture_id) {
+    rtc::CritScope lock(&crit_);
+    entries_.push_back({stream_id, picture_id});
+    event_.Set();
+  }
+
+  // Waits until there are at least |num_entries| entries.
+  bool WaitFor(size_t num_entries) {
+    while (true) {
+      {
+        rtc::CritScope lock(&crit_);
+        if (entries_.size() >= num_entries)
+          return true;
+      }
+      if (!event_.Wait(kWaitForCallbackMs))
+        return false;
+    }
+  }
+
+  struct Entry {
+    int stream_id;
+    // -1 for a timeout.
+    int64_t picture_id;
+  };
+
+  std::vector<Entry> entries() {
+    rtc::CritScope lock(&crit_);
+    return entries_;
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  rtc::Event event_;
+  std::vector<Entry> entries_ RTC_GUARDED_BY(crit_);
+};
+
+class TestReceiver : public DecodeScheduler::Receiver {
+ public:
+  TestReceiver(int stream_id, CallbackLog* log)
+      : stream_id_(stream_id), log_(log) {}
+
+  void OnFrame(std::unique_ptr<EncodedFrame> frame) override {
+    log_->Add(stream_id_, frame->id.picture_id);
+  }
+
+  void OnTimeout() override { log_->Add(stream_id_, -1); }
+
+ private:
+  const int stream_id_;
+  CallbackLog* const log_;
+};
+
+// A FrameBuffer with its timing and receiver.
+struct TestStream {
+  TestStream(Clock* clock,
+             int stream_id,
+             int64_t render_offset_ms,
+             CallbackLog* log)
+      : timing(clock, render_offset_ms),
+        frame_buffer(clock, &timing, nullptr),
+        receiver(stream_id, log) {}
+
+  VCMTimingFake timing;
+  FrameBuffer frame_buffer;
+  TestReceiver receiver;
+};
+
+}  // namespace
+
+class TestDecodeScheduler : public ::testing::Test {
+ protected:
+  TestDecodeScheduler() : clock_(1000), scheduler_(&clock_, 1) {}
+
+  ~TestDecodeScheduler() override {
+    scheduler_.Stop();
+    for (auto& stream : streams_)
+      scheduler_.RemoveStream(&stream->frame_buffer);
+  }
+
+  TestStream* AddStream(int64_t render_offset_ms) {
+    streams_.emplace_back(new TestStream(&clock_, streams_.size(),
+                                         render_offset_ms, &log_));
+    TestStream* stream = streams_.back().get();
+    scheduler_.AddStream(&stream->frame_buffer, &stream->receiver,
+                         kMaxWaitTimeMs);
+    return stream;
+  }
+
+  void InsertKeyFrame(TestStream* stream, uint16_t picture_id) {
+    stream->frame_buffer.InsertFrame(CreateKeyFrame(picture_id));
+    scheduler_.WakeUp(&stream->frame_buffer);
+  }
+
+  SimulatedClock clock_;
+  DecodeScheduler scheduler_;
+  CallbackLog log_;
+  std::vector<std::unique_ptr<TestStream>> streams_;
+};
+
+TEST_F(TestDecodeScheduler, ServesEarliestDeadlineFirst) {
+  TestStream* late = AddStream(-1);
+  TestStream* later = AddStream(-3);
+  TestStream* latest = AddStream(-2);
+  InsertKeyFrame(late, 10);
+  InsertKeyFrame(later, 20);
+  InsertKeyFrame(latest, 30);
+
+  scheduler_.Start();
+  ASSERT_TRUE(log_.WaitFor(3));
+
+  std::vector<CallbackLog::Entry> entries = log_.entries();
+  EXPECT_EQ(20, entries[0].picture_id);
+  EXPECT_EQ(30, entries[1].picture_id);
+  EXPECT_EQ(10, entries[2].picture_id);
+}
+
+TEST_F(TestDecodeScheduler, WaitsUntilFrameIsDue) {
+  TestStream* stream = AddStream(50);
+  scheduler_.Start();
+  InsertKeyFrame(stream, 10);
+
+  rtc::Event().Wait(20);
+  EXPECT_TRUE(log_.entries().empty());
+
+  clock_.AdvanceTimeMilliseconds(50);
+  scheduler_.WakeUp(&stream->frame_buffer);
+  ASSERT_TRUE(log_.WaitFor(1));
+  EXPECT_EQ(10, log_.entries()[0].picture_id);
+}
+
+TEST_F(TestDecodeScheduler, ReportsTimeout) {
+  TestStream* stream = AddStream(0);
+  scheduler_.Start();
+
+  clock_.AdvanceTimeMilliseconds(kMaxWaitTimeMs);
+  scheduler_.WakeUp(&stream->frame_buffer);
+  ASSERT_TRUE(log_.WaitFor(1));
+  EXPECT_EQ(0, log_.entries()[0].stream_id);
+  EXPECT_EQ(-1, log_.entries()[0].picture_id);
+}
+
+TEST_F(TestDecodeScheduler, ServesManyStreamsWithFewWorkers) {
+  const int kNumStreams = 50;
+  const int kNumFrames = 10;
+  for (int i = 0; i < kNumStreams; ++i)
+    AddStream(0);
+  scheduler_.Start();
+
+  for (int f = 0; f < kNumFrames; ++f) {
+    for (auto& stream : streams_)
+      InsertKeyFrame(stream.get(), f);
+    ASSERT_TRUE(log_.WaitFor((f + 1) * kNumStreams));
+  }
+
+  std::vector<int> frames_per_stream(kNumStreams);
+  for (const CallbackLog::Entry& entry : log_.entries()) {
+    EXPECT_NE(-1, entry.picture_id);
+    ++frames_per_stream[entry.stream_id];
+  }
+  for (int num_frames : frames_per_stream)
+    EXPECT_EQ(kNumFrames, num_frames);
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
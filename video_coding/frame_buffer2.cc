@@ -61,6 +61,7 @@ FrameBuffer::FrameBuffer(Clock* clock,
       protection_mode_(kProtectionNack),
       stats_callback_(stats_callback),
       last_log_non_decoded_ms_(-kLogNonDecodedIntervalMs),
+      byte_limit_(0),
       add_rtt_to_playout_delay_(
           webrtc::field_trial::IsEnabled("WebRTC-AddRttToPlayoutDelay")),
       rtt_mult_settings_(RttMultExperiment::GetRttMultValue()) {}
@@ -160,19 +161,34 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
   return kTimeout;
 }
 
+absl::optional<int64_t> FrameBuffer::NextFrameDecodeTimeMs(
+    bool keyframe_required) {
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(!callback_queue_);
+  if (stopped_)
+    return absl::nullopt;
+
+  keyframe_required_ = keyframe_required;
+  latest_return_time_ms_ = now_ms;
+  FindNextFrame(now_ms);
+  if (frames_to_decode_.empty())
+    return absl::nullopt;
+
+  const EncodedFrame& frame = *frames_to_decode_[0]->second.frame;
+  return now_ms + timing_->MaxWaitingTime(frame.RenderTime(), now_ms);
+}
+
 int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
   int64_t wait_ms = latest_return_time_ms_ - now_ms;
   frames_to_decode_.clear();
 
-  // |last_continuous_frame_| may be empty below, but nullopt is smaller
-  // than everything else and loop will immediately terminate as expected.
-  for (auto frame_it = frames_.begin();
-       frame_it != frames_.end() && frame_it->first <= last_continuous_frame_;
-       ++frame_it) {
-    if (!frame_it->second.continuous ||
-        frame_it->second.num_missing_decodable > 0) {
-      continue;
-    }
+  // Only frames that are continuous and have all their references decoded can
+  // start the next superframe, and those are exactly |decodable_frames_|.
+  for (const auto& decodable_frame : decodable_frames_) {
+    FrameMap::iterator frame_it = decodable_frame.second;
+    RTC_DCHECK(frame_it->second.continuous);
+    RTC_DCHECK_EQ(frame_it->second.num_missing_decodable, 0U);
 
     EncodedFrame* frame = frame_it->second.frame.get();
 
@@ -275,6 +291,7 @@ EncodedFrame* FrameBuffer::GetNextFrame() {
   for (FrameMap::iterator& frame_it : frames_to_decode_) {
     RTC_DCHECK(frame_it != frames_.end());
     EncodedFrame* frame = frame_it->second.frame.release();
+    memory_usage_.Remove(frame->size());
 
     frame->SetRenderTime(render_time_ms);
 
@@ -286,17 +303,19 @@ EncodedFrame* FrameBuffer::GetNextFrame() {
     decoded_frames_history_.InsertDecoded(frame_it->first, frame->Timestamp());
 
     // Remove decoded frame and all undecoded frames before it.
-    if (stats_callback_) {
-      unsigned int dropped_frames = std::count_if(
-          frames_.begin(), frame_it,
-          [](const std::pair<const VideoLayerFrameId, FrameInfo>& frame) {
-            return frame.second.frame != nullptr;
-          });
-      if (dropped_frames > 0) {
-        stats_callback_->OnDroppedFrames(dropped_frames);
+    unsigned int dropped_frames = 0;
+    for (auto it = frames_.begin(); it != frame_it; ++it) {
+      if (it->second.frame) {
+        ++dropped_frames;
+        memory_usage_.Remove(it->second.frame->size());
       }
     }
+    if (stats_callback_ && dropped_frames > 0) {
+      stats_callback_->OnDroppedFrames(dropped_frames);
+    }
 
+    decodable_frames_.erase(decodable_frames_.begin(),
+                            decodable_frames_.upper_bound(frame_it->first));
     frames_.erase(frames_.begin(), ++frame_it);
 
     frames_out.push_back(frame);
@@ -387,6 +406,16 @@ void FrameBuffer::Clear() {
   ClearFramesAndHistory();
 }
 
+void FrameBuffer::SetByteLimit(size_t byte_limit) {
+  rtc::CritScope lock(&crit_);
+  byte_limit_ = byte_limit;
+}
+
+BufferMemoryUsage FrameBuffer::GetMemoryUsage() const {
+  rtc::CritScope lock(&crit_);
+  return memory_usage_;
+}
+
 void FrameBuffer::UpdateRtt(int64_t rtt_ms) {
   rtc::CritScope lock(&crit_);
   jitter_estimator_.UpdateRtt(rtt_ms);
@@ -476,7 +505,9 @@ int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
     return last_continuous_picture_id;
   }
 
-  if (frames_.size() >= kMaxFramesBuffered) {
+  if (frames_.size() >= kMaxFramesBuffered ||
+      (byte_limit_ > 0 &&
+       memory_usage_.bytes + frame->size() > byte_limit_)) {
     if (frame->is_keyframe()) {
       RTC_LOG(LS_WARNING) << "Inserting keyframe (picture_id:spatial_id) ("
                           << id.picture_id << ":"
@@ -553,6 +584,7 @@ int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
                                      frame->contentType());
   }
 
+  memory_usage_.Add(frame->size());
   info->second.frame = std::move(frame);
 
   if (info->second.num_missing_continuous == 0) {
@@ -594,6 +626,7 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
     if (!last_continuous_frame_ || *last_continuous_frame_ < frame->first) {
       last_continuous_frame_ = frame->first;
     }
+    MaybeAddDecodableFrame(frame);
 
     // Loop through all dependent frames, and if that frame no longer has
     // any unfulfilled dependencies then that frame is continuous as well.
@@ -622,10 +655,16 @@ void FrameBuffer::PropagateDecodability(const FrameInfo& info) {
     if (ref_info != frames_.end()) {
       RTC_DCHECK_GT(ref_info->second.num_missing_decodable, 0U);
       --ref_info->second.num_missing_decodable;
+      MaybeAddDecodableFrame(ref_info);
     }
   }
 }
 
+void FrameBuffer::MaybeAddDecodableFrame(FrameMap::iterator frame) {
+  if (frame->second.continuous && frame->second.num_missing_decodable == 0)
+    decodable_frames_.emplace(frame->first, frame);
+}
+
 bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
                                                    FrameMap::iterator info) {
   TRACE_EVENT0("webrtc", "FrameBuffer::UpdateFrameInfoWithIncomingFrame");
@@ -745,6 +784,8 @@ void FrameBuffer::ClearFramesAndHistory() {
     }
   }
   frames_.clear();
+  memory_usage_.Clear();
+  decodable_frames_.clear();
   last_continuous_frame_.reset();
   frames_to_decode_.clear();
   decoded_frames_history_.Clear();
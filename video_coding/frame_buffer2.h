@@ -18,7 +18,9 @@
 #include <vector>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 #include "api/video/encoded_frame.h"
+#include "modules/include/module_common_types_public.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/inter_frame_delay.h"
 #include "modules/video_coding/jitter_estimator.h"
@@ -72,6 +74,11 @@ class FrameBuffer {
       rtc::TaskQueue* callback_queue,
       std::function<void(std::unique_ptr<EncodedFrame>, ReturnReason)> handler);
 
+  // Returns the time at which the frame that NextFrame would return should be
+  // handed to the decoder, or nullopt if there is no decodable frame. Does not
+  // wait, and must not be used while an asynchronous NextFrame is pending.
+  absl::optional<int64_t> NextFrameDecodeTimeMs(bool keyframe_required);
+
   // Tells the FrameBuffer which protection mode that is in use. Affects
   // the frame timing.
   // TODO(philipel): Remove this when new timing calculations has been
@@ -92,6 +99,13 @@ class FrameBuffer {
   // Clears the FrameBuffer, removing all the buffered frames.
   void Clear();
 
+  // Caps the bytes of the buffered frames. A frame that would take the buffer
+  // above |byte_limit| is handled as if the buffer was full: a key frame clears
+  // the buffer, other frames are dropped. A |byte_limit| of 0 is equivalent to
+  // no limit.
+  void SetByteLimit(size_t byte_limit);
+  BufferMemoryUsage GetMemoryUsage() const;
+
  private:
   struct FrameInfo {
     FrameInfo();
@@ -121,6 +135,9 @@ class FrameBuffer {
   };
 
   using FrameMap = std::map<VideoLayerFrameId, FrameInfo>;
+  // Continuous frames that have all their references decoded, in the same
+  // order as in the |frames_|.
+  using DecodableFrameMap = std::map<VideoLayerFrameId, FrameMap::iterator>;
 
   // Check that the references of |frame| are valid.
   bool ValidReferences(const EncodedFrame& frame) const;
@@ -140,6 +157,11 @@ class FrameBuffer {
   void PropagateDecodability(const FrameInfo& info)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Adds |frame| to |decodable_frames_| if it is continuous and all its
+  // references have been decoded.
+  void MaybeAddDecodableFrame(FrameMap::iterator frame)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Update the corresponding FrameInfo of |frame| and all FrameInfos that
   // |frame| references.
   // Return false if |frame| will never be decodable, true otherwise.
@@ -169,6 +191,9 @@ class FrameBuffer {
 
   // Stores only undecoded frames.
   FrameMap frames_ RTC_GUARDED_BY(crit_);
+  // Candidates for the next frame to decode, so that NextFrame doesn't have to
+  // walk past frames that are still waiting for their references.
+  DecodableFrameMap decodable_frames_ RTC_GUARDED_BY(crit_);
   DecodedFramesHistory decoded_frames_history_ RTC_GUARDED_BY(crit_);
 
   rtc::CriticalSection crit_;
@@ -192,6 +217,8 @@ class FrameBuffer {
   VCMVideoProtection protection_mode_ RTC_GUARDED_BY(crit_);
   VCMReceiveStatisticsCallback* const stats_callback_;
   int64_t last_log_non_decoded_ms_ RTC_GUARDED_BY(crit_);
+  size_t byte_limit_ RTC_GUARDED_BY(crit_);
+  BufferMemoryUsage memory_usage_ RTC_GUARDED_BY(crit_);
 
   const bool add_rtt_to_playout_delay_;
 
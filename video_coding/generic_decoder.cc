@@ -26,6 +26,16 @@
 
 namespace webrtc {
 
+namespace {
+// The number of frames that may be waiting for decoder output. One less than
+// the capacity of the timestamp map, so that no entry is forgotten while its
+// frame is still being decoded.
+const size_t kMaxFramesInFlight = kDecoderFrameMemoryLength - 1;
+// How long a decode may wait for the decoder to release a frame before the
+// oldest frame in flight is given up on.
+const int kMaxWaitForFrameReleaseMs = 20;
+}  // namespace
+
 VCMDecodedFrameCallback::VCMDecodedFrameCallback(VCMTiming* timing,
                                                  Clock* clock)
     : _clock(clock),
@@ -87,6 +97,7 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
     rtc::CritScope cs(&lock_);
     frameInfo = _timestampMap.Pop(decodedImage.timestamp());
   }
+  frame_released_.Set();
 
   if (frameInfo == NULL) {
     RTC_LOG(LS_WARNING) << "Too many frames backed up in the decoder, dropping "
@@ -173,14 +184,33 @@ void VCMDecodedFrameCallback::Map(uint32_t timestamp,
 }
 
 int32_t VCMDecodedFrameCallback::Pop(uint32_t timestamp) {
-  rtc::CritScope cs(&lock_);
-  if (_timestampMap.Pop(timestamp) == NULL) {
-    return VCM_GENERAL_ERROR;
+  {
+    rtc::CritScope cs(&lock_);
+    if (_timestampMap.Pop(timestamp) == NULL) {
+      return VCM_GENERAL_ERROR;
+    }
   }
+  frame_released_.Set();
   _receiveCallback->OnDroppedFrames(1);
   return VCM_OK;
 }
 
+bool VCMDecodedFrameCallback::WaitForFramesInFlightBelow(
+    size_t max_frames_in_flight,
+    int timeout_ms) {
+  const int64_t deadline_ms = rtc::TimeMillis() + timeout_ms;
+  while (true) {
+    {
+      rtc::CritScope cs(&lock_);
+      if (_timestampMap.Size() < max_frames_in_flight)
+        return true;
+    }
+    const int64_t wait_ms = deadline_ms - rtc::TimeMillis();
+    if (wait_ms <= 0 || !frame_released_.Wait(wait_ms))
+      return false;
+  }
+}
+
 VCMGenericDecoder::VCMGenericDecoder(std::unique_ptr<VideoDecoder> decoder)
     : VCMGenericDecoder(decoder.release(), false /* isExternal */) {}
 
@@ -213,6 +243,12 @@ int32_t VCMGenericDecoder::InitDecode(const VideoCodec* settings,
 int32_t VCMGenericDecoder::Decode(const VCMEncodedFrame& frame, int64_t nowMs) {
   TRACE_EVENT1("webrtc", "VCMGenericDecoder::Decode", "timestamp",
                frame.Timestamp());
+  // Don't reuse the information of a frame the decoder still holds.
+  if (!_callback->WaitForFramesInFlightBelow(kMaxFramesInFlight,
+                                             kMaxWaitForFrameReleaseMs)) {
+    RTC_LOG(LS_WARNING) << "Too many frames in flight in the decoder, the "
+                           "oldest one will be dropped.";
+  }
   _frameInfos[_nextFrameInfoIdx].decodeStartTimeMs = nowMs;
   _frameInfos[_nextFrameInfoIdx].renderTimeMs = frame.RenderTimeMs();
   _frameInfos[_nextFrameInfoIdx].rotation = frame.rotation();
@@ -19,6 +19,7 @@
 #include "modules/video_coding/timestamp_map.h"
 #include "modules/video_coding/timing.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/thread_checker.h"
 
@@ -58,6 +59,12 @@ class VCMDecodedFrameCallback : public DecodedImageCallback {
   void Map(uint32_t timestamp, VCMFrameInformation* frameInfo);
   int32_t Pop(uint32_t timestamp);
 
+  // Blocks until fewer than |max_frames_in_flight| mapped frames are waiting
+  // for output from the decoder, or until |timeout_ms| has passed. Returns
+  // false on timeout. Decoders that deliver their output asynchronously may
+  // keep several frames in flight; synchronous decoders never block here.
+  bool WaitForFramesInFlightBelow(size_t max_frames_in_flight, int timeout_ms);
+
  private:
   rtc::ThreadChecker construction_thread_;
   // Protect |_timestampMap|.
@@ -71,6 +78,8 @@ class VCMDecodedFrameCallback : public DecodedImageCallback {
   VCMTiming* _timing;
   rtc::CriticalSection lock_;
   VCMTimestampMap _timestampMap RTC_GUARDED_BY(lock_);
+  // Signaled every time a frame is popped from |_timestampMap|.
+  rtc::Event frame_released_;
   int64_t ntp_offset_;
   // Set by the field trial WebRTC-SlowDownDecoder to simulate a slow decoder.
   FieldTrialOptional<TimeDelta> _extra_decode_time;
@@ -35,6 +35,7 @@ class ReceiveCallback : public VCMReceiveCallback {
     {
       rtc::CritScope cs(&lock_);
       last_frame_ = videoFrame;
+      ++num_frames_;
     }
     received_frame_event_.Set();
     return 0;
@@ -45,6 +46,11 @@ class ReceiveCallback : public VCMReceiveCallback {
     return last_frame_;
   }
 
+  int num_frames() {
+    rtc::CritScope cs(&lock_);
+    return num_frames_;
+  }
+
   absl::optional<VideoFrame> WaitForFrame(int64_t wait_ms) {
     if (received_frame_event_.Wait(wait_ms)) {
       rtc::CritScope cs(&lock_);
@@ -58,6 +64,7 @@ class ReceiveCallback : public VCMReceiveCallback {
   rtc::CriticalSection lock_;
   rtc::Event received_frame_event_;
   absl::optional<VideoFrame> last_frame_ RTC_GUARDED_BY(lock_);
+  int num_frames_ RTC_GUARDED_BY(lock_) = 0;
 };
 
 class GenericDecoderTest : public ::testing::Test {
@@ -115,5 +122,22 @@ TEST_F(GenericDecoderTest, PassesPacketInfosForDelayedDecoders) {
   EXPECT_EQ(decoded_frame->packet_infos().size(), 3U);
 }
 
+TEST_F(GenericDecoderTest, DeliversAllFramesFromDelayedDecoders) {
+  const int kNumFrames = 3 * kDecoderFrameMemoryLength;
+  decoder_.SetDelayedDecoding(5);
+
+  for (int i = 0; i < kNumFrames; ++i) {
+    VCMEncodedFrame encoded_frame;
+    encoded_frame.SetTimestamp(90 * i);
+    generic_decoder_.Decode(encoded_frame, clock_.TimeInMilliseconds());
+  }
+
+  // Decoding is held back while the decoder has too many frames in flight,
+  // so none of them is forgotten before its output arrives.
+  for (int i = 0; i < 100 && user_callback_.num_frames() < kNumFrames; ++i)
+    user_callback_.WaitForFrame(10);
+  EXPECT_EQ(kNumFrames, user_callback_.num_frames());
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
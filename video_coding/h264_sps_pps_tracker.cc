@@ -127,17 +127,22 @@ H264SpsPpsTracker::PacketAction H264SpsPpsTracker::CopyAndFixBitstream(
   }
 
   if (h264_header.packetization_type == kH264StapA) {
-    const uint8_t* nalu_ptr = data + 1;
-    while (nalu_ptr < data + data_size) {
+    // Validate the segments while sizing them, so that a malformed packet is
+    // dropped before anything is allocated and the copy below needs no
+    // bounds checks.
+    size_t offset = 1;
+    while (offset < data_size) {
       RTC_DCHECK(video_header.is_first_packet_in_frame);
-      required_size += sizeof(start_code_h264);
-
       // The first two bytes describe the length of a segment.
-      uint16_t segment_length = nalu_ptr[0] << 8 | nalu_ptr[1];
-      nalu_ptr += 2;
+      if (offset + 2 > data_size)
+        return kDrop;
+      uint16_t segment_length = data[offset] << 8 | data[offset + 1];
+      offset += 2;
+      if (offset + segment_length > data_size)
+        return kDrop;
 
-      required_size += segment_length;
-      nalu_ptr += segment_length;
+      required_size += sizeof(start_code_h264) + segment_length;
+      offset += segment_length;
     }
   } else {
     if (h264_header.nalus_length > 0) {
@@ -192,12 +197,6 @@ H264SpsPpsTracker::PacketAction H264SpsPpsTracker::CopyAndFixBitstream(
       uint16_t segment_length = nalu_ptr[0] << 8 | nalu_ptr[1];
       nalu_ptr += 2;
 
-      size_t copy_end = nalu_ptr - data + segment_length;
-      if (copy_end > data_size) {
-        delete[] buffer;
-        return kDrop;
-      }
-
       memcpy(insert_at, nalu_ptr, segment_length);
       insert_at += segment_length;
       nalu_ptr += segment_length;
@@ -212,6 +211,9 @@ H264SpsPpsTracker::PacketAction H264SpsPpsTracker::CopyAndFixBitstream(
 
   packet->dataPtr = buffer;
   packet->sizeBytes = required_size;
+  // |buffer| is owned by the holder of the packet, like any payload that
+  // isn't shared, so the packet must no longer refer to a shared buffer.
+  packet->payload_buffer = rtc::CopyOnWriteBuffer();
   return kInsert;
 }
 
@@ -15,10 +15,12 @@
 #include <vector>
 
 #include "absl/types/variant.h"
+#include "api/array_view.h"
 #include "common_video/h264/h264_common.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
 #include "modules/video_coding/codecs/h264/include/h264_globals.h"
 #include "modules/video_coding/packet.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -151,6 +153,17 @@ TEST_F(TestH264SpsPpsTracker, StapAIncorrectSegmentLength) {
   EXPECT_EQ(H264SpsPpsTracker::kDrop, tracker_.CopyAndFixBitstream(&packet));
 }
 
+TEST_F(TestH264SpsPpsTracker, StapATruncatedSegmentLength) {
+  uint8_t data[] = {0, 0, 1, 0xAB, 0};
+  H264VcmPacket packet;
+  packet.h264().packetization_type = kH264StapA;
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.dataPtr = data;
+  packet.sizeBytes = sizeof(data);
+
+  EXPECT_EQ(H264SpsPpsTracker::kDrop, tracker_.CopyAndFixBitstream(&packet));
+}
+
 TEST_F(TestH264SpsPpsTracker, SingleNaluInsertStartCode) {
   uint8_t data[] = {1, 2, 3};
   H264VcmPacket packet;
@@ -318,6 +331,39 @@ TEST_F(TestH264SpsPpsTracker, SpsPpsOutOfBand) {
   }
 }
 
+TEST_F(TestH264SpsPpsTracker, SpsPpsInsertedIntoSharedPayloadDropsBuffer) {
+  const std::vector<uint8_t> sps(
+      {0x67, 0x7a, 0x00, 0x0d, 0xbc, 0xd9, 0x41, 0x41, 0xfa, 0x10, 0x00, 0x00,
+       0x03, 0x00, 0x10, 0x00, 0x00, 0x03, 0x03, 0xc0, 0xf1, 0x42, 0x99, 0x60});
+  const std::vector<uint8_t> pps({0x68, 0xeb, 0xe3, 0xcb, 0x22, 0xc0});
+  tracker_.InsertSpsPpsNalus(sps, pps);
+
+  // The payload follows a 12 byte RTP header in the received buffer.
+  const uint8_t kRtpPacket[] = {0x80, 96, 0, 1, 0, 0, 0, 2,
+                                0,    0,  0, 3, 1, 2, 3};
+  rtc::CopyOnWriteBuffer rtp_packet(kRtpPacket, sizeof(kRtpPacket));
+  H264VcmPacket idr_packet;
+  idr_packet.video_header.is_first_packet_in_frame = true;
+  AddIdr(&idr_packet, 0);
+  ASSERT_TRUE(idr_packet.SetSharedPayload(
+      rtp_packet, rtc::ArrayView<const uint8_t>(rtp_packet.cdata() + 12, 3)));
+
+  EXPECT_EQ(H264SpsPpsTracker::kInsert,
+            tracker_.CopyAndFixBitstream(&idr_packet));
+  ExpectSpsPpsIdr(idr_packet.h264(), 0, 0);
+  // The packet now holds a copy with SPS and PPS prepended, which the holder
+  // of the packet must free, so it must not refer to the shared buffer.
+  EXPECT_EQ(nullptr, idr_packet.payload_buffer.cdata());
+  EXPECT_FALSE(idr_packet.dataPtr >= rtp_packet.cdata() &&
+               idr_packet.dataPtr < rtp_packet.cdata() + rtp_packet.size());
+  const uint8_t kIdrData[] = {1, 2, 3};
+  ASSERT_GE(idr_packet.sizeBytes, sizeof(kIdrData));
+  EXPECT_EQ(0, memcmp(idr_packet.dataPtr + idr_packet.sizeBytes -
+                          sizeof(kIdrData),
+                      kIdrData, sizeof(kIdrData)));
+  delete[] idr_packet.dataPtr;
+}
+
 TEST_F(TestH264SpsPpsTracker, SpsPpsOutOfBandWrongNaluHeader) {
   constexpr uint8_t kData[] = {1, 2, 3};
 
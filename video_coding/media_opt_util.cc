@@ -311,17 +311,58 @@ bool VCMFecMethod::ProtectionFactor(const VCMProtectionParameters* parameters) {
   const uint8_t ratePar1 = 5;
   const uint8_t ratePar2 = 49;
 
-  // Spatial resolution size, relative to a reference size.
-  float spatialSizeToRef = rtc::saturated_cast<float>(parameters->codecWidth *
-                                                      parameters->codecHeight) /
-                           (rtc::saturated_cast<float>(704 * 576));
-  // resolnFac: This parameter will generally increase/decrease the FEC rate
-  // (for fixed bitRate and packetLoss) based on system size.
-  // Use a smaller exponent (< 1) to control/soften system size effect.
-  const float resolnFac = 1.0 / powf(spatialSizeToRef, 0.3f);
+  if (!resoln_fac_valid_ || parameters->codecWidth != resoln_fac_width_ ||
+      parameters->codecHeight != resoln_fac_height_) {
+    // Spatial resolution size, relative to a reference size.
+    float spatialSizeToRef =
+        rtc::saturated_cast<float>(parameters->codecWidth *
+                                   parameters->codecHeight) /
+        (rtc::saturated_cast<float>(704 * 576));
+    // resolnFac: This parameter will generally increase/decrease the FEC rate
+    // (for fixed bitRate and packetLoss) based on system size.
+    // Use a smaller exponent (< 1) to control/soften system size effect.
+    resoln_fac_ = 1.0 / powf(spatialSizeToRef, 0.3f);
+    resoln_fac_width_ = parameters->codecWidth;
+    resoln_fac_height_ = parameters->codecHeight;
+    resoln_fac_valid_ = true;
+  }
+  const float resolnFac = resoln_fac_;
 
   const int bitRatePerFrame = BitsPerFrame(parameters);
 
+  // Get index for table: the FEC protection depends on an effective rate.
+  // The range on the rate index corresponds to rates (bps)
+  // from ~200k to ~8000k, for 30fps
+  const uint16_t effRateFecTable =
+      rtc::saturated_cast<uint16_t>(resolnFac * bitRatePerFrame);
+
+  // Restrict packet loss range to 50:
+  // current tables defined only up to 50%
+  if (packetLoss >= kPacketLossMax) {
+    packetLoss = kPacketLossMax - 1;
+  }
+
+  const uint8_t packetFrameDelta =
+      rtc::saturated_cast<uint8_t>(0.5 + parameters->packetsPerFrame);
+  const uint8_t packetFrameKey =
+      rtc::saturated_cast<uint8_t>(0.5 + parameters->packetsPerFrameKey);
+
+  // The protection factors only depend on the values above, reuse them if
+  // these are the same as for the last computation.
+  ProtectionFactorCache& cache = protection_factor_cache_;
+  if (cache.valid && cache.packet_loss == packetLoss &&
+      cache.bits_per_frame == bitRatePerFrame &&
+      cache.eff_rate_fec_table == effRateFecTable &&
+      cache.packets_per_frame_delta == packetFrameDelta &&
+      cache.packets_per_frame_key == packetFrameKey &&
+      cache.max_payload_size == _maxPayloadSize &&
+      cache.scale_prot_key == _scaleProtKey) {
+    _protectionFactorK = cache.protection_factor_k;
+    _protectionFactorD = cache.protection_factor_d;
+    _corrFecCost = cache.corr_fec_cost;
+    return true;
+  }
+
   // Average number of packets per frame (source and fec):
   const uint8_t avgTotPackets = rtc::saturated_cast<uint8_t>(
       1.5f + rtc::saturated_cast<float>(bitRatePerFrame) * 1000.0f /
@@ -331,19 +372,9 @@ bool VCMFecMethod::ProtectionFactor(const VCMProtectionParameters* parameters) {
   uint8_t codeRateDelta = 0;
   uint8_t codeRateKey = 0;
 
-  // Get index for table: the FEC protection depends on an effective rate.
-  // The range on the rate index corresponds to rates (bps)
-  // from ~200k to ~8000k, for 30fps
-  const uint16_t effRateFecTable =
-      rtc::saturated_cast<uint16_t>(resolnFac * bitRatePerFrame);
   uint8_t rateIndexTable = rtc::saturated_cast<uint8_t>(
       VCM_MAX(VCM_MIN((effRateFecTable - ratePar1) / ratePar1, ratePar2), 0));
 
-  // Restrict packet loss range to 50:
-  // current tables defined only up to 50%
-  if (packetLoss >= kPacketLossMax) {
-    packetLoss = kPacketLossMax - 1;
-  }
   uint16_t indexTable = rateIndexTable * kPacketLossMax + packetLoss;
 
   // Check on table index
@@ -368,10 +399,6 @@ bool VCMFecMethod::ProtectionFactor(const VCMProtectionParameters* parameters) {
   // Effectively at a higher rate, so we scale/boost the rate
   // The boost factor may depend on several factors: ratio of packet
   // number of I to P frames, how much protection placed on P frames, etc.
-  const uint8_t packetFrameDelta =
-      rtc::saturated_cast<uint8_t>(0.5 + parameters->packetsPerFrame);
-  const uint8_t packetFrameKey =
-      rtc::saturated_cast<uint8_t>(0.5 + parameters->packetsPerFrameKey);
   const uint8_t boostKey = BoostCodeRateKey(packetFrameDelta, packetFrameKey);
 
   rateIndexTable = rtc::saturated_cast<uint8_t>(VCM_MAX(
@@ -434,6 +461,18 @@ bool VCMFecMethod::ProtectionFactor(const VCMProtectionParameters* parameters) {
     _corrFecCost = 0.0f;
   }
 
+  cache.valid = true;
+  cache.packet_loss = packetLoss;
+  cache.bits_per_frame = bitRatePerFrame;
+  cache.eff_rate_fec_table = effRateFecTable;
+  cache.packets_per_frame_delta = packetFrameDelta;
+  cache.packets_per_frame_key = packetFrameKey;
+  cache.max_payload_size = _maxPayloadSize;
+  cache.scale_prot_key = _scaleProtKey;
+  cache.protection_factor_k = _protectionFactorK;
+  cache.protection_factor_d = _protectionFactorD;
+  cache.corr_fec_cost = _corrFecCost;
+
   // DONE WITH FEC PROTECTION SETTINGS
   return true;
 }
@@ -441,12 +480,17 @@ bool VCMFecMethod::ProtectionFactor(const VCMProtectionParameters* parameters) {
 int VCMFecMethod::BitsPerFrame(const VCMProtectionParameters* parameters) {
   // When temporal layers are available FEC will only be applied on the base
   // layer.
-  const float bitRateRatio =
+  // The bitrate share is looked up every time, since it depends on a field
+  // trial.
+  float bitRateRatio =
       webrtc::SimulcastRateAllocator::GetTemporalRateAllocation(
           parameters->numLayers, 0);
-  float frameRateRatio = powf(1 / 2.0, parameters->numLayers - 1);
+  if (parameters->numLayers != layer_frame_rate_ratio_num_layers_) {
+    layer_frame_rate_ratio_ = powf(1 / 2.0, parameters->numLayers - 1);
+    layer_frame_rate_ratio_num_layers_ = parameters->numLayers;
+  }
   float bitRate = parameters->bitRate * bitRateRatio;
-  float frameRate = parameters->frameRate * frameRateRatio;
+  float frameRate = parameters->frameRate * layer_frame_rate_ratio_;
 
   // TODO(mikhal): Update factor following testing.
   float adjustmentFactor = 1;
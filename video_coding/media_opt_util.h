@@ -183,6 +183,37 @@ class VCMFecMethod : public VCMProtectionMethod {
   enum { kMaxBytesPerFrameForFecLow = 400 };
   // Max bytes/frame for frame size larger than VGA, ~200k at 25fps.
   enum { kMaxBytesPerFrameForFecHigh = 1000 };
+
+ private:
+  // The inputs of the last ProtectionFactor() computation, after they have
+  // been quantized for the table lookups, and its results. Consecutive
+  // updates mostly map to the same inputs.
+  struct ProtectionFactorCache {
+    bool valid = false;
+    uint8_t packet_loss = 0;
+    int bits_per_frame = 0;
+    uint16_t eff_rate_fec_table = 0;
+    uint8_t packets_per_frame_delta = 0;
+    uint8_t packets_per_frame_key = 0;
+    int32_t max_payload_size = 0;
+    float scale_prot_key = 0.0f;
+    uint8_t protection_factor_k = 0;
+    uint8_t protection_factor_d = 0;
+    float corr_fec_cost = 1.0f;
+  };
+
+  // Resolution factor of the protection, for |resoln_fac_width_| x
+  // |resoln_fac_height_|.
+  bool resoln_fac_valid_ = false;
+  uint16_t resoln_fac_width_ = 0;
+  uint16_t resoln_fac_height_ = 0;
+  float resoln_fac_ = 1.0f;
+  ProtectionFactorCache protection_factor_cache_;
+  // Base layer share of the frame rate, for
+  // |layer_frame_rate_ratio_num_layers_| temporal layers (0 if not yet
+  // computed).
+  int layer_frame_rate_ratio_num_layers_ = 0;
+  float layer_frame_rate_ratio_ = 1.0f;
 };
 
 class VCMNackFecMethod : public VCMFecMethod {
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/media_opt_util.h"
+
+#include "test/field_trial.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace media_optimization {
+namespace {
+
+constexpr int32_t kDefaultMaxPayloadSize = 1460;
+
+class TestFecMethod : public VCMFecMethod {
+ public:
+  void SetMaxPayloadSize(int32_t max_payload_size) {
+    _maxPayloadSize = max_payload_size;
+  }
+  uint8_t protection_factor_k() const { return _protectionFactorK; }
+  uint8_t protection_factor_d() const { return _protectionFactorD; }
+  float corr_fec_cost() const { return _corrFecCost; }
+};
+
+VCMProtectionParameters DefaultParameters() {
+  VCMProtectionParameters parameters;
+  parameters.lossPr = 0.1f;
+  parameters.bitRate = 500.0f;
+  parameters.frameRate = 30.0f;
+  parameters.packetsPerFrame = 2.0f;
+  parameters.packetsPerFrameKey = 10.0f;
+  parameters.codecWidth = 640;
+  parameters.codecHeight = 480;
+  parameters.numLayers = 1;
+  return parameters;
+}
+
+}  // namespace
+
+// Each test updates |fec_| with the default parameters, then changes one of
+// the inputs at a time and expects the same protection factors as a method
+// that computes them for the first time.
+class FecMethodTest : public ::testing::Test {
+ protected:
+  FecMethodTest() : parameters_(DefaultParameters()) {
+    fec_.ProtectionFactor(&parameters_);
+  }
+
+  void ExpectSameAsNewMethod() {
+    fec_.SetMaxPayloadSize(max_payload_size_);
+    fec_.ProtectionFactor(&parameters_);
+
+    TestFecMethod new_fec;
+    new_fec.SetMaxPayloadSize(max_payload_size_);
+    new_fec.ProtectionFactor(&parameters_);
+    EXPECT_EQ(new_fec.protection_factor_k(), fec_.protection_factor_k());
+    EXPECT_EQ(new_fec.protection_factor_d(), fec_.protection_factor_d());
+    EXPECT_EQ(new_fec.corr_fec_cost(), fec_.corr_fec_cost());
+  }
+
+  VCMProtectionParameters parameters_;
+  int32_t max_payload_size_ = kDefaultMaxPayloadSize;
+  TestFecMethod fec_;
+};
+
+TEST_F(FecMethodTest, UnchangedParameters) {
+  ExpectSameAsNewMethod();
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, ChangedPacketLoss) {
+  parameters_.lossPr = 0.2f;
+  ExpectSameAsNewMethod();
+  parameters_.lossPr = 0.0f;
+  ExpectSameAsNewMethod();
+  parameters_.lossPr = 0.2f;
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, ChangedBitrate) {
+  parameters_.bitRate = 100.0f;
+  ExpectSameAsNewMethod();
+  parameters_.bitRate = 2000.0f;
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, ChangedPacketsPerFrame) {
+  parameters_.packetsPerFrame = 5.0f;
+  ExpectSameAsNewMethod();
+  parameters_.packetsPerFrameKey = 40.0f;
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, ChangedMaxPayloadSize) {
+  max_payload_size_ = 200;
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, ChangedCodecSize) {
+  parameters_.codecWidth = 1280;
+  ExpectSameAsNewMethod();
+  parameters_.codecHeight = 720;
+  ExpectSameAsNewMethod();
+  parameters_.codecWidth = 320;
+  parameters_.codecHeight = 240;
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, ChangedNumLayers) {
+  parameters_.numLayers = 2;
+  ExpectSameAsNewMethod();
+  parameters_.numLayers = 3;
+  ExpectSameAsNewMethod();
+  parameters_.numLayers = 1;
+  ExpectSameAsNewMethod();
+}
+
+TEST_F(FecMethodTest, FollowsBaseHeavy3TLRateAllocationFieldTrial) {
+  parameters_.numLayers = 3;
+  ExpectSameAsNewMethod();
+  const int bits_per_frame = fec_.BitsPerFrame(&parameters_);
+
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-UseBaseHeavyVP8TL3RateAllocation/Enabled/");
+  EXPECT_GT(fec_.BitsPerFrame(&parameters_), bits_per_frame);
+  ExpectSameAsNewMethod();
+}
+
+}  // namespace media_optimization
+}  // namespace webrtc
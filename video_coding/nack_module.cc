@@ -41,8 +41,30 @@ int64_t GetSendNackDelay() {
   }
   return kDefaultSendNackDelayMs;
 }
+
+uint16_t SeqNumOf(uint16_t seq_num) {
+  return seq_num;
+}
+
+template <typename T>
+uint16_t SeqNumOf(const T& nack_info) {
+  return nack_info.seq_num;
+}
+
+// Returns the first entry of |list|, ordered from oldest to newest, that is
+// not older than |seq_num|.
+template <typename List>
+typename List::iterator FirstNotOlderThan(List* list, uint16_t seq_num) {
+  return std::lower_bound(
+      list->begin(), list->end(), seq_num,
+      [](const typename List::value_type& entry, uint16_t seq_num) {
+        return AheadOf(seq_num, SeqNumOf(entry));
+      });
+}
 }  // namespace
 
+constexpr int NackModule::RecoveredPackets::kNumBits;
+
 NackModule::NackInfo::NackInfo()
     : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
 
@@ -55,6 +77,62 @@ NackModule::NackInfo::NackInfo(uint16_t seq_num,
       sent_at_time(-1),
       retries(0) {}
 
+NackModule::RecoveredPackets::RecoveredPackets()
+    : empty_(true), oldest_seq_num_(0), newest_seq_num_(0) {
+  static_assert(kMaxPacketAge < kNumBits,
+                "The window must not wrap around the bitmap.");
+}
+
+void NackModule::RecoveredPackets::Insert(uint16_t seq_num) {
+  if (empty_) {
+    empty_ = false;
+    oldest_seq_num_ = seq_num - kMaxPacketAge;
+    newest_seq_num_ = seq_num;
+  } else if (AheadOf(seq_num, newest_seq_num_)) {
+    const uint16_t window_start = seq_num - kMaxPacketAge;
+    if (ForwardDiff(newest_seq_num_, seq_num) > kMaxPacketAge) {
+      bits_.reset();
+      oldest_seq_num_ = window_start;
+    } else {
+      // Clear the bits of the packets that leave the window.
+      for (uint16_t old_seq_num = newest_seq_num_ - kMaxPacketAge;
+           old_seq_num != window_start; ++old_seq_num) {
+        bits_.reset(old_seq_num % kNumBits);
+      }
+      if (AheadOf(window_start, oldest_seq_num_))
+        oldest_seq_num_ = window_start;
+    }
+    newest_seq_num_ = seq_num;
+  } else if (AheadOf(oldest_seq_num_, seq_num)) {
+    // Too old, or already removed by ClearUpTo().
+    return;
+  }
+  bits_.set(seq_num % kNumBits);
+}
+
+bool NackModule::RecoveredPackets::Contains(uint16_t seq_num) const {
+  if (empty_ || AheadOf(seq_num, newest_seq_num_) ||
+      AheadOf(oldest_seq_num_, seq_num)) {
+    return false;
+  }
+  return bits_[seq_num % kNumBits];
+}
+
+void NackModule::RecoveredPackets::ClearUpTo(uint16_t seq_num) {
+  if (empty_)
+    return;
+  if (AheadOf(seq_num, newest_seq_num_)) {
+    Clear();
+  } else if (AheadOf(seq_num, oldest_seq_num_)) {
+    oldest_seq_num_ = seq_num;
+  }
+}
+
+void NackModule::RecoveredPackets::Clear() {
+  bits_.reset();
+  empty_ = true;
+}
+
 NackModule::NackModule(Clock* clock,
                        NackSender* nack_sender,
                        KeyFrameRequestSender* keyframe_request_sender)
@@ -89,7 +167,7 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   if (!initialized_) {
     newest_seq_num_ = seq_num;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      keyframe_list_.push_back(seq_num);
     initialized_ = true;
     return 0;
   }
@@ -101,10 +179,10 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    auto nack_list_it = FirstNotOlderThan(&nack_list_, seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
+    if (nack_list_it != nack_list_.end() && nack_list_it->seq_num == seq_num) {
+      nacks_sent_for_packet = nack_list_it->retries;
       nack_list_.erase(nack_list_it);
     }
     if (!is_retransmitted)
@@ -113,21 +191,19 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   }
 
   // Keep track of new keyframes.
-  if (is_keyframe)
-    keyframe_list_.insert(seq_num);
+  if (is_keyframe) {
+    auto it = FirstNotOlderThan(&keyframe_list_, seq_num);
+    if (it == keyframe_list_.end() || *it != seq_num)
+      keyframe_list_.insert(it, seq_num);
+  }
 
   // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+  keyframe_list_.erase(
+      keyframe_list_.begin(),
+      FirstNotOlderThan(&keyframe_list_, seq_num - kMaxPacketAge));
 
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
-
-    // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    recovered_list_.Insert(seq_num);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
@@ -149,11 +225,10 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
+  nack_list_.erase(nack_list_.begin(), FirstNotOlderThan(&nack_list_, seq_num));
   keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+                       FirstNotOlderThan(&keyframe_list_, seq_num));
+  recovered_list_.ClearUpTo(seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
@@ -165,7 +240,7 @@ void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
   keyframe_list_.clear();
-  recovered_list_.clear();
+  recovered_list_.Clear();
 }
 
 int64_t NackModule::TimeUntilNextProcess() {
@@ -204,7 +279,7 @@ void NackModule::Process() {
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
+    auto it = FirstNotOlderThan(&nack_list_, keyframe_list_.front());
 
     if (it != nack_list_.begin()) {
       // We have found a keyframe that actually is newer than at least one
@@ -215,7 +290,7 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 
     // If this keyframe is so old it does not remove any packets from the list,
     // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+    keyframe_list_.pop_front();
   }
   return false;
 }
@@ -223,8 +298,8 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 void NackModule::AddPacketsToNack(uint16_t seq_num_start,
                                   uint16_t seq_num_end) {
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  nack_list_.erase(nack_list_.begin(),
+                   FirstNotOlderThan(&nack_list_, seq_num_end - kMaxPacketAge));
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
@@ -246,12 +321,12 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
 
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (recovered_list_.Contains(seq_num))
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->TimeInMilliseconds());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK(nack_list_.empty() ||
+               AheadOf(seq_num, nack_list_.back().seq_num));
+    nack_list_.emplace_back(seq_num, seq_num + WaitNumberOfPackets(0.5),
+                            clock_->TimeInMilliseconds());
   }
 }
 
@@ -263,18 +338,18 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   auto it = nack_list_.begin();
   while (it != nack_list_.end()) {
     bool delay_timed_out =
-        now_ms - it->second.created_at_time >= send_nack_delay_ms_;
-    bool nack_on_rtt_passed = now_ms - it->second.sent_at_time >= rtt_ms_;
+        now_ms - it->created_at_time >= send_nack_delay_ms_;
+    bool nack_on_rtt_passed = now_ms - it->sent_at_time >= rtt_ms_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        it->sent_at_time == -1 &&
+        AheadOrAt(newest_seq_num_, it->send_at_seq_num);
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      nack_batch.emplace_back(it->seq_num);
+      ++it->retries;
+      it->sent_at_time = now_ms;
+      if (it->retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << it->seq_num
                             << " removed from NACK list due to max retries.";
         it = nack_list_.erase(it);
       } else {
@@ -13,8 +13,8 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
+#include <bitset>
+#include <deque>
 #include <vector>
 
 #include "modules/include/module.h"
@@ -64,6 +64,32 @@ class NackModule : public Module {
     int64_t sent_at_time;
     int retries;
   };
+  // Set of packets recovered by FEC or RTX, which should not be nacked. Kept
+  // as a bitmap indexed by sequence number, covering the window of
+  // |kMaxPacketAge| sequence numbers up to the newest recovered packet. Bits
+  // of sequence numbers that leave the window are cleared as it moves, so
+  // every sequence number in the window owns its bit.
+  class RecoveredPackets {
+   public:
+    RecoveredPackets();
+
+    void Insert(uint16_t seq_num);
+    bool Contains(uint16_t seq_num) const;
+    // Removes all packets older than |seq_num|.
+    void ClearUpTo(uint16_t seq_num);
+    void Clear();
+
+   private:
+    static constexpr int kNumBits = 1 << 14;
+
+    std::bitset<kNumBits> bits_;
+    bool empty_;
+    // Packets older than |oldest_seq_num_| are not part of the set, even if
+    // their bit is still set.
+    uint16_t oldest_seq_num_;
+    uint16_t newest_seq_num_;
+  };
+
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
@@ -90,12 +116,12 @@ class NackModule : public Module {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see |initialized_|). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(crit_);
+  // Both ordered from oldest to newest sequence number. Packets are nacked in
+  // sequence number order, so entries are appended at the back and mostly
+  // removed from the front.
+  std::deque<NackInfo> nack_list_ RTC_GUARDED_BY(crit_);
+  std::deque<uint16_t> keyframe_list_ RTC_GUARDED_BY(crit_);
+  RecoveredPackets recovered_list_ RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
@@ -288,6 +289,22 @@ TEST_F(TestNackModule, HandleFecRecoveredPacket) {
   EXPECT_EQ(2u, sent_nacks_.size());
 }
 
+TEST_F(TestNackModule, HandleFecRecoveredPacketsAcrossWrap) {
+  nack_module_.OnReceivedPacket(0xfffe, false, false);
+  nack_module_.OnReceivedPacket(0xffff, false, true);
+  nack_module_.OnReceivedPacket(1, false, true);
+  nack_module_.OnReceivedPacket(3, false, false);
+  EXPECT_EQ(std::vector<uint16_t>({0, 2}), sent_nacks_);
+}
+
+TEST_F(TestNackModule, ClearUpToForgetsRecoveredPackets) {
+  nack_module_.OnReceivedPacket(0, false, false);
+  nack_module_.OnReceivedPacket(2, false, true);
+  nack_module_.ClearUpTo(3);
+  nack_module_.OnReceivedPacket(4, false, false);
+  EXPECT_EQ(std::vector<uint16_t>({1, 2, 3}), sent_nacks_);
+}
+
 TEST_F(TestNackModule, SendNackWithoutDelay) {
   nack_module_.OnReceivedPacket(0, false, false);
   nack_module_.OnReceivedPacket(100, false, false);
@@ -10,6 +10,8 @@
 
 #include "modules/video_coding/packet.h"
 
+#include <utility>
+
 #include "api/rtp_headers.h"
 
 namespace webrtc {
@@ -67,4 +69,17 @@ VCMPacket::VCMPacket(const uint8_t* ptr,
 
 VCMPacket::~VCMPacket() = default;
 
+bool VCMPacket::SetSharedPayload(rtc::CopyOnWriteBuffer buffer,
+                                 rtc::ArrayView<const uint8_t> payload) {
+  const uint8_t* begin = buffer.cdata();
+  if (begin == nullptr || payload.data() < begin ||
+      payload.data() + payload.size() > begin + buffer.size()) {
+    return false;
+  }
+  dataPtr = payload.data();
+  sizeBytes = payload.size();
+  payload_buffer = std::move(buffer);
+  return true;
+}
+
 }  // namespace webrtc
@@ -17,9 +17,11 @@
 #include "absl/types/optional.h"
 #include "api/rtp_headers.h"
 #include "api/rtp_packet_info.h"
+#include "api/array_view.h"
 #include "api/video/video_frame_type.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
 
@@ -56,6 +58,14 @@ class VCMPacket {
     return video_header.is_last_packet_in_frame;
   }
 
+  // Makes |dataPtr| and |sizeBytes| refer to |payload| without copying it,
+  // and keeps a reference to |buffer|, which must contain |payload|. Typically
+  // |buffer| is the buffer of the received RTP packet and |payload| is the
+  // depacketized payload. Returns false, leaving the packet unchanged, if
+  // |payload| isn't part of |buffer|, in which case it has to be copied.
+  bool SetSharedPayload(rtc::CopyOnWriteBuffer buffer,
+                        rtc::ArrayView<const uint8_t> payload);
+
   uint8_t payloadType;
   uint32_t timestamp;
   // NTP time of the capture time in local timebase in milliseconds.
@@ -63,6 +73,10 @@ class VCMPacket {
   uint16_t seqNum;
   const uint8_t* dataPtr;
   size_t sizeBytes;
+  // Set by SetSharedPayload(), in which case |dataPtr| points into this
+  // buffer. Otherwise |dataPtr| is a heap allocated array owned by the holder
+  // of the packet (e.g. the PacketBuffer).
+  rtc::CopyOnWriteBuffer payload_buffer;
   bool markerBit;
   int timesNacked;
 
@@ -30,6 +30,149 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+// Frees the payload of |packet|, unless it is shared with the received RTP
+// packet, in which case only the reference to that buffer is dropped.
+void ReleasePayload(VCMPacket* packet) {
+  if (packet->payload_buffer.cdata() == nullptr) {
+    delete[] packet->dataPtr;
+  }
+  packet->dataPtr = nullptr;
+  packet->payload_buffer = rtc::CopyOnWriteBuffer();
+}
+
+}  // namespace
+
+constexpr int PacketBuffer::MissingPackets::kMaxPaddingAge;
+constexpr int PacketBuffer::MissingPackets::kNumBits;
+constexpr int PacketBuffer::MissingPackets::kBitsPerWord;
+constexpr size_t PacketBuffer::kMaxTimestampsHistory;
+constexpr size_t PacketBuffer::kMaxPooledFrameBuffers;
+
+PacketBuffer::MissingPackets::MissingPackets() {
+  static_assert(kMaxPaddingAge < kNumBits, "");
+  static_assert((1 << 16) % kNumBits == 0, "");
+  Clear();
+}
+
+void PacketBuffer::MissingPackets::Insert(uint16_t seq_num) {
+  if (!newest_seq_num_) {
+    newest_seq_num_ = seq_num;
+    return;
+  }
+
+  if (!AheadOf(seq_num, *newest_seq_num_)) {
+    if (CountUpTo(seq_num) > 0)
+      SetRange(seq_num, 1, false);
+    return;
+  }
+
+  // Guard against marking a large amount of packets as missing if there is a
+  // jump in the sequence number. Bits of sequence numbers that are older than
+  // |kMaxPaddingAge| are never read, and are overwritten as the newest
+  // sequence number moves forward.
+  uint16_t old_seq_num = seq_num - kMaxPaddingAge;
+  uint16_t first_missing = *newest_seq_num_ + 1;
+  if (AheadOf(old_seq_num, *newest_seq_num_)) {
+    bits_.fill(0);
+    first_missing = old_seq_num + 1;
+  }
+  SetRange(first_missing, ForwardDiff(first_missing, seq_num), true);
+  SetRange(seq_num, 1, false);
+  newest_seq_num_ = seq_num;
+}
+
+absl::optional<uint16_t> PacketBuffer::MissingPackets::NewestUpTo(
+    uint16_t seq_num) const {
+  int count = CountUpTo(seq_num);
+  if (count == 0)
+    return absl::nullopt;
+
+  uint16_t oldest_seq_num = *newest_seq_num_ - kMaxPaddingAge;
+  int begin = oldest_seq_num % kNumBits;
+  int end = begin + count;
+  int bit = -1;
+  if (end > kNumBits) {
+    bit = FindLastSetBit(0, end - kNumBits);
+    end = kNumBits;
+  }
+  if (bit == -1)
+    bit = FindLastSetBit(begin, end);
+  if (bit == -1)
+    return absl::nullopt;
+  return oldest_seq_num + (bit - begin + kNumBits) % kNumBits;
+}
+
+void PacketBuffer::MissingPackets::ClearUpTo(uint16_t seq_num) {
+  int count = CountUpTo(seq_num);
+  if (count > 0)
+    SetRange(*newest_seq_num_ - kMaxPaddingAge, count, false);
+}
+
+void PacketBuffer::MissingPackets::Clear() {
+  bits_.fill(0);
+  newest_seq_num_.reset();
+}
+
+int PacketBuffer::MissingPackets::CountUpTo(uint16_t seq_num) const {
+  if (!newest_seq_num_)
+    return 0;
+  uint16_t oldest_seq_num = *newest_seq_num_ - kMaxPaddingAge;
+  uint16_t diff = ForwardDiff(oldest_seq_num, seq_num);
+  if (diff <= kMaxPaddingAge)
+    return diff + 1;
+  return AheadOf(seq_num, *newest_seq_num_) ? kMaxPaddingAge + 1 : 0;
+}
+
+void PacketBuffer::MissingPackets::SetRange(uint16_t first_seq_num,
+                                            int count,
+                                            bool missing) {
+  RTC_DCHECK_LE(count, kNumBits);
+  int begin = first_seq_num % kNumBits;
+  int end = begin + count;
+  if (end > kNumBits) {
+    SetBits(0, end - kNumBits, missing);
+    end = kNumBits;
+  }
+  SetBits(begin, end, missing);
+}
+
+void PacketBuffer::MissingPackets::SetBits(int begin, int end, bool missing) {
+  while (begin < end) {
+    int bit = begin % kBitsPerWord;
+    int num_bits = std::min(kBitsPerWord - bit, end - begin);
+    uint64_t mask = num_bits == kBitsPerWord
+                        ? ~uint64_t{0}
+                        : ((uint64_t{1} << num_bits) - 1) << bit;
+    if (missing) {
+      bits_[begin / kBitsPerWord] |= mask;
+    } else {
+      bits_[begin / kBitsPerWord] &= ~mask;
+    }
+    begin += num_bits;
+  }
+}
+
+int PacketBuffer::MissingPackets::FindLastSetBit(int begin, int end) const {
+  while (end > begin) {
+    int word_begin = std::max(begin, (end - 1) / kBitsPerWord * kBitsPerWord);
+    int bit = word_begin % kBitsPerWord;
+    int num_bits = end - word_begin;
+    uint64_t mask = num_bits == kBitsPerWord
+                        ? ~uint64_t{0}
+                        : ((uint64_t{1} << num_bits) - 1) << bit;
+    uint64_t word = bits_[word_begin / kBitsPerWord] & mask;
+    if (word != 0) {
+      int index = bit + num_bits - 1;
+      while ((word & (uint64_t{1} << index)) == 0)
+        --index;
+      return word_begin - bit + index;
+    }
+    end = word_begin;
+  }
+  return -1;
+}
 
 PacketBuffer::PacketBuffer(Clock* clock,
                            size_t start_buffer_size,
@@ -45,8 +188,13 @@ PacketBuffer::PacketBuffer(Clock* clock,
       sequence_buffer_(start_buffer_size),
       assembled_frame_callback_(assembled_frame_callback),
       unique_frames_seen_(0),
+      max_packets_per_frame_(0),
+      max_frame_size_(0),
+      byte_limit_(0),
       sps_pps_idr_is_h264_keyframe_(
-          field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")) {
+          field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")),
+      rtp_timestamps_history_size_(0),
+      rtp_timestamps_history_next_(0) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
   RTC_DCHECK((start_buffer_size & (start_buffer_size - 1)) == 0);
@@ -74,8 +222,7 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
       // If we have explicitly cleared past this packet then it's old,
       // don't insert it, just silently ignore it.
       if (is_cleared_to_first_seq_num_) {
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
+        ReleasePayload(packet);
         return true;
       }
 
@@ -85,8 +232,7 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
     if (sequence_buffer_[index].used) {
       // Duplicate packet, just delete the payload.
       if (data_buffer_[index].seqNum == packet->seqNum) {
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
+        ReleasePayload(packet);
         return true;
       }
 
@@ -101,12 +247,20 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
         // new keyframe is needed.
         RTC_LOG(LS_WARNING) << "Clear PacketBuffer and request key frame.";
         Clear();
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
+        ReleasePayload(packet);
         return false;
       }
     }
 
+    if (byte_limit_ > 0 &&
+        memory_usage_.bytes + packet->sizeBytes > byte_limit_) {
+      RTC_LOG(LS_WARNING) << "PacketBuffer reached its limit of " << byte_limit_
+                          << " bytes, clear it and request key frame.";
+      Clear();
+      ReleasePayload(packet);
+      return false;
+    }
+
     sequence_buffer_[index].frame_begin = packet->is_first_packet_in_frame();
     sequence_buffer_[index].frame_end = packet->is_last_packet_in_frame();
     sequence_buffer_[index].seq_num = packet->seqNum;
@@ -115,8 +269,10 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
     sequence_buffer_[index].used = true;
     data_buffer_[index] = *packet;
     packet->dataPtr = nullptr;
+    packet->payload_buffer = rtc::CopyOnWriteBuffer();
+    memory_usage_.Add(packet->sizeBytes);
 
-    UpdateMissingPackets(packet->seqNum);
+    missing_packets_.Insert(packet->seqNum);
 
     int64_t now_ms = clock_->TimeInMilliseconds();
     last_received_packet_ms_ = now_ms;
@@ -153,9 +309,7 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
     size_t index = first_seq_num_ % size_;
     RTC_DCHECK_EQ(data_buffer_[index].seqNum, sequence_buffer_[index].seq_num);
     if (AheadOf<uint16_t>(seq_num, sequence_buffer_[index].seq_num)) {
-      delete[] data_buffer_[index].dataPtr;
-      data_buffer_[index].dataPtr = nullptr;
-      sequence_buffer_[index].used = false;
+      ReleaseSlot(index);
     }
     ++first_seq_num_;
   }
@@ -165,11 +319,12 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  auto clear_to_it = missing_packets_.upper_bound(seq_num);
-  if (clear_to_it != missing_packets_.begin()) {
-    --clear_to_it;
-    missing_packets_.erase(missing_packets_.begin(), clear_to_it);
-  }
+  // Keep the newest missing packet before |seq_num|, so that H264 delta
+  // frames depending on it are still held back.
+  absl::optional<uint16_t> missing_seq_num =
+      missing_packets_.NewestUpTo(seq_num);
+  if (missing_seq_num)
+    missing_packets_.ClearUpTo(*missing_seq_num - 1);
 }
 
 void PacketBuffer::ClearInterval(uint16_t start_seq_num,
@@ -181,9 +336,7 @@ void PacketBuffer::ClearInterval(uint16_t start_seq_num,
     size_t index = seq_num % size_;
     RTC_DCHECK_EQ(sequence_buffer_[index].seq_num, seq_num);
     RTC_DCHECK_EQ(sequence_buffer_[index].seq_num, data_buffer_[index].seqNum);
-    delete[] data_buffer_[index].dataPtr;
-    data_buffer_[index].dataPtr = nullptr;
-    sequence_buffer_[index].used = false;
+    ReleaseSlot(index);
 
     ++seq_num;
   }
@@ -192,24 +345,23 @@ void PacketBuffer::ClearInterval(uint16_t start_seq_num,
 void PacketBuffer::Clear() {
   rtc::CritScope lock(&crit_);
   for (size_t i = 0; i < size_; ++i) {
-    delete[] data_buffer_[i].dataPtr;
-    data_buffer_[i].dataPtr = nullptr;
+    ReleasePayload(&data_buffer_[i]);
     sequence_buffer_[i].used = false;
   }
+  memory_usage_.Clear();
 
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
   last_received_packet_ms_.reset();
   last_received_keyframe_packet_ms_.reset();
-  newest_inserted_seq_num_.reset();
-  missing_packets_.clear();
+  missing_packets_.Clear();
 }
 
 void PacketBuffer::PaddingReceived(uint16_t seq_num) {
   std::vector<std::unique_ptr<RtpFrameObject>> found_frames;
   {
     rtc::CritScope lock(&crit_);
-    UpdateMissingPackets(seq_num);
+    missing_packets_.Insert(seq_num);
     found_frames = FindFrames(static_cast<uint16_t>(seq_num + 1));
   }
 
@@ -232,6 +384,16 @@ int PacketBuffer::GetUniqueFramesSeen() const {
   return unique_frames_seen_;
 }
 
+void PacketBuffer::SetByteLimit(size_t byte_limit) {
+  rtc::CritScope lock(&crit_);
+  byte_limit_ = byte_limit;
+}
+
+BufferMemoryUsage PacketBuffer::GetMemoryUsage() const {
+  rtc::CritScope lock(&crit_);
+  return memory_usage_;
+}
+
 bool PacketBuffer::ExpandBufferSize() {
   if (size_ == max_size_) {
     RTC_LOG(LS_WARNING) << "PacketBuffer is already at max size (" << max_size_
@@ -300,6 +462,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
       int64_t min_recv_time = data_buffer_[index].packet_info.receive_time_ms();
       int64_t max_recv_time = data_buffer_[index].packet_info.receive_time_ms();
       RtpPacketInfos::vector_type packet_infos;
+      packet_infos.reserve(max_packets_per_frame_);
 
       // Find the start index by searching backward until the packet with
       // the |frame_begin| flag is set.
@@ -380,6 +543,8 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
 
       // Fix the order since the packet-finding loop traverses backwards.
       std::reverse(packet_infos.begin(), packet_infos.end());
+      max_packets_per_frame_ = std::max(max_packets_per_frame_, tested_packets);
+      max_frame_size_ = std::max(max_frame_size_, frame_size);
 
       if (is_h264) {
         // Warn if this is an unsafe frame.
@@ -411,8 +576,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         const uint8_t h264tid =
             data_buffer_[start_index].video_header.frame_marking.temporal_id;
         if (h264tid == kNoTemporalIdx && !is_h264_keyframe &&
-            missing_packets_.upper_bound(start_seq_num) !=
-                missing_packets_.begin()) {
+            missing_packets_.NewestUpTo(start_seq_num)) {
           uint16_t stop_index = (index + 1) % size_;
           while (start_index != stop_index) {
             sequence_buffer_[start_index].frame_created = false;
@@ -423,8 +587,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         }
       }
 
-      missing_packets_.erase(missing_packets_.begin(),
-                             missing_packets_.upper_bound(seq_num));
+      missing_packets_.ClearUpTo(seq_num);
 
       const VCMPacket* first_packet = GetPacket(start_seq_num);
       const VCMPacket* last_packet = GetPacket(seq_num);
@@ -439,6 +602,8 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
           first_packet->generic_descriptor,
           RtpPacketInfos(std::move(packet_infos)),
           GetEncodedImageBuffer(frame_size, start_seq_num, seq_num));
+      // A pooled buffer can be larger than the frame.
+      frame->set_size(frame_size);
 
       found_frames.emplace_back(std::move(frame));
 
@@ -456,7 +621,24 @@ rtc::scoped_refptr<EncodedImageBuffer> PacketBuffer::GetEncodedImageBuffer(
   size_t index = first_seq_num % size_;
   size_t end = (last_seq_num + 1) % size_;
 
-  auto buffer = EncodedImageBuffer::Create(frame_size);
+  rtc::scoped_refptr<EncodedImageBuffer> buffer;
+  for (const auto& frame_buffer : frame_buffers_) {
+    if (frame_buffer->HasOneRef()) {
+      // Only grows when the stream sends a frame larger than any before.
+      if (frame_buffer->size() < frame_size)
+        frame_buffer->Realloc(max_frame_size_);
+      buffer = frame_buffer;
+      break;
+    }
+  }
+  if (!buffer && frame_buffers_.size() < kMaxPooledFrameBuffers) {
+    frame_buffers_.push_back(
+        new rtc::RefCountedObject<EncodedImageBuffer>(max_frame_size_));
+    buffer = frame_buffers_.back();
+  }
+  if (!buffer)
+    buffer = EncodedImageBuffer::Create(frame_size);
+
   size_t offset = 0;
 
   do {
@@ -473,6 +655,13 @@ rtc::scoped_refptr<EncodedImageBuffer> PacketBuffer::GetEncodedImageBuffer(
   return buffer;
 }
 
+void PacketBuffer::ReleaseSlot(size_t index) {
+  if (sequence_buffer_[index].used)
+    memory_usage_.Remove(data_buffer_[index].sizeBytes);
+  ReleasePayload(&data_buffer_[index]);
+  sequence_buffer_[index].used = false;
+}
+
 VCMPacket* PacketBuffer::GetPacket(uint16_t seq_num) {
   size_t index = seq_num % size_;
   if (!sequence_buffer_[index].used ||
@@ -482,42 +671,22 @@ VCMPacket* PacketBuffer::GetPacket(uint16_t seq_num) {
   return &data_buffer_[index];
 }
 
-void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
-  if (!newest_inserted_seq_num_)
-    newest_inserted_seq_num_ = seq_num;
-
-  const int kMaxPaddingAge = 1000;
-  if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-    uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
-
-    // Guard against inserting a large amount of missing packets if there is a
-    // jump in the sequence number.
-    if (AheadOf(old_seq_num, *newest_inserted_seq_num_))
-      *newest_inserted_seq_num_ = old_seq_num;
-
-    ++*newest_inserted_seq_num_;
-    while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
-      ++*newest_inserted_seq_num_;
-    }
-  } else {
-    missing_packets_.erase(seq_num);
-  }
-}
-
 void PacketBuffer::OnTimestampReceived(uint32_t rtp_timestamp) {
-  const size_t kMaxTimestampsHistory = 1000;
-  if (rtp_timestamps_history_set_.insert(rtp_timestamp).second) {
-    rtp_timestamps_history_queue_.push(rtp_timestamp);
-    ++unique_frames_seen_;
-    if (rtp_timestamps_history_set_.size() > kMaxTimestampsHistory) {
-      uint32_t discarded_timestamp = rtp_timestamps_history_queue_.front();
-      rtp_timestamps_history_set_.erase(discarded_timestamp);
-      rtp_timestamps_history_queue_.pop();
-    }
+  // Packets of the same frame mostly arrive back to back, so search from the
+  // most recently added timestamp and backwards.
+  size_t index = rtp_timestamps_history_next_;
+  for (size_t i = 0; i < rtp_timestamps_history_size_; ++i) {
+    index = index > 0 ? index - 1 : kMaxTimestampsHistory - 1;
+    if (rtp_timestamps_history_[index] == rtp_timestamp)
+      return;
   }
+
+  ++unique_frames_seen_;
+  rtp_timestamps_history_[rtp_timestamps_history_next_] = rtp_timestamp;
+  rtp_timestamps_history_next_ =
+      (rtp_timestamps_history_next_ + 1) % kMaxTimestampsHistory;
+  rtp_timestamps_history_size_ =
+      std::min(rtp_timestamps_history_size_ + 1, kMaxTimestampsHistory);
 }
 
 }  // namespace video_coding
@@ -11,15 +11,17 @@
 #ifndef MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 #define MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 
+#include <array>
 #include <memory>
-#include <queue>
-#include <set>
 #include <vector>
 
+#include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
+#include "modules/include/module_common_types_public.h"
 #include "modules/video_coding/packet.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -48,8 +50,9 @@ class PacketBuffer {
 
   // Returns true unless the packet buffer is cleared, which means that a key
   // frame request should be sent. The PacketBuffer will always take ownership
-  // of the |packet.dataPtr| when this function is called. Made virtual for
-  // testing.
+  // of the |packet.dataPtr| when this function is called, or of the reference
+  // to |packet.payload_buffer| if the payload is shared, see
+  // VCMPacket::SetSharedPayload(). Made virtual for testing.
   virtual bool InsertPacket(VCMPacket* packet);
   void ClearTo(uint16_t seq_num);
   void Clear();
@@ -62,6 +65,12 @@ class PacketBuffer {
   // Returns number of different frames seen in the packet buffer
   int GetUniqueFramesSeen() const;
 
+  // Caps the payload bytes of the buffered packets. A packet that would take
+  // the buffer above |byte_limit| clears the buffer, the same way as when it is
+  // out of slots. A |byte_limit| of 0 is equivalent to no limit.
+  void SetByteLimit(size_t byte_limit);
+  BufferMemoryUsage GetMemoryUsage() const;
+
  private:
   friend RtpFrameObject;
   // Since we want the packet buffer to be as packet type agnostic
@@ -87,6 +96,55 @@ class PacketBuffer {
     bool frame_created = false;
   };
 
+  // Keeps track of the packets that are missing among the last
+  // |kMaxPaddingAge| sequence numbers. The state is a bitmap indexed by
+  // sequence number, so updating it never allocates.
+  class MissingPackets {
+   public:
+    MissingPackets();
+
+    // Marks |seq_num| as received. If it is newer than any sequence number
+    // seen so far, every sequence number in between is marked as missing.
+    void Insert(uint16_t seq_num);
+
+    // Returns the newest missing sequence number that is not newer than
+    // |seq_num|, if any.
+    absl::optional<uint16_t> NewestUpTo(uint16_t seq_num) const;
+
+    // Forgets every missing sequence number that is not newer than |seq_num|.
+    void ClearUpTo(uint16_t seq_num);
+
+    void Clear();
+
+   private:
+    static constexpr int kMaxPaddingAge = 1000;
+    static constexpr int kNumBits = 1024;
+    static constexpr int kBitsPerWord = 64;
+
+    // Returns the number of tracked sequence numbers from the oldest one up to
+    // and including |seq_num|.
+    int CountUpTo(uint16_t seq_num) const;
+
+    // Sets or clears the bits for |count| sequence numbers starting at
+    // |first_seq_num|.
+    void SetRange(uint16_t first_seq_num, int count, bool missing);
+
+    // Same as above, for bit indices in [|begin|, |end|).
+    void SetBits(int begin, int end, bool missing);
+
+    // Returns the index of the last set bit in [|begin|, |end|), or -1.
+    int FindLastSetBit(int begin, int end) const;
+
+    std::array<uint64_t, kNumBits / kBitsPerWord> bits_;
+    absl::optional<uint16_t> newest_seq_num_;
+  };
+
+  static constexpr size_t kMaxTimestampsHistory = 1000;
+  // Frames are normally decoded and released within a few frame intervals,
+  // so a handful of buffers covers the frames in flight. Frames assembled
+  // while all of them are in use get a buffer of their own.
+  static constexpr size_t kMaxPooledFrameBuffers = 8;
+
   Clock* const clock_;
 
   // Tries to expand the buffer.
@@ -101,11 +159,18 @@ class PacketBuffer {
   std::vector<std::unique_ptr<RtpFrameObject>> FindFrames(uint16_t seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns a buffer holding the payloads of the packets from
+  // |first_seq_num| to |last_seq_num|. The buffer is reused from
+  // |frame_buffers_| when possible and may be larger than |frame_size|.
   rtc::scoped_refptr<EncodedImageBuffer> GetEncodedImageBuffer(
       size_t frame_size,
       uint16_t first_seq_num,
       uint16_t last_seq_num) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Frees the payload of the packet in slot |index| and marks the slot as
+  // unused.
+  void ReleaseSlot(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Get the packet with sequence number |seq_num|.
   // Virtual for testing.
   virtual VCMPacket* GetPacket(uint16_t seq_num)
@@ -116,9 +181,6 @@ class PacketBuffer {
   void ClearInterval(uint16_t start_seq_num, uint16_t stop_seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
-  void UpdateMissingPackets(uint16_t seq_num)
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
-
   // Counts unique received timestamps and updates |unique_frames_seen_|.
   void OnTimestampReceived(uint32_t rtp_timestamp)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -156,18 +218,35 @@ class PacketBuffer {
 
   int unique_frames_seen_ RTC_GUARDED_BY(crit_);
 
-  absl::optional<uint16_t> newest_inserted_seq_num_ RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_
-      RTC_GUARDED_BY(crit_);
+  // The largest number of packets seen in one frame, used to size the packet
+  // info list of the next frame up front.
+  size_t max_packets_per_frame_ RTC_GUARDED_BY(crit_);
+
+  // The largest frame assembled so far, in bytes. Pooled buffers are
+  // allocated with this size, so that they fit the following frames of the
+  // stream without reallocating.
+  size_t max_frame_size_ RTC_GUARDED_BY(crit_);
+
+  // Buffers of assembled frames, in use or ready to be reused once no frame
+  // refers to them.
+  std::vector<rtc::scoped_refptr<rtc::RefCountedObject<EncodedImageBuffer>>>
+      frame_buffers_ RTC_GUARDED_BY(crit_);
+
+  MissingPackets missing_packets_ RTC_GUARDED_BY(crit_);
+
+  size_t byte_limit_ RTC_GUARDED_BY(crit_);
+  BufferMemoryUsage memory_usage_ RTC_GUARDED_BY(crit_);
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
   const bool sps_pps_idr_is_h264_keyframe_;
 
-  // Stores several last seen unique timestamps for quick search.
-  std::set<uint32_t> rtp_timestamps_history_set_ RTC_GUARDED_BY(crit_);
-  // Stores the same unique timestamps in the order of insertion.
-  std::queue<uint32_t> rtp_timestamps_history_queue_ RTC_GUARDED_BY(crit_);
+  // Ring buffer of the last |kMaxTimestampsHistory| unique timestamps, in the
+  // order of insertion.
+  std::array<uint32_t, kMaxTimestampsHistory> rtp_timestamps_history_
+      RTC_GUARDED_BY(crit_);
+  size_t rtp_timestamps_history_size_ RTC_GUARDED_BY(crit_);
+  size_t rtp_timestamps_history_next_ RTC_GUARDED_BY(crit_);
 };
 
 }  // namespace video_coding
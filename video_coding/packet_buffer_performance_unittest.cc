@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/video_coding/frame_object.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr int kBitrateBps = 50000000;
+constexpr int kFramesPerSecond = 30;
+constexpr int kPayloadSize = 1200;
+constexpr int kPacketsPerFrame =
+    kBitrateBps / 8 / kFramesPerSecond / kPayloadSize;
+constexpr int kNumFrames = 300;
+constexpr int kStartSize = 512;
+constexpr int kMaxSize = 2048;
+
+class FrameCounter : public OnAssembledFrameCallback {
+ public:
+  void OnAssembledFrame(std::unique_ptr<RtpFrameObject> frame) override {
+    ++num_frames;
+    last_seq_num = frame->last_seq_num();
+  }
+
+  int num_frames = 0;
+  uint16_t last_seq_num = 0;
+};
+
+// Returns the sequence numbers of |kNumFrames| frames in arrival order, where
+// each packet is delayed by up to |max_reordering| packets.
+std::vector<uint16_t> ArrivalOrder(int max_reordering) {
+  Random random(0x3b6a);
+  const int num_packets = kNumFrames * kPacketsPerFrame;
+  std::vector<std::pair<int, uint16_t>> arrivals;
+  arrivals.reserve(num_packets);
+  for (int i = 0; i < num_packets; ++i) {
+    arrivals.emplace_back(i + random.Rand(0, max_reordering),
+                          static_cast<uint16_t>(i));
+  }
+  std::stable_sort(arrivals.begin(), arrivals.end(),
+                   [](const std::pair<int, uint16_t>& a,
+                      const std::pair<int, uint16_t>& b) {
+                     return a.first < b.first;
+                   });
+  std::vector<uint16_t> seq_nums;
+  seq_nums.reserve(num_packets);
+  for (const auto& arrival : arrivals)
+    seq_nums.push_back(arrival.second);
+  return seq_nums;
+}
+
+}  // namespace
+
+// Measures the time needed to insert the packets of a 50 Mbps video stream
+// into the packet buffer and assemble its frames, with packets reordered.
+TEST(PacketBufferPerformanceTest, DISABLED_InsertReorderedPackets) {
+  for (int max_reordering : {0, 4, 32}) {
+    const std::vector<uint16_t> seq_nums = ArrivalOrder(max_reordering);
+    SimulatedClock clock(0);
+    FrameCounter frame_counter;
+    PacketBuffer packet_buffer(&clock, kStartSize, kMaxSize, &frame_counter);
+
+    int64_t insert_us = 0;
+    for (uint16_t seq_num : seq_nums) {
+      VCMPacket packet;
+      packet.video_header.codec = kVideoCodecGeneric;
+      packet.video_header.frame_type = seq_num < kPacketsPerFrame
+                                           ? VideoFrameType::kVideoFrameKey
+                                           : VideoFrameType::kVideoFrameDelta;
+      packet.video_header.is_first_packet_in_frame =
+          seq_num % kPacketsPerFrame == 0;
+      packet.video_header.is_last_packet_in_frame =
+          seq_num % kPacketsPerFrame == kPacketsPerFrame - 1;
+      packet.seqNum = seq_num;
+      packet.timestamp = seq_num / kPacketsPerFrame * 3000u;
+      packet.sizeBytes = kPayloadSize;
+      packet.dataPtr = new uint8_t[kPayloadSize]();
+
+      int num_frames = frame_counter.num_frames;
+      int64_t start_us = rtc::TimeMicros();
+      ASSERT_TRUE(packet_buffer.InsertPacket(&packet));
+      if (frame_counter.num_frames != num_frames)
+        packet_buffer.ClearTo(frame_counter.last_seq_num);
+      insert_us += rtc::TimeMicros() - start_us;
+    }
+    EXPECT_EQ(kNumFrames, frame_counter.num_frames);
+
+    rtc::StringBuilder story;
+    story << "max_reordering_" << max_reordering;
+    test::PrintResult("packet_buffer_insert_time", "", story.str(),
+                      1000.0 * insert_us / seq_nums.size(), "ns", false);
+  }
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -22,6 +22,181 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+uint64_t BitMask(uint32_t first_bit, uint32_t num_bits) {
+  uint64_t mask = num_bits == 64 ? ~uint64_t{0} : (uint64_t{1} << num_bits) - 1;
+  return mask << first_bit;
+}
+
+int PopCount(uint64_t x) {
+  x = x - ((x >> 1) & 0x5555555555555555ull);
+  x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+}
+
+}  // namespace
+
+template <typename T>
+constexpr int RtpFrameReferenceFinder::Tl0Table<T>::kSize;
+
+template <typename T>
+RtpFrameReferenceFinder::Tl0Table<T>::Tl0Table()
+    : empty_(true), oldest_tl0_(0), newest_tl0_(0) {
+  static_assert(kMaxLayerInfo < kSize, "");
+  static_assert(kMaxGofSaved < kSize, "");
+}
+
+template <typename T>
+T* RtpFrameReferenceFinder::Tl0Table<T>::Find(int64_t tl0) {
+  if (empty_ || tl0 < oldest_tl0_ || tl0 > newest_tl0_)
+    return nullptr;
+  absl::optional<T>& entry = EntryOf(tl0);
+  return entry ? &*entry : nullptr;
+}
+
+template <typename T>
+T* RtpFrameReferenceFinder::Tl0Table<T>::Emplace(int64_t tl0, const T& value) {
+  if (T* entry = Find(tl0))
+    return entry;
+
+  if (!empty_ && tl0 > newest_tl0_) {
+    // Make room for |tl0| by dropping the entries it would collide with.
+    EraseOlderThan(tl0 - kSize + 1);
+  }
+
+  if (empty_) {
+    empty_ = false;
+    oldest_tl0_ = tl0;
+    newest_tl0_ = tl0;
+  } else if (tl0 > newest_tl0_) {
+    newest_tl0_ = tl0;
+  } else if (tl0 < oldest_tl0_) {
+    if (newest_tl0_ - tl0 >= kSize) {
+      for (absl::optional<T>& entry : entries_)
+        entry.reset();
+      newest_tl0_ = tl0;
+    }
+    oldest_tl0_ = tl0;
+  }
+
+  absl::optional<T>& entry = EntryOf(tl0);
+  RTC_DCHECK(!entry);
+  entry.emplace(value);
+  return &*entry;
+}
+
+template <typename T>
+void RtpFrameReferenceFinder::Tl0Table<T>::EraseOlderThan(int64_t tl0) {
+  if (empty_ || tl0 <= oldest_tl0_)
+    return;
+
+  if (tl0 > newest_tl0_) {
+    for (absl::optional<T>& entry : entries_)
+      entry.reset();
+    empty_ = true;
+    return;
+  }
+
+  for (int64_t i = oldest_tl0_; i < tl0; ++i)
+    EntryOf(i).reset();
+  oldest_tl0_ = tl0;
+}
+
+template <typename T>
+absl::optional<T>& RtpFrameReferenceFinder::Tl0Table<T>::EntryOf(int64_t tl0) {
+  return entries_[static_cast<uint64_t>(tl0) % kSize];
+}
+
+template <uint32_t kRange>
+constexpr uint16_t RtpFrameReferenceFinder::SeqNumSet<kRange>::kModulus;
+template <uint32_t kRange>
+constexpr uint32_t RtpFrameReferenceFinder::SeqNumSet<kRange>::kBitsPerWord;
+
+template <uint32_t kRange>
+RtpFrameReferenceFinder::SeqNumSet<kRange>::SeqNumSet() : size_(0) {
+  static_assert(kRange % kBitsPerWord == 0, "");
+  bits_.fill(0);
+}
+
+template <uint32_t kRange>
+void RtpFrameReferenceFinder::SeqNumSet<kRange>::Insert(uint16_t seq_num) {
+  RTC_DCHECK_LT(seq_num, kRange);
+  uint64_t& word = bits_[seq_num / kBitsPerWord];
+  uint64_t bit = uint64_t{1} << (seq_num % kBitsPerWord);
+  if ((word & bit) == 0) {
+    word |= bit;
+    ++size_;
+  }
+}
+
+template <uint32_t kRange>
+void RtpFrameReferenceFinder::SeqNumSet<kRange>::Erase(uint16_t seq_num) {
+  RTC_DCHECK_LT(seq_num, kRange);
+  uint64_t& word = bits_[seq_num / kBitsPerWord];
+  uint64_t bit = uint64_t{1} << (seq_num % kBitsPerWord);
+  if ((word & bit) != 0) {
+    word &= ~bit;
+    --size_;
+  }
+}
+
+template <uint32_t kRange>
+void RtpFrameReferenceFinder::SeqNumSet<kRange>::EraseOlderThan(
+    uint16_t seq_num) {
+  if (size_ == 0)
+    return;
+
+  // Everything less than half of the range behind |seq_num| is older. At
+  // exactly half of the range, the numerically smaller one is older.
+  const uint32_t kHalfRange = kRange / 2;
+  ClearBits((seq_num + kRange - (kHalfRange - 1)) % kRange, kHalfRange - 1);
+  uint16_t opposite = (seq_num + kHalfRange) % kRange;
+  if (opposite < seq_num)
+    Erase(opposite);
+}
+
+template <uint32_t kRange>
+bool RtpFrameReferenceFinder::SeqNumSet<kRange>::ContainsAny(
+    uint16_t begin,
+    uint16_t end) const {
+  if (size_ == 0 || !AheadOf<uint16_t, kModulus>(end, begin))
+    return false;
+  return AnyBits(begin, ForwardDiff<uint16_t, kModulus>(begin, end));
+}
+
+template <uint32_t kRange>
+void RtpFrameReferenceFinder::SeqNumSet<kRange>::ClearBits(uint32_t begin,
+                                                           uint32_t count) {
+  while (count > 0) {
+    uint32_t bit = begin % kBitsPerWord;
+    uint32_t num_bits = std::min(kBitsPerWord - bit, count);
+    uint64_t& word = bits_[begin / kBitsPerWord];
+    uint64_t cleared = word & BitMask(bit, num_bits);
+    if (cleared != 0) {
+      size_ -= PopCount(cleared);
+      word &= ~cleared;
+    }
+    begin = (begin + num_bits) % kRange;
+    count -= num_bits;
+  }
+}
+
+template <uint32_t kRange>
+bool RtpFrameReferenceFinder::SeqNumSet<kRange>::AnyBits(
+    uint32_t begin,
+    uint32_t count) const {
+  while (count > 0) {
+    uint32_t bit = begin % kBitsPerWord;
+    uint32_t num_bits = std::min(kBitsPerWord - bit, count);
+    if ((bits_[begin / kBitsPerWord] & BitMask(bit, num_bits)) != 0)
+      return true;
+    begin = (begin + num_bits) % kRange;
+    count -= num_bits;
+  }
+  return false;
+}
 
 RtpFrameReferenceFinder::RtpFrameReferenceFinder(
     OnCompleteFrameCallback* frame_callback)
@@ -299,46 +474,41 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   if (AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id, last_picture_id_)) {
     do {
       last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
-      not_yet_received_frames_.insert(last_picture_id_);
+      not_yet_received_frames_.Insert(last_picture_id_);
     } while (last_picture_id_ != frame->id.picture_id);
   }
 
   int64_t unwrapped_tl0 = tl0_unwrapper_.Unwrap(codec_header.tl0PicIdx);
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
+  layer_info_.EraseOlderThan(unwrapped_tl0 - kMaxLayerInfo);
 
   // Clean up info about not yet received frames that are too old.
-  uint16_t old_picture_id =
-      Subtract<kPicIdLength>(frame->id.picture_id, kMaxNotYetReceivedFrames);
-  auto clean_frames_to = not_yet_received_frames_.lower_bound(old_picture_id);
-  not_yet_received_frames_.erase(not_yet_received_frames_.begin(),
-                                 clean_frames_to);
+  not_yet_received_frames_.EraseOlderThan(
+      Subtract<kPicIdLength>(frame->id.picture_id, kMaxNotYetReceivedFrames));
 
   if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
+    auto* layer_info = layer_info_.Emplace(unwrapped_tl0, {});
     frame->num_references = 0;
-    layer_info_[unwrapped_tl0].fill(-1);
+    layer_info->fill(-1);
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
 
-  auto layer_info_it = layer_info_.find(
+  auto* layer_info = layer_info_.Find(
       codec_header.temporalIdx == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
   // If we don't have the base layer frame yet, stash this frame.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // A non keyframe base layer frame has been received, copy the layer info
   // from the previous base layer frame and set a reference to the previous
   // base layer frame.
   if (codec_header.temporalIdx == 0) {
-    layer_info_it =
-        layer_info_.emplace(unwrapped_tl0, layer_info_it->second).first;
+    layer_info = layer_info_.Emplace(unwrapped_tl0, *layer_info);
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
   }
@@ -346,7 +516,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   // Layer sync frame, this frame only references its base layer frame.
   if (codec_header.layerSync) {
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
 
     UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
     return kHandOff;
@@ -357,29 +527,26 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   for (uint8_t layer = 0; layer <= codec_header.temporalIdx; ++layer) {
     // If we have not yet received a previous frame on this temporal layer,
     // stash this frame.
-    if (layer_info_it->second[layer] == -1)
+    if ((*layer_info)[layer] == -1)
       return kStash;
 
     // If the last frame on this layer is ahead of this frame it means that
     // a layer sync frame has been received after this frame for the same
     // base layer frame, drop this frame.
-    if (AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[layer],
+    if (AheadOf<uint16_t, kPicIdLength>((*layer_info)[layer],
                                         frame->id.picture_id)) {
       return kDrop;
     }
 
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
-    auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
-    if (not_received_frame_it != not_yet_received_frames_.end() &&
-        AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id,
-                                        *not_received_frame_it)) {
+    if (not_yet_received_frames_.ContainsAny(
+            Add<kPicIdLength>((*layer_info)[layer], 1), frame->id.picture_id)) {
       return kStash;
     }
 
     if (!(AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id,
-                                          layer_info_it->second[layer]))) {
+                                          (*layer_info)[layer]))) {
       RTC_LOG(LS_WARNING) << "Frame with picture id " << frame->id.picture_id
                           << " and packet range [" << frame->first_seq_num()
                           << ", " << frame->last_seq_num()
@@ -389,7 +556,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
     }
 
     ++frame->num_references;
-    frame->references[layer] = layer_info_it->second[layer];
+    frame->references[layer] = (*layer_info)[layer];
   }
 
   UpdateLayerInfoVp8(frame, unwrapped_tl0, codec_header.temporalIdx);
@@ -399,23 +566,23 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
 void RtpFrameReferenceFinder::UpdateLayerInfoVp8(RtpFrameObject* frame,
                                                  int64_t unwrapped_tl0,
                                                  uint8_t temporal_idx) {
-  auto layer_info_it = layer_info_.find(unwrapped_tl0);
+  auto* layer_info = layer_info_.Find(unwrapped_tl0);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_idx] != -1 &&
-        AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[temporal_idx],
+  while (layer_info) {
+    if ((*layer_info)[temporal_idx] != -1 &&
+        AheadOf<uint16_t, kPicIdLength>((*layer_info)[temporal_idx],
                                         frame->id.picture_id)) {
       // The frame was not newer, then no subsequent layer info have to be
       // update.
       break;
     }
 
-    layer_info_it->second[temporal_idx] = frame->id.picture_id;
+    (*layer_info)[temporal_idx] = frame->id.picture_id;
     ++unwrapped_tl0;
-    layer_info_it = layer_info_.find(unwrapped_tl0);
+    layer_info = layer_info_.Find(unwrapped_tl0);
   }
-  not_yet_received_frames_.erase(frame->id.picture_id);
+  not_yet_received_frames_.Erase(frame->id.picture_id);
 
   UnwrapPictureIds(frame);
 }
@@ -478,17 +645,15 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
       current_ss_idx_ = Add<kMaxGofSaved>(current_ss_idx_, 1);
       scalability_structures_[current_ss_idx_] = gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->id.picture_id;
-      gof_info_.emplace(unwrapped_tl0,
+      gof_info_.Emplace(unwrapped_tl0,
                         GofInfo(&scalability_structures_[current_ss_idx_],
                                 frame->id.picture_id));
     }
 
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = gof_info_.Find(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->id.picture_id, info);
@@ -500,12 +665,10 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
       RTC_LOG(LS_WARNING) << "Received keyframe without scalability structure";
       return kDrop;
     }
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = gof_info_.Find(unwrapped_tl0);
+    if (!info)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->id.picture_id, info);
@@ -513,27 +676,21 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
       return kHandOff;
     }
   } else {
-    auto gof_info_it = gof_info_.find(
-        (codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1 : unwrapped_tl0);
+    info = gof_info_.Find((codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1
+                                                           : unwrapped_tl0);
 
     // Gof info for this frame is not available yet, stash this frame.
-    if (gof_info_it == gof_info_.end())
+    if (!info)
       return kStash;
 
     if (codec_header.temporal_idx == 0) {
-      gof_info_it = gof_info_
-                        .emplace(unwrapped_tl0, GofInfo(gof_info_it->second.gof,
-                                                        frame->id.picture_id))
-                        .first;
+      info = gof_info_.Emplace(unwrapped_tl0,
+                               GofInfo(info->gof, frame->id.picture_id));
     }
-
-    info = &gof_info_it->second;
   }
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
+  gof_info_.EraseOlderThan(unwrapped_tl0 - kMaxGofSaved);
 
   FrameReceivedVp9(frame->id.picture_id, info);
 
@@ -598,11 +755,8 @@ bool RtpFrameReferenceFinder::MissingRequiredFrameVp9(uint16_t picture_id,
     uint16_t ref_pid =
         Subtract<kPicIdLength>(picture_id, info.gof->pid_diff[gof_idx][i]);
     for (size_t l = 0; l < temporal_idx; ++l) {
-      auto missing_frame_it = missing_frames_for_layer_[l].lower_bound(ref_pid);
-      if (missing_frame_it != missing_frames_for_layer_[l].end() &&
-          AheadOf<uint16_t, kPicIdLength>(picture_id, *missing_frame_it)) {
+      if (missing_frames_for_layer_[l].ContainsAny(ref_pid, picture_id))
         return true;
-      }
     }
   }
   return false;
@@ -633,7 +787,7 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
         return;
       }
 
-      missing_frames_for_layer_[temporal_idx].insert(last_picture_id);
+      missing_frames_for_layer_[temporal_idx].Insert(last_picture_id);
       last_picture_id = Add<kPicIdLength>(last_picture_id, 1);
     }
 
@@ -651,7 +805,7 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
       return;
     }
 
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    missing_frames_for_layer_[temporal_idx].Erase(picture_id);
   }
 }
 
@@ -706,7 +860,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
     if (AheadOf<uint16_t>(frame->id.picture_id, last_pic_id_padded)) {
       do {
         last_pic_id_padded = last_pic_id_padded + 1;
-        not_yet_received_seq_num_.insert(last_pic_id_padded);
+        not_yet_received_seq_num_.Insert(last_pic_id_padded);
       } while (last_pic_id_padded != frame->id.picture_id);
     }
   }
@@ -714,37 +868,32 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
   int64_t unwrapped_tl0 = tl0_unwrapper_.Unwrap(rtp_frame_marking.tl0_pic_idx);
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
+  layer_info_.EraseOlderThan(unwrapped_tl0 - kMaxLayerInfo);
 
   // Clean up info about not yet received frames that are too old.
-  uint16_t old_picture_id = frame->id.picture_id - kMaxNotYetReceivedFrames * 2;
-  auto clean_frames_to = not_yet_received_seq_num_.lower_bound(old_picture_id);
-  not_yet_received_seq_num_.erase(not_yet_received_seq_num_.begin(),
-                                  clean_frames_to);
+  not_yet_received_seq_num_.EraseOlderThan(frame->id.picture_id -
+                                           kMaxNotYetReceivedFrames * 2);
 
   if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
+    auto* layer_info = layer_info_.Emplace(unwrapped_tl0, {});
     frame->num_references = 0;
-    layer_info_[unwrapped_tl0].fill(-1);
+    layer_info->fill(-1);
     UpdateDataH264(frame, unwrapped_tl0, tid);
     return kHandOff;
   }
 
-  auto layer_info_it =
-      layer_info_.find(tid == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
+  auto* layer_info =
+      layer_info_.Find(tid == 0 ? unwrapped_tl0 - 1 : unwrapped_tl0);
 
   // Stash if we have no base layer frame yet.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // Base layer frame. Copy layer info from previous base layer frame.
   if (tid == 0) {
-    layer_info_it =
-        layer_info_.insert(std::make_pair(unwrapped_tl0, layer_info_it->second))
-            .first;
+    layer_info = layer_info_.Emplace(unwrapped_tl0, *layer_info);
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateDataH264(frame, unwrapped_tl0, tid);
     return kHandOff;
   }
@@ -752,7 +901,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
   // This frame only references its base layer frame.
   if (blSync) {
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateDataH264(frame, unwrapped_tl0, tid);
     return kHandOff;
   }
@@ -761,20 +910,18 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
   frame->num_references = 0;
   for (uint8_t layer = 0; layer <= tid; ++layer) {
     // Stash if we have not yet received frames on this temporal layer.
-    if (layer_info_it->second[layer] == -1)
+    if ((*layer_info)[layer] == -1)
       return kStash;
 
     // Drop if the last frame on this layer is ahead of this frame. A layer sync
     // frame was received after this frame for the same base layer frame.
-    uint16_t last_frame_in_layer = layer_info_it->second[layer];
+    uint16_t last_frame_in_layer = (*layer_info)[layer];
     if (AheadOf<uint16_t>(last_frame_in_layer, frame->id.picture_id))
       return kDrop;
 
     // Stash and wait for missing frame between this frame and the reference
-    auto not_received_seq_num_it =
-        not_yet_received_seq_num_.upper_bound(last_frame_in_layer);
-    if (not_received_seq_num_it != not_yet_received_seq_num_.end() &&
-        AheadOf<uint16_t>(frame->id.picture_id, *not_received_seq_num_it)) {
+    if (not_yet_received_seq_num_.ContainsAny(last_frame_in_layer + 1,
+                                              frame->id.picture_id)) {
       return kStash;
     }
 
@@ -815,20 +962,19 @@ void RtpFrameReferenceFinder::UpdateLastPictureIdWithPaddingH264() {
 void RtpFrameReferenceFinder::UpdateLayerInfoH264(RtpFrameObject* frame,
                                                   int64_t unwrapped_tl0,
                                                   uint8_t temporal_idx) {
-  auto layer_info_it = layer_info_.find(unwrapped_tl0);
+  auto* layer_info = layer_info_.Find(unwrapped_tl0);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_idx] != -1 &&
-        AheadOf<uint16_t>(layer_info_it->second[temporal_idx],
-                          frame->id.picture_id)) {
+  while (layer_info) {
+    if ((*layer_info)[temporal_idx] != -1 &&
+        AheadOf<uint16_t>((*layer_info)[temporal_idx], frame->id.picture_id)) {
       // Not a newer frame. No subsequent layer info needs update.
       break;
     }
 
-    layer_info_it->second[temporal_idx] = frame->id.picture_id;
+    (*layer_info)[temporal_idx] = frame->id.picture_id;
     ++unwrapped_tl0;
-    layer_info_it = layer_info_.find(unwrapped_tl0);
+    layer_info = layer_info_.Find(unwrapped_tl0);
   }
 
   for (size_t i = 0; i < frame->num_references; ++i)
@@ -854,7 +1000,7 @@ void RtpFrameReferenceFinder::UpdateDataH264(RtpFrameObject* frame,
   uint16_t last_seq_num_padded = seq_num_it->second.second;
   for (uint16_t n = frame->first_seq_num(); AheadOrAt(last_seq_num_padded, n);
        ++n) {
-    not_yet_received_seq_num_.erase(n);
+    not_yet_received_seq_num_.Erase(n);
   }
 }
 
@@ -18,6 +18,7 @@
 #include <set>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/video_coding/codecs/vp9/include/vp9_globals.h"
@@ -79,6 +80,67 @@ class RtpFrameReferenceFinder {
     uint16_t last_picture_id;
   };
 
+  // Flat circular table holding a |T| for each of the last |kSize| unwrapped
+  // TL0 picture indices.
+  template <typename T>
+  class Tl0Table {
+   public:
+    Tl0Table();
+
+    // Returns the entry of |tl0|, or nullptr if there is none.
+    T* Find(int64_t tl0);
+
+    // Returns the entry of |tl0|, inserting a copy of |value| if there is none.
+    // If |tl0| is too old to be held together with the newest entry, the
+    // TL0 index has jumped backwards and all newer entries are dropped.
+    T* Emplace(int64_t tl0, const T& value);
+
+    // Removes all entries older than |tl0|.
+    void EraseOlderThan(int64_t tl0);
+
+   private:
+    static constexpr int kSize = 64;
+
+    absl::optional<T>& EntryOf(int64_t tl0);
+
+    std::array<absl::optional<T>, kSize> entries_;
+    // Unless the table is empty, all entries are within
+    // [|oldest_tl0_|, |newest_tl0_|].
+    bool empty_;
+    int64_t oldest_tl0_;
+    int64_t newest_tl0_;
+  };
+
+  // Set of sequence numbers or picture ids wrapping at |kRange|, backed by a
+  // bitmap over the whole range so that updates and interval queries don't
+  // need to allocate or rebalance a tree.
+  template <uint32_t kRange>
+  class SeqNumSet {
+   public:
+    SeqNumSet();
+
+    void Insert(uint16_t seq_num);
+    void Erase(uint16_t seq_num);
+
+    // Erases every sequence number older than |seq_num|.
+    void EraseOlderThan(uint16_t seq_num);
+
+    // Returns true if the set holds a sequence number in [|begin|, |end|).
+    bool ContainsAny(uint16_t begin, uint16_t end) const;
+
+   private:
+    static constexpr uint16_t kModulus = kRange == (1 << 16) ? 0 : kRange;
+    static constexpr uint32_t kBitsPerWord = 64;
+
+    // Clears, or tests, |count| bits starting at |begin| and wrapping at
+    // |kRange|.
+    void ClearBits(uint32_t begin, uint32_t count);
+    bool AnyBits(uint32_t begin, uint32_t count) const;
+
+    std::array<uint64_t, kRange / kBitsPerWord> bits_;
+    size_t size_;
+  };
+
   // Find the relevant group of pictures and update its "last-picture-id-with
   // padding" sequence number.
   void UpdateLastPictureIdWithPadding(uint16_t seq_num);
@@ -163,12 +225,11 @@ class RtpFrameReferenceFinder {
 
   // Frames earlier than the last received frame that have not yet been
   // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
-      not_yet_received_frames_;
+  SeqNumSet<kPicIdLength> not_yet_received_frames_;
 
   // Sequence numbers of frames earlier than the last received frame that
   // have not yet been fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> not_yet_received_seq_num_;
+  SeqNumSet<1 << 16> not_yet_received_seq_num_;
 
   // Frames that have been fully received but didn't have all the information
   // needed to determine their references.
@@ -176,7 +237,7 @@ class RtpFrameReferenceFinder {
 
   // Holds the information about the last completed frame for a given temporal
   // layer given an unwrapped Tl0 picture index.
-  std::map<int64_t, std::array<int64_t, kMaxTemporalLayers>> layer_info_;
+  Tl0Table<std::array<int64_t, kMaxTemporalLayers>> layer_info_;
 
   // Where the current scalability structure is in the
   // |scalability_structures_| array.
@@ -186,7 +247,7 @@ class RtpFrameReferenceFinder {
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
   // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  Tl0Table<GofInfo> gof_info_;
 
   // Keep track of which picture id and which temporal layer that had the
   // up switch flag set.
@@ -194,8 +255,7 @@ class RtpFrameReferenceFinder {
       up_switch_;
 
   // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>,
-             kMaxTemporalLayers>
+  std::array<SeqNumSet<kPicIdLength>, kMaxTemporalLayers>
       missing_frames_for_layer_;
 
   // How far frames have been cleared by sequence number. A frame will be
@@ -424,6 +424,22 @@ TEST_F(TestRtpFrameReferenceFinder, Vp8TemporalLayers_0) {
   CheckReferencesVp8(pid + 3, pid + 2);
 }
 
+TEST_F(TestRtpFrameReferenceFinder, Vp8KeyFrameAfterTl0JumpsBack) {
+  uint16_t pid = Rand();
+  uint16_t sn = Rand();
+
+  InsertVp8(sn, sn, true, pid, 0, 0);
+  for (int i = 1; i <= 100; ++i)
+    InsertVp8(sn + i, sn + i, false, pid + i, 0, i);
+  InsertVp8(sn + 101, sn + 101, true, pid + 101, 0, 10);
+  InsertVp8(sn + 102, sn + 102, false, pid + 102, 0, 11);
+
+  ASSERT_EQ(103UL, frames_from_callback_.size());
+  CheckReferencesVp8(pid + 100, pid + 99);
+  CheckReferencesVp8(pid + 101);
+  CheckReferencesVp8(pid + 102, pid + 101);
+}
+
 TEST_F(TestRtpFrameReferenceFinder, Vp8DuplicateTl1Frames) {
   uint16_t pid = Rand();
   uint16_t sn = Rand();
@@ -13,6 +13,7 @@
 #include <assert.h>
 #include <string.h>
 
+#include <iterator>
 #include <vector>
 
 #include "absl/types/variant.h"
@@ -38,6 +39,7 @@ VCMSessionInfo::VCMSessionInfo()
     : complete_(false),
       frame_type_(VideoFrameType::kVideoFrameDelta),
       packets_(),
+      session_length_(0),
       empty_seq_num_low_(-1),
       empty_seq_num_high_(-1),
       first_packet_seq_num_(-1),
@@ -173,7 +175,8 @@ void VCMSessionInfo::SetGofInfo(const GofInfoVP9& gof_info, size_t idx) {
 void VCMSessionInfo::Reset() {
   complete_ = false;
   frame_type_ = VideoFrameType::kVideoFrameDelta;
-  packets_.clear();
+  free_packets_.splice(free_packets_.end(), packets_);
+  session_length_ = 0;
   empty_seq_num_low_ = -1;
   empty_seq_num_high_ = -1;
   first_packet_seq_num_ = -1;
@@ -181,10 +184,7 @@ void VCMSessionInfo::Reset() {
 }
 
 size_t VCMSessionInfo::SessionLength() const {
-  size_t length = 0;
-  for (PacketIteratorConst it = packets_.begin(); it != packets_.end(); ++it)
-    length += (*it).sizeBytes;
-  return length;
+  return session_length_;
 }
 
 int VCMSessionInfo::NumPackets() const {
@@ -194,12 +194,12 @@ int VCMSessionInfo::NumPackets() const {
 size_t VCMSessionInfo::InsertBuffer(uint8_t* frame_buffer,
                                     PacketIterator packet_it) {
   VCMPacket& packet = *packet_it;
-  PacketIterator it;
 
-  // Calculate the offset into the frame buffer for this packet.
-  size_t offset = 0;
-  for (it = packets_.begin(); it != packet_it; ++it)
-    offset += (*it).sizeBytes;
+  // Calculate the offset into the frame buffer for this packet. Packets mostly
+  // arrive in order, so count from the end of the session.
+  size_t offset = session_length_;
+  for (PacketIterator it = std::next(packet_it); it != packets_.end(); ++it)
+    offset -= (*it).sizeBytes;
 
   // Set the data pointer to pointing to the start of this packet in the
   // frame buffer.
@@ -337,6 +337,7 @@ size_t VCMSessionInfo::DeletePacketData(PacketIterator start,
   }
   if (bytes_to_delete > 0)
     ShiftSubsequentPackets(end, -static_cast<int>(bytes_to_delete));
+  session_length_ -= bytes_to_delete;
   return bytes_to_delete;
 }
 
@@ -499,9 +500,17 @@ int VCMSessionInfo::InsertPacket(const VCMPacket& packet,
   }
 
   // The insert operation invalidates the iterator |rit|.
-  PacketIterator packet_list_it = packets_.insert(rit.base(), packet);
+  PacketIterator packet_list_it;
+  if (free_packets_.empty()) {
+    packet_list_it = packets_.insert(rit.base(), packet);
+  } else {
+    packet_list_it = free_packets_.begin();
+    *packet_list_it = packet;
+    packets_.splice(rit.base(), free_packets_, packet_list_it);
+  }
 
   size_t returnLength = InsertBuffer(frame_buffer, packet_list_it);
+  session_length_ += returnLength;
   UpdateCompleteSession();
 
   return static_cast<int>(returnLength);
@@ -106,6 +106,11 @@ class VCMSessionInfo {
   webrtc::VideoFrameType frame_type_;
   // Packets in this frame.
   PacketList packets_;
+  // Packets of previous frames, kept so that their list nodes can be reused
+  // by InsertPacket() instead of allocating new ones.
+  PacketList free_packets_;
+  // Sum of the sizes of |packets_| in the frame buffer.
+  size_t session_length_;
   int empty_seq_num_low_;
   int empty_seq_num_high_;
 
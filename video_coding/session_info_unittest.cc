@@ -172,6 +172,44 @@ TEST_F(TestSessionInfo, NormalOperation) {
   }
 }
 
+TEST_F(TestSessionInfo, OutOfOrderPacketsAfterReset) {
+  // Fill the session once, so that the second frame reuses its packets.
+  packet_.video_header.is_first_packet_in_frame = false;
+  for (int i = 0; i < 10; ++i) {
+    packet_.seqNum = i;
+    FillPacket(100 + i);
+    ASSERT_EQ(packet_buffer_size(), static_cast<size_t>(session_.InsertPacket(
+                                        packet_, frame_buffer_, frame_data)));
+  }
+  session_.Reset();
+  EXPECT_EQ(0, session_.NumPackets());
+  EXPECT_EQ(0u, session_.SessionLength());
+
+  // Insert the packets of the second frame in the order 0, 9, 8, ..., 1.
+  packet_.seqNum = 0;
+  packet_.video_header.is_first_packet_in_frame = true;
+  FillPacket(0);
+  ASSERT_EQ(packet_buffer_size(), static_cast<size_t>(session_.InsertPacket(
+                                      packet_, frame_buffer_, frame_data)));
+  packet_.video_header.is_first_packet_in_frame = false;
+  for (int i = 9; i > 0; --i) {
+    packet_.seqNum = i;
+    packet_.markerBit = i == 9;
+    FillPacket(i);
+    ASSERT_EQ(packet_buffer_size(), static_cast<size_t>(session_.InsertPacket(
+                                        packet_, frame_buffer_, frame_data)));
+  }
+
+  EXPECT_EQ(10, session_.NumPackets());
+  EXPECT_EQ(10 * packet_buffer_size(), session_.SessionLength());
+  EXPECT_EQ(0, session_.LowSequenceNumber());
+  EXPECT_EQ(9, session_.HighSequenceNumber());
+  for (int i = 0; i < 10; ++i) {
+    SCOPED_TRACE("Calling VerifyPacket");
+    VerifyPacket(frame_buffer_ + i * packet_buffer_size(), i);
+  }
+}
+
 TEST_F(TestSessionInfo, OutOfBoundsPackets1PacketFrame) {
   packet_.seqNum = 0x0001;
   packet_.video_header.is_first_packet_in_frame = true;
@@ -0,0 +1,383 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/test/receive_pipeline_benchmark.h"
+
+#include <string.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/include/module_common_types.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/video_coding/frame_buffer2.h"
+#include "modules/video_coding/frame_object.h"
+#include "modules/video_coding/h264_sps_pps_tracker.h"
+#include "modules/video_coding/nack_module.h"
+#include "modules/video_coding/packet.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "modules/video_coding/timing.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+using Component = ReceivePipelineBenchmark::Component;
+using video_coding::EncodedFrame;
+using video_coding::RtpFrameObject;
+
+// Same sizes as used by the video receive stream.
+constexpr size_t kPacketBufferStartSize = 512;
+constexpr size_t kPacketBufferMaxSize = 2048;
+// Keeps the simulated clock away from zero, which some components treat as
+// unset.
+constexpr int64_t kStartTimeMs = 100000;
+
+// RTCP packet types are 192-223, which as RTP would be a marker bit and a
+// payload type of 64-95.
+bool IsRtcpPacket(rtc::ArrayView<const uint8_t> data) {
+  return data.size() >= 2 && data[1] >= 192 && data[1] <= 223;
+}
+
+// Owns the receive pipeline of one replay, and attributes the elapsed time to
+// the component that is currently running. Components call each other
+// synchronously, e.g. the PacketBuffer hands assembled frames to the
+// reference finder from within InsertPacket(), so every component entry is
+// wrapped in a ScopedComponent that restores the caller when it ends.
+class ReceivePipeline : public video_coding::OnAssembledFrameCallback,
+                        public video_coding::OnCompleteFrameCallback,
+                        public NackSender,
+                        public KeyFrameRequestSender {
+ public:
+  ReceivePipeline(const ReceivePipelineBenchmark::Config& config,
+                  ReceivePipelineBenchmark::Result* result)
+      : config_(config),
+        result_(result),
+        clock_(kStartTimeMs * rtc::kNumMicrosecsPerMillisec),
+        timing_(&clock_),
+        packet_buffer_(&clock_,
+                       kPacketBufferStartSize,
+                       kPacketBufferMaxSize,
+                       this),
+        reference_finder_(this),
+        frame_buffer_(&clock_, &timing_, nullptr),
+        nack_module_(&clock_, this, this),
+        ssrc_(config.ssrc),
+        received_packet_(&config_.extensions) {
+    for (const auto& payload_type : config_.payload_types) {
+      depacketizers_[payload_type.first].reset(
+          RtpDepacketizer::Create(payload_type.second));
+    }
+  }
+
+  void Replay(MappedRtpFile* dump) {
+    const int64_t start_ns = rtc::TimeNanos();
+    last_switch_ns_ = start_ns;
+    absl::optional<uint32_t> first_time_ms;
+    MappedRtpFile::Packet dump_packet;
+    while (dump->NextPacket(&dump_packet)) {
+      if (dump_packet.is_rtcp || IsRtcpPacket(dump_packet.data)) {
+        ++result_->skipped_packets;
+        continue;
+      }
+      if (!first_time_ms)
+        first_time_ms = dump_packet.time_ms;
+      const int64_t arrival_time_ms =
+          kStartTimeMs + dump_packet.time_ms - *first_time_ms;
+      if (arrival_time_ms > clock_.TimeInMilliseconds()) {
+        clock_.AdvanceTimeMilliseconds(arrival_time_ms -
+                                       clock_.TimeInMilliseconds());
+      }
+      MaybeProcessNack();
+      OnRtpPacket(dump_packet.data, arrival_time_ms);
+    }
+    SwitchTo(ReceivePipelineBenchmark::kOther);
+    result_->total_time_ns = last_switch_ns_ - start_ns;
+  }
+
+  // Implements OnAssembledFrameCallback.
+  void OnAssembledFrame(std::unique_ptr<RtpFrameObject> frame) override {
+    ++result_->assembled_frames;
+    ScopedComponent scoped(this, ReceivePipelineBenchmark::kReferenceFinder);
+    reference_finder_.ManageFrame(std::move(frame));
+  }
+
+  // Implements OnCompleteFrameCallback.
+  void OnCompleteFrame(std::unique_ptr<EncodedFrame> frame) override {
+    ++result_->complete_frames;
+    ScopedComponent scoped(this, ReceivePipelineBenchmark::kFrameBuffer);
+    RtpFrameObject* rtp_frame = static_cast<RtpFrameObject*>(frame.get());
+    last_seq_num_for_pic_id_[rtp_frame->id.picture_id] =
+        rtp_frame->last_seq_num();
+    frame_buffer_.InsertFrame(std::move(frame));
+    // Hand every frame that is ready over to a "decoder" right away.
+    std::unique_ptr<EncodedFrame> decodable_frame;
+    while (frame_buffer_.NextFrame(0, &decodable_frame, keyframe_required_) ==
+           video_coding::FrameBuffer::kFrameFound) {
+      ++result_->decoded_frames;
+      keyframe_required_ = false;
+      pending_decoded_picture_ids_.push_back(decodable_frame->id.picture_id);
+    }
+  }
+
+  // Implements NackSender.
+  void SendNack(const std::vector<uint16_t>& sequence_numbers,
+                bool buffering_allowed) override {
+    result_->nacked_packets += static_cast<int>(sequence_numbers.size());
+  }
+
+  // Implements KeyFrameRequestSender.
+  void RequestKeyFrame() override { ++result_->keyframe_requests; }
+
+ private:
+  class ScopedComponent {
+   public:
+    ScopedComponent(ReceivePipeline* pipeline, Component component)
+        : pipeline_(pipeline), previous_(pipeline->SwitchTo(component)) {}
+    ~ScopedComponent() { pipeline_->SwitchTo(previous_); }
+
+   private:
+    ReceivePipeline* const pipeline_;
+    const Component previous_;
+  };
+
+  // Charges the time since the last switch to the current component and
+  // makes |component| current. Returns the previous component.
+  Component SwitchTo(Component component) {
+    const int64_t now_ns = rtc::TimeNanos();
+    result_->component_time_ns[current_] += now_ns - last_switch_ns_;
+    last_switch_ns_ = now_ns;
+    const Component previous = current_;
+    current_ = component;
+    return previous;
+  }
+
+  void MaybeProcessNack() {
+    ScopedComponent scoped(this, ReceivePipelineBenchmark::kNack);
+    if (nack_module_.TimeUntilNextProcess() <= 0)
+      nack_module_.Process();
+  }
+
+  void OnRtpPacket(rtc::ArrayView<const uint8_t> data,
+                   int64_t arrival_time_ms) {
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kRtpParsing);
+      // Copies the packet, like receiving it from the network does.
+      if (!received_packet_.Parse(data)) {
+        ++result_->skipped_packets;
+        return;
+      }
+      received_packet_.set_arrival_time_ms(arrival_time_ms);
+    }
+    auto depacketizer = depacketizers_.find(received_packet_.PayloadType());
+    if (depacketizer == depacketizers_.end() ||
+        (ssrc_ && *ssrc_ != received_packet_.Ssrc())) {
+      ++result_->skipped_packets;
+      return;
+    }
+    ssrc_ = received_packet_.Ssrc();
+    ++result_->packets;
+    const uint16_t seq_num = received_packet_.SequenceNumber();
+    if (received_packet_.payload_size() == 0) {
+      OnPaddingPacket(seq_num);
+      return;
+    }
+
+    VCMPacket packet;
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kRtpParsing);
+      RTPHeader rtp_header;
+      received_packet_.GetHeader(&rtp_header);
+      RtpDepacketizer::ParsedPayload parsed_payload;
+      {
+        ScopedComponent depacketization(
+            this, ReceivePipelineBenchmark::kDepacketization);
+        if (!depacketizer->second->Parse(&parsed_payload,
+                                         received_packet_.payload().data(),
+                                         received_packet_.payload_size())) {
+          ++result_->skipped_packets;
+          return;
+        }
+      }
+      if (parsed_payload.payload_length == 0) {
+        OnPaddingPacket(seq_num);
+        return;
+      }
+      parsed_payload.video_header().is_last_packet_in_frame |=
+          rtp_header.markerBit;
+      packet = VCMPacket(parsed_payload.payload, parsed_payload.payload_length,
+                         rtp_header, parsed_payload.video_header(),
+                         /*ntp_time_ms=*/0, arrival_time_ms);
+    }
+
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kNack);
+      const bool is_keyframe =
+          packet.is_first_packet_in_frame() &&
+          packet.video_header.frame_type == VideoFrameType::kVideoFrameKey;
+      nack_module_.OnReceivedPacket(seq_num, is_keyframe);
+    }
+
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kDepacketization);
+      if (packet.codec() == kVideoCodecH264) {
+        // The tracker replaces the payload by a copy with the start codes and
+        // any stored SPS/PPS prepended.
+        switch (h264_tracker_.CopyAndFixBitstream(&packet)) {
+          case video_coding::H264SpsPpsTracker::kRequestKeyframe:
+            RequestKeyFrame();
+            return;
+          case video_coding::H264SpsPpsTracker::kDrop:
+            return;
+          case video_coding::H264SpsPpsTracker::kInsert:
+            break;
+        }
+      } else if (!packet.SetSharedPayload(received_packet_.Buffer(),
+                                          rtc::MakeArrayView(
+                                              packet.dataPtr,
+                                              packet.sizeBytes))) {
+        uint8_t* payload = new uint8_t[packet.sizeBytes];
+        memcpy(payload, packet.dataPtr, packet.sizeBytes);
+        packet.dataPtr = payload;
+      }
+    }
+
+    bool inserted;
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kPacketBuffer);
+      inserted = packet_buffer_.InsertPacket(&packet);
+    }
+    if (!inserted)
+      RequestKeyFrame();
+    ReleaseDecodedFrames();
+  }
+
+  void OnPaddingPacket(uint16_t seq_num) {
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kNack);
+      nack_module_.OnReceivedPacket(seq_num, /*is_keyframe=*/false);
+    }
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kPacketBuffer);
+      packet_buffer_.PaddingReceived(seq_num);
+    }
+    {
+      ScopedComponent scoped(this, ReceivePipelineBenchmark::kReferenceFinder);
+      reference_finder_.PaddingReceived(seq_num);
+    }
+    ReleaseDecodedFrames();
+  }
+
+  // Drops the packets of decoded frames from the earlier components, the way
+  // the video receive stream does once a frame has been decoded.
+  void ReleaseDecodedFrames() {
+    for (int64_t picture_id : pending_decoded_picture_ids_) {
+      auto seq_num_it = last_seq_num_for_pic_id_.find(picture_id);
+      if (seq_num_it == last_seq_num_for_pic_id_.end())
+        continue;
+      const uint16_t last_seq_num = seq_num_it->second;
+      last_seq_num_for_pic_id_.erase(last_seq_num_for_pic_id_.begin(),
+                                     ++seq_num_it);
+      {
+        ScopedComponent scoped(this, ReceivePipelineBenchmark::kPacketBuffer);
+        packet_buffer_.ClearTo(last_seq_num);
+      }
+      {
+        ScopedComponent scoped(this,
+                               ReceivePipelineBenchmark::kReferenceFinder);
+        reference_finder_.ClearTo(last_seq_num);
+      }
+      {
+        ScopedComponent scoped(this, ReceivePipelineBenchmark::kNack);
+        nack_module_.ClearUpTo(last_seq_num);
+      }
+    }
+    pending_decoded_picture_ids_.clear();
+  }
+
+  const ReceivePipelineBenchmark::Config& config_;
+  ReceivePipelineBenchmark::Result* const result_;
+  Component current_ = ReceivePipelineBenchmark::kOther;
+  int64_t last_switch_ns_ = 0;
+
+  SimulatedClock clock_;
+  VCMTiming timing_;
+  video_coding::PacketBuffer packet_buffer_;
+  video_coding::RtpFrameReferenceFinder reference_finder_;
+  video_coding::FrameBuffer frame_buffer_;
+  NackModule nack_module_;
+  video_coding::H264SpsPpsTracker h264_tracker_;
+  std::map<uint8_t, std::unique_ptr<RtpDepacketizer>> depacketizers_;
+
+  absl::optional<uint32_t> ssrc_;
+  RtpPacketReceived received_packet_;
+  bool keyframe_required_ = true;
+  std::map<int64_t, uint16_t> last_seq_num_for_pic_id_;
+  std::vector<int64_t> pending_decoded_picture_ids_;
+};
+
+}  // namespace
+
+double ReceivePipelineBenchmark::Result::PacketsPerSecond() const {
+  if (total_time_ns <= 0)
+    return 0.0;
+  return packets * static_cast<double>(rtc::kNumNanosecsPerSec) /
+         total_time_ns;
+}
+
+double ReceivePipelineBenchmark::Result::ComponentNsPerPacket(
+    Component component) const {
+  if (packets == 0)
+    return 0.0;
+  return static_cast<double>(component_time_ns[component]) / packets;
+}
+
+const char* ReceivePipelineBenchmark::ComponentName(Component component) {
+  switch (component) {
+    case kRtpParsing:
+      return "rtp_parsing";
+    case kDepacketization:
+      return "depacketization";
+    case kNack:
+      return "nack_module";
+    case kPacketBuffer:
+      return "packet_buffer";
+    case kReferenceFinder:
+      return "reference_finder";
+    case kFrameBuffer:
+      return "frame_buffer";
+    case kOther:
+      return "other";
+    case kNumComponents:
+      break;
+  }
+  RTC_NOTREACHED();
+  return "";
+}
+
+ReceivePipelineBenchmark::Result ReceivePipelineBenchmark::Run(
+    const Config& config,
+    MappedRtpFile* dump) {
+  Result result;
+  ReceivePipeline pipeline(config, &result);
+  pipeline.Replay(dump);
+  return result;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_TEST_RECEIVE_PIPELINE_BENCHMARK_H_
+#define MODULES_VIDEO_CODING_TEST_RECEIVE_PIPELINE_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <map>
+
+#include "absl/types/optional.h"
+#include "api/video/video_codec_type.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/test/mapped_rtp_file.h"
+
+namespace webrtc {
+namespace test {
+
+// Pushes the video packets of an rtpdump or pcap file through the receive side
+// of the video pipeline as fast as possible: RTP parsing, depacketization, the
+// NackModule, the PacketBuffer, the RtpFrameReferenceFinder and the
+// FrameBuffer. A simulated clock follows the recorded arrival times, and every
+// frame released by the FrameBuffer is treated as decoded. The time spent in
+// each component is measured separately.
+class ReceivePipelineBenchmark {
+ public:
+  enum Component {
+    kRtpParsing = 0,
+    kDepacketization,
+    kNack,
+    kPacketBuffer,
+    kReferenceFinder,
+    kFrameBuffer,
+    kOther,  // Reading the dump and the replay loop itself.
+    kNumComponents
+  };
+
+  struct Config {
+    // Codecs of the replayed RTP payload types. Packets with other payload
+    // types, e.g. RTX or FEC, are skipped.
+    std::map<uint8_t, VideoCodecType> payload_types;
+    // The replayed stream. If unset, the SSRC of the first packet with one of
+    // |payload_types| is used.
+    absl::optional<uint32_t> ssrc;
+    // The header extensions negotiated for the recorded stream.
+    RtpHeaderExtensionMap extensions;
+  };
+
+  struct Result {
+    // Packets of the replayed stream.
+    int packets = 0;
+    // RTCP, packets of other streams and packets that failed to parse.
+    int skipped_packets = 0;
+    int assembled_frames = 0;
+    int complete_frames = 0;
+    int decoded_frames = 0;
+    int nacked_packets = 0;
+    int keyframe_requests = 0;
+    // The wall clock time of the whole replay, in nanoseconds.
+    int64_t total_time_ns = 0;
+    // The time spent in each component, in nanoseconds. Sums up to
+    // |total_time_ns|.
+    std::array<int64_t, kNumComponents> component_time_ns = {};
+
+    double PacketsPerSecond() const;
+    // Returns the time, in ns, spent in |component| per replayed packet.
+    double ComponentNsPerPacket(Component component) const;
+  };
+
+  static const char* ComponentName(Component component);
+
+  // Replays |dump| from its current position to its end.
+  static Result Run(const Config& config, MappedRtpFile* dump);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_TEST_RECEIVE_PIPELINE_BENCHMARK_H_
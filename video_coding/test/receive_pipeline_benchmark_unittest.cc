@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/test/receive_pipeline_benchmark.h"
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtp_format_video_generic.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "modules/rtp_rtcp/test/mapped_rtp_file.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr uint8_t kPayloadType = 96;
+constexpr uint32_t kSsrc = 0x1234;
+constexpr int kNumFrames = 30;
+constexpr int kPacketsPerFrame = 3;
+constexpr size_t kPayloadSize = 500;
+
+// Writes an rtpdump file, in the format of the rtpplay tools.
+class RtpDumpWriter {
+ public:
+  RtpDumpWriter() {
+    const std::string first_line = "#!rtpplay1.0 127.0.0.1/5000\n";
+    contents_.assign(first_line.begin(), first_line.end());
+    contents_.resize(contents_.size() + 16);
+  }
+
+  void AddPacket(const uint8_t* data,
+                 size_t size,
+                 uint32_t offset_ms,
+                 bool is_rtcp) {
+    uint8_t header[8];
+    ByteWriter<uint16_t>::WriteBigEndian(
+        header, static_cast<uint16_t>(size + sizeof(header)));
+    ByteWriter<uint16_t>::WriteBigEndian(
+        header + 2, is_rtcp ? 0 : static_cast<uint16_t>(size));
+    ByteWriter<uint32_t>::WriteBigEndian(header + 4, offset_ms);
+    contents_.insert(contents_.end(), header, header + sizeof(header));
+    contents_.insert(contents_.end(), data, data + size);
+  }
+
+  // Adds the packets of a generic codec stream, one key frame followed by
+  // delta frames, at 30 fps. Skips the packet with |dropped_seq_num|.
+  void AddStream(uint32_t ssrc, int dropped_seq_num = -1) {
+    uint16_t seq_num = 0;
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      for (int i = 0; i < kPacketsPerFrame; ++i, ++seq_num) {
+        if (seq_num == dropped_seq_num)
+          continue;
+        RtpPacket packet;
+        packet.SetPayloadType(kPayloadType);
+        packet.SetSequenceNumber(seq_num);
+        packet.SetTimestamp(frame * 3000);
+        packet.SetSsrc(ssrc);
+        packet.SetMarker(i == kPacketsPerFrame - 1);
+        uint8_t* payload = packet.AllocatePayload(kPayloadSize);
+        payload[0] = 0;
+        if (frame == 0)
+          payload[0] |= RtpFormatVideoGeneric::kKeyFrameBit;
+        if (i == 0)
+          payload[0] |= RtpFormatVideoGeneric::kFirstPacketBit;
+        AddPacket(packet.data(), packet.size(), frame * 33, false);
+      }
+    }
+  }
+
+  void AddRtcp() {
+    // An empty receiver report.
+    const uint8_t kReceiverReport[] = {0x80, 201, 0x00, 0x01,
+                                       0x00, 0x00, 0x12, 0x34};
+    AddPacket(kReceiverReport, sizeof(kReceiverReport), 0, true);
+  }
+
+  std::string WriteToFile() const {
+    const std::string file_name = TempFilename(OutputPath(), "rtpdump");
+    FILE* file = fopen(file_name.c_str(), "wb");
+    EXPECT_TRUE(file);
+    if (file) {
+      fwrite(contents_.data(), 1, contents_.size(), file);
+      fclose(file);
+    }
+    return file_name;
+  }
+
+ private:
+  std::vector<uint8_t> contents_;
+};
+
+ReceivePipelineBenchmark::Config GenericConfig() {
+  ReceivePipelineBenchmark::Config config;
+  config.payload_types[kPayloadType] = kVideoCodecGeneric;
+  return config;
+}
+
+}  // namespace
+
+TEST(ReceivePipelineBenchmarkTest, DecodesEveryFrameOfTheStream) {
+  RtpDumpWriter writer;
+  writer.AddRtcp();
+  writer.AddStream(kSsrc);
+  const std::string file_name = writer.WriteToFile();
+  std::unique_ptr<MappedRtpFile> dump = MappedRtpFile::Open(file_name);
+  ASSERT_TRUE(dump);
+
+  const ReceivePipelineBenchmark::Result result =
+      ReceivePipelineBenchmark::Run(GenericConfig(), dump.get());
+  EXPECT_EQ(kNumFrames * kPacketsPerFrame, result.packets);
+  EXPECT_EQ(1, result.skipped_packets);
+  EXPECT_EQ(kNumFrames, result.assembled_frames);
+  EXPECT_EQ(kNumFrames, result.complete_frames);
+  EXPECT_EQ(kNumFrames, result.decoded_frames);
+  EXPECT_EQ(0, result.nacked_packets);
+  EXPECT_EQ(0, result.keyframe_requests);
+
+  int64_t component_time_ns = 0;
+  for (int64_t time_ns : result.component_time_ns)
+    component_time_ns += time_ns;
+  EXPECT_EQ(result.total_time_ns, component_time_ns);
+  EXPECT_GT(result.PacketsPerSecond(), 0.0);
+  RemoveFile(file_name);
+}
+
+TEST(ReceivePipelineBenchmarkTest, ReplaysOnlyTheSelectedStream) {
+  RtpDumpWriter writer;
+  writer.AddStream(kSsrc + 1);
+  writer.AddStream(kSsrc);
+  const std::string file_name = writer.WriteToFile();
+  std::unique_ptr<MappedRtpFile> dump = MappedRtpFile::Open(file_name);
+  ASSERT_TRUE(dump);
+
+  ReceivePipelineBenchmark::Config config = GenericConfig();
+  config.ssrc = kSsrc;
+  const ReceivePipelineBenchmark::Result result =
+      ReceivePipelineBenchmark::Run(config, dump.get());
+  EXPECT_EQ(kNumFrames * kPacketsPerFrame, result.packets);
+  EXPECT_EQ(kNumFrames * kPacketsPerFrame, result.skipped_packets);
+  EXPECT_EQ(kNumFrames, result.decoded_frames);
+  RemoveFile(file_name);
+}
+
+TEST(ReceivePipelineBenchmarkTest, NacksLostPacket) {
+  const int kDroppedSeqNum = 10 * kPacketsPerFrame + 1;
+  RtpDumpWriter writer;
+  writer.AddStream(kSsrc, kDroppedSeqNum);
+  const std::string file_name = writer.WriteToFile();
+  std::unique_ptr<MappedRtpFile> dump = MappedRtpFile::Open(file_name);
+  ASSERT_TRUE(dump);
+
+  const ReceivePipelineBenchmark::Result result =
+      ReceivePipelineBenchmark::Run(GenericConfig(), dump.get());
+  EXPECT_EQ(kNumFrames * kPacketsPerFrame - 1, result.packets);
+  EXPECT_GE(result.nacked_packets, 1);
+  EXPECT_EQ(kNumFrames - 1, result.assembled_frames);
+  EXPECT_EQ(10, result.decoded_frames);
+  RemoveFile(file_name);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Replays a recorded video rtpdump or pcap file through the receive side
+// pipeline as fast as possible and reports the packet rate and the time spent
+// per component.
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
+#include "api/video_codecs/video_codec.h"
+#include "modules/rtp_rtcp/test/mapped_rtp_file.h"
+#include "modules/video_coding/test/receive_pipeline_benchmark.h"
+#include "rtc_base/string_to_number.h"
+
+ABSL_FLAG(std::string,
+          payload_types,
+          "",
+          "Comma-separated list of <payload type>:<codec> pairs, e.g. "
+          "96:VP8,98:VP9,100:H264. Packets with other payload types are "
+          "skipped.");
+ABSL_FLAG(std::string,
+          ssrc,
+          "",
+          "SSRC of the replayed stream. Defaults to the SSRC of the first "
+          "packet with a listed payload type.");
+ABSL_FLAG(std::string,
+          extensions,
+          "",
+          "Comma-separated list of <id>:<uri> header extension pairs.");
+ABSL_FLAG(int, iterations, 1, "Number of times the dump is replayed.");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+const char kUsage[] =
+    "Usage: video_receive_pipeline_replay --payload_types=<list>\n"
+    "           [--ssrc=<ssrc>] [--extensions=<list>] [--iterations=<n>]\n"
+    "           <input file>\n"
+    "\n"
+    "Pushes the video packets of an rtpdump or pcap file through RTP\n"
+    "parsing, depacketization, the NackModule, the PacketBuffer, the\n"
+    "RtpFrameReferenceFinder and the FrameBuffer at maximum speed, and\n"
+    "reports the packet rate and the time spent in each component.\n";
+
+// Splits "<key>:<value>" at the first colon, since URIs contain colons.
+bool SplitPair(const std::string& pair, std::string* key, std::string* value) {
+  const size_t colon = pair.find(':');
+  if (colon == std::string::npos || colon == 0 || colon + 1 == pair.size())
+    return false;
+  *key = pair.substr(0, colon);
+  *value = pair.substr(colon + 1);
+  return true;
+}
+
+bool ParseConfig(ReceivePipelineBenchmark::Config* config) {
+  const std::string payload_types = absl::GetFlag(FLAGS_payload_types);
+  for (const std::string& pair :
+       absl::StrSplit(payload_types, ',', absl::SkipEmpty())) {
+    std::string key, value;
+    absl::optional<uint8_t> payload_type;
+    if (SplitPair(pair, &key, &value))
+      payload_type = rtc::StringToNumber<uint8_t>(key);
+    if (!payload_type || *payload_type > 127) {
+      fprintf(stderr, "Invalid payload type: %s\n", pair.c_str());
+      return false;
+    }
+    config->payload_types[*payload_type] = PayloadStringToCodecType(value);
+  }
+  if (config->payload_types.empty()) {
+    fprintf(stderr, "--payload_types is required.\n");
+    return false;
+  }
+
+  const std::string ssrc = absl::GetFlag(FLAGS_ssrc);
+  if (!ssrc.empty()) {
+    config->ssrc = rtc::StringToNumber<uint32_t>(ssrc);
+    if (!config->ssrc) {
+      fprintf(stderr, "Invalid SSRC: %s\n", ssrc.c_str());
+      return false;
+    }
+  }
+
+  const std::string extensions = absl::GetFlag(FLAGS_extensions);
+  for (const std::string& pair :
+       absl::StrSplit(extensions, ',', absl::SkipEmpty())) {
+    std::string key, uri;
+    absl::optional<int> id;
+    if (SplitPair(pair, &key, &uri))
+      id = rtc::StringToNumber<int>(key);
+    if (!id || !config->extensions.RegisterByUri(*id, uri)) {
+      fprintf(stderr, "Invalid header extension: %s\n", pair.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+void PrintResult(const ReceivePipelineBenchmark::Result& result) {
+  printf("packets: %d (skipped %d)\n", result.packets,
+         result.skipped_packets);
+  printf("frames: %d assembled, %d complete, %d decoded\n",
+         result.assembled_frames, result.complete_frames,
+         result.decoded_frames);
+  printf("nacked packets: %d, key frame requests: %d\n", result.nacked_packets,
+         result.keyframe_requests);
+  printf("total: %.3f ms, %.0f packets/s\n", result.total_time_ns / 1e6,
+         result.PacketsPerSecond());
+  for (int i = 0; i < ReceivePipelineBenchmark::kNumComponents; ++i) {
+    const auto component = static_cast<ReceivePipelineBenchmark::Component>(i);
+    const double share =
+        result.total_time_ns > 0
+            ? 100.0 * result.component_time_ns[i] / result.total_time_ns
+            : 0.0;
+    printf("  %-18s %10.1f ns/packet %6.2f %%\n",
+           ReceivePipelineBenchmark::ComponentName(component),
+           result.ComponentNsPerPacket(component), share);
+  }
+}
+
+int Run(const std::string& input_file) {
+  ReceivePipelineBenchmark::Config config;
+  if (!ParseConfig(&config)) {
+    printf("%s", kUsage);
+    return 1;
+  }
+  std::unique_ptr<MappedRtpFile> dump = MappedRtpFile::Open(input_file);
+  if (!dump) {
+    fprintf(stderr, "Can't read %s as an rtpdump or pcap file\n",
+            input_file.c_str());
+    return 1;
+  }
+  const int iterations = absl::GetFlag(FLAGS_iterations);
+  for (int i = 0; i < iterations; ++i) {
+    dump->Rewind();
+    printf("iteration %d\n", i);
+    PrintResult(ReceivePipelineBenchmark::Run(config, dump.get()));
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 2) {
+    printf("%s", webrtc::test::kUsage);
+    return 1;
+  }
+  return webrtc::test::Run(args[1]);
+}
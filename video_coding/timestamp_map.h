@@ -24,6 +24,8 @@ class VCMTimestampMap {
 
   void Add(uint32_t timestamp, VCMFrameInformation* data);
   VCMFrameInformation* Pop(uint32_t timestamp);
+  // Returns the number of entries that have been added but not popped.
+  size_t Size() const;
 
  private:
   struct TimestampDataTuple {
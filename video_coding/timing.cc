@@ -38,6 +38,8 @@ VCMTiming::VCMTiming(Clock* clock, VCMTiming* master_timing)
   } else {
     ts_extrapolator_ = master_timing->ts_extrapolator_;
   }
+  rtc::CritScope cs(&crit_sect_);
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 VCMTiming::~VCMTiming() {
@@ -55,31 +57,33 @@ void VCMTiming::Reset() {
   jitter_delay_ms_ = 0;
   current_delay_ms_ = 0;
   prev_frame_timestamp_ = 0;
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 void VCMTiming::set_render_delay(int render_delay_ms) {
   rtc::CritScope cs(&crit_sect_);
   render_delay_ms_ = render_delay_ms;
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 void VCMTiming::set_min_playout_delay(int min_playout_delay_ms) {
   rtc::CritScope cs(&crit_sect_);
   min_playout_delay_ms_ = min_playout_delay_ms;
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 int VCMTiming::min_playout_delay() {
-  rtc::CritScope cs(&crit_sect_);
-  return min_playout_delay_ms_;
+  return delay_snapshot_.Read().min_playout_delay_ms;
 }
 
 void VCMTiming::set_max_playout_delay(int max_playout_delay_ms) {
   rtc::CritScope cs(&crit_sect_);
   max_playout_delay_ms_ = max_playout_delay_ms;
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 int VCMTiming::max_playout_delay() {
-  rtc::CritScope cs(&crit_sect_);
-  return max_playout_delay_ms_;
+  return delay_snapshot_.Read().max_playout_delay_ms;
 }
 
 void VCMTiming::SetJitterDelay(int jitter_delay_ms) {
@@ -90,6 +94,7 @@ void VCMTiming::SetJitterDelay(int jitter_delay_ms) {
     if (current_delay_ms_ == 0) {
       current_delay_ms_ = jitter_delay_ms_;
     }
+    delay_snapshot_.Publish(CurrentDelays());
   }
 }
 
@@ -131,6 +136,7 @@ void VCMTiming::UpdateCurrentDelay(uint32_t frame_timestamp) {
     current_delay_ms_ = current_delay_ms_ + delay_diff_ms;
   }
   prev_frame_timestamp_ = frame_timestamp;
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 void VCMTiming::UpdateCurrentDelay(int64_t render_time_ms,
@@ -148,6 +154,7 @@ void VCMTiming::UpdateCurrentDelay(int64_t render_time_ms,
   } else {
     current_delay_ms_ = target_delay_ms;
   }
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 void VCMTiming::StopDecodeTimer(uint32_t /*time_stamp*/,
@@ -162,6 +169,7 @@ void VCMTiming::StopDecodeTimer(int32_t decode_time_ms, int64_t now_ms) {
   codec_timer_->AddTiming(decode_time_ms, now_ms);
   assert(decode_time_ms >= 0);
   ++num_decoded_frames_;
+  delay_snapshot_.Publish(CurrentDelays());
 }
 
 void VCMTiming::IncomingTimestamp(uint32_t time_stamp, int64_t now_ms) {
@@ -171,16 +179,13 @@ void VCMTiming::IncomingTimestamp(uint32_t time_stamp, int64_t now_ms) {
 
 int64_t VCMTiming::RenderTimeMs(uint32_t frame_timestamp,
                                 int64_t now_ms) const {
-  rtc::CritScope cs(&crit_sect_);
-  return RenderTimeMsInternal(frame_timestamp, now_ms);
-}
-
-int64_t VCMTiming::RenderTimeMsInternal(uint32_t frame_timestamp,
-                                        int64_t now_ms) const {
-  if (min_playout_delay_ms_ == 0 && max_playout_delay_ms_ == 0) {
+  const DelaySnapshot snapshot = delay_snapshot_.Read();
+  if (snapshot.min_playout_delay_ms == 0 &&
+      snapshot.max_playout_delay_ms == 0) {
     // Render as soon as possible.
     return 0;
   }
+  // The extrapolator is thread safe on its own.
   int64_t estimated_complete_time_ms =
       ts_extrapolator_->ExtrapolateLocalTime(frame_timestamp);
   if (estimated_complete_time_ms == -1) {
@@ -189,8 +194,9 @@ int64_t VCMTiming::RenderTimeMsInternal(uint32_t frame_timestamp,
 
   // Make sure the actual delay stays in the range of |min_playout_delay_ms_|
   // and |max_playout_delay_ms_|.
-  int actual_delay = std::max(current_delay_ms_, min_playout_delay_ms_);
-  actual_delay = std::min(actual_delay, max_playout_delay_ms_);
+  int actual_delay =
+      std::max(snapshot.current_delay_ms, snapshot.min_playout_delay_ms);
+  actual_delay = std::min(actual_delay, snapshot.max_playout_delay_ms);
   return estimated_complete_time_ms + actual_delay;
 }
 
@@ -202,17 +208,17 @@ int VCMTiming::RequiredDecodeTimeMs() const {
 
 int64_t VCMTiming::MaxWaitingTime(int64_t render_time_ms,
                                   int64_t now_ms) const {
-  rtc::CritScope cs(&crit_sect_);
+  const DelaySnapshot snapshot = delay_snapshot_.Read();
 
-  const int64_t max_wait_time_ms =
-      render_time_ms - now_ms - RequiredDecodeTimeMs() - render_delay_ms_;
+  const int64_t max_wait_time_ms = render_time_ms - now_ms -
+                                   snapshot.required_decode_time_ms -
+                                   snapshot.render_delay_ms;
 
   return max_wait_time_ms;
 }
 
 int VCMTiming::TargetVideoDelay() const {
-  rtc::CritScope cs(&crit_sect_);
-  return TargetDelayInternal();
+  return delay_snapshot_.Read().TargetDelayMs();
 }
 
 int VCMTiming::TargetDelayInternal() const {
@@ -220,6 +226,23 @@ int VCMTiming::TargetDelayInternal() const {
                   jitter_delay_ms_ + RequiredDecodeTimeMs() + render_delay_ms_);
 }
 
+int VCMTiming::DelaySnapshot::TargetDelayMs() const {
+  return std::max(min_playout_delay_ms, jitter_delay_ms +
+                                            required_decode_time_ms +
+                                            render_delay_ms);
+}
+
+VCMTiming::DelaySnapshot VCMTiming::CurrentDelays() const {
+  DelaySnapshot delays;
+  delays.render_delay_ms = render_delay_ms_;
+  delays.min_playout_delay_ms = min_playout_delay_ms_;
+  delays.max_playout_delay_ms = max_playout_delay_ms_;
+  delays.jitter_delay_ms = jitter_delay_ms_;
+  delays.current_delay_ms = current_delay_ms_;
+  delays.required_decode_time_ms = RequiredDecodeTimeMs();
+  return delays;
+}
+
 bool VCMTiming::GetTimings(int* max_decode_ms,
                            int* current_delay_ms,
                            int* target_delay_ms,
@@ -15,6 +15,7 @@
 
 #include "absl/types/optional.h"
 #include "api/video/video_timing.h"
+#include "modules/utility/include/statistics_snapshot.h"
 #include "modules/video_coding/codec_timer.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
@@ -24,6 +25,10 @@ namespace webrtc {
 class Clock;
 class TimestampExtrapolator;
 
+// The delay state is written under |crit_sect_| and published as a snapshot
+// after every change. RenderTimeMs(), MaxWaitingTime(), TargetVideoDelay()
+// and the playout delay getters read the snapshot without taking the lock,
+// so they never wait for a writer on another thread.
 class VCMTiming {
  public:
   // The primary timing component should be passed
@@ -105,11 +110,24 @@ class VCMTiming {
 
  protected:
   int RequiredDecodeTimeMs() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
-  int64_t RenderTimeMsInternal(uint32_t frame_timestamp, int64_t now_ms) const
-      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
   int TargetDelayInternal() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
  private:
+  struct DelaySnapshot {
+    int render_delay_ms = 0;
+    int min_playout_delay_ms = 0;
+    int max_playout_delay_ms = 0;
+    int jitter_delay_ms = 0;
+    int current_delay_ms = 0;
+    int required_decode_time_ms = 0;
+
+    int TargetDelayMs() const;
+  };
+
+  // Returns the current delay state, to be published in |delay_snapshot_|
+  // after every change of a value in DelaySnapshot.
+  DelaySnapshot CurrentDelays() const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+
   rtc::CriticalSection crit_sect_;
   Clock* const clock_;
   bool master_ RTC_GUARDED_BY(crit_sect_);
@@ -128,6 +146,9 @@ class VCMTiming {
   uint32_t prev_frame_timestamp_ RTC_GUARDED_BY(crit_sect_);
   absl::optional<TimingFrameInfo> timing_frame_info_ RTC_GUARDED_BY(crit_sect_);
   size_t num_decoded_frames_ RTC_GUARDED_BY(crit_sect_);
+
+  // Published under |crit_sect_|, read without it.
+  StatisticsSnapshot<DelaySnapshot> delay_snapshot_;
 };
 }  // namespace webrtc
 
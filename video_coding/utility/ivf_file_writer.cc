@@ -10,12 +10,18 @@
 
 #include "modules/video_coding/utility/ivf_file_writer.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "api/video_codecs/video_codec.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
 
 // TODO(palmkvist): make logging more informative in the absence of a file name
 // (or get one)
@@ -24,7 +30,138 @@ namespace webrtc {
 
 const size_t kIvfHeaderSize = 32;
 
-IvfFileWriter::IvfFileWriter(FileWrapper file, size_t byte_limit)
+class IvfFileWriter::FrameQueue {
+ public:
+  FrameQueue(FileWrapper* file, size_t max_queued_bytes);
+  ~FrameQueue();
+
+  // Queues |header| followed by |data|. Returns false if they don't fit in
+  // the queue, or if writing previously queued frames failed.
+  bool Enqueue(const uint8_t* header,
+               size_t header_size,
+               const uint8_t* data,
+               size_t size);
+  // Writes all queued frames and stops the thread. Returns false if writing
+  // any frame failed.
+  bool Stop();
+  QueueStats GetStats() const;
+
+ private:
+  static void Run(void* obj);
+  bool Process();
+  // Writes all frames queued so far with a single write. Returns false if
+  // there were none.
+  bool WriteQueuedFrames();
+
+  FileWrapper* const file_;
+  const size_t max_queued_bytes_;
+
+  rtc::CriticalSection crit_;
+  bool stop_ RTC_GUARDED_BY(crit_);
+  bool write_failed_ RTC_GUARDED_BY(crit_);
+  rtc::Buffer queued_frames_ RTC_GUARDED_BY(crit_);
+  QueueStats stats_ RTC_GUARDED_BY(crit_);
+
+  // The frames being written. Only used on |thread_|, reused for each write.
+  rtc::Buffer frames_to_write_;
+  rtc::Event frames_queued_;
+  rtc::PlatformThread thread_;
+};
+
+IvfFileWriter::FrameQueue::FrameQueue(FileWrapper* file,
+                                      size_t max_queued_bytes)
+    : file_(file),
+      max_queued_bytes_(max_queued_bytes),
+      stop_(false),
+      write_failed_(false),
+      thread_(&FrameQueue::Run, this, "IvfFileWriter", rtc::kNormalPriority) {
+  thread_.Start();
+}
+
+IvfFileWriter::FrameQueue::~FrameQueue() {
+  Stop();
+}
+
+bool IvfFileWriter::FrameQueue::Enqueue(const uint8_t* header,
+                                        size_t header_size,
+                                        const uint8_t* data,
+                                        size_t size) {
+  {
+    rtc::CritScope lock(&crit_);
+    if (write_failed_)
+      return false;
+    if (stats_.queued_bytes + header_size + size > max_queued_bytes_) {
+      ++stats_.dropped_frames;
+      return false;
+    }
+    queued_frames_.AppendData(header, header_size);
+    queued_frames_.AppendData(data, size);
+    stats_.queued_bytes += header_size + size;
+    stats_.max_queued_bytes =
+        std::max(stats_.max_queued_bytes, stats_.queued_bytes);
+  }
+  frames_queued_.Set();
+  return true;
+}
+
+bool IvfFileWriter::FrameQueue::Stop() {
+  {
+    rtc::CritScope lock(&crit_);
+    stop_ = true;
+  }
+  frames_queued_.Set();
+  thread_.Stop();
+  rtc::CritScope lock(&crit_);
+  return !write_failed_;
+}
+
+IvfFileWriter::QueueStats IvfFileWriter::FrameQueue::GetStats() const {
+  rtc::CritScope lock(&crit_);
+  return stats_;
+}
+
+// static
+void IvfFileWriter::FrameQueue::Run(void* obj) {
+  FrameQueue* frame_queue = static_cast<FrameQueue*>(obj);
+  while (frame_queue->Process()) {
+  }
+}
+
+bool IvfFileWriter::FrameQueue::Process() {
+  frames_queued_.Wait(rtc::Event::kForever);
+  while (WriteQueuedFrames()) {
+  }
+  rtc::CritScope lock(&crit_);
+  // Frames queued right before stopping are written on the next call.
+  return !stop_ || !queued_frames_.empty();
+}
+
+bool IvfFileWriter::FrameQueue::WriteQueuedFrames() {
+  {
+    rtc::CritScope lock(&crit_);
+    if (queued_frames_.empty())
+      return false;
+    // Frames queued while writing go to the buffer of the previous write.
+    std::swap(queued_frames_, frames_to_write_);
+  }
+  const bool success =
+      file_->Write(frames_to_write_.data(), frames_to_write_.size());
+  if (!success)
+    RTC_LOG(LS_ERROR) << "Unable to write frames to file.";
+  {
+    rtc::CritScope lock(&crit_);
+    stats_.queued_bytes -= frames_to_write_.size();
+    ++stats_.num_writes;
+    if (!success)
+      write_failed_ = true;
+  }
+  frames_to_write_.Clear();
+  return true;
+}
+
+IvfFileWriter::IvfFileWriter(FileWrapper file,
+                             size_t byte_limit,
+                             size_t max_queued_bytes)
     : codec_type_(kVideoCodecGeneric),
       bytes_written_(0),
       byte_limit_(byte_limit),
@@ -36,6 +173,8 @@ IvfFileWriter::IvfFileWriter(FileWrapper file, size_t byte_limit)
       file_(std::move(file)) {
   RTC_DCHECK(byte_limit == 0 || kIvfHeaderSize <= byte_limit)
       << "The byte_limit is too low, not even the header will fit.";
+  if (max_queued_bytes > 0)
+    frame_queue_ = std::make_unique<FrameQueue>(&file_, max_queued_bytes);
 }
 
 IvfFileWriter::~IvfFileWriter() {
@@ -45,7 +184,16 @@ IvfFileWriter::~IvfFileWriter() {
 std::unique_ptr<IvfFileWriter> IvfFileWriter::Wrap(FileWrapper file,
                                                    size_t byte_limit) {
   return std::unique_ptr<IvfFileWriter>(
-      new IvfFileWriter(std::move(file), byte_limit));
+      new IvfFileWriter(std::move(file), byte_limit, 0));
+}
+
+std::unique_ptr<IvfFileWriter> IvfFileWriter::WrapAsync(
+    FileWrapper file,
+    size_t byte_limit,
+    size_t max_queued_bytes) {
+  RTC_DCHECK_GT(max_queued_bytes, 0);
+  return std::unique_ptr<IvfFileWriter>(
+      new IvfFileWriter(std::move(file), byte_limit, max_queued_bytes));
 }
 
 bool IvfFileWriter::WriteHeader() {
@@ -196,8 +344,11 @@ bool IvfFileWriter::WriteOneSpatialLayer(int64_t timestamp,
   ByteWriter<uint32_t>::WriteLittleEndian(&frame_header[0],
                                           static_cast<uint32_t>(size));
   ByteWriter<uint64_t>::WriteLittleEndian(&frame_header[4], timestamp);
-  if (!file_.Write(frame_header, kFrameHeaderSize) ||
-      !file_.Write(data, size)) {
+  if (frame_queue_) {
+    if (!frame_queue_->Enqueue(frame_header, kFrameHeaderSize, data, size))
+      return false;
+  } else if (!file_.Write(frame_header, kFrameHeaderSize) ||
+             !file_.Write(data, size)) {
     RTC_LOG(LS_ERROR) << "Unable to write frame to file.";
     return false;
   }
@@ -212,14 +363,26 @@ bool IvfFileWriter::Close() {
   if (!file_.is_open())
     return false;
 
+  bool frames_written = true;
+  if (frame_queue_) {
+    // The header is rewritten once the thread is done with the file.
+    frames_written = frame_queue_->Stop();
+    final_queue_stats_ = frame_queue_->GetStats();
+    frame_queue_.reset();
+  }
+
   if (num_frames_ == 0) {
     file_.Close();
     return true;
   }
 
-  bool ret = WriteHeader();
+  bool ret = WriteHeader() && frames_written;
   file_.Close();
   return ret;
 }
 
+IvfFileWriter::QueueStats IvfFileWriter::GetQueueStats() const {
+  return frame_queue_ ? frame_queue_->GetStats() : final_queue_stats_;
+}
+
 }  // namespace webrtc
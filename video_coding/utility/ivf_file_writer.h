@@ -25,19 +25,45 @@ namespace webrtc {
 
 class IvfFileWriter {
  public:
+  // Statistics of the frame queue of an asynchronous writer.
+  struct QueueStats {
+    // Frame data waiting to be written, including the data being written.
+    size_t queued_bytes = 0;
+    // The largest |queued_bytes| so far.
+    size_t max_queued_bytes = 0;
+    // Frames that did not fit in the queue.
+    size_t dropped_frames = 0;
+    // Writes to the file, each of all the frames queued meanwhile.
+    size_t num_writes = 0;
+  };
+
   // Takes ownership of the file, which will be closed either through
   // Close or ~IvfFileWriter. If writing a frame would take the file above the
   // |byte_limit| the file will be closed, the write (and all future writes)
   // will fail. A |byte_limit| of 0 is equivalent to no limit.
   static std::unique_ptr<IvfFileWriter> Wrap(FileWrapper file,
                                              size_t byte_limit);
+  // Like Wrap(), but WriteFrame() only queues the frames, which a thread of
+  // the writer writes to the file. Up to |max_queued_bytes| of frame data are
+  // queued; WriteFrame() drops the frames that don't fit and returns false,
+  // instead of waiting for the file. Close() waits until all queued frames
+  // are written.
+  static std::unique_ptr<IvfFileWriter> WrapAsync(FileWrapper file,
+                                                  size_t byte_limit,
+                                                  size_t max_queued_bytes);
   ~IvfFileWriter();
 
   bool WriteFrame(const EncodedImage& encoded_image, VideoCodecType codec_type);
   bool Close();
 
+  // Returns all zeros unless the writer was created by WrapAsync().
+  QueueStats GetQueueStats() const;
+
  private:
-  explicit IvfFileWriter(FileWrapper file, size_t byte_limit);
+  // Writes the queued frames to |file_| on a dedicated thread.
+  class FrameQueue;
+
+  IvfFileWriter(FileWrapper file, size_t byte_limit, size_t max_queued_bytes);
 
   bool WriteHeader();
   bool InitFromFirstFrame(const EncodedImage& encoded_image,
@@ -56,6 +82,9 @@ class IvfFileWriter {
   bool using_capture_timestamps_;
   rtc::TimestampWrapAroundHandler wrap_handler_;
   FileWrapper file_;
+  // Set if the writer was created by WrapAsync(), until the file is closed.
+  std::unique_ptr<FrameQueue> frame_queue_;
+  QueueStats final_queue_stats_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(IvfFileWriter);
 };
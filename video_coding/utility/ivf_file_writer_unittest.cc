@@ -181,4 +181,40 @@ TEST_F(IvfFileWriterTest, ClosesWhenReachesLimit) {
   out_file.Close();
 }
 
+TEST_F(IvfFileWriterTest, WritesQueuedFramesAsync) {
+  const uint8_t fourcc[4] = {'V', 'P', '8', '0'};
+  const int kWidth = 320;
+  const int kHeight = 240;
+  const int kNumFrames = 257;
+  file_writer_ = IvfFileWriter::WrapAsync(
+      FileWrapper::OpenWriteOnly(file_name_), 0,
+      kNumFrames * (kFrameHeaderSize + sizeof(dummy_payload)));
+  ASSERT_TRUE(file_writer_.get());
+  ASSERT_TRUE(WriteDummyTestFrames(kVideoCodecVP8, kWidth, kHeight, kNumFrames,
+                                   false));
+  EXPECT_TRUE(file_writer_->Close());
+
+  const IvfFileWriter::QueueStats stats = file_writer_->GetQueueStats();
+  EXPECT_EQ(0u, stats.queued_bytes);
+  EXPECT_GT(stats.max_queued_bytes, 0u);
+  EXPECT_EQ(0u, stats.dropped_frames);
+  EXPECT_GT(stats.num_writes, 0u);
+  EXPECT_LE(stats.num_writes, static_cast<size_t>(kNumFrames));
+
+  FileWrapper out_file = FileWrapper::OpenReadOnly(file_name_);
+  VerifyIvfHeader(&out_file, fourcc, kWidth, kHeight, kNumFrames, false);
+  VerifyDummyTestFrames(&out_file, kNumFrames);
+
+  out_file.Close();
+}
+
+TEST_F(IvfFileWriterTest, DropsFramesThatDoNotFitInQueue) {
+  file_writer_ = IvfFileWriter::WrapAsync(
+      FileWrapper::OpenWriteOnly(file_name_), 0, kFrameHeaderSize);
+  ASSERT_TRUE(file_writer_.get());
+  EXPECT_FALSE(WriteDummyTestFrames(kVideoCodecVP8, 320, 240, 1, false));
+  EXPECT_EQ(1u, file_writer_->GetQueueStats().dropped_frames);
+  EXPECT_EQ(0u, file_writer_->GetQueueStats().queued_bytes);
+}
+
 }  // namespace webrtc
@@ -18,6 +18,7 @@
 #include <numeric>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "rtc_base/checks.h"
@@ -42,16 +43,27 @@ static const float kBaseHeavy3TlRateAllocation[kMaxTemporalStreams] = {
 
 const uint32_t kLegacyScreenshareTl0BitrateKbps = 200;
 const uint32_t kLegacyScreenshareTl1BitrateKbps = 1000;
+
+const char kBaseHeavy3TlRateAllocationFieldTrial[] =
+    "WebRTC-UseBaseHeavyVP8TL3RateAllocation";
 }  // namespace
 
 float SimulcastRateAllocator::GetTemporalRateAllocation(int num_layers,
                                                         int temporal_id) {
+  return GetTemporalRateAllocation(
+      num_layers, temporal_id,
+      field_trial::IsEnabled(kBaseHeavy3TlRateAllocationFieldTrial));
+}
+
+float SimulcastRateAllocator::GetTemporalRateAllocation(
+    int num_layers,
+    int temporal_id,
+    bool base_heavy_tl3_rate_allocation) {
   RTC_CHECK_GT(num_layers, 0);
   RTC_CHECK_LE(num_layers, kMaxTemporalStreams);
   RTC_CHECK_GE(temporal_id, 0);
   RTC_CHECK_LT(temporal_id, num_layers);
-  if (num_layers == 3 &&
-      field_trial::IsEnabled("WebRTC-UseBaseHeavyVP8TL3RateAllocation")) {
+  if (num_layers == 3 && base_heavy_tl3_rate_allocation) {
     return kBaseHeavy3TlRateAllocation[temporal_id];
   }
   return kLayerRateAllocation[num_layers - 1][temporal_id];
@@ -59,8 +71,9 @@ float SimulcastRateAllocator::GetTemporalRateAllocation(int num_layers,
 
 SimulcastRateAllocator::SimulcastRateAllocator(const VideoCodec& codec)
     : codec_(codec),
-      stable_rate_settings_(
-          StableTargetRateExperiment::ParseFromFieldTrials()) {}
+      stable_rate_settings_(StableTargetRateExperiment::ParseFromFieldTrials()),
+      base_heavy_tl3_rate_allocation_(
+          field_trial::IsEnabled(kBaseHeavy3TlRateAllocationFieldTrial)) {}
 
 SimulcastRateAllocator::~SimulcastRateAllocator() = default;
 
@@ -72,9 +85,21 @@ VideoBitrateAllocation SimulcastRateAllocator::Allocate(
       parameters.stable_bitrate > DataRate::Zero()) {
     stable_rate = std::min(parameters.stable_bitrate, parameters.total_bitrate);
   }
+  if (cached_allocation_ &&
+      cached_allocation_->total_bitrate == parameters.total_bitrate &&
+      cached_allocation_->stable_bitrate == stable_rate &&
+      cached_allocation_->stream_enabled == stream_enabled_) {
+    stream_enabled_ = cached_allocation_->next_stream_enabled;
+    return cached_allocation_->allocation;
+  }
+  std::vector<bool> stream_enabled = stream_enabled_;
+
   DistributeAllocationToSimulcastLayers(parameters.total_bitrate, stable_rate,
                                         &allocated_bitrates);
   DistributeAllocationToTemporalLayers(&allocated_bitrates);
+  cached_allocation_ = CachedAllocation{
+      parameters.total_bitrate, stable_rate, std::move(stream_enabled),
+      stream_enabled_, allocated_bitrates};
   return allocated_bitrates;
 }
 
@@ -283,7 +308,9 @@ std::vector<uint32_t> SimulcastRateAllocator::DefaultTemporalLayerAllocation(
   std::vector<uint32_t> bitrates;
   for (size_t i = 0; i < num_temporal_layers; ++i) {
     float layer_bitrate =
-        bitrate_kbps * GetTemporalRateAllocation(num_temporal_layers, i);
+        bitrate_kbps * GetTemporalRateAllocation(
+                           num_temporal_layers, i,
+                           base_heavy_tl3_rate_allocation_);
     bitrates.push_back(static_cast<uint32_t>(layer_bitrate + 0.5));
   }
 
@@ -16,6 +16,8 @@
 
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_bitrate_allocator.h"
 #include "api/video_codecs/video_codec.h"
@@ -36,6 +38,10 @@ class SimulcastRateAllocator : public VideoBitrateAllocator {
   static float GetTemporalRateAllocation(int num_layers, int temporal_id);
 
  private:
+  static float GetTemporalRateAllocation(int num_layers,
+                                         int temporal_id,
+                                         bool base_heavy_tl3_rate_allocation);
+
   void DistributeAllocationToSimulcastLayers(
       DataRate total_bitrate,
       DataRate stable_bitrate,
@@ -53,8 +59,23 @@ class SimulcastRateAllocator : public VideoBitrateAllocator {
 
   const VideoCodec codec_;
   const StableTargetRateExperiment stable_rate_settings_;
+  const bool base_heavy_tl3_rate_allocation_;
   std::vector<bool> stream_enabled_;
 
+  // The result of the last Allocate() call. The allocation only depends on
+  // the total and stable rates and on |stream_enabled_|, so it is returned
+  // again while those stay the same, e.g. when rates are set again for a new
+  // framerate.
+  struct CachedAllocation {
+    DataRate total_bitrate;
+    DataRate stable_bitrate;
+    std::vector<bool> stream_enabled;
+    // |stream_enabled_| once the allocation was made.
+    std::vector<bool> next_stream_enabled;
+    VideoBitrateAllocation allocation;
+  };
+  absl::optional<CachedAllocation> cached_allocation_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(SimulcastRateAllocator);
 };
 
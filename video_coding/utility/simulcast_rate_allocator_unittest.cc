@@ -802,4 +802,44 @@ TEST_F(ScreenshareRateAllocationTest, Hysteresis) {
   }
 }
 
+// Rates are often set again unchanged, e.g. for a new framerate. Such repeated
+// allocations should neither change the result nor the hysteresis state.
+TEST_F(ScreenshareRateAllocationTest, HysteresisWithRepeatedRates) {
+  SetupConferenceScreenshare(true);
+  CreateAllocator();
+
+  const uint32_t default_enable_rate_bps =
+      codec_.simulcastStream[0].targetBitrate +
+      codec_.simulcastStream[1].minBitrate;
+  auto get_allocation = [this](uint32_t bitrate, uint32_t framerate) {
+    return allocator_->Allocate(VideoBitrateAllocationParameters(
+        DataRate::kbps(bitrate), framerate));
+  };
+
+  {
+    // Hysteresis is disabled on the first call only.
+    const uint32_t bitrate = default_enable_rate_bps;
+    uint32_t expected[] = {codec_.simulcastStream[0].targetBitrate,
+                           codec_.simulcastStream[1].minBitrate};
+    ExpectEqual(expected, get_allocation(bitrate, kFramerateFps));
+    ExpectEqual(expected, get_allocation(bitrate, kDefaultFrameRate));
+  }
+
+  {
+    const uint32_t bitrate = default_enable_rate_bps - 1;
+    uint32_t expected[] = {bitrate, 0};
+    ExpectEqual(expected, get_allocation(bitrate, kFramerateFps));
+    ExpectEqual(expected, get_allocation(bitrate, kDefaultFrameRate));
+  }
+
+  {
+    // The second stream stays disabled however often the rate is set.
+    const uint32_t bitrate = default_enable_rate_bps;
+    uint32_t expected[] = {bitrate, 0};
+    ExpectEqual(expected, get_allocation(bitrate, kFramerateFps));
+    ExpectEqual(expected, get_allocation(bitrate, kDefaultFrameRate));
+    ExpectEqual(expected, get_allocation(bitrate, kFramerateFps));
+  }
+}
+
 }  // namespace webrtc
@@ -13,9 +13,11 @@
 #include <set>
 #include <utility>
 
+#include "api/array_view.h"
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
@@ -114,6 +116,38 @@ TEST_F(TestPacketBuffer, InsertMultiplePackets) {
   EXPECT_TRUE(Insert(seq_num + 3, kKeyFrame, kFirst, kLast));
 }
 
+TEST_F(TestPacketBuffer, TracksMemoryUsage) {
+  const uint16_t seq_num = Rand();
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast, 10,
+                     new uint8_t[10]()));
+  EXPECT_TRUE(Insert(seq_num + 1, kKeyFrame, kNotFirst, kNotLast, 5,
+                     new uint8_t[5]()));
+  EXPECT_EQ(15u, packet_buffer_.GetMemoryUsage().bytes);
+  EXPECT_EQ(2u, packet_buffer_.GetMemoryUsage().num_items);
+
+  packet_buffer_.ClearTo(seq_num);
+  EXPECT_EQ(5u, packet_buffer_.GetMemoryUsage().bytes);
+  EXPECT_EQ(1u, packet_buffer_.GetMemoryUsage().num_items);
+  EXPECT_EQ(15u, packet_buffer_.GetMemoryUsage().max_bytes);
+}
+
+TEST_F(TestPacketBuffer, ByteLimitClearsBuffer) {
+  const uint16_t seq_num = Rand();
+  packet_buffer_.SetByteLimit(25);
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast, 10,
+                     new uint8_t[10]()));
+  EXPECT_TRUE(Insert(seq_num + 1, kKeyFrame, kNotFirst, kNotLast, 10,
+                     new uint8_t[10]()));
+  EXPECT_FALSE(Insert(seq_num + 2, kKeyFrame, kNotFirst, kNotLast, 10,
+                      new uint8_t[10]()));
+  EXPECT_EQ(0u, packet_buffer_.GetMemoryUsage().bytes);
+  EXPECT_EQ(0u, packet_buffer_.GetMemoryUsage().num_items);
+
+  EXPECT_TRUE(Insert(seq_num + 3, kKeyFrame, kFirst, kLast, 10,
+                     new uint8_t[10]()));
+  CheckFrame(seq_num + 3);
+}
+
 TEST_F(TestPacketBuffer, InsertDuplicatePacket) {
   const uint16_t seq_num = Rand();
   EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast));
@@ -464,6 +498,50 @@ TEST_F(TestPacketBuffer, GetBitstream) {
             0);
 }
 
+TEST_F(TestPacketBuffer, GetBitstreamFromSharedPayload) {
+  // Each buffer starts with a two byte fake header that is not part of the
+  // payload.
+  const uint8_t first_rtp_data[] = {0x80, 0x60, 0x73, 0x68, 0x61, 0x72};
+  const uint8_t second_rtp_data[] = {0x80, 0x60, 0x65, 0x64, 0x0};
+  rtc::CopyOnWriteBuffer first_rtp(first_rtp_data);
+  rtc::CopyOnWriteBuffer second_rtp(second_rtp_data);
+  const uint8_t* first_rtp_ptr = first_rtp.cdata();
+  const uint8_t* second_rtp_ptr = second_rtp.cdata();
+
+  const uint16_t seq_num = Rand();
+  VCMPacket packet;
+  packet.video_header.codec = kVideoCodecGeneric;
+  packet.video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  packet.timestamp = 123u;
+  packet.seqNum = seq_num;
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = false;
+  ASSERT_TRUE(packet.SetSharedPayload(
+      first_rtp, rtc::MakeArrayView(first_rtp.cdata() + 2, 4)));
+  EXPECT_EQ(first_rtp_ptr + 2, packet.dataPtr);
+  EXPECT_TRUE(packet_buffer_.InsertPacket(&packet));
+
+  packet.seqNum = seq_num + 1;
+  packet.video_header.is_first_packet_in_frame = false;
+  packet.video_header.is_last_packet_in_frame = true;
+  // A payload that isn't part of the buffer can't be shared.
+  EXPECT_FALSE(packet.SetSharedPayload(
+      second_rtp, rtc::MakeArrayView(first_rtp.cdata() + 2, 3)));
+  ASSERT_TRUE(packet.SetSharedPayload(
+      second_rtp, rtc::MakeArrayView(second_rtp.cdata() + 2, 3)));
+  EXPECT_TRUE(packet_buffer_.InsertPacket(&packet));
+
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  CheckFrame(seq_num);
+  EXPECT_EQ(frames_from_callback_[seq_num]->size(), 7UL);
+  EXPECT_EQ(memcmp(frames_from_callback_[seq_num]->data(), "shared", 7), 0);
+
+  // Once the frame is assembled the packet buffer no longer references the
+  // RTP buffers, so writing to them doesn't trigger a copy.
+  EXPECT_EQ(first_rtp_ptr, first_rtp.data());
+  EXPECT_EQ(second_rtp_ptr, second_rtp.data());
+}
+
 TEST_F(TestPacketBuffer, GetBitstreamOneFrameOnePacket) {
   uint8_t bitstream_data[] = "All the bitstream data for this frame!";
   uint8_t* data = new uint8_t[sizeof(bitstream_data)];
@@ -502,6 +580,38 @@ TEST_F(TestPacketBuffer, GetBitstreamOneFrameFullBuffer) {
   EXPECT_EQ(memcmp(frames_from_callback_[0]->data(), expected, kStartSize), 0);
 }
 
+TEST_F(TestPacketBuffer, ReusesBufferOfReleasedFrame) {
+  const uint16_t seq_num = Rand();
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast, 10,
+                     new uint8_t[10]()));
+  EXPECT_TRUE(Insert(seq_num + 1, kKeyFrame, kNotFirst, kLast, 10,
+                     new uint8_t[10]()));
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  const uint8_t* const first_frame_data =
+      frames_from_callback_[seq_num]->data();
+  DeleteFrame(seq_num);
+
+  // A smaller frame fits in the released buffer, which keeps the size of the
+  // largest frame so far.
+  uint8_t bitstream_data[] = "frame";
+  uint8_t* data = new uint8_t[sizeof(bitstream_data)];
+  memcpy(data, bitstream_data, sizeof(bitstream_data));
+  EXPECT_TRUE(Insert(seq_num + 2, kDeltaFrame, kFirst, kLast,
+                     sizeof(bitstream_data), data, 124u));
+  CheckFrame(seq_num + 2);
+  const RtpFrameObject& frame = *frames_from_callback_[seq_num + 2];
+  EXPECT_EQ(first_frame_data, frame.data());
+  EXPECT_EQ(sizeof(bitstream_data), frame.size());
+  EXPECT_EQ(20u, frame.capacity());
+  EXPECT_EQ(memcmp(frame.data(), bitstream_data, sizeof(bitstream_data)), 0);
+
+  // The buffer isn't reused while the frame is alive.
+  EXPECT_TRUE(Insert(seq_num + 3, kDeltaFrame, kFirst, kLast, 5,
+                     new uint8_t[5](), 125u));
+  CheckFrame(seq_num + 3);
+  EXPECT_NE(first_frame_data, frames_from_callback_[seq_num + 3]->data());
+}
+
 TEST_F(TestPacketBuffer, InsertPacketAfterOldFrameObjectIsRemoved) {
   uint16_t kFirstSeqNum = 0;
   uint32_t kTimestampDelta = 100;
@@ -899,6 +1009,19 @@ TEST_P(TestPacketBufferH264Parameterized, FindFramesOnPadding) {
   CheckFrame(2);
 }
 
+TEST_P(TestPacketBufferH264Parameterized, FindFramesOnPaddingAcrossWrap) {
+  InsertH264(65534, kKeyFrame, kFirst, kLast, 1000);
+  InsertH264(1, kDeltaFrame, kFirst, kLast, 2000);
+
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  packet_buffer_.PaddingReceived(65535);
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  packet_buffer_.PaddingReceived(0);
+  ASSERT_EQ(2UL, frames_from_callback_.size());
+  CheckFrame(65534);
+  CheckFrame(1);
+}
+
 class TestPacketBufferH264XIsKeyframe : public TestPacketBufferH264 {
  protected:
   const uint16_t kSeqNum = 5;
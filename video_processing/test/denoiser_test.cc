@@ -165,4 +165,72 @@ TEST(VideoDenoiserTest, Denoiser) {
   ASSERT_NE(0, feof(source_file)) << "Error reading source file";
 }
 
+TEST(VideoDenoiserTest, DenoiserWithBands) {
+  const int kWidth = 352;
+  const int kHeight = 288;
+
+  const std::string video_file =
+      webrtc::test::ResourcePath("foreman_cif", "yuv");
+  FILE* source_file = fopen(video_file.c_str(), "rb");
+  ASSERT_TRUE(source_file != nullptr)
+      << "Cannot open source file: " << video_file;
+
+  VideoDenoiser denoiser(true);
+  // Uses a band count that does not divide the number of block rows.
+  VideoDenoiser denoiser_bands(true, 5);
+
+  for (;;) {
+    rtc::scoped_refptr<I420BufferInterface> video_frame_buffer(
+        test::ReadI420Buffer(kWidth, kHeight, source_file));
+    if (!video_frame_buffer)
+      break;
+
+    rtc::scoped_refptr<I420BufferInterface> denoised_frame(
+        denoiser.DenoiseFrame(video_frame_buffer, true));
+    rtc::scoped_refptr<I420BufferInterface> denoised_frame_bands(
+        denoiser_bands.DenoiseFrame(video_frame_buffer, true));
+
+    // Splitting the frame into bands should not change the result.
+    ASSERT_TRUE(test::FrameBufsEqual(denoised_frame, denoised_frame_bands));
+  }
+  ASSERT_NE(0, feof(source_file)) << "Error reading source file";
+}
+
+TEST(VideoDenoiserTest, DenoiserWithSubsampledNoiseEstimation) {
+  const int kWidth = 352;
+  const int kHeight = 288;
+
+  const std::string video_file =
+      webrtc::test::ResourcePath("foreman_cif", "yuv");
+  FILE* source_file = fopen(video_file.c_str(), "rb");
+  ASSERT_TRUE(source_file != nullptr)
+      << "Cannot open source file: " << video_file;
+
+  VideoDenoiser denoiser(true);
+  // The default subsampling should not change the result.
+  VideoDenoiser denoiser_default(true);
+  denoiser_default.SetNoiseEstimationSubsampling(1, NOISE_SUBSAMPLE_INTERVAL);
+  VideoDenoiser denoiser_c(false);
+  denoiser_c.SetNoiseEstimationSubsampling(3, 2 * NOISE_SUBSAMPLE_INTERVAL);
+  VideoDenoiser denoiser_sse_neon(true);
+  denoiser_sse_neon.SetNoiseEstimationSubsampling(3,
+                                                  2 * NOISE_SUBSAMPLE_INTERVAL);
+
+  for (;;) {
+    rtc::scoped_refptr<I420BufferInterface> video_frame_buffer(
+        test::ReadI420Buffer(kWidth, kHeight, source_file));
+    if (!video_frame_buffer)
+      break;
+
+    ASSERT_TRUE(test::FrameBufsEqual(
+        denoiser.DenoiseFrame(video_frame_buffer, true),
+        denoiser_default.DenoiseFrame(video_frame_buffer, true)));
+    // Subsampling results should be the same for C and SSE/NEON denoiser.
+    ASSERT_TRUE(test::FrameBufsEqual(
+        denoiser_c.DenoiseFrame(video_frame_buffer, true),
+        denoiser_sse_neon.DenoiseFrame(video_frame_buffer, true)));
+  }
+  ASSERT_NE(0, feof(source_file)) << "Error reading source file";
+}
+
 }  // namespace webrtc
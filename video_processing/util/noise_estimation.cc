@@ -26,20 +26,29 @@ void NoiseEstimation::Init(int width, int height, CpuType cpu_type) {
   cpu_type_ = cpu_type;
 }
 
-void NoiseEstimation::GetNoise(int mb_index, uint32_t var, uint32_t luma) {
+void NoiseEstimation::GetNoise(int mb_index,
+                               uint32_t var,
+                               uint32_t luma,
+                               BandStats* stats) {
   consec_low_var_[mb_index]++;
-  num_static_block_++;
+  stats->num_static_block++;
   if (consec_low_var_[mb_index] >= kConsecLowVarFrame &&
       (luma >> 6) < kAverageLumaMax && (luma >> 6) > kAverageLumaMin) {
     // Normalized var by the average luma value, this gives more weight to
     // darker blocks.
     int nor_var = var / (luma >> 10);
-    noise_var_ +=
+    stats->noise_var +=
         nor_var > kBlockSelectionVarMax ? kBlockSelectionVarMax : nor_var;
-    num_noisy_block_++;
+    stats->num_noisy_block++;
   }
 }
 
+void NoiseEstimation::AddBandStats(const BandStats& stats) {
+  num_static_block_ += stats.num_static_block;
+  noise_var_ += stats.noise_var;
+  num_noisy_block_ += stats.num_noisy_block;
+}
+
 void NoiseEstimation::ResetConsecLowVar(int mb_index) {
   consec_low_var_[mb_index] = 0;
 }
@@ -50,7 +59,7 @@ void NoiseEstimation::UpdateNoiseLevel() {
   // No enough samples implies the motion of the camera or too many moving
   // objects in the frame.
   if (num_static_block_ <
-          (0.65 * mb_cols_ * mb_rows_ / NOISE_SUBSAMPLE_INTERVAL) ||
+          (0.65 * mb_cols_ * mb_rows_ / mb_interval_) ||
       !num_noisy_block_) {
 #if DISPLAY
     printf("Not enough samples. %d \n", num_static_block_);
@@ -66,19 +75,19 @@ void NoiseEstimation::UpdateNoiseLevel() {
   } else {
 #if DISPLAY
     printf("%d %d fraction = %.3f\n", num_static_block_,
-           mb_cols_ * mb_rows_ / NOISE_SUBSAMPLE_INTERVAL,
+           mb_cols_ * mb_rows_ / mb_interval_,
            percent_static_block_);
 #elif DISPLAYNEON
     __android_log_print(ANDROID_LOG_DEBUG, "DISPLAY", "%d %d fraction = %.3f\n",
                         num_static_block_,
-                        mb_cols_ * mb_rows_ / NOISE_SUBSAMPLE_INTERVAL,
+                        mb_cols_ * mb_rows_ / mb_interval_,
                         percent_static_block_);
 #endif
     // Normalized by the number of noisy blocks.
     noise_var_ /= num_noisy_block_;
     // Get the percentage of static blocks.
     percent_static_block_ = static_cast<double>(num_static_block_) /
-                            (mb_cols_ * mb_rows_ / NOISE_SUBSAMPLE_INTERVAL);
+                            (mb_cols_ * mb_rows_ / mb_interval_);
     num_noisy_block_ = 0;
     num_static_block_ = 0;
   }
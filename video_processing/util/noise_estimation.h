@@ -34,9 +34,23 @@ const int kBlockSelectionVarMax = kNoiseThreshold << 1;
 
 class NoiseEstimation {
  public:
+  // Noise data collected from the blocks of one band of a frame.
+  struct BandStats {
+    int num_noisy_block = 0;
+    int num_static_block = 0;
+    uint32_t noise_var = 0;
+  };
+
   void Init(int width, int height, CpuType cpu_type);
-  // Collect noise data from one qualified block.
-  void GetNoise(int mb_index, uint32_t var, uint32_t luma);
+  // Blocks the caller collects noise data from, every |interval| blocks.
+  // Defaults to NOISE_SUBSAMPLE_INTERVAL.
+  void set_mb_interval(int interval) { mb_interval_ = interval; }
+  int mb_interval() const { return mb_interval_; }
+  // Collect noise data from one qualified block into |stats|. May be called
+  // concurrently for different blocks.
+  void GetNoise(int mb_index, uint32_t var, uint32_t luma, BandStats* stats);
+  // Add the noise data of one band to the current frame.
+  void AddBandStats(const BandStats& stats);
   // Reset the counter for consecutive low-var blocks.
   void ResetConsecLowVar(int mb_index);
   // Update noise level for current frame.
@@ -52,6 +66,7 @@ class NoiseEstimation {
   int num_noisy_block_;
   int num_static_block_;
   CpuType cpu_type_;
+  int mb_interval_ = NOISE_SUBSAMPLE_INTERVAL;
   uint32_t noise_var_;
   double noise_var_accum_;
   double percent_static_block_;
@@ -14,6 +14,7 @@
 #include <string.h>
 
 #include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
 #include "third_party/libyuv/include/libyuv/planar_functions.h"
 
 namespace webrtc {
@@ -75,10 +76,33 @@ static void ShowRect(const std::unique_ptr<DenoiserFilter>& filter,
 #endif
 
 VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection)
+    : VideoDenoiser(runtime_cpu_detection, 1) {}
+
+VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection, int num_threads)
     : width_(0),
       height_(0),
       filter_(DenoiserFilter::Create(runtime_cpu_detection, &cpu_type_)),
-      ne_(new NoiseEstimation()) {}
+      ne_(new NoiseEstimation()),
+      num_bands_(num_threads),
+      band_noise_stats_(num_threads) {
+  RTC_DCHECK_GT(num_bands_, 0);
+  for (int i = 1; i < num_bands_; ++i) {
+    band_workers_.push_back(
+        std::make_unique<TaskThread>("VideoDenoiserBand", rtc::kHighPriority));
+  }
+  band_tasks_.resize(band_workers_.size());
+}
+
+VideoDenoiser::~VideoDenoiser() = default;
+
+void VideoDenoiser::SetNoiseEstimationSubsampling(int frame_interval,
+                                                  int mb_interval) {
+  RTC_DCHECK_GT(frame_interval, 0);
+  RTC_DCHECK_GT(mb_interval, 0);
+  noise_frame_interval_ = frame_interval;
+  frames_until_noise_sample_ = 0;
+  ne_->set_mb_interval(mb_interval);
+}
 
 void VideoDenoiser::DenoiserReset(
     rtc::scoped_refptr<I420BufferInterface> frame) {
@@ -94,6 +118,24 @@ void VideoDenoiser::DenoiserReset(
   x_density_.reset(new uint8_t[mb_cols_]);
   y_density_.reset(new uint8_t[mb_rows_]);
   moving_object_.reset(new uint8_t[mb_cols_ * mb_rows_]);
+  frames_until_noise_sample_ = 0;
+  noise_data_pending_ = false;
+  noise_level_ = 0;
+  band_x_density_.clear();
+  for (int i = 1; i < num_bands_; ++i)
+    band_x_density_.emplace_back(new uint8_t[mb_cols_]);
+}
+
+void VideoDenoiser::RunOnBands(
+    rtc::FunctionView<void(int band)> band_function) {
+  for (size_t i = 0; i < band_workers_.size(); ++i) {
+    band_tasks_[i].band_function = band_function;
+    band_tasks_[i].band = static_cast<int>(i) + 1;
+    band_workers_[i]->StartTask(band_tasks_[i]);
+  }
+  band_function(0);
+  for (auto& worker : band_workers_)
+    worker->Wait();
 }
 
 int VideoDenoiser::PositionCheck(int mb_row, int mb_col, int noise_level) {
@@ -175,10 +217,12 @@ bool VideoDenoiser::IsTrailingBlock(const std::unique_ptr<uint8_t[]>& d_status,
 void VideoDenoiser::CopySrcOnMOB(const uint8_t* y_src,
                                  int stride_src,
                                  uint8_t* y_dst,
-                                 int stride_dst) {
+                                 int stride_dst,
+                                 int mb_row_begin,
+                                 int mb_row_end) {
   // Loop over to copy src block if the block is marked as moving object block
   // or if the block may cause trailing artifacts.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+  for (int mb_row = mb_row_begin; mb_row < mb_row_end; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_dst;
@@ -220,45 +264,31 @@ void VideoDenoiser::CopyLumaOnMargin(const uint8_t* y_src,
   }
 }
 
-rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
-    rtc::scoped_refptr<I420BufferInterface> frame,
-    bool noise_estimation_enabled) {
-  // If previous width and height are different from current frame's, need to
-  // reallocate the buffers and no denoising for the current frame.
-  if (!prev_buffer_ || width_ != frame->width() || height_ != frame->height()) {
-    DenoiserReset(frame);
-    prev_buffer_ = frame;
-    return frame;
-  }
-
-  // Set buffer pointers.
-  const uint8_t* y_src = frame->DataY();
-  int stride_y_src = frame->StrideY();
-  rtc::scoped_refptr<I420Buffer> dst =
-      buffer_pool_.CreateBuffer(width_, height_);
-
-  uint8_t* y_dst = dst->MutableDataY();
-  int stride_y_dst = dst->StrideY();
-
-  const uint8_t* y_dst_prev = prev_buffer_->DataY();
-  int stride_prev = prev_buffer_->StrideY();
-
-  memset(x_density_.get(), 0, mb_cols_);
-  memset(y_density_.get(), 0, mb_rows_);
-  memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
+void VideoDenoiser::FilterBlocks(const LumaPlanes& planes,
+                                 int mb_row_begin,
+                                 int mb_row_end,
+                                 uint8_t noise_level,
+                                 uint8_t* x_density,
+                                 NoiseEstimation::BandStats* noise_stats) {
+  const uint8_t* y_src = planes.y_src;
+  const int stride_y_src = planes.stride_y_src;
+  uint8_t* y_dst = planes.y_dst;
+  const int stride_y_dst = planes.stride_y_dst;
+  const uint8_t* y_dst_prev = planes.y_dst_prev;
+  const int stride_prev = planes.stride_prev;
 
-  uint8_t noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
   int thr_var_base = 16 * 16 * 2;
   // Loop over blocks to accumulate/extract noise level and update x/y_density
   // factors for moving object detection.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+  for (int mb_row = mb_row_begin; mb_row < mb_row_end; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_y_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_y_dst;
     const uint8_t* mb_dst_prev_base = y_dst_prev + (mb_row << 4) * stride_prev;
     for (int mb_col = 0; mb_col < mb_cols_; ++mb_col) {
       const int mb_index = mb_index_base + mb_col;
-      const bool ne_enable = (mb_index % NOISE_SUBSAMPLE_INTERVAL == 0);
+      const bool ne_enable =
+          noise_stats && (mb_index % ne_->mb_interval() == 0);
       const int pos_factor = PositionCheck(mb_row, mb_col, noise_level);
       const uint32_t thr_var_adp = thr_var_base * pos_factor;
       const uint32_t offset_col = mb_col << 4;
@@ -291,7 +321,7 @@ rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
           // time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
           uint32_t noise_var = filter_->Variance16x8(
               mb_dst_prev, stride_y_dst, mb_src, stride_y_src, &sse_t);
-          ne_->GetNoise(mb_index, noise_var, luma);
+          ne_->GetNoise(mb_index, noise_var, luma, noise_stats);
         }
         moving_edge_[mb_index] = 0;  // Not a moving edge block.
       } else {
@@ -305,7 +335,7 @@ rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
             ne_->ResetConsecLowVar(mb_index);
           }
           moving_edge_[mb_index] = 1;  // Mark as moving edge block.
-          x_density_[mb_col] += (pos_factor < 3);
+          x_density[mb_col] += (pos_factor < 3);
           y_density_[mb_row] += (pos_factor < 3);
         } else {
           moving_edge_[mb_index] = 0;
@@ -314,16 +344,85 @@ rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
             // in time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
             uint32_t noise_var = filter_->Variance16x8(
                 mb_dst_prev, stride_prev, mb_src, stride_y_src, &sse_t);
-            ne_->GetNoise(mb_index, noise_var, luma);
+            ne_->GetNoise(mb_index, noise_var, luma, noise_stats);
           }
         }
       }
     }  // End of for loop
   }    // End of for loop
+}
+
+rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
+    rtc::scoped_refptr<I420BufferInterface> frame,
+    bool noise_estimation_enabled) {
+  // If previous width and height are different from current frame's, need to
+  // reallocate the buffers and no denoising for the current frame.
+  if (!prev_buffer_ || width_ != frame->width() || height_ != frame->height()) {
+    DenoiserReset(frame);
+    prev_buffer_ = frame;
+    return frame;
+  }
+
+  // Set buffer pointers.
+  const uint8_t* y_src = frame->DataY();
+  int stride_y_src = frame->StrideY();
+  rtc::scoped_refptr<I420Buffer> dst =
+      buffer_pool_.CreateBuffer(width_, height_);
+
+  uint8_t* y_dst = dst->MutableDataY();
+  int stride_y_dst = dst->StrideY();
+
+  const uint8_t* y_dst_prev = prev_buffer_->DataY();
+  int stride_prev = prev_buffer_->StrideY();
+
+  memset(x_density_.get(), 0, mb_cols_);
+  memset(y_density_.get(), 0, mb_rows_);
+  memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
+  for (auto& x_density : band_x_density_)
+    memset(x_density.get(), 0, mb_cols_);
+
+  // The noise level is updated from the data of the previous frame, if any.
+  uint8_t noise_level = 0;
+  bool sample_noise = false;
+  if (noise_estimation_enabled) {
+    if (noise_data_pending_) {
+      noise_level_ = ne_->GetNoiseLevel();
+      noise_data_pending_ = false;
+    }
+    noise_level = noise_level_;
+    sample_noise = frames_until_noise_sample_ == 0;
+    frames_until_noise_sample_ = sample_noise ? noise_frame_interval_ - 1
+                                              : frames_until_noise_sample_ - 1;
+  }
+  const LumaPlanes planes = {y_src,        stride_y_src, y_dst,
+                             stride_y_dst, y_dst_prev,   stride_prev};
+  // Loop over blocks to accumulate/extract noise level and update x/y_density
+  // factors for moving object detection, in bands of rows.
+  RunOnBands([&](int band) {
+    band_noise_stats_[band] = NoiseEstimation::BandStats();
+    FilterBlocks(planes, band * mb_rows_ / num_bands_,
+                 (band + 1) * mb_rows_ / num_bands_, noise_level,
+                 band == 0 ? x_density_.get() : band_x_density_[band - 1].get(),
+                 sample_noise ? &band_noise_stats_[band] : nullptr);
+  });
+  noise_data_pending_ = sample_noise;
+  for (int band = 0; band < num_bands_; ++band) {
+    if (sample_noise)
+      ne_->AddBandStats(band_noise_stats_[band]);
+    if (band == 0)
+      continue;
+    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col)
+      x_density_[mb_col] += band_x_density_[band - 1][mb_col];
+  }
 
   ReduceFalseDetection(moving_edge_, &moving_object_, noise_level);
 
-  CopySrcOnMOB(y_src, stride_y_src, y_dst, stride_y_dst);
+  // Only reads the status of neighboring blocks, which is final by now.
+  RunOnBands([&](int band) {
+    CopySrcOnMOB(y_src, stride_y_src, y_dst, stride_y_dst,
+                 band * mb_rows_ / num_bands_,
+                 (band + 1) * mb_rows_ / num_bands_);
+  });
 
   // When frame width/height not divisible by 16, copy the margin to
   // denoised_frame.
@@ -12,10 +12,13 @@
 #define MODULES_VIDEO_PROCESSING_VIDEO_DENOISER_H_
 
 #include <memory>
+#include <vector>
 
+#include "api/function_view.h"
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/include/i420_buffer_pool.h"
+#include "modules/utility/include/task_thread.h"
 #include "modules/video_processing/util/denoiser_filter.h"
 #include "modules/video_processing/util/noise_estimation.h"
 #include "modules/video_processing/util/skin_detection.h"
@@ -25,14 +28,59 @@ namespace webrtc {
 class VideoDenoiser {
  public:
   explicit VideoDenoiser(bool runtime_cpu_detection);
+  // Splits each frame into |num_threads| horizontal bands of macroblocks that
+  // are denoised in parallel, using |num_threads| - 1 worker threads besides
+  // the calling thread. The result is the same as with a single thread.
+  VideoDenoiser(bool runtime_cpu_detection, int num_threads);
+  ~VideoDenoiser();
 
   rtc::scoped_refptr<I420BufferInterface> DenoiseFrame(
       rtc::scoped_refptr<I420BufferInterface> frame,
       bool noise_estimation_enabled);
 
+  // Collects noise data only from every |frame_interval|-th frame, and from
+  // every |mb_interval|-th block of these frames. The noise level is kept
+  // in between. By default, noise data is collected from every
+  // NOISE_SUBSAMPLE_INTERVAL-th block of every frame. Larger intervals save
+  // CPU on low-power devices, but the noise level follows changes slower.
+  void SetNoiseEstimationSubsampling(int frame_interval, int mb_interval);
+
  private:
+  // The band handed to a worker thread by RunOnBands().
+  struct BandTask {
+    void operator()() const { band_function(band); }
+
+    rtc::FunctionView<void(int band)> band_function;
+    int band = 0;
+  };
+
+  // Luma planes of the frame being denoised.
+  struct LumaPlanes {
+    const uint8_t* y_src;
+    int stride_y_src;
+    uint8_t* y_dst;
+    int stride_y_dst;
+    const uint8_t* y_dst_prev;
+    int stride_prev;
+  };
+
   void DenoiserReset(rtc::scoped_refptr<I420BufferInterface> frame);
 
+  // Calls |band_function| for every band, on the band workers and the calling
+  // thread, and returns when all calls have returned.
+  void RunOnBands(rtc::FunctionView<void(int band)> band_function);
+
+  // Filters the blocks of rows [mb_row_begin, mb_row_end) and detects moving
+  // edges. Density factors of the columns are added to |x_density| and noise
+  // data to |noise_stats|, so that bands can run concurrently. No noise data
+  // is collected if |noise_stats| is null.
+  void FilterBlocks(const LumaPlanes& planes,
+                    int mb_row_begin,
+                    int mb_row_end,
+                    uint8_t noise_level,
+                    uint8_t* x_density,
+                    NoiseEstimation::BandStats* noise_stats);
+
   // Check the mb position, return 1: close to the frame center (between 1/8
   // and 7/8 of width/height), 3: close to the border (out of 1/16 and 15/16
   // of width/height), 2: in between.
@@ -49,11 +97,14 @@ class VideoDenoiser {
                        int mb_row,
                        int mb_col);
 
-  // Copy input blocks to dst buffer on moving object blocks (MOB).
+  // Copy input blocks to dst buffer on moving object blocks (MOB), for rows
+  // [mb_row_begin, mb_row_end).
   void CopySrcOnMOB(const uint8_t* y_src,
                     int stride_src,
                     uint8_t* y_dst,
-                    int stride_dst);
+                    int stride_dst,
+                    int mb_row_begin,
+                    int mb_row_end);
 
   // Copy luma margin blocks when frame width/height not divisible by 16.
   void CopyLumaOnMargin(const uint8_t* y_src,
@@ -79,6 +130,23 @@ class VideoDenoiser {
   std::unique_ptr<DenoiserDecision[]> mb_filter_decision_;
   I420BufferPool buffer_pool_;
   rtc::scoped_refptr<I420BufferInterface> prev_buffer_;
+  // Noise estimation subsampling, see SetNoiseEstimationSubsampling().
+  int noise_frame_interval_ = 1;
+  int frames_until_noise_sample_ = 0;
+  // Whether noise data was collected from the previous frame, and the noise
+  // level has to be updated from it.
+  bool noise_data_pending_ = false;
+  uint8_t noise_level_ = 0;
+
+  const int num_bands_;
+  // One per band except the first, which runs on the calling thread.
+  std::vector<std::unique_ptr<TaskThread>> band_workers_;
+  // The tasks of |band_workers_|, kept here as the workers don't copy them.
+  std::vector<BandTask> band_tasks_;
+  // Column density factors of bands except the first, which uses
+  // |x_density_|.
+  std::vector<std::unique_ptr<uint8_t[]>> band_x_density_;
+  std::vector<NoiseEstimation::BandStats> band_noise_stats_;
 };
 
 }  // namespace webrtc